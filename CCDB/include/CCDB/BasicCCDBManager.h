@@ -17,6 +17,7 @@
 
 #include "CCDB/CcdbApi.h"
 #include "CCDB/CCDBTimeStampUtils.h"
+#include "CCDB/SharedObjectStore.h"
 #include "CommonUtils/NameConf.h"
 #include "Framework/DataTakingContext.h"
 #include "Framework/DefaultsHelpers.h"
@@ -123,6 +124,9 @@ class CCDBManagerInstance
 
   bool isHostReachable() const { return mCCDBAccessor.isHostReachable(); }
 
+  /// prefetch in one go the objects of the given paths valid at timestamp to the local snapshot cache, see CcdbApi::prefetchToSnapshotCache
+  int prefetchToSnapshotCache(std::vector<std::string> const& paths, long timestamp, MD metaData = MD()) const { return mCCDBAccessor.prefetchToSnapshotCache(paths, timestamp, metaData); }
+
   /// clear all entries in the cache
   void clearCache() { mCache.clear(); }
 
@@ -248,9 +252,34 @@ T* CCDBManagerInstance::getForTimeStamp(std::string const& path, long timestamp)
     if ((!isOnline() && cached.isCacheValid(timestamp)) || (mCheckObjValidityEnabled && cached.isValid(timestamp))) {
       return reinterpret_cast<T*>(cached.noCleanupPtr ? cached.noCleanupPtr : cached.objPtr.get());
     }
-    ptr = mCCDBAccessor.retrieveFromTFileAny<T>(path, mMetaData, timestamp, &mHeaders, cached.uuid,
-                                                mCreatedNotAfter ? std::to_string(mCreatedNotAfter) : "",
-                                                mCreatedNotBefore ? std::to_string(mCreatedNotBefore) : "");
+    SharedObjectStore* store = nullptr;
+    bool unchanged = false;
+    if constexpr (FlatObjectLike<T>) {
+      // flat objects can be shared by all the processes of the node, only the headers are queried
+      // to know which version to look for in the store
+      store = (mCreatedNotAfter || mCreatedNotBefore) ? nullptr : SharedObjectStore::instance();
+      if (store) {
+        mHeaders = mCCDBAccessor.retrieveHeaders(path, mMetaData, timestamp);
+        auto etag = mHeaders.find("ETag");
+        if (etag == mHeaders.end()) {
+          mHeaders.clear();
+        } else if (etag->second == cached.uuid) {
+          unchanged = true;
+        } else {
+          ptr = store->getFlatObject<T>(path, etag->second);
+        }
+      }
+    }
+    if (!ptr && !unchanged) {
+      ptr = mCCDBAccessor.retrieveFromTFileAny<T>(path, mMetaData, timestamp, &mHeaders, cached.uuid,
+                                                  mCreatedNotAfter ? std::to_string(mCreatedNotAfter) : "",
+                                                  mCreatedNotBefore ? std::to_string(mCreatedNotBefore) : "");
+      if constexpr (FlatObjectLike<T>) {
+        if (ptr && store) {
+          store->shareFlatObject(path, mHeaders["ETag"], *ptr);
+        }
+      }
+    }
     if (ptr) { // new object was shipped, old one (if any) is not valid anymore
       cached.fetches++;
       mFetches++;
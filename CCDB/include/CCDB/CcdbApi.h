@@ -26,6 +26,7 @@
 #include "CCDB/CcdbObjectInfo.h"
 #include <CommonUtils/ConfigurableParam.h>
 #include <type_traits>
+#include <typeinfo>
 #include <vector>
 
 #if !defined(__CINT__) && !defined(__MAKECINT__) && !defined(__ROOTCLING__) && !defined(__CLING__)
@@ -48,6 +49,22 @@ namespace ccdb
 
 class CCDBQuery;
 
+/// Header of the raw image of an o2::gpu::FlatObject stored with CcdbApi::storeFlatObject.
+/// It is followed by the bytes of the object and by its flat buffer, each at an offset aligned to alignment.
+struct FlatObjectImageHeader {
+  static constexpr char Magic[8] = {'O', '2', 'F', 'L', 'A', 'T', 'O', 'B'};
+  char magic[8] = {};
+  char className[128] = {};
+  int classVersion = 0;
+  unsigned int alignment = 0;
+  unsigned long objectOffset = 0;
+  unsigned long objectSize = 0;
+  unsigned long bufferOffset = 0;
+  unsigned long bufferSize = 0;
+
+  static size_t alignSize(size_t size, size_t alignment) { return (size + alignment - 1) / alignment * alignment; }
+};
+
 /**
  * Interface to the CCDB.
  * It uses Curl to talk to the REST api.
@@ -191,6 +208,50 @@ class CcdbApi //: public DatabaseInterface
                          long timestamp = -1, std::map<std::string, std::string>* headers = nullptr, std::string const& etag = "",
                          const std::string& createdNotAfter = "", const std::string& createdNotBefore = "") const;
 
+  /**
+   * Store an o2::gpu::FlatObject-derived object as a raw image (see FlatObjectImageHeader) instead of streaming it with ROOT.
+   * The object must be constructed and must not own memory outside of its flat buffer.
+   * @return same as storeAsBinaryFile
+   */
+  template <typename T>
+  int storeFlatObject(const T& obj, std::string const& path, std::map<std::string, std::string> const& metadata,
+                      long startValidityTimestamp = -1, long endValidityTimestamp = -1) const
+  {
+    auto image = createFlatObjectImage(&obj, sizeof(T), alignof(T), obj.getFlatBufferPtr(), obj.getFlatBufferSize(), typeid(T));
+    const std::string className = reinterpret_cast<const FlatObjectImageHeader*>(image.data())->className;
+    return storeAsBinaryFile(image.data(), image.size(), className + ".flat", className, path, metadata, startValidityTimestamp, endValidityTimestamp);
+  }
+
+  /**
+   * Retrieve an object stored with storeFlatObject without deserialization: the object is used in place in the
+   * (aligned) memory of the payload, which the returned pointer owns, after relocating it to its flat buffer.
+   * @return the object, or nullptr if none was found or the payload is not an image of T.
+   */
+  template <typename T>
+  std::shared_ptr<T> retrieveFlatObject(std::string const& path, std::map<std::string, std::string> const& metadata,
+                                        long timestamp = -1, std::map<std::string, std::string>* headers = nullptr) const
+  {
+    std::shared_ptr<char> image;
+    auto obj = static_cast<T*>(loadFlatObjectImage(typeid(T), sizeof(T), alignof(T), path, metadata, timestamp, headers, image));
+    if (!obj) {
+      return nullptr;
+    }
+    auto const* header = reinterpret_cast<const FlatObjectImageHeader*>(image.get());
+    obj->clearInternalBufferPtr(); // the container of the writer is meaningless here, the buffer is owned by the image
+    obj->setActualBufferAddress(image.get() + header->bufferOffset);
+    return std::shared_ptr<T>(image, obj);
+  }
+
+  /// raw image of an object of size objectSize followed by its flat buffer, see FlatObjectImageHeader
+  static std::vector<char> createFlatObjectImage(const void* obj, size_t objectSize, size_t objectAlignment,
+                                                 const char* flatBuffer, size_t flatBufferSize, std::type_info const& tinfo);
+
+  /// load a flat object image, validated against the type, into aligned memory owned by image
+  /// @return pointer to the (not yet relocated) object in the image, nullptr on failure
+  void* loadFlatObjectImage(std::type_info const& tinfo, size_t objectSize, size_t objectAlignment, std::string const& path,
+                            std::map<std::string, std::string> const& metadata, long timestamp,
+                            std::map<std::string, std::string>* headers, std::shared_ptr<char>& image) const;
+
   /**
    * Delete all versions of the object at this path.
    *
@@ -247,6 +308,23 @@ class CcdbApi //: public DatabaseInterface
    */
   void snapshot(std::string const& ccdbrootpath, std::string const& localDir, long timestamp) const;
 
+  /**
+   * Prefetch the objects valid at a timestamp for all paths of a manifest into the local snapshot cache
+   * (ALICEO2_CCDB_LOCALCACHE), from which the subsequent retrievals of the job are then served.
+   * The downloads are done in parallel by the CCDBDownloader, objects already in the cache are not fetched again.
+   *
+   * @param paths The CCDB paths to prefetch.
+   * @param timestamp Timestamp of the objects to prefetch, e.g. the one of the run.
+   * @param metadata Key-values representing the metadata to filter out objects.
+   * @return The number of paths for which an object is available in the cache after the prefetch.
+   */
+  int prefetchToSnapshotCache(std::vector<std::string> const& paths, long timestamp, std::map<std::string, std::string> const& metadata = {}) const;
+
+  /**
+   * Same as above with the paths read from a manifest file, one path per line, empty lines and lines starting with # being ignored.
+   */
+  int prefetchToSnapshotCache(std::string const& manifestFile, long timestamp, std::map<std::string, std::string> const& metadata = {}) const;
+
   /**
    * Check whether the url is reachable.
    * @param url The url to test.
@@ -0,0 +1,137 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file SharedObjectStore.h
+/// \brief Node-local store of CCDB flat objects, shared by all the processes of the node
+
+#ifndef O2_CCDB_SHAREDOBJECTSTORE_H_
+#define O2_CCDB_SHAREDOBJECTSTORE_H_
+
+#include <cstring>
+#include <initializer_list>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+#include <gsl/span>
+
+namespace o2::ccdb
+{
+
+/// Objects made of a small header and of a flat buffer which can be relocated
+/// via setActualBufferAddress, e.g. MatLayerCylSet or TPCFastTransform.
+template <typename T>
+concept FlatObjectLike = requires(T& obj, char* ptr) {
+  obj.getFlatBufferPtr();
+  obj.getFlatBufferSize();
+  obj.setActualBufferAddress(ptr);
+  obj.releaseInternalBuffer();
+  obj.adoptInternalBuffer(ptr);
+  obj.clearInternalBufferPtr();
+};
+
+/// Store of CCDB objects in files of a node-local directory, ideally on tmpfs
+/// (e.g. /dev/shm), keyed by CCDB path and ETag. The first process retrieving
+/// an object stores it, all the others map the stored copy instead of
+/// downloading and deserializing their own.
+///
+/// Entries are mapped copy-on-write: relocating a flat object writes only the
+/// pages holding its internal pointers, the rest of the buffer stays shared by
+/// all the processes. Entries are published with an atomic link, so a reader
+/// sees either a complete entry or none. They are not removed by the store.
+class SharedObjectStore
+{
+ public:
+  explicit SharedObjectStore(std::string directory);
+  ~SharedObjectStore();
+  SharedObjectStore(SharedObjectStore const&) = delete;
+  SharedObjectStore& operator=(SharedObjectStore const&) = delete;
+
+  /// The store configured via ALICEO2_CCDB_SHARED_OBJECTS=<directory>, nullptr if not set.
+  static SharedObjectStore* instance();
+
+  /// Mapping of the blob stored in the node for @a key, empty if there is none.
+  gsl::span<char> get(std::string const& key);
+  /// Store @a parts one after the other, each aligned to 64 bytes, for @a key and
+  /// return the mapping of the stored copy. If another process stored the same key
+  /// in the meanwhile, its copy is returned.
+  gsl::span<char> put(std::string const& key, std::initializer_list<gsl::span<const char>> parts);
+
+  /// A flat object using the buffer stored for @a path and @a etag, nullptr if not in the store.
+  template <FlatObjectLike T>
+  T* getFlatObject(std::string const& path, std::string const& etag);
+  /// Store the flat object @a obj, which has to own its buffer, and make it use the buffer
+  /// of the store instead of its own. Returns false if the object could not be stored.
+  template <FlatObjectLike T>
+  bool shareFlatObject(std::string const& path, std::string const& etag, T& obj);
+
+  static constexpr size_t Alignment = 64;
+
+ private:
+  template <typename T>
+  static std::string flatObjectKey(std::string const& path, std::string const& etag)
+  {
+    return path + '\n' + etag + '\n' + typeid(T).name();
+  }
+  struct Mapping {
+    void* address = nullptr;
+    size_t size = 0;
+    gsl::span<char> payload;
+  };
+
+  std::string fileName(std::string const& key) const;
+  gsl::span<char> map(std::string const& key, std::string const& file);
+
+  std::string mDirectory;
+  std::unordered_map<std::string, Mapping> mMappings; // kept until destruction, objects refer to them
+};
+
+template <FlatObjectLike T>
+T* SharedObjectStore::getFlatObject(std::string const& path, std::string const& etag)
+{
+  auto blob = get(flatObjectKey<T>(path, etag));
+  if (blob.size() < sizeof(T)) {
+    return nullptr;
+  }
+  // The image of the object refers to the buffer at the address it had in the
+  // process which stored it, relocating it fixes all the internal pointers.
+  auto* obj = new T();
+  std::memcpy((void*)obj, blob.data(), sizeof(T));
+  obj->clearInternalBufferPtr();
+  obj->setActualBufferAddress(blob.data() + (sizeof(T) + Alignment - 1) / Alignment * Alignment);
+  return obj;
+}
+
+template <FlatObjectLike T>
+bool SharedObjectStore::shareFlatObject(std::string const& path, std::string const& etag, T& obj)
+{
+  if (obj.getFlatBufferPtr() == nullptr) {
+    // As streamed by ROOT, only the buffer container is set
+    char* container = obj.releaseInternalBuffer();
+    if (container == nullptr) {
+      return false;
+    }
+    obj.setActualBufferAddress(container);
+    obj.adoptInternalBuffer(container);
+  }
+  auto blob = put(flatObjectKey<T>(path, etag), {gsl::span<const char>(reinterpret_cast<const char*>(&obj), sizeof(T)),
+                                                 gsl::span<const char>(obj.getFlatBufferPtr(), obj.getFlatBufferSize())});
+  if (blob.size() < sizeof(T)) {
+    return false;
+  }
+  char* ownBuffer = obj.releaseInternalBuffer();
+  obj.setActualBufferAddress(blob.data() + (sizeof(T) + Alignment - 1) / Alignment * Alignment);
+  delete[] ownBuffer;
+  return true;
+}
+
+} // namespace o2::ccdb
+
+#endif // O2_CCDB_SHAREDOBJECTSTORE_H_
@@ -111,6 +111,8 @@ void CCDBDownloader::initializeMultiHandle()
   curlMultiErrorCheck(curl_multi_setopt(mCurlMultiHandle, CURLMOPT_TIMERFUNCTION, startTimeout));
   curlMultiErrorCheck(curl_multi_setopt(mCurlMultiHandle, CURLMOPT_TIMERDATA, mTimeoutTimer));
   curlMultiErrorCheck(curl_multi_setopt(mCurlMultiHandle, CURLMOPT_MAX_TOTAL_CONNECTIONS, mMaxHandlesInUse));
+  // multiplex the parallel transfers to the same host over one HTTP/2 connection when the server supports it
+  curlMultiErrorCheck(curl_multi_setopt(mCurlMultiHandle, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX));
 }
 
 CCDBDownloader::~CCDBDownloader()
@@ -611,6 +613,7 @@ void CCDBDownloader::setHandleOptions(CURL* handle, PerformData* data)
   curlEasyErrorCheck(curl_easy_setopt(handle, CURLOPT_CONNECTTIMEOUT_MS, mConnectionTimeoutMS));
   curlEasyErrorCheck(curl_easy_setopt(handle, CURLOPT_HAPPY_EYEBALLS_TIMEOUT_MS, mHappyEyeballsHeadstartMS));
   curlEasyErrorCheck(curl_easy_setopt(handle, CURLOPT_USERAGENT, mUserAgentId.c_str()));
+  curlEasyErrorCheck(curl_easy_setopt(handle, CURLOPT_PIPEWAIT, 1L));
 }
 
 void CCDBDownloader::checkHandleQueue()
@@ -45,6 +45,9 @@
 #include <boost/interprocess/sync/named_semaphore.hpp>
 #include <regex>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
 #include <string>
 #include <unordered_set>
 #include "rapidjson/document.h"
@@ -851,6 +854,115 @@ bool CcdbApi::retrieveBlob(std::string const& path, std::string const& targetdir
   return true;
 }
 
+std::vector<char> CcdbApi::createFlatObjectImage(const void* obj, size_t objectSize, size_t objectAlignment,
+                                                const char* flatBuffer, size_t flatBufferSize, std::type_info const& tinfo)
+{
+  FlatObjectImageHeader header;
+  std::memcpy(header.magic, FlatObjectImageHeader::Magic, sizeof(header.magic));
+  auto cl = tinfo2TClass(tinfo);
+  std::strncpy(header.className, cl->GetName(), sizeof(header.className) - 1);
+  header.classVersion = cl->GetClassVersion();
+  header.alignment = std::max({objectAlignment, alignof(FlatObjectImageHeader), size_t(8)});
+  header.objectOffset = FlatObjectImageHeader::alignSize(sizeof(FlatObjectImageHeader), header.alignment);
+  header.objectSize = objectSize;
+  header.bufferOffset = FlatObjectImageHeader::alignSize(header.objectOffset + objectSize, header.alignment);
+  header.bufferSize = flatBufferSize;
+
+  std::vector<char> image(header.bufferOffset + flatBufferSize, 0);
+  std::memcpy(image.data(), &header, sizeof(header));
+  std::memcpy(image.data() + header.objectOffset, obj, objectSize);
+  if (flatBufferSize) {
+    std::memcpy(image.data() + header.bufferOffset, flatBuffer, flatBufferSize);
+  }
+  return image;
+}
+
+void* CcdbApi::loadFlatObjectImage(std::type_info const& tinfo, size_t objectSize, size_t objectAlignment, std::string const& path,
+                                   std::map<std::string, std::string> const& metadata, long timestamp,
+                                   std::map<std::string, std::string>* headers, std::shared_ptr<char>& image) const
+{
+  std::map<std::string, std::string> localHeaders;
+  auto blob = std::make_shared<o2::pmr::vector<char>>();
+  loadFileToMemory(*blob, path, metadata, timestamp, headers ? headers : &localHeaders, "", "", "");
+  if (blob->size() < sizeof(FlatObjectImageHeader)) {
+    LOGP(error, "No flat object image found for {} at timestamp {}", path, timestamp);
+    return nullptr;
+  }
+  FlatObjectImageHeader header;
+  std::memcpy(&header, blob->data(), sizeof(header));
+  auto cl = tinfo2TClass(tinfo);
+  if (std::memcmp(header.magic, FlatObjectImageHeader::Magic, sizeof(header.magic)) != 0 ||
+      std::strncmp(header.className, cl->GetName(), sizeof(header.className)) != 0 || header.classVersion != cl->GetClassVersion() ||
+      header.objectSize != objectSize || header.alignment < objectAlignment || header.bufferOffset + header.bufferSize > blob->size()) {
+    LOGP(error, "Payload of {} is not a flat object image of {} version {}", path, cl->GetName(), cl->GetClassVersion());
+    return nullptr;
+  }
+  if (reinterpret_cast<std::uintptr_t>(blob->data()) % header.alignment == 0) {
+    // use the downloaded payload in place
+    image = std::shared_ptr<char>(blob, blob->data());
+  } else {
+    auto aligned = static_cast<char*>(std::aligned_alloc(header.alignment, FlatObjectImageHeader::alignSize(blob->size(), header.alignment)));
+    std::memcpy(aligned, blob->data(), blob->size());
+    image = std::shared_ptr<char>(aligned, std::free);
+  }
+  return image.get() + header.objectOffset;
+}
+
+int CcdbApi::prefetchToSnapshotCache(std::vector<std::string> const& paths, long timestamp, std::map<std::string, std::string> const& metadata) const
+{
+  if (mSnapshotCachePath.empty() || mInSnapshotMode) {
+    LOGP(warn, "CCDB prefetch requires a local snapshot cache (ALICEO2_CCDB_LOCALCACHE) and a server backend, ignoring it");
+    return 0;
+  }
+  std::vector<std::string> toFetch;
+  for (auto const& path : paths) {
+    if (!std::filesystem::exists(getSnapshotFile(mSnapshotCachePath, path))) {
+      toFetch.push_back(path);
+    }
+  }
+  // all downloads are scheduled at once and performed in parallel
+  std::vector<o2::pmr::vector<char>> dests(toFetch.size());
+  std::vector<std::map<std::string, std::string>> headers(toFetch.size());
+  std::vector<RequestContext> contexts;
+  contexts.reserve(toFetch.size());
+  for (size_t i = 0; i < toFetch.size(); i++) {
+    auto& requestContext = contexts.emplace_back(dests[i], metadata, headers[i]);
+    requestContext.path = toFetch[i];
+    requestContext.timestamp = timestamp;
+    requestContext.considerSnapshot = true;
+  }
+  vectoredLoadFileToMemory(contexts);
+
+  int nCached = 0;
+  for (auto const& path : paths) {
+    if (std::filesystem::exists(getSnapshotFile(mSnapshotCachePath, path))) {
+      nCached++;
+    } else {
+      LOGP(warn, "CCDB prefetch: no object for {} at timestamp {}", path, timestamp);
+    }
+  }
+  LOGP(info, "CCDB prefetch: {} of {} objects valid at {} available in {} ({} downloaded)", nCached, paths.size(), timestamp, mSnapshotCachePath, toFetch.size());
+  return nCached;
+}
+
+int CcdbApi::prefetchToSnapshotCache(std::string const& manifestFile, long timestamp, std::map<std::string, std::string> const& metadata) const
+{
+  std::ifstream manifest(manifestFile);
+  if (!manifest.good()) {
+    LOGP(error, "Failed to open CCDB prefetch manifest {}", manifestFile);
+    return 0;
+  }
+  std::vector<std::string> paths;
+  std::string line;
+  while (std::getline(manifest, line)) {
+    boost::algorithm::trim(line);
+    if (!line.empty() && line[0] != '#') {
+      paths.push_back(line);
+    }
+  }
+  return prefetchToSnapshotCache(paths, timestamp, metadata);
+}
+
 void CcdbApi::snapshot(std::string const& ccdbrootpath, std::string const& localDir, long timestamp) const
 {
   // query all subpaths to ccdbrootpath
@@ -0,0 +1,163 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file SharedObjectStore.cxx
+
+#include "CCDB/SharedObjectStore.h"
+#include <Framework/Logger.h>
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <fmt/format.h>
+
+namespace o2::ccdb
+{
+
+namespace
+{
+struct EntryHeader {
+  static constexpr std::array<char, 8> Magic{'O', '2', 'C', 'C', 'D', 'B', 'S', 'O'};
+  std::array<char, 8> magic = Magic;
+  uint64_t keySize = 0;       // the key follows the header, to detect hash collisions
+  uint64_t payloadOffset = 0; // multiple of SharedObjectStore::Alignment
+  uint64_t payloadSize = 0;
+};
+
+size_t align(size_t size)
+{
+  return (size + SharedObjectStore::Alignment - 1) / SharedObjectStore::Alignment * SharedObjectStore::Alignment;
+}
+} // namespace
+
+SharedObjectStore::SharedObjectStore(std::string directory) : mDirectory(std::move(directory))
+{
+}
+
+SharedObjectStore::~SharedObjectStore()
+{
+  for (auto& [key, mapping] : mMappings) {
+    munmap(mapping.address, mapping.size);
+  }
+}
+
+SharedObjectStore* SharedObjectStore::instance()
+{
+  static std::unique_ptr<SharedObjectStore> store = []() -> std::unique_ptr<SharedObjectStore> {
+    const char* directory = getenv("ALICEO2_CCDB_SHARED_OBJECTS");
+    if (directory == nullptr || *directory == 0) {
+      return nullptr;
+    }
+    LOGP(info, "Sharing CCDB flat objects between the processes of the node via {}", directory);
+    return std::make_unique<SharedObjectStore>(directory);
+  }();
+  return store.get();
+}
+
+std::string SharedObjectStore::fileName(std::string const& key) const
+{
+  return fmt::format("{}/o2-ccdb-{:016x}", mDirectory, std::hash<std::string>{}(key));
+}
+
+gsl::span<char> SharedObjectStore::get(std::string const& key)
+{
+  auto mapping = mMappings.find(key);
+  if (mapping != mMappings.end()) {
+    return mapping->second.payload;
+  }
+  return map(key, fileName(key));
+}
+
+gsl::span<char> SharedObjectStore::map(std::string const& key, std::string const& file)
+{
+  int fd = open(file.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd == -1) {
+    return {};
+  }
+  struct stat statbuf;
+  if (fstat(fd, &statbuf) == -1 || size_t(statbuf.st_size) < sizeof(EntryHeader)) {
+    close(fd);
+    return {};
+  }
+  size_t size = statbuf.st_size;
+  // Private, so that relocating the objects only copies the pages they modify.
+  void* address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (address == MAP_FAILED) {
+    LOGP(warn, "Failed to map shared CCDB object {}: {}", file, strerror(errno));
+    return {};
+  }
+  auto const& header = *reinterpret_cast<EntryHeader const*>(address);
+  auto* data = static_cast<char*>(address);
+  if (header.magic != EntryHeader::Magic || sizeof(EntryHeader) + header.keySize > size ||
+      std::string_view(data + sizeof(EntryHeader), header.keySize) != key ||
+      header.payloadOffset + header.payloadSize > size) {
+    LOGP(warn, "Ignoring shared CCDB object {}, which is corrupted or does not belong to {}", file, key);
+    munmap(address, size);
+    return {};
+  }
+  auto& mapping = mMappings[key];
+  mapping = Mapping{address, size, gsl::span<char>(data + header.payloadOffset, header.payloadSize)};
+  return mapping.payload;
+}
+
+gsl::span<char> SharedObjectStore::put(std::string const& key, std::initializer_list<gsl::span<const char>> parts)
+{
+  if (auto stored = get(key); !stored.empty()) {
+    return stored;
+  }
+  EntryHeader header;
+  header.keySize = key.size();
+  header.payloadOffset = align(sizeof(EntryHeader) + key.size());
+  for (auto const& part : parts) {
+    header.payloadSize = align(header.payloadSize) + part.size();
+  }
+
+  // Written aside and published by linking, so that readers never see a partial entry
+  // and the first writer wins.
+  auto file = fileName(key);
+  auto tmpFile = fmt::format("{}.{}.tmp", file, getpid());
+  {
+    std::ofstream out(tmpFile, std::ios::binary | std::ios::trunc);
+    static const std::array<char, Alignment> zeros{};
+    size_t offset = 0;
+    auto write = [&out, &offset](char const* data, size_t size) {
+      out.write(data, size);
+      offset += size;
+    };
+    auto pad = [&write, &offset]() { write(zeros.data(), align(offset) - offset); };
+    write(reinterpret_cast<char const*>(&header), sizeof(header));
+    write(key.data(), key.size());
+    for (auto const& part : parts) {
+      pad();
+      write(part.data(), part.size());
+    }
+    if (!out.good()) {
+      LOGP(warn, "Failed to write shared CCDB object {} for {}", tmpFile, key);
+      out.close();
+      unlink(tmpFile.c_str());
+      return {};
+    }
+  }
+  if (link(tmpFile.c_str(), file.c_str()) == -1 && errno != EEXIST) {
+    LOGP(warn, "Failed to publish shared CCDB object {} for {}: {}", file, key, strerror(errno));
+  }
+  unlink(tmpFile.c_str());
+  return map(key, file);
+}
+
+} // namespace o2::ccdb
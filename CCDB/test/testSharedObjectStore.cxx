@@ -0,0 +1,93 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   testSharedObjectStore.cxx
+/// \brief  Test sharing of flat objects via the SharedObjectStore
+///
+
+#define BOOST_TEST_MODULE CCDB
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include "CCDB/SharedObjectStore.h"
+#include <boost/test/unit_test.hpp>
+#include <filesystem>
+#include <numeric>
+#include <unistd.h>
+
+using namespace o2::ccdb;
+
+namespace
+{
+// Minimal object following the FlatObject buffer management protocol
+struct FlatTest {
+  ~FlatTest() { delete[] mContainer; }
+  char* getFlatBufferPtr() const { return mPtr; }
+  size_t getFlatBufferSize() const { return mSize; }
+  void setActualBufferAddress(char* ptr)
+  {
+    mPtr = ptr;
+    mValues = reinterpret_cast<int*>(ptr);
+  }
+  char* releaseInternalBuffer()
+  {
+    auto* buf = mContainer;
+    mContainer = nullptr;
+    return buf;
+  }
+  void adoptInternalBuffer(char* buf) { mContainer = buf; }
+  void clearInternalBufferPtr() { mContainer = nullptr; }
+
+  char* mContainer = nullptr;
+  char* mPtr = nullptr;
+  size_t mSize = 0;
+  int* mValues = nullptr;
+};
+} // namespace
+
+BOOST_AUTO_TEST_CASE(TestSharedObjectStore)
+{
+  auto dir = std::filesystem::temp_directory_path() / ("o2-ccdb-store-test-" + std::to_string(getpid()));
+  std::filesystem::create_directories(dir);
+  {
+    SharedObjectStore store(dir.string());
+    BOOST_CHECK(store.get("missing").empty());
+    std::string a = "abc", b = "defgh";
+    auto blob = store.put("key", {gsl::span<const char>(a.data(), a.size()), gsl::span<const char>(b.data(), b.size())});
+    BOOST_REQUIRE(blob.size() == SharedObjectStore::Alignment + b.size());
+    BOOST_CHECK(std::string(blob.data(), a.size()) == a);
+    BOOST_CHECK(std::string(blob.data() + SharedObjectStore::Alignment, b.size()) == b);
+
+    constexpr int N = 1000;
+    FlatTest obj;
+    obj.mSize = N * sizeof(int);
+    obj.adoptInternalBuffer(new char[obj.mSize]);
+    obj.setActualBufferAddress(obj.mContainer);
+    std::iota(obj.mValues, obj.mValues + N, 0);
+    BOOST_REQUIRE(store.shareFlatObject("Test/Flat", "etag", obj));
+    BOOST_CHECK(obj.mContainer == nullptr);
+    BOOST_CHECK(obj.mValues[N - 1] == N - 1);
+  }
+  {
+    // as seen by another process
+    SharedObjectStore store(dir.string());
+    BOOST_CHECK(store.getFlatObject<FlatTest>("Test/Flat", "other") == nullptr);
+    std::unique_ptr<FlatTest> obj(store.getFlatObject<FlatTest>("Test/Flat", "etag"));
+    BOOST_REQUIRE(obj);
+    BOOST_CHECK(obj->mContainer == nullptr);
+    BOOST_CHECK(reinterpret_cast<uintptr_t>(obj->mPtr) % SharedObjectStore::Alignment == 0);
+    for (int i = 0; i < 1000; i++) {
+      BOOST_CHECK_EQUAL(obj->mValues[i], i);
+    }
+  }
+  std::filesystem::remove_all(dir);
+}
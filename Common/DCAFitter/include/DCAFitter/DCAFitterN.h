@@ -211,6 +211,15 @@ class DCAFitterN
 
   template <class... Tr>
   int process(const Tr&... args);
+  /// same as process(), but with the aux. parameters of the tracks (for the fitter Bz) provided by the caller, e.g. calculated
+  /// only once per track when the same tracks are combined in many candidates
+  template <class... Tr>
+  int processWithAux(const std::array<const TrackAuxPar*, N>& aux, const Tr&... args);
+  /// fast check if the XY circles of 2 tracks are too far from each other for the fit to find any crossing, as in CrossInfo::set
+  bool isFarInXY(const TrackAuxPar& aux0, const TrackAuxPar& aux1) const
+  {
+    return aux0.rC > o2::constants::math::Almost0 && aux1.rC > o2::constants::math::Almost0 && CrossInfo::circlesTooFar(aux0, aux1, mMaxDXYIni);
+  }
   void print() const;
 
   int getFitterID() const { return mFitterID; }
@@ -223,6 +232,7 @@ class DCAFitterN
   void calcResidDerivatives();
   void calcResidDerivativesNoErr();
   void calcRMatrices();
+  int fitPrepared();
   void calcChi2Derivatives();
   void calcChi2DerivativesNoErr();
   void calcPCA();
@@ -357,6 +367,30 @@ int DCAFitterN<N, Args...>::process(const Tr&... args)
   for (int i = 0; i < N; i++) {
     mTrAux[i].set(*mOrigTrPtr[i], mBz);
   }
+  return fitPrepared();
+}
+
+///_________________________________________________________________________
+template <int N, typename... Args>
+template <class... Tr>
+int DCAFitterN<N, Args...>::processWithAux(const std::array<const TrackAuxPar*, N>& aux, const Tr&... args)
+{
+  // fit PCA of N tracks with externally provided aux. parameters
+  mCallID++;
+  static_assert(sizeof...(args) == N, "incorrect number of input tracks");
+  assign(0, args...);
+  clear();
+  for (int i = 0; i < N; i++) {
+    mTrAux[i] = *aux[i];
+  }
+  return fitPrepared();
+}
+
+///_________________________________________________________________________
+template <int N, typename... Args>
+int DCAFitterN<N, Args...>::fitPrepared()
+{
+  // fit PCA of the assigned tracks with already set aux. parameters
   if (!mCrossings.set(mTrAux[0], *mOrigTrPtr[0], mTrAux[1], *mOrigTrPtr[1], mMaxDXYIni, mIsCollinear)) { // even for N>2 it should be enough to test just 1 loop
     return 0;                                                                                            // no crossing
   }
@@ -59,6 +59,14 @@ struct CrossInfo {
   float yDCA[2] = {};
   int nDCA = 0;
 
+  /// true if the circles do not touch and their distance exceeds maxDistXY, i.e. circlesCrossInfo will find no crossing
+  static bool circlesTooFar(const TrackAuxPar& trax0, const TrackAuxPar& trax1, float maxDistXY = MaxDistXYDef)
+  {
+    float xDist = trax1.xC - trax0.xC, yDist = trax1.yC - trax0.yC;
+    float dist2 = xDist * xDist + yDist * yDist, dist = std::sqrt(dist2), rsum = trax0.rC + trax1.rC;
+    return dist > rsum && dist - rsum > maxDistXY;
+  }
+
   int circlesCrossInfo(const TrackAuxPar& trax0, const TrackAuxPar& trax1, float maxDistXY = MaxDistXYDef, bool isCollinear = false)
   {
     const auto& trcA = trax0.rC > trax1.rC ? trax0 : trax1; // designate the largest circle as A
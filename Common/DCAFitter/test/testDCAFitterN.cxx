@@ -552,5 +552,75 @@ BOOST_AUTO_TEST_CASE(DCAFitterNProngs)
   outStream.Close();
 }
 
+BOOST_AUTO_TEST_CASE(DCAFitterNPairScan)
+{
+  // combinatorial scan of all pairs of positive and negative tracks, as in the V0 finder, with the aux. parameters
+  // calculated per pair or once per track
+  constexpr int NDecays = 300;
+  TGenPhaseSpace genPHS;
+  constexpr double pion = 0.13957;
+  constexpr double k0 = 0.49761;
+  std::vector<double> k0dec = {pion, pion};
+  std::vector<int> forceQ{1, 1};
+  std::vector<o2::track::TrackParCov> vctracks, posTracks, negTracks;
+  Vec3D vtxGen;
+  double bz = 5.0;
+  for (int iev = 0; iev < NDecays; iev++) {
+    generate(vtxGen, vctracks, bz, genPHS, k0, k0dec, forceQ);
+    posTracks.push_back(vctracks[0]);
+    negTracks.push_back(vctracks[1]);
+  }
+
+  o2::vertexing::DCAFitterN<2> ft;
+  ft.setBz(bz);
+  ft.setPropagateToPCA(false);
+  ft.setUseAbsDCA(true);
+
+  TStopwatch swPair, swTrack;
+  swPair.Stop();
+  swTrack.Stop();
+  std::vector<int> nCandPair, nCandTrack;
+  std::vector<std::array<float, 3>> pcaPair, pcaTrack;
+
+  swPair.Start(false);
+  for (const auto& trP : posTracks) {
+    for (const auto& trN : negTracks) {
+      int nc = ft.process(trP, trN);
+      nCandPair.push_back(nc);
+      if (nc) {
+        const auto& pca = ft.getPCACandidate();
+        pcaPair.push_back({float(pca[0]), float(pca[1]), float(pca[2])});
+      }
+    }
+  }
+  swPair.Stop();
+
+  swTrack.Start(false);
+  std::vector<o2::track::TrackAuxPar> posAux, negAux;
+  for (const auto& trP : posTracks) {
+    posAux.emplace_back(trP, ft.getBz());
+  }
+  for (const auto& trN : negTracks) {
+    negAux.emplace_back(trN, ft.getBz());
+  }
+  for (size_t ip = 0; ip < posTracks.size(); ip++) {
+    for (size_t in = 0; in < negTracks.size(); in++) {
+      int nc = ft.isFarInXY(posAux[ip], negAux[in]) ? 0 : ft.processWithAux({&posAux[ip], &negAux[in]}, posTracks[ip], negTracks[in]);
+      nCandTrack.push_back(nc);
+      if (nc) {
+        const auto& pca = ft.getPCACandidate();
+        pcaTrack.push_back({float(pca[0]), float(pca[1]), float(pca[2])});
+      }
+    }
+  }
+  swTrack.Stop();
+
+  LOG(info) << "Scanned " << nCandPair.size() << " pairs, CPU time with aux. parameters per pair: " << swPair.CpuTime()
+            << " per track with XY precheck: " << swTrack.CpuTime();
+  BOOST_CHECK(nCandPair == nCandTrack);
+  BOOST_CHECK(pcaPair == pcaTrack);
+  BOOST_CHECK(pcaPair.size() >= NDecays);
+}
+
 } // namespace vertexing
 } // namespace o2
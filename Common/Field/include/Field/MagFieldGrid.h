@@ -0,0 +1,105 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file MagFieldGrid.h
+/// \brief Definition of the tabulated magnetic field MagFieldGrid
+
+#ifndef ALICEO2_FIELD_MAGFIELDGRID_H_
+#define ALICEO2_FIELD_MAGFIELDGRID_H_
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace o2
+{
+namespace field
+{
+/// Magnetic field tabulated on a regular cartesian grid and evaluated by trilinear interpolation.
+/// It is filled once from an exact (e.g. Chebyshev) parametrization of the field and trades memory
+/// for speed: the field at a point needs the 8 surrounding nodes only, without segment search. The
+/// precision is set by the grid step. Queries outside of the grid return false, the caller then
+/// has to fall back to the exact parametrization.
+class MagFieldGrid
+{
+ public:
+  using FieldFunction = std::function<void(const double* xyz, double* b)>;
+
+  MagFieldGrid() = default;
+  /// tabulate the field fun in |x|,|y| <= xyMax, |z| <= zMax with nodes every step cm
+  MagFieldGrid(const FieldFunction& fun, float xyMax = 260.f, float zMax = 260.f, float step = 5.f) { fill(fun, xyMax, zMax, step); }
+  MagFieldGrid(const MagFieldGrid& src) = default;
+  ~MagFieldGrid() = default;
+
+  void fill(const FieldFunction& fun, float xyMax, float zMax, float step);
+
+  bool Field(const double xyz[3], double bxyz[3]) const;
+  bool Field(const float xyz[3], float bxyz[3]) const;
+  bool GetBz(const double xyz[3], double& bz) const;
+  bool GetBz(const float xyz[3], float& bz) const;
+
+  /// scaling factor applied to the tabulated field
+  void setFactor(float v = 1.f) { mFactor = v; }
+  float getFactor() const { return mFactor; }
+
+  float getXYMax() const { return mXYMax; }
+  float getZMax() const { return mZMax; }
+  float getStep() const { return mStep; }
+  /// memory used by the grid nodes
+  size_t getBytes() const { return mB.size() * sizeof(float); }
+
+ private:
+  /// find the cell of a point and the fractional position in it, false if outside the grid
+  bool getCell(float x, float y, float z, size_t& node, float& fx, float& fy, float& fz) const
+  {
+    const float ux = (x + mXYMax) * mInvStep, uy = (y + mXYMax) * mInvStep, uz = (z + mZMax) * mInvStep;
+    if (!(ux >= 0.f && uy >= 0.f && uz >= 0.f)) { // also rejects NaN
+      return false;
+    }
+    const int ix = int(ux), iy = int(uy), iz = int(uz);
+    if (ix >= mNXY - 1 || iy >= mNXY - 1 || iz >= mNZ - 1) {
+      return false;
+    }
+    fx = ux - ix;
+    fy = uy - iy;
+    fz = uz - iz;
+    node = (size_t(iz) * mNXY + iy) * mNXY + ix;
+    return true;
+  }
+  /// interpolate component comp of the 8 nodes of the cell
+  float interpolate(size_t node, int comp, float fx, float fy, float fz) const;
+
+  float mXYMax = 0.f;  ///< half size of the grid in x and y
+  float mZMax = 0.f;   ///< half size of the grid in z
+  float mStep = 1.f;   ///< grid step
+  float mInvStep = 1.f;
+  int mNXY = 0;        ///< number of nodes in x and in y
+  int mNZ = 0;         ///< number of nodes in z
+  float mFactor = 1.f; ///< scaling factor
+  std::vector<float> mB; ///< Bx, By, Bz of the nodes, x running fastest
+};
+
+inline float MagFieldGrid::interpolate(size_t node, int comp, float fx, float fy, float fz) const
+{
+  const size_t dx = 3, dy = 3 * size_t(mNXY), dz = dy * mNXY;
+  const float* b = &mB[3 * node + comp];
+  const float b00 = b[0] + fx * (b[dx] - b[0]);
+  const float b10 = b[dy] + fx * (b[dy + dx] - b[dy]);
+  const float b01 = b[dz] + fx * (b[dz + dx] - b[dz]);
+  const float b11 = b[dz + dy] + fx * (b[dz + dy + dx] - b[dz + dy]);
+  const float b0 = b00 + fy * (b10 - b00);
+  const float b1 = b01 + fy * (b11 - b01);
+  return mFactor * (b0 + fz * (b1 - b0));
+}
+} // namespace field
+} // namespace o2
+
+#endif
@@ -20,6 +20,7 @@
 #include "Field/MagFieldParam.h"
 #include "Field/MagneticWrapperChebyshev.h" // for MagneticWrapperChebyshev
 #include "Field/MagFieldFast.h"
+#include "Field/MagFieldGrid.h"
 #include "TSystem.h"
 #include "Rtypes.h" // for Double_t, Char_t, Int_t, Float_t, etc
 #include "TNamed.h" // for TNamed
@@ -78,6 +79,10 @@ class MagneticField : public FairField
   /// allow fast field param
   void AllowFastField(bool v = true);
 
+  /// allow the field tabulated on a grid with nodes every step cm in |x|,|y| <= xyMax, |z| <= zMax,
+  /// used in this region instead of the exact (and fast) parametrization
+  void AllowGridField(bool v = true, float step = 5.f, float xyMax = 260.f, float zMax = 260.f);
+
   bool fastFieldExists() const
   {
     return !(mMapType == MagFieldParam::k5kGUniform || mDipoleOnOffFlag == true);
@@ -170,6 +175,9 @@ class MagneticField : public FairField
   /// get fast field direct pointer
   const MagFieldFast* getFastField() const { return mFastField.get(); }
 
+  /// get tabulated field direct pointer
+  const MagFieldGrid* getGridField() const { return mGridField.get(); }
+
   // Former MagF methods or their aliases
 
   /// Sets the sign/scale of the current in the L3 according to sPolarityConvention
@@ -253,6 +261,7 @@ class MagneticField : public FairField
  private:
   std::unique_ptr<MagneticWrapperChebyshev> mMeasuredMap; //! Measured part of the field map
   std::unique_ptr<MagFieldFast> mFastField;               // ! optional fast parametrization
+  std::unique_ptr<MagFieldGrid> mGridField;               //! optional tabulated field
   MagFieldParam::BMap_t mMapType;                         ///< field map type
   Double_t mSolenoid;                                     ///< Solenoid field setting
   MagFieldParam::BeamType_t mBeamType;                    ///< Beam type: A-A (mBeamType=0) or p-p (mBeamType=1)
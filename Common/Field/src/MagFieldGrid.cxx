@@ -0,0 +1,105 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file MagFieldGrid.cxx
+/// \brief Implementation of the tabulated magnetic field MagFieldGrid
+
+#include "Field/MagFieldGrid.h"
+#include <fairlogger/Logger.h>
+#include <cmath>
+
+using namespace o2::field;
+
+//_______________________________________________________________________
+void MagFieldGrid::fill(const FieldFunction& fun, float xyMax, float zMax, float step)
+{
+  if (step <= 0.f || xyMax <= 0.f || zMax <= 0.f) {
+    LOG(fatal) << "MagFieldGrid: invalid grid xyMax=" << xyMax << " zMax=" << zMax << " step=" << step;
+  }
+  mStep = step;
+  mInvStep = 1.f / step;
+  mNXY = 1 + int(std::ceil(2.f * xyMax / step));
+  mNZ = 1 + int(std::ceil(2.f * zMax / step));
+  // the grid ends on a node
+  mXYMax = 0.5f * (mNXY - 1) * step;
+  mZMax = 0.5f * (mNZ - 1) * step;
+  mB.resize(size_t(3) * mNXY * mNXY * mNZ);
+
+  double xyz[3], b[3];
+  size_t ib = 0;
+  for (int iz = 0; iz < mNZ; iz++) {
+    xyz[2] = -mZMax + iz * double(step);
+    for (int iy = 0; iy < mNXY; iy++) {
+      xyz[1] = -mXYMax + iy * double(step);
+      for (int ix = 0; ix < mNXY; ix++) {
+        xyz[0] = -mXYMax + ix * double(step);
+        fun(xyz, b);
+        mB[ib++] = b[0];
+        mB[ib++] = b[1];
+        mB[ib++] = b[2];
+      }
+    }
+  }
+  LOG(info) << "MagFieldGrid: tabulated field in |x|,|y|<" << mXYMax << " |z|<" << mZMax << " with step " << step
+            << " cm, " << mNXY << "x" << mNXY << "x" << mNZ << " nodes, " << getBytes() / (1024 * 1024) << " MB";
+}
+
+//_______________________________________________________________________
+bool MagFieldGrid::Field(const double xyz[3], double bxyz[3]) const
+{
+  size_t node;
+  float fx, fy, fz;
+  if (!getCell(xyz[0], xyz[1], xyz[2], node, fx, fy, fz)) {
+    return false;
+  }
+  bxyz[0] = interpolate(node, 0, fx, fy, fz);
+  bxyz[1] = interpolate(node, 1, fx, fy, fz);
+  bxyz[2] = interpolate(node, 2, fx, fy, fz);
+  return true;
+}
+
+//_______________________________________________________________________
+bool MagFieldGrid::Field(const float xyz[3], float bxyz[3]) const
+{
+  size_t node;
+  float fx, fy, fz;
+  if (!getCell(xyz[0], xyz[1], xyz[2], node, fx, fy, fz)) {
+    return false;
+  }
+  bxyz[0] = interpolate(node, 0, fx, fy, fz);
+  bxyz[1] = interpolate(node, 1, fx, fy, fz);
+  bxyz[2] = interpolate(node, 2, fx, fy, fz);
+  return true;
+}
+
+//_______________________________________________________________________
+bool MagFieldGrid::GetBz(const double xyz[3], double& bz) const
+{
+  size_t node;
+  float fx, fy, fz;
+  if (!getCell(xyz[0], xyz[1], xyz[2], node, fx, fy, fz)) {
+    return false;
+  }
+  bz = interpolate(node, 2, fx, fy, fz);
+  return true;
+}
+
+//_______________________________________________________________________
+bool MagFieldGrid::GetBz(const float xyz[3], float& bz) const
+{
+  size_t node;
+  float fx, fy, fz;
+  if (!getCell(xyz[0], xyz[1], xyz[2], node, fx, fy, fz)) {
+    return false;
+  }
+  bz = interpolate(node, 2, fx, fy, fz);
+  return true;
+}
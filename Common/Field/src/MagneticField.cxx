@@ -266,6 +266,9 @@ void MagneticField::Field(const Double_t* __restrict__ xyz, Double_t* __restrict
    */
 
   //  b[0]=b[1]=b[2]=0.0;
+  if (mGridField && mGridField->Field(xyz, b)) {
+    return;
+  }
   if (mFastField && mFastField->Field(xyz, b)) {
     return;
   }
@@ -292,6 +295,12 @@ Double_t MagneticField::getBz(const Double_t* xyz) const
    * query field Bz component at point
    */
 
+  if (mGridField) {
+    double bz = 0;
+    if (mGridField->GetBz(xyz, bz)) {
+      return bz;
+    }
+  }
   if (mFastField) {
     double bz = 0;
     if (mFastField->GetBz(xyz, bz)) {
@@ -329,6 +338,7 @@ MagneticField& MagneticField::operator=(const MagneticField& src)
     mDipoleOnOffFlag = src.mDipoleOnOffFlag;
     mParameterNames = src.mParameterNames;
     mFastField.reset(src.mFastField ? new MagFieldFast(*src.getFastField()) : nullptr);
+    mGridField.reset(src.mGridField ? new MagFieldGrid(*src.getGridField()) : nullptr);
   }
   return *this;
 }
@@ -492,6 +502,9 @@ void MagneticField::setFactorSolenoid(Float_t fc)
   if (mFastField) {
     mFastField->setFactorSol(getFactorSolenoid());
   }
+  if (mGridField) {
+    mGridField->setFactor(mMultipicativeFactorSolenoid);
+  }
 }
 
 void MagneticField::setFactorDipole(Float_t fc)
@@ -726,3 +739,25 @@ void MagneticField::AllowFastField(bool v)
     mFastField.reset(nullptr);
   }
 }
+
+//_____________________________________________________________________________
+void MagneticField::AllowGridField(bool v, float step, float xyMax, float zMax)
+{
+  if (!v) {
+    mGridField.reset(nullptr);
+    return;
+  }
+  if (!mMeasuredMap) {
+    LOG(error) << "MagneticField::AllowGridField: no measured field map to tabulate";
+    return;
+  }
+  // the grid must be inside the measured map and in the solenoid region, where a single scaling factor applies
+  if (-zMax <= mMeasuredMap->getMinZ() || zMax >= mMeasuredMap->getMaxZ() || -zMax <= sSolenoidToDipoleZ) {
+    LOG(error) << "MagneticField::AllowGridField: |z|<" << zMax << " exceeds the measured field map "
+               << mMeasuredMap->getMinZ() << " < z < " << mMeasuredMap->getMaxZ();
+    return;
+  }
+  // tabulate the unscaled map, the factor is applied at the query
+  mGridField = std::make_unique<MagFieldGrid>([this](const double* xyz, double* b) { mMeasuredMap->Field(xyz, b); }, xyMax, zMax, step);
+  mGridField->setFactor(mMultipicativeFactorSolenoid);
+}
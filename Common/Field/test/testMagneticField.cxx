@@ -98,3 +98,86 @@ BOOST_AUTO_TEST_CASE(MagneticField_test)
     BOOST_CHECK(TMath::Abs(rms[i] / nomBz) < 1.e-3);
   }
 }
+
+BOOST_AUTO_TEST_CASE(MagneticField_grid_test)
+{
+  std::unique_ptr<MagneticField> fld = std::make_unique<MagneticField>("Maps", "Maps", 1., 1., o2::field::MagFieldParam::k5kG);
+  const double nomBz = fld->solenoidField();
+
+  const int ntst = 10000;
+  float rnd[3];
+  double xyz[ntst][3] = {}, bxyz[ntst][3] = {};
+  // fill input inside the default grid region
+  for (int it = ntst; it--;) {
+    gRandom->RndmArray(3, rnd);
+    xyz[it][0] = rnd[0] * 250. * TMath::Cos(rnd[1] * TMath::Pi() * 2);
+    xyz[it][1] = rnd[0] * 250. * TMath::Sin(rnd[1] * TMath::Pi() * 2);
+    xyz[it][2] = (rnd[2] - 0.5) * 500;
+  }
+
+  const int repFactor = 50;
+  // timing: exact param
+  TStopwatch swExact;
+  swExact.Start();
+  for (int ii = repFactor; ii--;) {
+    for (int it = ntst; it--;) {
+      fld->Field(xyz[it], bxyz[it]);
+    }
+  }
+  swExact.Stop();
+
+  fld->AllowGridField(true);
+  BOOST_REQUIRE(fld->getGridField() != nullptr);
+
+  // timing: tabulated field
+  TStopwatch swGrid;
+  swGrid.Start();
+  double bgrid[3];
+  for (int ii = repFactor; ii--;) {
+    for (int it = ntst; it--;) {
+      fld->Field(xyz[it], bgrid);
+    }
+  }
+  swGrid.Stop();
+  double sE = swExact.CpuTime() / (ntst * repFactor);
+  double sG = swGrid.CpuTime() / (ntst * repFactor);
+  LOG(info) << "Timing: Exact param: " << sE << " Grid: " << sG << "s/call -> factor " << (sG > 0. ? sE / sG : -1);
+
+  // compare exact/tabulated field precision
+  double mean[3] = {0.}, rms[3] = {0.};
+  const char comp[] = "XYZ";
+  LOG(info) << "Relative precision of tabulated field wrt exact field";
+  for (int it = ntst; it--;) {
+    fld->Field(xyz[it], bgrid);
+    BOOST_CHECK_CLOSE(fld->getBz(xyz[it]), bgrid[2], 1.e-6);
+    for (int i = 0; i < 3; i++) {
+      double df = bxyz[it][i] - bgrid[i];
+      mean[i] += df;
+      rms[i] += df * df;
+    }
+  }
+  for (int i = 0; i < 3; i++) {
+    mean[i] /= ntst;
+    rms[i] /= ntst;
+    rms[i] -= mean[i] * mean[i];
+    rms[i] = TMath::Sqrt(rms[i]);
+    LOG(info) << "deltaB" << comp[i] << ": "
+              << " mean=" << mean[i] << "(" << mean[i] / nomBz * 100. << "%)"
+              << " RMS =" << rms[i] << "(" << rms[i] / nomBz * 100. << "%)";
+    BOOST_CHECK(TMath::Abs(mean[i] / nomBz) < 1.e-3);
+    BOOST_CHECK(TMath::Abs(rms[i] / nomBz) < 1.e-3);
+  }
+
+  // the tabulated field follows the rescaling of the solenoid
+  fld->setFactorSolenoid(-fld->getFactorSolenoid());
+  fld->Field(xyz[0], bgrid);
+  BOOST_CHECK_CLOSE(bgrid[2], -bxyz[0][2], 0.5);
+
+  // outside of the grid the exact param is used
+  double xyzOut[3] = {0., 0., 400.}, bOut[3];
+  fld->Field(xyzOut, bOut);
+  fld->AllowGridField(false);
+  double bOutExact[3];
+  fld->Field(xyzOut, bOutExact);
+  BOOST_CHECK_EQUAL(bOut[2], bOutExact[2]);
+}
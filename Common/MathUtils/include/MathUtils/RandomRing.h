@@ -29,6 +29,7 @@
 #ifndef ALICEO2_MATHUTILS_RANDOMRING_H_
 #define ALICEO2_MATHUTILS_RANDOMRING_H_
 
+#include <algorithm>
 #include <array>
 
 #include "TF1.h"
@@ -86,6 +87,25 @@ class RandomRing
     return value;
   }
 
+  /// next n random values from the ring buffer
+  /// This function is equivalent to n calls of getNextValue,
+  /// but copies contiguous blocks of the ring buffer
+  /// @param [out] values array to be filled with n values
+  /// @param [in] n number of values
+  void getNextValues(float* values, size_t n)
+  {
+    while (n > 0) {
+      const size_t nCopy = std::min(n, mRandomNumbers.size() - mRingPosition);
+      std::copy_n(&mRandomNumbers[mRingPosition], nCopy, values);
+      values += nCopy;
+      n -= nCopy;
+      mRingPosition += nCopy;
+      if (mRingPosition >= mRandomNumbers.size()) {
+        mRingPosition = 0;
+      }
+    }
+  }
+
   /// next vector with random values
   /// This function retuns a Vc vector with random numbers to be
   /// used for vectorised programming and increases the buffer
@@ -449,6 +449,43 @@ double fitGaus(size_t nBins, const T* arr, const T xMin, const T xMax, std::arra
   return np > 3 ? chi2 / (np - 3.) : 0.;
 }
 
+/// Gaussian fits with fitGaus of many histograms with the same binning, e.g. the per-channel histograms of a calibration.
+/// The histograms are stored contiguously: the bins of channel i are arr[i * nBins] ... arr[(i + 1) * nBins - 1].
+/// No ROOT objects are used, so the fits can be done in parallel without any locking.
+/// \param[in]  nChannels number of histograms
+/// \param[in]  nBins number of bins of each histogram
+/// \param[in]  arr contiguous histograms
+/// \param[in]  xMin lower edge of the histograms
+/// \param[in]  xMax upper edge of the histograms
+/// \param[out] params fit parameters (amplitude, mean, sigma) for each channel
+/// \param[out] chi2 return value of fitGaus for each channel (negative in case of failed fits)
+/// \param[in]  minVal, applyMAD see fitGaus
+/// \param[in]  nBinsAroundMax if > 0 only the bins within +-nBinsAroundMax around the maximum of each histogram are fitted
+/// \param[in]  nThreads number of threads (only used if the caller is compiled with OpenMP)
+template <typename T>
+void fitGausBatch(const size_t nChannels, const size_t nBins, const T* arr, const T xMin, const T xMax, std::array<double, 3>* params, double* chi2,
+                  int minVal = 2, bool applyMAD = true, int nBinsAroundMax = -1, int nThreads = 1)
+{
+  const double binW = double(xMax - xMin) / nBins;
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic, 16) num_threads(nThreads)
+#endif
+  for (size_t ich = 0; ich < nChannels; ++ich) {
+    const T* histo = arr + ich * nBins;
+    size_t bStart = 0, bEnd = nBins;
+    if (nBinsAroundMax > 0) {
+      const size_t iMax = std::max_element(histo, histo + nBins) - histo;
+      bStart = iMax > size_t(nBinsAroundMax) ? iMax - nBinsAroundMax : 0;
+      bEnd = std::min(nBins, iMax + nBinsAroundMax + 1);
+    }
+    try {
+      chi2[ich] = fitGaus(bEnd - bStart, histo + bStart, T(xMin + bStart * binW), T(xMin + bEnd * binW), params[ich], nullptr, minVal, applyMAD);
+    } catch (const std::runtime_error&) { // exceptions must not leave the parallel region
+      chi2[ich] = -10;
+    }
+  }
+}
+
 /// struct for returning statistical parameters
 ///
 /// \todo make type templated?
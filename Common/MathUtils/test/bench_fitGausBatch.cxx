@@ -0,0 +1,74 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file   bench_fitGausBatch.cxx
+/// \brief  Benchmark of the batched Gaussian fits of per-channel histograms, for the channel counts of the EMCAL (17664) and of a TOF strip (144)
+
+#include "benchmark/benchmark.h"
+#include "MathUtils/fit.h"
+#include <array>
+#include <random>
+#include <vector>
+
+constexpr int NBins = 1000;
+constexpr float XMax = 1000.f;
+
+// per-channel histograms of Gaussian distributions with random mean and sigma
+std::vector<float> generateHistograms(int nChannels, int nEntries)
+{
+  std::mt19937 gen(1);
+  std::uniform_real_distribution<float> mean(-200.f, 200.f), sigma(50.f, 150.f);
+  const float binsPerUnit = NBins / (2 * XMax);
+  std::vector<float> histos(size_t(nChannels) * NBins);
+  for (int ich = 0; ich < nChannels; ich++) {
+    std::normal_distribution<float> gaus(mean(gen), sigma(gen));
+    for (int i = 0; i < nEntries; i++) {
+      const int bin = (gaus(gen) + XMax) * binsPerUnit;
+      if (bin >= 0 && bin < NBins) {
+        histos[size_t(ich) * NBins + bin] += 1;
+      }
+    }
+  }
+  return histos;
+}
+
+static void BM_fitGausLoop(benchmark::State& state)
+{
+  const int nChannels = state.range(0);
+  const auto histos = generateHistograms(nChannels, state.range(1));
+  std::array<double, 3> params;
+  double sum = 0;
+  for (auto _ : state) {
+    for (int ich = 0; ich < nChannels; ich++) {
+      sum += o2::math_utils::fitGaus(NBins, histos.data() + size_t(ich) * NBins, -XMax, XMax, params, nullptr, 2, true);
+    }
+  }
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations() * nChannels);
+}
+
+static void BM_fitGausBatch(benchmark::State& state)
+{
+  const int nChannels = state.range(0);
+  const auto histos = generateHistograms(nChannels, state.range(1));
+  std::vector<std::array<double, 3>> params(nChannels);
+  std::vector<double> chi2(nChannels);
+  for (auto _ : state) {
+    o2::math_utils::fitGausBatch(nChannels, NBins, histos.data(), -XMax, XMax, params.data(), chi2.data(), 2, true, -1, state.range(2));
+    benchmark::DoNotOptimize(chi2.data());
+  }
+  state.SetItemsProcessed(state.iterations() * nChannels);
+}
+
+BENCHMARK(BM_fitGausLoop)->Args({144, 1000})->Args({17664, 1000})->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_fitGausBatch)->Args({144, 1000, 1})->Args({17664, 1000, 1})->Args({17664, 1000, 4})->Args({17664, 1000, 8})->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK_MAIN();
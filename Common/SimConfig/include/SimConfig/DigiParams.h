@@ -34,6 +34,9 @@ struct DigiParams : public o2::conf::ConfigurableParamHelper<DigiParams> {
                                                       // This parameter should typically be set to coincide with a single timeframe length or multiples thereof.
   std::string passName = "unanchored";                // passName for anchored MC
   int seed = 0;                                       // rndSeed to be applied in digitization; convention is that 0 is time based
+  int bgHitCacheMB = 0;                               // memory (per digitizer) for caching the hits of background events across timeframes in embedding; 0 disables the cache
+  int hitReadCacheMB = 0;                             // TTreeCache size (per hit file) for reading the hits; 0 keeps the ROOT default
+  int hitReadUnzipThreads = 0;                        // if > 0, decompress the cached hit baskets in parallel with ROOT IMT using that many threads
   O2ParamDef(DigiParams, "DigiParams");
 };
 
@@ -50,6 +50,18 @@ struct SimMaterialParams : public o2::conf::ConfigurableParamHelper<SimMaterialP
   O2ParamDef(SimMaterialParams, "SimMaterialParams");
 };
 
+// parameters influencing how the primary server splits an event into chunks (subevents)
+struct SimChunkingParams : public o2::conf::ConfigurableParamHelper<SimChunkingParams> {
+  bool costBalanced = false;  // cut the chunks at equal estimated transport cost instead of equal number of primaries
+  int minParts = 1;           // minimal number of chunks for an event (e.g. the number of workers), split only above chunk size otherwise
+  float energyWeight = 1.f;   // cost of a primary: (1 + energyWeight * E/GeV) ...
+  float forwardEta = 4.f;     // ... times forwardWeight for |eta| above this ...
+  float forwardWeight = 2.f;  // ... and zero for neutrinos
+  float guidedFraction = 0.f; // in [0, 1): the cost of consecutive chunks decreases linearly down to (1 - guidedFraction) of the first one
+
+  O2ParamDef(SimChunkingParams, "SimChunkingParams");
+};
+
 } // namespace conf
 } // namespace o2
 
@@ -118,6 +118,7 @@ class EnumRegistry
 {
  public:
   void add(const std::string& key, const TDataMember* dm);
+  void add(const std::string& key, const EnumLegalValues& legalVals);
 
   bool contains(const std::string& key) const
   {
@@ -249,8 +250,15 @@ class ConfigurableParam
   static void setValues(std::vector<std::pair<std::string, std::string>> const& keyValues);
 
   // initializes the parameter database
+  // (from the snapshot in $ALICEO2_CONFIGURABLEPARAM_SNAPSHOT_DIR when this matches the registered params)
   static void initialize();
 
+  // writes a binary snapshot of the parameter database: keys, types, offsets and default values
+  static void writeSnapshot(std::string const& filename);
+  // initializes the parameter database from a binary snapshot, without ROOT introspection;
+  // returns false (leaving the database untouched) if the snapshot does not match the registered params
+  static bool loadSnapshot(std::string const& filename);
+
   // create CCDB snapsnot
   static void toCCDB(std::string filename);
   // load from (CCDB) snapshot
@@ -279,6 +287,7 @@ class ConfigurableParam
   friend std::ostream& operator<<(std::ostream& out, const ConfigurableParam& me);
 
   static void initPropertyTree();
+  static std::string getSnapshotFileName();
   static EParamUpdateStatus updateThroughStorageMap(std::string, std::string, std::type_info const&, void*);
   static EParamUpdateStatus updateThroughStorageMapWithConversion(std::string const&, std::string const&);
 
@@ -286,6 +295,8 @@ class ConfigurableParam
 
   // fill property tree with the key-values from the sub-classes
   virtual void putKeyValues(boost::property_tree::ptree*) = 0;
+  // size of the concrete parameter class (to validate the offsets of a snapshot)
+  virtual size_t getSizeOf() const = 0;
   virtual void output(std::ostream& out) const = 0;
 
   virtual void serializeTo(TFile*) const = 0;
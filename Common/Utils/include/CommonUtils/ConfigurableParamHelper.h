@@ -156,6 +156,11 @@ class ConfigurableParamHelper : virtual public ConfigurableParam
     _ParamHelper::fillKeyValuesImpl(getName(), cl, (void*)this, tree, sKeyToStorageMap, sEnumRegistry);
   }
 
+  size_t getSizeOf() const final
+  {
+    return sizeof(P);
+  }
+
   // ----------------------------------------------------------------
 
   void initFrom(TFile* file) final
@@ -68,6 +68,7 @@ struct ParameterDebugStreamer : public o2::conf::ConfigurableParamHelper<Paramet
   SamplingTypes samplingType[StreamFlags::streamFlagsCount]{};                                    ///< sampling type for each streamer (default = SamplingTypes::sampleAll)
   float samplingFrequency[StreamFlags::streamFlagsCount]{0.1, 0.1, 0.1, 0.1, 0.1, 0.1, 0.1, 0.1}; ///< frequency which is used for the sampling (0.1 -> 10% is written if sampling is used)
   int sampleIDGlobal[StreamFlags::streamFlagsCount]{};                                            ///< storage of reference streamer used for sampleIDFromOtherStreamer
+  bool asyncWriting{false};                                                                       ///< fill the trees in a background thread per streamer (see TreeStreamRedirector::setAsync)
   O2ParamDef(ParameterDebugStreamer, "DebugStreamerParam");
 };
 
@@ -16,6 +16,7 @@
 #define ALICEO2_FILEFETCHER_H_
 
 #include "CommonUtils/FIFO.h"
+#include <list>
 #include <unordered_map>
 #include <string>
 #include <thread>
@@ -36,11 +37,22 @@ class FileFetcher
     std::string localName{}; // local alias for for remote files
     bool remote = false;
     bool copied = false;
+    size_t copySize = 0; // size of the local copy
+    int nUses = 0;       // number of its entries being fetched or waiting in the queue
 
     const auto& getLocalName() const { return remote ? localName : origName; }
     const auto& getOrigName() const { return origName; }
   };
 
+  struct CopyStats {
+    size_t nCopied = 0;     // number of successful copies of remote files
+    size_t nBytes = 0;      // total size copied
+    double copyTime = 0.;   // total time spent in copying (s), the parallel copies being summed
+    double maxCopyTime = 0; // longest copy time (s)
+    size_t cacheSize = 0;   // current size of the local copies
+    size_t nEvicted = 0;    // number of local copies removed to respect the cache size limit
+  };
+
   /*
   * Create file fetcher with predefined cache and async copy of remote files
   *
@@ -62,6 +74,11 @@ class FileFetcher
   float getFailThreshold() const { return mFailThreshold; }
   void setMaxFilesInQueue(size_t s) { mMaxInQueue = s > 0 ? s : 1; }
   void setMaxLoops(size_t v) { mMaxLoops = v; }
+  void setNCopyThreads(size_t n) { mNCopyThreads = n > 0 ? n : 1; }
+  size_t getNCopyThreads() const { return mNCopyThreads; }
+  void setMaxCacheSize(size_t s) { mMaxCacheSize = s; }
+  size_t getMaxCacheSize() const { return mMaxCacheSize; }
+  CopyStats getCopyStats() const;
   bool isRunning() const { return mRunning; }
   bool isFailed() const { return mFailure; }
   void start();
@@ -86,6 +103,8 @@ class FileFetcher
   bool addInputFile(const std::string& fname);
   std::string createCopyName(const std::string& fname) const;
   bool copyFile(size_t id);
+  void discardCopy(size_t id);
+  void evictCopies();
   bool isRemote(const std::string& fname) const;
   void fetcher();
 
@@ -97,9 +116,13 @@ class FileFetcher
   std::unique_ptr<std::regex> mSelRegex;
   std::unique_ptr<std::regex> mRemRegex;
   std::unordered_map<std::string, size_t> mCopied{};
+  std::list<size_t> mUnusedCopies{}; // copies kept for the next loop, least recently used first
   std::vector<FileRef> mInputFiles{};
   size_t mNRemote{0};
   size_t mMaxInQueue{5};
+  size_t mNCopyThreads{1};
+  size_t mMaxCacheSize{0}; // if > 0, no new copy is started while the local copies (incl. those in flight) exceed this size (bytes)
+  CopyStats mCopyStats{};
   bool mRunning = false;
   bool mNoRemoteCopy = false;
   bool mFailure = false;
@@ -112,7 +135,7 @@ class FileFetcher
   std::mutex mMtxStop;
   std::thread mFetcherThread{};
 
-  ClassDefNV(FileFetcher, 1);
+  ClassDefNV(FileFetcher, 2);
 };
 
 } // namespace utils
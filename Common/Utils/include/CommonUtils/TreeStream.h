@@ -18,6 +18,8 @@
 
 #include <TString.h>
 #include <TTree.h>
+#include <functional>
+#include <memory>
 #include <vector>
 #include "GPUCommonDef.h"
 
@@ -49,9 +51,16 @@ class TreeStream
     std::string name;            ///< name of the element
   };
 
+  /// row of data serialized by Endl() in the asynchronous mode
+  struct Row {
+    std::vector<TreeDataElement> newElements; ///< elements added since the previous row
+    std::vector<char> data;                   ///< serialized values of all elements
+  };
+  using AsyncWriter = std::function<void(TreeStream*, Row&&)>;
+
   TreeStream(const char* treename);
   TreeStream() = default;
-  virtual ~TreeStream() = default;
+  virtual ~TreeStream();
   void Close() { mTree.Write(); }
   Int_t CheckIn(Char_t type, const void* pointer);
   void BuildTree();
@@ -63,6 +72,13 @@ class TreeStream
   const char* getName() const { return mTree.GetName(); }
   void setID(int id) { mID = id; }
   int getID() const { return mID; }
+
+  /// asynchronous mode: Endl() serializes the row and passes it to the writer instead of filling the tree,
+  /// the writer is expected to call fillRow() for the rows in their order, in its own thread.
+  /// The tree must then be accessed only when the writer is idle.
+  void setAsyncWriter(AsyncWriter writer) { mAsyncWriter = std::move(writer); }
+  bool isAsync() const { return bool(mAsyncWriter); }
+  void fillRow(Row& row);
   TreeStream& operator<<(const Bool_t& b)
   {
     CheckIn('B', &b);
@@ -161,6 +177,9 @@ class TreeStream
   Int_t CheckIn(const T* obj);
 
  private:
+  void buildTree(std::vector<TreeDataElement>& elements);
+  void fill(std::vector<TreeDataElement>& elements);
+  Row serializeRow();
   //
   std::vector<TreeDataElement> mElements;
   std::vector<TBranch*> mBranches; ///< pointers to branches
@@ -170,6 +189,13 @@ class TreeStream
   int mNextNameCounter = 0;        ///< next name counter
   int mStatus = 0;                 ///< status of the layout
   TString mNextName;               ///< name for next entry
+  bool mNamesFixed = false;        ///< a row was filled, the names are not changed anymore
+
+  AsyncWriter mAsyncWriter;                               //! consumer of the rows in the asynchronous mode
+  size_t mSentElements = 0;                               //! number of elements already passed to the writer
+  std::vector<TreeDataElement> mWriterElements;           //! elements of the rows filled by the writer
+  std::vector<std::unique_ptr<char[]>> mWriterPrimitives; //! storage of the elementary values of the row being filled
+  std::vector<std::pair<TClass*, void*>> mWriterObjects;  //! storage of the objects of the row being filled
 
   ClassDefNV(TreeStream, 0);
 };
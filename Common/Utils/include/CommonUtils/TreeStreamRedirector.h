@@ -19,6 +19,10 @@
 #include <Rtypes.h>
 #include <TDirectory.h>
 #include "CommonUtils/TreeStream.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
 
 namespace o2
 {
@@ -36,6 +40,10 @@ namespace utils
 /// The flushing of trees to the file happens on TreeStreamRedirector::Close() call
 /// or at its desctruction.
 ///
+/// With setAsync(true) the trees are filled (and their baskets compressed and written) by
+/// a background thread: the rows are serialized at "\n" and queued, so that the streaming
+/// thread pays only for the copy of the data.
+///
 /// See testTreeStream.cxx for functional example
 ///
 class TreeStreamRedirector
@@ -52,14 +60,34 @@ class TreeStreamRedirector
   void SetFile(TFile* sfile);
   static void FixLeafNameBug(TTree* tree);
 
+  /// fill the trees in a background thread, the streaming blocks when maxQueued rows are waiting
+  void setAsync(bool async, size_t maxQueued = 10000);
+  bool isAsync() const { return mWriter.joinable(); }
+  /// wait until all queued rows are filled
+  void waitAsync();
+
  private:
   TreeStreamRedirector(const TreeStreamRedirector& tsr);
   TreeStreamRedirector& operator=(const TreeStreamRedirector& tsr);
 
+  TreeStream& addLayout(const char* name, int id);
+  void enqueue(TreeStream* layout, TreeStream::Row&& row);
+  void writerLoop();
+  void stopWriter();
+
   std::unique_ptr<TDirectory> mOwnDirectory;             // own directory of the redirector
   TDirectory* mDirectory = nullptr;                      // output directory
   std::vector<std::unique_ptr<TreeStream>> mDataLayouts; // array of data layouts
 
+  std::thread mWriter;                                         //! thread filling the trees in the asynchronous mode
+  std::mutex mQueueMutex;                                      //! protection of the queue
+  std::mutex mFileMutex;                                       //! protection of the output directory against concurrent filling and tree creation
+  std::condition_variable mQueueCV;                            //! signals a change of the queue
+  std::deque<std::pair<TreeStream*, TreeStream::Row>> mQueue;  //! rows to be filled
+  size_t mMaxQueued = 0;                                       //! max number of rows in the queue
+  bool mStopWriter = false;                                    //! the writer is to exit once the queue is empty
+  bool mWriterBusy = false;                                    //! the writer is filling a row
+
   ClassDefNV(TreeStreamRedirector, 0);
 };
 } // namespace utils
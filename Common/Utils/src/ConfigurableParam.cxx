@@ -24,6 +24,9 @@
 #include <boost/lexical_cast.hpp>
 #include <algorithm>
 #include <array>
+#include <cstring>
+#include <fstream>
+#include <functional>
 #include <limits>
 #ifdef NDEBUG
 #undef NDEBUG
@@ -39,6 +42,7 @@
 #include "TEnum.h"
 #include "TEnumConstant.h"
 #include <filesystem>
+#include <unistd.h>
 
 namespace o2
 {
@@ -113,6 +117,11 @@ void EnumRegistry::add(const std::string& key, const TDataMember* dm)
   this->entries.insert(entry);
 }
 
+void EnumRegistry::add(const std::string& key, const EnumLegalValues& legalVals)
+{
+  this->entries.emplace(key, legalVals);
+}
+
 std::string EnumRegistry::toString() const
 {
   std::string out = "";
@@ -338,6 +347,10 @@ ConfigurableParam::ConfigurableParam()
 
 void ConfigurableParam::initialize()
 {
+  auto snapshot = getSnapshotFileName();
+  if (!snapshot.empty() && std::filesystem::exists(snapshot) && loadSnapshot(snapshot)) {
+    return;
+  }
   initPropertyTree();
   // initialize the provenance map
   // initially the values come from code
@@ -345,6 +358,272 @@ void ConfigurableParam::initialize()
     sValueProvenanceMap->insert(std::pair<std::string, ConfigurableParam::EParamProvenance>(key.first, kCODE));
   }
   sIsFullyInitialized = true;
+  if (!snapshot.empty()) {
+    writeSnapshot(snapshot);
+  }
+}
+
+// ------------------------------------------------------------------
+
+// Binary snapshot of the parameter database, allowing to initialize it without walking
+// the ROOT dictionaries of every registered class. For each param it stores its size and,
+// for each key, the type, the offset in the param object, the string value of the property
+// tree, the raw default value and the legal enum values.
+// The raw values are compared to the ones of the param objects when loading, such that a
+// snapshot written by a different build of the params is refused rather than misused.
+namespace
+{
+constexpr char SnapshotMagic[8] = {'O', '2', 'C', 'P', 'S', 'N', 'A', 'P'};
+constexpr uint32_t SnapshotVersion = 1;
+
+// the types that the storage map can hold, the index in this table is the type code of the snapshot
+struct SnapshotType {
+  std::type_info const* info;
+  size_t size;
+};
+const std::array<SnapshotType, 15> SnapshotTypes = {{{&typeid(char), sizeof(char)},
+                                                     {&typeid(unsigned char), sizeof(unsigned char)},
+                                                     {&typeid(short), sizeof(short)},
+                                                     {&typeid(unsigned short), sizeof(unsigned short)},
+                                                     {&typeid(int), sizeof(int)},
+                                                     {&typeid(unsigned int), sizeof(unsigned int)},
+                                                     {&typeid(long), sizeof(long)},
+                                                     {&typeid(unsigned long), sizeof(unsigned long)},
+                                                     {&typeid(float), sizeof(float)},
+                                                     {&typeid(double), sizeof(double)},
+                                                     {&typeid(bool), sizeof(bool)},
+                                                     {&typeid(long long), sizeof(long long)},
+                                                     {&typeid(unsigned long long), sizeof(unsigned long long)},
+                                                     {&typeid(std::string), sizeof(std::string)},
+                                                     {nullptr, 0}}};
+constexpr uint8_t SnapshotStringType = 13;
+
+int getSnapshotTypeCode(std::type_info const& ti)
+{
+  for (int i = 0; SnapshotTypes[i].info; i++) {
+    if (*SnapshotTypes[i].info == ti) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+// raw representation of the value at addr, the content for a std::string
+std::string getSnapshotRawValue(uint8_t type, const void* addr)
+{
+  if (type == SnapshotStringType) {
+    return *static_cast<const std::string*>(addr);
+  }
+  return std::string(static_cast<const char*>(addr), SnapshotTypes[type].size);
+}
+
+template <typename T>
+void writeSnapshotValue(std::ostream& out, T value)
+{
+  out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void writeSnapshotValue(std::ostream& out, std::string const& str)
+{
+  writeSnapshotValue<uint32_t>(out, str.size());
+  out.write(str.data(), str.size());
+}
+
+template <typename T>
+bool readSnapshotValue(std::istream& in, T& value)
+{
+  return bool(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+bool readSnapshotValue(std::istream& in, std::string& str)
+{
+  uint32_t size = 0;
+  if (!readSnapshotValue(in, size) || size > (1u << 24)) {
+    return false;
+  }
+  str.resize(size);
+  return bool(in.read(str.data(), size));
+}
+} // namespace
+
+std::string ConfigurableParam::getSnapshotFileName()
+{
+  auto dir = getenv("ALICEO2_CONFIGURABLEPARAM_SNAPSHOT_DIR");
+  if (dir == nullptr || sRegisteredParamClasses == nullptr) {
+    return "";
+  }
+  // the snapshot is only valid for a given set of params, which depends on the loaded libraries
+  std::vector<std::string> names;
+  for (auto p : *sRegisteredParamClasses) {
+    names.push_back(p->getName() + ":" + std::to_string(p->getSizeOf()));
+  }
+  std::sort(names.begin(), names.end());
+  size_t hash = 0;
+  for (auto& name : names) {
+    hash ^= std::hash<std::string>{}(name) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  }
+  return fmt::format("{}/o2-configurable-params-{:016x}.bin", dir, hash);
+}
+
+// ------------------------------------------------------------------
+
+void ConfigurableParam::writeSnapshot(std::string const& filename)
+{
+  if (!sIsFullyInitialized) {
+    initialize();
+  }
+  // write to a private file and move it in place, such that concurrent processes never read a partial snapshot
+  auto tmpname = fmt::format("{}.{}.tmp", filename, getpid());
+  {
+    std::ofstream out(tmpname, std::ios::binary | std::ios::trunc);
+    out.write(SnapshotMagic, sizeof(SnapshotMagic));
+    writeSnapshotValue(out, SnapshotVersion);
+    writeSnapshotValue<uint32_t>(out, sRegisteredParamClasses->size());
+    for (auto p : *sRegisteredParamClasses) {
+      auto name = p->getName();
+      auto base = static_cast<const char*>(dynamic_cast<const void*>(p));
+      auto subtree = sPtree->get_child_optional(name);
+      writeSnapshotValue(out, name);
+      writeSnapshotValue<uint64_t>(out, p->getSizeOf());
+      writeSnapshotValue<uint32_t>(out, subtree ? subtree->size() : 0);
+      if (!subtree) {
+        continue;
+      }
+      for (auto& entry : *subtree) {
+        auto key = name + "." + entry.first;
+        auto iter = sKeyToStorageMap->find(key);
+        int type = iter != sKeyToStorageMap->end() ? getSnapshotTypeCode(iter->second.first) : -1;
+        if (type < 0) {
+          LOG(warn) << "ConfigurableParam: cannot write snapshot with the unsupported key " << key;
+          out.close();
+          std::filesystem::remove(tmpname);
+          return;
+        }
+        auto addr = static_cast<const char*>(iter->second.second);
+        auto enumValues = (*sEnumRegistry)[key];
+        writeSnapshotValue(out, entry.first);
+        writeSnapshotValue<uint8_t>(out, type);
+        writeSnapshotValue<uint64_t>(out, addr - base);
+        writeSnapshotValue(out, entry.second.data());
+        writeSnapshotValue(out, getSnapshotRawValue(type, addr));
+        writeSnapshotValue<uint32_t>(out, enumValues ? enumValues->vvalues.size() : 0);
+        if (enumValues) {
+          for (auto& v : enumValues->vvalues) {
+            writeSnapshotValue(out, v.first);
+            writeSnapshotValue<int32_t>(out, v.second);
+          }
+        }
+      }
+    }
+    if (!out) {
+      LOG(warn) << "ConfigurableParam: failed to write snapshot " << filename;
+      out.close();
+      std::filesystem::remove(tmpname);
+      return;
+    }
+  }
+  std::error_code ec;
+  std::filesystem::rename(tmpname, filename, ec);
+  if (ec) {
+    LOG(warn) << "ConfigurableParam: failed to write snapshot " << filename << " : " << ec.message();
+    std::filesystem::remove(tmpname, ec);
+  }
+}
+
+// ------------------------------------------------------------------
+
+bool ConfigurableParam::loadSnapshot(std::string const& filename)
+{
+  if (sIsFullyInitialized) {
+    LOG(warn) << "ConfigurableParam: ignoring snapshot " << filename << " for the already initialized parameters";
+    return false;
+  }
+  std::ifstream in(filename, std::ios::binary);
+  auto refuse = [&filename](const char* reason) {
+    LOG(info) << "ConfigurableParam: not using snapshot " << filename << " : " << reason;
+    return false;
+  };
+  char magic[sizeof(SnapshotMagic)];
+  uint32_t version = 0, nParams = 0;
+  if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, SnapshotMagic, sizeof(magic)) != 0 ||
+      !readSnapshotValue(in, version) || version != SnapshotVersion) {
+    return refuse("not a snapshot of this version");
+  }
+  if (!readSnapshotValue(in, nParams) || nParams != sRegisteredParamClasses->size()) {
+    return refuse("different number of params");
+  }
+  std::unordered_map<std::string, ConfigurableParam*> params;
+  for (auto p : *sRegisteredParamClasses) {
+    params.emplace(p->getName(), p);
+  }
+
+  // everything is validated before the database is changed
+  struct Key {
+    std::string name, value;
+    std::type_info const* type;
+    void* addr;
+    EnumLegalValues enumValues;
+  };
+  std::vector<std::pair<std::string, std::vector<Key>>> contents;
+  for (uint32_t ip = 0; ip < nParams; ip++) {
+    std::string name;
+    uint64_t size = 0;
+    uint32_t nKeys = 0;
+    if (!readSnapshotValue(in, name) || !readSnapshotValue(in, size) || !readSnapshotValue(in, nKeys)) {
+      return refuse("truncated file");
+    }
+    if (nKeys > size) {
+      return refuse("corrupted file");
+    }
+    auto iter = params.find(name);
+    if (iter == params.end() || iter->second->getSizeOf() != size) {
+      return refuse("different params");
+    }
+    auto base = static_cast<char*>(dynamic_cast<void*>(iter->second));
+    auto& keys = contents.emplace_back(name, std::vector<Key>(nKeys)).second;
+    for (auto& key : keys) {
+      uint8_t type = 0;
+      uint64_t offset = 0;
+      uint32_t nEnumValues = 0;
+      std::string raw;
+      if (!readSnapshotValue(in, key.name) || !readSnapshotValue(in, type) || !readSnapshotValue(in, offset) ||
+          !readSnapshotValue(in, key.value) || !readSnapshotValue(in, raw) || !readSnapshotValue(in, nEnumValues)) {
+        return refuse("truncated file");
+      }
+      if (type >= SnapshotTypes.size() - 1 || offset + SnapshotTypes[type].size > size) {
+        return refuse("corrupted file");
+      }
+      key.type = SnapshotTypes[type].info;
+      key.addr = base + offset;
+      if (getSnapshotRawValue(type, key.addr) != raw) {
+        return refuse("different default values");
+      }
+      for (uint32_t ie = 0; ie < nEnumValues; ie++) {
+        std::pair<std::string, int32_t> value;
+        if (!readSnapshotValue(in, value.first) || !readSnapshotValue(in, value.second)) {
+          return refuse("truncated file");
+        }
+        key.enumValues.vvalues.emplace_back(value);
+      }
+    }
+  }
+
+  sPtree->clear();
+  for (auto& [name, keys] : contents) {
+    boost::property_tree::ptree localtree;
+    for (auto& key : keys) {
+      auto fullkey = name + "." + key.name;
+      localtree.put(key.name, key.value);
+      sKeyToStorageMap->emplace(fullkey, std::pair<std::type_info const&, void*>(*key.type, key.addr));
+      sValueProvenanceMap->emplace(fullkey, kCODE);
+      if (!key.enumValues.vvalues.empty()) {
+        sEnumRegistry->add(fullkey, key.enumValues);
+      }
+    }
+    sPtree->add_child(name, localtree);
+  }
+  sIsFullyInitialized = true;
+  return true;
 }
 
 // ------------------------------------------------------------------
@@ -32,6 +32,9 @@ void o2::utils::DebugStreamer::setStreamer(const char* outFile, const char* opti
 {
   if (!isStreamerSet(id)) {
     mTreeStreamer[id] = std::make_unique<o2::utils::TreeStreamRedirector>(fmt::format("{}_{}.root", outFile, id).data(), option);
+    if (ParameterDebugStreamer::Instance().asyncWriting) {
+      mTreeStreamer[id]->setAsync(true);
+    }
   }
 }
 
@@ -18,6 +18,8 @@
 #include "Framework/Logger.h"
 #include <filesystem>
 #include <fstream>
+#include <future>
+#include <deque>
 #include <memory>
 #include <thread>
 #include <chrono>
@@ -183,8 +185,12 @@ size_t FileFetcher::popFromQueue(bool discard)
   }
   auto id = mQueue.front();
   mQueue.pop();
+  auto& fileRef = mInputFiles[id];
+  fileRef.nUses--;
   if (discard) {
-    discardFile(mInputFiles[id].getLocalName());
+    discardCopy(id);
+  } else if (mMaxCacheSize && fileRef.copied && !fileRef.nUses) { // keep for the next loop, unless the cache space is needed
+    mUnusedCopies.push_back(id);
   }
   return id;
 }
@@ -242,11 +248,24 @@ void FileFetcher::cleanup()
   }
 }
 
+//____________________________________________________________
+FileFetcher::CopyStats FileFetcher::getCopyStats() const
+{
+  std::lock_guard<std::mutex> lock(mMtx);
+  return mCopyStats;
+}
+
 //____________________________________________________________
 void FileFetcher::fetcher()
 {
-  // data fetching/copying thread
-  size_t fileEntry = -1ul;
+  // data fetching/copying thread: up to mNCopyThreads remote files are copied in parallel,
+  // the files are added to the queue in the input order
+  struct Fetch {
+    size_t id = -1ul;
+    std::future<bool> copy{}; // invalid if no copy is needed
+  };
+  std::deque<Fetch> fetches;
+  size_t fileEntry = -1ul, nCopying = 0;
 
   if (!getNFiles()) {
     mRunning = false;
@@ -267,46 +286,103 @@ void FileFetcher::fetcher()
     }
   }
 
+  if (mNRemote && !mNoRemoteCopy && mCopyCmd.find("alien") != std::string::npos && !gGrid && !TGrid::Connect("alien://")) {
+    LOG(error) << "Copy command refers to alien but connection to Grid failed";
+  }
+
   while (mRunning) {
+    // move the finished fetches to the queue, in the input order
+    while (!fetches.empty() && (!fetches.front().copy.valid() || fetches.front().copy.wait_for(0ms) == std::future_status::ready)) {
+      auto& fetch = fetches.front();
+      bool ok = true;
+      if (fetch.copy.valid()) {
+        ok = fetch.copy.get();
+        nCopying--;
+      }
+      if (ok) {
+        mQueue.push(fetch.id);
+        mNFilesProcOK++;
+      } else {
+        {
+          std::lock_guard<std::mutex> lock(mMtx);
+          mInputFiles[fetch.id].nUses--;
+        }
+        if (mFailThreshold < 0.f) { // cut on abs number of failures
+          if (mNFilesProc - mNFilesProcOK > -mNFilesProcOK) {
+            mFailure = true;
+          }
+        } else if (mFailThreshold > 0.f) {
+          float fracFail = mNLoops ? (mNFilesProc - mNFilesProcOK) / float(mNFilesProc) : (mNFilesProc - mNFilesProcOK) / float(getNFiles());
+          mFailure = fracFail > mFailThreshold;
+        }
+      }
+      fetches.pop_front();
+      if (mFailure) {
+        mRunning = false;
+        break;
+      }
+    }
+    if (!mRunning) {
+      break;
+    }
     mNLoops = mNFilesProc / getNFiles();
     if (mNLoops > mMaxLoops) {
+      if (!fetches.empty()) { // let the pending copies finish
+        std::this_thread::sleep_for(5ms);
+        continue;
+      }
       LOGP(info, "Finished file fetching: {} of {} files fetched successfully in {} iterations", mNFilesProcOK, mNFilesProc, mMaxLoops);
       mRunning = false;
       break;
     }
-    if (getQueueSize() >= mMaxInQueue) {
+    if (getQueueSize() + fetches.size() >= mMaxInQueue) {
       std::this_thread::sleep_for(5ms);
       continue;
     }
-    fileEntry = (fileEntry + 1) % getNFiles();
+    const auto nextEntry = (fileEntry + 1) % getNFiles();
+    auto& fileRef = mInputFiles[nextEntry];
+    bool needCopy = false, wait = false;
+    {
+      std::lock_guard<std::mutex> lock(mMtx);
+      needCopy = fileRef.remote && !fileRef.copied && !mNoRemoteCopy;
+      wait = needCopy && fileRef.nUses; // the same file is still being copied
+    }
+    if (needCopy && !wait) {
+      wait = nCopying >= mNCopyThreads;
+      if (!wait && mMaxCacheSize) {
+        evictCopies();
+        std::lock_guard<std::mutex> lock(mMtx);
+        // account for the copies in flight with the mean file size, wait for the space to be freed unless nothing is available to the consumer
+        size_t expSize = mCopyStats.cacheSize + (mCopyStats.nCopied ? nCopying * mCopyStats.nBytes / mCopyStats.nCopied : 0);
+        wait = expSize >= mMaxCacheSize && (nCopying || !mQueue.empty());
+      }
+    }
+    if (wait) {
+      std::this_thread::sleep_for(5ms);
+      continue;
+    }
+    fileEntry = nextEntry;
     if (fileEntry == 0 && mNLoops > 0) {
       LOG(info) << "Fetcher starts new iteration " << mNLoops;
     }
     mNFilesProc++;
-    auto& fileRef = mInputFiles[fileEntry];
-    if (fileRef.copied || !fileRef.remote || mNoRemoteCopy) {
-      mQueue.push(fileEntry);
-      mNFilesProcOK++;
-    } else { // need to copy
-      if (copyFile(fileEntry)) {
-        fileRef.copied = true;
-        mQueue.push(fileEntry);
-        mNFilesProcOK++;
-      } else {
-        if (mFailThreshold < 0.f) { // cut on abs number of failures
-          if (mNFilesProc - mNFilesProcOK > -mNFilesProcOK) {
-            mFailure = true;
-          }
-        } else if (mFailThreshold > 0.f) {
-          float fracFail = mNLoops ? (mNFilesProc - mNFilesProcOK) / float(mNFilesProc) : (mNFilesProc - mNFilesProcOK) / float(getNFiles());
-          mFailure = fracFail > mFailThreshold;
-        }
-        if (mFailure) {
-          mRunning = false;
-          break;
-        }
+    {
+      std::lock_guard<std::mutex> lock(mMtx);
+      if (!fileRef.nUses++ && fileRef.copied) { // the copy is in use again
+        mUnusedCopies.remove(fileEntry);
       }
     }
+    auto& fetch = fetches.emplace_back();
+    fetch.id = fileEntry;
+    if (needCopy) {
+      fetch.copy = std::async(std::launch::async, &FileFetcher::copyFile, this, fileEntry);
+      nCopying++;
+    }
+  }
+  for (auto& fetch : fetches) { // the copies in flight are abandoned, their files are removed in the cleanup
+    if (fetch.copy.valid()) {
+      fetch.copy.wait();
+    }
   }
 }
 
@@ -314,11 +390,37 @@ void FileFetcher::fetcher()
 void FileFetcher::discardFile(const std::string& fname)
 {
   // delete file if it is copied.
+  std::lock_guard<std::mutex> lock(mMtx);
   auto ent = mCopied.find(fname);
   if (ent != mCopied.end()) {
-    mInputFiles[ent->second - 1].copied = false;
-    fs::remove(fname);
-    mCopied.erase(fname);
+    discardCopy(ent->second - 1);
+  }
+}
+
+//____________________________________________________________
+void FileFetcher::discardCopy(size_t id)
+{
+  // delete the local copy of the file, if any, to be called with mMtx locked
+  auto& fileRef = mInputFiles[id];
+  if (!fileRef.copied) {
+    return;
+  }
+  fs::remove(fileRef.getLocalName());
+  mCopied.erase(fileRef.getLocalName());
+  mUnusedCopies.remove(id);
+  mCopyStats.cacheSize -= fileRef.copySize;
+  fileRef.copySize = 0;
+  fileRef.copied = false;
+}
+
+//____________________________________________________________
+void FileFetcher::evictCopies()
+{
+  // remove the least recently used copies not in the queue until the cache fits its size limit
+  std::lock_guard<std::mutex> lock(mMtx);
+  while (mCopyStats.cacheSize >= mMaxCacheSize && !mUnusedCopies.empty()) {
+    discardCopy(mUnusedCopies.front());
+    mCopyStats.nEvicted++;
   }
 }
 
@@ -326,30 +428,26 @@ void FileFetcher::discardFile(const std::string& fname)
 bool FileFetcher::copyFile(size_t id)
 {
   // copy remote file to local setCopyDirName. Adaptation for Gvozden's code from SubTimeFrameFileSource::DataFetcherThread()
-  bool aliencpMode = false;
-  std::string uuid{};
+  // may run in parallel for different files, the debug log settings are passed in the environment of the command only
+  std::string uuid{}, cmdEnv{};
   std::vector<std::string> logsToClean;
   if (mCopyCmd.find("alien") != std::string::npos) {
-    if (!gGrid && !TGrid::Connect("alien://")) {
-      LOG(error) << "Copy command refers to alien but connection to Grid failed";
-    }
     uuid = mInputFiles[id].getOrigName();
     for (auto& c : uuid) {
       if (!std::isalnum(c) && c != '-') {
         c = '_';
       }
     }
-    gSystem->Setenv("ALIENPY_DEBUG", "1");
     logsToClean.push_back(fmt::format("log_alienpy_{}.txt", uuid));
-    gSystem->Setenv("ALIENPY_DEBUG_FILE", logsToClean.back().c_str());
-    gSystem->Setenv("XRD_LOGLEVEL", "Dump");
     logsToClean.push_back(fmt::format("log_xrd_{}.txt", uuid));
-    gSystem->Setenv("XRD_LOGFILE", logsToClean.back().c_str());
+    cmdEnv = fmt::format("ALIENPY_DEBUG=1 ALIENPY_DEBUG_FILE={} XRD_LOGLEVEL=Dump XRD_LOGFILE={} ", logsToClean[0], logsToClean[1]);
   }
   auto realCmd = std::regex_replace(std::regex_replace(mCopyCmd, std::regex(R"(\?src)"), mInputFiles[id].getOrigName()), std::regex(R"(\?dst)"), mInputFiles[id].getLocalName());
-  auto fullCmd = fmt::format(R"(sh -c "{}" >> {}  2>&1)", realCmd, mCopyCmdLogFile);
+  auto fullCmd = fmt::format(R"({}sh -c "{}" >> {}  2>&1)", cmdEnv, realCmd, mCopyCmdLogFile);
   LOG(info) << "Executing " << fullCmd;
+  const auto tStart = std::chrono::steady_clock::now();
   const auto sysRet = gSystem->Exec(fullCmd.c_str());
+  const double copyTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - tStart).count();
   if (sysRet != 0) {
     LOGP(warning, "FileFetcher: non-zero exit code {} for cmd={}", sysRet, realCmd);
     std::string logCmd = fmt::format(R"(sh -c "cp {} log_aliencp_{}.txt")", mCopyCmdLogFile, uuid);
@@ -365,6 +463,15 @@ bool FileFetcher::copyFile(size_t id)
     LOGP(alarm, "FileFetcher: failed for copy command {}", realCmd);
     return false;
   }
-  mCopied[mInputFiles[id].getLocalName()] = id + 1;
+  std::lock_guard<std::mutex> lock(mMtx);
+  auto& fileRef = mInputFiles[id];
+  fileRef.copySize = fs::file_size(fileRef.getLocalName());
+  fileRef.copied = true;
+  mCopied[fileRef.getLocalName()] = id + 1;
+  mCopyStats.nCopied++;
+  mCopyStats.nBytes += fileRef.copySize;
+  mCopyStats.cacheSize += fileRef.copySize;
+  mCopyStats.copyTime += copyTime;
+  mCopyStats.maxCopyTime = std::max(mCopyStats.maxCopyTime, copyTime);
   return true;
 }
@@ -13,9 +13,31 @@
 
 #include "CommonUtils/TreeStream.h"
 #include <TBranch.h>
+#include <TBufferFile.h>
 
 using namespace o2::utils;
 
+namespace
+{
+int elementSize(char type)
+{
+  switch (type) {
+    case 'B':
+    case 'b':
+      return 1;
+    case 'S':
+    case 's':
+      return 2;
+    case 'I':
+    case 'i':
+    case 'F':
+      return 4;
+    default:
+      return 8;
+  }
+}
+} // namespace
+
 //_________________________________________________
 TreeStream::TreeStream(const char* treename) : mTree(treename, treename)
 {
@@ -23,6 +45,16 @@ TreeStream::TreeStream(const char* treename) : mTree(treename, treename)
   // Standard ctor
 }
 
+//_________________________________________________
+TreeStream::~TreeStream()
+{
+  for (auto& obj : mWriterObjects) {
+    if (obj.second) {
+      obj.first->Destructor(obj.second);
+    }
+  }
+}
+
 //_________________________________________________
 int TreeStream::CheckIn(Char_t type, const void* pointer)
 {
@@ -56,19 +88,25 @@ int TreeStream::CheckIn(Char_t type, const void* pointer)
 
 //_________________________________________________
 void TreeStream::BuildTree()
+{
+  buildTree(mElements);
+}
+
+//_________________________________________________
+void TreeStream::buildTree(std::vector<TreeDataElement>& elements)
 {
   // Build the Tree
 
   int entriesFilled = mTree.GetEntries();
-  if (mBranches.size() < mElements.size()) {
-    mBranches.resize(mElements.size());
+  if (mBranches.size() < elements.size()) {
+    mBranches.resize(elements.size());
   }
 
   TString name;
   TBranch* br = nullptr;
-  for (int i = 0; i < static_cast<int>(mElements.size()); i++) {
+  for (int i = 0; i < static_cast<int>(elements.size()); i++) {
     //
-    auto& element = mElements[i];
+    auto& element = elements[i];
     if (mBranches[i]) {
       continue;
     }
@@ -105,15 +143,21 @@ void TreeStream::BuildTree()
 
 //_________________________________________________
 void TreeStream::Fill()
+{
+  fill(mElements);
+}
+
+//_________________________________________________
+void TreeStream::fill(std::vector<TreeDataElement>& elements)
 {
   // Fill the tree
 
-  int entries = mElements.size();
+  int entries = elements.size();
   if (entries > mTree.GetNbranches()) {
-    BuildTree();
+    buildTree(elements);
   }
   for (int i = 0; i < entries; i++) {
-    auto& element = mElements[i];
+    auto& element = elements[i];
     if (!element.type) {
       continue;
     }
@@ -126,19 +170,91 @@ void TreeStream::Fill()
   }
   if (!mStatus) {
     mTree.Fill(); // fill only in case of non conflicts
+    if (!mAsyncWriter) {
+      mNamesFixed = true;
+    }
   }
   mStatus = 0;
 }
 
+//_________________________________________________
+TreeStream::Row TreeStream::serializeRow()
+{
+  // Serialize the values of the current row, together with the description of the new elements
+
+  Row row;
+  for (; mSentElements < mElements.size(); mSentElements++) {
+    row.newElements.push_back(mElements[mSentElements]);
+  }
+  TBufferFile buf(TBuffer::kWrite);
+  for (auto& element : mElements) {
+    if (element.type > 0) {
+      buf.WriteFastArray(static_cast<const char*>(element.ptr), elementSize(element.type));
+      continue;
+    }
+    const TClass* cls = element.ptr ? element.cls : nullptr;
+    buf.WriteFastArray(reinterpret_cast<const char*>(&cls), sizeof(cls));
+    if (cls) {
+      cls->Streamer(const_cast<void*>(element.ptr), buf);
+    }
+  }
+  row.data.assign(buf.Buffer(), buf.Buffer() + buf.Length());
+  return row;
+}
+
+//_________________________________________________
+void TreeStream::fillRow(Row& row)
+{
+  // Fill the tree with a row serialized by serializeRow, the values are read to the storage owned by the stream
+
+  for (auto& newElement : row.newElements) {
+    auto& element = mWriterElements.emplace_back(newElement);
+    mWriterPrimitives.emplace_back(element.type > 0 ? new char[sizeof(Long64_t)]() : nullptr);
+    mWriterObjects.emplace_back(nullptr, nullptr);
+    element.ptr = mWriterPrimitives.back().get();
+  }
+  TBufferFile buf(TBuffer::kRead, row.data.size(), row.data.data(), kFALSE);
+  for (size_t i = 0; i < mWriterElements.size(); i++) {
+    auto& element = mWriterElements[i];
+    if (element.type > 0) {
+      buf.ReadFastArray(mWriterPrimitives[i].get(), elementSize(element.type));
+      continue;
+    }
+    const TClass* cls = nullptr;
+    buf.ReadFastArray(reinterpret_cast<char*>(&cls), sizeof(cls));
+    element.ptr = nullptr;
+    if (cls) {
+      auto& obj = mWriterObjects[i];
+      if (!obj.second) {
+        obj = {const_cast<TClass*>(cls), cls->New()};
+      }
+      cls->Streamer(obj.second, buf);
+      element.cls = cls;
+      element.ptr = obj.second;
+    }
+  }
+  if (mTree.GetNbranches() == 0) {
+    buildTree(mWriterElements);
+  }
+  fill(mWriterElements);
+}
+
 //_________________________________________________
 TreeStream& TreeStream::Endl()
 {
   // Perform pseudo endl operation
 
-  if (mTree.GetNbranches() == 0) {
-    BuildTree();
+  if (mAsyncWriter) {
+    if (!mStatus) { // as in Fill, pass only rows w/o conflicts
+      mAsyncWriter(this, serializeRow());
+      mNamesFixed = true;
+    }
+  } else {
+    if (mTree.GetNbranches() == 0) {
+      BuildTree();
+    }
+    Fill();
   }
-  Fill();
   mStatus = 0;
   mCurrentIndex = 0;
   return *this;
@@ -154,7 +270,7 @@ TreeStream& TreeStream::operator<<(const Char_t* name)
   }
   //
   // if tree was already defined ignore
-  if (mTree.GetEntries() > 0) {
+  if (mNamesFixed) {
     return *this;
   }
   // check branch name if tree was not
@@ -14,6 +14,7 @@
 #include "CommonUtils/TreeStreamRedirector.h"
 #include <TFile.h>
 #include <TLeaf.h>
+#include <algorithm>
 #include <cstring>
 
 using namespace o2::utils;
@@ -53,6 +54,7 @@ void TreeStreamRedirector::SetDirectory(TDirectory* sfile)
   // In case other directory already attached old file is closed before
   // Redirector will be the owner of file ?
 
+  waitAsync();
   if (mOwnDirectory) {
     mDirectory->Close();
     mOwnDirectory.reset();
@@ -71,16 +73,7 @@ TreeStream& TreeStreamRedirector::operator<<(Int_t id)
       return *layout.get();
     }
   }
-
-  TDirectory* backup = gDirectory;
-  mDirectory->cd();
-  mDataLayouts.emplace_back(std::unique_ptr<TreeStream>(new TreeStream(Form("Tree%d", id))));
-  auto layout = mDataLayouts.back().get();
-  layout->setID(id);
-  if (backup) {
-    backup->cd();
-  }
-  return *layout;
+  return addLayout(Form("Tree%d", id), id);
 }
 
 //_________________________________________________
@@ -94,23 +87,113 @@ TreeStream& TreeStreamRedirector::operator<<(const char* name)
       return *layout.get();
     }
   }
+  return addLayout(name, -1);
+}
 
-  // create new
+//_________________________________________________
+TreeStream& TreeStreamRedirector::addLayout(const char* name, int id)
+{
+  // create new data layout in the output directory
+  std::lock_guard<std::mutex> lock(mFileMutex);
   TDirectory* backup = gDirectory;
   mDirectory->cd();
   mDataLayouts.emplace_back(std::unique_ptr<TreeStream>(new TreeStream(name)));
   auto layout = mDataLayouts.back().get();
-  layout->setID(-1);
+  layout->setID(id);
+  if (mWriter.joinable()) {
+    layout->setAsyncWriter([this](TreeStream* stream, TreeStream::Row&& row) { enqueue(stream, std::move(row)); });
+  }
   if (backup) {
     backup->cd();
   }
   return *layout;
 }
 
+//_________________________________________________
+void TreeStreamRedirector::setAsync(bool async, size_t maxQueued)
+{
+  if (async == mWriter.joinable()) {
+    return;
+  }
+  if (!async) {
+    stopWriter();
+    for (auto& layout : mDataLayouts) {
+      layout->setAsyncWriter({});
+    }
+    return;
+  }
+  mMaxQueued = std::max(size_t(1), maxQueued);
+  mStopWriter = false;
+  mWriter = std::thread(&TreeStreamRedirector::writerLoop, this);
+  for (auto& layout : mDataLayouts) {
+    layout->setAsyncWriter([this](TreeStream* stream, TreeStream::Row&& row) { enqueue(stream, std::move(row)); });
+  }
+}
+
+//_________________________________________________
+void TreeStreamRedirector::enqueue(TreeStream* layout, TreeStream::Row&& row)
+{
+  std::unique_lock<std::mutex> lock(mQueueMutex);
+  mQueueCV.wait(lock, [this] { return mQueue.size() < mMaxQueued; });
+  mQueue.emplace_back(layout, std::move(row));
+  mQueueCV.notify_all();
+}
+
+//_________________________________________________
+void TreeStreamRedirector::writerLoop()
+{
+  std::unique_lock<std::mutex> lock(mQueueMutex);
+  while (true) {
+    mQueueCV.wait(lock, [this] { return mStopWriter || !mQueue.empty(); });
+    if (mQueue.empty()) {
+      break; // stop requested and all rows filled
+    }
+    auto entry = std::move(mQueue.front());
+    mQueue.pop_front();
+    mWriterBusy = true;
+    mQueueCV.notify_all();
+    lock.unlock();
+    {
+      std::lock_guard<std::mutex> fileLock(mFileMutex);
+      TDirectory* backup = gDirectory;
+      mDirectory->cd();
+      entry.first->fillRow(entry.second);
+      if (backup) {
+        backup->cd();
+      }
+    }
+    lock.lock();
+    mWriterBusy = false;
+    mQueueCV.notify_all();
+  }
+}
+
+//_________________________________________________
+void TreeStreamRedirector::waitAsync()
+{
+  std::unique_lock<std::mutex> lock(mQueueMutex);
+  mQueueCV.wait(lock, [this] { return mQueue.empty() && !mWriterBusy; });
+}
+
+//_________________________________________________
+void TreeStreamRedirector::stopWriter()
+{
+  if (!mWriter.joinable()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mQueueMutex);
+    mStopWriter = true;
+  }
+  mQueueCV.notify_all();
+  mWriter.join();
+}
+
 //_________________________________________________
 void TreeStreamRedirector::Close()
 {
   // flush and close
+  stopWriter(); // fill the queued rows
   if (!mDirectory) {
     return;
   }
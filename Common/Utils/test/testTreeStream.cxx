@@ -107,6 +107,50 @@ BOOST_AUTO_TEST_CASE(TreeStream_test)
   //
 }
 
+BOOST_AUTO_TEST_CASE(TreeStreamAsync_test)
+{
+  // the same content is written by the background thread of the redirector
+  std::string outFName("testTreeStreamAsync.root");
+  const int nit = 1000;
+  {
+    TreeStreamRedirector tstStream(outFName.data(), "recreate");
+    tstStream.setAsync(true, 100);
+    BOOST_CHECK(tstStream.isAsync());
+    std::array<float, o2::track::kNParams> par{};
+    for (int i = 0; i < nit; i++) {
+      par[o2::track::kQ2Pt] = 0.5 + float(i) / nit;
+      float x = 10. + float(i) / nit * 200.;
+      o2::track::TrackPar trc(0., 0., par);
+      trc.propagateParamTo(x, 0.5);
+      TVectorD vec(10);
+      vec[0] = i;
+      tstStream << "TrackTree"
+                << "id=" << i << "x=" << x << "track=" << trc << "vec.=" << (i % 2 ? &vec : nullptr) << "\n";
+    }
+  }
+  TFile inpf(outFName.data());
+  BOOST_CHECK(!inpf.IsZombie());
+  auto tree = (TTree*)inpf.GetObjectChecked("TrackTree", "TTree");
+  BOOST_REQUIRE(tree);
+  BOOST_CHECK_EQUAL(tree->GetEntries(), nit);
+  int id;
+  float x;
+  o2::track::TrackPar* trc = nullptr;
+  TVectorD* vec = nullptr;
+  BOOST_CHECK(!tree->SetBranchAddress("id", &id));
+  BOOST_CHECK(!tree->SetBranchAddress("x", &x));
+  BOOST_CHECK(!tree->SetBranchAddress("track", &trc));
+  BOOST_CHECK(!tree->SetBranchAddress("vec.", &vec));
+  for (int i = 0; i < nit; i++) {
+    tree->GetEntry(i);
+    BOOST_CHECK_EQUAL(id, i);
+    BOOST_CHECK(std::abs(x - trc->getX()) < 1e-4);
+    if (i % 2) {
+      BOOST_CHECK_EQUAL((*vec)[0], i);
+    }
+  }
+}
+
 //_________________________________________________
 bool UnitTestSparse(Double_t scale, Int_t testEntries)
 {
@@ -450,6 +450,15 @@ class EncodedBlocks
   template <typename VD>
   static auto create(VD& v);
 
+  /// create container from vector which will store only a given slot, e.g. to encode independent blocks concurrently.
+  /// The block can be then added to the final container with importBlock
+  template <typename VD>
+  static auto createForSlot(VD& v, int slot, const ANSHeader& ansVersion);
+
+  /// copy the already encoded block at provided slot of another container to the container in the buffer (expanded as needed)
+  template <typename buffer_T>
+  static o2::ctf::CTFIOSize importBlock(buffer_T& buffer, const EncodedBlocks& src, int slot);
+
   /// estimate free size needed to add new block
   static size_t estimateBlockSize(int n) { return Block<W>::estimateSize(n); }
 
@@ -493,15 +502,16 @@ class EncodedBlocks
   static void readFromTree(VD& vec, TTree& tree, const std::string& name, int ev = 0);
 
   /// encode vector src to bloc at provided slot
+  /// if adaptiveDict is set, the external encoder (if any) is used only if its estimated size does not exceed that with an embedded dictionary
   template <typename VE, typename buffer_T>
-  inline o2::ctf::CTFIOSize encode(const VE& src, int slot, uint8_t symbolTablePrecision, Metadata::OptStore opt, buffer_T* buffer = nullptr, const std::any& encoderExt = {}, float memfc = 1.f)
+  inline o2::ctf::CTFIOSize encode(const VE& src, int slot, uint8_t symbolTablePrecision, Metadata::OptStore opt, buffer_T* buffer = nullptr, const std::any& encoderExt = {}, float memfc = 1.f, bool adaptiveDict = false)
   {
-    return encode(std::begin(src), std::end(src), slot, symbolTablePrecision, opt, buffer, encoderExt, memfc);
+    return encode(std::begin(src), std::end(src), slot, symbolTablePrecision, opt, buffer, encoderExt, memfc, adaptiveDict);
   }
 
   /// encode vector src to bloc at provided slot
   template <typename input_IT, typename buffer_T>
-  o2::ctf::CTFIOSize encode(const input_IT srcBegin, const input_IT srcEnd, int slot, uint8_t symbolTablePrecision, Metadata::OptStore opt, buffer_T* buffer = nullptr, const std::any& encoderExt = {}, float memfc = 1.f);
+  o2::ctf::CTFIOSize encode(const input_IT srcBegin, const input_IT srcEnd, int slot, uint8_t symbolTablePrecision, Metadata::OptStore opt, buffer_T* buffer = nullptr, const std::any& encoderExt = {}, float memfc = 1.f, bool adaptiveDict = false);
 
   /// decode block at provided slot to destination vector (will be resized as needed)
   template <class container_T, class container_IT = typename container_T::iterator>
@@ -592,13 +602,13 @@ class EncodedBlocks
   o2::ctf::CTFIOSize entropyCodeRANSCompat(const input_IT srcBegin, const input_IT srcEnd, int slot, uint8_t symbolTablePrecision, buffer_T* buffer = nullptr, const std::any& encoderExt = {}, float memfc = 1.f);
 
   template <typename input_IT, typename buffer_T>
-  o2::ctf::CTFIOSize entropyCodeRANSV1(const input_IT srcBegin, const input_IT srcEnd, int slot, Metadata::OptStore opt, buffer_T* buffer = nullptr, const std::any& encoderExt = {}, float memfc = 1.f);
+  o2::ctf::CTFIOSize entropyCodeRANSV1(const input_IT srcBegin, const input_IT srcEnd, int slot, Metadata::OptStore opt, buffer_T* buffer = nullptr, const std::any& encoderExt = {}, float memfc = 1.f, bool adaptiveDict = false);
 
   template <typename input_IT, typename buffer_T>
   o2::ctf::CTFIOSize encodeRANSV1External(const input_IT srcBegin, const input_IT srcEnd, int slot, const std::any& encoderExt, buffer_T* buffer = nullptr, double_t sizeEstimateSafetyFactor = 1);
 
   template <typename input_IT, typename buffer_T>
-  o2::ctf::CTFIOSize encodeRANSV1Inplace(const input_IT srcBegin, const input_IT srcEnd, int slot, Metadata::OptStore opt, buffer_T* buffer = nullptr, double_t sizeEstimateSafetyFactor = 1);
+  o2::ctf::CTFIOSize encodeRANSV1Inplace(const input_IT srcBegin, const input_IT srcEnd, int slot, Metadata::OptStore opt, buffer_T* buffer = nullptr, double_t sizeEstimateSafetyFactor = 1, const std::any& encoderExt = {});
 
 #ifndef __CLING__
   template <typename input_IT, typename buffer_T>
@@ -878,6 +888,42 @@ inline auto EncodedBlocks<H, N, W>::create(VD& v)
   return create(v.data(), v.size() * vsz);
 }
 
+///_____________________________________________________________________________
+/// create container from vector which will store only a given slot. Head is supposed to respect the alignment
+template <typename H, int N, typename W>
+template <typename VD>
+inline auto EncodedBlocks<H, N, W>::createForSlot(VD& v, int slot, const ANSHeader& ansVersion)
+{
+  assert(slot < N);
+  auto b = create(v);
+  b->setANSHeader(ansVersion);
+  b->mRegistry.nFilledBlocks = slot; // pretend the preceding blocks were filled
+  return b;
+}
+
+///_____________________________________________________________________________
+/// copy the already encoded block at provided slot of another container to the container in the buffer (expanded as needed)
+template <typename H, int N, typename W>
+template <typename buffer_T>
+o2::ctf::CTFIOSize EncodedBlocks<H, N, W>::importBlock(buffer_T& buffer, const EncodedBlocks& src, int slot)
+{
+  auto* dest = get(buffer.data());
+  assert(slot == dest->mRegistry.nFilledBlocks);
+  assert(slot < src.mRegistry.nFilledBlocks);
+  dest->mRegistry.nFilledBlocks++;
+
+  const auto& srcBlock = src.mBlocks[slot];
+  const auto& srcMetadata = src.mMetadata[slot];
+  if (srcBlock.getNStored() == 0) { // nothing was stored, e.g. empty message, everything is in the metadata
+    dest->mMetadata[slot] = srcMetadata;
+    return {0, srcMetadata.getUncompressedSize(), srcMetadata.getCompressedSize()};
+  }
+  auto [thisBlock, thisMetadata] = dest->expandStorage(slot, srcBlock.getNStored(), &buffer);
+  thisBlock->store(srcBlock.getNDict(), srcBlock.getNData(), srcBlock.getNLiterals(), srcBlock.getDict(), srcBlock.getData(), srcBlock.getLiterals());
+  *thisMetadata = srcMetadata;
+  return {0, thisMetadata->getUncompressedSize(), thisMetadata->getCompressedSize()};
+}
+
 ///_____________________________________________________________________________
 /// print itself
 template <typename H, int N, typename W>
@@ -1111,7 +1157,8 @@ o2::ctf::CTFIOSize EncodedBlocks<H, N, W>::encode(const input_IT srcBegin,
                                                   Metadata::OptStore opt,       // option for data compression
                                                   buffer_T* buffer,             // optional buffer (vector) providing memory for encoded blocks
                                                   const std::any& encoderExt,   // optional external encoder
-                                                  float memfc)                  // memory allocation margin factor
+                                                  float memfc,                  // memory allocation margin factor
+                                                  bool adaptiveDict)            // choose between external and embedded dictionary by the size estimate
 {
   // fill a new block
   assert(slot == mRegistry.nFilledBlocks);
@@ -1134,7 +1181,7 @@ o2::ctf::CTFIOSize EncodedBlocks<H, N, W>::encode(const input_IT srcBegin,
     if (ansVersion == ANSVersionCompat) {
       return entropyCodeRANSCompat(srcBegin, srcEnd, slot, symbolTablePrecision, buffer, encoderExt, memfc);
     } else if (ansVersion == ANSVersion1) {
-      return entropyCodeRANSV1(srcBegin, srcEnd, slot, opt, buffer, encoderExt, memfc);
+      return entropyCodeRANSV1(srcBegin, srcEnd, slot, opt, buffer, encoderExt, memfc, adaptiveDict);
     } else {
       throw std::runtime_error(fmt::format("Unsupported ANS Coder Version: {}.{}", ansVersion.majorVersion, ansVersion.minorVersion));
     }
@@ -1273,7 +1320,7 @@ o2::ctf::CTFIOSize EncodedBlocks<H, N, W>::entropyCodeRANSCompat(const input_IT
 
 template <typename H, int N, typename W>
 template <typename input_IT, typename buffer_T>
-o2::ctf::CTFIOSize EncodedBlocks<H, N, W>::entropyCodeRANSV1(const input_IT srcBegin, const input_IT srcEnd, int slot, Metadata::OptStore opt, buffer_T* buffer, const std::any& encoderExt, float memfc)
+o2::ctf::CTFIOSize EncodedBlocks<H, N, W>::entropyCodeRANSV1(const input_IT srcBegin, const input_IT srcEnd, int slot, Metadata::OptStore opt, buffer_T* buffer, const std::any& encoderExt, float memfc, bool adaptiveDict)
 {
   CTFIOSize encoderStatistics{};
 
@@ -1282,10 +1329,11 @@ o2::ctf::CTFIOSize EncodedBlocks<H, N, W>::entropyCodeRANSV1(const input_IT srcB
     encoderStatistics = pack(srcBegin, srcEnd, slot, buffer);
   } else {
 
-    if (encoderExt.has_value()) {
+    if (encoderExt.has_value() && !adaptiveDict) {
       encoderStatistics = encodeRANSV1External(srcBegin, srcEnd, slot, encoderExt, buffer, memfc);
     } else {
-      encoderStatistics = encodeRANSV1Inplace(srcBegin, srcEnd, slot, opt, buffer, memfc);
+      // in the adaptive mode the external encoder is passed to be compared with the embedded dictionary
+      encoderStatistics = encodeRANSV1Inplace(srcBegin, srcEnd, slot, opt, buffer, memfc, encoderExt);
     }
   }
   return encoderStatistics;
@@ -1354,7 +1402,7 @@ CTFIOSize EncodedBlocks<H, N, W>::encodeRANSV1External(const input_IT srcBegin,
 
 template <typename H, int N, typename W>
 template <typename input_IT, typename buffer_T>
-CTFIOSize EncodedBlocks<H, N, W>::encodeRANSV1Inplace(const input_IT srcBegin, const input_IT srcEnd, int slot, Metadata::OptStore opt, buffer_T* buffer, double_t sizeEstimateSafetyFactor)
+CTFIOSize EncodedBlocks<H, N, W>::encodeRANSV1Inplace(const input_IT srcBegin, const input_IT srcEnd, int slot, Metadata::OptStore opt, buffer_T* buffer, double_t sizeEstimateSafetyFactor, const std::any& encoderExt)
 {
   using storageBuffer_t = W;
   using input_t = typename std::iterator_traits<input_IT>::value_type;
@@ -1382,6 +1430,9 @@ CTFIOSize EncodedBlocks<H, N, W>::encodeRANSV1Inplace(const input_IT srcBegin, c
       encoder = internal::InplaceEntropyCoder<input_t>{proxy.beginIter(), proxy.endIter()};
     }
   } catch (const rans::HistogramError& error) {
+    if (encoderExt.has_value()) {
+      return encodeRANSV1External(srcBegin, srcEnd, slot, encoderExt, buffer, sizeEstimateSafetyFactor);
+    }
     LOGP(warning, "Failed to build Dictionary for rANS encoding, using fallback option");
     if (proxy.isCached()) {
       return store(proxy.beginCache(), proxy.endCache(), slot, this->FallbackStorageType, buffer);
@@ -1397,6 +1448,25 @@ CTFIOSize EncodedBlocks<H, N, W>::encodeRANSV1Inplace(const input_IT srcBegin, c
     LOGP(info, "Metrics:{{slot: {}, numSamples: {}, min: {}, max: {}, alphabetRangeBits: {}, nUsedAlphabetSymbols: {}, preferPacking: {}}}", slot, dp.numSamples, dp.min, dp.max, dp.alphabetRangeBits, dp.nUsedAlphabetSymbols, metrics.getSizeEstimate().preferPacking());
   }
   */
+  if (encoderExt.has_value()) { // adaptive dictionary selection: use the external one unless the embedded one is estimated to be smaller
+    const auto& sizeEstimate = metrics.getSizeEstimate();
+    size_t embeddedSizeB = sizeEstimate.getCompressedDatasetSize(1.) + sizeEstimate.getCompressedDictionarySize(1.) + sizeEstimate.getIncompressibleSize(1.);
+    if (detail::mayPack(opt)) {
+      embeddedSizeB = std::min(embeddedSizeB, sizeEstimate.getPackedDatasetSize());
+    }
+    using ransEncoderExt_t = typename internal::ExternalEntropyCoder<input_t>::encoder_type;
+    const internal::ExternalEntropyCoder<input_t> encoderExtProxy{std::any_cast<const ransEncoderExt_t&>(encoderExt)};
+    size_t externalSizeB = 0;
+    std::visit([&](auto&& histogram) { externalSizeB = encoderExtProxy.computeSizeEstimateB(histogram, metrics.getDatasetProperties().alphabetRangeBits); }, encoder.getHistogram());
+    LOGP(debug, "Slot {}: size estimate with external dictionary {} vs embedded {} bytes", slot, externalSizeB, embeddedSizeB);
+    if (externalSizeB <= embeddedSizeB) {
+      if (proxy.isCached()) {
+        return encodeRANSV1External(proxy.beginCache(), proxy.endCache(), slot, encoderExt, buffer, sizeEstimateSafetyFactor);
+      } else {
+        return encodeRANSV1External(proxy.beginIter(), proxy.endIter(), slot, encoderExt, buffer, sizeEstimateSafetyFactor);
+      }
+    }
+  }
   if (detail::mayPack(opt) && metrics.getSizeEstimate().preferPacking()) {
     if (proxy.isCached()) {
       return pack(proxy.beginCache(), proxy.endCache(), slot, metrics, buffer);
@@ -16,6 +16,7 @@
 #ifndef ALICEO2_EXTERNALENTROPYCODER_H_
 #define ALICEO2_EXTERNALENTROPYCODER_H_
 
+#include <cmath>
 #include <type_traits>
 
 #include "DetectorsCommonDataFormats/internal/Packer.h"
@@ -43,6 +44,10 @@ class ExternalEntropyCoder
   template <typename dst_T = uint8_t>
   [[nodiscard]] inline size_t computePayloadSizeEstimate(size_t nElements, double_t safetyFactor = 1);
 
+  // estimated size in bytes of the payload and literals when encoding the data described by the histogram with this coder
+  template <typename histogram_T>
+  [[nodiscard]] size_t computeSizeEstimateB(const histogram_T& histogram, size_t incompressibleSymbolBits) const;
+
   template <typename src_IT, typename dst_IT>
   [[nodiscard]] dst_IT encode(src_IT srcBegin, src_IT srcEnd, dst_IT dstBegin, dst_IT dstEnd);
 
@@ -82,6 +87,27 @@ template <typename dst_T>
   return rans::utils::nBytesTo<dst_T>(std::ceil(RelativeSafetyFactor * messageSizeB) + Overhead);
 }
 
+template <typename source_T>
+template <typename histogram_T>
+[[nodiscard]] size_t ExternalEntropyCoder<source_T>::computeSizeEstimateB(const histogram_T& histogram, size_t incompressibleSymbolBits) const
+{
+  const auto& symbolTable = getEncoder().getSymbolTable();
+  const double_t precision = symbolTable.getPrecision();
+  double_t nBits = 0;
+
+  rans::internal::forEachIndexValue(histogram, [&](const source_type& symbol, const auto& count) {
+    if (count > 0) {
+      const auto& encoderSymbol = symbolTable[symbol];
+      // cost of a symbol is -log2(p) with p = freq/2^precision, incompressible symbols are escaped and stored as literals
+      nBits += count * (precision - std::log2(static_cast<double_t>(encoderSymbol.getFrequency())));
+      if (symbolTable.isEscapeSymbol(encoderSymbol)) {
+        nBits += count * incompressibleSymbolBits;
+      }
+    }
+  });
+  return rans::addEncoderOverheadEstimateB<>(rans::utils::toBytes(std::ceil(nBits)));
+};
+
 template <typename source_T>
 template <typename src_IT, typename dst_IT>
 [[nodiscard]] dst_IT ExternalEntropyCoder<source_T>::encode(src_IT srcBegin, src_IT srcEnd, dst_IT dstBegin, dst_IT dstEnd)
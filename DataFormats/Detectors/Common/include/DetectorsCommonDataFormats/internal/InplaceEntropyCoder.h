@@ -66,6 +66,9 @@ class InplaceEntropyCoder
 
   [[nodiscard]] inline const metrics_type& getMetrics() const noexcept { return mMetrics; };
 
+  // histogram of the source data, valid only before makeEncoder
+  [[nodiscard]] inline const histogram_type& getHistogram() const { return *mHistogram; };
+
   [[nodiscard]] inline size_t getNIncompressibleSamples() const noexcept { return mIncompressibleBuffer.size(); };
 
   [[nodiscard]] size_t getNStreams() const;
@@ -347,4 +347,32 @@ BOOST_AUTO_TEST_CASE(testExternalEncoderCombinedIterator)
   auto [begin, end] = makeInputIterators(testMessage1.data(), testMessage2.data(), testMessage1.size(), ShiftFunctor<uint16_t, rans::utils::toBits<uint8_t>()>{});
 
   encodeExternal(begin, end);
-};
\ No newline at end of file
+};
+using small_source_types = boost::mp11::mp_list<uint8_t, int8_t, uint16_t, int16_t>;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(testExternalEncoderSizeEstimate, source_T, small_source_types)
+{
+  auto estimateSizes = [](const auto& message) {
+    ctf::internal::InplaceEntropyCoder<source_T> inplaceCoder{message.begin(), message.end()};
+    const auto& metrics = inplaceCoder.getMetrics();
+    const auto& sizeEstimate = metrics.getSizeEstimate();
+    const size_t embeddedSizeB = sizeEstimate.getCompressedDatasetSize(1.) + sizeEstimate.getCompressedDictionarySize(1.) + sizeEstimate.getIncompressibleSize(1.);
+    const ctf::internal::ExternalEntropyCoder<source_T> externalCoder{ExternalEncoders.getEncoder<source_T>()};
+    size_t externalSizeB{};
+    std::visit([&](auto&& histogram) { externalSizeB = externalCoder.computeSizeEstimateB(histogram, metrics.getDatasetProperties().alphabetRangeBits); }, inplaceCoder.getHistogram());
+    return std::make_pair(externalSizeB, embeddedSizeB);
+  };
+
+  // the external dictionary was built from this very message: no need to embed a dictionary
+  const auto& matchingMessage = MessageProxy.getMessage<source_T>();
+  auto [externalMatchingB, embeddedMatchingB] = estimateSizes(matchingMessage);
+  BOOST_CHECK_LE(externalMatchingB, embeddedMatchingB);
+
+  // a message populating few symbols only, which are rare in the external dictionary
+  std::vector<source_T> narrowMessage(matchingMessage.size());
+  for (size_t i = 0; i < narrowMessage.size(); ++i) {
+    narrowMessage[i] = std::numeric_limits<source_T>::min() + (i % 4);
+  }
+  auto [externalNarrowB, embeddedNarrowB] = estimateSizes(narrowMessage);
+  BOOST_CHECK_GT(externalNarrowB, embeddedNarrowB);
+};
@@ -0,0 +1,127 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file FilteredRecoTFImage.h
+/// \brief Flat image of the information filtered out from single TF
+///
+/// Layout: Header | blocks of the FilteredRecoTF data, each being the raw array of its objects starting at Alignment.
+/// The image is laid out in a preallocated buffer (e.g. the output message) where the selected objects are gathered
+/// directly, and its blocks can be accessed in place, e.g. from a memory-mapped file, without deserialization.
+
+#ifndef ALICEO2_FILTERED_RECO_TF_IMAGE_H
+#define ALICEO2_FILTERED_RECO_TF_IMAGE_H
+
+#include <array>
+#include <cstdint>
+#include <gsl/span>
+#include "DataFormatsGlobalTracking/FilteredRecoTF.h"
+
+namespace o2::dataformats
+{
+
+struct FilteredRecoTFImage {
+  static constexpr std::array<char, 8> Magic{'O', '2', 'F', 'T', 'F', 'I', 'M', 'G'};
+  static constexpr uint32_t CurrentVersion = 1;
+  static constexpr size_t Alignment = 8; // alignment of the blocks and of the consecutive images in a file
+
+  enum Block : int {
+    ITSTrackROFs,
+    ITSTracks,
+    ITSClusterIndices,
+    ITSTrackMCTruth,
+    ITSClusterROFs,
+    ITSClusters,
+    ITSClusterPatterns,
+    NBlocks
+  };
+
+  template <int B>
+  struct BlockType;
+
+  struct BlockRef {
+    uint64_t offset = 0;      // offset wrt the image start
+    uint64_t nElements = 0;   // number of objects stored
+    uint32_t elementSize = 0; // size of the object, to detect a layout change
+    uint32_t reserved = 0;
+  };
+
+  struct Header {
+    std::array<char, 8> magic = Magic;
+    uint32_t version = CurrentVersion;
+    uint32_t nBlocks = NBlocks;
+    uint64_t size = 0; // size of the image in bytes, multiple of Alignment
+    uint64_t run = 0;
+    uint64_t creationTime = 0;
+    uint32_t firstTForbit = 0;
+    uint32_t reserved = 0;
+    std::array<BlockRef, NBlocks> blocks{};
+
+    FilteredRecoTF::Header getTFHeader() const;
+  };
+
+  using Sizes = std::array<size_t, NBlocks>;
+
+  /// size of the image with given numbers of objects in every block
+  static size_t getSize(const Sizes& nElements);
+
+  /// lay out the image with given numbers of objects in the buffer of getSize(nElements) bytes, the blocks are left uninitialized
+  static const Header& create(gsl::span<char> buffer, const Sizes& nElements, const FilteredRecoTF::Header& tfHeader);
+
+  /// header of the image at the start of the buffer, throws if the buffer does not start with a valid image
+  static const Header& get(gsl::span<const char> buffer);
+
+  template <int B>
+  static gsl::span<typename BlockType<B>::type> getBlock(gsl::span<char> buffer)
+  {
+    const auto& ref = get(buffer).blocks[B];
+    return {reinterpret_cast<typename BlockType<B>::type*>(buffer.data() + ref.offset), size_t(ref.nElements)};
+  }
+
+  template <int B>
+  static gsl::span<const typename BlockType<B>::type> getBlock(gsl::span<const char> buffer)
+  {
+    const auto& ref = get(buffer).blocks[B];
+    return {reinterpret_cast<const typename BlockType<B>::type*>(buffer.data() + ref.offset), size_t(ref.nElements)};
+  }
+};
+
+template <>
+struct FilteredRecoTFImage::BlockType<FilteredRecoTFImage::ITSTrackROFs> {
+  using type = o2::itsmft::ROFRecord;
+};
+template <>
+struct FilteredRecoTFImage::BlockType<FilteredRecoTFImage::ITSTracks> {
+  using type = o2::its::TrackITS;
+};
+template <>
+struct FilteredRecoTFImage::BlockType<FilteredRecoTFImage::ITSClusterIndices> {
+  using type = int;
+};
+template <>
+struct FilteredRecoTFImage::BlockType<FilteredRecoTFImage::ITSTrackMCTruth> {
+  using type = o2::MCCompLabel;
+};
+template <>
+struct FilteredRecoTFImage::BlockType<FilteredRecoTFImage::ITSClusterROFs> {
+  using type = o2::itsmft::ROFRecord;
+};
+template <>
+struct FilteredRecoTFImage::BlockType<FilteredRecoTFImage::ITSClusters> {
+  using type = o2::itsmft::CompClusterExt;
+};
+template <>
+struct FilteredRecoTFImage::BlockType<FilteredRecoTFImage::ITSClusterPatterns> {
+  using type = unsigned char;
+};
+
+} // namespace o2::dataformats
+
+#endif // ALICEO2_FILTERED_RECO_TF_IMAGE_H
@@ -28,7 +28,9 @@
 #include "SimulationDataFormat/ConstMCTruthContainer.h"
 #include "DataFormatsCTP/LumiInfo.h"
 #include <gsl/span>
+#include <functional>
 #include <memory>
+#include <mutex>
 
 // We forward declare the internal structures, to reduce header dependencies.
 // Please include headers for TPC Hits or TRD tracklets directly (DataFormatsTPC/WorkflowHelper.h / DataFormatsTRD/RecoInputContainer.h)
@@ -187,6 +189,35 @@ namespace o2
 namespace globaltracking
 {
 
+// helper class holding an input object which is extracted from the DPL inputs (and deserialized) only when it is
+// accessed for the first time. The object is then shared by all the users of the RecoContainer, until the next set().
+// The access must happen in the same processing call where the loader was set.
+template <typename T>
+class LazyInput
+{
+ public:
+  void set(std::function<std::unique_ptr<const T>()> loader)
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mObject.reset();
+    mLoader = std::move(loader);
+  }
+  const T* get() const
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mLoader) {
+      mObject = mLoader();
+      mLoader = nullptr;
+    }
+    return mObject.get();
+  }
+
+ private:
+  mutable std::mutex mMutex;
+  mutable std::function<std::unique_ptr<const T>()> mLoader;
+  mutable std::unique_ptr<const T> mObject;
+};
+
 // helper class to request DPL input data from the processor specs definition
 struct DataRequest {
   std::vector<o2::framework::InputSpec> inputs;
@@ -331,15 +362,16 @@ struct RecoContainer {
   STrackAccessor strkPool;  // containers for strangeness tracking related objects
   CosmicsAccessor cosmPool; // containers for cosmics track data
 
-  std::unique_ptr<const o2::dataformats::MCTruthContainer<o2::MCCompLabel>> mcITSClusters;
-  std::unique_ptr<const o2::dataformats::MCTruthContainer<o2::MCCompLabel>> mcTOFClusters;
-  std::unique_ptr<const o2::dataformats::MCTruthContainer<o2::MCCompLabel>> mcHMPClusters;
-  std::unique_ptr<const o2::dataformats::MCTruthContainer<o2::MCCompLabel>> mcCPVClusters;
-  std::unique_ptr<const o2::dataformats::MCTruthContainer<o2::MCCompLabel>> mcMCHClusters;
-  std::unique_ptr<const o2::dataformats::MCTruthContainer<o2::phos::MCLabel>> mcPHSCells;
-  std::unique_ptr<const o2::dataformats::MCTruthContainer<o2::emcal::MCLabel>> mcEMCCells;
-  std::unique_ptr<const o2::dataformats::MCTruthContainer<o2::mid::MCClusterLabel>> mcMIDTrackClusters;
-  std::unique_ptr<const o2::dataformats::MCTruthContainer<o2::mid::MCClusterLabel>> mcMIDClusters;
+  // MC labels of the clusters are deserialized only if they are accessed
+  LazyInput<o2::dataformats::MCTruthContainer<o2::MCCompLabel>> mcITSClusters;
+  LazyInput<o2::dataformats::MCTruthContainer<o2::MCCompLabel>> mcTOFClusters;
+  LazyInput<o2::dataformats::MCTruthContainer<o2::MCCompLabel>> mcHMPClusters;
+  LazyInput<o2::dataformats::MCTruthContainer<o2::MCCompLabel>> mcCPVClusters;
+  LazyInput<o2::dataformats::MCTruthContainer<o2::MCCompLabel>> mcMCHClusters;
+  LazyInput<o2::dataformats::MCTruthContainer<o2::phos::MCLabel>> mcPHSCells;
+  LazyInput<o2::dataformats::MCTruthContainer<o2::emcal::MCLabel>> mcEMCCells;
+  LazyInput<o2::dataformats::MCTruthContainer<o2::mid::MCClusterLabel>> mcMIDTrackClusters;
+  LazyInput<o2::dataformats::MCTruthContainer<o2::mid::MCClusterLabel>> mcMIDClusters;
   std::unique_ptr<const std::vector<o2::MCCompLabel>> mcMIDTracks;
   o2::ctp::LumiInfo mCTPLumi;
 
@@ -13,8 +13,12 @@
 /// \brief Information filtered out from single TF
 
 #include "DataFormatsGlobalTracking/FilteredRecoTF.h"
+#include "DataFormatsGlobalTracking/FilteredRecoTFImage.h"
 #include <fmt/printf.h>
+#include <algorithm>
 #include <iostream>
+#include <new>
+#include <stdexcept>
 #include "CommonUtils/StringUtils.h"
 
 using namespace o2::dataformats;
@@ -44,3 +48,85 @@ void FilteredRecoTF::clear()
   ITSClusters.clear();
   ITSClusterPatterns.clear();
 }
+
+namespace
+{
+using Image = o2::dataformats::FilteredRecoTFImage;
+const std::array<uint32_t, Image::NBlocks> ElementSizes{sizeof(Image::BlockType<Image::ITSTrackROFs>::type),
+                                                        sizeof(Image::BlockType<Image::ITSTracks>::type),
+                                                        sizeof(Image::BlockType<Image::ITSClusterIndices>::type),
+                                                        sizeof(Image::BlockType<Image::ITSTrackMCTruth>::type),
+                                                        sizeof(Image::BlockType<Image::ITSClusterROFs>::type),
+                                                        sizeof(Image::BlockType<Image::ITSClusters>::type),
+                                                        sizeof(Image::BlockType<Image::ITSClusterPatterns>::type)};
+
+size_t alignSize(size_t size)
+{
+  return (size + Image::Alignment - 1) / Image::Alignment * Image::Alignment;
+}
+} // namespace
+
+FilteredRecoTF::Header FilteredRecoTFImage::Header::getTFHeader() const
+{
+  FilteredRecoTF::Header h;
+  h.run = run;
+  h.creationTime = creationTime;
+  h.firstTForbit = firstTForbit;
+  return h;
+}
+
+size_t FilteredRecoTFImage::getSize(const Sizes& nElements)
+{
+  size_t size = alignSize(sizeof(Header));
+  for (int ib = 0; ib < NBlocks; ib++) {
+    size += alignSize(nElements[ib] * ElementSizes[ib]);
+  }
+  return size;
+}
+
+const FilteredRecoTFImage::Header& FilteredRecoTFImage::create(gsl::span<char> buffer, const Sizes& nElements, const FilteredRecoTF::Header& tfHeader)
+{
+  auto size = getSize(nElements);
+  if (buffer.size() < size || reinterpret_cast<uintptr_t>(buffer.data()) % Alignment) {
+    throw std::runtime_error(fmt::format("buffer of {} bytes cannot hold the filtered TF image of {} bytes", buffer.size(), size));
+  }
+  auto& header = *new (buffer.data()) Header{};
+  header.size = size;
+  header.run = tfHeader.run;
+  header.creationTime = tfHeader.creationTime;
+  header.firstTForbit = tfHeader.firstTForbit;
+  uint64_t offset = alignSize(sizeof(Header));
+  for (int ib = 0; ib < NBlocks; ib++) {
+    header.blocks[ib] = BlockRef{offset, nElements[ib], ElementSizes[ib]};
+    offset += alignSize(nElements[ib] * ElementSizes[ib]);
+  }
+  // zero the padding only, the blocks are to be filled by the caller
+  std::fill(buffer.data() + sizeof(Header), buffer.data() + header.blocks[0].offset, 0);
+  for (int ib = 0; ib < NBlocks; ib++) {
+    const auto& ref = header.blocks[ib];
+    auto end = ib + 1 < NBlocks ? header.blocks[ib + 1].offset : size;
+    std::fill(buffer.data() + ref.offset + ref.nElements * ref.elementSize, buffer.data() + end, 0);
+  }
+  return header;
+}
+
+const FilteredRecoTFImage::Header& FilteredRecoTFImage::get(gsl::span<const char> buffer)
+{
+  if (buffer.size() < sizeof(Header) || reinterpret_cast<uintptr_t>(buffer.data()) % Alignment) {
+    throw std::runtime_error(fmt::format("buffer of {} bytes does not contain a filtered TF image", buffer.size()));
+  }
+  const auto& header = *reinterpret_cast<const Header*>(buffer.data());
+  if (header.magic != Magic || header.version != CurrentVersion || header.nBlocks != NBlocks) {
+    throw std::runtime_error(fmt::format("buffer does not contain a filtered TF image of version {}", CurrentVersion));
+  }
+  if (header.size > buffer.size()) {
+    throw std::runtime_error(fmt::format("filtered TF image of {} bytes exceeds the buffer of {} bytes", header.size, buffer.size()));
+  }
+  for (int ib = 0; ib < NBlocks; ib++) {
+    const auto& ref = header.blocks[ib];
+    if (ref.elementSize != ElementSizes[ib] || ref.offset % Alignment || ref.offset + ref.nElements * ref.elementSize > header.size) {
+      throw std::runtime_error(fmt::format("block {} of the filtered TF image is corrupted or has an obsolete layout", ib));
+    }
+  }
+  return header;
+}
@@ -53,6 +53,16 @@ namespace o2d = o2::dataformats;
 using GTrackID = o2d::GlobalTrackID;
 using DetID = o2::detectors::DetID;
 
+namespace
+{
+// loader of an input object for LazyInput, the object is extracted from the inputs on first access
+template <typename T>
+std::function<std::unique_ptr<const T>()> lazyInput(ProcessingContext& pc, const char* binding)
+{
+  return [&inputs = pc.inputs(), binding]() -> std::unique_ptr<const T> { return inputs.get<const T*>(binding); };
+}
+} // namespace
+
 RecoContainer::RecoContainer() = default;
 RecoContainer::~RecoContainer() = default;
 
@@ -930,7 +940,7 @@ void RecoContainer::addMIDTracks(ProcessingContext& pc, bool mc)
   commonPool[GTrackID::MID].registerContainer(pc.inputs().get<gsl::span<o2::mid::ROFRecord>>("trackClMIDROF"), MATCHES);
   if (mc) {
     commonPool[GTrackID::MID].registerContainer(pc.inputs().get<gsl::span<o2::MCCompLabel>>("trackMIDMCTR"), MCLABELS);
-    mcMIDTrackClusters = pc.inputs().get<const dataformats::MCTruthContainer<o2::mid::MCClusterLabel>*>("trackMIDMCTRCL");
+    mcMIDTrackClusters.set(lazyInput<dataformats::MCTruthContainer<o2::mid::MCClusterLabel>>(pc, "trackMIDMCTRCL"));
   }
 }
 
@@ -1069,7 +1079,7 @@ void RecoContainer::addITSClusters(ProcessingContext& pc, bool mc)
   commonPool[GTrackID::ITS].registerContainer(pc.inputs().get<gsl::span<o2::itsmft::CompClusterExt>>("clusITS"), CLUSTERS);
   commonPool[GTrackID::ITS].registerContainer(pc.inputs().get<gsl::span<unsigned char>>("clusITSPatt"), PATTERNS);
   if (mc) {
-    mcITSClusters = pc.inputs().get<const dataformats::MCTruthContainer<MCCompLabel>*>("clusITSMC");
+    mcITSClusters.set(lazyInput<dataformats::MCTruthContainer<MCCompLabel>>(pc, "clusITSMC"));
   }
 }
 
@@ -1084,7 +1094,7 @@ void RecoContainer::addIT3Clusters(ProcessingContext& pc, bool mc)
   commonPool[GTrackID::ITS].registerContainer(pc.inputs().get<gsl::span<o2::itsmft::CompClusterExt>>("clusITS"), CLUSTERS);
   commonPool[GTrackID::ITS].registerContainer(pc.inputs().get<gsl::span<unsigned char>>("clusITSPatt"), PATTERNS);
   if (mc) {
-    mcITSClusters = pc.inputs().get<const dataformats::MCTruthContainer<MCCompLabel>*>("clusITSMC");
+    mcITSClusters.set(lazyInput<dataformats::MCTruthContainer<MCCompLabel>>(pc, "clusITSMC"));
   }
 }
 #endif
@@ -1100,7 +1110,7 @@ void RecoContainer::addMFTClusters(ProcessingContext& pc, bool mc)
   commonPool[GTrackID::MFT].registerContainer(pc.inputs().get<gsl::span<o2::itsmft::CompClusterExt>>("clusMFT"), CLUSTERS);
   commonPool[GTrackID::MFT].registerContainer(pc.inputs().get<gsl::span<unsigned char>>("clusMFTPatt"), PATTERNS);
   if (mc) {
-    mcITSClusters = pc.inputs().get<const dataformats::MCTruthContainer<MCCompLabel>*>("clusMFTMC");
+    mcITSClusters.set(lazyInput<dataformats::MCTruthContainer<MCCompLabel>>(pc, "clusMFTMC"));
   }
 }
 
@@ -1133,7 +1143,7 @@ void RecoContainer::addTOFClusters(ProcessingContext& pc, bool mc)
 {
   commonPool[GTrackID::TOF].registerContainer(pc.inputs().get<gsl::span<o2::tof::Cluster>>("tofcluster"), CLUSTERS);
   if (mc) {
-    mcTOFClusters = pc.inputs().get<const dataformats::MCTruthContainer<MCCompLabel>*>("tofclusterlabel");
+    mcTOFClusters.set(lazyInput<dataformats::MCTruthContainer<MCCompLabel>>(pc, "tofclusterlabel"));
   }
 }
 
@@ -1143,7 +1153,7 @@ void RecoContainer::addHMPClusters(ProcessingContext& pc, bool mc)
   commonPool[GTrackID::HMP].registerContainer(pc.inputs().get<gsl::span<o2::hmpid::Cluster>>("hmpidcluster"), CLUSTERS);
   commonPool[GTrackID::HMP].registerContainer(pc.inputs().get<gsl::span<o2::hmpid::Trigger>>("hmpidtriggers"), CLUSREFS);
   if (mc) {
-    mcHMPClusters = pc.inputs().get<const dataformats::MCTruthContainer<MCCompLabel>*>("hmpidclusterlabel");
+    mcHMPClusters.set(lazyInput<dataformats::MCTruthContainer<MCCompLabel>>(pc, "hmpidclusterlabel"));
   }
 }
 //__________________________________________________________
@@ -1152,7 +1162,7 @@ void RecoContainer::addMCHClusters(ProcessingContext& pc, bool mc)
   commonPool[GTrackID::MCH].registerContainer(pc.inputs().get<gsl::span<o2::mch::ROFRecord>>("clusMCHROF"), CLUSREFS);
   commonPool[GTrackID::MCH].registerContainer(pc.inputs().get<gsl::span<o2::mch::Cluster>>("clusMCH"), CLUSTERS);
   if (mc) {
-    mcMCHClusters = pc.inputs().get<const dataformats::MCTruthContainer<MCCompLabel>*>("clusMCHMC");
+    mcMCHClusters.set(lazyInput<dataformats::MCTruthContainer<MCCompLabel>>(pc, "clusMCHMC"));
   }
 }
 
@@ -1162,7 +1172,7 @@ void RecoContainer::addMIDClusters(ProcessingContext& pc, bool mc)
   commonPool[GTrackID::MID].registerContainer(pc.inputs().get<gsl::span<o2::mid::ROFRecord>>("clusMIDROF"), CLUSREFS);
   commonPool[GTrackID::MID].registerContainer(pc.inputs().get<gsl::span<o2::mid::Cluster>>("clusMID"), CLUSTERS);
   if (mc) {
-    mcMIDClusters = pc.inputs().get<const dataformats::MCTruthContainer<o2::mid::MCClusterLabel>*>("clusMIDMC");
+    mcMIDClusters.set(lazyInput<dataformats::MCTruthContainer<o2::mid::MCClusterLabel>>(pc, "clusMIDMC"));
   }
 }
 
@@ -1184,7 +1194,7 @@ void RecoContainer::addCPVClusters(ProcessingContext& pc, bool mc)
   commonPool[GTrackID::CPV].registerContainer(pc.inputs().get<gsl::span<o2::cpv::Cluster>>("CPVClusters"), CLUSTERS);
   commonPool[GTrackID::CPV].registerContainer(pc.inputs().get<gsl::span<o2::cpv::TriggerRecord>>("CPVTriggers"), CLUSREFS);
   if (mc) {
-    mcCPVClusters = pc.inputs().get<const dataformats::MCTruthContainer<MCCompLabel>*>("CPVClustersMC");
+    mcCPVClusters.set(lazyInput<dataformats::MCTruthContainer<MCCompLabel>>(pc, "CPVClustersMC"));
   }
 }
 
@@ -1194,7 +1204,7 @@ void RecoContainer::addPHOSCells(ProcessingContext& pc, bool mc)
   commonPool[GTrackID::PHS].registerContainer(pc.inputs().get<gsl::span<o2::phos::Cell>>("PHSCells"), CLUSTERS);
   commonPool[GTrackID::PHS].registerContainer(pc.inputs().get<gsl::span<o2::phos::TriggerRecord>>("PHSTriggers"), CLUSREFS);
   if (mc) {
-    mcPHSCells = pc.inputs().get<const dataformats::MCTruthContainer<o2::phos::MCLabel>*>("PHSCellsMC");
+    mcPHSCells.set(lazyInput<dataformats::MCTruthContainer<o2::phos::MCLabel>>(pc, "PHSCellsMC"));
   }
 }
 
@@ -1204,7 +1214,7 @@ void RecoContainer::addEMCALCells(ProcessingContext& pc, bool mc)
   commonPool[GTrackID::EMC].registerContainer(pc.inputs().get<gsl::span<o2::emcal::Cell>>("EMCCells"), CLUSTERS);
   commonPool[GTrackID::EMC].registerContainer(pc.inputs().get<gsl::span<o2::emcal::TriggerRecord>>("EMCTriggers"), CLUSREFS);
   if (mc) {
-    mcEMCCells = pc.inputs().get<const dataformats::MCTruthContainer<o2::emcal::MCLabel>*>("EMCCellsMC");
+    mcEMCCells.set(lazyInput<dataformats::MCTruthContainer<o2::emcal::MCLabel>>(pc, "EMCCellsMC"));
   }
 }
 
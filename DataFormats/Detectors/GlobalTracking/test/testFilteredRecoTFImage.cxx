@@ -0,0 +1,77 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test FilteredRecoTFImage
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "DataFormatsGlobalTracking/FilteredRecoTFImage.h"
+#include <stdexcept>
+#include <vector>
+
+using namespace o2::dataformats;
+using Image = FilteredRecoTFImage;
+
+BOOST_AUTO_TEST_CASE(FilteredRecoTFImage_test)
+{
+  Image::Sizes sizes{};
+  sizes[Image::ITSTrackROFs] = 2;
+  sizes[Image::ITSTracks] = 3;
+  sizes[Image::ITSClusterIndices] = 15;
+  sizes[Image::ITSClusterROFs] = 2;
+  sizes[Image::ITSClusters] = 11;
+  sizes[Image::ITSClusterPatterns] = 5;
+  auto size = Image::getSize(sizes);
+  BOOST_CHECK_EQUAL(size % Image::Alignment, 0);
+
+  FilteredRecoTF::Header tfHeader;
+  tfHeader.run = 523142;
+  tfHeader.firstTForbit = 1280;
+  tfHeader.creationTime = 1664000000000;
+  std::vector<uint64_t> storage(size / sizeof(uint64_t)); // aligned buffer
+  gsl::span<char> buffer(reinterpret_cast<char*>(storage.data()), size);
+  Image::create(buffer, sizes, tfHeader);
+
+  auto tracks = Image::getBlock<Image::ITSTracks>(buffer);
+  BOOST_CHECK_EQUAL(tracks.size(), 3);
+  for (int i = 0; i < 3; i++) {
+    tracks[i] = o2::its::TrackITS();
+    tracks[i].setFirstClusterEntry(5 * i);
+  }
+  auto patterns = Image::getBlock<Image::ITSClusterPatterns>(buffer);
+  for (size_t i = 0; i < patterns.size(); i++) {
+    patterns[i] = i + 1;
+  }
+  BOOST_CHECK(Image::getBlock<Image::ITSTrackMCTruth>(buffer).empty());
+
+  // read back through a const view of the same memory
+  gsl::span<const char> cbuffer(buffer.data(), buffer.size());
+  const auto& header = Image::get(cbuffer);
+  BOOST_CHECK_EQUAL(header.size, size);
+  BOOST_CHECK_EQUAL(header.getTFHeader().run, tfHeader.run);
+  BOOST_CHECK_EQUAL(header.getTFHeader().firstTForbit, tfHeader.firstTForbit);
+  BOOST_CHECK_EQUAL(header.getTFHeader().creationTime, tfHeader.creationTime);
+  auto ctracks = Image::getBlock<Image::ITSTracks>(cbuffer);
+  BOOST_REQUIRE_EQUAL(ctracks.size(), 3);
+  BOOST_CHECK_EQUAL(ctracks[2].getFirstClusterEntry(), 10);
+  auto cpatterns = Image::getBlock<Image::ITSClusterPatterns>(cbuffer);
+  BOOST_REQUIRE_EQUAL(cpatterns.size(), 5);
+  BOOST_CHECK_EQUAL(cpatterns[4], 5);
+  for (int ib = 0; ib < Image::NBlocks; ib++) {
+    BOOST_CHECK_EQUAL(header.blocks[ib].offset % Image::Alignment, 0);
+  }
+
+  // too small or corrupted buffers are refused
+  BOOST_CHECK_THROW(Image::create(buffer.subspan(0, size - Image::Alignment), sizes, tfHeader), std::runtime_error);
+  BOOST_CHECK_THROW(Image::get(cbuffer.subspan(0, size - Image::Alignment)), std::runtime_error);
+  buffer[0] = 'X';
+  BOOST_CHECK_THROW(Image::get(cbuffer), std::runtime_error);
+}
@@ -78,6 +78,45 @@ class NoiseMap
     }
   }
 
+  /// add the hits of a chip given by their sorted row/col keys: each distinct pixel is looked up once,
+  /// instead of one map lookup per hit
+  void increaseNoiseCountSorted(int chip, gsl::span<const int> sortedKeys)
+  {
+    assert(chip < (int)mNoisyPixels.size());
+    auto& ch = mNoisyPixels[chip];
+    for (size_t i = 0; i < sortedKeys.size();) {
+      const int k = sortedKeys[i];
+      size_t j = i + 1;
+      while (j < sortedKeys.size() && sortedKeys[j] == k) {
+        j++;
+      }
+      auto it = ch.lower_bound(k);
+      if (it == ch.end() || it->first != k) {
+        it = ch.emplace_hint(it, k, 0);
+      }
+      it->second += j - i;
+      i = j;
+    }
+  }
+
+  /// add the counts of another chip map, walking both ordered maps in a single pass
+  void addNoiseCounts(int chip, const std::map<int, int>& ext)
+  {
+    assert(chip < (int)mNoisyPixels.size());
+    auto& ch = mNoisyPixels[chip];
+    auto hint = ch.begin();
+    for (const auto& pix : ext) {
+      while (hint != ch.end() && hint->first < pix.first) {
+        ++hint;
+      }
+      if (hint == ch.end() || hint->first != pix.first) {
+        hint = ch.emplace_hint(hint, pix.first, 0);
+      }
+      hint->second += pix.second;
+      ++hint;
+    }
+  }
+
   int dumpAboveThreshold(int t = 3) const
   {
     int n = 0;
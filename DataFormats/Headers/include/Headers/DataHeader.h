@@ -442,6 +442,12 @@ struct BaseHeader {
   /// meaningful error message
   bool sanityCheck(uint32_t expectedVersion) const;
 
+  /// inline fast path of sanityCheck, the out-of-line check is only called to report a mismatch
+  inline bool checkVersion(uint32_t expectedVersion) const
+  {
+    return headerVersion == expectedVersion || sanityCheck(expectedVersion);
+  }
+
   /// throw runtime error to report inconsistent header stack when the next-header flag is set
   /// but no next header is found; implemented only once, no template overloads
   void throwInconsistentStackError() const;
@@ -467,7 +473,7 @@ auto get(const std::byte* buffer, size_t /*len*/ = 0)
     // otherwise, we keep the code related to the exception outside the header file.
     // Note: Can not check on size because the O2 data model requires variable size headers
     // to be supported.
-    if (current->sanityCheck(HeaderValueType::sVersion)) {
+    if (current->checkVersion(HeaderValueType::sVersion)) {
       return reinterpret_cast<HeaderConstPtrType>(current);
     }
   }
@@ -475,7 +481,7 @@ auto get(const std::byte* buffer, size_t /*len*/ = 0)
   while ((current = current->next())) {
     prev = current;
     if (current->description == HeaderValueType::sHeaderType) {
-      if (current->sanityCheck(HeaderValueType::sVersion)) {
+      if (current->checkVersion(HeaderValueType::sVersion)) {
         return reinterpret_cast<HeaderConstPtrType>(current);
       }
     }
@@ -31,7 +31,9 @@
 #include <boost/container/pmr/memory_resource.hpp>
 #include <boost/container/pmr/monotonic_buffer_resource.hpp>
 #include <boost/container/pmr/polymorphic_allocator.hpp>
+#include <atomic>
 #include <cstring>
+#include <memory>
 #include <string>
 #include <type_traits>
 #include <utility>
@@ -41,6 +43,7 @@
 #include <fairmq/TransportFactory.h>
 #include <fairmq/MemoryResources.h>
 #include <fairmq/MemoryResourceTools.h>
+#include <fairmq/UnmanagedRegion.h>
 
 namespace o2::pmr
 {
@@ -296,6 +299,91 @@ class NoConstructAllocator : public boost::container::pmr::polymorphic_allocator
   }
 };
 
+//__________________________________________________________________________________________________
+/// An arena of messages sub-allocated from a single unmanaged region of the transport, meant for the
+/// many small outputs of a timeslice: creating a slice costs a pointer increment instead of a
+/// round trip to the (shared memory) segment manager, and the segment is not fragmented by them.
+/// The region is split in blocks of equal size. Slices are carved sequentially from the current
+/// block; a block can be reused once all the messages created out of it have been released (the
+/// transport notifies it via the region callback, possibly from another thread). Call nextBlock()
+/// when starting a new batch of messages, e.g. a new timeslice, so that slices in a block share a
+/// similar lifetime. newMessage() is not thread safe.
+class MessageArena
+{
+ public:
+  MessageArena(fair::mq::TransportFactory* factory, size_t blockSize, size_t nBlocks)
+    : mFactory{factory},
+      mBlockSize{blockSize},
+      mNBlocks{nBlocks},
+      mPending{std::make_unique<std::atomic<size_t>[]>(nBlocks)}
+  {
+    if (mFactory == nullptr || mBlockSize == 0 || mNBlocks == 0) {
+      throw std::runtime_error("MessageArena::MessageArena requires a transport and a non empty region");
+    }
+    fair::mq::RegionConfig cfg;
+    mRegion = mFactory->CreateUnmanagedRegion(
+      mBlockSize * mNBlocks, fair::mq::RegionCallback{[pending = mPending.get()](void*, size_t, void* hint) {
+        pending[reinterpret_cast<size_t>(hint)].fetch_sub(1, std::memory_order_release);
+      }},
+      cfg);
+    mBase = static_cast<char*>(mRegion->GetData());
+  }
+  MessageArena(const MessageArena&) = delete;
+  MessageArena& operator=(const MessageArena&) = delete;
+
+  /// Create a message of @a size bytes in the current block, moving to a free block if it does not fit.
+  /// Returns nullptr if no block is available, in which case the caller should use the transport directly.
+  fair::mq::MessagePtr newMessage(size_t size, size_t alignment = 64)
+  {
+    if (size > mBlockSize) {
+      return nullptr;
+    }
+    size_t offset = (mOffset + alignment - 1) / alignment * alignment;
+    if (mCurrent == mNBlocks || offset + size > mBlockSize) {
+      if (!nextBlock()) {
+        return nullptr;
+      }
+      offset = 0;
+    }
+    mPending[mCurrent].fetch_add(1, std::memory_order_relaxed);
+    mOffset = offset + size;
+    return mFactory->CreateMessage(mRegion, mBase + mCurrent * mBlockSize + offset, size, reinterpret_cast<void*>(mCurrent));
+  }
+
+  /// Move to a block all of whose messages were released. Does nothing if the current one is still empty.
+  bool nextBlock()
+  {
+    if (mCurrent != mNBlocks && mOffset == 0) {
+      return true;
+    }
+    for (size_t i = 1; i <= mNBlocks; ++i) {
+      size_t candidate = (mCurrent + i) % (mNBlocks + 1);
+      if (candidate != mNBlocks && candidate != mCurrent && mPending[candidate].load(std::memory_order_acquire) == 0) {
+        mCurrent = candidate;
+        mOffset = 0;
+        return true;
+      }
+    }
+    mCurrent = mNBlocks; // arena exhausted, retry at next call
+    mOffset = 0;
+    return false;
+  }
+
+  fair::mq::TransportFactory* getTransportFactory() const noexcept { return mFactory; }
+  size_t getBlockSize() const noexcept { return mBlockSize; }
+  size_t getNBlocks() const noexcept { return mNBlocks; }
+
+ private:
+  fair::mq::TransportFactory* mFactory = nullptr;
+  size_t mBlockSize = 0;
+  size_t mNBlocks = 0;
+  std::unique_ptr<std::atomic<size_t>[]> mPending; // messages of each block not yet released, must outlive the region
+  fair::mq::UnmanagedRegionPtr mRegion;
+  char* mBase = nullptr;
+  size_t mCurrent = mNBlocks; // mNBlocks means no block is in use
+  size_t mOffset = 0;
+};
+
 //__________________________________________________________________________________________________
 //__________________________________________________________________________________________________
 //__________________________________________________________________________________________________
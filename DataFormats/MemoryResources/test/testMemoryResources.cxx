@@ -190,6 +190,34 @@ BOOST_AUTO_TEST_CASE(adoptVector_test)
   BOOST_CHECK(modifiedMessage.get() != messageAddr);
 }
 
+BOOST_AUTO_TEST_CASE(messageArena_test)
+{
+  auto factoryZMQ = fair::mq::TransportFactory::CreateTransportFactory("zeromq");
+  MessageArena arena(factoryZMQ.get(), 1024, 2);
+
+  auto m1 = arena.newMessage(100);
+  auto m2 = arena.newMessage(100);
+  BOOST_REQUIRE(m1 != nullptr && m2 != nullptr);
+  BOOST_CHECK(m1->GetSize() == 100);
+  BOOST_CHECK(static_cast<char*>(m2->GetData()) == static_cast<char*>(m1->GetData()) + 128);
+  BOOST_CHECK(arena.newMessage(2000) == nullptr);
+
+  // a new batch goes to the other block
+  BOOST_CHECK(arena.nextBlock());
+  auto m3 = arena.newMessage(1000);
+  BOOST_REQUIRE(m3 != nullptr);
+  BOOST_CHECK(static_cast<char*>(m3->GetData()) == static_cast<char*>(m1->GetData()) + 1024);
+  // the first block is still in use, the second one is full
+  BOOST_CHECK(arena.newMessage(100) == nullptr);
+
+  // once released, the first block can be reused
+  m1.reset();
+  m2.reset();
+  auto m4 = arena.newMessage(100);
+  BOOST_REQUIRE(m4 != nullptr);
+  BOOST_CHECK(static_cast<char*>(m4->GetData()) == static_cast<char*>(m3->GetData()) - 1024);
+}
+
 BOOST_AUTO_TEST_CASE(test_SpectatorMemoryResource)
 {
   constexpr int size = 5;
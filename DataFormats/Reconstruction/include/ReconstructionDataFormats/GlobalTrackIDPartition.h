@@ -0,0 +1,179 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   GlobalTrackIDPartition.h
+/// @brief  Grouping of a batch of GlobalTrackID / VtxTrackIndex by source, for the gathers from the per source containers
+
+#ifndef O2_GLOBALTRACKID_PARTITION_H
+#define O2_GLOBALTRACKID_PARTITION_H
+
+#include "ReconstructionDataFormats/GlobalTrackID.h"
+#include "ReconstructionDataFormats/VtxTrackRef.h"
+#include "CommonDataFormat/AbstractRefAccessor.h"
+#include <array>
+#include <vector>
+#include <gsl/span>
+
+namespace o2
+{
+namespace dataformats
+{
+
+/*
+  GlobalTrackIDPartition sorts a batch of track references by source with a single counting sort pass
+  on the source bits (stable, so the order of the batch is kept within each source). Then every
+  source is processed as a block of indices in its own container, without a switch on the source
+  per element, e.g.
+    GlobalTrackIDPartition part;
+    part.partition(gids);
+    part.gather(accessor, tracks.data());           // tracks[i] = accessor.get(gids[i]) for the loaded sources
+    part.forEachSource([&](int src, auto positions, auto indices) { ... });
+  The buffers are kept between the calls to avoid reallocations.
+*/
+
+class GlobalTrackIDPartition
+{
+ public:
+  static constexpr int NSources = GlobalTrackID::NSources;
+
+  /// partition the references of the batch
+  template <typename I>
+  void partition(gsl::span<const I> ids)
+  {
+    mCounts.fill(0);
+    for (const auto& id : ids) {
+      mCounts[id.getSource()]++;
+    }
+    fillOffsets();
+    mPositions.resize(ids.size());
+    mIndices.resize(ids.size());
+    mVertices.clear();
+    auto next = mOffsets;
+    for (size_t i = 0; i < ids.size(); i++) {
+      const int slot = next[ids[i].getSource()]++;
+      mPositions[slot] = i;
+      mIndices[slot] = ids[i].getIndex();
+    }
+  }
+
+  template <typename I>
+  void partition(const std::vector<I>& ids)
+  {
+    partition(gsl::span<const I>(ids));
+  }
+
+  /// partition the track indices of all the vertex references: since the indices of each reference are
+  /// already sorted by source, the blocks of their sources are copied at once. The positions refer to the
+  /// entries of @a ids and the reference (vertex) of every entry is kept as well
+  void partition(gsl::span<const VtxTrackRef> refs, gsl::span<const VtxTrackIndex> ids)
+  {
+    mCounts.fill(0);
+    for (const auto& ref : refs) {
+      for (int src = 0; src < NSources; src++) {
+        mCounts[src] += ref.getEntriesOfSource(src);
+      }
+    }
+    fillOffsets();
+    const size_t n = mOffsets[NSources - 1] + mCounts[NSources - 1];
+    mPositions.resize(n);
+    mIndices.resize(n);
+    mVertices.resize(n);
+    auto next = mOffsets;
+    for (int iref = 0; iref < (int)refs.size(); iref++) {
+      const auto& ref = refs[iref];
+      for (int src = 0; src < NSources; src++) {
+        const int first = ref.getFirstEntryOfSource(src), nent = ref.getEntriesOfSource(src);
+        int slot = next[src];
+        for (int i = first; i < first + nent; i++, slot++) {
+          mPositions[slot] = i;
+          mIndices[slot] = ids[i].getIndex();
+          mVertices[slot] = iref;
+        }
+        next[src] = slot;
+      }
+    }
+  }
+
+  size_t size() const { return mPositions.size(); }
+  int getEntriesOfSource(int src) const { return mCounts[src]; }
+
+  /// positions in the partitioned batch of the references of the source
+  gsl::span<const int> getPositions(int src) const { return {mPositions.data() + mOffsets[src], size_t(mCounts[src])}; }
+  /// indices in the container of the source
+  gsl::span<const int> getIndices(int src) const { return {mIndices.data() + mOffsets[src], size_t(mCounts[src])}; }
+  /// references (vertices) the entries of the source belong to, only for the partition of VtxTrackRefs
+  gsl::span<const int> getVertices(int src) const { return mVertices.empty() ? gsl::span<const int>() : gsl::span<const int>{mVertices.data() + mOffsets[src], size_t(mCounts[src])}; }
+
+  /// call f(src, positions, indices) for every source with entries
+  template <typename F>
+  void forEachSource(F&& f) const
+  {
+    for (int src = 0; src < NSources; src++) {
+      if (mCounts[src]) {
+        f(src, getPositions(src), getIndices(src));
+      }
+    }
+  }
+
+  /// out[position] = cont[index] for the entries of the source
+  template <typename U, typename O>
+  void gather(int src, gsl::span<const U> cont, O* out) const
+  {
+    const int *pos = mPositions.data() + mOffsets[src], *idx = mIndices.data() + mOffsets[src];
+    for (int i = 0; i < mCounts[src]; i++) {
+      out[pos[i]] = cont[idx[i]];
+    }
+  }
+
+  /// out[position] = accessor.get(reference) for the entries of all the sources loaded in the accessor
+  /// (the containers may hold types derived from T, hence the access with the stride of each container)
+  /// @returns the mask of the sources which had entries but were not loaded and thus were not filled
+  template <typename T, int N, typename O>
+  GlobalTrackID::mask_t gather(const AbstractRefAccessor<T, N>& accessor, O* out) const
+  {
+    GlobalTrackID::mask_t missing;
+    for (int src = 0; src < NSources; src++) {
+      if (!mCounts[src]) {
+        continue;
+      }
+      if (!accessor.isLoaded(src)) {
+        missing.set(src);
+        continue;
+      }
+      const int *pos = mPositions.data() + mOffsets[src], *idx = mIndices.data() + mOffsets[src];
+      for (int i = 0; i < mCounts[src]; i++) {
+        out[pos[i]] = accessor.get(src, idx[i]);
+      }
+    }
+    return missing;
+  }
+
+ private:
+  void fillOffsets()
+  {
+    int offset = 0;
+    for (int src = 0; src < NSources; src++) {
+      mOffsets[src] = offset;
+      offset += mCounts[src];
+    }
+  }
+
+  std::array<int, NSources> mCounts{};
+  std::array<int, NSources> mOffsets{};
+  std::vector<int> mPositions;
+  std::vector<int> mIndices;
+  std::vector<int> mVertices;
+};
+
+} // namespace dataformats
+} // namespace o2
+
+#endif
@@ -0,0 +1,211 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   TrackParCovBatch.h
+/// @brief  Structure-of-arrays batch of tracks with covariance, for the same operation applied to many tracks
+
+#ifndef INCLUDE_RECONSTRUCTIONDATAFORMATS_TRACKPARCOVBATCH_H_
+#define INCLUDE_RECONSTRUCTIONDATAFORMATS_TRACKPARCOVBATCH_H_
+
+#include "ReconstructionDataFormats/TrackParametrizationWithError.h"
+#include "CommonConstants/MathConstants.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace o2
+{
+namespace track
+{
+
+/// W tracks stored as structure of arrays: every operation is a loop over the lanes with the math
+/// of TrackParametrizationWithError written without branches, so that the compiler can vectorize it.
+/// The lanes for which the operation is not possible are masked and left untouched.
+template <typename value_T = float, int W = 8>
+class TrackParCovBatch
+{
+ public:
+  using value_t = value_T;
+  using track_t = TrackParametrizationWithError<value_T>;
+  static constexpr int Width = W;
+  static_assert(W > 0 && W <= 32, "the lane masks are 32 bits wide");
+
+  int size() const { return mSize; }
+  bool full() const { return mSize == W; }
+  void clear() { mSize = 0; }
+
+  /// append a copy of the parameters and covariance of the track
+  /// @returns its lane, -1 if the batch is full
+  int add(const track_t& trc)
+  {
+    if (mSize == W) {
+      return -1;
+    }
+    const int lane = mSize++;
+    mX[lane] = trc.getX();
+    mCharged[lane] = trc.getAbsCharge() != 0;
+    mModified[lane] = false;
+    for (int i = 0; i < kNParams; i++) {
+      mP[i][lane] = trc.getParam(i);
+    }
+    for (int i = 0; i < kCovMatSize; i++) {
+      mC[i][lane] = trc.getCov()[i];
+    }
+    return lane;
+  }
+
+  /// copy the lane back to the track it was added from
+  void get(int lane, track_t& trc) const
+  {
+    trc.setX(mX[lane]);
+    for (int i = 0; i < kNParams; i++) {
+      trc.setParam(mP[i][lane], i);
+    }
+    for (int i = 0; i < kCovMatSize; i++) {
+      trc.setCov(mC[i][lane], i);
+    }
+    if (mModified[lane]) {
+      trc.checkCovariance();
+    }
+  }
+
+  value_t getX(int lane) const { return mX[lane]; }
+  value_t getParam(int i, int lane) const { return mP[i][lane]; }
+  value_t getCov(int i, int lane) const { return mC[i][lane]; }
+
+  /// propagate the track of each lane to the plane X = xk[lane] in the field b (kG), as TrackParametrizationWithError::propagateTo
+  /// @returns the mask of the lanes for which the propagation succeeded
+  uint32_t propagateTo(const value_t* xk, value_t b);
+  uint32_t propagateTo(value_t xk, value_t b)
+  {
+    value_t xks[W];
+    std::fill(xks, xks + W, xk);
+    return propagateTo(xks, b);
+  }
+
+  /// chi2 of the space points (y, z) with covariance (sy2, syz, sz2) of each lane, as TrackParametrizationWithError::getPredictedChi2
+  void getPredictedChi2(const value_t* y, const value_t* z, const value_t* sy2, const value_t* syz, const value_t* sz2, value_t* chi2) const;
+
+ private:
+  int mSize = 0;
+  value_t mX[W] = {};
+  value_t mP[kNParams][W] = {};
+  value_t mC[kCovMatSize][W] = {};
+  bool mCharged[W] = {};
+  bool mModified[W] = {}; // the covariance was propagated and is to be checked before being copied back
+};
+
+//______________________________________________________________
+template <typename value_T, int W>
+inline uint32_t TrackParCovBatch<value_T, W>::propagateTo(const value_t* xk, value_t b)
+{
+  using namespace o2::constants::math;
+  uint32_t okMask = 0;
+  for (int lane = 0; lane < W; lane++) {
+    const value_t dx = xk[lane] - mX[lane];
+    const value_t crv = mCharged[lane] ? mP[kQ2Pt][lane] * b * B2C : 0.f;
+    const value_t x2r = crv * dx;
+    const value_t f1 = mP[kSnp][lane], f2 = f1 + x2r;
+    const value_t r1 = std::sqrt(std::max(value_t(0), (1.f - f1) * (1.f + f1)));
+    const value_t r2 = std::sqrt(std::max(value_t(0), (1.f - f2) * (1.f + f2)));
+    const bool move = lane < mSize && std::abs(dx) >= Almost0;
+    bool ok = std::abs(f1) <= Almost1 && std::abs(f2) <= Almost1 && std::abs(r1) >= Almost0 && std::abs(r2) >= Almost0;
+    const double dy2dx = (f1 + f2) / (r1 + r2);
+    const bool arcz = std::abs(x2r) > 0.05f;
+    const value_t arg = r1 * f2 - r2 * f1;
+    ok = ok && (!arcz || std::abs(arg) <= Almost1);
+    value_t rot = std::asin(std::clamp(arg, value_t(-1), value_t(1)));
+    if (f1 * f1 + f2 * f2 > 1.f && f1 * f2 < 0.f) { // special cases of large rotations or large abs angles
+      rot = f2 > 0.f ? PI - rot : -PI - rot;
+    }
+    const value_t tgl = mP[kTgl][lane];
+    const value_t dz = arcz ? value_t(tgl / crv * rot) : value_t(dx * (r2 + f2 * dy2dx) * tgl);
+    const value_t dy = dx * dy2dx;
+    const bool upd = move && ok;
+    const bool done = lane < mSize && (!move || ok);
+    okMask |= uint32_t(done) << lane;
+    mModified[lane] = mModified[lane] || upd;
+
+    mX[lane] = upd ? xk[lane] : mX[lane];
+    mP[kY][lane] = upd ? mP[kY][lane] + dy : mP[kY][lane];
+    mP[kZ][lane] = upd ? mP[kZ][lane] + dz : mP[kZ][lane];
+    mP[kSnp][lane] = upd ? std::clamp(value_t(f1 + x2r), -Almost1, Almost1) : mP[kSnp][lane];
+
+    // evaluate matrix in double prec.
+    const double rinv = 1. / r1;
+    const double r3inv = rinv * rinv * rinv;
+    const double f24 = dx * b * B2C; // x2r/mP[kQ2Pt];
+    const double f02 = dx * r3inv;
+    const double f04 = 0.5 * f24 * f02;
+    const double f12 = f02 * tgl * f1;
+    const double f14 = 0.5 * f24 * f12;
+    const double f13 = dx * rinv;
+
+    const double c20 = mC[kSigSnpY][lane], c21 = mC[kSigSnpZ][lane], c22 = mC[kSigSnp2][lane], c30 = mC[kSigTglY][lane], c31 = mC[kSigTglZ][lane],
+                 c32 = mC[kSigTglSnp][lane], c33 = mC[kSigTgl2][lane], c40 = mC[kSigQ2PtY][lane], c41 = mC[kSigQ2PtZ][lane],
+                 c42 = mC[kSigQ2PtSnp][lane], c43 = mC[kSigQ2PtTgl][lane], c44 = mC[kSigQ2Pt2][lane];
+
+    // b = C*ft
+    const double b00 = f02 * c20 + f04 * c40, b01 = f12 * c20 + f14 * c40 + f13 * c30;
+    const double b02 = f24 * c40;
+    const double b10 = f02 * c21 + f04 * c41, b11 = f12 * c21 + f14 * c41 + f13 * c31;
+    const double b12 = f24 * c41;
+    const double b20 = f02 * c22 + f04 * c42, b21 = f12 * c22 + f14 * c42 + f13 * c32;
+    const double b22 = f24 * c42;
+    const double b40 = f02 * c42 + f04 * c44, b41 = f12 * c42 + f14 * c44 + f13 * c43;
+    const double b42 = f24 * c44;
+    const double b30 = f02 * c32 + f04 * c43, b31 = f12 * c32 + f14 * c43 + f13 * c33;
+    const double b32 = f24 * c43;
+
+    // a = f*b = f*C*ft
+    const double a00 = f02 * b20 + f04 * b40, a01 = f02 * b21 + f04 * b41, a02 = f02 * b22 + f04 * b42;
+    const double a11 = f12 * b21 + f14 * b41 + f13 * b31, a12 = f12 * b22 + f14 * b42 + f13 * b32;
+    const double a22 = f24 * b42;
+
+    // F*C*Ft = C + (b + bt + a)
+    auto add = [upd, lane, this](int i, double delta) { mC[i][lane] = upd ? value_t(mC[i][lane] + delta) : mC[i][lane]; };
+    add(kSigY2, b00 + b00 + a00);
+    add(kSigZY, b10 + b01 + a01);
+    add(kSigSnpY, b20 + b02 + a02);
+    add(kSigTglY, b30);
+    add(kSigQ2PtY, b40);
+    add(kSigZ2, b11 + b11 + a11);
+    add(kSigSnpZ, b21 + b12 + a12);
+    add(kSigTglZ, b31);
+    add(kSigQ2PtZ, b41);
+    add(kSigSnp2, b22 + b22 + a22);
+    add(kSigTglSnp, b32);
+    add(kSigQ2PtSnp, b42);
+  }
+  return okMask;
+}
+
+//______________________________________________________________
+template <typename value_T, int W>
+inline void TrackParCovBatch<value_T, W>::getPredictedChi2(const value_t* y, const value_t* z, const value_t* sy2, const value_t* syz,
+                                                           const value_t* sz2, value_t* chi2) const
+{
+  for (int lane = 0; lane < W; lane++) {
+    const double sdd = static_cast<double>(mC[kSigY2][lane]) + static_cast<double>(sy2[lane]);
+    const double sdz = static_cast<double>(mC[kSigZY][lane]) + static_cast<double>(syz[lane]);
+    const double szz = static_cast<double>(mC[kSigZ2][lane]) + static_cast<double>(sz2[lane]);
+    const double det = sdd * szz - sdz * sdz;
+    const value_t d = mP[kY][lane] - y[lane];
+    const value_t dz = mP[kZ][lane] - z[lane];
+    const bool ok = std::abs(det) >= o2::constants::math::Almost0;
+    chi2[lane] = ok ? value_t((d * (szz * d - sdz * dz) + dz * (sdd * dz - d * sdz)) / det) : o2::constants::math::VeryBig;
+  }
+}
+
+} // namespace track
+} // namespace o2
+
+#endif
@@ -0,0 +1,77 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file   bench_TrackParCovBatch.cxx
+/// \brief  Benchmark of the propagation in constant field of many tracks, one by one and in TrackParCovBatch
+
+#include "benchmark/benchmark.h"
+#include "ReconstructionDataFormats/Track.h"
+#include "ReconstructionDataFormats/TrackParCovBatch.h"
+#include <TRandom.h>
+#include <vector>
+
+using namespace o2::track;
+
+constexpr int NTracks = 4096;
+constexpr float Bz = -5.f, XRef = 70.f;
+
+std::vector<TrackParCov> generateTracks()
+{
+  gRandom->SetSeed(1);
+  std::vector<TrackParCov> tracks;
+  std::array<float, kCovMatSize> cov = {1e-2, 1e-4, 1e-2, 1e-5, 1e-6, 1e-4, 1e-6, 1e-6, 1e-7, 1e-4, 1e-5, 1e-6, 1e-6, 1e-7, 1e-3};
+  for (int i = 0; i < NTracks; i++) {
+    std::array<float, kNParams> par = {gRandom->Uniform(-5.f, 5.f), gRandom->Uniform(-10.f, 10.f), gRandom->Uniform(-0.3f, 0.3f),
+                                       gRandom->Uniform(-1.f, 1.f), gRandom->Uniform(-2.f, 2.f)};
+    tracks.emplace_back(gRandom->Uniform(2.f, 40.f), 0.f, par, cov);
+  }
+  return tracks;
+}
+
+static void BM_PropagateScalar(benchmark::State& state)
+{
+  const auto tracks = generateTracks();
+  for (auto _ : state) {
+    auto work = tracks;
+    for (auto& trc : work) {
+      benchmark::DoNotOptimize(trc.propagateTo(XRef, Bz));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * NTracks);
+}
+
+template <int W>
+static void BM_PropagateBatch(benchmark::State& state)
+{
+  const auto tracks = generateTracks();
+  for (auto _ : state) {
+    auto work = tracks;
+    TrackParCovBatch<float, W> batch;
+    for (int first = 0; first < NTracks; first += W) {
+      batch.clear();
+      for (int i = first; i < first + W && i < NTracks; i++) {
+        batch.add(work[i]);
+      }
+      benchmark::DoNotOptimize(batch.propagateTo(XRef, Bz));
+      for (int i = 0; i < batch.size(); i++) {
+        batch.get(i, work[first + i]);
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * NTracks);
+}
+
+BENCHMARK(BM_PropagateScalar);
+BENCHMARK_TEMPLATE(BM_PropagateBatch, 4);
+BENCHMARK_TEMPLATE(BM_PropagateBatch, 8);
+BENCHMARK_TEMPLATE(BM_PropagateBatch, 16);
+
+BENCHMARK_MAIN();
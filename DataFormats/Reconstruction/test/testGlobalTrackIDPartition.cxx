@@ -0,0 +1,94 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test GlobalTrackIDPartition class
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "ReconstructionDataFormats/GlobalTrackIDPartition.h"
+#include <vector>
+
+using namespace o2::dataformats;
+using GTrackID = GlobalTrackID;
+
+// the partition gives the same result as the access element by element
+BOOST_AUTO_TEST_CASE(GlobalTrackIDPartition_gather)
+{
+  std::vector<int> itsTracks{10, 11, 12, 13}, tpcTracks{20, 21, 22}, itstpcTracks{30, 31};
+  AbstractRefAccessor<int, GTrackID::NSources> accessor;
+  accessor.registerContainer(itsTracks, GTrackID::ITS);
+  accessor.registerContainer(tpcTracks, GTrackID::TPC);
+  accessor.registerContainer(itstpcTracks, GTrackID::ITSTPC);
+
+  std::vector<GTrackID> gids{{1, GTrackID::TPC}, {3, GTrackID::ITS}, {0, GTrackID::ITSTPC}, {0, GTrackID::ITS}, {2, GTrackID::TPC}, {1, GTrackID::ITSTPC}, {2, GTrackID::ITS}};
+  GlobalTrackIDPartition part;
+  part.partition(gids);
+  BOOST_CHECK_EQUAL(part.size(), gids.size());
+  BOOST_CHECK_EQUAL(part.getEntriesOfSource(GTrackID::ITS), 3);
+  BOOST_CHECK_EQUAL(part.getEntriesOfSource(GTrackID::TPC), 2);
+  BOOST_CHECK_EQUAL(part.getEntriesOfSource(GTrackID::TOF), 0);
+  // the order of the batch is kept within the source
+  auto pos = part.getPositions(GTrackID::ITS);
+  BOOST_CHECK_EQUAL(pos[0], 1);
+  BOOST_CHECK_EQUAL(pos[1], 3);
+  BOOST_CHECK_EQUAL(pos[2], 6);
+
+  std::vector<int> out(gids.size(), -1);
+  BOOST_CHECK(part.gather(accessor, out.data()).none());
+  for (size_t i = 0; i < gids.size(); i++) {
+    BOOST_CHECK_EQUAL(out[i], accessor.get(gids[i]));
+  }
+
+  int nVisited = 0;
+  part.forEachSource([&](int src, gsl::span<const int> positions, gsl::span<const int> indices) {
+    BOOST_REQUIRE_EQUAL(positions.size(), indices.size());
+    for (size_t i = 0; i < positions.size(); i++) {
+      BOOST_CHECK_EQUAL(gids[positions[i]].getSource(), src);
+      BOOST_CHECK_EQUAL(gids[positions[i]].getIndex(), indices[i]);
+      nVisited++;
+    }
+  });
+  BOOST_CHECK_EQUAL(nVisited, gids.size());
+
+  // a source with entries which is not loaded is reported
+  gids.emplace_back(0, GTrackID::TOF);
+  part.partition(gids);
+  BOOST_CHECK(part.gather(accessor, out.data()) == GTrackID::getSourceMask(GTrackID::TOF));
+}
+
+BOOST_AUTO_TEST_CASE(GlobalTrackIDPartition_vertices)
+{
+  // 2 vertices with ITS and TPC tracks, the entries of each one being sorted by source
+  std::vector<VtxTrackIndex> ids{{0, GTrackID::ITS}, {1, GTrackID::ITS}, {5, GTrackID::TPC}, {2, GTrackID::ITS}, {6, GTrackID::TPC}, {7, GTrackID::TPC}};
+  std::vector<VtxTrackRef> refs(2);
+  for (int src = 0; src < GTrackID::NSources; src++) {
+    refs[0].setFirstEntryOfSource(src, src <= GTrackID::ITS ? 0 : (src <= GTrackID::TPC ? 2 : 3));
+    refs[1].setFirstEntryOfSource(src, src <= GTrackID::ITS ? 3 : (src <= GTrackID::TPC ? 4 : 6));
+  }
+  refs[0].setEnd(3);
+  refs[1].setEnd(6);
+
+  GlobalTrackIDPartition part;
+  part.partition(refs, ids);
+  BOOST_CHECK_EQUAL(part.size(), ids.size());
+  auto itsIdx = part.getIndices(GTrackID::ITS);
+  auto itsVtx = part.getVertices(GTrackID::ITS);
+  BOOST_REQUIRE_EQUAL(itsIdx.size(), 3);
+  BOOST_CHECK_EQUAL(itsIdx[2], 2);
+  BOOST_CHECK_EQUAL(itsVtx[0], 0);
+  BOOST_CHECK_EQUAL(itsVtx[2], 1);
+  auto tpcPos = part.getPositions(GTrackID::TPC);
+  auto tpcVtx = part.getVertices(GTrackID::TPC);
+  BOOST_REQUIRE_EQUAL(tpcPos.size(), 3);
+  BOOST_CHECK_EQUAL(tpcPos[0], 2);
+  BOOST_CHECK_EQUAL(tpcVtx[0], 0);
+  BOOST_CHECK_EQUAL(tpcVtx[1], 1);
+}
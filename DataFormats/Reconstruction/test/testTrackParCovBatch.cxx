@@ -0,0 +1,89 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test TrackParCovBatch class
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "ReconstructionDataFormats/Track.h"
+#include "ReconstructionDataFormats/TrackParCovBatch.h"
+#include <TRandom.h>
+#include <vector>
+
+using namespace o2::track;
+
+namespace
+{
+TrackParCov generateTrack(float x, float q2pt, float snp)
+{
+  std::array<float, kNParams> par = {gRandom->Uniform(-5.f, 5.f), gRandom->Uniform(-10.f, 10.f), snp, gRandom->Uniform(-1.f, 1.f), q2pt};
+  std::array<float, kCovMatSize> cov = {1e-2, 1e-4, 1e-2, 1e-5, 1e-6, 1e-4, 1e-6, 1e-6, 1e-7, 1e-4, 1e-5, 1e-6, 1e-6, 1e-7, 1e-3};
+  return TrackParCov(x, 0.f, par, cov);
+}
+} // namespace
+
+// the batch gives the same results as the track by track propagation, including for the failing lanes
+BOOST_AUTO_TEST_CASE(TrackParCovBatch_propagateTo)
+{
+  constexpr int W = 8;
+  const float bz = -5.f, xTgt = 70.f;
+  gRandom->SetSeed(1);
+  for (int iter = 0; iter < 100; iter++) {
+    std::vector<TrackParCov> tracks;
+    TrackParCovBatch<float, W> batch;
+    for (int i = 0; i < W - 1; i++) { // leave one lane empty
+      // large snp and large q/pt make some of the propagations fail
+      tracks.push_back(generateTrack(gRandom->Uniform(2.f, 40.f), gRandom->Uniform(-10.f, 10.f), gRandom->Uniform(-0.99f, 0.99f)));
+      BOOST_CHECK_EQUAL(batch.add(tracks.back()), i);
+    }
+    auto mask = batch.propagateTo(xTgt, bz);
+    BOOST_CHECK(!(mask & (1u << (W - 1))));
+    for (int i = 0; i < W - 1; i++) {
+      auto ref = tracks[i];
+      bool ok = ref.propagateTo(xTgt, bz);
+      BOOST_CHECK_EQUAL(ok, bool(mask & (1u << i)));
+      auto res = tracks[i];
+      batch.get(i, res);
+      BOOST_CHECK_CLOSE(res.getX(), ref.getX(), 1e-4);
+      for (int ip = 0; ip < kNParams; ip++) {
+        BOOST_CHECK_SMALL(res.getParam(ip) - ref.getParam(ip), 1e-4f * (1.f + std::abs(ref.getParam(ip))));
+      }
+      for (int ic = 0; ic < kCovMatSize; ic++) {
+        BOOST_CHECK_SMALL(res.getCov()[ic] - ref.getCov()[ic], 1e-4f * (1e-6f + std::abs(ref.getCov()[ic])));
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TrackParCovBatch_getPredictedChi2)
+{
+  constexpr int W = 4;
+  TrackParCovBatch<float, W> batch;
+  std::vector<TrackParCov> tracks;
+  float y[W], z[W], sy2[W], syz[W], sz2[W], chi2[W];
+  gRandom->SetSeed(2);
+  for (int i = 0; i < W; i++) {
+    tracks.push_back(generateTrack(10.f, 1.f, 0.1f));
+    batch.add(tracks.back());
+    y[i] = tracks.back().getY() + gRandom->Gaus(0., 0.1);
+    z[i] = tracks.back().getZ() + gRandom->Gaus(0., 0.1);
+    sy2[i] = sz2[i] = 0.01f;
+    syz[i] = 0.f;
+  }
+  BOOST_CHECK(batch.full());
+  BOOST_CHECK_EQUAL(batch.add(tracks.back()), -1);
+  batch.getPredictedChi2(y, z, sy2, syz, sz2, chi2);
+  for (int i = 0; i < W; i++) {
+    std::array<float, 2> p = {y[i], z[i]};
+    std::array<float, 3> c = {sy2[i], syz[i], sz2[i]};
+    BOOST_CHECK_CLOSE(chi2[i], tracks[i].getPredictedChi2(p, c), 1e-4);
+  }
+}
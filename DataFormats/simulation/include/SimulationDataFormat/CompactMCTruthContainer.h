@@ -0,0 +1,181 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file CompactMCTruthContainer.h
+/// \brief A memory-compact, append-only version of MCTruthContainer
+
+#ifndef O2_COMPACTMCTRUTHCONTAINER_H
+#define O2_COMPACTMCTRUTHCONTAINER_H
+
+#include <SimulationDataFormat/MCTruthContainer.h>
+
+namespace o2
+{
+namespace dataformats
+{
+
+/// @class CompactMCTruthContainer
+/// @brief An append-only container of MC truth storing runs of consecutive data indices
+///
+/// Consecutive data indices with identical sets of truth elements (e.g. the digits of
+/// neighbouring pads or time bins produced by the same track) share a single copy of their
+/// truth elements and a single MCTruthRunElement instead of one MCTruthHeaderElement each.
+/// Random access to a data index is a binary search in the array of runs.
+///
+/// The container is filled in a streaming way with the same interface as MCTruthContainer
+/// (strictly consecutive data indices) and flattened with flatten_to to the compact
+/// layout (version 2 of the flat header) which is read in place by ConstMCTruthContainer
+/// and ConstMCTruthContainerView and expanded by MCTruthContainer::restore_from.
+template <typename TruthElement>
+class CompactMCTruthContainer
+{
+ public:
+  using FlatHeader = typename MCTruthContainer<TruthElement>::FlatHeader;
+
+  // return the number of original data indexed here
+  size_t getIndexedSize() const { return mNIndexed; }
+  // return the number of elements (labels) stored in this container
+  size_t getNElements() const { return mTruthArray.size(); }
+  // return the number of runs of data indices with identical labels
+  size_t getNRuns() const { return mRunArray.size(); }
+
+  // get the labels of a given data index
+  gsl::span<const TruthElement> getLabels(uint32_t dataindex) const
+  {
+    if (dataindex >= mNIndexed) {
+      return gsl::span<const TruthElement>();
+    }
+    const auto irun = findMCTruthRun(mRunArray.data(), mRunArray.size(), dataindex);
+    const auto start = mRunArray[irun].index;
+    const auto end = irun + 1 < mRunArray.size() ? mRunArray[irun + 1].index : mTruthArray.size();
+    return gsl::span<const TruthElement>(&mTruthArray[start], end - start);
+  }
+
+  void clear()
+  {
+    mRunArray.clear();
+    mTruthArray.clear();
+    mNIndexed = 0;
+  }
+
+  // add element for a particular dataindex
+  // only strictly consecutive modes are supported
+  // noElement indicates that actually no label/element will be added for this dataindex
+  void addElement(uint32_t dataindex, TruthElement const& element, bool noElement = false)
+  {
+    if (dataindex < mNIndexed) {
+      // must currently be the last one
+      if (dataindex != mNIndexed - 1) {
+        throw std::runtime_error("CompactMCTruthContainer: unsupported code path");
+      }
+    } else {
+      // add empty holes and the new index
+      while (mNIndexed <= dataindex) {
+        beginIndex();
+      }
+    }
+    if (!noElement) {
+      mTruthArray.emplace_back(element);
+    }
+  }
+
+  /// adds a data index that has no label
+  void addNoLabelIndex(uint32_t dataindex)
+  {
+    addElement(dataindex, TruthElement(), true);
+  }
+
+  // convenience interface to add multiple labels at once
+  template <typename CompatibleLabel>
+  void addElements(uint32_t dataindex, gsl::span<CompatibleLabel> elements)
+  {
+    addNoLabelIndex(dataindex);
+    for (auto& e : elements) {
+      mTruthArray.emplace_back(e);
+    }
+  }
+
+  // append all data indices of a MCTruthContainer to the back of this one
+  void mergeAtBack(MCTruthContainer<TruthElement> const& other)
+  {
+    const auto offset = mNIndexed;
+    for (uint32_t i = 0; i < other.getIndexedSize(); ++i) {
+      addElements(offset + i, other.getLabels(i));
+    }
+  }
+
+  /// Flatten to the provided container in the compact layout:
+  /// FlatHeader (version 2), number of indexed data (uint32_t), runs, truth elements
+  template <typename ContainerType>
+  size_t flatten_to(ContainerType& container) const
+  {
+    // the last run may still be identical to the previous one
+    const bool mergeLast = isLastRunRedundant();
+    const size_t nruns = mRunArray.size() - (mergeLast ? 1 : 0);
+    const size_t ntruth = mergeLast ? mRunArray.back().index : mTruthArray.size();
+    size_t bufferSize = sizeof(FlatHeader) + sizeof(uint32_t) + sizeof(MCTruthRunElement) * nruns + sizeof(TruthElement) * ntruth;
+    container.resize((bufferSize / sizeof(typename ContainerType::value_type)) + ((bufferSize % sizeof(typename ContainerType::value_type)) > 0 ? 1 : 0));
+    char* target = reinterpret_cast<char*>(container.data());
+    auto& flatheader = *reinterpret_cast<FlatHeader*>(target);
+    target += sizeof(FlatHeader);
+    flatheader.version = MCTruthRunElement::FlatVersion;
+    flatheader.sizeofHeaderElement = sizeof(MCTruthRunElement);
+    flatheader.sizeofTruthElement = sizeof(TruthElement);
+    flatheader.reserved = 0;
+    flatheader.nofHeaderElements = nruns;
+    flatheader.nofTruthElements = ntruth;
+    memcpy(target, &mNIndexed, sizeof(uint32_t));
+    target += sizeof(uint32_t);
+    size_t copySize = sizeof(MCTruthRunElement) * nruns;
+    memcpy(target, mRunArray.data(), copySize);
+    target += copySize;
+    copySize = sizeof(TruthElement) * ntruth;
+    memcpy(target, mTruthArray.data(), copySize);
+    return bufferSize;
+  }
+
+ private:
+  std::vector<MCTruthRunElement> mRunArray; // the runs of data indices, the last one holds only the last index
+  std::vector<TruthElement> mTruthArray;    // the buffer containing the actual truth information
+  uint32_t mNIndexed = 0;                   // number of data indices
+
+  // whether the labels of the last run are the same as for the previous one
+  bool isLastRunRedundant() const
+  {
+    const auto nruns = mRunArray.size();
+    if (nruns < 2) {
+      return false;
+    }
+    const auto prevStart = mRunArray[nruns - 2].index;
+    const auto lastStart = mRunArray[nruns - 1].index;
+    const auto lastSize = mTruthArray.size() - lastStart;
+    return lastStart - prevStart == lastSize &&
+           std::equal(mTruthArray.begin() + prevStart, mTruthArray.begin() + lastStart, mTruthArray.begin() + lastStart);
+  }
+
+  // finish the last data index, merging it to the previous run if it has the same labels,
+  // and start a new one
+  void beginIndex()
+  {
+    if (isLastRunRedundant()) {
+      mTruthArray.resize(mRunArray.back().index);
+      mRunArray.pop_back();
+    }
+    mRunArray.push_back(MCTruthRunElement{mNIndexed++, uint32_t(mTruthArray.size())});
+  }
+};
+
+using CompactMCLabelContainer = o2::dataformats::CompactMCTruthContainer<o2::MCCompLabel>;
+
+} // namespace dataformats
+} // namespace o2
+
+#endif // O2_COMPACTMCTRUTHCONTAINER_H
@@ -17,6 +17,7 @@
 #define O2_CONSTMCTRUTHCONTAINER_H
 
 #include <SimulationDataFormat/MCTruthContainer.h>
+#include <SimulationDataFormat/CompactMCTruthContainer.h>
 #ifndef GPUCA_STANDALONE
 #include <Framework/Traits.h>
 #endif
@@ -34,7 +35,7 @@ namespace dataformats
 /// This provides access functionality to MCTruthContainer with optimized linear storage
 /// so that the data can easily be shared in memory or sent over network.
 /// This container needs to be initialized by calling "flatten_to" from an existing
-/// MCTruthContainer
+/// MCTruthContainer or CompactMCTruthContainer, the compact layout of the latter is read in place
 template <typename TruthElement>
 class ConstMCTruthContainer : public std::vector<char>
 {
@@ -46,8 +47,11 @@ class ConstMCTruthContainer : public std::vector<char>
   // const data access
   // get individual const "view" container for a given data index
   // the caller can't do modifications on this view
-  MCTruthHeaderElement const& getMCTruthHeader(uint32_t dataindex) const
+  MCTruthHeaderElement getMCTruthHeader(uint32_t dataindex) const
   {
+    if (isCompact()) {
+      return MCTruthHeaderElement(getRunStart()[findMCTruthRun(getRunStart(), getHeader().nofHeaderElements, dataindex)].index);
+    }
     return getHeaderStart()[dataindex];
   }
 
@@ -56,13 +60,28 @@ class ConstMCTruthContainer : public std::vector<char>
     if (dataindex >= getIndexedSize()) {
       return gsl::span<const TruthElement>();
     }
+    if (isCompact()) {
+      // labels shared by a run of data indices
+      const auto runs = getRunStart();
+      const size_t nruns = getHeader().nofHeaderElements;
+      const auto irun = findMCTruthRun(runs, nruns, dataindex);
+      const auto start = runs[irun].index;
+      const auto end = irun + 1 < nruns ? runs[irun + 1].index : getNElements();
+      return gsl::span<const TruthElement>(&getLabelStart()[start], end - start);
+    }
     const auto start = getMCTruthHeader(dataindex).index;
     const auto labelsptr = getLabelStart();
     return gsl::span<const TruthElement>(&labelsptr[start], getSize(dataindex));
   }
 
   // return the number of original data indexed here
-  size_t getIndexedSize() const { return size() >= sizeof(FlatHeader) ? getHeader().nofHeaderElements : 0; }
+  size_t getIndexedSize() const
+  {
+    if (size() < sizeof(FlatHeader)) {
+      return 0;
+    }
+    return isCompact() ? *reinterpret_cast<uint32_t const*>(&(*this)[sizeof(FlatHeader)]) : getHeader().nofHeaderElements;
+  }
 
   // return the number of labels managed in this container
   size_t getNElements() const { return size() >= sizeof(FlatHeader) ? getHeader().nofTruthElements : 0; }
@@ -86,7 +105,7 @@ class ConstMCTruthContainer : public std::vector<char>
   {
     auto* source = &(*this)[0];
     auto flatheader = getHeader();
-    source += sizeof(FlatHeader);
+    source += sizeof(FlatHeader) + (isCompact() ? sizeof(uint32_t) : 0);
     const size_t headerSize = flatheader.sizeofHeaderElement * flatheader.nofHeaderElements;
     source += headerSize;
     return (TruthElement const*)source;
@@ -105,6 +124,17 @@ class ConstMCTruthContainer : public std::vector<char>
     source += sizeof(FlatHeader);
     return (MCTruthHeaderElement const*)source;
   }
+
+  // whether the buffer has the compact layout of CompactMCTruthContainer (runs of data indices
+  // sharing the same labels, preceded by the number of indexed data)
+  bool isCompact() const { return getHeader().version == MCTruthRunElement::FlatVersion; }
+
+  MCTruthRunElement const* getRunStart() const
+  {
+    auto* source = &(*this)[0];
+    source += sizeof(FlatHeader) + sizeof(uint32_t);
+    return (MCTruthRunElement const*)source;
+  }
 };
 } // namespace dataformats
 } // namespace o2
@@ -144,8 +174,11 @@ class ConstMCTruthContainerView
   // const data access
   // get individual const "view" container for a given data index
   // the caller can't do modifications on this view
-  MCTruthHeaderElement const& getMCTruthHeader(uint32_t dataindex) const
+  MCTruthHeaderElement getMCTruthHeader(uint32_t dataindex) const
   {
+    if (isCompact()) {
+      return MCTruthHeaderElement(getRunStart()[findMCTruthRun(getRunStart(), getHeader().nofHeaderElements, dataindex)].index);
+    }
     return getHeaderStart()[dataindex];
   }
 
@@ -154,13 +187,28 @@ class ConstMCTruthContainerView
     if (dataindex >= getIndexedSize()) {
       return gsl::span<const TruthElement>();
     }
+    if (isCompact()) {
+      // labels shared by a run of data indices
+      const auto runs = getRunStart();
+      const size_t nruns = getHeader().nofHeaderElements;
+      const auto irun = findMCTruthRun(runs, nruns, dataindex);
+      const auto start = runs[irun].index;
+      const auto end = irun + 1 < nruns ? runs[irun + 1].index : getNElements();
+      return gsl::span<const TruthElement>(&getLabelStart()[start], end - start);
+    }
     const auto start = getMCTruthHeader(dataindex).index;
     const auto labelsptr = getLabelStart();
     return gsl::span<const TruthElement>(&labelsptr[start], getSize(dataindex));
   }
 
   // return the number of original data indexed here
-  size_t getIndexedSize() const { return (size_t)mStorage.size() >= sizeof(FlatHeader) ? getHeader().nofHeaderElements : 0; }
+  size_t getIndexedSize() const
+  {
+    if ((size_t)mStorage.size() < sizeof(FlatHeader)) {
+      return 0;
+    }
+    return isCompact() ? *reinterpret_cast<uint32_t const*>(&mStorage[sizeof(FlatHeader)]) : getHeader().nofHeaderElements;
+  }
 
   // return the number of labels managed in this container
   size_t getNElements() const { return (size_t)mStorage.size() >= sizeof(FlatHeader) ? getHeader().nofTruthElements : 0; }
@@ -189,7 +237,7 @@ class ConstMCTruthContainerView
   {
     auto* source = &(mStorage)[0];
     auto flatheader = getHeader();
-    source += sizeof(FlatHeader);
+    source += sizeof(FlatHeader) + (isCompact() ? sizeof(uint32_t) : 0);
     const size_t headerSize = flatheader.sizeofHeaderElement * flatheader.nofHeaderElements;
     source += headerSize;
     return (TruthElement const*)source;
@@ -208,6 +256,17 @@ class ConstMCTruthContainerView
     source += sizeof(FlatHeader);
     return (MCTruthHeaderElement const*)source;
   }
+
+  // whether the buffer has the compact layout of CompactMCTruthContainer (runs of data indices
+  // sharing the same labels, preceded by the number of indexed data)
+  bool isCompact() const { return getHeader().version == MCTruthRunElement::FlatVersion; }
+
+  MCTruthRunElement const* getRunStart() const
+  {
+    auto* source = &(mStorage)[0];
+    source += sizeof(FlatHeader) + sizeof(uint32_t);
+    return (MCTruthRunElement const*)source;
+  }
 };
 
 using ConstMCLabelContainer = o2::dataformats::ConstMCTruthContainer<o2::MCCompLabel>;
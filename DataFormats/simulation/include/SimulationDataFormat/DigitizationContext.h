@@ -24,6 +24,7 @@
 #include <MathUtils/Cartesian.h>
 #include <DataFormatsCalibration/MeanVertexObject.h>
 #include <DataFormatsCTP/Digits.h>
+#include "SimulationDataFormat/HitCache.h"
 
 namespace o2
 {
@@ -102,6 +103,12 @@ class DigitizationContext
   /// return boolean saying if input simchains was modified or not
   bool initSimChains(o2::detectors::DetID detid, std::vector<TChain*>& simchains) const;
 
+  /// size of the TTreeCache attached to the hit chains set up by initSimChains; 0 (default) leaves the ROOT default.
+  /// The cache learns the branches read by the digitizer and reads their baskets of many events with few
+  /// (vectored) reads; with TTreeCacheUnzip::SetParallelUnzip and ROOT IMT the baskets are also decompressed in parallel
+  static void setHitReadCacheSize(long bytes) { sHitReadCacheSize = bytes; }
+  static long getHitReadCacheSize() { return sHitReadCacheSize; }
+
   /// Common functions the setup input TChains for reading kinematics information, given the state (prefixes) encapsulated
   /// by this context. The input vector needs to be empty otherwise nothing will be done.
   /// return boolean saying if input simchains was modified or not
@@ -119,6 +126,16 @@ class DigitizationContext
                     int entryID,
                     std::vector<T>* hits) const;
 
+  /// same as above, but taking the hits of the events of cached sources from (and filling them
+  /// into) a cache kept by the caller across timeframes
+  template <typename T>
+  void retrieveHits(std::vector<TChain*> const& chains,
+                    const char* brname,
+                    int sourceID,
+                    int entryID,
+                    std::vector<T>* hits,
+                    HitCache& cache) const;
+
   /// returns the GRP object associated to this context
   o2::parameters::GRPObject const& getGRP() const;
 
@@ -184,6 +201,8 @@ class DigitizationContext
   mutable std::vector<o2::ctp::CTPDigit> const* mCTPTrigger = nullptr; // CTP trigger info associated to this digitization context
   mutable bool mHasTrigger = false;                                    //
 
+  static long sHitReadCacheSize; // TTreeCache size for the hit chains, 0 for the ROOT default
+
   ClassDefNV(DigitizationContext, 5);
 };
 
@@ -204,6 +223,26 @@ inline void DigitizationContext::retrieveHits(std::vector<TChain*> const& chains
   br->GetEntry(entryID);
 }
 
+template <typename T>
+inline void DigitizationContext::retrieveHits(std::vector<TChain*> const& chains,
+                                              const char* brname,
+                                              int sourceID,
+                                              int entryID,
+                                              std::vector<T>* hits,
+                                              HitCache& cache) const
+{
+  if (!cache.isCachedSource(sourceID)) {
+    retrieveHits(chains, brname, sourceID, entryID, hits);
+    return;
+  }
+  if (auto cached = cache.get<T>(brname, sourceID, entryID)) {
+    *hits = *cached;
+    return;
+  }
+  retrieveHits(chains, brname, sourceID, entryID, hits);
+  cache.put(brname, sourceID, entryID, *hits);
+}
+
 } // namespace steer
 } // namespace o2
 
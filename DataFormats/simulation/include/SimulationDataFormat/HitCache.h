@@ -0,0 +1,167 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file HitCache.h
+/// \brief A bounded in-memory cache for the hits of simulated events
+
+#ifndef O2_STEER_HITCACHE_H
+#define O2_STEER_HITCACHE_H
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+namespace o2
+{
+namespace steer
+{
+
+/// @class HitCache
+/// @brief Keeps the hits of recently used events in memory, evicting the least recently used ones
+///
+/// In embedding productions the same background events are combined with many signal events
+/// and their hits would be read and decompressed again for every combination. A digitizer can
+/// keep a HitCache across timeframes and pass it to DigitizationContext::retrieveHits, which then
+/// reads the hits of the cached sources (by default only the background, source 0) only once.
+/// The cache is bounded by the (approximate) memory of the stored hits and may be used from
+/// several threads.
+class HitCache
+{
+ public:
+  HitCache() = default;
+  explicit HitCache(size_t maxBytes) : mMaxBytes(maxBytes) {}
+
+  /// set the maximal memory of the cached hits; 0 disables the cache
+  void setMaxBytes(size_t maxBytes)
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mMaxBytes = maxBytes;
+    evict();
+  }
+  size_t getMaxBytes() const { return mMaxBytes; }
+
+  /// select the sources (as in the event parts of the context) whose events are cached
+  void setCachedSources(std::vector<int> const& sources) { mSources = sources; }
+
+  /// whether the events of a source are cached
+  bool isCachedSource(int sourceID) const
+  {
+    if (mMaxBytes == 0) {
+      return false;
+    }
+    for (auto s : mSources) {
+      if (s == sourceID) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// get the hits of a given branch and event, nullptr if not cached
+  template <typename T>
+  std::shared_ptr<const std::vector<T>> get(const std::string& brname, int sourceID, int entryID)
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto iter = mEntries.find(Key{brname, sourceID, entryID});
+    if (iter == mEntries.end() || iter->second.type != std::type_index(typeid(T))) {
+      ++mNMisses;
+      return nullptr;
+    }
+    // move to the front of the LRU list
+    mLRU.splice(mLRU.begin(), mLRU, iter->second.lruPos);
+    ++mNHits;
+    return std::static_pointer_cast<const std::vector<T>>(iter->second.hits);
+  }
+
+  /// store a copy of the hits of a given branch and event
+  template <typename T>
+  void put(const std::string& brname, int sourceID, int entryID, std::vector<T> const& hits)
+  {
+    const size_t bytes = sizeof(std::vector<T>) + hits.size() * sizeof(T);
+    if (bytes > mMaxBytes) {
+      return;
+    }
+    auto copy = std::make_shared<const std::vector<T>>(hits);
+    std::lock_guard<std::mutex> lock(mMutex);
+    Key key{brname, sourceID, entryID};
+    auto iter = mEntries.find(key);
+    if (iter != mEntries.end()) {
+      // already added by another thread
+      return;
+    }
+    mLRU.push_front(key);
+    mEntries.emplace(std::move(key), Entry{std::move(copy), std::type_index(typeid(T)), bytes, mLRU.begin()});
+    mBytes += bytes;
+    evict();
+  }
+
+  void clear()
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mEntries.clear();
+    mLRU.clear();
+    mBytes = 0;
+  }
+
+  size_t getBytes() const { return mBytes; }
+  size_t getNEntries() const { return mEntries.size(); }
+  size_t getNHits() const { return mNHits; }
+  size_t getNMisses() const { return mNMisses; }
+
+ private:
+  struct Key {
+    std::string branch;
+    int sourceID;
+    int entryID;
+    bool operator==(Key const& other) const { return sourceID == other.sourceID && entryID == other.entryID && branch == other.branch; }
+  };
+  struct KeyHash {
+    size_t operator()(Key const& key) const
+    {
+      return std::hash<std::string>()(key.branch) ^ (std::hash<long>()((long(key.sourceID) << 32) | unsigned(key.entryID)) << 1);
+    }
+  };
+  struct Entry {
+    std::shared_ptr<const void> hits; // a std::vector of the stored type
+    std::type_index type;
+    size_t bytes;
+    std::list<Key>::iterator lruPos;
+  };
+
+  // remove the least recently used entries until within the memory limit
+  void evict()
+  {
+    while (mBytes > mMaxBytes && !mLRU.empty()) {
+      auto iter = mEntries.find(mLRU.back());
+      mBytes -= iter->second.bytes;
+      mEntries.erase(iter);
+      mLRU.pop_back();
+    }
+  }
+
+  std::unordered_map<Key, Entry, KeyHash> mEntries;
+  std::list<Key> mLRU; // most recently used first
+  std::vector<int> mSources{0};
+  size_t mMaxBytes = 0;
+  size_t mBytes = 0;
+  size_t mNHits = 0;
+  size_t mNMisses = 0;
+  std::mutex mMutex;
+};
+
+} // namespace steer
+} // namespace o2
+
+#endif // O2_STEER_HITCACHE_H
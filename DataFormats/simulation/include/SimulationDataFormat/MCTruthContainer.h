@@ -25,6 +25,7 @@
 #include <cstring> // memmove, memcpy
 #include <memory>
 #include <vector>
+#include <algorithm>
 
 // type traits are needed for the compile time consistency check
 // maybe to be moved out of Framework first
@@ -47,6 +48,23 @@ struct MCTruthHeaderElement {
   ClassDefNV(MCTruthHeaderElement, 1);
 };
 
+/// @struct MCTruthRunElement
+/// @brief Header of a run of consecutive data indices sharing the same truth elements
+/// Used instead of MCTruthHeaderElement in the compact flat layout (see CompactMCTruthContainer)
+struct MCTruthRunElement {
+  static constexpr uint8_t FlatVersion = 2; // version of the flat layout made of runs
+  uint32_t firstIndex = 0;                  // first data index of the run
+  uint32_t index = 0;                       // the index of the first truth element of the run in the storage
+};
+
+/// Position of the run holding dataindex in an array of nruns runs sorted by first index,
+/// the first one starting at 0
+inline size_t findMCTruthRun(MCTruthRunElement const* runs, size_t nruns, uint32_t dataindex)
+{
+  auto iter = std::upper_bound(runs, runs + nruns, dataindex, [](uint32_t i, MCTruthRunElement const& run) { return i < run.firstIndex; });
+  return (iter - runs) - 1;
+}
+
 /// @class MCTruthContainer
 /// @brief A container to hold and manage MC truth information/labels.
 ///
@@ -363,6 +381,7 @@ class MCTruthContainer
   /// Resore internal vectors from a raw buffer
   /// The two vectors are resized according to the information in the \a FlatHeader
   /// struct at the beginning of the buffer. Data is copied to the vectors.
+  /// Buffers in the compact layout of CompactMCTruthContainer are expanded.
   void restore_from(const char* buffer, size_t bufferSize)
   {
     if (buffer == nullptr || bufferSize < sizeof(FlatHeader)) {
@@ -370,6 +389,10 @@ class MCTruthContainer
     }
     auto* source = buffer;
     auto& flatheader = *reinterpret_cast<FlatHeader const*>(source);
+    if (flatheader.version == MCTruthRunElement::FlatVersion) {
+      restore_from_runs(buffer, bufferSize);
+      return;
+    }
     source += sizeof(FlatHeader);
     if (bufferSize < sizeof(FlatHeader) + flatheader.sizeofHeaderElement * flatheader.nofHeaderElements + flatheader.sizeofTruthElement * flatheader.nofTruthElements) {
       throw std::runtime_error("inconsistent buffer size: too small");
@@ -393,6 +416,38 @@ class MCTruthContainer
     memcpy(mTruthArray.data(), source, copySize);
   }
 
+  /// Restore internal vectors from a raw buffer in the compact layout:
+  /// FlatHeader, number of indexed data (uint32_t), runs, truth elements
+  void restore_from_runs(const char* buffer, size_t bufferSize)
+  {
+    auto& flatheader = *reinterpret_cast<FlatHeader const*>(buffer);
+    const size_t runsOffset = sizeof(FlatHeader) + sizeof(uint32_t);
+    const size_t truthOffset = runsOffset + flatheader.sizeofHeaderElement * flatheader.nofHeaderElements;
+    if (bufferSize < truthOffset + flatheader.sizeofTruthElement * flatheader.nofTruthElements) {
+      throw std::runtime_error("inconsistent buffer size: too small");
+    }
+    if (flatheader.sizeofHeaderElement != sizeof(MCTruthRunElement) || flatheader.sizeofTruthElement != sizeof(TruthElement)) {
+      throw std::runtime_error("member element sizes don't match");
+    }
+    uint32_t nindexed;
+    memcpy(&nindexed, buffer + sizeof(FlatHeader), sizeof(uint32_t));
+    auto runs = reinterpret_cast<MCTruthRunElement const*>(buffer + runsOffset);
+    auto truth = reinterpret_cast<TruthElement const*>(buffer + truthOffset);
+    const uint32_t nruns = flatheader.nofHeaderElements;
+    mHeaderArray.clear();
+    mTruthArray.clear();
+    mHeaderArray.reserve(nindexed);
+    for (uint32_t irun = 0; irun < nruns; ++irun) {
+      const auto end = irun + 1 < nruns ? runs[irun + 1].firstIndex : nindexed;
+      const auto first = truth + runs[irun].index;
+      const auto last = truth + (irun + 1 < nruns ? runs[irun + 1].index : flatheader.nofTruthElements);
+      for (auto dataindex = runs[irun].firstIndex; dataindex < end; ++dataindex) {
+        mHeaderArray.emplace_back(mTruthArray.size());
+        mTruthArray.insert(mTruthArray.end(), first, last);
+      }
+    }
+  }
+
   /// Print some info
   template <typename Stream>
   void print(Stream& stream)
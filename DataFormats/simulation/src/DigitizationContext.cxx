@@ -22,6 +22,8 @@
 
 using namespace o2::steer;
 
+long DigitizationContext::sHitReadCacheSize = 0;
+
 void DigitizationContext::printCollisionSummary(bool withQED, int truncateOutputTo) const
 {
   std::cout << "Summary of DigitizationContext --\n";
@@ -99,6 +101,14 @@ bool DigitizationContext::initSimChains(o2::detectors::DetID detid, std::vector<
     simchains[QEDSOURCEID]->AddFile(o2::base::DetectorNameConf::getHitsFileName(detid, mQEDSimPrefix).c_str());
   }
 
+  if (sHitReadCacheSize > 0) {
+    for (auto chain : simchains) {
+      if (chain) {
+        chain->SetCacheSize(sHitReadCacheSize);
+      }
+    }
+  }
+
   return true;
 }
 
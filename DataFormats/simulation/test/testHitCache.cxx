@@ -0,0 +1,69 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test HitCache class
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "SimulationDataFormat/HitCache.h"
+
+using namespace o2::steer;
+
+BOOST_AUTO_TEST_CASE(HitCache_test)
+{
+  const size_t entryBytes = sizeof(std::vector<int>) + 100 * sizeof(int);
+  HitCache cache(2 * entryBytes);
+  BOOST_CHECK(cache.isCachedSource(0));
+  BOOST_CHECK(!cache.isCachedSource(1));
+
+  std::vector<int> hits(100, 1);
+  BOOST_CHECK(cache.get<int>("Hit", 0, 0) == nullptr);
+  cache.put("Hit", 0, 0, hits);
+  hits.assign(100, 2);
+  cache.put("Hit", 0, 1, hits);
+  BOOST_CHECK_EQUAL(cache.getNEntries(), 2);
+  BOOST_CHECK_EQUAL(cache.getBytes(), 2 * entryBytes);
+
+  // the stored hits are copies
+  auto cached = cache.get<int>("Hit", 0, 0);
+  BOOST_REQUIRE(cached != nullptr);
+  BOOST_CHECK_EQUAL(cached->size(), 100);
+  BOOST_CHECK_EQUAL((*cached)[0], 1);
+
+  // a different type or branch is not found
+  BOOST_CHECK(cache.get<float>("Hit", 0, 0) == nullptr);
+  BOOST_CHECK(cache.get<int>("OtherHit", 0, 0) == nullptr);
+
+  // entry 1 is now the least recently used one and evicted
+  hits.assign(100, 3);
+  cache.put("Hit", 0, 2, hits);
+  BOOST_CHECK_EQUAL(cache.getNEntries(), 2);
+  BOOST_CHECK(cache.get<int>("Hit", 0, 1) == nullptr);
+  BOOST_CHECK(cache.get<int>("Hit", 0, 0) != nullptr);
+  BOOST_CHECK_EQUAL((*cache.get<int>("Hit", 0, 2))[0], 3);
+
+  // hits still in use survive the eviction
+  cache.setMaxBytes(0);
+  BOOST_CHECK_EQUAL(cache.getNEntries(), 0);
+  BOOST_CHECK_EQUAL(cache.getBytes(), 0);
+  BOOST_CHECK_EQUAL((*cached)[0], 1);
+  BOOST_CHECK(!cache.isCachedSource(0));
+
+  // entries larger than the cache are not stored
+  cache.setMaxBytes(entryBytes - 1);
+  cache.put("Hit", 0, 0, hits);
+  BOOST_CHECK_EQUAL(cache.getNEntries(), 0);
+
+  cache.setMaxBytes(entryBytes);
+  cache.setCachedSources({1, 2});
+  BOOST_CHECK(!cache.isCachedSource(0));
+  BOOST_CHECK(cache.isCachedSource(2));
+}
@@ -15,6 +15,7 @@
 #include <boost/test/unit_test.hpp>
 #include "SimulationDataFormat/MCCompLabel.h"
 #include "SimulationDataFormat/ConstMCTruthContainer.h"
+#include "SimulationDataFormat/CompactMCTruthContainer.h"
 #include "SimulationDataFormat/LabelContainer.h"
 #include "SimulationDataFormat/IOMCTruthContainerView.h"
 #include <algorithm>
@@ -212,6 +213,68 @@ BOOST_AUTO_TEST_CASE(MCTruthContainer_flatten)
   BOOST_CHECK(cc.getLabels(2)[0] == 10);
 }
 
+BOOST_AUTO_TEST_CASE(CompactMCTruthContainer_flatten)
+{
+  using TruthElement = long;
+  dataformats::MCTruthContainer<TruthElement> container;
+  dataformats::CompactMCTruthContainer<TruthElement> compact;
+  // runs of identical label sets, including empty ones and a hole
+  const std::vector<std::vector<TruthElement>> labels{{1, 2}, {1, 2}, {1, 2}, {3}, {}, {}, {3}, {3}, {1, 2}, {}, {4}, {4}};
+  for (uint32_t i = 0; i < labels.size(); ++i) {
+    if (labels[i].empty()) {
+      if (i != 5) {
+        container.addNoLabelIndex(i);
+        compact.addNoLabelIndex(i);
+      }
+      continue;
+    }
+    for (auto l : labels[i]) {
+      container.addElement(i, l);
+      compact.addElement(i, l);
+    }
+  }
+  BOOST_CHECK_THROW(compact.addElement(0, TruthElement(0)), std::runtime_error);
+  BOOST_CHECK(compact.getIndexedSize() == labels.size());
+  for (uint32_t i = 0; i < labels.size(); ++i) {
+    auto view = compact.getLabels(i);
+    BOOST_CHECK(std::vector<TruthElement>(view.begin(), view.end()) == labels[i]);
+  }
+
+  // compact layout read in place
+  using ConstMCTruthContainer = dataformats::ConstMCTruthContainer<TruthElement>;
+  ConstMCTruthContainer cc;
+  compact.flatten_to(cc);
+  BOOST_CHECK(cc.getIndexedSize() == labels.size());
+  BOOST_CHECK(cc.getNElements() == 7); // {1, 2}, {3}, {}, {3}, {1, 2}, {}, {4}
+  std::vector<char> buffer;
+  BOOST_CHECK(cc.size() < container.flatten_to(buffer));
+  dataformats::ConstMCTruthContainerView<TruthElement> ccview(cc);
+  for (uint32_t i = 0; i < labels.size(); ++i) {
+    auto view = cc.getLabels(i);
+    BOOST_CHECK(std::vector<TruthElement>(view.begin(), view.end()) == labels[i]);
+    BOOST_CHECK(ccview.getLabels(i).size() == labels[i].size());
+  }
+  BOOST_CHECK(cc.getLabels(labels.size()).size() == 0);
+
+  // compact layout expanded
+  dataformats::MCTruthContainer<TruthElement> restored;
+  restored.restore_from(cc.data(), cc.size());
+  BOOST_CHECK(restored.getIndexedSize() == container.getIndexedSize());
+  BOOST_CHECK(restored.getNElements() == container.getNElements());
+  for (uint32_t i = 0; i < labels.size(); ++i) {
+    BOOST_CHECK(restored.getMCTruthHeader(i).index == container.getMCTruthHeader(i).index);
+  }
+
+  // streaming from a MCTruthContainer
+  dataformats::CompactMCTruthContainer<TruthElement> merged;
+  merged.mergeAtBack(container);
+  merged.mergeAtBack(container);
+  BOOST_CHECK(merged.getIndexedSize() == 2 * labels.size());
+  for (uint32_t i = 0; i < merged.getIndexedSize(); ++i) {
+    BOOST_CHECK(merged.getLabels(i).size() == labels[i % labels.size()].size());
+  }
+}
+
 BOOST_AUTO_TEST_CASE(LabelContainer_noncont)
 {
   using TruthElement = long;
@@ -410,6 +410,18 @@ class AODProducerWorkflowDPL : public Task
     uint8_t tpcdEdxTot3R;
   };
 
+  // helper struct for the barrel tracks of one source, processed in parallel before filling the tables
+  struct BarrelTrackInfo {
+    TrackExtraInfo extraInfo;
+    TrackQA trackQAInfo;
+    o2::track::TrackParCov trackPar; // track propagated to the PV (if isProp)
+    bool skip = false;               // ambiguous track already stored
+    bool writeQAData = false;
+    bool isThinned = false; // not stored but pretended to be
+    bool isProp = false;
+  };
+  std::vector<BarrelTrackInfo> mBarrelTracksTmp;
+
   // helper struct for addToFwdTracksTable()
   struct FwdTrackInfo {
     uint8_t trackTypeId = 0;
@@ -503,6 +515,8 @@ class AODProducerWorkflowDPL : public Task
   TrackExtraInfo processBarrelTrack(int collisionID, std::uint64_t collisionBC, GIndex trackIndex, const o2::globaltracking::RecoContainer& data, const std::map<uint64_t, int>& bcsMap);
   TrackQA processBarrelTrackQA(int collisionID, std::uint64_t collisionBC, GIndex trackIndex, const o2::globaltracking::RecoContainer& data, const std::map<uint64_t, int>& bcsMap);
 
+  void processBarrelTracks(int collisionID, std::uint64_t collisionBC, const gsl::span<const GIndex>& GIndices, int start, int end,
+                           const o2::globaltracking::RecoContainer& data, const std::map<uint64_t, int>& bcsMap);
   bool propagateTrackToPV(o2::track::TrackParametrizationWithError<float>& trackPar, const o2::globaltracking::RecoContainer& data, int colID);
   void extrapolateToCalorimeters(TrackExtraInfo& extraInfoHolder, const o2::track::TrackPar& track);
   void cacheTriggers(const o2::globaltracking::RecoContainer& recoData);
@@ -453,6 +453,9 @@ void AODProducerWorkflowDPL::fillTrackTablesPerCollision(int collisionID,
       tracksCursor.reserve(nToReserve + tracksCursor.lastIndex());
       tracksCovCursor.reserve(nToReserve + tracksCovCursor.lastIndex());
       tracksExtraCursor.reserve(nToReserve + tracksExtraCursor.lastIndex());
+      if (GIndex::includesSource(src, mInputSources)) {
+        processBarrelTracks(collisionID, collisionBC, GIndices, start, end, data, bcsMap);
+      }
     }
     for (int ti = start; ti < end; ti++) {
       const auto& trackIndex = GIndices[ti];
@@ -473,30 +476,18 @@ void AODProducerWorkflowDPL::fillTrackTablesPerCollision(int collisionID,
           addClustersToFwdTrkClsTable(data, fwdTrkClsCursor, trackIndex, mTableTrFwdID);
           mTableTrFwdID++;
         } else {
-          // barrel track: normal tracks table
-          if (trackIndex.isAmbiguous() && mGIDToTableID.find(trackIndex) != mGIDToTableID.end()) { // was it already stored ?
+          // barrel track: normal tracks table, filled with the results of processBarrelTracks
+          auto& trackInfo = mBarrelTracksTmp[ti - start];
+          if (trackInfo.skip) { // was it already stored ?
             continue;
           }
-
-          float weight = 0;
-          static std::uniform_real_distribution<> distr(0., 1.);
-          bool writeQAData = o2::math_utils::Tsallis::downsampleTsallisCharged(data.getTrackParam(trackIndex).getPt(), mTrackQCFraction, mSqrtS, weight, distr(mGenerator));
-          auto extraInfoHolder = processBarrelTrack(collisionID, collisionBC, trackIndex, data, bcsMap);
-
-          if (writeQAData) {
-            auto trackQAInfoHolder = processBarrelTrackQA(collisionID, collisionBC, trackIndex, data, bcsMap);
-            if (std::bitset<8>(trackQAInfoHolder.tpcClusterByteMask).count() >= mTrackQCNTrCut) {
-              trackQAInfoHolder.trackID = mTableTrID;
-              // LOGP(info, "orig time0 in bc: {} diffBCRef: {}, ttime: {} -> {}", trackQAInfoHolder.tpcTime0*8, extraInfoHolder.diffBCRef, extraInfoHolder.trackTime, (trackQAInfoHolder.tpcTime0 * 8 - extraInfoHolder.diffBCRef) * o2::constants::lhc::LHCBunchSpacingNS - extraInfoHolder.trackTime);
-              trackQAInfoHolder.tpcTime0 = (trackQAInfoHolder.tpcTime0 * 8 - extraInfoHolder.diffBCRef) * o2::constants::lhc::LHCBunchSpacingNS - extraInfoHolder.trackTime;
-              // difference between TPC track time0 and stored track nominal time in ns instead of TF start
-              addToTracksQATable(tracksQACursor, trackQAInfoHolder);
-            } else {
-              writeQAData = false;
-            }
+          auto& extraInfoHolder = trackInfo.extraInfo;
+          if (trackInfo.writeQAData) {
+            trackInfo.trackQAInfo.trackID = mTableTrID;
+            addToTracksQATable(tracksQACursor, trackInfo.trackQAInfo);
           }
 
-          if (mThinTracks && src == GIndex::Source::TPC && mGIDUsedBySVtx.find(trackIndex) == mGIDUsedBySVtx.end() && mGIDUsedByStr.find(trackIndex) == mGIDUsedByStr.end() && !writeQAData) {
+          if (trackInfo.isThinned) {
             mGIDToTableID.emplace(trackIndex, -1); // pretend skipped tracks are stored; this is safe since they are are not written to disk and -1 indicates to all users to not use this track
             continue;
           }
@@ -506,19 +497,10 @@ void AODProducerWorkflowDPL::fillTrackTablesPerCollision(int collisionID,
                          << " timeErr=" << extraInfoHolder.trackTimeRes << " BCSlice: " << extraInfoHolder.bcSlice[0] << ":" << extraInfoHolder.bcSlice[1];
             continue;
           }
-          const auto& trOrig = data.getTrackParam(trackIndex);
-          bool isProp = false;
-          if (mPropTracks && trOrig.getX() < mMinPropR &&
-              mGIDUsedBySVtx.find(trackIndex) == mGIDUsedBySVtx.end() &&
-              mGIDUsedByStr.find(trackIndex) == mGIDUsedByStr.end()) { // Do not propagate track assoc. to V0s and str. tracking
-            auto trackPar(trOrig);
-            isProp = propagateTrackToPV(trackPar, data, collisionID);
-            if (isProp) {
-              addToTracksTable(tracksCursor, tracksCovCursor, trackPar, collisionID, aod::track::Track);
-            }
-          }
-          if (!isProp) {
-            addToTracksTable(tracksCursor, tracksCovCursor, trOrig, collisionID, aod::track::TrackIU);
+          if (trackInfo.isProp) {
+            addToTracksTable(tracksCursor, tracksCovCursor, trackInfo.trackPar, collisionID, aod::track::Track);
+          } else {
+            addToTracksTable(tracksCursor, tracksCovCursor, data.getTrackParam(trackIndex), collisionID, aod::track::TrackIU);
           }
           addToTracksExtraTable(tracksExtraCursor, extraInfoHolder);
 
@@ -1853,6 +1835,9 @@ void AODProducerWorkflowDPL::run(ProcessingContext& pc)
   std::unique_ptr<o2::steer::MCKinematicsReader> mcReader;
   if (mUseMC) {
     mcReader = std::make_unique<o2::steer::MCKinematicsReader>("collisioncontext.root");
+    // the tracks of each event are only needed while filling its MC particles,
+    // bound what the label lookups for diagnostics keep in memory
+    mcReader->setMaxCachedEvents(16);
   }
   mMCKineReader = mcReader.get(); // for use in different functions
   std::map<uint64_t, int> bcsMap;
@@ -2399,6 +2384,69 @@ void AODProducerWorkflowDPL::cacheTriggers(const o2::globaltracking::RecoContain
   }
 }
 
+void AODProducerWorkflowDPL::processBarrelTracks(int collisionID, std::uint64_t collisionBC, const gsl::span<const GIndex>& GIndices, int start, int end,
+                                                 const o2::globaltracking::RecoContainer& data, const std::map<uint64_t, int>& bcsMap)
+{
+  // process the barrel tracks GIndices[start:end] of a single source in parallel, the results are stored in mBarrelTracksTmp
+  // and added to the tables in the original order by fillTrackTablesPerCollision
+  int ntr = end - start;
+  mBarrelTracksTmp.clear();
+  mBarrelTracksTmp.resize(ntr);
+  // the QA downsampling draws random numbers: keep it serial to preserve the sequence
+  for (int itr = 0; itr < ntr; itr++) {
+    const auto& trackIndex = GIndices[start + itr];
+    auto& trackInfo = mBarrelTracksTmp[itr];
+    if (trackIndex.isAmbiguous() && mGIDToTableID.find(trackIndex) != mGIDToTableID.end()) { // was it already stored ?
+      trackInfo.skip = true;
+      continue;
+    }
+    float weight = 0;
+    static std::uniform_real_distribution<> distr(0., 1.);
+    trackInfo.writeQAData = o2::math_utils::Tsallis::downsampleTsallisCharged(data.getTrackParam(trackIndex).getPt(), mTrackQCFraction, mSqrtS, weight, distr(mGenerator));
+  }
+#ifdef WITH_OPENMP
+  int ngroup = std::min(50, std::max(1, ntr / mNThreads));
+#pragma omp parallel for schedule(dynamic, ngroup) num_threads(mNThreads)
+#endif
+  for (int itr = 0; itr < ntr; itr++) {
+    const auto& trackIndex = GIndices[start + itr];
+    auto& trackInfo = mBarrelTracksTmp[itr];
+    if (trackInfo.skip) {
+      continue;
+    }
+    auto& extraInfoHolder = trackInfo.extraInfo;
+    extraInfoHolder = processBarrelTrack(collisionID, collisionBC, trackIndex, data, bcsMap);
+
+    if (trackInfo.writeQAData) {
+      auto& trackQAInfoHolder = trackInfo.trackQAInfo;
+      trackQAInfoHolder = processBarrelTrackQA(collisionID, collisionBC, trackIndex, data, bcsMap);
+      if (std::bitset<8>(trackQAInfoHolder.tpcClusterByteMask).count() >= mTrackQCNTrCut) {
+        // LOGP(info, "orig time0 in bc: {} diffBCRef: {}, ttime: {} -> {}", trackQAInfoHolder.tpcTime0*8, extraInfoHolder.diffBCRef, extraInfoHolder.trackTime, (trackQAInfoHolder.tpcTime0 * 8 - extraInfoHolder.diffBCRef) * o2::constants::lhc::LHCBunchSpacingNS - extraInfoHolder.trackTime);
+        trackQAInfoHolder.tpcTime0 = (trackQAInfoHolder.tpcTime0 * 8 - extraInfoHolder.diffBCRef) * o2::constants::lhc::LHCBunchSpacingNS - extraInfoHolder.trackTime;
+        // difference between TPC track time0 and stored track nominal time in ns instead of TF start
+      } else {
+        trackInfo.writeQAData = false;
+      }
+    }
+
+    if (mThinTracks && trackIndex.getSource() == GIndex::Source::TPC && mGIDUsedBySVtx.find(trackIndex) == mGIDUsedBySVtx.end() && mGIDUsedByStr.find(trackIndex) == mGIDUsedByStr.end() && !trackInfo.writeQAData) {
+      trackInfo.isThinned = true;
+      continue;
+    }
+
+    if (!extraInfoHolder.isTPConly && extraInfoHolder.trackTimeRes < 0.f) { // failed or rejected?
+      continue;
+    }
+    const auto& trOrig = data.getTrackParam(trackIndex);
+    if (mPropTracks && trOrig.getX() < mMinPropR &&
+        mGIDUsedBySVtx.find(trackIndex) == mGIDUsedBySVtx.end() &&
+        mGIDUsedByStr.find(trackIndex) == mGIDUsedByStr.end()) { // Do not propagate track assoc. to V0s and str. tracking
+      trackInfo.trackPar = trOrig;
+      trackInfo.isProp = propagateTrackToPV(trackInfo.trackPar, data, collisionID);
+    }
+  }
+}
+
 AODProducerWorkflowDPL::TrackExtraInfo AODProducerWorkflowDPL::processBarrelTrack(int collisionID, std::uint64_t collisionBC, GIndex trackIndex,
                                                                                   const o2::globaltracking::RecoContainer& data, const std::map<uint64_t, int>& bcsMap)
 {
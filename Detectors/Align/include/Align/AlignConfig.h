@@ -89,6 +89,7 @@ struct AlignConfig : public o2::conf::ConfigurableParamHelper<AlignConfig> {
   bool KalmanResid = true;    // Kalman residuals
   bool MilleOutBin = true;    // text vs binary output for mille data
   bool GZipMilleOut = false;  // compress binary records
+  bool MilleOutAsync = true;  // write binary mille records in a separate thread
 
   std::string mpDatFileName{"mpData"};            //  file name for records mille data output
   std::string mpParFileName{"mpParams.txt"};      //  file name for MP params
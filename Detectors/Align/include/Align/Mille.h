@@ -25,12 +25,19 @@
  *  to write also derivatives and labels which are ==0.
  *  But note that **pede** will not be able to read text output and has not been tested with
  *  derivatives/labels ==0.
+ *
+ *  With the asynchronous flag the binary records are collected in a buffer which is written
+ *  to the file by a separate thread, so that the track processing is not blocked by the I/O.
  */
 
 #ifndef MILLE_H
 #define MILLE_H
 
 #include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
 #include <TArrayI.h>
 #include <TArrayF.h>
 
@@ -42,7 +49,10 @@ namespace align
 class Mille
 {
  public:
-  Mille(const std::string& outFileName, bool asBinary = true, bool writeZero = false);
+  Mille(const std::string& outFileName, bool asBinary = true, bool writeZero = false, bool async = false);
+  ~Mille();
+  Mille(const Mille&) = delete;
+  Mille& operator=(const Mille&) = delete;
   void mille(int NLC, const float* derLc, int NGL, const float* derGl, const int* label, float rMeas, float sigma);
   void special(int nSpecial, const float* floatings, const int* integers);
   void clear();
@@ -53,12 +63,27 @@ class Mille
  private:
   /// largest label allowed: 2^31 - 1
   static constexpr int MaxLabel = 0x7fffffff;
+  /// size of the record buffer which is passed to the writer thread in the asynchronous mode
+  static constexpr size_t AsyncBufferSize = 4 * 1024 * 1024;
+
+  void flushAsync();
+  void runWriter();
+
   std::ofstream mOutFile = {};     ///< C-binary for output
   bool mAsBinary = true;           ///< if false output as text
   bool mWriteZero = false;         ///< if true also write out derivatives/labels ==0
   bool mHasSpecial = false;        ///< if true, special(..) already called for this record
   std::vector<int> mBufferInt;     ///< to collect labels etc.
   std::vector<float> mBufferFloat; ///< to collect derivatives etc.
+
+  bool mAsync = false;                ///< if true the binary records are written by mWriter
+  std::vector<char> mRecords;         ///< records collected for the writer thread
+  std::vector<char> mRecordsWriting;  ///< records being written by the writer thread
+  bool mWriting = false;              ///< mRecordsWriting is being written
+  bool mStop = false;                 ///< stop the writer thread
+  std::mutex mMutex;                  ///< protects the hand-over to the writer thread
+  std::condition_variable mCondition; ///< signals the hand-over and the end of writing
+  std::thread mWriter;                ///< writer thread
 };
 
 } // namespace align
@@ -786,7 +786,7 @@ bool Controller::fillMilleData()
   if (!mMille) {
     const auto& conf = AlignConfig::Instance();
     mMilleFileName = fmt::format("{}_{:08d}_{:010d}{}", AlignConfig::Instance().mpDatFileName, mTimingInfo.runNumber, mTimingInfo.tfCounter, conf.MilleOutBin ? sMPDataExt : sMPDataTxtExt);
-    mMille = std::make_unique<Mille>(mMilleFileName.c_str(), conf.MilleOutBin);
+    mMille = std::make_unique<Mille>(mMilleFileName.c_str(), conf.MilleOutBin, false, conf.MilleOutAsync);
   }
   if (!mAlgTrack->getDerivDone()) {
     LOG(error) << "Track derivatives are not yet evaluated";
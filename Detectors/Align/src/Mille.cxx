@@ -22,25 +22,81 @@
 #include "Framework/Logger.h"
 #include <fstream>
 #include <iostream>
+#include <thread>
 
 namespace o2
 {
 namespace align
 {
 //___________________________________________________________________________
-Mille::Mille(const std::string& outFileName, bool asBinary, bool writeZero)
+Mille::Mille(const std::string& outFileName, bool asBinary, bool writeZero, bool async)
   : mOutFile(outFileName, (asBinary ? (std::ios::binary | std::ios::out | std::ios::trunc) : (std::ios::out | std::ios::trunc))),
     mAsBinary(asBinary),
-    mWriteZero(writeZero)
+    mWriteZero(writeZero),
+    mAsync(async && asBinary) // text output is only used for debugging
 {
   if (!mOutFile.is_open()) {
     LOG(fatal) << "Failed to open Mille file " << outFileName;
   }
   mBufferInt.reserve(1024);
   mBufferFloat.reserve(1024);
+  if (mAsync) {
+    mRecords.reserve(AsyncBufferSize);
+    mRecordsWriting.reserve(AsyncBufferSize);
+    mWriter = std::thread(&Mille::runWriter, this);
+  }
   clear();
 }
 
+//___________________________________________________________________________
+Mille::~Mille()
+{
+  if (mAsync) {
+    flushAsync();
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mStop = true;
+    }
+    mCondition.notify_all();
+    mWriter.join();
+  }
+}
+
+//___________________________________________________________________________
+/// Pass the collected records to the writer thread, waiting for the previous ones to be written.
+void Mille::flushAsync()
+{
+  if (mRecords.empty()) {
+    return;
+  }
+  std::unique_lock<std::mutex> lock(mMutex);
+  mCondition.wait(lock, [this] { return !mWriting; });
+  mRecords.swap(mRecordsWriting);
+  mWriting = true;
+  lock.unlock();
+  mCondition.notify_all();
+  mRecords.clear();
+}
+
+//___________________________________________________________________________
+/// Write the records passed by flushAsync to the file.
+void Mille::runWriter()
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+  while (true) {
+    mCondition.wait(lock, [this] { return mWriting || mStop; });
+    if (mWriting) { // mRecordsWriting is not touched by the other thread while mWriting is set
+      lock.unlock();
+      mOutFile.write(mRecordsWriting.data(), mRecordsWriting.size());
+      lock.lock();
+      mWriting = false;
+      mCondition.notify_all();
+    } else if (mStop) {
+      break;
+    }
+  }
+}
+
 //___________________________________________________________________________
 /// Add measurement to buffer.
 /**
@@ -133,7 +189,18 @@ int Mille::finalise()
   if (nw) { // only if anything stored...
     const int numWordsToWrite = nw * 2;
 
-    if (mAsBinary) {
+    if (mAsync) {
+      auto append = [this](const void* data, size_t size) {
+        const char* ptr = reinterpret_cast<const char*>(data);
+        mRecords.insert(mRecords.end(), ptr, ptr + size);
+      };
+      append(&numWordsToWrite, sizeof(int));
+      append(mBufferFloat.data(), nw * sizeof(mBufferFloat[0]));
+      append(mBufferInt.data(), nw * sizeof(mBufferInt[0]));
+      if (mRecords.size() >= AsyncBufferSize) {
+        flushAsync();
+      }
+    } else if (mAsBinary) {
       mOutFile.write(reinterpret_cast<const char*>(&numWordsToWrite), sizeof(int));
       mOutFile.write(reinterpret_cast<const char*>(mBufferFloat.data()), nw * sizeof(mBufferFloat[0]));
       mOutFile.write(reinterpret_cast<const char*>(mBufferInt.data()), nw * sizeof(mBufferInt[0]));
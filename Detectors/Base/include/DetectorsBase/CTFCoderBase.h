@@ -35,6 +35,11 @@
 #include "Framework/ConcreteDataMatcher.h"
 #include "Framework/ConfigParamRegistry.h"
 #include <any>
+#include <array>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <thread>
 
 namespace o2
 {
@@ -121,6 +126,13 @@ class CTFCoderBase
   void setVerbosity(int v) { mVerbosity = v; }
   int getVerbosity() const { return mVerbosity; }
 
+  void setNEncoderThreads(int n) { mNEncoderThreads = n > 1 ? n : 1; }
+  int getNEncoderThreads() const { return mNEncoderThreads; }
+
+  /// for every block choose between the external and the embedded dictionary, depending on the estimated size
+  void setAdaptiveDictSelection(bool v) { mAdaptiveDict = v; }
+  bool getAdaptiveDictSelection() const { return mAdaptiveDict; }
+
   const CTFDictHeader& getExtDictHeader() const { return mExtHeader; }
 
   template <typename T>
@@ -173,6 +185,12 @@ class CTFCoderBase
   }
   bool canApplyBCShift(const o2::InteractionRecord& ir) const { return canApplyBCShift(ir, mBCShift); }
 
+  /// flag the entries of the decoded trigger records selected by the IR frames (all of them if no selection is set).
+  /// The IRs are restored from the BC and orbit increments and shifted as in the decompression, each entry spanning nBC bunches.
+  /// @returns number of selected entries: if 0, the payload blocks need not be decoded at all
+  template <typename VB, typename VO>
+  size_t selectDecodedIRs(const o2::InteractionRecord& ir0, const VB& bcInc, const VO& orbitInc, size_t n, std::vector<bool>& selected, uint32_t nBC = 1);
+
   template <typename source_IT>
   [[nodiscard]] size_t estimateBufferSize(size_t slot, source_IT samplesBegin, source_IT samplesEnd);
 
@@ -187,6 +205,17 @@ class CTFCoderBase
 
   template <typename CTF>
   std::vector<char> loadDictionaryFromTree(TTree* tree);
+
+  /// entropy-encode the source containers of all blocks (in the order of the slots) to the CTF in the buffer.
+  /// With more than 1 encoder threads the blocks are encoded concurrently into separate buffers and then copied to the CTF
+  template <typename CTF, typename BUF, typename OPT, typename... SRC>
+  o2::ctf::CTFIOSize encodeBlocks(BUF& buffer, const OPT& optField, const SRC&... sources);
+
+  /// run the tasks in up to mNEncoderThreads threads (including the calling one), rethrow the exception of the 1st failed task.
+  /// Also used by the decoders, for blocks which can be decoded independently
+  template <size_t NT>
+  void runEncoderTasks(std::array<std::function<void()>, NT>& tasks) const;
+
   std::vector<std::any> mCoders; // encoders/decoders
   DetID mDet;
   std::string mDictBinding{"ctfdict"};
@@ -204,6 +233,8 @@ class CTFCoderBase
   size_t mIRFrameSelMarginFwd = 0; // margin in BC to add to the IRFrame upper boundary when selection is requested
   long mIRFrameSelShift = 0;       // Global shift of the IRFrames, to account for e.g. detector latency
   int mVerbosity = 0;
+  int mNEncoderThreads = 1;   // number of threads for concurrent encoding or decoding of the CTF blocks
+  bool mAdaptiveDict = false; // choose per block between external and embedded dictionary
 };
 
 ///________________________________
@@ -310,6 +341,15 @@ void CTFCoderBase::init(o2::framework::InitContext& ic)
   if (ic.options().hasOption("irframe-margin-fwd")) {
     mIRFrameSelMarginFwd = ic.options().get<uint32_t>("irframe-margin-fwd");
   }
+  if (ic.options().hasOption("encoder-threads")) {
+    setNEncoderThreads(ic.options().get<int>("encoder-threads"));
+  }
+  if (ic.options().hasOption("decoder-threads")) {
+    setNEncoderThreads(ic.options().get<int>("decoder-threads"));
+  }
+  if (ic.options().hasOption("adaptive-dict")) {
+    setAdaptiveDictSelection(ic.options().get<bool>("adaptive-dict"));
+  }
   if (ic.options().hasOption("irframe-shift")) {
     mIRFrameSelShift = (long)ic.options().get<int32_t>("irframe-shift");
   }
@@ -386,6 +426,99 @@ bool CTFCoderBase::finaliseCCDB(o2::framework::ConcreteDataMatcher& matcher, voi
   return match;
 }
 
+///________________________________
+template <typename CTF, typename BUF, typename OPT, typename... SRC>
+o2::ctf::CTFIOSize CTFCoderBase::encodeBlocks(BUF& buffer, const OPT& optField, const SRC&... sources)
+{
+  constexpr int NBlocks = sizeof...(SRC);
+  static_assert(NBlocks == CTF::getNBlocks(), "number of sources must match the number of CTF blocks");
+  const float memfc = getMemMarginFactor();
+  const bool adaptiveDict = getAdaptiveDictSelection();
+  o2::ctf::CTFIOSize iosize;
+  if (mNEncoderThreads < 2) { // at every encoding the buffer might be autoexpanded, so we don't work with fixed pointer to CTF
+    int slot = 0;
+    ((iosize += CTF::get(buffer.data())->encode(sources, slot, 0, optField[slot], &buffer, mCoders[slot], memfc, adaptiveDict), ++slot), ...);
+    return iosize;
+  }
+  // blocks are independent: encode each one to its own buffer concurrently, then copy them to the CTF in the slots order
+  const auto ansVersion = CTF::get(buffer.data())->getANSHeader();
+  std::array<std::vector<o2::ctf::BufferType>, NBlocks> slotBuffers;
+  std::array<std::function<void()>, NBlocks> tasks;
+  int slot = 0;
+  ((tasks[slot] = [&, slot]() {
+     auto& slotBuffer = slotBuffers[slot];
+     CTF::createForSlot(slotBuffer, slot, ansVersion);
+     CTF::get(slotBuffer.data())->encode(sources, slot, 0, optField[slot], &slotBuffer, mCoders[slot], memfc, adaptiveDict);
+   },
+    ++slot),
+   ...);
+
+  runEncoderTasks(tasks);
+  for (int i = 0; i < NBlocks; i++) {
+    iosize += CTF::importBlock(buffer, *CTF::get(slotBuffers[i].data()), i);
+  }
+  return iosize;
+}
+
+///________________________________
+template <typename VB, typename VO>
+size_t CTFCoderBase::selectDecodedIRs(const o2::InteractionRecord& ir0, const VB& bcInc, const VO& orbitInc, size_t n, std::vector<bool>& selected, uint32_t nBC)
+{
+  selected.assign(n, true);
+  if (!mIRFrameSelector.isSet()) {
+    return n;
+  }
+  size_t nSel = 0;
+  auto ir = ir0;
+  for (size_t i = 0; i < n; i++) {
+    if (orbitInc[i]) {  // non-0 increment => new orbit
+      ir.bc = bcInc[i]; // bcInc has absolute meaning
+      ir.orbit += orbitInc[i];
+    } else {
+      ir.bc += bcInc[i];
+    }
+    if (mBCShift && !canApplyBCShift(ir)) { // will be discarded in the decompression
+      selected[i] = false;
+      continue;
+    }
+    auto irs = ir - mBCShift;
+    selected[i] = mIRFrameSelector.check({irs, irs + (nBC - 1)}) >= 0;
+    nSel += selected[i];
+  }
+  return nSel;
+}
+
+///________________________________
+template <size_t NT>
+void CTFCoderBase::runEncoderTasks(std::array<std::function<void()>, NT>& tasks) const
+{
+  constexpr int NTasks = NT;
+  std::atomic<int> nextTask{0};
+  std::array<std::exception_ptr, NT> errors;
+  auto worker = [&]() {
+    for (int i = nextTask++; i < NTasks; i = nextTask++) {
+      try {
+        tasks[i]();
+      } catch (...) {
+        errors[i] = std::current_exception();
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  for (int i = 1; i < std::min(mNEncoderThreads, NTasks); i++) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& th : threads) {
+    th.join();
+  }
+  for (const auto& err : errors) {
+    if (err) {
+      std::rethrow_exception(err);
+    }
+  }
+}
+
 template <typename IT>
 [[nodiscard]] inline size_t CTFCoderBase::estimateBufferSize(size_t slot, IT samplesBegin, IT samplesEnd)
 {
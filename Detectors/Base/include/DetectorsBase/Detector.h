@@ -274,6 +274,36 @@ T decodeTMessage(fair::mq::Parts& dataparts, int index)
 
 void attachDetIDHeaderMessage(int id, fair::mq::Channel& channel, fair::mq::Parts& parts);
 
+// header of hit messages in flat binary format, followed by nHits trivially copyable
+// hits of hitSize bytes each
+struct FlatHitsHeader {
+  static constexpr uint32_t Magic = 0x4846324f; // "O2FH"
+  uint32_t magic = Magic;
+  uint32_t hitSize = 0;
+  uint64_t nHits = 0;
+};
+
+// copy nHits hits of hitSize bytes into a single message (allocated in shared memory with the shm transport)
+void attachFlatHitsMessage(const void* hits, uint32_t hitSize, size_t nHits, fair::mq::Channel& channel, fair::mq::Parts& parts);
+// the hits of the message at index if it is in flat format with hits of hitSize bytes, nullptr otherwise;
+// the message stays owned by dataparts
+const void* getFlatHitsMessage(fair::mq::Parts& dataparts, int index, uint32_t hitSize, size_t& nHits);
+
+template <typename Container>
+void attachFlatHits(Container const& hits, fair::mq::Channel& channel, fair::mq::Parts& parts)
+{
+  attachFlatHitsMessage(hits.data(), sizeof(typename Container::value_type), hits.size(), channel, parts);
+}
+
+template <typename Container>
+Container* decodeFlatHits(fair::mq::Parts& dataparts, int index)
+{
+  using T = typename Container::value_type;
+  size_t nHits = 0;
+  auto ptr = static_cast<const T*>(getFlatHitsMessage(dataparts, index, sizeof(T), nHits));
+  return ptr ? new Container(ptr, ptr + nHits) : nullptr;
+}
+
 template <typename T>
 TBranch* getOrMakeBranch(TTree& tree, const char* brname, T* ptr)
 {
@@ -291,6 +321,13 @@ struct UseShm {
   static constexpr bool value = false;
 };
 
+// a trait to determine if hits (when not in shared mem) may be sent in flat binary format
+// instead of being serialized using TMessage; only used for trivially copyable hits
+template <typename Det>
+struct UseFlatHits {
+  static constexpr bool value = true;
+};
+
 // an implementation helper template which automatically implements
 // common functionality for deriving classes via the CRT pattern
 // (example: it implements the updateHitTrackIndices function and avoids
@@ -326,6 +363,13 @@ class DetImpl : public o2::base::Detector
     }
   }
 
+  // whether hits not in shared mem are sent in flat binary format
+  static constexpr bool useFlatHits()
+  {
+    using Hit_t = typename std::remove_pointer<decltype(static_cast<Det*>(nullptr)->Det::getHits(0))>::type::value_type;
+    return UseFlatHits<Det>::value && std::is_trivially_copyable<Hit_t>::value;
+  }
+
   void attachHits(fair::mq::Channel& channel, fair::mq::Parts& parts) override
   {
     int probe = 0;
@@ -339,7 +383,11 @@ class DetImpl : public o2::base::Detector
 
     while (auto hits = static_cast<Det*>(this)->Det::getHits(probe++)) {
       if (!UseShm<Det>::value || !o2::utils::ShmManager::Instance().isOperational()) {
-        attachTMessage(*hits, channel, parts);
+        if constexpr (useFlatHits()) {
+          attachFlatHits(*hits, channel, parts);
+        } else {
+          attachTMessage(*hits, channel, parts);
+        }
       } else {
         // this is the shared mem variant
         // we will just send the sharedmem ID and the offset inside
@@ -537,7 +585,7 @@ class DetImpl : public o2::base::Detector
     using HitPtr_t = decltype(static_cast<Det*>(this)->Det::getHits(probe));
     std::string name = static_cast<Det*>(this)->getHitBranchNames(probe);
 
-    auto copyToBuffer = [this, eventID](HitPtr_t hitdata, Collector_t& collectbuffer, int probe) {
+    auto getBucket = [eventID](Collector_t& collectbuffer, int probe) -> std::vector<std::unique_ptr<Hit_t>>& {
       std::vector<std::vector<std::unique_ptr<Hit_t>>>* hitvector = nullptr;
       {
         auto eventIter = collectbuffer.find(eventID);
@@ -551,26 +599,30 @@ class DetImpl : public o2::base::Detector
       if (probe >= hitvector->size()) {
         hitvector->resize(probe + 1);
       }
-      // add empty hit bucket to list for this event and probe
-      (*hitvector)[probe].emplace_back(new Hit_t());
-      // copy the data into this bucket
-      *((*hitvector)[probe].back()) = *hitdata;
+      return (*hitvector)[probe];
     };
 
     while (name.size() > 0) {
       if (!UseShm<Det>::value || !o2::utils::ShmManager::Instance().isOperational()) {
         // for each branch name we extract/decode hits from the message parts ...
-        auto hitsptr = decodeTMessage<HitPtr_t>(parts, index++);
+        // (flat hits are checked first since the sender may not have used TMessage)
+        HitPtr_t hitsptr = nullptr;
+        if constexpr (useFlatHits()) {
+          hitsptr = decodeFlatHits<Hit_t>(parts, index);
+        }
+        if (!hitsptr) {
+          hitsptr = decodeTMessage<HitPtr_t>(parts, index);
+        }
+        index++;
         if (hitsptr) {
-          // ... and copy them to the buffer
-          copyToBuffer(hitsptr, hitcollector, probe);
-          delete hitsptr;
+          // ... and move them to the buffer
+          getBucket(hitcollector, probe).emplace_back(hitsptr);
         }
       } else {
         // for each branch name we extract/decode hits from the message parts ...
         auto hitsptr = decodeShmMessage<HitPtr_t>(parts, index++, busy);
-        // ... and copy them to the buffer
-        copyToBuffer(hitsptr, hitcollector, probe);
+        // ... and copy them to a new bucket of the buffer
+        getBucket(hitcollector, probe).emplace_back(new Hit_t(*hitsptr));
       }
       // next name
       probe++;
@@ -593,7 +645,14 @@ class DetImpl : public o2::base::Detector
       if (!UseShm<Det>::value || !o2::utils::ShmManager::Instance().isOperational()) {
 
         // for each branch name we extract/decode hits from the message parts ...
-        auto hitsptr = decodeTMessage<Hit_t>(parts, index++);
+        Hit_t hitsptr = nullptr;
+        if constexpr (useFlatHits()) {
+          hitsptr = decodeFlatHits<typename std::remove_pointer<Hit_t>::type>(parts, index);
+        }
+        if (!hitsptr) {
+          hitsptr = decodeTMessage<Hit_t>(parts, index);
+        }
+        index++;
         if (hitsptr) {
           // ... and fill the tree branch
           auto br = getOrMakeBranch(tr, name.c_str(), hitsptr);
@@ -0,0 +1,113 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef ALICEO2_BASE_FASTSIMREGION_H
+#define ALICEO2_BASE_FASTSIMREGION_H
+
+#include <functional>
+#include <memory>
+#include <unordered_map>
+
+class TVirtualMC;
+
+namespace o2
+{
+namespace base
+{
+
+/// The state of a particle entering a fast simulation region
+struct FastSimParticle {
+  int pdg = 0;
+  int trackID = -1;
+  float x = 0.f, y = 0.f, z = 0.f;    // entry point (cm)
+  float px = 0.f, py = 0.f, pz = 0.f; // momentum (GeV)
+  float e = 0.f;                      // total energy (GeV)
+  float t = 0.f;                      // time (s)
+};
+
+/// Interface of the shower models attached to a fast simulation region.
+/// A model replaces the transport of a particle inside the region by producing
+/// its deposits directly as hits of the detector owning the region.
+class FastSimShowerModel
+{
+ public:
+  virtual ~FastSimShowerModel() = default;
+  /// @returns true if the particle was handled and its track is to be stopped,
+  /// false if it is to be transported normally
+  virtual bool simulate(FastSimParticle const& particle) = 0;
+};
+
+/// Parametrized electromagnetic shower: the energy is deposited along the
+/// direction of flight in slices following the longitudinal Gamma profile
+/// dE/dt = E b (bt)^(a-1) exp(-bt) / Gamma(a), t in radiation lengths, with
+/// the maximum at t = ln(E/Ec) - 0.5 (Grindhammer et al.), and with a Gaussian
+/// lateral spread of one Moliere radius. The detector turns the deposits into hits.
+class ParametrizedShowerModel : public FastSimShowerModel
+{
+ public:
+  /// called for every deposit with the position (cm), the energy (GeV) and the time (s)
+  using DepositFcn = std::function<void(FastSimParticle const& particle, float x, float y, float z, float edep, float t)>;
+
+  /// @param radLength radiation length X0 of the calorimeter (cm)
+  /// @param criticalEnergy critical energy Ec (GeV)
+  /// @param moliereRadius lateral spread (cm), 0 to deposit on the shower axis
+  /// @param depth depth of the calorimeter in radiation lengths, the energy beyond is leaking
+  ParametrizedShowerModel(DepositFcn deposit, float radLength, float criticalEnergy, float moliereRadius, float depth,
+                          int nSlices = 25, int nSpotsPerSlice = 10);
+
+  bool simulate(FastSimParticle const& particle) override;
+
+  /// energy fraction deposited between t1 and t2 radiation lengths by a shower of energy e
+  float longitudinalFraction(float e, float t1, float t2) const;
+
+ private:
+  DepositFcn mDeposit;
+  float mRadLength;
+  float mCriticalEnergy;
+  float mMoliereRadius;
+  float mDepth;
+  int mNSlices;
+  int mNSpotsPerSlice;
+};
+
+/// Registry of the fast simulation regions: volumes (by VMC volume id) and, for each of them,
+/// the shower models per particle type (PDG code, 0 for all particles).
+/// Filled by the detectors, e.g. in InitializeO2Detector, and used by the stepping of
+/// O2MCApplication for every track entering a volume.
+class FastSimRegistry
+{
+ public:
+  static FastSimRegistry& instance()
+  {
+    static FastSimRegistry inst;
+    return inst;
+  }
+
+  void addModel(int volumeID, int pdg, std::shared_ptr<FastSimShowerModel> model);
+  /// the model for pdg in the volume, nullptr if none
+  FastSimShowerModel* findModel(int volumeID, int pdg) const;
+  bool empty() const { return mRegions.empty(); }
+  void clear() { mRegions.clear(); }
+
+  /// handle the current track of the VMC if it enters a region with a model for its type
+  /// @returns true if the track was simulated by a model and is to be stopped
+  bool process(TVirtualMC* mc) const;
+
+ private:
+  FastSimRegistry() = default;
+
+  std::unordered_map<int, std::unordered_map<int, std::shared_ptr<FastSimShowerModel>>> mRegions; // volume id -> pdg -> model
+};
+
+} // namespace base
+} // namespace o2
+
+#endif
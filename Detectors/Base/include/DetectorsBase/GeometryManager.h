@@ -29,6 +29,7 @@
 #include <mutex>
 class TGeoHMatrix; // lines 11-11
 class TGeoManager; // lines 9-9
+class TGeoNavigator;
 
 namespace o2
 {
@@ -98,6 +99,8 @@ class GeometryManager : public TObject
   };
 
   static o2::base::MatBudget meanMaterialBudget(float x0, float y0, float z0, float x1, float y1, float z1);
+  /// same with an explicit navigator, without locking: to be used with a navigator per thread
+  static o2::base::MatBudget meanMaterialBudget(float x0, float y0, float z0, float x1, float y1, float z1, TGeoNavigator* nav);
   static o2::base::MatBudget meanMaterialBudget(const math_utils::Point3D<float>& start, const math_utils::Point3D<float>& end)
   {
     return meanMaterialBudget(start.X(), start.Y(), start.Z(), end.X(), end.Y(), end.Z());
@@ -25,6 +25,10 @@
 #include "GPUCommonMath.h"
 #include "DetectorsBase/MatCell.h"
 
+#ifndef GPUCA_ALIGPUCODE
+class TGeoNavigator;
+#endif
+
 namespace o2
 {
 namespace base
@@ -64,7 +68,8 @@ class MatLayerCyl : public o2::gpu::FlatObject
   void initSegmentation(float rMin, float rMax, float zHalfSpan, int nz, int nphi);
   void initSegmentation(float rMin, float rMax, float zHalfSpan, float dzMin, float drphiMin);
   void populateFromTGeo(int ntrPerCell = 10);
-  void populateFromTGeo(int ip, int iz, int ntrPerCell);
+  /// populate single cell, with a navigator owned by the calling thread or under the GeometryManager lock if none is given
+  void populateFromTGeo(int ip, int iz, int ntrPerCell, TGeoNavigator* nav = nullptr);
   void print(bool data = false) const;
 #endif // !GPUCA_ALIGPUCODE
 
@@ -47,6 +47,11 @@ struct MatLayerCylSetLayout {
   int* mInterval2LrID;  //[mNRIntervals] mapping from r2 interval to layer ID
 };
 
+/// layer in which the last queried segment of a track has ended, to be kept by the caller between consecutive queries for the same track
+struct MatBudgetCache {
+  short lrID = -1; ///< layer ID, -1 if not known or outside of the layers
+};
+
 class MatLayerCylSet : public o2::gpu::FlatObject
 {
 
@@ -71,7 +76,7 @@ class MatLayerCylSet : public o2::gpu::FlatObject
 #ifndef GPUCA_ALIGPUCODE // this part is unvisible on GPU version
   void print(bool data = false) const;
   void addLayer(float rmin, float rmax, float zmax, float dz, float drphi);
-  void populateFromTGeo(int ntrPerCel = 10);
+  void populateFromTGeo(int ntrPerCel = 10, int nThreads = 1);
   void optimizePhiSlices(float maxRelDiff = 0.05);
 
   void dumpToTree(const std::string& outName = "matbudTree.root") const;
@@ -99,6 +104,12 @@ class MatLayerCylSet : public o2::gpu::FlatObject
 #endif // !GPUCA_ALIGPUCODE
   GPUd() MatBudget getMatBudget(float x0, float y0, float z0, float x1, float y1, float z1) const;
 
+  /// material budget on the line between two points, the layer of the cache is tested before searching the layers and is updated with the layer of the end point
+  GPUd() MatBudget getMatBudget(float x0, float y0, float z0, float x1, float y1, float z1, MatBudgetCache& cache) const;
+
+  /// material budgets of n segments given by the start points xyz0[3 * i] and end points xyz1[3 * i], with optional caches of the tracks to which the segments belong
+  GPUd() void getMatBudget(int n, const float* xyz0, const float* xyz1, MatBudget* budgets, MatBudgetCache* caches = nullptr) const;
+
   GPUd() int searchSegment(float val, int low = -1, int high = -1) const;
 
   /// searches a layer based on r2 input, using a lookup table
@@ -124,6 +135,12 @@ class MatLayerCylSet : public o2::gpu::FlatObject
   static constexpr size_t getBufferAlignmentBytes() { return 8; }
 #endif // !GPUCA_GPUCODE
 
+  /// material budget of the ray, with the range of relevant layers
+  GPUd() MatBudget getMatBudget(Ray& ray, short lmin, short lmax) const;
+
+  /// material budget of a ray which is fully contained in a single cell of the layer lrID, returns false if this is not the case
+  GPUd() bool getMatBudgetSingleCell(const Ray& ray, float rmin2, float rmax2, short lrID, MatBudget& rval) const;
+
   static constexpr float LayerRMax = 500;    // maximum value of R lookup (corresponds to last layer of MatLUT)
   static constexpr float VoxelRDelta = 0.05; // voxel spacing for layer lookup; seems a natural choice - corresponding ~ to smallest spacing
   static constexpr float InvVoxelRDelta = 1.f / VoxelRDelta;
@@ -27,6 +27,9 @@
 #ifndef GPUCA_GPUCODE
 #include <string>
 #endif
+#if !defined(GPUCA_GPUCODE) && !defined(GPUCA_STANDALONE)
+#include <gsl/span>
+#endif
 
 namespace o2
 {
@@ -99,6 +102,14 @@ class PropagatorImpl
   GPUd() bool propagateToAlphaX(track_T& track, value_type alpha, value_type x, bool bzOnly = false, value_type maxSnp = MAX_SIN_PHI, value_type maxStep = MAX_STEP, int minSteps = 1,
                                 MatCorrType matCorr = MatCorrType::USEMatCorrLUT, track::TrackLTIntegral* tofInfo = nullptr, int signCorr = 0) const;
 
+#if !defined(GPUCA_GPUCODE) && !defined(GPUCA_STANDALONE)
+  /// propagate all tracks of the batch to the same X with the settings of propagateTo, the material source being resolved once for the batch.
+  /// If provided, status must have the size of tracks and is set to the result of each track. Returns the number of successfully propagated tracks.
+  template <typename track_T>
+  int propagateAllTo(gsl::span<track_T> tracks, value_type x, bool bzOnly = false, value_type maxSnp = MAX_SIN_PHI, value_type maxStep = MAX_STEP,
+                     MatCorrType matCorr = MatCorrType::USEMatCorrLUT, gsl::span<uint8_t> status = {}, int signCorr = 0) const;
+#endif
+
   GPUd() bool propagateToDCA(const o2::dataformats::VertexBase& vtx, o2::track::TrackParametrizationWithError<value_type>& track, value_type bZ,
                              value_type maxStep = MAX_STEP, MatCorrType matCorr = MatCorrType::USEMatCorrLUT,
                              o2::dataformats::DCA* dcaInfo = nullptr, track::TrackLTIntegral* tofInfo = nullptr,
@@ -151,7 +162,7 @@ class PropagatorImpl
   static int initFieldFromGRP(const std::string grpFileName = "", bool verbose = false);
 #endif
 
-  GPUd() MatBudget getMatBudget(MatCorrType corrType, const o2::math_utils::Point3D<value_type>& p0, const o2::math_utils::Point3D<value_type>& p1) const;
+  GPUd() MatBudget getMatBudget(MatCorrType corrType, const o2::math_utils::Point3D<value_type>& p0, const o2::math_utils::Point3D<value_type>& p1, MatBudgetCache* cache = nullptr) const;
 
   GPUd() void getFieldXYZ(const math_utils::Point3D<float> xyz, float* bxyz) const;
 
@@ -162,7 +162,8 @@ class Stack : public FairGenericStack
   /// \param option: 0=events summary, non0=track info
   void Print(Option_t* option = nullptr) const override;
 
-  void ReorderKine(std::vector<MCTrack>& particles, std::vector<int>& reOrderedIndices);
+  /// order the kept particles (given by their entries in mParticles) such that the descendants are next to each other
+  void ReorderKine(std::vector<int> const& keptEntries, std::vector<int>& reOrderedIndices);
   /// Modifiers
   void StoreSecondaries(Bool_t choice = kTRUE) { mStoreSecondaries = choice; }
   void pruneKinematics(bool choice = true) { mPruneKinematics = choice; }
@@ -250,6 +251,16 @@ class Stack : public FairGenericStack
   std::vector<int> mTransportedIDs;          //! prim + sec trackIDs transported for "current" primary
   std::vector<int> mIndexOfPrimaries;        //! index of primaries in mParticles
   std::vector<int> mTrackIDtoParticlesEntry; //! an O(1) mapping of trackID to the entry of mParticles
+
+  // buffers of the compaction and reordering in FinishPrimary, kept to reuse their memory
+  std::vector<int> mIndicesKept;         //! index in mParticles -> index among the kept particles (-1 if dropped)
+  std::vector<int> mKeptEntries;         //! kept particles as entries in mParticles
+  std::vector<int> mReOrderedIndices;    //!
+  std::vector<int> mInvReOrderedIndices; //!
+  std::vector<int> mReorderOffsets;      //! prefix sum of the number of daughters per particle
+  std::vector<int> mReorderDaughters;    //! daughters grouped by mother
+  std::vector<int> mReorderCursor;       //!
+  std::vector<bool> mReorderDone;        //!
   // the current TParticle object
   TParticle mCurrentParticle;
   TParticle mCurrentParticle0;
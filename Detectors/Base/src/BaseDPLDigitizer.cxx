@@ -15,8 +15,11 @@
 #include <DataFormatsParameters/GRPObject.h>
 #include <DetectorsBase/Propagator.h>
 #include <fairlogger/Logger.h>
+#include <SimulationDataFormat/DigitizationContext.h>
 #include <TGeoGlobalMagField.h>
 #include <TRandom.h>
+#include <TTreeCacheUnzip.h>
+#include <TROOT.h>
 
 using namespace o2::base;
 
@@ -55,6 +58,18 @@ void BaseDPLDigitizer::init(o2::framework::InitContext& ic)
     }
   }
 
+  // configure the reading of the hits
+  const auto& digipar = o2::conf::DigiParams::Instance();
+  if (digipar.hitReadCacheMB > 0) {
+    o2::steer::DigitizationContext::setHitReadCacheSize(long(digipar.hitReadCacheMB) << 20);
+    if (digipar.hitReadUnzipThreads > 0) {
+      ROOT::EnableImplicitMT(digipar.hitReadUnzipThreads);
+      TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kEnable);
+    }
+    LOG(info) << "Reading hits with a " << digipar.hitReadCacheMB << " MB cache per file"
+              << (digipar.hitReadUnzipThreads > 0 ? ", decompressed in parallel" : "");
+  }
+
   // initialize the global ROOT random number generator (needed or not)
   LOG(info) << "Initializing ROOT digitizer random with seed " << o2::conf::DigiParams::Instance().seed;
   gRandom->SetSeed(o2::conf::DigiParams::Instance().seed);
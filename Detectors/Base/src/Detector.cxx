@@ -197,6 +197,7 @@ int Detector::registerSensitiveVolumeAndGetVolID(std::string const& name)
 #include <fairmq/Message.h>
 #include <fairmq/Parts.h>
 #include <fairmq/Channel.h>
+#include <cstring>
 namespace o2::base
 {
 // this goes into the source
@@ -216,6 +217,36 @@ void attachDetIDHeaderMessage(int id, fair::mq::Channel& channel, fair::mq::Part
   std::unique_ptr<fair::mq::Message> message(channel.NewSimpleMessage(id));
   parts.AddPart(std::move(message));
 }
+void attachFlatHitsMessage(const void* hits, uint32_t hitSize, size_t nHits, fair::mq::Channel& channel, fair::mq::Parts& parts)
+{
+  // The hits are copied once into the message, which lives in shared memory when the
+  // channel uses the shm transport: the receiver can use them without any deserialization
+  FlatHitsHeader header;
+  header.hitSize = hitSize;
+  header.nHits = nHits;
+  auto msg = channel.Transport()->CreateMessage(sizeof(FlatHitsHeader) + nHits * hitSize, fair::mq::Alignment{64});
+  auto data = static_cast<char*>(msg->GetData());
+  memcpy(data, &header, sizeof(FlatHitsHeader));
+  if (nHits) {
+    memcpy(data + sizeof(FlatHitsHeader), hits, nHits * hitSize);
+  }
+  parts.AddPart(std::move(msg));
+}
+const void* getFlatHitsMessage(fair::mq::Parts& dataparts, int index, uint32_t hitSize, size_t& nHits)
+{
+  auto& message = dataparts.At(index);
+  auto size = message->GetSize();
+  if (size < sizeof(FlatHitsHeader)) {
+    return nullptr;
+  }
+  FlatHitsHeader header;
+  memcpy(&header, message->GetData(), sizeof(FlatHitsHeader));
+  if (header.magic != FlatHitsHeader::Magic || header.hitSize != hitSize || sizeof(FlatHitsHeader) + header.nHits * hitSize != size) {
+    return nullptr;
+  }
+  nHits = header.nHits;
+  return static_cast<const char*>(message->GetData()) + sizeof(FlatHitsHeader);
+}
 void attachShmMessage(void* hits_ptr, fair::mq::Channel& channel, fair::mq::Parts& parts, bool* busy_ptr)
 {
   struct shmcontext {
@@ -0,0 +1,116 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "DetectorsBase/FastSimRegion.h"
+#include "TVirtualMC.h"
+#include "TVirtualMCStack.h"
+#include "TMath.h"
+#include "TRandom.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace o2::base;
+
+ParametrizedShowerModel::ParametrizedShowerModel(DepositFcn deposit, float radLength, float criticalEnergy, float moliereRadius, float depth,
+                                                 int nSlices, int nSpotsPerSlice)
+  : mDeposit(std::move(deposit)), mRadLength(radLength), mCriticalEnergy(criticalEnergy), mMoliereRadius(moliereRadius), mDepth(depth), mNSlices(nSlices), mNSpotsPerSlice(nSpotsPerSlice)
+{
+}
+
+float ParametrizedShowerModel::longitudinalFraction(float e, float t1, float t2) const
+{
+  constexpr float b = 0.5;
+  const float tmax = std::max(0.f, std::log(e / mCriticalEnergy) - 0.5f);
+  const float a = b * tmax + 1.f;
+  // the Gamma profile integrates to the regularized lower incomplete gamma function
+  return TMath::Gamma(a, b * t2) - TMath::Gamma(a, b * t1);
+}
+
+bool ParametrizedShowerModel::simulate(FastSimParticle const& particle)
+{
+  const float p = std::sqrt(particle.px * particle.px + particle.py * particle.py + particle.pz * particle.pz);
+  if (p <= 0.f || particle.e <= 0.f) {
+    return false;
+  }
+  // shower axis and two directions orthogonal to it for the lateral spread
+  const float ux = particle.px / p, uy = particle.py / p, uz = particle.pz / p;
+  float vx = -uy, vy = ux, vz = 0.f;
+  float vnorm = std::sqrt(vx * vx + vy * vy);
+  if (vnorm < 1e-6f) {
+    vx = 1.f, vy = 0.f, vnorm = 1.f;
+  }
+  vx /= vnorm, vy /= vnorm;
+  const float wx = uy * vz - uz * vy, wy = uz * vx - ux * vz, wz = ux * vy - uy * vx;
+
+  constexpr float SpeedOfLight = 29.9792458; // cm/ns
+  const float dt = mDepth / mNSlices;
+  for (int slice = 0; slice < mNSlices; ++slice) {
+    const float edep = particle.e * longitudinalFraction(particle.e, slice * dt, (slice + 1) * dt);
+    if (edep <= 0.f) {
+      continue;
+    }
+    const float depth = (slice + 0.5f) * dt * mRadLength;
+    const float time = particle.t + depth / SpeedOfLight * 1e-9f;
+    for (int spot = 0; spot < mNSpotsPerSlice; ++spot) {
+      float dv = 0.f, dw = 0.f;
+      if (mMoliereRadius > 0.f) {
+        dv = gRandom->Gaus(0., mMoliereRadius);
+        dw = gRandom->Gaus(0., mMoliereRadius);
+      }
+      mDeposit(particle,
+               particle.x + depth * ux + dv * vx + dw * wx,
+               particle.y + depth * uy + dv * vy + dw * wy,
+               particle.z + depth * uz + dv * vz + dw * wz,
+               edep / mNSpotsPerSlice, time);
+    }
+  }
+  return true;
+}
+
+void FastSimRegistry::addModel(int volumeID, int pdg, std::shared_ptr<FastSimShowerModel> model)
+{
+  mRegions[volumeID][pdg] = std::move(model);
+}
+
+FastSimShowerModel* FastSimRegistry::findModel(int volumeID, int pdg) const
+{
+  auto region = mRegions.find(volumeID);
+  if (region == mRegions.end()) {
+    return nullptr;
+  }
+  auto model = region->second.find(pdg);
+  if (model == region->second.end()) {
+    model = region->second.find(0);
+  }
+  return model == region->second.end() ? nullptr : model->second.get();
+}
+
+bool FastSimRegistry::process(TVirtualMC* mc) const
+{
+  if (!mc->IsTrackEntering()) {
+    return false;
+  }
+  int copy;
+  auto model = findModel(mc->CurrentVolID(copy), mc->TrackPid());
+  if (!model) {
+    return false;
+  }
+  FastSimParticle particle;
+  particle.pdg = mc->TrackPid();
+  particle.trackID = mc->GetStack()->GetCurrentTrackNumber();
+  double x, y, z, px, py, pz, e;
+  mc->TrackPosition(x, y, z);
+  mc->TrackMomentum(px, py, pz, e);
+  particle.x = x, particle.y = y, particle.z = z;
+  particle.px = px, particle.py = py, particle.pz = pz, particle.e = e;
+  particle.t = mc->TrackTime();
+  return model->simulate(particle);
+}
@@ -17,7 +17,10 @@
 #ifndef GPUCA_ALIGPUCODE // this part is unvisible on GPU version
 #include "GPUCommonLogger.h"
 #include <TFile.h>
+#include <TGeoManager.h>
 #include "CommonUtils/TreeStreamRedirector.h"
+#include <atomic>
+#include <thread>
 //#define _DBG_LOC_ // for local debugging only
 
 #endif // !GPUCA_ALIGPUCODE
@@ -69,9 +72,10 @@ void MatLayerCylSet::addLayer(float rmin, float rmax, float zmax, float dz, floa
 }
 
 //________________________________________________________________________________
-void MatLayerCylSet::populateFromTGeo(int ntrPerCell)
+void MatLayerCylSet::populateFromTGeo(int ntrPerCell, int nThreads)
 {
-  ///< populate layers, using ntrPerCell test tracks per cell
+  ///< populate layers, using ntrPerCell test tracks per cell.
+  ///< With nThreads > 1 the cells of all layers are shared by threads with their own TGeo navigator
   assert(mConstructionMask == InProgress);
 
   int nlr = getNLayers();
@@ -83,10 +87,50 @@ void MatLayerCylSet::populateFromTGeo(int ntrPerCell)
     LOG(error) << "The LUT is already populated";
     return;
   }
+  if (nThreads <= 1) {
+    for (int i = 0; i < nlr; i++) {
+      printf("Populating with %d trials Lr  %3d ", ntrPerCell, i);
+      get()->mLayers[i].print();
+      get()->mLayers[i].populateFromTGeo(ntrPerCell);
+    }
+    finalizeStructures();
+    return;
+  }
+
+  // the cells are independent: threads pick them from a common counter (their cost differs a lot
+  // between the layers) and fill them using the navigators of their own TGeo thread data
+  std::vector<std::pair<int, int>> cellRanges; // first global cell of each layer and its number of phi bins
+  int nCells = 0;
   for (int i = 0; i < nlr; i++) {
+    auto& lr = get()->mLayers[i];
     printf("Populating with %d trials Lr  %3d ", ntrPerCell, i);
-    get()->mLayers[i].print();
-    get()->mLayers[i].populateFromTGeo(ntrPerCell);
+    lr.print();
+    cellRanges.emplace_back(nCells, lr.getNPhiBins());
+    nCells += lr.getNZBins() * lr.getNPhiBins();
+  }
+  if (gGeoManager->GetMaxThreads() < nThreads) {
+    gGeoManager->SetMaxThreads(nThreads);
+  }
+  ntrPerCell = ntrPerCell > 1 ? ntrPerCell : 1;
+  std::atomic<int> nextCell{0};
+  auto worker = [&]() {
+    auto nav = gGeoManager->AddNavigator();
+    int cell;
+    while ((cell = nextCell++) < nCells) {
+      int lr = nlr;
+      while (cellRanges[--lr].first > cell) {
+      }
+      const int cellInLayer = cell - cellRanges[lr].first, nPhi = cellRanges[lr].second;
+      get()->mLayers[lr].populateFromTGeo(cellInLayer % nPhi, cellInLayer / nPhi, ntrPerCell, nav);
+    }
+    gGeoManager->RemoveNavigator(nav);
+  };
+  std::vector<std::thread> threads;
+  for (int i = 0; i < nThreads; i++) {
+    threads.emplace_back(worker);
+  }
+  for (auto& th : threads) {
+    th.join();
   }
   finalizeStructures();
 }
@@ -279,13 +323,113 @@ std::size_t MatLayerCylSet::estimateFlatBufferSize() const
 GPUd() MatBudget MatLayerCylSet::getMatBudget(float x0, float y0, float z0, float x1, float y1, float z1) const
 {
   // get material budget traversed on the line between point0 and point1
-  MatBudget rval;
   Ray ray(x0, y0, z0, x1, y1, z1);
   short lmin, lmax; // get innermost and outermost relevant layer
   if (ray.isTooShort() || !getLayersRange(ray, lmin, lmax)) {
+    MatBudget rval;
+    rval.length = ray.getDist();
+    return rval;
+  }
+  return getMatBudget(ray, lmin, lmax);
+}
+
+//_________________________________________________________________________________________________
+GPUd() MatBudget MatLayerCylSet::getMatBudget(float x0, float y0, float z0, float x1, float y1, float z1, MatBudgetCache& cache) const
+{
+  // get material budget traversed on the line between point0 and point1, testing first if the segment stays in the layer of the cache
+  Ray ray(x0, y0, z0, x1, y1, z1);
+  if (ray.isTooShort()) {
+    MatBudget rval;
     rval.length = ray.getDist();
     return rval;
   }
+  float rmin2, rmax2;
+  ray.getMinMaxR2(rmin2, rmax2);
+  short lmin, lmax;
+  if (cache.lrID >= 0 && cache.lrID < getNLayers() && rmin2 >= getLayer(cache.lrID).getRMin2() && rmax2 < getLayer(cache.lrID).getRMax2()) {
+    lmin = lmax = cache.lrID;
+  } else if (!getLayersRange(ray, lmin, lmax)) {
+    cache.lrID = -1;
+    MatBudget rval;
+    rval.length = ray.getDist();
+    return rval;
+  }
+  // layer of the end point for the next segment of the track
+  float r2End = x1 * x1 + y1 * y1;
+  cache.lrID = -1;
+  for (short lrID = lmin; lrID <= lmax; lrID++) {
+    if (r2End >= getLayer(lrID).getRMin2() && r2End < getLayer(lrID).getRMax2()) {
+      cache.lrID = lrID;
+      break;
+    }
+  }
+  return getMatBudget(ray, lmin, lmax);
+}
+
+//_________________________________________________________________________________________________
+GPUd() void MatLayerCylSet::getMatBudget(int n, const float* xyz0, const float* xyz1, MatBudget* budgets, MatBudgetCache* caches) const
+{
+  // get material budgets of n segments
+  for (int i = 0; i < n; i++) {
+    const float* p0 = xyz0 + 3 * i;
+    const float* p1 = xyz1 + 3 * i;
+    budgets[i] = caches ? getMatBudget(p0[0], p0[1], p0[2], p1[0], p1[1], p1[2], caches[i]) : getMatBudget(p0[0], p0[1], p0[2], p1[0], p1[1], p1[2]);
+  }
+}
+
+//_________________________________________________________________________________________________
+GPUd() bool MatLayerCylSet::getMatBudgetSingleCell(const Ray& ray, float rmin2, float rmax2, short lrID, MatBudget& rval) const
+{
+  // material budget of a ray which does not leave the cell of its start point in the layer lrID
+  const auto& lr = getLayer(lrID);
+  if (rmin2 < lr.getRMin2() || rmax2 >= lr.getRMax2()) {
+    return false;
+  }
+  float zStart = ray.getZ(0.f), zEnd = ray.getZ(1.f);
+  if (lr.isZOutside(zStart) != MatLayerCyl::Within || lr.isZOutside(zEnd) != MatLayerCyl::Within) {
+    return false;
+  }
+  int zID = lr.getZBinID(zStart);
+  if (zID != lr.getZBinID(zEnd)) {
+    return false;
+  }
+  int phiBin = lr.getPhiBinID(ray.getPhi(0.f)), phiBinLast = lr.getPhiBinID(ray.getPhi(1.f));
+  int phiID = lr.phiBin2Slice(phiBin);
+  if (phiBin != phiBinLast) {
+    // the segment crosses the phi bins of the shorter arc between its end points, they must belong to the same slice
+    int nphiBins = lr.getNPhiBins(), dBin = phiBinLast - phiBin;
+    if (2 * dBin > nphiBins) {
+      dBin -= nphiBins;
+    } else if (2 * dBin < -nphiBins) {
+      dBin += nphiBins;
+    }
+    int stepBin = dBin > 0 ? 1 : -1;
+    for (int ib = dBin > 0 ? dBin : -dBin; ib--;) {
+      phiBin = (phiBin + stepBin + nphiBins) % nphiBins;
+      if (lr.phiBin2Slice(phiBin) != phiID) {
+        return false;
+      }
+    }
+  }
+  const auto& cell = lr.getCell(phiID, zID);
+  rval.meanRho = cell.meanRho;
+  rval.meanX2X0 = cell.meanX2X0 * ray.getDist();
+  rval.length = ray.getDist();
+  return true;
+}
+
+//_________________________________________________________________________________________________
+GPUd() MatBudget MatLayerCylSet::getMatBudget(Ray& ray, short lmin, short lmax) const
+{
+  // get material budget traversed by the ray in the layers lmin to lmax
+  MatBudget rval;
+  if (lmin == lmax) { // the ray stays most probably in a single cell
+    float rmin2, rmax2;
+    ray.getMinMaxR2(rmin2, rmax2);
+    if (getMatBudgetSingleCell(ray, rmin2, rmax2, lmin, rval)) {
+      return rval;
+    }
+  }
   short lrID = lmax;
   while (lrID >= lmin) { // go from outside to inside
     const auto& lr = getLayer(lrID);
@@ -171,6 +171,7 @@ GPUd() bool PropagatorImpl<value_T>::PropagateToXBxByBz(TrackParCov_t& track, va
   }
 
   gpu::gpustd::array<value_type, 3> b{};
+  MatBudgetCache matCache; // the steps start in the layer in which the previous step has ended
   while (math_utils::detail::abs<value_type>(dx) > Epsilon) {
     auto step = math_utils::detail::min<value_type>(math_utils::detail::abs<value_type>(dx), maxStep);
     if (dir < 0) {
@@ -180,11 +181,11 @@ GPUd() bool PropagatorImpl<value_T>::PropagateToXBxByBz(TrackParCov_t& track, va
     auto xyz0 = track.getXYZGlo();
     getFieldXYZ(xyz0, &b[0]);
 
-    auto correct = [&track, &xyz0, tofInfo, matCorr, signCorr, this]() {
+    auto correct = [&track, &xyz0, &matCache, tofInfo, matCorr, signCorr, this]() {
       bool res = true;
       if (matCorr != MatCorrType::USEMatCorrNONE) {
         auto xyz1 = track.getXYZGlo();
-        auto mb = this->getMatBudget(matCorr, xyz0, xyz1);
+        auto mb = this->getMatBudget(matCorr, xyz0, xyz1, &matCache);
         if (!track.correctForMaterial(mb.meanX2X0, mb.getXRho(signCorr))) {
           res = false;
         }
@@ -240,6 +241,7 @@ GPUd() bool PropagatorImpl<value_T>::PropagateToXBxByBz(TrackPar_t& track, value
   }
 
   gpu::gpustd::array<value_type, 3> b{};
+  MatBudgetCache matCache; // the steps start in the layer in which the previous step has ended
   while (math_utils::detail::abs<value_type>(dx) > Epsilon) {
     auto step = math_utils::detail::min<value_type>(math_utils::detail::abs<value_type>(dx), maxStep);
     if (dir < 0) {
@@ -249,11 +251,11 @@ GPUd() bool PropagatorImpl<value_T>::PropagateToXBxByBz(TrackPar_t& track, value
     auto xyz0 = track.getXYZGlo();
     getFieldXYZ(xyz0, &b[0]);
 
-    auto correct = [&track, &xyz0, tofInfo, matCorr, signCorr, this]() {
+    auto correct = [&track, &xyz0, &matCache, tofInfo, matCorr, signCorr, this]() {
       bool res = true;
       if (matCorr != MatCorrType::USEMatCorrNONE) {
         auto xyz1 = track.getXYZGlo();
-        auto mb = this->getMatBudget(matCorr, xyz0, xyz1);
+        auto mb = this->getMatBudget(matCorr, xyz0, xyz1, &matCache);
         if (!track.correctForELoss(((signCorr < 0) ? -mb.length : mb.length) * mb.meanRho)) {
           res = false;
         }
@@ -308,6 +310,7 @@ GPUd() bool PropagatorImpl<value_T>::propagateToX(TrackParCov_t& track, value_ty
     signCorr = -dir; // sign of eloss correction is not imposed
   }
 
+  MatBudgetCache matCache; // the steps start in the layer in which the previous step has ended
   while (math_utils::detail::abs<value_type>(dx) > Epsilon) {
     auto step = math_utils::detail::min<value_type>(math_utils::detail::abs<value_type>(dx), maxStep);
     if (dir < 0) {
@@ -315,11 +318,11 @@ GPUd() bool PropagatorImpl<value_T>::propagateToX(TrackParCov_t& track, value_ty
     }
     auto x = track.getX() + step;
     auto xyz0 = track.getXYZGlo();
-    auto correct = [&track, &xyz0, tofInfo, matCorr, signCorr, this]() {
+    auto correct = [&track, &xyz0, &matCache, tofInfo, matCorr, signCorr, this]() {
       bool res = true;
       if (matCorr != MatCorrType::USEMatCorrNONE) {
         auto xyz1 = track.getXYZGlo();
-        auto mb = this->getMatBudget(matCorr, xyz0, xyz1);
+        auto mb = this->getMatBudget(matCorr, xyz0, xyz1, &matCache);
         if (!track.correctForMaterial(mb.meanX2X0, mb.getXRho(signCorr))) {
           res = false;
         }
@@ -373,6 +376,7 @@ GPUd() bool PropagatorImpl<value_T>::propagateToX(TrackPar_t& track, value_type
     signCorr = -dir; // sign of eloss correction is not imposed
   }
 
+  MatBudgetCache matCache; // the steps start in the layer in which the previous step has ended
   while (math_utils::detail::abs<value_type>(dx) > Epsilon) {
     auto step = math_utils::detail::min<value_type>(math_utils::detail::abs<value_type>(dx), maxStep);
     if (dir < 0) {
@@ -381,11 +385,11 @@ GPUd() bool PropagatorImpl<value_T>::propagateToX(TrackPar_t& track, value_type
     auto x = track.getX() + step;
     auto xyz0 = track.getXYZGlo();
 
-    auto correct = [&track, &xyz0, tofInfo, matCorr, signCorr, this]() {
+    auto correct = [&track, &xyz0, &matCache, tofInfo, matCorr, signCorr, this]() {
       bool res = true;
       if (matCorr != MatCorrType::USEMatCorrNONE) {
         auto xyz1 = track.getXYZGlo();
-        auto mb = this->getMatBudget(matCorr, xyz0, xyz1);
+        auto mb = this->getMatBudget(matCorr, xyz0, xyz1, &matCache);
         if (!track.correctForELoss(mb.getXRho(signCorr))) {
           res = false;
         }
@@ -418,6 +422,37 @@ GPUd() bool PropagatorImpl<value_T>::propagateToX(TrackPar_t& track, value_type
   return true;
 }
 
+#if !defined(GPUCA_GPUCODE) && !defined(GPUCA_STANDALONE)
+//_______________________________________________________________________
+template <typename value_T>
+template <typename track_T>
+int PropagatorImpl<value_T>::propagateAllTo(gsl::span<track_T> tracks, value_type x, bool bzOnly, value_type maxSnp, value_type maxStep,
+                                            MatCorrType matCorr, gsl::span<uint8_t> status, int signCorr) const
+{
+  // propagate a batch of tracks to the same X
+  if (status.size() && status.size() != tracks.size()) {
+    throw std::runtime_error("size of the status span differs from the number of tracks");
+  }
+  // resolve the material source once instead of at every step of every track
+  if (matCorr == MatCorrType::USEMatCorrLUT && !mMatLUT) {
+    if (!mTGeoFallBackAllowed) {
+      throw std::runtime_error("requested MatLUT is absent and fall-back to TGeo is disabled");
+    }
+    matCorr = MatCorrType::USEMatCorrTGeo;
+  }
+  const value_type bZ = getNominalBz();
+  int nOK = 0;
+  for (size_t i = 0; i < tracks.size(); i++) {
+    bool res = bzOnly ? propagateToX(tracks[i], x, bZ, maxSnp, maxStep, matCorr, nullptr, signCorr) : PropagateToXBxByBz(tracks[i], x, maxSnp, maxStep, matCorr, nullptr, signCorr);
+    if (status.size()) {
+      status[i] = res;
+    }
+    nOK += res;
+  }
+  return nOK;
+}
+#endif
+
 //_______________________________________________________________________
 template <typename value_T>
 template <typename track_T>
@@ -723,7 +758,7 @@ GPUd() value_T PropagatorImpl<value_T>::estimateLTFast(o2::track::TrackLTIntegra
 
 //____________________________________________________________
 template <typename value_T>
-GPUd() MatBudget PropagatorImpl<value_T>::getMatBudget(PropagatorImpl<value_type>::MatCorrType corrType, const math_utils::Point3D<value_type>& p0, const math_utils::Point3D<value_type>& p1) const
+GPUd() MatBudget PropagatorImpl<value_T>::getMatBudget(PropagatorImpl<value_type>::MatCorrType corrType, const math_utils::Point3D<value_type>& p0, const math_utils::Point3D<value_type>& p1, MatBudgetCache* cache) const
 {
 #if !defined(GPUCA_STANDALONE) && !defined(GPUCA_GPUCODE)
   if (corrType == MatCorrType::USEMatCorrTGeo) {
@@ -737,6 +772,9 @@ GPUd() MatBudget PropagatorImpl<value_T>::getMatBudget(PropagatorImpl<value_type
     }
   }
 #endif
+  if (cache) {
+    return mMatLUT->getMatBudget(p0.X(), p0.Y(), p0.Z(), p1.X(), p1.Y(), p1.Z(), *cache);
+  }
   return mMatLUT->getMatBudget(p0.X(), p0.Y(), p0.Z(), p1.X(), p1.Y(), p1.Z());
 }
 
@@ -798,4 +836,10 @@ template bool PropagatorImpl<double>::propagateToAlphaX<PropagatorImpl<double>::
 template bool PropagatorImpl<double>::propagateToAlphaX<PropagatorImpl<double>::TrackParCov_t>(PropagatorImpl<double>::TrackParCov_t&, double, double, bool, double, double, int, PropagatorImpl<double>::MatCorrType matCorr, track::TrackLTIntegral*, int) const;
 #endif
 #endif
+#if !defined(GPUCA_GPUCODE) && !defined(GPUCA_STANDALONE)
+template int PropagatorImpl<float>::propagateAllTo<PropagatorImpl<float>::TrackPar_t>(gsl::span<PropagatorImpl<float>::TrackPar_t>, float, bool, float, float, PropagatorImpl<float>::MatCorrType, gsl::span<uint8_t>, int) const;
+template int PropagatorImpl<float>::propagateAllTo<PropagatorImpl<float>::TrackParCov_t>(gsl::span<PropagatorImpl<float>::TrackParCov_t>, float, bool, float, float, PropagatorImpl<float>::MatCorrType, gsl::span<uint8_t>, int) const;
+template int PropagatorImpl<double>::propagateAllTo<PropagatorImpl<double>::TrackPar_t>(gsl::span<PropagatorImpl<double>::TrackPar_t>, double, bool, double, double, PropagatorImpl<double>::MatCorrType, gsl::span<uint8_t>, int) const;
+template int PropagatorImpl<double>::propagateAllTo<PropagatorImpl<double>::TrackParCov_t>(gsl::span<PropagatorImpl<double>::TrackParCov_t>, double, bool, double, double, PropagatorImpl<double>::MatCorrType, gsl::span<uint8_t>, int) const;
+#endif
 } // namespace o2::base
@@ -427,13 +427,15 @@ void Stack::FinishPrimary()
   // loop over current particle buffer
   // - build index map indicesKept
   // - update mother index information
-  int indexOld = 0;
-  int indexNew = 0;
   int indexoffset = mTracks->size();
   int neglected = 0;
-  std::vector<int> indicesKept((int)(mParticles.size()));
-  std::vector<MCTrack> tmpTracks;
-  Int_t ic = 0;
+  // the kept particles are compacted by reference: indicesKept is the running count (prefix sum)
+  // of the kept particles and keptEntries their entries in mParticles, so nothing is copied
+  // before the final emplace into mTracks. The buffers are members to reuse their memory.
+  auto& indicesKept = mIndicesKept;
+  auto& keptEntries = mKeptEntries;
+  indicesKept.resize(mParticles.size());
+  keptEntries.clear();
 
   // mTrackIDtoParticlesEntry
   // trackID to mTrack -> index in mParticles
@@ -445,7 +447,8 @@ void Stack::FinishPrimary()
   // old (mTrack-highWaterMark) -> new (mTrack-highWaterMark)
   //
 
-  for (auto& particle : mParticles) {
+  for (int indexOld = 0; indexOld < (int)mParticles.size(); indexOld++) {
+    auto& particle = mParticles[indexOld];
     if (particle.getStore() || !mPruneKinematics) {
       // map the global track index to the new persistent index
       auto imother = particle.getMotherTrackId();
@@ -457,34 +460,35 @@ void Stack::FinishPrimary()
       }
       // at this point we have the correct mother index in mParticles or
       // a negative one which is a pointer to a primary
-      tmpTracks.emplace_back(particle);
-      indicesKept[indexOld] = indexNew;
-      indexNew++;
+      indicesKept[indexOld] = keptEntries.size();
+      keptEntries.push_back(indexOld);
     } else {
       indicesKept[indexOld] = -1;
       neglected++;
     }
-    indexOld++;
     mTracksDone++;
   }
-  Int_t ntr = (int)(tmpTracks.size());
-  std::vector<int> reOrderedIndices(ntr);
-  std::vector<int> invreOrderedIndices(ntr);
+  Int_t ntr = (int)(keptEntries.size());
+  auto& reOrderedIndices = mReOrderedIndices;
+  auto& invreOrderedIndices = mInvReOrderedIndices;
+  reOrderedIndices.resize(ntr);
+  invreOrderedIndices.resize(ntr);
   for (Int_t i = 0; i < ntr; i++) {
     invreOrderedIndices[i] = i;
     reOrderedIndices[i] = i;
   }
 
   if (mIsG4Like) {
-    ReorderKine(tmpTracks, reOrderedIndices);
+    ReorderKine(keptEntries, reOrderedIndices);
     for (Int_t i = 0; i < ntr; i++) {
       Int_t index = reOrderedIndices[i];
       invreOrderedIndices[index] = i;
     }
   }
+  mTracks->reserve(mTracks->size() + ntr);
   for (Int_t i = 0; i < ntr; i++) {
     Int_t index = reOrderedIndices[i];
-    auto& particle = tmpTracks[index];
+    auto& particle = mParticles[keptEntries[index]];
     Int_t imo = particle.getMotherTrackId();
     Int_t imo0 = imo;
     if (imo >= 0) {
@@ -518,8 +522,8 @@ void Stack::FinishPrimary()
   // we can now clear the particles buffer!
   reOrderedIndices.clear();
   invreOrderedIndices.clear();
+  keptEntries.clear();
   mParticles.clear();
-  tmpTracks.clear();
   mTransportedIDs.clear();
   mTrackIDtoParticlesEntry.clear();
   mIndexOfPrimaries.clear();
@@ -861,7 +865,7 @@ void Stack::fillParentIDs(std::vector<int>& parentids) const
   } while (mother != -1);
 }
 
-void Stack::ReorderKine(std::vector<MCTrack>& particles, std::vector<int>& reOrderedIndices)
+void Stack::ReorderKine(std::vector<int> const& keptEntries, std::vector<int>& reOrderedIndices)
 {
   //
   // Particles are ordered in a way that descendants of a particle appear next to each other.
@@ -869,40 +873,64 @@ void Stack::ReorderKine(std::vector<MCTrack>& particles, std::vector<int>& reOrd
   // for example the index of the first and last descentant.
   // The result of the ordering is returned via the look-up table reOrderedIndices
   //
+  // The daughters of every particle are laid out contiguously (in increasing order) with a
+  // prefix sum over their number, which makes the ordering linear in the number of particles.
+  //
 
-  Int_t ntr = (int)(particles.size());
-  std::vector<bool> done(ntr, false);
-
+  Int_t ntr = (int)(keptEntries.size());
   int indexoffset = mTracks->size();
-  Int_t index = 0;
-  Int_t imoOld = 0;
-  for (Int_t i = 0; i < ntr; i++) {
-    reOrderedIndices[i] = i;
+  const int currentPrimary = mIndexOfCurrentPrimary - indexoffset;
+  auto motherOf = [this, &keptEntries](int j) { return mParticles[keptEntries[j]].getMotherTrackId(); };
+  // slot 0 holds the daughters of the current primary, slot i + 1 those of particle i
+  auto slotOf = [currentPrimary](int j, int mother) {
+    if (mother == currentPrimary) {
+      return 0;
+    }
+    return (mother >= 0 && mother < j) ? mother + 1 : -1;
+  };
+
+  auto& offsets = mReorderOffsets;
+  auto& daughters = mReorderDaughters;
+  auto& cursor = mReorderCursor;
+  offsets.assign(ntr + 2, 0);
+  for (Int_t j = 0; j < ntr; j++) {
+    auto slot = slotOf(j, motherOf(j));
+    if (slot >= 0) {
+      offsets[slot + 1]++;
+    }
+  }
+  for (Int_t slot = 1; slot < ntr + 2; slot++) {
+    offsets[slot] += offsets[slot - 1];
+  }
+  daughters.resize(offsets[ntr + 1]);
+  cursor.assign(offsets.begin(), offsets.end());
+  for (Int_t j = 0; j < ntr; j++) {
+    auto slot = slotOf(j, motherOf(j));
+    if (slot >= 0) {
+      daughters[cursor[slot]++] = j;
+    }
   }
 
+  auto& done = mReorderDone;
+  done.assign(ntr, false);
+  Int_t index = 0;
   for (Int_t i = -1; i < ntr; i++) {
-    if (i != -1) {
+    if (i != -1 && !done[i]) {
       // secondaries
-      if (!done[i]) {
-        reOrderedIndices[index] = i;
-        index++;
-        done[i] = true;
-      }
-      imoOld = i;
-    } else {
-      // current primary
-      imoOld = mIndexOfCurrentPrimary - indexoffset;
+      reOrderedIndices[index] = i;
+      index++;
+      done[i] = true;
     }
-    for (Int_t j = i + 1; j < ntr; j++) {
+    // daughters of the current primary (i == -1) or of the secondary i
+    for (int k = offsets[i + 1]; k < offsets[i + 2]; k++) {
+      auto j = daughters[k];
       if (!done[j]) {
-        if ((particles[j]).getMotherTrackId() == imoOld) {
-          reOrderedIndices[index] = j;
-          index++;
-          done[j] = true;
-        } // child found
-      }   // done
-    }     // j
-  }       // i
+        reOrderedIndices[index] = j;
+        index++;
+        done[j] = true;
+      } // child found
+    }
+  }
 }
 
 FairGenericStack* Stack::CloneStack() const { return new o2::data::Stack(*this); }
@@ -0,0 +1,151 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file   bench_MatBudLUT.cxx
+/// \brief  Benchmark of the material budget queries of the MatLayerCylSet, with and without the layer cache of the tracks
+///
+/// The LUT is read from the file given by the environment variable O2_MATBUD_LUT (default: matbud.root)
+
+#include "benchmark/benchmark.h"
+#include "DetectorsBase/MatLayerCylSet.h"
+#include <TRandom.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+using namespace o2::base;
+
+constexpr int NTracks = 1000;
+constexpr float RMax = 80.f;
+
+const MatLayerCylSet* getLUT()
+{
+  static std::unique_ptr<MatLayerCylSet> lut;
+  if (!lut) {
+    const char* fname = std::getenv("O2_MATBUD_LUT");
+    lut.reset(MatLayerCylSet::loadFromFile(fname ? fname : "matbud.root"));
+  }
+  return lut.get();
+}
+
+// start and end points of the steps of NTracks straight tracks from the origin to RMax, ordered by track
+void generateSteps(float step, std::vector<float>& xyz0, std::vector<float>& xyz1, std::vector<int>& firstStep)
+{
+  gRandom->SetSeed(1);
+  xyz0.clear();
+  xyz1.clear();
+  firstStep.clear();
+  for (int itr = 0; itr < NTracks; itr++) {
+    firstStep.push_back(xyz0.size() / 3);
+    float phi = gRandom->Rndm() * 2.f * M_PI, tgl = gRandom->Uniform(-1.f, 1.f);
+    float dir[3] = {std::cos(phi), std::sin(phi), tgl};
+    for (float r = 0.f; r < RMax; r += step) {
+      for (int i = 0; i < 3; i++) {
+        xyz0.push_back(dir[i] * r);
+        xyz1.push_back(dir[i] * (r + step));
+      }
+    }
+  }
+  firstStep.push_back(xyz0.size() / 3);
+}
+
+static void BM_MatBudget(benchmark::State& state)
+{
+  const auto* lut = getLUT();
+  if (!lut) {
+    state.SkipWithError("material budget LUT is not available");
+    return;
+  }
+  std::vector<float> xyz0, xyz1;
+  std::vector<int> firstStep;
+  generateSteps(state.range(0) * 0.1f, xyz0, xyz1, firstStep);
+  const int nSteps = firstStep.back();
+  float sum = 0.f;
+  for (auto _ : state) {
+    for (int i = 0; i < nSteps; i++) {
+      auto mb = lut->getMatBudget(xyz0[3 * i], xyz0[3 * i + 1], xyz0[3 * i + 2], xyz1[3 * i], xyz1[3 * i + 1], xyz1[3 * i + 2]);
+      sum += mb.meanX2X0;
+    }
+  }
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations() * nSteps);
+}
+
+static void BM_MatBudgetCached(benchmark::State& state)
+{
+  const auto* lut = getLUT();
+  if (!lut) {
+    state.SkipWithError("material budget LUT is not available");
+    return;
+  }
+  std::vector<float> xyz0, xyz1;
+  std::vector<int> firstStep;
+  generateSteps(state.range(0) * 0.1f, xyz0, xyz1, firstStep);
+  const int nSteps = firstStep.back();
+  float sum = 0.f;
+  for (auto _ : state) {
+    for (int itr = 0; itr < NTracks; itr++) {
+      MatBudgetCache cache;
+      for (int i = firstStep[itr]; i < firstStep[itr + 1]; i++) {
+        auto mb = lut->getMatBudget(xyz0[3 * i], xyz0[3 * i + 1], xyz0[3 * i + 2], xyz1[3 * i], xyz1[3 * i + 1], xyz1[3 * i + 2], cache);
+        sum += mb.meanX2X0;
+      }
+    }
+  }
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations() * nSteps);
+}
+
+static void BM_MatBudgetBatched(benchmark::State& state)
+{
+  const auto* lut = getLUT();
+  if (!lut) {
+    state.SkipWithError("material budget LUT is not available");
+    return;
+  }
+  std::vector<float> xyz0, xyz1;
+  std::vector<int> firstStep;
+  generateSteps(state.range(0) * 0.1f, xyz0, xyz1, firstStep);
+  const int nSteps = firstStep.back();
+  // the steps with the same index of all tracks form one batch
+  const int nStepsPerTrack = firstStep[1];
+  std::vector<float> batch0(3 * NTracks), batch1(3 * NTracks);
+  std::vector<MatBudget> budgets(NTracks);
+  std::vector<MatBudgetCache> caches(NTracks);
+  float sum = 0.f;
+  for (auto _ : state) {
+    std::fill(caches.begin(), caches.end(), MatBudgetCache{});
+    for (int is = 0; is < nStepsPerTrack; is++) {
+      for (int itr = 0; itr < NTracks; itr++) {
+        int i = firstStep[itr] + is;
+        for (int j = 0; j < 3; j++) {
+          batch0[3 * itr + j] = xyz0[3 * i + j];
+          batch1[3 * itr + j] = xyz1[3 * i + j];
+        }
+      }
+      lut->getMatBudget(NTracks, batch0.data(), batch1.data(), budgets.data(), caches.data());
+      for (const auto& mb : budgets) {
+        sum += mb.meanX2X0;
+      }
+    }
+  }
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations() * nSteps);
+}
+
+// step length in mm
+BENCHMARK(BM_MatBudget)->Arg(5)->Arg(20)->Arg(100);
+BENCHMARK(BM_MatBudgetCached)->Arg(5)->Arg(20)->Arg(100);
+BENCHMARK(BM_MatBudgetBatched)->Arg(5)->Arg(20)->Arg(100);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,90 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test FastSimRegion
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "DetectorsBase/FastSimRegion.h"
+
+using namespace o2::base;
+
+namespace
+{
+struct CountingModel : public FastSimShowerModel {
+  int calls = 0;
+  bool simulate(FastSimParticle const&) override
+  {
+    calls++;
+    return true;
+  }
+};
+} // namespace
+
+BOOST_AUTO_TEST_CASE(FastSimRegistry_test)
+{
+  auto& registry = FastSimRegistry::instance();
+  registry.clear();
+  BOOST_CHECK(registry.empty());
+
+  auto photons = std::make_shared<CountingModel>();
+  auto others = std::make_shared<CountingModel>();
+  registry.addModel(10, 22, photons);
+  registry.addModel(10, 0, others);
+  registry.addModel(11, 11, photons);
+
+  BOOST_CHECK(!registry.empty());
+  BOOST_CHECK(registry.findModel(10, 22) == photons.get());
+  BOOST_CHECK(registry.findModel(10, 211) == others.get()); // fallback to the model for all particles
+  BOOST_CHECK(registry.findModel(11, 11) == photons.get());
+  BOOST_CHECK(registry.findModel(11, 22) == nullptr);
+  BOOST_CHECK(registry.findModel(12, 22) == nullptr);
+  registry.clear();
+}
+
+// energy response of the parametrized shower in a PbWO4-like calorimeter
+BOOST_AUTO_TEST_CASE(ParametrizedShower_response)
+{
+  float sum = 0.f;
+  float sumZ = 0.f;
+  int nDeposits = 0;
+  auto deposit = [&](FastSimParticle const&, float, float, float z, float edep, float) {
+    sum += edep;
+    sumZ += z * edep;
+    nDeposits++;
+  };
+  const float radLength = 0.89, criticalEnergy = 9.3e-3, depth = 20.;
+  ParametrizedShowerModel model(deposit, radLength, criticalEnergy, 2.f, depth);
+
+  float lastMeanZ = 0.f;
+  for (float e : {0.5f, 2.f, 10.f, 50.f}) {
+    sum = sumZ = 0.f;
+    nDeposits = 0;
+    FastSimParticle particle;
+    particle.pdg = 22;
+    particle.pz = particle.e = e;
+    BOOST_CHECK(model.simulate(particle));
+    BOOST_CHECK(nDeposits > 0);
+    // the shower is contained up to the leakage beyond the depth of the calorimeter
+    const float contained = model.longitudinalFraction(e, 0., depth);
+    BOOST_CHECK_CLOSE(sum, e * contained, 0.1);
+    BOOST_CHECK(contained > 0.9);
+    BOOST_CHECK(contained <= 1.);
+    // and its mean depth grows with the energy
+    const float meanZ = sumZ / sum;
+    BOOST_CHECK(meanZ > lastMeanZ);
+    lastMeanZ = meanZ;
+  }
+
+  // no deposits for a particle at rest
+  FastSimParticle particle;
+  BOOST_CHECK(!model.simulate(particle));
+}
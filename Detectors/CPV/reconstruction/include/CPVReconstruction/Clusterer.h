@@ -47,7 +47,7 @@ class Clusterer
 
   void makeUnfoldingsAndCalibDigits(gsl::span<const Digit> digits, std::vector<Digit>* calibDigits); // Find and unfold clusters with few local maxima
   void makeCalibDigits(std::vector<Digit>* calibDigits);                                             // Find clusters with 1 local maximum and make calibDigits using them
-  void unfoldOneCluster(FullCluster& iniClu, char nMax, gsl::span<int> digitId, gsl::span<const Digit> digits);
+  void unfoldOneCluster(int iniCluIndex, char nMax, gsl::span<int> digitId, gsl::span<const Digit> digits);
 
  protected:
   static constexpr short NLMMax = 10; ///< maximal number of local maxima in cluster
@@ -55,11 +55,14 @@ class Clusterer
   bool mRunMC = false;                ///< Process MC info
   int mFirstDigitInEvent;             ///< Range of digits from one event
   int mLastDigitInEvent;              ///< Range of digits from one event
-  std::vector<FullCluster> mClusters; ///< internal vector of clusters
-  std::vector<Digit> mDigits;         ///< vector of transient digits for cell processing
+  std::vector<FullCluster> mClusters;                ///< internal vector of clusters
+  std::vector<FullCluster::CluElement> mCluElements; ///< digits of all clusters of the event, clusters refer to ranges of it
+  std::vector<Digit> mDigits;                        ///< vector of transient digits for cell processing
 
-  std::vector<std::vector<float>> meInClusters = std::vector<std::vector<float>>(10, std::vector<float>(NLMMax));
-  std::vector<std::vector<float>> mfij = std::vector<std::vector<float>>(10, std::vector<float>(NLMMax));
+  // workspaces reused for all clusters, the capacity is kept between events
+  std::vector<float> meInClusters; ///< energy of digits in unfolded clusters, NLMMax entries per digit
+  std::vector<float> mfij;         ///< shower shape of unfolded clusters at digits, NLMMax entries per digit
+  std::vector<bool> mIsLocalMax;   ///< local maxima flags of the digits of a cluster
 };
 } // namespace cpv
 } // namespace o2
@@ -16,6 +16,8 @@
 #include "DataFormatsCPV/Digit.h"
 #include "DataFormatsCPV/Cluster.h"
 #include "SimulationDataFormat/MCCompLabel.h"
+#include <gsl/span>
+#include <vector>
 
 namespace o2
 {
@@ -23,6 +25,9 @@ namespace cpv
 {
 /// \class FullCluster
 /// \brief CPV cluster implementation
+///
+/// The digits of the cluster are kept as a contiguous range of an element storage shared by all
+/// clusters of the event. Digits can only be added to the cluster at the end of the storage.
 
 class FullCluster : public Cluster
 {
@@ -40,7 +45,9 @@ class FullCluster : public Cluster
   };
 
   FullCluster() = default;
-  FullCluster(short digitAbsId, float energy, int label);
+  /// \brief Empty cluster with digits stored in elements
+  explicit FullCluster(std::vector<CluElement>* elements) : mElements(elements), mFirstElement(elements->size()) {}
+  FullCluster(std::vector<CluElement>* elements, short digitAbsId, float energy, int label);
 
   ~FullCluster() = default;
 
@@ -51,12 +58,15 @@ class FullCluster : public Cluster
   void evalAll();
 
   // Get index of a digit with i
-  short getDigitAbsId(Int_t i) const { return mElementList.at(i).absId; }
+  short getDigitAbsId(Int_t i) const { return (*mElements)[mFirstElement + i].absId; }
 
-  const std::vector<CluElement>* getElementList() const { return &mElementList; }
+  gsl::span<const CluElement> getElementList() const { return {mElements->data() + mFirstElement, static_cast<size_t>(mNElements)}; }
 
-  // Counts local maxima and returns their positions
-  char getNumberOfLocalMax(gsl::span<int> maxAt) const;
+  /// \return index of the first digit of the cluster in the element storage
+  int getFirstElement() const { return mFirstElement; }
+
+  // Counts local maxima and returns their positions, isLocalMax is a workspace
+  char getNumberOfLocalMax(gsl::span<int> maxAt, std::vector<bool>& isLocalMax) const;
 
   void purify(); // Removes digits below threshold
 
@@ -64,7 +74,9 @@ class FullCluster : public Cluster
   void evalLocalPosition(); // computes the position in the CPV module
 
  private:
-  std::vector<CluElement> mElementList; //!  Transient Array of digits
+  std::vector<CluElement>* mElements = nullptr; //!  Transient storage of digits, not owned
+  int mFirstElement = 0;                        //!  First digit of this cluster in mElements
+  int mNElements = 0;                           //!  Number of digits of this cluster
 
   ClassDefNV(FullCluster, 1);
 };
@@ -55,6 +55,7 @@ void Clusterer::process(gsl::span<const Digit> digits, gsl::span<const TriggerRe
     mLastDigitInEvent = mFirstDigitInEvent + tr.getNumberOfObjects();
     int indexStart = clusters->size();
     mClusters.clear(); // internal list of FullClusters
+    mCluElements.clear();
 
     LOG(debug) << "Starting clusteriztion digits from " << mFirstDigitInEvent << " to " << mLastDigitInEvent;
 
@@ -107,7 +108,7 @@ void Clusterer::makeClusters(gsl::span<const Digit> digits)
       continue;
     }
     // start new cluster
-    mClusters.emplace_back(digitSeed.getAbsId(), digitSeedEnergy, digitSeed.getLabel());
+    mClusters.emplace_back(&mCluElements, digitSeed.getAbsId(), digitSeedEnergy, digitSeed.getLabel());
     FullCluster& clu = mClusters.back();
     digitsUsed.set(i - mFirstDigitInEvent, true);
     int iDigitInCluster = 1;
@@ -155,11 +156,11 @@ void Clusterer::makeCalibDigits(std::vector<Digit>* calibDigits)
 {
   std::array<int, NLMMax> maxAt; // NLMMax:Maximal number of local maxima
   for (auto& clu : mClusters) {
-    if (clu.getNumberOfLocalMax(maxAt) == 1) { // cluster with only one local maximum
+    if (clu.getNumberOfLocalMax(maxAt, mIsLocalMax) == 1) { // cluster with only one local maximum
                                                // and appropriate size
       if ((o2::cpv::CPVCalibParams::Instance().gainMinClusterMultForCalib <= clu.getMultiplicity()) &&
           (o2::cpv::CPVCalibParams::Instance().gainMaxClusterMultForCalib >= clu.getMultiplicity())) {
-        const FullCluster::CluElement& maxElement = clu.getElementList()->at(maxAt[0]);
+        const FullCluster::CluElement& maxElement = clu.getElementList()[maxAt[0]];
         calibDigits->emplace_back(maxElement.absId, maxElement.energy, maxElement.label);
       }
     }
@@ -180,39 +181,39 @@ void Clusterer::makeUnfoldingsAndCalibDigits(gsl::span<const Digit> digits, std:
       continue;
     }
     //     char nMultipl = clu.getMultiplicity();
-    char nMax = clu.getNumberOfLocalMax(maxAt);
+    char nMax = clu.getNumberOfLocalMax(maxAt, mIsLocalMax);
     if (nMax > 1) {
-      unfoldOneCluster(clu, nMax, maxAt, digits);
-      clu.setEnergy(0); // will be skipped later
+      unfoldOneCluster(i, nMax, maxAt, digits);
+      mClusters[i].setEnergy(0); // will be skipped later, clu may be invalidated by the new clusters
     } else {
       clu.setNExMax(nMax); // Only one local maximum
       // make calib digits from cluster with only one local maximum and appropriate size
       if ((o2::cpv::CPVCalibParams::Instance().gainMinClusterMultForCalib <= clu.getMultiplicity()) &&
           (o2::cpv::CPVCalibParams::Instance().gainMaxClusterMultForCalib >= clu.getMultiplicity())) {
-        const FullCluster::CluElement& maxElement = clu.getElementList()->at(maxAt[0]);
+        const FullCluster::CluElement& maxElement = clu.getElementList()[maxAt[0]];
         calibDigits->emplace_back(maxElement.absId, maxElement.energy, maxElement.label);
       }
     }
   }
 }
 //____________________________________________________________________________
-void Clusterer::unfoldOneCluster(FullCluster& iniClu, char nMax, gsl::span<int> digitId, gsl::span<const Digit> digits)
+void Clusterer::unfoldOneCluster(int iniCluIndex, char nMax, gsl::span<int> digitId, gsl::span<const Digit> digits)
 {
   // Performs the unfolding of a cluster with nMax overlapping showers
-  // Parameters: iniClu cluster to be unfolded
+  // Parameters: iniCluIndex index of the cluster to be unfolded
   //             nMax number of local maxima found (this is the number of new clusters)
   //             digitId: index of digits, corresponding to local maxima
   //             maxAtEnergy: energies of digits, corresponding to local maxima
 
   // Take initial cluster and calculate local coordinates of digits
   // To avoid multiple re-calculation of same parameters
+  // The digits of the initial cluster are accessed by index as the new clusters may reallocate the storage
+  const FullCluster& iniClu = mClusters[iniCluIndex];
   char mult = iniClu.getMultiplicity();
-  if (meInClusters.capacity() < static_cast<unsigned int>(mult)) {
-    meInClusters.reserve(mult);
-    mfij.reserve(mult);
-  }
-
-  const std::vector<FullCluster::CluElement>* cluElist = iniClu.getElementList();
+  const int firstElement = iniClu.getFirstElement();
+  meInClusters.resize(mult * NLMMax);
+  mfij.resize(mult * NLMMax);
+  auto cluElement = [this, firstElement](int idig) -> const FullCluster::CluElement& { return mCluElements[firstElement + idig]; };
 
   // Coordinates of centers of clusters
   std::array<float, NLMMax> xMax;
@@ -225,9 +226,9 @@ void Clusterer::unfoldOneCluster(FullCluster& iniClu, char nMax, gsl::span<int>
   std::array<float, NLMMax> c;
 
   for (int iclu = 0; iclu < nMax; iclu++) {
-    xMax[iclu] = (*cluElist)[digitId[iclu]].localX;
-    zMax[iclu] = (*cluElist)[digitId[iclu]].localZ;
-    eMax[iclu] = 2. * (*cluElist)[digitId[iclu]].energy;
+    xMax[iclu] = cluElement(digitId[iclu]).localX;
+    zMax[iclu] = cluElement(digitId[iclu]).localZ;
+    eMax[iclu] = 2. * cluElement(digitId[iclu]).energy;
   }
 
   std::array<float, NLMMax> prop; // proportion of clusters in the current digit
@@ -242,23 +243,23 @@ void Clusterer::unfoldOneCluster(FullCluster& iniClu, char nMax, gsl::span<int>
     std::memset(&c, 0, sizeof c);
     // First calculate shower shapes
     for (int idig = 0; idig < mult; idig++) {
-      auto it = (*cluElist)[idig];
+      const auto& it = cluElement(idig);
       for (int iclu = 0; iclu < nMax; iclu++) {
-        mfij[idig][iclu] = responseShape(it.localX - xMax[iclu], it.localZ - zMax[iclu]);
+        mfij[idig * NLMMax + iclu] = responseShape(it.localX - xMax[iclu], it.localZ - zMax[iclu]);
       }
     }
 
     // Fit energies
     for (int idig = 0; idig < mult; idig++) {
-      auto it = (*cluElist)[idig];
+      const auto& it = cluElement(idig);
       for (int iclu = 0; iclu < nMax; iclu++) {
-        a[iclu] += mfij[idig][iclu] * mfij[idig][iclu];
-        b[iclu] += it.energy * mfij[idig][iclu];
+        a[iclu] += mfij[idig * NLMMax + iclu] * mfij[idig * NLMMax + iclu];
+        b[iclu] += it.energy * mfij[idig * NLMMax + iclu];
         for (int kclu = 0; kclu < nMax; kclu++) {
           if (iclu == kclu) {
             continue;
           }
-          c[iclu] += eMax[kclu] * mfij[idig][iclu] * mfij[idig][kclu];
+          c[iclu] += eMax[kclu] * mfij[idig * NLMMax + iclu] * mfij[idig * NLMMax + kclu];
         }
       }
     }
@@ -277,7 +278,7 @@ void Clusterer::unfoldOneCluster(FullCluster& iniClu, char nMax, gsl::span<int>
     for (int idig = 0; idig < mult; idig++) {
       float eEstimated = 0;
       for (int iclu = 0; iclu < nMax; iclu++) {
-        prop[iclu] = eMax[iclu] * mfij[idig][iclu];
+        prop[iclu] = eMax[iclu] * mfij[idig * NLMMax + iclu];
         eEstimated += prop[iclu];
       }
       if (eEstimated == 0.) { // numerical accuracy
@@ -285,7 +286,7 @@ void Clusterer::unfoldOneCluster(FullCluster& iniClu, char nMax, gsl::span<int>
       }
       // Split energy of digit according to contributions
       for (int iclu = 0; iclu < nMax; iclu++) {
-        meInClusters[idig][iclu] = (*cluElist)[idig].energy * prop[iclu] / eEstimated;
+        meInClusters[idig * NLMMax + iclu] = cluElement(idig).energy * prop[iclu] / eEstimated;
       }
     }
 
@@ -296,18 +297,18 @@ void Clusterer::unfoldOneCluster(FullCluster& iniClu, char nMax, gsl::span<int>
       // full energy, need for weight
       float eTotNew = 0;
       for (int idig = 0; idig < mult; idig++) {
-        eTotNew += meInClusters[idig][iclu];
+        eTotNew += meInClusters[idig * NLMMax + iclu];
       }
       xMax[iclu] = 0;
       zMax[iclu] = 0.;
       float wtot = 0.;
       for (int idig = 0; idig < mult; idig++) {
-        if (meInClusters[idig][iclu] > 0) {
+        if (meInClusters[idig * NLMMax + iclu] > 0) {
           // In unfolding it is better to use linear weight to reduce contribution of unfolded tails
-          float w = meInClusters[idig][iclu] / eTotNew;
+          float w = meInClusters[idig * NLMMax + iclu] / eTotNew;
           // float w = std::max(std::log(eInClusters[idig][iclu] / eTotNew) + o2::cpv::CPVSimParams::Instance().mLogWeight, float(0.));
-          xMax[iclu] += (*cluElist)[idig].localX * w;
-          zMax[iclu] += (*cluElist)[idig].localZ * w;
+          xMax[iclu] += cluElement(idig).localX * w;
+          zMax[iclu] += cluElement(idig).localZ * w;
           wtot += w;
         }
       }
@@ -324,16 +325,17 @@ void Clusterer::unfoldOneCluster(FullCluster& iniClu, char nMax, gsl::span<int>
   }
   // Iterations finished, add new clusters
   for (int iclu = 0; iclu < nMax; iclu++) {
-    mClusters.emplace_back();
+    mClusters.emplace_back(&mCluElements);
     FullCluster& clu = mClusters.back();
     clu.setNExMax(nMax);
     for (int idig = 0; idig < mult; idig++) {
-      float eDigit = meInClusters[idig][iclu];
-      idig++;
+      float eDigit = meInClusters[idig * NLMMax + iclu];
       if (eDigit < o2::cpv::CPVSimParams::Instance().mDigitMinEnergy) {
         continue;
       }
-      clu.addDigit((*cluElist)[idig].absId, eDigit, (*cluElist)[idig].label);
+      const short absId = cluElement(idig).absId;
+      const int label = cluElement(idig).label;
+      clu.addDigit(absId, eDigit, label);
     }
   }
 }
@@ -374,9 +376,9 @@ void Clusterer::evalCluProperties(gsl::span<const Digit> digits, std::vector<Clu
       if (mRunMC) { // Handle labels
         // Calculate list of primaries
         // loop over entries in digit MCTruthContainer
-        const std::vector<FullCluster::CluElement>* vl = clu->getElementList();
-        auto ll = vl->begin();
-        while (ll != vl->end()) {
+        const auto vl = clu->getElementList();
+        auto ll = vl.begin();
+        while (ll != vl.end()) {
           int i = (*ll).label; // index
           if (i < 0) {
             ++ll;
@@ -15,13 +15,14 @@
 #include "CPVBase/CPVSimParams.h"
 
 #include <fairlogger/Logger.h> // for LOG
+#include <algorithm>
 
 using namespace o2::cpv;
 
 ClassImp(FullCluster);
 
-FullCluster::FullCluster(short digitAbsId, float energy, int label)
-  : Cluster()
+FullCluster::FullCluster(std::vector<CluElement>* elements, short digitAbsId, float energy, int label)
+  : Cluster(), mElements(elements), mFirstElement(elements->size())
 {
   addDigit(digitAbsId, energy, label);
 }
@@ -34,7 +35,8 @@ void FullCluster::addDigit(short digitIndex, float energy, int label)
   float x = 0., z = 0.;
   Geometry::absIdToRelPosInModule(digitIndex, x, z);
 
-  mElementList.emplace_back(digitIndex, energy, x, z, label);
+  mElements->emplace_back(digitIndex, energy, x, z, label);
+  mNElements++;
   mEnergy += energy; // To be updated when calculate cluster properties.
   mMulDigit++;
 }
@@ -52,16 +54,13 @@ void FullCluster::purify()
 
   float threshold = o2::cpv::CPVSimParams::Instance().mDigitMinEnergy;
 
-  std::vector<CluElement>::iterator itEl = mElementList.begin();
-  while (itEl != mElementList.end()) {
-    if ((*itEl).energy < threshold) { // very rare case
-      itEl = mElementList.erase(itEl);
-    } else {
-      ++itEl;
-    }
-  }
+  // digits are removed by compacting the range of the cluster, the storage itself is not modified
+  auto first = mElements->begin() + mFirstElement;
+  auto last = first + mNElements;
+  last = std::remove_if(first, last, [threshold](const CluElement& el) { return el.energy < threshold; }); // very rare case
+  mNElements = last - first;
 
-  mMulDigit = mElementList.size();
+  mMulDigit = mNElements;
 
   if (mMulDigit == 0) { // too soft cluster
     mEnergy = 0.;
@@ -71,10 +70,10 @@ void FullCluster::purify()
   // Remove non-connected cells
   if (mMulDigit > 1) {
     mEnergy = 0.; // Recalculate total energy
-    auto it = mElementList.begin();
-    while (it != mElementList.end()) {
+    auto it = first;
+    while (it != last) {
       bool hasNeighbours = false;
-      for (auto jt = mElementList.begin(); jt != mElementList.end(); ++jt) {
+      for (auto jt = first; jt != last; ++jt) {
         if (it == jt) {
           continue;
         }
@@ -84,7 +83,8 @@ void FullCluster::purify()
         }
       }
       if (!hasNeighbours) { // Isolated digits are rare
-        it = mElementList.erase(it);
+        last = std::move(it + 1, last, it);
+        --mNElements;
         --mMulDigit;
       } else {
         mEnergy += (*it).energy;
@@ -92,7 +92,7 @@ void FullCluster::purify()
       }
     }
   } else {
-    mEnergy = mElementList[0].energy;
+    mEnergy = first->energy;
   }
 }
 //____________________________________________________________________________
@@ -109,13 +109,13 @@ void FullCluster::evalLocalPosition()
   }
 
   // find module number
-  mModule = Geometry::absIdToModule(mElementList[0].absId);
+  mModule = Geometry::absIdToModule((*mElements)[mFirstElement].absId);
 
   float wtot = 0.;
   mLocalPosX = 0.;
   mLocalPosZ = 0.;
   float invE = 1. / mEnergy;
-  for (auto it : mElementList) {
+  for (const auto& it : getElementList()) {
     float w = std::max(float(0.), o2::cpv::CPVSimParams::Instance().mLogWeight + std::log(it.energy * invE));
     mLocalPosX += it.localX * w;
     mLocalPosZ += it.localZ * w;
@@ -129,17 +129,18 @@ void FullCluster::evalLocalPosition()
 }
 
 //____________________________________________________________________________
-char FullCluster::getNumberOfLocalMax(gsl::span<int> maxAt) const
+char FullCluster::getNumberOfLocalMax(gsl::span<int> maxAt, std::vector<bool>& isLocalMax) const
 {
   // Calculates the number of local maxima in the cluster using LocalMaxCut as the minimum
   // energy difference between maximum and surrounding digits
 
   float locMaxCut = o2::cpv::CPVSimParams::Instance().mLocalMaximumCut;
 
-  std::unique_ptr<bool[]> isLocalMax = std::make_unique<bool[]>(mMulDigit);
+  const auto elements = getElementList();
+  isLocalMax.resize(mMulDigit);
 
   for (int i = 0; i < mMulDigit; i++) {
-    if (mElementList[i].energy > o2::cpv::CPVSimParams::Instance().mClusteringThreshold) {
+    if (elements[i].energy > o2::cpv::CPVSimParams::Instance().mClusteringThreshold) {
       isLocalMax[i] = true;
     } else {
       isLocalMax[i] = false;
@@ -149,17 +150,17 @@ char FullCluster::getNumberOfLocalMax(gsl::span<int> maxAt) const
 
     for (int j = i; j--;) {
 
-      if (Geometry::areNeighbours(mElementList[i].absId, mElementList[j].absId) == 1) {
-        if (mElementList[i].energy > mElementList[j].energy) {
+      if (Geometry::areNeighbours(elements[i].absId, elements[j].absId) == 1) {
+        if (elements[i].energy > elements[j].energy) {
           isLocalMax[j] = false;
           // but may be digit too is not local max ?
-          if (mElementList[j].energy > mElementList[i].energy - locMaxCut) {
+          if (elements[j].energy > elements[i].energy - locMaxCut) {
             isLocalMax[i] = false;
           }
         } else {
           isLocalMax[i] = false;
           // but may be digitN is not local max too?
-          if (mElementList[i].energy > mElementList[j].energy - locMaxCut) {
+          if (elements[i].energy > elements[j].energy - locMaxCut) {
             isLocalMax[j] = false;
           }
         }
@@ -0,0 +1,94 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test CTFFlatFile
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#undef NDEBUG
+#include <cassert>
+
+#include <boost/test/unit_test.hpp>
+#include "CTFWorkflow/CTFFlatFile.h"
+#include <TRandom.h>
+#include <filesystem>
+
+using namespace o2::ctf;
+using DetID = o2::detectors::DetID;
+
+void writeAndCheck(const CTFFlatFileWriter::Options& options)
+{
+  const std::string fileName = "test_ctf_flat_file.ctf";
+  const std::vector<DetID> dets{DetID::ITS, DetID::TPC, DetID::CTP};
+  constexpr int NTF = 5;
+  std::vector<std::vector<std::vector<BufferType>>> images(NTF);
+  std::vector<CTFHeader> headers;
+  {
+    CTFFlatFileWriter writer(fileName, options);
+    for (int itf = 0; itf < NTF; itf++) {
+      CTFHeader header{uint64_t(500000 + itf), uint64_t(1650000000000 + itf), uint32_t(itf * 128), uint32_t(itf)};
+      for (auto det : dets) {
+        auto& img = images[itf].emplace_back();
+        if (det == DetID::TPC && itf == 2) { // detector missing in this TF
+          continue;
+        }
+        img.resize(1 + gRandom->Integer(10000));
+        for (auto& b : img) {
+          b = gRandom->Integer(0xff);
+        }
+        writer.addImage(det, img);
+        header.detectors.set(det);
+      }
+      writer.closeEntry(header);
+      headers.push_back(header);
+    }
+    BOOST_CHECK(writer.getNEntries() == NTF);
+  }
+  BOOST_CHECK(CTFFlatFileReader::isFlatFile(fileName));
+
+  CTFFlatFileReader reader(fileName);
+  BOOST_REQUIRE(reader.getNEntries() == NTF);
+  for (int itf = 0; itf < NTF; itf++) {
+    auto header = reader.getHeader(itf);
+    BOOST_CHECK(header.run == headers[itf].run);
+    BOOST_CHECK(header.creationTime == headers[itf].creationTime);
+    BOOST_CHECK(header.firstTForbit == headers[itf].firstTForbit);
+    BOOST_CHECK(header.tfCounter == headers[itf].tfCounter);
+    BOOST_CHECK(header.detectors == headers[itf].detectors);
+    for (size_t id = 0; id < dets.size(); id++) {
+      auto img = reader.getImage(itf, dets[id]);
+      const auto& orig = images[itf][id];
+      BOOST_CHECK(img.size() == orig.size());
+      BOOST_CHECK(std::equal(img.begin(), img.end(), orig.begin()));
+      if (img.size()) {
+        BOOST_CHECK(reinterpret_cast<uintptr_t>(img.data()) % CTFFlatFileHeader::Alignment == 0);
+      }
+    }
+  }
+  std::filesystem::remove(fileName);
+}
+
+BOOST_AUTO_TEST_CASE(CTFFlatFileTest)
+{
+  writeAndCheck({});
+}
+
+BOOST_AUTO_TEST_CASE(CTFFlatFileAsyncTest)
+{
+  for (int mode = 0; mode < 4; mode++) {
+    CTFFlatFileWriter::Options options;
+    options.async = true;
+    options.maxQueued = 20000; // smaller than the total, the producer has to wait
+    options.directIO = mode & 1;
+    options.preallocate = (mode & 2) ? (1 << 20) : 0;
+    writeAndCheck(options);
+  }
+}
@@ -166,4 +166,33 @@ BOOST_DATA_TEST_CASE(CTFTest, boost_data::make(ANSVersions), ansVersion)
     BOOST_CHECK(cor.CFDTime == cdc.CFDTime);
     BOOST_CHECK(cor.QTCAmpl == cdc.QTCAmpl);
   }
+
+  // selective decoding: only the digits in the selected IR frames are decompressed
+  std::vector<o2::dataformats::IRFrame> frames{{digits[10].mIntRecord, digits[20].mIntRecord}, {digits[500].mIntRecord, digits[500].mIntRecord}};
+  {
+    CTFCoder coder(o2::ctf::CTFCoderBase::OpType::Decoder);
+    coder.setSelectedIRFrames(frames);
+    coder.decode(ctfImage, digitsD, channelsD);
+  }
+  BOOST_REQUIRE(digitsD.size() == 12);
+  for (const auto& ddc : digitsD) {
+    const auto& dor = digits[ddc.mEventID];
+    BOOST_CHECK(dor.mIntRecord == ddc.mIntRecord);
+    BOOST_CHECK(dor.mTriggers.getTriggersignals() == ddc.mTriggers.getTriggersignals());
+    auto chor = dor.getBunchChannelData(channels);
+    auto chdc = ddc.getBunchChannelData(channelsD);
+    BOOST_REQUIRE(chor.size() == chdc.size());
+    for (size_t i = 0; i < chor.size(); i++) {
+      BOOST_CHECK(chor[i].ChId == chdc[i].ChId);
+      BOOST_CHECK(chor[i].QTCAmpl == chdc[i].QTCAmpl);
+    }
+  }
+  // nothing is decoded if no trigger is selected
+  frames = {{digits.back().mIntRecord + 1, digits.back().mIntRecord + 10}};
+  {
+    CTFCoder coder(o2::ctf::CTFCoderBase::OpType::Decoder);
+    coder.setSelectedIRFrames(frames);
+    coder.decode(ctfImage, digitsD, channelsD);
+  }
+  BOOST_CHECK(digitsD.empty() && channelsD.empty());
 }
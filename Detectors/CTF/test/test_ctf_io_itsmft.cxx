@@ -35,8 +35,9 @@ using namespace o2::itsmft;
 namespace boost_data = boost::unit_test::data;
 
 inline std::vector<o2::ctf::ANSHeader> ANSVersions{o2::ctf::ANSVersionCompat, o2::ctf::ANSVersion1};
+inline std::vector<int> NEncoderThreads{1, 4};
 
-BOOST_DATA_TEST_CASE(CompressedClustersTest, boost_data::make(ANSVersions), ansVersion)
+BOOST_DATA_TEST_CASE(CompressedClustersTest, boost_data::make(ANSVersions) * boost_data::make(NEncoderThreads), ansVersion, nEncoderThreads)
 {
 
   std::vector<ROFRecord> rofRecVec;
@@ -83,6 +84,7 @@ BOOST_DATA_TEST_CASE(CompressedClustersTest, boost_data::make(ANSVersions), ansV
   {
     CTFCoder coder(o2::ctf::CTFCoderBase::OpType::Encoder, o2::detectors::DetID::ITS);
     coder.setANSVersion(ansVersion);
+    coder.setNEncoderThreads(nEncoderThreads);
     coder.encode(vec, rofRecVec, cclusVec, pattVec, pattIdConverter, 0); // compress
   }
   sw.Stop();
@@ -0,0 +1,37 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   CTFDecoderSpec.h
+/// @brief  Single device decoding the CTFs of several small detectors in parallel
+
+#ifndef O2_CTFDECODER_SPEC
+#define O2_CTFDECODER_SPEC
+
+#include "Framework/DataProcessorSpec.h"
+#include "DetectorsCommonDataFormats/DetID.h"
+
+namespace o2
+{
+namespace ctf
+{
+
+/// detectors which can be decoded by the combined decoder (FT0, FV0, FDD, CTP, ZDC, CPV, MID, HMP)
+o2::detectors::DetID::mask_t getCombinedDecoderMask();
+
+/// create a processor spec decoding the CTFs of the detectors in dets (must be a subset of getCombinedDecoderMask()).
+/// It replaces the individual entropy decoders of these detectors, producing the same outputs.
+/// The detectors are decoded concurrently in up to nThreads threads (<1: one thread per detector)
+framework::DataProcessorSpec getCombinedDecoderSpec(o2::detectors::DetID::mask_t dets, int verbosity, unsigned int sspec, int nThreads);
+
+} // namespace ctf
+} // namespace o2
+
+#endif /* O2_CTFDECODER_SPEC */
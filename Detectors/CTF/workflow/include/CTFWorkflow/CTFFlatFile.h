@@ -0,0 +1,174 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   CTFFlatFile.h
+/// @brief  Flat, page-aligned on-disk container of CTFs, readable via mmap without ROOT deserialization
+///
+/// Layout: CTFFlatFileHeader | detector images (each starting at a page boundary) ... | index of CTFFlatEntry
+/// Each detector image is the EncodedBlocks buffer exactly as produced by the entropy encoder, so the reader can
+/// hand it to EncodedBlocks::getImage (or to the output message) directly from the mapped file.
+/// The writer can hand the images to a background thread (CTFIOQueue), which writes them at their final offsets.
+
+#ifndef O2_CTF_FLAT_FILE_H
+#define O2_CTF_FLAT_FILE_H
+
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <gsl/span>
+#include "DetectorsCommonDataFormats/DetID.h"
+#include "DetectorsCommonDataFormats/CTFHeader.h"
+#include "DetectorsCommonDataFormats/EncodedBlocks.h"
+
+namespace o2
+{
+namespace ctf
+{
+
+struct CTFFlatFileHeader {
+  static constexpr std::array<char, 8> Magic{'O', '2', 'C', 'T', 'F', 'F', 'L', 'T'};
+  static constexpr uint32_t CurrentVersion = 1;
+  static constexpr size_t Alignment = 4096; // alignment of detector images in the file
+
+  std::array<char, 8> magic = Magic;
+  uint32_t version = CurrentVersion;
+  uint32_t nEntries = 0;    // number of CTFs stored
+  uint64_t indexOffset = 0; // offset of the index (nEntries of CTFFlatEntry) wrt the file start
+};
+
+struct CTFFlatChunk {
+  uint64_t offset = 0; // offset wrt the file start, multiple of CTFFlatFileHeader::Alignment
+  uint64_t size = 0;   // size in bytes, 0 if the detector is absent
+};
+
+struct CTFFlatEntry {
+  uint64_t run = 0;
+  uint64_t creationTime = 0;
+  uint32_t firstTForbit = 0;
+  uint32_t tfCounter = 0;
+  uint32_t detectors = 0;
+  uint32_t reserved = 0;
+  std::array<CTFFlatChunk, o2::detectors::DetID::nDetectors> images{};
+
+  CTFHeader getCTFHeader() const;
+  void setCTFHeader(const CTFHeader& h);
+};
+
+/// Single background thread executing the queued jobs in order.
+/// The producer is blocked while the total size of the queued jobs exceeds the limit.
+/// An exception thrown by a job is rethrown to the producer by the next push or drain.
+class CTFIOQueue
+{
+ public:
+  CTFIOQueue(size_t maxQueued = 0); // 0: no limit
+  ~CTFIOQueue();
+  CTFIOQueue(const CTFIOQueue&) = delete;
+  CTFIOQueue& operator=(const CTFIOQueue&) = delete;
+
+  void push(std::function<void()> job, size_t size = 0);
+  /// wait until all queued jobs are done
+  void drain();
+
+ private:
+  void run();
+
+  size_t mMaxQueued = 0;
+  size_t mQueued = 0;
+  bool mBusy = false;
+  bool mStop = false;
+  std::deque<std::pair<std::function<void()>, size_t>> mJobs;
+  std::exception_ptr mError;
+  std::mutex mMutex;
+  std::condition_variable mCondition;
+  std::thread mThread;
+};
+
+class CTFFlatFileWriter
+{
+ public:
+  static constexpr std::string_view FileExtension = ".ctf";
+
+  struct Options {
+    bool async = false;                 // write from a background thread, the images are copied
+    bool directIO = false;              // open with O_DIRECT, all writes are padded to CTFFlatFileHeader::Alignment
+    size_t preallocate = 0;             // if > 0, reserve this size on disk when opening, the file is truncated when closing
+    size_t maxQueued = size_t(1) << 30; // max. size of the images queued in the async mode before the producer is blocked
+  };
+
+  CTFFlatFileWriter(const std::string& fileName, const Options& options);
+  CTFFlatFileWriter(const std::string& fileName) : CTFFlatFileWriter(fileName, Options{}) {}
+  ~CTFFlatFileWriter();
+  CTFFlatFileWriter(const CTFFlatFileWriter&) = delete;
+  CTFFlatFileWriter& operator=(const CTFFlatFileWriter&) = delete;
+
+  /// append image of the detector to the current entry, return written size
+  size_t addImage(o2::detectors::DetID det, gsl::span<const o2::ctf::BufferType> image);
+  /// close the current entry with provided header
+  void closeEntry(const CTFHeader& header);
+  /// write the index and the file header and close the file
+  void close();
+
+  const std::string& getFileName() const { return mFileName; }
+  uint32_t getNEntries() const { return mIndex.size(); }
+  size_t getSize() const { return mOffset; }
+
+ private:
+  void write(const void* data, size_t size);
+  void writeAt(const void* data, size_t size, uint64_t offset);
+  void pad(size_t alignment);
+
+  std::string mFileName{};
+  int mFD = -1;
+  bool mDirectIO = false;
+  std::unique_ptr<CTFIOQueue> mQueue;
+  std::vector<CTFFlatEntry> mIndex{};
+  CTFFlatEntry mCurrent{};
+  uint64_t mOffset = 0;
+};
+
+class CTFFlatFileReader
+{
+ public:
+  /// check if the file exists locally and starts with the flat CTF file signature
+  static bool isFlatFile(const std::string& fileName);
+
+  CTFFlatFileReader(const std::string& fileName);
+  ~CTFFlatFileReader();
+  CTFFlatFileReader(const CTFFlatFileReader&) = delete;
+  CTFFlatFileReader& operator=(const CTFFlatFileReader&) = delete;
+
+  const std::string& getFileName() const { return mFileName; }
+  size_t getNEntries() const { return mIndex.size(); }
+  CTFHeader getHeader(size_t entry) const { return mIndex[entry].getCTFHeader(); }
+  /// image of the detector in the mapped file, empty if the detector is absent
+  gsl::span<const o2::ctf::BufferType> getImage(size_t entry, o2::detectors::DetID det) const;
+
+ private:
+  std::string mFileName{};
+  const o2::ctf::BufferType* mData = nullptr;
+  size_t mSize = 0;
+  gsl::span<const CTFFlatEntry> mIndex{};
+};
+
+} // namespace ctf
+} // namespace o2
+
+#endif
@@ -0,0 +1,449 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   CTFDecoderSpec.cxx
+
+#include <array>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "Framework/Logger.h"
+#include "Framework/ConfigParamRegistry.h"
+#include "Framework/CCDBParamSpec.h"
+#include "Framework/Task.h"
+#include "CommonConstants/LHCConstants.h"
+#include "CTFWorkflow/CTFDecoderSpec.h"
+#include "FT0Reconstruction/CTFCoder.h"
+#include "FV0Reconstruction/CTFCoder.h"
+#include "FDDReconstruction/CTFCoder.h"
+#include "CTPReconstruction/CTFCoder.h"
+#include "ZDCReconstruction/CTFCoder.h"
+#include "CPVReconstruction/CTFCoder.h"
+#include "MIDCTF/CTFCoder.h"
+#include "HMPIDReconstruction/CTFCoder.h"
+#include <TStopwatch.h>
+
+using namespace o2::framework;
+using DetID = o2::detectors::DetID;
+
+namespace o2
+{
+namespace ctf
+{
+
+namespace
+{
+
+/// Decoding of a single detector. The inputs are fetched and the outputs are created in the main thread
+/// (prepare/finalise), only decode may be called from a worker thread. The output containers created
+/// by the DataAllocator may grow in the worker: their memory comes from the transport, which is thread safe.
+class DetDecoder
+{
+ public:
+  virtual ~DetDecoder() = default;
+  virtual void init(InitContext& ic) = 0;
+  virtual bool finaliseCCDB(ConcreteDataMatcher& matcher, void* obj) = 0;
+  virtual void prepare(ProcessingContext& pc) = 0;
+  virtual void decode() = 0;
+  virtual void finalise(ProcessingContext& pc) = 0;
+};
+
+template <typename CODER, typename CTF>
+class DetDecoderImpl : public DetDecoder
+{
+ public:
+  DetDecoderImpl(DetID det, int verbosity, bool supportBCShifts) : mDet(det), mCTFCoder(o2::ctf::CTFCoderBase::OpType::Decoder)
+  {
+    mCTFCoder.setVerbosity(verbosity);
+    mCTFCoder.setSupportBCShifts(supportBCShifts);
+    mCTFCoder.setDictBinding(fmt::format("ctfdict_{}", det.getName()));
+  }
+
+  void init(InitContext& ic) override { mCTFCoder.template init<CTF>(ic); }
+
+  bool finaliseCCDB(ConcreteDataMatcher& matcher, void* obj) override { return mCTFCoder.template finaliseCCDB<CTF>(matcher, obj); }
+
+  void prepare(ProcessingContext& pc) final
+  {
+    mCTFCoder.updateTimeDependentParams(pc, true);
+    mBuffer = pc.inputs().get<gsl::span<o2::ctf::BufferType>>(fmt::format("ctf_{}", mDet.getName()));
+    mIOSize = {};
+    makeOutputs(pc);
+  }
+
+  void decode() final
+  {
+    // since the buff is const, we cannot use EncodedBlocks::relocate directly, instead we wrap its data to another flat object
+    if (mBuffer.size()) {
+      const auto ctfImage = CTF::getImage(mBuffer.data());
+      mIOSize = decodeImage(ctfImage);
+    }
+  }
+
+  void finalise(ProcessingContext& pc) final
+  {
+    sendOutputs(pc);
+    pc.outputs().snapshot(Output{mDet.getDataOrigin(), "CTFDECREP", 0}, mIOSize);
+    LOGP(info, "Decoded {} {}, ({})", mDet.getName(), summary(), mIOSize.asString());
+  }
+
+ protected:
+  /// create the outputs to be filled by decodeImage
+  virtual void makeOutputs(ProcessingContext& pc) = 0;
+  virtual o2::ctf::CTFIOSize decodeImage(const typename CTF::base& ctfImage) = 0;
+  /// send the outputs which could not be created upfront
+  virtual void sendOutputs(ProcessingContext& pc) {}
+  virtual std::string summary() const = 0;
+
+  DetID mDet;
+  CODER mCTFCoder;
+  gsl::span<const o2::ctf::BufferType> mBuffer;
+  o2::ctf::CTFIOSize mIOSize;
+};
+
+/// FT0, FV0 and FDD have the same layout of the decoded data
+template <typename CODER, typename CTF, typename DIGIT, typename CHANNEL>
+class FITDecoder final : public DetDecoderImpl<CODER, CTF>
+{
+ public:
+  using DetDecoderImpl<CODER, CTF>::DetDecoderImpl;
+
+ protected:
+  void makeOutputs(ProcessingContext& pc) final
+  {
+    mDigits = &pc.outputs().make<std::vector<DIGIT>>(Output{this->mDet.getDataOrigin(), "DIGITSBC", 0});
+    mChannels = &pc.outputs().make<std::vector<CHANNEL>>(Output{this->mDet.getDataOrigin(), "DIGITSCH", 0});
+  }
+  o2::ctf::CTFIOSize decodeImage(const typename CTF::base& ctfImage) final { return this->mCTFCoder.decode(ctfImage, *mDigits, *mChannels); }
+  std::string summary() const final { return fmt::format("{} channels in {} digits", mChannels->size(), mDigits->size()); }
+
+ private:
+  std::vector<DIGIT>* mDigits = nullptr;
+  std::vector<CHANNEL>* mChannels = nullptr;
+};
+
+class CTPDecoder final : public DetDecoderImpl<o2::ctp::CTFCoder, o2::ctp::CTF>
+{
+ public:
+  using DetDecoderImpl::DetDecoderImpl;
+  void init(InitContext& ic) final
+  {
+    DetDecoderImpl::init(ic);
+    mCTFCoder.setDecodeInps(!ic.options().get<bool>("ignore-ctpinputs-decoding-ctf"));
+  }
+
+ protected:
+  void makeOutputs(ProcessingContext& pc) final
+  {
+    mDigits = &pc.outputs().make<std::vector<o2::ctp::CTPDigit>>(Output{"CTP", "DIGITS", 0});
+    mLumi = &pc.outputs().make<o2::ctp::LumiInfo>(Output{"CTP", "LUMI", 0});
+  }
+  o2::ctf::CTFIOSize decodeImage(const o2::ctp::CTF::base& ctfImage) final { return mCTFCoder.decode(ctfImage, *mDigits, *mLumi); }
+  std::string summary() const final { return fmt::format("{} digits", mDigits->size()); }
+
+ private:
+  std::vector<o2::ctp::CTPDigit>* mDigits = nullptr;
+  o2::ctp::LumiInfo* mLumi = nullptr;
+};
+
+class ZDCDecoder final : public DetDecoderImpl<o2::zdc::CTFCoder, o2::zdc::CTF>
+{
+ public:
+  using DetDecoderImpl::DetDecoderImpl;
+  bool finaliseCCDB(ConcreteDataMatcher& matcher, void* obj) final
+  {
+    if (!DetDecoderImpl::finaliseCCDB(matcher, obj)) {
+      return false;
+    }
+    if (mCTFCoder.getBCShift()) {
+      long norb = mCTFCoder.getBCShift() / o2::constants::lhc::LHCMaxBunches;
+      mCTFCoder.setBCShiftOrbits(norb * o2::constants::lhc::LHCMaxBunches);
+      LOGP(info, "BCs 0 and 3563 will be corrected only for {} BCs (= {} integer orbits)", mCTFCoder.getBCShiftOrbits(), norb);
+    }
+    return true;
+  }
+
+ protected:
+  void makeOutputs(ProcessingContext& pc) final
+  {
+    mTrig = &pc.outputs().make<std::vector<o2::zdc::BCData>>(Output{"ZDC", "DIGITSBC", 0});
+    mChans = &pc.outputs().make<std::vector<o2::zdc::ChannelData>>(Output{"ZDC", "DIGITSCH", 0});
+    mPeds = &pc.outputs().make<std::vector<o2::zdc::OrbitData>>(Output{"ZDC", "DIGITSPD", 0});
+  }
+  o2::ctf::CTFIOSize decodeImage(const o2::zdc::CTF::base& ctfImage) final { return mCTFCoder.decode(ctfImage, *mTrig, *mChans, *mPeds); }
+  std::string summary() const final { return fmt::format("{} channels in {} triggers and {} pedestals", mChans->size(), mTrig->size(), mPeds->size()); }
+
+ private:
+  std::vector<o2::zdc::BCData>* mTrig = nullptr;
+  std::vector<o2::zdc::ChannelData>* mChans = nullptr;
+  std::vector<o2::zdc::OrbitData>* mPeds = nullptr;
+};
+
+class CPVDecoder final : public DetDecoderImpl<o2::cpv::CTFCoder, o2::cpv::CTF>
+{
+ public:
+  using DetDecoderImpl::DetDecoderImpl;
+
+ protected:
+  void makeOutputs(ProcessingContext& pc) final
+  {
+    mTriggers = &pc.outputs().make<std::vector<o2::cpv::TriggerRecord>>(Output{"CPV", "CLUSTERTRIGRECS", 0});
+    mClusters = &pc.outputs().make<std::vector<o2::cpv::Cluster>>(Output{"CPV", "CLUSTERS", 0});
+  }
+  o2::ctf::CTFIOSize decodeImage(const o2::cpv::CTF::base& ctfImage) final { return mCTFCoder.decode(ctfImage, *mTriggers, *mClusters); }
+  std::string summary() const final { return fmt::format("{} clusters in {} triggers", mClusters->size(), mTriggers->size()); }
+
+ private:
+  std::vector<o2::cpv::TriggerRecord>* mTriggers = nullptr;
+  std::vector<o2::cpv::Cluster>* mClusters = nullptr;
+};
+
+class HMPDecoder final : public DetDecoderImpl<o2::hmpid::CTFCoder, o2::hmpid::CTF>
+{
+ public:
+  using DetDecoderImpl::DetDecoderImpl;
+
+ protected:
+  void makeOutputs(ProcessingContext& pc) final
+  {
+    mTriggers = &pc.outputs().make<std::vector<o2::hmpid::Trigger>>(Output{"HMP", "INTRECORDS", 0});
+    mDigits = &pc.outputs().make<std::vector<o2::hmpid::Digit>>(Output{"HMP", "DIGITS", 0});
+  }
+  o2::ctf::CTFIOSize decodeImage(const o2::hmpid::CTF::base& ctfImage) final { return mCTFCoder.decode(ctfImage, *mTriggers, *mDigits); }
+  std::string summary() const final { return fmt::format("{} digits in {} triggers", mDigits->size(), mTriggers->size()); }
+
+ private:
+  std::vector<o2::hmpid::Trigger>* mTriggers = nullptr;
+  std::vector<o2::hmpid::Digit>* mDigits = nullptr;
+};
+
+/// MID outputs one message per event type, which are snapshot after decoding as in the standalone decoder
+class MIDDecoder final : public DetDecoderImpl<o2::mid::CTFCoder, o2::mid::CTF>
+{
+ public:
+  using DetDecoderImpl::DetDecoderImpl;
+
+ protected:
+  void makeOutputs(ProcessingContext& pc) final
+  {
+    for (uint32_t it = 0; it < o2::mid::NEvTypes; it++) {
+      mROFs[it].clear();
+      mCols[it].clear();
+    }
+  }
+  o2::ctf::CTFIOSize decodeImage(const o2::mid::CTF::base& ctfImage) final { return mCTFCoder.decode(ctfImage, mROFs, mCols); }
+  void sendOutputs(ProcessingContext& pc) final
+  {
+    size_t insize = 0;
+    for (uint32_t it = 0; it < o2::mid::NEvTypes; it++) {
+      insize += mCols[it].size() * sizeof(o2::mid::ColumnData);
+      pc.outputs().snapshot(Output{o2::header::gDataOriginMID, "DATA", it}, mCols[it]);
+      insize += mROFs[it].size() * sizeof(o2::mid::ROFRecord);
+      pc.outputs().snapshot(Output{o2::header::gDataOriginMID, "DATAROF", it}, mROFs[it]);
+    }
+    mIOSize.rawIn = insize;
+  }
+  std::string summary() const final
+  {
+    return fmt::format("{{{},{},{}}} columns for {{{},{},{}}} ROFRecords", mCols[0].size(), mCols[1].size(), mCols[2].size(), mROFs[0].size(), mROFs[1].size(), mROFs[2].size());
+  }
+
+ private:
+  std::array<std::vector<o2::mid::ROFRecord>, o2::mid::NEvTypes> mROFs{};
+  std::array<std::vector<o2::mid::ColumnData>, o2::mid::NEvTypes> mCols{};
+};
+
+std::unique_ptr<DetDecoder> createDecoder(DetID det, int verbosity)
+{
+  switch (det.getID()) {
+    case DetID::FT0:
+      return std::make_unique<FITDecoder<o2::ft0::CTFCoder, o2::ft0::CTF, o2::ft0::Digit, o2::ft0::ChannelData>>(det, verbosity, false);
+    case DetID::FV0:
+      return std::make_unique<FITDecoder<o2::fv0::CTFCoder, o2::fv0::CTF, o2::fv0::Digit, o2::fv0::ChannelData>>(det, verbosity, false);
+    case DetID::FDD:
+      return std::make_unique<FITDecoder<o2::fdd::CTFCoder, o2::fdd::CTF, o2::fdd::Digit, o2::fdd::ChannelData>>(det, verbosity, false);
+    case DetID::CTP:
+      return std::make_unique<CTPDecoder>(det, verbosity, true);
+    case DetID::ZDC:
+      return std::make_unique<ZDCDecoder>(det, verbosity, true);
+    case DetID::CPV:
+      return std::make_unique<CPVDecoder>(det, verbosity, true);
+    case DetID::MID:
+      return std::make_unique<MIDDecoder>(det, verbosity, false);
+    case DetID::HMP:
+      return std::make_unique<HMPDecoder>(det, verbosity, true);
+    default:
+      throw std::runtime_error(fmt::format("Detector {} is not supported by the combined CTF decoder", det.getName()));
+  }
+}
+
+} // namespace
+
+class CTFDecoderSpec : public o2::framework::Task
+{
+ public:
+  CTFDecoderSpec(DetID::mask_t dets, int verbosity, int nThreads);
+  ~CTFDecoderSpec() override = default;
+  void init(o2::framework::InitContext& ic) final;
+  void run(o2::framework::ProcessingContext& pc) final;
+  void endOfStream(o2::framework::EndOfStreamContext& ec) final;
+  void finaliseCCDB(o2::framework::ConcreteDataMatcher& matcher, void* obj) final;
+
+ private:
+  std::vector<std::unique_ptr<DetDecoder>> mDecoders;
+  int mNThreads = 1;
+  TStopwatch mTimer;
+};
+
+CTFDecoderSpec::CTFDecoderSpec(DetID::mask_t dets, int verbosity, int nThreads)
+{
+  mTimer.Stop();
+  mTimer.Reset();
+  for (auto id = DetID::First; id <= DetID::Last; id++) {
+    if (dets[id]) {
+      mDecoders.emplace_back(createDecoder(DetID(id), verbosity));
+    }
+  }
+  mNThreads = nThreads < 1 ? int(mDecoders.size()) : std::min(nThreads, int(mDecoders.size()));
+}
+
+void CTFDecoderSpec::init(InitContext& ic)
+{
+  for (auto& dec : mDecoders) {
+    dec->init(ic);
+  }
+}
+
+void CTFDecoderSpec::finaliseCCDB(ConcreteDataMatcher& matcher, void* obj)
+{
+  // the trigger offsets are shared by all detectors, so every decoder has to see them
+  for (auto& dec : mDecoders) {
+    dec->finaliseCCDB(matcher, obj);
+  }
+}
+
+void CTFDecoderSpec::run(ProcessingContext& pc)
+{
+  mTimer.Start(false);
+  for (auto& dec : mDecoders) {
+    dec->prepare(pc);
+  }
+
+  const int nDec = mDecoders.size();
+  std::atomic<int> nextDec{0};
+  std::vector<std::exception_ptr> errors(nDec);
+  auto worker = [&]() {
+    for (int i = nextDec++; i < nDec; i = nextDec++) {
+      try {
+        mDecoders[i]->decode();
+      } catch (...) {
+        errors[i] = std::current_exception();
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  for (int i = 1; i < mNThreads; i++) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& th : threads) {
+    th.join();
+  }
+  for (const auto& err : errors) {
+    if (err) {
+      std::rethrow_exception(err);
+    }
+  }
+
+  for (auto& dec : mDecoders) {
+    dec->finalise(pc);
+  }
+  mTimer.Stop();
+}
+
+void CTFDecoderSpec::endOfStream(EndOfStreamContext& ec)
+{
+  LOGF(info, "Combined Entropy Decoding total timing: Cpu: %.3e Real: %.3e s in %d slots",
+       mTimer.CpuTime(), mTimer.RealTime(), mTimer.Counter() - 1);
+}
+
+DetID::mask_t getCombinedDecoderMask()
+{
+  return DetID::getMask("FT0,FV0,FDD,CTP,ZDC,CPV,MID,HMP");
+}
+
+DataProcessorSpec getCombinedDecoderSpec(DetID::mask_t dets, int verbosity, unsigned int sspec, int nThreads)
+{
+  if ((dets & ~getCombinedDecoderMask()).any()) {
+    throw std::runtime_error(fmt::format("Detectors {} are not supported by the combined CTF decoder", DetID::getNames(dets & ~getCombinedDecoderMask())));
+  }
+  std::vector<InputSpec> inputs;
+  std::vector<OutputSpec> outputs;
+  Options options{{"ctf-dict", VariantType::String, "ccdb", {"CTF dictionary: empty or ccdb=CCDB, none=no external dictionary otherwise: local filename (common for all detectors)"}},
+                  {"ans-version", VariantType::String, {"version of ans entropy coder implementation to use"}}};
+
+  for (auto id = DetID::First; id <= DetID::Last; id++) {
+    if (!dets[id]) {
+      continue;
+    }
+    DetID det(id);
+    const auto orig = det.getDataOrigin();
+    inputs.emplace_back(fmt::format("ctf_{}", det.getName()), orig, "CTFDATA", sspec, Lifetime::Timeframe);
+    inputs.emplace_back(fmt::format("ctfdict_{}", det.getName()), orig, "CTFDICT", 0, Lifetime::Condition, ccdbParamSpec(fmt::format("{}/Calib/CTFDictionaryTree", det.getName())));
+    switch (id) {
+      case DetID::FT0:
+      case DetID::FV0:
+      case DetID::FDD:
+        outputs.emplace_back(orig, "DIGITSBC", 0, Lifetime::Timeframe);
+        outputs.emplace_back(orig, "DIGITSCH", 0, Lifetime::Timeframe);
+        break;
+      case DetID::CTP:
+        outputs.emplace_back(orig, "DIGITS", 0, Lifetime::Timeframe);
+        outputs.emplace_back(orig, "LUMI", 0, Lifetime::Timeframe);
+        options.emplace_back(ConfigParamSpec{"ignore-ctpinputs-decoding-ctf", VariantType::Bool, false, {"Inputs alignment: false - CTF decoder - has to be compatible with reco: allowed options: 10,01,00"}});
+        break;
+      case DetID::ZDC:
+        outputs.emplace_back(orig, "DIGITSBC", 0, Lifetime::Timeframe);
+        outputs.emplace_back(orig, "DIGITSCH", 0, Lifetime::Timeframe);
+        outputs.emplace_back(orig, "DIGITSPD", 0, Lifetime::Timeframe);
+        break;
+      case DetID::CPV:
+        outputs.emplace_back(orig, "CLUSTERTRIGRECS", 0, Lifetime::Timeframe);
+        outputs.emplace_back(orig, "CLUSTERS", 0, Lifetime::Timeframe);
+        break;
+      case DetID::MID:
+        for (o2::header::DataHeader::SubSpecificationType subSpec = 0; subSpec < o2::mid::NEvTypes; ++subSpec) {
+          outputs.emplace_back(orig, "DATA", subSpec, Lifetime::Timeframe);
+          outputs.emplace_back(orig, "DATAROF", subSpec, Lifetime::Timeframe);
+        }
+        break;
+      case DetID::HMP:
+        outputs.emplace_back(orig, "INTRECORDS", 0, Lifetime::Timeframe);
+        outputs.emplace_back(orig, "DIGITS", 0, Lifetime::Timeframe);
+        break;
+    }
+    outputs.emplace_back(orig, "CTFDECREP", 0, Lifetime::Timeframe);
+  }
+  inputs.emplace_back("trigoffset", "CTP", "Trig_Offset", 0, Lifetime::Condition, ccdbParamSpec("CTP/Config/TriggerOffsets"));
+
+  return DataProcessorSpec{
+    "ctf-combined-decoder",
+    inputs,
+    outputs,
+    AlgorithmSpec{adaptFromTask<CTFDecoderSpec>(dets, verbosity, nThreads)},
+    options};
+}
+
+} // namespace ctf
+} // namespace o2
@@ -0,0 +1,337 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   CTFFlatFile.cxx
+
+#include "CTFWorkflow/CTFFlatFile.h"
+#include "Framework/Logger.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <fmt/format.h>
+
+using namespace o2::ctf;
+using DetID = o2::detectors::DetID;
+
+///_______________________________________
+CTFHeader CTFFlatEntry::getCTFHeader() const
+{
+  CTFHeader h{run, creationTime, firstTForbit, tfCounter};
+  h.detectors = DetID::mask_t(detectors);
+  return h;
+}
+
+///_______________________________________
+void CTFFlatEntry::setCTFHeader(const CTFHeader& h)
+{
+  run = h.run;
+  creationTime = h.creationTime;
+  firstTForbit = h.firstTForbit;
+  tfCounter = h.tfCounter;
+  detectors = h.detectors.to_ulong();
+}
+
+///_______________________________________
+CTFIOQueue::CTFIOQueue(size_t maxQueued) : mMaxQueued(maxQueued), mThread([this]() { run(); })
+{
+}
+
+///_______________________________________
+CTFIOQueue::~CTFIOQueue()
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStop = true;
+  }
+  mCondition.notify_all();
+  mThread.join();
+  if (mError) {
+    try {
+      std::rethrow_exception(mError);
+    } catch (std::exception const& e) {
+      LOGP(error, "Unreported error in background CTF I/O: {}", e.what());
+    }
+  }
+}
+
+///_______________________________________
+void CTFIOQueue::push(std::function<void()> job, size_t size)
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+  // a job larger than the limit is accepted once the queue is empty
+  mCondition.wait(lock, [this, size]() { return mError || !mMaxQueued || !mQueued || mQueued + size <= mMaxQueued; });
+  if (mError) {
+    auto error = mError;
+    mError = nullptr;
+    std::rethrow_exception(error);
+  }
+  mJobs.emplace_back(std::move(job), size);
+  mQueued += size;
+  lock.unlock();
+  mCondition.notify_all();
+}
+
+///_______________________________________
+void CTFIOQueue::drain()
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+  mCondition.wait(lock, [this]() { return mJobs.empty() && !mBusy; });
+  if (mError) {
+    auto error = mError;
+    mError = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+
+///_______________________________________
+void CTFIOQueue::run()
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+  while (true) {
+    mCondition.wait(lock, [this]() { return !mJobs.empty() || mStop; });
+    if (mJobs.empty()) {
+      return;
+    }
+    auto [job, size] = std::move(mJobs.front());
+    mJobs.pop_front();
+    mBusy = true;
+    lock.unlock();
+    std::exception_ptr error;
+    try {
+      job();
+    } catch (...) {
+      error = std::current_exception();
+    }
+    job = nullptr; // release the resources of the job before reporting it done
+    lock.lock();
+    mBusy = false;
+    mQueued -= size;
+    if (error && !mError) {
+      mError = error;
+    }
+    mCondition.notify_all();
+  }
+}
+
+///_______________________________________
+CTFFlatFileWriter::CTFFlatFileWriter(const std::string& fileName, const Options& options) : mFileName(fileName), mDirectIO(options.directIO)
+{
+  int flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+  if (mDirectIO) {
+#ifdef O_DIRECT
+    flags |= O_DIRECT;
+#else
+    LOGP(warning, "O_DIRECT is not supported on this platform, writing {} through the page cache", fileName);
+    mDirectIO = false;
+#endif
+  }
+  mFD = open(fileName.c_str(), flags, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+  if (mFD == -1) {
+    throw std::runtime_error(fmt::format("failed to open flat CTF file {}: {}", fileName, strerror(errno)));
+  }
+  if (options.preallocate) {
+#ifndef __APPLE__
+    if (int res = posix_fallocate(mFD, 0, options.preallocate)) {
+      LOGP(warning, "failed to preallocate {} bytes for flat CTF file {}: {}", options.preallocate, fileName, strerror(res));
+    }
+#endif
+  }
+  if (options.async) {
+    mQueue = std::make_unique<CTFIOQueue>(options.maxQueued);
+  }
+  CTFFlatFileHeader header; // placeholder, rewritten at closing
+  write(&header, sizeof(header));
+}
+
+///_______________________________________
+CTFFlatFileWriter::~CTFFlatFileWriter()
+{
+  try {
+    close();
+  } catch (std::exception const& e) {
+    LOGP(error, "{}", e.what());
+  }
+}
+
+///_______________________________________
+size_t CTFFlatFileWriter::addImage(DetID det, gsl::span<const o2::ctf::BufferType> image)
+{
+  pad(CTFFlatFileHeader::Alignment);
+  mCurrent.images[det] = CTFFlatChunk{mOffset, image.size()};
+  write(image.data(), image.size());
+  return image.size();
+}
+
+///_______________________________________
+void CTFFlatFileWriter::closeEntry(const CTFHeader& header)
+{
+  mCurrent.setCTFHeader(header);
+  mIndex.push_back(mCurrent);
+  mCurrent = CTFFlatEntry{};
+}
+
+///_______________________________________
+void CTFFlatFileWriter::close()
+{
+  if (mFD == -1) {
+    return;
+  }
+  pad(mDirectIO ? CTFFlatFileHeader::Alignment : alignof(CTFFlatEntry));
+  CTFFlatFileHeader header;
+  header.nEntries = mIndex.size();
+  header.indexOffset = mOffset;
+  const uint64_t fileSize = mOffset + mIndex.size() * sizeof(CTFFlatEntry);
+  write(mIndex.data(), mIndex.size() * sizeof(CTFFlatEntry));
+  mOffset = 0;
+  write(&header, sizeof(header));
+  if (mQueue) {
+    try {
+      mQueue->drain();
+    } catch (...) {
+      ::close(mFD);
+      mFD = -1;
+      throw;
+    }
+  }
+  // drop the padding of the last block and what was preallocated but not used
+  bool ok = ftruncate(mFD, fileSize) == 0;
+  ok = (::close(mFD) == 0) && ok;
+  mFD = -1;
+  if (!ok) {
+    throw std::runtime_error(fmt::format("failed to finalize flat CTF file {}: {}", mFileName, strerror(errno)));
+  }
+}
+
+///_______________________________________
+void CTFFlatFileWriter::write(const void* data, size_t size)
+{
+  const auto offset = mOffset;
+  mOffset += size;
+  if (!mQueue && !mDirectIO) {
+    writeAt(data, size, offset);
+    return;
+  }
+  // the source may go away after the call, and direct I/O needs blocks aligned in memory, on disk and in size
+  constexpr size_t Alignment = CTFFlatFileHeader::Alignment;
+  const size_t allocSize = (std::max(size, size_t(1)) + Alignment - 1) / Alignment * Alignment;
+  const size_t bufSize = mDirectIO ? allocSize : size;
+  std::shared_ptr<char> buffer(static_cast<char*>(std::aligned_alloc(Alignment, allocSize)), std::free);
+  if (!buffer) {
+    throw std::runtime_error(fmt::format("failed to allocate {} bytes for flat CTF file {}", bufSize, mFileName));
+  }
+  if (size) {
+    memcpy(buffer.get(), data, size);
+  }
+  memset(buffer.get() + size, 0, bufSize - size);
+  if (mDirectIO) {
+    mOffset = offset + bufSize;
+  }
+  if (mQueue) {
+    mQueue->push([this, buffer, bufSize, offset]() { writeAt(buffer.get(), bufSize, offset); }, bufSize);
+  } else {
+    writeAt(buffer.get(), bufSize, offset);
+  }
+}
+
+///_______________________________________
+void CTFFlatFileWriter::writeAt(const void* data, size_t size, uint64_t offset)
+{
+  auto ptr = reinterpret_cast<const char*>(data);
+  while (size) {
+    auto nwr = pwrite(mFD, ptr, size, offset);
+    if (nwr < 0 && errno == EINTR) {
+      continue;
+    }
+    if (nwr <= 0) {
+      throw std::runtime_error(fmt::format("failed to write {} bytes to flat CTF file {} at offset {}: {}", size, mFileName, offset, strerror(errno)));
+    }
+    ptr += nwr;
+    size -= nwr;
+    offset += nwr;
+  }
+}
+
+///_______________________________________
+void CTFFlatFileWriter::pad(size_t alignment)
+{
+  static const std::array<char, CTFFlatFileHeader::Alignment> zeros{};
+  if (auto rem = mOffset % alignment) {
+    if (mDirectIO) { // the blocks are padded when written
+      mOffset += alignment - rem;
+      return;
+    }
+    write(zeros.data(), alignment - rem);
+  }
+}
+
+///_______________________________________
+bool CTFFlatFileReader::isFlatFile(const std::string& fileName)
+{
+  std::ifstream inp(fileName, std::ios::binary);
+  decltype(CTFFlatFileHeader::magic) magic{};
+  return inp.read(magic.data(), magic.size()) && magic == CTFFlatFileHeader::Magic;
+}
+
+///_______________________________________
+CTFFlatFileReader::CTFFlatFileReader(const std::string& fileName) : mFileName(fileName)
+{
+  int fd = open(fileName.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd == -1) {
+    throw std::runtime_error(fmt::format("failed to open flat CTF file {}", fileName));
+  }
+  struct stat statbuf;
+  if (fstat(fd, &statbuf) == -1 || size_t(statbuf.st_size) < sizeof(CTFFlatFileHeader)) {
+    ::close(fd);
+    throw std::runtime_error(fmt::format("flat CTF file {} is too short", fileName));
+  }
+  mSize = statbuf.st_size;
+  void* ptr = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd); // the mapping keeps the file referenced
+  if (ptr == MAP_FAILED) {
+    throw std::runtime_error(fmt::format("failed to map flat CTF file {}", fileName));
+  }
+  mData = reinterpret_cast<const o2::ctf::BufferType*>(ptr);
+  madvise(ptr, mSize, MADV_SEQUENTIAL);
+
+  const auto& header = *reinterpret_cast<const CTFFlatFileHeader*>(mData);
+  if (header.magic != CTFFlatFileHeader::Magic || header.version != CTFFlatFileHeader::CurrentVersion) {
+    munmap(ptr, mSize);
+    throw std::runtime_error(fmt::format("{} is not a flat CTF file of version {}", fileName, CTFFlatFileHeader::CurrentVersion));
+  }
+  if (header.indexOffset % alignof(CTFFlatEntry) || header.indexOffset + header.nEntries * sizeof(CTFFlatEntry) > mSize) {
+    munmap(ptr, mSize);
+    throw std::runtime_error(fmt::format("index of flat CTF file {} is corrupted", fileName));
+  }
+  mIndex = gsl::span<const CTFFlatEntry>(reinterpret_cast<const CTFFlatEntry*>(mData + header.indexOffset), header.nEntries);
+}
+
+///_______________________________________
+CTFFlatFileReader::~CTFFlatFileReader()
+{
+  if (mData) {
+    munmap(const_cast<o2::ctf::BufferType*>(mData), mSize);
+  }
+}
+
+///_______________________________________
+gsl::span<const o2::ctf::BufferType> CTFFlatFileReader::getImage(size_t entry, DetID det) const
+{
+  const auto& chunk = mIndex[entry].images[det];
+  if (chunk.offset + chunk.size > mSize) {
+    throw std::runtime_error(fmt::format("image of {} in entry {} of flat CTF file {} exceeds the file size", det.getName(), entry, mFileName));
+  }
+  return {mData + chunk.offset, chunk.size};
+}
@@ -12,6 +12,7 @@
 /// @file   CTFReaderSpec.cxx
 
 #include <vector>
+#include <cstring>
 #include <TFile.h>
 #include <TTree.h>
 
@@ -21,11 +22,13 @@
 #include "Framework/InputSpec.h"
 #include "Framework/RawDeviceService.h"
 #include "Framework/RateLimiter.h"
+#include "Framework/Monitoring.h"
 #include "CommonUtils/StringUtils.h"
 #include "CommonUtils/FileFetcher.h"
 #include "CommonUtils/IRFrameSelector.h"
 #include "DetectorsRaw/HBFUtils.h"
 #include "CTFWorkflow/CTFReaderSpec.h"
+#include "CTFWorkflow/CTFFlatFile.h"
 #include "DetectorsCommonDataFormats/EncodedBlocks.h"
 #include "CommonUtils/NameConf.h"
 #include "DetectorsCommonDataFormats/CTFHeader.h"
@@ -84,16 +87,22 @@ class CTFReaderSpec : public o2::framework::Task
   void openCTFFile(const std::string& flname);
   bool processTF(ProcessingContext& pc);
   void checkTreeEntries();
+  bool isFileOpen() const { return mCTFTree || mCTFFlat; }
+  long getNEntries() const { return mCTFFlat ? long(mCTFFlat->getNEntries()) : mCTFTree->GetEntries(); }
+  std::string getFileName() const { return mCTFFlat ? mCTFFlat->getFileName() : mCTFFile->GetName(); }
+  void closeCTFFile();
   void stopReader();
   template <typename C>
   void processDetector(DetID det, const CTFHeader& ctfHeader, ProcessingContext& pc) const;
   void setMessageHeader(ProcessingContext& pc, const CTFHeader& ctfHeader, const std::string& lbl, unsigned subspec) const; // keep just for the reference
   void tryToFixCTFHeader(CTFHeader& ctfHeader) const;
+  void sendFetcherMetrics(ProcessingContext& pc) const;
   CTFReaderInp mInput{};
   o2::utils::IRFrameSelector mIRFrameSelector; // optional IR frames selector
   std::unique_ptr<o2::utils::FileFetcher> mFileFetcher;
   std::unique_ptr<TFile> mCTFFile;
   std::unique_ptr<TTree> mCTFTree;
+  std::unique_ptr<CTFFlatFileReader> mCTFFlat; // mmapped flat CTF file, used instead of mCTFFile/mCTFTree
   bool mRunning = false;
   bool mUseLocalTFCounter = false;
   int mCTFCounter = 0;
@@ -134,11 +143,18 @@ void CTFReaderSpec::stopReader()
   mRunning = false;
   mFileFetcher->stop();
   mFileFetcher.reset();
+  closeCTFFile();
+}
+
+///_______________________________________
+void CTFReaderSpec::closeCTFFile()
+{
   mCTFTree.reset();
   if (mCTFFile) {
     mCTFFile->Close();
   }
   mCTFFile.reset();
+  mCTFFlat.reset();
 }
 
 ///_______________________________________
@@ -153,6 +169,8 @@ void CTFReaderSpec::init(InitContext& ic)
   mFileFetcher->setMaxFilesInQueue(mInput.maxFileCache);
   mFileFetcher->setMaxLoops(mInput.maxLoops);
   mFileFetcher->setFailThreshold(ic.options().get<float>("fetch-failure-threshold"));
+  mFileFetcher->setNCopyThreads(ic.options().get<int>("fetch-threads"));
+  mFileFetcher->setMaxCacheSize(size_t(ic.options().get<int>("fetch-cache-size-MB")) << 20);
   mFileFetcher->start();
   if (!mInput.fileIRFrames.empty()) {
     mIRFrameSelector.loadIRFrames(mInput.fileIRFrames);
@@ -167,6 +185,14 @@ void CTFReaderSpec::openCTFFile(const std::string& flname)
 {
   try {
     mFilesRead++;
+    if (CTFFlatFileReader::isFlatFile(flname)) {
+      mCTFFlat = std::make_unique<CTFFlatFileReader>(flname);
+      if (mCTFFlat->getNEntries() < 1) {
+        throw std::runtime_error(fmt::format("flat CTF file {} has 0 entries, skipping", flname));
+      }
+      mCurrTreeEntry = 0;
+      return;
+    }
     mCTFFile.reset(TFile::Open(flname.c_str()));
     if (!mCTFFile || !mCTFFile->IsOpen() || mCTFFile->IsZombie()) {
       throw std::runtime_error(fmt::format("failed to open CTF file {}, skipping", flname));
@@ -182,6 +208,7 @@ void CTFReaderSpec::openCTFFile(const std::string& flname)
     LOG(error) << "Cannot process " << flname << ", reason: " << e.what();
     mCTFTree.reset();
     mCTFFile.reset();
+    mCTFFlat.reset();
     mNFailedFiles++;
     if (mFileFetcher) {
       mFileFetcher->popFromQueue(mInput.maxLoops < 1);
@@ -190,6 +217,24 @@ void CTFReaderSpec::openCTFFile(const std::string& flname)
   mCurrTreeEntry = 0;
 }
 
+///_______________________________________
+void CTFReaderSpec::sendFetcherMetrics(ProcessingContext& pc) const
+{
+  // report the staging of the input files
+  using o2::monitoring::Metric;
+  auto& monitoring = pc.services().get<o2::monitoring::Monitoring>();
+  const auto stats = mFileFetcher->getCopyStats();
+  monitoring.send(Metric{uint64_t(mFileFetcher->getQueueSize()), "ctf-fetch-queue-size"});
+  monitoring.send(Metric{1e-3 * mTotalWaitTime, "ctf-fetch-wait-ms"});
+  if (stats.nCopied) {
+    monitoring.send(Metric{uint64_t(stats.nCopied), "ctf-fetch-copies"});
+    monitoring.send(Metric{1e-6 * stats.nBytes / std::max(stats.copyTime, 1e-6), "ctf-fetch-MBps"});
+    monitoring.send(Metric{1e3 * stats.copyTime / stats.nCopied, "ctf-fetch-latency-ms"});
+    monitoring.send(Metric{1e3 * stats.maxCopyTime, "ctf-fetch-max-latency-ms"});
+    monitoring.send(Metric{double(stats.cacheSize) / (1 << 20), "ctf-fetch-cache-MB"});
+  }
+}
+
 ///_______________________________________
 void CTFReaderSpec::run(ProcessingContext& pc)
 {
@@ -201,7 +246,7 @@ void CTFReaderSpec::run(ProcessingContext& pc)
   long startWait = 0;
 
   while (mRunning) {
-    if (mCTFTree) { // there is a tree open with multiple CTF
+    if (isFileOpen()) { // there is a tree (or flat file) open with multiple CTF
       if (mInput.ctfIDs.empty() || mInput.ctfIDs[mSelIDEntry] == mCTFCounter) { // no selection requested or matching CTF ID is found
         LOG(debug) << "TF " << mCTFCounter << " of " << mInput.maxTFs << " loop " << mFileFetcher->getNLoops();
         mSelIDEntry++;
@@ -210,7 +255,7 @@ void CTFReaderSpec::run(ProcessingContext& pc)
         }
       }
       // explict CTF ID selection list or IRFrame was provided and current entry is not selected
-      LOGP(info, "Skipping CTF#{} ({} of {} in {})", mCTFCounter, mCurrTreeEntry, mCTFTree->GetEntries(), mCTFFile->GetName());
+      LOGP(info, "Skipping CTF#{} ({} of {} in {})", mCTFCounter, mCurrTreeEntry, getNEntries(), getFileName());
       checkTreeEntries();
       mCTFCounter++;
       continue;
@@ -238,13 +283,14 @@ void CTFReaderSpec::run(ProcessingContext& pc)
       waitAcknowledged = false;
     }
     LOG(info) << "Reading CTF input " << ' ' << tfFileName;
+    sendFetcherMetrics(pc);
     openCTFFile(tfFileName);
   }
 
   if (mCTFCounter >= mInput.maxTFs || (!mInput.ctfIDs.empty() && mSelIDEntry >= mInput.ctfIDs.size())) { // done
     LOGP(info, "All CTFs from selected range were injected, stopping");
     mRunning = false;
-  } else if (mRunning && !mCTFTree && mFileFetcher->getNextFileInQueue().empty() && !mFileFetcher->isRunning()) { // previous tree was done, can we read more?
+  } else if (mRunning && !isFileOpen() && mFileFetcher->getNextFileInQueue().empty() && !mFileFetcher->isRunning()) { // previous tree was done, can we read more?
     mRunning = false;
   }
 
@@ -263,7 +309,9 @@ bool CTFReaderSpec::processTF(ProcessingContext& pc)
 
   static RateLimiter limiter;
   CTFHeader ctfHeader;
-  if (!readFromTree(*(mCTFTree.get()), "CTFHeader", ctfHeader, mCurrTreeEntry)) {
+  if (mCTFFlat) {
+    ctfHeader = mCTFFlat->getHeader(mCurrTreeEntry);
+  } else if (!readFromTree(*(mCTFTree.get()), "CTFHeader", ctfHeader, mCurrTreeEntry)) {
     throw std::runtime_error("did not find CTFHeader");
   }
   if (mImposeRunStartMS > 0) {
@@ -334,7 +382,7 @@ bool CTFReaderSpec::processTF(ProcessingContext& pc)
     stfDist.runNumber = uint32_t(ctfHeader.run);
   }
 
-  auto entryStr = fmt::format("({} of {} in {})", mCurrTreeEntry, mCTFTree->GetEntries(), mCTFFile->GetName());
+  auto entryStr = fmt::format("({} of {} in {})", mCurrTreeEntry, getNEntries(), getFileName());
   checkTreeEntries();
   mTimer.Stop();
 
@@ -360,10 +408,8 @@ bool CTFReaderSpec::processTF(ProcessingContext& pc)
 void CTFReaderSpec::checkTreeEntries()
 {
   // check if the tree has entries left, if needed, close current tree/file
-  if (++mCurrTreeEntry >= mCTFTree->GetEntries()) { // this file is done, check if there are other files
-    mCTFTree.reset();
-    mCTFFile->Close();
-    mCTFFile.reset();
+  if (++mCurrTreeEntry >= getNEntries()) { // this file is done, check if there are other files
+    closeCTFFile();
     if (mFileFetcher) {
       mFileFetcher->popFromQueue(mInput.maxLoops < 1);
     }
@@ -391,10 +437,19 @@ void CTFReaderSpec::processDetector(DetID det, const CTFHeader& ctfHeader, Proce
 {
   if (mInput.detMask[det]) {
     const auto lbl = det.getName();
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({lbl, mInput.subspec}, ctfHeader.detectors[det] ? sizeof(C) : 0);
-    if (ctfHeader.detectors[det]) {
-      C::readFromTree(bufVec, *(mCTFTree.get()), lbl, mCurrTreeEntry);
-    } else if (!mInput.allowMissingDetectors) {
+    if (mCTFFlat) { // the image is copied from the mapped file directly to the output message
+      auto image = ctfHeader.detectors[det] ? mCTFFlat->getImage(mCurrTreeEntry, det) : gsl::span<const o2::ctf::BufferType>{};
+      auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({lbl, mInput.subspec}, image.size());
+      if (image.size()) {
+        std::memcpy(bufVec.data(), image.data(), image.size());
+      }
+    } else {
+      auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({lbl, mInput.subspec}, ctfHeader.detectors[det] ? sizeof(C) : 0);
+      if (ctfHeader.detectors[det]) {
+        C::readFromTree(bufVec, *(mCTFTree.get()), lbl, mCurrTreeEntry);
+      }
+    }
+    if (!ctfHeader.detectors[det] && !mInput.allowMissingDetectors) {
       throw std::runtime_error(fmt::format("Requested detector {} is missing in the CTF", lbl));
     }
     //    setMessageHeader(pc, ctfHeader, lbl);
@@ -473,6 +528,8 @@ DataProcessorSpec getCTFReaderSpec(const CTFReaderInp& inp)
   options.emplace_back(ConfigParamSpec{"impose-run-start-timstamp", VariantType::Int64, 0L, {"impose run start time stamp (ms), ignored if 0"}});
   options.emplace_back(ConfigParamSpec{"local-tf-counter", VariantType::Bool, false, {"reassign header.tfCounter from local TF counter"}});
   options.emplace_back(ConfigParamSpec{"fetch-failure-threshold", VariantType::Float, 0.f, {"Fail if too many failures( >0: fraction, <0: abs number, 0: no threshold)"}});
+  options.emplace_back(ConfigParamSpec{"fetch-threads", VariantType::Int, 1, {"number of remote files copied in parallel"}});
+  options.emplace_back(ConfigParamSpec{"fetch-cache-size-MB", VariantType::Int, 0, {"do not copy new remote files while their local copies exceed this size, evicting least recently used ones (0: no limit)"}});
   options.emplace_back(ConfigParamSpec{"limit-tf-before-reading", VariantType::Bool, false, {"Check TF limiting before reading new TF, otherwhise before injecting it"}});
   if (!inp.metricChannel.empty()) {
     options.emplace_back(ConfigParamSpec{"channel-config", VariantType::String, inp.metricChannel, {"Out-of-band channel config for TF throttling"}});
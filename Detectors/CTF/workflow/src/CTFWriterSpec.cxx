@@ -23,6 +23,7 @@
 
 #include "DataFormatsParameters/GRPECSObject.h"
 #include "CTFWorkflow/CTFWriterSpec.h"
+#include "CTFWorkflow/CTFFlatFile.h"
 #include "DetectorsCommonDataFormats/CTFHeader.h"
 #include "CommonUtils/NameConf.h"
 #include "CommonUtils/FileSystemUtils.h"
@@ -55,6 +56,7 @@
 #include <vector>
 #include <TFile.h>
 #include <TTree.h>
+#include <TROOT.h>
 #include <TRandom.h>
 #include <filesystem>
 #include <ctime>
@@ -119,6 +121,8 @@ class CTFWriterSpec : public o2::framework::Task
   size_t getAvailableDiskSpace(const std::string& path, int level);
   void createLockFile(int level);
   void removeLockFile();
+  static void releaseLockFile(int fd, const std::string& name);
+  void waitForClosedFiles();
   void finalize();
 
   DetID::mask_t mDets; // detectors
@@ -152,6 +156,9 @@ class CTFWriterSpec : public o2::framework::Task
   int mRejRate = 0;                // CTF rejection rule (>0: percentage to reject randomly, <0: reject if timeslice%|value|!=0)
   int mCTFFileCompression = 0;     // CTF file compression level (if >= 0)
   bool mFillMD5 = false;
+  bool mFlatOutput = false; // write flat page-aligned CTF files instead of ROOT ones
+  bool mAsyncIO = false;    // write flat CTF images and finalize the closed files in background threads
+  CTFFlatFileWriter::Options mFlatOptions{};
   std::vector<uint32_t> mTFOrbits{}; // 1st orbits of TF accumulated in current file
   o2::framework::DataTakingContext mDataTakingContext{};
   o2::framework::TimingInfo mTimingInfo{};
@@ -170,6 +177,8 @@ class CTFWriterSpec : public o2::framework::Task
   int mLockFD = -1;
   std::unique_ptr<TFile> mCTFFileOut;
   std::unique_ptr<TTree> mCTFTreeOut;
+  std::unique_ptr<CTFFlatFileWriter> mCTFFlatOut;
+  std::unique_ptr<CTFIOQueue> mFileCloser; // finalization of the closed CTF files in the async mode
 
   std::unique_ptr<TFile> mDictFileOut; // file to store dictionary
   std::unique_ptr<TTree> mDictTreeOut; // tree to store dictionary
@@ -222,6 +231,18 @@ void CTFWriterSpec::init(InitContext& ic)
   mSaveDictAfter = ic.options().get<int>("save-dict-after");
   mCTFAutoSave = ic.options().get<long>("save-ctf-after");
   mCTFFileCompression = ic.options().get<int>("ctf-file-compression");
+  mFlatOutput = ic.options().get<bool>("flat-output");
+  mAsyncIO = ic.options().get<bool>("async-io");
+  mFlatOptions.async = mAsyncIO;
+  mFlatOptions.directIO = ic.options().get<bool>("direct-io");
+  mFlatOptions.maxQueued = std::max(int64_t(0), ic.options().get<int64_t>("io-queue-size"));
+  bool preallocate = ic.options().get<bool>("preallocate");
+  if (mAsyncIO) {
+    // the closed ROOT files are written while the next one is filled
+    ROOT::EnableThreadSafety();
+    mFileCloser = std::make_unique<CTFIOQueue>();
+    LOGP(info, "CTF files will be finalized in the background, flat CTF images queued up to {} bytes", mFlatOptions.maxQueued);
+  }
   mCTFMetaFileDir = ic.options().get<std::string>("meta-output-dir");
   if (mCTFMetaFileDir != "/dev/null") {
     mCTFMetaFileDir = o2::utils::Str::rectifyDirectory(mCTFMetaFileDir);
@@ -266,6 +287,10 @@ void CTFWriterSpec::init(InitContext& ic)
   mWaitDiskFullMax = 1000 * ic.options().get<float>("max-wait-for-free-disk");
 
   mChkSize = std::max(size_t(mMinSize * 1.1), mMaxSize);
+  if (preallocate) {
+    // the file can exceed mMinSize by one CTF, truncated at closing anyway
+    mFlatOptions.preallocate = mChkSize;
+  }
   o2::utils::createDirectoriesIfAbsent(LOCKFileDir);
 
   if (mCreateDict) { // make sure that there is no local dictonary
@@ -314,7 +339,7 @@ size_t CTFWriterSpec::processDet(o2::framework::ProcessingContext& pc, DetID det
     const auto ctfImage = C::getImage(bdata);
     ctfImage.print(o2::utils::Str::concat_string(det.getName(), ": "), mVerbosity);
     if (mWriteCTF && !mRejectCurrentTF) {
-      sz = ctfImage.appendToTree(*tree, det.getName());
+      sz = mCTFFlatOut ? mCTFFlatOut->addImage(det, ctfBuffer) : ctfImage.appendToTree(*tree, det.getName());
       header.detectors.set(det);
     } else {
       sz = ctfBuffer.size();
@@ -445,7 +470,7 @@ void CTFWriterSpec::run(ProcessingContext& pc)
       constexpr size_t MB = 1024 * 1024;
       constexpr int showFirstN = 10, prsecaleWarnings = 50;
       try {
-        const auto si = std::filesystem::space(mCTFFileOut->GetName());
+        const auto si = std::filesystem::space(mCTFFlatOut ? mCTFFlatOut->getFileName() : std::string(mCTFFileOut->GetName()));
         std::string wmsg{};
         if (mCheckDiskFull > 0.f && si.available < mCheckDiskFull) {
           nwaitCycles++;
@@ -459,6 +484,7 @@ void CTFWriterSpec::run(ProcessingContext& pc)
         if (nwaitCycles) {
           if (mWaitDiskFullMax > 0 && totalWait > mWaitDiskFullMax) {
             closeTFTreeAndFile(); // try to save whatever we have
+            waitForClosedFiles();
             LOGP(fatal, "Disk has {} MB available out of {} MB after waiting for {} ms", si.available / MB, si.capacity / MB, mWaitDiskFullMax);
           }
           if (nwaitCycles < showFirstN + 1 || (prsecaleWarnings && (nwaitCycles % prsecaleWarnings) == 0)) {
@@ -503,10 +529,18 @@ void CTFWriterSpec::run(ProcessingContext& pc)
   mTimer.Stop();
 
   if (mWriteCTF && !mRejectCurrentTF) {
-    szCTF += appendToTree(*mCTFTreeOut.get(), "CTFHeader", header);
+    if (mCTFFlatOut) {
+      mCTFFlatOut->closeEntry(header);
+      szCTF += sizeof(CTFFlatEntry);
+    } else {
+      szCTF += appendToTree(*mCTFTreeOut.get(), "CTFHeader", header);
+    }
     size_t prevSizeMB = mAccCTFSize / (1 << 20);
     mAccCTFSize += szCTF;
-    mCTFTreeOut->SetEntries(++mNAccCTF);
+    ++mNAccCTF;
+    if (mCTFTreeOut) {
+      mCTFTreeOut->SetEntries(mNAccCTF);
+    }
     mTFOrbits.push_back(mTimingInfo.firstTForbit);
     LOG(info) << "TF#" << mNCTF << ": wrote CTF{" << header << "} of size " << szCTF << " to " << mCurrentCTFFileNameFull << " in " << mTimer.CpuTime() - cput << " s";
     if (mNAccCTF > 1) {
@@ -522,7 +556,7 @@ void CTFWriterSpec::run(ProcessingContext& pc)
 
     if (mAccCTFSize >= mMinSize || (mMaxCTFPerFile > 0 && mNAccCTF >= mMaxCTFPerFile)) {
       closeTFTreeAndFile();
-    } else if ((mCTFAutoSave > 0 && mNAccCTF % mCTFAutoSave == 0) || (mCTFAutoSave < 0 && int(prevSizeMB / (-mCTFAutoSave)) != size_t(mAccCTFSize / (1 << 20)) / (-mCTFAutoSave))) {
+    } else if (mCTFTreeOut && ((mCTFAutoSave > 0 && mNAccCTF % mCTFAutoSave == 0) || (mCTFAutoSave < 0 && int(prevSizeMB / (-mCTFAutoSave)) != size_t(mAccCTFSize / (1 << 20)) / (-mCTFAutoSave)))) { // flat files are readable only once closed
       mCTFTreeOut->AutoSave("override");
     }
   } else {
@@ -550,6 +584,7 @@ void CTFWriterSpec::finalize()
   if (mWriteCTF) {
     closeTFTreeAndFile();
   }
+  waitForClosedFiles();
   LOGF(info, "CTF writing total timing: Cpu: %.3e Real: %.3e s in %d slots",
        mTimer.CpuTime(), mTimer.RealTime(), mTimer.Counter() - 1);
   mFinalized = true;
@@ -564,7 +599,7 @@ void CTFWriterSpec::prepareTFTreeAndFile()
     return;
   }
   bool needToOpen = false;
-  if (!mCTFTreeOut) {
+  if (!mCTFTreeOut && !mCTFFlatOut) {
     needToOpen = true;
   } else {
     if ((mAccCTFSize >= mMinSize) ||                                                         // min size exceeded, may close the file.
@@ -596,12 +631,19 @@ void CTFWriterSpec::prepareTFTreeAndFile()
       }
     }
     mCurrentCTFFileName = o2::base::NameConf::getCTFFileName(mTimingInfo.runNumber, mTimingInfo.firstTForbit, mTimingInfo.tfCounter, mHostName);
+    if (mFlatOutput) {
+      mCurrentCTFFileName = std::filesystem::path(mCurrentCTFFileName).replace_extension(CTFFlatFileWriter::FileExtension).string();
+    }
     mCurrentCTFFileNameFull = fmt::format("{}{}", ctfDir, mCurrentCTFFileName);
-    mCTFFileOut.reset(TFile::Open(fmt::format("{}{}", mCurrentCTFFileNameFull, TMPFileEnding).c_str(), "recreate")); // to prevent premature external usage, use temporary name
-    if (mCTFFileCompression >= 0) {
-      mCTFFileOut->SetCompressionLevel(mCTFFileCompression);
+    if (mFlatOutput) {
+      mCTFFlatOut = std::make_unique<CTFFlatFileWriter>(fmt::format("{}{}", mCurrentCTFFileNameFull, TMPFileEnding), mFlatOptions);
+    } else {
+      mCTFFileOut.reset(TFile::Open(fmt::format("{}{}", mCurrentCTFFileNameFull, TMPFileEnding).c_str(), "recreate")); // to prevent premature external usage, use temporary name
+      if (mCTFFileCompression >= 0) {
+        mCTFFileOut->SetCompressionLevel(mCTFFileCompression);
+      }
+      mCTFTreeOut = std::make_unique<TTree>(std::string(o2::base::NameConf::CTFTREENAME).c_str(), "O2 CTF tree");
     }
-    mCTFTreeOut = std::make_unique<TTree>(std::string(o2::base::NameConf::CTFTREENAME).c_str(), "O2 CTF tree");
 
     mNCTFFiles++;
   }
@@ -610,47 +652,82 @@ void CTFWriterSpec::prepareTFTreeAndFile()
 //___________________________________________________________________
 void CTFWriterSpec::closeTFTreeAndFile()
 {
-  if (mCTFTreeOut) {
-    try {
-      mCTFFileOut->cd();
-      mCTFTreeOut->Write();
-      mCTFTreeOut.reset();
-      mCTFFileOut->Close();
-      mCTFFileOut.reset();
-      // write CTF file metaFile data
-      auto actualFileName = TMPFileEnding.empty() ? mCurrentCTFFileNameFull : o2::utils::Str::concat_string(mCurrentCTFFileNameFull, TMPFileEnding);
-      if (mStoreMetaFile) {
-        o2::dataformats::FileMetaData ctfMetaData;
-        if (!ctfMetaData.fillFileData(actualFileName, mFillMD5, TMPFileEnding)) {
-          throw std::runtime_error("metadata file was requested but not created");
+  if (mCTFTreeOut || mCTFFlatOut) {
+    // everything needed to finalize the file is captured, so that the writing can go on with a new file
+    // while this one is closed in the background
+    auto closeFile = [flatOut = std::shared_ptr<CTFFlatFileWriter>(std::move(mCTFFlatOut)),
+                      fileOut = std::shared_ptr<TFile>(std::move(mCTFFileOut)),
+                      treeOut = std::shared_ptr<TTree>(std::move(mCTFTreeOut)),
+                      fileNameFull = mCurrentCTFFileNameFull, fileName = mCurrentCTFFileName,
+                      storeMetaFile = mStoreMetaFile, fillMD5 = mFillMD5, metaFileDir = mCTFMetaFileDir,
+                      dataTakingContext = mDataTakingContext, metaDataType = mMetaDataType,
+                      priority = std::string(mFallBackDirUsed ? "low" : "high"), tfOrbits = mTFOrbits,
+                      lockFD = mLockFD, lockFileName = mLockFileName]() mutable {
+      try {
+        if (flatOut) {
+          flatOut->close();
+          flatOut.reset();
+        } else {
+          fileOut->cd();
+          treeOut->Write();
+          treeOut.reset();
+          fileOut->Close();
+          fileOut.reset();
         }
-        ctfMetaData.setDataTakingContext(mDataTakingContext);
-        ctfMetaData.type = mMetaDataType;
-        ctfMetaData.priority = mFallBackDirUsed ? "low" : "high";
-        ctfMetaData.tfOrbits.swap(mTFOrbits);
-        auto metaFileNameTmp = fmt::format("{}{}.tmp", mCTFMetaFileDir, mCurrentCTFFileName);
-        auto metaFileName = fmt::format("{}{}.done", mCTFMetaFileDir, mCurrentCTFFileName);
-        try {
-          std::ofstream metaFileOut(metaFileNameTmp);
-          metaFileOut << ctfMetaData;
-          metaFileOut.close();
-          if (!TMPFileEnding.empty()) {
-            std::filesystem::rename(actualFileName, mCurrentCTFFileNameFull);
+        // write CTF file metaFile data
+        auto actualFileName = TMPFileEnding.empty() ? fileNameFull : o2::utils::Str::concat_string(fileNameFull, TMPFileEnding);
+        if (storeMetaFile) {
+          o2::dataformats::FileMetaData ctfMetaData;
+          if (!ctfMetaData.fillFileData(actualFileName, fillMD5, TMPFileEnding)) {
+            throw std::runtime_error("metadata file was requested but not created");
+          }
+          ctfMetaData.setDataTakingContext(dataTakingContext);
+          ctfMetaData.type = metaDataType;
+          ctfMetaData.priority = priority;
+          ctfMetaData.tfOrbits.swap(tfOrbits);
+          auto metaFileNameTmp = fmt::format("{}{}.tmp", metaFileDir, fileName);
+          auto metaFileName = fmt::format("{}{}.done", metaFileDir, fileName);
+          try {
+            std::ofstream metaFileOut(metaFileNameTmp);
+            metaFileOut << ctfMetaData;
+            metaFileOut.close();
+            if (!TMPFileEnding.empty()) {
+              std::filesystem::rename(actualFileName, fileNameFull);
+            }
+            std::filesystem::rename(metaFileNameTmp, metaFileName);
+          } catch (std::exception const& e) {
+            LOG(error) << "Failed to store CTF meta data file " << metaFileName << ", reason: " << e.what();
           }
-          std::filesystem::rename(metaFileNameTmp, metaFileName);
-        } catch (std::exception const& e) {
-          LOG(error) << "Failed to store CTF meta data file " << metaFileName << ", reason: " << e.what();
+        } else if (!TMPFileEnding.empty()) {
+          std::filesystem::rename(actualFileName, fileNameFull);
         }
-      } else if (!TMPFileEnding.empty()) {
-        std::filesystem::rename(actualFileName, mCurrentCTFFileNameFull);
+      } catch (std::exception const& e) {
+        LOG(error) << "Failed to finalize CTF file " << fileNameFull << ", reason: " << e.what();
       }
-    } catch (std::exception const& e) {
-      LOG(error) << "Failed to finalize CTF file " << mCurrentCTFFileNameFull << ", reason: " << e.what();
+      // the lock accounts for the disk space of the file until it is complete
+      releaseLockFile(lockFD, lockFileName);
+    };
+    mLockFD = -1;
+    if (mFileCloser) {
+      mFileCloser->push(std::move(closeFile));
+    } else {
+      closeFile();
     }
     mTFOrbits.clear();
     mNAccCTF = 0;
     mAccCTFSize = 0;
-    removeLockFile();
+  }
+}
+
+//___________________________________________________________________
+void CTFWriterSpec::waitForClosedFiles()
+{
+  if (mFileCloser) {
+    try {
+      mFileCloser->drain();
+    } catch (std::exception const& e) {
+      LOG(error) << "Failed to close CTF file in the background, reason: " << e.what();
+    }
   }
 }
 
@@ -739,6 +816,20 @@ void CTFWriterSpec::removeLockFile()
   }
 }
 
+//___________________________________________________________________
+void CTFWriterSpec::releaseLockFile(int fd, const std::string& name)
+{
+  // release the lock of a CTF file which was already closed, errors are only reported
+  if (fd != -1) {
+    if (lockf(fd, F_ULOCK, 0)) {
+      LOG(error) << "Error unlocking file " << name;
+    }
+    close(fd);
+    std::error_code ec;
+    std::filesystem::remove(name, ec); // use non-throwing version
+  }
+}
+
 //___________________________________________________________________
 size_t CTFWriterSpec::getAvailableDiskSpace(const std::string& path, int level)
 {
@@ -817,6 +908,11 @@ DataProcessorSpec getCTFWriterSpec(DetID::mask_t dets, const std::string& outTyp
             {"max-ctf-per-file", VariantType::Int, 0, {"if > 0, avoid storing more than requested CTFs per file"}},
             {"ctf-rejection", VariantType::Int, 0, {">0: percentage to reject randomly, <0: reject if timeslice%|value|!=0"}},
             {"ctf-file-compression", VariantType::Int, 0, {"if >= 0: impose CTF file compression level"}},
+            {"flat-output", VariantType::Bool, false, {"write flat page-aligned CTF files (.ctf) for mmap-based reading instead of ROOT ones"}},
+            {"async-io", VariantType::Bool, false, {"write flat CTF images in a background thread and close the CTF files in the background"}},
+            {"io-queue-size", VariantType::Int64, 1073741824ll, {"max. size of flat CTF images queued for background writing before blocking, 0: no limit"}},
+            {"direct-io", VariantType::Bool, false, {"write flat CTF files with O_DIRECT, bypassing the page cache"}},
+            {"preallocate", VariantType::Bool, false, {"preallocate flat CTF files to the max-file-size (or 1.1*min-file-size) on disk"}},
             {"require-free-disk", VariantType::Float, 0.f, {"pause writing op. if available disk space is below this margin, in bytes if >0, as a fraction of total if <0"}},
             {"wait-for-free-disk", VariantType::Float, 10.f, {"if paused due to the low disk space, recheck after this time (in s)"}},
             {"max-wait-for-free-disk", VariantType::Float, 60.f, {"produce fatal if paused due to the low disk space for more than this amount in s."}},
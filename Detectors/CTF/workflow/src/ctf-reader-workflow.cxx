@@ -39,6 +39,7 @@
 #include "CPVWorkflow/EntropyDecoderSpec.h"
 #include "ZDCWorkflow/EntropyDecoderSpec.h"
 #include "CTPWorkflow/EntropyDecoderSpec.h"
+#include "CTFWorkflow/CTFDecoderSpec.h"
 #ifdef WITH_OPENMP
 #include <omp.h>
 #endif
@@ -58,7 +59,7 @@ void customize(std::vector<o2::framework::ConfigParamSpec>& workflowOptions)
   options.push_back(ConfigParamSpec{"loop", VariantType::Int, 0, {"loop N times (infinite for N<0)"}});
   options.push_back(ConfigParamSpec{"delay", VariantType::Float, 0.f, {"delay in seconds between consecutive TFs sending"}});
   options.push_back(ConfigParamSpec{"copy-cmd", VariantType::String, "alien_cp ?src file://?dst", {"copy command for remote files or no-copy to avoid copying"}}); // Use "XrdSecPROTOCOL=sss,unix xrdcp -N root://eosaliceo2.cern.ch/?src ?dst" for direct EOS access
-  options.push_back(ConfigParamSpec{"ctf-file-regex", VariantType::String, ".*o2_ctf_run.+\\.root$", {"regex string to identify CTF files"}});
+  options.push_back(ConfigParamSpec{"ctf-file-regex", VariantType::String, ".*o2_ctf_run.+\\.(root|ctf)$", {"regex string to identify CTF files (ROOT or flat)"}});
   options.push_back(ConfigParamSpec{"remote-regex", VariantType::String, "^(alien://|)/alice/data/.+", {"regex string to identify remote files"}}); // Use "^/eos/aliceo2/.+" for direct EOS access
   options.push_back(ConfigParamSpec{"max-cached-files", VariantType::Int, 3, {"max CTF files queued (copied for remote source)"}});
   options.push_back(ConfigParamSpec{"allow-missing-detectors", VariantType::Bool, false, {"send empty message if detector is missing in the CTF (otherwise throw)"}});
@@ -68,6 +69,7 @@ void customize(std::vector<o2::framework::ConfigParamSpec>& workflowOptions)
   options.push_back(ConfigParamSpec{"configKeyValues", VariantType::String, "", {"Semicolon separated key=value strings"}});
   options.push_back(ConfigParamSpec{"ir-frames-files", VariantType::String, "", {"If non empty, inject selected IRFrames from this file"}});
   options.push_back(ConfigParamSpec{"skip-skimmed-out-tf", VariantType::Bool, false, {"Do not process TFs with empty IR-Frame coverage"}});
+  options.push_back(ConfigParamSpec{"select-ir-frames-in-decoders", VariantType::Bool, false, {"Apply the IR-Frames selection already in the entropy decoders supporting it (FT0, FV0, FDD)"}});
   //
   options.push_back(ConfigParamSpec{"its-digits", VariantType::Bool, false, {"convert ITS clusters to digits"}});
   options.push_back(ConfigParamSpec{"mft-digits", VariantType::Bool, false, {"convert MFT clusters to digits"}});
@@ -77,6 +79,8 @@ void customize(std::vector<o2::framework::ConfigParamSpec>& workflowOptions)
   options.push_back(ConfigParamSpec{"timeframes-shm-limit", VariantType::String, "0", {"Minimum amount of SHM required in order to publish data"}});
   options.push_back(ConfigParamSpec{"metric-feedback-channel-format", VariantType::String, "name=metric-feedback,type=pull,method=connect,address=ipc://{}metric-feedback-{},transport=shmem,rateLogging=0", {"format for the metric-feedback channel for TF rate limiting"}});
   options.push_back(ConfigParamSpec{"combine-devices", VariantType::Bool, false, {"combine multiple DPL devices (entropy decoders)"}});
+  options.push_back(ConfigParamSpec{"combined-decoder", VariantType::Bool, false, {"decode FT0,FV0,FDD,CTP,ZDC,CPV,MID,HMP in a single device instead of one decoder per detector"}});
+  options.push_back(ConfigParamSpec{"combined-decoder-threads", VariantType::Int, 0, {"number of threads of the combined decoder (<1: one per detector)"}});
   std::swap(workflowOptions, options);
 }
 
@@ -129,6 +133,7 @@ WorkflowSpec defineDataProcessing(ConfigContext const& configcontext)
   ctfInput.minSHM = std::stoul(configcontext.options().get<std::string>("timeframes-shm-limit"));
   ctfInput.fileIRFrames = configcontext.options().get<std::string>("ir-frames-files");
   ctfInput.skipSkimmedOutTF = configcontext.options().get<bool>("skip-skimmed-out-tf");
+  bool selIRDec = !ctfInput.fileIRFrames.empty() && configcontext.options().get<bool>("select-ir-frames-in-decoders");
   int verbosity = configcontext.options().get<int>("ctf-reader-verbosity");
 
   int rateLimitingIPCID = std::stoi(configcontext.options().get<std::string>("timeframes-rate-limit-ipcid"));
@@ -170,53 +175,63 @@ WorkflowSpec defineDataProcessing(ConfigContext const& configcontext)
     decSpecsV[mult - 1].push_back(s);
   };
 
-  // add decoders for all allowed detectors.
-  if (ctfInput.detMask[DetID::ITS]) {
+  // the small detectors are optionally decoded concurrently in a single device
+  auto decMask = ctfInput.detMask;
+  if (configcontext.options().get<bool>("combined-decoder")) {
+    auto combMask = decMask & o2::ctf::getCombinedDecoderMask();
+    if (combMask.any()) {
+      addSpecs(o2::ctf::getCombinedDecoderSpec(combMask, verbosity, ctfInput.subspec, configcontext.options().get<int>("combined-decoder-threads")));
+      decMask &= ~combMask;
+    }
+  }
+
+  // add decoders for all remaining allowed detectors.
+  if (decMask[DetID::ITS]) {
     addSpecs(o2::itsmft::getEntropyDecoderSpec(DetID::getDataOrigin(DetID::ITS), verbosity, configcontext.options().get<bool>("its-digits"), ctfInput.subspec));
   }
-  if (ctfInput.detMask[DetID::MFT]) {
+  if (decMask[DetID::MFT]) {
     addSpecs(o2::itsmft::getEntropyDecoderSpec(DetID::getDataOrigin(DetID::MFT), verbosity, configcontext.options().get<bool>("mft-digits"), ctfInput.subspec));
   }
-  if (ctfInput.detMask[DetID::TPC]) {
+  if (decMask[DetID::TPC]) {
     addSpecs(o2::tpc::getEntropyDecoderSpec(verbosity, ctfInput.subspec));
   }
-  if (ctfInput.detMask[DetID::TRD]) {
+  if (decMask[DetID::TRD]) {
     addSpecs(o2::trd::getEntropyDecoderSpec(verbosity, ctfInput.subspec));
   }
-  if (ctfInput.detMask[DetID::TOF]) {
+  if (decMask[DetID::TOF]) {
     addSpecs(o2::tof::getEntropyDecoderSpec(verbosity, ctfInput.subspec));
   }
-  if (ctfInput.detMask[DetID::FT0]) {
-    addSpecs(o2::ft0::getEntropyDecoderSpec(verbosity, ctfInput.subspec));
+  if (decMask[DetID::FT0]) {
+    addSpecs(o2::ft0::getEntropyDecoderSpec(verbosity, ctfInput.subspec, selIRDec));
   }
-  if (ctfInput.detMask[DetID::FV0]) {
-    addSpecs(o2::fv0::getEntropyDecoderSpec(verbosity, ctfInput.subspec));
+  if (decMask[DetID::FV0]) {
+    addSpecs(o2::fv0::getEntropyDecoderSpec(verbosity, ctfInput.subspec, selIRDec));
   }
-  if (ctfInput.detMask[DetID::FDD]) {
-    addSpecs(o2::fdd::getEntropyDecoderSpec(verbosity, ctfInput.subspec));
+  if (decMask[DetID::FDD]) {
+    addSpecs(o2::fdd::getEntropyDecoderSpec(verbosity, ctfInput.subspec, selIRDec));
   }
-  if (ctfInput.detMask[DetID::MID]) {
+  if (decMask[DetID::MID]) {
     addSpecs(o2::mid::getEntropyDecoderSpec(verbosity, ctfInput.subspec));
   }
-  if (ctfInput.detMask[DetID::MCH]) {
+  if (decMask[DetID::MCH]) {
     addSpecs(o2::mch::getEntropyDecoderSpec(verbosity, "mch-entropy-decoder", ctfInput.subspec));
   }
-  if (ctfInput.detMask[DetID::EMC]) {
+  if (decMask[DetID::EMC]) {
     addSpecs(o2::emcal::getEntropyDecoderSpec(verbosity, ctfInput.subspec, ctfInput.decSSpecEMC));
   }
-  if (ctfInput.detMask[DetID::PHS]) {
+  if (decMask[DetID::PHS]) {
     addSpecs(o2::phos::getEntropyDecoderSpec(verbosity, ctfInput.subspec));
   }
-  if (ctfInput.detMask[DetID::CPV]) {
+  if (decMask[DetID::CPV]) {
     addSpecs(o2::cpv::getEntropyDecoderSpec(verbosity, ctfInput.subspec));
   }
-  if (ctfInput.detMask[DetID::ZDC]) {
+  if (decMask[DetID::ZDC]) {
     addSpecs(o2::zdc::getEntropyDecoderSpec(verbosity, ctfInput.subspec));
   }
-  if (ctfInput.detMask[DetID::HMP]) {
+  if (decMask[DetID::HMP]) {
     addSpecs(o2::hmpid::getEntropyDecoderSpec(verbosity, ctfInput.subspec));
   }
-  if (ctfInput.detMask[DetID::CTP]) {
+  if (decMask[DetID::CTP]) {
     addSpecs(o2::ctp::getEntropyDecoderSpec(verbosity, ctfInput.subspec));
   }
 
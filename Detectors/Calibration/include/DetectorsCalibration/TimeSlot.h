@@ -39,6 +39,7 @@ class TimeSlot
   {
     mContainer = src.mContainer ? std::make_unique<Container>(*src.mContainer) : nullptr;
   }
+  TimeSlot(TimeSlot&& src) = default;
   TimeSlot& operator=(TimeSlot&& src) = default;
 
   ~TimeSlot() = default;
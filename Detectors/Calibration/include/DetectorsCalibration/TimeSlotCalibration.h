@@ -26,6 +26,10 @@
 #include <limits>
 #include <type_traits>
 #include <unistd.h>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
 
 namespace o2
 {
@@ -46,7 +50,7 @@ class TimeSlotCalibration
   static constexpr TFType INFINITE_TF = o2::calibration::INFINITE_TF;
 
   TimeSlotCalibration() = default;
-  virtual ~TimeSlotCalibration() = default;
+  virtual ~TimeSlotCalibration() { stopFinalizationWorker(); }
   float getMaxSlotsDelay() const { return mMaxSlotsDelay; }
   void setMaxSlotsDelay(float v) { mMaxSlotsDelay = v > 0. ? v : 0.; }
 
@@ -111,6 +115,7 @@ class TimeSlotCalibration
 
   virtual void reset()
   { // reset to virgin state (need for start - stop - start)
+    waitForFinalizations();
     mSlots.clear();
     mLastClosedTF = 0;
     mFirstTF = 0;
@@ -133,6 +138,31 @@ class TimeSlotCalibration
 
   virtual void print() const;
 
+  // Asynchronous finalization: the slots which are closed are moved to a queue and finalized by a worker thread,
+  // so that the filling of the new TFs is not blocked by slow finalizations. At most maxPendingSlots slots are
+  // kept in the queue; if more slots are closed, the calling thread waits until a slot was finalized.
+  // The finalizeSlot of the derived class must then only access the slot and the output, and the output has to be
+  // accessed only while holding the lock returned by getOutputLock(). The end of run (TF = INFINITE_TF),
+  // finalizeOldestSlot and reset are always processed synchronously, after all the queued slots were finalized.
+  // Derived classes using it should call waitForFinalizations() in their destructor.
+  void setAsyncFinalization(bool v, size_t maxPendingSlots = 2)
+  {
+    waitForFinalizations();
+    mAsyncFinalization = v;
+    mMaxPendingSlots = maxPendingSlots > 0 ? maxPendingSlots : 1;
+  }
+  bool isAsyncFinalization() const { return mAsyncFinalization; }
+  size_t getMaxPendingSlots() const { return mMaxPendingSlots; }
+  // number of slots which are waiting for or are in the finalization
+  size_t getNPendingSlots() const;
+  // block until all queued slots were finalized
+  void waitForFinalizations();
+  // lock protecting the output filled by finalizeSlot, not locked if the asynchronous finalization is not used
+  std::unique_lock<std::mutex> getOutputLock()
+  {
+    return mAsyncFinalization ? std::unique_lock<std::mutex>(getFinalizationWorker().outputMutex) : std::unique_lock<std::mutex>();
+  }
+
   const o2::dataformats::TFIDInfo& getCurrentTFInfo() const { return mCurrentTFInfo; }
   o2::dataformats::TFIDInfo& getCurrentTFInfo() { return mCurrentTFInfo; }
 
@@ -220,6 +250,9 @@ class TimeSlotCalibration
 
   TFType tf2SlotMin(TFType tf) const;
 
+  // finalize the slot directly or move it to the queue of the asynchronous finalization
+  void finalizeOrQueueSlot(Slot& slot, bool sync);
+
   std::deque<Slot> mSlots;
 
   o2::dataformats::TFIDInfo mCurrentTFInfo{};
@@ -249,6 +282,25 @@ class TimeSlotCalibration
   TimeSlotMetaData mSaveMetaData{};
   bool mSavedSlotAllowed = false;
 
+  bool mAsyncFinalization = false; // finalize the slots in a worker thread
+  size_t mMaxPendingSlots = 2;     // max. number of slots queued for the asynchronous finalization
+
+ private:
+  struct FinalizationWorker {
+    std::thread thread;
+    mutable std::mutex queueMutex;
+    std::mutex outputMutex;
+    std::condition_variable cv;
+    std::deque<Slot> queue; // slots waiting for the finalization, the front one is the one being finalized
+    bool stop = false;
+  };
+
+  FinalizationWorker& getFinalizationWorker();
+  void runFinalizationWorker();
+  void stopFinalizationWorker();
+
+  std::unique_ptr<FinalizationWorker> mWorker; //! worker for the asynchronous finalization
+
   ClassDef(TimeSlotCalibration, 1);
 };
 
@@ -320,7 +372,7 @@ void TimeSlotCalibration<Container>::checkSlotsToFinalize(TFType tf, int maxDela
         mSlots[0].setTFStart(mLastClosedTF);
         mSlots[0].setTFEnd(mMaxSeenTF);
         LOG(info) << "Finalizing slot for " << mSlots[0].getTFStart() << " <= TF <= " << mSlots[0].getTFEnd();
-        finalizeSlot(mSlots[0]);                  // will be removed after finalization
+        finalizeOrQueueSlot(mSlots[0], tf == INFINITE_TF); // will be removed after finalization
         mLastClosedTF = mSlots[0].getTFEnd() < INFINITE_TF ? (mSlots[0].getTFEnd() + 1) : mSlots[0].getTFEnd() < INFINITE_TF; // will not accept any TF below this
         mSlots.erase(mSlots.begin());
         // creating a new slot if we are not at the end of run
@@ -344,7 +396,7 @@ void TimeSlotCalibration<Container>::checkSlotsToFinalize(TFType tf, int maxDela
       if (tfLim < tf) {
         if (hasEnoughData(*slot)) {
           LOG(debug) << "Finalizing slot for " << slot->getTFStart() << " <= TF <= " << slot->getTFEnd();
-          finalizeSlot(*slot); // will be removed after finalization
+          finalizeOrQueueSlot(*slot, tf == INFINITE_TF); // will be removed after finalization
         } else if ((slot + 1) != mSlots.end()) {
           LOG(info) << "Merging underpopulated slot " << slot->getTFStart() << " <= TF <= " << slot->getTFEnd()
                     << " to slot " << (slot + 1)->getTFStart() << " <= TF <= " << (slot + 1)->getTFEnd();
@@ -372,11 +424,111 @@ void TimeSlotCalibration<Container>::finalizeOldestSlot()
     LOG(warning) << "There are no slots defined";
     return;
   }
-  finalizeSlot(mSlots.front());
+  finalizeOrQueueSlot(mSlots.front(), true);
   mLastClosedTF = mSlots.front().getTFEnd() + 1; // do not accept any TF below this
   mSlots.erase(mSlots.begin());
 }
 
+//_________________________________________________
+template <typename Container>
+void TimeSlotCalibration<Container>::finalizeOrQueueSlot(Slot& slot, bool sync)
+{
+  if (!mAsyncFinalization) {
+    finalizeSlot(slot);
+    return;
+  }
+  if (sync) {
+    waitForFinalizations();
+    auto lock = getOutputLock();
+    finalizeSlot(slot);
+    return;
+  }
+  auto& worker = getFinalizationWorker();
+  std::unique_lock<std::mutex> lock(worker.queueMutex);
+  if (worker.queue.size() >= mMaxPendingSlots) {
+    LOG(info) << "Waiting for the finalization of " << worker.queue.size() << " slots";
+    worker.cv.wait(lock, [&worker, this] { return worker.queue.size() < mMaxPendingSlots; });
+  }
+  worker.queue.emplace_back(std::move(slot)); // the slot is erased by the caller, its container is now owned by the queue
+  lock.unlock();
+  worker.cv.notify_all();
+}
+
+//_________________________________________________
+template <typename Container>
+typename TimeSlotCalibration<Container>::FinalizationWorker& TimeSlotCalibration<Container>::getFinalizationWorker()
+{
+  if (!mWorker) {
+    mWorker = std::make_unique<FinalizationWorker>();
+    mWorker->thread = std::thread(&TimeSlotCalibration<Container>::runFinalizationWorker, this);
+  }
+  return *mWorker;
+}
+
+//_________________________________________________
+template <typename Container>
+void TimeSlotCalibration<Container>::runFinalizationWorker()
+{
+  auto& worker = *mWorker;
+  std::unique_lock<std::mutex> lock(worker.queueMutex);
+  while (true) {
+    worker.cv.wait(lock, [&worker] { return worker.stop || !worker.queue.empty(); });
+    if (worker.stop) {
+      break;
+    }
+    auto& slot = worker.queue.front(); // stays in the queue during the finalization, references to deque elements are stable on emplace_back
+    lock.unlock();
+    {
+      std::lock_guard<std::mutex> outputLock(worker.outputMutex);
+      finalizeSlot(slot);
+    }
+    lock.lock();
+    worker.queue.pop_front();
+    worker.cv.notify_all();
+  }
+}
+
+//_________________________________________________
+template <typename Container>
+void TimeSlotCalibration<Container>::waitForFinalizations()
+{
+  if (!mWorker) {
+    return;
+  }
+  std::unique_lock<std::mutex> lock(mWorker->queueMutex);
+  mWorker->cv.wait(lock, [this] { return mWorker->queue.empty(); });
+}
+
+//_________________________________________________
+template <typename Container>
+size_t TimeSlotCalibration<Container>::getNPendingSlots() const
+{
+  if (!mWorker) {
+    return 0;
+  }
+  std::lock_guard<std::mutex> lock(mWorker->queueMutex);
+  return mWorker->queue.size();
+}
+
+//_________________________________________________
+template <typename Container>
+void TimeSlotCalibration<Container>::stopFinalizationWorker()
+{
+  if (!mWorker) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mWorker->queueMutex);
+    if (!mWorker->queue.empty()) {
+      LOG(warning) << "Stopping the finalization worker with " << mWorker->queue.size() << " pending slots";
+    }
+    mWorker->stop = true;
+  }
+  mWorker->cv.notify_all();
+  mWorker->thread.join();
+  mWorker.reset();
+}
+
 //________________________________________
 template <typename Container>
 inline TFType TimeSlotCalibration<Container>::tf2SlotMin(TFType tf) const
@@ -188,13 +188,13 @@ class DataPointIdentifier final
   /**
          * Returns a hash code calculated from the alias. <em>Note that the
          * hash code is recalculated every time when this function is called.
-         * </em>
+         * </em> The alias is hashed in place, without copying it to a string.
          *
          * @return An unsigned integer.
          */
   inline size_t hash_code() const noexcept
   {
-    return o2::dcs::hash_code(std::string((char*)&pt1));
+    return o2::dcs::hash_code((const char*)&pt1, strnlen((const char*)&pt1, 63));
   }
 
   /**
@@ -0,0 +1,90 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef O2_DCS_DATAPOINT_REGISTRY_H
+#define O2_DCS_DATAPOINT_REGISTRY_H
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <gsl/span>
+#include "DetectorsDCS/DataPointCompositeObject.h"
+#include "DetectorsDCS/DataPointIdentifier.h"
+#include "DetectorsDCS/DataPointValue.h"
+#include "DetectorsDCS/DeliveryType.h"
+
+namespace o2::dcs
+{
+
+/**
+  * Compact representation of a batch of data points: the 64-byte
+  * DataPointIdentifier of each data point is replaced by its integer ID
+  * in a DataPointRegistry.
+  */
+struct IndexedDataPointBatch {
+  std::vector<uint32_t> ids;          ///< registry ID of each data point
+  std::vector<DataPointValue> values; ///< value of each data point
+
+  size_t size() const { return ids.size(); }
+  void clear()
+  {
+    ids.clear();
+    values.clear();
+  }
+};
+
+/**
+  * DataPointRegistry assigns dense integer IDs (in the order of registration)
+  * to the data points a processor is interested in, so that the alias lookup
+  * is done once per data point and the processors can then use the IDs as
+  * indices of flat arrays.
+  */
+class DataPointRegistry
+{
+ public:
+  using ID = uint32_t;
+  static constexpr ID INVALID = std::numeric_limits<ID>::max();
+
+  /// register a data point, returns its ID (the existing one if already registered)
+  ID add(const DataPointIdentifier& dpid);
+
+  /// register all aliases obtained by expanding the patterns (see expandAliases) with the given type
+  void add(const std::vector<std::string>& patternedAliases, DeliveryType type);
+
+  /// ID of a data point, INVALID if not registered
+  ID getID(const DataPointIdentifier& dpid) const
+  {
+    auto it = mIDs.find(dpid);
+    return it == mIDs.end() ? INVALID : it->second;
+  }
+
+  const DataPointIdentifier& getDPID(ID id) const { return mDPIDs[id]; }
+  const std::vector<DataPointIdentifier>& getDPIDs() const { return mDPIDs; }
+  size_t size() const { return mDPIDs.size(); }
+  void clear();
+
+  /// convert the data points to the compact representation, appending to batch.
+  /// Data points which are not registered are dropped, their number is returned
+  size_t pack(gsl::span<const DataPointCompositeObject> dps, IndexedDataPointBatch& batch) const;
+
+  /// convert a compact batch back to data points, appending to dps
+  void unpack(const IndexedDataPointBatch& batch, std::vector<DataPointCompositeObject>& dps) const;
+
+ private:
+  std::vector<DataPointIdentifier> mDPIDs;
+  std::unordered_map<DataPointIdentifier, ID> mIDs;
+};
+
+} // namespace o2::dcs
+
+#endif
@@ -0,0 +1,45 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef O2_DCS_DELTA_COMPRESSION_H
+#define O2_DCS_DELTA_COMPRESSION_H
+
+#include <cstdint>
+#include <vector>
+#include <gsl/span>
+
+namespace o2::dcs
+{
+
+/**
+  * Lossless compression of DCS time series before they are stored.
+  *
+  * The residuals of consecutive values are computed in a separate pass
+  * (which the compiler can vectorise) and are then written as variable
+  * length integers (7 bits per byte), so that small residuals take 1 or 2
+  * bytes instead of 8.
+  */
+
+/// encode the differences between consecutive values (e.g. time stamps in ms), appending to out
+void encodeDeltas(gsl::span<const uint64_t> values, std::vector<uint8_t>& out);
+
+/// decode n values written by encodeDeltas, appending to out. Returns the number of bytes read, 0 on error
+size_t decodeDeltas(gsl::span<const uint8_t> in, size_t n, std::vector<uint64_t>& out);
+
+/// encode the XOR between consecutive bit patterns (e.g. of slowly varying double values), appending to out
+void encodeXors(gsl::span<const uint64_t> values, std::vector<uint8_t>& out);
+
+/// decode n values written by encodeXors, appending to out. Returns the number of bytes read, 0 on error
+size_t decodeXors(gsl::span<const uint8_t> in, size_t n, std::vector<uint64_t>& out);
+
+} // namespace o2::dcs
+
+#endif
@@ -64,6 +64,16 @@ std::string random_string2(const size_t length) noexcept;
      */
 uint64_t hash_code(const std::string& input) noexcept;
 
+/**
+     * Same as hash_code(const std::string&), for a character array of the
+     * given length, without making a copy of it.
+     *
+     * @param input  Pointer to the characters.
+     * @param length Number of characters.
+     * @return       An unsigned integer.
+     */
+uint64_t hash_code(const char* input, size_t length) noexcept;
+
 /**
     * Converts the C-style strings of the command line parameters to a more
     * civilized data type.
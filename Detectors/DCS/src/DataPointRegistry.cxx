@@ -0,0 +1,68 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "DetectorsDCS/DataPointRegistry.h"
+#include "DetectorsDCS/AliasExpander.h"
+
+namespace o2::dcs
+{
+
+DataPointRegistry::ID DataPointRegistry::add(const DataPointIdentifier& dpid)
+{
+  auto [it, inserted] = mIDs.try_emplace(dpid, ID(mDPIDs.size()));
+  if (inserted) {
+    mDPIDs.push_back(dpid);
+  }
+  return it->second;
+}
+
+void DataPointRegistry::add(const std::vector<std::string>& patternedAliases, DeliveryType type)
+{
+  const auto aliases = expandAliases(patternedAliases);
+  mDPIDs.reserve(mDPIDs.size() + aliases.size());
+  mIDs.reserve(mDPIDs.size() + aliases.size());
+  for (const auto& alias : aliases) {
+    add(DataPointIdentifier(alias, type));
+  }
+}
+
+void DataPointRegistry::clear()
+{
+  mDPIDs.clear();
+  mIDs.clear();
+}
+
+size_t DataPointRegistry::pack(gsl::span<const DataPointCompositeObject> dps, IndexedDataPointBatch& batch) const
+{
+  size_t nUnknown = 0;
+  batch.ids.reserve(batch.ids.size() + dps.size());
+  batch.values.reserve(batch.values.size() + dps.size());
+  for (const auto& dp : dps) {
+    const auto id = getID(dp.id);
+    if (id == INVALID) {
+      nUnknown++;
+      continue;
+    }
+    batch.ids.push_back(id);
+    batch.values.push_back(dp.data);
+  }
+  return nUnknown;
+}
+
+void DataPointRegistry::unpack(const IndexedDataPointBatch& batch, std::vector<DataPointCompositeObject>& dps) const
+{
+  dps.reserve(dps.size() + batch.size());
+  for (size_t i = 0; i < batch.size(); i++) {
+    dps.emplace_back(mDPIDs[batch.ids[i]], batch.values[i]);
+  }
+}
+
+} // namespace o2::dcs
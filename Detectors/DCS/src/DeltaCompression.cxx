@@ -0,0 +1,113 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "DetectorsDCS/DeltaCompression.h"
+
+namespace
+{
+void writeVarInt(uint64_t value, std::vector<uint8_t>& out)
+{
+  while (value >= 0x80) {
+    out.push_back(uint8_t(value) | 0x80);
+    value >>= 7;
+  }
+  out.push_back(uint8_t(value));
+}
+
+// reads the varints of the residuals, returns the number of bytes read or 0 if the input is truncated
+size_t readVarInts(gsl::span<const uint8_t> in, size_t n, uint64_t* residuals)
+{
+  size_t pos = 0;
+  for (size_t i = 0; i < n; i++) {
+    uint64_t value = 0;
+    int shift = 0;
+    while (true) {
+      if (pos >= in.size() || shift > 63) {
+        return 0;
+      }
+      const uint8_t byte = in[pos++];
+      value |= uint64_t(byte & 0x7f) << shift;
+      if (!(byte & 0x80)) {
+        break;
+      }
+      shift += 7;
+    }
+    residuals[i] = value;
+  }
+  return pos;
+}
+} // namespace
+
+namespace o2::dcs
+{
+
+void encodeDeltas(gsl::span<const uint64_t> values, std::vector<uint8_t>& out)
+{
+  std::vector<uint64_t> residuals(values.size());
+  for (size_t i = 0; i < values.size(); i++) {
+    // zigzag encoding of the signed difference, so that small negative differences stay small
+    const int64_t delta = int64_t(values[i] - (i ? values[i - 1] : 0));
+    residuals[i] = (uint64_t(delta) << 1) ^ uint64_t(delta >> 63);
+  }
+  out.reserve(out.size() + values.size() * 2);
+  for (auto residual : residuals) {
+    writeVarInt(residual, out);
+  }
+}
+
+size_t decodeDeltas(gsl::span<const uint8_t> in, size_t n, std::vector<uint64_t>& out)
+{
+  const size_t first = out.size();
+  out.resize(first + n);
+  const size_t nBytes = readVarInts(in, n, out.data() + first);
+  if (n && !nBytes) {
+    out.resize(first);
+    return 0;
+  }
+  uint64_t previous = 0;
+  for (size_t i = first; i < out.size(); i++) {
+    previous += (out[i] >> 1) ^ (0 - (out[i] & 1));
+    out[i] = previous;
+  }
+  return nBytes;
+}
+
+void encodeXors(gsl::span<const uint64_t> values, std::vector<uint8_t>& out)
+{
+  std::vector<uint64_t> residuals(values.size());
+  for (size_t i = 0; i < values.size(); i++) {
+    residuals[i] = values[i] ^ (i ? values[i - 1] : 0);
+  }
+  out.reserve(out.size() + values.size() * 4);
+  for (auto residual : residuals) {
+    // close floating point values share sign, exponent and leading mantissa bits: their XOR has many leading zeros
+    writeVarInt(residual, out);
+  }
+}
+
+size_t decodeXors(gsl::span<const uint8_t> in, size_t n, std::vector<uint64_t>& out)
+{
+  const size_t first = out.size();
+  out.resize(first + n);
+  const size_t nBytes = readVarInts(in, n, out.data() + first);
+  if (n && !nBytes) {
+    out.resize(first);
+    return 0;
+  }
+  uint64_t previous = 0;
+  for (size_t i = first; i < out.size(); i++) {
+    previous ^= out[i];
+    out[i] = previous;
+  }
+  return nBytes;
+}
+
+} // namespace o2::dcs
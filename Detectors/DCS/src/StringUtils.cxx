@@ -223,9 +223,14 @@ string o2::dcs::random_string2(const size_t length) noexcept
 }
 
 uint64_t o2::dcs::hash_code(const std::string& input) noexcept
+{
+  return hash_code(input.data(), input.length());
+}
+
+uint64_t o2::dcs::hash_code(const char* input, size_t inputLength) noexcept
 {
   size_t result(0);
-  const size_t length(min(input.length(), (string::size_type)52));
+  const size_t length(min(inputLength, (size_t)52));
   for (size_t i = 0; i < length; ++i) {
     //        result += exp(PRIMES[i], (uint8_t) input[i]);
     result += exp(PRIMES[i], lookup(input[i]));
@@ -0,0 +1,83 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test DCS DataPointRegistry
+#define BOOST_TEST_MAIN
+
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include <cstring>
+#include "DetectorsDCS/DataPointCreator.h"
+#include "DetectorsDCS/DataPointRegistry.h"
+#include "DetectorsDCS/DeltaCompression.h"
+
+using namespace o2::dcs;
+
+BOOST_AUTO_TEST_CASE(RegistryAssignsDenseIDs)
+{
+  DataPointRegistry registry;
+  registry.add({"TST/Channel[00..02]/vMon"}, DeliveryType::DPVAL_DOUBLE);
+  BOOST_CHECK_EQUAL(registry.size(), 3);
+  BOOST_CHECK_EQUAL(registry.getID(DataPointIdentifier("TST/Channel01/vMon", DeliveryType::DPVAL_DOUBLE)), 1);
+  BOOST_CHECK_EQUAL(registry.add(DataPointIdentifier("TST/Channel01/vMon", DeliveryType::DPVAL_DOUBLE)), 1);
+  BOOST_CHECK_EQUAL(registry.getID(DataPointIdentifier("TST/Channel03/vMon", DeliveryType::DPVAL_DOUBLE)), DataPointRegistry::INVALID);
+  BOOST_CHECK_EQUAL(std::string(registry.getDPID(2).get_alias()), "TST/Channel02/vMon");
+}
+
+BOOST_AUTO_TEST_CASE(PackAndUnpackBatch)
+{
+  DataPointRegistry registry;
+  registry.add({"TST/Channel[00..02]/vMon"}, DeliveryType::DPVAL_DOUBLE);
+  std::vector<DataPointCompositeObject> dps;
+  dps.emplace_back(createDataPointCompositeObject("TST/Channel02/vMon", 2., 100, 1));
+  dps.emplace_back(createDataPointCompositeObject("TST/Unknown/vMon", 3., 100, 2));
+  dps.emplace_back(createDataPointCompositeObject("TST/Channel00/vMon", 4., 101, 3));
+
+  IndexedDataPointBatch batch;
+  BOOST_CHECK_EQUAL(registry.pack(dps, batch), 1);
+  BOOST_CHECK_EQUAL(batch.size(), 2);
+  BOOST_CHECK_EQUAL(batch.ids[0], 2);
+  BOOST_CHECK_EQUAL(batch.ids[1], 0);
+
+  std::vector<DataPointCompositeObject> unpacked;
+  registry.unpack(batch, unpacked);
+  BOOST_CHECK_EQUAL(unpacked.size(), 2);
+  BOOST_CHECK(unpacked[0] == dps[0]);
+  BOOST_CHECK(unpacked[1] == dps[2]);
+}
+
+BOOST_AUTO_TEST_CASE(DeltaCompressionRoundTrip)
+{
+  std::vector<uint64_t> times{1650000000000, 1650000000100, 1650000000200, 1650000000150, 1650000010000};
+  std::vector<uint8_t> buffer;
+  encodeDeltas(times, buffer);
+  BOOST_CHECK(buffer.size() < times.size() * sizeof(uint64_t));
+  std::vector<uint64_t> decoded;
+  BOOST_CHECK_EQUAL(decodeDeltas(buffer, times.size(), decoded), buffer.size());
+  BOOST_TEST(decoded == times, boost::test_tools::per_element());
+  // truncated input
+  decoded.clear();
+  BOOST_CHECK_EQUAL(decodeDeltas(gsl::span<const uint8_t>(buffer.data(), buffer.size() - 1), times.size(), decoded), 0);
+  BOOST_CHECK(decoded.empty());
+
+  std::vector<uint64_t> values;
+  for (double v : {1400.1, 1400.1, 1400.2, 1399.9, -3.}) {
+    uint64_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    values.push_back(bits);
+  }
+  buffer.clear();
+  encodeXors(values, buffer);
+  decoded.clear();
+  BOOST_CHECK_EQUAL(decodeXors(buffer, values.size(), decoded), buffer.size());
+  BOOST_TEST(decoded == values, boost::test_tools::per_element());
+}
@@ -362,6 +362,7 @@ class AltroDecoder
   RCUTrailer mRCUTrailer;                                    ///< RCU trailer
   std::vector<Channel> mChannels;                            ///< vector of channels in the raw stream
   std::vector<MinorAltroDecodingError> mMinorDecodingErrors; ///< Container for minor (non-crashing) errors
+  std::vector<uint16_t> mBunchWords;                         ///< 10-bit words of the channel being decoded, buffer reused for all channels
   bool mChannelsInitialized = false;                         ///< check whether the channels are initialized
   unsigned int mMaxBunchLength = UINT_MAX;                   ///< Max bunch length
 
@@ -31,6 +31,8 @@ namespace emcal
 // Define numbers rows/columns for topological representation of cells
 constexpr unsigned int NROWS = (24 + 1) * (6 + 4); // 10x supermodule rows (6 for EMCAL, 4 for DCAL). +1 accounts for topological gap between two supermodules
 constexpr unsigned int NCOLS = 48 * 2 + 1;         // 2x  supermodule columns + 1 empty space in between for DCAL (not used for EMCAL)
+constexpr unsigned int NROWSSMROW = 24 + 1;          // rows of one row of supermodules including the topological gap
+constexpr unsigned int NSMROWS = NROWS / NROWSSMROW; // number of supermodule rows, clusters cannot extend over two of them
 
 using ClusterIndex = int;
 
@@ -81,6 +83,15 @@ class Clusterizer
     ClusterIndex mIndex;     ///< index of the cluster
   };
 
+  /// \struct SMRowClusters
+  /// \brief Clusters found in one row of supermodules
+  struct SMRowClusters {
+    std::vector<Cluster> mClusters;             ///< clusters, cell indices relative to mInputIndices
+    std::vector<ClusterIndex> mInputIndices;    ///< associated cell/digit indices, ordered by cluster
+    std::vector<float> mSeedEnergies;           ///< energy of the seed of each cluster
+    std::vector<InputwithIndex> mClusterInputs; ///< buffer for the cells/digits of the cluster being built
+  };
+
  public:
   /// \brief Main constructor
   /// \param timeCut Max. time difference of cells in cluster in ns
@@ -117,7 +128,10 @@ class Clusterizer
 
   /// \brief Find clusters based on a give input collection.
   ///
-  /// Start clustering from highest energy cell.
+  /// Start clustering from highest energy cell. The rows of supermodules
+  /// are separated by a gap, they are clustered independently and in parallel
+  /// if more than one thread is set. The clusters are ordered by decreasing
+  /// seed energy.
   ///
   /// \param inputArray Input collection of cells/digits
   void findClusters(const gsl::span<InputType const>& inputArray);
@@ -138,6 +152,14 @@ class Clusterizer
   /// \return EMCAL geometry
   Geometry* getGeometry() { return mEMCALGeometry; }
 
+  /// \brief Set number of threads used to cluster the rows of supermodules
+  /// \param nThreads Number of threads
+  void setNThreads(int nThreads) { mNThreads = nThreads > 0 ? nThreads : 1; }
+
+  /// \brief Get number of threads
+  /// \return Number of threads
+  int getNThreads() const { return mNThreads; }
+
  private:
   /// \brief Recursively search for neighbours (EMCAL)
   /// \param[in,out] clusterInputs Cells/digits of prototype cluster
@@ -145,6 +167,12 @@ class Clusterizer
   /// \param column Column number for neighbor search in recursion step
   void getClusterFromNeighbours(std::vector<InputwithIndex>& clusterInputs, int row, int column);
 
+  /// \brief Find clusters in one row of supermodules
+  /// \param seeds Seeds of the supermodule row, sorted in ascending energy
+  /// \param nSeeds Number of seeds
+  /// \param[out] output Clusters found in the supermodule row
+  void findClustersSMRow(const cellWithE* seeds, int nSeeds, SMRowClusters& output);
+
   /// \brief Get row (phi) and column (eta) of a cell/digit, values corresponding to topology
   /// \param input Input object (cell/digit)
   /// \param[out] row Topological row
@@ -153,6 +181,8 @@ class Clusterizer
 
   Geometry* mEMCALGeometry = nullptr;                             //!<! pointer to geometry for utilities
   std::array<cellWithE, NROWS * NCOLS> mSeedList;                 //!<! seed array
+  std::array<cellWithE, NROWS * NCOLS> mSeedListSMRow;            //!<! seed array grouped by supermodule row
+  std::array<SMRowClusters, NSMROWS> mSMRowClusters;              //!<! clusters per supermodule row
   std::array<std::array<InputwithIndex, NCOLS>, NROWS> mInputMap; //!<! topology arrays
   std::array<std::array<bool, NCOLS>, NROWS> mCellMask;           //!<! topology arrays
 
@@ -166,6 +196,7 @@ class Clusterizer
   bool mDoEnergyGradientCut;   ///<  cut on energy gradient
   double mThresholdSeedEnergy; ///<  minimum energy to seed a EC digit/cell in a cluster
   double mThresholdCellEnergy; ///<  minimum energy for a digit/cell to be a member of a cluster
+  int mNThreads = 1;           //!<! number of threads for the clustering of the supermodule rows
   ClassDefNV(Clusterizer, 1);
 };
 
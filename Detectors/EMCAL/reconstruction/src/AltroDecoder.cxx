@@ -95,7 +95,8 @@ void AltroDecoder::readChannels()
     /// decode all words for channel
     bool foundChannelError = false;
     int numberofwords = (payloadsize + 2) / 3;
-    std::vector<uint16_t> bunchwords;
+    auto& bunchwords = mBunchWords;
+    bunchwords.clear();
     for (int iword = 0; iword < numberofwords; iword++) {
       if (currentpos >= maxpayloadsize) {
         mMinorDecodingErrors.emplace_back(MinorAltroDecodingError::ErrorType_t::CHANNEL_PAYLOAD_EXCEED, channelheader, currentword);
@@ -14,7 +14,5 @@ using namespace o2::emcal;
 
 void Bunch::initFromRange(gsl::span<uint16_t> adcs)
 {
-  for (auto adcval : adcs) {
-    mADC.emplace_back(adcval);
-  }
+  mADC.assign(adcs.begin(), adcs.end());
 }
\ No newline at end of file
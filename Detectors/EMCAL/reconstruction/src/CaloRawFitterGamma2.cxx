@@ -123,10 +123,11 @@ float CaloRawFitterGamma2::doFit_1peak(int firstTimeBin, int nSamples, float& am
       continue;
     }
 
-    double g_1i = (ti + 1) * TMath::Exp(-2 * ti);
+    double exp_i = TMath::Exp(-2 * ti);
+    double g_1i = (ti + 1) * exp_i;
     double g_i = (ti + 1) * g_1i;
     double gp_i = 2 * (g_i - g_1i);
-    double q1_i = (2 * ti + 1) * TMath::Exp(-2 * ti);
+    double q1_i = (2 * ti + 1) * exp_i;
     double q2_i = g_1i * g_1i * (4 * ti + 1);
     c11 += (getReversed(itbin) - ampl * 2 * g_i) * gp_i;
     c12 += g_i * g_i;
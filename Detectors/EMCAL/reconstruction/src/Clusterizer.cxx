@@ -22,12 +22,20 @@ using namespace o2::emcal;
 template <class InputType>
 Clusterizer<InputType>::Clusterizer(double timeCut, double timeMin, double timeMax, double gradientCut, bool doEnergyGradientCut, double thresholdSeedE, double thresholdCellE) : mSeedList(), mInputMap(), mCellMask(), mTimeCut(timeCut), mTimeMin(timeMin), mTimeMax(timeMax), mGradientCut(gradientCut), mDoEnergyGradientCut(doEnergyGradientCut), mThresholdSeedEnergy(thresholdSeedE), mThresholdCellEnergy(thresholdCellE)
 {
+  for (auto iArr = 0; iArr < NROWS; iArr++) {
+    mCellMask[iArr].fill(kFALSE);
+    mInputMap[iArr].fill({nullptr, -1});
+  }
 }
 
 //____________________________________________________________________________
 template <class InputType>
 Clusterizer<InputType>::Clusterizer() : mSeedList(), mInputMap(), mCellMask(), mTimeCut(0), mTimeMin(0), mTimeMax(0), mGradientCut(0), mDoEnergyGradientCut(false), mThresholdSeedEnergy(0), mThresholdCellEnergy(0)
 {
+  for (auto iArr = 0; iArr < NROWS; iArr++) {
+    mCellMask[iArr].fill(kFALSE);
+    mInputMap[iArr].fill({nullptr, -1});
+  }
 }
 
 //____________________________________________________________________________
@@ -108,6 +116,43 @@ void Clusterizer<InputType>::getTopologicalRowColumn(const InputType& input, int
   }
 }
 
+//____________________________________________________________________________
+template <class InputType>
+void Clusterizer<InputType>::findClustersSMRow(const cellWithE* seeds, int nSeeds, SMRowClusters& output)
+{
+  output.mClusters.clear();
+  output.mInputIndices.clear();
+  output.mSeedEnergies.clear();
+
+  // Take next valid cell/digit in the supermodule row as seed (in descending energy order)
+  for (int i = nSeeds - 1; i >= 0; i--) {
+    int row = seeds[i].row, column = seeds[i].column;
+    // Continue if the cell is already masked (i.e. was already clustered)
+    if (mCellMask[row][column]) {
+      continue;
+    }
+    // Continue if energy constraints are not fulfilled
+    if (seeds[i].energy <= mThresholdSeedEnergy) {
+      continue;
+    }
+
+    // Seed is found, form cluster recursively
+    output.mClusterInputs.clear();
+    getClusterFromNeighbours(output.mClusterInputs, row, column);
+
+    // Add cells/digits for current cluster to cell/digit index vector
+    int inputIndexStart = output.mInputIndices.size();
+    for (auto dig : output.mClusterInputs) {
+      output.mInputIndices.emplace_back(dig.mIndex);
+    }
+    int inputIndexSize = output.mInputIndices.size() - inputIndexStart;
+
+    // Now form cluster object from cells/digits
+    output.mClusters.emplace_back(mInputMap[row][column].mInput->getTimeStamp(), inputIndexStart, inputIndexSize); // Cluster object initialized w/ time of seed cell, start + size of associated cells
+    output.mSeedEnergies.emplace_back(seeds[i].energy);
+  }
+}
+
 //____________________________________________________________________________
 template <class InputType>
 void Clusterizer<InputType>::findClusters(const gsl::span<InputType const>& inputArray)
@@ -118,6 +163,7 @@ void Clusterizer<InputType>::findClusters(const gsl::span<InputType const>& inpu
   // - Fill cells/digits in 2D topological map
   // - Fill struct arrays (energy,x,y)  (to get mapping energy -> (x,y))
   // - Create 2D bitmap (cell/digit is already clustered or not)
+  // - Group struct arrays by supermodule row, the rows are separated by a gap and can be clustered independently
   // - Sort struct arrays with descending energy
   //
   // - Loop over arrays:
@@ -125,17 +171,14 @@ void Clusterizer<InputType>::findClusters(const gsl::span<InputType const>& inpu
   // --> Take valid cell/digit with highest energy as seed (they are already sorted)
   // --> Recursive to neighboughs and create cluster
   // --> Seed cell and all neighbours belonging to cluster will be put in 2D bitmap
-
-  // Reset cell/digit maps and cell masks
-  // Loop over one array dim, then reset each array
-  for (auto iArr = 0; iArr < NROWS; iArr++) {
-    mCellMask[iArr].fill(kFALSE);
-    mInputMap[iArr].fill({nullptr, -1});
-  }
+  //
+  // - Merge the clusters of the supermodule rows in descending seed energy
+  // - Reset the cells/digits used in the 2D map and bitmap, which are otherwise kept empty
 
   // Calibrate cells/digits and fill the maps/arrays
   int nCells = 0;
   double ehs = 0.0;
+  std::array<int, NSMROWS + 1> smRowOffsets{};
   //for (auto dig : inputArray) {
   for (int iIndex = 0; iIndex < inputArray.size(); iIndex++) {
 
@@ -161,37 +204,57 @@ void Clusterizer<InputType>::findClusters(const gsl::span<InputType const>& inpu
     mSeedList[nCells].energy = inputEnergy;
     mSeedList[nCells].row = row;
     mSeedList[nCells].column = column;
+    smRowOffsets[row / NROWSSMROW + 1]++;
     nCells++;
   }
 
-  // Sort struct arrays with ascending energy
-  std::sort(mSeedList.begin(), std::next(std::begin(mSeedList), nCells));
+  // Group the seeds by supermodule row
+  for (int smRow = 0; smRow < NSMROWS; smRow++) {
+    smRowOffsets[smRow + 1] += smRowOffsets[smRow];
+  }
+  std::array<int, NSMROWS> smRowFill{};
+  for (int i = 0; i < nCells; i++) {
+    const int smRow = mSeedList[i].row / NROWSSMROW;
+    mSeedListSMRow[smRowOffsets[smRow] + smRowFill[smRow]++] = mSeedList[i];
+  }
 
-  // Take next valid cell/digit in calorimeter as seed (in descending energy order)
-  for (int i = nCells - 1; i >= 0; i--) {
-    int row = mSeedList[i].row, column = mSeedList[i].column;
-    // Continue if the cell is already masked (i.e. was already clustered)
-    if (mCellMask[row][column]) {
-      continue;
+  // Sort struct arrays with ascending energy and form clusters, per supermodule row
+#ifdef WITH_OPENMP
+#pragma omp parallel for num_threads(mNThreads) schedule(dynamic)
+#endif
+  for (int smRow = 0; smRow < NSMROWS; smRow++) {
+    cellWithE* seeds = mSeedListSMRow.data() + smRowOffsets[smRow];
+    const int nSeeds = smRowOffsets[smRow + 1] - smRowOffsets[smRow];
+    std::sort(seeds, seeds + nSeeds);
+    findClustersSMRow(seeds, nSeeds, mSMRowClusters[smRow]);
+  }
+
+  // Merge the clusters of all supermodule rows in descending seed energy
+  std::array<size_t, NSMROWS> nextCluster{};
+  while (true) {
+    int bestSMRow = -1;
+    for (int smRow = 0; smRow < NSMROWS; smRow++) {
+      const auto& smRowClusters = mSMRowClusters[smRow];
+      if (nextCluster[smRow] < smRowClusters.mClusters.size() && (bestSMRow < 0 || smRowClusters.mSeedEnergies[nextCluster[smRow]] > mSMRowClusters[bestSMRow].mSeedEnergies[nextCluster[bestSMRow]])) {
+        bestSMRow = smRow;
+      }
     }
-    // Continue if energy constraints are not fulfilled
-    if (mSeedList[i].energy <= mThresholdSeedEnergy) {
-      continue;
+    if (bestSMRow < 0) {
+      break;
     }
-
-    // Seed is found, form cluster recursively
-    std::vector<InputwithIndex> clusterInputs;
-    getClusterFromNeighbours(clusterInputs, row, column);
-
-    // Add cells/digits for current cluster to cell/digit index vector
+    const auto& smRowClusters = mSMRowClusters[bestSMRow];
+    const auto& cluster = smRowClusters.mClusters[nextCluster[bestSMRow]++];
+    auto firstIndex = std::next(smRowClusters.mInputIndices.begin(), cluster.getCellIndexFirst());
     int inputIndexStart = mInputIndices.size();
-    for (auto dig : clusterInputs) {
-      mInputIndices.emplace_back(dig.mIndex);
-    }
-    int inputIndexSize = mInputIndices.size() - inputIndexStart;
+    mInputIndices.insert(mInputIndices.end(), firstIndex, std::next(firstIndex, cluster.getNCells()));
+    mFoundClusters.emplace_back(cluster);
+    mFoundClusters.back().setCellIndexFirst(inputIndexStart);
+  }
 
-    // Now form cluster object from cells/digits
-    mFoundClusters.emplace_back(mInputMap[row][column].mInput->getTimeStamp(), inputIndexStart, inputIndexSize); // Cluster object initialized w/ time of seed cell, start + size of associated cells
+  // Reset cell/digit maps and cell masks, only the used entries need to be cleaned
+  for (int i = 0; i < nCells; i++) {
+    mCellMask[mSeedList[i].row][mSeedList[i].column] = kFALSE;
+    mInputMap[mSeedList[i].row][mSeedList[i].column] = {nullptr, -1};
   }
   LOG(debug) << mFoundClusters.size() << "clusters found from " << nCells << " cells/digits (total=" << inputArray.size() << ")-> ehs " << ehs << " (minE " << mThresholdCellEnergy << ")";
 }
@@ -55,9 +55,9 @@ class CTFCoder : public o2::ctf::CTFCoderBase
   void compress(CompressedDigits& cd, const gsl::span<const Digit>& digitVec, const gsl::span<const ChannelData>& channelVec);
   size_t estimateCompressedSize(const CompressedDigits& cc);
 
-  /// decompress CompressedDigits to digits
+  /// decompress CompressedDigits to digits, skipping the triggers not selected
   template <int MAJOR_VERSION, int MINOR_VERSION, typename VDIG, typename VCHAN>
-  void decompress(const CompressedDigits& cd, VDIG& digitVec, VCHAN& channelVec);
+  void decompress(const CompressedDigits& cd, VDIG& digitVec, VCHAN& channelVec, const std::vector<bool>& selected);
 
   void appendToTree(TTree& tree, CTF& ec);
   void readFromTree(TTree& tree, int entry, std::vector<Digit>& digitVec, std::vector<ChannelData>& channelVec);
@@ -104,7 +104,7 @@ o2::ctf::CTFIOSize CTFCoder::encode(VEC& buff, const gsl::span<const Digit>& dig
   ec->setANSHeader(mANSVersion);
   // at every encoding the buffer might be autoexpanded, so we don't work with fixed pointer ec
   o2::ctf::CTFIOSize iosize;
-#define ENCODEFDD(part, slot, bits) CTF::get(buff.data())->encode(part, int(slot), bits, optField[int(slot)], &buff, mCoders[int(slot)], getMemMarginFactor());
+#define ENCODEFDD(part, slot, bits) CTF::get(buff.data())->encode(part, int(slot), bits, optField[int(slot)], &buff, mCoders[int(slot)], getMemMarginFactor(), getAdaptiveDictSelection());
   // clang-format off
   iosize += ENCODEFDD(cd.trigger,   CTF::BLC_trigger,  0);
   iosize += ENCODEFDD(cd.bcInc,     CTF::BLC_bcInc,    0);
@@ -138,7 +138,15 @@ o2::ctf::CTFIOSize CTFCoder::decode(const CTF::base& ec, VDIG& digitVec, VCHAN&
   iosize += DECODEFDD(cd.bcInc,     CTF::BLC_bcInc);
   iosize += DECODEFDD(cd.orbitInc,  CTF::BLC_orbitInc);
   iosize += DECODEFDD(cd.nChan,     CTF::BLC_nChan);
-
+  // clang-format on
+  // the channels payload is decoded only if some trigger is selected
+  std::vector<bool> selected;
+  if (!selectDecodedIRs({cd.header.firstBC, cd.header.firstOrbit}, cd.bcInc, cd.orbitInc, cd.header.nTriggers, selected)) {
+    digitVec.clear();
+    channelVec.clear();
+    return iosize;
+  }
+  // clang-format off
   iosize += DECODEFDD(cd.idChan,    CTF::BLC_idChan);
   iosize += DECODEFDD(cd.time,      CTF::BLC_time);
   iosize += DECODEFDD(cd.charge,    CTF::BLC_charge);
@@ -146,9 +154,9 @@ o2::ctf::CTFIOSize CTFCoder::decode(const CTF::base& ec, VDIG& digitVec, VCHAN&
   // clang-format on
   //
   if (hd.minorVersion == 0 && hd.majorVersion == 1) {
-    decompress<1, 0>(cd, digitVec, channelVec);
+    decompress<1, 0>(cd, digitVec, channelVec, selected);
   } else {
-    decompress<1, 1>(cd, digitVec, channelVec);
+    decompress<1, 1>(cd, digitVec, channelVec, selected);
   }
   iosize.rawIn = sizeof(Digit) * digitVec.size() + sizeof(ChannelData) * channelVec.size();
   return iosize;
@@ -156,14 +164,14 @@ o2::ctf::CTFIOSize CTFCoder::decode(const CTF::base& ec, VDIG& digitVec, VCHAN&
 
 /// decompress compressed digits to standard digits
 template <int MAJOR_VERSION, int MINOR_VERSION, typename VDIG, typename VCHAN>
-void CTFCoder::decompress(const CompressedDigits& cd, VDIG& digitVec, VCHAN& channelVec)
+void CTFCoder::decompress(const CompressedDigits& cd, VDIG& digitVec, VCHAN& channelVec, const std::vector<bool>& selected)
 {
   digitVec.clear();
   channelVec.clear();
   digitVec.reserve(cd.header.nTriggers);
   channelVec.reserve(cd.idChan.size());
 
-  uint32_t firstEntry = 0, clCount = 0, chipCount = 0;
+  uint32_t firstEntry = 0, chanCount = 0;
   o2::InteractionRecord ir(cd.header.firstBC, cd.header.firstOrbit);
 
   for (uint32_t idig = 0; idig < cd.header.nTriggers; idig++) {
@@ -174,13 +182,17 @@ void CTFCoder::decompress(const CompressedDigits& cd, VDIG& digitVec, VCHAN& cha
     } else {
       ir.bc += cd.bcInc[idig];
     }
+    if (!selected[idig]) { // rejected by the IR frames selection
+      chanCount += cd.nChan[idig];
+      continue;
+    }
     firstEntry = channelVec.size();
     uint8_t chID = 0;
     int8_t nChanA = 0, nChanC = 0;
     int32_t amplA = 0, amplC = 0;
     int16_t timeA = 0, timeC = 0;
     for (uint8_t ic = 0; ic < cd.nChan[idig]; ic++) {
-      auto icc = channelVec.size();
+      auto icc = chanCount++;
       if constexpr (MINOR_VERSION == 0 && MAJOR_VERSION == 1) {
         // Old decoding procedure, mostly for Pilot Beam in October 2021
         chID += cd.idChan[icc];
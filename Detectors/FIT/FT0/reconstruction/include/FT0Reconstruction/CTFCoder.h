@@ -56,9 +56,9 @@ class CTFCoder : public o2::ctf::CTFCoderBase
   void compress(CompressedDigits& cd, const gsl::span<const Digit>& digitVec, const gsl::span<const ChannelData>& channelVec);
   size_t estimateCompressedSize(const CompressedDigits& cc);
 
-  /// decompress CompressedDigits to digits
+  /// decompress CompressedDigits to digits, skipping the triggers not selected
   template <int MAJOR_VERSION, int MINOR_VERSION, typename VDIG, typename VCHAN>
-  void decompress(const CompressedDigits& cd, VDIG& digitVec, VCHAN& channelVec);
+  void decompress(const CompressedDigits& cd, VDIG& digitVec, VCHAN& channelVec, const std::vector<bool>& selected);
 
   void appendToTree(TTree& tree, CTF& ec);
   void readFromTree(TTree& tree, int entry, std::vector<Digit>& digitVec, std::vector<ChannelData>& channelVec);
@@ -104,7 +104,7 @@ o2::ctf::CTFIOSize CTFCoder::encode(VEC& buff, const gsl::span<const Digit>& dig
   ec->setANSHeader(mANSVersion);
   // at every encoding the buffer might be autoexpanded, so we don't work with fixed pointer ec
   o2::ctf::CTFIOSize iosize;
-#define ENCODEFT0(part, slot, bits) CTF::get(buff.data())->encode(part, int(slot), bits, optField[int(slot)], &buff, mCoders[int(slot)], getMemMarginFactor());
+#define ENCODEFT0(part, slot, bits) CTF::get(buff.data())->encode(part, int(slot), bits, optField[int(slot)], &buff, mCoders[int(slot)], getMemMarginFactor(), getAdaptiveDictSelection());
   // clang-format off
   iosize += ENCODEFT0(cd.trigger,     CTF::BLC_trigger,  0);
   iosize += ENCODEFT0(cd.bcInc,       CTF::BLC_bcInc,    0);
@@ -139,6 +139,15 @@ o2::ctf::CTFIOSize CTFCoder::decode(const CTF::base& ec, VDIG& digitVec, VCHAN&
   iosize += DECODEFT0(cd.orbitInc,    CTF::BLC_orbitInc);
   iosize += DECODEFT0(cd.nChan,       CTF::BLC_nChan);
   iosize += DECODEFT0(cd.eventStatus, CTF::BLC_status);
+  // clang-format on
+  // the channels payload is decoded only if some trigger is selected
+  std::vector<bool> selected;
+  if (!selectDecodedIRs({cd.header.firstBC, cd.header.firstOrbit}, cd.bcInc, cd.orbitInc, cd.header.nTriggers, selected)) {
+    digitVec.clear();
+    channelVec.clear();
+    return iosize;
+  }
+  // clang-format off
   iosize += DECODEFT0(cd.idChan,      CTF::BLC_idChan);
   iosize += DECODEFT0(cd.qtcChain,    CTF::BLC_qtcChain);
   iosize += DECODEFT0(cd.cfdTime,     CTF::BLC_cfdTime);
@@ -146,9 +155,9 @@ o2::ctf::CTFIOSize CTFCoder::decode(const CTF::base& ec, VDIG& digitVec, VCHAN&
   // clang-format on
   //
   if (hd.minorVersion == 0 && hd.majorVersion == 1) {
-    decompress<1, 0>(cd, digitVec, channelVec);
+    decompress<1, 0>(cd, digitVec, channelVec, selected);
   } else {
-    decompress<1, 1>(cd, digitVec, channelVec);
+    decompress<1, 1>(cd, digitVec, channelVec, selected);
   }
   iosize.rawIn = sizeof(Digit) * digitVec.size() + sizeof(ChannelData) * channelVec.size();
   return iosize;
@@ -156,14 +165,14 @@ o2::ctf::CTFIOSize CTFCoder::decode(const CTF::base& ec, VDIG& digitVec, VCHAN&
 
 /// decompress compressed digits to standard digits
 template <int MAJOR_VERSION, int MINOR_VERSION, typename VDIG, typename VCHAN>
-void CTFCoder::decompress(const CompressedDigits& cd, VDIG& digitVec, VCHAN& channelVec)
+void CTFCoder::decompress(const CompressedDigits& cd, VDIG& digitVec, VCHAN& channelVec, const std::vector<bool>& selected)
 {
   digitVec.clear();
   channelVec.clear();
   digitVec.reserve(cd.header.nTriggers);
   channelVec.reserve(cd.idChan.size());
 
-  uint32_t firstEntry = 0, clCount = 0, chipCount = 0;
+  uint32_t firstEntry = 0, chanCount = 0;
   o2::InteractionRecord ir(cd.header.firstBC, cd.header.firstOrbit);
 
   for (uint32_t idig = 0; idig < cd.header.nTriggers; idig++) {
@@ -174,6 +183,10 @@ void CTFCoder::decompress(const CompressedDigits& cd, VDIG& digitVec, VCHAN& cha
     } else {
       ir.bc += cd.bcInc[idig];
     }
+    if (!selected[idig]) { // rejected by the IR frames selection
+      chanCount += cd.nChan[idig];
+      continue;
+    }
     const auto& params = FT0DigParam::Instance();
     int triggerGate = params.mTime_trg_gate;
     firstEntry = channelVec.size();
@@ -182,7 +195,7 @@ void CTFCoder::decompress(const CompressedDigits& cd, VDIG& digitVec, VCHAN& cha
     int32_t amplA = 0, amplC = 0;
     int16_t timeA = 0, timeC = 0;
     for (uint8_t ic = 0; ic < cd.nChan[idig]; ic++) {
-      auto icc = channelVec.size();
+      auto icc = chanCount++;
       if constexpr (MINOR_VERSION == 0 && MAJOR_VERSION == 1) {
         // Old decoding procedure, mostly for Pilot Beam in October 2021
         chID += cd.idChan[icc];
@@ -51,17 +51,27 @@ class CollisionTimeRecoTask
                                   const gsl::span<const o2::ft0::ChannelData> inChData,
                                   std::vector<o2::ft0::ChannelDataFloat>& outChData);
   void FinishTask();
-  void SetTimeCalibObject(o2::ft0::TimeSpectraInfoObject const* timeCalibObject) { mTimeCalibObject = timeCalibObject; };
+  void SetTimeCalibObject(o2::ft0::TimeSpectraInfoObject const* timeCalibObject);
   void SetSlewingCalibObject(o2::ft0::SlewingCoef const* calibSlew)
   {
     LOG(info) << "Init for slewing calib object";
     mCalibSlew = calibSlew->makeSlewingPlots();
   };
   float getTimeInPS(const o2::ft0::ChannelData& channelData);
+  /// number of threads processing the digits of a TF in parallel
+  void setNThreads(int nThreads) { mNThreads = nThreads > 0 ? nThreads : 1; }
+  int getNThreads() const { return mNThreads; }
 
  private:
+  /// select the time offset of each channel from the time calibration object, done once per calibration object instead of per channel data
+  void fillTimeOffsets();
+
   o2::ft0::TimeSpectraInfoObject const* mTimeCalibObject = nullptr;
   typename o2::ft0::SlewingCoef::SlewingPlots_t mCalibSlew{};
+  std::array<float, NCHANNELS> mTimeOffsets{};                      ///< time offset per channel
+  int mNThreads = 1;                                                ///< number of threads for processTF
+  std::vector<std::vector<o2::ft0::RecPoints>> mThreadRecPoints;    ///< RecPoints per thread
+  std::vector<std::vector<o2::ft0::ChannelDataFloat>> mThreadChData; ///< channel data per thread
 };
 } // namespace ft0
 } // namespace o2
@@ -21,6 +21,7 @@
 #include <DataFormatsFT0/Digit.h>
 #include <DataFormatsFT0/DigitFilterParam.h>
 #include <DataFormatsFT0/CalibParam.h>
+#include <algorithm>
 #include <cmath>
 #include <bitset>
 #include <cassert>
@@ -36,12 +37,48 @@ void CollisionTimeRecoTask::processTF(const gsl::span<const o2::ft0::Digit>& dig
                                       std::vector<o2::ft0::RecPoints>& vecRecPoints,
                                       std::vector<o2::ft0::ChannelDataFloat>& vecChData)
 {
-  for (const auto& digit : digits) {
-    if (!ChannelFilterParam::Instance().checkTCMbits(digit.getTriggers().getTriggersignals())) {
-      continue;
+  const int nThreads = std::min<int>(mNThreads, digits.size());
+  if (nThreads <= 1) {
+    for (const auto& digit : digits) {
+      if (!ChannelFilterParam::Instance().checkTCMbits(digit.getTriggers().getTriggersignals())) {
+        continue;
+      }
+      const auto channelsPerDigit = digit.getBunchChannelData(channels);
+      vecRecPoints.emplace_back(processDigit(digit, channelsPerDigit, vecChData));
+    }
+    return;
+  }
+
+  // the BCs are independent: process contiguous ranges of digits in parallel and concatenate the outputs
+  mThreadRecPoints.resize(nThreads);
+  mThreadChData.resize(nThreads);
+  const size_t nDigitsPerThread = (digits.size() + nThreads - 1) / nThreads;
+#ifdef WITH_OPENMP
+#pragma omp parallel for num_threads(nThreads) schedule(static)
+#endif
+  for (int iThread = 0; iThread < nThreads; iThread++) {
+    auto& recPoints = mThreadRecPoints[iThread];
+    auto& chData = mThreadChData[iThread];
+    recPoints.clear();
+    chData.clear();
+    const size_t first = std::min(iThread * nDigitsPerThread, digits.size());
+    const size_t last = std::min(first + nDigitsPerThread, digits.size());
+    for (size_t iDigit = first; iDigit < last; iDigit++) {
+      const auto& digit = digits[iDigit];
+      if (!ChannelFilterParam::Instance().checkTCMbits(digit.getTriggers().getTriggersignals())) {
+        continue;
+      }
+      const auto channelsPerDigit = digit.getBunchChannelData(channels);
+      recPoints.emplace_back(processDigit(digit, channelsPerDigit, chData));
+    }
+  }
+  for (int iThread = 0; iThread < nThreads; iThread++) {
+    const int offset = vecChData.size();
+    for (auto recPoint : mThreadRecPoints[iThread]) {
+      recPoint.ref.setFirstEntry(recPoint.ref.getFirstEntry() + offset);
+      vecRecPoints.emplace_back(recPoint);
     }
-    const auto channelsPerDigit = digit.getBunchChannelData(channels);
-    vecRecPoints.emplace_back(processDigit(digit, channelsPerDigit, vecChData));
+    vecChData.insert(vecChData.end(), mThreadChData[iThread].begin(), mThreadChData[iThread].end());
   }
 }
 RP CollisionTimeRecoTask::processDigit(const o2::ft0::Digit& digit,
@@ -99,30 +136,44 @@ void CollisionTimeRecoTask::FinishTask()
   // if (!mContinuous)   return;
 }
 
-float CollisionTimeRecoTask::getTimeInPS(const o2::ft0::ChannelData& channelData)
+void CollisionTimeRecoTask::SetTimeCalibObject(o2::ft0::TimeSpectraInfoObject const* timeCalibObject)
 {
-  // Getting time offset
-  float offsetChannel{0};
-  if (mTimeCalibObject) {
+  mTimeCalibObject = timeCalibObject;
+  fillTimeOffsets();
+}
+
+void CollisionTimeRecoTask::fillTimeOffsets()
+{
+  mTimeOffsets.fill(0);
+  if (!mTimeCalibObject) {
+    return;
+  }
+  for (int iCh = 0; iCh < NCHANNELS; iCh++) {
     // Temporary, will be changed to status bit checking
     // Check statistics
-    const auto& stat = mTimeCalibObject->mTime[channelData.ChId].mStat;
+    const auto& stat = mTimeCalibObject->mTime[iCh].mStat;
     const bool isEnoughStat = stat > CalibParam::Instance().mMaxEntriesThreshold;
     const bool isNotGoogStat = stat > CalibParam::Instance().mMinEntriesThreshold && !isEnoughStat;
     // Check fit quality
-    const auto& meanGaus = mTimeCalibObject->mTime[channelData.ChId].mGausMean;
-    const auto& meanHist = mTimeCalibObject->mTime[channelData.ChId].mStatMean;
-    const auto& sigmaGaus = mTimeCalibObject->mTime[channelData.ChId].mGausRMS;
-    const auto& rmsHist = mTimeCalibObject->mTime[channelData.ChId].mStatRMS;
-    const bool isGoodFitResult = (mTimeCalibObject->mTime[channelData.ChId].mStatusBits & 1) > 0;
+    const auto& meanGaus = mTimeCalibObject->mTime[iCh].mGausMean;
+    const auto& meanHist = mTimeCalibObject->mTime[iCh].mStatMean;
+    const auto& sigmaGaus = mTimeCalibObject->mTime[iCh].mGausRMS;
+    const auto& rmsHist = mTimeCalibObject->mTime[iCh].mStatRMS;
+    const bool isGoodFitResult = (mTimeCalibObject->mTime[iCh].mStatusBits & 1) > 0;
     const bool isBadFit = std::abs(meanGaus - meanHist) > CalibParam::Instance().mMaxDiffMean || rmsHist < CalibParam::Instance().mMinRMS || sigmaGaus > CalibParam::Instance().mMaxSigma;
 
     if (isEnoughStat && isGoodFitResult && !isBadFit) {
-      offsetChannel = meanGaus;
+      mTimeOffsets[iCh] = meanGaus;
     } else if ((isNotGoogStat || isEnoughStat) && isBadFit) {
-      offsetChannel = meanHist;
+      mTimeOffsets[iCh] = meanHist;
     }
   }
+}
+
+float CollisionTimeRecoTask::getTimeInPS(const o2::ft0::ChannelData& channelData)
+{
+  // Getting time offset
+  const float offsetChannel = mTimeOffsets[channelData.ChId];
   // Getting slewing offset
   float slewoffset{0};
   const auto& gr = mCalibSlew[static_cast<int>(channelData.getFlag(o2::ft0::ChannelData::EEventDataBit::kNumberADC))][channelData.ChId];
@@ -88,6 +88,7 @@ DataProcessorSpec getEntropyEncoderSpec(bool selIR)
             {"irframe-margin-bwd", VariantType::UInt32, 0u, {"margin in BC to add to the IRFrame lower boundary when selection is requested"}},
             {"irframe-margin-fwd", VariantType::UInt32, 0u, {"margin in BC to add to the IRFrame upper boundary when selection is requested"}},
             {"mem-factor", VariantType::Float, 1.f, {"Memory allocation margin factor"}},
+            {"adaptive-dict", VariantType::Bool, false, {"choose per block between external and embedded dictionary by the estimated size"}},
             {"ans-version", VariantType::String, {"version of ans entropy coder implementation to use"}}}};
 }
 
@@ -36,6 +36,7 @@ void ReconstructionDPL::init(InitContext& ic)
 {
   mTimer.Stop();
   mTimer.Reset();
+  mReco.setNThreads(ic.options().get<int>("reco-threads"));
   o2::ft0::ChannelFilterParam::Instance().printKeyValues();
   o2::ft0::TimeFilterParam::Instance().printKeyValues();
   // Parameters which are used in reco, too many will be printed if use printKeyValues()
@@ -129,7 +130,7 @@ DataProcessorSpec getReconstructionSpec(bool useMC, const std::string ccdbpath,
     inputSpec,
     outputSpec,
     AlgorithmSpec{adaptFromTask<ReconstructionDPL>(useMC, ccdbpath, useTimeOffsetCalib, useSlewingCalib)},
-    Options{}};
+    Options{{"reco-threads", VariantType::Int, 1, {"number of threads reconstructing the BCs of a TF in parallel"}}}};
 }
 
 } // namespace ft0
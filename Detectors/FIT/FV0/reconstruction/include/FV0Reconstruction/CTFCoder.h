@@ -52,9 +52,9 @@ class CTFCoder : public o2::ctf::CTFCoderBase
   void compress(CompressedDigits& cd, const gsl::span<const Digit>& digitVec, const gsl::span<const ChannelData>& channelVec);
   size_t estimateCompressedSize(const CompressedDigits& cc);
 
-  /// decompress CompressedDigits to digits
+  /// decompress CompressedDigits to digits, skipping the triggers not selected
   template <int MAJOR_VERSION, int MINOR_VERSION, typename VDIG, typename VCHAN>
-  void decompress(const CompressedDigits& cd, VDIG& digitVec, VCHAN& channelVec);
+  void decompress(const CompressedDigits& cd, VDIG& digitVec, VCHAN& channelVec, const std::vector<bool>& selected);
 
   void appendToTree(TTree& tree, CTF& ec);
   void readFromTree(TTree& tree, int entry, std::vector<Digit>& digitVec, std::vector<ChannelData>& channelVec);
@@ -100,7 +100,7 @@ o2::ctf::CTFIOSize CTFCoder::encode(VEC& buff, const gsl::span<const Digit>& dig
   ec->setANSHeader(mANSVersion);
   // at every encoding the buffer might be autoexpanded, so we don't work with fixed pointer ec
   o2::ctf::CTFIOSize iosize;
-#define ENCODEFV0(part, slot, bits) CTF::get(buff.data())->encode(part, int(slot), bits, optField[int(slot)], &buff, mCoders[int(slot)], getMemMarginFactor());
+#define ENCODEFV0(part, slot, bits) CTF::get(buff.data())->encode(part, int(slot), bits, optField[int(slot)], &buff, mCoders[int(slot)], getMemMarginFactor(), getAdaptiveDictSelection());
   // clang-format off
   iosize += ENCODEFV0(cd.bcInc,     CTF::BLC_bcInc,    0);
   iosize += ENCODEFV0(cd.orbitInc,  CTF::BLC_orbitInc, 0);
@@ -133,11 +133,20 @@ o2::ctf::CTFIOSize CTFCoder::decode(const CTF::base& ec, VDIG& digitVec, VCHAN&
   iosize += DECODEFV0(cd.bcInc,     CTF::BLC_bcInc);
   iosize += DECODEFV0(cd.orbitInc,  CTF::BLC_orbitInc);
   iosize += DECODEFV0(cd.nChan,     CTF::BLC_nChan);
+  iosize += DECODEFV0(cd.trigger,   CTF::BLC_trigger);
+  // clang-format on
+  // the channels payload is decoded only if some trigger is selected
+  std::vector<bool> selected;
+  if (!selectDecodedIRs({cd.header.firstBC, cd.header.firstOrbit}, cd.bcInc, cd.orbitInc, cd.header.nTriggers, selected)) {
+    digitVec.clear();
+    channelVec.clear();
+    return iosize;
+  }
+  // clang-format off
   iosize += DECODEFV0(cd.idChan,    CTF::BLC_idChan);
   iosize += DECODEFV0(cd.cfdTime,   CTF::BLC_cfdTime);
   iosize += DECODEFV0(cd.qtcAmpl,   CTF::BLC_qtcAmpl);
   // extra slot was added in the end
-  iosize += DECODEFV0(cd.trigger,   CTF::BLC_trigger);
   iosize += DECODEFV0(cd.qtcChain,  CTF::BLC_qtcChain);
   // triggers and qtcChain were added later, in old data they are absent:
   if (cd.trigger.empty()) {
@@ -149,9 +158,9 @@ o2::ctf::CTFIOSize CTFCoder::decode(const CTF::base& ec, VDIG& digitVec, VCHAN&
   // clang-format on
   //
   if (hd.minorVersion == 0 && hd.majorVersion == 1) {
-    decompress<1, 0>(cd, digitVec, channelVec);
+    decompress<1, 0>(cd, digitVec, channelVec, selected);
   } else {
-    decompress<1, 1>(cd, digitVec, channelVec);
+    decompress<1, 1>(cd, digitVec, channelVec, selected);
   }
   iosize.rawIn = sizeof(Digit) * digitVec.size() + sizeof(ChannelData) * channelVec.size();
   return iosize;
@@ -159,14 +168,14 @@ o2::ctf::CTFIOSize CTFCoder::decode(const CTF::base& ec, VDIG& digitVec, VCHAN&
 
 /// decompress compressed digits to standard digits
 template <int MAJOR_VERSION, int MINOR_VERSION, typename VDIG, typename VCHAN>
-void CTFCoder::decompress(const CompressedDigits& cd, VDIG& digitVec, VCHAN& channelVec)
+void CTFCoder::decompress(const CompressedDigits& cd, VDIG& digitVec, VCHAN& channelVec, const std::vector<bool>& selected)
 {
   digitVec.clear();
   channelVec.clear();
   digitVec.reserve(cd.header.nTriggers);
   channelVec.reserve(cd.idChan.size());
 
-  uint32_t firstEntry = 0, clCount = 0, chipCount = 0;
+  uint32_t firstEntry = 0, chanCount = 0;
   o2::InteractionRecord ir(cd.header.firstBC, cd.header.firstOrbit);
 
   for (uint32_t idig = 0; idig < cd.header.nTriggers; idig++) {
@@ -177,6 +186,10 @@ void CTFCoder::decompress(const CompressedDigits& cd, VDIG& digitVec, VCHAN& cha
     } else {
       ir.bc += cd.bcInc[idig];
     }
+    if (!selected[idig]) { // rejected by the IR frames selection
+      chanCount += cd.nChan[idig];
+      continue;
+    }
     const auto& params = FV0DigParam::Instance();
     int triggerGate = params.mTime_trg_gate;
     firstEntry = channelVec.size();
@@ -185,7 +198,7 @@ void CTFCoder::decompress(const CompressedDigits& cd, VDIG& digitVec, VCHAN& cha
     int32_t amplA = 0, amplC = Triggers::DEFAULT_AMP;
     int16_t timeA = 0, timeC = Triggers::DEFAULT_TIME;
     for (uint8_t ic = 0; ic < cd.nChan[idig]; ic++) {
-      auto icc = channelVec.size();
+      auto icc = chanCount++;
       if constexpr (MINOR_VERSION == 0 && MAJOR_VERSION == 1) {
         // Old decoding procedure, mostly for Pilot Beam in October 2021
         chID += cd.idChan[icc];
@@ -41,6 +41,10 @@ RP BaseRecoTask::process(o2::fv0::Digit const& bcd,
 
   LOG(debug) << " event time " << timeStamp << " orbit " << bcd.getIntRecord().orbit << " bc " << bcd.getIntRecord().bc;
 
+  const auto& digParam = FV0DigParam::Instance();
+  const float chargeThrForMeanTime = digParam.chargeThrForMeanTime;
+  const float timeThresholdForReco = digParam.mTimeThresholdForReco;
+  const float ampThresholdForReco = digParam.mAmpThresholdForReco;
   int nch = inChData.size();
   for (int ich = 0; ich < nch; ich++) {
     LOG(debug) << "  channel " << ich << " / " << nch;
@@ -51,14 +55,14 @@ RP BaseRecoTask::process(o2::fv0::Digit const& bcd,
                                                inChData[ich].ChainQTC};
 
     // Conditions for reconstructing collision time (3 variants: first, average-relaxed and average-tight)
-    if (outChData[ich].charge > FV0DigParam::Instance().chargeThrForMeanTime) {
+    if (outChData[ich].charge > chargeThrForMeanTime) {
       sideAtimeFirst = std::min(static_cast<Double_t>(sideAtimeFirst), outChData[ich].time);
       if (inChData[ich].areAllFlagsGood()) {
-        if (std::abs(outChData[ich].time) < FV0DigParam::Instance().mTimeThresholdForReco) {
+        if (std::abs(outChData[ich].time) < timeThresholdForReco) {
           sideAtimeAvg += outChData[ich].time;
           ndigitsA++;
         }
-        if (outChData[ich].charge > FV0DigParam::Instance().mAmpThresholdForReco && std::abs(outChData[ich].time) < FV0DigParam::Instance().mTimeThresholdForReco) {
+        if (outChData[ich].charge > ampThresholdForReco && std::abs(outChData[ich].time) < timeThresholdForReco) {
           sideAtimeAvgSelected += outChData[ich].time;
           ndigitsASelected++;
         }
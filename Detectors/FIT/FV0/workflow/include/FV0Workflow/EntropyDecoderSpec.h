@@ -28,7 +28,7 @@ namespace fv0
 class EntropyDecoderSpec : public o2::framework::Task
 {
  public:
-  EntropyDecoderSpec(int verbosity);
+  EntropyDecoderSpec(int verbosity, bool selIR = false);
   ~EntropyDecoderSpec() override = default;
   void run(o2::framework::ProcessingContext& pc) final;
   void init(o2::framework::InitContext& ic) final;
@@ -38,10 +38,11 @@ class EntropyDecoderSpec : public o2::framework::Task
  private:
   o2::fv0::CTFCoder mCTFCoder;
   TStopwatch mTimer;
+  bool mSelIR = false;
 };
 
 /// create a processor spec
-framework::DataProcessorSpec getEntropyDecoderSpec(int verbosity, unsigned int sspec);
+framework::DataProcessorSpec getEntropyDecoderSpec(int verbosity, unsigned int sspec, bool selIR = false);
 
 } // namespace fv0
 } // namespace o2
@@ -11,10 +11,18 @@
 
 /// @file   FilteredTFReaderSpec.cxx
 
-#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <fmt/format.h>
 #include "Framework/ControlService.h"
 #include "Framework/ConfigParamRegistry.h"
 #include "FilteredTFReaderSpec.h"
+#include "DataFormatsGlobalTracking/FilteredRecoTFImage.h"
 #include "CommonUtils/NameConf.h"
 
 using namespace o2::framework;
@@ -28,51 +36,70 @@ FilteredTFReader::FilteredTFReader(bool useMC)
   mUseMC = useMC;
 }
 
+FilteredTFReader::~FilteredTFReader()
+{
+  if (mData) {
+    munmap(const_cast<char*>(mData), mSize);
+  }
+}
+
 void FilteredTFReader::init(InitContext& ic)
 {
   mInputFileName = o2::utils::Str::concat_string(o2::utils::Str::rectifyDirectory(ic.options().get<std::string>("input-dir")),
                                                  ic.options().get<std::string>("filtered-tf-infile"));
-  connectTree(mInputFileName);
+  mapFile(mInputFileName);
 }
 
 void FilteredTFReader::run(ProcessingContext& pc)
 {
   // FIXME: fill all output headers by TF specific info (extend findMessageHeaderStack)
+  using Image = FilteredRecoTFImage;
+  gsl::span<const char> image(mData + mOffset, mSize - mOffset);
+  const auto& header = Image::get(image);
+  mOffset += (header.size + Image::Alignment - 1) / Image::Alignment * Image::Alignment;
 
-  auto ent = mTree->GetReadEntry() + 1;
-  assert(ent < mTree->GetEntries()); // this should not happen
-  mTree->GetEntry(ent);
-
-  LOG(info) << "Pushing filtered TF: " << mFiltTF.header.asString();
+  LOG(info) << "Pushing filtered TF: " << header.getTFHeader().asString();
+  // the blocks are sent from the mapped file, without deserialization
   // ITS
-  pc.outputs().snapshot(Output{"ITS", "ITSTrackROF", 0}, mFiltTF.ITSTrackROFs);
-  pc.outputs().snapshot(Output{"ITS", "TRACKS", 0}, mFiltTF.ITSTracks);
-  pc.outputs().snapshot(Output{"ITS", "TRACKCLSID", 0}, mFiltTF.ITSClusterIndices);
+  pc.outputs().snapshot(Output{"ITS", "ITSTrackROF", 0}, Image::getBlock<Image::ITSTrackROFs>(image));
+  pc.outputs().snapshot(Output{"ITS", "TRACKS", 0}, Image::getBlock<Image::ITSTracks>(image));
+  pc.outputs().snapshot(Output{"ITS", "TRACKCLSID", 0}, Image::getBlock<Image::ITSClusterIndices>(image));
   if (mUseMC) {
-    pc.outputs().snapshot(Output{"ITS", "TRACKSMCTR", 0}, mFiltTF.ITSTrackMCTruth);
+    pc.outputs().snapshot(Output{"ITS", "TRACKSMCTR", 0}, Image::getBlock<Image::ITSTrackMCTruth>(image));
   }
-  pc.outputs().snapshot(Output{"ITS", "CLUSTERSROF", 0}, mFiltTF.ITSClusterROFs);
-  pc.outputs().snapshot(Output{"ITS", "COMPCLUSTERS", 0}, mFiltTF.ITSClusters);
-  pc.outputs().snapshot(Output{"ITS", "PATTERNS", 0}, mFiltTF.ITSClusterPatterns);
+  pc.outputs().snapshot(Output{"ITS", "CLUSTERSROF", 0}, Image::getBlock<Image::ITSClusterROFs>(image));
+  pc.outputs().snapshot(Output{"ITS", "COMPCLUSTERS", 0}, Image::getBlock<Image::ITSClusters>(image));
+  pc.outputs().snapshot(Output{"ITS", "PATTERNS", 0}, Image::getBlock<Image::ITSClusterPatterns>(image));
 
-  if (mTree->GetReadEntry() + 1 >= mTree->GetEntries()) {
+  if (mOffset >= mSize) {
     pc.services().get<ControlService>().endOfStream();
     pc.services().get<ControlService>().readyToQuit(QuitRequest::Me);
   }
 }
 
-void FilteredTFReader::connectTree(const std::string& filename)
+void FilteredTFReader::mapFile(const std::string& filename)
 {
-  mTree.reset(nullptr); // in case it was already loaded
-  mFile.reset(TFile::Open(filename.c_str()));
-  assert(mFile && !mFile->IsZombie());
-  mTree.reset((TTree*)mFile->Get(mInputTreeName.c_str()));
-  assert(mTree);
-  assert(mTree->GetBranch(mFTFBranchName.c_str()));
-  mTree->SetBranchAddress(mFTFBranchName.c_str(), &mFiltTFPtr);
-  LOG(info) << "Loaded tree from " << filename << " with " << mTree->GetEntries() << " entries";
+  int fd = open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd == -1) {
+    throw std::runtime_error(fmt::format("failed to open filtered TF file {}: {}", filename, strerror(errno)));
+  }
+  struct stat statbuf;
+  if (fstat(fd, &statbuf) == -1 || statbuf.st_size == 0) {
+    ::close(fd);
+    throw std::runtime_error(fmt::format("filtered TF file {} is empty", filename));
+  }
+  mSize = statbuf.st_size;
+  void* ptr = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd); // the mapping keeps the file referenced
+  if (ptr == MAP_FAILED) {
+    throw std::runtime_error(fmt::format("failed to map filtered TF file {}", filename));
+  }
+  madvise(ptr, mSize, MADV_SEQUENTIAL);
+  mData = reinterpret_cast<const char*>(ptr);
+  mOffset = 0;
+  FilteredRecoTFImage::get({mData, mSize}); // validate the 1st image
+  LOG(info) << "Mapped " << filename << " of " << mSize << " bytes";
 }
-
 DataProcessorSpec getFilteredTFReaderSpec(bool useMC)
 {
 
@@ -95,7 +122,7 @@ DataProcessorSpec getFilteredTFReaderSpec(bool useMC)
     outputSpec,
     AlgorithmSpec{adaptFromTask<FilteredTFReader>(useMC)},
     Options{
-      {"filtered-tf-infile", VariantType::String, "o2_filtered_tf.root", {"Name of the input file"}},
+      {"filtered-tf-infile", VariantType::String, "o2_filtered_tf.bin", {"Name of the input file"}},
       {"input-dir", VariantType::String, "none", {"Input directory"}}}};
 }
 
@@ -15,13 +15,10 @@
 #ifndef O2_FILTERED_TF_READER_H
 #define O2_FILTERED_TF_READER_H
 
-#include <TFile.h>
-#include <TTree.h>
-#include <vector>
+#include <string>
 #include "Framework/DataProcessorSpec.h"
 #include "Framework/Task.h"
 #include "Headers/DataHeader.h"
-#include "DataFormatsGlobalTracking/FilteredRecoTF.h"
 
 namespace o2::filtering
 {
@@ -31,26 +28,23 @@ class FilteredTFReader : public o2::framework::Task
 
  public:
   FilteredTFReader(bool useMC = true);
-  ~FilteredTFReader() override = default;
+  ~FilteredTFReader() override;
   void init(o2::framework::InitContext& ic) final;
   void run(o2::framework::ProcessingContext& pc) final;
 
  protected:
-  void connectTree(const std::string& filename);
-
-  o2::dataformats::FilteredRecoTF mFiltTF, *mFiltTFPtr = &mFiltTF;
+  void mapFile(const std::string& filename);
 
   bool mUseMC = true; // use MC truth
 
-  std::unique_ptr<TFile> mFile;
-  std::unique_ptr<TTree> mTree;
+  const char* mData = nullptr; // memory-mapped file of FilteredRecoTFImage
+  size_t mSize = 0;
+  size_t mOffset = 0; // offset of the next image to push
   std::string mInputFileName = "";
-  std::string mInputTreeName = "o2sim";
-  std::string mFTFBranchName = "FilteredRecoTF";
 };
 
 /// create a processor spec
-/// read ITS track data from a root file
+/// read ITS track data from a file of filtered TF images
 framework::DataProcessorSpec getFilteredTFReaderSpec(bool useMC = true);
 
 } // namespace o2::filtering
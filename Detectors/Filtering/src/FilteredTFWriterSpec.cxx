@@ -12,26 +12,63 @@
 /// @file   FilteredTFWriterSpec.cxx
 
 #include "FilteredTFWriterSpec.h"
-#include "DataFormatsGlobalTracking/FilteredRecoTF.h"
+#include "DataFormatsGlobalTracking/FilteredRecoTFImage.h"
+#include "Framework/ConfigParamRegistry.h"
+#include "Framework/Logger.h"
+#include "CommonUtils/StringUtils.h"
+#include <array>
+#include <stdexcept>
+#include <fmt/format.h>
+
+using namespace o2::framework;
 
 namespace o2::filtering
 {
 
-template <typename T>
-using BranchDefinition = framework::MakeRootTreeWriterSpec::BranchDefinition<T>;
+void FilteredTFWriter::init(InitContext& ic)
+{
+  mOutputFileName = o2::utils::Str::concat_string(o2::utils::Str::rectifyDirectory(ic.options().get<std::string>("output-dir")),
+                                                  ic.options().get<std::string>("filtered-tf-outfile"));
+  mFile.open(mOutputFileName, std::ios::binary | std::ios::trunc);
+  if (!mFile) {
+    throw std::runtime_error(fmt::format("failed to open filtered TF file {}", mOutputFileName));
+  }
+}
+
+void FilteredTFWriter::run(ProcessingContext& pc)
+{
+  using Image = o2::dataformats::FilteredRecoTFImage;
+  static const std::array<char, Image::Alignment> zeros{};
+  auto image = pc.inputs().get<gsl::span<char>>("ftf");
+  const auto& header = Image::get(image);
+  LOG(debug) << "writing filtered TF: " << header.getTFHeader().asString();
+  mFile.write(image.data(), header.size); // written from the input buffer, no copy
+  if (auto rem = header.size % Image::Alignment) {
+    mFile.write(zeros.data(), Image::Alignment - rem);
+  }
+  if (!mFile) {
+    throw std::runtime_error(fmt::format("failed to write filtered TF to {}", mOutputFileName));
+  }
+  mNTFs++;
+  mSize += header.size;
+}
+
+void FilteredTFWriter::endOfStream(EndOfStreamContext& ec)
+{
+  mFile.close();
+  LOGP(info, "Wrote {} filtered TFs of {} bytes to {}", mNTFs, mSize, mOutputFileName);
+}
 
 o2::framework::DataProcessorSpec getFilteredTFWriterSpec()
 {
-  using InputSpec = framework::InputSpec;
-  using MakeRootTreeWriterSpec = framework::MakeRootTreeWriterSpec;
-  // Spectators for logging
-  auto logger = [](const o2::dataformats::FilteredRecoTF& tf) {
-    LOG(debug) << "writing filtered TF: " << tf.header.asString();
-  };
-  return MakeRootTreeWriterSpec("filterer-reco-tf-writer",
-                                "o2_filtered_tf.root",
-                                MakeRootTreeWriterSpec::TreeAttributes{"o2sim", "Filtered reconstructed TF"},
-                                BranchDefinition<o2::dataformats::FilteredRecoTF>{InputSpec{"ftf", "GLO", "FILTERED_RECO_TF", 0}, "FTF", logger})();
+  return DataProcessorSpec{
+    "filterer-reco-tf-writer",
+    Inputs{InputSpec{"ftf", "GLO", "FILTERED_RECO_TF", 0}},
+    Outputs{},
+    AlgorithmSpec{adaptFromTask<FilteredTFWriter>()},
+    Options{
+      {"filtered-tf-outfile", VariantType::String, "o2_filtered_tf.bin", {"Name of the output file"}},
+      {"output-dir", VariantType::String, "none", {"Output directory"}}}};
 }
 
 } // end namespace o2::filtering
@@ -15,15 +15,33 @@
 #define O2_FILTERED_TF_WRITER_H
 
 #include "Framework/DataProcessorSpec.h"
-#include "DPLUtils/MakeRootTreeWriterSpec.h"
+#include "Framework/Task.h"
 #include "Framework/InputSpec.h"
-#include "DataFormatsGlobalTracking/FilteredRecoTF.h"
+#include <fstream>
+#include <string>
 
 using namespace o2::framework;
 
 namespace o2::filtering
 {
 
+/// Writes the FilteredRecoTFImage messages one after the other, each padded to FilteredRecoTFImage::Alignment,
+/// directly from the input buffers, so that the file can be memory-mapped by the FilteredTFReader
+class FilteredTFWriter : public o2::framework::Task
+{
+ public:
+  ~FilteredTFWriter() override = default;
+  void init(o2::framework::InitContext& ic) final;
+  void run(o2::framework::ProcessingContext& pc) final;
+  void endOfStream(o2::framework::EndOfStreamContext& ec) final;
+
+ private:
+  std::ofstream mFile;
+  std::string mOutputFileName = "";
+  size_t mNTFs = 0;
+  size_t mSize = 0;
+};
+
 framework::DataProcessorSpec getFilteredTFWriterSpec();
 
 } // namespace o2::filtering
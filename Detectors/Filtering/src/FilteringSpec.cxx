@@ -122,14 +122,8 @@ void FilteringSpec::run(ProcessingContext& pc)
   }
 
   if (mNeedToSave) {
-    fillData(recoData);
-    const auto& tinfo = pc.services().get<o2::framework::TimingInfo>();
-    mFTF.header.run = tinfo.runNumber;
-    mFTF.header.firstTForbit = tinfo.firstTForbit;
-    mFTF.header.creationTime = tinfo.creation;
-
-    pc.outputs().snapshot(Output{"GLO", "FILTERED_RECO_TF", 0}, mFTF);
-    clear(); // clear caches, safe after the snapshot
+    fillData(pc, recoData);
+    clear(); // clear caches, the selection is already in the output
   }
 
   mTimer.Stop();
@@ -151,86 +145,132 @@ void FilteringSpec::init(InitContext& ic)
 void FilteringSpec::clear()
 {
   mNeedToSave = false;
-  mFTF.clear(); // we can clear immidiately after the snapshot
   mGIDToTableID.clear();
   mITSTrackIDCache.clear();
   mITSClusterIDCache.clear();
+  mITSTrackROFSel.clear();
+  mITSClusterROFSel.clear();
+  mITSClusterPattSel.clear();
 }
 
-void FilteringSpec::fillData(const o2::globaltracking::RecoContainer& recoData)
+void FilteringSpec::fillData(ProcessingContext& pc, const o2::globaltracking::RecoContainer& recoData)
 {
-  // actual data filling
-
-  // ITS tracks
-  if (!mITSTrackIDCache.empty()) {
-    const auto tracksOrig = recoData.getITSTracks();
-    const auto tracksOrigLbl = recoData.getITSTracksMCLabels();
-    const auto clusRefOrig = recoData.getITSTracksClusterRefs();
-    const auto rofsOrig = recoData.getITSTracksROFRecords();
-    auto trIt = mITSTrackIDCache.begin(); // tracks sorted in their ID
-    for (unsigned irof = 0; irof < rofsOrig.size() && trIt != mITSTrackIDCache.end(); irof++) {
-      const auto& rofOrig = rofsOrig[irof];
-      int startID = rofOrig.getFirstEntry(), endID = startID + rofOrig.getNEntries();
-      if (trIt->first >= endID) {
-        continue; // nothing from this ROF is selected
-      }
-      auto& rofSave = mFTF.ITSTrackROFs.emplace_back(rofOrig);
-      rofSave.setFirstEntry(mFTF.ITSTracks.size());
-      while (trIt != mITSTrackIDCache.end() && trIt->first < endID) {
-        trIt->second = mFTF.ITSTracks.size(); // this for the further bookkeeping?
-        const auto& trOr = tracksOrig[trIt->first];
-        auto& trSave = mFTF.ITSTracks.emplace_back(trOr);
-        trSave.setFirstClusterEntry(mFTF.ITSClusterIndices.size()); // N cluster entries is set correctly at creation
-        for (int i = 0; i < trOr.getNClusters(); i++) {
-          int clID = trOr.getClusterEntry(i);
-          mFTF.ITSClusterIndices.push_back(clID); // later will be remapped to actually stored cluster indices
-          mITSClusterIDCache[clID] = 0;           // flag used cluster
-        }
-        if (mUseMC) {
-          mFTF.ITSTrackMCTruth.push_back(tracksOrigLbl[trIt->first]);
-        }
-        trIt++;
+  // the selection is expressed as index lists over the input spans, which are gathered directly into the output image
+  using Image = o2::dataformats::FilteredRecoTFImage;
+  const auto tracksOrig = recoData.getITSTracks();
+  const auto tracksOrigLbl = recoData.getITSTracksMCLabels();
+  const auto clusRefOrig = recoData.getITSTracksClusterRefs();
+  const auto trackROFsOrig = recoData.getITSTracksROFRecords();
+  const auto clusOrig = recoData.getITSClusters();
+  const auto pattOrig = recoData.getITSClustersPatterns();
+  const auto clusROFsOrig = recoData.getITSClustersROFRecords();
+
+  // ROFs of the selected ITS tracks, flag the clusters they use
+  size_t nClusIndices = 0;
+  auto trIt = mITSTrackIDCache.begin(); // tracks sorted in their ID
+  for (unsigned irof = 0; irof < trackROFsOrig.size() && trIt != mITSTrackIDCache.end(); irof++) {
+    int endID = trackROFsOrig[irof].getFirstEntry() + trackROFsOrig[irof].getNEntries();
+    if (trIt->first >= endID) {
+      continue; // nothing from this ROF is selected
+    }
+    mITSTrackROFSel.push_back(irof);
+    for (; trIt != mITSTrackIDCache.end() && trIt->first < endID; trIt++) {
+      const auto& trOr = tracksOrig[trIt->first];
+      for (int i = 0; i < trOr.getNClusters(); i++) {
+        mITSClusterIDCache[clusRefOrig[trOr.getClusterEntry(i)]] = 0; // flag used cluster
       }
-      rofSave.setNEntries(mFTF.ITSTracks.size() - rofSave.getFirstEntry());
+      nClusIndices += trOr.getNClusters();
     }
   }
-  // ITS clusters info for selected tracks
-  if (!mITSClusterIDCache.empty()) {
-    const auto clusOrig = recoData.getITSClusters();
-    const auto pattOrig = recoData.getITSClustersPatterns();
-    const auto rofsOrig = recoData.getITSClustersROFRecords();
-    auto clIt = mITSClusterIDCache.begin(); // clusters sorted in their ID
-    auto pattItOrig = pattOrig.begin(), pattItOrigPrev = pattItOrig;
-    for (unsigned irof = 0; irof < rofsOrig.size() && clIt != mITSClusterIDCache.end(); irof++) {
-      const auto& rofOrig = rofsOrig[irof];
-      int startID = rofOrig.getFirstEntry(), endID = startID + rofOrig.getNEntries();
-      if (clIt->first >= endID) {
-        continue; // nothing from this ROF is selected
+  // ROFs and explicit patterns of the selected ITS clusters, the patterns of all preceding clusters must be scanned
+  size_t nPattBytes = 0;
+  auto clIt = mITSClusterIDCache.begin(); // clusters sorted in their ID
+  auto pattIt = pattOrig.begin();
+  for (unsigned irof = 0; irof < clusROFsOrig.size() && clIt != mITSClusterIDCache.end(); irof++) {
+    int startID = clusROFsOrig[irof].getFirstEntry(), endID = startID + clusROFsOrig[irof].getNEntries();
+    bool selROF = false;
+    for (int icl = startID; icl < endID && clIt != mITSClusterIDCache.end(); icl++) {
+      auto pattStart = pattIt;
+      auto pattID = clusOrig[icl].getPatternID();
+      if (pattID == o2::itsmft::CompCluster::InvalidPatternID || mDictITS->isGroup(pattID)) {
+        o2::itsmft::ClusterPattern::skipPattern(pattIt);
       }
-      auto& rofSave = mFTF.ITSClusterROFs.emplace_back(rofOrig);
-      rofSave.setFirstEntry(mFTF.ITSTracks.size());
-      while (clIt != mITSClusterIDCache.end() && clIt->first < endID) {
-        clIt->second = mFTF.ITSClusters.size(); // new index of the stored cluster
-        const auto& clOr = clusOrig[clIt->first];
-        auto& clSave = mFTF.ITSClusters.emplace_back(clOr);
-        // cluster pattern
-        auto pattID = clOr.getPatternID();
-        o2::itsmft::ClusterPattern patt;
-        if (pattID == o2::itsmft::CompCluster::InvalidPatternID || mDictITS->isGroup(pattID)) {
-          patt.acquirePattern(pattItOrig);
-        }
-        while (pattItOrigPrev != pattItOrig) { // the difference, if any, is the explicitly stored pattern
-          mFTF.ITSClusterPatterns.push_back(*pattItOrigPrev);
-          pattItOrigPrev++;
-        }
+      if (icl == clIt->first) {
+        mITSClusterPattSel.emplace_back(pattStart - pattOrig.begin(), pattIt - pattOrig.begin());
+        nPattBytes += pattIt - pattStart;
+        selROF = true;
         clIt++;
       }
-      rofSave.setNEntries(mFTF.ITSClusters.size() - rofSave.getFirstEntry());
+    }
+    if (selROF) {
+      mITSClusterROFSel.push_back(irof);
     }
   }
-  // now remap cluster indices to stored values
-  for (auto& clID : mFTF.ITSClusterIndices) {
-    clID = mITSClusterIDCache[clID];
+
+  Image::Sizes sizes{};
+  sizes[Image::ITSTrackROFs] = mITSTrackROFSel.size();
+  sizes[Image::ITSTracks] = mITSTrackIDCache.size();
+  sizes[Image::ITSClusterIndices] = nClusIndices;
+  sizes[Image::ITSTrackMCTruth] = mUseMC ? mITSTrackIDCache.size() : 0;
+  sizes[Image::ITSClusterROFs] = mITSClusterROFSel.size();
+  sizes[Image::ITSClusters] = mITSClusterPattSel.size();
+  sizes[Image::ITSClusterPatterns] = nPattBytes;
+  const auto& tinfo = pc.services().get<o2::framework::TimingInfo>();
+  o2::dataformats::FilteredRecoTF::Header tfHeader;
+  tfHeader.run = tinfo.runNumber;
+  tfHeader.firstTForbit = tinfo.firstTForbit;
+  tfHeader.creationTime = tinfo.creation;
+  auto image = pc.outputs().make<char>(Output{"GLO", "FILTERED_RECO_TF", 0}, Image::getSize(sizes));
+  Image::create(image, sizes, tfHeader);
+
+  // ITS clusters of the selected tracks
+  auto clusterROFs = Image::getBlock<Image::ITSClusterROFs>(image);
+  auto clusters = Image::getBlock<Image::ITSClusters>(image);
+  auto patterns = Image::getBlock<Image::ITSClusterPatterns>(image);
+  size_t ncl = 0, npatt = 0;
+  clIt = mITSClusterIDCache.begin();
+  for (size_t i = 0; i < mITSClusterROFSel.size(); i++) {
+    const auto& rofOrig = clusROFsOrig[mITSClusterROFSel[i]];
+    int endID = rofOrig.getFirstEntry() + rofOrig.getNEntries();
+    auto& rofSave = clusterROFs[i] = rofOrig;
+    rofSave.setFirstEntry(ncl);
+    for (; clIt != mITSClusterIDCache.end() && clIt->first < endID; clIt++) {
+      clIt->second = ncl; // new index of the stored cluster
+      clusters[ncl] = clusOrig[clIt->first];
+      const auto [pattStart, pattEnd] = mITSClusterPattSel[ncl];
+      std::copy(pattOrig.begin() + pattStart, pattOrig.begin() + pattEnd, patterns.begin() + npatt);
+      npatt += pattEnd - pattStart;
+      ncl++;
+    }
+    rofSave.setNEntries(ncl - rofSave.getFirstEntry());
+  }
+
+  // ITS tracks, with their cluster indices remapped to the stored clusters
+  auto trackROFs = Image::getBlock<Image::ITSTrackROFs>(image);
+  auto tracks = Image::getBlock<Image::ITSTracks>(image);
+  auto clusIndices = Image::getBlock<Image::ITSClusterIndices>(image);
+  auto tracksLbl = Image::getBlock<Image::ITSTrackMCTruth>(image);
+  size_t ntr = 0, nidx = 0;
+  trIt = mITSTrackIDCache.begin();
+  for (size_t i = 0; i < mITSTrackROFSel.size(); i++) {
+    const auto& rofOrig = trackROFsOrig[mITSTrackROFSel[i]];
+    int endID = rofOrig.getFirstEntry() + rofOrig.getNEntries();
+    auto& rofSave = trackROFs[i] = rofOrig;
+    rofSave.setFirstEntry(ntr);
+    for (; trIt != mITSTrackIDCache.end() && trIt->first < endID; trIt++) {
+      trIt->second = ntr; // this for the further bookkeeping?
+      const auto& trOr = tracksOrig[trIt->first];
+      auto& trSave = tracks[ntr] = trOr;
+      trSave.setFirstClusterEntry(nidx); // N cluster entries is set correctly at creation
+      for (int ic = 0; ic < trOr.getNClusters(); ic++) {
+        clusIndices[nidx++] = mITSClusterIDCache[clusRefOrig[trOr.getClusterEntry(ic)]];
+      }
+      if (mUseMC) {
+        tracksLbl[ntr] = tracksOrigLbl[trIt->first];
+      }
+      ntr++;
+    }
+    rofSave.setNEntries(ntr - rofSave.getFirstEntry());
   }
 }
 
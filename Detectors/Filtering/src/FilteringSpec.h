@@ -14,7 +14,7 @@
 #ifndef O2_DATA_FILTERING_SPEC
 #define O2_DATA_FILTERING_SPEC
 
-#include "DataFormatsGlobalTracking/FilteredRecoTF.h"
+#include "DataFormatsGlobalTracking/FilteredRecoTFImage.h"
 
 #include "CCDB/BasicCCDBManager.h"
 #include "DataFormatsFT0/RecPoints.h"
@@ -69,15 +69,13 @@ class FilteringSpec : public Task
   void finaliseCCDB(ConcreteDataMatcher&, void*) final;
 
  private:
-  void fillData(const o2::globaltracking::RecoContainer& recoData);
+  void fillData(ProcessingContext& pc, const o2::globaltracking::RecoContainer& recoData);
   void processTracksOfVertex(const o2::dataformats::VtxTrackRef& vtxref, const o2::globaltracking::RecoContainer& recoData);
   int processBarrelTrack(GIndex idx, const o2::globaltracking::RecoContainer& recoData);
   bool selectTrack(GIndex id, const o2::globaltracking::RecoContainer& recoData);
   void updateTimeDependentParams(ProcessingContext& pc);
   void clear();
 
-  o2::dataformats::FilteredRecoTF mFTF{};
-
   bool mUseMC = true;
   bool mEnableSV = true; // enable secondary vertices
 
@@ -88,6 +86,9 @@ class FilteringSpec : public Task
   bool mNeedToSave = false;                // flag that there was something selected to save
   std::map<int, int> mITSTrackIDCache{};   // cache for selected ITS track IDS
   std::map<int, int> mITSClusterIDCache{}; // cache for selected ITS clusters
+  std::vector<int> mITSTrackROFSel{};      // ROFs of the selected ITS tracks
+  std::vector<int> mITSClusterROFSel{};    // ROFs of the selected ITS clusters
+  std::vector<std::pair<size_t, size_t>> mITSClusterPattSel{}; // [start, end) in the patterns of the explicit pattern of each selected cluster
 
   // unordered map connects global indices and table indices of barrel tracks
   std::unordered_map<GIndex, int> mGIDToTableID;
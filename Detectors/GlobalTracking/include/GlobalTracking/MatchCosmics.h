@@ -85,12 +85,20 @@ class MatchCosmics
     GTrackID origID;        ///< track origin id
     int matchID = MinusOne; ///< entry (none if MinusOne) of its match in the vector of matches
   };
+
+  ///< pair of seeds passing the crude cuts, to be registered in the order of the serial matching
+  struct MatchCandidate {
+    int pos0 = MinusOne; ///< position of the 1st partner in the time-sorted seeds
+    int pos1 = MinusOne; ///< position of the 2nd partner in the time-sorted seeds
+    float chi2 = -1.f;   ///< matching chi2
+  };
   void setTPCCorrMaps(o2::gpu::CorrectionMapsHelper* maph);
   void setTPCVDrift(const o2::tpc::VDriftCorrFact& v);
   void setITSROFrameLengthMUS(float fums) { mITSROFrameLengthMUS = fums; }
   void setITSDict(const o2::itsmft::TopologyDictionary* dict) { mITSDict = dict; }
   void process(const o2::globaltracking::RecoContainer& data);
   void setUseMC(bool mc) { mUseMC = mc; }
+  void setNThreads(int n);
   void init();
   void end();
 
@@ -125,7 +133,8 @@ class MatchCosmics
 
  private:
   void updateTimeDependentParams();
-  RejFlag checkPair(int i, int j);
+  RejFlag checkPair(int i, int j, float& chi2);
+  void findCandidates(const std::vector<int>& sortID, int posMin, int posMax, std::vector<MatchCandidate>& candidates);
   void registerMatch(int i, int j, float chi2);
   void suppressMatch(int partner0, int partner1);
   void createSeeds(const o2::globaltracking::RecoContainer& data);
@@ -140,6 +149,7 @@ class MatchCosmics
   const o2::itsmft::TopologyDictionary* mITSDict = nullptr; // cluster patterns dictionary
   o2::gpu::CorrectionMapsHelper* mTPCCorrMapsHelper = nullptr;
   int mTFCount = 0;
+  int mNThreads = 1;
   float mTPCVDriftRef = -1.; ///< TPC nominal drift speed in cm/microseconds
   float mTPCVDriftCorrFact = 1.; ///< TPC nominal correction factort (wrt ref)
   float mTPCVDrift = -1.;    ///< TPC drift speed in cm/microseconds
@@ -152,6 +162,17 @@ class MatchCosmics
   float mQ2PtCutoff = 1e9;
   const MatchCosmicsParams* mMatchParams = nullptr;
 
+  // seeds indexed in cells of tgl and q/pt, each cell holding the positions of its seeds in the time-sorted seeds
+  std::vector<std::vector<int>> mSeedCells;
+  int mNTglBins = 1;
+  int mNQ2PtBins = 1;
+  float mTglMin = 0.f;
+  float mTglBinInv = 0.f;
+  float mQ2PtMin = 0.f;
+  float mQ2PtBinInv = 0.f;
+  float mMaxSigmaTgl2 = 0.f;  ///< largest tgl error of the seeds, defining the tgl window of the cells to check
+  float mMaxSigmaQ2Pt2 = 0.f; ///< largest q/pt error of the seeds, defining the q/pt window of the cells to check
+
   std::vector<o2d::TrackCosmics> mCosmicTracks;
   std::vector<o2::MCCompLabel> mCosmicTracksLbl;
 
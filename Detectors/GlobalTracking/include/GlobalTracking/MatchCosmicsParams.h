@@ -33,6 +33,8 @@ struct MatchCosmicsParams : public o2::conf::ConfigurableParamHelper<MatchCosmic
   float minSeedPt = 0.10;  // use only tracks above this pT (scaled with field)
   float nSigmaTError = 4.; // number of sigmas on track time error for matching (except for TPC which provides an interval)
   bool allowTPCOnly = true;
+  int nBinsTgl = 40;       // number of tgl bins of the seeds index
+  int nBinsQ2Pt = 20;      // number of q/pt bins of the seeds index (with the field on only)
   o2::base::Propagator::MatCorrType matCorr = o2::base::Propagator::MatCorrType::USEMatCorrLUT;
 
   O2ParamDef(MatchCosmicsParams, "cosmicsMatch");
@@ -17,7 +17,9 @@
 #define ALICEO2_GLOBTRACKING_MATCHGLOBALFWD_
 
 #include <Rtypes.h>
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <vector>
 #include <string>
 #include <gsl/span>
@@ -130,6 +132,8 @@ class MatchGlobalFwd
   bool isMFTTriggered() const { return mMFTTriggered; }
 
   void setMCTruthOn(bool v) { mMCTruthON = v; }
+  void setNThreads(int n);
+  int getNThreads() const { return mNThreads; }
   ///< set MFT ROFrame duration in microseconds
   void setMFTROFrameLengthMUS(float fums);
   ///< set MFT ROFrame duration in BC (continuous mode only)
@@ -166,6 +170,19 @@ class MatchGlobalFwd
   ///< Matches MFT tracks in one MFT ROFrame with all MCH tracks in the overlapping MCH ROFrames
   template <int saveMode>
   void ROFMatch(int MFTROFId, int firstMCHROFId, int lastMCHROFId);
+  ///< Matches one MCH track with the MFT tracks of one MFT ROFrame
+  template <int saveMode>
+  void matchMCHTrack(int MCHId, int MFTROFId, std::vector<int>& mftCandidates, int& nFakes, int& nTrue);
+  ///< Best match of the MCH tracks with the MFT tracks in the given MFT ROFrame windows, in parallel over MCH tracks
+  void matchBestParallel(const std::vector<std::array<int, 3>>& rofWindows);
+
+  ///< Index the MFT tracks of each ROFrame on a XY grid at the matching plane
+  void buildMFTGrid();
+  static constexpr int NMFTGridBins = 400; ///< number of X and Y bins of the grid, with the bin size equal to the max pair distance
+  int getMFTGridBin(float v) const { return int(std::clamp(std::floor(v / mMatchPlaneMaxDXY) + NMFTGridBins / 2, 0.f, float(NMFTGridBins - 1))); }
+  int getMFTGridCell(float x, float y) const { return getMFTGridBin(x) * NMFTGridBins + getMFTGridBin(y); }
+  ///< Select the MFT tracks of one ROFrame close to the MCH track at the matching plane, in the order of the tracks
+  void selectMFTCandidates(const TrackLocMCH& mchTrack, int MFTROFId, std::vector<int>& mftCandidates) const;
 
   void fitTracks();                                          ///< Fit all matched tracks
   void fitGlobalMuonTrack(o2::dataformats::GlobalFwdTrack&); ///< Kalman filter fit global Forward track by attaching MFT clusters
@@ -327,6 +344,8 @@ class MatchGlobalFwd
   std::vector<BracketF> mMFTROFTimes;                          ///< min/max times of MFT ROFs in \mus
   std::vector<TrackLocMFT> mMFTWork;                           ///< MFT track params prepared for matching
   std::vector<MFTCluster> mMFTClusters;                        ///< input MFT clusters
+  std::vector<std::pair<int, int>> mMFTGrid;                   ///< {grid cell, MFT track id} sorted in cell within each MFT ROF
+  std::vector<std::vector<int>> mMFTCandidatesTmp;             ///< per thread, MFT candidates of the current MCH track
   std::vector<o2::dataformats::GlobalFwdTrack> mMatchedTracks; ///< MCH-MFT(-MID) Matched tracks
   std::vector<o2::MCCompLabel> mMatchLabels;                   ///< Output labels
   std::vector<o2::dataformats::MatchInfoFwd> mMatchingInfo;    ///< Forward tracks mathing information
@@ -336,6 +355,8 @@ class MatchGlobalFwd
   const o2::itsmft::TopologyDictionary* mMFTDict{nullptr}; // cluster patterns dictionary
   o2::itsmft::ChipMappingMFT mMFTMapping;
   bool mMCTruthON = false;      ///< Flag availability of MC truth
+  int mNThreads = 1;            ///< number of OMP threads
+  float mMatchPlaneMaxDXY = -1.; ///< if positive, max X and Y distance at the matching plane to consider an MFT-MCH pair
   bool mUseMIDMCHMatch = false; ///< Flag for using MCHMID matches (TrackMCHMID)
   int mSaveMode = 0;            ///< Output mode [0 = SaveBestMatch; 1 = SaveAllMatches; 2 = SaveTrainingData]
   MatchingType mMatchingType = MATCHINGUNDEFINED;
@@ -41,6 +41,7 @@ struct GlobalFwdMatchingParam : public o2::conf::ConfigurableParamHelper<GlobalF
   Int_t saveMode = kBestMatch;                            ///< Global Forward Tracks save mode
   float MFTRadLength = 0.042;                             ///< MFT thickness in radiation length
   float alignResidual = 1.;                               ///< Alignment residual for cluster position uncertainty
+  float matchPlaneMaxDXY = -1.;                          ///< if positive, skip MFT-MCH pairs with X or Y distance at the matching plane above this (cm)
 
   bool
     isMatchUpstream() const
@@ -203,8 +203,9 @@ class MatchTOF
   bool prepareFITData();
   int prepareInteractionTimes();
   bool prepareTPCData();
-  void propagateTPCTracks(int sec);
-  void propagateConstrTracks(int sec);
+  void propagateTracks(int type);
+  int propagateTPCTrack(int sec, int it);
+  int propagateConstrTrack(int sec, int it);
   void addTPCSeed(const o2::tpc::TrackTPC& _tr, o2::dataformats::GlobalTrackID srcGID, float time0, float terr);
   void addITSTPCSeed(const o2::dataformats::TrackTPCITS& _tr, o2::dataformats::GlobalTrackID srcGID, float time0, float terr);
   void addTRDSeed(const o2::trd::TrackTRD& _tr, o2::dataformats::GlobalTrackID srcGID, float time0, float terr);
@@ -191,6 +191,16 @@ struct MatchRecord {
   }
 };
 
+///< matching candidate found for a sector, registered in the MatchRecords once all sectors are processed
+struct MatchCandidate {
+  int iITS = MinusOne;      ///< id of the ITS track entry in mITSWork
+  int iTPC = MinusOne;      ///< id of the TPC track entry in mTPCWork
+  float chi2 = -1.f;        ///< matching chi2
+  int matchedIC = MinusOne; ///< index of eventually matched InteractionCandidate
+  MatchCandidate(int its, int tpc, float chi2match, int candIC) : iITS(its), iTPC(tpc), chi2(chi2match), matchedIC(candIC) {}
+  MatchCandidate() = default;
+};
+
 ///< Link of the AfterBurner track: update at sertain cluster
 ///< original track in the currently loaded TPC reco output
 struct ABTrackLink : public o2::track::TrackParCov {
@@ -716,6 +726,9 @@ class MatchTPCITS
   ///< per sector indices of ITS track entry in mITSWork
   std::array<std::vector<int>, o2::constants::math::NSectors> mITSSectIndexCache;
 
+  ///< per sector matching candidates, filled in parallel and registered in a fixed sector order
+  std::array<std::vector<MatchCandidate>, o2::constants::math::NSectors> mSectorMatchCandidates;
+
   ///< indices of 1st TPC tracks with time above the ITS ROF time
   std::array<std::vector<int>, o2::constants::math::NSectors> mTPCTimeStart;
   ///< indices of 1st entries of ITS tracks starting at given ROframe
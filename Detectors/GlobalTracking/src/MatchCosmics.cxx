@@ -35,12 +35,24 @@
 #include "CorrectionMapsHelper.h"
 #include <algorithm>
 #include <numeric>
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
 
 using namespace o2::globaltracking;
 
 using GTrackID = o2d::GlobalTrackID;
 using MatCorrType = o2::base::Propagator::MatCorrType;
 
+namespace
+{
+// bin of the value in the seeds index, the values outside of the range are attributed to the edge bins
+inline int getBin(float v, float vMin, float binInv, int nBins)
+{
+  return int(std::clamp((v - vMin) * binInv, 0.f, nBins - 1.f));
+}
+} // namespace
+
 //________________________________________________________
 void MatchCosmics::process(const o2::globaltracking::RecoContainer& data)
 {
@@ -67,13 +79,59 @@ void MatchCosmics::process(const o2::globaltracking::RecoContainer& data)
   std::iota(sortID.begin(), sortID.end(), 0);
   std::sort(sortID.begin(), sortID.end(), [this](int a, int b) { return mSeeds[a].tBracket.getMin() < mSeeds[b].tBracket.getMin(); });
 
-  for (int i = 0; i < ntr; i++) {
-    for (int j = i + 1; j < ntr; j++) {
-      if (checkPair(sortID[i], sortID[j]) == RejTime) {
-        break;
-      }
+  // index the seeds in cells of tgl and q/pt (the latter with the field on only): the legs of a cosmic track have opposite tgl and q/pt,
+  // so that each seed needs to be compared only to the seeds of the cells compatible with the crude cuts of checkPair on these parameters
+  mTglMin = mQ2PtMin = 1e9f;
+  float tglMax = -1e9f, q2ptMax = -1e9f;
+  mMaxSigmaTgl2 = mMaxSigmaQ2Pt2 = 0.f;
+  for (const auto& seed : mSeeds) {
+    if (seed.matchID == Reject) {
+      continue;
+    }
+    mTglMin = std::min(mTglMin, seed.getTgl());
+    tglMax = std::max(tglMax, seed.getTgl());
+    mQ2PtMin = std::min(mQ2PtMin, seed.getQ2Pt());
+    q2ptMax = std::max(q2ptMax, seed.getQ2Pt());
+    mMaxSigmaTgl2 = std::max(mMaxSigmaTgl2, seed.getSigmaTgl2());
+    mMaxSigmaQ2Pt2 = std::max(mMaxSigmaQ2Pt2, seed.getSigma1Pt2());
+  }
+  mNTglBins = std::max(1, mMatchParams->nBinsTgl);
+  mNQ2PtBins = mFieldON ? std::max(1, mMatchParams->nBinsQ2Pt) : 1;
+  mTglBinInv = tglMax > mTglMin ? mNTglBins / (tglMax - mTglMin) : 0.f;
+  mQ2PtBinInv = q2ptMax > mQ2PtMin ? mNQ2PtBins / (q2ptMax - mQ2PtMin) : 0.f;
+  mSeedCells.clear();
+  mSeedCells.resize(mNTglBins * mNQ2PtBins);
+  for (int pos = 0; pos < ntr; pos++) {
+    const auto& seed = mSeeds[sortID[pos]];
+    if (seed.matchID == Reject) {
+      continue;
+    }
+    int binTgl = getBin(seed.getTgl(), mTglMin, mTglBinInv, mNTglBins);
+    int binQ2Pt = getBin(seed.getQ2Pt(), mQ2PtMin, mQ2PtBinInv, mNQ2PtBins);
+    mSeedCells[binTgl * mNQ2PtBins + binQ2Pt].push_back(pos);
+  }
+
+  // the candidates are found in parallel in chunks of the time-sorted seeds and registered in the order of the serial matching,
+  // so that the result does not depend on the number of threads
+  bool parallelMatching = mNThreads > 1;
+#ifdef _ALLOW_DEBUG_TREES_
+  parallelMatching &= !mDBGOut; // the debug trees are filled in checkPair
+#endif
+  int nChunks = parallelMatching ? std::min(ntr, 4 * mNThreads) : 1;
+  std::vector<std::vector<MatchCandidate>> chunkCandidates(nChunks);
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads) if (parallelMatching)
+#endif
+  for (int ich = 0; ich < nChunks; ich++) {
+    findCandidates(sortID, ntr * ich / nChunks, ntr * (ich + 1) / nChunks, chunkCandidates[ich]);
+  }
+  for (const auto& candidates : chunkCandidates) {
+    for (const auto& cand : candidates) {
+      registerMatch(sortID[cand.pos0], sortID[cand.pos1], cand.chi2);
+      registerMatch(sortID[cand.pos1], sortID[cand.pos0], cand.chi2); // the reverse reference can be also done in a separate loop
     }
   }
+  LOG(debug) << "NMatches " << mRecords.size();
 
   selectWinners();
   refitWinners(data);
@@ -85,18 +143,19 @@ void MatchCosmics::process(const o2::globaltracking::RecoContainer& data)
 void MatchCosmics::refitWinners(const o2::globaltracking::RecoContainer& data)
 {
   LOG(info) << "Refitting " << mWinners.size() << " winner matches";
-  int count = 0;
   auto tpcTBinMUSInv = 1. / mTPCTBinMUS;
   const auto& tpcClusRefs = data.getTPCTracksClusterRefs();
   const auto& tpcClusShMap = data.clusterShMapTPC;
   const auto& tpcClusOccMap = data.occupancyMapTPC;
-  std::unique_ptr<o2::gpu::GPUO2InterfaceRefit> tpcRefitter;
+  std::vector<std::unique_ptr<o2::gpu::GPUO2InterfaceRefit>> tpcRefitters(mNThreads);
   if (data.inputsTPCclusters) {
-    tpcRefitter = std::make_unique<o2::gpu::GPUO2InterfaceRefit>(&data.inputsTPCclusters->clusterIndex,
-                                                                 mTPCCorrMapsHelper, mBz,
-                                                                 tpcClusRefs.data(), 0, tpcClusShMap.data(),
-                                                                 tpcClusOccMap.data(), tpcClusOccMap.size(), nullptr, o2::base::Propagator::Instance());
-    tpcRefitter->setTrackReferenceX(900); // disable propagation after refit by setting reference to value > 500
+    for (auto& tpcRefitter : tpcRefitters) {
+      tpcRefitter = std::make_unique<o2::gpu::GPUO2InterfaceRefit>(&data.inputsTPCclusters->clusterIndex,
+                                                                   mTPCCorrMapsHelper, mBz,
+                                                                   tpcClusRefs.data(), 0, tpcClusShMap.data(),
+                                                                   tpcClusOccMap.data(), tpcClusOccMap.size(), nullptr, o2::base::Propagator::Instance());
+      tpcRefitter->setTrackReferenceX(900); // disable propagation after refit by setting reference to value > 500
+    }
   }
 
   const auto& itsClusters = prepareITSClusters(data);
@@ -140,8 +199,13 @@ void MatchCosmics::refitWinners(const o2::globaltracking::RecoContainer& data)
     return nclRefit == ncl ? ncl : -1;
   };
 
-  for (auto winRID : mWinners) {
-    const auto& rec = mRecords[winRID];
+  // the winners are refitted in parallel, each thread with its own TPC refitter, and stored in the order of the winners
+  int nWinners = mWinners.size();
+  std::vector<o2d::TrackCosmics> winTracks(nWinners);
+  std::vector<o2::MCCompLabel> winLabels(mUseMC ? nWinners : 0);
+  std::vector<char> winValid(nWinners, 0);
+  auto refitWinner = [&](int iw, o2::gpu::GPUO2InterfaceRefit* tpcRefitter) {
+    const auto& rec = mRecords[mWinners[iw]];
     int poolEntryID[2] = {rec.id0, rec.id1};
     const o2::track::TrackParCov outerLegs[2] = {data.getTrackParamOut(mSeeds[rec.id0].origID), data.getTrackParamOut(mSeeds[rec.id1].origID)};
     auto tOverlap = mSeeds[rec.id0].tBracket.getOverlap(mSeeds[rec.id1].tBracket);
@@ -153,7 +217,7 @@ void MatchCosmics::refitWinners(const o2::globaltracking::RecoContainer& data)
       btm = 1;
       top = 0;
     }
-    LOG(debug) << "Winner " << count++ << " Record " << winRID << " Partners:"
+    LOG(debug) << "Winner " << iw << " Record " << mWinners[iw] << " Partners:"
                << " B: " << mSeeds[poolEntryID[btm]].origID << "/" << mSeeds[poolEntryID[btm]].origID.getSourceName()
                << " U: " << mSeeds[poolEntryID[top]].origID << "/" << mSeeds[poolEntryID[top]].origID.getSourceName()
                << " | T:" << tOverlap.asString();
@@ -175,7 +239,7 @@ void MatchCosmics::refitWinners(const o2::globaltracking::RecoContainer& data)
       int retVal = tpcRefitter->RefitTrackAsTrackParCov(trCosm, tpcTrOrig.getClusterRef(), t0 * tpcTBinMUSInv, &chi2, false, false); // inward refit, reset
       if (retVal < 0) {                                                                                                             // refit failed
         LOG(debug) << "Inward refit of btm TPC track failed.";
-        continue;
+        return false;
       }
       nclTot += retVal;
       LOG(debug) << "chi2 after btm TPC refit with " << retVal << " clusters : " << chi2 << " orig.chi2 was " << tpcTrOrig.getChi2();
@@ -200,7 +264,7 @@ void MatchCosmics::refitWinners(const o2::globaltracking::RecoContainer& data)
     if (!trCosm.rotate(mSeeds[poolEntryID[top]].getAlpha()) ||
         !o2::base::Propagator::Instance()->PropagateToXBxByBz(trCosm, mSeeds[poolEntryID[top]].getX(), mMatchParams->maxSnp, mMatchParams->maxStep, mMatchParams->matCorr)) {
       LOG(debug) << "Rotation/propagation of btm-track to top-track frame failed.";
-      continue;
+      return false;
     }
     // save bottom parameter at merging point
     auto trCosmBtm = trCosm;
@@ -213,7 +277,7 @@ void MatchCosmics::refitWinners(const o2::globaltracking::RecoContainer& data)
     if (gidxListTop[GTrackID::ITS].isIndexSet()) {
       auto nclfit = refitITSTrack(trCosm, gidxListTop[GTrackID::ITS], chi2, false);
       if (nclfit < 0) {
-        continue;
+        return false;
       }
       LOG(debug) << "chi2 after top ITS refit with " << nclfit << " clusters : " << chi2 << " orig.chi2 was " << data.getITSTrack(gidxListTop[GTrackID::ITS]).getChi2();
       nclTot += nclfit;
@@ -226,14 +290,14 @@ void MatchCosmics::refitWinners(const o2::globaltracking::RecoContainer& data)
         if (!trCosm.getXatLabR(o2::constants::geom::XTPCInnerRef, xtogo, mBz, o2::track::DirOutward) ||
             !o2::base::Propagator::Instance()->PropagateToXBxByBz(trCosm, xtogo, mMatchParams->maxSnp, mMatchParams->maxStep, mMatchParams->matCorr)) {
           LOG(debug) << "Propagation to inner TPC boundary X=" << xtogo << " failed";
-          continue;
+          return false;
         }
       }
       const auto& tpcTrOrig = data.getTPCTrack(gidxListTop[GTrackID::TPC]);
       int retVal = tpcRefitter->RefitTrackAsTrackParCov(trCosm, tpcTrOrig.getClusterRef(), t0 * tpcTBinMUSInv, &chi2, true, false); // outward refit, no reset
       if (retVal < 0) {                                                                                                             // refit failed
         LOG(debug) << "Outward refit of top TPC track failed.";
-        continue;
+        return false;
       } // outward refit in TPC
       LOG(debug) << "chi2 after top TPC refit with " << retVal << " clusters : " << chi2 << " orig.chi2 was " << tpcTrOrig.getChi2();
       nclTot += retVal;
@@ -247,14 +311,14 @@ void MatchCosmics::refitWinners(const o2::globaltracking::RecoContainer& data)
       int retVal = tpcRefitter->RefitTrackAsTrackParCov(trCosmTop, tpcTrOrig.getClusterRef(), t0 * tpcTBinMUSInv, &chi2Dummy, false, true); // inward refit, reset
       if (retVal < 0) {                                                                                                                     // refit failed
         LOG(debug) << "Outward refit of top TPC track failed.";
-        continue;
+        return false;
       } // inward refit in TPC
     }
     // is there ITS sub-track ?
     if (gidxListTop[GTrackID::ITS].isIndexSet()) {
       auto nclfit = refitITSTrack(trCosmTop, gidxListTop[GTrackID::ITS], chi2Dummy, true);
       if (nclfit < 0) {
-        continue;
+        return false;
       }
       nclTot += nclfit;
     } // ITS refit
@@ -262,22 +326,43 @@ void MatchCosmics::refitWinners(const o2::globaltracking::RecoContainer& data)
     if (!trCosmTop.rotate(trCosmBtm.getAlpha()) ||
         !o2::base::Propagator::Instance()->PropagateToXBxByBz(trCosmTop, trCosmBtm.getX(), mMatchParams->maxSnp, mMatchParams->maxStep, mMatchParams->matCorr)) {
       LOG(debug) << "Rotation/propagation of top-track to bottom-track frame failed.";
-      continue;
+      return false;
     }
     // calculate weighted average of 2 legs and chi2
     o2::track::TrackParCov::MatrixDSym5 cov5;
     float chi2Match = trCosmBtm.getPredictedChi2(trCosmTop, cov5);
     if (!trCosmBtm.update(trCosmTop, cov5)) {
       LOG(debug) << "Top/Bottom update failed";
-      continue;
+      return false;
     }
     // create final track
-    mCosmicTracks.emplace_back(mSeeds[poolEntryID[btm]].origID, mSeeds[poolEntryID[top]].origID, trCosmBtm, trCosmTop, chi2, chi2Match, nclTot, t0, dt);
+    winTracks[iw] = o2d::TrackCosmics(mSeeds[poolEntryID[btm]].origID, mSeeds[poolEntryID[top]].origID, trCosmBtm, trCosmTop, chi2, chi2Match, nclTot, t0, dt);
     if (mUseMC) {
       o2::MCCompLabel lbl[2] = {data.getTrackMCLabel(mSeeds[poolEntryID[btm]].origID), data.getTrackMCLabel(mSeeds[poolEntryID[top]].origID)};
-      auto& tlb = mCosmicTracksLbl.emplace_back((nclBtm > nclTot - nclBtm ? lbl[0] : lbl[1]));
+      auto& tlb = winLabels[iw] = (nclBtm > nclTot - nclBtm ? lbl[0] : lbl[1]);
       tlb.setFakeFlag(lbl[0] != lbl[1]);
     }
+    return true;
+  };
+
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+  for (int iw = 0; iw < nWinners; iw++) {
+#ifdef WITH_OPENMP
+    int ith = omp_get_thread_num();
+#else
+    int ith = 0;
+#endif
+    winValid[iw] = refitWinner(iw, tpcRefitters[ith].get());
+  }
+  for (int iw = 0; iw < nWinners; iw++) {
+    if (winValid[iw]) {
+      mCosmicTracks.push_back(winTracks[iw]);
+      if (mUseMC) {
+        mCosmicTracksLbl.push_back(winLabels[iw]);
+      }
+    }
   }
   LOG(info) << "Validated " << mCosmicTracks.size() << " top-bottom tracks in TF# " << mTFCount;
 }
@@ -365,7 +450,49 @@ void MatchCosmics::suppressMatch(int partner0, int partner1)
 }
 
 //________________________________________________________
-MatchCosmics::RejFlag MatchCosmics::checkPair(int i, int j)
+void MatchCosmics::findCandidates(const std::vector<int>& sortID, int posMin, int posMax, std::vector<MatchCandidate>& candidates)
+{
+  ///< compare the seeds at positions [posMin : posMax) of the time-sorted seeds to the following seeds of the compatible cells
+  candidates.clear();
+  for (int pos0 = posMin; pos0 < posMax; pos0++) {
+    int i = sortID[pos0];
+    const auto& seed0 = mSeeds[i];
+    if (seed0.matchID == Reject) {
+      continue;
+    }
+    // window of the partner tgl (q/pt) allowed by the crude cut of checkPair for the largest partner error
+    float tolTgl = std::sqrt((mMatchParams->systSigma2[o2::track::kTgl] + seed0.getSigmaTgl2() + mMaxSigmaTgl2) * mMatchParams->crudeNSigma2Cut[o2::track::kTgl]);
+    int binTglMin = getBin(-seed0.getTgl() - tolTgl, mTglMin, mTglBinInv, mNTglBins);
+    int binTglMax = getBin(-seed0.getTgl() + tolTgl, mTglMin, mTglBinInv, mNTglBins);
+    int binQ2PtMin = 0, binQ2PtMax = 0;
+    if (mNQ2PtBins > 1) {
+      float tolQ2Pt = std::sqrt((mMatchParams->systSigma2[o2::track::kQ2Pt] + seed0.getSigma1Pt2() + mMaxSigmaQ2Pt2) * mMatchParams->crudeNSigma2Cut[o2::track::kQ2Pt]);
+      binQ2PtMin = getBin(-seed0.getQ2Pt() - tolQ2Pt, mQ2PtMin, mQ2PtBinInv, mNQ2PtBins);
+      binQ2PtMax = getBin(-seed0.getQ2Pt() + tolQ2Pt, mQ2PtMin, mQ2PtBinInv, mNQ2PtBins);
+    }
+    size_t firstCand = candidates.size();
+    for (int binTgl = binTglMin; binTgl <= binTglMax; binTgl++) {
+      for (int binQ2Pt = binQ2PtMin; binQ2Pt <= binQ2PtMax; binQ2Pt++) {
+        const auto& cell = mSeedCells[binTgl * mNQ2PtBins + binQ2Pt];
+        for (auto it = std::upper_bound(cell.begin(), cell.end(), pos0); it != cell.end(); ++it) {
+          float chi2 = 0.f;
+          auto rej = checkPair(i, sortID[*it], chi2);
+          if (rej == RejTime) {
+            break;
+          }
+          if (rej == Accept) {
+            candidates.push_back(MatchCandidate{pos0, *it, chi2});
+          }
+        }
+      }
+    }
+    // restore the order of the partners in time, as they were collected cell by cell
+    std::sort(candidates.begin() + firstCand, candidates.end(), [](const MatchCandidate& a, const MatchCandidate& b) { return a.pos1 < b.pos1; });
+  }
+}
+
+//________________________________________________________
+MatchCosmics::RejFlag MatchCosmics::checkPair(int i, int j, float& chi2)
 {
   // if validated with given chi2, register match
   RejFlag rej = RejOther;
@@ -383,10 +510,10 @@ MatchCosmics::RejFlag MatchCosmics::checkPair(int i, int j)
   LOG(debug) << seed0.origID << " | " << seed0.o2::track::TrackPar::asString();
   LOG(debug) << seed1.origID << " | " << seed1.o2::track::TrackPar::asString();
 
+  chi2 = 1.e9f;
   if (seed1.tBracket > seed0.tBracket) {
     return (rej = RejTime); // since the brackets are sorted in tmin, all following tbj will also exceed tbi
   }
-  float chi2 = 1.e9f;
 
   // check
   // 1) crude check on tgl and q/pt (if B!=0). Note: back-to-back tracks will have mutually params (see TrackPar::invertParam)
@@ -445,9 +572,7 @@ MatchCosmics::RejFlag MatchCosmics::checkPair(int i, int j)
       break;
     }
     rej = Accept;
-    registerMatch(i, j, chi2);
-    registerMatch(j, i, chi2); // the reverse reference can be also done in a separate loop
-    LOG(debug) << "Chi2 = " << chi2 << " NMatches " << mRecords.size();
+    LOG(debug) << "Chi2 = " << chi2;
     break;
   }
 
@@ -568,6 +693,17 @@ std::vector<o2::BaseCluster<float>> MatchCosmics::prepareITSClusters(const o2::g
   return std::move(itscl);
 }
 
+//______________________________________________
+void MatchCosmics::setNThreads(int n)
+{
+#ifdef WITH_OPENMP
+  mNThreads = n > 0 ? n : 1;
+#else
+  LOG(warning) << "Multithreading is not supported, imposing single thread";
+  mNThreads = 1;
+#endif
+}
+
 //______________________________________________
 void MatchCosmics::end()
 {
@@ -10,6 +10,11 @@
 // or submit itself to any jurisdiction.
 
 #include "GlobalTracking/MatchGlobalFwd.h"
+#include <algorithm>
+
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
 
 using namespace o2::globaltracking;
 
@@ -66,6 +71,11 @@ void MatchGlobalFwd::init()
 
   mSaveMode = matchingParam.saveMode;
   LOG(info) << "Save mode MFTMCH candidates = " << mSaveMode;
+
+  mMatchPlaneMaxDXY = matchingParam.matchPlaneMaxDXY;
+  if (mMatchPlaneMaxDXY > 0) {
+    LOG(info) << "MFTMCH pairs preselection: max XY distance at matching plane = " << mMatchPlaneMaxDXY;
+  }
 }
 
 //_________________________________________________________
@@ -334,7 +344,12 @@ void MatchGlobalFwd::doMatching()
   // Range of compatible MCH ROFS for the first MFT track
   int nMCHROFs = mMCHROFTimes.size();
 
-  LOG(info) << "Running MCH-MFT Track Matching.";
+  LOG(info) << "Running MCH-MFT Track Matching with " << mNThreads << " threads.";
+  if (mMatchPlaneMaxDXY > 0) {
+    buildMFTGrid();
+  }
+  mMFTCandidatesTmp.resize(mNThreads);
+  std::vector<std::array<int, 3>> rofWindows; // MFT ROF and range of overlapping MCH ROFs
   // ROFrame of first MFT track
   auto firstMFTTrackIdInROF = 0;
   auto MFTROFId = mMFTWork.front().roFrame;
@@ -376,7 +391,15 @@ void MatchGlobalFwd::doMatching()
                << mMCHROFTimes[mchROFMatchLast].getMin() << ","
                << mMCHROFTimes[mchROFMatchLast].getMax() << "]  size: " << mMCHTrackROFRec[mchROFMatchLast].getNEntries();
 
-    ROFMatch<saveAllMode>(MFTROFId, mchROFMatchFirst, mchROFMatchLast);
+    rofWindows.push_back({MFTROFId, mchROFMatchFirst, mchROFMatchLast});
+  }
+
+  if (saveAllMode == SaveMode::kBestMatch && mNThreads > 1) { // the other modes fill the output containers while matching
+    matchBestParallel(rofWindows);
+  } else {
+    for (const auto& win : rofWindows) {
+      ROFMatch<saveAllMode>(win[0], win[1], win[2]);
+    }
   }
 
   if constexpr (saveAllMode == SaveMode::kBestMatch) { // Otherwise output container is filled by ROFMatch()
@@ -422,8 +445,6 @@ void MatchGlobalFwd::ROFMatch(int MFTROFId, int firstMCHROFId, int lastMCHROFId)
   auto nMFTTracks = thisMFTROF.getNEntries();
   auto nMCHTracks = lastMCHTrackID - firstMCHTrackID + 1;
 
-  auto& matchAllChi2 = mMatchingFunctionMap["matchALL"];
-
   LOG(debug) << "Matching MFT ROF " << MFTROFId << " with MCH ROFs [" << firstMCHROFId << "->" << lastMCHROFId << "]";
   LOG(debug) << "   firstMFTTrackID = " << firstMFTTrackID << " ; lastMFTTrackID = " << lastMFTTrackID;
   LOG(debug) << "   firstMCHTrackID = " << firstMCHTrackID << " ; lastMCHTrackID = " << lastMCHTrackID;
@@ -433,60 +454,163 @@ void MatchGlobalFwd::ROFMatch(int MFTROFId, int firstMCHROFId, int lastMCHROFId)
 
   // loop over all MCH tracks
   for (auto MCHId = firstMCHTrackID; MCHId <= lastMCHTrackID; MCHId++) {
-    auto& thisMCHTrack = mMCHWork[MCHId];
-    o2::MCCompLabel matchLabel;
-    for (auto MFTId = firstMFTTrackID; MFTId <= lastMFTTrackID; MFTId++) {
-      auto& thisMFTTrack = mMFTWork[MFTId];
+    matchMCHTrack<saveAllMode>(MCHId, MFTROFId, mMFTCandidatesTmp[0], nFakes, nTrue);
+    const auto& thisMCHTrack = mMCHWork[MCHId];
+    auto bestMFTMatchID = thisMCHTrack.getMFTTrackID();
+    LOG(debug) << "       Matching MCHId = " << MCHId << " ==> bestMFTMatchID = " << thisMCHTrack.getMFTTrackID() << " ; thisMCHTrack.getMFTMCHMatchingChi2() =  " << thisMCHTrack.getMFTMCHMatchingChi2();
+    LOG(debug) << "         MCH COV<X,X> = " << thisMCHTrack.getSigma2X() << " ; COV<Y,Y> = " << thisMCHTrack.getSigma2Y() << " ; pt = " << thisMCHTrack.getPt();
+
+  } // /loop over MCH tracks seeds
+
+  LOG(debug) << "Finished matching MFT ROF " << MFTROFId << ": " << nMFTTracks << " MFT tracks and " << nMCHTracks << "  MCH Tracks.";
+  if (mMCTruthON) {
+    LOG(debug) << "   nFakes = " << nFakes << " nTrue = " << nTrue;
+  }
+}
+
+//_________________________________________________________
+template <Int_t saveAllMode>
+void MatchGlobalFwd::matchMCHTrack(int MCHId, int MFTROFId, std::vector<int>& mftCandidates, int& nFakes, int& nTrue)
+{
+  /// Matches one MCH track with the MFT tracks of one ROF
+  const auto& matchAllChi2 = mMatchingFunctionMap.at("matchALL");
+  auto& thisMCHTrack = mMCHWork[MCHId];
+  o2::MCCompLabel matchLabel;
+  selectMFTCandidates(thisMCHTrack, MFTROFId, mftCandidates);
+  for (auto MFTId : mftCandidates) {
+    auto& thisMFTTrack = mMFTWork[MFTId];
+    if (mMCTruthON) {
+      matchLabel = computeLabel(MCHId, MFTId);
+    }
+    if (mCutFunc(thisMCHTrack, thisMFTTrack)) {
+      thisMCHTrack.countMFTCandidate();
       if (mMCTruthON) {
-        matchLabel = computeLabel(MCHId, MFTId);
+        if (matchLabel.isCorrect()) {
+          thisMCHTrack.setCloseMatch();
+        }
+      }
+      auto score = mMatchFunc(thisMCHTrack, thisMFTTrack);
+      if (score < thisMCHTrack.getMFTMCHMatchingScore()) {
+        thisMCHTrack.setMFTTrackID(MFTId);
+        auto chi2 = matchAllChi2(thisMCHTrack, thisMFTTrack); // Matching chi2 is stored independently
+        thisMCHTrack.setMFTMCHMatchingScore(score);
+        thisMCHTrack.setMFTMCHMatchingChi2(chi2);
       }
-      if (mCutFunc(thisMCHTrack, thisMFTTrack)) {
-        thisMCHTrack.countMFTCandidate();
+      if constexpr (saveAllMode == SaveMode::kSaveAll) { // In saveAllmode save all pairs to output container
+        thisMCHTrack.setMFTTrackID(MFTId);
+        mMatchedTracks.emplace_back(thisMCHTrack);
+        mMatchingInfo.emplace_back(thisMCHTrack);
         if (mMCTruthON) {
-          if (matchLabel.isCorrect()) {
-            thisMCHTrack.setCloseMatch();
-          }
-        }
-        auto score = mMatchFunc(thisMCHTrack, thisMFTTrack);
-        if (score < thisMCHTrack.getMFTMCHMatchingScore()) {
-          thisMCHTrack.setMFTTrackID(MFTId);
-          auto chi2 = matchAllChi2(thisMCHTrack, thisMFTTrack); // Matching chi2 is stored independently
-          thisMCHTrack.setMFTMCHMatchingScore(score);
-          thisMCHTrack.setMFTMCHMatchingChi2(chi2);
-        }
-        if constexpr (saveAllMode == SaveMode::kSaveAll) { // In saveAllmode save all pairs to output container
-          thisMCHTrack.setMFTTrackID(MFTId);
-          mMatchedTracks.emplace_back(thisMCHTrack);
-          mMatchingInfo.emplace_back(thisMCHTrack);
-          if (mMCTruthON) {
-            mMatchLabels.push_back(matchLabel);
-            mMatchLabels.back().isFake() ? nFakes++ : nTrue++;
-          }
+          mMatchLabels.push_back(matchLabel);
+          mMatchLabels.back().isFake() ? nFakes++ : nTrue++;
         }
+      }
 
-        if constexpr (saveAllMode == SaveMode::kSaveTrainingData) { // In save training data mode store track parameters at matching plane
-          thisMCHTrack.setMFTTrackID(MFTId);
-          mMatchingInfo.emplace_back(thisMCHTrack);
-          mMCHMatchPlaneParams.emplace_back(thisMCHTrack);
-          mMFTMatchPlaneParams.emplace_back(static_cast<o2::mft::TrackMFT>(thisMFTTrack));
+      if constexpr (saveAllMode == SaveMode::kSaveTrainingData) { // In save training data mode store track parameters at matching plane
+        thisMCHTrack.setMFTTrackID(MFTId);
+        mMatchingInfo.emplace_back(thisMCHTrack);
+        mMCHMatchPlaneParams.emplace_back(thisMCHTrack);
+        mMFTMatchPlaneParams.emplace_back(static_cast<o2::mft::TrackMFT>(thisMFTTrack));
 
-          if (mMCTruthON) {
-            mMatchLabels.push_back(matchLabel);
-            mMatchLabels.back().isFake() ? nFakes++ : nTrue++;
-          }
+        if (mMCTruthON) {
+          mMatchLabels.push_back(matchLabel);
+          mMatchLabels.back().isFake() ? nFakes++ : nTrue++;
         }
       }
     }
-    auto bestMFTMatchID = thisMCHTrack.getMFTTrackID();
-    LOG(debug) << "       Matching MCHId = " << MCHId << " ==> bestMFTMatchID = " << thisMCHTrack.getMFTTrackID() << " ; thisMCHTrack.getMFTMCHMatchingChi2() =  " << thisMCHTrack.getMFTMCHMatchingChi2();
-    LOG(debug) << "         MCH COV<X,X> = " << thisMCHTrack.getSigma2X() << " ; COV<Y,Y> = " << thisMCHTrack.getSigma2Y() << " ; pt = " << thisMCHTrack.getPt();
+  }
+}
 
-  } // /loop over MCH tracks seeds
+//_________________________________________________________
+void MatchGlobalFwd::matchBestParallel(const std::vector<std::array<int, 3>>& rofWindows)
+{
+  /// Best match of the MCH tracks in the MFT ROF windows. Each MCH track is matched with the MFT ROFs in the order
+  /// of the serial matching, the result does not depend on the number of threads
+  int nMCH = mMCHWork.size();
+  std::vector<int> winFirst(nMCH + 1, 0), winIDs;
+  for (const auto& win : rofWindows) {
+    for (auto MCHId = mMCHTrackROFRec[win[1]].getFirstIdx(); MCHId <= mMCHTrackROFRec[win[2]].getLastIdx(); MCHId++) {
+      winFirst[MCHId + 1]++;
+    }
+  }
+  for (int i = 0; i < nMCH; i++) {
+    winFirst[i + 1] += winFirst[i];
+  }
+  winIDs.resize(winFirst[nMCH]);
+  std::vector<int> winFill(winFirst.begin(), winFirst.end() - 1);
+  for (int iw = 0; iw < (int)rofWindows.size(); iw++) {
+    const auto& win = rofWindows[iw];
+    for (auto MCHId = mMCHTrackROFRec[win[1]].getFirstIdx(); MCHId <= mMCHTrackROFRec[win[2]].getLastIdx(); MCHId++) {
+      winIDs[winFill[MCHId]++] = iw;
+    }
+  }
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+  for (int MCHId = 0; MCHId < nMCH; MCHId++) {
+#ifdef WITH_OPENMP
+    auto& mftCandidates = mMFTCandidatesTmp[omp_get_thread_num()];
+#else
+    auto& mftCandidates = mMFTCandidatesTmp[0];
+#endif
+    int nFakes = 0, nTrue = 0;
+    for (int i = winFirst[MCHId]; i < winFirst[MCHId + 1]; i++) {
+      matchMCHTrack<kBestMatch>(MCHId, rofWindows[winIDs[i]][0], mftCandidates, nFakes, nTrue);
+    }
+  }
+}
 
-  LOG(debug) << "Finished matching MFT ROF " << MFTROFId << ": " << nMFTTracks << " MFT tracks and " << nMCHTracks << "  MCH Tracks.";
-  if (mMCTruthON) {
-    LOG(debug) << "   nFakes = " << nFakes << " nTrue = " << nTrue;
+//_________________________________________________________
+void MatchGlobalFwd::buildMFTGrid()
+{
+  /// Index the MFT tracks of each ROF on a XY grid at the matching plane with the cell size equal to the max distance of
+  /// the pairs, so that the candidates of an MCH track are in the 3x3 cells around it
+  mMFTGrid.resize(mMFTWork.size());
+  for (int MFTId = 0; MFTId < (int)mMFTWork.size(); MFTId++) {
+    mMFTGrid[MFTId] = {getMFTGridCell(mMFTWork[MFTId].getX(), mMFTWork[MFTId].getY()), MFTId};
+  }
+  for (const auto& rof : mMFTTrackROFRec) {
+    std::sort(mMFTGrid.begin() + rof.getFirstEntry(), mMFTGrid.begin() + rof.getFirstEntry() + rof.getNEntries());
+  }
+}
+
+//_________________________________________________________
+void MatchGlobalFwd::selectMFTCandidates(const TrackLocMCH& mchTrack, int MFTROFId, std::vector<int>& mftCandidates) const
+{
+  const auto& rof = mMFTTrackROFRec[MFTROFId];
+  mftCandidates.clear();
+  if (mMatchPlaneMaxDXY <= 0) {
+    for (int MFTId = rof.getFirstEntry(); MFTId < rof.getFirstEntry() + rof.getNEntries(); MFTId++) {
+      mftCandidates.push_back(MFTId);
+    }
+    return;
+  }
+  auto gridBeg = mMFTGrid.begin() + rof.getFirstEntry(), gridEnd = gridBeg + rof.getNEntries();
+  int ix = getMFTGridBin(mchTrack.getX()), iy = getMFTGridBin(mchTrack.getY());
+  for (int jx = std::max(0, ix - 1); jx <= std::min(NMFTGridBins - 1, ix + 1); jx++) {
+    for (int jy = std::max(0, iy - 1); jy <= std::min(NMFTGridBins - 1, iy + 1); jy++) {
+      int cell = jx * NMFTGridBins + jy;
+      auto it = std::lower_bound(gridBeg, gridEnd, std::pair<int, int>{cell, -1});
+      for (; it != gridEnd && it->first == cell; ++it) {
+        const auto& mftTrack = mMFTWork[it->second];
+        if (std::abs(mftTrack.getX() - mchTrack.getX()) <= mMatchPlaneMaxDXY && std::abs(mftTrack.getY() - mchTrack.getY()) <= mMatchPlaneMaxDXY) {
+          mftCandidates.push_back(it->second);
+        }
+      }
+    }
   }
+  std::sort(mftCandidates.begin(), mftCandidates.end()); // keep the order of the tracks, as without preselection
+}
+
+//_________________________________________________________
+void MatchGlobalFwd::setNThreads(int n)
+{
+#ifdef WITH_OPENMP
+  mNThreads = n > 0 ? n : 1;
+#else
+  LOG(warning) << "Multithreading is not supported, imposing single thread";
+  mNThreads = 1;
+#endif
 }
 
 //_________________________________________________________
@@ -550,12 +674,13 @@ void MatchGlobalFwd::fitTracks()
 {
   LOG(info) << "Fitting global muon tracks...";
 
-  auto GTrackID = 0;
-
-  for (auto& track : mMatchedTracks) {
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+  for (int GTrackID = 0; GTrackID < (int)mMatchedTracks.size(); GTrackID++) {
+    auto& track = mMatchedTracks[GTrackID];
     LOG(debug) << "  ==> Fitting Global Track # " << GTrackID << " with MFT track # " << track.getMFTTrackID() << ":";
     fitGlobalMuonTrack(track);
-    GTrackID++;
   }
 
   LOG(info) << "Finished fitting global muon tracks.";
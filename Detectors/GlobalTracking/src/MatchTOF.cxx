@@ -416,16 +416,11 @@ bool MatchTOF::prepareTPCData()
   };
   mRecoCont->createTracksVariadic(creator);
 
-#ifdef WITH_OPENMP
-#pragma omp parallel for schedule(dynamic) num_threads(mNlanes)
-#endif
-  for (int sec = o2::constants::math::NSectors - 1; sec > -1; sec--) {
-    if (mIsTPCused) {
-      propagateTPCTracks(sec);
-    }
-    if (mIsITSTPCused || mIsTPCTRDused || mIsITSTPCTRDused) {
-      propagateConstrTracks(sec);
-    }
+  if (mIsTPCused) {
+    propagateTracks(trkType::UNCONS);
+  }
+  if (mIsITSTPCused || mIsTPCTRDused || mIsITSTPCTRDused) {
+    propagateTracks(trkType::CONSTR);
   }
 
   // re-assign tracks which change sector (no multi-threading)
@@ -532,92 +527,96 @@ bool MatchTOF::prepareTPCData()
 }
 
 //______________________________________________
-void MatchTOF::propagateTPCTracks(int sec)
+void MatchTOF::propagateTracks(int type)
 {
-  auto& trkWork = mTracksWork[sec][trkType::UNCONS];
-
-  for (int it = 0; it < trkWork.size(); it++) {
-    o2::track::TrackParCov& trc = trkWork[it].first;
-
-    o2::track::TrackLTIntegral& intLT0 = mLTinfos[sec][trkType::UNCONS][it];
-
-    const auto& trackTune = TrackTuneParams::Instance();
-    if (!trackTune.sourceLevelTPC) { // correct only if TPC track was not corrected at the source level
-      if (trackTune.useTPCOuterCorr) {
-        trc.updateParams(trackTune.tpcParOuter);
-      }
-      if (trackTune.tpcCovOuterType != TrackTuneParams::AddCovType::Disable) { // only TRD-refitted track have cov.matrix already man>
-        trc.updateCov(mCovDiagOuter, trackTune.tpcCovOuterType == TrackTuneParams::AddCovType::WithCorrelations);
-      }
-    }
-    if (!propagateToRefXWithoutCov(trc, mXRef, 10, mBz)) { // we first propagate to 371 cm without considering the covariance matri
-      mNotPropagatedToTOF[trkType::UNCONS]++;
-      continue;
-    }
-
-    if (trc.getX() < o2::constants::geom::XTPCOuterRef - 1.) {
-      if (!propagateToRefXWithoutCov(trc, o2::constants::geom::XTPCOuterRef, 10, mBz) || TMath::Abs(trc.getZ()) > Geo::MAXHZTOF) { // we check that the propagat>
-        mNotPropagatedToTOF[trkType::UNCONS]++;
-        continue;
-      }
-    }
-
-    o2::base::Propagator::Instance()->estimateLTFast(intLT0, trc);
-
-    // the "rough" propagation worked; now we can propagate considering also the cov matrix
-    if (!propagateToRefX(trc, mXRef, 2, intLT0)) { // || TMath::Abs(trc.getZ()) > Geo::MAXHZTOF) { // we check that the propagation with the cov matrix w>
-      mNotPropagatedToTOF[trkType::UNCONS]++;
-      continue;
+  // propagate the tracks of all sectors to TOF in a single loop over the tracks, which is better balanced than a loop over
+  // the sectors, then register them in their sector at TOF in the order of the tracks
+  std::vector<std::pair<int, int>> trackRefs; // sector and index of the track in the sector work array
+  for (int sec = o2::constants::math::NSectors - 1; sec > -1; sec--) {
+    for (int it = 0; it < mTracksWork[sec][type].size(); it++) {
+      trackRefs.emplace_back(sec, it);
     }
-
-    //  printf("time0 %f -> %f (diff = %f, err = %f)\n",trackTime0, time0, trackTime0 - time0, terr);
-    //  printf("time errors %f,%f -> %f,%f\n",(_tr.getDeltaTBwd() + 5) * mTPCTBinMUS,(_tr.getDeltaTFwd() + 5) * mTPCTBinMUS,trackTime0 - time0 + terr, ti>
-
-    std::array<float, 3> globalPos;
-    trc.getXYZGlo(globalPos);
-    int sector = o2::math_utils::angle2Sector(TMath::ATan2(globalPos[1], globalPos[0]));
-
-    if (sector == sec) {
-      mTracksSectIndexCache[trkType::UNCONS][sector].push_back(it);
+  }
+  std::vector<int> sectorAtTOF(trackRefs.size());
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic, 16) num_threads(mNlanes)
+#endif
+  for (int i = 0; i < (int)trackRefs.size(); i++) {
+    sectorAtTOF[i] = type == trkType::UNCONS ? propagateTPCTrack(trackRefs[i].first, trackRefs[i].second) : propagateConstrTrack(trackRefs[i].first, trackRefs[i].second);
+  }
+  for (int i = 0; i < (int)trackRefs.size(); i++) {
+    auto [sec, it] = trackRefs[i];
+    int sector = sectorAtTOF[i];
+    if (sector < 0) {
+      mNotPropagatedToTOF[type]++;
+    } else if (sector == sec) {
+      mTracksSectIndexCache[type][sector].push_back(it);
     } else {
-      mTracksSeed[trkType::UNCONS][sec].push_back(it); // to be moved to another sector
+      mTracksSeed[type][sec].push_back(it); // to be moved to another sector
     }
   }
 }
+
 //______________________________________________
-void MatchTOF::propagateConstrTracks(int sec)
+int MatchTOF::propagateTPCTrack(int sec, int it)
 {
-  std::array<float, 3> globalPos;
-
-  auto& trkWork = mTracksWork[sec][trkType::CONSTR];
-
-  for (int it = 0; it < trkWork.size(); it++) {
-    o2::track::TrackParCov& trc = trkWork[it].first;
-    o2::track::TrackLTIntegral& intLT0 = mLTinfos[sec][trkType::CONSTR][it];
+  // propagate unconstrained track to TOF, return its sector there or -1 if failed
+  o2::track::TrackParCov& trc = mTracksWork[sec][trkType::UNCONS][it].first;
+  o2::track::TrackLTIntegral& intLT0 = mLTinfos[sec][trkType::UNCONS][it];
 
-    // propagate to matching Xref
-    if (!propagateToRefXWithoutCov(trc, mXRef, 2, mBz)) { // we first propagate to 371 cm without considering the covariance matrix
-      mNotPropagatedToTOF[trkType::CONSTR]++;
-      continue;
+  const auto& trackTune = TrackTuneParams::Instance();
+  if (!trackTune.sourceLevelTPC) { // correct only if TPC track was not corrected at the source level
+    if (trackTune.useTPCOuterCorr) {
+      trc.updateParams(trackTune.tpcParOuter);
+    }
+    if (trackTune.tpcCovOuterType != TrackTuneParams::AddCovType::Disable) { // only TRD-refitted track have cov.matrix already man>
+      trc.updateCov(mCovDiagOuter, trackTune.tpcCovOuterType == TrackTuneParams::AddCovType::WithCorrelations);
     }
+  }
+  if (!propagateToRefXWithoutCov(trc, mXRef, 10, mBz)) { // we first propagate to 371 cm without considering the covariance matri
+    return -1;
+  }
 
-    // the "rough" propagation worked; now we can propagate considering also the cov matrix
-    if (!propagateToRefX(trc, mXRef, 2, intLT0) || TMath::Abs(trc.getZ()) > Geo::MAXHZTOF) { // we check that the propagation with the cov matrix worked;>
-      mNotPropagatedToTOF[trkType::CONSTR]++;
-      continue;
+  if (trc.getX() < o2::constants::geom::XTPCOuterRef - 1.) {
+    if (!propagateToRefXWithoutCov(trc, o2::constants::geom::XTPCOuterRef, 10, mBz) || TMath::Abs(trc.getZ()) > Geo::MAXHZTOF) { // we check that the propagat>
+      return -1;
     }
+  }
 
-    trc.getXYZGlo(globalPos);
+  o2::base::Propagator::Instance()->estimateLTFast(intLT0, trc);
 
-    int sector = o2::math_utils::angle2Sector(TMath::ATan2(globalPos[1], globalPos[0]));
+  // the "rough" propagation worked; now we can propagate considering also the cov matrix
+  if (!propagateToRefX(trc, mXRef, 2, intLT0)) { // || TMath::Abs(trc.getZ()) > Geo::MAXHZTOF) { // we check that the propagation with the cov matrix w>
+    return -1;
+  }
 
-    if (sector == sec) {
-      mTracksSectIndexCache[trkType::CONSTR][sector].push_back(it);
-    } else {
-      mTracksSeed[trkType::CONSTR][sec].push_back(it); // to be moved to another sector
-    }
+  std::array<float, 3> globalPos;
+  trc.getXYZGlo(globalPos);
+  return o2::math_utils::angle2Sector(TMath::ATan2(globalPos[1], globalPos[0]));
+}
+
+//______________________________________________
+int MatchTOF::propagateConstrTrack(int sec, int it)
+{
+  // propagate constrained track to TOF, return its sector there or -1 if failed
+  o2::track::TrackParCov& trc = mTracksWork[sec][trkType::CONSTR][it].first;
+  o2::track::TrackLTIntegral& intLT0 = mLTinfos[sec][trkType::CONSTR][it];
+
+  // propagate to matching Xref
+  if (!propagateToRefXWithoutCov(trc, mXRef, 2, mBz)) { // we first propagate to 371 cm without considering the covariance matrix
+    return -1;
+  }
+
+  // the "rough" propagation worked; now we can propagate considering also the cov matrix
+  if (!propagateToRefX(trc, mXRef, 2, intLT0) || TMath::Abs(trc.getZ()) > Geo::MAXHZTOF) { // we check that the propagation with the cov matrix worked;>
+    return -1;
   }
+
+  std::array<float, 3> globalPos;
+  trc.getXYZGlo(globalPos);
+  return o2::math_utils::angle2Sector(TMath::ATan2(globalPos[1], globalPos[0]));
 }
+
 //______________________________________________
 void MatchTOF::addITSTPCSeed(const o2::dataformats::TrackTPCITS& _tr, o2::dataformats::GlobalTrackID srcGID, float time0, float terr)
 {
@@ -104,9 +104,23 @@ void MatchTPCITS::run(const o2::globaltracking::RecoContainer& inp,
     }
 
     mTimer[SWDoMatching].Start(false);
-    for (int sec = o2::constants::math::NSectors; sec--;) {
+    bool parallelMatching = mNThreads > 1;
+#ifdef _ALLOW_DEBUG_TREES_
+    parallelMatching &= !mDBGOut; // the debug trees are filled in the matching loop
+#endif
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads) if (parallelMatching)
+#endif
+    for (int sec = 0; sec < o2::constants::math::NSectors; sec++) {
       doMatching(sec);
     }
+    // register the candidates in the order of the serial matching, the result does not depend on the number of threads
+    for (int sec = o2::constants::math::NSectors; sec--;) {
+      for (const auto& cand : mSectorMatchCandidates[sec]) {
+        registerMatchRecordTPC(cand.iITS, cand.iTPC, cand.chi2, cand.matchedIC);
+      }
+      mNMatchesControl += mSectorMatchCandidates[sec].size();
+    }
     mTimer[SWDoMatching].Stop();
     if constexpr (false) { // enabling this creates very verbose output
       mTimer[SWTot].Stop();
@@ -183,6 +197,7 @@ void MatchTPCITS::clear()
     mITSTimeStart[sec].clear();
     mTPCSectIndexCache[sec].clear();
     mTPCTimeStart[sec].clear();
+    mSectorMatchCandidates[sec].clear();
   }
 
   if (mMCTruthON) {
@@ -839,7 +854,9 @@ bool MatchTPCITS::prepareFITData()
 //_____________________________________________________
 void MatchTPCITS::doMatching(int sec)
 {
-  ///< run matching for currently cached ITS data for given TPC sector
+  ///< run matching for currently cached ITS data for given TPC sector, the candidates are stored in mSectorMatchCandidates[sec]
+  auto& candidates = mSectorMatchCandidates[sec];
+  candidates.clear();
   auto& cacheITS = mITSSectIndexCache[sec]; // array of cached ITS track indices for this sector
   auto& cacheTPC = mTPCSectIndexCache[sec]; // array of cached ITS track indices for this sector
   auto& timeStartTPC = mTPCTimeStart[sec];  // array of 1st TPC track with timeMax in ITS ROFrame
@@ -985,7 +1002,7 @@ void MatchTPCITS::doMatching(int sec)
           continue;
         }
       }
-      registerMatchRecordTPC(cacheITS[iits], cacheTPC[itpc], chi2, matchedIC); // register matching candidate
+      candidates.emplace_back(cacheITS[iits], cacheTPC[itpc], chi2, matchedIC); // matching candidate to be registered
       nMatchesControl++;
     }
   }
@@ -994,7 +1011,6 @@ void MatchTPCITS::doMatching(int sec)
               << " N TPC tracks checked: " << nCheckTPCControl << " (starting from " << idxMinTPC
               << "), checks: " << nCheckITSControl << ", matches:" << nMatchesControl;
   }
-  mNMatchesControl += nMatchesControl;
 }
 
 //______________________________________________
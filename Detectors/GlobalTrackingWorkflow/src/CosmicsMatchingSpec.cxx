@@ -91,6 +91,7 @@ void CosmicsMatchingSpec::init(InitContext& ic)
   o2::base::GRPGeomHelper::instance().setRequest(mGGCCDBRequest);
   mMatching.setDebugFlag(ic.options().get<int>("debug-tree-flags"));
   mMatching.setUseMC(mUseMC);
+  mMatching.setNThreads(std::max(1, ic.options().get<int>("nthreads")));
   mTPCCorrMapsLoader.init(ic);
   //
 }
@@ -181,7 +182,8 @@ DataProcessorSpec getCosmicsMatchingSpec(GTrackID::mask_t src, bool useMC, const
   std::vector<OutputSpec> outputs;
   Options opts{
     {"material-lut-path", VariantType::String, "", {"Path of the material LUT file"}},
-    {"debug-tree-flags", VariantType::Int, 0, {"DebugFlagTypes bit-pattern for debug tree"}}};
+    {"debug-tree-flags", VariantType::Int, 0, {"DebugFlagTypes bit-pattern for debug tree"}},
+    {"nthreads", VariantType::Int, 1, {"Number of matching threads"}}};
 
   auto dataRequest = std::make_shared<DataRequest>();
 
@@ -56,7 +56,7 @@ void StrangenessTrackerSpec::init(framework::InitContext& ic)
   o2::base::GRPGeomHelper::instance().setRequest(mGGCCDBRequest);
   mTracker.setCorrType(o2::base::PropagatorImpl<float>::MatCorrType::USEMatCorrLUT);
   mTracker.setConfigParams(&StrangenessTrackingParamConfig::Instance());
-  mTracker.setupThreads(1);
+  mTracker.setupThreads(ic.options().get<int>("threads"));
   mTracker.setupFitters();
 
   LOG(info) << "Initialized strangeness tracker...";
@@ -75,6 +75,7 @@ void StrangenessTrackerSpec::run(framework::ProcessingContext& pc)
   mTracker.loadData(recoData);
   mTracker.prepareITStracks();
   mTracker.process();
+  mTracker.mergeThreadOutputs();
   pc.outputs().snapshot(Output{"GLO", "STRANGETRACKS", 0}, mTracker.getStrangeTrackVec());
   pc.outputs().snapshot(Output{"GLO", "CLUSUPDATES", 0}, mTracker.getClusAttachments());
 
@@ -170,7 +171,7 @@ DataProcessorSpec getStrangenessTrackerSpec(o2::dataformats::GlobalTrackID::mask
     dataRequest->inputs,
     outputs,
     AlgorithmSpec{adaptFromTask<StrangenessTrackerSpec>(dataRequest, ggRequest, useMC)},
-    Options{}};
+    Options{{"threads", VariantType::Int, 1, {"Number of threads"}}}};
 }
 
 } // namespace strangeness_tracking
@@ -61,6 +61,7 @@ void VertexTrackMatcherSpec::init(InitContext& ic)
   mTimer.Stop();
   mTimer.Reset();
   mMatcher.setPrescaleLogs(ic.options().get<int>("prescale-logs"));
+  mMatcher.setNThreads(ic.options().get<int>("threads"));
   o2::base::GRPGeomHelper::instance().setRequest(mGGCCDBRequest);
 }
 
@@ -170,7 +171,8 @@ DataProcessorSpec getVertexTrackMatcherSpec(GTrackID::mask_t src)
     dataRequest->inputs,
     outputs,
     AlgorithmSpec{adaptFromTask<VertexTrackMatcherSpec>(dataRequest, ggRequest)},
-    Options{{"prescale-logs", VariantType::Int, 50, {"print vertex logs for each n-th TF"}}}};
+    Options{{"prescale-logs", VariantType::Int, 50, {"print vertex logs for each n-th TF"}},
+            {"threads", VariantType::Int, 1, {"Number of threads for the track to vertex association"}}}};
 }
 
 } // namespace vertexing
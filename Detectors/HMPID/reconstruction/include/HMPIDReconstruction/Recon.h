@@ -25,6 +25,7 @@
 #include <TVector2.h>
 #include <TVector3.h>
 
+#include <array>
 #include <vector>
 
 #include "HMPIDBase/Param.h"
@@ -85,17 +86,22 @@ class Recon : public TNamed
   // void deleteVars() const; // delete variables
 
   // void     CkovAngle    (AliESDtrack *pTrk,TClonesArray *pCluLst,int index,double nmean,float xRa,float yRa );
-  void ckovAngle(o2::dataformats::MatchInfoHMP* match, const std::vector<o2::hmpid::Cluster> clusters, int index, double nmean, float xRa, float yRa); // reconstructed Theta Cerenkov
+  void ckovAngle(o2::dataformats::MatchInfoHMP* match, const std::vector<o2::hmpid::Cluster>& clusters, int index, double nmean, float xRa, float yRa); // reconstructed Theta Cerenkov
 
   bool findPhotCkov(double cluX, double cluY, double& thetaCer, double& phiCer); // find ckov angle for single photon candidate
   bool findPhotCkov2(double cluX, double cluY, double& thetaCer, double& phiCer);
+
+  void initCkovLookup();                                 // tabulate the photon displacement on PC vs emission angle for the current ref. index
+  bool lookupPhotCkov(double dist, double& ckov) const; // emission angle in LORS of a photon displaced by dist on PC, from the table
+  void setUseCkovLookup(bool v) { fUseCkovLookup = v; }
+  bool getUseCkovLookup() const { return fUseCkovLookup; }
   double findRingCkov(int iNclus);                  // best ckov for ring formed by found photon candidates
   void findRingGeom(double ckovAng, int level = 1); // estimated area of ring in cm^2 and portion accepted by geometry
 
   // template <typename T = double>
   const TVector2 intWithEdge(TVector2 p1, TVector2 p2); // find intercection between plane and lines of 2 thetaC
 
-  int flagPhot(double ckov, const std::vector<o2::hmpid::Cluster> clusters, float* photChargeVec); // is photon ckov near most probable track ckov
+  int flagPhot(double ckov, const std::vector<o2::hmpid::Cluster>& clusters, float* photChargeVec); // is photon ckov near most probable track ckov
                                                                                                    //  int flagPhot(double ckov, const std::vector<o2::hmpid::Cluster> clusters); // is photon ckov near most probable track ckov
 
   double houghResponse(); // most probable track ckov angle
@@ -182,6 +188,14 @@ class Recon : public TNamed
 
   o2::hmpid::Param* fParam = o2::hmpid::Param::instance(); // Pointer to HMPIDParam
 
+  // Photons are refracted at the planes parallel to the PC, hence their displacement from the emission point in the middle of RAD
+  // to the PC depends only on the polar angle in LORS and on the ref. indices, not on the track
+  static constexpr int kNCkovLookup = 512;        // number of nodes of the lookup table
+  std::array<double, kNCkovLookup> fCkovLookupR{}; //! displacement in the PC plane of a photon vs polar angle in LORS, [cm]
+  double fCkovLookupStep = 0;                      //! polar angle step between nodes, [rad]
+  double fCkovLookupRefIdx = -1;                   //! ref. index of RAD for which the table was filled
+  bool fUseCkovLookup = true;                      //! start the search of the photon ckov from the lookup table
+
  private:
   Recon(const Recon& r);            // dummy copy constructor
   Recon& operator=(const Recon& r); // dummy assignment operator
@@ -16,6 +16,7 @@
 #include <TRotation.h> //TracePhot()
 #include <TH1D.h>      //HoughResponse()
 #include <TRandom.h>   //HoughResponse()
+#include <algorithm>
 
 #include "ReconstructionDataFormats/MatchInfoHMP.h"
 #include "ReconstructionDataFormats/Track.h"
@@ -46,7 +47,7 @@ void Recon::initVars(int n)
   //
 }
 //++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-void Recon::ckovAngle(o2::dataformats::MatchInfoHMP* match, const std::vector<o2::hmpid::Cluster> clusters, int index, double nmean, float xRa, float yRa)
+void Recon::ckovAngle(o2::dataformats::MatchInfoHMP* match, const std::vector<o2::hmpid::Cluster>& clusters, int index, double nmean, float xRa, float yRa)
 {
   // Pattern recognition method based on Hough transform
   // Arguments:   pTrk     - track for which Ckov angle is to be found
@@ -66,6 +67,9 @@ void Recon::ckovAngle(o2::dataformats::MatchInfoHMP* match, const std::vector<o2
   setTrack(xRa, yRa, th, ph);
 
   fParam->setRefIdx(nmean);
+  if (fUseCkovLookup) {
+    initCkovLookup();
+  }
 
   float mipQ = -1, mipX = -1, mipY = -1;
   int chId = -1, sizeClu = -1;
@@ -76,7 +80,7 @@ void Recon::ckovAngle(o2::dataformats::MatchInfoHMP* match, const std::vector<o2
 
   for (int iClu = 0; iClu < clusters.size(); iClu++) { // clusters loop
 
-    o2::hmpid::Cluster cluster = clusters.at(iClu);
+    const auto& cluster = clusters[iClu];
     nPads += cluster.size();
     if (iClu == index) { // this is the MIP! not a photon candidate: just store mip info
       mipX = cluster.x();
@@ -161,6 +165,26 @@ bool Recon::findPhotCkov(double cluX, double cluY, double& thetaCer, double& phi
   double ckov2 = 0.75 + fTrkDir.Theta(); // start to find theta cerenkov in DRS
   const double kTol = 0.01;
   Int_t iIterCnt = 0;
+  double ckovL;
+  if (fUseCkovLookup && lookupPhotCkov(TMath::Sqrt((cluX - fTrkPos.X()) * (cluX - fTrkPos.X()) + (cluY - fTrkPos.Y()) * (cluY - fTrkPos.Y())), ckovL)) {
+    // the photon is traced along the line from the RAD impact to the cluster, check the tabulated angle and
+    // restrict the search to the neighbouring nodes if it is not precise enough
+    dirCkov.SetMagThetaPhi(1, ckovL, phi);
+    TVector2 posC = traceForward(dirCkov);
+    double dist = posC.X() == -999 ? -999 : cluR - (posC - fPc).Mod();
+    iIterCnt++;
+    if (TMath::Abs(dist) <= kTol) {
+      lors2Trs(dirCkov, thetaCer, phiCer);
+      return kTRUE;
+    }
+    if (dist > kTol) {
+      ckov1 = ckovL;
+      ckov2 = TMath::Min(ckov2, ckovL + fCkovLookupStep);
+    } else {
+      ckov1 = TMath::Max(ckov1, ckovL - fCkovLookupStep);
+      ckov2 = ckovL;
+    }
+  }
   while (1) {
     if (iIterCnt >= 50) {
       return kFALSE;
@@ -187,6 +211,48 @@ bool Recon::findPhotCkov(double cluX, double cluY, double& thetaCer, double& phi
   }
 } // FindPhotTheta()
 //++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+void Recon::initCkovLookup()
+{
+  // Fill the table of photon displacement on PC vs polar angle in LORS, up to the total reflection on the WIN-GAP boundary
+  // It depends only on the ref. index of RAD, so it is refilled only when this changes
+
+  if (fCkovLookupRefIdx == fParam->getRefIdx()) {
+    return;
+  }
+  fCkovLookupRefIdx = fParam->getRefIdx();
+  fCkovLookupStep = 0.999 * TMath::ASin(1. / fCkovLookupRefIdx) / (kNCkovLookup - 1);
+  double zRad = -0.5 * fParam->radThick() - 0.5 * fParam->winThick(); // z position of middle of RAD
+  for (int i = 0; i < kNCkovLookup; i++) {
+    TVector3 dirCkov;
+    dirCkov.SetMagThetaPhi(1, i * fCkovLookupStep, 0);
+    TVector3 posCkov(0, 0, zRad);
+    propagate(dirCkov, posCkov, -0.5 * fParam->winThick());
+    refract(dirCkov, fCkovLookupRefIdx, fParam->winIdx());
+    propagate(dirCkov, posCkov, 0.5 * fParam->winThick());
+    refract(dirCkov, fParam->winIdx(), fParam->gapIdx());
+    propagate(dirCkov, posCkov, 0.5 * fParam->winThick() + fParam->gapThick());
+    fCkovLookupR[i] = posCkov.X();
+  }
+} // initCkovLookup()
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+bool Recon::lookupPhotCkov(double dist, double& ckov) const
+{
+  // Interpolate the polar angle in LORS of a photon which is displaced by dist on PC
+  // Arguments: dist - distance between the cluster and the track impact point at RAD, projected on PC
+  //   Returns: false if dist is out of the table, i.e. total reflection
+
+  if (fCkovLookupStep <= 0 || dist >= fCkovLookupR[kNCkovLookup - 1]) {
+    return kFALSE;
+  }
+  int i = std::upper_bound(fCkovLookupR.begin(), fCkovLookupR.end(), dist) - fCkovLookupR.begin(); // displacement grows with the angle
+  if (i == 0) {
+    ckov = 0;
+    return kTRUE;
+  }
+  ckov = fCkovLookupStep * (i - 1 + (dist - fCkovLookupR[i - 1]) / (fCkovLookupR[i] - fCkovLookupR[i - 1]));
+  return kTRUE;
+} // lookupPhotCkov()
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 bool Recon::findPhotCkov2(double cluX, double cluY, double& thetaCer, double& phiCer)
 {
 
@@ -439,7 +505,7 @@ double Recon::findRingCkov(int)
 
 } // FindCkovRing()
 //++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-int Recon::flagPhot(double ckov, const std::vector<o2::hmpid::Cluster> clusters, float* photChargeVec)
+int Recon::flagPhot(double ckov, const std::vector<o2::hmpid::Cluster>& clusters, float* photChargeVec)
 // int Recon::flagPhot(double ckov, const std::vector<o2::hmpid::Cluster> clusters)
 {
   // Flag photon candidates if their individual ckov angle is inside the window around ckov angle returned by  HoughResponse()
@@ -464,7 +530,7 @@ int Recon::flagPhot(double ckov, const std::vector<o2::hmpid::Cluster> clusters,
     fPhotFlag[i] = 0;
     if (fPhotCkov[i] >= tmin && fPhotCkov[i] <= tmax) {
       fPhotFlag[i] = 2;
-      o2::hmpid::Cluster cluster = clusters.at(fPhotClusIndex[i]);
+      const auto& cluster = clusters[fPhotClusIndex[i]];
       float charge = cluster.q();
       if (iInsideCnt < 10) {
         photChargeVec[iInsideCnt] = charge;
@@ -15,6 +15,7 @@
 #define O2_ITS_NOISESLOTCALIBRATOR
 
 #include <string>
+#include <vector>
 
 #include "DataFormatsITSMFT/TopologyDictionary.h"
 #include "DetectorsCalibration/TimeSlotCalibration.h"
@@ -90,6 +91,8 @@ class NoiseSlotCalibrator : public o2::calibration::TimeSlotCalibration<o2::itsm
   long mMinROFs = 0;
   unsigned int mNumberOfStrobes = 0;
   bool m1pix = true;
+  std::vector<int> mChipIDs;              // chips fired in the current TF
+  std::vector<std::vector<int>> mChipHits; // row/col keys of the hits of the current TF, per chip
 };
 
 } // namespace its
@@ -18,6 +18,7 @@
 #include "DataFormatsITSMFT/ClusterPattern.h"
 #include "DataFormatsITSMFT/CompCluster.h"
 #include "DataFormatsITSMFT/ROFRecord.h"
+#include <algorithm>
 #ifdef WITH_OPENMP
 #include <omp.h>
 #endif
@@ -93,8 +94,10 @@ bool NoiseCalibrator::processTimeFrameClusters(gsl::span<const o2::itsmft::CompC
 #pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
 #endif
   for (int chipID : mChipIDs) {
-    mNoiseMap.increaseNoiseCount(chipID, mChipHits[chipID]);
-    mChipHits[chipID].clear();
+    auto& hits = mChipHits[chipID];
+    std::sort(hits.begin(), hits.end());
+    mNoiseMap.increaseNoiseCountSorted(chipID, hits);
+    hits.clear();
   }
   mNumberOfStrobes += rofs.size();
   return (mNumberOfStrobes > mMinROFs) ? true : false;
@@ -126,8 +129,10 @@ bool NoiseCalibrator::processTimeFrameDigits(gsl::span<const o2::itsmft::Digit>
 #pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
 #endif
   for (int chipID : mChipIDs) {
-    mNoiseMap.increaseNoiseCount(chipID, mChipHits[chipID]);
-    mChipHits[chipID].clear();
+    auto& hits = mChipHits[chipID];
+    std::sort(hits.begin(), hits.end());
+    mNoiseMap.increaseNoiseCountSorted(chipID, hits);
+    hits.clear();
   }
   mNumberOfStrobes += rofs.size();
   return (mNumberOfStrobes > mMinROFs) ? true : false;
@@ -140,11 +145,7 @@ void NoiseCalibrator::addMap(const o2::itsmft::NoiseMap& extMap)
 #pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
 #endif
   for (int ic = 0; ic < NChips; ic++) {
-    const auto& chExt = extMap.getChip(ic);
-    auto& chCurr = mNoiseMap.getChip(ic);
-    for (auto it : chExt) {
-      chCurr[it.first] += it.second;
-    }
+    mNoiseMap.addNoiseCounts(ic, extMap.getChip(ic));
   }
 }
 
@@ -17,6 +17,7 @@
 #include "TFile.h"
 #include "DataFormatsITSMFT/ClusterPattern.h"
 #include "DataFormatsITSMFT/ROFRecord.h"
+#include <algorithm>
 
 namespace o2
 {
@@ -34,6 +35,17 @@ bool NoiseSlotCalibrator::processTimeFrame(gsl::span<const o2::itsmft::CompClust
   auto& slotTF = getSlotForTF(nTF);
   auto& noiseMap = *(slotTF.getContainer());
 
+  // collect the hits per chip first, then add them to the map in key order
+  mChipHits.resize(24120);
+  mChipIDs.clear();
+  auto addHit = [this](int chipID, int row, int col) {
+    auto& hits = mChipHits[chipID];
+    if (hits.empty()) {
+      mChipIDs.push_back(chipID);
+    }
+    hits.push_back(o2::itsmft::NoiseMap::getKey(row, col));
+  };
+
   auto pattIt = patterns.begin();
   for (const auto& rof : rofs) {
     auto clustersInFrame = rof.getROFData(clusters);
@@ -65,7 +77,7 @@ bool NoiseSlotCalibrator::processTimeFrame(gsl::span<const o2::itsmft::CompClust
 
       // Fast 1-pixel calibration
       if ((rowSpan == 1) && (colSpan == 1)) {
-        noiseMap.increaseNoiseCount(id, row, col);
+        addHit(id, row, col);
         continue;
       }
       if (m1pix) {
@@ -80,7 +92,7 @@ bool NoiseSlotCalibrator::processTimeFrame(gsl::span<const o2::itsmft::CompClust
         int s = 128; // 0b10000000
         while (s > 0) {
           if ((tempChar & s) != 0) {
-            noiseMap.increaseNoiseCount(id, row + ir, col + ic);
+            addHit(id, row + ir, col + ic);
           }
           ic++;
           s >>= 1;
@@ -99,6 +111,13 @@ bool NoiseSlotCalibrator::processTimeFrame(gsl::span<const o2::itsmft::CompClust
     }
   }
 
+  for (int chipID : mChipIDs) {
+    auto& hits = mChipHits[chipID];
+    std::sort(hits.begin(), hits.end());
+    noiseMap.increaseNoiseCountSorted(chipID, hits);
+    hits.clear();
+  }
+
   noiseMap.addStrobes(rofs.size());
   mNumberOfStrobes += rofs.size();
   return hasEnoughData(slotTF);
@@ -198,7 +198,7 @@ class TimeFrameGPU : public TimeFrame
   void loadTrackSeedsDevice(std::vector<CellSeed>&);
   void createCellNeighboursDevice(const unsigned int& layer, std::vector<std::pair<int, int>>& neighbours);
   void createTrackITSExtDevice(std::vector<CellSeed>&);
-  void downloadTrackITSExtDevice(std::vector<CellSeed>&);
+  void downloadTrackITSExtDevice(std::vector<CellSeed>&, const size_t nTracks);
   void initDeviceChunks(const int, const int);
   template <Task task>
   size_t loadChunkData(const size_t, const size_t, const size_t);
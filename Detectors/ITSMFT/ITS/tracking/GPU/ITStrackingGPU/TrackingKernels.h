@@ -52,16 +52,17 @@ GPUg() void fitTrackSeedsKernel(
 #endif
 } // namespace gpu
 
-void trackSeedHandler(CellSeed* trackSeeds,
-                      TrackingFrameInfo** foundTrackingFrameInfo,
-                      o2::its::TrackITSExt* tracks,
-                      const size_t nSeeds,
-                      const float Bz,
-                      const int startLevel,
-                      float maxChi2ClusterAttachment,
-                      float maxChi2NDF,
-                      const o2::base::Propagator* propagator,
-                      const o2::base::PropagatorF::MatCorrType matCorrType);
+// Fit the seeds, compact the fitted tracks at the beginning of tracks sorted by chi2, and return their number
+size_t trackSeedHandler(CellSeed* trackSeeds,
+                        TrackingFrameInfo** foundTrackingFrameInfo,
+                        o2::its::TrackITSExt* tracks,
+                        const size_t nSeeds,
+                        const float Bz,
+                        const int startLevel,
+                        float maxChi2ClusterAttachment,
+                        float maxChi2NDF,
+                        const o2::base::Propagator* propagator,
+                        const o2::base::PropagatorF::MatCorrType matCorrType);
 } // namespace its
 } // namespace o2
 #endif // ITSTRACKINGGPU_TRACKINGKERNELS_H_
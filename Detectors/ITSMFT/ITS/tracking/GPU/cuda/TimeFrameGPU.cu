@@ -585,13 +585,14 @@ void TimeFrameGPU<nLayers>::createTrackITSExtDevice(std::vector<CellSeed>& seeds
 }
 
 template <int nLayers>
-void TimeFrameGPU<nLayers>::downloadTrackITSExtDevice(std::vector<CellSeed>& seeds)
+void TimeFrameGPU<nLayers>::downloadTrackITSExtDevice(std::vector<CellSeed>& seeds, const size_t nTracks)
 {
-  LOGP(debug, "gpu-transfer: downloading {} tracks, for {} MB.", mTrackITSExt.size(), mTrackITSExt.size() * sizeof(o2::its::TrackITSExt) / MB);
-  checkGPUError(cudaMemcpyAsync(mTrackITSExt.data(), mTrackITSExtDevice, mTrackITSExt.size() * sizeof(o2::its::TrackITSExt), cudaMemcpyDeviceToHost, mGpuStreams[0].get()));
+  LOGP(debug, "gpu-transfer: downloading {} tracks out of {} seeds, for {} MB.", nTracks, seeds.size(), nTracks * sizeof(o2::its::TrackITSExt) / MB);
+  checkGPUError(cudaMemcpyAsync(mTrackITSExt.data(), mTrackITSExtDevice, nTracks * sizeof(o2::its::TrackITSExt), cudaMemcpyDeviceToHost, mGpuStreams[0].get()));
+  discardResult(cudaDeviceSynchronize());
   checkGPUError(cudaHostUnregister(mTrackITSExt.data()));
   checkGPUError(cudaHostUnregister(seeds.data()));
-  discardResult(cudaDeviceSynchronize());
+  mTrackITSExt.resize(nTracks);
 }
 
 template <int nLayers>
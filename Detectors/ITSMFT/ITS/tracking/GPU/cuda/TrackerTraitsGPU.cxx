@@ -400,7 +400,7 @@ void TrackerTraitsGPU<nLayers>::findRoads(const int iteration)
     mTimeFrameGPU->createTrackITSExtDevice(trackSeeds);
     mTimeFrameGPU->loadTrackSeedsDevice(trackSeeds);
 
-    trackSeedHandler(
+    size_t nTracks = trackSeedHandler(
       mTimeFrameGPU->getDeviceTrackSeeds(),             // CellSeed* trackSeeds,
       mTimeFrameGPU->getDeviceArrayTrackingFrameInfo(), // TrackingFrameInfo** foundTrackingFrameInfo,
       mTimeFrameGPU->getDeviceTrackITSExt(),            // o2::its::TrackITSExt* tracks,
@@ -412,17 +412,10 @@ void TrackerTraitsGPU<nLayers>::findRoads(const int iteration)
       mTimeFrameGPU->getDevicePropagator(),             // const o2::base::Propagator* propagator
       mCorrType);                                       // o2::base::PropagatorImpl<float>::MatCorrType
 
-    mTimeFrameGPU->downloadTrackITSExtDevice(trackSeeds);
+    mTimeFrameGPU->downloadTrackITSExtDevice(trackSeeds, nTracks); // Only the fitted tracks, already sorted by chi2
 
     auto& tracks = mTimeFrameGPU->getTrackITSExt();
-    std::sort(tracks.begin(), tracks.end(), [](const TrackITSExt& a, const TrackITSExt& b) {
-      return a.getChi2() < b.getChi2();
-    });
-
     for (auto& track : tracks) {
-      if (!track.getChi2()) {
-        continue; // this is to skip the unset tracks that are put at the beginning of the vector by the sorting. To see if this can be optimised.
-      }
       int nShared = 0;
       bool isFirstShared{false};
       for (int iLayer{0}; iLayer < mTrkParams[0].NLayers; ++iLayer) {
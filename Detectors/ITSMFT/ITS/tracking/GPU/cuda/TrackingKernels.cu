@@ -286,6 +286,21 @@ struct trackletSortIndexFunctor : public thrust::binary_function<T, T, bool> {
   }
 };
 
+// Functors to compact and sort the fitted tracks
+struct trackUnsetFunctor {
+  GPUhd() bool operator()(const o2::its::TrackITSExt& track) const
+  {
+    return !track.getChi2();
+  }
+};
+
+struct trackChi2SortFunctor {
+  GPUhd() bool operator()(const o2::its::TrackITSExt& lhs, const o2::its::TrackITSExt& rhs) const
+  {
+    return lhs.getChi2() < rhs.getChi2();
+  }
+};
+
 // Print layer buffer
 GPUg() void printBufferLayerOnThread(const int layer, const int* v, size_t size, const int len = 150, const unsigned int tId = 0)
 {
@@ -714,16 +729,16 @@ void cellNeighboursHandler(CellSeed* cellsCurrentLayer,
     maxCellNeighbours);       // const int maxCellNeighbours = 1e2
 }
 
-void trackSeedHandler(CellSeed* trackSeeds,
-                      TrackingFrameInfo** foundTrackingFrameInfo,
-                      o2::its::TrackITSExt* tracks,
-                      const size_t nSeeds,
-                      const float Bz,
-                      const int startLevel,
-                      float maxChi2ClusterAttachment,
-                      float maxChi2NDF,
-                      const o2::base::Propagator* propagator,
-                      const o2::base::PropagatorF::MatCorrType matCorrType)
+size_t trackSeedHandler(CellSeed* trackSeeds,
+                        TrackingFrameInfo** foundTrackingFrameInfo,
+                        o2::its::TrackITSExt* tracks,
+                        const size_t nSeeds,
+                        const float Bz,
+                        const int startLevel,
+                        float maxChi2ClusterAttachment,
+                        float maxChi2NDF,
+                        const o2::base::Propagator* propagator,
+                        const o2::base::PropagatorF::MatCorrType matCorrType)
 {
   gpu::fitTrackSeedsKernel<<<20, 256>>>(
     trackSeeds,               // CellSeed* trackSeeds,
@@ -738,7 +753,13 @@ void trackSeedHandler(CellSeed* trackSeeds,
     matCorrType);             // o2::base::PropagatorF::MatCorrType matCorrType
 
   gpuCheckError(cudaPeekAtLastError());
+
+  // Drop the seeds which could not be fitted and sort the tracks by chi2 on the device, only the good tracks are downloaded
+  auto thrustTracksBegin = thrust::device_ptr<o2::its::TrackITSExt>(tracks);
+  auto thrustTracksEnd = thrust::remove_if(thrust::device, thrustTracksBegin, thrustTracksBegin + nSeeds, gpu::trackUnsetFunctor());
+  thrust::sort(thrust::device, thrustTracksBegin, thrustTracksEnd, gpu::trackChi2SortFunctor());
   gpuCheckError(cudaDeviceSynchronize());
+  return thrustTracksEnd - thrustTracksBegin;
 }
 } // namespace its
 } // namespace o2
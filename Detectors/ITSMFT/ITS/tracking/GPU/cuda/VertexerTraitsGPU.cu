@@ -621,9 +621,13 @@ void VertexerTraitsGPU::computeTracklets(const int iteration)
     auto doVertexReconstruction = [&, chunkId, rofPerChunk]() -> void {
       auto offset = chunkId * rofPerChunk;
       auto maxROF = offset + rofPerChunk;
-      while (offset < maxROF) {
-        auto rofs = mTimeFrameGPU->loadChunkData<gpu::Task::Vertexer>(chunkId, offset, maxROF);
-        RANGE("chunk_gpu_vertexing", 1);
+      std::vector<int> exclusiveFoundLinesHost;
+      std::vector<Line> lines;
+      std::vector<ClusterLines> clusterLines;
+      std::vector<bool> usedLines;
+      // enqueue the tracklet finding and selection of the ROFs starting at offset on the stream of the chunk, returns the number of ROFs
+      auto launchBatch = [&](const int offset) -> int {
+        const int rofs = mTimeFrameGPU->loadChunkData<gpu::Task::Vertexer>(chunkId, offset, maxROF);
         // gpu::GpuTimer timer{offset, mTimeFrameGPU->getStream(chunkId).get()};
         // timer.Start("vtTrackletFinder");
         gpu::trackleterKernelMultipleRof<TrackletMode::Layer0Layer1><<<rofs, 1024, 0, mTimeFrameGPU->getStream(chunkId).get()>>>(
@@ -706,23 +710,26 @@ void VertexerTraitsGPU::computeTracklets(const int iteration)
           mVrtParams[iteration].tanLambdaCut,                               // const float tanLambdaCut = 0.025f,      // Cut on tan lambda
           mVrtParams[iteration].phiCut);                                    // const float phiCut = 0.002f)            // Cut on phi
 
+        return rofs;
+      };
+      // copy the lines of the batch to the host, synchronizing the stream of the chunk
+      auto fetchLines = [&](const int offset, const int rofs) -> void {
         int nClusters = mTimeFrameGPU->getTotalClustersPerROFrange(offset, rofs, 1);
         int lastFoundLines;
-        std::vector<int> exclusiveFoundLinesHost(nClusters + 1);
+        exclusiveFoundLinesHost.resize(nClusters + 1);
 
         // Obtain whole exclusive sum including nCluster+1 element  (nCluster+1)th element is the total number of found lines.
         checkGPUError(cudaMemcpyAsync(exclusiveFoundLinesHost.data(), mTimeFrameGPU->getChunk(chunkId).getDeviceNExclusiveFoundLines(), (nClusters) * sizeof(int), cudaMemcpyDeviceToHost, mTimeFrameGPU->getStream(chunkId).get()));
         checkGPUError(cudaMemcpyAsync(&lastFoundLines, mTimeFrameGPU->getChunk(chunkId).getDeviceNFoundLines() + nClusters - 1, sizeof(int), cudaMemcpyDeviceToHost, mTimeFrameGPU->getStream(chunkId).get()));
         exclusiveFoundLinesHost[nClusters] = exclusiveFoundLinesHost[nClusters - 1] + lastFoundLines;
 
-        std::vector<Line> lines(exclusiveFoundLinesHost[nClusters]);
+        lines.resize(exclusiveFoundLinesHost[nClusters]);
 
         checkGPUError(cudaMemcpyAsync(lines.data(), mTimeFrameGPU->getChunk(chunkId).getDeviceLines(), sizeof(Line) * lines.size(), cudaMemcpyDeviceToHost, mTimeFrameGPU->getStream(chunkId).get()));
         checkGPUError(cudaStreamSynchronize(mTimeFrameGPU->getStream(chunkId).get()));
-
-        // Compute vertices
-        std::vector<ClusterLines> clusterLines;
-        std::vector<bool> usedLines;
+      };
+      // host side line clustering of the batch
+      auto clusterBatch = [&](const int offset, const int rofs) -> void {
         for (int rofId{0}; rofId < rofs; ++rofId) {
           auto rof = offset + rofId;
           auto clustersL1offsetRof = mTimeFrameGPU->getROframeClusters(1)[rof] - mTimeFrameGPU->getROframeClusters(1)[offset]; // starting cluster offset for this ROF
@@ -745,7 +752,18 @@ void VertexerTraitsGPU::computeTracklets(const int iteration)
                                mTimeFrameGPU,
                                mTimeFrameGPU->hasMCinformation() ? &mTimeFrameGPU->getLabelsInChunks()[chunkId] : nullptr);
         }
-        offset += rofs;
+      };
+      // the next batch is enqueued on the GPU before clustering the lines of the current one on the host,
+      // so that the GPU and the host work concurrently
+      int rofs = offset < maxROF ? launchBatch(offset) : 0;
+      while (offset < maxROF) {
+        RANGE("chunk_gpu_vertexing", 1);
+        fetchLines(offset, rofs);
+        const int nextOffset = offset + rofs;
+        const int nextRofs = nextOffset < maxROF ? launchBatch(nextOffset) : 0;
+        clusterBatch(offset, rofs);
+        offset = nextOffset;
+        rofs = nextRofs;
       }
     };
     // Do work
@@ -127,6 +127,13 @@ class TimeFrame
   gsl::span<Cluster> getClustersOnLayer(int rofId, int layerId);
   gsl::span<const Cluster> getClustersOnLayer(int rofId, int layerId) const;
   gsl::span<const Cluster> getClustersPerROFrange(int rofMin, int range, int layerId) const;
+  /// Phi, radius and z of the sorted clusters of the ROF, in separate arrays for the vectorized tracklet selection
+  struct ClusterFieldsView {
+    const float* phi = nullptr;
+    const float* radius = nullptr;
+    const float* z = nullptr;
+  };
+  ClusterFieldsView getClusterFieldsOnLayer(int rofId, int layerId) const;
   gsl::span<const Cluster> getUnsortedClustersOnLayer(int rofId, int layerId) const;
   gsl::span<const int> getROframesClustersPerROFrange(int rofMin, int range, int layerId) const;
   gsl::span<const int> getROframeClusters(int layerId) const;
@@ -259,6 +266,12 @@ class TimeFrame
   bool mIsGPU = false;
 
   std::vector<std::vector<Cluster>> mClusters;
+  struct ClusterFields {
+    std::vector<float> phi;
+    std::vector<float> radius;
+    std::vector<float> z;
+  };
+  std::vector<ClusterFields> mClusterFields; // Copies of the fields of mClusters used by the tracklet selection
   std::vector<std::vector<TrackingFrameInfo>> mTrackingFrameInfo;
   std::vector<std::vector<int>> mClusterExternalIndices;
   std::vector<std::vector<int>> mROframesClusters;
@@ -410,6 +423,16 @@ inline gsl::span<const Cluster> TimeFrame::getClustersOnLayer(int rofId, int lay
   return {&mClusters[layerId][startIdx], static_cast<gsl::span<Cluster>::size_type>(mROframesClusters[layerId][rofId + 1] - startIdx)};
 }
 
+inline TimeFrame::ClusterFieldsView TimeFrame::getClusterFieldsOnLayer(int rofId, int layerId) const
+{
+  if (rofId < 0 || rofId >= mNrof || layerId >= (int)mClusterFields.size()) {
+    return {};
+  }
+  int startIdx{mROframesClusters[layerId][rofId]};
+  const auto& fields{mClusterFields[layerId]};
+  return {fields.phi.data() + startIdx, fields.radius.data() + startIdx, fields.z.data() + startIdx};
+}
+
 inline gsl::span<const Cluster> TimeFrame::getClustersPerROFrange(int rofMin, int range, int layerId) const
 {
   if (rofMin < 0 || rofMin >= mNrof) {
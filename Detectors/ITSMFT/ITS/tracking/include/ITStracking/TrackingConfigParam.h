@@ -76,8 +76,8 @@ struct TrackerParamConfig : public o2::conf::ConfigurableParamHelper<TrackerPara
   float trackletsPerClusterLimit = -1.f;
   int findShortTracks = -1;
   int nThreads = 1;
-  int nOrbitsPerIterations = 0;
-  int nROFsPerIterations = 0;
+  int nOrbitsPerIterations = 0; // process the TF in windows of this many orbits of ROFs, overrides nROFsPerIterations
+  int nROFsPerIterations = 0;   // process the TF in windows of this many ROFs (+ deltaRof of overlap), 0: whole TF at once
   bool perPrimaryVertexProcessing = false;
   bool saveTimeBenchmarks = false;
   bool overrideBeamEstimation = false; // used by gpuwf only
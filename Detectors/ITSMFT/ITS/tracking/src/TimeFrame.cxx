@@ -331,6 +331,20 @@ void TimeFrame::prepareClusters(const TrackingParameters& trkParam, const int ma
       }
     }
   }
+
+  mClusterFields.resize(std::min(trkParam.NLayers, maxLayers));
+  for (unsigned int iLayer{0}; iLayer < mClusterFields.size(); ++iLayer) {
+    auto& fields{mClusterFields[iLayer]};
+    const auto& clusters{mClusters[iLayer]};
+    fields.phi.resize(clusters.size());
+    fields.radius.resize(clusters.size());
+    fields.z.resize(clusters.size());
+    for (size_t iCluster{0}; iCluster < clusters.size(); ++iCluster) {
+      fields.phi[iCluster] = clusters[iCluster].phi;
+      fields.radius[iCluster] = clusters[iCluster].radius;
+      fields.z[iCluster] = clusters[iCluster].zCoordinate;
+    }
+  }
 }
 
 void TimeFrame::initialise(const int iteration, const TrackingParameters& trkParam, const int maxLayers, bool resetVertices)
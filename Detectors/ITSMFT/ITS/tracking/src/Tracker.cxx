@@ -22,6 +22,8 @@
 #include "ITStracking/Tracklet.h"
 #include "ITStracking/TrackerTraits.h"
 #include "ITStracking/TrackingConfigParam.h"
+#include "ITSMFTBase/DPLAlpideParam.h"
+#include "CommonConstants/LHCConstants.h"
 
 #include "ReconstructionDataFormats/Track.h"
 #include <cassert>
@@ -469,7 +471,10 @@ void Tracker::getGlobalConfiguration()
   setNThreads(tc.nThreads);
   int nROFsPerIterations = tc.nROFsPerIterations > 0 ? tc.nROFsPerIterations : -1;
   if (tc.nOrbitsPerIterations > 0) {
-    /// code to be used when the number of ROFs per orbit is known, this gets priority over the number of ROFs per iteration
+    /// the number of ROFs per orbit is known from the ALPIDE readout, this gets priority over the number of ROFs per iteration
+    const auto& alpParams = o2::itsmft::DPLAlpideParam<o2::detectors::DetID::ITS>::Instance();
+    nROFsPerIterations = std::max(1, tc.nOrbitsPerIterations * o2::constants::lhc::LHCMaxBunches / alpParams.roFrameLengthInBC);
+    LOGP(info, "Processing the timeframe in windows of {} orbits ({} ROFs)", tc.nOrbitsPerIterations, nROFsPerIterations);
   }
   for (auto& params : mTrkParams) {
     if (params.NLayers == 7) {
@@ -71,7 +71,7 @@ void TrackerTraits::computeLayerTracklets(const int iteration, int iROFslice, in
   const Vertex diamondVert({mTrkParams[iteration].Diamond[0], mTrkParams[iteration].Diamond[1], mTrkParams[iteration].Diamond[2]}, {25.e-6f, 0.f, 0.f, 25.e-6f, 0.f, 36.f}, 1, 1.f);
   gsl::span<const Vertex> diamondSpan(&diamondVert, 1);
   int startROF{mTrkParams[iteration].nROFsPerIterations > 0 ? iROFslice * mTrkParams[iteration].nROFsPerIterations : 0};
-  int endROF{mTrkParams[iteration].nROFsPerIterations > 0 ? (iROFslice + 1) * mTrkParams[iteration].nROFsPerIterations + mTrkParams[iteration].DeltaROF : tf->getNrof()};
+  int endROF{mTrkParams[iteration].nROFsPerIterations > 0 ? std::min((iROFslice + 1) * mTrkParams[iteration].nROFsPerIterations + mTrkParams[iteration].DeltaROF, tf->getNrof()) : tf->getNrof()};
   for (int rof0{startROF}; rof0 < endROF; ++rof0) {
     gsl::span<const Vertex> primaryVertices = mTrkParams[iteration].UseDiamond ? diamondSpan : tf->getPrimaryVertices(rof0);
     const int startVtx{iVertex >= 0 ? iVertex : 0};
@@ -87,6 +87,7 @@ void TrackerTraits::computeLayerTracklets(const int iteration, int iROFslice, in
       float meanDeltaR{mTrkParams[iteration].LayerRadii[iLayer + 1] - mTrkParams[iteration].LayerRadii[iLayer]};
 
       const int currentLayerClustersNum{static_cast<int>(layer0.size())};
+      std::vector<unsigned char> compatible;
       for (int iCluster{0}; iCluster < currentLayerClustersNum; ++iCluster) {
         const Cluster& currentCluster{layer0[iCluster]};
         const int currentSortedIndex{tf->getSortedIndex(rof0, iLayer, iCluster)};
@@ -128,6 +129,7 @@ void TrackerTraits::computeLayerTracklets(const int iteration, int iROFslice, in
             if (layer1.empty()) {
               continue;
             }
+            const auto fields1 = tf->getClusterFieldsOnLayer(rof1, iLayer + 1);
 
             for (int iPhiCount{0}; iPhiCount < phiBinsNum; iPhiCount++) {
               int iPhiBin = (selectedBinsRect.y + iPhiCount) % mTrkParams[iteration].PhiBins;
@@ -144,23 +146,39 @@ void TrackerTraits::computeLayerTracklets(const int iteration, int iROFslice, in
                 }
               }
               const int firstRowClusterIndex = tf->getIndexTable(rof1, iLayer + 1)[firstBinIndex];
-              const int maxRowClusterIndex = tf->getIndexTable(rof1, iLayer + 1)[maxBinIndex];
+              const int maxRowClusterIndex = std::min(tf->getIndexTable(rof1, iLayer + 1)[maxBinIndex], (int)layer1.size());
+              const int nRowClusters{maxRowClusterIndex - firstRowClusterIndex};
+              if (nRowClusters <= 0) {
+                continue;
+              }
 
-              for (int iNextCluster{firstRowClusterIndex}; iNextCluster < maxRowClusterIndex; ++iNextCluster) {
+              /// Branch-free selection over the contiguous fields of the row, so that the compiler can vectorize it
+              if ((int)compatible.size() < nRowClusters) {
+                compatible.resize(nRowClusters);
+              }
+              const float* phi1{fields1.phi + firstRowClusterIndex};
+              const float* radius1{fields1.radius + firstRowClusterIndex};
+              const float* z1{fields1.z + firstRowClusterIndex};
+              const float phiCut{tf->getPhiCut(iLayer)};
+              const float nSigmaCut{mTrkParams[iteration].NSigmaCut};
+              for (int iRow{0}; iRow < nRowClusters; ++iRow) {
+                const float deltaPhi{gpu::GPUCommonMath::Abs(currentCluster.phi - phi1[iRow])};
+                const float deltaZ{gpu::GPUCommonMath::Abs(tanLambda * (radius1[iRow] - currentCluster.radius) +
+                                                           currentCluster.zCoordinate - z1[iRow])};
+                compatible[iRow] = (deltaZ / sigmaZ < nSigmaCut) & ((deltaPhi < phiCut) | (gpu::GPUCommonMath::Abs(deltaPhi - constants::math::TwoPi) < phiCut));
+              }
 
-                if (iNextCluster >= (int)layer1.size()) {
-                  break;
+              for (int iNextCluster{firstRowClusterIndex}; iNextCluster < maxRowClusterIndex; ++iNextCluster) {
+#ifndef OPTIMISATION_OUTPUT
+                if (!compatible[iNextCluster - firstRowClusterIndex]) {
+                  continue;
                 }
-
+#endif
                 const Cluster& nextCluster{layer1[iNextCluster]};
                 if (tf->isClusterUsed(iLayer + 1, nextCluster.clusterId)) {
                   continue;
                 }
 
-                const float deltaPhi{gpu::GPUCommonMath::Abs(currentCluster.phi - nextCluster.phi)};
-                const float deltaZ{gpu::GPUCommonMath::Abs(tanLambda * (nextCluster.radius - currentCluster.radius) +
-                                                           currentCluster.zCoordinate - nextCluster.zCoordinate)};
-
 #ifdef OPTIMISATION_OUTPUT
                 MCCompLabel label;
                 int currentId{currentCluster.clusterId};
@@ -179,9 +197,7 @@ void TrackerTraits::computeLayerTracklets(const int iteration, int iROFslice, in
                 off << fmt::format("{}\t{:d}\t{}\t{}\t{}\t{}", iLayer, label.isValid(), (tanLambda * (nextCluster.radius - currentCluster.radius) + currentCluster.zCoordinate - nextCluster.zCoordinate) / sigmaZ, tanLambda, resolution, sigmaZ) << std::endl;
 #endif
 
-                if (deltaZ / sigmaZ < mTrkParams[iteration].NSigmaCut &&
-                    (deltaPhi < tf->getPhiCut(iLayer) ||
-                     gpu::GPUCommonMath::Abs(deltaPhi - constants::math::TwoPi) < tf->getPhiCut(iLayer))) {
+                if (compatible[iNextCluster - firstRowClusterIndex]) {
                   if (iLayer > 0) {
                     tf->getTrackletsLookupTable()[iLayer - 1][currentSortedIndex]++;
                   }
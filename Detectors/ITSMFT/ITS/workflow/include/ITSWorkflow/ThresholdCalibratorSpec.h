@@ -101,7 +101,8 @@ enum FitTypes {
   DERIVATIVE = 0,
   FIT = 1,
   HITCOUNTING = 2,
-  NO_FIT = 3
+  NO_FIT = 3,
+  FIT_GN = 4 // S-curve fit without ROOT (Gauss-Newton), thread-safe
 };
 
 // To work with parallel chip access
@@ -192,11 +193,12 @@ class ITSThresholdCalibrator : public Task
 
   // Helper functions related to threshold extraction
   void initThresholdTree(bool recreate = true);
-  bool findUpperLower(std::vector<std::vector<unsigned short int>>, const short int&, short int&, short int&, bool, int);
-  bool findThreshold(const short int&, std::vector<std::vector<unsigned short int>>, const float*, short int&, float&, float&, int&, int);
-  bool findThresholdFit(const short int&, std::vector<std::vector<unsigned short int>>, const float*, const short int&, float&, float&, int&, int);
-  bool findThresholdDerivative(std::vector<std::vector<unsigned short int>>, const float*, const short int&, float&, float&, int&, int);
-  bool findThresholdHitcounting(std::vector<std::vector<unsigned short int>>, const float*, const short int&, float&, int);
+  bool findUpperLower(const std::vector<std::vector<unsigned short int>>&, const short int&, short int&, short int&, bool, int);
+  bool findThreshold(const short int&, const std::vector<std::vector<unsigned short int>>&, const float*, short int&, float&, float&, int&, int);
+  bool findThresholdFit(const short int&, const std::vector<std::vector<unsigned short int>>&, const float*, const short int&, float&, float&, int&, int);
+  bool findThresholdFitGN(const std::vector<std::vector<unsigned short int>>&, const float*, const short int&, float&, float&, int&, int);
+  bool findThresholdDerivative(const std::vector<std::vector<unsigned short int>>&, const float*, const short int&, float&, float&, int&, int);
+  bool findThresholdHitcounting(const std::vector<std::vector<unsigned short int>>&, const float*, const short int&, float&, int);
   void findAverage(const std::array<long int, 6>&, float&, float&, float&, float&);
   void saveThreshold();
 
@@ -122,6 +122,7 @@ void ITSThresholdAggregator::finalize(EndOfStreamContext* ec)
   // Create metadata for database object
   std::string ft = this->mFitType == 0 ? "derivative" : this->mFitType == 1 ? "fit"
                                                       : this->mFitType == 2 ? "hitcounting"
+                                                      : this->mFitType == 4 ? "fit-gn"
                                                                             : "null";
   if (mScanType == 'D' || mScanType == 'A' || mScanType == 'P' || mScanType == 'p') {
     ft = "null";
@@ -82,9 +82,12 @@ void ITSThresholdCalibrator::init(InitContext& ic)
   } else if (fittype == "hitcounting") {
     this->mFitType = HITCOUNTING;
 
+  } else if (fittype == "fit-gn") {
+    this->mFitType = FIT_GN;
+
   } else {
     LOG(error) << "fittype " << fittype
-               << " not recognized, please use 'derivative', 'fit', or 'hitcounting'";
+               << " not recognized, please use 'derivative', 'fit', 'fit-gn' or 'hitcounting'";
     throw fittype;
   }
 
@@ -412,7 +415,7 @@ void ITSThresholdCalibrator::initThresholdTree(bool recreate /*=true*/)
 // x is the array of charge injected values;
 // NPoints is the length of both arrays.
 bool ITSThresholdCalibrator::findUpperLower(
-  std::vector<std::vector<unsigned short int>> data, const short int& NPoints,
+  const std::vector<std::vector<unsigned short int>>& data, const short int& NPoints,
   short int& lower, short int& upper, bool flip, int iloop2)
 {
   // Initialize (or re-initialize) upper and lower
@@ -472,7 +475,7 @@ bool ITSThresholdCalibrator::findUpperLower(
 //////////////////////////////////////////////////////////////////////////////
 // Main findThreshold function which calls one of the three methods
 bool ITSThresholdCalibrator::findThreshold(
-  const short int& chipID, std::vector<std::vector<unsigned short int>> data, const float* x, short int& NPoints,
+  const short int& chipID, const std::vector<std::vector<unsigned short int>>& data, const float* x, short int& NPoints,
   float& thresh, float& noise, int& spoints, int iloop2)
 {
   bool success = false;
@@ -486,6 +489,10 @@ bool ITSThresholdCalibrator::findThreshold(
       success = this->findThresholdFit(chipID, data, x, NPoints, thresh, noise, spoints, iloop2);
       break;
 
+    case FIT_GN: // Fit method without ROOT
+      success = this->findThresholdFitGN(data, x, NPoints, thresh, noise, spoints, iloop2);
+      break;
+
     case HITCOUNTING: // Hit-counting method
       success = this->findThresholdHitcounting(data, x, NPoints, thresh, iloop2);
       // noise = 0;
@@ -504,7 +511,7 @@ bool ITSThresholdCalibrator::findThreshold(
 // spoints: number of points in the S of the S-curve (with n_hits between 0 and 50, excluding first and last point)
 // iloop2 is 0 for thr scan but is equal to vresetd index in 2D vresetd scan
 bool ITSThresholdCalibrator::findThresholdFit(
-  const short int& chipID, std::vector<std::vector<unsigned short int>> data, const float* x, const short int& NPoints,
+  const short int& chipID, const std::vector<std::vector<unsigned short int>>& data, const float* x, const short int& NPoints,
   float& thresh, float& noise, int& spoints, int iloop2)
 {
   // Find lower & upper values of the S-curve region
@@ -568,6 +575,89 @@ bool ITSThresholdCalibrator::findThresholdFit(
   return (chi2 < 5);
 }
 
+//////////////////////////////////////////////////////////////////////////////
+// Find the threshold and noise via a weighted least-squares fit of the erf S-curve,
+// minimised with damped Gauss-Newton iterations starting from the derivative method result.
+// It does not use ROOT objects, hence it can run in several threads.
+// data is the number of trigger counts per charge injected;
+// x is the array of charge injected values;
+// NPoints is the length of both arrays.
+// spoints: number of points in the S of the S-curve (with n_hits between 0 and 50, excluding first and last point)
+// iloop2 is 0 for thr scan but is equal to vresetd index in 2D vresetd scan
+bool ITSThresholdCalibrator::findThresholdFitGN(const std::vector<std::vector<unsigned short int>>& data, const float* x, const short int& NPoints,
+                                                float& thresh, float& noise, int& spoints, int iloop2)
+{
+  if (!this->findThresholdDerivative(data, x, NPoints, thresh, noise, spoints, iloop2)) {
+    return false;
+  }
+  const float sign = (this->mScanType == 'I') ? -1.f : 1.f; // ITHR erf is reversed
+  const float halfAmpl = nInjScaled / 2.f;
+  const float derivNorm = sign * nInjScaled / std::sqrt(2.f * TMath::Pi());
+  constexpr int MaxIter = 20;
+  constexpr float MinNoise = 1e-2f;
+
+  // weighted chi2 of the model for parameters (t, s), with binomial errors (at least 1 count)
+  auto chi2 = [&](float t, float s) {
+    float sum = 0.f;
+    for (int i = 0; i < NPoints; i++) {
+      float y = mScanType != 'r' ? data[iloop2][i] : data[i][iloop2];
+      float r = y - halfAmpl * (1.f + sign * std::erf((this->mX[i] - t) / (std::sqrt(2.f) * s)));
+      sum += r * r / std::max(y * (nInjScaled - y) / nInjScaled, 1.f);
+    }
+    return sum;
+  };
+
+  float t = thresh, s = std::max(noise, MinNoise), lambda = 1e-3f;
+  float chi2Curr = chi2(t, s);
+  bool converged = false;
+  for (int iter = 0; iter < MaxIter && !converged; iter++) {
+    // normal equations J^T W J dp = J^T W r for the two parameters
+    float a00 = 0.f, a01 = 0.f, a11 = 0.f, b0 = 0.f, b1 = 0.f;
+    for (int i = 0; i < NPoints; i++) {
+      float y = mScanType != 'r' ? data[iloop2][i] : data[i][iloop2];
+      float z = (this->mX[i] - t) / s;
+      float r = y - halfAmpl * (1.f + sign * std::erf(z / std::sqrt(2.f)));
+      float w = 1.f / std::max(y * (nInjScaled - y) / nInjScaled, 1.f);
+      float dfdz = derivNorm * std::exp(-0.5f * z * z);
+      float jt = -dfdz / s, js = -dfdz * z / s;
+      a00 += w * jt * jt;
+      a01 += w * jt * js;
+      a11 += w * js * js;
+      b0 += w * jt * r;
+      b1 += w * js * r;
+    }
+    bool improved = false;
+    while (!improved && lambda < 1e6f) {
+      float d00 = a00 * (1.f + lambda), d11 = a11 * (1.f + lambda);
+      float det = d00 * d11 - a01 * a01;
+      if (det <= 0.f) {
+        lambda *= 10.f;
+        continue;
+      }
+      float dt = (d11 * b0 - a01 * b1) / det, ds = (d00 * b1 - a01 * b0) / det;
+      float sNew = std::max(s + ds, MinNoise);
+      float chi2New = chi2(t + dt, sNew);
+      if (chi2New < chi2Curr) {
+        improved = true;
+        converged = std::abs(dt) < 1e-3f * std::max(std::abs(t), 1.f) && std::abs(sNew - s) < 1e-3f * s;
+        t += dt;
+        s = sNew;
+        chi2Curr = chi2New;
+        lambda = std::max(lambda * 0.1f, 1e-7f);
+      } else {
+        lambda *= 10.f;
+      }
+    }
+    if (!improved) {
+      break; // no further decrease of the chi2: at the minimum within the precision
+    }
+  }
+
+  thresh = t;
+  noise = s;
+  return NPoints > 2 && (chi2Curr / (NPoints - 2)) < 5;
+}
+
 //////////////////////////////////////////////////////////////////////////////
 // Use ROOT to find the threshold and noise via derivative method
 // data is the number of trigger counts per charge injected;
@@ -575,7 +665,7 @@ bool ITSThresholdCalibrator::findThresholdFit(
 // NPoints is the length of both arrays.
 // spoints: number of points in the S of the S-curve (with n_hits between 0 and 50, excluding first and last point)
 // iloop2 is 0 for thr scan but is equal to vresetd index in 2D vresetd scan
-bool ITSThresholdCalibrator::findThresholdDerivative(std::vector<std::vector<unsigned short int>> data, const float* x, const short int& NPoints,
+bool ITSThresholdCalibrator::findThresholdDerivative(const std::vector<std::vector<unsigned short int>>& data, const float* x, const short int& NPoints,
                                                      float& thresh, float& noise, int& spoints, int iloop2)
 {
   // Find lower & upper values of the S-curve region
@@ -621,7 +711,7 @@ bool ITSThresholdCalibrator::findThresholdDerivative(std::vector<std::vector<uns
 // NPoints is the length of both arrays.
 // iloop2 is 0 for thr scan but is equal to vresetd index in 2D vresetd scan
 bool ITSThresholdCalibrator::findThresholdHitcounting(
-  std::vector<std::vector<unsigned short int>> data, const float* x, const short int& NPoints, float& thresh, int iloop2)
+  const std::vector<std::vector<unsigned short int>>& data, const float* x, const short int& NPoints, float& thresh, int iloop2)
 {
   unsigned short int numberOfHits = 0;
   bool is50 = false;
@@ -1938,7 +2028,7 @@ DataProcessorSpec getITSThresholdCalibratorSpec(const ITSCalibInpConf& inpConf)
     inputs,
     outputs,
     AlgorithmSpec{adaptFromTask<ITSThresholdCalibrator>(inpConf)},
-    Options{{"fittype", VariantType::String, "derivative", {"Fit type to extract thresholds, with options: fit, derivative (default), hitcounting"}},
+    Options{{"fittype", VariantType::String, "derivative", {"Fit type to extract thresholds, with options: fit, fit-gn (fit without ROOT, thread-safe), derivative (default), hitcounting"}},
             {"verbose", VariantType::Bool, false, {"Use verbose output mode"}},
             {"output-dir", VariantType::String, "./", {"ROOT trees output directory"}},
             {"meta-output-dir", VariantType::String, "/dev/null", {"Metadata output directory"}},
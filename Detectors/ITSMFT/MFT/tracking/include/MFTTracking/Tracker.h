@@ -137,7 +137,13 @@ class Tracker : public TrackerConfig
   }
 
   const Int_t isDiskFace(Int_t layer) const { return (layer % 2); }
-  const Float_t getDistanceToSeed(const Cluster&, const Cluster&, const Cluster&) const;
+
+  /// straight line through the two seed clusters, computed once per seed and reused for all candidate points of the road
+  struct SeedLine {
+    Float_t x1, y1, z1, slopeX, slopeY;
+  };
+  const SeedLine getSeedLine(const Cluster&, const Cluster&) const;
+  const Float_t getDistanceToSeed(const SeedLine&, const Cluster&) const;
   void getBinClusterRange(const ROframe<T>&, const Int_t, const Int_t, Int_t&, Int_t&) const;
   const Float_t getCellDeviation(const Cell&, const Cell&) const;
   const Bool_t getCellsConnect(const Cell&, const Cell&) const;
@@ -167,24 +173,27 @@ class Tracker : public TrackerConfig
 
   /// current road for CA algorithm
   Road mRoad;
+  /// points of the current road candidate, reused between seeds and ROFs
+  std::vector<TrackElement> mRoadPoints;
 };
 
 //_________________________________________________________________________________________________
 template <typename T>
-inline const Float_t Tracker<T>::getDistanceToSeed(const Cluster& cluster1, const Cluster& cluster2, const Cluster& cluster) const
+inline const typename Tracker<T>::SeedLine Tracker<T>::getSeedLine(const Cluster& cluster1, const Cluster& cluster2) const
+{
+  Float_t invdzSeed = 1.f / (cluster2.getZ() - cluster1.getZ());
+  return SeedLine{cluster1.getX(), cluster1.getY(), cluster1.getZ(), (cluster2.getX() - cluster1.getX()) * invdzSeed, (cluster2.getY() - cluster1.getY()) * invdzSeed};
+}
+
+//_________________________________________________________________________________________________
+template <typename T>
+inline const Float_t Tracker<T>::getDistanceToSeed(const SeedLine& seed, const Cluster& cluster) const
 {
-  // the seed is between "cluster1" and "cluster2" and cuts the plane
-  // of the "cluster" at a distance dR from it
-  Float_t dxSeed, dySeed, dzSeed, invdzSeed, dz, dR2, xSeed, ySeed;
-  dxSeed = cluster2.getX() - cluster1.getX();
-  dySeed = cluster2.getY() - cluster1.getY();
-  dzSeed = cluster2.getZ() - cluster1.getZ();
-  dz = cluster.getZ() - cluster1.getZ();
-  invdzSeed = dz / dzSeed;
-  xSeed = cluster1.getX() + dxSeed * invdzSeed;
-  ySeed = cluster1.getY() + dySeed * invdzSeed;
-  dR2 = (cluster.getX() - xSeed) * (cluster.getX() - xSeed) + (cluster.getY() - ySeed) * (cluster.getY() - ySeed);
-  return dR2;
+  // squared distance in the plane of "cluster" between "cluster" and the seed line
+  Float_t dz = cluster.getZ() - seed.z1;
+  Float_t dx = cluster.getX() - (seed.x1 + seed.slopeX * dz);
+  Float_t dy = cluster.getY() - (seed.y1 + seed.slopeY * dz);
+  return dx * dx + dy * dy;
 }
 
 //_________________________________________________________________________________________________
@@ -106,6 +106,7 @@ void Tracker<T>::configure(const MFTTrackingParam& trkParam, int trackerID)
     initializeFinder();
   }
   mRoad.initialize();
+  mRoadPoints.reserve(constants::mft::LayersNumber * constants::mft::MaxPointsInRoad);
 }
 
 //_________________________________________________________________________________________________
@@ -313,6 +314,7 @@ void Tracker<T>::findTracksLTF(ROframe<T>& event)
             continue;
           }
           clsInLayer2 = it2 - event.getClustersInLayer(layer2).begin();
+          const auto seed = getSeedLine(cluster1, cluster2);
 
           // start a Track type T
           nPoints = 0;
@@ -344,7 +346,7 @@ void Tracker<T>::findTracksLTF(ROframe<T>& event)
                 }
                 clsInLayer = it - event.getClustersInLayer(layer).begin();
 
-                dR2 = getDistanceToSeed(cluster1, cluster2, cluster);
+                dR2 = getDistanceToSeed(seed, cluster);
                 // retain the closest point within a radius dR2cut
                 if (dR2 >= dR2min) {
                   continue;
@@ -459,6 +461,7 @@ void Tracker<T>::findTracksLTFfcs(ROframe<T>& event)
           continue;
         }
         clsInLayer2 = it2 - event.getClustersInLayer(layer2).begin();
+        const auto seed = getSeedLine(cluster1, cluster2);
 
         // start a track type T
         nPoints = 0;
@@ -482,7 +485,7 @@ void Tracker<T>::findTracksLTFfcs(ROframe<T>& event)
             }
             clsInLayer = it - event.getClustersInLayer(layer).begin();
 
-            dR2 = getDistanceToSeed(cluster1, cluster2, cluster);
+            dR2 = getDistanceToSeed(seed, cluster);
             // retain the closest point within a radius dR2cut
             if (dR2 >= dR2min) {
               continue;
@@ -569,7 +572,7 @@ void Tracker<T>::findTracksCA(ROframe<T>& event)
   Int_t clsInLayer1, clsInLayer2, clsInLayer;
 
   Int_t nPoints;
-  std::vector<TrackElement> roadPoints;
+  auto& roadPoints = mRoadPoints;
 
   roadId = 0;
 
@@ -595,6 +598,7 @@ void Tracker<T>::findTracksCA(ROframe<T>& event)
               continue;
             }
             clsInLayer2 = it2 - event.getClustersInLayer(layer2).begin();
+            const auto seed = getSeedLine(cluster1, cluster2);
 
             // start a road
             roadPoints.clear();
@@ -622,7 +626,7 @@ void Tracker<T>::findTracksCA(ROframe<T>& event)
                   }
                   clsInLayer = it - event.getClustersInLayer(layer).begin();
 
-                  dR2 = getDistanceToSeed(cluster1, cluster2, cluster);
+                  dR2 = getDistanceToSeed(seed, cluster);
                   // add all points within a radius dR2cut
                   if (dR2 >= dR2min) {
                     continue;
@@ -703,7 +707,7 @@ void Tracker<T>::findTracksCAfcs(ROframe<T>& event)
   Int_t clsInLayer1, clsInLayer2, clsInLayer;
 
   Int_t nPoints;
-  std::vector<TrackElement> roadPoints;
+  auto& roadPoints = mRoadPoints;
 
   roadId = 0;
 
@@ -724,6 +728,7 @@ void Tracker<T>::findTracksCAfcs(ROframe<T>& event)
             continue;
           }
           clsInLayer2 = it2 - event.getClustersInLayer(layer2).begin();
+          const auto seed = getSeedLine(cluster1, cluster2);
 
           // start a road
           roadPoints.clear();
@@ -740,7 +745,7 @@ void Tracker<T>::findTracksCAfcs(ROframe<T>& event)
               }
               clsInLayer = it - event.getClustersInLayer(layer).begin();
 
-              dR2 = getDistanceToSeed(cluster1, cluster2, cluster);
+              dR2 = getDistanceToSeed(seed, cluster);
               // add all points within a radius dR2cut
               if (dR2 >= dR2cut) {
                 continue;
@@ -62,6 +62,8 @@ class TrackerDPL : public o2::framework::Task
   std::unique_ptr<o2::parameters::GRPObject> mGRP = nullptr;
   std::vector<std::unique_ptr<o2::mft::Tracker<TrackLTF>>> mTrackerVec;
   std::vector<std::unique_ptr<o2::mft::Tracker<TrackLTFL>>> mTrackerLVec;
+  std::vector<std::vector<o2::mft::ROframe<TrackLTF>>> mROFramesVec;   ///< per-thread ROF workspaces, reused between TFs to keep their allocations
+  std::vector<std::vector<o2::mft::ROframe<TrackLTFL>>> mROFramesLVec; ///< same for the field-off tracker
 
   enum TimerIDs { SWTot,
                   SWLoadData,
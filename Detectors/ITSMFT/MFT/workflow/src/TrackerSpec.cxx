@@ -113,18 +113,35 @@ void TrackerDPL::run(ProcessingContext& pc)
 
   std::uint32_t roFrameId = 0;
   int nROFs = rofs.size();
-  auto rofsPerWorker = std::max(1, nROFs / mNThreads);
-  LOG(debug) << "nROFs = " << nROFs << " rofsPerWorker = " << rofsPerWorker;
+  // contiguous blocks of ROFs per worker, balanced to differ by at most one ROF
+  auto getWorker = [nROFs, this](int iROF) { return int((long)iROF * mNThreads / std::max(1, nROFs)); };
+  LOG(debug) << "nROFs = " << nROFs << " on " << mNThreads << " workers";
+
+  // the ROF workspaces of the previous TF are reused: loadROFrameData clears them but keeps their capacity
+  auto prepareWorkspaces = [&, this](auto& roFrameDataVec) {
+    std::vector<int> nROFsPerWorker(mNThreads, 0);
+    for (int iROF = 0; iROF < nROFs; iROF++) {
+      nROFsPerWorker[getWorker(iROF)]++;
+    }
+    roFrameDataVec.resize(mNThreads);
+    for (int i = 0; i < mNThreads; i++) {
+      roFrameDataVec[i].resize(nROFsPerWorker[i]);
+    }
+  };
 
   auto loadData = [&, this](auto& trackerVec, auto& roFrameDataVec) {
     auto& tracker = trackerVec[0]; // Use first tracker to load the data: serial operation
     gsl::span<const unsigned char>::iterator pattIt = patterns.begin();
 
-    auto iROF = 0;
+    auto iROF = 0, firstWorkerROF = 0, prevWorker = 0;
 
     for (const auto& rof : rofs) {
-      int worker = std::min(int(iROF / rofsPerWorker), mNThreads - 1);
-      auto& roFrameData = roFrameDataVec[worker].emplace_back();
+      int worker = getWorker(iROF);
+      if (worker != prevWorker) {
+        firstWorkerROF = iROF;
+        prevWorker = worker;
+      }
+      auto& roFrameData = roFrameDataVec[worker][iROF - firstWorkerROF];
       int nclUsed = ioutils::loadROFrameData(rof, roFrameData, compClusters, pattIt, mDict, labels, tracker.get(), filter);
       LOG(debug) << "ROframeId: " << iROF << ", clusters loaded : " << nclUsed << " on worker " << worker;
       iROF++;
@@ -208,12 +225,9 @@ void TrackerDPL::run(ProcessingContext& pc)
 
   if (mFieldOn) {
 
-    std::vector<std::vector<o2::mft::ROframe<TrackLTF>>> roFrameVec(mNThreads); // One vector of ROFrames per thread
-    LOG(debug) << "Reserving ROFs ";
-
-    for (auto& rof : roFrameVec) {
-      rof.reserve(rofsPerWorker);
-    }
+    auto& roFrameVec = mROFramesVec; // One vector of ROFrames per thread
+    LOG(debug) << "Preparing ROFs ";
+    prepareWorkspaces(roFrameVec);
     LOG(debug) << "Loading data into ROFs.";
 
     mTimer[SWLoadData].Start(false);
@@ -267,12 +281,9 @@ void TrackerDPL::run(ProcessingContext& pc)
 
   } else {
     LOG(debug) << "Field is off! ";
-    std::vector<std::vector<o2::mft::ROframe<TrackLTFL>>> roFrameVec(mNThreads); // One vector of ROFrames per thread
-    LOG(debug) << "Reserving ROFs ";
-
-    for (auto& rof : roFrameVec) {
-      rof.reserve(rofsPerWorker);
-    }
+    auto& roFrameVec = mROFramesLVec; // One vector of ROFrames per thread
+    LOG(debug) << "Preparing ROFs ";
+    prepareWorkspaces(roFrameVec);
     LOG(debug) << "Loading data into ROFs.";
 
     mTimer[SWLoadData].Start(false);
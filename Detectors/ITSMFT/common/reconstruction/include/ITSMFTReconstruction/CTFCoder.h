@@ -114,22 +114,10 @@ o2::ctf::CTFIOSize CTFCoder::encode(VEC& buff, const gsl::span<const ROFRecord>&
   ec->setHeader(compCl.header);
   assignDictVersion(static_cast<o2::ctf::CTFDictHeader&>(ec->getHeader()));
   ec->setANSHeader(mANSVersion);
-  // at every encoding the buffer might be autoexpanded, so we don't work with fixed pointer ec
-  o2::ctf::CTFIOSize iosize;
-#define ENCODEITSMFT(part, slot, bits) CTF::get(buff.data())->encode(part, int(slot), bits, optField[int(slot)], &buff, mCoders[int(slot)], getMemMarginFactor());
-  // clang-format off
-  iosize += ENCODEITSMFT(compCl.firstChipROF, CTF::BLCfirstChipROF, 0);
-  iosize += ENCODEITSMFT(compCl.bcIncROF, CTF::BLCbcIncROF, 0);
-  iosize += ENCODEITSMFT(compCl.orbitIncROF, CTF::BLCorbitIncROF, 0);
-  iosize += ENCODEITSMFT(compCl.nclusROF, CTF::BLCnclusROF, 0);
-  //
-  iosize += ENCODEITSMFT(compCl.chipInc, CTF::BLCchipInc, 0);
-  iosize += ENCODEITSMFT(compCl.chipMul, CTF::BLCchipMul, 0);
-  iosize += ENCODEITSMFT(compCl.row, CTF::BLCrow, 0);
-  iosize += ENCODEITSMFT(compCl.colInc, CTF::BLCcolInc, 0);
-  iosize += ENCODEITSMFT(compCl.pattID, CTF::BLCpattID, 0);
-  iosize += ENCODEITSMFT(compCl.pattMap, CTF::BLCpattMap, 0);
-  // clang-format on
+  // blocks are encoded in the order of the slots, see CTF::Slots
+  auto iosize = encodeBlocks<CTF>(buff, optField,
+                                  compCl.firstChipROF, compCl.bcIncROF, compCl.orbitIncROF, compCl.nclusROF,
+                                  compCl.chipInc, compCl.chipMul, compCl.row, compCl.colInc, compCl.pattID, compCl.pattMap);
   //CTF::get(buff.data())->print(getPrefix());
   iosize.rawIn = rofRecVec.size() * sizeof(ROFRecord) + cclusVec.size() * sizeof(CompClusterExt) + pattVec.size() * sizeof(unsigned char);
   return iosize;
@@ -120,6 +120,14 @@ class Clusterer
     uint32_t nPatt = 0;
   };
 
+  struct PixelRun {        // pixels of a column fired in consecutive rows
+    uint16_t col = 0;      // column of the run
+    uint16_t rowMin = 0;   // 1st row of the run
+    uint16_t rowMax = 0;   // last row of the run
+    uint16_t nPix = 0;     // number of unmasked pixels of the run
+    uint32_t firstPix = 0; // entry of the 1st pixel of the run in the ChipPixelData
+  };
+
   struct ClustererThread {
     int id = -1;
     Clusterer* parent = nullptr; // parent clusterer
@@ -138,6 +146,11 @@ class Clusterer
     bool noLeftCol = true;                   ///< flag that there is no column on the left to check
     std::array<Label, MaxLabels> labelsBuff; //! temporary buffer for building cluster labels
     std::vector<PixelData> pixArrBuff;       //! temporary buffer for pattern calc.
+    // vertical runs of adjacent fired pixels of the chip, used by the run-based clustering
+    std::vector<PixelRun> runs;
+    std::vector<int> runRoot; // index of the 1st run of the cluster the run belongs to
+    std::vector<int> runNext; // index of the next run of the same cluster
+    std::vector<int> runTail; // index of the last run of the cluster, valid for the 1st run only
     //
     /// temporary storage for the thread output
     CompClusCont compClusters;
@@ -171,11 +184,39 @@ class Clusterer
       curr[row] = lastIndex; // store index of the new precluster in the current column buffer
     }
 
+    ///< index of the 1st run of the cluster the run belongs to
+    int findRunRoot(int i)
+    {
+      while (runRoot[i] != i) {
+        i = runRoot[i] = runRoot[runRoot[i]];
+      }
+      return i;
+    }
+
+    ///< put the runs i and j into the same cluster, which is identified by its 1st run
+    void mergeRuns(int i, int j)
+    {
+      i = findRunRoot(i);
+      j = findRunRoot(j);
+      if (i == j) {
+        return;
+      }
+      if (j < i) {
+        std::swap(i, j);
+      }
+      runRoot[j] = i;
+      runNext[runTail[i]] = j;
+      runTail[i] = runTail[j];
+    }
+
     void fetchMCLabels(int digID, const ConstMCTruth* labelsDig, int& nfilled);
     void initChip(const ChipPixelData* curChipData, uint32_t first);
     void updateChip(const ChipPixelData* curChipData, uint32_t ip);
     void finishChip(ChipPixelData* curChipData, CompClusCont* compClus, PatternCont* patterns,
                     const ConstMCTruth* labelsDig, MCTruth* labelsClus);
+    void finishChipRuns(ChipPixelData* curChipData, uint32_t first, CompClusCont* compClus, PatternCont* patterns,
+                        const ConstMCTruth* labelsDig, MCTruth* labelsClus);
+    void streamPixArrBuff(const BBox& bbox, int nlab, CompClusCont* compClusPtr, PatternCont* patternsPtr, MCTruth* labelsClusPtr);
     void finishChipSingleHitFast(uint32_t hit, ChipPixelData* curChipData, CompClusCont* compClusPtr,
                                  PatternCont* patternsPtr, const ConstMCTruth* labelsDigPtr, MCTruth* labelsClusPTr);
     void process(uint16_t chip, uint16_t nChips, CompClusCont* compClusPtr, PatternCont* patternsPtr,
@@ -216,6 +257,9 @@ class Clusterer
   int getMaxBCSeparationToSquash() const { return mMaxBCSeparationToSquash; }
   void setMaxBCSeparationToSquash(int n) { mMaxBCSeparationToSquash = n; }
 
+  bool isClusteringFromRuns() const { return mClusterFromRuns; }
+  void setClusteringFromRuns(bool v) { mClusterFromRuns = v; }
+
   void print() const;
   void clear();
   void reset();
@@ -244,6 +288,8 @@ class Clusterer
   int mMaxRowColDiffToMask = 0; ///< provide their difference in col/row is <= than this
   int mNHugeClus = 0;           ///< number of encountered huge clusters
 
+  bool mClusterFromRuns = false; ///< find the clusters from the runs of fired pixels in the columns rather than from the preclusters
+
   ///< Squashing options
   int mSquashingDepth = 0; ///< squashing is applied to next N rofs
   int mMaxBCSeparationToSquash = 6000. / o2::constants::lhc::LHCBunchSpacingNS + 10;
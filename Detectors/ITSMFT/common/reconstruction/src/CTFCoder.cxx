@@ -16,6 +16,8 @@
 #include "ITSMFTReconstruction/CTFCoder.h"
 #include "CommonUtils/StringUtils.h"
 #include <TTree.h>
+#include <array>
+#include <functional>
 
 using namespace o2::itsmft;
 
@@ -240,19 +242,27 @@ CompressedClusters CTFCoder::decodeCompressedClusters(const CTF::base& ec, o2::c
   cc.header = ec.getHeader();
   checkDictVersion(static_cast<const o2::ctf::CTFDictHeader&>(cc.header));
   ec.print(getPrefix(), mVerbosity);
-#define DECODEITSMFT(part, slot) ec.decode(part, int(slot), mCoders[int(slot)])
-  // clang-format off
-  iosize += DECODEITSMFT(cc.firstChipROF, CTF::BLCfirstChipROF);
-  iosize += DECODEITSMFT(cc.bcIncROF,     CTF::BLCbcIncROF);
-  iosize += DECODEITSMFT(cc.orbitIncROF,  CTF::BLCorbitIncROF);
-  iosize += DECODEITSMFT(cc.nclusROF,     CTF::BLCnclusROF);
-  //
-  iosize += DECODEITSMFT(cc.chipInc,      CTF::BLCchipInc);
-  iosize += DECODEITSMFT(cc.chipMul,      CTF::BLCchipMul);
-  iosize += DECODEITSMFT(cc.row,          CTF::BLCrow);
-  iosize += DECODEITSMFT(cc.colInc,       CTF::BLCcolInc);
-  iosize += DECODEITSMFT(cc.pattID,       CTF::BLCpattID);
-  iosize += DECODEITSMFT(cc.pattMap,      CTF::BLCpattMap);
-  // clang-format on
+  // every block has its own decoder and destination, so they can be decoded concurrently
+  std::array<o2::ctf::CTFIOSize, CTF::getNBlocks()> blockSizes;
+#define DECODEITSMFT(part, slot) [&]() { blockSizes[int(slot)] = ec.decode(part, int(slot), mCoders[int(slot)]); }
+  std::array<std::function<void()>, CTF::getNBlocks()> tasks = {
+    // clang-format off
+    DECODEITSMFT(cc.firstChipROF, CTF::BLCfirstChipROF),
+    DECODEITSMFT(cc.bcIncROF,     CTF::BLCbcIncROF),
+    DECODEITSMFT(cc.orbitIncROF,  CTF::BLCorbitIncROF),
+    DECODEITSMFT(cc.nclusROF,     CTF::BLCnclusROF),
+    //
+    DECODEITSMFT(cc.chipInc,      CTF::BLCchipInc),
+    DECODEITSMFT(cc.chipMul,      CTF::BLCchipMul),
+    DECODEITSMFT(cc.row,          CTF::BLCrow),
+    DECODEITSMFT(cc.colInc,       CTF::BLCcolInc),
+    DECODEITSMFT(cc.pattID,       CTF::BLCpattID),
+    DECODEITSMFT(cc.pattMap,      CTF::BLCpattMap)
+    // clang-format on
+  };
+  runEncoderTasks(tasks);
+  for (const auto& sz : blockSizes) {
+    iosize += sz;
+  }
   return cc;
 }
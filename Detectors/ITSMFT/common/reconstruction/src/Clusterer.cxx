@@ -189,6 +189,8 @@ void Clusterer::ClustererThread::process(uint16_t chip, uint16_t nChips, CompClu
       auto valp = validPixID++;
       if (validPixID == npix) { // special case of a single pixel fired on the chip
         finishChipSingleHitFast(valp, curChipData, compClusPtr, patternsPtr, labelsDigPtr, labelsClPtr);
+      } else if (parent->mClusterFromRuns) {
+        finishChipRuns(curChipData, valp, compClusPtr, patternsPtr, labelsDigPtr, labelsClPtr);
       } else {
         initChip(curChipData, valp);
         for (; validPixID < npix; validPixID++) {
@@ -259,41 +261,140 @@ void Clusterer::ClustererThread::finishChip(ChipPixelData* curChipData, CompClus
       }
       preClusterIndices[i2] = -1;
     }
-    if (bbox.isAcceptableSize()) {
-      parent->streamCluster(pixArrBuff, &labelsBuff, bbox, parent->mPattIdConverter, compClusPtr, patternsPtr, labelsClusPtr, nlab);
+    streamPixArrBuff(bbox, nlab, compClusPtr, patternsPtr, labelsClusPtr);
+  }
+}
+
+//__________________________________________________
+void Clusterer::ClustererThread::finishChipRuns(ChipPixelData* curChipData, uint32_t first, CompClusCont* compClusPtr,
+                                                PatternCont* patternsPtr, const ConstMCTruth* labelsDigPtr, MCTruth* labelsClusPtr)
+{
+  // Clusterize the chip starting from its 1st unmasked pixel (entry "first" in the ChipPixelData).
+  // The pixels are sorted in columns and rows, so the pixels fired in consecutive rows of the same column
+  // are grouped in runs with a single sequential pass, then the runs touching each other in neighbouring
+  // columns are merged to clusters. This avoids the per-pixel precluster bookkeeping, which is expensive
+  // for chips with many fired pixels.
+  const auto& pixData = curChipData->getData();
+  runs.clear();
+  for (uint32_t ip = first; ip < pixData.size(); ip++) {
+    const auto& pix = pixData[ip];
+    if (pix.isMasked()) {
+      continue;
+    }
+    uint16_t row = pix.getRowDirect(), col = pix.getCol(); // can use getRowDirect since the pixel is not masked
+    if (!runs.empty() && runs.back().col == col && runs.back().rowMax + 1 == row) {
+      runs.back().rowMax = row;
+      runs.back().nPix++;
     } else {
-      auto warnLeft = MaxHugeClusWarn - parent->mNHugeClus;
-      if (warnLeft > 0) {
-        LOGP(warn, "Splitting a huge cluster: chipID {}, rows {}:{} cols {}:{}{}", bbox.chipID, bbox.rowMin, bbox.rowMax, bbox.colMin, bbox.colMax,
-             warnLeft == 1 ? " (Further warnings will be muted)" : "");
-#ifdef WITH_OPENMP
-#pragma omp critical
+      runs.emplace_back(PixelRun{col, row, row, 1, ip});
+    }
+  }
+  int nRuns = runs.size();
+  runRoot.resize(nRuns);
+  runNext.assign(nRuns, -1);
+  runTail.resize(nRuns);
+  for (int ir = 0; ir < nRuns; ir++) {
+    runRoot[ir] = runTail[ir] = ir;
+  }
+#ifdef _ALLOW_DIAGONAL_ALPIDE_CLUSTERS_
+  constexpr int Slack = 1; // runs of neighbouring columns touch also by their corners
+#else
+  constexpr int Slack = 0;
 #endif
-        {
-          parent->mNHugeClus++;
+  // merge the overlapping runs of each pair of neighbouring columns, the runs are ordered in rows within a column
+  int prevBeg = 0, prevEnd = 0, currBeg = 0;
+  while (currBeg < nRuns) {
+    int currEnd = currBeg;
+    while (currEnd < nRuns && runs[currEnd].col == runs[currBeg].col) {
+      currEnd++;
+    }
+    if (prevEnd > prevBeg && runs[prevBeg].col + 1 == runs[currBeg].col) {
+      int ip = prevBeg, ic = currBeg;
+      while (ip < prevEnd && ic < currEnd) {
+        const auto &runP = runs[ip], &runC = runs[ic];
+        if (runP.rowMax + Slack < runC.rowMin) {
+          ip++;
+        } else if (runC.rowMax + Slack < runP.rowMin) {
+          ic++;
+        } else {
+          mergeRuns(ip, ic);
+          runP.rowMax < runC.rowMax ? ip++ : ic++;
         }
       }
-      BBox bboxT(bbox); // truncated box
-      std::vector<PixelData> pixbuf;
-      do {
-        bboxT.rowMin = bbox.rowMin;
-        bboxT.colMax = std::min(bbox.colMax, uint16_t(bboxT.colMin + o2::itsmft::ClusterPattern::MaxColSpan - 1));
-        do { // Select a subset of pixels fitting the reduced bounding box
-          bboxT.rowMax = std::min(bbox.rowMax, uint16_t(bboxT.rowMin + o2::itsmft::ClusterPattern::MaxRowSpan - 1));
-          for (const auto& pix : pixArrBuff) {
-            if (bboxT.isInside(pix.getRowDirect(), pix.getCol())) {
-              pixbuf.push_back(pix);
-            }
-          }
-          if (!pixbuf.empty()) { // Stream a piece of cluster only if the reduced bounding box is not empty
-            parent->streamCluster(pixbuf, &labelsBuff, bboxT, parent->mPattIdConverter, compClusPtr, patternsPtr, labelsClusPtr, nlab, true);
-            pixbuf.clear();
+    }
+    prevBeg = currBeg;
+    prevEnd = currBeg = currEnd;
+  }
+  // stream the clusters in the order of their 1st run
+  for (int ir = 0; ir < nRuns; ir++) {
+    if (runRoot[ir] != ir) {
+      continue;
+    }
+    BBox bbox(curChipData->getChipID());
+    int nlab = 0;
+    pixArrBuff.clear();
+    for (int next = ir; next >= 0; next = runNext[next]) {
+      const auto& run = runs[next];
+      bbox.adjust(run.rowMin, run.col);
+      bbox.adjust(run.rowMax, run.col);
+      for (uint32_t ip = run.firstPix, nAdded = 0; nAdded < run.nPix; ip++) {
+        const auto pix = pixData[ip];
+        if (pix.isMasked()) {
+          continue;
+        }
+        pixArrBuff.push_back(pix); // needed for cluster topology
+        nAdded++;
+        if (labelsClusPtr) {
+          if (parent->mSquashingDepth) { // the MCtruth for this pixel is stored in chip data: due to squashing we lose contiguity
+            fetchMCLabels(curChipData->getOrderedPixId(ip), labelsDigPtr, nlab);
+          } else { // the MCtruth for this pixel is at curChipData->startID+ip
+            fetchMCLabels(ip + curChipData->getStartID(), labelsDigPtr, nlab);
           }
-          bboxT.rowMin = bboxT.rowMax + 1;
-        } while (bboxT.rowMin < bbox.rowMax);
-        bboxT.colMin = bboxT.colMax + 1;
-      } while (bboxT.colMin < bbox.colMax);
+        }
+      }
+    }
+    streamPixArrBuff(bbox, nlab, compClusPtr, patternsPtr, labelsClusPtr);
+  }
+}
+
+//__________________________________________________
+void Clusterer::ClustererThread::streamPixArrBuff(const BBox& bbox, int nlab, CompClusCont* compClusPtr, PatternCont* patternsPtr, MCTruth* labelsClusPtr)
+{
+  // stream the cluster made of the pixels in the pixArrBuff, splitting it if it does not fit the maximum pattern size
+  if (bbox.isAcceptableSize()) {
+    parent->streamCluster(pixArrBuff, &labelsBuff, bbox, parent->mPattIdConverter, compClusPtr, patternsPtr, labelsClusPtr, nlab);
+  } else {
+    auto warnLeft = MaxHugeClusWarn - parent->mNHugeClus;
+    if (warnLeft > 0) {
+      LOGP(warn, "Splitting a huge cluster: chipID {}, rows {}:{} cols {}:{}{}", bbox.chipID, bbox.rowMin, bbox.rowMax, bbox.colMin, bbox.colMax,
+           warnLeft == 1 ? " (Further warnings will be muted)" : "");
+#ifdef WITH_OPENMP
+#pragma omp critical
+#endif
+      {
+        parent->mNHugeClus++;
+      }
     }
+    BBox bboxT(bbox); // truncated box
+    std::vector<PixelData> pixbuf;
+    do {
+      bboxT.rowMin = bbox.rowMin;
+      bboxT.colMax = std::min(bbox.colMax, uint16_t(bboxT.colMin + o2::itsmft::ClusterPattern::MaxColSpan - 1));
+      do { // Select a subset of pixels fitting the reduced bounding box
+        bboxT.rowMax = std::min(bbox.rowMax, uint16_t(bboxT.rowMin + o2::itsmft::ClusterPattern::MaxRowSpan - 1));
+        for (const auto& pix : pixArrBuff) {
+          if (bboxT.isInside(pix.getRowDirect(), pix.getCol())) {
+            pixbuf.push_back(pix);
+          }
+        }
+        if (!pixbuf.empty()) { // Stream a piece of cluster only if the reduced bounding box is not empty
+          parent->streamCluster(pixbuf, &labelsBuff, bboxT, parent->mPattIdConverter, compClusPtr, patternsPtr, labelsClusPtr, nlab, true);
+          pixbuf.clear();
+        }
+        bboxT.rowMin = bboxT.rowMax + 1;
+      } while (bboxT.rowMin < bbox.rowMax);
+      bboxT.colMin = bboxT.colMax + 1;
+    } while (bboxT.colMin < bbox.colMax);
   }
 }
 
@@ -453,6 +554,7 @@ void Clusterer::print() const
   LOGP(info, "Clusterizer squashes overflow pixels separated by {} BC and <= {} in row/col seeking down to {} neighbour ROFs", mMaxBCSeparationToSquash, mMaxRowColDiffToMask, mSquashingDepth);
   LOG(info) << "Clusterizer masks overflow pixels separated by < " << mMaxBCSeparationToMask << " BC and <= "
             << mMaxRowColDiffToMask << " in row/col";
+  LOG(info) << "Clusterizer finds clusters from " << (mClusterFromRuns ? "the runs of fired pixels in columns" : "the preclusters of fired pixels");
 
 #ifdef _PERFORM_TIMING_
   auto& tmr = const_cast<TStopwatch&>(mTimer); // ugly but this is what root does internally
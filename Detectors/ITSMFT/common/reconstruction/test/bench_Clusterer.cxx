@@ -0,0 +1,89 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file   bench_Clusterer.cxx
+/// \brief  Benchmark of the precluster and run based clustering of ITSMFT digits
+
+#include "benchmark/benchmark.h"
+#include "DataFormatsITSMFT/Digit.h"
+#include "DataFormatsITSMFT/ROFRecord.h"
+#include "ITSMFTReconstruction/Clusterer.h"
+#include "ITSMFTReconstruction/DigitPixelReader.h"
+#include <TRandom.h>
+#include <algorithm>
+#include <set>
+#include <tuple>
+#include <vector>
+
+using namespace o2::itsmft;
+
+constexpr int NChips = 100;
+constexpr int NROFs = 4;
+
+// Digits of NROFs frames with nClusPerChip blobs of up to blobSize x blobSize pixels on each chip
+void generateDigits(int nClusPerChip, int blobSize, std::vector<Digit>& digits, std::vector<ROFRecord>& rofs)
+{
+  gRandom->SetSeed(1);
+  digits.clear();
+  rofs.clear();
+  for (int irof = 0; irof < NROFs; irof++) {
+    int first = digits.size();
+    for (int chip = 0; chip < NChips; chip++) {
+      std::set<std::tuple<int, int>> pixels; // col, row
+      for (int icl = 0; icl < nClusPerChip; icl++) {
+        int col0 = gRandom->Integer(SegmentationAlpide::NCols - blobSize), row0 = gRandom->Integer(SegmentationAlpide::NRows - blobSize);
+        for (int ic = 0; ic < blobSize; ic++) {
+          for (int ir = 0; ir < blobSize; ir++) {
+            if (gRandom->Rndm() < 0.7) {
+              pixels.emplace(col0 + ic, row0 + ir);
+            }
+          }
+        }
+      }
+      for (const auto& [col, row] : pixels) {
+        digits.emplace_back(chip, row, col, 100);
+      }
+    }
+    o2::InteractionRecord ir(0, 1000 * (irof + 1));
+    rofs.emplace_back(ir, irof, first, digits.size() - first);
+  }
+}
+
+static void BM_Clusterer(benchmark::State& state)
+{
+  std::vector<Digit> digits;
+  std::vector<ROFRecord> rofs;
+  generateDigits(state.range(1), state.range(2), digits, rofs);
+
+  Clusterer clusterer;
+  clusterer.setNChips(NChips);
+  clusterer.setClusteringFromRuns(state.range(0));
+  std::vector<CompClusterExt> clusters;
+  std::vector<unsigned char> patterns;
+  std::vector<ROFRecord> clusROFs;
+  for (auto _ : state) {
+    DigitPixelReader reader;
+    reader.setDigits(digits);
+    reader.setROFRecords(rofs);
+    reader.init();
+    clusters.clear();
+    patterns.clear();
+    clusROFs.clear();
+    clusterer.process(1, reader, &clusters, &patterns, &clusROFs);
+  }
+  state.counters["clusters"] = clusters.size();
+  state.counters["digits/s"] = benchmark::Counter(digits.size(), benchmark::Counter::kIsIterationInvariantRate);
+}
+
+// {preclusters | runs} x clusters per chip x blob size
+BENCHMARK(BM_Clusterer)->ArgsProduct({{0, 1}, {10, 100, 1000}, {3, 8}})->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -48,6 +48,8 @@ struct DPLDigitizerParam : public o2::conf::ConfigurableParamHelper<DPLDigitizer
 
   std::string noiseFilePath{}; ///< optional noise masks file path. FIXME to be removed once switch to CCDBFetcher
 
+  bool useTopologyFastSim = false; ///< sample the cluster topologies from the dictionary instead of the full response simulation
+
   // boilerplate stuff + make principal key
   O2ParamDef(DPLDigitizerParam, getParamName().data());
 
@@ -25,6 +25,7 @@
 #include "ITSMFTSimulation/AlpideSimResponse.h"
 #include "ITSMFTSimulation/DigiParams.h"
 #include "ITSMFTSimulation/Hit.h"
+#include "ITSMFTSimulation/TopologySampler.h"
 #include "ITSMFTBase/GeometryTGeo.h"
 #include "DataFormatsITSMFT/Digit.h"
 #include "DataFormatsITSMFT/NoiseMap.h"
@@ -60,6 +61,8 @@ class Digitizer : public TObject
   const o2::itsmft::DigiParams& getParams() const { return mParams; }
   void setNoiseMap(const o2::itsmft::NoiseMap* mp) { mNoiseMap = mp; }
   void setDeadChannelsMap(const o2::itsmft::NoiseMap* mp) { mDeadChanMap = mp; }
+  /// enable the fast response simulation sampling the cluster topologies from the dictionary, disable if null
+  void setTopologyDictionary(const o2::itsmft::TopologyDictionary* dict);
 
   void init();
 
@@ -94,6 +97,8 @@ class Digitizer : public TObject
 
  private:
   void processHit(const o2::itsmft::Hit& hit, uint32_t& maxFr, int evID, int srcID);
+  bool processHitTopology(const o2::itsmft::Hit& hit, ChipDigitsContainer& chip, int rowS, int rowE, int colS, int colE,
+                          uint32_t roFrame, float tInROF, int nROF, int evID, int srcID);
   void registerDigits(ChipDigitsContainer& chip, uint32_t roFrame, float tInROF, int nROF,
                       uint16_t row, uint16_t col, int nEle, o2::MCCompLabel& lbl);
 
@@ -138,6 +143,7 @@ class Digitizer : public TObject
   o2::dataformats::MCTruthContainer<o2::MCCompLabel>* mMCLabels = nullptr; //! output labels
   const o2::itsmft::NoiseMap* mNoiseMap = nullptr;
   const o2::itsmft::NoiseMap* mDeadChanMap = nullptr;
+  o2::itsmft::TopologySampler mTopologySampler; //! topologies for the fast response simulation
 
   ClassDefOverride(Digitizer, 2);
 };
@@ -0,0 +1,66 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file TopologySampler.h
+/// \brief Sampling of cluster topologies from the dictionary for the fast ITS/MFT digitization
+
+#ifndef ALICEO2_ITSMFT_TOPOLOGYSAMPLER_H_
+#define ALICEO2_ITSMFT_TOPOLOGYSAMPLER_H_
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace o2
+{
+namespace itsmft
+{
+class TopologyDictionary;
+
+/// Samples cluster topologies according to their frequencies in the TopologyDictionary,
+/// conditioned on the minimal row and column span of the cluster, i.e. on the pixels crossed
+/// by the particle, which reflect its incidence angle. Only the explicit topologies of the
+/// dictionary are used, the groups of rare topologies having no pattern.
+class TopologySampler
+{
+ public:
+  /// spans above this are treated as equal to it in the conditioning
+  static constexpr int MaxConditionSpan = 8;
+
+  struct Pixel {
+    int16_t row; ///< row wrt the cluster center of gravity
+    int16_t col; ///< column wrt the cluster center of gravity
+  };
+
+  void init(const TopologyDictionary& dict);
+  bool isInitialized() const { return !mTopologies.empty(); }
+
+  /// @returns index of a topology with at least the requested spans, -1 if there is none
+  /// @param rnd uniform random number in [0, 1)
+  int sample(int minRowSpan, int minColSpan, float rnd) const;
+
+  /// fired pixels of the sampled topology, relative to the pixel at the center of gravity
+  const std::vector<Pixel>& getPixels(int topology) const { return mTopologies[topology]; }
+
+ private:
+  struct Condition {
+    std::vector<double> cumFreq; ///< cumulative frequency of the compatible topologies
+    std::vector<int> topology;   ///< their index in mTopologies
+  };
+
+  std::vector<std::vector<Pixel>> mTopologies;
+  std::array<Condition, MaxConditionSpan * MaxConditionSpan> mConditions;
+};
+
+} // namespace itsmft
+} // namespace o2
+
+#endif
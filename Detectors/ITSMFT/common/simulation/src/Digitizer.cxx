@@ -16,6 +16,7 @@
 #include "ITSMFTBase/SegmentationAlpide.h"
 #include "ITSMFTSimulation/DPLDigitizerParam.h"
 #include "ITSMFTSimulation/Digitizer.h"
+#include "DataFormatsITSMFT/TopologyDictionary.h"
 #include "MathUtils/Cartesian.h"
 #include "SimulationDataFormat/MCTruthContainer.h"
 #include "DetectorsRaw/HBFUtils.h"
@@ -327,6 +328,10 @@ void Digitizer::processHit(const o2::itsmft::Hit& hit, uint32_t& maxFr, int evID
   if (colS > colE) {
     std::swap(colS, colE);
   }
+  if (mTopologySampler.isInitialized() &&
+      processHitTopology(hit, chip, rowS, rowE, colS, colE, mNewROFrame + roFrameRel, timeInROF, nFrames, evID, srcID)) {
+    return;
+  }
   rowS -= AlpideRespSimMat::NPix / 2;
   rowE += AlpideRespSimMat::NPix / 2;
   if (rowS < 0) {
@@ -428,6 +433,53 @@ void Digitizer::processHit(const o2::itsmft::Hit& hit, uint32_t& maxFr, int evID
   }
 }
 
+//________________________________________________________________________________
+bool Digitizer::processHitTopology(const o2::itsmft::Hit& hit, ChipDigitsContainer& chip, int rowS, int rowE, int colS, int colE,
+                                   uint32_t roFrame, float tInROF, int nROF, int evID, int srcID)
+{
+  // fast response simulation: instead of integrating the response map along the track, fire the pixels of a
+  // topology sampled from the dictionary among those spanning at least the pixels crossed by the track
+  // (rowS:rowE, colS:colE), centered on the crossed pixels. Returns false if the dictionary has no such
+  // topology, then the full response simulation is to be used.
+  int topology = mTopologySampler.sample(rowE - rowS + 1, colE - colS + 1, gRandom->Rndm());
+  if (topology < 0) {
+    return false;
+  }
+  float nElectrons = hit.GetEnergyLoss() * mParams.getEnergyToNElectrons(); // total number of deposited electrons
+  if (nElectrons < mParams.getChargeThreshold()) {
+    return true; // not enough charge to fire any pixel
+  }
+  const auto& pixels = mTopologySampler.getPixels(topology);
+  // the pixels of the topology are fired by definition: share the charge but keep each of them above the threshold
+  int nEle = std::max(int(nElectrons / pixels.size()), mParams.getChargeThreshold());
+  int chipID = hit.GetDetectorID(), rowC = (rowS + rowE) / 2, colC = (colS + colE) / 2;
+  o2::MCCompLabel lbl(hit.GetTrackID(), evID, srcID, false);
+  for (const auto& pix : pixels) {
+    int row = rowC + pix.row, col = colC + pix.col;
+    if (row < 0 || row >= Segmentation::NRows || col < 0 || col >= Segmentation::NCols) {
+      continue;
+    }
+    if (mNoiseMap && mNoiseMap->isNoisy(chipID, row, col)) {
+      continue;
+    }
+    if (mDeadChanMap && mDeadChanMap->isNoisy(chipID, row, col)) {
+      continue;
+    }
+    registerDigits(chip, roFrame, tInROF, nROF, row, col, nEle, lbl);
+  }
+  return true;
+}
+
+//________________________________________________________________________________
+void Digitizer::setTopologyDictionary(const o2::itsmft::TopologyDictionary* dict)
+{
+  mTopologySampler = TopologySampler();
+  if (dict) {
+    mTopologySampler.init(*dict);
+    LOG(info) << "Fast response simulation with the cluster topologies of the dictionary is enabled";
+  }
+}
+
 //________________________________________________________________________________
 void Digitizer::registerDigits(ChipDigitsContainer& chip, uint32_t roFrame, float tInROF, int nROF,
                                uint16_t row, uint16_t col, int nEle, o2::MCCompLabel& lbl)
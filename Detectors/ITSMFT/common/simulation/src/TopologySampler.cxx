@@ -0,0 +1,74 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file TopologySampler.cxx
+/// \brief Implementation of the cluster topology sampling for the fast ITS/MFT digitization
+
+#include "ITSMFTSimulation/TopologySampler.h"
+#include "DataFormatsITSMFT/TopologyDictionary.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace o2::itsmft;
+
+//______________________________________________________________________
+void TopologySampler::init(const TopologyDictionary& dict)
+{
+  mTopologies.clear();
+  for (auto& cond : mConditions) {
+    cond.cumFreq.clear();
+    cond.topology.clear();
+  }
+  for (int id = 0; id < dict.getSize(); id++) {
+    if (dict.isGroup(id) || dict.getFrequency(id) <= 0.) {
+      continue;
+    }
+    const auto& patt = dict.getPattern(id);
+    float xCOG = 0.f, zCOG = 0.f;
+    patt.getCOG(xCOG, zCOG);
+    const int rowCOG = std::lround(xCOG), colCOG = std::lround(zCOG);
+    std::vector<Pixel> pixels;
+    for (int ir = 0; ir < patt.getRowSpan(); ir++) {
+      for (int ic = 0; ic < patt.getColumnSpan(); ic++) {
+        if (patt.isSet(ir, ic)) {
+          pixels.push_back(Pixel{int16_t(ir - rowCOG), int16_t(ic - colCOG)});
+        }
+      }
+    }
+    const int topology = mTopologies.size();
+    mTopologies.emplace_back(std::move(pixels));
+    // register the topology for every condition it satisfies
+    const int rowSpan = std::min(patt.getRowSpan(), MaxConditionSpan), colSpan = std::min(patt.getColumnSpan(), MaxConditionSpan);
+    for (int ir = 0; ir < rowSpan; ir++) {
+      for (int ic = 0; ic < colSpan; ic++) {
+        auto& cond = mConditions[ir * MaxConditionSpan + ic];
+        cond.cumFreq.push_back((cond.cumFreq.empty() ? 0. : cond.cumFreq.back()) + dict.getFrequency(id));
+        cond.topology.push_back(topology);
+      }
+    }
+  }
+}
+
+//______________________________________________________________________
+int TopologySampler::sample(int minRowSpan, int minColSpan, float rnd) const
+{
+  minRowSpan = std::clamp(minRowSpan, 1, MaxConditionSpan);
+  minColSpan = std::clamp(minColSpan, 1, MaxConditionSpan);
+  const auto& cond = mConditions[(minRowSpan - 1) * MaxConditionSpan + minColSpan - 1];
+  if (cond.cumFreq.empty()) {
+    return -1;
+  }
+  auto it = std::upper_bound(cond.cumFreq.begin(), cond.cumFreq.end(), rnd * cond.cumFreq.back());
+  if (it == cond.cumFreq.end()) {
+    --it;
+  }
+  return cond.topology[it - cond.cumFreq.begin()];
+}
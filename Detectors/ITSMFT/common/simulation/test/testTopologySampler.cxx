@@ -0,0 +1,79 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test TopologySampler
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "ITSMFTSimulation/TopologySampler.h"
+#include "ITSMFTReconstruction/BuildTopologyDictionary.h"
+#include "DataFormatsITSMFT/ClusterTopology.h"
+
+using namespace o2::itsmft;
+
+BOOST_AUTO_TEST_CASE(TopologySampler_test)
+{
+  // dictionary with 70% of 1x1, 20% of 2x1 (2 rows) and 10% of 2x2 clusters
+  const unsigned char patt1x1[ClusterPattern::MaxPatternBytes] = {0x80};
+  const unsigned char patt2x1[ClusterPattern::MaxPatternBytes] = {0xc0};
+  const unsigned char patt2x2[ClusterPattern::MaxPatternBytes] = {0xf0};
+  BuildTopologyDictionary builder;
+  for (int i = 0; i < 100; i++) {
+    if (i < 70) {
+      builder.accountTopology(ClusterTopology(1, 1, patt1x1));
+    } else if (i < 90) {
+      builder.accountTopology(ClusterTopology(2, 1, patt2x1));
+    } else {
+      builder.accountTopology(ClusterTopology(2, 2, patt2x2));
+    }
+  }
+  builder.setThreshold(0.);
+  builder.groupRareTopologies();
+  auto dict = builder.getDictionary();
+
+  TopologySampler sampler;
+  BOOST_CHECK(!sampler.isInitialized());
+  sampler.init(dict);
+  BOOST_CHECK(sampler.isInitialized());
+
+  const int nSamples = 1000;
+  int nPixels[5] = {0};
+  for (int i = 0; i < nSamples; i++) {
+    int topology = sampler.sample(1, 1, (i + 0.5f) / nSamples);
+    BOOST_REQUIRE(topology >= 0);
+    nPixels[sampler.getPixels(topology).size()]++;
+  }
+  BOOST_CHECK_EQUAL(nPixels[1], 700);
+  BOOST_CHECK_EQUAL(nPixels[2], 200);
+  BOOST_CHECK_EQUAL(nPixels[4], 100);
+
+  // a track crossing 2 rows produces 2x1 or 2x2 clusters only, in the ratio of their frequencies
+  int n2x2 = 0;
+  for (int i = 0; i < nSamples; i++) {
+    int topology = sampler.sample(2, 1, (i + 0.5f) / nSamples);
+    BOOST_REQUIRE(topology >= 0);
+    const auto& pixels = sampler.getPixels(topology);
+    BOOST_REQUIRE(pixels.size() == 2 || pixels.size() == 4);
+    n2x2 += pixels.size() == 4;
+  }
+  BOOST_CHECK_EQUAL(n2x2, nSamples / 3);
+
+  // the pixels are given wrt the center of gravity of the cluster
+  const auto& pixels = sampler.getPixels(sampler.sample(2, 2, 0.5f));
+  BOOST_REQUIRE_EQUAL(pixels.size(), 4);
+  for (const auto& pix : pixels) {
+    BOOST_CHECK(pix.row >= -1 && pix.row <= 0);
+    BOOST_CHECK(pix.col >= -1 && pix.col <= 0);
+  }
+
+  // no topology spanning 3 rows
+  BOOST_CHECK_EQUAL(sampler.sample(3, 1, 0.5f), -1);
+}
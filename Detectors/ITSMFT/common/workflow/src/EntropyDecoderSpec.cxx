@@ -153,6 +153,7 @@ DataProcessorSpec getEntropyDecoderSpec(o2::header::DataOrigin orig, int verbosi
       {"ctf-dict", VariantType::String, "ccdb", {"CTF dictionary: empty or ccdb=CCDB, none=no external dictionary otherwise: local filename"}},
       {"mask-noise", VariantType::Bool, false, {"apply noise mask to digits or clusters (involves reclusterization)"}},
       {"ignore-cluster-dictionary", VariantType::Bool, false, {"do not use cluster dictionary, always store explicit patterns"}},
+      {"decoder-threads", VariantType::Int, 1, {"number of threads for concurrent entropy decoding of CTF blocks"}},
       {"ans-version", VariantType::String, {"version of ans entropy coder implementation to use"}}}};
 }
 
@@ -311,6 +311,7 @@ void STFDecoder<Mapping>::updateTimeDependentParams(ProcessingContext& pc)
         nROFsToSquash = 2 + int(clParams.maxSOTMUS / (rofBC * o2::constants::lhc::LHCBunchSpacingMUS)); // use squashing
       }
       mClusterer->setMaxROFDepthToSquash(clParams.maxBCDiffToSquashBias > 0 ? nROFsToSquash : 0);
+      mClusterer->setClusteringFromRuns(clParams.clusterFromRuns);
       mClusterer->print();
     }
   }
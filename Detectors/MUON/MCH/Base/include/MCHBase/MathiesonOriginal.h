@@ -17,6 +17,8 @@
 #ifndef O2_MCH_MATHIESONORIGINAL_H_
 #define O2_MCH_MATHIESONORIGINAL_H_
 
+#include <vector>
+
 namespace o2
 {
 namespace mch
@@ -40,9 +42,29 @@ class MathiesonOriginal
   void setSqrtKx3AndDeriveKx2Kx4(float sqrtKx3);
   void setSqrtKy3AndDeriveKy2Ky4(float sqrtKy3);
 
+  /// use precomputed tables of the Mathieson primitive instead of evaluating tanh and atan
+  /// (absolute difference on the primitive < 1.e-9, below the float precision of the integral)
+  void setUseLookupTable(bool use);
+  bool usesLookupTable() const { return mUseLookupTable; }
+
   float integrate(float xMin, float yMin, float xMax, float yMax) const;
 
  private:
+  /// primitive of the 1D Mathieson, atan(sqrt(K3) * tanh(K2 * u)), tabulated with its derivative
+  /// as a function of the distance u in units of pitch and evaluated with cubic Hermite interpolation
+  class PrimitiveTable
+  {
+   public:
+    void fill(float sqrtK3, float k2);
+    double eval(double u) const;
+
+   private:
+    static constexpr double SStep = 0.01; ///< sampling step in units of pitch
+    static constexpr double SUMax = 12.;  ///< limit above which the primitive is considered constant
+    std::vector<double> mPrimitive{};     ///< sampled primitive
+    std::vector<double> mDerivative{};    ///< sampled derivative times the step
+  };
+
   float mSqrtKx3 = 0.;      ///< Mathieson Sqrt(Kx3)
   float mKx2 = 0.;          ///< Mathieson Kx2
   float mKx4 = 0.;          ///< Mathieson Kx4 = Kx1/Kx2/Sqrt(Kx3)
@@ -50,6 +72,10 @@ class MathiesonOriginal
   float mKy2 = 0.;          ///< Mathieson Ky2
   float mKy4 = 0.;          ///< Mathieson Ky4 = Ky1/Ky2/Sqrt(Ky3)
   float mInversePitch = 0.; ///< 1 / anode-cathode pitch
+
+  bool mUseLookupTable = false; ///< use the tabulated primitives
+  PrimitiveTable mTableX{};     ///< tabulated primitive in x direction
+  PrimitiveTable mTableY{};     ///< tabulated primitive in y direction
 };
 
 } // namespace mch
@@ -16,6 +16,9 @@
 
 #include "MCHBase/MathiesonOriginal.h"
 
+#include <algorithm>
+#include <cmath>
+
 #include <TMath.h>
 
 namespace o2
@@ -32,6 +35,9 @@ void MathiesonOriginal::setSqrtKx3AndDeriveKx2Kx4(float sqrtKx3)
   mKx2 = TMath::Pi() / 2. * (1. - 0.5 * mSqrtKx3);
   float cx1 = mKx2 * mSqrtKx3 / 4. / TMath::ATan(static_cast<double>(mSqrtKx3));
   mKx4 = cx1 / mKx2 / mSqrtKx3;
+  if (mUseLookupTable) {
+    mTableX.fill(mSqrtKx3, mKx2);
+  }
 }
 
 //_________________________________________________________________________________________________
@@ -43,6 +49,20 @@ void MathiesonOriginal::setSqrtKy3AndDeriveKy2Ky4(float sqrtKy3)
   mKy2 = TMath::Pi() / 2. * (1. - 0.5 * mSqrtKy3);
   float cy1 = mKy2 * mSqrtKy3 / 4. / TMath::ATan(static_cast<double>(mSqrtKy3));
   mKy4 = cy1 / mKy2 / mSqrtKy3;
+  if (mUseLookupTable) {
+    mTableY.fill(mSqrtKy3, mKy2);
+  }
+}
+
+//_________________________________________________________________________________________________
+void MathiesonOriginal::setUseLookupTable(bool use)
+{
+  /// enable/disable the tabulated primitives, filled with the current Mathieson parameters
+  mUseLookupTable = use;
+  if (use) {
+    mTableX.fill(mSqrtKx3, mKx2);
+    mTableY.fill(mSqrtKy3, mKy2);
+  }
 }
 
 //_________________________________________________________________________________________________
@@ -54,6 +74,11 @@ float MathiesonOriginal::integrate(float xMin, float yMin, float xMax, float yMa
   xMax *= mInversePitch;
   yMin *= mInversePitch;
   yMax *= mInversePitch;
+
+  if (mUseLookupTable) {
+    return static_cast<float>(4. * mKx4 * (mTableX.eval(xMax) - mTableX.eval(xMin)) *
+                              mKy4 * (mTableY.eval(yMax) - mTableY.eval(yMin)));
+  }
   //
   // The Mathieson function
   double uxMin = mSqrtKx3 * TMath::TanH(mKx2 * xMin);
@@ -66,5 +91,40 @@ float MathiesonOriginal::integrate(float xMin, float yMin, float xMax, float yMa
                             mKy4 * (TMath::ATan(uyMax) - TMath::ATan(uyMin)));
 }
 
+//_________________________________________________________________________________________________
+void MathiesonOriginal::PrimitiveTable::fill(float sqrtK3, float k2)
+{
+  /// sample the primitive and its derivative with the given Mathieson parameters
+  int n = static_cast<int>(std::lround(SUMax / SStep)) + 1;
+  mPrimitive.resize(n);
+  mDerivative.resize(n);
+  double k3 = static_cast<double>(sqrtK3) * sqrtK3;
+  for (int i = 0; i < n; ++i) {
+    double t = TMath::TanH(k2 * (i * SStep));
+    mPrimitive[i] = TMath::ATan(sqrtK3 * t);
+    mDerivative[i] = SStep * sqrtK3 * k2 * (1. - t * t) / (1. + k3 * t * t);
+  }
+}
+
+//_________________________________________________________________________________________________
+double MathiesonOriginal::PrimitiveTable::eval(double u) const
+{
+  /// interpolate the primitive at u (odd function)
+  double absU = std::abs(u);
+  double value = 0.;
+  if (absU >= SUMax) {
+    value = mPrimitive.back();
+  } else {
+    double x = absU / SStep;
+    int i = std::min(static_cast<int>(x), static_cast<int>(mPrimitive.size()) - 2);
+    double t = x - i;
+    double t2 = t * t;
+    double t3 = t2 * t;
+    value = (2. * t3 - 3. * t2 + 1.) * mPrimitive[i] + (t3 - 2. * t2 + t) * mDerivative[i] +
+            (3. * t2 - 2. * t3) * mPrimitive[i + 1] + (t3 - t2) * mDerivative[i + 1];
+  }
+  return (u < 0.) ? -value : value;
+}
+
 } // namespace mch
 } // namespace o2
@@ -0,0 +1,52 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE mathieson original test
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "MCHBase/MathiesonOriginal.h"
+#include <cmath>
+
+using o2::mch::MathiesonOriginal;
+
+BOOST_AUTO_TEST_CASE(LookupTableShouldReproduceAnalyticIntegrals)
+{
+  MathiesonOriginal analytic;
+  analytic.setPitch(0.25);
+  analytic.setSqrtKx3AndDeriveKx2Kx4(0.7131);
+  analytic.setSqrtKy3AndDeriveKy2Ky4(0.7642);
+
+  MathiesonOriginal tabulated(analytic);
+  tabulated.setUseLookupTable(true);
+  BOOST_CHECK(tabulated.usesLookupTable());
+  BOOST_CHECK(!analytic.usesLookupTable());
+
+  // pads of various sizes at various distances from the Mathieson center, including far outside the table range
+  const float padSizes[] = {0.63, 0.42, 2.5, 5.};
+  for (auto dx : padSizes) {
+    for (auto dy : padSizes) {
+      for (float x = -10.f; x <= 10.f; x += 0.37f) {
+        for (float y = -4.f; y <= 4.f; y += 0.29f) {
+          float ref = analytic.integrate(x - dx / 2, y - dy / 2, x + dx / 2, y + dy / 2);
+          float val = tabulated.integrate(x - dx / 2, y - dy / 2, x + dx / 2, y + dy / 2);
+          BOOST_CHECK_SMALL(val - ref, 1.e-6f);
+        }
+      }
+    }
+  }
+
+  // the full integral is 1 and the tables follow the parameter changes
+  tabulated.setSqrtKx3AndDeriveKx2Kx4(0.7);
+  analytic.setSqrtKx3AndDeriveKx2Kx4(0.7);
+  BOOST_CHECK_CLOSE(tabulated.integrate(-100., -100., 100., 100.), 1.f, 1.e-4);
+  BOOST_CHECK_SMALL(tabulated.integrate(-0.1, -0.3, 0.2, 0.1) - analytic.integrate(-0.1, -0.3, 0.2, 0.1), 1.e-6f);
+}
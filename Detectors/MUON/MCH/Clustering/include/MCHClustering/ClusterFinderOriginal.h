@@ -33,6 +33,8 @@
 #include "MCHMappingInterface/Segmentation.h"
 #include "MCHPreClustering/PreClusterFinder.h"
 
+class TRandom;
+
 namespace o2
 {
 namespace mch
@@ -57,6 +59,8 @@ class ClusterFinderOriginal
   void deinit();
   void reset();
 
+  void setSeed(uint32_t seed);
+
   void findClusters(gsl::span<const Digit> digits);
 
   /// return the list of reconstructed clusters
@@ -135,6 +139,8 @@ class ClusterFinderOriginal
   ErrorMap mErrorMap{}; ///< counting of encountered errors
 
   PreClusterFinder mPreClusterFinder{}; ///< preclusterizer
+
+  std::unique_ptr<TRandom> mRandom{}; ///< private random generator (gRandom is used if not set)
 };
 
 } // namespace mch
@@ -0,0 +1,86 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file ClusterFinderOriginalPool.h
+/// \brief Definition of a class to run the original MLEM cluster finder on several threads
+
+#ifndef O2_MCH_CLUSTERFINDERORIGINALPOOL_H_
+#define O2_MCH_CLUSTERFINDERORIGINALPOOL_H_
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <gsl/span>
+
+#include "DataFormatsMCH/Digit.h"
+#include "DataFormatsMCH/Cluster.h"
+#include "MCHBase/ErrorMap.h"
+#include "MCHBase/PreCluster.h"
+#include "MCHClustering/ClusterFinderOriginal.h"
+
+namespace o2
+{
+namespace mch
+{
+
+/// Clusterize the preclusters of one ROF in parallel, with one ClusterFinderOriginal per thread.
+/// The preclusters are independent, so the output is the same as when clusterizing them one
+/// after the other with a single cluster finder: the clusters and their digits are ordered
+/// and indexed as the input preclusters, whatever the number of threads.
+/// The random generator used in the fit is reseeded for every precluster to keep it reproducible.
+class ClusterFinderOriginalPool
+{
+ public:
+  void init(bool run2Config, int nThreads = 1);
+  void deinit();
+
+  void findClusters(gsl::span<const PreCluster> preClusters, gsl::span<const Digit> digits);
+
+  /// return the list of reconstructed clusters of the last call to findClusters
+  const std::vector<Cluster>& getClusters() const { return mClusters; }
+  /// return the list of digits used in reconstructed clusters of the last call to findClusters
+  const std::vector<Digit>& getUsedDigits() const { return mUsedDigits; }
+  /// return the index of the first cluster reconstructed from the given precluster (iPreCluster <= number of preclusters)
+  int getFirstClusterIdx(size_t iPreCluster) const { return mFirstClusterIdx[iPreCluster]; }
+
+  /// return the counting of encountered errors
+  ErrorMap& getErrorMap() { return mErrorMap; }
+
+  int getNThreads() const { return mNThreads; }
+
+ private:
+  void setNThreads(int n);
+
+  /// clusters and digits produced by one precluster in the lists of the cluster finder of a thread
+  struct PreClusterOutput {
+    int thread = 0;
+    int firstCluster = 0;
+    int nClusters = 0;
+    int firstDigit = 0;
+    int nDigits = 0;
+  };
+
+  int mNThreads = 1;                                            ///< number of threads
+  uint32_t mNPreClusters = 0;                                   ///< number of preclusters processed so far, used to seed the fit
+  std::vector<std::unique_ptr<ClusterFinderOriginal>> mFinders; ///< one cluster finder per thread
+  std::vector<PreClusterOutput> mPreClusterOutputs;             ///< output of every precluster of the current ROF
+  std::vector<int> mFirstClusterIdx;                            ///< index of the first cluster of every precluster
+  std::vector<Cluster> mClusters{};                             ///< list of reconstructed clusters
+  std::vector<Digit> mUsedDigits{};                             ///< list of digits used in reconstructed clusters
+  ErrorMap mErrorMap{};                                         ///< counting of encountered errors
+};
+
+} // namespace mch
+} // namespace o2
+
+#endif // O2_MCH_CLUSTERFINDERORIGINALPOOL_H_
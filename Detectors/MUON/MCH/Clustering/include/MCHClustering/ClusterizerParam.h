@@ -37,6 +37,8 @@ struct ClusterizerParam : public o2::conf::ConfigurableParamHelper<ClusterizerPa
 
   bool legacy = true; ///< use original (run2) clustering
 
+  bool mathiesonLookupTable = false; ///< use tabulated Mathieson primitives to compute the pad charge integrals
+
   O2ParamDef(ClusterizerParam, "MCHClustering");
 };
 
@@ -115,6 +115,11 @@ void ClusterFinderGEM::init(int _mode, bool run2Config)
     clusterConfig.SBadClusterResolutionX = ClusterizerParam::Instance().badClusterResolutionX;
     clusterConfig.SBadClusterResolutionY = ClusterizerParam::Instance().badClusterResolutionY;
   }
+  // use the tabulated (spline) Mathieson primitives to compute the pad integrals
+  if (ClusterizerParam::Instance().mathiesonLookupTable) {
+    clusterConfig.useSpline = 1;
+    o2::mch::initMathieson(clusterConfig.useSpline, 0);
+  }
   // Inv ???  LOG(info) << "Init lowestPadCharge = " << clusterConfig.minChargeOfPads ;
 }
 //_________________________________________________________________________________________________
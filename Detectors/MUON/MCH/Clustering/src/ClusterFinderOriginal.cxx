@@ -30,8 +30,10 @@
 
 #include <TH2I.h>
 #include <TAxis.h>
+#include <TDirectory.h>
 #include <TMath.h>
 #include <TRandom.h>
+#include <TRandom3.h>
 
 #include <fairlogger/Logger.h>
 
@@ -104,6 +106,10 @@ void ClusterFinderOriginal::init(bool run2Config)
     mMathiesons[1].setSqrtKx3AndDeriveKx2Kx4(ResponseParam::Instance().mathiesonSqrtKx3St2345);
     mMathiesons[1].setSqrtKy3AndDeriveKy2Ky4(ResponseParam::Instance().mathiesonSqrtKy3St2345);
   }
+
+  // use tabulated primitives to speed up the Mathieson integrals in the EM and fit loops
+  mMathiesons[0].setUseLookupTable(ClusterizerParam::Instance().mathiesonLookupTable);
+  mMathiesons[1].setUseLookupTable(ClusterizerParam::Instance().mathiesonLookupTable);
 }
 
 //_________________________________________________________________________________________________
@@ -121,6 +127,18 @@ void ClusterFinderOriginal::reset()
   mUsedDigits.clear();
 }
 
+//_________________________________________________________________________________________________
+void ClusterFinderOriginal::setSeed(uint32_t seed)
+{
+  /// use a private random generator initialized with this seed instead of gRandom
+  /// this makes the results reproducible when several cluster finders run in parallel
+  if (!mRandom) {
+    mRandom = std::make_unique<TRandom3>(seed);
+  } else {
+    mRandom->SetSeed(seed);
+  }
+}
+
 //_________________________________________________________________________________________________
 void ClusterFinderOriginal::findClusters(gsl::span<const Digit> digits)
 {
@@ -132,6 +150,9 @@ void ClusterFinderOriginal::findClusters(gsl::span<const Digit> digits)
     return;
   }
 
+  // do not attach the temporary histograms to the current directory (not thread safe)
+  TDirectory::TContext noDirectory(nullptr);
+
   // set the Mathieson function to be used
   mMathieson = (digits[0].getDetID() < 300) ? &mMathiesons[0] : &mMathiesons[1];
 
@@ -1621,7 +1642,7 @@ double ClusterFinderOriginal::fit(double currentParam[SNFitParamMax + 2],
       }
       if (nFail > 10) {
         currentParam[iDerivMax] -= shift[iDerivMax];
-        shift[iDerivMax] = 4. * shiftSave * (gRandom->Rndm(0) - 0.5);
+        shift[iDerivMax] = 4. * shiftSave * ((mRandom ? mRandom->Rndm() : gRandom->Rndm()) - 0.5);
         currentParam[iDerivMax] += shift[iDerivMax];
       }
     }
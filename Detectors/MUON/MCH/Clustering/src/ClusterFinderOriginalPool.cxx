@@ -0,0 +1,129 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file ClusterFinderOriginalPool.cxx
+/// \brief Implementation of a class to run the original MLEM cluster finder on several threads
+
+#include "MCHClustering/ClusterFinderOriginalPool.h"
+
+#include <TROOT.h>
+
+#include <fairlogger/Logger.h>
+
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
+namespace o2::mch
+{
+
+//_________________________________________________________________________________________________
+void ClusterFinderOriginalPool::init(bool run2Config, int nThreads)
+{
+  /// create and initialize one cluster finder per thread
+
+  setNThreads(nThreads);
+  if (mNThreads > 1) {
+    ROOT::EnableThreadSafety();
+  }
+
+  mFinders.clear();
+  for (int i = 0; i < mNThreads; ++i) {
+    mFinders.emplace_back(std::make_unique<ClusterFinderOriginal>());
+    mFinders.back()->init(run2Config);
+  }
+  mNPreClusters = 0;
+}
+
+//_________________________________________________________________________________________________
+void ClusterFinderOriginalPool::deinit()
+{
+  /// deinitialize the cluster finders
+  for (auto& finder : mFinders) {
+    finder->deinit();
+  }
+}
+
+//_________________________________________________________________________________________________
+void ClusterFinderOriginalPool::setNThreads(int n)
+{
+#ifdef WITH_OPENMP
+  mNThreads = n > 0 ? n : 1;
+#else
+  if (n > 1) {
+    LOG(warning) << "Multithreading is not supported, imposing single thread";
+  }
+  mNThreads = 1;
+#endif
+}
+
+//_________________________________________________________________________________________________
+void ClusterFinderOriginalPool::findClusters(gsl::span<const PreCluster> preClusters, gsl::span<const Digit> digits)
+{
+  /// reconstruct the clusters of all the preclusters of one ROF
+  /// the clusters and associated digits replace those of the previous call
+
+  for (auto& finder : mFinders) {
+    finder->reset();
+  }
+  int nPreClusters = preClusters.size();
+  mPreClusterOutputs.resize(nPreClusters);
+
+  // clusterize every precluster with the cluster finder of the current thread
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+  for (int iPreCluster = 0; iPreCluster < nPreClusters; ++iPreCluster) {
+#ifdef WITH_OPENMP
+    int thread = omp_get_thread_num();
+#else
+    int thread = 0;
+#endif
+    auto& finder = *mFinders[thread];
+    auto& output = mPreClusterOutputs[iPreCluster];
+    output.thread = thread;
+    output.firstCluster = finder.getClusters().size();
+    output.firstDigit = finder.getUsedDigits().size();
+    finder.setSeed(mNPreClusters + iPreCluster + 1);
+    const auto& preCluster = preClusters[iPreCluster];
+    finder.findClusters(digits.subspan(preCluster.firstDigit, preCluster.nDigits));
+    output.nClusters = finder.getClusters().size() - output.firstCluster;
+    output.nDigits = finder.getUsedDigits().size() - output.firstDigit;
+  }
+  mNPreClusters += nPreClusters;
+
+  // collect the results in the order of the preclusters
+  // make the clusters point to the digits in the merged list and reindex them within the ROF
+  mClusters.clear();
+  mUsedDigits.clear();
+  mFirstClusterIdx.resize(nPreClusters + 1);
+  for (int iPreCluster = 0; iPreCluster < nPreClusters; ++iPreCluster) {
+    const auto& output = mPreClusterOutputs[iPreCluster];
+    const auto& finder = *mFinders[output.thread];
+    mFirstClusterIdx[iPreCluster] = mClusters.size();
+    int digitOffset = static_cast<int>(mUsedDigits.size()) - output.firstDigit;
+    auto itDigit = finder.getUsedDigits().begin() + output.firstDigit;
+    mUsedDigits.insert(mUsedDigits.end(), itDigit, itDigit + output.nDigits);
+    for (int iCluster = output.firstCluster; iCluster < output.firstCluster + output.nClusters; ++iCluster) {
+      auto& cluster = mClusters.emplace_back(finder.getClusters()[iCluster]);
+      cluster.uid = Cluster::buildUniqueId(cluster.getChamberId(), cluster.getDEId(), mClusters.size() - 1);
+      cluster.firstDigit += digitOffset;
+    }
+  }
+  mFirstClusterIdx[nPreClusters] = mClusters.size();
+
+  for (auto& finder : mFinders) {
+    mErrorMap.add(finder->getErrorMap());
+    finder->getErrorMap().clear();
+  }
+}
+
+} // namespace o2::mch
@@ -86,7 +86,7 @@ void initMathieson(int useSpline_, int useCache_)
     K4y[i] = K1y[i] / K2y[i] / sqrtK3y[i];
     invPitch[i] = 1.0 / pitch[i];
   }
-  if (useSpline) {
+  if (useSpline && splineXY == nullptr) {
     initSplineMathiesonPrimitive();
   }
 }
@@ -118,20 +118,20 @@ void initSplineMathiesonPrimitive()
   // X and Y primitives on chambers <= 2 (Mathieson Type = 0)
   int mathiesonType = 0;
   int axe = 0;
-  mathiesonPrimitive(xy, N, axe, 2, mathPrimitive);
+  analyticMathiesonPrimitive(xy, N, axe, 2, mathPrimitive);
   leftDerivative = 2.0 * K4x[mathiesonType] * sqrtK3x[mathiesonType] * K2x[mathiesonType] * invPitch[mathiesonType];
   computeSplineCoef(xy, xyStep, mathPrimitive, N, leftDerivative, rightDerivative, o2::mch::splineCoef[mathiesonType][axe]);
   axe = 1;
-  mathiesonPrimitive(xy, N, axe, 2, mathPrimitive);
+  analyticMathiesonPrimitive(xy, N, axe, 2, mathPrimitive);
   leftDerivative = 2.0 * K4y[mathiesonType] * sqrtK3y[mathiesonType] * K2y[mathiesonType] * invPitch[mathiesonType];
   computeSplineCoef(xy, xyStep, mathPrimitive, N, leftDerivative, rightDerivative, splineCoef[mathiesonType][axe]);
   mathiesonType = 1;
   axe = 0;
-  mathiesonPrimitive(xy, N, axe, 3, mathPrimitive);
+  analyticMathiesonPrimitive(xy, N, axe, 3, mathPrimitive);
   leftDerivative = 2.0 * K4x[mathiesonType] * sqrtK3x[mathiesonType] * K2x[mathiesonType] * invPitch[mathiesonType];
   computeSplineCoef(xy, xyStep, mathPrimitive, N, leftDerivative, rightDerivative, splineCoef[mathiesonType][axe]);
   axe = 1;
-  mathiesonPrimitive(xy, N, axe, 3, mathPrimitive);
+  analyticMathiesonPrimitive(xy, N, axe, 3, mathPrimitive);
   leftDerivative = 2.0 * K4y[mathiesonType] * sqrtK3y[mathiesonType] * K2y[mathiesonType] * invPitch[mathiesonType];
   computeSplineCoef(xy, xyStep, mathPrimitive, N, leftDerivative, rightDerivative, splineCoef[mathiesonType][axe]);
 }
@@ -242,8 +242,21 @@ void splineMathiesonPrimitive(const double* x, int N, int axe, int chamberId, do
 }
 
 // Return the Mathieson primitive at x or y
+// interpolated in the tabulated spline if enabled (useSpline)
 void mathiesonPrimitive(const double* xy, int N,
                         int axe, int chamberId, double mPrimitive[])
+{
+  mathiesonType = (chamberId <= 2) ? 0 : 1;
+  if (useSpline) {
+    splineMathiesonPrimitive(xy, N, axe, chamberId, mPrimitive);
+  } else {
+    analyticMathiesonPrimitive(xy, N, axe, chamberId, mPrimitive);
+  }
+}
+
+// Return the Mathieson primitive at x or y computed with tanh/atan
+void analyticMathiesonPrimitive(const double* xy, int N,
+                                int axe, int chamberId, double mPrimitive[])
 {
   mathiesonType = (chamberId <= 2) ? 0 : 1;
   //
@@ -300,6 +313,14 @@ void compute1DPadIntegrals(const double* xyInf, const double* xySup, int N,
   //
   mathiesonType = (chamberId <= 2) ? 0 : 1;
 
+  if (useSpline) {
+    double lBoundPrim[N], uBoundPrim[N];
+    splineMathiesonPrimitive(xyInf, N, axe, chamberId, lBoundPrim);
+    splineMathiesonPrimitive(xySup, N, axe, chamberId, uBoundPrim);
+    vectorAddVector(uBoundPrim, -1.0, lBoundPrim, N, Integrals);
+    return;
+  }
+
   //
   // Select Mathieson coef.
   double curInvPitch = invPitch[mathiesonType];
@@ -57,6 +57,8 @@ typedef struct {
 void initMathieson(int useSpline_, int useCache_);
 void mathiesonPrimitive(const double* xy, int N,
                         int axe, int chamberId, double mPrimitive[]);
+void analyticMathiesonPrimitive(const double* xy, int N,
+                                int axe, int chamberId, double mPrimitive[]);
 void initSplineMathiesonPrimitive();
 void computeSplineCoef(const double* xy, double xyStep, const double* f, int N,
                        double leftDerivative, double rightDerivative, SplineCoef* splineCoef);
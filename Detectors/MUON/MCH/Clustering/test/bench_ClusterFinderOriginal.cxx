@@ -0,0 +1,94 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file   MCH/Clustering/test/bench_ClusterFinderOriginal.cxx
+/// \brief  Benchmark of the original MLEM cluster finder run on several threads
+
+#include "benchmark/benchmark.h"
+#include <cmath>
+#include <random>
+#include <vector>
+#include <gsl/span>
+#include "DataFormatsMCH/Digit.h"
+#include "MCHBase/PreCluster.h"
+#include "MCHMappingInterface/Segmentation.h"
+#include "MCHClustering/ClusterFinderOriginalPool.h"
+
+/// generate nPreClusters preclusters, each made of the pads around a random position on one of the given DEs
+void generateTestData(const std::vector<int>& deIds, int nPreClusters, std::vector<o2::mch::PreCluster>& preClusters,
+                      std::vector<o2::mch::Digit>& digits)
+{
+  std::mt19937 mt(12345);
+  std::uniform_int_distribution<size_t> distDE(0, deIds.size() - 1);
+  std::uniform_real_distribution<double> distShift(-0.5, 0.5);
+
+  preClusters.clear();
+  digits.clear();
+  while (preClusters.size() < static_cast<size_t>(nPreClusters)) {
+    int deId = deIds[distDE(mt)];
+    const auto& segmentation = o2::mch::mapping::segmentation(deId);
+    std::uniform_int_distribution<int> distPad(0, segmentation.nofPads() - 1);
+    int padId = distPad(mt);
+    double x = segmentation.padPositionX(padId) + distShift(mt) * segmentation.padSizeX(padId);
+    double y = segmentation.padPositionY(padId) + distShift(mt) * segmentation.padSizeY(padId);
+    uint32_t firstDigit = digits.size();
+    segmentation.forEachPadInArea(x - 2., y - 2., x + 2., y + 2., [&](int iPad) {
+      double dx = (segmentation.padPositionX(iPad) - x) / segmentation.padSizeX(iPad);
+      double dy = (segmentation.padPositionY(iPad) - y) / segmentation.padSizeY(iPad);
+      auto adc = static_cast<uint32_t>(2000. * std::exp(-dx * dx - dy * dy));
+      if (adc > 20) {
+        digits.emplace_back(deId, iPad, adc, 0);
+      }
+    });
+    if (digits.size() - firstDigit > 1) {
+      preClusters.push_back({firstDigit, static_cast<uint32_t>(digits.size() - firstDigit)});
+    } else {
+      digits.resize(firstDigit);
+    }
+  }
+}
+
+static void BM_ClusterFinderOriginal(benchmark::State& state)
+{
+  int nThreads = state.range(0);
+  int nPreClusters = state.range(1);
+  double num{0};
+
+  std::vector<o2::mch::PreCluster> preClusters;
+  std::vector<o2::mch::Digit> digits;
+  generateTestData({100, 300, 500, 819, 1025}, nPreClusters, preClusters, digits);
+
+  o2::mch::ClusterFinderOriginalPool clusterFinder;
+  clusterFinder.init(false, nThreads);
+
+  for (auto _ : state) {
+    clusterFinder.findClusters(preClusters, digits);
+    benchmark::DoNotOptimize(clusterFinder.getClusters().data());
+    ++num;
+  }
+
+  clusterFinder.deinit();
+  state.counters["num"] = benchmark::Counter(num, benchmark::Counter::kIsRate);
+  state.counters["preclusters"] = benchmark::Counter(num * preClusters.size(), benchmark::Counter::kIsRate);
+}
+
+static void CustomArguments(benchmark::internal::Benchmark* bench)
+{
+  for (int nThreads : {1, 2, 4, 8}) {
+    for (int nPreClusters : {100, 1000}) {
+      bench->Args({nThreads, nPreClusters});
+    }
+  }
+}
+
+BENCHMARK(BM_ClusterFinderOriginal)->Apply(CustomArguments)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK_MAIN();
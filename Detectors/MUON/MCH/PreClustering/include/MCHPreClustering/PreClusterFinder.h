@@ -55,6 +55,10 @@ class PreClusterFinder
 
   int run();
 
+  /// set the number of threads used to preclusterize the DEs in parallel
+  void setNThreads(int n);
+  int getNThreads() const { return mNThreads; }
+
   void getPreClusters(std::vector<o2::mch::PreCluster>& preClusters, std::vector<Digit>& digits);
 
   /// return the counting of encountered errors
@@ -73,10 +77,10 @@ class PreClusterFinder
 
   void reset(int deIndex);
 
-  void preClusterizeRecursive();
+  void preClusterizeRecursive(int iDE);
   void addPad(DetectionElement& de, uint16_t iPad, PreCluster& cluster);
 
-  int mergePreClusters();
+  int mergePreClusters(int iDE);
   void mergePreClusters(PreCluster& cluster, std::vector<std::unique_ptr<PreCluster>> preClusters[2],
                         int nPreClusters[2], DetectionElement& de, int iPlane, PreCluster*& mergedCluster);
   PreCluster* usePreClusters(PreCluster* cluster, DetectionElement& de);
@@ -90,6 +94,9 @@ class PreClusterFinder
 
   std::vector<std::unique_ptr<DetectionElement>> mDEs; ///< internal mapping
   std::unordered_map<int, int> mDEIndices{};           ///< maps DE indices from DE IDs
+  std::vector<int> mFiredDEs{};                        ///< indices of the DEs which received digits since the last reset
+
+  int mNThreads = 1; ///< number of threads used to preclusterize the DEs
 
   int mNPreClusters[SNDEs][2]{};                                     ///< number of preclusters in each cathods of each DE
   std::vector<std::unique_ptr<PreCluster>> mPreClusters[SNDEs][2]{}; ///< preclusters in each cathods of each DE
@@ -11,11 +11,16 @@
 
 #include "MCHPreClustering/PreClusterFinder.h"
 
+#include <algorithm>
 #include <chrono>
 #include <memory>
 #include <stdexcept>
 #include <vector>
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 #include <fairmq/Tools.h>
 #include <fairlogger/Logger.h>
 
@@ -32,6 +37,7 @@ struct PreClusterFinder::DetectionElement {
   std::vector<uint16_t> firedPads[2];     // indices of fired pads on each plane
   uint16_t nOrderedPads[2];               // current number of fired pads in the following arrays
   std::vector<uint16_t> orderedPads[2];   // indices of fired pads ordered after preclustering and merging
+  bool inFiredDEs = false;                // true if registered in the list of DEs to process
 };
 
 using namespace std;
@@ -74,10 +80,12 @@ void PreClusterFinder::deinit()
 //_________________________________________________________________________________________________
 void PreClusterFinder::reset()
 {
-  /// reset fired pad and precluster information
-  for (int iDE = 0; iDE < SNDEs; ++iDE) {
+  /// reset fired pad and precluster information, only the DEs which received digits need it
+  for (auto iDE : mFiredDEs) {
     reset(iDE);
+    mDEs[iDE]->inFiredDEs = false;
   }
+  mFiredDEs.clear();
 }
 
 //_________________________________________________________________________________________________
@@ -128,6 +136,10 @@ void PreClusterFinder::loadDigit(const Digit& digit)
   int deIndex = mDEIndices.at(digit.getDetID());
 
   DetectionElement& de(*(mDEs[deIndex]));
+  if (!de.inFiredDEs) {
+    de.inFiredDEs = true;
+    mFiredDEs.push_back(deIndex);
+  }
 
   if (digit.getPadID() < 0 || digit.getPadID() >= de.mapping->nPads[0] + de.mapping->nPads[1]) {
     throw out_of_range("invalid pad index");
@@ -177,7 +189,7 @@ int PreClusterFinder::discardHighOccupancy(bool perDE, bool perEvent)
   int nDigits(0);
   int nRemovedDigits(0);
   int nHighOccupancyDE(0);
-  for (int iDE = 0; iDE < SNDEs; ++iDE) {
+  for (auto iDE : mFiredDEs) {
     DetectionElement& de(*(mDEs[iDE]));
     nDigits += de.nFiredPads[0] + de.nFiredPads[1];
     if (de.mapping->uid >= 500 &&
@@ -204,8 +216,35 @@ int PreClusterFinder::discardHighOccupancy(bool perDE, bool perEvent)
 int PreClusterFinder::run()
 {
   /// preclusterize each cathod separately then merge them
-  preClusterizeRecursive();
-  return mergePreClusters();
+  /// the DEs are independent and processed in parallel, the output keeps the order of the DE indices
+
+  std::sort(mFiredDEs.begin(), mFiredDEs.end());
+
+  int nPreClusters(0);
+  const int nFiredDEs = mFiredDEs.size();
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) reduction(+ : nPreClusters) num_threads(mNThreads)
+#endif
+  for (int i = 0; i < nFiredDEs; ++i) {
+    preClusterizeRecursive(mFiredDEs[i]);
+    nPreClusters += mergePreClusters(mFiredDEs[i]);
+  }
+
+  return nPreClusters;
+}
+
+//_________________________________________________________________________________________________
+void PreClusterFinder::setNThreads(int n)
+{
+  /// set the number of threads used to preclusterize the DEs in parallel
+#ifdef WITH_OPENMP
+  mNThreads = n > 0 ? n : 1;
+#else
+  mNThreads = 1;
+  if (n > 1) {
+    LOG(warning) << "OpenMP is not available, the preclustering runs in 1 thread";
+  }
+#endif
 }
 
 //_________________________________________________________________________________________________
@@ -215,7 +254,7 @@ void PreClusterFinder::getPreClusters(std::vector<o2::mch::PreCluster>& preClust
   /// the existing preclusters and digits are not touched, so the corresponding indices are preserved
   /// however, iterators, pointers and references might be invalidated in case the vectors are resized
 
-  for (int iDE = 0, nDEs = SNDEs; iDE < nDEs; ++iDE) {
+  for (auto iDE : mFiredDEs) {
 
     DetectionElement& de(*(mDEs[iDE]));
     if (de.nOrderedPads[1] == 0) {
@@ -245,49 +284,45 @@ void PreClusterFinder::getPreClusters(std::vector<o2::mch::PreCluster>& preClust
 }
 
 //_________________________________________________________________________________________________
-void PreClusterFinder::preClusterizeRecursive()
+void PreClusterFinder::preClusterizeRecursive(int iDE)
 {
-  /// preclusterize both planes of every DE using recursive algorithm
+  /// preclusterize both planes of this DE using recursive algorithm
 
   PreCluster* cluster(nullptr);
   uint16_t iPad(0);
 
-  // loop over DEs
-  for (int iDE = 0; iDE < SNDEs; ++iDE) {
-
-    DetectionElement& de(*(mDEs[iDE]));
-
-    // loop over planes
-    for (int iPlane = 0; iPlane < 2; ++iPlane) {
-
-      // loop over fired pads
-      for (int iFiredPad = 0; iFiredPad < de.nFiredPads[iPlane]; ++iFiredPad) {
-
-        iPad = de.firedPads[iPlane][iFiredPad];
+  DetectionElement& de(*(mDEs[iDE]));
 
-        if (de.mapping->pads[iPad].useMe) {
+  // loop over planes
+  for (int iPlane = 0; iPlane < 2; ++iPlane) {
 
-          // create the precluster if needed
-          if (mNPreClusters[iDE][iPlane] >= mPreClusters[iDE][iPlane].size()) {
-            mPreClusters[iDE][iPlane].push_back(std::make_unique<PreCluster>());
-          }
+    // loop over fired pads
+    for (int iFiredPad = 0; iFiredPad < de.nFiredPads[iPlane]; ++iFiredPad) {
 
-          // get the precluster
-          cluster = mPreClusters[iDE][iPlane][mNPreClusters[iDE][iPlane]].get();
-          ++mNPreClusters[iDE][iPlane];
+      iPad = de.firedPads[iPlane][iFiredPad];
 
-          // reset its content
-          cluster->area[0][0] = 1.e6;
-          cluster->area[0][1] = -1.e6;
-          cluster->area[1][0] = 1.e6;
-          cluster->area[1][1] = -1.e6;
-          cluster->useMe = true;
-          cluster->storeMe = false;
+      if (de.mapping->pads[iPad].useMe) {
 
-          // add the pad and its fired neighbours recusively
-          cluster->firstPad = de.nOrderedPads[0];
-          addPad(de, iPad, *cluster);
+        // create the precluster if needed
+        if (mNPreClusters[iDE][iPlane] >= mPreClusters[iDE][iPlane].size()) {
+          mPreClusters[iDE][iPlane].push_back(std::make_unique<PreCluster>());
         }
+
+        // get the precluster
+        cluster = mPreClusters[iDE][iPlane][mNPreClusters[iDE][iPlane]].get();
+        ++mNPreClusters[iDE][iPlane];
+
+        // reset its content
+        cluster->area[0][0] = 1.e6;
+        cluster->area[0][1] = -1.e6;
+        cluster->area[1][0] = 1.e6;
+        cluster->area[1][1] = -1.e6;
+        cluster->useMe = true;
+        cluster->storeMe = false;
+
+        // add the pad and its fired neighbours recusively
+        cluster->firstPad = de.nOrderedPads[0];
+        addPad(de, iPad, *cluster);
       }
     }
   }
@@ -336,55 +371,51 @@ void PreClusterFinder::addPad(DetectionElement& de, uint16_t iPad, PreCluster& c
 }
 
 //_________________________________________________________________________________________________
-int PreClusterFinder::mergePreClusters()
+int PreClusterFinder::mergePreClusters(int iDE)
 {
-  /// merge overlapping preclusters on every DE
-  /// return the total number of preclusters after merging
+  /// merge overlapping preclusters on this DE
+  /// return the number of preclusters after merging
 
   PreCluster* cluster(nullptr);
   int nPreClusters(0);
 
-  // loop over DEs
-  for (int iDE = 0; iDE < SNDEs; ++iDE) {
+  DetectionElement& de(*(mDEs[iDE]));
 
-    DetectionElement& de(*(mDEs[iDE]));
-
-    // loop over preclusters of one plane
-    for (int iCluster = 0; iCluster < mNPreClusters[iDE][0]; ++iCluster) {
+  // loop over preclusters of one plane
+  for (int iCluster = 0; iCluster < mNPreClusters[iDE][0]; ++iCluster) {
 
-      if (!mPreClusters[iDE][0][iCluster]->useMe) {
-        continue;
-      }
-
-      cluster = mPreClusters[iDE][0][iCluster].get();
-      cluster->useMe = false;
+    if (!mPreClusters[iDE][0][iCluster]->useMe) {
+      continue;
+    }
 
-      // look for overlapping preclusters in the other plane
-      PreCluster* mergedCluster(nullptr);
-      mergePreClusters(*cluster, mPreClusters[iDE], mNPreClusters[iDE], de, 1, mergedCluster);
+    cluster = mPreClusters[iDE][0][iCluster].get();
+    cluster->useMe = false;
 
-      // add the current one
-      if (!mergedCluster) {
-        mergedCluster = usePreClusters(cluster, de);
-      } else {
-        mergePreClusters(*mergedCluster, *cluster, de);
-      }
+    // look for overlapping preclusters in the other plane
+    PreCluster* mergedCluster(nullptr);
+    mergePreClusters(*cluster, mPreClusters[iDE], mNPreClusters[iDE], de, 1, mergedCluster);
 
-      ++nPreClusters;
+    // add the current one
+    if (!mergedCluster) {
+      mergedCluster = usePreClusters(cluster, de);
+    } else {
+      mergePreClusters(*mergedCluster, *cluster, de);
     }
 
-    // loop over preclusters of the other plane
-    for (int iCluster = 0; iCluster < mNPreClusters[iDE][1]; ++iCluster) {
-
-      if (!mPreClusters[iDE][1][iCluster]->useMe) {
-        continue;
-      }
+    ++nPreClusters;
+  }
 
-      // all remaining preclusters have to be stored
-      usePreClusters(mPreClusters[iDE][1][iCluster].get(), de);
+  // loop over preclusters of the other plane
+  for (int iCluster = 0; iCluster < mNPreClusters[iDE][1]; ++iCluster) {
 
-      ++nPreClusters;
+    if (!mPreClusters[iDE][1][iCluster]->useMe) {
+      continue;
     }
+
+    // all remaining preclusters have to be stored
+    usePreClusters(mPreClusters[iDE][1][iCluster].get(), de);
+
+    ++nPreClusters;
   }
 
   return nPreClusters;
@@ -69,6 +69,7 @@ class PreClusterFinderTask
     LOG(info) << "initializing preclusterizer";
 
     mPreClusterFinder.init();
+    mPreClusterFinder.setNThreads(ic.options().get<int>("nthreads"));
 
     auto stop = [this]() {
       LOG(info) << "reset precluster finder duration = " << mTimeResetPreClusterFinder.count() << " ms";
@@ -256,7 +257,8 @@ o2::framework::DataProcessorSpec getPreClusterFinderSpec(const char* specName,
     Options{{"check-no-leftover-digits", VariantType::String, "error", {helpstr}},
             {{"sanity-check"}, VariantType::Bool, false, {"perform some input digit sanity checks"}},
             {"discard-high-occupancy-des", VariantType::Bool, false, {"discard DEs with occupancy > 20%"}},
-            {"discard-high-occupancy-events", VariantType::Bool, false, {"discard events with >= 5 DEs above 20% occupancy"}}}};
+            {"discard-high-occupancy-events", VariantType::Bool, false, {"discard events with >= 5 DEs above 20% occupancy"}},
+            {"nthreads", VariantType::Int, 1, {"number of threads to preclusterize the DEs of an event in parallel"}}}};
 }
 
 } // end namespace mch
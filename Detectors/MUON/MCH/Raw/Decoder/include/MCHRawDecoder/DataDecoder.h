@@ -23,6 +23,8 @@
 #include <unordered_set>
 #include <unordered_map>
 #include <fstream>
+#include <map>
+#include <memory>
 
 #include "Headers/RDHAny.h"
 #include "DataFormatsMCH/Digit.h"
@@ -153,6 +155,7 @@ class DataDecoder
               bool ds2manu, bool verbose, bool useDummyElecMap,
               TimeRecoMode timeRecoMode = TimeRecoMode::HBPackets,
               uint32_t nofOrbitsPerTF = 32);
+  ~DataDecoder();
 
   void reset();
 
@@ -170,6 +173,18 @@ class DataDecoder
    */
   bool decodeBuffer(gsl::span<const std::byte> buf);
 
+  /** Decode several buffers of one TimeFrame, as if decodeBuffer() was called on each of them in turn
+   *  until one fails. With more than one thread (see setNThreads()), the pages of different links (FEE IDs)
+   *  are decoded in parallel, and the results are merged in the order of the pages, so that they are
+   *  identical to the ones of the serial decoding.
+   *  @return true if decoding went ok, or false otherwise.
+   */
+  bool decodeBuffers(gsl::span<const gsl::span<const std::byte>> buffers);
+
+  /// Set the number of threads used by decodeBuffers(). The pages are decoded serially if
+  /// a channel or RDH handler is set, or in verbose mode, as the handlers are not thread-safe.
+  void setNThreads(int nThreads);
+
   /// For a given SAMPA chip, update the information about the BC counter value at the beginning of the TimeFrame
   void updateTimeFrameStartRecord(uint64_t chipId, uint32_t mFirstOrbitInTF, uint32_t bcTF);
   /// Convert a Solar/Ds/Chip triplet into an unique chip index
@@ -201,15 +216,34 @@ class DataDecoder
   void initElec2DetMapper(std::string filename);
   void initFee2SolarMapper(std::string filename);
   void init();
-  void decodePage(gsl::span<const std::byte> page);
+
+  /// Where the decoding of the pages of a set of links writes its output:
+  /// the members of the decoder in the serial case, the buffers of a LinkWorker otherwise
+  struct DecodingState {
+    o2::mch::raw::PageDecoder decoder;                              ///< CRU page decoder
+    uint32_t orbit{0};                                              ///< orbit of the page being decoded
+    RawDigitVector* digits{nullptr};                                ///< decoded digits
+    size_t digitIdOffset{0};                                        ///< id in the merger records of the first of the digits
+    std::unordered_set<OrbitInfo, OrbitInfoHash>* orbits{nullptr}; ///< orbits of the pages, if filled while decoding
+    std::vector<o2::mch::DecoderError>* errors{nullptr};            ///< decoding errors
+    std::vector<o2::mch::HeartBeatPacket>* hbPackets{nullptr};      ///< heart-beat packets
+    std::map<std::string, uint64_t>* errorMap{nullptr};             ///< counts for error messages
+    int* errorCount{nullptr};                                       ///< number of logged errors
+    std::vector<uint32_t>* mergerChannels{nullptr};                 ///< updated merger channels, if needed
+  };
+  struct LinkWorker;
+
+  void decodePage(gsl::span<const std::byte> page, DecodingState& state);
+  bool decodeBuffersInParallel(gsl::span<const gsl::span<const std::byte>> buffers);
   void dumpDigits();
-  bool getPadMapping(const DsElecId& dsElecId, DualSampaChannelId channel, int& deId, int& dsIddet, int& padId);
-  bool addDigit(const DsElecId& dsElecId, DualSampaChannelId channel, const o2::mch::raw::SampaCluster& sc);
+  bool getPadMapping(const DsElecId& dsElecId, DualSampaChannelId channel, int& deId, int& dsIddet, int& padId, DecodingState& state);
+  bool addDigit(const DsElecId& dsElecId, DualSampaChannelId channel, const o2::mch::raw::SampaCluster& sc, DecodingState& state);
   bool getTimeFrameStartRecord(const RawDigit& digit, uint32_t& orbit, uint32_t& bc);
   bool getMergerChannelId(const DsElecId& dsElecId, DualSampaChannelId channel, uint32_t& chId, uint32_t& dsId);
   uint64_t getMergerChannelBitmask(DualSampaChannelId channel);
-  void updateMergerRecord(uint32_t mergerChannelId, uint32_t mergerBoardId, uint64_t mergerChannelBitmask, uint32_t digitId);
-  bool mergeDigits(uint32_t mergerChannelId, uint32_t mergerBoardId, uint64_t mergerChannelBitmask, o2::mch::raw::SampaCluster& sc);
+  void updateMergerRecord(uint32_t mergerChannelId, uint32_t mergerBoardId, uint64_t mergerChannelBitmask, uint32_t digitId, DecodingState& state);
+  bool mergeDigits(uint32_t mergerChannelId, uint32_t mergerBoardId, uint64_t mergerChannelBitmask, o2::mch::raw::SampaCluster& sc, DecodingState& state);
+  RawDigit& getDigit(uint32_t digitId, DecodingState& state);
 
   // structure that stores the index of the last decoded digit for a given readout channel,
   // as well as the time stamp of the last ADC sample of the digit
@@ -237,7 +271,11 @@ class DataDecoder
   std::string mMapFECfile;                 ///< optional text file with custom front-end electronics mapping
   std::string mMapCRUfile;                 ///< optional text file with custom CRU mapping
 
-  o2::mch::raw::PageDecoder mDecoder; ///< CRU page decoder
+  DecodingState mState; ///< decoding state of the serial path, writing directly to the members below
+
+  int mNThreads{1};                                   ///< number of threads used by decodeBuffers()
+  std::vector<std::unique_ptr<LinkWorker>> mWorkers;  ///< decoding states of the parallel path, one per thread
+  std::unordered_map<uint16_t, size_t> mFeeIdWorkers; ///< worker which decodes the pages of a given FEE ID
 
   RawDigitVector mDigits;                               ///< vector of decoded digits
   std::unordered_set<OrbitInfo, OrbitInfoHash> mOrbits; ///< list of orbits in the processed buffer
@@ -255,7 +293,6 @@ class DataDecoder
   bool mDebug{false};
   int mErrorCount{0};
   bool mDs2manu{false};
-  uint32_t mOrbit{0};
   bool mUseDummyElecMap{false};
   std::map<std::string, uint64_t> mErrorMap; // counts for error messages
 };
@@ -27,7 +27,9 @@
 #include "MCHMappingInterface/Segmentation.h"
 #include "MCHRawDecoder/ErrorCodes.h"
 #include <fairlogger/Logger.h>
+#include <algorithm>
 #include <fstream>
+#include <thread>
 
 #define MCH_DECODER_MAX_ERROR_COUNT 100
 
@@ -246,9 +248,17 @@ DataDecoder::DataDecoder(SampaChannelHandler channelHandler, RdhHandler rdhHandl
                          uint32_t nofOrbitsPerTF)
   : mChannelHandler(channelHandler), mRdhHandler(rdhHandler), mMapCRUfile(mapCRUfile), mMapFECfile(mapFECfile), mDs2manu(ds2manu), mDebug(verbose), mUseDummyElecMap(useDummyElecMap), mTimeRecoMode(timeRecoMode), mOrbitsInTF(nofOrbitsPerTF)
 {
+  mState.digits = &mDigits;
+  mState.orbits = &mOrbits;
+  mState.errors = &mErrors;
+  mState.hbPackets = &mHBPackets;
+  mState.errorMap = &mErrorMap;
+  mState.errorCount = &mErrorCount;
   init();
 }
 
+DataDecoder::~DataDecoder() = default;
+
 void DataDecoder::logErrorMap(int tfcount) const
 {
   for (auto err : mErrorMap) {
@@ -292,7 +302,7 @@ bool DataDecoder::decodeBuffer(gsl::span<const std::byte> buf)
 
     gsl::span<const std::byte> page(reinterpret_cast<const std::byte*>(rdh), pageSize);
     try {
-      decodePage(page);
+      decodePage(page, mState);
     } catch (const std::exception& e) {
       mErrors.emplace_back(DecoderError(0, 0, 0, ErrorNonRecoverableDecodingError));
       return false;
@@ -312,6 +322,197 @@ bool DataDecoder::decodeBuffer(gsl::span<const std::byte> buf)
 
 //_________________________________________________________________________________________________
 
+/// Decoding state and output of the pages of the links assigned to one thread
+struct DataDecoder::LinkWorker {
+  /// Where the output of one page ends in the buffers of the worker
+  struct PageOutput {
+    size_t digitsEnd{0};
+    size_t errorsEnd{0};
+    size_t hbPacketsEnd{0};
+  };
+
+  LinkWorker()
+  {
+    // the orbits are filled when merging, to skip the pages following a decoding failure
+    state.digits = &digits;
+    state.errors = &errors;
+    state.hbPackets = &hbPackets;
+    state.errorMap = &errorMap;
+    state.errorCount = &errorCount;
+    state.mergerChannels = &mergerChannels;
+  }
+  LinkWorker(const LinkWorker&) = delete;
+  LinkWorker& operator=(const LinkWorker&) = delete;
+
+  void decode(DataDecoder& decoder, const std::vector<gsl::span<const std::byte>>& allPages)
+  {
+    for (auto ip : pages) {
+      try {
+        decoder.decodePage(allPages[ip], state);
+      } catch (const std::exception& e) {
+        errors.emplace_back(DecoderError(0, 0, 0, ErrorNonRecoverableDecodingError));
+        outputs.push_back({digits.size(), errors.size(), hbPackets.size()});
+        failed = true;
+        return;
+      }
+      outputs.push_back({digits.size(), errors.size(), hbPackets.size()});
+    }
+  }
+
+  void clear()
+  {
+    digits.clear();
+    errors.clear();
+    hbPackets.clear();
+    errorMap.clear();
+    mergerChannels.clear();
+    pages.clear();
+    outputs.clear();
+    digitIds.clear();
+    failed = false;
+  }
+
+  DecodingState state;
+  RawDigitVector digits;
+  std::vector<o2::mch::DecoderError> errors;
+  std::vector<o2::mch::HeartBeatPacket> hbPackets;
+  std::map<std::string, uint64_t> errorMap;
+  int errorCount{0};
+  std::vector<uint32_t> mergerChannels; ///< merger channels updated by this worker
+  std::vector<size_t> pages;            ///< indexes of the pages to be decoded by this worker
+  std::vector<PageOutput> outputs;      ///< one for each decoded page
+  std::vector<uint32_t> digitIds;       ///< index of the digits of this worker in mDigits, once merged
+  bool failed{false};
+};
+
+//_________________________________________________________________________________________________
+
+void DataDecoder::setNThreads(int nThreads)
+{
+  mNThreads = std::max(nThreads, 1);
+  // the links are assigned again to the workers, which start from a new page decoder
+  mWorkers.clear();
+  mFeeIdWorkers.clear();
+}
+
+//_________________________________________________________________________________________________
+
+bool DataDecoder::decodeBuffers(gsl::span<const gsl::span<const std::byte>> buffers)
+{
+  if (mNThreads > 1 && !mChannelHandler && !mRdhHandler && !mDebug) {
+    return decodeBuffersInParallel(buffers);
+  }
+  for (auto buffer : buffers) {
+    if (!decodeBuffer(buffer)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+//_________________________________________________________________________________________________
+
+bool DataDecoder::decodeBuffersInParallel(gsl::span<const gsl::span<const std::byte>> buffers)
+{
+  // split the buffers into pages, as done by decodeBuffer()
+  std::vector<gsl::span<const std::byte>> pages;
+  for (auto buf : buffers) {
+    size_t pageStart = 0;
+    while (buf.size() > pageStart) {
+      RDH* rdh = reinterpret_cast<RDH*>(const_cast<std::byte*>(&(buf[pageStart])));
+      if (o2::raw::RDHUtils::getHeaderSize(rdh) != 64) {
+        break;
+      }
+      auto pageSize = o2::raw::RDHUtils::getOffsetToNext(rdh);
+      pages.emplace_back(reinterpret_cast<const std::byte*>(rdh), pageSize);
+      pageStart += pageSize;
+    }
+  }
+
+  // the pages of a given FEE ID are always decoded by the same worker, as the
+  // page decoders and the digit merging keep track of the previous pages of each link
+  while (mWorkers.size() < static_cast<size_t>(mNThreads)) {
+    mWorkers.emplace_back(std::make_unique<LinkWorker>());
+  }
+  std::vector<size_t> pageWorkers(pages.size());
+  for (size_t ip = 0; ip < pages.size(); ip++) {
+    patchPage(pages[ip], mDebug);
+    auto feeId = o2::raw::RDHUtils::getFEEID(*reinterpret_cast<const RDH*>(pages[ip].data()));
+    auto worker = mFeeIdWorkers.emplace(feeId, mFeeIdWorkers.size() % mWorkers.size()).first->second;
+    pageWorkers[ip] = worker;
+    mWorkers[worker]->pages.push_back(ip);
+  }
+
+  // the merger records of the digits decoded by the workers refer to them as if they were
+  // appended to mDigits, their actual index is only known after merging
+  const int errorCount = mErrorCount;
+  for (auto& worker : mWorkers) {
+    worker->state.digitIdOffset = mDigits.size();
+    worker->errorCount = errorCount;
+  }
+
+  std::vector<std::thread> threads;
+  for (size_t iw = 1; iw < mWorkers.size(); iw++) {
+    if (!mWorkers[iw]->pages.empty()) {
+      threads.emplace_back([this, &worker = *mWorkers[iw], &pages]() { worker.decode(*this, pages); });
+    }
+  }
+  mWorkers[0]->decode(*this, pages);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // merge the outputs in the order of the pages, stopping after the first page which failed
+  bool ok = true;
+  std::vector<size_t> nextPageOutput(mWorkers.size(), 0);
+  for (size_t ip = 0; ip < pages.size() && ok; ip++) {
+    auto& worker = *mWorkers[pageWorkers[ip]];
+    auto& iout = nextPageOutput[pageWorkers[ip]];
+    LinkWorker::PageOutput begin = iout > 0 ? worker.outputs[iout - 1] : LinkWorker::PageOutput{};
+    const auto& end = worker.outputs[iout];
+    iout += 1;
+
+    mOrbits.emplace(pages[ip]);
+    for (size_t id = begin.digitsEnd; id < end.digitsEnd; id++) {
+      worker.digitIds.push_back(mDigits.size());
+      mDigits.emplace_back(worker.digits[id]);
+    }
+    mErrors.insert(mErrors.end(), worker.errors.begin() + begin.errorsEnd, worker.errors.begin() + end.errorsEnd);
+    mHBPackets.insert(mHBPackets.end(), worker.hbPackets.begin() + begin.hbPacketsEnd, worker.hbPackets.begin() + end.hbPacketsEnd);
+
+    if (worker.failed && iout == worker.outputs.size()) {
+      ok = false;
+    }
+  }
+
+  for (auto& worker : mWorkers) {
+    std::sort(worker->mergerChannels.begin(), worker->mergerChannels.end());
+    worker->mergerChannels.erase(std::unique(worker->mergerChannels.begin(), worker->mergerChannels.end()), worker->mergerChannels.end());
+    for (auto mergerChannelId : worker->mergerChannels) {
+      auto& mergerCh = mMergerRecords[mergerChannelId];
+      if (mergerCh.digitId < worker->state.digitIdOffset) {
+        continue;
+      }
+      size_t localId = mergerCh.digitId - worker->state.digitIdOffset;
+      if (localId < worker->digitIds.size()) {
+        mergerCh.digitId = worker->digitIds[localId];
+      } else {
+        // the digit was dropped together with the pages following a decoding failure
+        mMergerRecordsReady[mergerChannelId / 64] &= ~getMergerChannelBitmask(mergerChannelId % 64);
+      }
+    }
+    for (const auto& [msg, count] : worker->errorMap) {
+      mErrorMap[msg] += count;
+    }
+    mErrorCount += worker->errorCount - errorCount;
+    worker->clear();
+  }
+
+  return ok;
+}
+
+//_________________________________________________________________________________________________
+
 void DataDecoder::dumpDigits()
 {
   for (size_t di = 0; di < mDigits.size(); di++) {
@@ -380,7 +581,18 @@ uint64_t DataDecoder::getMergerChannelBitmask(DualSampaChannelId channel)
 
 //_________________________________________________________________________________________________
 
-bool DataDecoder::mergeDigits(uint32_t mergerChannelId, uint32_t mergerBoardId, uint64_t mergerChannelBitmask, o2::mch::raw::SampaCluster& sc)
+DataDecoder::RawDigit& DataDecoder::getDigit(uint32_t digitId, DecodingState& state)
+{
+  // the digits decoded before the current call to decodeBuffers() are already in mDigits
+  if (digitId < state.digitIdOffset) {
+    return mDigits[digitId];
+  }
+  return (*state.digits)[digitId - state.digitIdOffset];
+}
+
+//_________________________________________________________________________________________________
+
+bool DataDecoder::mergeDigits(uint32_t mergerChannelId, uint32_t mergerBoardId, uint64_t mergerChannelBitmask, o2::mch::raw::SampaCluster& sc, DecodingState& state)
 {
   uint32_t BCROLLOVER = (mTimeRecoMode == TimeRecoMode::BCReset) ? (mBcInOrbit * mOrbitsInTF) : (1 << 20);
   static constexpr uint32_t ONEADCCLOCK = 4;
@@ -413,7 +625,7 @@ bool DataDecoder::mergeDigits(uint32_t mergerChannelId, uint32_t mergerBoardId,
   }
 
   // add total charge and number of samples to existing digit
-  auto& digit = mDigits[mergerCh.digitId].digit;
+  auto& digit = getDigit(mergerCh.digitId, state).digit;
 
   digit.setADC(digit.getADC() + sc.sum());
   uint32_t newNofSamples = digit.getNofSamples() + sc.nofSamples();
@@ -430,13 +642,16 @@ bool DataDecoder::mergeDigits(uint32_t mergerChannelId, uint32_t mergerBoardId,
 
 //_________________________________________________________________________________________________
 
-void DataDecoder::updateMergerRecord(uint32_t mergerChannelId, uint32_t mergerBoardId, uint64_t mergerChannelBitmask, uint32_t digitId)
+void DataDecoder::updateMergerRecord(uint32_t mergerChannelId, uint32_t mergerBoardId, uint64_t mergerChannelBitmask, uint32_t digitId, DecodingState& state)
 {
   auto& mergerCh = mMergerRecords[mergerChannelId];
-  auto& digit = mDigits[digitId];
+  auto& digit = getDigit(digitId, state);
   mergerCh.digitId = digitId;
   mergerCh.bcEnd = digit.info.bunchCrossing + (digit.info.sampaTime + digit.digit.getNofSamples() - 1) * 4;
   mMergerRecordsReady[mergerBoardId] |= mergerChannelBitmask;
+  if (state.mergerChannels) {
+    state.mergerChannels->push_back(mergerChannelId);
+  }
   if (mDebug) {
     std::cout << fmt::format("[updateMergerRecord] updated S{}-DS{}-CHIP{}  time {}-{}-{}  cs {}",
                              (int)digit.info.solar, (int)digit.info.ds, (int)digit.info.chip,
@@ -447,7 +662,7 @@ void DataDecoder::updateMergerRecord(uint32_t mergerChannelId, uint32_t mergerBo
 
 //_________________________________________________________________________________________________
 
-bool DataDecoder::getPadMapping(const DsElecId& dsElecId, DualSampaChannelId channel, int& deId, int& dsIddet, int& padId)
+bool DataDecoder::getPadMapping(const DsElecId& dsElecId, DualSampaChannelId channel, int& deId, int& dsIddet, int& padId, DecodingState& state)
 {
   deId = -1;
   dsIddet = -1;
@@ -467,7 +682,7 @@ bool DataDecoder::getPadMapping(const DsElecId& dsElecId, DualSampaChannelId cha
 
   if (deId < 0 || dsIddet < 0 || !isValidDeID(deId)) {
     auto msg = fmt::format("got invalid DsDetId from dsElecId={}", asString(dsElecId));
-    mErrorMap[msg]++;
+    (*state.errorMap)[msg]++;
     return false;
   }
 
@@ -482,10 +697,10 @@ bool DataDecoder::getPadMapping(const DsElecId& dsElecId, DualSampaChannelId cha
 
 //_________________________________________________________________________________________________
 
-bool DataDecoder::addDigit(const DsElecId& dsElecId, DualSampaChannelId channel, const o2::mch::raw::SampaCluster& sc)
+bool DataDecoder::addDigit(const DsElecId& dsElecId, DualSampaChannelId channel, const o2::mch::raw::SampaCluster& sc, DecodingState& state)
 {
   int deId, dsIddet, padId;
-  if (!getPadMapping(dsElecId, channel, deId, dsIddet, padId)) {
+  if (!getPadMapping(dsElecId, channel, deId, dsIddet, padId, state)) {
     return false;
   }
 
@@ -496,7 +711,7 @@ bool DataDecoder::addDigit(const DsElecId& dsElecId, DualSampaChannelId channel,
     auto ch = fmt::format("{}-CH{:02d}", s, channel);
     LOG(info) << ch << "  "
               << fmt::format("PAD ({:04d} {:04d} {:04d})\tADC {:06d}  TIME ({} {} {:02d})  SIZE {}  END {}",
-                             deId, dsIddet, padId, digitadc, mOrbit, sc.bunchCrossing, sc.sampaTime, sc.nofSamples(), (sc.sampaTime + sc.nofSamples() - 1))
+                             deId, dsIddet, padId, digitadc, state.orbit, sc.bunchCrossing, sc.sampaTime, sc.nofSamples(), (sc.sampaTime + sc.nofSamples() - 1))
               << (((sc.sampaTime + sc.nofSamples() - 1) >= 98) ? " *" : "");
   }
 
@@ -513,14 +728,14 @@ bool DataDecoder::addDigit(const DsElecId& dsElecId, DualSampaChannelId channel,
   digit.info.solar = dsElecId.solarId();
   digit.info.sampaTime = sc.sampaTime;
   digit.info.bunchCrossing = sc.bunchCrossing;
-  digit.info.orbit = mOrbit;
+  digit.info.orbit = state.orbit;
 
-  mDigits.emplace_back(digit);
+  state.digits->emplace_back(digit);
 
   if (mDebug) {
-    RawDigit& lastDigit = mDigits.back();
+    RawDigit& lastDigit = state.digits->back();
     LOGP(info, "DIGIT STORED: ORBIT {} ADC {} DE {} PADID {} TIME {} BXCOUNT {}",
-         mOrbit, lastDigit.getADC(), lastDigit.getDetID(), lastDigit.getPadID(),
+         state.orbit, lastDigit.getADC(), lastDigit.getDetID(), lastDigit.getPadID(),
          lastDigit.getSampaTime(), lastDigit.getBunchCrossing());
   }
   return true;
@@ -542,14 +757,10 @@ void DataDecoder::updateTimeFrameStartRecord(uint64_t chipId, uint32_t mFirstOrb
 
 //_________________________________________________________________________________________________
 
-void DataDecoder::decodePage(gsl::span<const std::byte> page)
+void DataDecoder::decodePage(gsl::span<const std::byte> page, DecodingState& state)
 {
-  uint8_t isStopRDH = 0;
-  uint32_t orbit;
-  uint32_t feeId;
-  uint32_t linkId;
-
-  auto heartBeatHandler = [&](DsElecId dsElecId, uint8_t chip, uint32_t bunchCrossing) {
+  // the handlers are kept by the page decoder of the state, they must not refer to the local variables
+  auto heartBeatHandler = [this, &state = state](DsElecId dsElecId, uint8_t chip, uint32_t bunchCrossing) {
     auto ds = dsElecId.elinkId();
     auto solar = dsElecId.solarId();
     uint64_t chipId = getChipId(solar, ds, chip);
@@ -564,20 +775,20 @@ void DataDecoder::decodePage(gsl::span<const std::byte> page)
       return;
     }
 
-    mHBPackets.emplace_back(solar, ds, chip, bunchCrossing);
+    state.hbPackets->emplace_back(solar, ds, chip, bunchCrossing);
 
     if (mTimeRecoMode == TimeRecoMode::HBPackets) {
       bool isOk = mTimeFrameStartRecords[chipId].update(mFirstOrbitInTF, bunchCrossing);
-      if (!isOk && mErrorCount < MCH_DECODER_MAX_ERROR_COUNT) {
+      if (!isOk && *state.errorCount < MCH_DECODER_MAX_ERROR_COUNT) {
         auto s = asString(dsElecId);
         LOGP(warning, "Bad HeartBeat packet received: {}-CHIP{} {}/{} (last {}/{})",
              s, chip, mFirstOrbitInTF, bunchCrossing, mTimeFrameStartRecords[chipId].mOrbitPrev, mTimeFrameStartRecords[chipId].mBunchCrossingPrev);
-        mErrorCount += 1;
+        *state.errorCount += 1;
       }
     }
   };
 
-  auto channelHandler = [&](DsElecId dsElecId, DualSampaChannelId channel,
+  auto channelHandler = [this, &state = state](DsElecId dsElecId, DualSampaChannelId channel,
                             o2::mch::raw::SampaCluster sc) {
     if (mChannelHandler) {
       mChannelHandler(dsElecId, channel, sc);
@@ -596,34 +807,34 @@ void DataDecoder::decodePage(gsl::span<const std::byte> page)
     }
     uint64_t mergerChannelBitmask = getMergerChannelBitmask(channel);
 
-    if (mergeDigits(mergerChannelId, mergerBoardId, mergerChannelBitmask, sc)) {
+    if (mergeDigits(mergerChannelId, mergerBoardId, mergerChannelBitmask, sc, state)) {
       return;
     }
 
-    if (!addDigit(dsElecId, channel, sc)) {
+    if (!addDigit(dsElecId, channel, sc, state)) {
       return;
     }
 
-    updateMergerRecord(mergerChannelId, mergerBoardId, mergerChannelBitmask, mDigits.size() - 1);
+    updateMergerRecord(mergerChannelId, mergerBoardId, mergerChannelBitmask, state.digitIdOffset + state.digits->size() - 1, state);
   };
 
-  auto errorHandler = [&](DsElecId dsElecId,
+  auto errorHandler = [this, &state = state](DsElecId dsElecId,
                           int8_t chip,
                           uint32_t error) {
     std::string msg = fmt::format("{} chip {:2d} error {:4d} ({})", asString(dsElecId), chip, error, errorCodeAsString(error));
-    mErrorMap[msg]++;
+    (*state.errorMap)[msg]++;
 
     auto solarId = dsElecId.solarId();
     auto dsId = dsElecId.elinkId();
-    mErrors.emplace_back(o2::mch::DecoderError(solarId, dsId, chip, error));
+    state.errors->emplace_back(o2::mch::DecoderError(solarId, dsId, chip, error));
   };
 
   patchPage(page, mDebug);
 
   auto& rdhAny = *reinterpret_cast<RDH*>(const_cast<std::byte*>(&(page[0])));
-  mOrbit = o2::raw::RDHUtils::getHeartBeatOrbit(rdhAny);
+  state.orbit = o2::raw::RDHUtils::getHeartBeatOrbit(rdhAny);
   if (mDebug) {
-    LOGP(info, "[decodeBuffer] mOrbit set to {}", mOrbit);
+    LOGP(info, "[decodeBuffer] mOrbit set to {}", state.orbit);
   }
 
   if (mRdhHandler) {
@@ -631,18 +842,20 @@ void DataDecoder::decodePage(gsl::span<const std::byte> page)
   }
 
   // add orbit to vector if not present yet
-  mOrbits.emplace(page);
+  if (state.orbits) {
+    state.orbits->emplace(page);
+  }
 
-  if (!mDecoder) {
+  if (!state.decoder) {
     DecodedDataHandlers handlers;
     handlers.sampaChannelHandler = channelHandler;
     handlers.sampaHeartBeatHandler = heartBeatHandler;
     handlers.sampaErrorHandler = errorHandler;
-    mDecoder = mFee2Solar ? o2::mch::raw::createPageDecoder(page, handlers, mFee2Solar)
-                          : o2::mch::raw::createPageDecoder(page, handlers);
+    state.decoder = mFee2Solar ? o2::mch::raw::createPageDecoder(page, handlers, mFee2Solar)
+                               : o2::mch::raw::createPageDecoder(page, handlers);
   }
 
-  mDecoder(page);
+  state.decoder(page);
 };
 
 //_________________________________________________________________________________________________
@@ -0,0 +1,108 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file   bench_DataDecoder.cxx
+/// \brief  Benchmark of the serial and parallel decoding of MCH raw data
+
+#include "benchmark/benchmark.h"
+#include "DataFormatsMCH/Digit.h"
+#include "Framework/Logger.h"
+#include "MCHConstants/DetectionElements.h"
+#include "MCHMappingInterface/Segmentation.h"
+#include "MCHRawDecoder/DataDecoder.h"
+#include "MCHRawEncoderDigit/DigitRawEncoder.h"
+#include <TRandom.h>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+using namespace o2::mch::raw;
+
+std::vector<std::byte> generateTestData(int nEvents, int nDigitsPerDE)
+{
+  auto severity = fair::Logger::GetConsoleSeverity();
+  fair::Logger::SetConsoleSeverity(fair::Severity::warning);
+  {
+    DigitRawEncoderOptions opts;
+    opts.splitMode = OutputSplit::None; // to get only one file
+    opts.noGRP = true;
+    opts.noEmptyHBF = true;
+    opts.writeHB = false;
+    opts.userLogicVersion = 1;
+    opts.dummyElecMap = true;
+
+    DigitRawEncoder encoder(opts);
+    for (int ievent = 0; ievent < nEvents; ievent++) {
+      std::vector<o2::mch::Digit> digits;
+      for (auto deId : o2::mch::constants::deIdsForAllMCH) {
+        const auto& seg = o2::mch::mapping::segmentation(deId);
+        for (int i = 0; i < nDigitsPerDE; i++) {
+          digits.emplace_back(deId, gRandom->Integer(seg.nofPads()), 100 + gRandom->Integer(1000), 0, 1);
+        }
+      }
+      encoder.encodeDigits(digits, 0, 100 * (ievent + 1));
+    }
+  }
+  fair::Logger::SetConsoleSeverity(severity);
+
+  std::ifstream in("MCH.raw", std::ifstream::binary);
+  in.seekg(0, in.end);
+  std::vector<std::byte> buffer(in.tellg());
+  in.seekg(0, in.beg);
+  in.read(reinterpret_cast<char*>(buffer.data()), buffer.size());
+  in.close();
+  std::remove("MCH.raw");
+  return buffer;
+}
+
+static void BM_DataDecoder(benchmark::State& state)
+{
+  int nThreads = state.range(0);
+  int nEvents = state.range(1);
+  int nDigitsPerDE = state.range(2);
+
+  auto inputData = generateTestData(nEvents, nDigitsPerDE);
+  std::vector<gsl::span<const std::byte>> buffers{gsl::span<const std::byte>(inputData)};
+
+  DataDecoder serial(nullptr, nullptr, "", "", false, false, true);
+  serial.decodeBuffers(buffers);
+  DataDecoder decoder(nullptr, nullptr, "", "", false, false, true);
+  decoder.setNThreads(nThreads);
+  decoder.decodeBuffers(buffers);
+  if (!(decoder.getDigits() == serial.getDigits()) || !(decoder.getErrors().size() == serial.getErrors().size())) {
+    state.SkipWithError("the parallel decoding differs from the serial one");
+    return;
+  }
+
+  double num{0};
+  for (auto _ : state) {
+    decoder.reset();
+    decoder.decodeBuffers(buffers);
+    ++num;
+  }
+
+  state.counters["num"] = benchmark::Counter(num, benchmark::Counter::kIsRate);
+  state.counters["digits"] = decoder.getDigits().size();
+}
+
+static void CustomArguments(benchmark::internal::Benchmark* bench)
+{
+  for (int nThreads : {1, 2, 4, 8}) {
+    // Few digits
+    bench->Args({nThreads, 1, 1});
+    // Many events with many digits
+    bench->Args({nThreads, 100, 20});
+  }
+}
+
+BENCHMARK(BM_DataDecoder)->Apply(CustomArguments)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+BENCHMARK_MAIN();
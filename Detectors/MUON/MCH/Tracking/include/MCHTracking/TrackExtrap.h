@@ -18,11 +18,16 @@
 #define O2_MCH_TRACKEXTRAP_H_
 
 #include <cstddef>
+#include <memory>
 
 #include <TMatrixD.h>
 
 namespace o2
 {
+namespace field
+{
+class MagFieldGrid;
+}
 namespace mch
 {
 
@@ -46,6 +51,11 @@ class TrackExtrap
   /// Return true if the field is switched ON
   static bool isFieldON() { return sFieldON; }
 
+  /// Tabulate the magnetic field in the muon spectrometer with the given step (cm) and use it during the extrapolation
+  /// instead of querying the field map at each Runge-Kutta step. A step <= 0 disables the cache
+  static void useFieldCache(double step);
+  static bool isFieldCacheON() { return sFieldCache != nullptr; }
+
   /// Switch to Runge-Kutta extrapolation v2
   static void useExtrapV2(bool extrapV2 = true) { sExtrapV2 = extrapV2; }
 
@@ -117,6 +127,9 @@ class TrackExtrap
   static bool extrapToZRungekuttaV2(TrackParam& trackParam, double zEnd);
   static bool extrapOneStepRungekutta(double charge, double step, const double* vect, double* vout);
 
+  static void field(const double* xyz, double* b);
+  static void fillFieldCache();
+
   static constexpr double SMuMass = 0.105658;                         ///< Muon mass (GeV/c2)
   static constexpr double SAbsZBeg = -90.;                            ///< Position of the begining of the absorber (cm)
   static constexpr double SAbsZEnd = -505.;                           ///< Position of the end of the absorber (cm)
@@ -134,12 +147,18 @@ class TrackExtrap
   static constexpr double SMuonFilterZEnd = SMuonFilterZBeg - SMuonFilterThickness;
   static constexpr double SMuonFilterX0 = 1.76; ///< Radiation length of the muon filter (cm)
   static constexpr double SMIDZ = -1603.5;      ///< Position of the first MID chamber (cm)
+  static constexpr double SFieldCacheZBeg = -80.;    ///< Position of the begining of the tabulated field region (cm)
+  static constexpr double SFieldCacheZEnd = -1700.;  ///< Position of the end of the tabulated field region (cm)
+  static constexpr double SFieldCacheXYMax = 320.;   ///< Half size in x and y of the tabulated field region (cm)
 
   static bool sExtrapV2; ///< switch to Runge-Kutta extrapolation v2
 
   static double sSimpleBValue; ///< Magnetic field value at the centre
   static bool sFieldON;        ///< true if the field is switched ON
 
+  static double sFieldCacheStep;                            ///< step of the tabulated field, disabled if <= 0
+  static std::unique_ptr<o2::field::MagFieldGrid> sFieldCache; ///< tabulated field
+
   static std::size_t sNCallExtrapToZCov; ///< number of times the method extrapToZCov(...) is called
   static std::size_t sNCallField;        ///< number of times the method Field(...) is called
 };
@@ -23,6 +23,7 @@
 #include <TGeoShape.h>
 #include <TMath.h>
 
+#include "Field/MagFieldGrid.h"
 #include "Framework/Logger.h"
 
 #include "MCHTracking/TrackParam.h"
@@ -35,6 +36,8 @@ namespace mch
 bool TrackExtrap::sExtrapV2 = false;
 double TrackExtrap::sSimpleBValue = 0.;
 bool TrackExtrap::sFieldON = false;
+double TrackExtrap::sFieldCacheStep = 0.;
+std::unique_ptr<o2::field::MagFieldGrid> TrackExtrap::sFieldCache{};
 std::size_t TrackExtrap::sNCallExtrapToZCov = 0;
 std::size_t TrackExtrap::sNCallField = 0;
 
@@ -49,6 +52,52 @@ void TrackExtrap::setField()
   sSimpleBValue = b[0];
   sFieldON = (TMath::Abs(sSimpleBValue) > 1.e-10) ? true : false;
   LOG(info) << "Track extrapolation with magnetic field " << (sFieldON ? "ON" : "OFF");
+  fillFieldCache();
+}
+
+//__________________________________________________________________________
+void TrackExtrap::useFieldCache(double step)
+{
+  /// Enable the tabulated field with the given step (cm), or disable it if step <= 0.
+  /// The field is tabulated now if it is already set, otherwise when calling setField()
+  sFieldCacheStep = step;
+  if (TGeoGlobalMagField::Instance()->GetField()) {
+    fillFieldCache();
+  } else {
+    sFieldCache.reset();
+  }
+}
+
+//__________________________________________________________________________
+void TrackExtrap::fillFieldCache()
+{
+  /// Tabulate the current field in the muon spectrometer if required
+  if (sFieldCacheStep <= 0.) {
+    sFieldCache.reset();
+    return;
+  }
+  // the grid is centred at z = 0, shift it to the spectrometer region
+  const double zCentre = 0.5 * (SFieldCacheZBeg + SFieldCacheZEnd);
+  auto fieldFunction = [zCentre](const double* xyz, double* b) {
+    const double xyzGlo[3] = {xyz[0], xyz[1], xyz[2] + zCentre};
+    TGeoGlobalMagField::Instance()->Field(xyzGlo, b);
+  };
+  sFieldCache = std::make_unique<o2::field::MagFieldGrid>(fieldFunction, SFieldCacheXYMax, 0.5 * (SFieldCacheZBeg - SFieldCacheZEnd), sFieldCacheStep);
+  LOG(info) << "Track extrapolation with field tabulated every " << sFieldCacheStep << " cm (" << sFieldCache->getBytes() / (1024 * 1024) << " MB)";
+}
+
+//__________________________________________________________________________
+void TrackExtrap::field(const double* xyz, double* b)
+{
+  /// Get the field at xyz, from the tabulated field if enabled and the point is inside
+  ++sNCallField;
+  if (sFieldCache) {
+    const double xyzLoc[3] = {xyz[0], xyz[1], xyz[2] - 0.5 * (SFieldCacheZBeg + SFieldCacheZEnd)};
+    if (sFieldCache->Field(xyzLoc, b)) {
+      return;
+    }
+  }
+  TGeoGlobalMagField::Instance()->Field(xyz, b);
 }
 
 //__________________________________________________________________________
@@ -1066,8 +1115,7 @@ bool TrackExtrap::extrapOneStepRungekutta(double charge, double step, const doub
       h = rest;
     }
     // cmodif: call gufld(vout,f) changed into:
-    TGeoGlobalMagField::Instance()->Field(vout, f);
-    ++sNCallField;
+    field(vout, f);
 
     // *
     // *             start of integration
@@ -1115,8 +1163,7 @@ bool TrackExtrap::extrapOneStepRungekutta(double charge, double step, const doub
     xyzt[2] = zt;
 
     // cmodif: call gufld(xyzt,f) changed into:
-    TGeoGlobalMagField::Instance()->Field(xyzt, f);
-    ++sNCallField;
+    field(xyzt, f);
 
     at = a + secxs[0];
     bt = b + secys[0];
@@ -1155,8 +1202,7 @@ bool TrackExtrap::extrapOneStepRungekutta(double charge, double step, const doub
     xyzt[2] = zt;
 
     // cmodif: call gufld(xyzt,f) changed into:
-    TGeoGlobalMagField::Instance()->Field(xyzt, f);
-    ++sNCallField;
+    field(xyzt, f);
 
     z = z + (c + (seczs[0] + seczs[1] + seczs[2]) * kthird) * h;
     y = y + (b + (secys[0] + secys[1] + secys[2]) * kthird) * h;
@@ -55,6 +55,9 @@ void TrackFinder::init()
   // use the Runge-Kutta extrapolation v2
   TrackExtrap::useExtrapV2();
 
+  // use the tabulated field if requested
+  TrackExtrap::useFieldCache(trackerParam.fieldCacheStep);
+
   // Pre-compute some parameters used during the tracking
   mChamberResolutionX2 = trackerParam.chamberResolutionX * trackerParam.chamberResolutionX;
   mChamberResolutionY2 = trackerParam.chamberResolutionY * trackerParam.chamberResolutionY;
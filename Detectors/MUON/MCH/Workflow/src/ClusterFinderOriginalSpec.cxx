@@ -42,6 +42,7 @@
 #include "MCHBase/PreCluster.h"
 #include "DataFormatsMCH/Cluster.h"
 #include "MCHClustering/ClusterFinderOriginal.h"
+#include "MCHClustering/ClusterFinderOriginalPool.h"
 
 namespace o2
 {
@@ -65,7 +66,13 @@ class ClusterFinderOriginalTask
       o2::conf::ConfigurableParam::updateFromFile(config, "MCHClustering", true);
     }
     bool run2Config = ic.options().get<bool>("run2-config");
-    mClusterFinder.init(run2Config);
+    mNThreads = ic.options().get<int>("nthreads");
+    if (mNThreads > 1) {
+      mClusterFinderPool.init(run2Config, mNThreads);
+      LOG(info) << "clustering with " << mClusterFinderPool.getNThreads() << " threads";
+    } else {
+      mClusterFinder.init(run2Config);
+    }
 
     mAttachInitalPrecluster = ic.options().get<bool>("attach-initial-precluster");
 
@@ -75,7 +82,11 @@ class ClusterFinderOriginalTask
       mErrorMap.forEach([](Error error) {
         LOGP(warning, fmt::runtime(error.asString()));
       });
-      this->mClusterFinder.deinit();
+      if (this->mNThreads > 1) {
+        this->mClusterFinderPool.deinit();
+      } else {
+        this->mClusterFinder.deinit();
+      }
     });
   }
 
@@ -95,10 +106,36 @@ class ClusterFinderOriginalTask
     auto& usedDigits = pc.outputs().make<std::vector<Digit>>(OutputRef{"clusterdigits"});
 
     clusterROFs.reserve(preClusterROFs.size());
-    auto& errorMap = mClusterFinder.getErrorMap();
+    auto& errorMap = (mNThreads > 1) ? mClusterFinderPool.getErrorMap() : mClusterFinder.getErrorMap();
     errorMap.clear();
     for (const auto& preClusterROF : preClusterROFs) {
 
+      if (mNThreads > 1) {
+        // clusterize all the preclusters of the current ROF in parallel
+        auto clusterOffset = clusters.size();
+        auto rofPreClusters = preClusters.subspan(preClusterROF.getFirstIdx(), preClusterROF.getNEntries());
+        auto tStart = std::chrono::high_resolution_clock::now();
+        mClusterFinderPool.findClusters(rofPreClusters, digits);
+        auto tEnd = std::chrono::high_resolution_clock::now();
+        mTimeClusterFinder += tEnd - tStart;
+
+        const auto& newClusters = mClusterFinderPool.getClusters();
+        if (mAttachInitalPrecluster) {
+          for (size_t i = 0; i < rofPreClusters.size(); ++i) {
+            auto first = mClusterFinderPool.getFirstClusterIdx(i);
+            auto n = mClusterFinderPool.getFirstClusterIdx(i + 1) - first;
+            writeClusters(digits.subspan(rofPreClusters[i].firstDigit, rofPreClusters[i].nDigits),
+                          {newClusters.data() + first, static_cast<size_t>(n)}, clusters, usedDigits);
+          }
+        } else {
+          writeClusters(newClusters, mClusterFinderPool.getUsedDigits(), clusters, usedDigits);
+        }
+
+        clusterROFs.emplace_back(preClusterROF.getBCData(), clusterOffset, clusters.size() - clusterOffset,
+                                 preClusterROF.getBCWidth());
+        continue;
+      }
+
       // prepare to clusterize the current ROF
       auto clusterOffset = clusters.size();
       mClusterFinder.reset();
@@ -116,13 +153,14 @@ class ClusterFinderOriginalTask
 
         if (mAttachInitalPrecluster) {
           // store the new clusters and associate them to all the digits of the precluster
-          writeClusters(preclusterDigits, firstClusterIdx, clusters, usedDigits);
+          writeClusters(preclusterDigits, {mClusterFinder.getClusters().data() + firstClusterIdx, mClusterFinder.getClusters().size() - firstClusterIdx},
+                        clusters, usedDigits);
         }
       }
 
       if (!mAttachInitalPrecluster) {
         // store all the clusters of the current ROF and the associated digits actually used in the clustering
-        writeClusters(clusters, usedDigits);
+        writeClusters(mClusterFinder.getClusters(), mClusterFinder.getUsedDigits(), clusters, usedDigits);
       }
 
       // create the cluster ROF
@@ -143,19 +181,19 @@ class ClusterFinderOriginalTask
 
  private:
   //_________________________________________________________________________________________________
-  void writeClusters(const gsl::span<const Digit>& preclusterDigits, size_t firstClusterIdx,
+  void writeClusters(const gsl::span<const Digit>& preclusterDigits, gsl::span<const Cluster> newClusters,
                      std::vector<Cluster, o2::pmr::polymorphic_allocator<Cluster>>& clusters,
                      std::vector<Digit, o2::pmr::polymorphic_allocator<Digit>>& usedDigits) const
   {
     /// fill the output messages with the new clusters and all the digits from the corresponding precluster
     /// modify the references to the attached digits according to their position in the global vector
 
-    if (firstClusterIdx == mClusterFinder.getClusters().size()) {
+    if (newClusters.empty()) {
       return;
     }
 
     auto clusterOffset = clusters.size();
-    clusters.insert(clusters.end(), mClusterFinder.getClusters().begin() + firstClusterIdx, mClusterFinder.getClusters().end());
+    clusters.insert(clusters.end(), newClusters.begin(), newClusters.end());
 
     auto digitOffset = usedDigits.size();
     usedDigits.insert(usedDigits.end(), preclusterDigits.begin(), preclusterDigits.end());
@@ -167,17 +205,18 @@ class ClusterFinderOriginalTask
   }
 
   //_________________________________________________________________________________________________
-  void writeClusters(std::vector<Cluster, o2::pmr::polymorphic_allocator<Cluster>>& clusters,
+  void writeClusters(const std::vector<Cluster>& newClusters, const std::vector<Digit>& newDigits,
+                     std::vector<Cluster, o2::pmr::polymorphic_allocator<Cluster>>& clusters,
                      std::vector<Digit, o2::pmr::polymorphic_allocator<Digit>>& usedDigits) const
   {
     /// fill the output messages with clusters and attached digits of the current event
     /// modify the references to the attached digits according to their position in the global vector
 
     auto clusterOffset = clusters.size();
-    clusters.insert(clusters.end(), mClusterFinder.getClusters().begin(), mClusterFinder.getClusters().end());
+    clusters.insert(clusters.end(), newClusters.begin(), newClusters.end());
 
     auto digitOffset = usedDigits.size();
-    usedDigits.insert(usedDigits.end(), mClusterFinder.getUsedDigits().begin(), mClusterFinder.getUsedDigits().end());
+    usedDigits.insert(usedDigits.end(), newDigits.begin(), newDigits.end());
 
     for (auto itCluster = clusters.begin() + clusterOffset; itCluster < clusters.end(); ++itCluster) {
       itCluster->firstDigit += digitOffset;
@@ -186,6 +225,8 @@ class ClusterFinderOriginalTask
 
   bool mAttachInitalPrecluster = false;               ///< attach all digits of initial precluster to cluster
   ClusterFinderOriginal mClusterFinder{};             ///< clusterizer
+  ClusterFinderOriginalPool mClusterFinderPool{};     ///< clusterizers running on several threads
+  int mNThreads = 1;                                  ///< number of clustering threads
   ErrorMap mErrorMap{};                               ///< counting of encountered errors
   std::chrono::duration<double> mTimeClusterFinder{}; ///< timer
 };
@@ -205,7 +246,8 @@ o2::framework::DataProcessorSpec getClusterFinderOriginalSpec(const char* specNa
     AlgorithmSpec{adaptFromTask<ClusterFinderOriginalTask>()},
     Options{{"mch-config", VariantType::String, "", {"JSON or INI file with clustering parameters"}},
             {"run2-config", VariantType::Bool, false, {"setup for run2 data"}},
-            {"attach-initial-precluster", VariantType::Bool, false, {"attach all digits of initial precluster to cluster"}}}};
+            {"attach-initial-precluster", VariantType::Bool, false, {"attach all digits of initial precluster to cluster"}},
+            {"nthreads", VariantType::Int, 1, {"number of threads used to clusterize the preclusters of a ROF"}}}};
 }
 
 } // end namespace mch
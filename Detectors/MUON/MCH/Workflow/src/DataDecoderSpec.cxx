@@ -100,6 +100,7 @@ class DataDecoderTask
 
     mDecoder = new DataDecoder(channelHandler, rdhHandler, mapCRUfile, mapFECfile, ds2manu, mDebug,
                                useDummyElecMap, timeRecoMode);
+    mDecoder->setNThreads(ic.options().get<int>("decoding-threads"));
 
     if (mCcdbRequest) {
       base::GRPGeomHelper::instance().setRequest(mCcdbRequest);
@@ -137,20 +138,19 @@ class DataDecoderTask
     // get the input buffer
     auto& inputs = pc.inputs();
     DPLRawParser parser(inputs, o2::framework::select(mInputSpec.c_str()));
-    bool abort{false};
-    for (auto it = parser.begin(), end = parser.end(); it != end && abort == false; ++it) {
+    std::vector<gsl::span<const std::byte>> buffers;
+    for (auto it = parser.begin(), end = parser.end(); it != end; ++it) {
       auto const* raw = it.raw();
       if (!raw) {
         continue;
       }
       size_t payloadSize = it.size();
 
-      gsl::span<const std::byte> buffer(reinterpret_cast<const std::byte*>(raw), sizeof(RDH) + payloadSize);
-      bool ok = mDecoder->decodeBuffer(buffer);
-      if (!ok) {
-        LOG(alarm) << "critical decoding error : aborting this TF decoding\n";
-        abort = true;
-      }
+      buffers.emplace_back(reinterpret_cast<const std::byte*>(raw), sizeof(RDH) + payloadSize);
+    }
+    bool ok = mDecoder->decodeBuffers(buffers);
+    if (!ok) {
+      LOG(alarm) << "critical decoding error : aborting this TF decoding\n";
     }
   }
 
@@ -378,6 +378,7 @@ o2::framework::DataProcessorSpec getDecodingSpec(const char* specName, std::stri
             {"fec-map", VariantType::String, "", {"custom FEC mapping"}},
             {"dummy-elecmap", VariantType::Bool, false, {"use dummy electronic mapping (for debug, temporary)"}},
             {"ds2manu", VariantType::Bool, false, {"convert channel numbering from Run3 to Run1-2 order"}},
+            {"decoding-threads", VariantType::Int, 1, {"number of threads decoding the pages of different links in parallel"}},
             {"time-reco-mode", VariantType::String, "bcreset", {"digit time reconstruction method [hbpackets, bcreset]"}},
             {"check-rofs", VariantType::Bool, false, {"perform consistency checks on the output ROFs"}},
             {"dummy-rofs", VariantType::Bool, false, {"disable the ROFs finding algorithm"}},
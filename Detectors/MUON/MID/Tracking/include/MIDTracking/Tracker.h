@@ -17,6 +17,7 @@
 #ifndef O2_MID_TRACKER_H
 #define O2_MID_TRACKER_H
 
+#include <array>
 #include <vector>
 #include <unordered_set>
 #include <gsl/gsl>
@@ -40,6 +41,11 @@ class Tracker
   /// Gets number of sigmas for cuts
   inline float getSigmaCut() const { return mSigmaCut; }
 
+  /// Sets the number of threads processing the ROFs of a timeframe in parallel
+  void setNThreads(int nThreads) { mNThreads = nThreads > 1 ? nThreads : 1; }
+  /// Gets the number of threads processing the ROFs of a timeframe in parallel
+  int getNThreads() const { return mNThreads; }
+
   void process(gsl::span<const Cluster> clusters, bool accumulate = false);
   void process(gsl::span<const Cluster> clusters, gsl::span<const ROFRecord> rofRecords);
   bool init(bool keepAll = false);
@@ -57,6 +63,7 @@ class Tracker
   const std::vector<ROFRecord>& getClusterROFRecords() { return mClusterROFRecords; }
 
  private:
+  void processROFs(gsl::span<const Cluster> clusters, gsl::span<const ROFRecord> rofRecords);
   void processSide(bool isRight, bool isInward);
   void tryAddTrack(const Track& track);
   void followTrackKeepAll(Track& track, bool isRight, bool isInward);
@@ -67,6 +74,7 @@ class Tracker
   int getFirstNeighbourRPC(int rpc) const;
   int getLastNeighbourRPC(int rpc) const;
   bool loadClusters(gsl::span<const Cluster>& clusters);
+  bool isCompatibleDE(const Track& track, int deId) const;
   bool makeTrackSeed(Track& track, const Cluster& cl1, const Cluster& cl2) const;
   void runKalmanFilter(Track& track, const Cluster& cluster) const;
   bool tryOneCluster(const Track& track, int chamber, int clIdx, Track& newTrack) const;
@@ -79,8 +87,15 @@ class Tracker
   float mSigmaCut = 5.;         ///< Number of sigmas cut
   float mMaxChi2 = 50.;         ///< Maximum cut on chi2 to attach a cluster (= 2 * mSigmaCut^2)
 
-  std::vector<int> mClusterIndexes[72]; ///< Ordered arrays of clusters indexes
-  std::vector<Cluster> mClusters{};     ///< 3D clusters
+  /// Bounding box and largest resolutions of the clusters of one detection element in the current event
+  struct ClusterBox {
+    float xMin, xMax, yMin, yMax, zMin, zMax;
+    float maxEX2, maxEY2;
+  };
+
+  std::vector<int> mClusterIndexes[72];     ///< Ordered arrays of clusters indexes
+  std::array<ClusterBox, 72> mClusterBoxes; ///< Clusters bounding boxes, to skip detection elements incompatible with the track
+  std::vector<Cluster> mClusters{};         ///< 3D clusters
 
   std::vector<Track> mTracks{};                ///< Vector of tracks
   std::vector<ROFRecord> mTrackROFRecords{};   ///< List of track RO frame records
@@ -88,6 +103,7 @@ class Tracker
   size_t mFirstTrackOffset{0};                 ///! Offset for the first track in the current event
   size_t mTrackOffset{0};                      ///! Offset for the track in the current event
   int mNTracksStep1{0};                        ///! Number of tracks found in the first tracking step
+  int mNThreads{1};                            ///< Number of threads processing the ROFs in parallel
 
   GeometryTransformer mTransformer{}; ///< Geometry transformer
 
@@ -15,9 +15,12 @@
 /// \date   09 May 2017
 #include "MIDTracking/Tracker.h"
 
+#include <algorithm>
 #include <cmath>
 #include <functional>
+#include <limits>
 #include <stdexcept>
+#include <thread>
 
 #include "Framework/Logger.h"
 #include "MIDBase/DetectorParameters.h"
@@ -77,19 +80,125 @@ bool Tracker::loadClusters(gsl::span<const Cluster>& clusters)
     mClusterIndexes[deId].emplace_back(mClusters.size());
     const auto& position = mTransformer.localToGlobal(deId, cl.xCoor, cl.yCoor);
     mClusters.emplace_back(cl);
-    mClusters.back().xCoor = position.x();
-    mClusters.back().yCoor = position.y();
-    mClusters.back().zCoor = position.z();
+    auto& gcl = mClusters.back();
+    gcl.xCoor = position.x();
+    gcl.yCoor = position.y();
+    gcl.zCoor = position.z();
+    auto& box = mClusterBoxes[deId];
+    if (mClusterIndexes[deId].size() == 1) {
+      box = {gcl.xCoor, gcl.xCoor, gcl.yCoor, gcl.yCoor, gcl.zCoor, gcl.zCoor, gcl.getEX2(), gcl.getEY2()};
+    } else {
+      box.xMin = std::min(box.xMin, gcl.xCoor);
+      box.xMax = std::max(box.xMax, gcl.xCoor);
+      box.yMin = std::min(box.yMin, gcl.yCoor);
+      box.yMax = std::max(box.yMax, gcl.yCoor);
+      box.zMin = std::min(box.zMin, gcl.zCoor);
+      box.zMax = std::max(box.zMax, gcl.zCoor);
+      box.maxEX2 = std::max(box.maxEX2, gcl.getEX2());
+      box.maxEY2 = std::max(box.maxEY2, gcl.getEY2());
+    }
   }
 
   return (clusters.size() > 0);
 }
 
+//______________________________________________________________________________
+bool Tracker::isCompatibleDE(const Track& track, int deId) const
+{
+  /// Checks if any cluster of the detection element can pass the chi2 cut of tryOneCluster,
+  /// using the bounding box of its clusters and their largest resolutions
+
+  if (mClusterIndexes[deId].empty()) {
+    return false;
+  }
+  const auto& box = mClusterBoxes[deId];
+  const float zLimits[2] = {box.zMin, box.zMax};
+  double posMin[2] = {std::numeric_limits<double>::max(), std::numeric_limits<double>::max()};
+  double posMax[2] = {std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest()};
+  double maxVar[2] = {0., 0.};
+  const auto& covParams = track.getCovarianceParameters();
+  const double pos[2] = {track.getPositionX(), track.getPositionY()};
+  const double dir[2] = {track.getDirectionX(), track.getDirectionY()};
+  for (auto zLimit : zLimits) {
+    // the position is linear and the variance is convex in dZ: the extremes are at the limits
+    double dZ = zLimit - track.getPositionZ();
+    for (int idx = 0; idx < 2; ++idx) {
+      double propPos = pos[idx] + dir[idx] * dZ;
+      posMin[idx] = std::min(posMin[idx], propPos);
+      posMax[idx] = std::max(posMax[idx], propPos);
+      maxVar[idx] = std::max(maxVar[idx], covParams[idx] + 2. * covParams[idx + 4] * dZ + covParams[idx + 2] * dZ * dZ);
+    }
+  }
+  const double boxMin[2] = {box.xMin, box.yMin};
+  const double boxMax[2] = {box.xMax, box.yMax};
+  const double maxErr2[2] = {box.maxEX2, box.maxEY2};
+  for (int idx = 0; idx < 2; ++idx) {
+    // each of the two terms of the chi2 must pass the cut, the margin covers the single precision of the propagation
+    double window = 1.001 * std::sqrt(mMaxChi2 * (maxVar[idx] + maxErr2[idx])) + 0.01;
+    if (posMin[idx] - window > boxMax[idx] || posMax[idx] + window < boxMin[idx]) {
+      return false;
+    }
+  }
+  return true;
+}
+
 //______________________________________________________________________________
 void Tracker::process(gsl::span<const Cluster> clusters, gsl::span<const ROFRecord> rofRecords)
 {
   /// Main function: runs on a data containing the clusters in timeframe
   /// and builds the tracks
+  /// With more than one thread, contiguous ranges of ROFs are processed in parallel by copies of the tracker.
+  /// The results are merged in the ROF order, so they do not depend on the number of threads
+  size_t nChunks = std::min<size_t>(mNThreads, rofRecords.size());
+  if (nChunks < 2) {
+    processROFs(clusters, rofRecords);
+    return;
+  }
+  std::vector<Tracker> workers(nChunks, *this);
+  size_t nROFsPerChunk = (rofRecords.size() + nChunks - 1) / nChunks;
+  std::vector<std::thread> threads;
+  for (size_t ichunk = 0; ichunk < nChunks; ++ichunk) {
+    size_t firstROF = std::min(ichunk * nROFsPerChunk, rofRecords.size());
+    size_t nROFs = std::min(nROFsPerChunk, rofRecords.size() - firstROF);
+    threads.emplace_back([&workers, clusters, rofRecords, ichunk, firstROF, nROFs]() {
+      workers[ichunk].processROFs(clusters, rofRecords.subspan(firstROF, nROFs));
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  mClusters.clear();
+  mTracks.clear();
+  mTrackROFRecords.clear();
+  mClusterROFRecords.clear();
+  for (auto& worker : workers) {
+    size_t trackOffset = mTracks.size();
+    size_t clusterOffset = mClusters.size();
+    for (auto& track : worker.mTracks) {
+      // the matched clusters refer to the clusters of the worker
+      for (int ich = 0; ich < 4; ++ich) {
+        auto clIdx = track.getClusterMatchedUnchecked(ich);
+        if (clIdx >= 0) {
+          track.setClusterMatchedUnchecked(ich, clIdx + clusterOffset);
+        }
+      }
+      mTracks.emplace_back(track);
+    }
+    mClusters.insert(mClusters.end(), worker.mClusters.begin(), worker.mClusters.end());
+    for (auto& rofRecord : worker.mTrackROFRecords) {
+      mTrackROFRecords.emplace_back(rofRecord, rofRecord.firstEntry + trackOffset, rofRecord.nEntries);
+    }
+    for (auto& rofRecord : worker.mClusterROFRecords) {
+      mClusterROFRecords.emplace_back(rofRecord, rofRecord.firstEntry + clusterOffset, rofRecord.nEntries);
+    }
+  }
+}
+
+//______________________________________________________________________________
+void Tracker::processROFs(gsl::span<const Cluster> clusters, gsl::span<const ROFRecord> rofRecords)
+{
+  /// Builds the tracks of the ROFs one after the other
   mClusters.clear();
   mTracks.clear();
   mTrackROFRecords.clear();
@@ -284,6 +393,9 @@ bool Tracker::findAllClusters(const Track& track, bool isRight, int chamber, int
 
   for (int irpc = firstRPC; irpc <= lastRPC; ++irpc) {
     int deId = rpcOffset + irpc;
+    if (!isCompatibleDE(track, deId)) {
+      continue;
+    }
     for (auto clIdx : mClusterIndexes[deId]) {
 
       // skip excluded clusters
@@ -368,6 +480,9 @@ void Tracker::findNextCluster(const Track& track, bool isRight, bool isInward, i
   Track newTrack;
   for (int irpc = firstRPC; irpc <= lastRPC; ++irpc) {
     int deId = rpcOffset + irpc;
+    if (!isCompatibleDE(track, deId)) {
+      continue;
+    }
     for (auto clIdx : mClusterIndexes[deId]) {
       if (!tryOneCluster(track, chamber, clIdx, newTrack)) {
         continue;
@@ -20,11 +20,14 @@
 
 #include <boost/test/data/monomorphic/generators/xrange.hpp>
 #include <boost/test/data/test_case.hpp>
+#include <algorithm>
 #include <cstdint>
 #include <string>
 #include <sstream>
 #include <vector>
+#include "CommonDataFormat/InteractionRecord.h"
 #include "DataFormatsMID/Cluster.h"
+#include "DataFormatsMID/ROFRecord.h"
 #include "DataFormatsMID/Track.h"
 #include "MIDBase/HitFinder.h"
 #include "MIDBase/Mapping.h"
@@ -226,6 +229,49 @@ BOOST_DATA_TEST_CASE(TestAlgorithms, boost::unit_test::data::xrange(2, 3), nTrac
   }
 }
 
+BOOST_DATA_TEST_CASE(TestParallelROFs, boost::unit_test::data::xrange(2, 5), nThreads)
+{
+  // Build a timeframe of events and check that the parallel processing gives the same results as the serial one
+  std::vector<Cluster> clusters;
+  std::vector<ROFRecord> rofRecords;
+  for (int ievt = 0; ievt < 100; ++ievt) {
+    std::vector<TrackClusters> trackClusters = getTrackClusters(1 + ievt % 4);
+    size_t firstEntry = clusters.size();
+    for (auto& trCl : trackClusters) {
+      clusters.insert(clusters.end(), trCl.clusters.begin(), trCl.clusters.end());
+    }
+    rofRecords.emplace_back(o2::InteractionRecord(100 * ievt, 0), EventType::Standard, firstEntry, clusters.size() - firstEntry);
+  }
+
+  Tracker serialTracker(helper.geoTrans);
+  serialTracker.init(true);
+  serialTracker.process(clusters, rofRecords);
+
+  Tracker parallelTracker(helper.geoTrans);
+  parallelTracker.init(true);
+  parallelTracker.setNThreads(nThreads);
+  parallelTracker.process(clusters, rofRecords);
+
+  BOOST_TEST(parallelTracker.getTracks().size() == serialTracker.getTracks().size());
+  BOOST_TEST(parallelTracker.getClusters().size() == serialTracker.getClusters().size());
+  BOOST_REQUIRE(parallelTracker.getTrackROFRecords().size() == serialTracker.getTrackROFRecords().size());
+  for (size_t irof = 0; irof < serialTracker.getTrackROFRecords().size(); ++irof) {
+    BOOST_TEST(parallelTracker.getTrackROFRecords()[irof].firstEntry == serialTracker.getTrackROFRecords()[irof].firstEntry);
+    BOOST_TEST(parallelTracker.getTrackROFRecords()[irof].nEntries == serialTracker.getTrackROFRecords()[irof].nEntries);
+    BOOST_TEST(parallelTracker.getClusterROFRecords()[irof].firstEntry == serialTracker.getClusterROFRecords()[irof].firstEntry);
+    BOOST_TEST(parallelTracker.getClusterROFRecords()[irof].nEntries == serialTracker.getClusterROFRecords()[irof].nEntries);
+  }
+  size_t nTracks = std::min(parallelTracker.getTracks().size(), serialTracker.getTracks().size());
+  for (size_t itr = 0; itr < nTracks; ++itr) {
+    auto& parallelTrack = parallelTracker.getTracks()[itr];
+    auto& serialTrack = serialTracker.getTracks()[itr];
+    BOOST_TEST(parallelTrack.getChi2() == serialTrack.getChi2());
+    for (int ich = 0; ich < 4; ++ich) {
+      BOOST_TEST(parallelTrack.getClusterMatchedUnchecked(ich) == serialTrack.getClusterMatchedUnchecked(ich));
+    }
+  }
+}
+
 BOOST_AUTO_TEST_CASE(TestHitMapBuilder)
 {
   for (int ievt = 0; ievt < 100; ++ievt) {
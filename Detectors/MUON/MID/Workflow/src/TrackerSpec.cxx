@@ -51,6 +51,7 @@ class TrackerDeviceDPL
   {
     o2::base::GRPGeomHelper::instance().setRequest(mGGCCDBRequest);
     mKeepAll = !ic.options().get<bool>("mid-tracker-keep-best");
+    mNThreads = ic.options().get<int>("mid-tracker-threads");
 
     auto stop = [this]() {
       double scaleFactor = (mNROFs == 0) ? 0. : 1.e6 / mNROFs;
@@ -136,6 +137,7 @@ class TrackerDeviceDPL
       if (!mTracker->init(mKeepAll)) {
         LOG(error) << "Initialization of MID tracker device failed";
       }
+      mTracker->setNThreads(mNThreads);
       mHitMapBuilder = std::make_unique<HitMapBuilder>(geoTrans);
     }
     pc.inputs().get<std::vector<ColumnData>*>("mid_bad_channels_forTracks");
@@ -145,6 +147,7 @@ class TrackerDeviceDPL
   bool mIsMC = false;
   bool mKeepAll = false;
   bool mCheckMasked = false;
+  int mNThreads = 1;
   TrackLabeler mTrackLabeler{};
   std::shared_ptr<o2::base::GRPGeomRequest> mGGCCDBRequest;
   std::unique_ptr<Tracker> mTracker{nullptr};
@@ -190,7 +193,8 @@ framework::DataProcessorSpec getTrackerSpec(bool isMC, bool checkMasked)
     {inputSpecs},
     {outputSpecs},
     of::adaptFromTask<o2::mid::TrackerDeviceDPL>(ggRequest, isMC, checkMasked),
-    of::Options{{"mid-tracker-keep-best", of::VariantType::Bool, false, {"Keep only best track (default is keep all)"}}}};
+    of::Options{{"mid-tracker-keep-best", of::VariantType::Bool, false, {"Keep only best track (default is keep all)"}},
+                {"mid-tracker-threads", of::VariantType::Int, 1, {"Number of threads processing the ROFs in parallel"}}}};
 }
 } // namespace mid
 } // namespace o2
@@ -261,11 +261,11 @@ void Clusterer::unfoldOneCluster(Cluster& iniClu, char nMax, std::vector<Cluster
   // Take initial cluster and calculate local coordinates of digits
   // To avoid multiple re-calculation of same parameters
   short mult = iniClu.getMultiplicity();
-  std::vector<std::vector<float>> eInClusters(mult, std::vector<float>(nMax));
   uint32_t firstCE = iniClu.getFirstCluEl();
   uint32_t lastCE = iniClu.getLastCluEl();
 
-  mProp.reserve(mult * nMax);
+  // workspace reused for all clusters, keeps its capacity
+  mProp.resize(mult * nMax);
 
   for (int iclu = nMax; iclu--;) {
     CluElement& ce = cluelements[mMaxAt[iclu]];
@@ -289,7 +289,6 @@ void Clusterer::unfoldOneCluster(Cluster& iniClu, char nMax, std::vector<Cluster
     insuficientAccuracy = false; // will be true if at least one parameter changed too much
     B.Zero();
     C.Zero();
-    mProp.clear();
     double chi2 = 0.;
     for (int iclu = nMax; iclu--;) {
       mA[iclu] = 0;
@@ -22,6 +22,7 @@
 #include "Framework/Logger.h"
 #include "Framework/DataProcessingHelpers.h"
 #include "Framework/RateLimiter.h"
+#include "Framework/Monitoring.h"
 #include "Headers/DataHeaderHelpers.h"
 #include "Algorithm/RangeTokenizer.h"
 #include "DetectorsCommonDataFormats/DetID.h"
@@ -67,6 +68,7 @@ class TFReaderSpec : public o2f::Task
 
  private:
   void stopProcessing(o2f::ProcessingContext& ctx);
+  void sendFetcherMetrics(o2f::ProcessingContext& ctx);
   void TFBuilder();
 
  private:
@@ -80,7 +82,8 @@ class TFReaderSpec : public o2f::Task
   int mTFBuilderCounter = 0;
   int mNWaits = 0;
   long mTotalWaitTime = 0;
-  size_t mSelIDEntry = 0; // next TFID to select from the mInput.tfIDs (if non-empty)
+  size_t mNCopiesReported = 0; // number of remote file copies at the previous report of the fetcher metrics
+  size_t mSelIDEntry = 0;      // next TFID to select from the mInput.tfIDs (if non-empty)
   bool mRunning = false;
   bool mWaitSendingLast = false;
   TFReaderInp mInput; // command line inputs
@@ -103,9 +106,34 @@ void TFReaderSpec::init(o2f::InitContext& ic)
   mFileFetcher->setMaxFilesInQueue(mInput.maxFileCache);
   mFileFetcher->setMaxLoops(mInput.maxLoops);
   mFileFetcher->setFailThreshold(ic.options().get<float>("fetch-failure-threshold"));
+  mFileFetcher->setNCopyThreads(ic.options().get<int>("fetch-threads"));
+  mFileFetcher->setMaxCacheSize(size_t(ic.options().get<int>("fetch-cache-size-MB")) << 20);
   mFileFetcher->start();
 }
 
+//___________________________________________________________
+void TFReaderSpec::sendFetcherMetrics(o2f::ProcessingContext& ctx)
+{
+  // report the staging of the input files, once per new copied file
+  using o2::monitoring::Metric;
+  if (!mFileFetcher) {
+    return;
+  }
+  const auto stats = mFileFetcher->getCopyStats();
+  if (stats.nCopied == mNCopiesReported) {
+    return;
+  }
+  mNCopiesReported = stats.nCopied;
+  auto& monitoring = ctx.services().get<o2::monitoring::Monitoring>();
+  monitoring.send(Metric{uint64_t(mFileFetcher->getQueueSize()), "tf-fetch-queue-size"});
+  monitoring.send(Metric{1e-3 * mTotalWaitTime, "tf-fetch-wait-ms"});
+  monitoring.send(Metric{uint64_t(stats.nCopied), "tf-fetch-copies"});
+  monitoring.send(Metric{1e-6 * stats.nBytes / std::max(stats.copyTime, 1e-6), "tf-fetch-MBps"});
+  monitoring.send(Metric{1e3 * stats.copyTime / stats.nCopied, "tf-fetch-latency-ms"});
+  monitoring.send(Metric{1e3 * stats.maxCopyTime, "tf-fetch-max-latency-ms"});
+  monitoring.send(Metric{double(stats.cacheSize) / (1 << 20), "tf-fetch-cache-MB"});
+}
+
 //___________________________________________________________
 void TFReaderSpec::run(o2f::ProcessingContext& ctx)
 {
@@ -125,6 +153,7 @@ void TFReaderSpec::run(o2f::ProcessingContext& ctx)
   if (mInput.tfRateLimit == -999) {
     mInput.tfRateLimit = std::stoi(device->fConfig->GetValue<std::string>("timeframes-rate-limit"));
   }
+  sendFetcherMetrics(ctx);
   auto acknowledgeOutput = [this](fair::mq::Parts& parts, bool verbose = false) {
     int np = parts.Size();
     size_t dsize = 0, dsizeTot = 0, nblocks = 0;
@@ -527,6 +556,8 @@ o2f::DataProcessorSpec o2::rawdd::getTFReaderSpec(o2::rawdd::TFReaderInp& rinp)
   }
   spec.options.emplace_back(o2f::ConfigParamSpec{"select-tf-ids", o2f::VariantType::String, "", {"comma-separated list TF IDs to inject (from cumulative counter of TFs seen)"}});
   spec.options.emplace_back(o2f::ConfigParamSpec{"fetch-failure-threshold", o2f::VariantType::Float, 0.f, {"Fatil if too many failures( >0: fraction, <0: abs number, 0: no threshold)"}});
+  spec.options.emplace_back(o2f::ConfigParamSpec{"fetch-threads", o2f::VariantType::Int, 1, {"number of remote files copied in parallel"}});
+  spec.options.emplace_back(o2f::ConfigParamSpec{"fetch-cache-size-MB", o2f::VariantType::Int, 0, {"do not copy new remote files while their local copies exceed this size, evicting least recently used ones (0: no limit)"}});
   spec.algorithm = o2f::adaptFromTask<TFReaderSpec>(rinp);
 
   return spec;
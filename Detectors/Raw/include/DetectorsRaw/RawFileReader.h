@@ -54,6 +54,7 @@ struct ReaderInp {
   uint32_t maxTF = 0xffffffff;
   bool partPerSP = true;
   bool cache = false;
+  bool mapFiles = false;
   bool autodetectTF0 = false;
   bool preferCalcTF = false;
   bool sup0xccdb = false;
@@ -272,6 +273,10 @@ class RawFileReader
   bool getCacheData() const { return mCacheData; }
   void setCacheData(bool v) { mCacheData = v; }
 
+  bool getMapFiles() const { return mMapFiles; }
+  void setMapFiles(bool v) { mMapFiles = v; }
+  bool readFileData(int fileID, size_t offset, size_t size, char* dest);
+
   o2::header::DataOrigin getDefaultDataOrigin() const { return mDefDataOrigin; }
   o2::header::DataDescription getDefaultDataSpecification() const { return mDefDataDescription; }
   ReadoutCardType getDefaultReadoutCardType() const { return mDefCardType; }
@@ -292,6 +297,8 @@ class RawFileReader
  private:
   int getLinkLocalID(const RDHAny& rdh, int fileID);
   bool preprocessFile(int ifl);
+  void mapFiles();
+  void unmapFiles();
   static LinkSpec_t createSpec(o2::header::DataOrigin orig, LinkSubSpec_t ss) { return (LinkSpec_t(orig) << 32) | ss; }
 
   static constexpr o2::header::DataOrigin DEFDataOrigin = o2::header::gDataOriginFLP;
@@ -303,6 +310,7 @@ class RawFileReader
   std::vector<std::string> mFileNames;                                  //! input file names
   std::vector<FILE*> mFiles;                                            //! input file handlers
   std::vector<std::unique_ptr<char[]>> mFileBuffers;                    //! buffers for input files
+  std::vector<std::pair<const char*, size_t>> mFileMaps;                //! read-only mappings of the input files and their sizes
   std::vector<OrigDescCard> mDataSpecs;                                 //! data origin and description for every input file + readout card type
   bool mInitDone = false;
   bool mEmpty = true;
@@ -320,6 +328,7 @@ class RawFileReader
   long int mPosInFile = 0;                                          //! current position in the file
   bool mMultiLinkFile = false;                                      //! was > than 1 link seen in the file?
   bool mCacheData = false;                                          //! cache data to block after 1st scan (may require excessive memory, use with care)
+  bool mMapFiles = false;                                           //! read data from memory mappings of the files instead of fread
   bool mStopProcessing = false;                                     //! stop processing after error
   uint32_t mCheckErrors = 0;                                        //! mask for errors to check
   FirstTFDetection mFirstTFAutodetect = FirstTFDetection::Disabled; //!
@@ -24,6 +24,9 @@
 #include <string_view>
 #include <functional>
 #include <mutex>
+#include <deque>
+#include <thread>
+#include <condition_variable>
 
 #include <Rtypes.h>
 #include <TTree.h>
@@ -173,6 +176,10 @@ class RawFileWriter
   }
   ~RawFileWriter();
   void useCaching();
+  /// write the flushed superpages from a separate thread, while the links keep filling the new ones.
+  /// The order of the writes to every file is preserved, at most maxQueuedMB of pending data is kept in memory
+  void useAsyncWriting(size_t maxQueuedMB = 512);
+  bool isAsyncWriting() const { return mAsyncWriting; }
   void doLazinessCheck(bool v) { mDoLazinessCheck = v; }
   void writeConfFile(std::string_view origin = "FLP", std::string_view description = "RAWDATA", std::string_view cfgname = "raw.cfg", bool fullPath = true) const;
   void close();
@@ -204,6 +211,7 @@ class RawFileWriter
     return mSSpec2Link[RDHUtils::getSubSpec(RDHUtils::getCRUID(rdh), RDHUtils::getLinkID(rdh), RDHUtils::getEndPointID(rdh), RDHUtils::getFEEID(rdh))];
   }
 
+  // can be called concurrently for different links, provided the laziness check is disabled
   void addData(uint16_t feeid, uint16_t cru, uint8_t lnk, uint8_t endpoint, const IR& ir,
                const gsl::span<char> data, bool preformatted = false, uint32_t trigger = 0, uint32_t detField = 0);
 
@@ -394,6 +402,10 @@ class RawFileWriter
 
  private:
   void fillFromCache();
+  void queueWrite(OutputFile& file, std::vector<char>&& data);
+  std::vector<char> getFreeBuffer();
+  void writeQueued();
+  void stopAsyncWriting();
 
   enum RoMode_t { NotSet,
                   Continuous,
@@ -429,8 +441,26 @@ class RawFileWriter
   std::map<IR, CacheEntry> mCacheMap;
   //<< caching -------------
 
+  //>> asynchronous writing --------------
+  struct WriteRequest {
+    OutputFile* file = nullptr;
+    std::vector<char> data;
+  };
+  bool mAsyncWriting = false;
+  bool mStopWriting = false;
+  size_t mMaxQueuedBytes = 0;
+  size_t mQueuedBytes = 0;
+  std::deque<WriteRequest> mWriteQueue;        //! superpages waiting to be written
+  std::vector<std::vector<char>> mFreeBuffers; //! written superpage buffers to be reused by the links
+  std::mutex mWriteMtx;
+  std::condition_variable mWriteCond;   //! new request or stop for the writing thread
+  std::condition_variable mWrittenCond; //! space freed in the queue
+  std::thread mWriterThread;            //!
+  //<< asynchronous writing -------------
+
   TStopwatch mTimer;
   RoMode_t mROMode = NotSet;
+  std::mutex mFirstIRMtx;
   IR mFirstIRAdded; // 1st IR seen
   DetLazinessCheck mDetLazyCheck{};
   bool mDoLazinessCheck = true;
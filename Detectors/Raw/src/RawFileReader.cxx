@@ -30,6 +30,8 @@
 #include <Common/Configuration.h>
 #include <TStopwatch.h>
 #include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 using namespace o2::raw;
 namespace o2h = o2::header;
@@ -134,8 +136,7 @@ size_t RawFileReader::LinkData::readNextHBF(char* buff)
     if (blc.dataCache) {
       memcpy(buff + sz, blc.dataCache.get(), blc.size);
     } else {
-      auto fl = reader->mFiles[blc.fileID];
-      if (fseek(fl, blc.offset, SEEK_SET) || fread(buff + sz, 1, blc.size, fl) != blc.size) {
+      if (!reader->readFileData(blc.fileID, blc.offset, blc.size, buff + sz)) {
         LOGF(error, "Failed to read for the %s a bloc:", describe());
         blc.print();
         error = true;
@@ -288,8 +289,7 @@ size_t RawFileReader::LinkData::readNextSuperPage(char* buff, const RawFileReade
     if (reader->mCacheData && blocks[nextBlock2Read].dataCache) {
       memcpy(buff, blocks[nextBlock2Read].dataCache.get(), sz);
     } else {
-      auto fl = reader->mFiles[blocks[nextBlock2Read].fileID];
-      if (fseek(fl, blocks[nextBlock2Read].offset, SEEK_SET) || fread(buff, 1, sz, fl) != sz) {
+      if (!reader->readFileData(blocks[nextBlock2Read].fileID, blocks[nextBlock2Read].offset, sz, buff)) {
         LOGF(error, "Failed to read for the %s a bloc:", describe());
         blocks[nextBlock2Read].print();
         error = true;
@@ -662,6 +662,7 @@ void RawFileReader::clear()
   mLinkEntries.clear();
   mOrderedIDs.clear();
   mLinksData.clear();
+  unmapFiles();
   for (auto fl : mFiles) {
     fclose(fl);
   }
@@ -783,11 +784,67 @@ bool RawFileReader::init()
   if (!mCheckErrors) {
     LOGF(info, "Detailed data format check was disabled");
   }
+  if (mMapFiles) {
+    mapFiles();
+  }
   mInitDone = true;
 
   return !mEmpty;
 }
 
+//_____________________________________________________________________
+bool RawFileReader::readFileData(int fileID, size_t offset, size_t size, char* dest)
+{
+  // read size bytes at offset of the file fileID, from its mapping if any
+  if (!mFileMaps.empty()) {
+    const auto& [data, fileSize] = mFileMaps[fileID];
+    if (offset + size > fileSize) {
+      return false;
+    }
+    memcpy(dest, data + offset, size);
+    return true;
+  }
+  auto fl = mFiles[fileID];
+  return !fseek(fl, offset, SEEK_SET) && fread(dest, 1, size, fl) == size;
+}
+
+//_____________________________________________________________________
+void RawFileReader::mapFiles()
+{
+  // map the input files, the data are then copied directly from the page cache to the output messages,
+  // w/o the extra system call and copy of the fread. The files are read mostly sequentially, so the kernel
+  // is asked for an aggressive read-ahead of the mapped data.
+  for (int i = 0; i < int(mFiles.size()); i++) {
+    int fd = fileno(mFiles[i]);
+    struct stat statbuf;
+    void* ptr = MAP_FAILED;
+    if (fstat(fd, &statbuf) == 0 && statbuf.st_size > 0) {
+      ptr = mmap(nullptr, statbuf.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    if (ptr == MAP_FAILED) {
+      LOG(error) << "Failed to map input file " << mFileNames[i] << ", will read the files with fread";
+      unmapFiles();
+      return;
+    }
+    madvise(ptr, statbuf.st_size, MADV_SEQUENTIAL);
+    mFileMaps.emplace_back(reinterpret_cast<const char*>(ptr), statbuf.st_size);
+  }
+  LOGF(info, "Reading data from the mappings of %zu files", mFileMaps.size());
+  if (mCacheData) {
+    LOGF(info, "The data of the mapped files stay in the page cache, disabling the data caching");
+    mCacheData = false;
+  }
+}
+
+//_____________________________________________________________________
+void RawFileReader::unmapFiles()
+{
+  for (auto [data, size] : mFileMaps) {
+    munmap(const_cast<char*>(data), size);
+  }
+  mFileMaps.clear();
+}
+
 //_____________________________________________________________________
 o2h::DataOrigin RawFileReader::getDataOrigin(const std::string& ors)
 {
@@ -102,6 +102,7 @@ RawReaderSpecs::RawReaderSpecs(const ReaderInp& rinp)
   mReader->setMaxTFToRead(rinp.maxTF);
   mReader->setNominalSPageSize(rinp.spSize);
   mReader->setCacheData(rinp.cache);
+  mReader->setMapFiles(rinp.mapFiles);
   mReader->setTFAutodetect(rinp.autodetectTF0 ? RawFileReader::FirstTFDetection::Pending : RawFileReader::FirstTFDetection::Disabled);
   mReader->setPreferCalculatedTFStart(rinp.preferCalcTF);
   LOG(info) << "Will preprocess files with buffer size of " << rinp.bufferSize << " bytes";
@@ -18,6 +18,7 @@
 #include <sstream>
 #include <functional>
 #include <cassert>
+#include <algorithm>
 #include "CommonUtils/NameConf.h"
 #include "DetectorsRaw/RawFileWriter.h"
 #include "DetectorsRaw/HBFUtils.h"
@@ -39,6 +40,7 @@ void RawFileWriter::close()
 {
   // finalize all links
   if (mFName2File.empty()) {
+    stopAsyncWriting();
     return;
   }
   if (mCachingStage) {
@@ -61,6 +63,7 @@ void RawFileWriter::close()
       lnk.second.print();
     }
   }
+  stopAsyncWriting(); // wait for all queued superpages to be written
   //
   // close all files
   for (auto& flh : mFName2File) {
@@ -200,9 +203,12 @@ void RawFileWriter::addData(uint16_t feeid, uint16_t cru, uint8_t lnk, uint8_t e
     }
     return;
   }
-  if (ir < mFirstIRAdded) {
-    mHBFUtils.checkConsistency(); // done only once
-    mFirstIRAdded = ir;
+  {
+    std::lock_guard<std::mutex> lock(mFirstIRMtx);
+    if (ir < mFirstIRAdded) {
+      mHBFUtils.checkConsistency(); // done only once
+      mFirstIRAdded = ir;
+    }
   }
   if (mDoLazinessCheck && !mCachingStage) {
     mDetLazyCheck.completeLinks(this, ir); // make sure that all links for previously called IR got their addData call
@@ -280,6 +286,91 @@ void RawFileWriter::useCaching()
   LOG(info) << "Switched caching ON";
 }
 
+//___________________________________________________________________________________
+void RawFileWriter::useAsyncWriting(size_t maxQueuedMB)
+{
+  // write the flushed superpages in a separate thread
+  if (mAsyncWriting) {
+    return; // already done
+  }
+  mMaxQueuedBytes = std::max(maxQueuedMB << 20, size_t(mSuperPageSize));
+  mStopWriting = false;
+  mAsyncWriting = true;
+  mWriterThread = std::thread(&RawFileWriter::writeQueued, this);
+  LOG(info) << "Switched asynchronous writing ON, up to " << (mMaxQueuedBytes >> 20) << " MB queued";
+}
+
+//___________________________________________________________________________________
+void RawFileWriter::stopAsyncWriting()
+{
+  // write what is still queued and stop the writing thread
+  if (!mAsyncWriting) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mWriteMtx);
+    mStopWriting = true;
+  }
+  mWriteCond.notify_one();
+  mWriterThread.join();
+  mAsyncWriting = false;
+  mFreeBuffers.clear();
+}
+
+//___________________________________________________________________________________
+void RawFileWriter::queueWrite(OutputFile& file, std::vector<char>&& data)
+{
+  // queue the data for writing, waiting if too much is pending
+  std::unique_lock<std::mutex> lock(mWriteMtx);
+  mWrittenCond.wait(lock, [this] { return mQueuedBytes < mMaxQueuedBytes; });
+  mQueuedBytes += data.size();
+  mWriteQueue.push_back(WriteRequest{&file, std::move(data)});
+  lock.unlock();
+  mWriteCond.notify_one();
+}
+
+//___________________________________________________________________________________
+std::vector<char> RawFileWriter::getFreeBuffer()
+{
+  // empty buffer for the superpage, recycled from those already written if possible
+  std::vector<char> buff;
+  {
+    std::lock_guard<std::mutex> lock(mWriteMtx);
+    if (!mFreeBuffers.empty()) {
+      buff.swap(mFreeBuffers.back());
+      mFreeBuffers.pop_back();
+    }
+  }
+  if (buff.capacity() < size_t(mSuperPageSize)) {
+    buff.reserve(mSuperPageSize);
+  }
+  return buff;
+}
+
+//___________________________________________________________________________________
+void RawFileWriter::writeQueued()
+{
+  // loop of the writing thread: write the queued superpages in the order of their arrival
+  std::unique_lock<std::mutex> lock(mWriteMtx);
+  while (true) {
+    mWriteCond.wait(lock, [this] { return mStopWriting || !mWriteQueue.empty(); });
+    if (mWriteQueue.empty()) {
+      return; // stop requested and everything is written
+    }
+    auto req = std::move(mWriteQueue.front());
+    mWriteQueue.pop_front();
+    lock.unlock();
+    req.file->write(req.data.data(), req.data.size());
+    lock.lock();
+    mQueuedBytes -= req.data.size();
+    if (mFreeBuffers.size() * mSuperPageSize < mMaxQueuedBytes) {
+      req.data.clear();
+      mFreeBuffers.emplace_back(std::move(req.data));
+    }
+    mWrittenCond.notify_all();
+  }
+}
+
 //===================================================================================
 
 //___________________________________________________________________________________
@@ -602,8 +693,21 @@ void RawFileWriter::LinkData::flushSuperPage(bool keepLastPage)
   if (writer->mVerbosity) {
     LOGF(info, "Flushing super page of %u bytes for %s", pgSize, describe());
   }
-  writer->mFName2File.find(fileName)->second.write(buffer.data(), pgSize);
   auto toMove = buffer.size() - pgSize;
+  if (writer->mAsyncWriting) { // hand over the buffer to the writing thread, continue with a free one
+    auto out = writer->getFreeBuffer();
+    out.swap(buffer);
+    if (toMove) {
+      buffer.insert(buffer.end(), out.begin() + pgSize, out.end());
+      out.resize(pgSize);
+      lastRDHoffset -= pgSize;
+    } else {
+      lastRDHoffset = -1;
+    }
+    writer->queueWrite(writer->mFName2File.find(fileName)->second, std::move(out));
+    return;
+  }
+  writer->mFName2File.find(fileName)->second.write(buffer.data(), pgSize);
   if (toMove) { // is there something left in the buffer, move it to the beginning of the buffer
     if (toMove > pgSize) {
       memcpy(buffer.data(), &buffer[pgSize], toMove);
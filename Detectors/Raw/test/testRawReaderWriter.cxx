@@ -318,6 +318,18 @@ BOOST_AUTO_TEST_CASE(RawReaderWriter_CRU)
   dr.run(); // read back and check
 }
 
+BOOST_AUTO_TEST_CASE(RawReaderWriter_CRU_AsyncWriting)
+{
+  TestRawWriter dw{"TST", true, "test_raw_conf_GBT_async.cfg"};
+  dw.init();
+  dw.writer.useAsyncWriting(1); // small queue to exercise the waiting of the links for the writing thread
+  dw.run();
+  //
+  TestRawReader dr{"TST", "test_raw_conf_GBT_async.cfg"};
+  dr.init();
+  dr.run();
+}
+
 BOOST_AUTO_TEST_CASE(RawReaderWriter_RORC)
 {
   TestRawWriter dw{"TST", false, "test_raw_conf_DDL.cfg"}; // this is RORC detector with origin TST
@@ -470,7 +470,9 @@ void TOFChannelCalibrator<T>::finalizeSlotWithCosmics(Slot& slot)
     double xp[NCOMBINSTRIP], exp[NCOMBINSTRIP], deltat[NCOMBINSTRIP], edeltat[NCOMBINSTRIP];
 
     std::array<double, 3> fitValues;
-    std::vector<float> histoValues;
+    std::vector<float> histoValues(NCOMBINSTRIP * nbins); // histograms of all pairs of a strip, fitted in one batch
+    std::array<std::array<double, 3>, NCOMBINSTRIP> fitValuesStrip;
+    std::array<double, NCOMBINSTRIP> fitResStrip;
 
     auto& histo = c->getHisto(sector);
 
@@ -490,6 +492,21 @@ void TOFChannelCalibrator<T>::finalizeSlotWithCosmics(Slot& slot)
 
       localFitter.StoreData(kFALSE);
       localFitter.ClearPoints();
+
+      // make the slices of the 2D histogram so that we have the 1D histograms of the pairs of the current strip
+      std::fill(histoValues.begin(), histoValues.end(), 0);
+      for (int ipair = 0; ipair < NCOMBINSTRIP; ipair++) {
+        int chinsector = ipair + offsetPairInStrip;
+        auto entriesInPair = entriesPerChannel.at(chinsector + offsetPairInSector);
+        if (entriesInPair == 0 || entriesInPair < mMinEntries) {
+          continue; // the pair is not calibrated, the empty histogram is skipped by the fit
+        }
+        for (unsigned i = 0; i < nbins; ++i) {
+          histoValues[ipair * nbins + i] = histo.at(i, chinsector);
+        }
+      }
+      o2::math_utils::fitGausBatch(NCOMBINSTRIP, nbins, histoValues.data(), -range, range, fitValuesStrip.data(), fitResStrip.data(), 2., true);
+
       for (int ipair = 0; ipair < NCOMBINSTRIP; ipair++) {
         int chinsector = ipair + offsetPairInStrip;
         int ich = chinsector + offsetPairInSector;
@@ -507,18 +524,8 @@ void TOFChannelCalibrator<T>::finalizeSlotWithCosmics(Slot& slot)
           allpoints++;
           continue;
         }
-        fitValues.fill(-99999999);
-        histoValues.clear();
-
-        // make the slice of the 2D histogram so that we have the 1D of the current channel
-        for (unsigned i = 0; i < nbins; ++i) {
-          const auto& v = histo.at(i, chinsector);
-          LOG(debug) << "channel = " << ich << ", in sector = " << sector << " (where it is channel = " << chinsector << ") bin = " << i << " value = " << v;
-          histoValues.push_back(v);
-        }
-
-        double fitres = entriesInPair - 1;
-        fitres = fitGaus(nbins, histoValues.data(), -range, range, fitValues, nullptr, 2., true);
+        fitValues = fitValuesStrip[ipair];
+        double fitres = fitResStrip[ipair];
         if (fitres >= 0) {
           LOG(debug) << "Pair " << ich << " :: Fit result " << fitres << " Mean = " << fitValues[1] << " Sigma = " << fitValues[2];
         } else {
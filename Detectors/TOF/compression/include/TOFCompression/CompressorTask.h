@@ -21,6 +21,8 @@
 #include "Framework/DataProcessorSpec.h"
 #include "TOFCompression/Compressor.h"
 #include <fstream>
+#include <memory>
+#include <vector>
 
 using namespace o2::framework;
 
@@ -39,7 +41,7 @@ class CompressorTask : public Task
   void run(ProcessingContext& pc) final;
 
  private:
-  Compressor<RDH, verbose, paranoid> mCompressor;
+  std::vector<std::unique_ptr<Compressor<RDH, verbose, paranoid>>> mCompressors; // one per thread
   int mOutputBufferSize;
   long mPayloadLimit = -1;
 };
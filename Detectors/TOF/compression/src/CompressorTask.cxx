@@ -21,6 +21,9 @@
 #include "Framework/DataSpecUtils.h"
 #include "Framework/InputRecordWalker.h"
 #include "CommonUtils/VerbosityConfig.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
 
 using namespace o2::framework;
 
@@ -41,14 +44,22 @@ void CompressorTask<RDH, verbose, paranoid>::init(InitContext& ic)
   auto encoderVerbose = ic.options().get<bool>("tof-compressor-encoder-verbose");
   auto checkerVerbose = ic.options().get<bool>("tof-compressor-checker-verbose");
   mOutputBufferSize = ic.options().get<int>("tof-compressor-output-buffer-size");
-
-  mCompressor.setDecoderCONET(decoderCONET);
-  mCompressor.setDecoderVerbose(decoderVerbose);
-  mCompressor.setEncoderVerbose(encoderVerbose);
-  mCompressor.setCheckerVerbose(checkerVerbose);
+  auto nThreads = std::max(1, ic.options().get<int>("tof-compressor-threads"));
+  LOG(info) << "Compressor processes the links of a TF with " << nThreads << " threads";
+
+  mCompressors.clear();
+  for (int i = 0; i < nThreads; i++) {
+    auto& compressor = mCompressors.emplace_back(std::make_unique<Compressor<RDH, verbose, paranoid>>());
+    compressor->setDecoderCONET(decoderCONET);
+    compressor->setDecoderVerbose(decoderVerbose);
+    compressor->setEncoderVerbose(encoderVerbose);
+    compressor->setCheckerVerbose(checkerVerbose);
+  }
 
   auto finishFunction = [this]() {
-    mCompressor.checkSummary();
+    for (auto& compressor : mCompressors) {
+      compressor->checkSummary();
+    }
   };
 
   ic.services().get<CallbackService>().set<CallbackService::Id::Stop>(finishFunction);
@@ -111,11 +122,19 @@ void CompressorTask<RDH, verbose, paranoid>::run(ProcessingContext& pc)
     //  }
   }
 
-  /** loop over subspecs **/
+  /** prepare the output of each subspec, the links are then compressed in parallel, each into its own buffer **/
+  struct SubspecOutput {
+    const std::vector<o2::framework::DataRef>& parts;
+    o2::header::DataHeader headerOut;
+    o2::pmr::vector<char> v;
+    long bufferSize;
+  };
+  std::vector<SubspecOutput> subspecOutputs;
+  subspecOutputs.reserve(subspecPartMap.size());
   for (auto& subspecPartEntry : subspecPartMap) {
 
     auto subspec = subspecPartEntry.first;
-    auto parts = subspecPartEntry.second;
+    const auto& parts = subspecPartEntry.second;
     auto& firstPart = parts.at(0);
 
     /** use the first part to define output headers **/
@@ -130,13 +149,19 @@ void CompressorTask<RDH, verbose, paranoid>::run(ProcessingContext& pc)
     auto output = Output{headerOut.dataOrigin, "CRAWDATA", headerOut.subSpecification};
     auto&& v = pc.outputs().makeVector<char>(output);
     v.resize(bufferSizeDouble);
+    subspecOutputs.push_back(SubspecOutput{parts, headerOut, std::move(v), bufferSize});
+  }
+
+  /** compress the parts of a subspec with the given compressor **/
+  auto compressSubspec = [this](Compressor<RDH, verbose, paranoid>& compressor, SubspecOutput& out) {
     // Better way of doing this would be to used an offset, so that we can resize the vector
     // as well. However, this should be good enough because bufferSize overestimates the size
     // of the payload.
-    auto bufferPointer = v.data();
+    auto bufferPointer = out.v.data();
+    auto bufferSize = out.bufferSize;
 
     /** loop over subspec parts **/
-    for (const auto& ref : parts) {
+    for (const auto& ref : out.parts) {
       /** input **/
       auto payloadIn = ref.payload;
       auto payloadInSize = DataRefUtils::getPayloadSize(ref);
@@ -147,25 +172,51 @@ void CompressorTask<RDH, verbose, paranoid>::run(ProcessingContext& pc)
       }
 
       /** prepare compressor **/
-      mCompressor.setDecoderBuffer(payloadIn);
-      mCompressor.setDecoderBufferSize(payloadInSize);
-      mCompressor.setEncoderBuffer(bufferPointer);
-      mCompressor.setEncoderBufferSize(bufferSize);
+      compressor.setDecoderBuffer(payloadIn);
+      compressor.setDecoderBufferSize(payloadInSize);
+      compressor.setEncoderBuffer(bufferPointer);
+      compressor.setEncoderBufferSize(bufferSize);
 
       /** run **/
-      mCompressor.run();
-      auto payloadOutSize = mCompressor.getEncoderByteCounter();
+      compressor.run();
+      auto payloadOutSize = compressor.getEncoderByteCounter();
       bufferPointer += payloadOutSize;
       bufferSize -= payloadOutSize;
-      headerOut.payloadSize += payloadOutSize;
+      out.headerOut.payloadSize += payloadOutSize;
+    }
+  };
+
+  /** loop over subspecs, the threads pick the next subspec to compress from a shared counter **/
+  size_t nThreads = std::min(mCompressors.size(), subspecOutputs.size());
+  if (nThreads > 1) {
+    std::atomic<size_t> nextSubspec{0};
+    auto worker = [&](size_t ithread) {
+      for (size_t i = nextSubspec++; i < subspecOutputs.size(); i = nextSubspec++) {
+        compressSubspec(*mCompressors[ithread], subspecOutputs[i]);
+      }
+    };
+    std::vector<std::thread> threads;
+    for (size_t ithread = 1; ithread < nThreads; ithread++) {
+      threads.emplace_back(worker, ithread);
+    }
+    worker(0);
+    for (auto& t : threads) {
+      t.join();
     }
+  } else {
+    for (auto& out : subspecOutputs) {
+      compressSubspec(*mCompressors[0], out);
+    }
+  }
 
-    if (headerOut.payloadSize > bufferSizeDouble) {
-      headerOut.payloadSize = 0; // put payload to zero, otherwise it will trigger a crash
+  /** send the outputs in the order of the subspecs **/
+  for (auto& out : subspecOutputs) {
+    if (out.headerOut.payloadSize > out.v.size()) {
+      out.headerOut.payloadSize = 0; // put payload to zero, otherwise it will trigger a crash
     }
 
-    v.resize(headerOut.payloadSize);
-    pc.outputs().adoptContainer(output, std::move(v));
+    out.v.resize(out.headerOut.payloadSize);
+    pc.outputs().adoptContainer(Output{out.headerOut.dataOrigin, "CRAWDATA", out.headerOut.subSpecification}, std::move(out.v));
   }
 }
 
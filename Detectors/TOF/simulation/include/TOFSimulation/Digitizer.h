@@ -111,10 +111,36 @@ class Digitizer : public WindowFiller
   // final vector of tof readout window MC
   std::vector<o2::dataformats::MCTruthContainer<o2::MCCompLabel>> mMCTruthOutputContainerPerTimeFrame;
 
+  // temporary MC info of the digits in a tof readout window: the first label of every digit and, chained to it,
+  // the labels of the merged hits. Adding a label to an existing digit is O(1), the labels are sorted in tdc
+  // only when the window is flushed
+  struct LabelRef {
+    o2::tof::MCLabel label;
+    int next = -1; ///< next label of the same digit in mExtra, -1 if none
+  };
+  struct WindowLabels {
+    std::vector<LabelRef> mFirst; ///< first label of every digit
+    std::vector<LabelRef> mExtra; ///< labels of the merged contributions
+    int getIndexedSize() const { return mFirst.size(); }
+    void addDigit(const o2::tof::MCLabel& label) { mFirst.push_back(LabelRef{label}); }
+    void addMergedLabel(int lbl, const o2::tof::MCLabel& label)
+    {
+      mExtra.push_back(LabelRef{label, mFirst[lbl].next});
+      mFirst[lbl].next = mExtra.size() - 1;
+    }
+    void clear()
+    {
+      mFirst.clear();
+      mExtra.clear();
+    }
+  };
+
   // temporary MC info in the current tof readout windows
-  o2::dataformats::MCTruthContainer<o2::tof::MCLabel> mMCTruthContainer[MAXWINDOWS];
-  o2::dataformats::MCTruthContainer<o2::tof::MCLabel>* mMCTruthContainerCurrent = &mMCTruthContainer[0]; ///< Array for MCTruth information associated to digits in mDigitsArrray.
-  o2::dataformats::MCTruthContainer<o2::tof::MCLabel>* mMCTruthContainerNext[MAXWINDOWS - 1];            ///< Array for MCTruth information associated to digits in mDigitsArrray.
+  WindowLabels mMCTruthContainer[MAXWINDOWS];                     //!
+  WindowLabels* mMCTruthContainerCurrent = &mMCTruthContainer[0]; //! Array for MCTruth information associated to digits in mDigitsArrray.
+  WindowLabels* mMCTruthContainerNext[MAXWINDOWS - 1];            //! Array for MCTruth information associated to digits in mDigitsArrray.
+  std::vector<o2::tof::MCLabel> mDigitLabels;                     //! buffer for the labels of a digit when flushing a window
+  std::vector<bool> mFutureToRemove;                              //! future digits moved to a readout window or lost
   o2::dataformats::MCTruthContainer<o2::MCCompLabel>* mMCTruthOutputContainer;
 
   // arrays with digit and MCLabels out of the current readout windows (stored to fill future readout window)
@@ -126,7 +152,7 @@ class Digitizer : public WindowFiller
 
   CalibApi* mCalibApi = nullptr; //! calib api to handle the TOF calibration
 
-  void fillDigitsInStrip(std::vector<Strip>* strips, o2::dataformats::MCTruthContainer<o2::tof::MCLabel>* mcTruthContainer, int channel, int tdc, int tot, uint64_t nbc, UInt_t istrip, Int_t trackID, Int_t eventID, Int_t sourceID);
+  void fillDigitsInStrip(std::vector<Strip>* strips, WindowLabels* mcTruthContainer, int channel, int tdc, int tot, uint64_t nbc, UInt_t istrip, Int_t trackID, Int_t eventID, Int_t sourceID);
 
   Int_t processHit(const HitType& hit, Double_t event_time);
   void addDigit(Int_t channel, UInt_t istrip, Double_t time, Float_t x, Float_t z, Float_t charge, Int_t iX, Int_t iZ, Int_t padZfired,
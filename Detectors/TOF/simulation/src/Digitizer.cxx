@@ -368,7 +368,7 @@ void Digitizer::addDigit(Int_t channel, UInt_t istrip, Double_t time, Float_t x,
   //printf("add TOF digit c=%i n=%i\n",iscurrent,isnext);
 
   std::vector<Strip>* strips;
-  o2::dataformats::MCTruthContainer<o2::tof::MCLabel>* mcTruthContainer;
+  WindowLabels* mcTruthContainer;
 
   if (iscurrent) {
     strips = mStripsCurrent;
@@ -393,7 +393,7 @@ void Digitizer::addDigit(Int_t channel, UInt_t istrip, Double_t time, Float_t x,
   }
 }
 //______________________________________________________________________
-void Digitizer::fillDigitsInStrip(std::vector<Strip>* strips, o2::dataformats::MCTruthContainer<o2::tof::MCLabel>* mcTruthContainer, int channel, int tdc, int tot, uint64_t nbc, UInt_t istrip, Int_t trackID, Int_t eventID, Int_t sourceID)
+void Digitizer::fillDigitsInStrip(std::vector<Strip>* strips, WindowLabels* mcTruthContainer, int channel, int tdc, int tot, uint64_t nbc, UInt_t istrip, Int_t trackID, Int_t eventID, Int_t sourceID)
 {
   int lblCurrent;
   if (mcTruthContainer) {
@@ -403,17 +403,11 @@ void Digitizer::fillDigitsInStrip(std::vector<Strip>* strips, o2::dataformats::M
   Int_t lbl = (*strips)[istrip].addDigit(channel, tdc, tot * Geo::NTOTBIN_PER_NS, nbc, lblCurrent);
 
   if (mcTruthContainer) {
+    o2::tof::MCLabel label(trackID, eventID, sourceID, tdc);
     if (lbl == lblCurrent) { // it means that the digit was a new one --> we have to add the info in the MC container
-      o2::tof::MCLabel label(trackID, eventID, sourceID, tdc);
-      mcTruthContainer->addElement(lbl, label);
+      mcTruthContainer->addDigit(label);
     } else {
-      o2::tof::MCLabel label(trackID, eventID, sourceID, tdc);
-      mcTruthContainer->addElementRandomAccess(lbl, label);
-
-      // sort the labels according to increasing tdc value
-      auto labels = mcTruthContainer->getLabels(lbl);
-      std::sort(labels.begin(), labels.end(),
-                [](o2::tof::MCLabel a, o2::tof::MCLabel b) { return a.getTDC() < b.getTDC(); });
+      mcTruthContainer->addMergedLabel(lbl, label); // sorted in tdc when the window is flushed
     }
   }
 }
@@ -898,19 +892,15 @@ void Digitizer::fillOutputContainer(std::vector<Digit>& digits)
       for (auto& strip : *mStripsCurrent) {
         std::map<ULong64_t, o2::tof::Digit>& dmap = strip.getDigitMap();
 
-        std::vector<ULong64_t> keyToBeRemoved;
-
-        for (auto [key, dig] : dmap) {
-          int crate = Geo::getCrateFromECH(Geo::getECHFromCH(dig.getChannel()));
+        for (auto it = dmap.begin(); it != dmap.end();) {
+          int crate = Geo::getCrateFromECH(Geo::getECHFromCH(it->second.getChannel()));
 
-          if (isEmptyCrate[crate] || mCalibApi->isChannelError(dig.getChannel())) {
-            // flag digits to be removed
-            keyToBeRemoved.push_back(key);
+          if (isEmptyCrate[crate] || mCalibApi->isChannelError(it->second.getChannel())) {
+            it = dmap.erase(it); // remove digits of empty crates or channels in error
+          } else {
+            ++it;
           }
         }
-        for (auto& key : keyToBeRemoved) {
-          dmap.erase(key);
-        }
 
         strip.fillOutputContainer(digits);
       }
@@ -928,10 +918,20 @@ void Digitizer::fillOutputContainer(std::vector<Digit>& digits)
 
   // copying the transient labels to the output labels (stripping the tdc information)
   if (mMCTruthOutputContainer) {
-    // copy from transientTruthContainer to mMCTruthAray
-    // a brute force solution for the moment; should be handled by a dedicated API
-    for (int index = 0; index < mMCTruthContainerCurrent->getIndexedSize(); ++index) {
-      mMCTruthOutputContainer->addElements(index, mMCTruthContainerCurrent->getLabels(index));
+    // copy from transientTruthContainer to mMCTruthAray, with the labels of each digit sorted according to increasing tdc value
+    const auto& first = mMCTruthContainerCurrent->mFirst;
+    const auto& extra = mMCTruthContainerCurrent->mExtra;
+    for (int index = 0; index < (int)first.size(); ++index) {
+      mDigitLabels.clear();
+      mDigitLabels.push_back(first[index].label);
+      for (int next = first[index].next; next >= 0; next = extra[next].next) {
+        mDigitLabels.push_back(extra[next].label);
+      }
+      if (mDigitLabels.size() > 1) {
+        std::sort(mDigitLabels.begin(), mDigitLabels.end(),
+                  [](const o2::tof::MCLabel& a, const o2::tof::MCLabel& b) { return a.getTDC() < b.getTDC(); });
+      }
+      mMCTruthOutputContainer->addElements(index, mDigitLabels);
     }
   }
 
@@ -991,9 +991,12 @@ void Digitizer::checkIfReuseFutureDigits()
   uint64_t bclimit = 999999999999999999;
 
   // check if digits stored very far in future match the new readout windows currently available
-  int idigit = mFutureDigits.size() - 1;
+  // the digits moved to a readout window (or lost) are flagged and removed in one pass at the end
+  mFutureToRemove.assign(mFutureDigits.size(), false);
+  bool anyToRemove = false;
 
-  for (std::vector<Digit>::reverse_iterator digit = mFutureDigits.rbegin(); digit != mFutureDigits.rend(); ++digit) {
+  for (int idigit = mFutureDigits.size() - 1; idigit >= 0; idigit--) {
+    const auto* digit = &mFutureDigits[idigit];
     if (digit->getBC() > bclimit) {
       break;
     }
@@ -1016,31 +1019,14 @@ void Digitizer::checkIfReuseFutureDigits()
       LOG(info) << "Digit lost because we jump too ahead in future. Current RO window=" << isnext << "\n";
 
       // remove digit from array in the future
-      int labelremoved = digit->getLabel();
-      mFutureDigits.erase(mFutureDigits.begin() + idigit);
-
-      /* NOT TO REMOVE LABELS TO SAVE CPU TIME (clear of vector when flushing)
-      // remove also the element from the buffers
-      mFutureItrackID.erase(mFutureItrackID.begin() + digit->getLabel());
-      mFutureIsource.erase(mFutureIsource.begin() + digit->getLabel());
-      mFutureIevent.erase(mFutureIevent.begin() + digit->getLabel());
-
-      // adjust labels
-      for (auto& digit2 : mFutureDigits) {
- if (digit2.getLabel() > labelremoved) {
-   digit2.setLabel(digit2.getLabel() - 1);
- }
-      }
-      */
-
-      idigit--;
-
+      // (labels are not removed from the buffers to save CPU time, they are cleared when flushing)
+      mFutureToRemove[idigit] = anyToRemove = true;
       continue;
     }
 
     if (isnext < MAXWINDOWS - 1) { // move from digit buffer array to the proper window
       std::vector<Strip>* strips = mStripsCurrent;
-      o2::dataformats::MCTruthContainer<o2::tof::MCLabel>* mcTruthContainer = mMCTruthContainerCurrent;
+      WindowLabels* mcTruthContainer = mMCTruthContainerCurrent;
 
       if (isnext) {
         strips = mStripsNext[isnext - 1];
@@ -1054,27 +1040,20 @@ void Digitizer::checkIfReuseFutureDigits()
 
       if (isIfOverlap < 0) { // if there is no overlap candidate
         // remove digit from array in the future
-        int labelremoved = digit->getLabel();
-        mFutureDigits.erase(mFutureDigits.begin() + idigit);
-
-        /* NOT TO REMOVE LABELS TO SAVE CPU TIME (clear of vector when flushing)
- // remove also the element from the buffers
- mFutureItrackID.erase(mFutureItrackID.begin() + digit->getLabel());
- mFutureIsource.erase(mFutureIsource.begin() + digit->getLabel());
- mFutureIevent.erase(mFutureIevent.begin() + digit->getLabel());
-
- // adjust labels
- for (auto& digit2 : mFutureDigits) {
-   if (digit2.getLabel() > labelremoved) {
-     digit2.setLabel(digit2.getLabel() - 1);
-   }
- }
- */
+        mFutureToRemove[idigit] = anyToRemove = true;
       }
     } else {
       bclimit = digit->getBC();
     }
+  } // close future digit loop
 
-    idigit--; // go back to the next position in the reverse iterator
-  }           // close future digit loop
+  if (anyToRemove) {
+    int nKept = 0;
+    for (int idigit = 0; idigit < (int)mFutureDigits.size(); idigit++) {
+      if (!mFutureToRemove[idigit]) {
+        mFutureDigits[nKept++] = mFutureDigits[idigit];
+      }
+    }
+    mFutureDigits.resize(nKept);
+  }
 }
@@ -126,6 +126,21 @@ class CalArray
   /// Divide this by other channel by channel
   const CalArray& operator/=(const CalArray& other);
 
+  /// Add other scaled by factor to this channel by channel (this += factor * other), avoiding a temporary copy of other
+  const CalArray& addScaled(const CalArray& other, const T& factor);
+
+  /// Replace each value by func(value)
+  template <typename Func>
+  const CalArray& transform(Func func)
+  {
+    std::transform(mData.begin(), mData.end(), mData.begin(), func);
+    return *this;
+  }
+
+  /// Replace each value by func(value, value of other) channel by channel
+  template <typename Func>
+  const CalArray& transform(const CalArray& other, Func func);
+
   /// check for equality
   bool operator==(const CalArray& other) const;
 
@@ -281,14 +296,42 @@ inline const CalArray<T>& CalArray<T>::operator/=(const CalArray<T>& other)
     LOG(error) << "pad subset type of the objects it not compatible";
     return *this;
   }
+  size_t nZero = 0;
   for (size_t i = 0; i < mData.size(); ++i) {
-    if (other.getValue(i) != 0) {
-      mData[i] /= other.getValue(i);
-    } else {
-      mData[i] = 0;
-      LOG(debug) << "Division by 0 detected! Value was set to 0.";
-    }
+    const T div = other.mData[i];
+    nZero += (div == 0);
+    mData[i] = (div != 0) ? mData[i] / div : T{0};
+  }
+  if (nZero) {
+    LOG(debug) << "Division by 0 detected for " << nZero << " values! Values were set to 0.";
+  }
+  return *this;
+}
+
+//______________________________________________________________________________
+template <class T>
+inline const CalArray<T>& CalArray<T>::addScaled(const CalArray<T>& other, const T& factor)
+{
+  if (!((mPadSubset == other.mPadSubset) && (mPadSubsetNumber == other.mPadSubsetNumber))) {
+    LOG(error) << "pad subset type of the objects it not compatible";
+    return *this;
+  }
+  for (size_t i = 0; i < mData.size(); ++i) {
+    mData[i] += factor * other.mData[i];
+  }
+  return *this;
+}
+
+//______________________________________________________________________________
+template <class T>
+template <typename Func>
+inline const CalArray<T>& CalArray<T>::transform(const CalArray<T>& other, Func func)
+{
+  if (!((mPadSubset == other.mPadSubset) && (mPadSubsetNumber == other.mPadSubsetNumber))) {
+    LOG(error) << "pad subset type of the objects it not compatible";
+    return *this;
   }
+  std::transform(mData.begin(), mData.end(), other.mData.begin(), mData.begin(), func);
   return *this;
 }
 
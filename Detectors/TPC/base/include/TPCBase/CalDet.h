@@ -91,6 +91,23 @@ class CalDet
   const CalDet& operator/=(const CalDet& other);
   bool operator==(const CalDet& other) const;
 
+  /// this += factor * other for all pads, avoiding a temporary copy of other
+  const CalDet& addScaled(const CalDet& other, const T& factor);
+
+  /// replace each value by func(value)
+  template <typename Func>
+  const CalDet& transform(Func func)
+  {
+    for (auto& cal : mData) {
+      cal.transform(func);
+    }
+    return *this;
+  }
+
+  /// replace each value by func(value, value of other) pad by pad
+  template <typename Func>
+  const CalDet& transform(const CalDet& other, Func func);
+
   const CalDet& operator+=(const T& val);
   const CalDet& operator-=(const T& val);
   const CalDet& operator*=(const T& val);
@@ -99,10 +116,10 @@ class CalDet
   const CalDet& operator=(const T& val);
 
   template <class U>
-  friend CalDet<U> operator+(const CalDet<U>&, const CalDet<U>&);
+  friend CalDet<U> operator+(CalDet<U>, const CalDet<U>&);
 
   template <class U>
-  friend CalDet<U> operator-(const CalDet<U>&, const CalDet<U>&);
+  friend CalDet<U> operator-(CalDet<U>, const CalDet<U>&);
 
   template <typename U = T>
   U getMean() const
@@ -436,20 +453,48 @@ inline bool CalDet<T>::operator==(const CalDet& other) const
 
 //______________________________________________________________________________
 template <class T>
-CalDet<T> operator+(const CalDet<T>& c1, const CalDet<T>& c2)
+inline const CalDet<T>& CalDet<T>::addScaled(const CalDet& other, const T& factor)
+{
+  if (mPadSubset != other.mPadSubset) {
+    LOG(error) << "You are trying to operate on incompatible objects: Pad subset type must be the same on both objects";
+    return *this;
+  }
+  for (size_t i = 0; i < mData.size(); ++i) {
+    mData[i].addScaled(other.mData[i], factor);
+  }
+  return *this;
+}
+
+//______________________________________________________________________________
+template <class T>
+template <typename Func>
+inline const CalDet<T>& CalDet<T>::transform(const CalDet& other, Func func)
+{
+  if (mPadSubset != other.mPadSubset) {
+    LOG(error) << "You are trying to operate on incompatible objects: Pad subset type must be the same on both objects";
+    return *this;
+  }
+  for (size_t i = 0; i < mData.size(); ++i) {
+    mData[i].transform(other.mData[i], func);
+  }
+  return *this;
+}
+
+//______________________________________________________________________________
+// the first argument is taken by value, so that temporaries, e.g. in c1 + c2 + c3, are reused instead of copied
+template <class T>
+CalDet<T> operator+(CalDet<T> c1, const CalDet<T>& c2)
 {
-  CalDet<T> ret(c1);
-  ret += c2;
-  return ret;
+  c1 += c2;
+  return c1;
 }
 
 //______________________________________________________________________________
 template <class T>
-CalDet<T> operator-(const CalDet<T>& c1, const CalDet<T>& c2)
+CalDet<T> operator-(CalDet<T> c1, const CalDet<T>& c2)
 {
-  CalDet<T> ret(c1);
-  ret -= c2;
-  return ret;
+  c1 -= c2;
+  return c1;
 }
 // ===| Full detector initialisation |==========================================
 template <class T>
@@ -312,6 +312,62 @@ BOOST_AUTO_TEST_CASE(CalDet_Arithmetics)
   BOOST_CHECK_EQUAL(isEqual, true);
 }
 
+BOOST_AUTO_TEST_CASE(CalDet_InPlaceOperations)
+{
+  CalPad pad(PadSubset::ROC);
+  CalPad pad2(PadSubset::ROC);
+
+  int iter = 0;
+  for (auto& calArray : pad.getData()) {
+    for (auto& value : calArray.getData()) {
+      value = iter++;
+    }
+  }
+  iter = 1;
+  for (auto& calArray : pad2.getData()) {
+    for (auto& value : calArray.getData()) {
+      value = iter++ % 10; // including 0 for the division
+    }
+  }
+
+  // addScaled
+  bool isEqual = true;
+  CalPad padCmp = pad;
+  padCmp.addScaled(pad2, -0.5f);
+  for (auto itpad = pad.getData().begin(), itpad2 = pad2.getData().begin(), itpadCmp = padCmp.getData().begin(); itpad != pad.getData().end(); ++itpad, ++itpad2, ++itpadCmp) {
+    for (auto itval1 = (*itpad).getData().begin(), itval2 = (*itpad2).getData().begin(), itval3 = (*itpadCmp).getData().begin(); itval1 != (*itpad).getData().end(); ++itval1, ++itval2, ++itval3) {
+      isEqual &= isEqualAbs(*itval3, *itval1 - 0.5f * *itval2);
+    }
+  }
+  BOOST_CHECK_EQUAL(isEqual, true);
+
+  // transform with other object
+  isEqual = true;
+  padCmp = pad;
+  padCmp.transform(pad2, [](const float a, const float b) { return a * b + 1; });
+  for (auto itpad = pad.getData().begin(), itpad2 = pad2.getData().begin(), itpadCmp = padCmp.getData().begin(); itpad != pad.getData().end(); ++itpad, ++itpad2, ++itpadCmp) {
+    for (auto itval1 = (*itpad).getData().begin(), itval2 = (*itpad2).getData().begin(), itval3 = (*itpadCmp).getData().begin(); itval1 != (*itpad).getData().end(); ++itval1, ++itval2, ++itval3) {
+      isEqual &= isEqualAbs(*itval3, *itval1 * *itval2 + 1);
+    }
+  }
+  BOOST_CHECK_EQUAL(isEqual, true);
+
+  // division with zeros
+  isEqual = true;
+  padCmp = pad;
+  padCmp /= pad2;
+  for (auto itpad = pad.getData().begin(), itpad2 = pad2.getData().begin(), itpadCmp = padCmp.getData().begin(); itpad != pad.getData().end(); ++itpad, ++itpad2, ++itpadCmp) {
+    for (auto itval1 = (*itpad).getData().begin(), itval2 = (*itpad2).getData().begin(), itval3 = (*itpadCmp).getData().begin(); itval1 != (*itpad).getData().end(); ++itval1, ++itval2, ++itval3) {
+      isEqual &= isEqualAbs(*itval3, (*itval2 != 0) ? *itval1 / *itval2 : 0.f);
+    }
+  }
+  BOOST_CHECK_EQUAL(isEqual, true);
+
+  // chained binary operators
+  const CalPad sum = pad + pad2 - pad;
+  BOOST_CHECK(sum == pad2);
+}
+
 BOOST_AUTO_TEST_CASE(CalDetTypeTest)
 {
   using namespace o2::framework;
@@ -47,6 +47,8 @@ namespace o2::tpc
 /// c.setRefit(); // set the refit pointer to perform refitting of tracks, otherwise setPropagateTrack to true
 /// start looping over the tracks
 /// c.calculatedEdx(track, output, 0.01, 0.6, CorrectionFlags::TopologyPol | CorrectionFlags::GainFull | CorrectionFlags::GainResidual | CorrectionFlags::dEdxResidual) // this will fill the dEdxInfo output for given track
+/// or process all tracks at once with
+/// c.calculatedEdx(tracks, outputs, 0.01, 0.6, mask) // this will fill one dEdxInfo per track
 
 enum class CorrectionFlags : unsigned short {
   TopologySimple = 1 << 0, ///< flag for simple analytical topology correction
@@ -110,7 +112,13 @@ class CalculatedEdx
   ///                                                      GainResidual = residuals gain map from calibration container, dEdxResidual = residual dEdx correction
   void calculatedEdx(TrackTPC& track, dEdxInfo& output, float low = 0.05f, float high = 0.6f, CorrectionFlags mask = CorrectionFlags::TopologyPol | CorrectionFlags::GainFull | CorrectionFlags::GainResidual | CorrectionFlags::dEdxResidual);
 
+  /// get the truncated mean for all input tracks, see calculatedEdx(TrackTPC&, dEdxInfo&, float, float, CorrectionFlags) for the parameters
+  /// \param tracks input tracks
+  /// \param output output dEdxInfo, one per input track
+  void calculatedEdx(std::vector<TrackTPC>& tracks, std::vector<dEdxInfo>& output, float low = 0.05f, float high = 0.6f, CorrectionFlags mask = CorrectionFlags::TopologyPol | CorrectionFlags::GainFull | CorrectionFlags::GainResidual | CorrectionFlags::dEdxResidual);
+
   /// get the truncated mean for the input charge vector and the truncation range low*nCl<nCl<high*nCl
+  /// the charges are only partially ordered, the order of the input vector is modified
   /// \param charge input vector
   /// \param low lower cluster cut (e.g. 0.05)
   /// \param high higher cluster cut (e.g. 0.6)
@@ -136,6 +144,9 @@ class CalculatedEdx
   /// \param runNumberOrTimeStamp run number or time stamp
   void loadCalibsFromCCDB(long runNumberOrTimeStamp);
 
+  /// unpack the gain, residual gain and zero supression threshold maps of the calibration container into per pad lookup tables
+  void fillPadLookupTables();
+
  private:
   std::vector<TrackTPC>* mTracks{nullptr};                       ///< vector containing the tpc tracks which will be processed.
   std::vector<TPCClRefElem>* mTPCTrackClIdxVecInput{nullptr};    ///< input vector with TPC tracks cluster indicies
@@ -150,6 +161,10 @@ class CalculatedEdx
   CalibdEdxContainer mCalibCont;                                       ///< calibration container
   std::unique_ptr<o2::utils::TreeStreamRedirector> mStreamer{nullptr}; ///< debug streamer
 
+  std::vector<float> mGainLUT;                                         ///< gain per pad, indexed by sector and global pad number
+  std::vector<float> mGainResidualLUT;                                 ///< residual gain per pad, indexed by sector and global pad number
+  std::vector<float> mThresholdLUT;                                    ///< zero supression threshold per pad, indexed by sector and global pad number
+
   std::array<std::vector<float>, 5> mChargeTotROC;
   std::array<std::vector<float>, 5> mChargeMaxROC;
 };
@@ -78,6 +78,10 @@ class CalibPedestal : public CalibRawBase
   /// Reset pedestal data
   void resetData();
 
+  /// allocate the ADC data of all ROCs of the given sectors (all if empty) upfront,
+  /// afterwards updateROC can be called concurrently for different pads
+  void allocateSectors(const std::vector<int>& sectors);
+
   /// set the adc range
   void setADCRange(int minADC, int maxADC)
   {
@@ -45,6 +45,7 @@ class CalibratordEdx final : public o2::calibration::TimeSlotCalibration<o2::tpc
 
  public:
   CalibratordEdx() = default;
+  ~CalibratordEdx() override { waitForFinalizations(); }
 
   void setHistParams(int dEdxBins, float mindEdx, float maxdEdx, int angularBins, bool fitSnp)
   {
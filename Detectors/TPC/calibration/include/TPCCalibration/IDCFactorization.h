@@ -240,11 +240,11 @@ class IDCFactorization : public IDCGroupHelperSector
   /// \return returns the number of threads used for some of the calculations
   static int getNThreads() { return sNThreads; }
 
-  /// set the IDC data
+  /// set the IDC data. The IDCs are directly added to the running sum of the IDC0 of the CRU, which is used in calcIDCZero()
   /// \param idcs vector containing the IDCs
   /// \param cru CRU
   /// \param timeframe time frame of the IDCs
-  void setIDCs(std::vector<float>&& idcs, const unsigned int cru, const unsigned int timeframe) { mIDCs[cru][timeframe] = std::move(idcs); }
+  void setIDCs(std::vector<float>&& idcs, const unsigned int cru, const unsigned int timeframe);
 
   /// set the number of threads used for some of the calculations
   /// \param nThreads number of threads
@@ -414,6 +414,8 @@ class IDCFactorization : public IDCGroupHelperSector
   const unsigned int mTimeFramesDeltaIDC{};                         ///< number of timeframes of which Delta IDCs are stored
   std::array<std::vector<std::vector<float>>, CRU::MaxCRU> mIDCs{}; ///< grouped and integrated IDCs for the whole TPC. CRU -> time frame -> IDCs
   std::vector<IDCZero> mIDCZero{};                                  ///< sides -> I_0(r,\phi) = <I(r,\phi,t)>_t
+  std::array<std::vector<float>, CRU::MaxCRU> mIDCZeroSum{};        ///<! running sum of the IDCs per CRU which is filled when setting the IDCs
+  std::array<bool, CRU::MaxCRU> mIDCZeroSumValid{};                 ///<! flag if the running sum of the CRU contains all the stored IDCs
   std::vector<IDCOne> mIDCOne{};                                    ///< I_1(t) = sides -> <I(r,\phi,t) / I_0(r,\phi)>_{r,\phi}
   std::vector<std::vector<IDCDelta<float>>> mIDCDelta{};            ///< uncompressed: sides -> chunk -> Delta IDC: \Delta I(r,\phi,t) = I(r,\phi,t) / ( I_0(r,\phi) * I_1(t) )
   inline static int sNThreads{1};                                   ///< number of threads which are used during the calculations
@@ -437,6 +439,9 @@ class IDCFactorization : public IDCGroupHelperSector
   /// helper function for drawing IDCZero
   void drawIDCZeroHelper(const bool type, const Sector sector, const std::string filename, const float minZ, const float maxZ) const;
 
+  /// add the IDCs of the given time frame to the running sum of the IDC0 of the CRU
+  void addIDCZeroSum(const unsigned int cru, const unsigned int timeframe);
+
   /// get time frame and index of integrationInterval in the TF
   void getTF(unsigned int integrationInterval, unsigned int& timeFrame, unsigned int& interval) const;
 
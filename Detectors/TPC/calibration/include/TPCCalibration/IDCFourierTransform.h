@@ -72,6 +72,14 @@ class IDCFourierTransform : public IDCFourierTransformBase<Type>
     sNThreads = nThreads;
   }
 
+  /// This function has to be called before the constructor is called
+  /// \param nIntervals number of intervals which are transformed with one execution of the FFTW plan by each thread
+  template <bool IsEnabled = true, typename std::enable_if<(IsEnabled && (std::is_same<Type, IDCFourierTransformBaseAggregator>::value)), int>::type = 0>
+  static void setNIntervalsPerBatch(const int nIntervals)
+  {
+    sNIntervalsBatch = nIntervals;
+  }
+
   /// calculate fourier coefficients for one TPC side
   template <bool IsEnabled = true, typename std::enable_if<(IsEnabled && (std::is_same<Type, IDCFourierTransformBaseAggregator>::value)), int>::type = 0>
   void calcFourierCoefficients(const unsigned int timeFrames = 2000)
@@ -102,6 +110,9 @@ class IDCFourierTransform : public IDCFourierTransformBase<Type>
   /// get the number of threads used for calculation of the fourier coefficients
   static int getNThreads() { return sNThreads; }
 
+  /// \return returns the number of intervals which are transformed with one execution of the FFTW plan
+  static int getNIntervalsPerBatch() { return std::is_same_v<Type, IDCFourierTransformBaseAggregator> ? sNIntervalsBatch : 1; }
+
   /// dump object to disc
   /// \param outFileName name of the output file
   /// \param outName name of the object in the output file
@@ -130,9 +141,10 @@ class IDCFourierTransform : public IDCFourierTransformBase<Type>
   FourierCoeff mFourierCoefficients;         ///< fourier coefficients. interval -> coefficient
   inline static int sFftw{1};                ///< using fftw or naive approach for calculation of fourier coefficients
   inline static int sNThreads{1};            ///< number of threads which are used during the calculation of the fourier coefficients
-  fftwf_plan mFFTWPlan{nullptr};             ///<! FFTW plan which is used during the ft
-  std::vector<float*> mVal1DIDCs;            ///<! buffer for the 1D-IDC values for SIMD usage (each thread will get his one obejct)
-  std::vector<fftwf_complex*> mCoefficients; ///<! buffer for coefficients (each thread will get his one obejct)
+  inline static int sNIntervalsBatch{16};    ///< number of intervals which are transformed with one execution of the FFTW plan (only for the aggregator)
+  fftwf_plan mFFTWPlan{nullptr};             ///<! FFTW plan which is used during the ft of getNIntervalsPerBatch() intervals
+  std::vector<float*> mVal1DIDCs;            ///<! buffer for the 1D-IDC values of one batch for SIMD usage (each thread will get his one obejct)
+  std::vector<fftwf_complex*> mCoefficients; ///<! buffer for coefficients of one batch (each thread will get his one obejct)
 
   /// calculate fourier coefficients
   void calcFourierCoefficientsNaive();
@@ -158,8 +170,8 @@ class IDCFourierTransform : public IDCFourierTransformBase<Type>
   /// initalizing fftw members
   void initFFTW3Members();
 
-  /// performing of ft using FFTW
-  void fftwLoop(const std::vector<float>& idcOneExpanded, const std::vector<unsigned int>& offsetIndex, const unsigned int interval, const unsigned int thread);
+  /// performing of ft of the intervals of one batch using FFTW
+  void fftwLoop(const std::vector<float>& idcOneExpanded, const std::vector<unsigned int>& offsetIndex, const unsigned int batch, const unsigned int thread);
 
   ClassDefNV(IDCFourierTransform, 1)
 };
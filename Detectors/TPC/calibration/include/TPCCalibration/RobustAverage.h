@@ -17,6 +17,8 @@
 #define ALICEO2_ROBUSTAVERAGE_H_
 
 #include <vector>
+#include <utility>
+#include <cstddef>
 
 namespace o2::tpc
 {
@@ -120,10 +122,11 @@ class RobustAverage
   float getQuantile(float quantile, int type);
 
  private:
-  std::vector<float> mValues{};    ///< values which will be averaged and filtered
-  std::vector<float> mWeights{};   ///< weights of each value
-  std::vector<float> mTmpValues{}; ///< tmp vector used for calculation of std dev
-  bool mUseWeights{};              ///< also storing weights
+  std::vector<float> mValues{};                             ///< values which will be averaged and filtered
+  std::vector<float> mWeights{};                            ///< weights of each value
+  std::vector<float> mTmpValues{};                          ///< tmp vector used for calculation of std dev
+  std::vector<std::pair<float, float>> mTmpValuesWeights{}; ///< tmp vector used for sorting the values together with the weights
+  bool mUseWeights{};                                       ///< also storing weights
 
   float getMean(std::vector<float>::const_iterator begin, std::vector<float>::const_iterator end) const;
 
@@ -138,6 +141,13 @@ class RobustAverage
   /// \param stdev standard deviation of the values
   /// \param sigma maximum accepted standard deviation: sigma*stdev
   float getFilteredMean(const float mean, const float stdev, const float sigma) const;
+
+  /// same as getFilteredMean, but not requiring sorted values
+  float getFilteredMeanUnsorted(const float mean, const float stdev, const float sigma) const;
+
+  /// partially sorting the values such that the median and the values in the range [idxLower, idxUpper) are at the position of the sorted values
+  /// \return returns the median
+  float getPartialSortedMedian(const size_t idxLower, const size_t idxUpper);
 };
 
 } // namespace o2::tpc
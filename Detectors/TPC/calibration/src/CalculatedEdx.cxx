@@ -28,8 +28,19 @@
 #include "DataFormatsParameters/GRPMagField.h"
 #include "GPUO2InterfaceUtils.h"
 
+#include <algorithm>
+
 using namespace o2::tpc;
 
+namespace
+{
+/// index of the pad in the per pad lookup tables
+inline unsigned int padLUTIndex(unsigned char sector, unsigned char row, unsigned char pad)
+{
+  return sector * Mapper::getPadsInSector() + Mapper::GLOBALPADOFFSET[Mapper::REGION[row]] + Mapper::OFFSETCRUGLOBAL[row] + pad;
+}
+} // namespace
+
 CalculatedEdx::CalculatedEdx()
 {
   mTPCCorrMapsHelper.setOwner(true);
@@ -77,8 +88,40 @@ void CalculatedEdx::fillMissingClusters(int missingClusters[4], float minChargeT
   }
 }
 
+void CalculatedEdx::fillPadLookupTables()
+{
+  const size_t nPads = Mapper::NSECTORS * Mapper::getPadsInSector();
+  mGainLUT.resize(nPads);
+  mGainResidualLUT.resize(nPads);
+  mThresholdLUT.resize(nPads);
+  for (unsigned char sector = 0; sector < Mapper::NSECTORS; ++sector) {
+    for (unsigned char row = 0; row < Mapper::PADROWS; ++row) {
+      const int region = Mapper::REGION[row];
+      const unsigned int nPadsRow = Mapper::PADSPERROW[region][Mapper::getLocalRowFromGlobalRow(row)];
+      const unsigned int offset = padLUTIndex(sector, row, 0);
+      for (unsigned int pad = 0; pad < nPadsRow; ++pad) {
+        mGainLUT[offset + pad] = mCalibCont.getGain(sector, row, pad);
+        mGainResidualLUT[offset + pad] = mCalibCont.getResidualGain(sector, row, pad);
+        mThresholdLUT[offset + pad] = mCalibCont.getZeroSupressionThreshold(sector, row, pad);
+      }
+    }
+  }
+}
+
+void CalculatedEdx::calculatedEdx(std::vector<TrackTPC>& tracks, std::vector<dEdxInfo>& output, float low, float high, CorrectionFlags mask)
+{
+  output.resize(tracks.size());
+  for (size_t iTrk = 0; iTrk < tracks.size(); ++iTrk) {
+    calculatedEdx(tracks[iTrk], output[iTrk], low, high, mask);
+  }
+}
+
 void CalculatedEdx::calculatedEdx(o2::tpc::TrackTPC& track, dEdxInfo& output, float low, float high, CorrectionFlags mask)
 {
+  if (mGainLUT.empty()) {
+    fillPadLookupTables();
+  }
+
   // get number of clusters
   const int nClusters = track.getNClusterReferences();
 
@@ -186,7 +229,8 @@ void CalculatedEdx::calculatedEdx(o2::tpc::TrackTPC& track, dEdxInfo& output, fl
 
     // get pad and threshold
     const unsigned char pad = std::clamp(static_cast<unsigned int>(cl.getPad() + 0.5f), static_cast<unsigned int>(0), Mapper::PADSPERROW[region][Mapper::getLocalRowFromGlobalRow(rowIndex)] - 1); // the left side of the pad is defined at e.g. 3.5 and the right side at 4.5
-    const float threshold = mCalibCont.getZeroSupressionThreshold(sectorIndex, rowIndex, pad);
+    const unsigned int padIndex = padLUTIndex(sectorIndex, rowIndex, pad);
+    const float threshold = mThresholdLUT[padIndex];
 
     // get stack and stack ID
     const CRU cru(Sector(sectorIndex), region);
@@ -233,10 +277,10 @@ void CalculatedEdx::calculatedEdx(o2::tpc::TrackTPC& track, dEdxInfo& output, fl
     float gain = 1.0f;
     float gainResidual = 1.0f;
     if ((mask & CorrectionFlags::GainFull) == CorrectionFlags::GainFull) {
-      gain = mCalibCont.getGain(sectorIndex, rowIndex, pad);
+      gain = mGainLUT[padIndex];
     };
     if ((mask & CorrectionFlags::GainResidual) == CorrectionFlags::GainResidual) {
-      gainResidual = mCalibCont.getResidualGain(sectorIndex, rowIndex, pad);
+      gainResidual = mGainResidualLUT[padIndex];
     };
     chargeTot /= gain * gainResidual;
     chargeMax /= gain * gainResidual;
@@ -335,8 +379,13 @@ void CalculatedEdx::calculatedEdx(o2::tpc::TrackTPC& track, dEdxInfo& output, fl
   // fill subthreshold clusters
   fillMissingClusters(nClsSubThreshROC, minChargeTot, minChargeMax, 0);
 
-  auto chargeTotVector = mChargeTotROC[4];
-  auto chargeMaxVector = mChargeMaxROC[4];
+  // keep the unordered charges for the debug output
+  std::vector<float> chargeTotVector;
+  std::vector<float> chargeMaxVector;
+  if (mDebug) {
+    chargeTotVector = mChargeTotROC[4];
+    chargeMaxVector = mChargeMaxROC[4];
+  }
 
   // calculate dEdx
   output.dEdxTotIROC = getTruncMean(mChargeTotROC[0], low, high);
@@ -386,14 +435,18 @@ void CalculatedEdx::calculatedEdx(o2::tpc::TrackTPC& track, dEdxInfo& output, fl
 
 float CalculatedEdx::getTruncMean(std::vector<float>& charge, float low, float high) const
 {
-  // sort the charge vector
-  std::sort(charge.begin(), charge.end());
-
   // calculate truncated mean
   int nCl = 0;
   float sum = 0;
   size_t firstCl = charge.size() * low;
-  size_t lastCl = charge.size() * high;
+  size_t lastCl = std::min(static_cast<size_t>(charge.size() * high), charge.size());
+  if (firstCl >= lastCl) {
+    return sum;
+  }
+
+  // only the clusters inside the truncation range are needed: partition the charges instead of sorting them
+  std::nth_element(charge.begin(), charge.begin() + firstCl, charge.end());
+  std::nth_element(charge.begin() + firstCl, charge.begin() + lastCl - 1, charge.end());
 
   for (size_t iCl = firstCl; iCl < lastCl; ++iCl) {
     sum += charge[iCl];
@@ -474,6 +527,7 @@ void CalculatedEdx::loadCalibsFromCCDB(long runNumberOrTimeStamp)
   // set the zero supression threshold map
   std::unordered_map<string, o2::tpc::CalDet<float>>* zeroSupressionThresholdMap = cm.getForTimeStamp<std::unordered_map<string, o2::tpc::CalDet<float>>>(o2::tpc::CDBTypeMap.at(o2::tpc::CDBType::ConfigFEEPad), tRun);
   mCalibCont.setZeroSupresssionThreshold(zeroSupressionThresholdMap->at("ThresholdMap"));
+  fillPadLookupTables();
 
   // set the magnetic field
   auto magField = cm.get<o2::parameters::GRPMagField>("GLO/Config/GRPMagField");
@@ -12,6 +12,7 @@
 /// \file   CalibPedestal.cxx
 /// \author Jens Wiechula, Jens.Wiechula@ikf.uni-frankfurt.de
 
+#include <algorithm>
 #include <fmt/format.h>
 
 #include "TH2F.h"
@@ -95,6 +96,18 @@ CalibPedestal::vectorType* CalibPedestal::getVector(ROC roc, bool create /*=kFAL
   return vec;
 }
 
+//______________________________________________________________________________
+void CalibPedestal::allocateSectors(const std::vector<int>& sectors)
+{
+  for (int sector = 0; sector < Sector::MAXSECTOR; ++sector) {
+    if (sectors.size() && std::find(sectors.begin(), sectors.end(), sector) == sectors.end()) {
+      continue;
+    }
+    getVector(ROC(Sector(sector), RocType::IROC), kTRUE);
+    getVector(ROC(Sector(sector), RocType::OROC), kTRUE);
+  }
+}
+
 //______________________________________________________________________________
 void CalibPedestal::analyse()
 {
@@ -128,6 +128,7 @@ void CorrectionMapsLoader::addOptions(std::vector<ConfigParamSpec>& options)
   // At the moment - nothing, all options are moved to configurable param CorrMapParam
   addOption(options, ConfigParamSpec{"recalculate-inverse-correction", o2::framework::VariantType::Bool, false, {"recalculate the inverse correction in case lumi mode 1 or 2 is used"}});
   addOption(options, ConfigParamSpec{"nthreads-inverse-correction", o2::framework::VariantType::Int, 4, {"Number of threads used for calculating the inverse correction (-1=all threads)"}});
+  addOption(options, ConfigParamSpec{"blend-correction-maps", o2::framework::VariantType::Bool, false, {"combine the spline parameters of the scaled correction maps into a single map on each scaling update"}});
 }
 
 //________________________________________________________
@@ -257,6 +258,7 @@ void CorrectionMapsLoader::init(o2::framework::InitContext& ic)
   }
   const int nthreadsInv = (ic.options().get<int>("nthreads-inverse-correction"));
   (nthreadsInv < 0) ? TPCFastSpaceChargeCorrectionHelper::instance()->setNthreadsToMaximum() : TPCFastSpaceChargeCorrectionHelper::instance()->setNthreads(nthreadsInv);
+  enableMapBlending(ic.options().get<bool>("blend-correction-maps"));
 }
 
 //________________________________________________________
@@ -277,6 +279,7 @@ void CorrectionMapsLoader::copySettings(const CorrectionMapsLoader& src)
   mLumiCTPSource = src.mLumiCTPSource;
   mLumiScaleMode = src.mLumiScaleMode;
   mScaleInverse = src.getScaleInverse();
+  mBlendMaps = src.getMapBlending();
 }
 
 void CorrectionMapsLoader::updateInverse()
@@ -291,6 +294,7 @@ void CorrectionMapsLoader::updateInverse()
       corr.emplace_back(&(mCorrMapMShape->getCorrection()));
     }
     TPCFastSpaceChargeCorrectionHelper::instance()->initInverse(corr, scaling, false);
+    updateBlendedMap();
   } else {
     LOGP(info, "Reinitializing inverse correction with lumi scale mode {} not supported for now", mLumiScaleMode);
   }
@@ -45,6 +45,8 @@ o2::tpc::IDCFactorization::IDCFactorization(const std::array<unsigned char, Mapp
   for (auto& idc : mIDCs) {
     idc.resize(mTimeFrames);
   }
+  mIDCZeroSumValid.fill(true);
+
   // check if the input IDCs are grouped
   for (int region = 0; region < Mapper::NREGIONS; ++region) {
     if (mNIDCsPerCRU[region] != Mapper::PADSPERREGION[region]) {
@@ -237,6 +239,32 @@ void o2::tpc::IDCFactorization::dumpIDCDeltaToTree(const Side side, const int ch
   helper.dumpToTreeIDCDelta(side, outFileName);
 }
 
+void o2::tpc::IDCFactorization::setIDCs(std::vector<float>&& idcs, const unsigned int cru, const unsigned int timeframe)
+{
+  // overwriting already stored IDCs invalidates the running sum, which is then recalculated in calcIDCZero()
+  if (!mIDCs[cru][timeframe].empty()) {
+    mIDCZeroSumValid[cru] = false;
+  }
+  mIDCs[cru][timeframe] = std::move(idcs);
+  if (mIDCZeroSumValid[cru]) {
+    addIDCZeroSum(cru, timeframe);
+  }
+}
+
+void o2::tpc::IDCFactorization::addIDCZeroSum(const unsigned int cru, const unsigned int timeframe)
+{
+  const unsigned int nIDCs = mNIDCsPerCRU[o2::tpc::CRU(cru).region()];
+  auto& idcZeroSum = mIDCZeroSum[cru];
+  idcZeroSum.resize(nIDCs);
+  const auto& idcs = mIDCs[cru][timeframe];
+  for (unsigned int i = 0; i < idcs.size(); ++i) {
+    if ((idcs[i] == -1) || (idcs[i] == 0)) {
+      continue;
+    }
+    idcZeroSum[i % nIDCs] += idcs[i];
+  }
+}
+
 void o2::tpc::IDCFactorization::calcIDCZero(const bool norm)
 {
   const unsigned int nIDCsSide = mNIDCsPerSector * o2::tpc::SECTORSPERSIDE;
@@ -252,18 +280,33 @@ void o2::tpc::IDCFactorization::calcIDCZero(const bool norm)
     const auto side = cruTmp.side();
     const unsigned int region = cruTmp.region();
     const auto factorIndexGlob = mRegionOffs[region] + mNIDCsPerSector * (cruTmp.sector() % o2::tpc::SECTORSPERSIDE);
-    for (unsigned int timeframe = 0; timeframe < mTimeFrames; ++timeframe) {
-      for (unsigned int idcs = 0; idcs < mIDCs[cru][timeframe].size(); ++idcs) {
-        if ((mIDCs[cru][timeframe][idcs] == -1) || (mIDCs[cru][timeframe][idcs] == 0)) {
-          continue;
-        }
-        if (norm) {
-          mIDCs[cru][timeframe][idcs] *= Mapper::INVPADAREA[region];
+
+    // recalculate the running sum in case it is not up to date
+    if (!mIDCZeroSumValid[cru]) {
+      mIDCZeroSum[cru].assign(mNIDCsPerCRU[region], 0);
+      for (unsigned int timeframe = 0; timeframe < mTimeFrames; ++timeframe) {
+        addIDCZeroSum(cru, timeframe);
+      }
+    }
+
+    const float normVal = norm ? Mapper::INVPADAREA[region] : 1;
+    for (unsigned int idcs = 0; idcs < mIDCZeroSum[cru].size(); ++idcs) {
+      mIDCZero[mSideIndex[side]].fillValueIDCZero(mIDCZeroSum[cru][idcs] * normVal, idcs + factorIndexGlob);
+    }
+
+    // the normalized IDCs are needed for the calculation of IDC1 and IDCDelta
+    if (norm) {
+      for (unsigned int timeframe = 0; timeframe < mTimeFrames; ++timeframe) {
+        for (auto& idc : mIDCs[cru][timeframe]) {
+          if ((idc == -1) || (idc == 0)) {
+            continue;
+          }
+          idc *= Mapper::INVPADAREA[region];
         }
-        const unsigned int indexGlob = (idcs % mNIDCsPerCRU[region]) + factorIndexGlob;
-        mIDCZero[mSideIndex[side]].fillValueIDCZero(mIDCs[cru][timeframe][idcs], indexGlob);
       }
     }
+    // the running sum is only valid for the unnormalized IDCs
+    mIDCZeroSumValid[cru] = !norm;
   }
 
 // perform normalization per CRU (in case some CRUs lack data)
@@ -982,6 +1025,10 @@ void o2::tpc::IDCFactorization::reset()
       idcs.clear();
     }
   }
+  for (auto& idcZeroSum : mIDCZeroSum) {
+    idcZeroSum.clear();
+  }
+  mIDCZeroSumValid.fill(true);
 }
 
 void o2::tpc::IDCFactorization::drawIDCDeltaHelper(const bool type, const Sector sector, const unsigned int integrationInterval, const IDCDeltaCompression compression, const std::string filename, const float minZ, const float maxZ) const
@@ -15,6 +15,7 @@
 #include "Framework/Logger.h"
 #include "TFile.h"
 #include <fftw3.h>
+#include <algorithm>
 
 #if (defined(WITH_OPENMP) || defined(_OPENMP)) && !defined(__CLING__)
 #include <omp.h>
@@ -35,11 +36,17 @@ o2::tpc::IDCFourierTransform<Type>::~IDCFourierTransform()
 template <class Type>
 void o2::tpc::IDCFourierTransform<Type>::initFFTW3Members()
 {
+  // the intervals of one batch are stored consecutively in the buffers and are transformed with one plan
+  const int nBatch = getNIntervalsPerBatch();
+  const int rangeIDC = this->mRangeIDC;
+  const int nMaxCoeff = getNMaxCoefficients();
   for (int thread = 0; thread < sNThreads; ++thread) {
-    mVal1DIDCs[thread] = fftwf_alloc_real(this->mRangeIDC);
-    mCoefficients[thread] = fftwf_alloc_complex(getNMaxCoefficients());
+    mVal1DIDCs[thread] = fftwf_alloc_real(nBatch * rangeIDC);
+    mCoefficients[thread] = fftwf_alloc_complex(nBatch * nMaxCoeff);
+    // the last batch might not be completely filled: initialize the buffers to avoid transforming undefined values
+    std::fill_n(mVal1DIDCs[thread], nBatch * rangeIDC, 0);
   }
-  mFFTWPlan = fftwf_plan_dft_r2c_1d(this->mRangeIDC, mVal1DIDCs.front(), mCoefficients.front(), FFTW_ESTIMATE);
+  mFFTWPlan = fftwf_plan_many_dft_r2c(1, &rangeIDC, nBatch, mVal1DIDCs.front(), nullptr, 1, rangeIDC, mCoefficients.front(), nullptr, 1, nMaxCoeff, FFTW_ESTIMATE);
 }
 
 template <class Type>
@@ -105,9 +112,11 @@ void o2::tpc::IDCFourierTransform<Type>::calcFourierCoefficientsFFTW3()
   const std::vector<float>& idcOneExpanded{this->getExpandedIDCOne()}; // 1D-IDC values which will be used for the FFT
 
   if constexpr (std::is_same_v<Type, IDCFourierTransformBaseAggregator>) {
+    const unsigned int nBatch = getNIntervalsPerBatch();
+    const unsigned int nBatches = (this->getNIntervals() + nBatch - 1) / nBatch;
 #pragma omp parallel for num_threads(sNThreads)
-    for (unsigned int interval = 0; interval < this->getNIntervals(); ++interval) {
-      fftwLoop(idcOneExpanded, offsetIndex, interval, omp_get_thread_num());
+    for (unsigned int batch = 0; batch < nBatches; ++batch) {
+      fftwLoop(idcOneExpanded, offsetIndex, batch, omp_get_thread_num());
     }
   } else {
     fftwLoop(idcOneExpanded, offsetIndex, 0, 0);
@@ -117,11 +126,18 @@ void o2::tpc::IDCFourierTransform<Type>::calcFourierCoefficientsFFTW3()
 }
 
 template <class Type>
-inline void o2::tpc::IDCFourierTransform<Type>::fftwLoop(const std::vector<float>& idcOneExpanded, const std::vector<unsigned int>& offsetIndex, const unsigned int interval, const unsigned int thread)
+inline void o2::tpc::IDCFourierTransform<Type>::fftwLoop(const std::vector<float>& idcOneExpanded, const std::vector<unsigned int>& offsetIndex, const unsigned int batch, const unsigned int thread)
 {
-  std::memcpy(mVal1DIDCs[thread], &idcOneExpanded[offsetIndex[interval]], this->mRangeIDC * sizeof(float));                                                                                               // copy IDCs to avoid seg fault when using SIMD instructions
-  fftwf_execute_dft_r2c(mFFTWPlan, mVal1DIDCs[thread], mCoefficients[thread]);                                                                                                                            // perform ft
-  std::memcpy(&(*(mFourierCoefficients.mFourierCoefficients.begin() + mFourierCoefficients.getIndex(interval, 0))), mCoefficients[thread], mFourierCoefficients.getNCoefficientsPerTF() * sizeof(float)); // store coefficients
+  const unsigned int nBatch = getNIntervalsPerBatch();
+  const unsigned int intervalStart = batch * nBatch;
+  const unsigned int nIntervals = std::min(nBatch, static_cast<unsigned int>(offsetIndex.size()) - intervalStart);
+  for (unsigned int i = 0; i < nIntervals; ++i) {
+    std::memcpy(mVal1DIDCs[thread] + i * this->mRangeIDC, &idcOneExpanded[offsetIndex[intervalStart + i]], this->mRangeIDC * sizeof(float)); // copy IDCs to avoid seg fault when using SIMD instructions
+  }
+  fftwf_execute_dft_r2c(mFFTWPlan, mVal1DIDCs[thread], mCoefficients[thread]); // perform ft of all intervals of the batch
+  for (unsigned int i = 0; i < nIntervals; ++i) {
+    std::memcpy(&(*(mFourierCoefficients.mFourierCoefficients.begin() + mFourierCoefficients.getIndex(intervalStart + i, 0))), mCoefficients[thread] + i * getNMaxCoefficients(), mFourierCoefficients.getNCoefficientsPerTF() * sizeof(float)); // store coefficients
+  }
 }
 
 template <class Type>
@@ -33,15 +33,29 @@ std::pair<float, float> o2::tpc::RobustAverage::getFilteredAverage(const float s
     5. Get mean of the selected points which are in the range of the std dev
   */
 
+  // without weights the values don't need to be sorted completely: the median and the interquartile range are obtained with partial sorting
+  const size_t nVals = mValues.size();
+  const size_t idxMedian = nVals / 2;
+  const size_t idxUpper = nVals * interQuartileRange;
+  const size_t idxLower = nVals * (1 - interQuartileRange);
+  if (!mUseWeights && (idxLower <= idxMedian) && (idxMedian <= idxUpper)) {
+    const auto median = getPartialSortedMedian(idxLower, idxUpper);
+    if (idxUpper == idxLower) {
+      return std::pair<float, float>(median, 0);
+    }
+    const float stdev = getStdDev(median, mValues.begin() + idxLower, mValues.begin() + idxUpper);
+    return std::pair<float, float>(getFilteredMeanUnsorted(median, stdev, sigma), stdev);
+  }
+
   // 1.  Sort the values
   sort();
 
   // 2. Use only the values in the Interquartile Range (inner n%)
-  const auto upper = mValues.begin() + mValues.size() * interQuartileRange;
-  const auto lower = mValues.begin() + mValues.size() * (1 - interQuartileRange);
+  const auto upper = mValues.begin() + idxUpper;
+  const auto lower = mValues.begin() + idxLower;
 
   // 3. Get the median
-  const float median = mValues[mValues.size() / 2];
+  const float median = mValues[idxMedian];
 
   if (upper == lower) {
     return std::pair<float, float>(median, 0);
@@ -54,6 +68,36 @@ std::pair<float, float> o2::tpc::RobustAverage::getFilteredAverage(const float s
   return std::pair<float, float>(getFilteredMean(median, stdev, sigma), stdev);
 }
 
+float o2::tpc::RobustAverage::getPartialSortedMedian(const size_t idxLower, const size_t idxUpper)
+{
+  // after the partitioning the values in [idxLower, idxUpper) are the same as for the sorted values
+  const size_t idxMedian = mValues.size() / 2;
+  std::nth_element(mValues.begin(), mValues.begin() + idxMedian, mValues.end());
+  if (idxLower < idxMedian) {
+    std::nth_element(mValues.begin(), mValues.begin() + idxLower, mValues.begin() + idxMedian);
+  }
+  if (idxUpper > idxMedian + 1) {
+    std::nth_element(mValues.begin() + idxMedian + 1, mValues.begin() + idxUpper, mValues.end());
+  }
+  return mValues[idxMedian];
+}
+
+float o2::tpc::RobustAverage::getFilteredMeanUnsorted(const float mean, const float stdev, const float sigma) const
+{
+  // same selection as in getFilteredMean: minVal <= val <= maxVal
+  const float sigmastddev = sigma * stdev;
+  const float minVal = mean - sigmastddev;
+  const float maxVal = mean + sigmastddev;
+  float sum = 0;
+  int count = 0;
+  for (const auto val : mValues) {
+    const bool accept = (val >= minVal) && (val <= maxVal);
+    sum += accept ? val : 0;
+    count += accept;
+  }
+  return sum / count;
+}
+
 std::tuple<float, float, float, unsigned int> o2::tpc::RobustAverage::filterPointsMedian(const float maxAbsMedian, const float sigma)
 {
   if (mValues.empty()) {
@@ -113,21 +157,16 @@ void o2::tpc::RobustAverage::sort()
       LOGP(warning, "values and errors haave different size");
       return;
     }
-    std::vector<std::size_t> tmpIdx(nVals);
-    std::iota(tmpIdx.begin(), tmpIdx.end(), 0);
-    std::sort(tmpIdx.begin(), tmpIdx.end(), [&](std::size_t i, std::size_t j) { return (mValues[i] < mValues[j]); });
-
-    std::vector<float> mValues_tmp;
-    std::vector<float> mWeights_tmp;
-    mValues_tmp.reserve(nVals);
-    mWeights_tmp.reserve(nVals);
-    for (int i = 0; i < nVals; ++i) {
-      const int idx = tmpIdx[i];
-      mValues_tmp.emplace_back(mValues[idx]);
-      mWeights_tmp.emplace_back(mWeights[idx]);
+    // sort the pairs of values and weights, the buffer is reused for all calls
+    mTmpValuesWeights.resize(nVals);
+    for (size_t i = 0; i < nVals; ++i) {
+      mTmpValuesWeights[i] = {mValues[i], mWeights[i]};
+    }
+    std::sort(mTmpValuesWeights.begin(), mTmpValuesWeights.end(), [](const auto& a, const auto& b) { return (a.first < b.first); });
+    for (size_t i = 0; i < nVals; ++i) {
+      mValues[i] = mTmpValuesWeights[i].first;
+      mWeights[i] = mTmpValuesWeights[i].second;
     }
-    mValues.swap(mValues_tmp);
-    mWeights.swap(mWeights_tmp);
   } else {
     std::sort(mValues.begin(), mValues.end());
   }
@@ -215,14 +254,13 @@ float o2::tpc::RobustAverage::getTrunctedMean(float low, float high)
     std::nth_element(mValues.begin(), mValues.begin() + startInd, mValues.end());
     const float valMin = mValues[startInd];
 
-    std::nth_element(mValues.begin(), mValues.begin() + endInd, mValues.end());
+    // all values after startInd are already larger or equal to valMin
+    std::nth_element(mValues.begin() + startInd + 1, mValues.begin() + endInd, mValues.end());
     const float valMax = mValues[endInd];
 
     double sum = 0;
     for (auto val : mValues) {
-      if (val >= valMin && val < valMax) {
-        sum += val;
-      }
+      sum += (val >= valMin && val < valMax) ? val : 0; // branchless for vectorization
     }
     const int count = endInd - startInd;
     const float mean = sum / count;
@@ -0,0 +1,88 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file bench_RobustAverage.cxx
+/// \brief Benchmark of the robust averaging of the values of all pads of the TPC, reusing one RobustAverage object for all pads
+
+#include "benchmark/benchmark.h"
+#include "TPCCalibration/RobustAverage.h"
+#include <random>
+#include <vector>
+
+using namespace o2::tpc;
+
+constexpr int NPads = 524160;     // number of pads of the TPC
+constexpr size_t NValues = 1 << 22; // size of the pool of random values from which the values of the pads are taken
+
+// pool of random values with a few outliers
+const std::vector<float>& getValues()
+{
+  static std::vector<float> values;
+  if (values.empty()) {
+    std::mt19937 gen(1);
+    std::normal_distribution<float> gaus(10, 1);
+    std::uniform_real_distribution<float> outlier(0, 100);
+    values.resize(NValues);
+    for (size_t i = 0; i < values.size(); ++i) {
+      values[i] = (i % 17) ? gaus(gen) : outlier(gen);
+    }
+  }
+  return values;
+}
+
+template <typename Func>
+void runPads(benchmark::State& state, const bool withWeights, Func func)
+{
+  const int nValuesPerPad = state.range(0);
+  const auto& values = getValues();
+  RobustAverage average(nValuesPerPad, withWeights);
+  float sum = 0;
+  for (auto _ : state) {
+    for (int pad = 0; pad < NPads; ++pad) {
+      average.clear();
+      const size_t offset = (size_t(pad) * nValuesPerPad) % (NValues - nValuesPerPad);
+      for (int i = 0; i < nValuesPerPad; ++i) {
+        average.addValue(values[offset + i]);
+      }
+      sum += func(average);
+    }
+  }
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations() * NPads);
+}
+
+static void BM_FilteredAverage(benchmark::State& state)
+{
+  runPads(state, false, [](RobustAverage& avg) { return avg.getFilteredAverage().first; });
+}
+
+static void BM_FilteredAverageSorted(benchmark::State& state)
+{
+  // with weights the values are sorted completely
+  runPads(state, true, [](RobustAverage& avg) { return avg.getFilteredAverage().first; });
+}
+
+static void BM_TruncatedMean(benchmark::State& state)
+{
+  runPads(state, false, [](RobustAverage& avg) { return avg.getTrunctedMean(0.05, 0.95); });
+}
+
+static void BM_Median(benchmark::State& state)
+{
+  runPads(state, false, [](RobustAverage& avg) { return avg.getMedian(); });
+}
+
+BENCHMARK(BM_FilteredAverage)->Arg(32)->Arg(1024)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FilteredAverageSorted)->Arg(32)->Arg(1024)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TruncatedMean)->Arg(32)->Arg(1024)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Median)->Arg(32)->Arg(1024)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -17,6 +17,8 @@
 #define O2_TPC_CTFCODER_H
 
 #include <algorithm>
+#include <array>
+#include <functional>
 #include <iterator>
 #include <string>
 #include <cassert>
@@ -230,9 +232,8 @@ o2::ctf::CTFIOSize CTFCoder::encode(VEC& buff, const CompressedClusters& ccl, co
   ec->setANSHeader(mANSVersion);
 
   o2::ctf::CTFIOSize iosize;
-  auto encodeTPC = [&buff, &optField, &coders = mCoders, mfc = this->getMemMarginFactor(), &iosize](auto begin, auto end, CTF::Slots slot, size_t probabilityBits, std::vector<bool>* reject = nullptr) {
+  auto encodeSlot = [&optField, &coders = mCoders, mfc = this->getMemMarginFactor(), adaptiveDict = this->getAdaptiveDictSelection()](auto& buffer, auto begin, auto end, int slotVal, size_t probabilityBits, std::vector<bool>* reject) {
     // at every encoding the buffer might be autoexpanded, so we don't work with fixed pointer ec
-    const auto slotVal = static_cast<int>(slot);
     if (reject && begin != end) {
       std::vector<std::decay_t<decltype(*begin)>> tmp;
       tmp.reserve(std::distance(begin, end));
@@ -241,9 +242,23 @@ o2::ctf::CTFIOSize CTFCoder::encode(VEC& buff, const CompressedClusters& ccl, co
           tmp.emplace_back(*i);
         }
       }
-      iosize += CTF::get(buff.data())->encode(tmp.begin(), tmp.end(), slotVal, probabilityBits, optField[slotVal], &buff, coders[slotVal], mfc);
+      return CTF::get(buffer.data())->encode(tmp.begin(), tmp.end(), slotVal, probabilityBits, optField[slotVal], &buffer, coders[slotVal], mfc, adaptiveDict);
+    }
+    return CTF::get(buffer.data())->encode(begin, end, slotVal, probabilityBits, optField[slotVal], &buffer, coders[slotVal], mfc, adaptiveDict);
+  };
+  // with several encoder threads the blocks are only booked here, to be encoded concurrently to their own buffers and then imported in the slots order
+  const bool concurrent = this->getNEncoderThreads() > 1;
+  std::array<std::vector<o2::ctf::BufferType>, CTF::getNBlocks()> slotBuffers;
+  std::array<std::function<void()>, CTF::getNBlocks()> tasks;
+  auto encodeTPC = [&](auto begin, auto end, CTF::Slots slot, size_t probabilityBits, std::vector<bool>* reject = nullptr) {
+    const auto slotVal = static_cast<int>(slot);
+    if (!concurrent) {
+      iosize += encodeSlot(buff, begin, end, slotVal, probabilityBits, reject);
     } else {
-      iosize += CTF::get(buff.data())->encode(begin, end, slotVal, probabilityBits, optField[slotVal], &buff, coders[slotVal], mfc);
+      tasks[slotVal] = [&encodeSlot, &slotBuffer = slotBuffers[slotVal], ansVersion = mANSVersion, begin, end, slotVal, probabilityBits, reject]() {
+        CTF::createForSlot(slotBuffer, slotVal, ansVersion);
+        encodeSlot(slotBuffer, begin, end, slotVal, probabilityBits, reject);
+      };
     }
   };
 
@@ -314,6 +329,13 @@ o2::ctf::CTFIOSize CTFCoder::encode(VEC& buff, const CompressedClusters& ccl, co
   encodeTPC(trigComp.deltaBC.begin(), trigComp.deltaBC.end(), CTF::BLCTrigBCInc, 0);
   encodeTPC(trigComp.triggerType.begin(), trigComp.triggerType.end(), CTF::BLCTrigType, 0);
 
+  if (concurrent) {
+    this->runEncoderTasks(tasks);
+    for (int i = 0; i < CTF::getNBlocks(); i++) {
+      iosize += CTF::importBlock(buff, *CTF::get(slotBuffers[i].data()), i);
+    }
+  }
+
   CTF::get(buff.data())->print(getPrefix(), mVerbosity);
   finaliseCTFOutput<CTF>(buff);
   iosize.rawIn = iosize.ctfIn;
@@ -86,7 +86,6 @@
 #include <tuple>
 #include <vector>
 #include <array>
-#include <deque>
 #include <gsl/span>
 
 namespace o2
@@ -257,7 +256,9 @@ class KrBoxClusterFinder
   /// x-axis: Timeslice number
   /// y-axis: Pad number
   /// Time slice four is the interesting one. In there, local maxima are found and clusters are built from it. After it is processed, timeslice number 1 will be dropped and another timeslice will be put at the end of the set.
-  std::deque<TimeSliceSector> mSetOfTimeSlices{};
+  /// The time slices are kept in a ring buffer which is allocated once: a dropped time slice is recycled as the new last one,
+  /// resetting only the entries which were filled, instead of allocating and zeroing a full sector map for every time bin.
+  std::vector<TimeSliceSector> mSetOfTimeSlices{};
 
   /// pre-store if complete time bins and rows within time bins have charges above mQThresholdMax
   struct ThresholdInfo {
@@ -265,13 +266,34 @@ class KrBoxClusterFinder
     std::array<bool, MaxRows> rowAboveThreshold{};
   };
 
-  std::deque<ThresholdInfo> mThresholdInfo{};
+  std::vector<ThresholdInfo> mThresholdInfo{};
+  std::vector<std::vector<unsigned int>> mFilledEntries{}; ///< row * MaxPads + pad of the filled entries of each time slice in the ring
+  size_t mFirstTimeSlice = 0;                             ///< position of the first time slice of the set in the ring
+  size_t mNTimeSlices = 0;                                ///< number of time slices currently in the set
+
+  size_t getRingIndex(int timeSlice) const { return (mFirstTimeSlice + timeSlice) % mSetOfTimeSlices.size(); }
+  TimeSliceSector& getTimeSlice(int timeSlice) { return mSetOfTimeSlices[getRingIndex(timeSlice)]; }
+  const TimeSliceSector& getTimeSlice(int timeSlice) const { return mSetOfTimeSlices[getRingIndex(timeSlice)]; }
+  ThresholdInfo& getThresholdInfo(int timeSlice) { return mThresholdInfo[getRingIndex(timeSlice)]; }
+
+  /// true if none of the time slices in the set contains a digit
+  bool isSetOfTimeSlicesEmpty() const
+  {
+    for (const auto& filled : mFilledEntries) {
+      if (!filled.empty()) {
+        return false;
+      }
+    }
+    return true;
+  }
+  void resetTimeSlice(size_t ringIndex);
 
   void createInitialMap(const gsl::span<const Digit> eventSector);
   void popFirstTimeSliceFromMap()
   {
-    mSetOfTimeSlices.pop_front();
-    mThresholdInfo.pop_front();
+    resetTimeSlice(mFirstTimeSlice);
+    mFirstTimeSlice = (mFirstTimeSlice + 1) % mSetOfTimeSlices.size();
+    --mNTimeSlices;
   }
   void fillADCValueInLastSlice(int cru, int rowInSector, int padInRow, float adcValue);
   void addTimeSlice(const gsl::span<const Digit> eventSector, const int timeSlice);
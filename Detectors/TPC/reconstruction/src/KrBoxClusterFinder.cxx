@@ -38,10 +38,31 @@ void KrBoxClusterFinder::loadGainMapFromFile(const std::string_view calDetFileNa
   LOGP(info, "Loaded gain map object '{}' from file '{}'", calDetFileName, gainMapName);
 }
 
+void KrBoxClusterFinder::resetTimeSlice(size_t ringIndex)
+{
+  auto& timeSlice = mSetOfTimeSlices[ringIndex];
+  auto& filled = mFilledEntries[ringIndex];
+  for (const auto entry : filled) {
+    timeSlice[entry / MaxPads][entry % MaxPads] = 0;
+  }
+  filled.clear();
+  mThresholdInfo[ringIndex] = ThresholdInfo{};
+}
+
 void KrBoxClusterFinder::createInitialMap(const gsl::span<const Digit> eventSector)
 {
-  mSetOfTimeSlices.clear();
-  mThresholdInfo.clear();
+  const size_t nTimeSlices = 2 * mMaxClusterSizeTime + 1;
+  if (mSetOfTimeSlices.size() != nTimeSlices) {
+    mSetOfTimeSlices.assign(nTimeSlices, TimeSliceSector{});
+    mThresholdInfo.assign(nTimeSlices, ThresholdInfo{});
+    mFilledEntries.assign(nTimeSlices, {});
+  } else {
+    for (size_t i = 0; i < nTimeSlices; ++i) {
+      resetTimeSlice(i);
+    }
+  }
+  mFirstTimeSlice = 0;
+  mNTimeSlices = 0;
 
   for (int iTimeSlice = 0; iTimeSlice <= 2 * mMaxClusterSizeTime; ++iTimeSlice) {
     addTimeSlice(eventSector, iTimeSlice);
@@ -50,12 +71,13 @@ void KrBoxClusterFinder::createInitialMap(const gsl::span<const Digit> eventSect
 
 void KrBoxClusterFinder::fillADCValueInLastSlice(int cru, int rowInSector, int padInRow, float adcValue)
 {
-  auto& timeSlice = mSetOfTimeSlices.back();
-  auto& thresholdInfo = mThresholdInfo.back();
+  auto& timeSlice = getTimeSlice(mNTimeSlices - 1);
+  auto& thresholdInfo = getThresholdInfo(mNTimeSlices - 1);
 
   // Correct for pad offset:
   const int padsInRow = mMapperInstance.getNumberOfPadsInRowSector(rowInSector);
   const int corPad = padInRow - (padsInRow / 2) + (MaxPads / 2);
+  mFilledEntries[getRingIndex(mNTimeSlices - 1)].push_back(rowInSector * MaxPads + corPad);
 
   if (adcValue > mQThresholdMax) {
     thresholdInfo.digitAboveThreshold = true;
@@ -85,8 +107,7 @@ void KrBoxClusterFinder::fillADCValueInLastSlice(int cru, int rowInSector, int p
 
 void KrBoxClusterFinder::addTimeSlice(const gsl::span<const Digit> eventSector, const int timeSlice)
 {
-  mSetOfTimeSlices.emplace_back();
-  mThresholdInfo.emplace_back();
+  ++mNTimeSlices; // the slot after the last time slice was reset when it was dropped
 
   for (; mFirstDigit < eventSector.size(); ++mFirstDigit) {
     const auto& digit = eventSector[mFirstDigit];
@@ -114,7 +135,7 @@ void KrBoxClusterFinder::loopOverSector(const gsl::span<const Digit> eventSector
   createInitialMap(eventSector);
   for (int iTimeSlice = mMaxClusterSizeTime; iTimeSlice < mMaxTimes - mMaxClusterSizeTime; ++iTimeSlice) {
     // only search for a local maximum if the central time slice has at least one ADC above the charge threshold
-    if (mThresholdInfo[mMaxClusterSizeTime].digitAboveThreshold) {
+    if (getThresholdInfo(mMaxClusterSizeTime).digitAboveThreshold) {
       findLocalMaxima(true, iTimeSlice);
     }
     popFirstTimeSliceFromMap();
@@ -124,6 +145,13 @@ void KrBoxClusterFinder::loopOverSector(const gsl::span<const Digit> eventSector
     if (mFirstDigit >= eventSector.size()) {
       break;
     }
+
+    // skip the time bins without data: if the whole set is empty, the next non-empty time slice
+    // can directly be added as the last one
+    const int nextTime = eventSector[mFirstDigit].getTimeStamp();
+    if (nextTime > iTimeSlice + mMaxClusterSizeTime + 2 && isSetOfTimeSlicesEmpty()) {
+      iTimeSlice = nextTime - mMaxClusterSizeTime - 2;
+    }
   }
 }
 
@@ -235,8 +263,8 @@ std::vector<std::tuple<int, int, int>> KrBoxClusterFinder::findLocalMaxima(bool
   std::vector<std::tuple<int, int, int>> localMaximaCoords;
 
   const int iTime = mMaxClusterSizeTime;
-  const auto& mapRow = mSetOfTimeSlices[iTime];
-  const auto& thresholdInfo = mThresholdInfo[iTime];
+  const auto& mapRow = getTimeSlice(iTime);
+  const auto& thresholdInfo = getThresholdInfo(iTime);
 
   for (int iRow = 0; iRow < MaxRows; iRow++) { // mapRow.size()
     // Since pad size is different for each ROC, we take this into account while looking for maxima:
@@ -289,29 +317,29 @@ std::vector<std::tuple<int, int, int>> KrBoxClusterFinder::findLocalMaxima(bool
         noNeighbours++;
       }
 
-      if ((iRow + 1 < MaxRows) && (mSetOfTimeSlices[iTime][iRow + 1][iPad] > mQThreshold)) {
-        if (mSetOfTimeSlices[iTime][iRow + 1][iPad] > qMax) {
+      if ((iRow + 1 < MaxRows) && (getTimeSlice(iTime)[iRow + 1][iPad] > mQThreshold)) {
+        if (getTimeSlice(iTime)[iRow + 1][iPad] > qMax) {
           continue;
         }
         noNeighbours++;
       }
 
-      if ((iRow - 1 >= 0) && (mSetOfTimeSlices[iTime][iRow - 1][iPad] > mQThreshold)) {
-        if (mSetOfTimeSlices[iTime][iRow - 1][iPad] > qMax) {
+      if ((iRow - 1 >= 0) && (getTimeSlice(iTime)[iRow - 1][iPad] > mQThreshold)) {
+        if (getTimeSlice(iTime)[iRow - 1][iPad] > qMax) {
           continue;
         }
         noNeighbours++;
       }
 
-      if ((iTime + 1 < mMaxTimes) && (mSetOfTimeSlices[iTime + 1][iRow][iPad] > mQThreshold)) {
-        if (mSetOfTimeSlices[iTime + 1][iRow][iPad] > qMax) {
+      if ((iTime + 1 < mMaxTimes) && (getTimeSlice(iTime + 1)[iRow][iPad] > mQThreshold)) {
+        if (getTimeSlice(iTime + 1)[iRow][iPad] > qMax) {
           continue;
         }
         noNeighbours++;
       }
 
-      if ((iTime - 1 >= 0) && (mSetOfTimeSlices[iTime - 1][iRow][iPad] > mQThreshold)) {
-        if (mSetOfTimeSlices[iTime - 1][iRow][iPad] > qMax) {
+      if ((iTime - 1 >= 0) && (getTimeSlice(iTime - 1)[iRow][iPad] > mQThreshold)) {
+        if (getTimeSlice(iTime - 1)[iRow][iPad] > qMax) {
           continue;
         }
         noNeighbours++;
@@ -339,7 +367,7 @@ std::vector<std::tuple<int, int, int>> KrBoxClusterFinder::findLocalMaxima(bool
             if ((iPad + i >= MaxPads) || (iPad + i < 0)) {
               continue;
             }
-            if (mSetOfTimeSlices[iTime + j][iRow + k][iPad + i] > qMax) {
+            if (getTimeSlice(iTime + j)[iRow + k][iPad + i] > qMax) {
               thisIsMax = false;
             }
           }
@@ -428,42 +456,42 @@ KrCluster KrBoxClusterFinder::buildCluster(int clusterCenterPad, int clusterCent
 
         // Second: Check if charge is above threshold
         // Might be not necessary since we deal with pedestal subtracted data
-        if (mSetOfTimeSlices[clusterCenterTime + iTime][clusterCenterRow + iRow][clusterCenterPad + iPad] <= mQThreshold) {
+        if (getTimeSlice(clusterCenterTime + iTime)[clusterCenterRow + iRow][clusterCenterPad + iPad] <= mQThreshold) {
           continue;
         }
         // If not, there are several cases which were explained (for 2D) in the header of the code.
         // The first one is for the diagonal. So, the digit we are investigating here is on the diagonal:
         if (std::abs(iTime) == std::abs(iPad) && std::abs(iTime) == std::abs(iRow)) {
           // Now we check, if the next inner digit has a signal above threshold:
-          if (mSetOfTimeSlices[clusterCenterTime + iTime - signnum(iTime)][clusterCenterRow + iRow - signnum(iRow)][clusterCenterPad + iPad - signnum(iPad)] > mQThreshold) {
+          if (getTimeSlice(clusterCenterTime + iTime - signnum(iTime))[clusterCenterRow + iRow - signnum(iRow)][clusterCenterPad + iPad - signnum(iPad)] > mQThreshold) {
             // If yes, the cluster gets updated with the digit on the diagonal.
-            updateTempCluster(mSetOfTimeSlices[clusterCenterTime + iTime][clusterCenterRow + iRow][clusterCenterPad + iPad], clusterCenterPad + iPad, clusterCenterRow + iRow, clusterCenterTime + iTime);
+            updateTempCluster(getTimeSlice(clusterCenterTime + iTime)[clusterCenterRow + iRow][clusterCenterPad + iPad], clusterCenterPad + iPad, clusterCenterRow + iRow, clusterCenterTime + iTime);
           }
         }
         // Basically, we go through every possible case in the next few if-else conditions:
         else if (std::abs(iTime) == std::abs(iPad)) {
-          if (mSetOfTimeSlices[clusterCenterTime + iTime - signnum(iTime)][clusterCenterRow + iRow][clusterCenterPad + iPad - signnum(iPad)] > mQThreshold) {
-            updateTempCluster(mSetOfTimeSlices[clusterCenterTime + iTime][clusterCenterRow + iRow][clusterCenterPad + iPad], clusterCenterPad + iPad, clusterCenterRow + iRow, clusterCenterTime + iTime);
+          if (getTimeSlice(clusterCenterTime + iTime - signnum(iTime))[clusterCenterRow + iRow][clusterCenterPad + iPad - signnum(iPad)] > mQThreshold) {
+            updateTempCluster(getTimeSlice(clusterCenterTime + iTime)[clusterCenterRow + iRow][clusterCenterPad + iPad], clusterCenterPad + iPad, clusterCenterRow + iRow, clusterCenterTime + iTime);
           }
         } else if (std::abs(iTime) == std::abs(iRow)) {
-          if (mSetOfTimeSlices[clusterCenterTime + iTime - signnum(iTime)][clusterCenterRow + iRow - signnum(iRow)][clusterCenterPad + iPad] > mQThreshold) {
-            updateTempCluster(mSetOfTimeSlices[clusterCenterTime + iTime][clusterCenterRow + iRow][clusterCenterPad + iPad], clusterCenterPad + iPad, clusterCenterRow + iRow, clusterCenterTime + iTime);
+          if (getTimeSlice(clusterCenterTime + iTime - signnum(iTime))[clusterCenterRow + iRow - signnum(iRow)][clusterCenterPad + iPad] > mQThreshold) {
+            updateTempCluster(getTimeSlice(clusterCenterTime + iTime)[clusterCenterRow + iRow][clusterCenterPad + iPad], clusterCenterPad + iPad, clusterCenterRow + iRow, clusterCenterTime + iTime);
           }
         } else if (std::abs(iPad) == std::abs(iRow)) {
-          if (mSetOfTimeSlices[clusterCenterTime + iTime][clusterCenterRow + iRow - signnum(iRow)][clusterCenterPad + iPad - signnum(iPad)] > mQThreshold) {
-            updateTempCluster(mSetOfTimeSlices[clusterCenterTime + iTime][clusterCenterRow + iRow][clusterCenterPad + iPad], clusterCenterPad + iPad, clusterCenterRow + iRow, clusterCenterTime + iTime);
+          if (getTimeSlice(clusterCenterTime + iTime)[clusterCenterRow + iRow - signnum(iRow)][clusterCenterPad + iPad - signnum(iPad)] > mQThreshold) {
+            updateTempCluster(getTimeSlice(clusterCenterTime + iTime)[clusterCenterRow + iRow][clusterCenterPad + iPad], clusterCenterPad + iPad, clusterCenterRow + iRow, clusterCenterTime + iTime);
           }
         } else if (std::abs(iTime) > std::abs(iPad) && std::abs(iTime) > std::abs(iRow)) {
-          if (mSetOfTimeSlices[clusterCenterTime + iTime - signnum(iTime)][clusterCenterRow + iRow][clusterCenterPad + iPad] > mQThreshold) {
-            updateTempCluster(mSetOfTimeSlices[clusterCenterTime + iTime][clusterCenterRow + iRow][clusterCenterPad + iPad], clusterCenterPad + iPad, clusterCenterRow + iRow, clusterCenterTime + iTime);
+          if (getTimeSlice(clusterCenterTime + iTime - signnum(iTime))[clusterCenterRow + iRow][clusterCenterPad + iPad] > mQThreshold) {
+            updateTempCluster(getTimeSlice(clusterCenterTime + iTime)[clusterCenterRow + iRow][clusterCenterPad + iPad], clusterCenterPad + iPad, clusterCenterRow + iRow, clusterCenterTime + iTime);
           }
         } else if (std::abs(iTime) < std::abs(iPad) && std::abs(iPad) > std::abs(iRow)) {
-          if (mSetOfTimeSlices[clusterCenterTime + iTime][clusterCenterRow + iRow][clusterCenterPad + iPad - signnum(iPad)] > mQThreshold) {
-            updateTempCluster(mSetOfTimeSlices[clusterCenterTime + iTime][clusterCenterRow + iRow][clusterCenterPad + iPad], clusterCenterPad + iPad, clusterCenterRow + iRow, clusterCenterTime + iTime);
+          if (getTimeSlice(clusterCenterTime + iTime)[clusterCenterRow + iRow][clusterCenterPad + iPad - signnum(iPad)] > mQThreshold) {
+            updateTempCluster(getTimeSlice(clusterCenterTime + iTime)[clusterCenterRow + iRow][clusterCenterPad + iPad], clusterCenterPad + iPad, clusterCenterRow + iRow, clusterCenterTime + iTime);
           }
         } else if (std::abs(iTime) < std::abs(iRow) && std::abs(iPad) < std::abs(iRow)) {
-          if (mSetOfTimeSlices[clusterCenterTime + iTime][clusterCenterRow + iRow - signnum(iRow)][clusterCenterPad + iPad] > mQThreshold) {
-            updateTempCluster(mSetOfTimeSlices[clusterCenterTime + iTime][clusterCenterRow + iRow][clusterCenterPad + iPad], clusterCenterPad + iPad, clusterCenterRow + iRow, clusterCenterTime + iTime);
+          if (getTimeSlice(clusterCenterTime + iTime)[clusterCenterRow + iRow - signnum(iRow)][clusterCenterPad + iPad] > mQThreshold) {
+            updateTempCluster(getTimeSlice(clusterCenterTime + iTime)[clusterCenterRow + iRow][clusterCenterPad + iPad], clusterCenterPad + iPad, clusterCenterRow + iRow, clusterCenterTime + iTime);
           }
         }
       }
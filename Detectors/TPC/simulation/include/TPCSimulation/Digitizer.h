@@ -21,6 +21,7 @@
 #include "TPCBase/Mapper.h"
 
 #include <cmath>
+#include <memory>
 
 class TTree;
 class TH3;
@@ -135,13 +136,19 @@ class Digitizer
   void setDistortionScaleType(int distortionScaleType) { mDistortionScaleType = distortionScaleType; }
   int getDistortionScaleType() const { return mDistortionScaleType; }
   void setLumiScaleFactor();
+
+  /// Take over the configuration of another digitizer, e.g. for processing sectors in parallel
+  /// The space-charge maps are shared and only used read-only by the digitizers
+  /// \param other digitizer to copy the settings from
+  void copySettingsFrom(const Digitizer& other);
+
   void setMeanLumiDistortions(float meanLumi);
   void setMeanLumiDistortionsDerivative(float meanLumi);
 
  private:
   DigitContainer mDigitContainer;      ///< Container for the Digits
-  std::unique_ptr<SC> mSpaceCharge;    ///< Handler of full distortions (static + IR dependant)
-  std::unique_ptr<SC> mSpaceChargeDer; ///< Handler of reference static distortions
+  std::shared_ptr<SC> mSpaceCharge;    //!< Handler of full distortions (static + IR dependant)
+  std::shared_ptr<SC> mSpaceChargeDer; //!< Handler of reference static distortions
   Sector mSector = -1;                 ///< ID of the currently processed sector
   double mEventTime = 0.f;             ///< Time of the currently processed event
   double mOutputDigitTimeOffset = 0;   ///< Time of the first IR sampled in the digitizer
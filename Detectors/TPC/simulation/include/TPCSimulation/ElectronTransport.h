@@ -22,6 +22,8 @@
 #include "TPCBase/Mapper.h"
 #include "MathUtils/RandomRing.h"
 
+#include <vector>
+
 namespace o2
 {
 namespace tpc
@@ -37,7 +39,7 @@ class ElectronTransport
  public:
   static ElectronTransport& instance()
   {
-    static ElectronTransport electronTransport;
+    static thread_local ElectronTransport electronTransport; // one per thread, the random rings are not thread-safe
     return electronTransport;
   }
 
@@ -53,6 +55,14 @@ class ElectronTransport
   /// \return GlobalPosition3D with position of the electrons after the drift taking into account diffusion
   GlobalPosition3D getElectronDrift(GlobalPosition3D posEle, float& driftTime);
 
+  /// Drift of a batch of electrons starting at the same position, taking into account diffusion
+  /// The random numbers are used in the same order as for nElectrons calls of the single electron version
+  /// \param posEle GlobalPosition3D with start position of the electrons
+  /// \param nElectrons Number of electrons to drift
+  /// \param posEleDiff Output container with the positions of the electrons after the drift
+  /// \param driftTime Output container with the drift times taking into account diffusion in z direction
+  void getElectronDrift(GlobalPosition3D posEle, int nElectrons, std::vector<GlobalPosition3D>& posEleDiff, std::vector<float>& driftTime);
+
   /// Drift of electrons in electric field taking into account diffusion with 3 sigma of the width
   /// \param posEle GlobalPosition3D with start position of the electrons
   /// \return GlobalPosition3D with position of the electrons after the drift taking into account diffusion with
@@ -79,6 +89,7 @@ class ElectronTransport
   math_utils::RandomRing<> mRandomGaus;
   /// Circular random buffer containing flat random values to take into account electron attachment during drift
   math_utils::RandomRing<> mRandomFlat;
+  std::vector<float> mGausBuffer;     ///< Workspace for the random values of a batch of electrons
   const ParameterDetector* mDetParam; ///< Caching of the parameter class to avoid multiple CDB calls
   const ParameterGas* mGasParam;      ///< Caching of the parameter class to avoid multiple CDB calls
   float mVDrift = 0;                  ///< VDrift for current timestamp
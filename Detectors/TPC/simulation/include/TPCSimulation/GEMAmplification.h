@@ -39,7 +39,7 @@ class GEMAmplification
   /// Default constructor
   static GEMAmplification& instance()
   {
-    static GEMAmplification gemAmplification;
+    static thread_local GEMAmplification gemAmplification; // one per thread, the random rings are not thread-safe
     return gemAmplification;
   }
 
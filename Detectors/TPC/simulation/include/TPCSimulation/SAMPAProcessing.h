@@ -42,7 +42,7 @@ class SAMPAProcessing
  public:
   static SAMPAProcessing& instance()
   {
-    static SAMPAProcessing sampaProcessing;
+    static thread_local SAMPAProcessing sampaProcessing; // one per thread, the random rings are not thread-safe
     return sampaProcessing;
   }
   /// Destructor
@@ -15,6 +15,7 @@
 
 #include "TPCSimulation/DigitContainer.h"
 #include <memory>
+#include <mutex>
 #include <fairlogger/Logger.h>
 #include "TPCBase/Mapper.h"
 #include "TPCBase/CDBInterface.h"
@@ -45,6 +46,11 @@ void DigitContainer::fillOutputContainer(std::vector<Digit>& output,
 
   auto& cdb = CDBInterface::instance();
 
+  // the calibration objects are loaded lazily by the CDBInterface, which is shared
+  // between digitizers running in different threads
+  static std::mutex cdbMutex;
+  std::unique_lock<std::mutex> cdbLock(cdbMutex);
+
   // ion tail per pad parameters
   const CalPad* padParams[3] = {nullptr, nullptr, nullptr};
 
@@ -82,6 +88,8 @@ void DigitContainer::fillOutputContainer(std::vector<Digit>& output,
     }
     reportedSettings = true;
   }
+  const bool isCMCEnabled = (digitizationMode == DigitzationMode::Auto) && cdb.getFEEConfig().isCMCEnabled();
+  cdbLock.unlock();
 
   for (auto& time : mTimeBins) {
     /// the time bins between the last event and the timing of this event are uncorrelated and can be written out
@@ -133,8 +141,7 @@ void DigitContainer::fillOutputContainer(std::vector<Digit>& output,
           break;
         }
         case DigitzationMode::Auto: {
-          const auto& feeConfig = cdb.getFEEConfig();
-          if (feeConfig.isCMCEnabled()) {
+          if (isCMCEnabled) {
             time->fillOutputContainer<DigitzationMode::ZeroSuppressionCMCorr>(output, mcTruth, commonModeOutput, sector, timeBin, mPrevDigArr.get(), debugStream, padParams, deadMap);
           } else {
             time->fillOutputContainer<DigitzationMode::ZeroSuppression>(output, mcTruth, commonModeOutput, sector, timeBin, mPrevDigArr.get(), debugStream, padParams, deadMap);
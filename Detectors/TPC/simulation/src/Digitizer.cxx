@@ -30,6 +30,7 @@
 #include "TPCCalibration/CorrMapParam.h"
 
 #include <fairlogger/Logger.h>
+#include <mutex>
 
 ClassImp(o2::tpc::Digitizer);
 
@@ -39,8 +40,16 @@ Digitizer::~Digitizer() = default;
 
 Digitizer::Digitizer() = default;
 
+namespace
+{
+// the (per thread) processing singletons are created and updated from the CDBInterface,
+// which is not thread-safe
+std::mutex parameterMutex;
+} // namespace
+
 void Digitizer::init()
 {
+  std::lock_guard<std::mutex> lock(parameterMutex);
   auto& gemAmplification = GEMAmplification::instance();
   gemAmplification.updateParameters();
   auto& electronTransport = ElectronTransport::instance();
@@ -63,8 +72,10 @@ void Digitizer::process(const std::vector<o2::tpc::HitGroup>& hits,
 
   const int nShapedPoints = eleParam.NShapedPoints;
   const auto amplificationMode = gemParam.AmplMode;
-  static std::vector<float> signalArray;
+  static thread_local std::vector<float> signalArray;
   signalArray.resize(nShapedPoints);
+  static thread_local std::vector<GlobalPosition3D> posEleDiffArray;
+  static thread_local std::vector<float> driftTimeArray;
 
   /// Reserve space in the digit container for the current event
   mDigitContainer.reserve(sampaProcessing.getTimeBinFromTime(mEventTime - mOutputDigitTimeOffset));
@@ -95,15 +106,16 @@ void Digitizer::process(const std::vector<o2::tpc::HitGroup>& hits,
       /// The energy loss stored corresponds to nElectrons
       const int nPrimaryElectrons = static_cast<int>(eh.GetEnergyLoss());
       const float hitTime = eh.GetTime() * 0.001; /// in us
-      float driftTime = 0.f;
 
       /// TODO: add primary ions to space-charge density
 
+      /// Drift and Diffusion of all electrons of the hit
+      electronTransport.getElectronDrift(posEle, nPrimaryElectrons, posEleDiffArray, driftTimeArray);
+
       /// Loop over electrons
       for (int iEle = 0; iEle < nPrimaryElectrons; ++iEle) {
-
-        /// Drift and Diffusion
-        const GlobalPosition3D posEleDiff = electronTransport.getElectronDrift(posEle, driftTime);
+        const GlobalPosition3D& posEleDiff = posEleDiffArray[iEle];
+        const float driftTime = driftTimeArray[iEle];
         const float eleTime = driftTime + hitTime; /// in us
         if (eleTime >= maxEleTime) {
           // LOG(warning) << "Skipping electron with driftTime " << driftTime << " from hit at time " << hitTime;
@@ -176,7 +188,7 @@ void Digitizer::setUseSCDistortions(const SCDistortionType& distortionType, cons
 {
   mUseSCDistortions = true;
   if (!mSpaceCharge) {
-    mSpaceCharge = std::make_unique<SC>();
+    mSpaceCharge = std::make_shared<SC>();
   }
   mSpaceCharge->setSCDistortionType(distortionType);
   if (hisInitialSCDensity) {
@@ -204,7 +216,7 @@ void Digitizer::setUseSCDistortions(std::string_view finp)
 {
   mUseSCDistortions = true;
   if (!mSpaceCharge) {
-    mSpaceCharge = std::make_unique<SC>();
+    mSpaceCharge = std::make_shared<SC>();
   }
 
   // in case analytical distortions are loaded from file they are applied
@@ -217,11 +229,25 @@ void Digitizer::setUseSCDistortions(std::string_view finp)
 
 void Digitizer::setStartTime(double time)
 {
+  std::lock_guard<std::mutex> lock(parameterMutex);
   SAMPAProcessing& sampaProcessing = SAMPAProcessing::instance();
   sampaProcessing.updateParameters(mVDrift);
   mDigitContainer.setStartTime(sampaProcessing.getTimeBinFromTime(time - mOutputDigitTimeOffset));
 }
 
+void Digitizer::copySettingsFrom(const Digitizer& other)
+{
+  mIsContinuous = other.mIsContinuous;
+  mVDrift = other.mVDrift;
+  mTDriftOffset = other.mTDriftOffset;
+  mOutputDigitTimeOffset = other.mOutputDigitTimeOffset;
+  mUseSCDistortions = other.mUseSCDistortions;
+  mDistortionScaleType = other.mDistortionScaleType;
+  mLumiScaleFactor = other.mLumiScaleFactor;
+  mSpaceCharge = other.mSpaceCharge;
+  mSpaceChargeDer = other.mSpaceChargeDer;
+}
+
 void Digitizer::setLumiScaleFactor()
 {
   mLumiScaleFactor = (CorrMapParam::Instance().lumiInst - mSpaceCharge->getMeanLumi()) / mSpaceChargeDer->getMeanLumi();
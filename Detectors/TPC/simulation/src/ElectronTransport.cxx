@@ -65,6 +65,40 @@ GlobalPosition3D ElectronTransport::getElectronDrift(GlobalPosition3D posEle, fl
   return posEleDiffusion;
 }
 
+void ElectronTransport::getElectronDrift(GlobalPosition3D posEle, int nElectrons, std::vector<GlobalPosition3D>& posEleDiff, std::vector<float>& driftTime)
+{
+  const size_t n = nElectrons > 0 ? nElectrons : 0;
+  posEleDiff.resize(n);
+  driftTime.resize(n);
+  if (n == 0) {
+    return;
+  }
+
+  /// The diffusion widths only depend on the start position and are identical for all electrons
+  float driftl = mDetParam->TPClength - std::abs(posEle.Z());
+  if (driftl < 0.01) {
+    driftl = 0.01;
+  }
+  driftl = std::sqrt(driftl);
+  const float sigT = driftl * mGasParam->DiffT;
+  const float sigL = driftl * mGasParam->DiffL;
+
+  /// Take the Gaussian random values of all electrons at once, (x, y, z) per electron
+  mGausBuffer.resize(3 * n);
+  mRandomGaus.getNextValues(mGausBuffer.data(), 3 * n);
+
+  const float* gaus = mGausBuffer.data();
+  for (size_t i = 0; i < n; ++i) {
+    const float z = (gaus[3 * i + 2] * sigL) + posEle.Z();
+    /// Electrons changing the side keep the old z position, only their drift time is elongated
+    const bool sideChange = posEle.Z() / z < 0.f;
+    driftTime[i] = getDriftTime(z, sideChange ? -1.f : 1.f);
+    posEleDiff[i].SetCoordinates((gaus[3 * i] * sigT) + posEle.X(),
+                                 (gaus[3 * i + 1] * sigT) + posEle.Y(),
+                                 sideChange ? posEle.Z() : z);
+  }
+}
+
 bool ElectronTransport::isCompletelyOutOfSectorCoarseElectronDrift(GlobalPosition3D posEle, const Sector& sector) const
 {
   /// For drift lengths shorter than 1 mm, the drift length is set to that value
@@ -121,6 +121,60 @@ BOOST_AUTO_TEST_CASE(ElectronDiffusion_test2)
   BOOST_CHECK_CLOSE(gausZ.GetParameter(2), gasParam.DiffL, 0.5);
 }
 
+/// \brief Test of the batch version of the getElectronDrift function
+/// Same as test 2, but drifting the electrons in batches
+///
+/// Precision: 0.5 %.
+BOOST_AUTO_TEST_CASE(ElectronDiffusion_batch)
+{
+  auto& gasParam = ParameterGas::Instance();
+  auto& detParam = ParameterDetector::Instance();
+  const GlobalPosition3D posEle(1.f, 1.f, detParam.TPClength - 1.f);
+  TH1D hTestDiffX("hTestDiffXBatch", "", 500, posEle.X() - 1., posEle.X() + 1.);
+  TH1D hTestDiffY("hTestDiffYBatch", "", 500, posEle.Y() - 1., posEle.Y() + 1.);
+  TH1D hTestDiffZ("hTestDiffZBatch", "", 500, posEle.Z() - 1., posEle.Z() + 1.);
+
+  TF1 gausX("gausX", "gaus");
+  TF1 gausY("gausY", "gaus");
+  TF1 gausZ("gausZ", "gaus");
+
+  static ElectronTransport& electronTransport = ElectronTransport::instance();
+  std::vector<GlobalPosition3D> posEleDiff;
+  std::vector<float> driftTime;
+
+  for (int i = 0; i < 1000; ++i) {
+    electronTransport.getElectronDrift(posEle, 500, posEleDiff, driftTime);
+    BOOST_CHECK_EQUAL(posEleDiff.size(), 500);
+    BOOST_CHECK_EQUAL(driftTime.size(), 500);
+    for (size_t iEle = 0; iEle < posEleDiff.size(); ++iEle) {
+      hTestDiffX.Fill(posEleDiff[iEle].X());
+      hTestDiffY.Fill(posEleDiff[iEle].Y());
+      hTestDiffZ.Fill(posEleDiff[iEle].Z());
+    }
+    // the drift time corresponds to the smeared z position
+    BOOST_CHECK_CLOSE(driftTime[0], electronTransport.getDriftTime(posEleDiff[0].Z()), 1e-3);
+  }
+
+  hTestDiffX.Fit("gausX", "Q0");
+  hTestDiffY.Fit("gausY", "Q0");
+  hTestDiffZ.Fit("gausZ", "Q0");
+
+  // check whether the mean of the gaussian fit matches the starting point
+  BOOST_CHECK_CLOSE(gausX.GetParameter(1), posEle.X(), 0.5);
+  BOOST_CHECK_CLOSE(gausY.GetParameter(1), posEle.Y(), 0.5);
+  BOOST_CHECK_CLOSE(gausZ.GetParameter(1), posEle.Z(), 0.5);
+
+  // check whether the width of the distribution matches the expected one
+  BOOST_CHECK_CLOSE(gausX.GetParameter(2), gasParam.DiffT, 0.5);
+  BOOST_CHECK_CLOSE(gausY.GetParameter(2), gasParam.DiffT, 0.5);
+  BOOST_CHECK_CLOSE(gausZ.GetParameter(2), gasParam.DiffL, 0.5);
+
+  // no electrons requested
+  electronTransport.getElectronDrift(posEle, 0, posEleDiff, driftTime);
+  BOOST_CHECK(posEleDiff.empty());
+  BOOST_CHECK(driftTime.empty());
+}
+
 /// \brief Test of the isElectronAttachment function
 /// We let the electrons drift for 100 us and compare the fraction
 /// of lost electrons to the expected value
@@ -0,0 +1,111 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file PoissonSolverGPU.h
+/// \brief Multigrid Poisson solver and electric field calculation on GPU
+///
+/// The multigrid cycles follow PoissonSolver::poissonMultiGrid3D (full coarsening) and use the MGParameters and the convergence error of the PoissonSolver.
+/// The relaxation is always done with the red-black Gauss-Seidel method, where the two colours are updated in parallel.
+
+#ifndef ALICEO2_TPC_POISSONSOLVERGPU_H_
+#define ALICEO2_TPC_POISSONSOLVERGPU_H_
+
+#include "TPCSpaceCharge/RegularGrid3D.h"
+#include "TPCSpaceCharge/DataContainer3D.h"
+#include <vector>
+
+namespace o2
+{
+namespace tpc
+{
+
+/// \class PoissonSolverGPU
+/// Solves the Poisson equation in cylindrical coordinates on a GPU.
+/// The device memory of the multigrid levels is kept until the object is destroyed, so that the same object can be used to solve the equation for many charge densities.
+/// Usage:
+///     PoissonSolverGPU<double> solver(spaceCharge.getGrid3D(Side::A));
+///     spaceCharge.poissonSolver(solver, Side::A);
+///     spaceCharge.calcEField(solver, Side::A);
+
+/// \tparam DataT the type of data which is used during the calculations
+template <typename DataT = double>
+class PoissonSolverGPU
+{
+ public:
+  using RegularGrid = RegularGrid3D<DataT>;
+  using DataContainer = DataContainer3D<DataT>;
+
+  /// constructor
+  PoissonSolverGPU(const RegularGrid& gridProperties) : mGrid3D{gridProperties} {};
+
+  /// frees the device memory
+  ~PoissonSolverGPU();
+
+  PoissonSolverGPU(const PoissonSolverGPU&) = delete;
+  PoissonSolverGPU& operator=(const PoissonSolverGPU&) = delete;
+
+  /// solve the Poisson equation in 3D with the multigrid method using full coarsening
+  /// \param matricesV potential in 3D, the boundary values have to be set
+  /// \param matricesCharge charge density in 3D
+  /// \param symmetry symmetry in phi (0: none, 1: reflection, -1: anti-symmetry)
+  void poissonSolver3D(DataContainer& matricesV, const DataContainer& matricesCharge, const int symmetry);
+
+  /// calculate the electric field from the potential (see SpaceCharge::calcEField)
+  /// \param potential potential in 3D
+  /// \param eZ electric field in z direction
+  /// \param eR electric field in r direction
+  /// \param ePhi electric field in phi direction
+  /// \param symmetry symmetry in phi (0: none, 1: reflection, -1: anti-symmetry)
+  void calcEField(const DataContainer& potential, DataContainer& eZ, DataContainer& eR, DataContainer& ePhi, const int symmetry = 0);
+
+ private:
+  /// device memory and properties of one level of the multigrid
+  struct Level {
+    unsigned short nZ{};     ///< number of z vertices
+    unsigned short nR{};     ///< number of r vertices
+    unsigned short nPhi{};   ///< number of phi vertices
+    DataT h{};               ///< grid spacing in r
+    DataT ratioZ{};          ///< ratio between the square of the grid spacing in r and in z
+    DataT ratioPhi{};        ///< ratio between the square of the grid spacing in r and in phi
+    DataT* potential{};      ///< potential <--> error
+    DataT* charge{};         ///< charge <--> residue
+    DataT* chargeFMG{};      ///< charge restricted in the full multigrid
+    DataT* residue{};        ///< residue calculation
+    DataT* prevPotential{};  ///< error calculation
+    size_t getNDataPoints() const { return static_cast<size_t>(nZ) * nR * nPhi; }
+  };
+
+  const RegularGrid& mGrid3D{};                            ///< grid properties
+  const ParamSpaceCharge mParamGrid{mGrid3D.getParamSC()}; ///< parameters of the grid on which the calculations are performed
+  std::vector<Level> mLevels;                              ///< multigrid levels, the first one is the finest grid
+  DataT* mSumBuffer{};                                     ///< device buffer for the convergence error
+  std::vector<DataT*> mEFieldBuffers;                      ///< device buffers for the electric field calculation
+
+  /// allocate the device memory for the multigrid levels if not yet done
+  void initLevels(const int nLoop, const int nnPhi);
+
+  /// free the device memory
+  void freeMemory();
+
+  /// one red-black Gauss-Seidel iteration on a level
+  void relax(const Level& level, const DataT* charge, const int symmetry) const;
+
+  /// V-cycle from level gridFrom - 1 to the coarsest level gridTo - 1 and back
+  void vCycle3D(const int symmetry, const int gridFrom, const int gridTo) const;
+
+  /// \returns inverse grid size in phi (either 1/2Pi or NSECTORSPERSIDE/2Pi)
+  static DataT getGridSizePhiInv();
+};
+
+} // namespace tpc
+} // namespace o2
+
+#endif
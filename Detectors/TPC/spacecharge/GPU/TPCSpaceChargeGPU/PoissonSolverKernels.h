@@ -0,0 +1,79 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file PoissonSolverKernels.h
+/// \brief Host interface to the device memory management and to the kernels of the GPU Poisson solver
+///
+/// All grids are passed as DataContainer3DView pointing to device memory and have the memory layout of the DataContainer3D.
+
+#ifndef ALICEO2_TPC_POISSONSOLVERKERNELS_H_
+#define ALICEO2_TPC_POISSONSOLVERKERNELS_H_
+
+#include "TPCSpaceCharge/DataContainer3DView.h"
+#include <cstddef>
+
+namespace o2
+{
+namespace tpc
+{
+
+/// \tparam DataT the type of data which is used during the calculations
+template <typename DataT>
+struct PoissonSolverKernels {
+  using View = DataContainer3DView<DataT>;
+  using ConstView = DataContainer3DView<const DataT>;
+
+  /// \return returns zero initialized device memory for nValues values
+  static DataT* allocate(const size_t nValues);
+  static void deallocate(DataT* ptr);
+  static void setZero(DataT* ptr, const size_t nValues);
+  static void copyToDevice(DataT* dst, const DataT* src, const size_t nValues);
+  static void copyToHost(DataT* dst, const DataT* src, const size_t nValues);
+  static void copyOnDevice(DataT* dst, const DataT* src, const size_t nValues);
+
+  /// one sweep of the red-black Gauss-Seidel relaxation over the vertices of one colour
+  /// \param potential potential which is relaxed
+  /// \param charge charge density on the same grid
+  /// \param symmetry symmetry in phi (0: none, 1: reflection, -1: anti-symmetry)
+  /// \param h grid spacing in r
+  /// \param ratioZ ratio between the square of the grid spacing in r and in z
+  /// \param ratioPhi ratio between the square of the grid spacing in r and in phi
+  /// \param radiusIFC radius of the first vertex in r
+  /// \param colour 0 or 1, the vertices with (ir + iz + iphi) % 2 == colour are updated
+  static void relax(View potential, ConstView charge, const int symmetry, const DataT h, const DataT ratioZ, const DataT ratioPhi, const DataT radiusIFC, const int colour);
+
+  /// residue of the discretised Poisson equation on the inner vertices
+  static void residue(View residue, ConstView potential, ConstView charge, const int symmetry, const DataT h, const DataT ratioZ, const DataT ratioPhi, const DataT radiusIFC);
+
+  /// restriction fine -> coarse grid, with full weighting in phi when the number of phi slices is halved
+  /// \param fullTransfer use full instead of half weighting if the number of phi slices is kept
+  static void restrictGrid(View coarse, ConstView fine, const bool fullTransfer);
+
+  /// copy of the boundary values fine -> coarse grid
+  static void restrictBoundary(View coarse, ConstView fine);
+
+  /// interpolation coarse -> fine grid of the inner vertices
+  /// \param add add the interpolated values to the fine grid instead of replacing them
+  /// \param fullTransfer interpolate also the vertices at the centre of the coarse cells if the number of phi slices is kept
+  static void interpolate(View fine, ConstView coarse, const bool add, const bool fullTransfer);
+
+  /// subtracts the current potential from the previous one and returns the largest sum of squares of a phi slice
+  /// \param buffer device memory for at least previous.getNPhi() values
+  static DataT convergenceError(View previous, ConstView potential, DataT* buffer);
+
+  /// electric field from the potential with central differences (forward/backward differences at the r and z boundaries)
+  static void electricField(ConstView potential, View eZ, View eR, View ePhi, const int symmetry, const DataT rMin, const DataT invSpacingZ, const DataT invSpacingR, const DataT invSpacingPhi);
+};
+
+} // namespace tpc
+} // namespace o2
+
+#endif
@@ -0,0 +1,264 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file PoissonSolverGPU.cxx
+/// \brief Host part of the multigrid Poisson solver on GPU
+
+#include "TPCSpaceChargeGPU/PoissonSolverGPU.h"
+#include "TPCSpaceChargeGPU/PoissonSolverKernels.h"
+#include "TPCSpaceCharge/PoissonSolver.h"
+#include "TPCSpaceCharge/PoissonSolverHelpers.h"
+#include "Framework/Logger.h"
+#include "DataFormatsTPC/Defs.h"
+#include <algorithm>
+#include <chrono>
+
+using namespace o2::tpc;
+
+template <typename DataT>
+PoissonSolverGPU<DataT>::~PoissonSolverGPU()
+{
+  freeMemory();
+}
+
+template <typename DataT>
+void PoissonSolverGPU<DataT>::poissonSolver3D(DataContainer& matricesV, const DataContainer& matricesCharge, const int symmetry)
+{
+  if (!MGParameters::isFull3D) {
+    LOGP(warning, "PoissonSolverGPU: only full coarsening is implemented on GPU, using the PoissonSolver on CPU");
+    PoissonSolver<DataT> poissonSolver(mGrid3D);
+    poissonSolver.poissonSolver3D(matricesV, matricesCharge, symmetry);
+    return;
+  }
+  if (MGParameters::relaxType != RelaxType::GaussSeidel) {
+    LOGP(warning, "PoissonSolverGPU: only the Gauss-Seidel relaxation is implemented on GPU");
+  }
+
+  using timer = std::chrono::high_resolution_clock;
+  auto start = timer::now();
+
+  // Check that the number of vertices is suitable for a binary expansion
+  const auto isPowerOfTwo = [](const int i) { return ((i > 0) && !(i & (i - 1))); };
+  if (!isPowerOfTwo(mParamGrid.NRVertices - 1) || !isPowerOfTwo(mParamGrid.NZVertices - 1) || (mParamGrid.NPhiVertices <= 3)) {
+    LOGP(error, "PoissonSolverGPU: Error in the number of vertices. NR and NZ must be 2**N + 1 and NPhi larger than 3");
+    return;
+  }
+
+  int nGridRow = 0;
+  int nnRow = mParamGrid.NRVertices;
+  while (nnRow >>= 1) {
+    ++nGridRow;
+  }
+  int nGridCol = 0;
+  int nnCol = mParamGrid.NZVertices;
+  while (nnCol >>= 1) {
+    ++nGridCol;
+  }
+  int nGridPhi = 0;
+  int nnPhi = mParamGrid.NPhiVertices;
+  while (nnPhi % 2 == 0) {
+    ++nGridPhi;
+    nnPhi /= 2;
+  }
+  const int nLoop = std::max({nGridRow, nGridCol, nGridPhi}); // number of levels of the binary expansion
+  initLevels(nLoop, nnPhi);
+
+  // the finest grid is set from the input
+  const auto& fine = mLevels.front();
+  const size_t nPoints = fine.getNDataPoints();
+  PoissonSolverKernels<DataT>::copyToDevice(fine.potential, matricesV.getView().mData, nPoints);
+  PoissonSolverKernels<DataT>::copyToDevice(fine.chargeFMG, matricesCharge.getView().mData, nPoints);
+  PoissonSolverKernels<DataT>::copyOnDevice(fine.charge, fine.chargeFMG, nPoints);
+
+  const DataT convergenceErrorMax = PoissonSolver<DataT>::getConvergenceError();
+  const bool fullTransfer = (MGParameters::gtType == GridTransferType::Full);
+  if (MGParameters::cycleType == CycleType::FCycle) {
+    // 1) Restrict charge and boundary to the coarser grids
+    for (int count = 1; count < nLoop; ++count) {
+      const auto& coarse = mLevels[count];
+      const auto& finer = mLevels[count - 1];
+      PoissonSolverKernels<DataT>::restrictGrid({coarse.chargeFMG, coarse.nZ, coarse.nR, coarse.nPhi}, {finer.chargeFMG, finer.nZ, finer.nR, finer.nPhi}, fullTransfer);
+      PoissonSolverKernels<DataT>::restrictBoundary({coarse.potential, coarse.nZ, coarse.nR, coarse.nPhi}, {finer.potential, finer.nZ, finer.nR, finer.nPhi});
+    }
+
+    // 2) Relax on the coarsest grid
+    relax(mLevels[nLoop - 1], mLevels[nLoop - 1].chargeFMG, symmetry);
+
+    // 3) V cycles from the coarsest to the finest grid
+    for (int count = nLoop - 2; count >= 0; --count) {
+      const auto& level = mLevels[count];
+      const auto& coarse = mLevels[count + 1];
+      PoissonSolverKernels<DataT>::interpolate({level.potential, level.nZ, level.nR, level.nPhi}, {coarse.potential, coarse.nZ, coarse.nR, coarse.nPhi}, false, fullTransfer);
+      if (count > 0) {
+        PoissonSolverKernels<DataT>::copyOnDevice(level.charge, level.chargeFMG, level.getNDataPoints());
+      }
+
+      for (int mgCycle = 0; mgCycle < MGParameters::nMGCycle; ++mgCycle) {
+        PoissonSolverKernels<DataT>::copyOnDevice(level.prevPotential, level.potential, level.getNDataPoints());
+        vCycle3D(symmetry, count + 1, nLoop);
+        const DataT convergenceError = PoissonSolverKernels<DataT>::convergenceError({level.prevPotential, level.nZ, level.nR, level.nPhi}, {level.potential, level.nZ, level.nR, level.nPhi}, mSumBuffer);
+        if (convergenceError <= convergenceErrorMax) {
+          LOGP(detail, "Cycle converged. Continue to next cycle...");
+          break;
+        }
+        if (mgCycle == (MGParameters::nMGCycle - 1)) {
+          LOGP(warning, "Cycle {} did not convergence! Current convergence error is larger than expected convergence error: {} > {}", mgCycle, convergenceError, convergenceErrorMax);
+        }
+      }
+    }
+  } else if (MGParameters::cycleType == CycleType::VCycle) {
+    for (int mgCycle = 0; mgCycle < MGParameters::nMGCycle; ++mgCycle) {
+      PoissonSolverKernels<DataT>::copyOnDevice(fine.prevPotential, fine.potential, nPoints);
+      vCycle3D(symmetry, 1, nLoop);
+      const DataT convergenceError = PoissonSolverKernels<DataT>::convergenceError({fine.prevPotential, fine.nZ, fine.nR, fine.nPhi}, {fine.potential, fine.nZ, fine.nR, fine.nPhi}, mSumBuffer);
+      if (convergenceError <= convergenceErrorMax) {
+        break;
+      }
+    }
+  }
+
+  // fill output
+  PoissonSolverKernels<DataT>::copyToHost(matricesV.getView().mData, fine.potential, nPoints);
+
+  auto stop = timer::now();
+  std::chrono::duration<float> time = stop - start;
+  LOGP(detail, "poissonSolver3D on GPU took {}s", time.count());
+}
+
+template <typename DataT>
+void PoissonSolverGPU<DataT>::calcEField(const DataContainer& potential, DataContainer& eZ, DataContainer& eR, DataContainer& ePhi, const int symmetry)
+{
+  const size_t nPoints = potential.getNDataPoints();
+  if (mEFieldBuffers.empty()) {
+    for (int i = 0; i < 4; ++i) {
+      mEFieldBuffers.emplace_back(PoissonSolverKernels<DataT>::allocate(nPoints));
+    }
+  }
+  const unsigned short nZ = potential.getNZ();
+  const unsigned short nR = potential.getNR();
+  const unsigned short nPhi = potential.getNPhi();
+  PoissonSolverKernels<DataT>::copyToDevice(mEFieldBuffers[0], potential.getView().mData, nPoints);
+  PoissonSolverKernels<DataT>::electricField({mEFieldBuffers[0], nZ, nR, nPhi}, {mEFieldBuffers[1], nZ, nR, nPhi}, {mEFieldBuffers[2], nZ, nR, nPhi}, {mEFieldBuffers[3], nZ, nR, nPhi}, symmetry,
+                                             mGrid3D.getGridMinR(), mGrid3D.getInvSpacingZ(), mGrid3D.getInvSpacingR(), mGrid3D.getInvSpacingPhi());
+  PoissonSolverKernels<DataT>::copyToHost(eZ.getView().mData, mEFieldBuffers[1], nPoints);
+  PoissonSolverKernels<DataT>::copyToHost(eR.getView().mData, mEFieldBuffers[2], nPoints);
+  PoissonSolverKernels<DataT>::copyToHost(ePhi.getView().mData, mEFieldBuffers[3], nPoints);
+}
+
+template <typename DataT>
+void PoissonSolverGPU<DataT>::initLevels(const int nLoop, const int nnPhi)
+{
+  if (mLevels.size() == static_cast<size_t>(nLoop)) {
+    return;
+  }
+  freeMemory();
+
+  const DataT gridSpacingR = mGrid3D.getSpacingR();
+  const DataT gridSpacingZ = mGrid3D.getSpacingZ();
+  const DataT ratioZ = gridSpacingR * gridSpacingR / (gridSpacingZ * gridSpacingZ); // ratio_{Z} = gridSize_{r} / gridSize_{z}
+  unsigned int iOne = 1;
+  mLevels.resize(nLoop);
+  for (auto& level : mLevels) {
+    level.nR = iOne == 1 ? mParamGrid.NRVertices : mParamGrid.NRVertices / iOne + 1;
+    level.nZ = iOne == 1 ? mParamGrid.NZVertices : mParamGrid.NZVertices / iOne + 1;
+    level.nPhi = iOne == 1 ? mParamGrid.NPhiVertices : mParamGrid.NPhiVertices / iOne;
+    level.nPhi = level.nPhi < nnPhi ? nnPhi : level.nPhi;
+    level.h = gridSpacingR * iOne;
+    const DataT gridSizePhiInv = level.nPhi * getGridSizePhiInv();
+    level.ratioPhi = level.h * level.h * gridSizePhiInv * gridSizePhiInv; // ratio_{phi} = gridSize_{r} / gridSize_{phi}
+    level.ratioZ = ratioZ;                                                 // the spacing in r and z is doubled for each level
+
+    const size_t nPoints = level.getNDataPoints();
+    level.potential = PoissonSolverKernels<DataT>::allocate(nPoints);
+    level.charge = PoissonSolverKernels<DataT>::allocate(nPoints);
+    level.chargeFMG = PoissonSolverKernels<DataT>::allocate(nPoints);
+    level.residue = PoissonSolverKernels<DataT>::allocate(nPoints);
+    level.prevPotential = PoissonSolverKernels<DataT>::allocate(nPoints);
+    iOne *= 2;
+  }
+  mSumBuffer = PoissonSolverKernels<DataT>::allocate(mParamGrid.NPhiVertices);
+}
+
+template <typename DataT>
+void PoissonSolverGPU<DataT>::freeMemory()
+{
+  for (auto& level : mLevels) {
+    for (auto ptr : {level.potential, level.charge, level.chargeFMG, level.residue, level.prevPotential}) {
+      PoissonSolverKernels<DataT>::deallocate(ptr);
+    }
+  }
+  mLevels.clear();
+  for (auto ptr : mEFieldBuffers) {
+    PoissonSolverKernels<DataT>::deallocate(ptr);
+  }
+  mEFieldBuffers.clear();
+  PoissonSolverKernels<DataT>::deallocate(mSumBuffer);
+  mSumBuffer = nullptr;
+}
+
+template <typename DataT>
+void PoissonSolverGPU<DataT>::relax(const Level& level, const DataT* charge, const int symmetry) const
+{
+  for (int colour = 0; colour < 2; ++colour) {
+    PoissonSolverKernels<DataT>::relax({level.potential, level.nZ, level.nR, level.nPhi}, {charge, level.nZ, level.nR, level.nPhi}, symmetry, level.h, level.ratioZ, level.ratioPhi, TPCParameters<DataT>::IFCRADIUS, colour);
+  }
+}
+
+template <typename DataT>
+void PoissonSolverGPU<DataT>::vCycle3D(const int symmetry, const int gridFrom, const int gridTo) const
+{
+  const bool fullTransfer = (MGParameters::gtType == GridTransferType::Full);
+  for (int count = gridFrom; count <= gridTo - 1; ++count) {
+    const auto& level = mLevels[count - 1];
+    const auto& coarse = mLevels[count];
+
+    // 1) Pre-Smoothing
+    for (int jPre = 1; jPre <= MGParameters::nPre; ++jPre) {
+      relax(level, level.charge, symmetry);
+    }
+
+    // 2) Residue calculation
+    PoissonSolverKernels<DataT>::residue({level.residue, level.nZ, level.nR, level.nPhi}, {level.potential, level.nZ, level.nR, level.nPhi}, {level.charge, level.nZ, level.nR, level.nPhi}, symmetry, level.h, level.ratioZ, level.ratioPhi, TPCParameters<DataT>::IFCRADIUS);
+
+    // 3) Restriction
+    PoissonSolverKernels<DataT>::restrictGrid({coarse.charge, coarse.nZ, coarse.nR, coarse.nPhi}, {level.residue, level.nZ, level.nR, level.nPhi}, fullTransfer);
+
+    // 4) Zeroing coarser V
+    PoissonSolverKernels<DataT>::setZero(coarse.potential, coarse.getNDataPoints());
+  }
+
+  // relax on the coarsest grid
+  relax(mLevels[gridTo - 1], mLevels[gridTo - 1].charge, symmetry);
+
+  // back to fine
+  for (int count = gridTo - 1; count >= gridFrom; --count) {
+    const auto& level = mLevels[count - 1];
+    const auto& coarse = mLevels[count];
+
+    // 4) Interpolation/Prolongation
+    PoissonSolverKernels<DataT>::interpolate({level.potential, level.nZ, level.nR, level.nPhi}, {coarse.potential, coarse.nZ, coarse.nR, coarse.nPhi}, true, fullTransfer);
+
+    // 5) Post-Smoothing
+    for (int jPost = 1; jPost <= MGParameters::nPost; ++jPost) {
+      relax(level, level.charge, symmetry);
+    }
+  }
+}
+
+template <typename DataT>
+DataT PoissonSolverGPU<DataT>::getGridSizePhiInv()
+{
+  constexpr DataT INVTWOPI = 1. / o2::constants::math::TwoPI;
+  return MGParameters::normalizeGridToOneSector ? (INVTWOPI * SECTORSPERSIDE) : INVTWOPI;
+}
+
+template class o2::tpc::PoissonSolverGPU<double>;
+template class o2::tpc::PoissonSolverGPU<float>;
@@ -0,0 +1,379 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file PoissonSolverKernels.cu
+/// \brief Kernels of the multigrid Poisson solver and of the electric field calculation on GPU
+
+#include <cuda_runtime.h>
+#include "TPCSpaceChargeGPU/PoissonSolverKernels.h"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+using namespace o2::tpc;
+
+namespace
+{
+constexpr int NThreadsPerBlock = 256;
+constexpr int MaxBlocks = 65535;
+
+void checkGPUError(const cudaError_t error, const char* file, const int line)
+{
+  if (error != cudaSuccess) {
+    std::ostringstream errorString{};
+    errorString << file << ":" << line << " TPC space-charge GPU API returned error [" << cudaGetErrorString(error) << "] (code " << error << ")";
+    throw std::runtime_error{errorString.str()};
+  }
+}
+
+int getNBlocks(const size_t nValues)
+{
+  return static_cast<int>(std::clamp<size_t>((nValues + NThreadsPerBlock - 1) / NThreadsPerBlock, 1, MaxBlocks));
+}
+
+/// indices of the neighbouring phi slices taking the symmetry into account
+GPUdi() void getPhiNeighbours(const int iPhi, const int nPhi, const int symmetry, int& iPhiPlus, int& iPhiMinus, int& signPlus, int& signMinus)
+{
+  iPhiPlus = iPhi + 1;
+  iPhiMinus = iPhi - 1;
+  signPlus = 1;
+  signMinus = 1;
+  if (symmetry == 1 || symmetry == -1) { // reflection or anti-symmetry in phi
+    if (iPhiPlus > nPhi - 1) {
+      iPhiPlus = nPhi - 2;
+      signPlus = symmetry;
+    }
+    if (iPhiMinus < 0) {
+      iPhiMinus = 1;
+      signMinus = symmetry;
+    }
+  } else { // no symmetries in phi, the calculation is continuous across all phi
+    if (iPhiPlus > nPhi - 1) {
+      iPhiPlus = iPhi + 1 - nPhi;
+    }
+    if (iPhiMinus < 0) {
+      iPhiMinus = iPhi - 1 + nPhi;
+    }
+  }
+}
+
+/// coefficients of the 7 point stencil in cylindrical coordinates (see PoissonSolver::calcCoefficients)
+template <typename DataT>
+struct StencilCoefficients {
+  DataT c1;    ///< coefficient for V(r+1)
+  DataT c2;    ///< coefficient for V(r-1)
+  DataT c3;    ///< coefficient for V(phi+1) and V(phi-1)
+  DataT c4Inv; ///< coefficient for V(r, z, phi)
+
+  GPUdi() StencilCoefficients(const int iR, const DataT h, const DataT ratioZ, const DataT ratioPhi, const DataT radiusIFC)
+  {
+    const DataT radiusInv = 1 / (radiusIFC + iR * h);
+    const DataT hRadiusTmp = h * radiusInv / 2;
+    c1 = 1 + hRadiusTmp;
+    c2 = 1 - hRadiusTmp;
+    c3 = ratioPhi * radiusInv * radiusInv;
+    c4Inv = 2 * (1 + ratioZ + c3);
+  }
+};
+
+template <typename View>
+GPUdi() void getIndices(const View& view, const size_t index, int& iZ, int& iR, int& iPhi)
+{
+  iZ = index % view.getNZ();
+  iR = (index / view.getNZ()) % view.getNR();
+  iPhi = index / (static_cast<size_t>(view.getNZ()) * view.getNR());
+}
+
+template <typename View>
+GPUdi() bool isBoundary(const View& view, const int iZ, const int iR)
+{
+  return (iZ == 0) || (iR == 0) || (iZ == view.getNZ() - 1) || (iR == view.getNR() - 1);
+}
+
+template <typename DataT>
+GPUdi() DataT stencil(DataContainer3DView<const DataT> v, const StencilCoefficients<DataT>& coeff, const int iZ, const int iR, const int iPhi, const int symmetry, const DataT ratioZ)
+{
+  int iPhiPlus, iPhiMinus, signPlus, signMinus;
+  getPhiNeighbours(iPhi, v.getNPhi(), symmetry, iPhiPlus, iPhiMinus, signPlus, signMinus);
+  return coeff.c2 * v(iZ, iR - 1, iPhi) + ratioZ * (v(iZ - 1, iR, iPhi) + v(iZ + 1, iR, iPhi)) + coeff.c1 * v(iZ, iR + 1, iPhi) + coeff.c3 * (signPlus * v(iZ, iR, iPhiPlus) + signMinus * v(iZ, iR, iPhiMinus));
+}
+
+template <typename DataT>
+GPUg() void relaxKernel(DataContainer3DView<DataT> v, DataContainer3DView<const DataT> charge, const int symmetry, const DataT h, const DataT ratioZ, const DataT ratioPhi, const DataT radiusIFC, const int colour)
+{
+  const DataContainer3DView<const DataT> vConst{v.mData, v.mZVertices, v.mRVertices, v.mPhiVertices};
+  for (size_t index = blockIdx.x * blockDim.x + threadIdx.x; index < v.getNDataPoints(); index += blockDim.x * gridDim.x) {
+    int iZ, iR, iPhi;
+    getIndices(v, index, iZ, iR, iPhi);
+    if (isBoundary(v, iZ, iR) || ((iZ + iR + iPhi) % 2 != colour)) {
+      continue;
+    }
+    const StencilCoefficients<DataT> coeff(iR, h, ratioZ, ratioPhi, radiusIFC);
+    v[index] = (stencil(vConst, coeff, iZ, iR, iPhi, symmetry, ratioZ) + h * h * charge[index]) / coeff.c4Inv;
+  }
+}
+
+template <typename DataT>
+GPUg() void residueKernel(DataContainer3DView<DataT> residue, DataContainer3DView<const DataT> v, DataContainer3DView<const DataT> charge, const int symmetry, const DataT h, const DataT ratioZ, const DataT ratioPhi, const DataT radiusIFC)
+{
+  const DataT ih2 = 1 / (h * h);
+  for (size_t index = blockIdx.x * blockDim.x + threadIdx.x; index < v.getNDataPoints(); index += blockDim.x * gridDim.x) {
+    int iZ, iR, iPhi;
+    getIndices(v, index, iZ, iR, iPhi);
+    if (isBoundary(v, iZ, iR)) {
+      continue;
+    }
+    const StencilCoefficients<DataT> coeff(iR, h, ratioZ, ratioPhi, radiusIFC);
+    residue[index] = ih2 * (stencil(v, coeff, iZ, iR, iPhi, symmetry, ratioZ) - coeff.c4Inv * v[index]) + charge[index];
+  }
+}
+
+template <typename DataT>
+GPUg() void restrictKernel(DataContainer3DView<DataT> coarse, DataContainer3DView<const DataT> fine, const bool fullTransfer, const bool boundaryOnly)
+{
+  const bool halvedPhi = (2 * coarse.getNPhi() == fine.getNPhi());
+  const int nPhiFine = fine.getNPhi();
+  for (size_t index = blockIdx.x * blockDim.x + threadIdx.x; index < coarse.getNDataPoints(); index += blockDim.x * gridDim.x) {
+    int iZ, iR, iPhi;
+    getIndices(coarse, index, iZ, iR, iPhi);
+    const int iZFine = 2 * iZ;
+    const int iRFine = 2 * iR;
+    const int iPhiFine = halvedPhi ? 2 * iPhi : iPhi;
+    if (isBoundary(coarse, iZ, iR)) {
+      coarse[index] = fine(iZFine, iRFine, iPhiFine);
+      continue;
+    }
+    if (boundaryOnly) {
+      continue;
+    }
+
+    DataT sum = 0;
+    if (halvedPhi) {
+      // full weighting in 3D: 1/8 for the centre, 1/16 for the faces, 1/32 for the edges and 1/64 for the corners
+      for (int dPhi = -1; dPhi <= 1; ++dPhi) {
+        const int iPhiTmp = (iPhiFine + dPhi + nPhiFine) % nPhiFine;
+        for (int dR = -1; dR <= 1; ++dR) {
+          for (int dZ = -1; dZ <= 1; ++dZ) {
+            const int nShifts = (dPhi != 0) + (dR != 0) + (dZ != 0);
+            sum += fine(iZFine + dZ, iRFine + dR, iPhiTmp) / static_cast<DataT>(8 << nShifts);
+          }
+        }
+      }
+    } else {
+      // full (1/4, 1/8, 1/16) or half (1/2, 1/8) weighting in 2D
+      for (int dR = -1; dR <= 1; ++dR) {
+        for (int dZ = -1; dZ <= 1; ++dZ) {
+          const int nShifts = (dR != 0) + (dZ != 0);
+          if (fullTransfer) {
+            sum += fine(iZFine + dZ, iRFine + dR, iPhiFine) / static_cast<DataT>(4 << nShifts);
+          } else if (nShifts < 2) {
+            sum += fine(iZFine + dZ, iRFine + dR, iPhiFine) / static_cast<DataT>(nShifts == 0 ? 2 : 8);
+          }
+        }
+      }
+    }
+    coarse[index] = sum;
+  }
+}
+
+template <typename DataT>
+GPUg() void interpolateKernel(DataContainer3DView<DataT> fine, DataContainer3DView<const DataT> coarse, const bool add, const bool fullTransfer)
+{
+  const bool halvedPhi = (fine.getNPhi() == 2 * coarse.getNPhi());
+  const int nPhiCoarse = coarse.getNPhi();
+  for (size_t index = blockIdx.x * blockDim.x + threadIdx.x; index < fine.getNDataPoints(); index += blockDim.x * gridDim.x) {
+    int iZ, iR, iPhi;
+    getIndices(fine, index, iZ, iR, iPhi);
+    const bool oddZ = iZ % 2;
+    const bool oddR = iR % 2;
+    const bool oddPhi = halvedPhi && (iPhi % 2);
+    if (isBoundary(fine, iZ, iR) || (!halvedPhi && !fullTransfer && oddZ && oddR)) {
+      continue;
+    }
+
+    // (tri)linear interpolation: average over the neighbouring coarse vertices
+    const int iZCoarse = iZ / 2;
+    const int iRCoarse = iR / 2;
+    const int iPhiCoarse = halvedPhi ? iPhi / 2 : iPhi;
+    DataT sum = 0;
+    for (int dPhi = 0; dPhi <= oddPhi; ++dPhi) {
+      const int iPhiTmp = (iPhiCoarse + dPhi) % nPhiCoarse;
+      for (int dR = 0; dR <= oddR; ++dR) {
+        for (int dZ = 0; dZ <= oddZ; ++dZ) {
+          sum += coarse(iZCoarse + dZ, iRCoarse + dR, iPhiTmp);
+        }
+      }
+    }
+    const DataT value = sum / (1 << (oddZ + oddR + oddPhi));
+    fine[index] = add ? (fine[index] + value) : value;
+  }
+}
+
+template <typename DataT>
+GPUg() void convergenceErrorKernel(DataContainer3DView<DataT> previous, DataContainer3DView<const DataT> v, DataT* sumSlices)
+{
+  __shared__ DataT partialSums[NThreadsPerBlock];
+  const size_t nSlice = static_cast<size_t>(v.getNZ()) * v.getNR();
+  const size_t offset = blockIdx.x * nSlice;
+  DataT sum = 0;
+  for (size_t i = threadIdx.x; i < nSlice; i += blockDim.x) {
+    const DataT diff = previous[offset + i] - v[offset + i];
+    previous[offset + i] = diff;
+    sum += diff * diff;
+  }
+  partialSums[threadIdx.x] = sum;
+  __syncthreads();
+  for (int stride = NThreadsPerBlock / 2; stride > 0; stride /= 2) {
+    if (threadIdx.x < stride) {
+      partialSums[threadIdx.x] += partialSums[threadIdx.x + stride];
+    }
+    __syncthreads();
+  }
+  if (threadIdx.x == 0) {
+    sumSlices[blockIdx.x] = partialSums[0];
+  }
+}
+
+template <typename DataT>
+GPUg() void electricFieldKernel(DataContainer3DView<const DataT> potential, DataContainer3DView<DataT> eZ, DataContainer3DView<DataT> eR, DataContainer3DView<DataT> ePhi, const int symmetry,
+                                const DataT rMin, const DataT spacingR, const DataT invSpacingZ, const DataT invSpacingR, const DataT invSpacingPhi)
+{
+  const int nZ = potential.getNZ();
+  const int nR = potential.getNR();
+  for (size_t index = blockIdx.x * blockDim.x + threadIdx.x; index < potential.getNDataPoints(); index += blockDim.x * gridDim.x) {
+    int iZ, iR, iPhi;
+    getIndices(potential, index, iZ, iR, iPhi);
+
+    // r direction: forward and backward differences at the boundaries
+    if (iR == 0) {
+      eR[index] = -1 * (-static_cast<DataT>(0.5) * potential(iZ, 2, iPhi) + 2 * potential(iZ, 1, iPhi) - static_cast<DataT>(1.5) * potential(iZ, 0, iPhi)) * invSpacingR;
+    } else if (iR == nR - 1) {
+      eR[index] = -1 * (static_cast<DataT>(1.5) * potential(iZ, nR - 1, iPhi) - 2 * potential(iZ, nR - 2, iPhi) + static_cast<DataT>(0.5) * potential(iZ, nR - 3, iPhi)) * invSpacingR;
+    } else {
+      eR[index] = -1 * (potential(iZ, iR + 1, iPhi) - potential(iZ, iR - 1, iPhi)) * static_cast<DataT>(0.5) * invSpacingR;
+    }
+
+    // z direction
+    if (iZ == 0) {
+      eZ[index] = -1 * (-static_cast<DataT>(0.5) * potential(2, iR, iPhi) + 2 * potential(1, iR, iPhi) - static_cast<DataT>(1.5) * potential(0, iR, iPhi)) * invSpacingZ;
+    } else if (iZ == nZ - 1) {
+      eZ[index] = -1 * (static_cast<DataT>(1.5) * potential(nZ - 1, iR, iPhi) - 2 * potential(nZ - 2, iR, iPhi) + static_cast<DataT>(0.5) * potential(nZ - 3, iR, iPhi)) * invSpacingZ;
+    } else {
+      eZ[index] = -1 * (potential(iZ + 1, iR, iPhi) - potential(iZ - 1, iR, iPhi)) * static_cast<DataT>(0.5) * invSpacingZ;
+    }
+
+    // phi direction
+    int iPhiPlus, iPhiMinus, signPlus, signMinus;
+    getPhiNeighbours(iPhi, potential.getNPhi(), symmetry, iPhiPlus, iPhiMinus, signPlus, signMinus);
+    const DataT radius = rMin + iR * spacingR;
+    ePhi[index] = -1 * (signPlus * potential(iZ, iR, iPhiPlus) - signMinus * potential(iZ, iR, iPhiMinus)) * static_cast<DataT>(0.5) * invSpacingPhi / radius;
+  }
+}
+
+} // namespace
+
+template <typename DataT>
+DataT* PoissonSolverKernels<DataT>::allocate(const size_t nValues)
+{
+  DataT* ptr = nullptr;
+  checkGPUError(cudaMalloc(reinterpret_cast<void**>(&ptr), nValues * sizeof(DataT)), __FILE__, __LINE__);
+  setZero(ptr, nValues);
+  return ptr;
+}
+
+template <typename DataT>
+void PoissonSolverKernels<DataT>::deallocate(DataT* ptr)
+{
+  if (ptr) {
+    checkGPUError(cudaFree(ptr), __FILE__, __LINE__);
+  }
+}
+
+template <typename DataT>
+void PoissonSolverKernels<DataT>::setZero(DataT* ptr, const size_t nValues)
+{
+  checkGPUError(cudaMemset(ptr, 0, nValues * sizeof(DataT)), __FILE__, __LINE__);
+}
+
+template <typename DataT>
+void PoissonSolverKernels<DataT>::copyToDevice(DataT* dst, const DataT* src, const size_t nValues)
+{
+  checkGPUError(cudaMemcpy(dst, src, nValues * sizeof(DataT), cudaMemcpyHostToDevice), __FILE__, __LINE__);
+}
+
+template <typename DataT>
+void PoissonSolverKernels<DataT>::copyToHost(DataT* dst, const DataT* src, const size_t nValues)
+{
+  checkGPUError(cudaMemcpy(dst, src, nValues * sizeof(DataT), cudaMemcpyDeviceToHost), __FILE__, __LINE__);
+}
+
+template <typename DataT>
+void PoissonSolverKernels<DataT>::copyOnDevice(DataT* dst, const DataT* src, const size_t nValues)
+{
+  checkGPUError(cudaMemcpy(dst, src, nValues * sizeof(DataT), cudaMemcpyDeviceToDevice), __FILE__, __LINE__);
+}
+
+template <typename DataT>
+void PoissonSolverKernels<DataT>::relax(View potential, ConstView charge, const int symmetry, const DataT h, const DataT ratioZ, const DataT ratioPhi, const DataT radiusIFC, const int colour)
+{
+  relaxKernel<<<getNBlocks(potential.getNDataPoints()), NThreadsPerBlock>>>(potential, charge, symmetry, h, ratioZ, ratioPhi, radiusIFC, colour);
+  checkGPUError(cudaGetLastError(), __FILE__, __LINE__);
+}
+
+template <typename DataT>
+void PoissonSolverKernels<DataT>::residue(View residue, ConstView potential, ConstView charge, const int symmetry, const DataT h, const DataT ratioZ, const DataT ratioPhi, const DataT radiusIFC)
+{
+  residueKernel<<<getNBlocks(potential.getNDataPoints()), NThreadsPerBlock>>>(residue, potential, charge, symmetry, h, ratioZ, ratioPhi, radiusIFC);
+  checkGPUError(cudaGetLastError(), __FILE__, __LINE__);
+}
+
+template <typename DataT>
+void PoissonSolverKernels<DataT>::restrictGrid(View coarse, ConstView fine, const bool fullTransfer)
+{
+  restrictKernel<<<getNBlocks(coarse.getNDataPoints()), NThreadsPerBlock>>>(coarse, fine, fullTransfer, false);
+  checkGPUError(cudaGetLastError(), __FILE__, __LINE__);
+}
+
+template <typename DataT>
+void PoissonSolverKernels<DataT>::restrictBoundary(View coarse, ConstView fine)
+{
+  restrictKernel<<<getNBlocks(coarse.getNDataPoints()), NThreadsPerBlock>>>(coarse, fine, false, true);
+  checkGPUError(cudaGetLastError(), __FILE__, __LINE__);
+}
+
+template <typename DataT>
+void PoissonSolverKernels<DataT>::interpolate(View fine, ConstView coarse, const bool add, const bool fullTransfer)
+{
+  interpolateKernel<<<getNBlocks(fine.getNDataPoints()), NThreadsPerBlock>>>(fine, coarse, add, fullTransfer);
+  checkGPUError(cudaGetLastError(), __FILE__, __LINE__);
+}
+
+template <typename DataT>
+DataT PoissonSolverKernels<DataT>::convergenceError(View previous, ConstView potential, DataT* buffer)
+{
+  convergenceErrorKernel<<<previous.getNPhi(), NThreadsPerBlock>>>(previous, potential, buffer);
+  checkGPUError(cudaGetLastError(), __FILE__, __LINE__);
+  std::vector<DataT> sumSlices(previous.getNPhi());
+  copyToHost(sumSlices.data(), buffer, sumSlices.size());
+  return *std::max_element(sumSlices.begin(), sumSlices.end());
+}
+
+template <typename DataT>
+void PoissonSolverKernels<DataT>::electricField(ConstView potential, View eZ, View eR, View ePhi, const int symmetry, const DataT rMin, const DataT invSpacingZ, const DataT invSpacingR, const DataT invSpacingPhi)
+{
+  electricFieldKernel<<<getNBlocks(potential.getNDataPoints()), NThreadsPerBlock>>>(potential, eZ, eR, ePhi, symmetry, rMin, 1 / invSpacingR, invSpacingZ, invSpacingR, invSpacingPhi);
+  checkGPUError(cudaGetLastError(), __FILE__, __LINE__);
+}
+
+template struct o2::tpc::PoissonSolverKernels<double>;
+template struct o2::tpc::PoissonSolverKernels<float>;
@@ -19,6 +19,7 @@
 #define ALICEO2_TPC_DATACONTAINER3D_H_
 
 #include "Rtypes.h"
+#include "TPCSpaceCharge/DataContainer3DView.h"
 #include <vector>
 
 class TFile;
@@ -55,6 +56,10 @@ struct DataContainer3D {
   const auto& getData() const { return mData; }
   auto& getData() { return mData; }
 
+  /// \return returns a non-owning view of the values, e.g. to copy them to or from a device
+  DataContainer3DView<const DataT> getView() const { return {mData.data(), mZVertices, mRVertices, mPhiVertices}; }
+  DataContainer3DView<DataT> getView() { return {mData.data(), mZVertices, mRVertices, mPhiVertices}; }
+
   /// \param iz index in z dimension
   /// \param ir index in r dimension
   /// \param iphi index in phi dimension
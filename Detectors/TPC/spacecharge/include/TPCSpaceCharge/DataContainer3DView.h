@@ -0,0 +1,60 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file DataContainer3DView.h
+/// \brief Non-owning view of the values of a DataContainer3D which can be used on host and device
+
+#ifndef ALICEO2_TPC_DATACONTAINER3DVIEW_H_
+#define ALICEO2_TPC_DATACONTAINER3DVIEW_H_
+
+#include "GPUCommonDef.h"
+
+namespace o2
+{
+namespace tpc
+{
+
+/// \class DataContainer3DView
+/// The DataContainer3DView gives access to values stored with the memory layout of the DataContainer3D (z is the fastest running index, phi the slowest).
+/// It does not own the memory, which can be located on the host or on the device, and can therefore be passed by value to GPU kernels.
+
+/// \tparam DataT the type of data which is used during the calculations (can be const)
+template <typename DataT = double>
+struct DataContainer3DView {
+  DataT* mData{nullptr};         ///< pointer to the values
+  unsigned short mZVertices{};   ///< number of z vertices
+  unsigned short mRVertices{};   ///< number of r vertices
+  unsigned short mPhiVertices{}; ///< number of phi vertices
+
+  /// \param iz index in z dimension
+  /// \param ir index in r dimension
+  /// \param iphi index in phi dimension
+  /// \return returns the index to the data
+  GPUhdi() size_t getDataIndex(const size_t iz, const size_t ir, const size_t iphi) const { return (iz + mZVertices * (ir + iphi * mRVertices)); }
+
+  /// \return returns the stored value for given indices
+  GPUhdi() DataT& operator()(size_t iz, size_t ir, size_t iphi) const { return mData[getDataIndex(iz, ir, iphi)]; }
+
+  /// operator to directly access the values
+  GPUhdi() DataT& operator[](size_t i) const { return mData[i]; }
+
+  /// \return returns the number of values
+  GPUhdi() size_t getNDataPoints() const { return static_cast<size_t>(mZVertices) * mRVertices * mPhiVertices; }
+
+  GPUhdi() unsigned short getNZ() const { return mZVertices; }
+  GPUhdi() unsigned short getNR() const { return mRVertices; }
+  GPUhdi() unsigned short getNPhi() const { return mPhiVertices; }
+};
+
+} // namespace tpc
+} // namespace o2
+
+#endif
@@ -22,6 +22,7 @@
 #include "TPCSpaceCharge/TriCubic.h"
 #include "TPCSpaceCharge/SpaceChargeHelpers.h"
 #include "TPCSpaceCharge/PoissonSolverHelpers.h"
+#include "TPCSpaceCharge/PoissonSolver.h"
 #include "TPCSpaceCharge/RegularGrid3D.h"
 #include "TPCSpaceCharge/DataContainer3D.h"
 #include "TPCSpaceCharge/SpaceChargeParameter.h"
@@ -292,6 +293,34 @@ class SpaceCharge
   /// \param side side of the TPC
   void calcEField(const Side side);
 
+  /// step 1 and 2 with an external solver, e.g. the PoissonSolverGPU
+  /// \tparam Solver class providing poissonSolver3D(potential, density, symmetry)
+  /// \param solver solver which is used to calculate the potential
+  /// \param side side of the TPC
+  /// \param stoppingConvergence stopping criterion used in the poisson solver
+  /// \param symmetry use symmetry or not in the poisson solver
+  template <typename Solver>
+  void poissonSolver(Solver& solver, const Side side, const DataT stoppingConvergence = 1e-6, const int symmetry = 0)
+  {
+    initContainer(mDensity[side], true);
+    initContainer(mPotential[side], true);
+    PoissonSolver<DataT>::setConvergenceError(stoppingConvergence);
+    solver.poissonSolver3D(mPotential[side], mDensity[side], symmetry);
+  }
+
+  /// \tparam Solver class providing calcEField(potential, eZ, eR, ePhi)
+  /// \param solver solver which is used to calculate the electric field
+  /// \param side side of the TPC
+  template <typename Solver>
+  void calcEField(Solver& solver, const Side side)
+  {
+    initContainer(mPotential[side], true);
+    initContainer(mElectricFieldEr[side], true);
+    initContainer(mElectricFieldEz[side], true);
+    initContainer(mElectricFieldEphi[side], true);
+    solver.calcEField(mPotential[side], mElectricFieldEz[side], mElectricFieldEr[side], mElectricFieldEphi[side]);
+  }
+
   /// step 2a: set the electric field from an analytical formula
   /// \param formulaStruct struct containing a method to evaluate the electric fields
   void setEFieldFromFormula(const AnalyticalFields<DataT>& formulaStruct);
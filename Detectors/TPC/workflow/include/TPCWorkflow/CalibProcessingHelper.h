@@ -13,6 +13,7 @@
 #define O2_TPC_CalibProcessingHelper_H
 
 #include <memory>
+#include <vector>
 
 #include "Framework/InputRecord.h"
 
@@ -30,6 +31,12 @@ namespace calib_processing_helper
 
 uint64_t processRawData(o2::framework::InputRecord& inputs, std::unique_ptr<o2::tpc::rawreader::RawReaderCRU>& reader, bool useOldSubspec = false, const std::vector<int>& sectors = {}, size_t* nerrors = nullptr, uint32_t syncOffsetReference = 144, uint32_t decoderType = 1, bool useTrigger = true, bool returnOnNoTrigger = false);
 
+/// same as above, decoding the links in parallel with one thread per reader
+/// all parts of a link are processed in input order by the same reader. With splitSectors == false also all links of
+/// a sector are processed by the same reader, so the callbacks may modify any data of the sector they are called for,
+/// otherwise they may only modify data of the pads they are called for
+uint64_t processRawData(o2::framework::InputRecord& inputs, std::vector<std::unique_ptr<o2::tpc::rawreader::RawReaderCRU>>& readers, bool splitSectors, bool useOldSubspec = false, const std::vector<int>& sectors = {}, size_t* nerrors = nullptr, uint32_t syncOffsetReference = 144, uint32_t decoderType = 1, bool useTrigger = true, bool returnOnNoTrigger = false);
+
 /// absolute BC relative to TF start (firstOrbit)
 std::vector<o2::framework::InputSpec> getFilter(o2::framework::InputRecord& inputs);
 
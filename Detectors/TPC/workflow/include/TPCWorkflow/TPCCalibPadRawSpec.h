@@ -17,9 +17,11 @@
 /// @author Jens Wiechula
 /// @author David Silvermyr
 
+#include <atomic>
 #include <vector>
 #include <string>
 #include <chrono>
+#include <type_traits>
 #include <fmt/format.h>
 
 #include "Framework/Task.h"
@@ -71,11 +73,28 @@ class TPCCalibPedestalDevice : public o2::framework::Task
     // set up ADC value filling
     // TODO: clean up to not go via RawReaderCRUManager
     mCalibration.init(); // initialize configuration via configKeyValues
-    mRawReader.createReader("");
+
+    // links are only decoded in parallel for the pedestal calibration, which fills
+    // independent data per pad, the pulser calibration keeps the signals in a common map
+    mNThreads = std::max(1, ic.options().get<int>("nthreads"));
+    if constexpr (std::is_same_v<T, CalibPedestal>) {
+      if (mNThreads > 1) {
+        LOGP(info, "Decoding links with {} threads", mNThreads);
+        mCalibration.allocateSectors(mSectors);
+      }
+    } else if (mNThreads > 1) {
+      LOGP(warning, "Parallel decoding is only supported for the pedestal calibration, using 1 thread");
+      mNThreads = 1;
+    }
+    for (int i = 0; i < mNThreads; ++i) {
+      mRawReader.createReader("");
+    }
 
     mRawReader.setADCDataCallback([this](const PadROCPos& padROCPos, const CRU& cru, const gsl::span<const uint32_t> data) -> int {
       const int timeBins = mCalibration.update(padROCPos, cru, data);
-      mCalibration.setNumberOfProcessedTimeBins(std::max(mCalibration.getNumberOfProcessedTimeBins(), size_t(timeBins)));
+      size_t processedTimeBins = mProcessedTimeBins.load(std::memory_order_relaxed);
+      while (size_t(timeBins) > processedTimeBins && !mProcessedTimeBins.compare_exchange_weak(processedTimeBins, size_t(timeBins), std::memory_order_relaxed)) {
+      }
       return timeBins;
     });
 
@@ -110,8 +129,8 @@ class TPCCalibPedestalDevice : public o2::framework::Task
       mCalibration.setDigits(&digits);
       mCalibration.processEvent();
     } else {
-      auto& reader = mRawReader.getReaders()[0];
-      calib_processing_helper::processRawData(pc.inputs(), reader, mUseOldSubspec, mSectors, nullptr, mSyncOffsetReference, mDecoderType);
+      calib_processing_helper::processRawData(pc.inputs(), mRawReader.getReaders(), true, mUseOldSubspec, mSectors, nullptr, mSyncOffsetReference, mDecoderType);
+      mCalibration.setNumberOfProcessedTimeBins(std::max(mCalibration.getNumberOfProcessedTimeBins(), mProcessedTimeBins.load()));
       mCalibration.endEvent();
       mCalibration.endReader();
     }
@@ -166,6 +185,7 @@ class TPCCalibPedestalDevice : public o2::framework::Task
   uint32_t mLane{0};                  ///< lane number of processor
   uint32_t mSyncOffsetReference{144}; ///< reference sync offset for decoding
   uint32_t mDecoderType{0};           ///< decoder type: 0 - TPC, 1 - GPU
+  int mNThreads{1};                   ///< number of threads decoding the links
   std::vector<int> mSectors{};        ///< sectors to process in this instance
   bool mReadyToQuit{false};           ///< if processor is ready to quit
   bool mCalibSent{false};             ///< if calibration object already sent / dumped
@@ -175,6 +195,8 @@ class TPCCalibPedestalDevice : public o2::framework::Task
   bool mDirectFileDump{false};        ///< directly dump the calibration data to file
   bool mResetAfterPublish{false};     ///< reset calibration after it was published
 
+  std::atomic<size_t> mProcessedTimeBins{0}; ///< maximum number of time bins seen by the ADC data callback, filled concurrently
+
   //____________________________________________________________________________
   void sendOutput(DataAllocator& output)
   {
@@ -260,6 +282,7 @@ DataProcessorSpec getTPCCalibPadRawSpec(const std::string inputSpec, uint32_t il
       {"direct-file-dump", VariantType::Bool, false, {"directly dump calibration to file"}},
       {"sync-offset-reference", VariantType::UInt32, 144u, {"Reference BCs used for the global sync offset in the CRUs"}},
       {"decoder-type", VariantType::UInt32, 1u, {"Decoder to use: 0 - TPC, 1 - GPU"}},
+      {"nthreads", VariantType::Int, 1, {"number of threads decoding the links in parallel (pedestal calibration only)"}},
     } // end Options
   };  // end DataProcessorSpec
 }
@@ -16,6 +16,9 @@
 #include <chrono>
 #include <fmt/format.h>
 #include <fmt/chrono.h>
+#include <atomic>
+#include <mutex>
+#include <thread>
 
 #include "GPUO2InterfaceUtils.h"
 #include "Framework/ConcreteDataMatcher.h"
@@ -71,30 +74,26 @@ std::vector<o2::framework::InputSpec> calib_processing_helper::getFilter(o2::fra
   return filter;
 }
 
-uint64_t calib_processing_helper::processRawData(o2::framework::InputRecord& inputs, std::unique_ptr<rawreader::RawReaderCRU>& reader, bool useOldSubspec, const std::vector<int>& sectors, size_t* nerrors, uint32_t syncOffsetReference, uint32_t decoderType, bool useTrigger, bool returnOnNoTrigger)
+namespace
+{
+/// raw data of one input part, with the hardware information extracted from the header
+struct RawPart {
+  const o2::header::DataHeader* dh = nullptr;
+  gsl::span<const char> raw;
+  rdh_utils::FEEIDType feeID = 0;
+  uint32_t sector = 0;
+};
+
+/// flags to report the data type only once per TF
+struct RawPartFlags {
+  std::atomic<bool> readFirst{false};
+  std::atomic<bool> readFirstZS{false};
+};
+
+/// collect the parts of the selected sectors, returns the mask of active sectors
+uint64_t collectRawParts(InputRecord& inputs, const std::vector<InputSpec>& filter, bool useOldSubspec, const std::vector<int>& sectors, std::vector<RawPart>& parts)
 {
-  std::vector<InputSpec> filter = getFilter(inputs);
-
-  size_t errorCount = 0;
-
   uint64_t activeSectors = 0;
-  uint32_t firstOrbit = 0;
-  bool readFirst = false;
-  bool readFirstZS = false;
-
-  const auto triggerBC = ((decoderType == 1 && useTrigger)) ? getTriggerBCoffset(inputs, filter) : -1;
-  if (returnOnNoTrigger && (triggerBC < 0)) {
-    return 0;
-  }
-
-  // for LinkZS data the maximum sync offset is needed to align the data properly.
-  // getBCsyncOffsetReference only works, if the full TF is seen. Alternatively, this value could be set
-  // fixed to e.g. 144 or 152 which is the maximum sync delay expected
-  // this is less precise and might lead to more time bins which have to be removed at the beginnig
-  // or end of the TF
-  // uint32_t syncOffsetReference = getBCsyncOffsetReference(inputs, filter);
-  // uint32_t syncOffsetReference = 144;
-
   for (auto const& ref : InputRecordWalker(inputs, filter)) {
     const auto* dh = DataRefUtils::getHeader<o2::header::DataHeader*>(ref);
     auto payloadSize = DataRefUtils::getPayloadSize(ref);
@@ -103,8 +102,6 @@ uint64_t calib_processing_helper::processRawData(o2::framework::InputRecord& inp
       continue;
     }
 
-    firstOrbit = dh->firstTForbit;
-
     // ---| extract hardware information to do the processing |---
     const auto subSpecification = dh->subSpecification;
     rdh_utils::FEEIDType feeID = (rdh_utils::FEEIDType)dh->subSpecification;
@@ -138,82 +135,120 @@ uint64_t calib_processing_helper::processRawData(o2::framework::InputRecord& inp
     // ^^^^^^
 
     // TODO: exception handling needed?
-    const gsl::span<const char> raw = inputs.get<gsl::span<char>>(ref);
-    std::unique_ptr<o2::framework::RawParser<8192>> rawparserPtr;
-    try {
+    parts.push_back({dh, inputs.get<gsl::span<char>>(ref), feeID, uint32_t(sector)});
+  }
+  return activeSectors;
+}
 
-      o2::framework::RawParser parser(raw.data(), raw.size());
-      // detect decoder type by analysing first RDH
-      bool isLinkZS = false;
-      {
-        auto it = parser.begin();
-        auto rdhPtr = reinterpret_cast<const o2::header::RDHAny*>(it.raw());
-        const auto rdhVersion = RDHUtils::getVersion(rdhPtr);
-        if (!rdhPtr || rdhVersion < 6) {
-          throw std::runtime_error(fmt::format("could not get RDH from packet, or version {} < 6", rdhVersion).data());
-        }
-        const auto link = RDHUtils::getLinkID(*rdhPtr);
-        const auto detField = RDHUtils::getDetectorField(*rdhPtr);
-        const auto feeID = RDHUtils::getFEEID(*rdhPtr);
-        const auto feeLinkID = rdh_utils::getLink(feeID);
-        if (detField == raw_data_types::LinkZS || ((link == 0 || link == rdh_utils::UserLogicLinkID) && ((feeLinkID == rdh_utils::ILBZSLinkID || feeLinkID == rdh_utils::DLBZSLinkID) && detField == raw_data_types::ZS))) {
-          isLinkZS = true;
-          if (!readFirstZS) {
-            if (feeLinkID == rdh_utils::DLBZSLinkID) {
-              LOGP(info, "Detected Dense Link-based zero suppression");
-            } else if (feeLinkID == rdh_utils::ILBZSLinkID) {
-              LOGP(info, "Detected Improved Link-based zero suppression");
-            } else {
-              LOGP(info, "Detected Link-based zero suppression");
-            }
-            if (!reader->getManager() || !reader->getManager()->getLinkZSCallback()) {
-              LOGP(fatal, "LinkZSCallback must be set in RawReaderCRUManager");
-            }
-            readFirstZS = true;
+/// decode one part, returns false in case of an error
+bool processRawPart(const RawPart& part, std::unique_ptr<rawreader::RawReaderCRU>& reader, uint32_t syncOffsetReference, uint32_t decoderType, int triggerBC, RawPartFlags& flags)
+{
+  const auto* dh = part.dh;
+  const auto firstOrbit = dh->firstTForbit;
+  try {
+
+    o2::framework::RawParser parser(part.raw.data(), part.raw.size());
+    // detect decoder type by analysing first RDH
+    bool isLinkZS = false;
+    {
+      auto it = parser.begin();
+      auto rdhPtr = reinterpret_cast<const o2::header::RDHAny*>(it.raw());
+      const auto rdhVersion = RDHUtils::getVersion(rdhPtr);
+      if (!rdhPtr || rdhVersion < 6) {
+        throw std::runtime_error(fmt::format("could not get RDH from packet, or version {} < 6", rdhVersion).data());
+      }
+      const auto link = RDHUtils::getLinkID(*rdhPtr);
+      const auto detField = RDHUtils::getDetectorField(*rdhPtr);
+      const auto feeID = RDHUtils::getFEEID(*rdhPtr);
+      const auto feeLinkID = rdh_utils::getLink(feeID);
+      if (detField == raw_data_types::LinkZS || ((link == 0 || link == rdh_utils::UserLogicLinkID) && ((feeLinkID == rdh_utils::ILBZSLinkID || feeLinkID == rdh_utils::DLBZSLinkID) && detField == raw_data_types::ZS))) {
+        isLinkZS = true;
+        if (!flags.readFirstZS.exchange(true)) {
+          if (feeLinkID == rdh_utils::DLBZSLinkID) {
+            LOGP(info, "Detected Dense Link-based zero suppression");
+          } else if (feeLinkID == rdh_utils::ILBZSLinkID) {
+            LOGP(info, "Detected Improved Link-based zero suppression");
+          } else {
+            LOGP(info, "Detected Link-based zero suppression");
+          }
+          if (!reader->getManager() || !reader->getManager()->getLinkZSCallback()) {
+            LOGP(fatal, "LinkZSCallback must be set in RawReaderCRUManager");
           }
         }
-
-        // firstOrbit = RDHUtils::getHeartBeatOrbit(*rdhPtr);
-        if (!readFirst) {
-          LOGP(info, "First orbit in present TF: {}", firstOrbit);
-        }
-        readFirst = true;
       }
 
-      if (isLinkZS) {
-        processLinkZS(parser, reader, firstOrbit, syncOffsetReference, decoderType, triggerBC);
-      } else {
-        processGBT(parser, reader, feeID);
+      // firstOrbit = RDHUtils::getHeartBeatOrbit(*rdhPtr);
+      if (!flags.readFirst.exchange(true)) {
+        LOGP(info, "First orbit in present TF: {}", firstOrbit);
       }
+    }
 
-    } catch (const std::exception& e) {
-      // error message throtteling
-      using namespace std::literals::chrono_literals;
-      static std::unordered_map<uint32_t, size_t> nErrorPerSubspec;
-      static std::chrono::time_point<std::chrono::steady_clock> lastReport = std::chrono::steady_clock::now();
-      const auto now = std::chrono::steady_clock::now();
-      static size_t reportedErrors = 0;
-      const size_t MAXERRORS = 10;
-      const auto sleepTime = 10min;
-      ++nErrorPerSubspec[subSpecification];
-
-      if ((now - lastReport) < sleepTime) {
-        if (reportedErrors < MAXERRORS) {
-          ++reportedErrors;
-          std::string sleepInfo;
-          if (reportedErrors == MAXERRORS) {
-            sleepInfo = fmt::format(", maximum error count ({}) reached, not reporting for the next {}", MAXERRORS, sleepTime);
-          }
-          LOGP(alarm, "EXCEPTIION in processRawData: {} -> skipping part:{}/{} of spec:{}/{}/{}, size:{}, error count for subspec: {}{}", e.what(), dh->splitPayloadIndex, dh->splitPayloadParts,
-               dh->dataOrigin, dh->dataDescription, subSpecification, payloadSize, nErrorPerSubspec.at(subSpecification), sleepInfo);
-          lastReport = now;
+    if (isLinkZS) {
+      processLinkZS(parser, reader, firstOrbit, syncOffsetReference, decoderType, triggerBC);
+    } else {
+      processGBT(parser, reader, part.feeID);
+    }
+
+  } catch (const std::exception& e) {
+    // error message throtteling
+    using namespace std::literals::chrono_literals;
+    static std::mutex errorMutex;
+    static std::unordered_map<uint32_t, size_t> nErrorPerSubspec;
+    static std::chrono::time_point<std::chrono::steady_clock> lastReport = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(errorMutex);
+    const auto now = std::chrono::steady_clock::now();
+    static size_t reportedErrors = 0;
+    const size_t MAXERRORS = 10;
+    const auto sleepTime = 10min;
+    const auto subSpecification = dh->subSpecification;
+    ++nErrorPerSubspec[subSpecification];
+
+    if ((now - lastReport) < sleepTime) {
+      if (reportedErrors < MAXERRORS) {
+        ++reportedErrors;
+        std::string sleepInfo;
+        if (reportedErrors == MAXERRORS) {
+          sleepInfo = fmt::format(", maximum error count ({}) reached, not reporting for the next {}", MAXERRORS, sleepTime);
         }
-      } else {
+        LOGP(alarm, "EXCEPTIION in processRawData: {} -> skipping part:{}/{} of spec:{}/{}/{}, size:{}, error count for subspec: {}{}", e.what(), dh->splitPayloadIndex, dh->splitPayloadParts,
+             dh->dataOrigin, dh->dataDescription, subSpecification, part.raw.size(), nErrorPerSubspec.at(subSpecification), sleepInfo);
         lastReport = now;
-        reportedErrors = 0;
       }
+    } else {
+      lastReport = now;
+      reportedErrors = 0;
+    }
+    return false;
+  }
+  return true;
+}
+} // namespace
+
+uint64_t calib_processing_helper::processRawData(o2::framework::InputRecord& inputs, std::unique_ptr<rawreader::RawReaderCRU>& reader, bool useOldSubspec, const std::vector<int>& sectors, size_t* nerrors, uint32_t syncOffsetReference, uint32_t decoderType, bool useTrigger, bool returnOnNoTrigger)
+{
+  std::vector<InputSpec> filter = getFilter(inputs);
+
+  size_t errorCount = 0;
+
+  const auto triggerBC = ((decoderType == 1 && useTrigger)) ? getTriggerBCoffset(inputs, filter) : -1;
+  if (returnOnNoTrigger && (triggerBC < 0)) {
+    return 0;
+  }
+
+  // for LinkZS data the maximum sync offset is needed to align the data properly.
+  // getBCsyncOffsetReference only works, if the full TF is seen. Alternatively, this value could be set
+  // fixed to e.g. 144 or 152 which is the maximum sync delay expected
+  // this is less precise and might lead to more time bins which have to be removed at the beginnig
+  // or end of the TF
+  // uint32_t syncOffsetReference = getBCsyncOffsetReference(inputs, filter);
+  // uint32_t syncOffsetReference = 144;
+
+  std::vector<RawPart> parts;
+  const auto activeSectors = collectRawParts(inputs, filter, useOldSubspec, sectors, parts);
+  RawPartFlags flags;
+  for (const auto& part : parts) {
+    if (!processRawPart(part, reader, syncOffsetReference, decoderType, triggerBC, flags)) {
       errorCount++;
-      continue;
     }
   }
   if (nerrors) {
@@ -222,6 +257,57 @@ uint64_t calib_processing_helper::processRawData(o2::framework::InputRecord& inp
   return activeSectors;
 }
 
+uint64_t calib_processing_helper::processRawData(o2::framework::InputRecord& inputs, std::vector<std::unique_ptr<rawreader::RawReaderCRU>>& readers, bool splitSectors, bool useOldSubspec, const std::vector<int>& sectors, size_t* nerrors, uint32_t syncOffsetReference, uint32_t decoderType, bool useTrigger, bool returnOnNoTrigger)
+{
+  if (readers.size() == 1) {
+    return processRawData(inputs, readers[0], useOldSubspec, sectors, nerrors, syncOffsetReference, decoderType, useTrigger, returnOnNoTrigger);
+  }
+
+  std::vector<InputSpec> filter = getFilter(inputs);
+
+  const auto triggerBC = ((decoderType == 1 && useTrigger)) ? getTriggerBCoffset(inputs, filter) : -1;
+  if (returnOnNoTrigger && (triggerBC < 0)) {
+    return 0;
+  }
+
+  std::vector<RawPart> parts;
+  const auto activeSectors = collectRawParts(inputs, filter, useOldSubspec, sectors, parts);
+
+  // all parts of a link (or of a sector) are decoded by the same thread, in input order,
+  // so that the callbacks of different threads never fill the same pads (or sector)
+  const size_t nThreads = readers.size();
+  auto getThread = [nThreads, splitSectors](const RawPart& part) -> size_t {
+    if (!splitSectors) {
+      return part.sector % nThreads;
+    }
+    rdh_utils::FEEIDType cruID, linkID, endPoint;
+    rdh_utils::getMapping(part.feeID, cruID, endPoint, linkID);
+    return (cruID * 2 * 12 + linkID + endPoint * 12) % nThreads;
+  };
+  std::atomic<size_t> errorCount{0};
+  RawPartFlags flags;
+  auto decode = [&](size_t iThread) {
+    for (const auto& part : parts) {
+      if (getThread(part) == iThread && !processRawPart(part, readers[iThread], syncOffsetReference, decoderType, triggerBC, flags)) {
+        ++errorCount;
+      }
+    }
+  };
+  std::vector<std::thread> workers;
+  for (size_t iThread = 1; iThread < nThreads; ++iThread) {
+    workers.emplace_back(decode, iThread);
+  }
+  decode(0);
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  if (nerrors) {
+    *nerrors += errorCount;
+  }
+  return activeSectors;
+}
+
 void processGBT(o2::framework::RawParser<>& parser, std::unique_ptr<o2::tpc::rawreader::RawReaderCRU>& reader, const rdh_utils::FEEIDType feeID)
 {
   // TODO: currently this will only work for HBa1, since the sync is in the first packet and
@@ -288,7 +374,7 @@ void processLinkZS(o2::framework::RawParser<>& parser, std::unique_ptr<o2::tpc::
 
     if ((decoderType == 1) && (linkID == rdh_utils::ILBZSLinkID || linkID == rdh_utils::DLBZSLinkID) && (detField == raw_data_types::Type::ZS)) {
       std::vector<Digit> digits;
-      static o2::gpu::GPUO2InterfaceUtils::GPUReconstructionZSDecoder gpuDecoder;
+      thread_local o2::gpu::GPUO2InterfaceUtils::GPUReconstructionZSDecoder gpuDecoder;
       gpuDecoder.DecodePage(digits, (const void*)it.raw(), firstOrbit, nullptr, static_cast<unsigned int>((triggerBC > 0) ? triggerBC : 0));
       for (const auto& digit : digits) {
         reader->getManager()->getLinkZSCallback()(digit.getCRU(), digit.getRow(), digit.getPad(), digit.getTimeStamp(), digit.getChargeFloat());
@@ -63,6 +63,7 @@ class CalibratordEdxDevice : public Task
     const auto fitSnp = ic.options().get<bool>("fit-snp");
 
     const auto dumpData = ic.options().get<bool>("file-dump");
+    const auto asyncFinalization = ic.options().get<bool>("async-finalization");
 
     mCalibrator = std::make_unique<tpc::CalibratordEdx>();
     mCalibrator->setHistParams(dEdxBins, mindEdx, maxdEdx, angularBins, fitSnp);
@@ -73,6 +74,7 @@ class CalibratordEdxDevice : public Task
     mCalibrator->setMaxSlotsDelay(maxDelay);
     mCalibrator->setElectronCut({fitThreshold, fitPasses, fitThresholdLowFactor});
     mCalibrator->setMaterialType(mMatType);
+    mCalibrator->setAsyncFinalization(asyncFinalization);
 
     if (dumpData) {
       mCalibrator->enableDebugOutput("calibratordEdx.root");
@@ -92,6 +94,9 @@ class CalibratordEdxDevice : public Task
     LOGP(detail, "Processing TF {} with {} tracks", mCalibrator->getCurrentTFInfo().tfCounter, tracks.size());
     mRunNumber = mCalibrator->getCurrentTFInfo().runNumber;
     mCalibrator->process(tracks);
+
+    // the output might be filled in parallel by the asynchronous finalization
+    auto lock = mCalibrator->getOutputLock();
     sendOutput(pc.outputs());
 
     const auto& infoVec = mCalibrator->getTFinterval();
@@ -172,6 +177,8 @@ DataProcessorSpec getCalibratordEdxSpec(const o2::base::Propagator::MatCorrType
       {"angularbins", VariantType::Int, 36, {"number of angular bins: Tgl and Snp"}},
       {"fit-snp", VariantType::Bool, false, {"enable Snp correction"}},
 
+      {"async-finalization", VariantType::Bool, false, {"finalize the slots in a separate thread without blocking the processing of new TFs"}},
+
       {"file-dump", VariantType::Bool, false, {"directly dump calibration to file"}}}};
 }
 
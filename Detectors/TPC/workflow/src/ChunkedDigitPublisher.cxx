@@ -36,6 +36,7 @@
 #include <string>
 #include <vector>
 #include <utility>
+#include <memory>
 #include <numeric>
 #include <TROOT.h>
 #ifdef NDEBUG
@@ -143,6 +144,59 @@ void publishBuffer<MCTruthContainer>(framework::ProcessingContext& pc, int secto
   delete accum;
 }
 
+template <typename T>
+void mergeChunks(framework::ProcessingContext& pc, int sector, uint64_t activeSectors, TBranch* br)
+{
+  T* chunk = nullptr;
+  br->SetAddress(&chunk);
+
+  using AccumType = std::decay_t<decltype(makePublishBuffer<T>(pc, sector, activeSectors))>;
+  AccumType accum;
+#pragma omp critical
+  accum = makePublishBuffer<T>(pc, sector, activeSectors);
+
+  for (auto e = 0; e < br->GetEntries(); ++e) {
+    br->GetEntry(e);
+    copyHelper(*chunk, *accum);
+    delete chunk;
+    chunk = nullptr;
+  }
+  br->ResetAddress();
+
+  // some data (labels are published slightly differently)
+  publishBuffer(pc, sector, activeSectors, accum);
+}
+
+template <>
+void mergeChunks<std::vector<o2::tpc::Digit>>(framework::ProcessingContext& pc, int sector, uint64_t activeSectors, TBranch* br)
+{
+  // size-then-fill: the chunks are read first, so that the output message is created with its final size
+  // and the chunks are copied into it without reallocations and outside of the critical section
+  std::vector<std::unique_ptr<std::vector<o2::tpc::Digit>>> chunks;
+  size_t nDigits = 0;
+  for (auto e = 0; e < br->GetEntries(); ++e) {
+    std::vector<o2::tpc::Digit>* chunk = nullptr;
+    br->SetAddress(&chunk);
+    br->GetEntry(e);
+    nDigits += chunk->size();
+    chunks.emplace_back(chunk);
+  }
+  br->ResetAddress();
+
+  LOG(info) << "PUBLISHING SECTOR " << sector;
+  o2::tpc::TPCSectorHeader header{sector};
+  header.activeSectors = activeSectors;
+  gsl::span<o2::tpc::Digit> digits;
+#pragma omp critical
+  digits = pc.outputs().make<o2::tpc::Digit>(Output{"TPC", "DIGITS", static_cast<SubSpecificationType>(sector), header}, nDigits);
+
+  auto target = digits.begin();
+  for (auto& chunk : chunks) {
+    target = std::copy(chunk->begin(), chunk->end(), target);
+    chunk.reset();
+  }
+}
+
 template <typename T>
 void mergeHelper(const char* brprefix, std::vector<int> const& tpcsectors, uint64_t activeSectors,
                  TFile& originfile, framework::ProcessingContext& pc)
@@ -164,26 +218,9 @@ void mergeHelper(const char* brprefix, std::vector<int> const& tpcsectors, uint6
     if (!br) {
       continue;
     }
-    T* chunk = nullptr;
-    br->SetAddress(&chunk);
-
-    using AccumType = std::decay_t<decltype(makePublishBuffer<T>(pc, sector, activeSectors))>;
-    AccumType accum;
-#pragma omp critical
-    accum = makePublishBuffer<T>(pc, sector, activeSectors);
-
-    for (auto e = 0; e < br->GetEntries(); ++e) {
-      br->GetEntry(e);
-      copyHelper(*chunk, *accum);
-      delete chunk;
-      chunk = nullptr;
-    }
-    br->ResetAddress();
+    mergeChunks<T>(pc, sector, activeSectors, br);
     br->DropBaskets("all");
     delete oldtree;
-
-    // some data (labels are published slightly differently)
-    publishBuffer(pc, sector, activeSectors, accum);
   }
 }
 
@@ -16,16 +16,23 @@
 #include <gsl/span>
 #include <TStopwatch.h>
 #include <vector>
+#include <algorithm>
 #include "DataFormatsTPC/WorkflowHelper.h"
 #include "DataFormatsTPC/TrackTPC.h"
 #include "GPUO2InterfaceRefit.h"
 #include "GPUO2InterfaceUtils.h"
 #include "TPCWorkflow/ClusterSharingMapSpec.h"
 #include "DataFormatsParameters/GRPECSObject.h"
+#include "Framework/ConfigParamRegistry.h"
 
 using namespace o2::framework;
 using namespace o2::tpc;
 
+void ClusterSharingMapSpec::init(InitContext& ic)
+{
+  mNThreads = std::max(1, ic.options().get<int>("nthreads"));
+}
+
 void ClusterSharingMapSpec::run(ProcessingContext& pc)
 {
   TStopwatch timer;
@@ -43,7 +50,7 @@ void ClusterSharingMapSpec::run(ProcessingContext& pc)
   auto& bufVecSh = pc.outputs().make<std::vector<unsigned char>>(Output{o2::header::gDataOriginTPC, "CLSHAREDMAP", 0}, clustersTPC->clusterIndex.nClustersTotal);
   size_t occupancyMapSize = o2::gpu::GPUO2InterfaceRefit::fillOccupancyMapGetSize(nHBPerTF, param.get());
   auto& bufVecOcc = pc.outputs().make<std::vector<unsigned int>>(Output{o2::header::gDataOriginTPC, "TPCOCCUPANCYMAP", 0}, occupancyMapSize);
-  o2::gpu::GPUO2InterfaceRefit::fillSharedClustersAndOccupancyMap(&clustersTPC->clusterIndex, tracksTPC, tracksTPCClRefs.data(), bufVecSh.data(), bufVecOcc.data(), nHBPerTF, param.get());
+  o2::gpu::GPUO2InterfaceRefit::fillSharedClustersAndOccupancyMap(&clustersTPC->clusterIndex, tracksTPC, tracksTPCClRefs.data(), bufVecSh.data(), bufVecOcc.data(), nHBPerTF, param.get(), mNThreads);
 
   timer.Stop();
   LOGF(info, "Timing for TPC clusters sharing map creation: Cpu: %.3e Real: %.3e s", timer.CpuTime(), timer.RealTime());
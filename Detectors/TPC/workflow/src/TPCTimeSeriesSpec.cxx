@@ -253,14 +253,6 @@ class TPCTimeSeries : public Task
         mTPCChi2C[i][type].clear();
         mTPCNClA[i][type].clear();
         mTPCNClC[i][type].clear();
-        mMIPdEdxRatioQMaxA[i][type].setUseWeights(false);
-        mMIPdEdxRatioQMaxC[i][type].setUseWeights(false);
-        mMIPdEdxRatioQTotA[i][type].setUseWeights(false);
-        mMIPdEdxRatioQTotC[i][type].setUseWeights(false);
-        mTPCChi2A[i][type].setUseWeights(false);
-        mTPCChi2C[i][type].setUseWeights(false);
-        mTPCNClA[i][type].setUseWeights(false);
-        mTPCNClC[i][type].setUseWeights(false);
       }
       for (int type = 0; type < mLogdEdxQTotA[i].size(); ++type) {
         mLogdEdxQTotA[i][type].clear();
@@ -298,10 +290,6 @@ class TPCTimeSeries : public Task
         mAvgMeffC[i][j].clear();
         mAvgChi2MatchA[i][j].clear();
         mAvgChi2MatchC[i][j].clear();
-        mAvgMeffA[i][j].setUseWeights(false);
-        mAvgMeffC[i][j].setUseWeights(false);
-        mAvgChi2MatchA[i][j].setUseWeights(false);
-        mAvgChi2MatchC[i][j].setUseWeights(false);
       }
     }
 
@@ -341,22 +329,6 @@ class TPCTimeSeries : public Task
         mAvgADCAz[i][type].reserve(resMem);
         mAvgCDCAz[i][type].reserve(resMem);
       }
-      for (int type = 0; type < mMIPdEdxRatioQMaxA[i].size(); ++type) {
-        mMIPdEdxRatioQMaxA[i][type].reserve(resMem);
-        mMIPdEdxRatioQMaxC[i][type].reserve(resMem);
-        mMIPdEdxRatioQTotA[i][type].reserve(resMem);
-        mMIPdEdxRatioQTotC[i][type].reserve(resMem);
-        mTPCChi2A[i][type].reserve(resMem);
-        mTPCChi2C[i][type].reserve(resMem);
-        mTPCNClA[i][type].reserve(resMem);
-        mTPCNClC[i][type].reserve(resMem);
-      }
-      for (int j = 0; j < mAvgMeffA[i].size(); ++j) {
-        mAvgMeffA[i][j].reserve(resMem);
-        mAvgMeffC[i][j].reserve(resMem);
-        mAvgChi2MatchA[i][j].reserve(resMem);
-        mAvgChi2MatchC[i][j].reserve(resMem);
-      }
       for (int j = 0; j < mITSPropertiesA[i].size(); ++j) {
         mITSPropertiesA[i][j].reserve(resMem);
         mITSPropertiesC[i][j].reserve(resMem);
@@ -477,11 +449,10 @@ class TPCTimeSeries : public Task
       }
     }
 
-    // calculate statistics and store values
-    // loop over TPC sides
-    for (int type = 0; type < 2; ++type) {
-      // loop over phi and tgl bins
-      for (int slice = 0; slice < nBins; ++slice) {
+    // calculate statistics and store values: the bins are independent and processed in parallel
+    processSlices(nBins, [&](int slice) {
+      // loop over TPC and ITS-TPC tracks
+      for (int type = 0; type < 2; ++type) {
         auto& bufferDCA = (type == 0) ? mBufferDCA.mTSTPC : mBufferDCA.mTSITSTPC;
 
         const auto dcaAr = mAvgADCAr[slice][type].filterPointsMedian(mCutDCA, mCutRMS);
@@ -526,7 +497,7 @@ class TPCTimeSeries : public Task
           mBufferDCA.mDCAz_comb_C_RMS[slice] = std::get<2>(dcaCzComb);
         }
       }
-    }
+    });
 
     // calculate matching eff
     for (const auto& vals : mBufferVals) {
@@ -697,7 +668,7 @@ class TPCTimeSeries : public Task
     }
 
     // store matching eff
-    for (int slice = 0; slice < nBins; ++slice) {
+    processSlices(nBins, [&](int slice) {
       for (int i = 0; i < mAvgMeffA[slice].size(); ++i) {
         auto& itsBuf = (i == 0) ? mBufferDCA.mITSTPCAll : ((i == 1) ? mBufferDCA.mITSTPCStandalone : mBufferDCA.mITSTPCAfterburner);
         itsBuf.mITSTPC_A_MatchEff[slice] = mAvgMeffA[slice][i].getMean();
@@ -781,7 +752,7 @@ class TPCTimeSeries : public Task
       mBufferDCA.mTPCSigmaZ2A_RMS[slice] = mSigmaYZA[slice][1].getStdDev();
       mBufferDCA.mTPCSigmaY2C_RMS[slice] = mSigmaYZC[slice][0].getStdDev();
       mBufferDCA.mTPCSigmaZ2C_RMS[slice] = mSigmaYZC[slice][1].getStdDev();
-    }
+    });
 
     auto stop = timer::now();
     std::chrono::duration<float> time = stop - startTotal;
@@ -806,6 +777,25 @@ class TPCTimeSeries : public Task
   }
 
  private:
+  /// streaming average for the quantities for which only the mean is stored, avoids keeping all values in memory
+  struct MeanAverage {
+    void addValue(const float value)
+    {
+      mSum += value;
+      ++mEntries;
+    }
+    float getMean() const { return (mEntries > 0) ? mSum / mEntries : 0; }
+    void clear()
+    {
+      mSum = 0;
+      mEntries = 0;
+    }
+
+   private:
+    double mSum{0};           ///< sum of the added values
+    unsigned int mEntries{0}; ///< number of added values
+  };
+
   /// buffer struct for multithreading
   struct ValsdEdx {
     float dedxNorm = 0;
@@ -975,18 +965,18 @@ class TPCTimeSeries : public Task
   std::vector<std::array<RobustAverage, 3>> mAvgCDCAr;                     ///< for averaging the DCAr for TPC and ITS-TPC tracks for C-side
   std::vector<std::array<RobustAverage, 3>> mAvgADCAz;                     ///< for averaging the DCAz for TPC and ITS-TPC tracks for A-side
   std::vector<std::array<RobustAverage, 3>> mAvgCDCAz;                     ///< for averaging the DCAz for TPC and ITS-TPC tracks for C-side
-  std::vector<std::array<RobustAverage, 2>> mMIPdEdxRatioQMaxA;            ///< for averaging MIP/dEdx - qMax -
-  std::vector<std::array<RobustAverage, 2>> mMIPdEdxRatioQMaxC;            ///< for averaging MIP/dEdx - qMax -
-  std::vector<std::array<RobustAverage, 2>> mMIPdEdxRatioQTotA;            ///< for averaging MIP/dEdx - qTot -
-  std::vector<std::array<RobustAverage, 2>> mMIPdEdxRatioQTotC;            ///< for averaging MIP/dEdx - qTot -
-  std::vector<std::array<RobustAverage, 2>> mTPCChi2A;                     ///< for averaging chi2 TPC A
-  std::vector<std::array<RobustAverage, 2>> mTPCChi2C;                     ///< for averaging chi2 TPC C
-  std::vector<std::array<RobustAverage, 2>> mTPCNClA;                      ///< for averaging number of cluster A
-  std::vector<std::array<RobustAverage, 2>> mTPCNClC;                      ///< for averaging number of cluster C
-  std::vector<std::array<RobustAverage, 3>> mAvgMeffA;                     ///< for matching efficiency ITS-TPC standalone + afterburner, standalone, afterburner
-  std::vector<std::array<RobustAverage, 3>> mAvgMeffC;                     ///< for matching efficiency ITS-TPC standalone + afterburner, standalone, afterburner
-  std::vector<std::array<RobustAverage, 3>> mAvgChi2MatchA;                ///< for matching efficiency ITS-TPC standalone + afterburner, standalone, afterburner
-  std::vector<std::array<RobustAverage, 3>> mAvgChi2MatchC;                ///< for matching efficiency ITS-TPC standalone + afterburner, standalone, afterburner
+  std::vector<std::array<MeanAverage, 2>> mMIPdEdxRatioQMaxA;             ///< for averaging MIP/dEdx - qMax -
+  std::vector<std::array<MeanAverage, 2>> mMIPdEdxRatioQMaxC;             ///< for averaging MIP/dEdx - qMax -
+  std::vector<std::array<MeanAverage, 2>> mMIPdEdxRatioQTotA;             ///< for averaging MIP/dEdx - qTot -
+  std::vector<std::array<MeanAverage, 2>> mMIPdEdxRatioQTotC;             ///< for averaging MIP/dEdx - qTot -
+  std::vector<std::array<MeanAverage, 2>> mTPCChi2A;                      ///< for averaging chi2 TPC A
+  std::vector<std::array<MeanAverage, 2>> mTPCChi2C;                      ///< for averaging chi2 TPC C
+  std::vector<std::array<MeanAverage, 2>> mTPCNClA;                       ///< for averaging number of cluster A
+  std::vector<std::array<MeanAverage, 2>> mTPCNClC;                       ///< for averaging number of cluster C
+  std::vector<std::array<MeanAverage, 3>> mAvgMeffA;                      ///< for matching efficiency ITS-TPC standalone + afterburner, standalone, afterburner
+  std::vector<std::array<MeanAverage, 3>> mAvgMeffC;                      ///< for matching efficiency ITS-TPC standalone + afterburner, standalone, afterburner
+  std::vector<std::array<MeanAverage, 3>> mAvgChi2MatchA;                 ///< for matching efficiency ITS-TPC standalone + afterburner, standalone, afterburner
+  std::vector<std::array<MeanAverage, 3>> mAvgChi2MatchC;                 ///< for matching efficiency ITS-TPC standalone + afterburner, standalone, afterburner
   std::vector<std::array<RobustAverage, 10>> mLogdEdxQTotA;                ///< for log dedx A side - qTot
   std::vector<std::array<RobustAverage, 10>> mLogdEdxQTotC;                ///< for log dedx C side - qTot
   std::vector<std::array<RobustAverage, 10>> mLogdEdxQMaxA;                ///< for log dedx A side - qMax
@@ -1692,6 +1682,26 @@ class TPCTimeSeries : public Task
   /// \return returns total number of stored values per TF
   int getNBins() const { return mBufferDCA.mTSTPC.getNBins(); }
 
+  /// calling func for all bins, distributing the bins over the threads
+  template <typename Func>
+  void processSlices(const int nBins, Func&& func)
+  {
+    auto myThread = [&](int iThread) {
+      for (int slice = iThread; slice < nBins; slice += mNThreads) {
+        func(slice);
+      }
+    };
+
+    std::vector<std::thread> threads(mNThreads);
+    for (int i = 0; i < mNThreads; i++) {
+      threads[i] = std::thread(myThread, i);
+    }
+
+    for (auto& th : threads) {
+      th.join();
+    }
+  }
+
   ValsdEdx getdEdxVars(bool useQMax, const TrackTPC& track) const
   {
     const float dedx = useQMax ? track.getdEdx().dEdxMaxTPC : track.getdEdx().dEdxTotTPC;
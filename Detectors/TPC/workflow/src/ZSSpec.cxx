@@ -141,6 +141,7 @@ DataProcessorSpec getZSEncoderSpec(std::vector<int> const& tpcSectors, bool outR
         uint32_t rdhV = o2::raw::RDHUtils::getVersion<o2::header::RAWDataHeader>();
         writer.useRDHVersion(rdhV);
         writer.doLazinessCheck(false); // LazinessCheck is not thread-safe
+        writer.useAsyncWriting();      // the sectors are encoded in parallel, write their superpages in the background
         std::string outDir = "./";
         const unsigned int defaultLink = 0;
         enum LinksGrouping { All,
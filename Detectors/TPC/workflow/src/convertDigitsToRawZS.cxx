@@ -164,6 +164,7 @@ void convertDigitsToZSfinal(std::string_view digitsFile, std::string_view output
     writer.useCaching();
   }
   writer.doLazinessCheck(false); // LazinessCheck is not thread-safe
+  writer.useAsyncWriting();      // the sectors are encoded in parallel, write their superpages in the background
 
   // ===| set up branch addresses |=============================================
   std::vector<Digit>* vDigitsPerSectorCollection[Sector::MAXSECTOR] = {nullptr}; // container that keeps Digits per sector
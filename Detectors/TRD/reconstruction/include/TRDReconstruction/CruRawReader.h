@@ -100,6 +100,10 @@ class CruRawReader
   // reset the event storage and the counters
   void reset();
 
+  // move the events, counters and half-chamber reports of another reader into this one and reset the other reader,
+  // used to combine the results of readers which processed different half-CRUs of the same TF in parallel
+  void merge(CruRawReader& other);
+
   // the parsing starts here, payload from all available RDHs is copied into mHBFPayload and afterwards processHalfCRU() is called
   // returns the total number of bytes read, including RDH header
   int processHBFs();
@@ -24,6 +24,8 @@
 #include "DataFormatsTRD/Digit.h"
 #include "DataFormatsTRD/RawDataStats.h"
 #include <fstream>
+#include <memory>
+#include <vector>
 
 using namespace o2::framework;
 
@@ -46,12 +48,14 @@ class DataReaderTask : public Task
   CruRawReader mReader; // this will do the parsing, of raw data passed directly through the flp(no compression)
                         // we pull the data from the vectors build message and pass on.
                         // they will internally produce a vector of digits and a vector tracklets and associated indexing.
+  std::vector<std::unique_ptr<CruRawReader>> mHelperReaders; // additional readers for the parallel decoding of the half-CRUs, merged into mReader
 
   bool mVerbose{false};          // verbos output general debuggign and info output.
   bool mDataVerbose{false};      // verbose output of data unpacking
   bool mHeaderVerbose{false};    // verbose output of headers
   bool mCompressedData{false};   // are we dealing with the compressed data from the flp (send via option)
   int mProcessEveryNthTF{1};     // to parse only every n-th TF and send empty output for the rest
+  int mNThreads{1};              // number of threads decoding the half-CRUs of a TF
   bool mInitOnceDone{false};     // flag for requesting new CCDB object upon global run number change
   std::bitset<16> mOptions;            // stores the incoming of the above bools, useful to be able to send this on instead of the individual ones above
                                        // the above bools make the code more readable hence still here.
@@ -59,6 +59,9 @@ class EventRecord
   // sort the tracklets (and optionally digits) by detector, pad row, pad column
   void sortData(bool sortDigits);
 
+  // append the data and the counters of another record of the same trigger
+  void merge(const EventRecord& other);
+
   void incTrackletTime(float timeadd) { mTimeTakenForTracklets += timeadd; }
   void incDigitTime(float timeadd) { mTimeTakenForDigits += timeadd; }
   void incTime(float duration) { mTimeTaken += duration; }
@@ -111,6 +114,10 @@ class EventRecordContainer
   void reset();
   void accumulateStats();
 
+  // add the records of another container, e.g. filled from a different set of half-CRUs,
+  // merging the records of the same trigger and keeping the order in which the triggers were seen
+  void merge(const EventRecordContainer& other);
+
  private:
   int mCurrEventRecord = 0;
   std::vector<EventRecord> mEventRecords;
@@ -1156,6 +1156,21 @@ void CruRawReader::reset()
   mWordsRejected = 0;
 }
 
+void CruRawReader::merge(CruRawReader& other)
+{
+  mEventRecords.merge(other.mEventRecords);
+  mTrackletsFound += other.mTrackletsFound;
+  mDigitsFound += other.mDigitsFound;
+  mDigitWordsRead += other.mDigitWordsRead;
+  mDigitWordsRejected += other.mDigitWordsRejected;
+  mTrackletWordsRead += other.mTrackletWordsRead;
+  mTrackletWordsRejected += other.mTrackletWordsRejected;
+  mWordsRejected += other.mWordsRejected;
+  mHalfChamberHeaderOK.merge(other.mHalfChamberHeaderOK);
+  mHalfChamberMismatches.merge(other.mHalfChamberMismatches);
+  other.reset();
+}
+
 void CruRawReader::checkNoWarn(bool silently)
 {
   if (!mOptions[TRDVerboseErrorsBit]) {
@@ -26,6 +26,10 @@
 #include "DataFormatsCTP/TriggerOffsetsParam.h"
 #include "DataFormatsTRD/Constants.h"
 
+#include <algorithm>
+#include <functional>
+#include <thread>
+
 namespace o2::trd
 {
 
@@ -39,6 +43,18 @@ void DataReaderTask::init(InitContext& ic)
   }
   mReader.configure(mTrackletHCHeaderState, mHalfChamberWords, mHalfChamberMajor, mOptions);
   mProcessEveryNthTF = ic.options().get<int>("every-nth-tf");
+  mNThreads = std::max(1, ic.options().get<int>("nthreads"));
+  for (int i = 1; i < mNThreads; ++i) {
+    auto& reader = mHelperReaders.emplace_back(std::make_unique<CruRawReader>());
+    reader->setMaxErrWarnPrinted(ic.options().get<int>("log-max-errors"), ic.options().get<int>("log-max-warnings"));
+    if (nTimeBins >= 0) {
+      reader->setNumberOfTimeBins(nTimeBins);
+    }
+    reader->configure(mTrackletHCHeaderState, mHalfChamberWords, mHalfChamberMajor, mOptions);
+  }
+  if (mNThreads > 1) {
+    LOGP(info, "Decoding the half-CRUs of each TF with {} threads", mNThreads);
+  }
 }
 
 void DataReaderTask::endOfStream(o2::framework::EndOfStreamContext& ec)
@@ -57,6 +73,9 @@ void DataReaderTask::finaliseCCDB(ConcreteDataMatcher& matcher, void* obj)
   } else if (matcher == ConcreteDataMatcher("TRD", "LinkToHcid", 0)) {
     LOG(info) << "Updated Link ID to HCID mapping";
     mReader.setLinkMap((const o2::trd::LinkToHCIDMapping*)obj);
+    for (auto& reader : mHelperReaders) {
+      reader->setLinkMap((const o2::trd::LinkToHCIDMapping*)obj);
+    }
     return;
   }
 }
@@ -113,23 +132,50 @@ void DataReaderTask::run(ProcessingContext& pc)
   size_t datasizeInTF = 0;
   std::vector<InputSpec> sel{InputSpec{"filter", ConcreteDataTypeMatcher{"TRD", "RAWDATA"}}};
   uint64_t tfCount = 0;
+  std::vector<DataRef> refs;
   for (auto& ref : InputRecordWalker(pc.inputs(), sel)) {
-    // loop over incoming HBFs from all half-CRUs (typically 128 * 72 iterations per TF)
+    // incoming HBFs from all half-CRUs (typically 128 * 72 per TF)
     const auto* dh = DataRefUtils::getHeader<o2::header::DataHeader*>(ref);
     tfCount = dh->tfCounter;
-    const char* payloadIn = ref.payload;
-    auto payloadInSize = DataRefUtils::getPayloadSize(ref);
-    if (mOptions[TRDVerboseBit]) {
-      LOGP(info, "Found input [{}/{}/{:#x}] TF#{} 1st_orbit:{} Payload {} : ",
-           dh->dataOrigin.str, dh->dataDescription.str, dh->subSpecification, dh->tfCounter, dh->firstTForbit, payloadInSize);
+    datasizeInTF += DataRefUtils::getPayloadSize(ref);
+    refs.push_back(ref);
+  }
+
+  auto decode = [this, &refs](CruRawReader& reader, size_t first, size_t last) {
+    for (size_t iRef = first; iRef < last; ++iRef) {
+      const auto& ref = refs[iRef];
+      auto payloadInSize = DataRefUtils::getPayloadSize(ref);
+      if (mOptions[TRDVerboseBit]) {
+        const auto* dh = DataRefUtils::getHeader<o2::header::DataHeader*>(ref);
+        LOGP(info, "Found input [{}/{}/{:#x}] TF#{} 1st_orbit:{} Payload {} : ",
+             dh->dataOrigin.str, dh->dataDescription.str, dh->subSpecification, dh->tfCounter, dh->firstTForbit, payloadInSize);
+      }
+      reader.setDataBuffer(ref.payload);
+      reader.setDataBufferSize(payloadInSize);
+      reader.run();
+      if (mOptions[TRDVerboseBit]) {
+        LOG(info) << "relevant vectors to read : " << reader.getTrackletsFound() << " tracklets and " << reader.getDigitsFound() << " compressed digits";
+      }
+    }
+  };
+  int nThreads = std::min<size_t>(mNThreads, refs.size());
+  if (nThreads > 1) {
+    // each thread decodes a contiguous range of half-CRU inputs, merging the readers in
+    // thread order afterwards yields the triggers and their data in the same order as
+    // the sequential decoding
+    std::vector<std::thread> workers;
+    for (int iThread = 1; iThread < nThreads; ++iThread) {
+      workers.emplace_back(decode, std::ref(*mHelperReaders[iThread - 1]), refs.size() * iThread / nThreads, refs.size() * (iThread + 1) / nThreads);
+    }
+    decode(mReader, 0, refs.size() / nThreads);
+    for (auto& worker : workers) {
+      worker.join();
     }
-    mReader.setDataBuffer(payloadIn);
-    mReader.setDataBufferSize(payloadInSize);
-    mReader.run();
-    datasizeInTF += payloadInSize;
-    if (mOptions[TRDVerboseBit]) {
-      LOG(info) << "relevant vectors to read : " << mReader.getTrackletsFound() << " tracklets and " << mReader.getDigitsFound() << " compressed digits";
+    for (int iThread = 1; iThread < nThreads; ++iThread) {
+      mReader.merge(*mHelperReaders[iThread - 1]);
     }
+  } else {
+    decode(mReader, 0, refs.size());
   }
 
   mReader.buildDPLOutputs(pc);
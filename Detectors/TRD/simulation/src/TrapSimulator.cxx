@@ -35,6 +35,7 @@
 #include "TRandom.h"
 #include "TFile.h"
 
+#include <algorithm>
 #include <iomanip>
 
 using namespace o2::trd;
@@ -691,14 +692,14 @@ void TrapSimulator::setBaselines()
     return;
   }
 
+  // kFPNP = 32 = 8 << 2 (pedestal correction additive) and kTPFP = 40 = 10 << 2 (filtered pedestal)
+  const int baseline = mTrapConfig->getTrapReg(TrapConfig::kTPFP, mDetector, mRobPos, mMcmPos); // OS: not using FPNP here, since in filter() the ADC values from the 'raw' array will be copied into the filtered array
+
   //loop over all adcs.
   for (int adc = 0; adc < NADCMCM; adc++) {
     if ((mADCFilled & (1 << adc)) == 0) { // adc is empty by construction of mADCFilled.
-      for (int timebin = 0; timebin < mNTimeBin; timebin++) {
-        // kFPNP = 32 = 8 << 2 (pedestal correction additive) and kTPFP = 40 = 10 << 2 (filtered pedestal)
-        mADCR[adc * mNTimeBin + timebin] = mTrapConfig->getTrapReg(TrapConfig::kTPFP, mDetector, mRobPos, mMcmPos); // OS: not using FPNP here, since in filter() the ADC values from the 'raw' array will be copied into the filtered array
-        mADCF[adc * mNTimeBin + timebin] = mTrapConfig->getTrapReg(TrapConfig::kTPFP, mDetector, mRobPos, mMcmPos);
-      }
+      std::fill_n(&mADCR[adc * mNTimeBin], mNTimeBin, baseline);
+      std::fill_n(&mADCF[adc * mNTimeBin], mNTimeBin, baseline);
     }
   }
 }
@@ -905,16 +906,27 @@ void TrapSimulator::filterPedestal()
   // It has only an effect if previous samples have been fed to
   // find the pedestal. Currently, the simulation assumes that
   // the input has been stable for a sufficiently long time.
-  // LOG(debug) << "BEGIN: " << __FILE__ << ":" << __func__ << ":" << __LINE__ ;
+  //
+  // Same as filterPedestalNextSample() for all samples, but with the
+  // configuration read once and running over the time bins of one
+  // channel after the other (the channels are independent).
 
-  for (int iTimeBin = 0; iTimeBin < mNTimeBin; iTimeBin++) {
-    for (int iAdc = 0; iAdc < NADCMCM; iAdc++) {
-      int oldadc = mADCF[iAdc * mNTimeBin + iTimeBin];
-      mADCF[iAdc * mNTimeBin + iTimeBin] = filterPedestalNextSample(iAdc, iTimeBin, mADCR[iAdc * mNTimeBin + iTimeBin]);
-      //    LOG(debug) << "mADCF : time : " << iTimeBin << " adc : " << iAdc << " change : " << oldadc << " -> " << mADCF[iAdc * mNTimeBin + iTimeBin];
+  const unsigned short fptc = mTrapConfig->getTrapReg(TrapConfig::kFPTC, mDetector, mRobPos, mMcmPos); // 0..3, 0 - fastest, 3 - slowest
+  const unsigned short shift = mgkFPshifts[fptc];
+
+  for (int iAdc = 0; iAdc < NADCMCM; iAdc++) {
+    const int* adcr = &mADCR[iAdc * mNTimeBin];
+    int* adcf = &mADCF[iAdc * mNTimeBin];
+    for (int iTimeBin = 0; iTimeBin < mNTimeBin; iTimeBin++) {
+      const unsigned short value = adcr[iTimeBin];
+      if (iTimeBin == 0) { // the accumulator is disabled in the drift time
+        unsigned short accumulatorShifted = (mInternalFilterRegisters[iAdc].mPedAcc >> shift) & 0x3FF; // 10 bits
+        int correction = (value & 0x3FF) - accumulatorShifted;
+        mInternalFilterRegisters[iAdc].mPedAcc = (mInternalFilterRegisters[iAdc].mPedAcc + correction) & 0x7FFFFFFF; // 31 bits
+      }
+      adcf[iTimeBin] = value; // FIXME bypass hard-coded for now, as in filterPedestalNextSample()
     }
   }
-  // LOG(debug) << "BEGIN: " << __FILE__ << ":" << __func__ << ":" << __LINE__ ;
 }
 
 void TrapSimulator::filterGainInit()
@@ -1088,11 +1100,44 @@ unsigned short TrapSimulator::filterTailNextSample(int adc, unsigned short value
 void TrapSimulator::filterTail()
 {
   // Apply tail cancellation filter to all data.
+  // Same as filterTailNextSample() for all samples, but with the
+  // configuration read once and running over the time bins of one
+  // channel after the other (the channels are independent).
 
-  for (int iTimeBin = 0; iTimeBin < mNTimeBin; iTimeBin++) {
-    for (int iAdc = 0; iAdc < NADCMCM; iAdc++) {
-      mADCF[iAdc * mNTimeBin + iTimeBin] = filterTailNextSample(iAdc, mADCF[iAdc * mNTimeBin + iTimeBin]);
+  // exponents and weight calculated from configuration
+  const unsigned short alphaLong = 0x3ff & mTrapConfig->getTrapReg(TrapConfig::kFTAL, mDetector, mRobPos, mMcmPos);                            // the weight of the long component
+  const unsigned short lambdaLong = (1 << 10) | (1 << 9) | (mTrapConfig->getTrapReg(TrapConfig::kFTLL, mDetector, mRobPos, mMcmPos) & 0x1FF);  // the multiplier of the long component
+  const unsigned short lambdaShort = (0 << 10) | (1 << 9) | (mTrapConfig->getTrapReg(TrapConfig::kFTLS, mDetector, mRobPos, mMcmPos) & 0x1FF); // the multiplier of the short component
+  const bool bypass = mTrapConfig->getTrapReg(TrapConfig::kFTBY, mDetector, mRobPos, mMcmPos) == 0;                                            // bypass mode, active low
+
+  for (int iAdc = 0; iAdc < NADCMCM; iAdc++) {
+    int* adcf = &mADCF[iAdc * mNTimeBin];
+    unsigned short amplLong = mInternalFilterRegisters[iAdc].mTailAmplLong;
+    unsigned short amplShort = mInternalFilterRegisters[iAdc].mTailAmplShort;
+    for (int iTimeBin = 0; iTimeBin < mNTimeBin; iTimeBin++) {
+      const unsigned short value = adcf[iTimeBin];
+      const unsigned short inpVolt = value & 0xFFF; // 12 bits
+
+      // add the present generator outputs
+      const unsigned short aQ = addUintClipping(amplLong, amplShort, 12);
+
+      // calculate the difference between the input and the generated signal
+      const unsigned int aDiff = inpVolt > aQ ? inpVolt - aQ : 0;
+
+      // the inputs to the two generators, weighted
+      const unsigned int alInpv = (aDiff * alphaLong) >> 11;
+
+      // the new values of the registers, used next time
+      unsigned int tmp = addUintClipping(amplLong, alInpv, 12);
+      amplLong = ((tmp * lambdaLong) >> 11) & 0xFFF;
+      tmp = addUintClipping(amplShort, aDiff - alInpv, 12);
+      amplShort = ((tmp * lambdaShort) >> 11) & 0xFFF;
+
+      // the output of the filter
+      adcf[iTimeBin] = bypass ? value : aDiff;
     }
+    mInternalFilterRegisters[iAdc].mTailAmplLong = amplLong;
+    mInternalFilterRegisters[iAdc].mTailAmplShort = amplShort;
   }
 }
 
@@ -1257,6 +1302,12 @@ void TrapSimulator::calcFitreg()
     fitreg.ClearReg();
   }
 
+  // configuration used for every time bin
+  const bool bypassHitQual = mTrapConfig->getTrapReg(TrapConfig::kTPVBY, mDetector, mRobPos, mMcmPos) == 0;
+  const int regTPVT = mTrapConfig->getTrapReg(TrapConfig::kTPVT, mDetector, mRobPos, mMcmPos);
+  const int regTPHT = mTrapConfig->getTrapReg(TrapConfig::kTPHT, mDetector, mRobPos, mMcmPos);
+  const int regTPFP = mTrapConfig->getTrapReg(TrapConfig::kTPFP, mDetector, mRobPos, mMcmPos);
+
   for (unsigned int timebin = timebin1; timebin < timebin2; timebin++) {
     // first find the hit candidates and store the total cluster charge in qTotal array
     // in case of not hit store 0 there.
@@ -1267,16 +1318,14 @@ void TrapSimulator::calcFitreg()
       adcCentral = mADCF[(adcch + 1) * mNTimeBin + timebin];
       adcRight = mADCF[(adcch + 2) * mNTimeBin + timebin];
       bool hitQual = false;
-      if (mTrapConfig->getTrapReg(TrapConfig::kTPVBY, mDetector, mRobPos, mMcmPos) == 0) {
+      if (bypassHitQual) {
         // bypass the cluster verification
         hitQual = true;
       } else {
-        hitQual = ((adcLeft * adcRight) <
-                   ((mTrapConfig->getTrapReg(TrapConfig::kTPVT, mDetector, mRobPos, mMcmPos) * adcCentral * adcCentral) >> 10));
+        hitQual = ((adcLeft * adcRight) < ((regTPVT * adcCentral * adcCentral) >> 10));
         if (hitQual) {
           LOG(debug) << "cluster quality cut passed with " << adcLeft << ", " << adcCentral << ", "
-                     << adcRight << " - threshold " << mTrapConfig->getTrapReg(TrapConfig::kTPVT, mDetector, mRobPos, mMcmPos)
-                     << " -> " << mTrapConfig->getTrapReg(TrapConfig::kTPVT, mDetector, mRobPos, mMcmPos) * adcCentral * adcCentral;
+                     << adcRight << " - threshold " << regTPVT << " -> " << regTPVT * adcCentral * adcCentral;
         }
       }
 
@@ -1284,7 +1333,7 @@ void TrapSimulator::calcFitreg()
       int qtotTemp = adcLeft + adcCentral + adcRight;
 
       if ((hitQual) &&
-          (qtotTemp >= mTrapConfig->getTrapReg(TrapConfig::kTPHT, mDetector, mRobPos, mMcmPos)) &&
+          (qtotTemp >= regTPHT) &&
           (adcLeft <= adcCentral) &&
           (adcCentral > adcRight)) {
         qTotal[adcch] = qtotTemp;
@@ -1373,10 +1422,9 @@ void TrapSimulator::calcFitreg()
         //  hit detected, in TRAP we have 4 units and a hit-selection, here we proceed all channels!
         //  subtract the pedestal TPFP, clipping instead of wrapping
 
-        int regTPFP = mTrapConfig->getTrapReg(TrapConfig::kTPFP, mDetector, mRobPos, mMcmPos); //TODO put this together with the others as members of trapsim, which is initiliased by det,rob,mcm.
         LOG(debug) << "Hit found, time=" << timebin << ", adcch=" << adcch << "/" << adcch + 1 << "/"
                    << adcch + 2 << ", adc values=" << adcLeft << "/" << adcCentral << "/"
-                   << adcRight << ", regTPFP=" << regTPFP << ", TPHT=" << mTrapConfig->getTrapReg(TrapConfig::kTPHT, mDetector, mRobPos, mMcmPos);
+                   << adcRight << ", regTPFP=" << regTPFP << ", TPHT=" << regTPHT;
         // regTPFP >>= 2; // OS: this line should be commented out when checking real data. It's only needed for comparison with Venelin's simulation if in addition mgkAddDigits == 0
         if (adcLeft < regTPFP) {
           adcLeft = 0;
@@ -84,9 +84,10 @@ class StrangenessTracker
   ~StrangenessTracker() = default;
 
   bool loadData(const o2::globaltracking::RecoContainer& recoData);
-  bool matchDecayToITStrack(float decayR, StrangeTrack& strangeTrack, ClusAttachments& structClus, const TrackITS& itsTrack, std::vector<o2::track::TrackParCovF>& daughterTracks, int iThread = 0);
+  bool matchDecayToITStrack(float decayR, StrangeTrack& strangeTrack, ClusAttachments& structClus, int iSortedTrack, std::vector<o2::track::TrackParCovF>& daughterTracks, int iThread = 0);
   void prepareITStracks();
   void process();
+  void mergeThreadOutputs();
   void processV0(int iv0, const V0& v0, const V0Index& v0Idx, int iThread = 0);
   void processCascade(int icasc, const Cascade& casc, const CascadeIndex& cascIdx, const V0& cascV0, int iThread = 0);
   void process3Body(int i3body, const Decay3Body& dec3body, const Decay3BodyIndex& dec3bodyIdx, int iThread = 0);
@@ -125,6 +126,9 @@ class StrangenessTracker
     mTracksIdxTable.clear();
     mSortedITStracks.clear();
     mSortedITSindexes.clear();
+    mSortedITSclusters.clear();
+    mSortedITSclusterSizes.clear();
+    mSortedITSclusterRefs.clear();
     mITSvtxBrackets.clear();
     mInputITSclusters.clear();
     mInputClusterSizes.clear();
@@ -140,6 +144,7 @@ class StrangenessTracker
     mClusAttachments.resize(nThreads);
     mStrangeTrackLabels.resize(nThreads);
     mDaughterTracks.resize(nThreads);
+    mMotherClusters.resize(nThreads);
   }
 
   void setupFitters()
@@ -338,6 +343,9 @@ class StrangenessTracker
 
   std::vector<o2::its::TrackITS> mSortedITStracks; // sorted ITS tracks
   std::vector<int> mSortedITSindexes;              // indexes of sorted ITS tracks
+  std::vector<ITSCluster> mSortedITSclusters;      // clusters of the sorted ITS tracks, stored once and shared by all candidates
+  std::vector<int> mSortedITSclusterSizes;         // sizes of the clusters of the sorted ITS tracks
+  std::vector<int> mSortedITSclusterRefs;          // first entry in mSortedITSclusters for each sorted ITS track (+ total size)
   IndexTableUtils mUtils;                          // structure for computing eta/phi matching selections
 
   std::vector<std::vector<StrangeTrack>> mStrangeTrackVec;       // structure containing updated mother and daughter tracks (per thread)
@@ -358,6 +366,7 @@ class StrangenessTracker
   o2::base::PropagatorImpl<float>::MatCorrType mCorrType = o2::base::PropagatorImpl<float>::MatCorrType::USEMatCorrNONE; // use mat correction
 
   std::vector<std::vector<o2::track::TrackParCovF>> mDaughterTracks; // vector of daughter tracks (per thread)
+  std::vector<std::vector<ITSCluster>> mMotherClusters;              // clusters attached to the mother track (per thread)
   ClusAttachments mStructClus;                                       // # of attached tracks, 1 for mother, 2 for daughter
 
   ClassDefNV(StrangenessTracker, 1);
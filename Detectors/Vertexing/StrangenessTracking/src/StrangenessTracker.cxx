@@ -11,6 +11,7 @@
 /// \file StrangenessTracker.cxx
 /// \brief
 
+#include <algorithm>
 #include <numeric>
 #include "StrangenessTracking/StrangenessTracker.h"
 #include "ITStracking/IOUtils.h"
@@ -20,6 +21,10 @@
 #include "ITS3Reconstruction/IOUtils.h"
 #endif
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 namespace o2
 {
 namespace strangeness_tracking
@@ -126,6 +131,19 @@ void StrangenessTracker::prepareITStracks() // sort tracks by eta and phi and se
   }
   std::exclusive_scan(mTracksIdxTable.begin(), mTracksIdxTable.begin() + mUtils.mPhiBins * mUtils.mEtaBins, mTracksIdxTable.begin(), 0);
   mTracksIdxTable[mUtils.mPhiBins * mUtils.mEtaBins] = mSortedITStracks.size();
+
+  // store the clusters of the sorted tracks contiguously, so that they are not collected again for every decay candidate
+  mSortedITSclusterRefs.reserve(mSortedITStracks.size() + 1);
+  for (const auto& track : mSortedITStracks) {
+    mSortedITSclusterRefs.push_back(mSortedITSclusters.size());
+    auto firstClus = track.getFirstClusterEntry();
+    for (int icl = 0; icl < track.getNumberOfClusters(); icl++) {
+      auto clusIdx = mInputITSidxs[firstClus + icl];
+      mSortedITSclusters.push_back(mInputITSclusters[clusIdx]);
+      mSortedITSclusterSizes.push_back(mInputClusterSizes[clusIdx]);
+    }
+  }
+  mSortedITSclusterRefs.push_back(mSortedITSclusters.size());
 }
 
 void StrangenessTracker::processV0(int iv0, const V0& v0, const V0Index& v0Idx, int iThread)
@@ -166,7 +184,7 @@ void StrangenessTracker::processV0(int iv0, const V0& v0, const V0Index& v0Idx,
       if (mStrParams->mVertexMatching && (mITSvtxBrackets[ITSindexRef].getMin() > v0Idx.getVertexID() || mITSvtxBrackets[ITSindexRef].getMax() < v0Idx.getVertexID())) {
         continue;
       }
-      if (matchDecayToITStrack(v0R, strangeTrack, structClus, itsTrack, daughterTracks, iThread)) {
+      if (matchDecayToITStrack(v0R, strangeTrack, structClus, iTrack, daughterTracks, iThread)) {
         auto propInstance = o2::base::Propagator::Instance();
         o2::track::TrackParCov decayVtxTrackClone = strangeTrack.mMother; // clone track and propagate to decay vertex
         if (!propInstance->propagateToX(decayVtxTrackClone, strangeTrack.mDecayVtx[0], getBz(), o2::base::PropagatorImpl<float>::MAX_SIN_PHI, o2::base::PropagatorImpl<float>::MAX_STEP, mCorrType)) {
@@ -225,7 +243,7 @@ void StrangenessTracker::processCascade(int iCasc, const Cascade& casc, const Ca
         LOG(debug) << "Vertex ID mismatch: " << mITSvtxBrackets[ITSindexRef].getMin() << " < " << cascIdx.getVertexID() << " < " << mITSvtxBrackets[ITSindexRef].getMax();
         continue;
       }
-      if (matchDecayToITStrack(cascR, strangeTrack, structClus, itsTrack, daughterTracks, iThread)) {
+      if (matchDecayToITStrack(cascR, strangeTrack, structClus, iTrack, daughterTracks, iThread)) {
         auto propInstance = o2::base::Propagator::Instance();
         o2::track::TrackParCov decayVtxTrackClone = strangeTrack.mMother; // clone track and propagate to decay vertex
         if (!propInstance->propagateToX(decayVtxTrackClone, strangeTrack.mDecayVtx[0], getBz(), o2::base::PropagatorImpl<float>::MAX_SIN_PHI, o2::base::PropagatorImpl<float>::MAX_STEP, mCorrType)) {
@@ -278,7 +296,7 @@ void StrangenessTracker::process3Body(int i3Body, const Decay3Body& dec3body, co
         if (mStrParams->mVertexMatching && (mITSvtxBrackets[ITSindexRef].getMin() > dec3bodyIdx.getVertexID() || mITSvtxBrackets[ITSindexRef].getMax() < dec3bodyIdx.getVertexID())) {
           continue;
         }
-        if (matchDecayToITStrack(dec3bodyR, strangeTrack, structClus, itsTrack, daughterTracks, iThread)) {
+        if (matchDecayToITStrack(dec3bodyR, strangeTrack, structClus, iTrack, daughterTracks, iThread)) {
           auto propInstance = o2::base::Propagator::Instance();
           o2::track::TrackParCov decayVtxTrackClone = strangeTrack.mMother; // clone track and propagate to decay vertex
           if (!propInstance->propagateToX(decayVtxTrackClone, strangeTrack.mDecayVtx[0], getBz(), o2::base::PropagatorImpl<float>::MAX_SIN_PHI, o2::base::PropagatorImpl<float>::MAX_STEP, mCorrType)) {
@@ -318,39 +336,99 @@ void StrangenessTracker::process3Body(int i3Body, const Decay3Body& dec3body, co
 
 void StrangenessTracker::process()
 {
-  // Loop over V0s
-  for (int iV0{0}; iV0 < mInputV0tracks.size(); iV0++) {
-    LOG(debug) << "Analysing V0: " << iV0 + 1 << "/" << mInputV0tracks.size();
-    processV0(iV0, mInputV0tracks[iV0], mInputV0Indices[iV0]);
-  }
+  // Every decay candidate is an independent work unit, processed with the fitters and buffers of its thread.
+  // The per-thread outputs are merged by mergeThreadOutputs
+  int nV0s = mInputV0tracks.size(), nCascs = mInputCascadeTracks.size(), n3Bodies = mStrParams->mSkip3Body ? 0 : mInput3BodyTracks.size();
+#ifdef WITH_OPENMP
+#pragma omp parallel num_threads(mNThreads)
+#endif
+  {
+#ifdef WITH_OPENMP
+    int iThread = omp_get_thread_num();
+#else
+    int iThread = 0;
+#endif
+    // Loop over V0s
+#ifdef WITH_OPENMP
+#pragma omp for schedule(dynamic) nowait
+#endif
+    for (int iV0 = 0; iV0 < nV0s; iV0++) {
+      LOG(debug) << "Analysing V0: " << iV0 + 1 << "/" << nV0s;
+      processV0(iV0, mInputV0tracks[iV0], mInputV0Indices[iV0], iThread);
+    }
+
+    // Loop over Cascades
+#ifdef WITH_OPENMP
+#pragma omp for schedule(dynamic) nowait
+#endif
+    for (int iCasc = 0; iCasc < nCascs; iCasc++) {
+      LOG(debug) << "Analysing Cascade: " << iCasc + 1 << "/" << nCascs;
+      processCascade(iCasc, mInputCascadeTracks[iCasc], mInputCascadeIndices[iCasc], mInputV0tracks[mInputCascadeIndices[iCasc].getV0ID()], iThread);
+    }
 
-  // Loop over Cascades
-  for (int iCasc{0}; iCasc < mInputCascadeTracks.size(); iCasc++) {
-    LOG(debug) << "Analysing Cascade: " << iCasc + 1 << "/" << mInputCascadeTracks.size();
-    processCascade(iCasc, mInputCascadeTracks[iCasc], mInputCascadeIndices[iCasc], mInputV0tracks[mInputCascadeIndices[iCasc].getV0ID()]);
+    // Loop over 3bodys
+#ifdef WITH_OPENMP
+#pragma omp for schedule(dynamic) nowait
+#endif
+    for (int i3Body = 0; i3Body < n3Bodies; i3Body++) {
+      LOG(debug) << "Analysing 3-Body: " << i3Body + 1 << "/" << n3Bodies;
+      process3Body(i3Body, mInput3BodyTracks[i3Body], mInput3BodyIndices[i3Body], iThread);
+    }
   }
+}
 
-  // Loop over 3bodys
-  if (!mStrParams->mSkip3Body) {
-    for (int i3Body{0}; i3Body < mInput3BodyTracks.size(); i3Body++) {
-      LOG(debug) << "Analysing 3-Body: " << i3Body + 1 << "/" << mInput3BodyTracks.size();
-      process3Body(i3Body, mInput3BodyTracks[i3Body], mInput3BodyIndices[i3Body]);
+void StrangenessTracker::mergeThreadOutputs()
+{
+  // move the outputs of all threads to the containers of thread 0, in the order of the serial processing:
+  // all the strange tracks of a decay candidate are found by the same thread, so a stable sort by the candidate is enough
+  if (mNThreads < 2) {
+    return;
+  }
+  std::vector<StrangeTrack> strTracks;
+  std::vector<ClusAttachments> strClus;
+  std::vector<o2::MCCompLabel> strLabels;
+  std::vector<int> sortIdx;
+  for (int ith = 0; ith < mNThreads; ith++) {
+    for (size_t i = 0; i < mStrangeTrackVec[ith].size(); i++) {
+      sortIdx.push_back(strTracks.size());
+      strTracks.push_back(mStrangeTrackVec[ith][i]);
+      strClus.push_back(mClusAttachments[ith][i]);
+      if (mMCTruthON) {
+        strLabels.push_back(mStrangeTrackLabels[ith][i]);
+      }
+    }
+    mStrangeTrackVec[ith].clear();
+    mClusAttachments[ith].clear();
+    mStrangeTrackLabels[ith].clear();
+  }
+  std::stable_sort(sortIdx.begin(), sortIdx.end(), [&strTracks](int i1, int i2) {
+    const auto &t1 = strTracks[i1], &t2 = strTracks[i2];
+    return t1.mPartType < t2.mPartType || (t1.mPartType == t2.mPartType && t1.mDecayRef < t2.mDecayRef);
+  });
+  for (auto i : sortIdx) {
+    mStrangeTrackVec[0].push_back(strTracks[i]);
+    mClusAttachments[0].push_back(strClus[i]);
+    if (mMCTruthON) {
+      mStrangeTrackLabels[0].push_back(strLabels[i]);
     }
   }
 }
 
-bool StrangenessTracker::matchDecayToITStrack(float decayR, StrangeTrack& strangeTrack, ClusAttachments& structClus, const TrackITS& itsTrack, std::vector<o2::track::TrackParCovF>& daughterTracks, int iThread)
+bool StrangenessTracker::matchDecayToITStrack(float decayR, StrangeTrack& strangeTrack, ClusAttachments& structClus, int iSortedTrack, std::vector<o2::track::TrackParCovF>& daughterTracks, int iThread)
 {
   auto geom = o2::its::GeometryTGeo::Instance();
-  auto trackClusters = getTrackClusters(itsTrack);
-  auto trackClusSizes = getTrackClusterSizes(itsTrack);
-  auto& lastClus = trackClusters[0];
+  const auto& itsTrack = mSortedITStracks[iSortedTrack];
+  int firstClus = mSortedITSclusterRefs[iSortedTrack];
+  int nClus = mSortedITSclusterRefs[iSortedTrack + 1] - firstClus;
+  gsl::span<const ITSCluster> trackClusters(mSortedITSclusters.data() + firstClus, nClus);
+  gsl::span<const int> trackClusSizes(mSortedITSclusterSizes.data() + firstClus, nClus);
   strangeTrack.mMatchChi2 = getMatchingChi2(strangeTrack.mMother, itsTrack);
 
   auto radTol = decayR < 4 ? mStrParams->mRadiusTolIB : mStrParams->mRadiusTolOB;
   auto nMinClusMother = trackClusters.size() < 4 ? 2 : mStrParams->mMinMotherClus;
 
-  std::vector<ITSCluster> motherClusters;
+  auto& motherClusters = mMotherClusters[iThread];
+  motherClusters.clear();
   std::array<unsigned int, 7> nAttachments;
   nAttachments.fill(-1); // fill arr with -1
 
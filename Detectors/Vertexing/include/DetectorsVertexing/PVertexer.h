@@ -89,6 +89,10 @@ class PVertexer
   bool getValidateWithIR() const { return mValidateWithIR; }
   void setTrackSources(GTrackID::mask_t s);
 
+  /// number of threads for the vertexing of the time-Z clusters (needs OpenMP)
+  void setNThreads(int n);
+  int getNThreads() const { return mNThreads; }
+
   auto& getTracksPool() const { return mTracksPool; }
   auto& getTimeZClusters() const { return mTimeZClusters; }
 
@@ -165,6 +169,7 @@ class PVertexer
   void createTracksPool(const TR& tracks, gsl::span<const o2d::GlobalTrackID> gids);
 
   int findVertices(const VertexingInput& input, std::vector<PVertex>& vertices, std::vector<uint32_t>& trackIDs, std::vector<V2TRef>& v2tRefs);
+  void findVerticesParallel(std::vector<PVertex>& vertices, std::vector<uint32_t>& trackIDs, std::vector<V2TRef>& v2tRefs);
   void reAttach(std::vector<PVertex>& vertices, std::vector<int>& timeSort, std::vector<uint32_t>& trackIDs, std::vector<V2TRef>& v2tRefs);
 
   std::pair<int, int> getBestIR(const PVertex& vtx, const gsl::span<InteractionCandidate> intCand, int& currEntry) const;
@@ -223,6 +228,7 @@ class PVertexer
   int mLongestClusterMult = 0;
   bool mPoolDumpProduced = false;
   bool mITSOnly = false;
+  int mNThreads = 1;
   TStopwatch mTimeDBScan;
   TStopwatch mTimeVertexing;
   TStopwatch mTimeDebris;
@@ -152,6 +152,7 @@ class SVertexer
   template <class TVI, class TCI, class T3I, class TR>
   void extractPVReferences(const TVI& v0s, TR& vtx2V0Refs, const TCI& cascades, TR& vtx2CascRefs, const T3I& vtxs3, TR& vtx2body3Refs);
   bool checkV0(const TrackCand& seed0, const TrackCand& seed1, int iP, int iN, int ithread);
+  void selectV0Partners(const TrackCand& seedP, int iP, int firstN, std::vector<int>& partners) const;
   int checkCascades(const V0Index& v0Idx, const V0& v0, float rv0, std::array<float, 3> pV0, float p2V0, int avoidTrackID, int posneg, VBracket v0vlist, int ithread);
   int check3bodyDecays(const V0Index& v0Idx, const V0& v0, float rv0, std::array<float, 3> pV0, float p2V0, int avoidTrackID, int posneg, VBracket v0vlist, int ithread);
   void setupThreads();
@@ -185,6 +186,11 @@ class SVertexer
   std::vector<std::vector<Decay3BodyIndex>> m3bodyIdxTmp;
   std::array<std::vector<TrackCand>, 2> mTracksPool{}; // pools of positive and negative seeds sorted in min VtxID
   std::array<std::vector<int>, 2> mVtxFirstTrack{};    // 1st pos. and neg. track of the pools for each vertex
+  std::array<std::vector<o2::track::TrackAuxPar>, 2> mTracksAux{}; // aux. (circle) parameters of the pool tracks for the V0 fitter
+  struct PoolCircles { // circles of the negative pool tracks in SoA layout, for the V0 partners preselection
+    std::vector<float> xC, yC, rC;
+  } mNegCircles;
+  std::vector<std::vector<int>> mV0PartnersTmp; // per thread, V0 partners of the current positive seed
 
   o2::dataformats::VertexBase mMeanVertex{{0., 0., 0.}, {0.1 * 0.1, 0., 0.1 * 0.1, 0., 0., 6. * 6.}};
   const SVertexerParams* mSVParams = nullptr;
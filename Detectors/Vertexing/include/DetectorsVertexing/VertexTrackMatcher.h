@@ -50,6 +50,10 @@ class VertexTrackMatcher
     TBracket tBracket{}; ///< bracketing time in \mus
     int origID = -1;     ///< vertex origin id
   };
+  struct ChunkMatches {
+    std::vector<int> vtxIDs;  ///< IDs of the vertices matching to the tracks of the chunk, in increasing vertex tmin
+    std::vector<int> vtxRefs; ///< for each track of the chunk the end of its entries in vtxIDs
+  };
 
   void process(const o2::globaltracking::RecoContainer& recoData,
                std::vector<VTIndex>& trackIndex, // Global ID's for associated tracks
@@ -61,14 +65,18 @@ class VertexTrackMatcher
   void setTPCTDriftOffset(float t) { mTPCTDriftOffset = t; }
   void setTPCBin2MUS(float v) { mTPCBin2MUS = v; }
   void setPrescaleLogs(int n) { mPrescaleLogs = n; }
+  void setNThreads(int n);
 
   float getITSROFrameLengthMUS() const { return mITSROFrameLengthMUS; }
   float getMFTROFrameLengthMUS() const { return mMFTROFrameLengthMUS; }
   float getMaxTPCDriftTimeMUS() const { return mMaxTPCDriftTimeMUS; }
   float getTPCBin2MUS() const { return mTPCBin2MUS; }
+  int getNThreads() const { return mNThreads; }
 
  private:
   void extractTracks(const o2::globaltracking::RecoContainer& data, const std::unordered_map<GIndex, bool>& vcont);
+  void matchChunk(const std::vector<VtxTBracket>& vtxOrdBrack, float maxVtxSpan, size_t first, size_t last, ChunkMatches& matches) const;
+  static constexpr size_t MinTracksPerChunk = 1000; ///< don't split the association in chunks smaller than this
   std::vector<TrackTBracket> mTBrackets;
   float mITSROFrameLengthMUS = 0;       ///< ITS RO frame in mus
   float mMFTROFrameLengthMUS = 0;       ///< MFT RO frame in mus
@@ -76,6 +84,7 @@ class VertexTrackMatcher
   float mTPCTDriftOffset = 0.f;
   float mTPCBin2MUS = 0;
   int mPrescaleLogs = 0;
+  int mNThreads = 1;
 };
 
 } // namespace vertexing
@@ -22,6 +22,10 @@
 #include "CommonUtils/StringUtils.h"
 #include <TH2F.h>
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 using namespace o2::vertexing;
 using DetID = o2::detectors::DetID;
 constexpr float PVertexer::kAlmost0F;
@@ -63,17 +67,19 @@ int PVertexer::runVertexing(const gsl::span<o2d::GlobalTrackID> gids, const gsl:
   std::vector<float> validationTimes;
   std::vector<o2::MCEventLabel> lblVtxLoc;
   mTimeVertexing.Start();
-  int cntTZ = 0;
-  for (auto tc : mTimeZClusters) {
-    size_t nnold = verticesLoc.size();
-    VertexingInput inp;
-    inp.idRange = gsl::span<int>(tc.trackIDs);
-    inp.scaleSigma2 = mPVParams->iniScale2;
-    inp.timeEst = tc.timeEst;
+  if (mNThreads > 1 && mTimeZClusters.size() > 1) {
+    findVerticesParallel(verticesLoc, trackIDs, v2tRefsLoc);
+  } else {
+    for (auto tc : mTimeZClusters) {
+      VertexingInput inp;
+      inp.idRange = gsl::span<int>(tc.trackIDs);
+      inp.scaleSigma2 = mPVParams->iniScale2;
+      inp.timeEst = tc.timeEst;
 #ifdef _PV_DEBUG_TREE_
-    doDBScanDump(inp, lblTracks);
+      doDBScanDump(inp, lblTracks);
 #endif
-    findVertices(inp, verticesLoc, trackIDs, v2tRefsLoc);
+      findVertices(inp, verticesLoc, trackIDs, v2tRefsLoc);
+    }
   }
   mTimeVertexing.Stop();
   // sort in time
@@ -223,23 +229,71 @@ int PVertexer::findVertices(const VertexingInput& input, std::vector<PVertex>& v
     auto clTime = tCurr - tStart;
     if (clTime > mPVParams->maxTimeMSPerCluster) {
       LOGP(warn, "Time per TZ-cluster ({}ms) of {} tracks exceeded limit after {} trials, abandon", clTime, mult, nTrials);
+#ifdef WITH_OPENMP
+#pragma omp critical(pvertexer_stat)
+#endif
       if (!mPoolDumpProduced) {
         dumpPool();
       }
       break;
     }
   }
-  mTotTrials += nTrials;
-  if (size_t(nTrials) > mMaxTrialPerCluster) {
-    mMaxTrialPerCluster = nTrials;
-  }
-  if (tCurr - tStart > mLongestClusterTimeMS) {
-    mLongestClusterTimeMS = tCurr - tStart;
-    mLongestClusterMult = mult;
+  // the clusters may be processed in parallel
+#ifdef WITH_OPENMP
+#pragma omp critical(pvertexer_stat)
+#endif
+  {
+    mTotTrials += nTrials;
+    if (size_t(nTrials) > mMaxTrialPerCluster) {
+      mMaxTrialPerCluster = nTrials;
+    }
+    if (tCurr - tStart > mLongestClusterTimeMS) {
+      mLongestClusterTimeMS = tCurr - tStart;
+      mLongestClusterMult = mult;
+    }
   }
   return nfound;
 }
 
+//______________________________________________
+void PVertexer::findVerticesParallel(std::vector<PVertex>& vertices, std::vector<uint32_t>& trackIDs, std::vector<V2TRef>& v2tRefs)
+{
+  // The time-Z clusters share no tracks and have their own seeding histograms, so they are processed
+  // independently, each into its own output. These outputs are merged in the order of the clusters,
+  // giving the same result as the sequential processing.
+  struct ClusterVertices {
+    std::vector<PVertex> vertices;
+    std::vector<uint32_t> trackIDs;
+    std::vector<V2TRef> v2tRefs;
+  };
+  const int nClusters = mTimeZClusters.size();
+  std::vector<ClusterVertices> clusVertices(nClusters);
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+  for (int icl = 0; icl < nClusters; icl++) {
+    auto& tc = mTimeZClusters[icl];
+    VertexingInput inp;
+    inp.idRange = gsl::span<int>(tc.trackIDs);
+    inp.scaleSigma2 = mPVParams->iniScale2;
+    inp.timeEst = tc.timeEst;
+    auto& out = clusVertices[icl];
+    findVertices(inp, out.vertices, out.trackIDs, out.v2tRefs);
+  }
+
+  for (auto& out : clusVertices) {
+    const int vtxOffset = vertices.size(), trOffset = trackIDs.size();
+    for (size_t iv = 0; iv < out.vertices.size(); iv++) {
+      vertices.push_back(out.vertices[iv]);
+      v2tRefs.emplace_back(out.v2tRefs[iv].getFirstEntry() + trOffset, out.v2tRefs[iv].getEntries());
+    }
+    for (auto tid : out.trackIDs) {
+      trackIDs.push_back(tid);
+      mTracksPool[tid].vtxID += vtxOffset; // the vertex IDs were assigned wrt the cluster output
+    }
+  }
+}
+
 //______________________________________________
 bool PVertexer::findVertex(const VertexingInput& input, PVertex& vtx)
 {
@@ -1379,6 +1433,16 @@ int PVertexer::processFromExternalPool(const std::vector<TrackVF>& pool, std::ve
   return runVertexing(gids, intCand, vertices, vertexTrackIDs, v2tRefs, lblTracks, lblVtx);
 }
 
+//______________________________________________
+void PVertexer::setNThreads(int n)
+{
+#if defined(WITH_OPENMP) && !defined(_PV_DEBUG_TREE_)
+  mNThreads = n > 0 ? n : 1;
+#else
+  mNThreads = 1;
+#endif
+}
+
 //______________________________________________
 void PVertexer::setTrackSources(GTrackID::mask_t s)
 {
@@ -23,6 +23,7 @@
 #include "Framework/DataProcessorSpec.h"
 #include "ReconstructionDataFormats/StrangeTrack.h"
 #include "CommonConstants/GeomConstants.h"
+#include "CommonConstants/MathConstants.h"
 #include "DataFormatsITSMFT/TrkClusRef.h"
 
 #ifdef WITH_OPENMP
@@ -30,6 +31,7 @@
 #endif
 
 #include "ReconstructionDataFormats/GlobalTrackID.h"
+#include <limits>
 
 using namespace o2::vertexing;
 namespace o2f = o2::framework;
@@ -46,7 +48,7 @@ void SVertexer::process(const o2::globaltracking::RecoContainer& recoData, o2::f
   updateTimeDependentParams(); // TODO RS: strictly speaking, one should do this only in case of the CCDB objects update
   mPVertices = recoData.getPrimaryVertices();
   buildT2V(recoData); // build track->vertex refs from vertex->track (if other workflow will need this, consider producing a message in the VertexTrackMatcher)
-  int ntrP = mTracksPool[POS].size(), ntrN = mTracksPool[NEG].size();
+  int ntrP = mTracksPool[POS].size();
   if (mStrTracker) {
     mStrTracker->loadData(recoData);
     mStrTracker->prepareITStracks();
@@ -62,20 +64,18 @@ void SVertexer::process(const o2::globaltracking::RecoContainer& recoData, o2::f
       LOG(debug) << "No partner is found for pos.track " << itp << " out of " << ntrP;
       continue;
     }
-    for (int itn = firstN; itn < ntrN; itn++) { // start from the 1st negative track of lowest-ID vertex of positive
+#ifdef WITH_OPENMP
+    int iThread = omp_get_thread_num();
+#else
+    int iThread = 0;
+#endif
+    auto& partners = mV0PartnersTmp[iThread];
+    selectV0Partners(seedP, itp, firstN, partners);
+    for (int itn : partners) {
       auto& seedN = mTracksPool[NEG][itn];
-      if (seedN.vBracket > seedP.vBracket) { // all vertices compatible with seedN are in future wrt that of seedP
-        LOG(debug) << "Brackets do not match";
-        break;
-      }
       if (mSVParams->maxPVContributors < 2 && seedP.gid.isPVContributor() + seedN.gid.isPVContributor() > mSVParams->maxPVContributors) {
         continue;
       }
-#ifdef WITH_OPENMP
-      int iThread = omp_get_thread_num();
-#else
-      int iThread = 0;
-#endif
       checkV0(seedP, seedN, itp, itn, iThread);
     }
   }
@@ -337,6 +337,7 @@ void SVertexer::setupThreads()
   mCascadesTmp.resize(mNThreads);
   m3bodyTmp.resize(mNThreads);
   mV0sIdxTmp.resize(mNThreads);
+  mV0PartnersTmp.resize(mNThreads);
   mCascadesIdxTmp.resize(mNThreads);
   m3bodyIdxTmp.resize(mNThreads);
   mFitterV0.resize(mNThreads);
@@ -567,9 +568,58 @@ void SVertexer::buildT2V(const o2::globaltracking::RecoContainer& recoData) // a
     }
   }
 
+  // the aux. parameters are needed for every pair the track enters, calculate them once
+  for (int pn = 0; pn < 2; pn++) {
+    const auto& tracksPool = mTracksPool[pn];
+    auto& tracksAux = mTracksAux[pn];
+    tracksAux.resize(tracksPool.size());
+    for (unsigned i = 0; i < tracksPool.size(); i++) {
+      tracksAux[i].set(tracksPool[i], mBz);
+    }
+  }
+  // circles of the negative tracks for the V0 partners preselection, straight lines are never rejected
+  const auto& auxN = mTracksAux[NEG];
+  mNegCircles.xC.resize(auxN.size());
+  mNegCircles.yC.resize(auxN.size());
+  mNegCircles.rC.resize(auxN.size());
+  for (unsigned i = 0; i < auxN.size(); i++) {
+    mNegCircles.xC[i] = auxN[i].xC;
+    mNegCircles.yC[i] = auxN[i].yC;
+    mNegCircles.rC[i] = auxN[i].rC > o2::constants::math::Almost0 ? auxN[i].rC : std::numeric_limits<float>::infinity();
+  }
+
   LOG(info) << "Collected " << mTracksPool[POS].size() << " positive and " << mTracksPool[NEG].size() << " negative seeds";
 }
 
+//__________________________________________________________________
+void SVertexer::selectV0Partners(const TrackCand& seedP, int iP, int firstN, std::vector<int>& partners) const
+{
+  // select negative tracks which may form a V0 with the positive seed: the vertex brackets must overlap and the circles must
+  // not be too far from each other in XY. The latter selection is looser than the exact one done by DCAFitterN::isFarInXY
+  partners.clear();
+  const auto& poolN = mTracksPool[NEG];
+  // starting from the 1st negative track of lowest-ID vertex of positive, the pool is sorted in min vertex ID:
+  // stop at the 1st track with all compatible vertices in future wrt those of seedP
+  int lastN = std::partition_point(poolN.begin() + firstN, poolN.end(), [&seedP](const TrackCand& t) { return !(t.vBracket > seedP.vBracket); }) - poolN.begin();
+  const auto& auxP = mTracksAux[POS][iP];
+  if (auxP.rC < o2::constants::math::Almost0) { // straight line
+    for (int itn = firstN; itn < lastN; itn++) {
+      partners.push_back(itn);
+    }
+    return;
+  }
+  constexpr float Margin = 1.0001f; // to be safe against the rounding differences wrt the exact check
+  float maxDXY = mSVParams->mTPCTrackPhotonTune ? std::max(mSVParams->maxDXYIni, mSVParams->mTPCTrackMaxDXYIni) : mSVParams->maxDXYIni;
+  float xP = auxP.xC, yP = auxP.yC, rPD = auxP.rC + maxDXY;
+  const float *xN = mNegCircles.xC.data(), *yN = mNegCircles.yC.data(), *rN = mNegCircles.rC.data();
+  for (int itn = firstN; itn < lastN; itn++) {
+    float dx = xN[itn] - xP, dy = yN[itn] - yP, lim = (rN[itn] + rPD) * Margin;
+    if (dx * dx + dy * dy <= lim * lim) {
+      partners.push_back(itn);
+    }
+  }
+}
+
 //__________________________________________________________________
 bool SVertexer::checkV0(const TrackCand& seedP, const TrackCand& seedN, int iP, int iN, int ithread)
 {
@@ -613,8 +663,10 @@ bool SVertexer::checkV0(const TrackCand& seedP, const TrackCand& seedN, int iP,
     fitterV0.setCollinear(true);
   }
 
-  // feed DCAFitter
-  int nCand = fitterV0.process(seedP, seedN);
+  // feed DCAFitter, unless the tracks circles are too far from each other to cross
+  const auto& auxP = mTracksAux[POS][iP];
+  const auto& auxN = mTracksAux[NEG][iN];
+  int nCand = fitterV0.isFarInXY(auxP, auxN) ? 0 : fitterV0.processWithAux({&auxP, &auxN}, seedP, seedN);
   if (mSVParams->mTPCTrackPhotonTune && isTPConly) {
     // Reset immediately to the defaults
     fitterV0.setMaxDZIni(mSVParams->maxDZIni);
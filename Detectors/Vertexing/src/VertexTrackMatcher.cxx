@@ -16,8 +16,14 @@
 #include "DataFormatsGlobalTracking/RecoContainerCreateTracksVariadic.h"
 #include "DetectorsVertexing/VertexTrackMatcher.h"
 #include "ITSMFTBase/DPLAlpideParam.h"
+#include "ReconstructionDataFormats/GlobalTrackIDPartition.h"
 #include <unordered_map>
 #include <numeric>
+#include <algorithm>
+
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
 
 using namespace o2::vertexing;
 
@@ -61,39 +67,40 @@ void VertexTrackMatcher::process(const o2::globaltracking::RecoContainer& recoDa
 
   extractTracks(recoData, vcont); // extract all track t-brackets, excluding those tracks which contribute to vertex (already attached)
 
-  int ivStart = 0, nAssigned = 0, nAmbiguous = 0;
-  std::vector<int> vtxList; // list of vertices which match to checked track
-  for (const auto& tro : mTBrackets) {
-    vtxList.clear();
-    for (int iv = ivStart; iv < nv; iv++) {
-      const auto& vto = vtxOrdBrack[iv];
-      auto res = tro.tBracket.isOutside(vto.tBracket);
-      if (res == TBracket::Below) {                                       // vertex preceeds the track
-        if (tro.tBracket.getMin() > vto.tBracket.getMin() + maxVtxSpan) { // all following vertices will be preceeding all following tracks times
-          ivStart = iv + 1;
+  // the time-ordered tracks are split in contiguous chunks matched independently, the results are merged in the chunk order,
+  // so that the output does not depend on the number of threads
+  size_t nTracks = mTBrackets.size();
+  int nChunks = std::max(1, int(std::min(size_t(mNThreads), nTracks / MinTracksPerChunk)));
+  std::vector<ChunkMatches> chunkMatches(nChunks);
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(static) num_threads(nChunks)
+#endif
+  for (int ich = 0; ich < nChunks; ich++) {
+    matchChunk(vtxOrdBrack, maxVtxSpan, nTracks * ich / nChunks, nTracks * (ich + 1) / nChunks, chunkMatches[ich]);
+  }
+
+  int nAssigned = 0, nAmbiguous = 0;
+  size_t itr = 0;
+  for (const auto& matches : chunkMatches) {
+    int vStart = 0;
+    for (auto vEnd : matches.vtxRefs) {
+      const auto& tro = mTBrackets[itr++];
+      if (vEnd > vStart) {
+        nAssigned++;
+        bool ambig = vEnd - vStart > 1;
+        for (int i = vStart; i < vEnd; i++) {
+          auto& ref = tmpMap[matches.vtxIDs[i]].emplace_back(tro.origID);
+          if (ambig) {
+            ref.setAmbiguous();
+          }
         }
-        continue; // following vertex with longer span might still match this track
-      }
-      if (res == TBracket::Above) { // track preceeds the vertex, so will preceed also all following vertices
-        break;
-      }
-      // track matches to vertex, register
-      vtxList.push_back(vto.origID); // flag matching vertex
-    }
-    if (vtxList.size()) {
-      nAssigned++;
-      bool ambig = vtxList.size() > 1;
-      for (auto v : vtxList) {
-        auto& ref = tmpMap[v].emplace_back(tro.origID);
-        if (ambig) {
-          ref.setAmbiguous();
+        if (ambig) { // did track match to multiple vertices?
+          nAmbiguous++;
         }
+      } else {
+        orphans.emplace_back(tro.origID); // register unassigned track
       }
-      if (ambig) { // did track match to multiple vertices?
-        nAmbiguous++;
-      }
-    } else {
-      orphans.emplace_back(tro.origID); // register unassigned track
+      vStart = vEnd;
     }
   }
 
@@ -102,25 +109,19 @@ void VertexTrackMatcher::process(const o2::globaltracking::RecoContainer& recoDa
   vtxRefs.clear();
   static size_t logCounter = 0;
   bool logVertices = mPrescaleLogs > 0 ? (logCounter % mPrescaleLogs) == 0 : true;
+  o2::dataformats::GlobalTrackIDPartition partition;
   for (int iv = 0; iv < nv1; iv++) {
     auto& trvec = tmpMap[iv];
-    // sort entries in each vertex track indices list according to the source
-    std::sort(trvec.begin(), trvec.end(), [](VTIndex a, VTIndex b) { return a.getSource() < b.getSource(); });
+    // group entries in each vertex track indices list according to the source
+    partition.partition(trvec);
 
-    auto entry0 = trackIndex.size(); // start of entries for this vertex
     auto& vr = vtxRefs.emplace_back();
     vr.setVtxID(iv < nv ? iv : -1); // flag table for unassigned tracks by VtxID = -1
-    int oldSrc = -1;
-    for (const auto gid0 : trvec) {
-      int src = gid0.getSource();
-      while (oldSrc < src) {
-        oldSrc++;
-        vr.setFirstEntryOfSource(oldSrc, trackIndex.size()); // register start of new source
+    for (int src = 0; src < GIndex::NSources; src++) {
+      vr.setFirstEntryOfSource(src, trackIndex.size()); // register start of new source
+      for (auto pos : partition.getPositions(src)) {
+        trackIndex.push_back(trvec[pos]);
       }
-      trackIndex.push_back(gid0);
-    }
-    while (++oldSrc < GIndex::NSources) {
-      vr.setFirstEntryOfSource(oldSrc, trackIndex.size());
     }
     vr.setEnd(trackIndex.size());
     if (logVertices) {
@@ -131,6 +132,61 @@ void VertexTrackMatcher::process(const o2::globaltracking::RecoContainer& recoDa
   LOG(info) << "Assigned " << nAssigned << " (" << nAmbiguous << " ambiguously) out of " << mTBrackets.size() << " non-contributor tracks + " << vcont.size() << " contributors";
 }
 
+//________________________________________________________
+void VertexTrackMatcher::matchChunk(const std::vector<VtxTBracket>& vtxOrdBrack, float maxVtxSpan, size_t first, size_t last, ChunkMatches& matches) const
+{
+  // Match the tracks [first : last) to the vertices sorted in tmin by a sweep in time: the vertices are activated once the track bracket
+  // reaches their start and dropped as soon as they end before the start of the track bracket, hence before that of all following tracks.
+  // Each track checks only the active vertices, i.e. the cost is driven by the number of matches rather than by the number of vertices.
+  matches.vtxIDs.clear();
+  matches.vtxRefs.clear();
+  if (first >= last) {
+    return;
+  }
+  matches.vtxRefs.reserve(last - first);
+  int nv = vtxOrdBrack.size();
+  // vertices starting earlier than maxVtxSpan before the 1st track of the chunk end before it
+  float tStart = mTBrackets[first].tBracket.getMin() - maxVtxSpan;
+  int ivNext = std::lower_bound(vtxOrdBrack.begin(), vtxOrdBrack.end(), tStart, [](const VtxTBracket& v, float t) { return v.tBracket.getMin() < t; }) - vtxOrdBrack.begin();
+  std::vector<int> next(nv, -1); // singly linked list of the active vertices, in increasing tmin
+  int head = -1, tail = -1;
+  for (size_t itr = first; itr < last; itr++) {
+    const auto& tro = mTBrackets[itr];
+    while (ivNext < nv && vtxOrdBrack[ivNext].tBracket.getMin() <= tro.tBracket.getMax()) { // activate vertices starting before the track end
+      (tail < 0 ? head : next[tail]) = ivNext;
+      tail = ivNext++;
+    }
+    for (int iv = head, prev = -1; iv >= 0;) {
+      const auto& vto = vtxOrdBrack[iv];
+      int ivn = next[iv];
+      auto res = tro.tBracket.isOutside(vto.tBracket);
+      if (res == TBracket::Below) { // vertex preceeds the track, hence all following tracks: drop it
+        (prev < 0 ? head : next[prev]) = ivn;
+        if (iv == tail) {
+          tail = prev;
+        }
+      } else if (res == TBracket::Above) { // track preceeds the vertex, so will preceed also all following vertices
+        break;
+      } else { // track matches to vertex, register
+        matches.vtxIDs.push_back(vto.origID);
+        prev = iv;
+      }
+      iv = ivn;
+    }
+    matches.vtxRefs.push_back(matches.vtxIDs.size());
+  }
+}
+
+//________________________________________________________
+void VertexTrackMatcher::setNThreads(int n)
+{
+#ifdef WITH_OPENMP
+  mNThreads = n > 0 ? n : 1;
+#else
+  mNThreads = 1;
+#endif
+}
+
 //________________________________________________________
 void VertexTrackMatcher::extractTracks(const o2::globaltracking::RecoContainer& data, const std::unordered_map<GIndex, bool>& vcont)
 {
@@ -37,7 +37,8 @@ class NeuralFastSimulation
   NeuralFastSimulation(const std::string& modelPath,
                        OrtAllocatorType allocatorType,
                        OrtMemType memoryType,
-                       int64_t batchSize);
+                       int64_t batchSize,
+                       int nThreads = 1);
   virtual ~NeuralFastSimulation() = default;
 
   /**
@@ -65,10 +66,15 @@ class NeuralFastSimulation
 
   [[nodiscard]] size_t getBatchSize() const;
 
+  /// true if the model has a dynamic batch axis, i.e. accepts inputs for several particles in one run.
+  /// The batch size of a run is then given by the size of the inputs passed to setInput
+  [[nodiscard]] bool hasDynamicBatch() const;
+
  protected:
   /// Sets models metadata (input/output layers names, inputs shape) in onnx session
   void setInputOutputData();
-  /// Converts flattend input data to Ort::Value. Tensor shapes are taken from loaded model metadata.
+  /// Converts flattend input data to Ort::Value. Tensor shapes are taken from loaded model metadata,
+  /// the dynamic axis is sized to the input.
   void setTensors(std::vector<std::vector<float>>& input);
 
   /// model path (where to find the ONNX model)
@@ -85,9 +91,13 @@ class NeuralFastSimulation
   std::vector<std::string> mInputNames;
   std::vector<std::string> mOutputNames;
   std::vector<std::vector<int64_t>> mInputShapes;
+  /// Dynamic axis of each input, -1 if none
+  std::vector<int> mDynamicAxes;
   /// If model has dynamic axis (for batch processing) this will tell ONNX expected size of those axis
   /// otherwise mBatchSize has no effect during runtime
   int64_t mBatchSize;
+  /// Number of threads used by ONNX to run the model
+  int mNThreads;
 
   /// Container for input tensors
   std::vector<Ort::Value> mInputTensors;
@@ -100,7 +110,7 @@ class NeuralFastSimulation
 class ConditionalModelSimulation : public NeuralFastSimulation
 {
  public:
-  ConditionalModelSimulation(const std::string& modelPath, int64_t batchSize);
+  ConditionalModelSimulation(const std::string& modelPath, int64_t batchSize, int nThreads = 1);
   ~ConditionalModelSimulation() override = default;
 
   /**
@@ -18,6 +18,7 @@
 
 #include "Utils.h"
 
+#include <algorithm>
 #include <fstream>
 
 using namespace o2::zdc::fastsim;
@@ -27,7 +28,8 @@ using namespace o2::zdc::fastsim;
 NeuralFastSimulation::NeuralFastSimulation(const std::string& modelPath,
                                            OrtAllocatorType allocatorType,
                                            OrtMemType memoryType,
-                                           int64_t batchSize) : mModelPath(modelPath), mSession(nullptr), mMemoryInfo(Ort::MemoryInfo::CreateCpu(allocatorType, memoryType)), mBatchSize(batchSize)
+                                           int64_t batchSize,
+                                           int nThreads) : mModelPath(modelPath), mSession(nullptr), mMemoryInfo(Ort::MemoryInfo::CreateCpu(allocatorType, memoryType)), mBatchSize(batchSize), mNThreads(nThreads)
 {
 }
 
@@ -35,7 +37,7 @@ void NeuralFastSimulation::initRunSession()
 {
   // create the session object
   Ort::SessionOptions options;
-  options.SetIntraOpNumThreads(1); // one thread since we might have multiple workers in parallel anyway
+  options.SetIntraOpNumThreads(mNThreads); // one thread by default since we might have multiple workers in parallel anyway
   mSession = new Ort::Session(mEnv, mModelPath.c_str(), options);
   setInputOutputData();
 }
@@ -45,6 +47,11 @@ size_t NeuralFastSimulation::getBatchSize() const
   return mBatchSize;
 }
 
+bool NeuralFastSimulation::hasDynamicBatch() const
+{
+  return std::all_of(mDynamicAxes.begin(), mDynamicAxes.end(), [](int axis) { return axis >= 0; });
+}
+
 void NeuralFastSimulation::setInputOutputData()
 {
   for (size_t i = 0; i < mSession->GetInputCount(); ++i) {
@@ -61,9 +68,11 @@ void NeuralFastSimulation::setInputOutputData()
   // Which is no problem in python implementation of ONNX where -1 means that
   // shape has to be figured out by library. In C++ this is illegal
   for (auto& shape : mInputShapes) {
-    for (auto& elem : shape) {
-      if (elem < 0) {
-        elem = mBatchSize;
+    mDynamicAxes.push_back(-1);
+    for (size_t axis = 0; axis < shape.size(); ++axis) {
+      if (shape[axis] < 0) {
+        shape[axis] = mBatchSize;
+        mDynamicAxes.back() = axis;
       }
     }
   }
@@ -72,13 +81,22 @@ void NeuralFastSimulation::setInputOutputData()
 void NeuralFastSimulation::setTensors(std::vector<std::vector<float>>& input)
 {
   for (size_t i = 0; i < mInputShapes.size(); ++i) {
+    auto shape = mInputShapes[i];
+    if (mDynamicAxes[i] >= 0) {
+      // the dynamic axis (batch) takes what is left of the input after the fixed axes
+      int64_t fixedSize = 1;
+      for (size_t axis = 0; axis < shape.size(); ++axis) {
+        fixedSize *= (int(axis) == mDynamicAxes[i]) ? 1 : shape[axis];
+      }
+      shape[mDynamicAxes[i]] = input[i].size() / fixedSize;
+    }
     mInputTensors.emplace_back(Ort::Value::CreateTensor<float>(
-      mMemoryInfo, input[i].data(), input[i].size(), mInputShapes[i].data(), mInputShapes[i].size()));
+      mMemoryInfo, input[i].data(), input[i].size(), shape.data(), shape.size()));
   }
 }
 
 //---------------------------------------------------------Conditional-------------------------------------------------------
-ConditionalModelSimulation::ConditionalModelSimulation(const std::string& modelPath, const int64_t batchSize) : NeuralFastSimulation(modelPath, OrtDeviceAllocator, OrtMemTypeCPU, batchSize)
+ConditionalModelSimulation::ConditionalModelSimulation(const std::string& modelPath, const int64_t batchSize, const int nThreads) : NeuralFastSimulation(modelPath, OrtDeviceAllocator, OrtMemTypeCPU, batchSize, nThreads)
 {
   initRunSession();
 }
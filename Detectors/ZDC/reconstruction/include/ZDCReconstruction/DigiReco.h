@@ -169,8 +169,20 @@ class DigiReco
   int correctTDCSignal(int itdc, int16_t TDCVal, float TDCAmp, float& fTDCVal, float& fTDCAmp, bool isbeg, bool isend); /// Correct TDC single signal
   int correctTDCBackground(int ibc, int itdc, std::deque<DigiRecoTDC>& tdc);                                            /// TDC amplitude and time corrections due to pile-up from previous bunches
 
+  void prepareSamples(int isig, int ibeg, int iend);                 /// Contiguous padded samples for interpolation
   O2_ZDC_DIGIRECO_FLT getPoint(int itdc, int ibeg, int iend, int i); /// Interpolation for current TDC
-  void setPoint(int itdc, int ibeg, int iend, int i);                /// Interpolation for current TDC
+  void setPoints(int isig, int ibeg, int iend);                      /// Full interpolation for current signal
+  /// Interpolated value at position im (1..TSN-1) after sample samples[TSL-1]
+  /// N.B. samples[0] is the first of the 2*TSL samples entering the interpolation
+  O2_ZDC_DIGIRECO_FLT interpolatePoint(const O2_ZDC_DIGIRECO_FLT* samples, int im) const
+  {
+    O2_ZDC_DIGIRECO_FLT y = 0;
+    const O2_ZDC_DIGIRECO_FLT* ts = &mTS[TSN - im];
+    for (int is = 0; is < 2 * TSL; is++) {
+      y += samples[is] * ts[is * TSN];
+    }
+    return y / mTSNorm[im];
+  }
 
   void assignTDC(int ibun, int ibeg, int iend, int itdc, int tdc, float amp); /// Set reconstructed TDC values
   void findSignals(int ibeg, int iend);                                       /// Find signals around main-main that satisfy condition on TDC
@@ -189,6 +201,8 @@ class DigiReco
   const RecoConfigZDC* mRecoConfigZDC = nullptr; /// CCDB configuration parameters
   int32_t mVerbosity = DbgMinimal;
   O2_ZDC_DIGIRECO_FLT mTS[NTS];                     /// Tapered sinc function
+  O2_ZDC_DIGIRECO_FLT mTSNorm[TSN];                 /// Normalization of tapered sinc function for each interpolated position
+  std::vector<O2_ZDC_DIGIRECO_FLT> mSamples;        /// Padded samples of current signal
   bool mTreeDbg = false;                            /// Write reconstructed data in debug output file
   std::unique_ptr<TFile> mDbg = nullptr;            /// Debug output file
   std::unique_ptr<TTree> mTDbg = nullptr;           /// Debug tree
@@ -480,6 +480,16 @@ void DigiReco::prepareInterpolation()
     mTS[n + tsi] = fs * fg;
     mTS[n - tsi] = mTS[n + tsi]; // Function is even
   }
+  // Normalization of the interpolation kernel for each position between two acquired samples
+  // N.B. the sum is performed in the same order of the interpolation loop
+  mTSNorm[0] = 1;
+  for (int im = 1; im < TSN; im++) {
+    O2_ZDC_DIGIRECO_FLT sum = 0;
+    for (int is = TSN - im; is < NTS; is += TSN) {
+      sum += mTS[is];
+    }
+    mTSNorm[im] = sum;
+  }
   LOG(info) << "Interpolation numeric precision is " << sizeof(O2_ZDC_DIGIRECO_FLT);
   LOG(info) << "Interpolation alpha = " << mAlpha;
 }
@@ -1368,10 +1378,31 @@ int DigiReco::processTriggerExtended(int itdc, int ibeg, int iend)
   return interpolate(itdc, ibeg, iend);
 } // processTriggerExtended
 
+void DigiReco::prepareSamples(int isig, int ibeg, int iend)
+{
+  // Copy the filtered samples of consecutive bunches from ibeg to iend in a contiguous
+  // array, padded with TSL copies of the first and of the last sample on each side.
+  // This makes the constant extrapolation at the edges implicit and the interpolation
+  // a plain dot product with the tapered sinc function
+  mSamples.resize(mNsam + 2 * TSL);
+  auto* samples = mSamples.data();
+  for (int is = 0; is < TSL; is++) {
+    samples[is] = mFirstSample;
+    samples[TSL + mNsam + is] = mLastSample;
+  }
+  samples += TSL;
+  for (int ibun = ibeg; ibun <= iend; ibun++) {
+    const auto& data = mReco[ibun].data[isig];
+    for (int ip = 0; ip < NTimeBinsPerBC; ip++) {
+      samples[ip] = data[ip];
+    }
+    samples += NTimeBinsPerBC;
+  }
+}
+
 // Interpolation for single point
 O2_ZDC_DIGIRECO_FLT DigiReco::getPoint(int isig, int ibeg, int iend, int i)
 {
-  constexpr int nsbun = TSN * NTimeBinsPerBC; // Total number of interpolated points per bunch crossing
   if (i >= mNtot || i < 0) {
     LOG(error) << "Error addressing isig=" << isig << " i=" << i << " mNtot=" << mNtot;
     mInError = true;
@@ -1385,79 +1416,56 @@ O2_ZDC_DIGIRECO_FLT DigiReco::getPoint(int isig, int ibeg, int iend, int i)
     // Return value of last sample
     return mLastSample;
   } else {
-    // Identification of the point to be assigned
-    int ibun = ibeg + i / nsbun;
     // Interpolation between acquired points (N.B. from 0 to mNint)
     i = i - TSNH;
     int im = i % TSN;
+    int ip = i / TSN;
     if (im == 0) {
       // This is an acquired point
-      int ip = (i / TSN) % NTimeBinsPerBC;
-      int ib = ibeg + (i / TSN) / NTimeBinsPerBC;
-      if (ib != ibun) {
-        LOG(error) << "ib=" << ib << " ibun=" << ibun;
-        mInError = true;
-        return std::numeric_limits<float>::infinity();
-      }
-      return mReco[ibun].data[isig][ip]; // Filtered point
-      // return mChData[mReco[ibun].ref[isig]].data[ip]; // Original point
+      return mSamples[TSL + ip]; // Filtered point
     } else {
       // Do the actual interpolation
-      O2_ZDC_DIGIRECO_FLT y = 0;
-      int ip = i / TSN;
-      O2_ZDC_DIGIRECO_FLT sum = 0;
-      for (int is = TSN - im, ii = ip - TSL + 1; is < NTS; is += TSN, ii++) {
-        // Default is first point in the array
-        O2_ZDC_DIGIRECO_FLT yy = mFirstSample;
-        if (ii > 0) {
-          if (ii < mNsam) {
-            int ip = ii % NTimeBinsPerBC;
-            int ib = ibeg + ii / NTimeBinsPerBC;
-            yy = mReco[ib].data[isig][ip];
-            // yy = mChData[mReco[ib].ref[isig]].data[ip];
-          } else {
-            // Last acquired point
-            yy = mLastSample;
-          }
-        }
-        sum += mTS[is];
-        y += yy * mTS[is];
-      }
-      y = y / sum;
-      return y;
+      return interpolatePoint(&mSamples[ip + 1], im);
     }
   }
 }
 
-void DigiReco::setPoint(int isig, int ibeg, int iend, int i)
+void DigiReco::setPoints(int isig, int ibeg, int iend)
 {
+  // Fill the arrays of interpolated points of signal isig in consecutive bunches from ibeg to iend
   // This function needs to be used only if mFullInterpolation is true otherwise the
   // vectors are not allocated
   if (!mFullInterpolation) {
     LOG(fatal) << __func__ << " call with mFullInterpolation = " << mFullInterpolation;
     return;
   }
-  constexpr int nsbun = TSN * NTimeBinsPerBC; // Total number of interpolated points per bunch crossing
-  if (i >= mNtot || i < 0) {
-    LOG(error) << "Error addressing signal isig=" << isig << " i=" << i << " mNtot=" << mNtot;
-    mInError = true;
-    return;
+  // Points are computed in the order of the interpolation region (acquired sample ip,
+  // position im between ip and ip+1) to avoid index arithmetics and branches for each point
+  auto* inter = mReco[ibeg].inter[isig].data();
+  int ibun = ibeg, isam = 0;
+  auto store = [&](O2_ZDC_DIGIRECO_FLT y) {
+    inter[isam] = y;
+    if (++isam == mNSB && ibun < iend) {
+      inter = mReco[++ibun].inter[isig].data();
+      isam = 0;
+    }
+  };
+  // Constant extrapolation at the beginning of the array
+  for (int i = 0; i < TSNH; i++) {
+    store(mFirstSample);
   }
-  // Constant extrapolation at the beginning and at the end of the array
-  if (i < TSNH) {
-    // Assign value of first sample
-    mReco[ibeg].inter[isig][i] = mFirstSample;
-  } else if (i >= mIlast) {
-    // Assign value of last sample
-    int isam = i % nsbun;
-    mReco[iend].inter[isig][isam] = mLastSample;
-  } else {
-    // Identification of the point to be assigned
-    int ibun = ibeg + i / nsbun;
-    int isam = i % nsbun;
-    mReco[ibun].inter[isig][isam] = getPoint(isig, ibeg, iend, i);
+  for (int ip = 0; ip < mNsam - 1; ip++) {
+    const auto* samples = &mSamples[ip + 1];
+    store(samples[TSL - 1]); // Acquired (filtered) point
+    for (int im = 1; im < TSN; im++) {
+      store(interpolatePoint(samples, im));
+    }
   }
-} // setPoint
+  // Constant extrapolation at the end of the array
+  for (int i = mIlast; i < mNtot; i++) {
+    store(mLastSample);
+  }
+} // setPoints
 
 int DigiReco::fullInterpolation(int isig, int ibeg, int iend)
 {
@@ -1494,12 +1502,11 @@ int DigiReco::fullInterpolation(int isig, int ibeg, int iend)
   mLastSample = mReco[iend].data[isig][MaxTimeBin];
 
   // Allocate and fill array of interpolated points
+  prepareSamples(isig, ibeg, iend);
   for (int ibun = ibeg; ibun <= iend; ibun++) {
     mReco[ibun].allocate(isig);
   }
-  for (int i = 0; i < mNtot; i++) {
-    setPoint(isig, ibeg, iend, i);
-  }
+  setPoints(isig, ibeg, iend);
   if (mInError) {
     return __LINE__;
   }
@@ -1547,6 +1554,7 @@ int DigiReco::interpolate(int itdc, int ibeg, int iend)
 
   mFirstSample = mReco[ibeg].data[isig][0];
   mLastSample = mReco[iend].data[isig][MaxTimeBin];
+  prepareSamples(isig, ibeg, iend);
 
   // mFullInterpolation turns on full interpolation for debugging
   // otherwise the interpolation is performed only around actual signal
@@ -1554,9 +1562,7 @@ int DigiReco::interpolate(int itdc, int ibeg, int iend)
     for (int ibun = ibeg; ibun <= iend; ibun++) {
       mReco[ibun].allocate(isig);
     }
-    for (int i = 0; i < mNtot; i++) {
-      setPoint(isig, ibeg, iend, i);
-    }
+    setPoints(isig, ibeg, iend);
   }
   if (mInError) {
     return __LINE__;
@@ -257,8 +257,22 @@ class Detector : public o2::base::DetImpl<Detector>
   using FastSimResults = std::vector<std::array<long, 5>>; //!
   FastSimResults mFastSimResults;                          //!
 
-  // converts FastSim model results to Hit
-  bool FastSimToHits(const Ort::Value& response, const TParticle& particle, int detector);
+  // primaries of the current event for which the fastsim is run, in batches, after the last primary
+  struct FastSimCandidate {
+    TParticle particle;
+    std::vector<float> rawInput;
+  };
+  std::vector<FastSimCandidate> mFastSimCandidates; //!
+  int mFinishedPrimaries = 0;                       //! primaries of the current event done so far
+
+  // runs the fastsim on all candidates of the event, at most ZDCSimParam::ZDCFastSimBatchSize per inference
+  void runFastSim();
+  void runFastSimBatch(size_t first, size_t n);
+  void runFastSimModel(fastsim::NeuralFastSimulation* model, fastsim::processors::StandardScaler* scaler,
+                       std::vector<size_t> const& candidates, int detectorA, int detectorC);
+
+  // converts FastSim model results (image of one particle) to Hit
+  bool FastSimToHits(const float* pixels, const TParticle& particle, int detector);
 
   // determines detector geometry "pixel sizes"
   constexpr std::pair<const int, const int> determineDetectorSize(int detector)
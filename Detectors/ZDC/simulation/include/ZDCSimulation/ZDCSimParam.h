@@ -35,6 +35,8 @@ struct ZDCSimParam : public o2::conf::ConfigurableParamHelper<ZDCSimParam> {
   std::string ZDCFastSimModelScalesNeutron = ""; ///< path to scales file for neutron model
   std::string ZDCFastSimModelPathProton = "";    ///< path to proton model file
   std::string ZDCFastSimModelScalesProton = "";  ///< path to scales file for proton model
+  int ZDCFastSimBatchSize = 0;                   ///< max number of particles per fastsim inference (0: all particles of an event at once)
+  int ZDCFastSimNThreads = 1;                    ///< number of threads used by the fastsim inference
 
   O2ParamDef(ZDCSimParam, "ZDCSimParam");
 };
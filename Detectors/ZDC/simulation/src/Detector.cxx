@@ -27,6 +27,7 @@
 #include "TVirtualMC.h"         // for gMC, TVirtualMC
 #include "TString.h"            // for TString, operator+
 #include <TRandom.h>
+#include <algorithm>
 #include <cassert>
 #include <fstream>
 #include "ZDCSimulation/ZDCSimParam.h"
@@ -91,7 +92,7 @@ Detector::Detector(Bool_t active)
       LOG(error) << "FastSim module disabled.";
     } else {
       mClassifierScaler->setScales(eonScales->first, eonScales->second);
-      mFastSimClassifier = new o2::zdc::fastsim::ConditionalModelSimulation(simparam.ZDCFastSimClassifierPath, 1);
+      mFastSimClassifier = new o2::zdc::fastsim::ConditionalModelSimulation(simparam.ZDCFastSimClassifierPath, 1, simparam.ZDCFastSimNThreads);
 
       if (simparam.useZDCFastSim && !simparam.ZDCFastSimModelPathNeutron.empty() && !simparam.ZDCFastSimModelScalesNeutron.empty()) {
         auto modelScalesNeutron = o2::zdc::fastsim::loadScales(simparam.ZDCFastSimModelScalesNeutron);
@@ -102,7 +103,7 @@ Detector::Detector(Bool_t active)
           LOG(error) << "FastSim module disabled";
         } else {
           mModelScalerNeutron->setScales(modelScalesNeutron->first, modelScalesNeutron->second);
-          mFastSimModelNeutron = new o2::zdc::fastsim::ConditionalModelSimulation(simparam.ZDCFastSimModelPathNeutron, 1);
+          mFastSimModelNeutron = new o2::zdc::fastsim::ConditionalModelSimulation(simparam.ZDCFastSimModelPathNeutron, 1, simparam.ZDCFastSimNThreads);
           LOG(info) << "FastSim neutron module enabled";
         }
       }
@@ -115,7 +116,7 @@ Detector::Detector(Bool_t active)
           LOG(error) << "FastSim module disabled";
         } else {
           mModelScalerProton->setScales(modelScalesProton->first, modelScalesProton->second);
-          mFastSimModelProton = new o2::zdc::fastsim::ConditionalModelSimulation(simparam.ZDCFastSimModelPathProton, 1);
+          mFastSimModelProton = new o2::zdc::fastsim::ConditionalModelSimulation(simparam.ZDCFastSimModelPathProton, 1, simparam.ZDCFastSimNThreads);
           LOG(info) << "FastSim proton module enabled";
         }
       }
@@ -2495,6 +2496,14 @@ void Detector::FinishPrimary()
   flushSpatialResponse();
 
 #ifdef ZDC_FASTSIM_ONNX
+  // the fastsim of the primaries collected in BeginPrimary is run in batches after the last
+  // primary (before the hits are sent), which amortizes the per-inference overhead when many
+  // spectators reach the ZDC
+  if (++mFinishedPrimaries < fMC->GetStack()->GetNprimary()) {
+    return;
+  }
+  runFastSim();
+
   // dump to file only if debugZDCFastSim is set to true
   auto& simparam = o2::zdc::ZDCSimParam::Instance();
   if (simparam.debugZDCFastSim && simparam.useZDCFastSim && mFastSimModelNeutron != nullptr && mFastSimModelProton != nullptr && mFastSimClassifier != nullptr) {
@@ -2538,54 +2547,106 @@ void Detector::BeginPrimary()
                                          static_cast<float>(mCurrentPrincipalParticle.GetMass() * 1000.0),
                                          static_cast<float>(mCurrentPrincipalParticle.GetPDG()->Charge())};
 
-    auto scaledClassParticle = mClassifierScaler->scale(rawInput);
+    mFastSimCandidates.push_back({mCurrentPrincipalParticle, rawInput});
+  }
+#endif
+}
+
+#ifdef ZDC_FASTSIM_ONNX
+//_____________________________________________________________________________
+void Detector::runFastSim()
+{
+  if (mFastSimCandidates.empty()) {
+    return;
+  }
+  auto& simparam = o2::zdc::ZDCSimParam::Instance();
+  size_t batchSize = simparam.ZDCFastSimBatchSize > 0 ? simparam.ZDCFastSimBatchSize : mFastSimCandidates.size();
+  // models exported without dynamic batch axis take one particle per inference
+  for (auto* model : {mFastSimClassifier, mFastSimModelNeutron, mFastSimModelProton}) {
+    if (model && !model->hasDynamicBatch()) {
+      batchSize = 1;
+    }
+  }
+  LOG(debug) << "Running FastSim on " << mFastSimCandidates.size() << " particles in batches of " << batchSize;
+  for (size_t first = 0; first < mFastSimCandidates.size(); first += batchSize) {
+    runFastSimBatch(first, std::min(batchSize, mFastSimCandidates.size() - first));
+  }
+  mFastSimCandidates.clear();
+  resetHitIndices();
+}
+
+//_____________________________________________________________________________
+void Detector::runFastSimBatch(size_t first, size_t n)
+{
+  using std::vector;
+  vector<float> classifierInput;
+  for (size_t i = first; i < first + n; ++i) {
+    auto scaledClassParticle = mClassifierScaler->scale(mFastSimCandidates[i].rawInput);
     if (!scaledClassParticle.has_value()) {
       LOG(error) << "FastSimModule: error occurred on scaling";
-    } else {
-      vector<vector<float>> classifierInput = {std::move(*scaledClassParticle)};
-      mFastSimClassifier->setInput(classifierInput);
-      mFastSimClassifier->run();
-
-      // this classifies if particle will leave a trace at all in one of the calos ---> TODO: better do it separately for ZN + ZP?
-      if (fastsim::processors::readClassifier(mFastSimClassifier->getResult()[0], 1)[0]) {
-        // let's do the neutron (ZN) part
-        if (mModelScalerNeutron && mFastSimModelNeutron) {
-          LOG(info) << "Generating fast hits for ZN";
-          auto scaledModelParticleNeutron = mModelScalerNeutron->scale(rawInput);
-          if (!scaledModelParticleNeutron.has_value()) {
-            LOG(error) << "FastSimModule: error occurred on scaling";
-          } else {
-            vector<vector<float>> modelInputNeutron = {fastsim::normal_distribution(0.0, 1.0, 10), std::move(*scaledModelParticleNeutron)};
-            mFastSimModelNeutron->setInput(modelInputNeutron);
-            mFastSimModelNeutron->run();
-            if (simparam.debugZDCFastSim) {
-              mFastSimResults.push_back(fastsim::processors::calculateChannels(mFastSimModelNeutron->getResult()[0], 1)[0]);
-            }
-            // produce hits from fast sim result
-            bool forward = mCurrentPrincipalParticle.Pz() > 0.;
-            FastSimToHits(mFastSimModelNeutron->getResult()[0], mCurrentPrincipalParticle, forward ? ZNA : ZNC);
-          }
-        }
-        // let's do the proton (ZP) part
-        if (mModelScalerProton && mFastSimModelProton) {
-          LOG(info) << "Generating fast hits for ZP";
-          auto scaledModelParticleProton = mModelScalerProton->scale(rawInput);
-          if (!scaledModelParticleProton.has_value()) {
-            LOG(error) << "FastSimModule: error occurred on scaling";
-          } else {
-            vector<vector<float>> modelInputProton = {fastsim::normal_distribution(0.0, 1.0, 10), std::move(*scaledModelParticleProton)};
-            mFastSimModelProton->setInput(modelInputProton);
-            mFastSimModelProton->run();
-            // produce hits from fast sim result
-            bool forward = mCurrentPrincipalParticle.Pz() > 0.;
-            FastSimToHits(mFastSimModelProton->getResult()[0], mCurrentPrincipalParticle, forward ? ZPA : ZPC);
-          }
-        } // end proton treatment
-      }
+      return;
     }
+    classifierInput.insert(classifierInput.end(), scaledClassParticle->begin(), scaledClassParticle->end());
+  }
+  vector<vector<float>> classifierInputs = {std::move(classifierInput)};
+  mFastSimClassifier->setInput(classifierInputs);
+  mFastSimClassifier->run();
+
+  // this classifies if particle will leave a trace at all in one of the calos ---> TODO: better do it separately for ZN + ZP?
+  auto classes = fastsim::processors::readClassifier(mFastSimClassifier->getResult()[0], n);
+  vector<size_t> selected;
+  for (size_t i = 0; i < n; ++i) {
+    if (classes[i]) {
+      selected.push_back(first + i);
+    }
+  }
+  if (selected.empty()) {
+    return;
+  }
+  // let's do the neutron (ZN) part
+  runFastSimModel(mFastSimModelNeutron, mModelScalerNeutron, selected, ZNA, ZNC);
+  // let's do the proton (ZP) part
+  runFastSimModel(mFastSimModelProton, mModelScalerProton, selected, ZPA, ZPC);
+}
+
+//_____________________________________________________________________________
+void Detector::runFastSimModel(fastsim::NeuralFastSimulation* model, fastsim::processors::StandardScaler* scaler,
+                               std::vector<size_t> const& candidates, int detectorA, int detectorC)
+{
+  using std::vector;
+  if (!model || !scaler) {
+    return;
+  }
+  LOG(debug) << "Generating fast hits for " << (detectorA == ZNA ? "ZN" : "ZP") << " of " << candidates.size() << " particles";
+  vector<float> modelInput;
+  for (auto i : candidates) {
+    auto scaledModelParticle = scaler->scale(mFastSimCandidates[i].rawInput);
+    if (!scaledModelParticle.has_value()) {
+      LOG(error) << "FastSimModule: error occurred on scaling";
+      return;
+    }
+    modelInput.insert(modelInput.end(), scaledModelParticle->begin(), scaledModelParticle->end());
+  }
+  vector<vector<float>> modelInputs = {fastsim::normal_distribution(0.0, 1.0, 10 * candidates.size()), std::move(modelInput)};
+  model->setInput(modelInputs);
+  model->run();
+
+  auto& response = model->getResult()[0];
+  if (o2::zdc::ZDCSimParam::Instance().debugZDCFastSim && detectorA == ZNA) {
+    auto channels = fastsim::processors::calculateChannels(response, candidates.size());
+    mFastSimResults.insert(mFastSimResults.end(), channels.begin(), channels.end());
+  }
+  // produce hits from fast sim result, the images of the particles follow each other in the output
+  auto [Nx, Ny] = determineDetectorSize(detectorA);
+  auto pixels = response.GetTensorData<float>();
+  for (size_t k = 0; k < candidates.size(); ++k) {
+    auto& particle = mFastSimCandidates[candidates[k]].particle;
+    bool forward = particle.Pz() > 0.;
+    resetHitIndices(); // new hits for each particle
+    FastSimToHits(pixels + k * Nx * Ny, particle, forward ? detectorA : detectorC);
   }
-#endif
 }
+#endif
 
 //_____________________________________________________________________________
 void Detector::Register()
@@ -2612,6 +2673,10 @@ void Detector::Reset()
   mResponses.clear();
   mLastPrincipalTrackEntered = -1;
   resetHitIndices();
+#ifdef ZDC_FASTSIM_ONNX
+  mFastSimCandidates.clear();
+  mFinishedPrimaries = 0;
+#endif
 }
 
 //_____________________________________________________________________________
@@ -2619,7 +2684,7 @@ void Detector::Reset()
 // The changes were made to directly convert FastSim output to Hits
 // TParticle can be used to fill additional data required by Hits
 #ifdef ZDC_FASTSIM_ONNX
-bool Detector::FastSimToHits(const Ort::Value& response, const TParticle& particle, int detector)
+bool Detector::FastSimToHits(const float* pixels, const TParticle& particle, int detector)
 {
   math_utils::Vector3D<float> xImp(0., 0., 0.); // good value
 
@@ -2630,9 +2695,6 @@ bool Detector::FastSimToHits(const Ort::Value& response, const TParticle& partic
     return false;
   }
 
-  // gets model output as const float*
-  auto pixels = response.GetTensorData<float>();
-
   auto determineSectorID = [&Nx = Nx, &Ny = Ny](int detector, int x, int y) {
     if (detector == ZNA || detector == ZNC) {
       if ((x + y) % 2 == 0) {
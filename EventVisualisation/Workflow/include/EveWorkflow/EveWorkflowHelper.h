@@ -138,7 +138,9 @@ class EveWorkflowHelper
   using Bracket = o2::math_utils::Bracketf_t;
 
   EveWorkflowHelper(const FilterSet& enabledFilters = {}, std::size_t maxNTracks = -1, const Bracket& timeBracket = {}, const Bracket& etaBracket = {}, bool primaryVertexMode = false);
-  static std::vector<PNT> getTrackPoints(const o2::track::TrackPar& trc, float minR, float maxR, float maxStep, float minZ = -25000, float maxZ = 25000);
+  /// propagate the track to produce the points of its polyline. With maxSagitta > 0 the step is increased up to MaxAdaptiveStep
+  /// for tracks with small curvature, keeping the distance of the polyline to the helix below maxSagitta (in cm)
+  static std::vector<PNT> getTrackPoints(const o2::track::TrackPar& trc, float minR, float maxR, float maxStep, float minZ = -25000, float maxZ = 25000, float maxSagitta = 0.f);
   void selectTracks(const CalibObjectsConst* calib, GID::mask_t maskCl, GID::mask_t maskTrk, GID::mask_t maskMatch);
   void selectTowers();
   void setITSROFs();
@@ -176,7 +178,12 @@ class EveWorkflowHelper
   void drawMIDClusters(GID gid);
   void drawTRDClusters(const o2::trd::TrackTRD& trc);
   void drawTOFClusters(GID gid);
-  void drawPoint(const float xyz[]) { mEvent.addCluster(xyz); }
+  void drawPoint(const float xyz[])
+  {
+    if (keepCluster()) {
+      mEvent.addCluster(xyz);
+    }
+  }
   void drawGlobalPoint(const TVector3& xyx, GID gid, float time) { mEvent.addGlobalCluster(xyx, gid, time); }
   void prepareITSClusters(const o2::itsmft::TopologyDictionary* dict); // fills mITSClustersArray
   void prepareMFTClusters(const o2::itsmft::TopologyDictionary* dict); // fills mMFTClustersArray
@@ -193,6 +200,7 @@ class EveWorkflowHelper
   bool isInsideTimeBracket(float t);
 
   void save(const std::string& jsonPath, const std::string& ext, int numberOfFiles);
+  static void save(o2::event_visualisation::VisualisationEvent& event, const std::string& jsonPath, const std::string& ext, int numberOfFiles);
 
   FilterSet mEnabledFilters;
   std::size_t mMaxNTracks;
@@ -205,6 +213,10 @@ class EveWorkflowHelper
   void setEMCALCellRecalibrator(o2::emcal::CellRecalibrator* calibrator) { mEMCALCalib = calibrator; }
   void setMaxEMCALCellTime(float maxtime) { mEMCALMaxCellTime = maxtime; }
   void setMinEMCALCellEnergy(float minenergy) { mEMCALMinCellEnergy = minenergy; }
+  void setClusterSubsampling(int n) { mClusterSubsampling = n > 1 ? n : 1; }
+  void setMaxTrackSagitta(float sagitta) { mMaxTrackSagitta = sagitta; }
+  /// subsampling of the displayed clusters: keep only every mClusterSubsampling-th cluster
+  bool keepCluster() { return mClusterSubsampling == 1 || mClusterCounter++ % mClusterSubsampling == 0; }
   TracksSet mTrackSet;
   o2::event_visualisation::VisualisationEvent mEvent;
   std::unordered_map<GID, std::size_t> mTotalDataTypes;
@@ -227,6 +239,10 @@ class EveWorkflowHelper
   float mTPCBin2MUS = 0;
   float mEMCALMaxCellTime = 100.;  ///< EMCAL cell time cut (in ns)
   float mEMCALMinCellEnergy = 0.3; ///< EMCAL cell energy cut (in GeV)
+  int mClusterSubsampling = 1;     ///< display only every n-th cluster
+  unsigned int mClusterCounter = 0; ///< clusters seen, for the subsampling
+  float mMaxTrackSagitta = 0.f;    ///< max distance of the track polyline to the helix (in cm) for the adaptive step, 0: fixed step
+  static constexpr float MaxAdaptiveStep = 50.f; ///< max step between track points with the adaptive step (in cm)
   static int BCDiffErrCount;
   const o2::vertexing::PVertexerParams* mPVParams = nullptr;
 };
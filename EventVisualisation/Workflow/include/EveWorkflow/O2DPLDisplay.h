@@ -23,6 +23,7 @@
 #include "EMCALWorkflow/CalibLoader.h"
 #include "EveWorkflow/DetectorData.h"
 #include "Framework/Task.h"
+#include <future>
 #include <memory>
 
 using GID = o2::dataformats::GlobalTrackID;
@@ -70,7 +71,7 @@ class O2DPLDisplaySpec : public o2::framework::Task
   {
     this->mTimeStamp = std::chrono::high_resolution_clock::now() - timeInterval; // first run meets condition
   }
-  ~O2DPLDisplaySpec() override = default;
+  ~O2DPLDisplaySpec() override { waitForSave(); }
   void init(o2::framework::InitContext& ic) final;
   void run(o2::framework::ProcessingContext& pc) final;
   void endOfStream(o2::framework::EndOfStreamContext& ec) final;
@@ -78,6 +79,12 @@ class O2DPLDisplaySpec : public o2::framework::Task
 
  private:
   void updateTimeDependentParams(o2::framework::ProcessingContext& pc);
+  void waitForSave()
+  {
+    if (mSaveFuture.valid()) {
+      mSaveFuture.get();
+    }
+  }
 
   bool mDisableWrite = false; // skip writing result (for testing performance)
   bool mUseMC = false;
@@ -108,6 +115,10 @@ class O2DPLDisplaySpec : public o2::framework::Task
   float mPrimaryVertexMaxY;                // maximum y position of the primary vertex
   float mEMCALMaxCellTime;                 // max abs EMCAL cell time (in ns)
   float mEMCALMinCellEnergy;               // min EMCAL cell energy (in GeV)
+  int mClusterSubsampling = 1;             // display only every n-th cluster
+  float mMaxTrackSagitta = 0.f;            // max distance of the track polyline to the helix for the adaptive step (0: fixed step)
+  bool mAsyncWrite = false;                // serialize and write the files in a worker thread
+  std::future<void> mSaveFuture;           // file being written by the worker thread
   int mEventCounter = 0;
   std::chrono::time_point<std::chrono::high_resolution_clock> mTimeStamp;
 
@@ -37,6 +37,7 @@
 #include "EMCALBase/Geometry.h"
 #include "EMCALCalib/CellRecalibrator.h"
 #include <TGeoBBox.h>
+#include <algorithm>
 #include <tuple>
 #include <gsl/span>
 
@@ -464,12 +465,17 @@ void EveWorkflowHelper::draw(std::size_t primaryVertexIdx, bool sortTracks)
 
 void EveWorkflowHelper::save(const std::string& jsonPath, const std::string& ext, int numberOfFiles)
 {
-  mEvent.setEveVersion(o2_eve_version);
+  save(mEvent, jsonPath, ext, numberOfFiles);
+}
+
+void EveWorkflowHelper::save(o2::event_visualisation::VisualisationEvent& event, const std::string& jsonPath, const std::string& ext, int numberOfFiles)
+{
+  event.setEveVersion(o2_eve_version);
   FileProducer producer(jsonPath, ext, numberOfFiles);
-  VisualisationEventSerializer::getInstance(ext)->toFile(mEvent, producer.newFileName());
+  VisualisationEventSerializer::getInstance(ext)->toFile(event, producer.newFileName());
 }
 
-std::vector<PNT> EveWorkflowHelper::getTrackPoints(const o2::track::TrackPar& trc, float minR, float maxR, float maxStep, float minZ, float maxZ)
+std::vector<PNT> EveWorkflowHelper::getTrackPoints(const o2::track::TrackPar& trc, float minR, float maxR, float maxStep, float minZ, float maxZ, float maxSagitta)
 {
   // adjust minR according to real track start from track starting point
   auto maxR2 = maxR * maxR;
@@ -479,8 +485,16 @@ std::vector<PNT> EveWorkflowHelper::getTrackPoints(const o2::track::TrackPar& tr
   }
   // prepare space points from the track param
   std::vector<PNT> pnts;
-  int nSteps = std::max(2, int((maxR - minR) / maxStep));
   const auto prop = o2::base::Propagator::Instance();
+  float step = maxStep;
+  if (maxSagitta > 0.f) {
+    // a chord of length L on a circle of radius R deviates from it by at most L^2/(8R)
+    const float curvature = std::abs(trc.getCurvature(prop->getNominalBz()));
+    const float chord = curvature > 0.f ? std::sqrt(8.f * maxSagitta / curvature) : MaxAdaptiveStep;
+    step = std::clamp(chord, maxStep, std::max(maxStep, MaxAdaptiveStep));
+  }
+  int nSteps = std::max(2, int((maxR - minR) / step));
+  pnts.reserve(nSteps + 1);
   float xMin = trc.getX(), xMax = maxR * maxR - trc.getY() * trc.getY();
   if (xMax > 0) {
     xMax = std::sqrt(xMax);
@@ -542,7 +556,7 @@ void EveWorkflowHelper::addTrackToEvent(const o2::track::TrackPar& tr, GID gid,
 
   const auto& prange = it->second;
 
-  auto pnts = getTrackPoints(tr, prange.minR, prange.maxR, maxStep, prange.minZ, prange.maxZ);
+  auto pnts = getTrackPoints(tr, prange.minR, prange.maxR, maxStep, prange.minZ, prange.maxZ, mMaxTrackSagitta);
 
   for (size_t ip = 0; ip < pnts.size(); ip++) {
     vTrack->addPolyPoint(pnts[ip][0], pnts[ip][1], pnts[ip][2] + dz);
@@ -945,6 +959,9 @@ void EveWorkflowHelper::drawTPCClusters(GID gid) // , float trackTimeTB
 
   // store the TPC cluster positions
   for (int iCl = trc.getNClusterReferences(); iCl--;) {
+    if (!keepCluster()) {
+      continue;
+    }
     uint8_t sector, row;
     const auto& clTPC = trc.getCluster(mTPCTracksClusIdx, iCl, *mTPCClusterIdxStruct, sector, row);
 
@@ -108,6 +108,9 @@ void O2DPLDisplaySpec::init(InitContext& ic)
   if (mEMCALCalibLoader) {
     mEMCALCalibrator = std::make_unique<o2::emcal::CellRecalibrator>();
   }
+  mClusterSubsampling = ic.options().get<int>("cluster-subsampling");
+  mMaxTrackSagitta = ic.options().get<float>("track-max-sagitta");
+  mAsyncWrite = ic.options().get<bool>("async-write");
 }
 
 void O2DPLDisplaySpec::run(ProcessingContext& pc)
@@ -155,6 +158,8 @@ void O2DPLDisplaySpec::run(ProcessingContext& pc)
   }
   helper.setMaxEMCALCellTime(mEMCALMaxCellTime);
   helper.setMinEMCALCellEnergy(mEMCALMinCellEnergy);
+  helper.setClusterSubsampling(mClusterSubsampling);
+  helper.setMaxTrackSagitta(mMaxTrackSagitta);
 
   helper.setITSROFs();
   helper.selectTracks(&(mData.mConfig.configCalib), mClMask, mTrkMask, mTrkMask);
@@ -220,7 +225,16 @@ void O2DPLDisplaySpec::run(ProcessingContext& pc)
         helper.mEvent.setRunType(this->mRunType);
         helper.mEvent.setPrimaryVertex(pv);
         helper.mEvent.setCreationTime(tinfo.creation);
-        helper.save(this->mJsonPath, this->mExt, this->mNumberOfFiles);
+        if (mAsyncWrite) {
+          // only one file in flight, so that the files are produced in order and the byte budget check sees the previous one
+          waitForSave();
+          auto event = std::make_shared<VisualisationEvent>(std::move(helper.mEvent));
+          mSaveFuture = std::async(std::launch::async, [event, jsonPath = mJsonPath, ext = mExt, numberOfFiles = mNumberOfFiles]() {
+            EveWorkflowHelper::save(*event, jsonPath, ext, numberOfFiles);
+          });
+        } else {
+          helper.save(this->mJsonPath, this->mExt, this->mNumberOfFiles);
+        }
         filesSaved++;
         currentTime = std::chrono::high_resolution_clock::now(); // time AFTER save
         this->mTimeStamp = currentTime;                          // next run AFTER period counted from last save
@@ -268,6 +282,7 @@ void O2DPLDisplaySpec::run(ProcessingContext& pc)
 
 void O2DPLDisplaySpec::endOfStream(EndOfStreamContext& ec)
 {
+  waitForSave();
 }
 
 void O2DPLDisplaySpec::updateTimeDependentParams(ProcessingContext& pc)
@@ -457,7 +472,11 @@ WorkflowSpec defineDataProcessing(ConfigContext const& cfgc)
     "o2-eve-export",
     dataRequest->inputs,
     {},
-    AlgorithmSpec{adaptFromTask<O2DPLDisplaySpec>(disableWrite, useMC, srcTrk, srcCl, dataRequest, ggRequest, emcalCalibLoader, jsonFolder, ext, timeInterval, numberOfFiles, numberOfTracks, numberOfBytes, eveHostNameMatch, minITSTracks, minTracks, filterITSROF, filterTime, timeBracket, removeTPCEta, etaBracket, tracksSorting, onlyNthEvent, primaryVertexMode, maxPrimaryVertices, primaryVertexTriggers, primaryVertexMinZ, primaryVertexMaxZ, primaryVertexMinX, primaryVertexMaxX, primaryVertexMinY, primaryVertexMaxY, maxEMCALCellTime, minEMCALCellEnergy)}});
+    AlgorithmSpec{adaptFromTask<O2DPLDisplaySpec>(disableWrite, useMC, srcTrk, srcCl, dataRequest, ggRequest, emcalCalibLoader, jsonFolder, ext, timeInterval, numberOfFiles, numberOfTracks, numberOfBytes, eveHostNameMatch, minITSTracks, minTracks, filterITSROF, filterTime, timeBracket, removeTPCEta, etaBracket, tracksSorting, onlyNthEvent, primaryVertexMode, maxPrimaryVertices, primaryVertexTriggers, primaryVertexMinZ, primaryVertexMaxZ, primaryVertexMinX, primaryVertexMaxX, primaryVertexMinY, primaryVertexMaxY, maxEMCALCellTime, minEMCALCellEnergy)},
+    Options{
+      {"cluster-subsampling", VariantType::Int, 1, {"display only every n-th cluster"}},
+      {"track-max-sagitta", VariantType::Float, 0.f, {"max distance (cm) of the track polyline to the helix, used to increase the step for straight tracks (0: fixed step)"}},
+      {"async-write", VariantType::Bool, false, {"serialize and write the files in a worker thread"}}}});
 
   // configure dpl timer to inject correct firstTForbit: start from the 1st orbit of TF containing 1st sampled orbit
   o2::raw::HBFUtilsInitializer hbfIni(cfgc, specs);
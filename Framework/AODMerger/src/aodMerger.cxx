@@ -15,6 +15,7 @@
 #include <getopt.h>
 
 #include "TSystem.h"
+#include "TROOT.h"
 #include "TFile.h"
 #include "TTree.h"
 #include "TList.h"
@@ -38,6 +39,7 @@ int main(int argc, char* argv[])
   bool skipNonExistingFiles = false;
   bool skipParentFilesList = false;
   int verbosity = 2;
+  int nThreads = 0;
   int exitCode = 0; // 0: success, >0: failure
 
   int option_index = 0;
@@ -49,6 +51,7 @@ int main(int argc, char* argv[])
     {"skip-parent-files-list", no_argument, nullptr, 4},
     {"verbosity", required_argument, nullptr, 5},
     {"help", no_argument, nullptr, 6},
+    {"threads", required_argument, nullptr, 7},
     {nullptr, 0, nullptr, 0}};
 
   while (true) {
@@ -75,7 +78,10 @@ int main(int argc, char* argv[])
       printf("  --skip-non-existing-files    Flag to allow skipping of non-existing files in the input list.\n");
       printf("  --skip-parent-files-list     Flag to allow skipping the merging of the parent files list.\n");
       printf("  --verbosity <flag>           Verbosity of output (default: %d).\n", verbosity);
+      printf("  --threads <n>                Number of threads for reading and compressing branches in parallel, 0 to disable (default: %d).\n", nThreads);
       return -1;
+    } else if (c == 7) {
+      nThreads = atoi(optarg);
     } else {
       return -2;
     }
@@ -88,6 +94,11 @@ int main(int argc, char* argv[])
   if (skipNonExistingFiles) {
     printf("  WARNING: Skipping non-existing files.\n");
   }
+  if (nThreads > 0) {
+    // the branches of a tree are read, decompressed and compressed in parallel
+    printf("  Threads: %d\n", nThreads);
+    ROOT::EnableImplicitMT(nThreads);
+  }
 
   std::map<std::string, TTree*> trees;
   std::map<std::string, uint64_t> sizeCompressed;
@@ -256,6 +267,8 @@ int main(int argc, char* argv[])
         auto outputTree = trees[treeName];
         // register index and connect VLA columns
         std::vector<std::pair<int*, int>> indexList;
+        // branches needed to compute the unassigned index offset of an already copied tree
+        std::vector<TBranch*> indexBranches;
         std::vector<char*> vlaPointers;
         std::vector<int*> indexPointers;
         TObjArray* branches = inputTree->GetListOfBranches();
@@ -283,6 +296,9 @@ int main(int argc, char* argv[])
             outputTree->SetBranchAddress(br->GetName(), buffer);
 
             if (branchName.BeginsWith("fIndexArray")) {
+              // the size has to be read before the array
+              indexBranches.push_back(((TLeaf*)br->GetListOfLeaves()->First())->GetLeafCount()->GetBranch());
+              indexBranches.push_back(br);
               for (int i = 0; i < maximum; i++) {
                 indexList.push_back({reinterpret_cast<int*>(buffer + i * typeSize), offsets[getTableName(branchName, treeName)]});
               }
@@ -295,6 +311,7 @@ int main(int argc, char* argv[])
             inputTree->SetBranchAddress(br->GetName(), buffer);
             outputTree->SetBranchAddress(br->GetName(), buffer);
 
+            indexBranches.push_back(br);
             indexList.push_back({buffer, offsets[getTableName(branchName, treeName)]});
             indexList.push_back({buffer + 1, offsets[getTableName(branchName, treeName)]});
           } else if (branchName.BeginsWith("fIndex") && !branchName.EndsWith("_size")) {
@@ -305,6 +322,7 @@ int main(int argc, char* argv[])
             inputTree->SetBranchAddress(br->GetName(), buffer);
             outputTree->SetBranchAddress(br->GetName(), buffer);
 
+            indexBranches.push_back(br);
             indexList.push_back({buffer, offsets[getTableName(branchName, treeName)]});
           }
         }
@@ -317,7 +335,14 @@ int main(int argc, char* argv[])
             for (auto& index : indexList) {
               *(index.first) = 0; // Any positive number will do, in any case it will not be filled in the output. Otherwise the previous entry is used and manipulated in the following.
             }
-            inputTree->GetEntry(i);
+            if (alreadyCopied) {
+              // the entries are in the output already, only the index columns are needed
+              for (auto* br : indexBranches) {
+                br->GetEntry(i);
+              }
+            } else {
+              inputTree->GetEntry(i);
+            }
             // shift index columns by offset
             for (const auto& idx : indexList) {
               // if negative, the index is unassigned. In this case, the different unassigned blocks have to get unique negative IDs
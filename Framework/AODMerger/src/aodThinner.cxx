@@ -13,6 +13,7 @@
 #include <getopt.h>
 
 #include "TSystem.h"
+#include "TROOT.h"
 #include "TStopwatch.h"
 #include "TString.h"
 #include "TRegexp.h"
@@ -42,14 +43,16 @@ int main(int argc, char* argv[])
   std::string outputFileName("AO2D_thinned.root");
   int exitCode = 0; // 0: success, !=0: failure
   bool bOverwrite = false;
+  int nThreads = 0;
 
   int option_index = 1;
 
-  const char* const short_opts = "i:o:KOh";
+  const char* const short_opts = "i:o:j:KOh";
   static struct option long_options[] = {
     {"input", required_argument, nullptr, 'i'},
     {"output", required_argument, nullptr, 'o'},
     {"overwrite", no_argument, nullptr, 'O'},
+    {"threads", required_argument, nullptr, 'j'},
     {"help", no_argument, nullptr, 'h'},
     {nullptr, 0, nullptr, 0}};
 
@@ -69,6 +72,9 @@ int main(int argc, char* argv[])
         bOverwrite = true;
         printf("Overwriting existing output file if existing\n");
         break;
+      case 'j':
+        nThreads = atoi(optarg);
+        break;
       case 'h':
       case '?':
       default:
@@ -78,6 +84,7 @@ int main(int argc, char* argv[])
         printf("\n");
         printf("  Optional Arguments:\n");
         printf("  --overwrite/-O                  Overwrite existing output file\n");
+        printf("  --threads/-j <n>                Number of threads for reading and compressing branches in parallel, 0 to disable. Default: %d\n", nThreads);
         return -1;
     }
   }
@@ -85,6 +92,11 @@ int main(int argc, char* argv[])
   printf("AOD reduction started with:\n");
   printf("  Input file: %s\n", inputFileName.c_str());
   printf("  Ouput file name: %s\n", outputFileName.c_str());
+  if (nThreads > 0) {
+    // the branches of a tree are read, decompressed and compressed in parallel
+    printf("  Threads: %d\n", nThreads);
+    ROOT::EnableImplicitMT(nThreads);
+  }
 
   TStopwatch clock;
   clock.Start(kTRUE);
@@ -212,9 +224,13 @@ int main(int argc, char* argv[])
     std::vector<bool> keepV0s(trackExtraTree->GetEntries(), false);
     v0s->SetBranchAddress("fIndexTracks_Pos", &trackIdxPos);
     v0s->SetBranchAddress("fIndexTracks_Neg", &trackIdxNeg);
+    // only the index columns are read for the selection, not the full entries
+    auto v0PosBranch = v0s->GetBranch("fIndexTracks_Pos");
+    auto v0NegBranch = v0s->GetBranch("fIndexTracks_Neg");
     auto nV0s = v0s->GetEntriesFast();
     for (int i{0}; i < nV0s; ++i) {
-      v0s->GetEntry(i);
+      v0PosBranch->GetEntry(i);
+      v0NegBranch->GetEntry(i);
       keepV0s[trackIdxPos] = true;
       keepV0s[trackIdxNeg] = true;
     }
@@ -224,8 +240,9 @@ int main(int argc, char* argv[])
     if (hasTrackQA) {
       keepTrackQA.assign(trackExtraTree->GetEntries(), false);
       trackQA->SetBranchAddress("fIndexTracks", &trackIdxPos);
+      auto trackQABranch = trackQA->GetBranch("fIndexTracks");
       for (int i{0}; i < trackQA->GetEntries(); ++i) {
-        trackQA->GetEntry(i);
+        trackQABranch->GetEntry(i);
         keepTrackQA[trackIdxPos] = true;
       }
     }
@@ -243,6 +260,7 @@ int main(int argc, char* argv[])
     bool bTRDPattern = false;
     float_t TOFChi2 = 0;
     bool bTOFChi2 = false;
+    std::vector<TBranch*> selectionBranches;
 
     // Test if track properties exist
     TBranch* br = nullptr;
@@ -251,18 +269,23 @@ int main(int argc, char* argv[])
       TString brName = br->GetName();
       if (brName == "fTPCNClsFindable") {
         trackExtraTree->SetBranchAddress("fTPCNClsFindable", &tpcNClsFindable);
+        selectionBranches.push_back(br);
         bTPClsFindable = true;
       } else if (brName == "fITSClusterMap") {
         trackExtraTree->SetBranchAddress("fITSClusterMap", &ITSClusterMap);
+        selectionBranches.push_back(br);
         bITSClusterMap = true;
       } else if (brName == "fITSClusterSizes") {
         trackExtraTree->SetBranchAddress("fITSClusterSizes", &ITSClusterSizes);
+        selectionBranches.push_back(br);
         bITSClusterSizes = true;
       } else if (brName == "fTRDPattern") {
         trackExtraTree->SetBranchAddress("fTRDPattern", &TRDPattern);
+        selectionBranches.push_back(br);
         bTRDPattern = true;
       } else if (brName == "fTOFChi2") {
         trackExtraTree->SetBranchAddress("fTOFChi2", &TOFChi2);
+        selectionBranches.push_back(br);
         bTOFChi2 = true;
       }
     }
@@ -278,13 +301,15 @@ int main(int argc, char* argv[])
 
     int fIndexCollisions = 0;
     track_iu->SetBranchAddress("fIndexCollisions", &fIndexCollisions);
+    selectionBranches.push_back(track_iu->GetBranch("fIndexCollisions"));
 
-    // loop over all tracks
+    // loop over all tracks, reading only the columns needed for the selection
     auto entries = trackExtraTree->GetEntries();
     int counter = 0;
     for (int i = 0; i < entries; i++) {
-      trackExtraTree->GetEntry(i);
-      track_iu->GetEntry(i);
+      for (auto* selectionBranch : selectionBranches) {
+        selectionBranch->GetEntry(i);
+      }
 
       // Flag collisions
       hasCollision[i] = (fIndexCollisions >= 0);
@@ -314,9 +339,8 @@ int main(int argc, char* argv[])
 
       auto inputTree = (TTree*)inputFile->Get(Form("%s/%s", dfName, treeName.Data()));
       printf("    Processing tree %s with %lld entries with total size %lld\n", treeName.Data(), inputTree->GetEntries(), inputTree->GetTotBytes());
-      auto outputTree = inputTree->CloneTree(0);
-      outputTree->SetAutoFlush(0);
 
+      std::vector<std::pair<const char*, int*>> indexAddresses;
       std::vector<int*> indexList;
       std::vector<char*> vlaPointers;
       std::vector<int*> indexPointers;
@@ -338,7 +362,7 @@ int main(int argc, char* argv[])
           memset(buffer, 0, 2 * sizeof(buffer[0]));
           vlaPointers.push_back(reinterpret_cast<char*>(buffer));
           inputTree->SetBranchAddress(br->GetName(), buffer);
-          outputTree->SetBranchAddress(br->GetName(), buffer);
+          indexAddresses.emplace_back(br->GetName(), buffer);
 
           indexList.push_back(buffer);
           indexList.push_back(buffer + 1);
@@ -348,7 +372,7 @@ int main(int argc, char* argv[])
           indexPointers.push_back(buffer);
 
           inputTree->SetBranchAddress(br->GetName(), buffer);
-          outputTree->SetBranchAddress(br->GetName(), buffer);
+          indexAddresses.emplace_back(br->GetName(), buffer);
 
           indexList.push_back(buffer);
         }
@@ -360,39 +384,51 @@ int main(int argc, char* argv[])
       const bool processingAmbiguousTracks = treeName.BeginsWith("O2ambiguoustrack");
 
       auto entries = inputTree->GetEntries();
-      for (int i = 0; i < entries; i++) {
-        inputTree->GetEntry(i);
-        bool fillThisEntry = true;
-        // Special case for Tracks, TracksExtra, TracksCov
-        if (processingTracks) {
-          if (acceptedTracks[i] < 0) {
-            fillThisEntry = false;
-          }
-        } else {
-          // Other table than Tracks* --> reassign indices to Tracks
-          for (const auto& idx : indexList) {
-            int oldTrackIndex = *idx;
-
-            // if negative, the index is unassigned.
-            if (oldTrackIndex >= 0) {
-              if (acceptedTracks[oldTrackIndex] < 0) {
-                fillThisEntry = false;
-              } else {
-                *idx = acceptedTracks[oldTrackIndex];
+      TTree* outputTree = nullptr;
+      if (indexList.empty() && !processingTracks && !processingAmbiguousTracks) {
+        // nothing to remove or to reassign, copy the baskets without decompressing them
+        outputTree = inputTree->CloneTree(-1, "fast");
+        outputTree->SetAutoFlush(0);
+      } else {
+        outputTree = inputTree->CloneTree(0);
+        outputTree->SetAutoFlush(0);
+        for (auto const& [name, buffer] : indexAddresses) {
+          outputTree->SetBranchAddress(name, buffer);
+        }
+        for (int i = 0; i < entries; i++) {
+          inputTree->GetEntry(i);
+          bool fillThisEntry = true;
+          // Special case for Tracks, TracksExtra, TracksCov
+          if (processingTracks) {
+            if (acceptedTracks[i] < 0) {
+              fillThisEntry = false;
+            }
+          } else {
+            // Other table than Tracks* --> reassign indices to Tracks
+            for (const auto& idx : indexList) {
+              int oldTrackIndex = *idx;
+
+              // if negative, the index is unassigned.
+              if (oldTrackIndex >= 0) {
+                if (acceptedTracks[oldTrackIndex] < 0) {
+                  fillThisEntry = false;
+                } else {
+                  *idx = acceptedTracks[oldTrackIndex];
+                }
               }
             }
           }
-        }
 
-        // Keep only tracks which have no collision, see O2-3601
-        if (processingAmbiguousTracks) {
-          if (hasCollision[i]) {
-            fillThisEntry = false;
+          // Keep only tracks which have no collision, see O2-3601
+          if (processingAmbiguousTracks) {
+            if (hasCollision[i]) {
+              fillThisEntry = false;
+            }
           }
-        }
 
-        if (fillThisEntry) {
-          outputTree->Fill();
+          if (fillThisEntry) {
+            outputTree->Fill();
+          }
         }
       }
 
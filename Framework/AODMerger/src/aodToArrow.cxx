@@ -0,0 +1,150 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include <getopt.h>
+#include <filesystem>
+
+#include "TFile.h"
+#include "TTree.h"
+#include "TKey.h"
+#include "TList.h"
+#include "TDirectory.h"
+#include "TStopwatch.h"
+
+#include "Framework/TableTreeHelpers.h"
+
+#include <arrow/io/file.h>
+#include <arrow/ipc/writer.h>
+#include <arrow/table.h>
+#include <arrow/util/compression.h>
+
+// AOD to Arrow IPC conversion tool
+//   Every tree DF_<n>/<tree> of the input file is written to <output>/DF_<n>/<tree>.arrow
+//   in the Arrow IPC file format. When <output> is the input file name with the extension
+//   .arrow instead of .root, the AOD reader uses the IPC files instead of the trees.
+int main(int argc, char* argv[])
+{
+  std::string inputFileName("AO2D.root");
+  std::string outputDirName;
+  std::string compression("none");
+
+  int option_index = 1;
+
+  const char* const short_opts = "i:o:c:h";
+  static struct option long_options[] = {
+    {"input", required_argument, nullptr, 'i'},
+    {"output", required_argument, nullptr, 'o'},
+    {"compression", required_argument, nullptr, 'c'},
+    {"help", no_argument, nullptr, 'h'},
+    {nullptr, 0, nullptr, 0}};
+
+  while (true) {
+    const auto opt = getopt_long(argc, argv, short_opts, long_options, &option_index);
+    if (opt == -1) {
+      break; // use defaults
+    }
+    switch (opt) {
+      case 'i':
+        inputFileName = optarg;
+        break;
+      case 'o':
+        outputDirName = optarg;
+        break;
+      case 'c':
+        compression = optarg;
+        break;
+      case 'h':
+      case '?':
+      default:
+        printf("AO2D to Arrow IPC conversion tool. Options: \n");
+        printf("  --input/-i <inputfile.root>     Input AO2D file. Default: %s\n", inputFileName.c_str());
+        printf("  --output/-o <outputdir>         Target output directory. Default: input file name with extension .arrow\n");
+        printf("\n");
+        printf("  Optional Arguments:\n");
+        printf("  --compression/-c <codec>        Buffer compression: none, lz4 or zstd. Default: %s\n", compression.c_str());
+        return -1;
+    }
+  }
+  if (outputDirName.empty()) {
+    outputDirName = std::filesystem::path(inputFileName).replace_extension(".arrow").string();
+  }
+
+  auto options = arrow::ipc::IpcWriteOptions::Defaults();
+  if (compression == "lz4" || compression == "zstd") {
+    auto codec = arrow::util::Codec::Create(compression == "lz4" ? arrow::Compression::LZ4_FRAME : arrow::Compression::ZSTD);
+    if (!codec.ok()) {
+      printf("Error: Compression %s is not available: %s\n", compression.c_str(), codec.status().ToString().c_str());
+      return 1;
+    }
+    options.codec = std::move(codec).ValueOrDie();
+  } else if (compression != "none") {
+    printf("Error: Unknown compression %s\n", compression.c_str());
+    return 1;
+  }
+
+  printf("AOD to Arrow IPC conversion started with:\n");
+  printf("  Input file: %s\n", inputFileName.c_str());
+  printf("  Output directory: %s\n", outputDirName.c_str());
+  printf("  Compression: %s\n", compression.c_str());
+
+  TStopwatch clock;
+  clock.Start(kTRUE);
+
+  auto inputFile = TFile::Open(inputFileName.c_str());
+  if (!inputFile) {
+    printf("Error: Could not open input file %s.\n", inputFileName.c_str());
+    return 1;
+  }
+
+  long totalBytes = 0;
+  for (auto key1 : *inputFile->GetListOfKeys()) {
+    auto dfName = std::string(key1->GetName());
+    if (dfName.find("DF_") != 0) {
+      continue;
+    }
+    auto dfDir = std::filesystem::path(outputDirName) / dfName;
+    std::filesystem::create_directories(dfDir);
+
+    auto inputDir = (TDirectory*)inputFile->Get(dfName.c_str());
+    for (auto key2 : *inputDir->GetListOfKeys()) {
+      auto tree = dynamic_cast<TTree*>(inputDir->Get(key2->GetName()));
+      if (!tree) {
+        continue;
+      }
+
+      o2::framework::TreeToTable t2t;
+      t2t.setLabel(tree->GetName());
+      t2t.addAllColumns(tree);
+      t2t.fill(tree);
+      auto table = t2t.finalize();
+
+      auto outputPath = (dfDir / (std::string(tree->GetName()) + ".arrow")).string();
+      auto stream = arrow::io::FileOutputStream::Open(outputPath);
+      if (!stream.ok()) {
+        printf("Error: Could not create %s: %s\n", outputPath.c_str(), stream.status().ToString().c_str());
+        return 1;
+      }
+      auto writer = arrow::ipc::MakeFileWriter(*stream, table->schema(), options);
+      if (!writer.ok() || !(*writer)->WriteTable(*table).ok() || !(*writer)->Close().ok() || !(*stream)->Close().ok()) {
+        printf("Error: Could not write %s\n", outputPath.c_str());
+        return 1;
+      }
+      totalBytes += std::filesystem::file_size(outputPath);
+      delete tree;
+    }
+  }
+  inputFile->Close();
+
+  clock.Stop();
+  printf("AOD conversion finished. Wrote %ld bytes in %.2f s.\n", totalBytes, clock.RealTime());
+
+  return 0;
+}
@@ -158,6 +158,9 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
         LOGP(error, "Check the JSON document! Can not be properly parsed!");
       }
     }
+    if (options.isSet("aod-read-ahead")) {
+      didir->setReadAhead(options.get<int>("aod-read-ahead"), options.get<int64_t>("aod-read-ahead-max-bytes"), options.get<int>("aod-read-ahead-threads"));
+    }
 
     // get the run time watchdog
     auto* watchdog = new RuntimeWatchdog(options.get<int64_t>("time-limit"));
@@ -181,6 +184,18 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
         reportTFFileName = true;
       } else {
         requestedTables.emplace_back(route);
+        // read only the columns declared by the subscribers, all if any of them needs all
+        std::vector<std::string> columns;
+        for (auto& m : route.matcher.metadata) {
+          if (m.name.rfind("column:", 0) == 0) {
+            columns.emplace_back(m.name.substr(7));
+          }
+        }
+        if (std::find(columns.begin(), columns.end(), "*") != columns.end()) {
+          columns.clear();
+        }
+        auto concrete = DataSpecUtils::asConcreteDataMatcher(route.matcher);
+        didir->setColumnNames(header::DataHeader(concrete.description, concrete.origin, concrete.subSpec), std::move(columns));
       }
     }
 
@@ -26,7 +26,14 @@
 #include "TGrid.h"
 #include "TObjString.h"
 #include "TMap.h"
+#include "TROOT.h"
 
+#include <arrow/io/file.h>
+#include <arrow/ipc/reader.h>
+#include <arrow/table.h>
+#include <arrow/util/byte_size.h>
+
+#include <filesystem>
 #include <uv.h>
 
 #if __has_include(<TJAlienFile.h>)
@@ -35,14 +42,85 @@
 #include <utility>
 #endif
 
-std::vector<std::string> getColumnNames(o2::header::DataHeader dh)
+namespace
+{
+void fillTable(o2::framework::TreeToTable& t2t, TTree* tree, std::vector<std::string> colnames, size_t& totalSizeCompressed, size_t& totalSizeUncompressed)
 {
-  auto description = std::string(dh.dataDescription.str);
-  auto origin = std::string(dh.dataOrigin.str);
+  // add branches to read
+  // fill the table
+  t2t.setLabel(tree->GetName());
+  if (colnames.size() == 0) {
+    totalSizeCompressed += tree->GetZipBytes();
+    totalSizeUncompressed += tree->GetTotBytes();
+    t2t.addAllColumns(tree);
+  } else {
+    for (auto& colname : colnames) {
+      // the sizes of variable length arrays are in a separate branch
+      for (auto* branch : {tree->GetBranch(colname.c_str()), tree->GetBranch((colname + "_size").c_str())}) {
+        if (branch) {
+          totalSizeCompressed += branch->GetZipBytes("*");
+          totalSizeUncompressed += branch->GetTotBytes("*");
+        }
+      }
+    }
+    t2t.addAllColumns(tree, std::move(colnames));
+  }
+  t2t.fill(tree);
+}
 
-  // default: column names = {}
-  return {};
+// read the @a colnames of an Arrow IPC file written by o2-aod-to-arrow, all if empty.
+// The file is memory mapped: uncompressed buffers are used in place, compressed ones
+// (LZ4/ZSTD) are decompressed by the IPC reader.
+std::shared_ptr<arrow::Table> readArrowIPC(std::string const& path, std::vector<std::string> const& colnames, size_t& totalSizeCompressed, size_t& totalSizeUncompressed)
+{
+  auto file = arrow::io::MemoryMappedFile::Open(path, arrow::io::FileMode::READ);
+  if (!file.ok()) {
+    return nullptr;
+  }
+  auto options = arrow::ipc::IpcReadOptions::Defaults();
+  if (!colnames.empty()) {
+    auto reader = arrow::ipc::RecordBatchFileReader::Open(*file);
+    if (!reader.ok()) {
+      throw std::runtime_error(fmt::format(R"(Couldn't read Arrow IPC file "{}": {})", path, reader.status().ToString()));
+    }
+    auto schema = (*reader)->schema();
+    for (auto& colname : colnames) {
+      for (auto& name : {colname, colname + "_size"}) {
+        auto index = schema->GetFieldIndex(name);
+        if (index >= 0) {
+          options.included_fields.push_back(index);
+        }
+      }
+    }
+  }
+  auto reader = arrow::ipc::RecordBatchFileReader::Open(*file, options);
+  if (!reader.ok()) {
+    throw std::runtime_error(fmt::format(R"(Couldn't read Arrow IPC file "{}": {})", path, reader.status().ToString()));
+  }
+  std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+  for (int i = 0; i < (*reader)->num_record_batches(); i++) {
+    auto batch = (*reader)->ReadRecordBatch(i);
+    if (!batch.ok()) {
+      throw std::runtime_error(fmt::format(R"(Couldn't read record batch {} of "{}": {})", i, path, batch.status().ToString()));
+    }
+    batches.emplace_back(std::move(batch).ValueOrDie());
+  }
+  auto table = arrow::Table::FromRecordBatches((*reader)->schema(), batches);
+  if (!table.ok()) {
+    throw std::runtime_error(fmt::format(R"(Couldn't create table from "{}": {})", path, table.status().ToString()));
+  }
+  // with a column selection only the buffers of these columns are touched
+  auto uncompressed = arrow::util::TotalBufferSize(**table);
+  totalSizeCompressed += colnames.empty() ? (*file)->GetSize().ValueOr(uncompressed) : uncompressed;
+  totalSizeUncompressed += uncompressed;
+  return std::move(table).ValueOrDie();
+}
+
+std::string columnNamesKey(o2::header::DataHeader const& dh)
+{
+  return fmt::format("{}/{}/{}", dh.dataOrigin.as<std::string>(), dh.dataDescription.as<std::string>(), dh.subSpecification);
 }
+} // namespace
 
 namespace o2::framework
 {
@@ -64,6 +142,11 @@ DataInputDescriptor::DataInputDescriptor(bool alienSupport, int level, o2::monit
 {
 }
 
+DataInputDescriptor::~DataInputDescriptor()
+{
+  stopReadAhead();
+}
+
 void DataInputDescriptor::printOut()
 {
   LOGP(info, "DataInputDescriptor");
@@ -129,6 +212,16 @@ bool DataInputDescriptor::setFile(int counter)
   }
   mcurrentFile->SetReadaheadSize(50 * 1024 * 1024);
 
+  // a local Arrow IPC copy of the trees (see o2-aod-to-arrow) is read instead of the trees
+  mArrowIPCDirectory.clear();
+  if (filename.find("://") == std::string::npos) {
+    auto ipcDir = std::filesystem::path(filename).replace_extension(".arrow");
+    if (std::filesystem::is_directory(ipcDir)) {
+      LOGP(info, "Reading the tables of {} from the Arrow IPC files in {}", filename, ipcDir.string());
+      mArrowIPCDirectory = ipcDir.string();
+    }
+  }
+
   // get the parent file map if exists
   mParentFileMap = (TMap*)mcurrentFile->Get("parentFiles"); // folder name (DF_XXX) --> parent file (absolute path)
   if (mParentFileMap && !mParentFileReplacement.empty()) {
@@ -294,6 +387,7 @@ void DataInputDescriptor::printFileStatistics()
 
 void DataInputDescriptor::closeInputFile()
 {
+  stopReadAhead();
   if (mcurrentFile) {
     if (mParentFile) {
       mParentFile->closeInputFile();
@@ -363,7 +457,7 @@ int DataInputDescriptor::findDFNumber(int file, std::string dfName)
   return it - dfList.begin();
 }
 
-bool DataInputDescriptor::readTree(DataAllocator& outputs, header::DataHeader dh, int counter, int numTF, std::string treename, size_t& totalSizeCompressed, size_t& totalSizeUncompressed)
+bool DataInputDescriptor::readTree(DataAllocator& outputs, header::DataHeader dh, int counter, int numTF, std::string treename, std::vector<std::string> const& columns, size_t& totalSizeCompressed, size_t& totalSizeUncompressed)
 {
   auto ioStart = uv_hrtime();
 
@@ -371,6 +465,18 @@ bool DataInputDescriptor::readTree(DataAllocator& outputs, header::DataHeader dh
   if (!fileAndFolder.file) {
     return false;
   }
+  if (!mArrowIPCDirectory.empty()) {
+    auto table = readArrowIPC(mArrowIPCDirectory + "/" + fileAndFolder.folderName + "/" + treename + ".arrow", columns, totalSizeCompressed, totalSizeUncompressed);
+    if (table) {
+      outputs.adopt(Output(dh), table);
+      mIOTime += (uv_hrtime() - ioStart);
+      return true;
+    }
+  }
+  if (mReadAheadDepth > 0 && takeReadAhead(outputs, dh, counter, numTF, treename, columns, totalSizeCompressed, totalSizeUncompressed)) {
+    mIOTime += (uv_hrtime() - ioStart);
+    return true;
+  }
 
   auto fullpath = fileAndFolder.folderName + "/" + treename;
   auto tree = (TTree*)fileAndFolder.file->Get(fullpath.c_str());
@@ -384,7 +490,7 @@ bool DataInputDescriptor::readTree(DataAllocator& outputs, header::DataHeader dh
         throw std::runtime_error(fmt::format(R"(DF {} listed in parent file map but not found in the corresponding file "{}")", fileAndFolder.folderName, parentFile->mcurrentFile->GetName()));
       }
       // first argument is 0 as the parent file object contains only 1 file
-      return parentFile->readTree(outputs, dh, 0, parentNumTF, treename, totalSizeCompressed, totalSizeUncompressed);
+      return parentFile->readTree(outputs, dh, 0, parentNumTF, treename, columns, totalSizeCompressed, totalSizeUncompressed);
     }
     throw std::runtime_error(fmt::format(R"(Couldn't get TTree "{}" from "{}". Please check https://aliceo2group.github.io/analysis-framework/docs/troubleshooting/#tree-not-found for more information.)", fileAndFolder.folderName + "/" + treename, fileAndFolder.file->GetName()));
   }
@@ -392,24 +498,7 @@ bool DataInputDescriptor::readTree(DataAllocator& outputs, header::DataHeader dh
   // create table output
   auto o = Output(dh);
   auto t2t = outputs.make<TreeToTable>(o);
-
-  // add branches to read
-  // fill the table
-  auto colnames = getColumnNames(dh);
-  t2t->setLabel(tree->GetName());
-  if (colnames.size() == 0) {
-    totalSizeCompressed += tree->GetZipBytes();
-    totalSizeUncompressed += tree->GetTotBytes();
-    t2t->addAllColumns(tree);
-  } else {
-    for (auto& colname : colnames) {
-      TBranch* branch = tree->GetBranch(colname.c_str());
-      totalSizeCompressed += branch->GetZipBytes("*");
-      totalSizeUncompressed += branch->GetTotBytes("*");
-    }
-    t2t->addAllColumns(tree, std::move(colnames));
-  }
-  t2t->fill(tree);
+  fillTable(*t2t, tree, columns, totalSizeCompressed, totalSizeUncompressed);
   delete tree;
 
   mIOTime += (uv_hrtime() - ioStart);
@@ -417,6 +506,146 @@ bool DataInputDescriptor::readTree(DataAllocator& outputs, header::DataHeader dh
   return true;
 }
 
+void DataInputDescriptor::setReadAhead(int depth, size_t maxBytes, int nThreads)
+{
+  stopReadAhead();
+  mReadAheadDepth = depth;
+  mReadAheadMaxBytes = maxBytes;
+  mReadAheadNThreads = std::max(1, nThreads);
+}
+
+bool DataInputDescriptor::takeReadAhead(DataAllocator& outputs, header::DataHeader dh, int counter, int numTF, std::string const& treename, std::vector<std::string> const& columns, size_t& totalSizeCompressed, size_t& totalSizeUncompressed)
+{
+  std::unique_lock<std::mutex> lock(mReadAheadMutex);
+  // move the window of DFs to read ahead, the current file was set by getFileFolder
+  if (mReadAheadFileName != mfilenames[counter]->fileName) {
+    mReadAheadFileName = mfilenames[counter]->fileName;
+    mReadAheadFolders = mfilenames[counter]->listOfTimeFrameKeys;
+  }
+  if (std::none_of(mReadAheadTrees.begin(), mReadAheadTrees.end(), [&treename](auto const& t) { return t.treename == treename; })) {
+    mReadAheadTrees.emplace_back(ReadAheadTree{treename, dh, columns});
+  }
+  mReadAheadCurrentTF = numTF;
+  while (!mReadAheadDFs.empty() && mReadAheadDFs.begin()->first < numTF) {
+    mReadAheadBytes -= mReadAheadDFs.begin()->second.bytes;
+    mReadAheadDFs.erase(mReadAheadDFs.begin());
+  }
+  if (mReadAheadThreads.empty()) {
+    mReadAheadStop = false;
+    for (int i = 0; i < mReadAheadNThreads; i++) {
+      mReadAheadThreads.emplace_back(&DataInputDescriptor::readAheadLoop, this);
+    }
+  }
+  mReadAheadCV.notify_all();
+
+  // if this DF is just being read ahead, better wait than read it twice
+  mReadAheadCV.wait(lock, [this, numTF]() { return mReadAheadInProgress.count(numTF) == 0; });
+  auto df = mReadAheadDFs.find(numTF);
+  if (df == mReadAheadDFs.end()) {
+    return false;
+  }
+  auto entry = df->second.tables.find(treename);
+  if (entry == df->second.tables.end() || !entry->second.table) {
+    return false; // not requested when the DF was read ahead or not in this file, read it synchronously
+  }
+  auto readAhead = std::move(entry->second);
+  df->second.tables.erase(entry);
+  df->second.bytes -= readAhead.sizeUncompressed;
+  mReadAheadBytes -= readAhead.sizeUncompressed;
+  lock.unlock();
+  mReadAheadCV.notify_all();
+
+  totalSizeCompressed += readAhead.sizeCompressed;
+  totalSizeUncompressed += readAhead.sizeUncompressed;
+  outputs.adopt(Output(dh), readAhead.table);
+  return true;
+}
+
+void DataInputDescriptor::readAheadLoop()
+{
+  TFile* file = nullptr;
+  std::string fileName;
+  std::unique_lock<std::mutex> lock(mReadAheadMutex);
+  while (!mReadAheadStop) {
+    int next = mReadAheadCurrentTF + 1;
+    while (mReadAheadDFs.count(next) || mReadAheadInProgress.count(next)) {
+      next++;
+    }
+    if (next > mReadAheadCurrentTF + mReadAheadDepth || next >= (int)mReadAheadFolders.size() || mReadAheadBytes >= mReadAheadMaxBytes) {
+      mReadAheadCV.wait(lock);
+      continue;
+    }
+    mReadAheadInProgress.insert(next);
+    auto folder = mReadAheadFolders[next];
+    auto trees = mReadAheadTrees;
+    if (fileName != mReadAheadFileName) {
+      if (file) {
+        file->Close();
+        delete file;
+      }
+      fileName = mReadAheadFileName;
+      file = nullptr;
+    }
+    lock.unlock();
+
+    ReadAheadDF df;
+    if (!file) {
+      file = TFile::Open(fileName.c_str());
+    }
+    for (auto& [treename, dh, columns] : trees) {
+      auto& entry = df.tables[treename];
+      auto tree = file ? (TTree*)file->Get((folder + "/" + treename).c_str()) : nullptr;
+      if (!tree) {
+        continue;
+      }
+      try {
+        TreeToTable t2t;
+        fillTable(t2t, tree, columns, entry.sizeCompressed, entry.sizeUncompressed);
+        entry.table = t2t.finalize();
+        df.bytes += entry.sizeUncompressed;
+      } catch (std::exception const& e) {
+        LOGP(warn, "Reading ahead tree {} of {} failed, it will be read when needed: {}", treename, folder, e.what());
+        entry = ReadAheadTable{};
+      }
+      delete tree;
+    }
+
+    lock.lock();
+    mReadAheadInProgress.erase(next);
+    if (next > mReadAheadCurrentTF) {
+      mReadAheadBytes += df.bytes;
+      mReadAheadDFs.emplace(next, std::move(df));
+    }
+    mReadAheadCV.notify_all();
+  }
+  lock.unlock();
+  if (file) {
+    file->Close();
+    delete file;
+  }
+}
+
+void DataInputDescriptor::stopReadAhead()
+{
+  if (mReadAheadThreads.empty()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mReadAheadMutex);
+    mReadAheadStop = true;
+  }
+  mReadAheadCV.notify_all();
+  for (auto& thread : mReadAheadThreads) {
+    thread.join();
+  }
+  mReadAheadThreads.clear();
+  mReadAheadDFs.clear();
+  mReadAheadBytes = 0;
+  mReadAheadFileName.clear();
+  mReadAheadFolders.clear();
+  mReadAheadCurrentTF = -1;
+}
+
 DataInputDirector::DataInputDirector()
 {
   createDefaultDataInputDescriptor();
@@ -761,7 +990,31 @@ bool DataInputDirector::readTree(DataAllocator& outputs, header::DataHeader dh,
     treename = aod::datamodel::getTreeName(dh);
   }
 
-  return didesc->readTree(outputs, dh, counter, numTF, treename, totalSizeCompressed, totalSizeUncompressed);
+  return didesc->readTree(outputs, dh, counter, numTF, treename, getColumnNames(dh), totalSizeCompressed, totalSizeUncompressed);
+}
+
+void DataInputDirector::setColumnNames(header::DataHeader dh, std::vector<std::string> columns)
+{
+  mColumnNames[columnNamesKey(dh)] = std::move(columns);
+}
+
+std::vector<std::string> const& DataInputDirector::getColumnNames(header::DataHeader dh) const
+{
+  static const std::vector<std::string> allColumns{};
+  auto columns = mColumnNames.find(columnNamesKey(dh));
+  return columns == mColumnNames.end() ? allColumns : columns->second;
+}
+
+void DataInputDirector::setReadAhead(int depth, size_t maxBytes, int nThreads)
+{
+  if (depth > 0) {
+    ROOT::EnableThreadSafety(); // the DFs are read ahead by nThreads threads per DataInputDescriptor
+    LOGP(info, "Reading ahead up to {} DFs per input file with {} threads, using at most {} bytes", depth, nThreads, maxBytes);
+  }
+  mdefaultDataInputDescriptor->setReadAhead(depth, maxBytes, nThreads);
+  for (auto didesc : mdataInputDescriptors) {
+    didesc->setReadAhead(depth, maxBytes, nThreads);
+  }
 }
 
 void DataInputDirector::closeInputFiles()
@@ -16,7 +16,13 @@
 #include "Framework/DataDescriptorMatcher.h"
 #include "Framework/DataAllocator.h"
 
+#include <condition_variable>
+#include <map>
+#include <mutex>
 #include <regex>
+#include <set>
+#include <thread>
+#include <unordered_map>
 #include "rapidjson/fwd.h"
 
 namespace o2::monitoring
@@ -54,6 +60,7 @@ class DataInputDescriptor
 
   DataInputDescriptor() = default;
   DataInputDescriptor(bool alienSupport, int level, o2::monitoring::Monitoring* monitoring = nullptr, int allowedParentLevel = 0, std::string parentFileReplacement = "");
+  ~DataInputDescriptor();
 
   void printOut();
 
@@ -68,6 +75,9 @@ class DataInputDescriptor
   void addFileNameHolder(FileNameHolder* fn);
   int fillInputfiles();
   bool setFile(int counter);
+  /// Read the trees of up to @a depth following DFs of the current file in the background,
+  /// as long as the prefetched tables stay below @a maxBytes (uncompressed). 0 disables it.
+  void setReadAhead(int depth, size_t maxBytes, int nThreads = 1);
 
   // getters
   std::string getInputfilesFilename();
@@ -83,7 +93,8 @@ class DataInputDescriptor
   int getTimeFramesInFile(int counter);
   int getReadTimeFramesInFile(int counter);
 
-  bool readTree(DataAllocator& outputs, header::DataHeader dh, int counter, int numTF, std::string treename, size_t& totalSizeCompressed, size_t& totalSizeUncompressed);
+  /// read the @a columns of the tree, all if empty
+  bool readTree(DataAllocator& outputs, header::DataHeader dh, int counter, int numTF, std::string treename, std::vector<std::string> const& columns, size_t& totalSizeCompressed, size_t& totalSizeUncompressed);
 
   void printFileStatistics();
   void closeInputFile();
@@ -100,6 +111,7 @@ class DataInputDescriptor
   std::vector<FileNameHolder*>* mdefaultFilenamesPtr = nullptr;
   TFile* mcurrentFile = nullptr;
   int mCurrentFileID = -1;
+  std::string mArrowIPCDirectory; // Arrow IPC copy of the current file, empty if none
   bool mAlienSupport = false;
 
   o2::monitoring::Monitoring* mMonitoring = nullptr;
@@ -112,6 +124,40 @@ class DataInputDescriptor
 
   uint64_t mIOTime = 0;
   uint64_t mCurrentFileStartedAt = 0;
+
+  // read-ahead of the next DFs of the current file, done by a thread with its own TFile
+  struct ReadAheadTable {
+    std::shared_ptr<arrow::Table> table; // nullptr if the tree is not in this file (e.g. in a parent file)
+    size_t sizeCompressed = 0;
+    size_t sizeUncompressed = 0;
+  };
+  struct ReadAheadDF {
+    std::unordered_map<std::string, ReadAheadTable> tables; // by tree name
+    size_t bytes = 0;
+  };
+  struct ReadAheadTree {
+    std::string treename;
+    header::DataHeader dh;
+    std::vector<std::string> columns;
+  };
+  bool takeReadAhead(DataAllocator& outputs, header::DataHeader dh, int counter, int numTF, std::string const& treename, std::vector<std::string> const& columns, size_t& totalSizeCompressed, size_t& totalSizeUncompressed);
+  void readAheadLoop();
+  void stopReadAhead();
+
+  int mReadAheadDepth = 0;
+  size_t mReadAheadMaxBytes = 0;
+  int mReadAheadNThreads = 1;
+  std::vector<std::thread> mReadAheadThreads; // each with its own TFile, reading different DFs
+  std::mutex mReadAheadMutex;
+  std::condition_variable mReadAheadCV;
+  bool mReadAheadStop = false;
+  std::string mReadAheadFileName;
+  std::vector<std::string> mReadAheadFolders; // DF folders of the file being read ahead
+  std::vector<ReadAheadTree> mReadAheadTrees; // trees requested so far
+  int mReadAheadCurrentTF = -1;               // DF being processed by the reader
+  std::set<int> mReadAheadInProgress;         // DFs being read by the read-ahead threads
+  std::map<int, ReadAheadDF> mReadAheadDFs;
+  size_t mReadAheadBytes = 0;
 };
 
 class DataInputDirector
@@ -134,12 +180,16 @@ class DataInputDirector
   // setters
   void setInputfilesFile(std::string iffn) { minputfilesFile = iffn; }
   void setFilenamesRegex(std::string dfn) { mFilenameRegex = dfn; }
+  void setReadAhead(int depth, size_t maxBytes, int nThreads = 1);
+  /// read only the @a columns of the table described by @a dh, all if empty
+  void setColumnNames(header::DataHeader dh, std::vector<std::string> columns);
   bool readJson(std::string const& fnjson);
   void closeInputFiles();
 
   // getters
   DataInputDescriptor* getDataInputDescriptor(header::DataHeader dh);
   int getNumberInputDescriptors() { return mdataInputDescriptors.size(); }
+  std::vector<std::string> const& getColumnNames(header::DataHeader dh) const;
 
   bool readTree(DataAllocator& outputs, header::DataHeader dh, int counter, int numTF, size_t& totalSizeCompressed, size_t& totalSizeUncompressed);
   uint64_t getTimeFrameNumber(header::DataHeader dh, int counter, int numTF);
@@ -159,6 +209,7 @@ class DataInputDirector
   DataInputDescriptor* mdefaultDataInputDescriptor = nullptr;
   std::vector<FileNameHolder*> mdefaultInputFiles;
   std::vector<DataInputDescriptor*> mdataInputDescriptors;
+  std::unordered_map<std::string, std::vector<std::string>> mColumnNames; // columns to read by table, all if not set
 
   o2::monitoring::Monitoring* mMonitoring = nullptr;
 
@@ -15,6 +15,7 @@
 #include "Framework/TimingInfo.h"
 #include "Framework/ConfigParamRegistry.h"
 #include "Framework/DataTakingContext.h"
+#include "Framework/DefaultsHelpers.h"
 #include "Framework/RawDeviceService.h"
 #include "Framework/DataSpecUtils.h"
 #include "CCDB/CcdbApi.h"
@@ -23,13 +24,168 @@
 #include <typeinfo>
 #include <TError.h>
 #include <TMemFile.h>
+#include <condition_variable>
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
 
 O2_DECLARE_DYNAMIC_LOG(ccdb);
 
 namespace o2::framework
 {
 
+/// Downloads in a background thread the objects for the validity interval
+/// following the current one, so that the fetcher does not stall the
+/// processing when the current objects expire. Requests queued while a batch
+/// is being downloaded are retrieved together, in parallel, by the curl
+/// multi-handle of the CCDBDownloader.
+struct CCDBPrefetcher {
+  struct Request {
+    std::string host;
+    std::string path;
+    std::map<std::string, std::string> metadata;
+    int64_t timestamp = 0;
+  };
+
+  struct Result {
+    int64_t timestamp = 0;
+    o2::pmr::vector<char> data;
+    std::map<std::string, std::string> headers;
+  };
+
+  CCDBPrefetcher(std::string const& createdNotAfter, std::string const& createdNotBefore, size_t maxBytes)
+    : mCreatedNotAfter{createdNotAfter},
+      mCreatedNotBefore{createdNotBefore},
+      mMaxBytes{maxBytes},
+      mThread{[this]() { run(); }}
+  {
+  }
+
+  ~CCDBPrefetcher()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mStop = true;
+    }
+    mCondition.notify_one();
+    mThread.join();
+  }
+
+  /// Add a host, using its own API instance, since CcdbApi is not thread safe.
+  void addHost(std::string const& host, std::string const& url)
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mAPIs[host].init(url);
+  }
+
+  /// Queue the download of @a path for @a timestamp, unless it is already pending or done.
+  void request(Request&& request)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      auto result = mResults.find(request.path);
+      if (mPending.count(request.path) || (result != mResults.end() && result->second.timestamp == request.timestamp)) {
+        return;
+      }
+      mPending.insert(request.path);
+      mQueue.emplace_back(std::move(request));
+    }
+    mCondition.notify_one();
+  }
+
+  /// Take the prefetched object for @a path if it is valid for @a timestamp.
+  bool take(std::string const& path, int64_t timestamp, o2::pmr::vector<char>& dest, std::map<std::string, std::string>& headers)
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto entry = mResults.find(path);
+    if (entry == mResults.end()) {
+      return false;
+    }
+    auto& result = entry->second;
+    auto validFrom = result.headers.find("Valid-From");
+    auto validUntil = result.headers.find("Valid-Until");
+    if (validFrom == result.headers.end() || validUntil == result.headers.end() ||
+        timestamp < std::stoll(validFrom->second) || timestamp >= std::stoll(validUntil->second)) {
+      return false;
+    }
+    dest.assign(result.data.begin(), result.data.end());
+    headers = std::move(result.headers);
+    mBytes -= result.data.size();
+    mResults.erase(entry);
+    return true;
+  }
+
+ private:
+  void run()
+  {
+    while (true) {
+      std::vector<Request> batch;
+      {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mCondition.wait(lock, [this]() { return mStop || !mQueue.empty(); });
+        if (mStop) {
+          return;
+        }
+        batch.swap(mQueue);
+      }
+      std::vector<Result> results(batch.size());
+      std::unordered_map<std::string, std::vector<o2::ccdb::CcdbApi::RequestContext>> contexts;
+      for (size_t i = 0; i < batch.size(); ++i) {
+        auto& context = contexts[batch[i].host].emplace_back(results[i].data, batch[i].metadata, results[i].headers);
+        context.path = batch[i].path;
+        context.timestamp = batch[i].timestamp;
+        context.createdNotAfter = mCreatedNotAfter;
+        context.createdNotBefore = mCreatedNotBefore;
+        context.considerSnapshot = true;
+        results[i].timestamp = batch[i].timestamp;
+      }
+      for (auto& [host, hostContexts] : contexts) {
+        try {
+          mAPIs.at(host).vectoredLoadFileToMemory(hostContexts);
+        } catch (std::exception const& e) {
+          // The object is fetched synchronously when needed.
+          LOGP(warn, "Failed to prefetch CCDB objects from {}: {}", host.empty() ? "default host" : host, e.what());
+        }
+      }
+      std::lock_guard<std::mutex> lock(mMutex);
+      for (size_t i = 0; i < batch.size(); ++i) {
+        auto& path = batch[i].path;
+        mPending.erase(path);
+        auto& result = results[i];
+        if (result.data.empty() || result.headers.count("Error")) {
+          continue;
+        }
+        if (auto previous = mResults.find(path); previous != mResults.end()) {
+          mBytes -= previous->second.data.size();
+          mResults.erase(previous);
+        }
+        if (mBytes + result.data.size() > mMaxBytes) {
+          LOGP(detail, "Not keeping prefetched {} for {}, {} bytes already cached", path, result.timestamp, mBytes);
+          continue;
+        }
+        LOGP(detail, "Prefetched {} for {}", path, result.timestamp);
+        mBytes += result.data.size();
+        mResults.emplace(path, std::move(result));
+      }
+    }
+  }
+
+  std::string mCreatedNotAfter;
+  std::string mCreatedNotBefore;
+  size_t mMaxBytes = 0;
+  size_t mBytes = 0;
+  std::unordered_map<std::string, o2::ccdb::CcdbApi> mAPIs;
+  std::vector<Request> mQueue;
+  std::unordered_set<std::string> mPending;
+  std::unordered_map<std::string, Result> mResults;
+  bool mStop = false;
+  std::mutex mMutex;
+  std::condition_variable mCondition;
+  std::thread mThread;
+};
+
 struct CCDBFetcherHelper {
   struct CCDBCacheInfo {
     std::string etag;
@@ -40,6 +196,9 @@ struct CCDBFetcherHelper {
     size_t minSize = -1ULL;
     size_t maxSize = 0;
     int lastCheckedTF = 0;
+    int64_t objectValidUntil = 0;     // end of validity of the cached object, when known
+    int64_t prefetchRequestedFor = 0; // timestamp of the last prefetch request
+    size_t prefetchHit = 0;
   };
 
   struct RemapMatcher {
@@ -61,22 +220,30 @@ struct CCDBFetcherHelper {
   int queryPeriodGlo = 1;
   int queryPeriodFactor = 1;
   int64_t timeToleranceMS = 5000;
+  int64_t prefetchMS = 0;
+  std::unique_ptr<CCDBPrefetcher> prefetcher;
 
-  o2::ccdb::CcdbApi& getAPI(const std::string& path)
+  std::string const& getHost(const std::string& path)
   {
+    static const std::string defaultHost = "";
     // find the first = sign in the string. If present drop everything after it
     // and between it and the previous /.
     auto pos = path.find('=');
     if (pos == std::string::npos) {
       auto entry = remappings.find(path);
-      return apis[entry == remappings.end() ? "" : entry->second];
+      return entry == remappings.end() ? defaultHost : entry->second;
     }
     auto pos2 = path.rfind('/', pos);
     if (pos2 == std::string::npos || pos2 == pos - 1 || pos2 == 0) {
       throw runtime_error_f("Malformed path %s", path.c_str());
     }
     auto entry = remappings.find(path.substr(0, pos2));
-    return apis[entry == remappings.end() ? "" : entry->second];
+    return entry == remappings.end() ? defaultHost : entry->second;
+  }
+
+  o2::ccdb::CcdbApi& getAPI(const std::string& path)
+  {
+    return apis[getHost(path)];
   }
 };
 
@@ -178,9 +345,14 @@ auto getOrbitResetTime(o2::pmr::vector<char> const& v) -> Long64_t
   return (*ctp)[0];
 };
 
+bool isOnlineRun(DeploymentMode mode)
+{
+  return mode == DeploymentMode::OnlineAUX || mode == DeploymentMode::OnlineDDS || mode == DeploymentMode::OnlineECS;
+}
+
 bool isOnlineRun(DataTakingContext const& dtc)
 {
-  return dtc.deploymentMode == DeploymentMode::OnlineAUX || dtc.deploymentMode == DeploymentMode::OnlineDDS || dtc.deploymentMode == DeploymentMode::OnlineECS;
+  return isOnlineRun(dtc.deploymentMode);
 }
 
 auto populateCacheWith(std::shared_ptr<CCDBFetcherHelper> const& helper,
@@ -241,9 +413,29 @@ auto populateCacheWith(std::shared_ptr<CCDBFetcherHelper> const& helper,
     O2_SIGNPOST_EVENT_EMIT(ccdb, sid, "populateCacheWith", "checkValidity is %{public}s for tfID %d of %{public}s", checkValidity ? "true" : "false", timingInfo.tfCounter, path.data());
 
     const auto& api = helper->getAPI(path);
+    // Ask for the object of the next validity interval when the current one is about to end.
+    if (helper->prefetcher && !api.isSnapshotMode() && url2uuid != helper->mapURL2UUID.end()) {
+      auto& info = url2uuid->second;
+      if (info.objectValidUntil > timestamp && info.objectValidUntil - timestamp <= helper->prefetchMS && info.prefetchRequestedFor != info.objectValidUntil) {
+        O2_SIGNPOST_EVENT_EMIT(ccdb, sid, "populateCacheWith", "Prefetching %{public}s for %" PRIi64, path.data(), info.objectValidUntil);
+        info.prefetchRequestedFor = info.objectValidUntil;
+        helper->prefetcher->request({helper->getHost(path), path, metadata, info.objectValidUntil});
+      }
+    }
     if (checkValidity && (!api.isSnapshotMode() || etag.empty())) { // in the snapshot mode the object needs to be fetched only once
-      LOGP(detail, "Loading {} for timestamp {}", path, timestamp);
-      api.loadFileToMemory(v, path, metadata, timestamp, &headers, etag, helper->createdNotAfter, helper->createdNotBefore);
+      if (helper->prefetcher && helper->prefetcher->take(path, timestamp, v, headers)) {
+        LOGP(detail, "Using prefetched {} for timestamp {}", path, timestamp);
+        helper->mapURL2UUID[path].prefetchHit++;
+        if (!etag.empty() && headers["ETag"] == etag) {
+          v.clear(); // same as the cached object, as if the server replied it was not modified
+        }
+      } else {
+        LOGP(detail, "Loading {} for timestamp {}", path, timestamp);
+        api.loadFileToMemory(v, path, metadata, timestamp, &headers, etag, helper->createdNotAfter, helper->createdNotBefore);
+      }
+      if (auto validUntil = headers.find("Valid-Until"); validUntil != headers.end() && !validUntil->second.empty()) {
+        helper->mapURL2UUID[path].objectValidUntil = std::stoll(validUntil->second);
+      }
       if ((headers.count("Error") != 0) || (etag.empty() && v.empty())) {
         LOGP(fatal, "Unable to find object {}/{}", path, timestamp);
         // FIXME: I should send a dummy message.
@@ -303,6 +495,7 @@ AlgorithmSpec CCDBHelpers::fetchFromCCDB()
       auto checkRate = options.get<int>("condition-tf-per-query");
       auto checkMult = options.get<int>("condition-tf-per-query-multiplier");
       helper->timeToleranceMS = options.get<int64_t>("condition-time-tolerance");
+      helper->prefetchMS = options.get<int64_t>("condition-prefetch-ms");
       helper->queryPeriodGlo = checkRate > 0 ? checkRate : std::numeric_limits<int>::max();
       helper->queryPeriodFactor = checkMult > 0 ? checkMult : 1;
       LOGP(info, "CCDB Backend at: {}, validity check for every {} TF{}", defHost, helper->queryPeriodGlo, helper->queryPeriodFactor == 1 ? std::string{} : fmt::format(", (query for high-rate objects downscaled by {})", helper->queryPeriodFactor));
@@ -325,6 +518,15 @@ AlgorithmSpec CCDBHelpers::fetchFromCCDB()
       }
       helper->createdNotBefore = std::to_string(options.get<int64_t>("condition-not-before"));
       helper->createdNotAfter = std::to_string(options.get<int64_t>("condition-not-after"));
+      // Prefetched objects might be superseded by newer uploads when online.
+      if (helper->prefetchMS > 0 && !isOnlineRun(DefaultsHelpers::deploymentMode())) {
+        helper->prefetcher = std::make_unique<CCDBPrefetcher>(helper->createdNotAfter, helper->createdNotBefore, options.get<int64_t>("condition-prefetch-max-bytes"));
+        helper->prefetcher->addHost("", defHost);
+        for (auto& entry : helper->remappings) {
+          helper->prefetcher->addHost(entry.second, entry.second);
+        }
+        LOGP(info, "Prefetching CCDB objects {} ms before the end of their validity", helper->prefetchMS);
+      }
 
       for (auto &route : spec.outputs) {
         if (route.matcher.lifetime != Lifetime::Condition) {
@@ -348,7 +550,7 @@ AlgorithmSpec CCDBHelpers::fetchFromCCDB()
       callbacks.set<CallbackService::Id::Stop>([helper]() {
         LOGP(info, "CCDB cache miss/hit ratio:");
         for (auto& entry : helper->mapURL2UUID) {
-          LOGP(info, "  {}: {}/{} ({}-{} bytes)", entry.first, entry.second.cacheMiss, entry.second.cacheHit, entry.second.minSize, entry.second.maxSize);
+          LOGP(info, "  {}: {}/{} ({}-{} bytes, {} prefetched)", entry.first, entry.second.cacheMiss, entry.second.cacheHit, entry.second.minSize, entry.second.maxSize, entry.second.prefetchHit);
         }
       });
 
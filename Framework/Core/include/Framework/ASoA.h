@@ -1749,6 +1749,37 @@ class Table
     return self_t{mTable->Slice(0, 0), 0};
   }
 
+  /// Contiguous blocks of the persistent columns Cs, split at the chunk boundaries of
+  /// any of them, so that the loops over the values can be vectorized, e.g.
+  ///   for (auto [xs, ys] : table.batches<X, Y>()) { for (auto i = 0U; i < xs.size(); ++i) { ... } }
+  template <typename... Cs>
+  auto batches() const
+  {
+    static_assert(((Cs::persistent::value && std::is_arithmetic_v<typename Cs::type> && !std::is_same_v<typename Cs::type, bool>) && ...), "Batches: only persistent columns of arithmetic, non boolean, type accepted");
+    std::vector<std::tuple<gsl::span<typename Cs::type const>...>> result;
+    std::array<arrow::ChunkedArray*, sizeof...(Cs)> columns{getIndexFromLabel(mTable.get(), Cs::columnLabel())...};
+    std::array<int, sizeof...(Cs)> chunks{};
+    std::array<int64_t, sizeof...(Cs)> positions{};
+    for (int64_t row = 0; row < mTable->num_rows();) {
+      auto length = mTable->num_rows() - row;
+      for (size_t ci = 0; ci < sizeof...(Cs); ++ci) {
+        while (positions[ci] == columns[ci]->chunk(chunks[ci])->length()) {
+          ++chunks[ci];
+          positions[ci] = 0;
+        }
+        length = std::min(length, columns[ci]->chunk(chunks[ci])->length() - positions[ci]);
+      }
+      [&]<size_t... Is>(std::index_sequence<Is...>) {
+        result.emplace_back(gsl::span<typename Cs::type const>{std::static_pointer_cast<arrow_array_for_t<typename Cs::type>>(columns[Is]->chunk(chunks[Is]))->raw_values() + positions[Is], static_cast<size_t>(length)}...);
+      }(std::index_sequence_for<Cs...>{});
+      for (auto& position : positions) {
+        position += length;
+      }
+      row += length;
+    }
+    return result;
+  }
+
  protected:
   /// Offset of the table within a larger table.
   uint64_t mOffset;
@@ -2979,6 +3010,10 @@ class FilteredBase : public T
     return self_t{{this->asArrowTable()}, SelectionVector{}, 0};
   }
 
+  /// The blocks of the underlying table would ignore the selection
+  template <typename... Cs>
+  auto batches() const = delete;
+
   static inline auto getSpan(gandiva::Selection const& sel)
   {
     if (sel == nullptr) {
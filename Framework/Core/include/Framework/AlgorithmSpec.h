@@ -22,6 +22,8 @@
 namespace o2::framework
 {
 
+class BatchProcessingContext;
+
 /// This is the class holding the actual algorithm to be used. Notice that the
 /// InitCallback  can  be  used  to  define stateful  data  as  it  returns  a
 /// ProcessCallback  which will  be invoked  to  do the  data processing.  For
@@ -45,10 +47,18 @@ struct AlgorithmSpec {
   using InitCallback = std::function<ProcessCallback(InitContext&)>;
   using ErrorCallback = std::function<void(ErrorContext&)>;
   using InitErrorCallback = std::function<void(InitErrorContext&)>;
+  using BatchProcessCallback = std::function<void(BatchProcessingContext&)>;
+  using InitBatchCallback = std::function<BatchProcessCallback(InitContext&)>;
 
   static AlgorithmSpec dummyAlgorithm();
   static ErrorCallback& emptyErrorCallback();
   static InitErrorCallback& emptyInitErrorCallback();
+  /// Opt-in variant for lightweight data processors which do not create
+  /// outputs themselves, e.g. sinks and writers. The callback returned by
+  /// @a init is invoked once per wake-up of the device with all the
+  /// timeslices which are ready at that moment, so that the per timeslice
+  /// overhead of invoking the user code is paid only once.
+  static AlgorithmSpec batch(InitBatchCallback init, ErrorCallback& error = emptyErrorCallback());
 
   AlgorithmSpec() = default;
 
@@ -77,6 +87,7 @@ struct AlgorithmSpec {
   ProcessCallback onProcess = nullptr;
   ErrorCallback onError = nullptr;
   InitErrorCallback onInitError = nullptr;
+  InitBatchCallback onInitBatch = nullptr;
 };
 
 /// Helper class for an algorithm which is loaded as a plugin.
@@ -121,6 +121,13 @@ struct AnalysisDataProcessorBuilder {
     }(framework::pack<Args...>{});
   }
 
+  /// declare the persistent columns of a subscribed table, the AOD reader reads only the columns declared by the subscribers
+  template <typename... C>
+  static void addColumnsMetadata(std::vector<ConfigParamSpec>& inputMetadata, framework::pack<C...>)
+  {
+    (inputMetadata.emplace_back(ConfigParamSpec{std::string{"column:"} + C::columnLabel(), VariantType::Bool, true, {"\"\""}}), ...);
+  }
+
   template <typename O>
   static void addOriginal(const char* name, bool value, std::vector<InputSpec>& inputs) requires soa::is_type_with_metadata_v<aod::MetadataTrait<std::decay_t<O>>>
   {
@@ -130,6 +137,8 @@ struct AnalysisDataProcessorBuilder {
     if constexpr (soa::is_soa_index_table_v<std::decay_t<O>> || soa::is_soa_extension_table_v<std::decay_t<O>>) {
       auto inputSources = getInputMetadata<std::decay_t<O>>();
       inputMetadata.insert(inputMetadata.end(), inputSources.begin(), inputSources.end());
+    } else {
+      addColumnsMetadata(inputMetadata, typename std::decay_t<O>::persistent_columns_t{});
     }
     DataSpecUtils::updateInputList(inputs, InputSpec{metadata::tableLabel(), metadata::origin(), metadata::description(), metadata::version(), Lifetime::Timeframe, inputMetadata});
   }
@@ -23,6 +23,8 @@ using ListVector = std::vector<std::vector<int64_t>>;
 struct SliceInfoPtr {
   gsl::span<int const> values;
   gsl::span<int64_t const> counts;
+  gsl::span<int64_t const> offsets; // first row of each group
+  gsl::span<int const> indices;     // group of each non-negative value, -1 if absent
 
   std::pair<int64_t, int64_t> getSliceFor(int value) const;
 };
@@ -51,8 +53,10 @@ struct ArrowTableSlicingCache {
   constexpr static ServiceKind service_kind = ServiceKind::Stream;
 
   std::vector<StringPair> bindingsKeys;
-  std::vector<std::shared_ptr<arrow::NumericArray<arrow::Int32Type>>> values;
-  std::vector<std::shared_ptr<arrow::NumericArray<arrow::Int64Type>>> counts;
+  std::vector<std::vector<int>> values;
+  std::vector<std::vector<int64_t>> counts;
+  std::vector<std::vector<int64_t>> offsets;
+  std::vector<std::vector<int>> indices;
 
   std::vector<StringPair> bindingsKeysUnsorted;
   std::vector<std::vector<int>> valuesUnsorted;
@@ -12,17 +12,36 @@
 #define O2_FRAMEWORK_ASYNCQUUE_H_
 
 #include "Framework/TimesliceSlot.h"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 namespace o2::framework
 {
 
+/// Where the tasks of a given AsyncTaskSpec are allowed to run.
+enum struct AsyncTaskAffinity : char {
+  /// On the thread invoking AsyncQueueHelpers::run, i.e. the one
+  /// processing the stream. Needed e.g. to use the FairMQ channels.
+  Stream,
+  /// On any of the workers of the queue, so that they do not
+  /// delay the processing.
+  Any
+};
+
 struct AsyncTaskSpec {
   std::string name;
   // Its priority compared to the other tasks
   int score = 0;
+  AsyncTaskAffinity affinity = AsyncTaskAffinity::Stream;
 };
 
 /// The position of the TaskSpec in the prototypes
@@ -30,6 +49,62 @@ struct AsyncTaskId {
   int value = -1;
 };
 
+/// A bounded pool of threads executing the tasks with AsyncTaskAffinity::Any.
+/// Tasks with the same id are executed one after the other, in the order
+/// they were scheduled, while tasks with different ids can run concurrently.
+/// Among the tasks ready to run, the ones with the highest score go first.
+class AsyncWorkerPool
+{
+ public:
+  using Callback = std::function<void(size_t)>;
+
+  explicit AsyncWorkerPool(size_t maxWorkers);
+  /// Waits for the scheduled tasks to complete.
+  ~AsyncWorkerPool();
+  AsyncWorkerPool(AsyncWorkerPool const&) = delete;
+  AsyncWorkerPool& operator=(AsyncWorkerPool const&) = delete;
+
+  /// Schedule @a task for execution. @a signpostId is passed to the task.
+  /// Workers are started on demand, up to the maximum.
+  void schedule(AsyncTaskId id, int score, Callback task, size_t signpostId);
+  /// Block until all the scheduled tasks are done.
+  void drain();
+
+  [[nodiscard]] size_t maxWorkers() const { return mMaxWorkers; }
+
+ private:
+  struct Pending {
+    Callback task;
+    size_t signpostId;
+  };
+  struct Ready {
+    int score;
+    uint64_t sequence;
+    int id;
+    // Highest score first, then first come first served.
+    bool operator<(Ready const& other) const
+    {
+      return score == other.score ? sequence > other.sequence : score < other.score;
+    }
+  };
+
+  void work();
+
+  std::mutex mMutex;
+  std::condition_variable mWakeUp;
+  std::condition_variable mIdle;
+  /// Tasks not yet started, per id.
+  std::unordered_map<int, std::deque<Pending>> mPending;
+  /// Ids with one of their tasks ready or running. Only one per id is.
+  std::priority_queue<Ready> mReady;
+  std::vector<std::thread> mWorkers;
+  size_t mMaxWorkers;
+  size_t mOutstanding = 0;
+  size_t mIdleWorkers = 0;
+  uint64_t mSequence = 0;
+  bool mStop = false;
+};
+
 /// An actuatual task to be executed
 struct AsyncTask {
   // The task to be executed. Id can be used as unique
@@ -47,6 +122,10 @@ struct AsyncQueue {
   std::vector<AsyncTaskSpec> prototypes;
   std::vector<AsyncTask> tasks;
   size_t iteration = 0;
+  /// Maximum number of threads for the tasks which can run anywhere.
+  size_t maxWorkers = 2;
+  /// Created the first time a task which can run anywhere is executed.
+  std::unique_ptr<AsyncWorkerPool> workers;
 };
 
 struct AsyncQueueHelpers {
@@ -60,9 +139,12 @@ struct AsyncQueueHelpers {
   /// 1. sorting the tasks by timeslice
   /// 2. then priority
   /// 3. only execute the highest (timeslice, debounce) value
+  /// Tasks with AsyncTaskAffinity::Any are handed over to the workers
+  /// rather than executed, so whatever they capture must outlive them.
   static void run(AsyncQueue& queue, TimesliceId oldestPossibleTimeslice);
 
-  /// Reset the queue to its initial state
+  /// Reset the queue to its initial state, waiting for
+  /// the tasks handed over to the workers to complete.
   static void reset(AsyncQueue& queue);
 };
 
@@ -0,0 +1,49 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_BATCHPROCESSINGCONTEXT_H_
+#define O2_FRAMEWORK_BATCHPROCESSINGCONTEXT_H_
+
+#include "Framework/InputRecord.h"
+#include "Framework/ServiceRegistryRef.h"
+#include <gsl/span>
+
+namespace o2::framework
+{
+
+// Context passed to the callback of a data processor which asked to
+// process the timeslices in batches (see AlgorithmSpec::batch). It holds
+// the inputs of all the timeslices which were ready when the device
+// was woken up, in dispatching order.
+class BatchProcessingContext
+{
+ public:
+  BatchProcessingContext(gsl::span<InputRecord> inputs, ServiceRegistryRef services)
+    : mInputs(inputs),
+      mServices(services)
+  {
+  }
+
+  /// The number of timeslices in this batch.
+  [[nodiscard]] size_t size() const { return mInputs.size(); }
+  /// The inputs associated to the @a i-th timeslice of this batch.
+  InputRecord& inputs(size_t i) { return mInputs[i]; }
+  /// The inputs associated to all the timeslices of this batch.
+  gsl::span<InputRecord> inputs() { return mInputs; }
+  /// The services registry associated with this processing context.
+  ServiceRegistryRef services() { return mServices; }
+
+  gsl::span<InputRecord> mInputs;
+  ServiceRegistryRef mServices;
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_BATCHPROCESSINGCONTEXT_H_
@@ -64,6 +64,9 @@ struct InputChannelInfo {
   /// Oldest possible timeslice for the given channel
   TimesliceId oldestForChannel;
   int pollerIndex = -1;
+  /// uv_hrtime() at which the oldest part still in parts was received,
+  /// used for the receive to relay latency.
+  uint64_t receivedTime = 0;
 };
 
 struct SendingPolicy;
@@ -477,6 +477,11 @@ class DataAllocator
   /// Adopt an already cached message, using an already provided CacheId.
   void adoptFromCache(Output const& spec, CacheId id, header::SerializationMethod method = header::gSerializationMethodNone);
 
+  /// Send the already existing message @a payload, e.g. the one of an input, to
+  /// the output @a spec. When the output uses the same transport as @a payload,
+  /// the new message refers to the same buffer and no payload is copied.
+  void forward(Output const& spec, fair::mq::Message const& payload, header::SerializationMethod method = header::gSerializationMethodNone);
+
   /// snapshot object and route to output specified by OutputRef
   /// Framework makes a (serialized) copy of object content.
   ///
@@ -78,6 +78,8 @@ struct DataOutputDirector {
   void setNumberTimeFramesToMerge(int ntfmerge) { mnumberTimeFramesToMerge = ntfmerge > 0 ? ntfmerge : 1; }
   std::string getFileMode() { return mfileMode; }
   void setFileMode(std::string filemode) { mfileMode = filemode; }
+  int getNumberWriterThreads() { return mnumberWriterThreads; }
+  void setNumberWriterThreads(int nthreads) { mnumberWriterThreads = nthreads > 0 ? nthreads : 0; }
 
   // get matching DataOutputDescriptors
   std::vector<DataOutputDescriptor*> getDataOutputDescriptors(header::DataHeader dh);
@@ -111,6 +113,7 @@ struct DataOutputDirector {
   int mfileCounter = 1;
   float mmaxfilesize = -1.;
   int mnumberTimeFramesToMerge = 1;
+  int mnumberWriterThreads = 0;
   std::string mfileMode = "RECREATE";
 
   std::tuple<std::string, std::string, std::string, float, int> readJsonDocument(Document* doc);
@@ -44,6 +44,8 @@ struct DataProcessorContext {
   AlgorithmSpec::InitCallback init;
   AlgorithmSpec::ProcessCallback statefulProcess;
   AlgorithmSpec::ProcessCallback statelessProcess;
+  /// Set instead of the two above for data processors processing timeslices in batches
+  AlgorithmSpec::BatchProcessCallback batchProcess;
   AlgorithmSpec::ErrorCallback error = nullptr;
   AlgorithmSpec::InitErrorCallback initError = nullptr;
 
@@ -64,7 +64,98 @@ enum struct ProcessingStatsId : short {
   RESOURCES_MISSING,
   RESOURCES_INSUFFICIENT,
   RESOURCES_SATISFACTORY,
+  ADMISSION_TF_FOOTPRINT,
+  ADMISSION_CONSUMPTION_RATE_MHZ,
+  ADMISSION_DELAY_US,
   AVAILABLE_MANAGED_SHM_BASE = 512,
+  // The percentiles of the latency histograms, see DataProcessingStats::LatencyStage
+  LATENCY_PERCENTILES_BASE = 1024,
+};
+
+/// HDR-like histogram of latencies in microseconds. Values below 16us are
+/// counted exactly, above that each power of two is split in 8 buckets, so that
+/// the tail is resolved with a relative precision of 12.5% up to ~12 days.
+/// Recording a value is a single relaxed atomic increment, so that it can be
+/// done on the hot path and from any thread.
+struct LatencyHistogram {
+  constexpr static int SUB_BUCKET_BITS = 3;
+  constexpr static int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+  constexpr static int LINEAR_BUCKETS = 2 * SUB_BUCKETS;
+  constexpr static int MAX_EXPONENT = 40;
+  constexpr static size_t N_BUCKETS = LINEAR_BUCKETS + (MAX_EXPONENT - SUB_BUCKET_BITS - 1) * SUB_BUCKETS;
+
+  struct Summary {
+    uint64_t count = 0;
+    uint64_t p50 = 0;
+    uint64_t p99 = 0;
+    uint64_t p999 = 0;
+    uint64_t max = 0;
+  };
+
+  static size_t bucketIndex(uint64_t value)
+  {
+    if (value < LINEAR_BUCKETS) {
+      return value;
+    }
+    int msb = 63 - __builtin_clzll(value);
+    if (msb >= MAX_EXPONENT) {
+      return N_BUCKETS - 1;
+    }
+    int shift = msb - SUB_BUCKET_BITS;
+    size_t sub = (value >> shift) & (SUB_BUCKETS - 1);
+    return LINEAR_BUCKETS + (msb - SUB_BUCKET_BITS - 1) * SUB_BUCKETS + sub;
+  }
+
+  /// @return the largest value which ends up in bucket @a index
+  static uint64_t bucketUpperBound(size_t index)
+  {
+    if (index < LINEAR_BUCKETS) {
+      return index;
+    }
+    int shift = (index - LINEAR_BUCKETS) / SUB_BUCKETS + 1;
+    uint64_t sub = (index - LINEAR_BUCKETS) % SUB_BUCKETS;
+    return ((SUB_BUCKETS + sub + 1) << shift) - 1;
+  }
+
+  void record(uint64_t value)
+  {
+    buckets[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /// Compute the percentiles of the values recorded so far. The percentiles are
+  /// the upper bound of the bucket, i.e. they are never underestimated.
+  /// @a reset whether to start a new measurement interval.
+  Summary summarize(bool reset)
+  {
+    std::array<uint64_t, N_BUCKETS> counts;
+    Summary summary;
+    for (size_t i = 0; i < N_BUCKETS; ++i) {
+      counts[i] = reset ? buckets[i].exchange(0, std::memory_order_relaxed) : buckets[i].load(std::memory_order_relaxed);
+      summary.count += counts[i];
+    }
+    if (summary.count == 0) {
+      return summary;
+    }
+    // Number of entries at or below the given percentile, rounded up.
+    auto rank = [count = summary.count](uint64_t permille) { return (count * permille + 999) / 1000; };
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < N_BUCKETS; ++i) {
+      if (counts[i] == 0) {
+        continue;
+      }
+      uint64_t previous = cumulative;
+      cumulative += counts[i];
+      auto upper = bucketUpperBound(i);
+      summary.p50 = previous < rank(500) ? upper : summary.p50;
+      summary.p99 = previous < rank(990) ? upper : summary.p99;
+      // For the 99.9 percentile we use tenths of permille.
+      summary.p999 = previous * 10000 < summary.count * 9990 ? upper : summary.p999;
+      summary.max = upper;
+    }
+    return summary;
+  }
+
+  std::array<std::atomic<uint64_t>, N_BUCKETS> buckets = {};
 };
 
 /// Helper struct to hold statistics about the data processing happening.
@@ -170,6 +261,33 @@ struct DataProcessingStats {
 
   void flushChangedMetrics(std::function<void(MetricSpec const&, int64_t, int64_t)> const& callback);
 
+  /// The stages of the processing for which we keep a latency histogram.
+  enum struct LatencyStage : short {
+    ReceiveToRelay,   /// From the moment a message is read from the channel to when it is relayed
+    RelayToDispatch,  /// From the last relayed message of a slot to the moment the computation is dispatched
+    Callback,         /// Time spent in the processing callback
+    OutputSend,       /// Time needed to hand the outputs over to the channel
+    Count
+  };
+  constexpr static std::array<char const*, (size_t)LatencyStage::Count> latencyStageNames = {"receive_to_relay", "relay_to_dispatch", "callback", "output_send"};
+  /// Number of metrics published for each stage: p50, p99, p99.9 and max, in microseconds.
+  constexpr static short LATENCY_METRICS_PER_STAGE = 4;
+
+  /// Record a latency in microseconds for the given stage.
+  void recordLatency(LatencyStage stage, uint64_t us)
+  {
+    latencies[(size_t)stage].record(us);
+  }
+
+  /// Publish the percentiles of the latencies recorded since the last time,
+  /// as LATENCY_PERCENTILES_BASE metrics, if at least latencyPublishInterval ms passed.
+  /// Requires the latency metrics to be registered.
+  void publishLatencies();
+
+  std::array<LatencyHistogram, (size_t)LatencyStage::Count> latencies;
+  int64_t latencyPublishInterval = 1000;
+  int64_t lastLatencyPublished = 0;
+
   std::atomic<size_t> statesSize = 0;
 
   std::array<Command, MAX_CMDS> cmds = {};
@@ -13,6 +13,7 @@
 
 #include "Framework/RootSerializationSupport.h"
 #include "Framework/InputRoute.h"
+#include "Framework/InputRouteIndex.h"
 #include "Framework/DataDescriptorMatcher.h"
 #include "Framework/ForwardRoute.h"
 #include "Framework/CompletionPolicy.h"
@@ -24,6 +25,7 @@
 
 #include <cstddef>
 #include <mutex>
+#include <shared_mutex>
 #include <vector>
 #include <functional>
 
@@ -79,6 +81,8 @@ class DataRelayer
     TimesliceSlot slot;
     TimesliceId timeslice;
     CompletionPolicy::CompletionOp op;
+    /// uv_hrtime() of the last time something was relayed in the slot.
+    uint64_t relayTime = 0;
   };
 
   enum struct InputType : int {
@@ -187,6 +191,14 @@ class DataRelayer
   /// e.g. as consequnce of an OOB event.
   void rescan() { mTimesliceIndex.rescan(); };
 
+  /// Give back a slot which was reported as ready by getReadyToProcess but
+  /// which was not processed, so that it is reported again, possibly to a
+  /// different stream.
+  void requeue(TimesliceSlot slot);
+
+  /// Lookup tables for the inputs, to be shared with the InputRecord.
+  [[nodiscard]] InputRouteIndex const& getInputRouteIndex() const { return mRouteIndex; }
+
   [[nodiscard]] size_t getCacheSize() const { return mCache.size(); }
   [[nodiscard]] size_t getNumberOfTimeslices() const { return mTimesliceIndex.size(); }
   [[nodiscard]] size_t getNumberOfUniqueInputs() const { return mDistinctRoutesIndex.size(); }
@@ -208,12 +220,21 @@ class DataRelayer
   std::vector<size_t> mDistinctRoutesIndex;
   std::vector<InputSpec> mInputs;
   std::vector<data_matcher::DataDescriptorMatcher> mInputMatchers;
+  InputRouteIndex mRouteIndex;
   std::vector<data_matcher::VariableContext> mVariableContextes;
   std::vector<CacheEntryStatus> mCachedStateMetrics;
   std::vector<PruneOp> mPruneOps;
+  /// uv_hrtime() of the last relayed message, per slot.
+  std::vector<uint64_t> mSlotRelayTimes;
   size_t mMaxLanes;
 
-  O2_LOCKABLE_NAMED(std::recursive_mutex, mMutex, "data relayer mutex");
+  /// Taken exclusively by anything which looks at more than one slot
+  /// or changes the slot assignment. relay() holds it shared while adding
+  /// data to a slot which is already in flight, locking only that slot.
+  O2_LOCKABLE_NAMED(std::shared_mutex, mMutex, "data relayer mutex");
+  /// One per slot, protects the cache entries and the VariableContext of
+  /// the slot while the relayer mutex is held shared.
+  std::vector<std::mutex> mSlotMutexes;
 };
 
 } // namespace o2::framework
@@ -240,6 +240,10 @@ struct DataSpecUtils {
   /// via 'and' operation
   static std::optional<framework::ConcreteDataMatcher> optionalConcreteDataMatcherFrom(data_matcher::DataDescriptorMatcher const& matcher);
 
+  /// return the data type if DataMatcher is connecting unique origin and description
+  /// via 'and' operation, i.e. if any data it matches has the given origin and description.
+  static std::optional<framework::ConcreteDataTypeMatcher> optionalConcreteDataTypeMatcherFrom(data_matcher::DataDescriptorMatcher const& matcher);
+
   /// Checks if left includes right (or is equal to)
   static bool includes(const InputSpec& left, const InputSpec& right);
 
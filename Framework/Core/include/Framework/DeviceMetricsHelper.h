@@ -25,6 +25,7 @@
 namespace o2::framework
 {
 struct DriverInfo;
+struct MetricRecord;
 
 struct DeviceMetricsHelper {
   /// Type of the callback which can be provided to be invoked every time a new
@@ -42,6 +43,12 @@ struct DeviceMetricsHelper {
   static bool processMetric(ParsedMetricMatch& results,
                             DeviceMetricsInfo& info,
                             NewMetricCallback newMetricCallback = nullptr);
+
+  /// Processes a binary metric record, as received via the shared memory ring
+  /// of the device, and stores it in the backend store. No parsing is needed.
+  static bool processMetric(MetricRecord const& record,
+                            DeviceMetricsInfo& info,
+                            NewMetricCallback newMetricCallback = nullptr);
   /// @return the index in metrics for the information of given metric
   static size_t metricIdxByName(const std::string& name,
                                 const DeviceMetricsInfo& info);
@@ -0,0 +1,168 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_DEVICEMETRICSRINGBUFFER_H_
+#define O2_FRAMEWORK_DEVICEMETRICSRINGBUFFER_H_
+
+#include "Framework/DeviceMetricsInfo.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace o2::framework
+{
+
+/// A fixed size, binary representation of a numeric metric,
+/// so that it can be passed from a device to the driver
+/// without formatting and parsing it as a string.
+struct MetricRecord {
+  static constexpr size_t MAX_KEY_SIZE = 107;
+  uint64_t timestamp = 0;
+  union {
+    int intValue;
+    float floatValue;
+    uint64_t uint64Value = 0;
+  };
+  MetricType type = MetricType::Unknown;
+  unsigned char keySize = 0;
+  char key[MAX_KEY_SIZE];
+
+  /// @return false if the key does not fit in the record.
+  bool setKey(std::string_view name)
+  {
+    if (name.size() > MAX_KEY_SIZE) {
+      return false;
+    }
+    memcpy(key, name.data(), name.size());
+    keySize = name.size();
+    return true;
+  }
+};
+
+static_assert(std::is_trivially_copyable_v<MetricRecord>, "MetricRecord must be trivially copyable");
+static_assert(sizeof(MetricRecord) == 128, "MetricRecord should fill two cache lines");
+
+/// Single producer, single consumer, lock free queue of MetricRecords,
+/// living in a memory region which is not owned by the ring itself.
+/// Since it only uses lock free atomics, the memory region can be
+/// shared between different processes, where the device is the producer
+/// and the driver the consumer.
+class DeviceMetricsRingBuffer
+{
+ public:
+  struct Header {
+    // head and tail on different cache lines, to avoid false sharing
+    // between the producer and the consumer.
+    alignas(64) std::atomic<uint64_t> head;
+    alignas(64) std::atomic<uint64_t> tail;
+    alignas(64) uint64_t capacity;
+    std::atomic<uint64_t> dropped;
+  };
+  static_assert(std::atomic<uint64_t>::is_always_lock_free, "Lock free atomics are needed for interprocess communication");
+
+  /// @return the size of the memory region needed for @a capacity records
+  static constexpr size_t sizeForCapacity(size_t capacity)
+  {
+    return sizeof(Header) + capacity * sizeof(MetricRecord);
+  }
+
+  /// @a initialise should be true only for the side which creates the memory region.
+  DeviceMetricsRingBuffer(void* memory, size_t capacity, bool initialise)
+    : mHeader{reinterpret_cast<Header*>(memory)},
+      mRecords{reinterpret_cast<MetricRecord*>(reinterpret_cast<char*>(memory) + sizeof(Header))}
+  {
+    if (initialise) {
+      new (mHeader) Header{};
+      mHeader->head.store(0, std::memory_order_relaxed);
+      mHeader->tail.store(0, std::memory_order_relaxed);
+      mHeader->capacity = capacity;
+      mHeader->dropped.store(0, std::memory_order_release);
+    }
+  }
+
+  /// Append a record. To be invoked only by the producer.
+  /// @return false if the ring is full. The caller can then
+  ///         decide to send the metric via some other channel.
+  bool push(MetricRecord const& record)
+  {
+    auto head = mHeader->head.load(std::memory_order_relaxed);
+    if (head - mHeader->tail.load(std::memory_order_acquire) >= mHeader->capacity) {
+      mHeader->dropped.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    mRecords[head % mHeader->capacity] = record;
+    mHeader->head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Invoke @a callback on all the records currently available
+  /// and release them. To be invoked only by the consumer.
+  /// @return the number of records consumed.
+  template <typename F>
+  size_t consume(F&& callback)
+  {
+    auto tail = mHeader->tail.load(std::memory_order_relaxed);
+    auto head = mHeader->head.load(std::memory_order_acquire);
+    for (auto pos = tail; pos != head; ++pos) {
+      callback(mRecords[pos % mHeader->capacity]);
+    }
+    mHeader->tail.store(head, std::memory_order_release);
+    return head - tail;
+  }
+
+  /// @return how many records could not be pushed because the ring was full.
+  uint64_t dropped() const { return mHeader->dropped.load(std::memory_order_relaxed); }
+  size_t capacity() const { return mHeader->capacity; }
+
+ private:
+  Header* mHeader;
+  MetricRecord* mRecords;
+};
+
+/// A DeviceMetricsRingBuffer in a POSIX shared memory segment.
+/// The driver creates one segment per device, the device opens it
+/// by name. The segment is unlinked when the creator goes away.
+class DeviceMetricsSharedMemory
+{
+ public:
+  /// Name of the environment variable used to pass the segment name to the device.
+  static constexpr char const* ENV_NAME = "DPL_METRICS_SHM";
+
+  /// Create a new segment which can hold @a capacity records.
+  static std::unique_ptr<DeviceMetricsSharedMemory> create(std::string const& name, size_t capacity);
+  /// Attach to an already existing segment.
+  static std::unique_ptr<DeviceMetricsSharedMemory> open(std::string const& name);
+
+  ~DeviceMetricsSharedMemory();
+  DeviceMetricsSharedMemory(DeviceMetricsSharedMemory const&) = delete;
+  DeviceMetricsSharedMemory& operator=(DeviceMetricsSharedMemory const&) = delete;
+
+  DeviceMetricsRingBuffer& ring() { return mRing; }
+  std::string const& name() const { return mName; }
+
+ private:
+  DeviceMetricsSharedMemory(std::string name, void* memory, size_t size, size_t capacity, bool owner);
+
+  std::string mName;
+  void* mMemory;
+  size_t mSize;
+  bool mOwner;
+  DeviceMetricsRingBuffer mRing;
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_DEVICEMETRICSRINGBUFFER_H_
@@ -94,6 +94,9 @@ struct DeviceState {
   std::vector<uv_poll_t*> activeOutOfBandPollers;
 
   uv_async_t* awakeMainThread = nullptr;
+  /// Number of streams which are not running, i.e. which could take
+  /// a computation handed back by a busy stream.
+  std::atomic<int> idleStreams = 0;
 
   // A list of states which we should go to
   std::vector<std::string> nextFairMQState;
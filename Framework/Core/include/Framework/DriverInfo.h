@@ -12,7 +12,9 @@
 #ifndef O2_FRAMEWORK_DRIVERINFO_H_
 #define O2_FRAMEWORK_DRIVERINFO_H_
 
+#include <array>
 #include <cstddef>
+#include <cstdint>
 #include <vector>
 
 #include <csignal>
@@ -126,6 +128,11 @@ struct DriverInfo {
   uint64_t startTime;
   /// The actual time in milliseconds from epoch at which the process was started.
   uint64_t startTimeMsFromEpoch;
+  /// Time spent in each of the states, in nanoseconds. Used
+  /// to report how long the various startup phases take.
+  std::array<uint64_t, static_cast<int>(DriverState::LAST)> stateDurations = {};
+  /// Whether the startup report was already printed.
+  bool startupReported = false;
   /// The optional timeout after which the driver will request
   /// all the children to quit.
   double timeout;
@@ -41,6 +41,7 @@ class Projector;
 #include <string>
 #include <memory>
 #include <set>
+#include <vector>
 namespace gandiva
 {
 using Selection = std::shared_ptr<gandiva::SelectionVector>;
@@ -48,6 +49,18 @@ using FilterPtr = std::shared_ptr<gandiva::Filter>;
 } // namespace gandiva
 
 using atype = arrow::Type;
+
+namespace o2::framework::expressions
+{
+/// A comparison of a floating point column with a literal, the building block of simple range filters
+struct ColumnCut {
+  std::string column;
+  BasicOp op;                   // comparison, with the column on the left-hand side
+  double value;                 // literal value
+  atype::type type = atype::NA; // literal type
+};
+} // namespace o2::framework::expressions
+
 struct ExpressionInfo {
   ExpressionInfo(int ai, size_t hash, std::set<uint32_t>&& hs, gandiva::SchemaPtr sc)
     : argumentIndex(ai),
@@ -64,6 +77,9 @@ struct ExpressionInfo {
   gandiva::FilterPtr filter = nullptr;
   gandiva::Selection selection = nullptr;
   bool resetSelection = false;
+  /// if all the filters attached are conjunctions of column cuts, they are evaluated natively instead of with gandiva
+  std::vector<o2::framework::expressions::ColumnCut> cuts;
+  bool simpleCuts = true;
 };
 
 namespace o2::framework::expressions
@@ -436,6 +452,12 @@ using Operations = std::vector<ColumnOperationSpec>;
 /// Function to create an internal operation sequence from a filter tree
 Operations createOperations(Filter const& expression);
 
+/// Function to extract the column cuts of an operation sequence, which succeeds only if the
+/// expression is a logical 'and' of comparisons of float or double columns with literals
+bool extractColumnCuts(Operations const& opSpecs, std::vector<ColumnCut>& cuts);
+/// Function for creating selection from column cuts, without gandiva
+gandiva::Selection createSelection(std::shared_ptr<arrow::Table> const& table, std::vector<ColumnCut> const& cuts);
+
 /// Function to check compatibility of a given arrow schema with operation sequence
 bool isTableCompatible(std::set<uint32_t> const& hashes, Operations const& specs);
 /// Function to create gandiva expression tree from operation sequence
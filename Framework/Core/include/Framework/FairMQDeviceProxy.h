@@ -20,6 +20,8 @@
 #include "Framework/InputRoute.h"
 #include "Framework/ForwardRoute.h"
 #include <fairmq/FwdDecls.h>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 namespace o2::header
@@ -27,6 +29,11 @@ namespace o2::header
 struct DataHeader;
 };
 
+namespace o2::pmr
+{
+class MessageArena;
+}
+
 namespace o2::framework
 {
 /// Helper class to hide fair::mq::Device headers in the DataAllocator header.
@@ -35,8 +42,9 @@ namespace o2::framework
 class FairMQDeviceProxy
 {
  public:
-  FairMQDeviceProxy() = default;
+  FairMQDeviceProxy();
   FairMQDeviceProxy(FairMQDeviceProxy const&) = delete;
+  ~FairMQDeviceProxy();
   void bind(std::vector<OutputRoute> const& outputs, std::vector<InputRoute> const& inputs,
             std::vector<ForwardRoute> const& forwards, fair::mq::Device& device);
 
@@ -78,6 +86,14 @@ class FairMQDeviceProxy
   [[nodiscard]] std::unique_ptr<fair::mq::Message> createOutputMessage(RouteIndex routeIndex) const;
   [[nodiscard]] std::unique_ptr<fair::mq::Message> createOutputMessage(RouteIndex routeIndex, const size_t size) const;
 
+  /// Sub-allocate output messages up to @a maxMessageSize bytes out of an arena of
+  /// @a nBlocks blocks of @a blockSize bytes for each output transport, rather than
+  /// creating each of them in the shared memory segment. Takes effect at the next bind.
+  void setOutputArena(size_t blockSize, size_t nBlocks, size_t maxMessageSize);
+  /// Start a new block of the output arenas, so that the outputs of a timeslice are
+  /// grouped together and released at about the same time.
+  void newOutputArenaBlock();
+
   [[nodiscard]] std::unique_ptr<fair::mq::Message> createInputMessage(RouteIndex routeIndex) const;
   [[nodiscard]] std::unique_ptr<fair::mq::Message> createInputMessage(RouteIndex routeIndex, const size_t size) const;
 
@@ -107,6 +123,13 @@ class FairMQDeviceProxy
   std::vector<ForwardChannelState> mForwardChannelStates;
 
   std::function<bool()> mStateChangeCallback;
+
+  size_t mArenaBlockSize = 0;
+  size_t mArenaBlocks = 0;
+  size_t mArenaMaxMessageSize = 0;
+  /// One per output transport. Messages can be created concurrently by the streams.
+  std::vector<std::unique_ptr<o2::pmr::MessageArena>> mOutputArenas;
+  mutable std::mutex mArenaMutex;
 };
 
 } // namespace o2::framework
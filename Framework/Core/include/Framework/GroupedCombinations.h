@@ -17,6 +17,7 @@
 #include "Framework/Pack.h"
 #include "Framework/SliceCache.h"
 #include <optional>
+#include <vector>
 
 namespace o2::framework
 {
@@ -94,6 +95,8 @@ struct GroupedCombinationsGenerator {
         mGrouping = std::make_shared<G>(std::vector{grouping.asArrowTable()});
       }
       mAssociated = std::make_shared<std::tuple<As...>>(std::make_tuple(std::get<has_type_at<As>(pack<T2s...>{})>(associated)...));
+      // new tables, the slices of the previous ones cannot be reused
+      mSlicesCache = std::make_shared<SlicesCache>();
       setMultipleGroupingTables<sizeof...(As)>(grouping);
       if (!this->mIsEnd) {
         setCurrentGroupedCombination();
@@ -164,7 +167,15 @@ struct GroupedCombinationsGenerator {
       if (std::get<I>(*mAssociated).size() == 0) {
         return std::get<I>(*mAssociated);
       }
-      return std::get<I>(*mAssociated).sliceByCached(mIndexColumns[I], ind, *cache);
+      // each collision is mixed with many others, slice its associated tables only once per dataframe
+      auto& slices = std::get<I>(*mSlicesCache);
+      if (ind >= slices.size()) {
+        slices.resize(std::max<size_t>(ind + 1, mGrouping->tableSize()));
+      }
+      if (!slices[ind].has_value()) {
+        slices[ind].emplace(std::get<I>(*mAssociated).sliceByCached(mIndexColumns[I], ind, *cache));
+      }
+      return *slices[ind];
     }
 
     void setCurrentGroupedCombination()
@@ -176,9 +187,12 @@ struct GroupedCombinationsGenerator {
       }
     }
 
+    using SlicesCache = std::tuple<std::vector<std::optional<As>>...>;
+
     std::array<expressions::BindingNode, sizeof...(As)> mIndexColumns;
     std::shared_ptr<G> mGrouping;
     std::shared_ptr<std::tuple<As...>> mAssociated;
+    std::shared_ptr<SlicesCache> mSlicesCache = std::make_shared<SlicesCache>(); // shared by the copies of the iterator
     std::optional<std::tuple<As...>> mSlices;
     std::optional<GroupedIteratorType> mCurrentGrouped;
     SliceCache* cache = nullptr;
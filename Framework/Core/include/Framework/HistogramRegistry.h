@@ -49,6 +49,11 @@ struct HistFiller {
   static void fillHistAny(std::shared_ptr<T> hist, Ts... positionAndWeight)
     requires(FillValue<Ts> && ...);
 
+  // fill any type of histogram with spans of values of the same size, e.g. the blocks of Table::batches (if weight was requested it must be the last span)
+  template <typename T, typename... Vs>
+  static void fillHistAny(std::shared_ptr<T> hist, gsl::span<Vs const>... positionsAndWeights)
+    requires(sizeof...(Vs) > 0 && (FillValue<Vs> && ...));
+
   // fill any type of histogram with columns (Cs) of a filtered table (if weight is requested it must reside the last specified column)
   template <typename... Cs, typename R, typename T>
   static void fillHistAny(std::shared_ptr<R> hist, const T& table, const o2::framework::expressions::Filter& filter);
@@ -135,6 +140,11 @@ class HistogramRegistry
   void fill(const HistName& histName, Ts... positionAndWeight)
     requires(FillValue<Ts> && ...);
 
+  // fill hist with spans of values, looking up the histogram once for all of them
+  template <typename... Vs>
+  void fill(const HistName& histName, gsl::span<Vs const>... positionsAndWeights)
+    requires(sizeof...(Vs) > 0 && (FillValue<Vs> && ...));
+
   // fill hist with content of (filtered) table columns
   template <typename... Cs, typename T>
   void fill(const HistName& histName, const T& table, const o2::framework::expressions::Filter& filter);
@@ -239,6 +249,19 @@ void HistFiller::fillHistAny(std::shared_ptr<T> hist, Ts... positionAndWeight)
   }
 }
 
+template <typename T, typename... Vs>
+void HistFiller::fillHistAny(std::shared_ptr<T> hist, gsl::span<Vs const>... positionsAndWeights)
+  requires(sizeof...(Vs) > 0 && (FillValue<Vs> && ...))
+{
+  const std::array<size_t, sizeof...(Vs)> sizes{positionsAndWeights.size()...};
+  if (std::any_of(sizes.begin(), sizes.end(), [&sizes](size_t size) { return size != sizes[0]; })) {
+    LOGF(fatal, "The spans given to the fill function called for histogram %s have different sizes.", hist->GetName());
+  }
+  for (size_t i = 0; i < sizes[0]; ++i) {
+    fillHistAny(hist, positionsAndWeights[i]...);
+  }
+}
+
 template <typename... Cs, typename R, typename T>
 void HistFiller::fillHistAny(std::shared_ptr<R> hist, const T& table, const o2::framework::expressions::Filter& filter)
 {
@@ -429,6 +452,13 @@ extern template void HistogramRegistry::fill(const HistName& histName, double);
 extern template void HistogramRegistry::fill(const HistName& histName, float);
 extern template void HistogramRegistry::fill(const HistName& histName, int);
 
+template <typename... Vs>
+void HistogramRegistry::fill(const HistName& histName, gsl::span<Vs const>... positionsAndWeights)
+  requires(sizeof...(Vs) > 0 && (FillValue<Vs> && ...))
+{
+  std::visit([&](auto&& hist) { HistFiller::fillHistAny(hist, positionsAndWeights...); }, mRegistryValue[getHistIndex(histName)]);
+}
+
 template <typename... Cs, typename T>
 void HistogramRegistry::fill(const HistName& histName, const T& table, const o2::framework::expressions::Filter& filter)
 {
@@ -66,7 +66,9 @@ enum HistType : unsigned int {
   kTProfile2D,
   kTProfile3D,
   kStepTHnF,
-  kStepTHnD
+  kStepTHnD,
+  kStepTHnSparseF,
+  kStepTHnSparseD
 };
 
 // variant of all possible root pointers; here we use only the interface types since the underlying data representation (int,float,double,long,char) is irrelevant
@@ -255,7 +257,9 @@ DECLAREEXT(TProfile);
 DECLAREEXT(TProfile2D);
 DECLAREEXT(TProfile3D);
 DECLAREEXT(StepTHnF);
-DECLAREEXT(StepTHnD)
+DECLAREEXT(StepTHnD);
+DECLAREEXT(StepTHnSparseF);
+DECLAREEXT(StepTHnSparseD)
 #undef DECLAREEXT
 
 } // namespace o2::framework
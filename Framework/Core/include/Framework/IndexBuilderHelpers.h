@@ -142,7 +142,7 @@ class IndexColumnBuilder : public SelfIndexColumnBuilder, public ChunkedArrayIte
 
   std::shared_ptr<arrow::NumericArray<arrow::Int32Type>> mValuesArrow = nullptr;
   std::shared_ptr<arrow::NumericArray<arrow::Int64Type>> mCounts = nullptr;
-  std::vector<int> mValues;
+  std::vector<int> mFirstEntries;
   std::vector<std::vector<int>> mIndices;
   int mFillOffset = 0;
   int mValuePos = 0;
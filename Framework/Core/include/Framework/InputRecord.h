@@ -14,6 +14,7 @@
 #include "Framework/DataRef.h"
 #include "Framework/DataRefUtils.h"
 #include "Framework/InputRoute.h"
+#include "Framework/InputRouteIndex.h"
 #include "Framework/TypeTraits.h"
 #include "Framework/TableConsumer.h"
 #include "Framework/Traits.h"
@@ -106,9 +107,12 @@ class InputRecord
     constexpr static size_t INVALID = -1LL;
   };
 
+  /// @a index, if provided, is used to look up inputs by binding, rather
+  /// than scanning @a inputs. It must have been created from @a inputs.
   InputRecord(std::vector<InputRoute> const& inputs,
               InputSpan& span,
-              ServiceRegistryRef);
+              ServiceRegistryRef,
+              InputRouteIndex const* index = nullptr);
 
   /// A deleter type to be used with unique_ptr, which can be marked that
   /// it does not own the underlying resource and thus should not delete it.
@@ -664,6 +668,7 @@ class InputRecord
   ServiceRegistryRef mRegistry;
   std::vector<InputRoute> const& mInputsSchema;
   InputSpan& mSpan;
+  InputRouteIndex const* mIndex = nullptr;
 };
 
 } // namespace o2::framework
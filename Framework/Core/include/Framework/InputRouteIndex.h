@@ -0,0 +1,79 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_INPUTROUTEINDEX_H_
+#define O2_FRAMEWORK_INPUTROUTEINDEX_H_
+
+#include "Framework/ConcreteDataMatcher.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace o2::framework
+{
+
+struct InputRoute;
+
+struct ConcreteDataMatcherHash {
+  size_t operator()(ConcreteDataMatcher const& matcher) const
+  {
+    size_t hash = std::hash<uint64_t>{}(matcher.description.itg[0]);
+    hash ^= std::hash<uint64_t>{}(matcher.description.itg[1]) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+    hash ^= std::hash<uint64_t>{}(((uint64_t)matcher.origin.itg[0] << 32) | matcher.subSpec) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+    return hash;
+  }
+};
+
+/// Lookup tables for the inputs of a device, computed once from its
+/// InputRoutes, so that finding an input by binding or by data type does
+/// not require a scan over all the routes for every message.
+/// Positions are the ones of the InputRecord, i.e. routes for timeslices
+/// other than the first one are not counted.
+struct InputRouteIndex {
+  constexpr static size_t INVALID = -1;
+
+  InputRouteIndex() = default;
+  explicit InputRouteIndex(std::vector<InputRoute> const& routes);
+
+  /// The inputs which can possibly match a given data type, see candidatesFor.
+  struct Candidates {
+    /// Position of the first input which matches exactly the data type, INVALID if none
+    size_t concrete = INVALID;
+    /// Positions of the inputs which need to be checked with their matcher, in order
+    std::vector<size_t> const& generic;
+  };
+
+  /// @return the position of the first input with the given binding, -1 if there is none.
+  [[nodiscard]] int getPos(std::string_view binding) const;
+
+  /// Notice that a generic input which comes before the concrete one takes precedence.
+  [[nodiscard]] Candidates candidatesFor(ConcreteDataMatcher const& target) const;
+
+  /// @return the number of inputs
+  [[nodiscard]] size_t size() const { return mSize; }
+
+ private:
+  struct StringHash {
+    using is_transparent = void;
+    size_t operator()(std::string_view s) const { return std::hash<std::string_view>{}(s); }
+  };
+  std::unordered_map<std::string, int, StringHash, std::equal_to<>> mBindings;
+  std::unordered_map<ConcreteDataMatcher, size_t, ConcreteDataMatcherHash> mConcrete;
+  std::vector<size_t> mGeneric;
+  size_t mSize = 0;
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_INPUTROUTEINDEX_H_
@@ -17,6 +17,11 @@
 extern template class std::function<o2::framework::DataRef(size_t)>;
 extern template class std::function<o2::framework::DataRef(size_t, size_t)>;
 
+namespace fair::mq
+{
+class Message;
+}
+
 namespace o2::framework
 {
 
@@ -66,6 +71,22 @@ class InputSpan
     return mNofPartsGetter(i);
   }
 
+  /// @a getter is the mapping between an element of the span and the message
+  /// holding its payload, so that the payload can be forwarded without copying it.
+  void setPayloadMessageGetter(std::function<fair::mq::Message const*(size_t, size_t)> getter)
+  {
+    mPayloadMessageGetter = std::move(getter);
+  }
+
+  /// The message holding the payload of the @a i-th element of the InputSpan, nullptr if not known.
+  [[nodiscard]] fair::mq::Message const* payloadMessage(size_t i, size_t partidx = 0) const
+  {
+    if (!mPayloadMessageGetter || i >= mSize) {
+      return nullptr;
+    }
+    return mPayloadMessageGetter(i, partidx);
+  }
+
   /// Number of elements in the InputSpan
   [[nodiscard]] size_t size() const
   {
@@ -236,6 +257,7 @@ class InputSpan
  private:
   std::function<DataRef(size_t, size_t)> mGetter;
   std::function<size_t(size_t)> mNofPartsGetter;
+  std::function<fair::mq::Message const*(size_t, size_t)> mPayloadMessageGetter;
   size_t mSize;
 };
 
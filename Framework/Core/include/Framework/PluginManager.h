@@ -15,6 +15,8 @@
 #include <cstring>
 #include <uv.h>
 #include <functional>
+#include <string>
+#include <vector>
 
 // Struct to hold live plugin information which the plugin itself cannot
 // know and that is owned by the framework.
@@ -57,72 +59,31 @@ struct PluginManager {
   /// with the original callback and the ProcessingContext.
   static auto wrapAlgorithm(AlgorithmSpec const& spec, WrapperProcessCallback&& wrapper) -> AlgorithmSpec;
 
+  /// Open @a library and return the chain of plugins it provides.
+  /// The result is cached, so that each library is opened and
+  /// resolved only once per process, no matter how many plugins
+  /// are requested from it.
+  /// @return nullptr if the library or its plugins cannot be loaded.
+  static DPLPluginHandle* resolve(std::string const& library);
+
   /// Parse a comma separated list of <library>:<plugin-name> plugin declarations.
   static std::vector<LoadablePlugin> parsePluginSpecString(char const* str);
 
   template <typename CONCRETE, typename PLUGIN>
   static void loadFromPlugin(std::vector<LoadablePlugin> const& loadablePlugins, std::vector<CONCRETE>& specs)
   {
-    struct LoadedDSO {
-      std::string library;
-      uv_lib_t handle;
-    };
-
-    struct LoadedPlugin {
-      std::string name;
-      PLUGIN* factory;
-    };
-    std::vector<LoadedDSO> loadedDSOs;
-    std::vector<LoadedPlugin> loadedPlugins;
     for (auto& loadablePlugin : loadablePlugins) {
-      auto loadedDSO = std::find_if(loadedDSOs.begin(), loadedDSOs.end(), [&loadablePlugin](auto& dso) {
-        return dso.library == loadablePlugin.library;
-      });
-
-      if (loadedDSO == loadedDSOs.end()) {
-        uv_lib_t handle;
-#ifdef __APPLE__
-        auto libraryName = fmt::format("lib{}.dylib", loadablePlugin.library);
-#else
-        auto libraryName = fmt::format("lib{}.so", loadablePlugin.library);
-#endif
-        auto ret = uv_dlopen(libraryName.c_str(), &handle);
-        if (ret != 0) {
-          LOGP(error, "Could not load library {}", loadablePlugin.library);
-          LOG(error) << uv_dlerror(&handle);
-          continue;
-        }
-        loadedDSOs.push_back({loadablePlugin.library, handle});
-        loadedDSO = loadedDSOs.end() - 1;
+      DPLPluginHandle* pluginInstance = PluginManager::resolve(loadablePlugin.library);
+      if (pluginInstance == nullptr) {
+        continue;
       }
-      int result = 0;
-
-      auto loadedPlugin = std::find_if(loadedPlugins.begin(), loadedPlugins.end(), [&loadablePlugin](auto& plugin) {
-        return plugin.name == loadablePlugin.name;
-      });
-
-      if (loadedPlugin == loadedPlugins.end()) {
-        DPLPluginHandle* (*dpl_plugin_callback)(DPLPluginHandle*);
-        result = uv_dlsym(&loadedDSO->handle, "dpl_plugin_callback", (void**)&dpl_plugin_callback);
-        if (result == -1) {
-          LOG(error) << uv_dlerror(&loadedDSO->handle);
-          continue;
-        }
-
-        DPLPluginHandle* pluginInstance = dpl_plugin_callback(nullptr);
-        PLUGIN* factory = PluginManager::getByName<PLUGIN>(pluginInstance, loadablePlugin.name.c_str());
-        if (factory == nullptr) {
-          LOGP(error, "Could not find service {} in library {}", loadablePlugin.name, loadablePlugin.library);
-          continue;
-        }
-
-        loadedPlugins.push_back({loadablePlugin.name, factory});
-        loadedPlugin = loadedPlugins.begin() + loadedPlugins.size() - 1;
+      PLUGIN* factory = PluginManager::getByName<PLUGIN>(pluginInstance, loadablePlugin.name.c_str());
+      if (factory == nullptr) {
+        LOGP(error, "Could not find service {} in library {}", loadablePlugin.name, loadablePlugin.library);
+        continue;
       }
-      assert(loadedPlugin != loadedPlugins.end());
-      assert(loadedPlugin->factory != nullptr);
 
-      CONCRETE* spec = loadedPlugin->factory->create();
+      CONCRETE* spec = factory->create();
       if (!spec) {
         LOG(error) << "Plugin " << loadablePlugin.name << " could not be created";
         continue;
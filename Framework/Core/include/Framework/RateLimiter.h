@@ -20,12 +20,52 @@
 
 namespace o2::framework
 {
+/// Predictive admission of new timeframes, enabled with DPL_PREDICTIVE_RATE_LIMITING=1.
+/// Rather than waiting for the free shared memory to drop below the limit, it
+/// estimates the footprint of a timeframe from the memory used by the ones in
+/// flight and admits a new one only if it is expected to fit. Once the pipeline
+/// is half full, new timeframes are injected at the rate at which downstream
+/// consumes them, smoothing out the oscillations of the throughput.
+class AdmissionController
+{
+ public:
+  /// Weight of a new sample in the moving estimates.
+  constexpr static double SMOOTHING = 0.2;
+
+  /// @a freeMemory the currently free shared memory
+  /// @a inFlight the number of timeframes sent and not yet consumed
+  void updateMemory(uint64_t freeMemory, int64_t inFlight);
+  /// @a consumed the total number of timeframes consumed at @a now, in seconds
+  void updateConsumed(int64_t consumed, double now);
+  /// @return true if a new timeframe is expected to fit while leaving @a minSHM free.
+  /// With nothing in flight, there is nothing to wait for, so only @a minSHM is checked.
+  [[nodiscard]] bool admit(uint64_t freeMemory, uint64_t minSHM, int64_t inFlight) const;
+  /// @return how many seconds to wait before sending a new timeframe, given
+  /// that the last one was sent @a sinceLast seconds ago.
+  [[nodiscard]] double delay(double sinceLast, int64_t inFlight, int maxInFlight) const;
+
+  /// Estimated memory needed by one timeframe, in bytes
+  [[nodiscard]] uint64_t footprint() const { return static_cast<uint64_t>(mFootprint); }
+  /// Estimated number of timeframes consumed per second downstream
+  [[nodiscard]] double consumptionRate() const { return mRate; }
+
+ private:
+  uint64_t mMaxFree = 0;
+  double mFootprint = 0;
+  double mRate = 0;
+  int64_t mLastConsumed = -1;
+  double mLastConsumedTime = 0;
+};
+
 class RateLimiter
 {
  public:
   int check(ProcessingContext& ctx, int maxInFlight, size_t minSHM);
 
  private:
+  AdmissionController mAdmission;
+  std::chrono::time_point<std::chrono::system_clock> mLastAdmission;
+
   int64_t mConsumedTimeframes = 0;
   int64_t mSentTimeframes = 0;
 
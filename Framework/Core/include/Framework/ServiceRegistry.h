@@ -196,6 +196,10 @@ struct ServiceRegistry {
   /// To hide exception throwing from QC
   void throwError(const char* name, int64_t hash, int64_t streamId, int64_t dataprocessorId) const;
 
+  /// Create the lazy service booked at @a pos, unless some other
+  /// thread did it already, and return it.
+  void* createLazyService(int pos) const;
+
  public:
   using hash_type = decltype(TypeIdHelpers::uniqueId<void>());
   ServiceRegistry();
@@ -212,7 +216,8 @@ struct ServiceRegistry {
 
   /// Declare a service by its ServiceSpec. If of type Global
   /// / Serial it will be immediately registered for tid 0,
-  /// so that subsequent gets will ultimately use it.
+  /// so that subsequent gets will ultimately use it, unless
+  /// the spec is lazy, in which case it is created by the first get.
   /// If it is of kind "Stream" we will create the Service only
   /// when requested by a given thread. This function is not
   /// thread safe.
@@ -257,6 +262,10 @@ struct ServiceRegistry {
   }
 
   mutable std::vector<ServiceSpec> mSpecs;
+  /// What lazy services get created with, i.e. what they would
+  /// have been created with when declared.
+  DeviceState* mLazyState = nullptr;
+  fair::mq::ProgOptions* mLazyOptions = nullptr;
   mutable std::array<std::atomic<Key>, MAX_SERVICES + MAX_DISTANCE> mServicesKey;
   mutable std::array<void*, MAX_SERVICES + MAX_DISTANCE> mServicesValue;
   mutable std::array<Meta, MAX_SERVICES + MAX_DISTANCE> mServicesMeta;
@@ -217,6 +217,12 @@ struct ServiceSpec {
   /// Active flag. If set to false, the service will not be used by default.
   bool active = true;
 
+  /// Lazy flag. If set to true, the service is created the first time it is
+  /// requested, rather than when it is declared. Since its callbacks are bound
+  /// only once the service exists, this is meant for services which do not
+  /// have any. Requires uniqueId to be set.
+  bool lazy = false;
+
   /// Kind of service being specified.
   ServiceKind kind = ServiceKind::Serial;
 };
@@ -19,6 +19,7 @@
 #include "THnSparse.h"
 #include "TAxis.h"
 #include "TArray.h"
+#include "TObjArray.h"
 
 #include "Framework/Logger.h"
 
@@ -63,7 +64,8 @@ class StepTHn : public TNamed
  protected:
   void init();
   virtual TArray* createArray(const TArray* src = nullptr) const = 0;
-  void createTarget(Int_t step, Bool_t sparse);
+  virtual void createTarget(Int_t step, Bool_t sparse);
+  virtual void addToStep(Int_t step, Long64_t bin, Double_t weight); // bin indices per axis are in mLastBins
   void deleteContainers();
 
   Long64_t getGlobalBinIndex(const Int_t* binIdx);
@@ -113,6 +115,37 @@ class StepTHnT : public StepTHn
 typedef StepTHnT<TArrayF> StepTHnF;
 typedef StepTHnT<TArrayD> StepTHnD;
 
+// StepTHn variant for high-dimensional maps with few populated bins: instead of dense arrays
+// the entries are accumulated from the start in one THnSparse per step
+template <class TemplateArray>
+class StepTHnSparseT : public StepTHn
+{
+ public:
+  StepTHnSparseT() : StepTHn() { mSteps.SetOwner(kTRUE); }
+  StepTHnSparseT(const Char_t* name, const Char_t* title, const Int_t nSteps, const Int_t nAxes, Int_t* nBins, std::vector<Double_t> binEdges[], const char** axisTitles);
+  StepTHnSparseT(const char* name, const char* title, const int nSteps, const int nAxes, const int* nBins, const double* xmin, const double* xmax);
+  StepTHnSparseT(const StepTHnSparseT& c);
+  ~StepTHnSparseT() override = default;
+
+  void Copy(TObject& c) const override;
+  Long64_t Merge(TCollection* list) override;
+
+  THnSparse* getSparse(Int_t step) { return static_cast<THnSparse*>(mSteps.At(step)); }
+
+ protected:
+  TArray* createArray(const TArray* = nullptr) const override { return nullptr; } // no dense storage
+  void createTarget(Int_t step, Bool_t sparse) override;
+  void addToStep(Int_t step, Long64_t bin, Double_t weight) override;
+  void copySteps(StepTHnSparseT& target) const;
+
+  TObjArray mSteps; // THnSparse per step, created with the first entry
+
+  ClassDef(StepTHnSparseT, 1) // THn like container with sparse storage
+};
+
+typedef StepTHnSparseT<TArrayF> StepTHnSparseF;
+typedef StepTHnSparseT<TArrayD> StepTHnSparseD;
+
 template <typename... Ts>
 void StepTHn::Fill(int iStep, const Ts&... valuesAndWeight)
 {
@@ -212,6 +212,13 @@ struct BuilderUtils {
       } else {
         return arrow::Status::OK();
       }
+    } else if constexpr (std::is_same_v<std::decay_t<std::remove_pointer_t<PTR>>, bool>) {
+      // BooleanBuilder only takes bytes
+      if (holder.builder->AppendValues(reinterpret_cast<const uint8_t*>(info.ptr), info.size, nullptr).ok() == false) {
+        throw runtime_error("Unable to append to column");
+      } else {
+        return arrow::Status::OK();
+      }
     } else {
       if (holder.builder->AppendValues(info.ptr, info.size, nullptr).ok() == false) {
         throw runtime_error("Unable to append to column");
@@ -347,6 +354,7 @@ struct BuilderMaker<T (&)[N]> {
 template <typename T, int N>
 struct BuilderMaker<T[N]> {
   using FillType = T*;
+  using STLValueType = T;
   using BuilderType = arrow::FixedSizeListBuilder;
   using ArrowType = arrow::FixedSizeListType;
   using ElementType = typename detail::ConversionTraits<T>::ArrowType;
@@ -847,6 +855,34 @@ class TableBuilder
     };
   }
 
+  /// Columnar bulk filling: the builders are reserved for @a nRows upfront and
+  /// the returned callback appends @a batchSize rows at once, taking one
+  /// contiguous buffer per column. Array columns take batchSize * N elements.
+  template <typename... ARGS, size_t NCOLUMNS = sizeof...(ARGS)>
+  auto bulkPersistColumns(std::array<char const*, NCOLUMNS> const& columnNames, size_t nRows)
+  {
+    static_assert((!is_specialization_v<ARGS, std::vector> && ...), "Variable size columns cannot be filled in bulk");
+    validate();
+    mArrays.resize(NCOLUMNS);
+    makeBuilders<ARGS...>(columnNames, nRows);
+
+    return [holders = mHolders](size_t batchSize, typename BuilderMaker<ARGS>::STLValueType const*... columns) -> void {
+      if (TableBuilderHelpers::bulkAppendChunked(*(HoldersTupleIndexed<ARGS...>*)holders, std::make_tuple(BulkInfo<typename BuilderMaker<ARGS>::STLValueType const*>{columns, batchSize}...)) == false) {
+        throwError(runtime_error("Unable to bulk append"));
+      }
+    };
+  }
+
+  // Same as above, but starting from a o2::soa::Table, which has all the
+  // information already available.
+  template <typename T>
+  auto bulkCursor(size_t nRows)
+  {
+    return [this, nRows]<typename... Cs>(pack<Cs...>) {
+      return this->template bulkPersistColumns<typename Cs::type...>({Cs::columnLabel()...}, nRows);
+    }(typename T::table_t::persistent_columns_t{});
+  }
+
   /// Reserve method to expand the columns as needed.
   template <typename... Ts>
   auto reserveArrays(std::tuple<Ts...>& holders, int s)
@@ -883,7 +919,13 @@ auto makeEmptyTable(const char* name)
 }
 
 std::shared_ptr<arrow::Table> spawnerHelper(std::shared_ptr<arrow::Table>& fullTable, std::shared_ptr<arrow::Schema> newSchema, size_t nColumns,
-                                            expressions::Projector* projectors, std::vector<std::shared_ptr<arrow::Field>> const& fields, const char* name);
+                                            std::shared_ptr<gandiva::Projector> const& projector, const char* name);
+
+/// Projector for the expression columns of a spawned table, built for a given source schema
+struct SpawnerProjectorCache {
+  std::shared_ptr<arrow::Schema> schema = nullptr;
+  std::shared_ptr<gandiva::Projector> projector = nullptr;
+};
 
 /// Expression-based column generator to materialize columns
 template <typename... C>
@@ -895,8 +937,14 @@ auto spawner(framework::pack<C...> columns, std::vector<std::shared_ptr<arrow::T
   }
   static auto fields = o2::soa::createFieldsFromColumns(columns);
   static auto new_schema = std::make_shared<arrow::Schema>(fields);
-  std::array<expressions::Projector, sizeof...(C)> projectors{{std::move(C::Projector())...}};
-  return spawnerHelper(fullTable, new_schema, sizeof...(C), projectors.data(), fields, name);
+  // the source schema is the same for every dataframe, so the projector is only rebuilt when it changes
+  thread_local SpawnerProjectorCache cache;
+  if (cache.projector == nullptr || !cache.schema->Equals(*fullTable->schema())) {
+    std::array<expressions::Projector, sizeof...(C)> projectors{{std::move(C::Projector())...}};
+    cache.projector = expressions::createProjectorHelper(sizeof...(C), projectors.data(), fullTable->schema(), fields);
+    cache.schema = fullTable->schema();
+  }
+  return spawnerHelper(fullTable, new_schema, sizeof...(C), cache.projector, name);
 }
 
 template <typename... T>
@@ -36,7 +36,7 @@ class TimesliceIndex
 {
  public:
   /// TimesliceIndex is threadsafe because it's accessed only by the
-  /// DataRelayer.
+  /// DataRelayer, which serialises the accesses to any given slot.
   constexpr static ServiceKind service_kind = ServiceKind::Global;
 
   /// What to do when there is backpressure
@@ -148,7 +148,8 @@ class TimesliceIndex
 
   /// This keeps track whether or not something was relayed
   /// since last time we called getReadyToProcess()
-  std::vector<bool> mDirty;
+  /// Not a std::vector<bool>, so that distinct slots can be marked concurrently.
+  std::vector<char> mDirty;
 
   /// This is the oldest possible timeslice for any given channel
   /// The cardinality of this vector is the number of input channels
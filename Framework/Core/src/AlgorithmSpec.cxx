@@ -29,4 +29,11 @@ AlgorithmSpec::InitErrorCallback& AlgorithmSpec::emptyInitErrorCallback()
   static InitErrorCallback callback = nullptr;
   return callback;
 }
+
+AlgorithmSpec AlgorithmSpec::batch(InitBatchCallback init, ErrorCallback& error)
+{
+  AlgorithmSpec spec{ProcessCallback{nullptr}, error};
+  spec.onInitBatch = init;
+  return spec;
+}
 } // namespace o2::framework
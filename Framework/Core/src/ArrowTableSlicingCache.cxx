@@ -12,8 +12,6 @@
 #include "Framework/ArrowTableSlicingCache.h"
 #include "Framework/RuntimeError.h"
 
-#include <arrow/compute/api_aggregate.h>
-#include <arrow/compute/kernel.h>
 #include <arrow/table.h>
 
 namespace o2::framework
@@ -32,6 +30,16 @@ std::pair<int64_t, int64_t> SliceInfoPtr::getSliceFor(int value) const
   if (values.empty()) {
     return {offset, 0};
   }
+  if (value >= 0 && !indices.empty()) {
+    if (value >= static_cast<int>(indices.size())) {
+      return {offset, 0};
+    }
+    auto i = indices[value];
+    if (i < 0) {
+      return {offsets.back() + counts.back(), 0};
+    }
+    return {offsets[i], counts[i]};
+  }
   int64_t p = static_cast<int64_t>(values.size()) - 1;
   while (values[p] < 0) {
     --p;
@@ -81,6 +89,8 @@ ArrowTableSlicingCache::ArrowTableSlicingCache(std::vector<StringPair>&& bsks, s
 {
   values.resize(bindingsKeys.size());
   counts.resize(bindingsKeys.size());
+  offsets.resize(bindingsKeys.size());
+  indices.resize(bindingsKeys.size());
 
   valuesUnsorted.resize(bindingsKeysUnsorted.size());
   groups.resize(bindingsKeysUnsorted.size());
@@ -94,6 +104,10 @@ void ArrowTableSlicingCache::setCaches(std::vector<StringPair>&& bsks, std::vect
   values.resize(bindingsKeys.size());
   counts.clear();
   counts.resize(bindingsKeys.size());
+  offsets.clear();
+  offsets.resize(bindingsKeys.size());
+  indices.clear();
+  indices.resize(bindingsKeys.size());
   valuesUnsorted.clear();
   valuesUnsorted.resize(bindingsKeysUnsorted.size());
   groups.clear();
@@ -102,22 +116,43 @@ void ArrowTableSlicingCache::setCaches(std::vector<StringPair>&& bsks, std::vect
 
 arrow::Status ArrowTableSlicingCache::updateCacheEntry(int pos, std::shared_ptr<arrow::Table> const& table)
 {
+  values[pos].clear();
+  counts[pos].clear();
+  offsets[pos].clear();
+  indices[pos].clear();
   if (table->num_rows() == 0) {
-    values[pos].reset();
-    counts[pos].reset();
     return arrow::Status::OK();
   }
   validateOrder(bindingsKeys[pos], table);
-  arrow::Datum value_counts;
-  auto options = arrow::compute::ScalarAggregateOptions::Defaults();
-  ARROW_ASSIGN_OR_RAISE(value_counts,
-                        arrow::compute::CallFunction("value_counts", {table->GetColumnByName(bindingsKeys[pos].second)},
-                                                     &options));
-  auto pair = static_cast<arrow::StructArray>(value_counts.array());
-  values[pos].reset();
-  counts[pos].reset();
-  values[pos] = std::make_shared<arrow::NumericArray<arrow::Int32Type>>(pair.field(0)->data());
-  counts[pos] = std::make_shared<arrow::NumericArray<arrow::Int64Type>>(pair.field(1)->data());
+
+  // the groups are contiguous in a sorted column: they are found with a single run-length pass,
+  // which gives the same values in order of appearance with their counts as a hashed value_counts
+  auto column = table->GetColumnByName(bindingsKeys[pos].second);
+  int64_t row = 0;
+  for (auto iChunk = 0; iChunk < column->num_chunks(); ++iChunk) {
+    auto chunk = static_cast<arrow::NumericArray<arrow::Int32Type>>(column->chunk(iChunk)->data());
+    for (auto iElement = 0; iElement < chunk.length(); ++iElement) {
+      auto v = chunk.Value(iElement);
+      if (values[pos].empty() || values[pos].back() != v) {
+        values[pos].push_back(v);
+        counts[pos].push_back(0);
+        offsets[pos].push_back(row);
+      }
+      ++counts[pos].back();
+      ++row;
+    }
+  }
+
+  // direct lookup of the groups, so that slicing does not scan all the preceding ones
+  for (auto i = 0U; i < values[pos].size(); ++i) {
+    auto v = values[pos][i];
+    if (v >= 0) {
+      if (static_cast<int>(indices[pos].size()) <= v) {
+        indices[pos].resize(v + 1, -1);
+      }
+      indices[pos][v] = i;
+    }
+  }
   return arrow::Status::OK();
 }
 
@@ -136,12 +171,12 @@ arrow::Status ArrowTableSlicingCache::updateCacheEntryUnsorted(int pos, const st
     for (auto iElement = 0; iElement < chunk.length(); ++iElement) {
       auto v = chunk.Value(iElement);
       if (v >= 0) {
-        if (std::find(valuesUnsorted[pos].begin(), valuesUnsorted[pos].end(), v) == valuesUnsorted[pos].end()) {
-          valuesUnsorted[pos].push_back(v);
-        }
         if (groups[pos].size() <= v) {
           groups[pos].resize(v + 1);
         }
+        if ((groups[pos])[v].empty()) {
+          valuesUnsorted[pos].push_back(v);
+        }
         (groups[pos])[v].push_back(row);
       }
       ++row;
@@ -203,7 +238,7 @@ SliceInfoUnsortedPtr ArrowTableSlicingCache::getCacheUnsortedFor(const StringPai
 
 SliceInfoPtr ArrowTableSlicingCache::getCacheForPos(int pos) const
 {
-  if (values[pos] == nullptr && counts[pos] == nullptr) {
+  if (values[pos].empty()) {
     return {
       {},
       {} //
@@ -211,8 +246,10 @@ SliceInfoPtr ArrowTableSlicingCache::getCacheForPos(int pos) const
   }
 
   return {
-    {reinterpret_cast<int const*>(values[pos]->values()->data()), static_cast<size_t>(values[pos]->length())},
-    {reinterpret_cast<int64_t const*>(counts[pos]->values()->data()), static_cast<size_t>(counts[pos]->length())} //
+    {values[pos].data(), values[pos].size()},
+    {counts[pos].data(), counts[pos].size()},
+    {offsets[pos].data(), offsets[pos].size()},
+    {indices[pos].data(), indices[pos].size()} //
   };
 }
 
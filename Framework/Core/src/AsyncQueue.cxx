@@ -11,12 +11,93 @@
 
 #include "Framework/AsyncQueue.h"
 #include "Framework/Signpost.h"
+#include "Framework/Logger.h"
+#include <algorithm>
 #include <numeric>
 
 O2_DECLARE_DYNAMIC_LOG(async_queue);
 
 namespace o2::framework
 {
+AsyncWorkerPool::AsyncWorkerPool(size_t maxWorkers)
+  : mMaxWorkers{std::max(maxWorkers, (size_t)1)}
+{
+}
+
+AsyncWorkerPool::~AsyncWorkerPool()
+{
+  {
+    std::scoped_lock<std::mutex> lock(mMutex);
+    mStop = true;
+  }
+  mWakeUp.notify_all();
+  for (auto& worker : mWorkers) {
+    worker.join();
+  }
+}
+
+void AsyncWorkerPool::schedule(AsyncTaskId id, int score, Callback task, size_t signpostId)
+{
+  {
+    std::scoped_lock<std::mutex> lock(mMutex);
+    auto& pending = mPending[id.value];
+    // If the id has other tasks pending, the worker which
+    // completes the previous one will take care of this one.
+    if (pending.empty()) {
+      mReady.push({score, mSequence++, id.value});
+    }
+    pending.push_back({std::move(task), signpostId});
+    mOutstanding++;
+    if (mIdleWorkers < mReady.size() && mWorkers.size() < mMaxWorkers) {
+      mWorkers.emplace_back(&AsyncWorkerPool::work, this);
+    }
+  }
+  mWakeUp.notify_one();
+}
+
+void AsyncWorkerPool::drain()
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+  mIdle.wait(lock, [this]() { return mOutstanding == 0; });
+}
+
+void AsyncWorkerPool::work()
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+  while (true) {
+    mIdleWorkers++;
+    mWakeUp.wait(lock, [this]() { return mStop || !mReady.empty(); });
+    mIdleWorkers--;
+    if (mReady.empty()) {
+      return;
+    }
+    auto ready = mReady.top();
+    mReady.pop();
+    auto& pending = mPending[ready.id];
+    // We keep the task in the queue while it runs, so that
+    // the next one for the same id is not scheduled.
+    auto task = std::move(pending.front().task);
+    auto signpostId = pending.front().signpostId;
+    lock.unlock();
+    try {
+      task(signpostId);
+    } catch (...) {
+      // Nobody would be there to catch it.
+      LOGP(error, "Exception while running asynchronous task {}", ready.id);
+    }
+    lock.lock();
+    auto& stillPending = mPending[ready.id];
+    stillPending.pop_front();
+    if (!stillPending.empty()) {
+      mReady.push({ready.score, mSequence++, ready.id});
+      mWakeUp.notify_one();
+    }
+    if (--mOutstanding == 0) {
+      mIdle.notify_all();
+    }
+  }
+}
+
 auto AsyncQueueHelpers::create(AsyncQueue& queue, AsyncTaskSpec spec) -> AsyncTaskId
 {
   AsyncTaskId id;
@@ -111,6 +192,15 @@ auto AsyncQueueHelpers::run(AsyncQueue& queue, TimesliceId oldestPossible) -> vo
       O2_SIGNPOST_EVENT_EMIT(async_queue, opid, "run", "Running task %{public}s (%d) for timeslice %zu",
                              queue.prototypes[queue.tasks[i].id.value].name.c_str(), i,
                              queue.tasks[i].timeslice.value);
+      auto id = queue.tasks[i].id.value;
+      if (id != -1 && queue.prototypes[id].affinity == AsyncTaskAffinity::Any) {
+        if (!queue.workers) {
+          queue.workers = std::make_unique<AsyncWorkerPool>(queue.maxWorkers);
+        }
+        queue.workers->schedule(queue.tasks[i].id, queue.prototypes[id].score, std::move(queue.tasks[i].task), opid.value);
+        O2_SIGNPOST_EVENT_EMIT(async_queue, opid, "run", "Handed over %d to the workers", i);
+        continue;
+      }
       queue.tasks[i].task(opid.value);
       O2_SIGNPOST_EVENT_EMIT(async_queue, opid, "run", "Done running %d", i);
     }
@@ -126,6 +216,9 @@ auto AsyncQueueHelpers::run(AsyncQueue& queue, TimesliceId oldestPossible) -> vo
 
 auto AsyncQueueHelpers::reset(AsyncQueue& queue) -> void
 {
+  if (queue.workers) {
+    queue.workers->drain();
+  }
   queue.tasks.clear();
   queue.iteration = 0;
 }
@@ -45,6 +45,7 @@
 #include <Monitoring/Monitoring.h>
 
 #include "TFile.h"
+#include "TROOT.h"
 #include "TTree.h"
 #include "TMap.h"
 #include "TObjString.h"
@@ -310,6 +311,13 @@ DataProcessorSpec
       };
     }
 
+    // with implicit multi-threading, TTree::Fill fills the branches in parallel and the baskets
+    // are compressed in parallel when flushed, while the trees are still written in order
+    if (dod->getNumberWriterThreads() > 0) {
+      LOGP(info, "Filling and compressing the output trees with {} threads", dod->getNumberWriterThreads());
+      ROOT::EnableImplicitMT(dod->getNumberWriterThreads());
+    }
+
     // end of data functor is called at the end of the data stream
     auto endofdatacb = [dod](EndOfStreamContext& context) {
       dod->closeDataFiles();
@@ -32,6 +32,7 @@
 #include <uv.h>
 #include <boost/program_options/variables_map.hpp>
 #include <csignal>
+#include <cstdio>
 
 // This is to allow C++20 aggregate initialisation
 #pragma GCC diagnostic push
@@ -49,8 +50,19 @@ o2::framework::ServiceSpec CommonMessageBackends::fairMQDeviceProxy()
     .name = "fairmq-device-proxy",
     .init = [](ServiceRegistryRef, DeviceState&, fair::mq::ProgOptions& options) -> ServiceHandle {
       auto* proxy = new FairMQDeviceProxy();
+      auto arena = options.Count("output-arena") ? options.GetValue<std::string>("output-arena") : std::string{};
+      if (!arena.empty()) {
+        size_t blockSize = 0, nBlocks = 0, maxMessageSize = 0;
+        if (sscanf(arena.c_str(), "%zu:%zu:%zu", &blockSize, &nBlocks, &maxMessageSize) != 3 || blockSize == 0 || nBlocks == 0) {
+          throw runtime_error_f("Bad --output-arena %s, expected <block size>:<blocks>:<max message size>", arena.c_str());
+        }
+        proxy->setOutputArena(blockSize, nBlocks, maxMessageSize);
+      }
       return ServiceHandle{.hash = TypeIdHelpers::uniqueId<FairMQDeviceProxy>(), .instance = proxy, .kind = ServiceKind::Serial};
     },
+    .preProcessing = [](ProcessingContext&, void* instance) {
+      // Outputs of a timeslice go to a new block of the arena, if any.
+      static_cast<FairMQDeviceProxy*>(instance)->newOutputArenaBlock(); },
     .start = [](ServiceRegistryRef services, void* instance) {
       auto* proxy = static_cast<FairMQDeviceProxy*>(instance);
       auto& outputs = services.get<DeviceSpec const>().outputs;
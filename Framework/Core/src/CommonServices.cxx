@@ -141,7 +141,14 @@ o2::framework::ServiceSpec CommonServices::asyncQueue()
 {
   return ServiceSpec{
     .name = "async-queue",
-    .init = simpleServiceInit<AsyncQueue, AsyncQueue>(),
+    .init = [](ServiceRegistryRef, DeviceState&, fair::mq::ProgOptions&) -> ServiceHandle {
+      auto* queue = new AsyncQueue;
+      // The workers are shared by all the services of the device.
+      if (char const* maxWorkers = getenv("DPL_ASYNC_QUEUE_WORKERS")) {
+        queue->maxWorkers = std::max(1, atoi(maxWorkers));
+      }
+      return ServiceHandle{TypeIdHelpers::uniqueId<AsyncQueue>(), queue};
+    },
     .configure = noConfiguration(),
     .stop = [](ServiceRegistryRef services, void* service) {
       auto& queue = services.get<AsyncQueue>();
@@ -370,8 +377,10 @@ o2::framework::ServiceSpec CommonServices::rootFileSpec()
 {
   return ServiceSpec{
     .name = "localrootfile",
+    .uniqueId = simpleServiceId<LocalRootFileService>(),
     .init = simpleServiceInit<LocalRootFileService, LocalRootFileService>(),
     .configure = noConfiguration(),
+    .lazy = true,
     .kind = ServiceKind::Serial};
 }
 
@@ -379,12 +388,14 @@ o2::framework::ServiceSpec CommonServices::parallelSpec()
 {
   return ServiceSpec{
     .name = "parallel",
+    .uniqueId = simpleServiceId<ParallelContext>(),
     .init = [](ServiceRegistryRef services, DeviceState&, fair::mq::ProgOptions& options) -> ServiceHandle {
       auto& spec = services.get<DeviceSpec const>();
       return ServiceHandle{TypeIdHelpers::uniqueId<ParallelContext>(),
                            new ParallelContext(spec.rank, spec.nSlots)};
     },
     .configure = noConfiguration(),
+    .lazy = true,
     .kind = ServiceKind::Serial};
 }
 
@@ -788,6 +799,7 @@ auto flushMetrics(ServiceRegistryRef registry, DataProcessingStats& stats) -> vo
   auto& monitoring = registry.get<Monitoring>();
   auto& relayer = registry.get<DataRelayer>();
 
+  stats.publishLatencies();
   // Send all the relevant metrics for the relayer to update the GUI
   stats.flushChangedMetrics([&monitoring](DataProcessingStats::MetricSpec const& spec, int64_t timestamp, int64_t value) mutable -> void {
     // convert timestamp to a time_point
@@ -1062,7 +1074,34 @@ o2::framework::ServiceSpec CommonServices::dataProcessingStats()
                    .scope = Scope::DPL,
                    .minPublishInterval = 0,
                    .maxRefreshLatency = 10000,
-                   .sendInitialValue = true}};
+                   .sendInitialValue = true},
+        MetricSpec{.name = "admission-tf-footprint",
+                   .metricId = static_cast<short>(ProcessingStatsId::ADMISSION_TF_FOOTPRINT),
+                   .kind = Kind::UInt64,
+                   .scope = Scope::Online,
+                   .minPublishInterval = quickUpdateInterval},
+        MetricSpec{.name = "admission-consumption-rate-mhz",
+                   .metricId = static_cast<short>(ProcessingStatsId::ADMISSION_CONSUMPTION_RATE_MHZ),
+                   .kind = Kind::UInt64,
+                   .scope = Scope::Online,
+                   .minPublishInterval = quickUpdateInterval},
+        MetricSpec{.name = "admission-delay-us",
+                   .metricId = static_cast<short>(ProcessingStatsId::ADMISSION_DELAY_US),
+                   .kind = Kind::UInt64,
+                   .scope = Scope::Online,
+                   .minPublishInterval = quickUpdateInterval}};
+
+      // Percentiles of the latency histograms, in microseconds.
+      constexpr std::array<char const*, DataProcessingStats::LATENCY_METRICS_PER_STAGE> latencyPercentiles = {"p50", "p99", "p999", "max"};
+      for (size_t si = 0; si < DataProcessingStats::latencyStageNames.size(); ++si) {
+        for (size_t pi = 0; pi < latencyPercentiles.size(); ++pi) {
+          metrics.push_back(MetricSpec{.name = fmt::format("latency/{}_us/{}", DataProcessingStats::latencyStageNames[si], latencyPercentiles[pi]),
+                                       .metricId = static_cast<short>((int)ProcessingStatsId::LATENCY_PERCENTILES_BASE + si * DataProcessingStats::LATENCY_METRICS_PER_STAGE + pi),
+                                       .kind = Kind::UInt64,
+                                       .scope = Scope::DPL,
+                                       .minPublishInterval = 1000});
+        }
+      }
 
       for (auto& metric : metrics) {
         stats->registerMetric(metric);
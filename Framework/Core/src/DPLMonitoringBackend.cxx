@@ -11,10 +11,14 @@
 
 #include "DPLMonitoringBackend.h"
 #include "Framework/DriverClient.h"
+#include "Framework/DeviceMetricsRingBuffer.h"
+#include "Framework/Logger.h"
 #include "Framework/ServiceRegistry.h"
 #include "Framework/RuntimeError.h"
 #include <fmt/format.h>
+#include <cstdlib>
 #include <sstream>
+#include <variant>
 
 namespace o2::framework
 {
@@ -30,8 +34,19 @@ overloaded(Ts...) -> overloaded<Ts...>;
 DPLMonitoringBackend::DPLMonitoringBackend(ServiceRegistryRef registry)
   : mRegistry{registry}
 {
+  char const* shmName = getenv(DeviceMetricsSharedMemory::ENV_NAME);
+  if (shmName == nullptr || shmName[0] == '\0') {
+    return;
+  }
+  try {
+    mSharedMemory = DeviceMetricsSharedMemory::open(shmName);
+  } catch (...) {
+    LOGP(warning, "Unable to attach to the metrics shared memory {}. Sending metrics as text.", shmName);
+  }
 }
 
+DPLMonitoringBackend::~DPLMonitoringBackend() = default;
+
 void DPLMonitoringBackend::addGlobalTag(std::string_view name, std::string_view value)
 {
   // FIXME: tags are ignored by DPL in any case...
@@ -52,8 +67,46 @@ inline unsigned long convertTimestamp(const std::chrono::time_point<std::chrono:
     .count();
 }
 
+bool DPLMonitoringBackend::sendBinary(o2::monitoring::Metric const& metric)
+{
+  // Only single value, numeric metrics with a short enough name
+  // fit in a record.
+  if (metric.getValuesSize() != 1) {
+    return false;
+  }
+  MetricRecord record;
+  if (record.setKey(metric.getName()) == false) {
+    return false;
+  }
+  auto const& value = metric.getValues().front().second;
+  switch (metric.getFirstValueType()) {
+    case 0:
+      record.type = MetricType::Int;
+      record.intValue = std::get<int>(value);
+      break;
+    case 2:
+      record.type = MetricType::Float;
+      record.floatValue = std::get<double>(value);
+      break;
+    case 3:
+      record.type = MetricType::Uint64;
+      record.uint64Value = std::get<uint64_t>(value);
+      break;
+    default:
+      return false;
+  }
+  record.timestamp = convertTimestamp(metric.getTimestamp());
+  std::lock_guard<std::mutex> lock(mSharedMemoryMutex);
+  return mSharedMemory->ring().push(record);
+}
+
 void DPLMonitoringBackend::send(o2::monitoring::Metric const& metric)
 {
+  // The driver bulk reads the records, so no need to format and parse them.
+  // If the ring is full, we fall back to the text channel.
+  if (mSharedMemory && sendBinary(metric)) {
+    return;
+  }
   std::array<char, 4096> buffer;
   auto mStream = fmt::format_to(buffer.begin(), "[METRIC] {}", metric.getName());
   for (auto& value : metric.getValues()) {
@@ -13,12 +13,15 @@
 
 #include "Framework/ServiceRegistryRef.h"
 #include "Monitoring/Backend.h"
+#include <memory>
+#include <mutex>
 #include <string>
 
 namespace o2::framework
 {
 
 struct ServiceRegistry;
+class DeviceMetricsSharedMemory;
 
 /// \brief Prints metrics to standard output via std::cout
 class DPLMonitoringBackend final : public o2::monitoring::Backend
@@ -28,7 +31,7 @@ class DPLMonitoringBackend final : public o2::monitoring::Backend
   DPLMonitoringBackend(ServiceRegistryRef registry);
 
   /// Default destructor
-  ~DPLMonitoringBackend() override = default;
+  ~DPLMonitoringBackend() override;
 
   /// Prints metric
   /// \param metric           reference to metric object
@@ -47,6 +50,13 @@ class DPLMonitoringBackend final : public o2::monitoring::Backend
   std::string mTagString;    ///< Global tagset (common for each metric)
   const std::string mPrefix; ///< Metric prefix
   ServiceRegistryRef mRegistry;
+  /// Binary channel to the driver, if provided by it. Numeric metrics
+  /// are sent via the ring in shared memory, everything else as text.
+  std::unique_ptr<DeviceMetricsSharedMemory> mSharedMemory;
+  std::mutex mSharedMemoryMutex;
+
+  /// @return true if the metric could be sent via the shared memory ring
+  bool sendBinary(const o2::monitoring::Metric& metric);
 };
 
 } // namespace o2::framework
@@ -34,6 +34,7 @@
 
 #include <TClonesArray.h>
 
+#include <cstring>
 #include <utility>
 
 O2_DECLARE_DYNAMIC_LOG(stream_context);
@@ -355,6 +356,23 @@ void DataAllocator::adoptFromCache(const Output& spec, CacheId id, header::Seria
   context.add<MessageContext::TrivialObject>(std::move(headerMessage), std::move(payloadMessage), routeIndex);
 }
 
+void DataAllocator::forward(const Output& spec, fair::mq::Message const& payload, header::SerializationMethod method)
+{
+  RouteIndex routeIndex = matchDataHeader(spec, mRegistry.get<TimingInfo>().timeslice);
+  auto* transport = mRegistry.get<FairMQDeviceProxy>().getOutputTransport(routeIndex);
+
+  fair::mq::MessagePtr payloadMessage;
+  if (payload.GetType() == transport->GetType()) {
+    // A shallow copy, for shared memory both messages refer to the same region
+    payloadMessage = transport->CreateMessage();
+    payloadMessage->Copy(payload);
+  } else {
+    payloadMessage = transport->CreateMessage(payload.GetSize());
+    memcpy(payloadMessage->GetData(), payload.GetData(), payload.GetSize());
+  }
+  addPartToContext(routeIndex, std::move(payloadMessage), spec, method);
+}
+
 void DataAllocator::cookDeadBeef(const Output& spec)
 {
   auto& proxy = mRegistry.get<FairMQDeviceProxy>();
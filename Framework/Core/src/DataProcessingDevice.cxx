@@ -9,6 +9,7 @@
 // granted to it by virtue of its status as an Intergovernmental Organization
 // or submit itself to any jurisdiction.
 #include "Framework/AsyncQueue.h"
+#include "Framework/BatchProcessingContext.h"
 #include "Framework/DataProcessingDevice.h"
 #include "Framework/ChannelMatching.h"
 #include "Framework/ControlService.h"
@@ -218,6 +219,7 @@ DataProcessingDevice::DataProcessingDevice(RunningDeviceRef running, ServiceRegi
   ServiceRegistryRef ref{mServiceRegistry};
   mAwakeHandle = (uv_async_t*)malloc(sizeof(uv_async_t));
   auto& state = ref.get<DeviceState>();
+  state.idleStreams = mStreams.size();
   assert(state.loop);
   int res = uv_async_init(state.loop, mAwakeHandle, on_communication_requested);
   mAwakeHandle->data = &state;
@@ -289,6 +291,7 @@ void run_completion(uv_work_t* handle, int status)
   quotaEvaluator.handleExpired(reportExpiredOffer);
   quotaEvaluator.dispose(task->id.index);
   task->running = false;
+  state.idleStreams++;
 }
 
 // Context for polling
@@ -398,6 +401,7 @@ void DataProcessingDevice::Init()
   O2_SIGNPOST_START(device, cid, "Init", "Entering Init callback.");
   context.statelessProcess = spec.algorithm.onProcess;
   context.statefulProcess = nullptr;
+  context.batchProcess = nullptr;
   context.error = spec.algorithm.onError;
   context.initError = spec.algorithm.onInitError;
 
@@ -464,6 +468,14 @@ void DataProcessingDevice::Init()
 
   context.expirationHandlers.clear();
   context.init = spec.algorithm.onInit;
+  if (spec.algorithm.onInitBatch) {
+    // Same error handling as the stateful initialisation, the batch
+    // callback is simply kept aside.
+    context.init = [&context, initBatch = spec.algorithm.onInitBatch](InitContext& ic) -> AlgorithmSpec::ProcessCallback {
+      context.batchProcess = initBatch(ic);
+      return nullptr;
+    };
+  }
   if (context.init) {
     static bool noCatch = getenv("O2_NO_CATCHALL_EXCEPTIONS") && strcmp(getenv("O2_NO_CATCHALL_EXCEPTIONS"), "0");
     InitContext initContext{*mConfigRegistry, mServiceRegistry};
@@ -672,16 +684,17 @@ static auto forwardInputs = [](ServiceRegistryRef registry, TimesliceSlot slot,
         continue;
       }
 
-      // In case of more than one forward route, we need to copy the message.
-      // This will eventually use the same mamory if running with the same backend.
-      if (cachedForwardingChoices.size() > 1) {
-        copy = true;
-      }
       auto* dh = o2::header::get<DataHeader*>(header->GetData());
       auto* dph = o2::header::get<DataProcessingHeader*>(header->GetData());
 
-      if (copy) {
-        for (auto& cachedForwardingChoice : cachedForwardingChoices) {
+      // In case of more than one forward route, we need to copy the message.
+      // The copy is shallow, i.e. with the shared memory backend it only
+      // increases the reference count of the region the message points to.
+      // Unless the caller needs the original, the last route gets the original.
+      if (copy || cachedForwardingChoices.size() > 1) {
+        auto copies = cachedForwardingChoices.size() - (copy ? 0 : 1);
+        for (size_t ci = 0; ci < copies; ++ci) {
+          auto& cachedForwardingChoice = cachedForwardingChoices[ci];
           auto&& newHeader = header->GetTransport()->CreateMessage();
           O2_SIGNPOST_EVENT_EMIT(forwarding, sid, "forwardInputs", "Forwarding a copy of %{public}s to route %d.",
                                  fmt::format("{}/{}/{}@timeslice:{} tfCounter:{}", dh->dataOrigin, dh->dataDescription, dh->subSpecification, dph->startTime, dh->tfCounter).c_str(), cachedForwardingChoice.value);
@@ -694,7 +707,8 @@ static auto forwardInputs = [](ServiceRegistryRef registry, TimesliceSlot slot,
             forwardedParts[cachedForwardingChoice.value].AddPart(std::move(newPayload));
           }
         }
-      } else {
+      }
+      if (!copy) {
         O2_SIGNPOST_EVENT_EMIT(forwarding, sid, "forwardInputs", "Forwarding %{public}s to route %d.",
                                fmt::format("{}/{}/{}@timeslice:{} tfCounter:{}", dh->dataOrigin, dh->dataDescription, dh->subSpecification, dph->startTime, dh->tfCounter).c_str(), cachedForwardingChoices.back().value);
         forwardedParts[cachedForwardingChoices.back().value].AddPart(std::move(messageSet.header(pi)));
@@ -789,7 +803,7 @@ void DataProcessingDevice::initPollers()
   auto& spec = ref.get<DeviceSpec const>();
   auto& state = ref.get<DeviceState>();
   // We add a timer only in case a channel poller is not there.
-  if ((context.statefulProcess != nullptr) || (context.statelessProcess != nullptr)) {
+  if ((context.statefulProcess != nullptr) || (context.statelessProcess != nullptr) || (context.batchProcess != nullptr)) {
     for (auto& [channelName, channel] : GetChannels()) {
       InputChannelInfo* channelInfo;
       for (size_t ci = 0; ci < spec.inputChannels.size(); ++ci) {
@@ -1464,6 +1478,7 @@ void DataProcessingDevice::Run()
       if (enough) {
         stream.id = streamRef;
         stream.running = true;
+        state.idleStreams--;
         stream.registry = &mServiceRegistry;
         if (dplEnableMultithreding) [[unlikely]] {
           stream.task = &handle;
@@ -1637,6 +1652,9 @@ void DataProcessingDevice::doPrepare(ServiceRegistryRef ref)
         info.channel->Receive(parts, 0);
         if (parts.Size()) {
           O2_SIGNPOST_EVENT_EMIT(device, cid, "channels", "Received %zu parts from channel %{public}s (%d).", parts.Size(), channelSpec.name.c_str(), info.id.value);
+          if (info.parts.Size() == 0) {
+            info.receivedTime = uv_hrtime();
+          }
         }
         for (auto&& part : parts) {
           info.parts.fParts.emplace_back(std::move(part));
@@ -1982,6 +2000,9 @@ void DataProcessingDevice::handleData(ServiceRegistryRef ref, InputChannelInfo&
             case DataRelayer::RelayChoice::Type::Dropped:
             case DataRelayer::RelayChoice::Type::Invalid:
             case DataRelayer::RelayChoice::Type::WillRelay:
+              if (relayed.type == DataRelayer::RelayChoice::Type::WillRelay && info.receivedTime) {
+                ref.get<DataProcessingStats>().recordLatency(DataProcessingStats::LatencyStage::ReceiveToRelay, (uv_hrtime() - info.receivedTime) / 1000);
+              }
               if (info.normalOpsNotified == false && info.backpressureNotified == true) {
                 LOGP(info, "Back to normal on channel {}.", info.channel->GetName());
                 auto& monitoring = ref.get<o2::monitoring::Monitoring>();
@@ -2127,15 +2148,19 @@ bool DataProcessingDevice::tryDispatchComputation(ServiceRegistryRef ref, std::v
   std::vector<MessageSet> currentSetOfInputs;
 
   //
-  auto getInputSpan = [ref, &currentSetOfInputs](TimesliceSlot slot, bool consume = true) {
-    auto& relayer = ref.get<DataRelayer>();
-    if (consume) {
-      currentSetOfInputs = relayer.consumeAllInputsForTimeslice(slot);
-    } else {
-      currentSetOfInputs = relayer.consumeExistingInputsForTimeslice(slot);
-    }
-    auto getter = [&currentSetOfInputs](size_t i, size_t partindex) -> DataRef {
-      if (currentSetOfInputs[i].getNumberOfPairs() > partindex) {
+  // Inputs of the timeslices whose processing is deferred to the end of this
+  // round, for data processors which process timeslices in batches.
+  struct BatchEntry {
+    DataRelayer::RecordAction action;
+    std::vector<MessageSet> inputs;
+    bool forwardLate;
+  };
+  std::vector<BatchEntry> batch;
+
+  // A span giving access to the messages in @a inputs, which must outlive it.
+  auto makeInputSpan = [](std::vector<MessageSet>& inputs) {
+    auto getter = [&inputs](size_t i, size_t partindex) -> DataRef {
+      if (inputs[i].getNumberOfPairs() > partindex) {
         const char* headerptr = nullptr;
         const char* payloadptr = nullptr;
         size_t payloadSize = 0;
@@ -2144,8 +2169,8 @@ bool DataProcessingDevice::tryDispatchComputation(ServiceRegistryRef ref, std::v
         //   sequence is the header message
         // - each part has one or more payload messages
         // - InputRecord provides all payloads as header-payload pair
-        auto const& headerMsg = currentSetOfInputs[i].associatedHeader(partindex);
-        auto const& payloadMsg = currentSetOfInputs[i].associatedPayload(partindex);
+        auto const& headerMsg = inputs[i].associatedHeader(partindex);
+        auto const& payloadMsg = inputs[i].associatedPayload(partindex);
         headerptr = static_cast<char const*>(headerMsg->GetData());
         payloadptr = payloadMsg ? static_cast<char const*>(payloadMsg->GetData()) : nullptr;
         payloadSize = payloadMsg ? payloadMsg->GetSize() : 0;
@@ -2153,10 +2178,27 @@ bool DataProcessingDevice::tryDispatchComputation(ServiceRegistryRef ref, std::v
       }
       return DataRef{};
     };
-    auto nofPartsGetter = [&currentSetOfInputs](size_t i) -> size_t {
-      return currentSetOfInputs[i].getNumberOfPairs();
+    auto nofPartsGetter = [&inputs](size_t i) -> size_t {
+      return inputs[i].getNumberOfPairs();
     };
-    return InputSpan{getter, nofPartsGetter, currentSetOfInputs.size()};
+    InputSpan span{getter, nofPartsGetter, inputs.size()};
+    span.setPayloadMessageGetter([&inputs](size_t i, size_t partindex) -> fair::mq::Message const* {
+      if (inputs[i].getNumberOfPairs() > partindex) {
+        return inputs[i].associatedPayload(partindex).get();
+      }
+      return nullptr;
+    });
+    return span;
+  };
+
+  auto getInputSpan = [ref, &currentSetOfInputs, &makeInputSpan](TimesliceSlot slot, bool consume = true) {
+    auto& relayer = ref.get<DataRelayer>();
+    if (consume) {
+      currentSetOfInputs = relayer.consumeAllInputsForTimeslice(slot);
+    } else {
+      currentSetOfInputs = relayer.consumeExistingInputsForTimeslice(slot);
+    }
+    return makeInputSpan(currentSetOfInputs);
   };
 
   auto markInputsAsDone = [ref](TimesliceSlot slot) -> void {
@@ -2283,6 +2325,7 @@ bool DataProcessingDevice::tryDispatchComputation(ServiceRegistryRef ref, std::v
     uint64_t tEnd = uv_hrtime();
     // tEnd and tStart are in nanoseconds according to https://docs.libuv.org/en/v1.x/misc.html#c.uv_hrtime
     int64_t wallTimeMs = (tEnd - tStart) / 1000000;
+    stats.recordLatency(DataProcessingStats::LatencyStage::Callback, (tEnd - tStart) / 1000);
     stats.updateStats({(int)ProcessingStatsId::LAST_ELAPSED_TIME_MS, DataProcessingStats::Op::Set, wallTimeMs});
     // Sum up the total wall time, in milliseconds.
     stats.updateStats({(int)ProcessingStatsId::TOTAL_WALL_TIME_MS, DataProcessingStats::Op::Add, wallTimeMs});
@@ -2337,6 +2380,21 @@ bool DataProcessingDevice::tryDispatchComputation(ServiceRegistryRef ref, std::v
       break;
   }
 
+  // If other streams are idle, we keep only the first computation for this
+  // stream and give the others back to the relayer. This way they are taken
+  // by whichever stream is free, rather than waiting behind a (possibly long)
+  // computation of this one. When the completion policy requires a given
+  // order, the whole batch stays on this stream.
+  if (spec.completionPolicy.order == CompletionPolicy::CompletionOrder::Any &&
+      completed.size() > 1 && state.idleStreams.load() > 0) {
+    O2_SIGNPOST_EVENT_EMIT(device, sid, "device", "Handing back %zu ready actions to %d idle streams", completed.size() - 1, state.idleStreams.load());
+    for (auto it = completed.begin() + 1; it != completed.end(); ++it) {
+      relayer.requeue(it->slot);
+    }
+    completed.erase(completed.begin() + 1, completed.end());
+    uv_async_send(state.awakeMainThread);
+  }
+
   for (auto action : completed) {
     O2_SIGNPOST_ID_GENERATE(aid, device);
     O2_SIGNPOST_START(device, aid, "device", "Processing action on slot %lu for action %{public}s", action.slot.index, fmt::format("{}", action.op).c_str());
@@ -2357,7 +2415,8 @@ bool DataProcessingDevice::tryDispatchComputation(ServiceRegistryRef ref, std::v
     auto& spec = ref.get<DeviceSpec const>();
     InputRecord record{spec.inputs,
                        span,
-                       *context.registry};
+                       *context.registry,
+                       &relayer.getInputRouteIndex()};
     ProcessingContext processContext{record, ref, ref.get<DataAllocator>()};
     {
       // Notice this should be thread safe and reentrant
@@ -2390,11 +2449,22 @@ bool DataProcessingDevice::tryDispatchComputation(ServiceRegistryRef ref, std::v
 
     uint64_t tStart = uv_hrtime();
     uint64_t tStartMilli = TimingHelpers::getRealtimeSinceEpochStandalone();
+    if (action.relayTime && tStart > action.relayTime) {
+      ref.get<DataProcessingStats>().recordLatency(DataProcessingStats::LatencyStage::RelayToDispatch, (tStart - action.relayTime) / 1000);
+    }
     preUpdateStats(action, record, tStart);
 
     static bool noCatch = getenv("O2_NO_CATCHALL_EXCEPTIONS") && strcmp(getenv("O2_NO_CATCHALL_EXCEPTIONS"), "0");
 
-    auto runNoCatch = [&context, ref, &processContext](DataRelayer::RecordAction& action) mutable {
+    // For batch processing we only do the bookkeeping here, the user callback
+    // is invoked once for all the timeslices after this loop.
+    bool deferToBatch = context.batchProcess && state.quitRequested == false &&
+                        (action.op == CompletionPolicy::CompletionOp::Consume ||
+                         action.op == CompletionPolicy::CompletionOp::ConsumeExisting ||
+                         action.op == CompletionPolicy::CompletionOp::ConsumeAndRescan ||
+                         action.op == CompletionPolicy::CompletionOp::Process);
+
+    auto runNoCatch = [&context, ref, &processContext, deferToBatch](DataRelayer::RecordAction& action) mutable {
       auto& state = ref.get<DeviceState>();
       auto& spec = ref.get<DeviceSpec const>();
       auto& streamContext = ref.get<StreamContext>();
@@ -2431,7 +2501,9 @@ bool DataProcessingDevice::tryDispatchComputation(ServiceRegistryRef ref, std::v
           O2_SIGNPOST_START(device, pcid, "device", "Stateful process");
           (context.statelessProcess)(processContext);
           O2_SIGNPOST_END(device, pcid, "device", "Stateful process");
-        } else if (context.statelessProcess || context.statefulProcess) {
+        } else if (deferToBatch) {
+          O2_SIGNPOST_EVENT_EMIT(device, pcid, "device", "Deferring processing to the end of the batch.");
+        } else if (context.statelessProcess || context.statefulProcess || context.batchProcess) {
           O2_SIGNPOST_EVENT_EMIT(device, pcid, "device", "Skipping processing because we are discarding.");
         } else {
           O2_SIGNPOST_EVENT_EMIT(device, pcid, "device", "No processing callback provided. Switching to %{public}s.", "Idle");
@@ -2504,7 +2576,14 @@ bool DataProcessingDevice::tryDispatchComputation(ServiceRegistryRef ref, std::v
       context.postDispatchingCallbacks(processContext);
       ref.get<CallbackService>().call<CallbackService::Id::DataConsumed>(o2::framework::ServiceRegistryRef{ref});
     }
-    if ((context.canForwardEarly == false) && hasForwards && consumeSomething) {
+    bool forwardLate = (context.canForwardEarly == false) && hasForwards && consumeSomething;
+    if (deferToBatch) {
+      // Late forwarding has to wait for the batch to be processed.
+      batch.push_back(BatchEntry{action, std::move(currentSetOfInputs), forwardLate});
+      O2_SIGNPOST_END(device, aid, "device", "Deferred processing action on slot %lu to the end of the batch", action.slot.index);
+      continue;
+    }
+    if (forwardLate) {
       O2_SIGNPOST_EVENT_EMIT(device, aid, "device", "Late forwarding");
       auto& timesliceIndex = ref.get<TimesliceIndex>();
       forwardInputs(ref, action.slot, currentSetOfInputs, timesliceIndex.getOldestPossibleOutput(), false, action.op == CompletionPolicy::CompletionOp::Consume);
@@ -2515,6 +2594,49 @@ bool DataProcessingDevice::tryDispatchComputation(ServiceRegistryRef ref, std::v
     }
     O2_SIGNPOST_END(device, aid, "device", "Done processing action on slot %lu for action %{public}s", action.slot.index, fmt::format("{}", action.op).c_str());
   }
+
+  if (batch.empty() == false) {
+    O2_SIGNPOST_EVENT_EMIT(device, sid, "device", "Processing a batch of %zu timeslices", batch.size());
+    // InputRecord keeps a reference to its span.
+    std::vector<InputSpan> spans;
+    std::vector<InputRecord> records;
+    spans.reserve(batch.size());
+    records.reserve(batch.size());
+    for (auto& entry : batch) {
+      spans.push_back(makeInputSpan(entry.inputs));
+      records.emplace_back(spec.inputs, spans.back(), *context.registry);
+    }
+    BatchProcessingContext batchContext{records, ref};
+    static bool noCatch = getenv("O2_NO_CATCHALL_EXCEPTIONS") && strcmp(getenv("O2_NO_CATCHALL_EXCEPTIONS"), "0");
+    if (noCatch) {
+      try {
+        (context.batchProcess)(batchContext);
+      } catch (o2::framework::RuntimeErrorRef e) {
+        (context.errorHandling)(e, records.front());
+      }
+    } else {
+      try {
+        (context.batchProcess)(batchContext);
+      } catch (std::exception& ex) {
+        auto e = runtime_error(ex.what());
+        (context.errorHandling)(e, records.front());
+      } catch (o2::framework::RuntimeErrorRef e) {
+        (context.errorHandling)(e, records.front());
+      }
+    }
+    for (size_t bi = 0; bi < batch.size(); ++bi) {
+      auto& entry = batch[bi];
+      if (entry.forwardLate) {
+        auto& timesliceIndex = ref.get<TimesliceIndex>();
+        forwardInputs(ref, entry.action.slot, entry.inputs, timesliceIndex.getOldestPossibleOutput(), false, entry.action.op == CompletionPolicy::CompletionOp::Consume);
+      }
+      ProcessingContext processContext{records[bi], ref, ref.get<DataAllocator>()};
+      context.postForwardingCallbacks(processContext);
+      if (entry.action.op == CompletionPolicy::CompletionOp::Process) {
+        cleanTimers(entry.action.slot, records[bi]);
+      }
+    }
+  }
   O2_SIGNPOST_END(device, sid, "device", "Start processing ready actions");
 
   // We now broadcast the end of stream if it was requested
@@ -191,6 +191,26 @@ void DataProcessingStats::processCommandQueue()
   insertedCmds.store(0, std::memory_order_relaxed);
 }
 
+void DataProcessingStats::publishLatencies()
+{
+  auto currentTimestamp = getTimestamp(realTimeBase, initialTimeOffset);
+  if (currentTimestamp - lastLatencyPublished < latencyPublishInterval) {
+    return;
+  }
+  lastLatencyPublished = currentTimestamp;
+  for (size_t si = 0; si < latencies.size(); ++si) {
+    auto summary = latencies[si].summarize(true);
+    if (summary.count == 0) {
+      continue;
+    }
+    auto base = static_cast<unsigned short>((int)ProcessingStatsId::LATENCY_PERCENTILES_BASE + si * LATENCY_METRICS_PER_STAGE);
+    updateStats({static_cast<unsigned short>(base + 0), Op::Set, (int64_t)summary.p50});
+    updateStats({static_cast<unsigned short>(base + 1), Op::Set, (int64_t)summary.p99});
+    updateStats({static_cast<unsigned short>(base + 2), Op::Set, (int64_t)summary.p999});
+    updateStats({static_cast<unsigned short>(base + 3), Op::Set, (int64_t)summary.max});
+  }
+}
+
 void DataProcessingStats::flushChangedMetrics(std::function<void(DataProcessingStats::MetricSpec const&, int64_t, int64_t)> const& callback)
 {
   publishingInvokedTotal++;
@@ -46,6 +46,7 @@
 #include <fmt/format.h>
 #include <fmt/ostream.h>
 #include <gsl/span>
+#include <uv.h>
 #include <numeric>
 #include <string>
 
@@ -70,10 +71,9 @@ DataRelayer::DataRelayer(const CompletionPolicy& policy,
     mCompletionPolicy{policy},
     mDistinctRoutesIndex{DataRelayerHelpers::createDistinctRouteIndex(routes)},
     mInputMatchers{DataRelayerHelpers::createInputMatchers(routes)},
+    mRouteIndex{routes},
     mMaxLanes{InputRouteHelpers::maxLanes(routes)}
 {
-  std::scoped_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
-
   if (policy.configureRelayer == nullptr) {
     static int pipelineLength = DefaultsHelpers::pipelineLength();
     setPipelineLength(pipelineLength);
@@ -102,7 +102,7 @@ DataRelayer::DataRelayer(const CompletionPolicy& policy,
 
 TimesliceId DataRelayer::getTimesliceForSlot(TimesliceSlot slot)
 {
-  std::scoped_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
+  std::scoped_lock<O2_LOCKABLE(std::shared_mutex)> lock(mMutex);
   auto& variables = mTimesliceIndex.getVariablesForSlot(slot);
   return VariableContextHelpers::getTimeslice(variables);
 }
@@ -111,7 +111,7 @@ DataRelayer::ActivityStats DataRelayer::processDanglingInputs(std::vector<Expira
                                                               ServiceRegistryRef services, bool createNew)
 {
   LOGP(debug, "DataRelayer::processDanglingInputs");
-  std::scoped_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
+  std::scoped_lock<O2_LOCKABLE(std::shared_mutex)> lock(mMutex);
   auto& deviceProxy = services.get<FairMQDeviceProxy>();
 
   ActivityStats activity;
@@ -235,12 +235,40 @@ DataRelayer::ActivityStats DataRelayer::processDanglingInputs(std::vector<Expira
 /// This does the mapping between a route and a InputSpec. The
 /// reason why these might diffent is that when you have timepipelining
 /// you have one route per timeslice, even if the type is the same.
+/// The @a lookup is used to find the candidates for concrete data types, the
+/// linear scan over all the matchers is only needed when that fails.
 size_t matchToContext(void const* data,
                       std::vector<DataDescriptorMatcher> const& matchers,
                       std::vector<size_t> const& index,
+                      InputRouteIndex const& lookup,
                       VariableContext& context)
 {
-  for (size_t ri = 0, re = index.size(); ri < re; ++ri) {
+  size_t first = 0;
+  if (auto const* dh = o2::header::get<DataHeader*>(data)) {
+    auto candidates = lookup.candidatesFor(ConcreteDataMatcher{dh->dataOrigin, dh->dataDescription, dh->subSpecification});
+    // Generic inputs which come before the concrete one have precedence.
+    for (auto ri : candidates.generic) {
+      if (ri > candidates.concrete) {
+        break;
+      }
+      if (matchers[index[ri]].match(reinterpret_cast<char const*>(data), context)) {
+        context.commit();
+        return ri;
+      }
+      context.discard();
+    }
+    if (candidates.concrete == InputRouteIndex::INVALID) {
+      return INVALID_INPUT;
+    }
+    if (matchers[index[candidates.concrete]].match(reinterpret_cast<char const*>(data), context)) {
+      context.commit();
+      return candidates.concrete;
+    }
+    context.discard();
+    // Something else than the data type did not match, check what follows.
+    first = candidates.concrete + 1;
+  }
+  for (size_t ri = first, re = index.size(); ri < re; ++ri) {
     auto& matcher = matchers[index[ri]];
 
     if (matcher.match(reinterpret_cast<char const*>(data), context)) {
@@ -410,7 +438,6 @@ DataRelayer::RelayChoice
                      size_t nPayloads,
                      std::function<void(TimesliceSlot, std::vector<MessageSet>&, TimesliceIndex::OldestOutputInfo)> onDrop)
 {
-  std::scoped_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
   DataProcessingHeader const* dph = o2::header::get<DataProcessingHeader*>(rawHeader);
   // IMPLEMENTATION DETAILS
   //
@@ -423,12 +450,13 @@ DataRelayer::RelayChoice
   // become more complicated when we will start supporting ranges.
   auto getInputTimeslice = [&matchers = mInputMatchers,
                             &distinctRoutes = mDistinctRoutesIndex,
+                            &lookup = mRouteIndex,
                             &rawHeader,
                             &index = mTimesliceIndex](VariableContext& context)
     -> std::tuple<int, TimesliceId> {
     /// FIXME: for the moment we only use the first context and reset
     /// between one invokation and the other.
-    auto input = matchToContext(rawHeader, matchers, distinctRoutes, context);
+    auto input = matchToContext(rawHeader, matchers, distinctRoutes, lookup, context);
 
     if (input == INVALID_INPUT) {
       return {
@@ -451,6 +479,7 @@ DataRelayer::RelayChoice
 
   // Actually save the header / payload in the slot
   auto saveInSlot = [&cachedStateMetrics = mCachedStateMetrics,
+                     &relayTimes = mSlotRelayTimes,
                      &messages,
                      &nMessages,
                      &nPayloads,
@@ -465,6 +494,7 @@ DataRelayer::RelayChoice
     auto cacheIdx = numInputTypes * slot.index + input;
     MessageSet& target = cache[cacheIdx];
     cachedStateMetrics[cacheIdx] = CacheEntryStatus::PENDING;
+    relayTimes[slot.index] = uv_hrtime();
     // TODO: make sure that multiple parts can only be added within the same call of
     // DataRelayer::relay
     assert(nPayloads > 0);
@@ -499,6 +529,42 @@ DataRelayer::RelayChoice
     }
   };
 
+  auto& stats = mContext.get<DataProcessingStats>();
+
+  // FAST PATH
+  //
+  // Most of the messages belong to a timeslice which already has a slot.
+  // Slots are assigned only with the relayer mutex held exclusively, so we
+  // can look for a matching one holding it shared and lock only the slot
+  // being inspected. This way relaying into distinct slots, e.g. from
+  // different streams, proceeds concurrently.
+  {
+    std::shared_lock<O2_LOCKABLE(std::shared_mutex)> sharedLock(mMutex);
+    for (size_t ci = 0; ci < mTimesliceIndex.size(); ++ci) {
+      auto slot = TimesliceSlot{ci};
+      if (!isSlotInLane(slot)) {
+        continue;
+      }
+      std::scoped_lock<std::mutex> slotLock(mSlotMutexes[ci]);
+      if (mTimesliceIndex.isValid(slot) == false) {
+        continue;
+      }
+      auto [input, timeslice] = getInputTimeslice(mTimesliceIndex.getVariablesForSlot(slot));
+      if (input != INVALID_INPUT && TimesliceId::isValid(timeslice)) {
+        saveInSlot(timeslice, input, slot, info);
+        mTimesliceIndex.publishSlot(slot);
+        mTimesliceIndex.markAsDirty(slot, true);
+        stats.updateStats({static_cast<short>(ProcessingStatsId::RELAYED_MESSAGES), DataProcessingStats::Op::Add, (int)1});
+        return RelayChoice{.type = RelayChoice::Type::WillRelay, .timeslice = timeslice};
+      }
+    }
+  }
+
+  // Anything else might change the slot assignment. Notice that the
+  // slot we are looking for might have been created in the meanwhile,
+  // so we need to look again for a partial match.
+  std::scoped_lock<O2_LOCKABLE(std::shared_mutex)> lock(mMutex);
+
   // OUTER LOOP
   //
   // This is the actual outer loop processing input as part of a given
@@ -544,7 +610,6 @@ DataRelayer::RelayChoice
     }
   }
 
-  auto& stats = mContext.get<DataProcessingStats>();
   /// If we get a valid result, we can store the message in cache.
   if (input != INVALID_INPUT && TimesliceId::isValid(timeslice) && TimesliceSlot::isValid(slot)) {
     if (needsCleaning) {
@@ -644,7 +709,7 @@ DataRelayer::RelayChoice
 void DataRelayer::getReadyToProcess(std::vector<DataRelayer::RecordAction>& completed)
 {
   LOGP(debug, "DataRelayer::getReadyToProcess");
-  std::scoped_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
+  std::scoped_lock<O2_LOCKABLE(std::shared_mutex)> lock(mMutex);
 
   // THE STATE
   const auto& cache = mCache;
@@ -665,10 +730,10 @@ void DataRelayer::getReadyToProcess(std::vector<DataRelayer::RecordAction>& comp
   // These two are trivial, but in principle the whole loop could be parallelised
   // or vectorised so "completed" could be a thread local variable which needs
   // merging at the end.
-  auto updateCompletionResults = [&completed](TimesliceSlot li, uint64_t const* timeslice, CompletionPolicy::CompletionOp op) {
+  auto updateCompletionResults = [&completed, &relayTimes = mSlotRelayTimes](TimesliceSlot li, uint64_t const* timeslice, CompletionPolicy::CompletionOp op) {
     if (timeslice) {
       LOGP(debug, "Doing action {} for slot {} (timeslice: {})", (int)op, li.index, *timeslice);
-      completed.emplace_back(RecordAction{li, {*timeslice}, op});
+      completed.emplace_back(RecordAction{li, {*timeslice}, op, relayTimes[li.index]});
     } else {
       LOGP(debug, "No timeslice associated with slot ", li.index);
     }
@@ -775,9 +840,15 @@ void DataRelayer::getReadyToProcess(std::vector<DataRelayer::RecordAction>& comp
        countDiscard, countWait);
 }
 
+void DataRelayer::requeue(TimesliceSlot slot)
+{
+  std::scoped_lock<O2_LOCKABLE(std::shared_mutex)> lock(mMutex);
+  mTimesliceIndex.markAsDirty(slot, true);
+}
+
 void DataRelayer::updateCacheStatus(TimesliceSlot slot, CacheEntryStatus oldStatus, CacheEntryStatus newStatus)
 {
-  std::scoped_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
+  std::scoped_lock<O2_LOCKABLE(std::shared_mutex)> lock(mMutex);
   const auto numInputTypes = mDistinctRoutesIndex.size();
 
   auto markInputDone = [&cachedStateMetrics = mCachedStateMetrics,
@@ -795,7 +866,7 @@ void DataRelayer::updateCacheStatus(TimesliceSlot slot, CacheEntryStatus oldStat
 
 std::vector<o2::framework::MessageSet> DataRelayer::consumeAllInputsForTimeslice(TimesliceSlot slot)
 {
-  std::scoped_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
+  std::scoped_lock<O2_LOCKABLE(std::shared_mutex)> lock(mMutex);
 
   const auto numInputTypes = mDistinctRoutesIndex.size();
   // State of the computation
@@ -849,7 +920,7 @@ std::vector<o2::framework::MessageSet> DataRelayer::consumeAllInputsForTimeslice
 
 std::vector<o2::framework::MessageSet> DataRelayer::consumeExistingInputsForTimeslice(TimesliceSlot slot)
 {
-  std::scoped_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
+  std::scoped_lock<O2_LOCKABLE(std::shared_mutex)> lock(mMutex);
 
   const auto numInputTypes = mDistinctRoutesIndex.size();
   // State of the computation
@@ -892,7 +963,7 @@ std::vector<o2::framework::MessageSet> DataRelayer::consumeExistingInputsForTime
 
 void DataRelayer::clear()
 {
-  std::scoped_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
+  std::scoped_lock<O2_LOCKABLE(std::shared_mutex)> lock(mMutex);
 
   for (auto& cache : mCache) {
     cache.clear();
@@ -914,26 +985,25 @@ size_t
 /// the time pipelining.
 void DataRelayer::setPipelineLength(size_t s)
 {
-  std::scoped_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
-
-  mTimesliceIndex.resize(s);
-  mVariableContextes.resize(s);
+  {
+    std::scoped_lock<O2_LOCKABLE(std::shared_mutex)> lock(mMutex);
+
+    mTimesliceIndex.resize(s);
+    mVariableContextes.resize(s);
+    mCache.resize(mDistinctRoutesIndex.size() * s);
+    mCachedStateMetrics.resize(mCache.size());
+    mSlotMutexes = std::vector<std::mutex>(s);
+    mSlotRelayTimes.resize(s);
+  }
   publishMetrics();
 }
 
 void DataRelayer::publishMetrics()
 {
-  std::scoped_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
+  std::scoped_lock<O2_LOCKABLE(std::shared_mutex)> lock(mMutex);
 
-  auto numInputTypes = mDistinctRoutesIndex.size();
-  // FIXME: many of the DataRelayer function rely on allocated cache, so its
-  // maybe misleading to have the allocation in a function primarily for
-  // metrics publishing, do better in setPipelineLength?
-  mCache.resize(numInputTypes * mTimesliceIndex.size());
   auto& states = mContext.get<DataProcessingStates>();
 
-  mCachedStateMetrics.resize(mCache.size());
-
   // There is maximum 16 variables available. We keep them row-wise so that
   // that we can take mod 16 of the index to understand which variable we
   // are talking about.
@@ -960,31 +1030,31 @@ void DataRelayer::publishMetrics()
 
 uint32_t DataRelayer::getFirstTFOrbitForSlot(TimesliceSlot slot)
 {
-  std::scoped_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
+  std::scoped_lock<O2_LOCKABLE(std::shared_mutex)> lock(mMutex);
   return VariableContextHelpers::getFirstTFOrbit(mTimesliceIndex.getVariablesForSlot(slot));
 }
 
 uint32_t DataRelayer::getFirstTFCounterForSlot(TimesliceSlot slot)
 {
-  std::scoped_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
+  std::scoped_lock<O2_LOCKABLE(std::shared_mutex)> lock(mMutex);
   return VariableContextHelpers::getFirstTFCounter(mTimesliceIndex.getVariablesForSlot(slot));
 }
 
 uint32_t DataRelayer::getRunNumberForSlot(TimesliceSlot slot)
 {
-  std::scoped_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
+  std::scoped_lock<O2_LOCKABLE(std::shared_mutex)> lock(mMutex);
   return VariableContextHelpers::getRunNumber(mTimesliceIndex.getVariablesForSlot(slot));
 }
 
 uint64_t DataRelayer::getCreationTimeForSlot(TimesliceSlot slot)
 {
-  std::scoped_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
+  std::scoped_lock<O2_LOCKABLE(std::shared_mutex)> lock(mMutex);
   return VariableContextHelpers::getCreationTime(mTimesliceIndex.getVariablesForSlot(slot));
 }
 
 void DataRelayer::sendContextState()
 {
-  std::scoped_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
+  std::scoped_lock<O2_LOCKABLE(std::shared_mutex)> lock(mMutex);
   auto& states = mContext.get<DataProcessingStates>();
   for (size_t ci = 0; ci < mTimesliceIndex.size(); ++ci) {
     auto slot = TimesliceSlot{ci};
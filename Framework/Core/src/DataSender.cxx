@@ -23,6 +23,9 @@
 #include "Framework/DataProcessingContext.h"
 #include "Framework/O2DataModelHelpers.h"
 #include "Framework/DataProcessingStates.h"
+#include "Framework/DataProcessingStats.h"
+
+#include <uv.h>
 
 using namespace o2::monitoring;
 
@@ -107,7 +110,9 @@ void DataSender::send(fair::mq::Parts& parts, ChannelIndex channelIndex)
   auto& dataProcessorContext = mRegistry.get<DataProcessorContext>();
   dataProcessorContext.preSendingMessagesCallbacks(mRegistry, parts, channelIndex);
   auto& info = mProxy.getOutputChannelInfo(channelIndex);
+  uint64_t tStart = uv_hrtime();
   info.policy->send(parts, channelIndex, mRegistry);
+  mRegistry.get<DataProcessingStats>().recordLatency(DataProcessingStats::LatencyStage::OutputSend, (uv_hrtime() - tStart) / 1000);
 }
 
 void DataSender::reset()
@@ -568,7 +568,9 @@ DataDescriptorMatcher DataSpecUtils::dataDescriptorMatcherFrom(header::DataDescr
   return matchOnlyOrigin;
 }
 
-std::optional<framework::ConcreteDataMatcher> DataSpecUtils::optionalConcreteDataMatcherFrom(data_matcher::DataDescriptorMatcher const& matcher)
+/// Extract the unique properties of a matcher which only uses 'and' and 'just'
+/// operations. Any other operation is reported as an error.
+MatcherInfo extractConjunctionInfo(data_matcher::DataDescriptorMatcher const& matcher)
 {
   using namespace data_matcher;
   using ops = DataDescriptorMatcher::Op;
@@ -637,12 +639,27 @@ std::optional<framework::ConcreteDataMatcher> DataSpecUtils::optionalConcreteDat
     },
     [](auto t) {}};
   DataMatcherWalker::walk(matcher, nodeWalker, leafWalker);
+  return state;
+}
+
+std::optional<framework::ConcreteDataMatcher> DataSpecUtils::optionalConcreteDataMatcherFrom(data_matcher::DataDescriptorMatcher const& matcher)
+{
+  auto state = extractConjunctionInfo(matcher);
   if (state.hasError == false && state.hasUniqueOrigin && state.hasUniqueDescription && state.hasUniqueSubSpec) {
     return std::make_optional(ConcreteDataMatcher{state.origin, state.description, state.subSpec});
   }
   return {};
 }
 
+std::optional<framework::ConcreteDataTypeMatcher> DataSpecUtils::optionalConcreteDataTypeMatcherFrom(data_matcher::DataDescriptorMatcher const& matcher)
+{
+  auto state = extractConjunctionInfo(matcher);
+  if (state.hasError == false && state.hasUniqueOrigin && state.hasUniqueDescription) {
+    return std::make_optional(ConcreteDataTypeMatcher{state.origin, state.description});
+  }
+  return {};
+}
+
 InputSpec DataSpecUtils::matchingInput(OutputSpec const& spec)
 {
   return std::visit(overloaded{
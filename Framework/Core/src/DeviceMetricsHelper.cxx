@@ -10,6 +10,7 @@
 // or submit itself to any jurisdiction.
 
 #include "Framework/DeviceMetricsHelper.h"
+#include "Framework/DeviceMetricsRingBuffer.h"
 #include "Framework/DriverInfo.h"
 #include "Framework/RuntimeError.h"
 #include "Framework/Logger.h"
@@ -538,6 +539,43 @@ bool DeviceMetricsHelper::processMetric(ParsedMetricMatch& match,
   return true;
 }
 
+bool DeviceMetricsHelper::processMetric(MetricRecord const& record,
+                                        DeviceMetricsInfo& info,
+                                        DeviceMetricsHelper::NewMetricCallback newMetricsCallback)
+{
+  if (record.keySize == 0 || record.keySize > MetricRecord::MAX_KEY_SIZE) {
+    return false;
+  }
+  ParsedMetricMatch match;
+  match.beginKey = record.key;
+  match.endKey = record.key + record.keySize;
+  match.timestamp = record.timestamp;
+  match.type = record.type;
+  // Fill all the representations of the value, like the parser does.
+  switch (record.type) {
+    case MetricType::Int:
+    case MetricType::Enum:
+      match.intValue = record.intValue;
+      match.uint64Value = record.intValue;
+      match.floatValue = record.intValue;
+      break;
+    case MetricType::Uint64:
+      match.uint64Value = record.uint64Value;
+      match.intValue = record.uint64Value;
+      match.floatValue = record.uint64Value;
+      break;
+    case MetricType::Float:
+      match.floatValue = record.floatValue;
+      match.uint64Value = record.floatValue;
+      match.intValue = record.floatValue;
+      break;
+    default:
+      // String metrics are never sent as records.
+      return false;
+  }
+  return processMetric(match, info, newMetricsCallback);
+}
+
 size_t DeviceMetricsHelper::metricIdxByName(const std::string& name, const DeviceMetricsInfo& info)
 {
   size_t i = 0;
@@ -0,0 +1,86 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/DeviceMetricsRingBuffer.h"
+#include "Framework/RuntimeError.h"
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace o2::framework
+{
+
+DeviceMetricsSharedMemory::DeviceMetricsSharedMemory(std::string name, void* memory, size_t size, size_t capacity, bool owner)
+  : mName{std::move(name)},
+    mMemory{memory},
+    mSize{size},
+    mOwner{owner},
+    mRing{memory, capacity, owner}
+{
+}
+
+std::unique_ptr<DeviceMetricsSharedMemory> DeviceMetricsSharedMemory::create(std::string const& name, size_t capacity)
+{
+  int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0) {
+    throw runtime_error_f("Unable to create shared memory segment %s for metrics: %s", name.c_str(), strerror(errno));
+  }
+  size_t size = DeviceMetricsRingBuffer::sizeForCapacity(capacity);
+  if (ftruncate(fd, size) != 0) {
+    close(fd);
+    shm_unlink(name.c_str());
+    throw runtime_error_f("Unable to resize shared memory segment %s for metrics: %s", name.c_str(), strerror(errno));
+  }
+  void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (memory == MAP_FAILED) {
+    shm_unlink(name.c_str());
+    throw runtime_error_f("Unable to map shared memory segment %s for metrics: %s", name.c_str(), strerror(errno));
+  }
+  return std::unique_ptr<DeviceMetricsSharedMemory>(new DeviceMetricsSharedMemory(name, memory, size, capacity, true));
+}
+
+std::unique_ptr<DeviceMetricsSharedMemory> DeviceMetricsSharedMemory::open(std::string const& name)
+{
+  int fd = shm_open(name.c_str(), O_RDWR, 0600);
+  if (fd < 0) {
+    throw runtime_error_f("Unable to open shared memory segment %s for metrics: %s", name.c_str(), strerror(errno));
+  }
+  struct stat sb;
+  if (fstat(fd, &sb) != 0 || (size_t)sb.st_size < sizeof(DeviceMetricsRingBuffer::Header)) {
+    close(fd);
+    throw runtime_error_f("Shared memory segment %s for metrics is not valid", name.c_str());
+  }
+  size_t size = sb.st_size;
+  void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (memory == MAP_FAILED) {
+    throw runtime_error_f("Unable to map shared memory segment %s for metrics: %s", name.c_str(), strerror(errno));
+  }
+  auto* header = reinterpret_cast<DeviceMetricsRingBuffer::Header*>(memory);
+  if (DeviceMetricsRingBuffer::sizeForCapacity(header->capacity) > size) {
+    munmap(memory, size);
+    throw runtime_error_f("Shared memory segment %s for metrics is too small", name.c_str());
+  }
+  return std::unique_ptr<DeviceMetricsSharedMemory>(new DeviceMetricsSharedMemory(name, memory, size, header->capacity, false));
+}
+
+DeviceMetricsSharedMemory::~DeviceMetricsSharedMemory()
+{
+  munmap(mMemory, mSize);
+  if (mOwner) {
+    shm_unlink(mName.c_str());
+  }
+}
+
+} // namespace o2::framework
@@ -861,12 +861,11 @@ void DeviceSpecHelpers::processInEdgeActions(std::vector<DeviceSpec>& devices,
       device.id += "_t" + std::to_string(edge.timeIndex);
     }
 
-    // FIXME: maybe I should use an std::map in the end
-    //        but this is really not performance critical
+    // Insert in place rather than resorting the whole index, which
+    // would be quadratic in the number of devices.
     auto id = DeviceId{edge.consumer, edge.timeIndex, devices.size()};
     devices.emplace_back(std::move(device));
-    deviceIndex.push_back(id);
-    std::sort(deviceIndex.begin(), deviceIndex.end());
+    deviceIndex.insert(std::upper_bound(deviceIndex.begin(), deviceIndex.end(), id), id);
     return devices.size() - 1;
   };
 
@@ -1517,6 +1516,7 @@ void DeviceSpecHelpers::prepareArguments(bool defaultQuiet, bool defaultStopped,
         realOdesc.add_options()("exit-transition-timeout", bpo::value<std::string>());
         realOdesc.add_options()("expected-region-callbacks", bpo::value<std::string>());
         realOdesc.add_options()("timeframes-rate-limit", bpo::value<std::string>());
+        realOdesc.add_options()("output-arena", bpo::value<std::string>());
         realOdesc.add_options()("environment", bpo::value<std::string>());
         realOdesc.add_options()("stacktrace-on-signal", bpo::value<std::string>());
         realOdesc.add_options()("post-fork-command", bpo::value<std::string>());
@@ -1703,6 +1703,7 @@ boost::program_options::options_description DeviceSpecHelpers::getForwardedDevic
     ("exit-transition-timeout", bpo::value<std::string>(), "timeout before switching to READY state")                                                                //
     ("expected-region-callbacks", bpo::value<std::string>(), "region callbacks to expect before starting")                                                           //
     ("timeframes-rate-limit", bpo::value<std::string>()->default_value("0"), "how many timeframes can be in fly")                                                    //
+    ("output-arena", bpo::value<std::string>(), "<block size>:<blocks>:<max message size> of the arena for small outputs")                                           //
     ("shm-monitor", bpo::value<std::string>(), "whether to use the shared memory monitor")                                                                           //
     ("channel-prefix", bpo::value<std::string>()->default_value(""), "prefix to use for multiplexing multiple workflows in the same session")                        //
     ("bad-alloc-max-attempts", bpo::value<std::string>()->default_value("1"), "throw after n attempts to alloc shm")                                                 //
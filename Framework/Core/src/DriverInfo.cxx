@@ -24,7 +24,9 @@ char const* o2::framework::DriverInfoHelper::stateToString(enum DriverState stat
     "PERFORM_CALLBACKS",       //
     "MATERIALISE_WORKFLOW",    //
     "IMPORT_CURRENT_WORKFLOW", //
-    "DO_CHILD"                 //
+    "DO_CHILD",                //
+    "MERGE_CONFIGS",           //
+    "BIND_GUI_PORT"            //
   };
   return names[static_cast<int>(state)];
 }
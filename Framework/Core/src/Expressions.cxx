@@ -12,6 +12,7 @@
 #include "Framework/ExpressionHelpers.h"
 #include "Framework/RuntimeError.h"
 #include "Framework/VariantHelpers.h"
+#include "arrow/array.h"
 #include "arrow/table.h"
 #include "gandiva/tree_expr_builder.h"
 #include <algorithm>
@@ -525,6 +526,11 @@ gandiva::Selection createSelection(std::shared_ptr<arrow::Table> const& table, s
   }
   arrow::TableBatchReader reader(*table);
   std::shared_ptr<arrow::RecordBatch> batch;
+  // the filter is evaluated batch by batch and each evaluation resets the selection,
+  // for tables made of several chunks the selected rows are collected with the batch offset
+  gandiva::Selection batchSelection;
+  int64_t offset = 0;
+  int64_t nSelected = 0;
   while (true) {
     s = reader.ReadNext(&batch);
     if (!s.ok()) {
@@ -533,11 +539,29 @@ gandiva::Selection createSelection(std::shared_ptr<arrow::Table> const& table, s
     if (batch == nullptr) {
       break;
     }
-    s = gfilter->Evaluate(*batch, selection);
+    if (batch->num_rows() == table->num_rows()) {
+      s = gfilter->Evaluate(*batch, selection);
+      if (!s.ok()) {
+        throw runtime_error_f("Cannot apply filter %s", s.ToString().c_str());
+      }
+      return selection;
+    }
+    if (batchSelection == nullptr) {
+      s = gandiva::SelectionVector::MakeInt64(table->num_rows(), arrow::default_memory_pool(), &batchSelection);
+      if (!s.ok()) {
+        throw runtime_error_f("Cannot allocate selection vector %s", s.ToString().c_str());
+      }
+    }
+    s = gfilter->Evaluate(*batch, batchSelection);
     if (!s.ok()) {
       throw runtime_error_f("Cannot apply filter %s", s.ToString().c_str());
     }
+    for (auto i = 0; i < batchSelection->GetNumSlots(); ++i) {
+      selection->SetIndex(nSelected++, offset + batchSelection->GetIndex(i));
+    }
+    offset += batch->num_rows();
   }
+  selection->SetNumSlots(nSelected);
 
   return selection;
 }
@@ -548,6 +572,187 @@ gandiva::Selection createSelection(std::shared_ptr<arrow::Table> const& table,
   return createSelection(table, createFilter(table->schema(), createOperations(std::move(expression))));
 }
 
+bool extractColumnCuts(Operations const& opSpecs, std::vector<ColumnCut>& cuts)
+{
+  std::vector<ColumnCut> found;
+  for (auto const& spec : opSpecs) {
+    if (spec.op == BasicOp::LogicalAnd) {
+      // both operands have to be results of other operations
+      if (spec.left.datum.index() != 1 || spec.right.datum.index() != 1) {
+        return false;
+      }
+      continue;
+    }
+    auto op = spec.op;
+    auto const* column = &spec.left;
+    auto const* literal = &spec.right;
+    if (column->datum.index() == 2) {
+      // literal on the left-hand side, mirror the comparison
+      std::swap(column, literal);
+      switch (op) {
+        case BasicOp::LessThan:
+          op = BasicOp::GreaterThan;
+          break;
+        case BasicOp::LessThanOrEqual:
+          op = BasicOp::GreaterThanOrEqual;
+          break;
+        case BasicOp::GreaterThan:
+          op = BasicOp::LessThan;
+          break;
+        case BasicOp::GreaterThanOrEqual:
+          op = BasicOp::LessThanOrEqual;
+          break;
+        default:
+          break;
+      }
+    }
+    switch (op) {
+      case BasicOp::LessThan:
+      case BasicOp::LessThanOrEqual:
+      case BasicOp::GreaterThan:
+      case BasicOp::GreaterThanOrEqual:
+      case BasicOp::Equal:
+      case BasicOp::NotEqual:
+        break;
+      default:
+        return false;
+    }
+    if (column->datum.index() != 3 || literal->datum.index() != 2 || (column->type != atype::FLOAT && column->type != atype::DOUBLE)) {
+      return false;
+    }
+    double value = 0;
+    auto isNumber = std::visit(
+      [&value](auto v) {
+        if constexpr (std::is_same_v<decltype(v), bool>) {
+          return false;
+        } else {
+          value = static_cast<double>(v);
+          return true;
+        }
+      },
+      std::get<LiteralNode::var_t>(literal->datum));
+    if (!isNumber) {
+      return false;
+    }
+    found.push_back(ColumnCut{std::get<std::string>(column->datum), op, value, literal->type});
+  }
+  if (found.empty()) {
+    return false;
+  }
+  cuts.insert(cuts.end(), found.begin(), found.end());
+  return true;
+}
+
+namespace
+{
+template <typename T, typename V>
+void applyCut(T const* values, int64_t n, BasicOp op, V cut, uint8_t* mask)
+{
+  // branchless loops over the whole batch, which the compiler vectorizes
+  switch (op) {
+    case BasicOp::LessThan:
+      for (int64_t i = 0; i < n; ++i) {
+        mask[i] &= static_cast<V>(values[i]) < cut;
+      }
+      break;
+    case BasicOp::LessThanOrEqual:
+      for (int64_t i = 0; i < n; ++i) {
+        mask[i] &= static_cast<V>(values[i]) <= cut;
+      }
+      break;
+    case BasicOp::GreaterThan:
+      for (int64_t i = 0; i < n; ++i) {
+        mask[i] &= static_cast<V>(values[i]) > cut;
+      }
+      break;
+    case BasicOp::GreaterThanOrEqual:
+      for (int64_t i = 0; i < n; ++i) {
+        mask[i] &= static_cast<V>(values[i]) >= cut;
+      }
+      break;
+    case BasicOp::Equal:
+      for (int64_t i = 0; i < n; ++i) {
+        mask[i] &= static_cast<V>(values[i]) == cut;
+      }
+      break;
+    case BasicOp::NotEqual:
+      for (int64_t i = 0; i < n; ++i) {
+        mask[i] &= static_cast<V>(values[i]) != cut;
+      }
+      break;
+    default:
+      throw runtime_error_f("Unsupported operation %d in column cut", op);
+  }
+}
+} // namespace
+
+gandiva::Selection createSelection(std::shared_ptr<arrow::Table> const& table, std::vector<ColumnCut> const& cuts)
+{
+  gandiva::Selection selection;
+  auto s = gandiva::SelectionVector::MakeInt64(table->num_rows(),
+                                               arrow::default_memory_pool(),
+                                               &selection);
+  if (!s.ok()) {
+    throw runtime_error_f("Cannot allocate selection vector %s", s.ToString().c_str());
+  }
+  if (table->num_rows() == 0) {
+    return selection;
+  }
+  std::vector<int> columnIndices;
+  for (auto const& cut : cuts) {
+    auto index = table->schema()->GetFieldIndex(cut.column);
+    if (index < 0) {
+      throw runtime_error_f("Cannot find column %s to apply the filter", cut.column.c_str());
+    }
+    columnIndices.push_back(index);
+  }
+  arrow::TableBatchReader reader(*table);
+  std::shared_ptr<arrow::RecordBatch> batch;
+  std::vector<uint8_t> mask;
+  int64_t offset = 0;
+  int64_t nSelected = 0;
+  while (true) {
+    s = reader.ReadNext(&batch);
+    if (!s.ok()) {
+      throw runtime_error_f("Cannot read batches from table %s", s.ToString().c_str());
+    }
+    if (batch == nullptr) {
+      break;
+    }
+    auto nRows = batch->num_rows();
+    mask.assign(nRows, 1);
+    for (auto ic = 0u; ic < cuts.size(); ++ic) {
+      auto const& cut = cuts[ic];
+      auto const& array = batch->column(columnIndices[ic]);
+      // same promotion as in the gandiva tree: a double literal upcasts a float column
+      if (array->type_id() == atype::FLOAT && cut.type != atype::DOUBLE) {
+        applyCut(std::static_pointer_cast<arrow::FloatArray>(array)->raw_values(), nRows, cut.op, static_cast<float>(cut.value), mask.data());
+      } else if (array->type_id() == atype::FLOAT) {
+        applyCut(std::static_pointer_cast<arrow::FloatArray>(array)->raw_values(), nRows, cut.op, cut.value, mask.data());
+      } else if (array->type_id() == atype::DOUBLE) {
+        applyCut(std::static_pointer_cast<arrow::DoubleArray>(array)->raw_values(), nRows, cut.op, cut.value, mask.data());
+      } else {
+        throw runtime_error_f("Column %s has unsupported type for a column cut", cut.column.c_str());
+      }
+      // null values never pass a filter
+      if (array->null_count() > 0) {
+        for (int64_t i = 0; i < nRows; ++i) {
+          mask[i] &= array->IsValid(i);
+        }
+      }
+    }
+    for (int64_t i = 0; i < nRows; ++i) {
+      if (mask[i]) {
+        selection->SetIndex(nSelected++, offset + i);
+      }
+    }
+    offset += nRows;
+  }
+  selection->SetNumSlots(nSelected);
+
+  return selection;
+}
+
 auto createProjection(std::shared_ptr<arrow::Table> const& table, std::shared_ptr<gandiva::Projector> const& gprojector)
 {
   arrow::TableBatchReader reader(*table);
@@ -722,8 +927,16 @@ void updateExpressionInfos(expressions::Filter const& filter, std::vector<Expres
     throw runtime_error("Empty expression info vector.");
   }
   Operations ops = createOperations(filter);
+  std::vector<ColumnCut> cuts;
+  auto simpleCuts = extractColumnCuts(ops, cuts);
   for (auto& info : eInfos) {
     if (isTableCompatible(info.hashes, ops)) {
+      if (simpleCuts && info.simpleCuts) {
+        info.cuts.insert(info.cuts.end(), cuts.begin(), cuts.end());
+      } else {
+        info.simpleCuts = false;
+        info.cuts.clear();
+      }
       auto tree = createExpressionTree(ops, info.schema);
       /// If the tree is already set, add a new tree to it with logical 'and'
       if (info.tree != nullptr) {
@@ -737,6 +950,14 @@ void updateExpressionInfos(expressions::Filter const& filter, std::vector<Expres
 
 void updateFilterInfo(ExpressionInfo& info, std::shared_ptr<arrow::Table>& table)
 {
+  // conjunctions of column cuts skip gandiva compilation and evaluation altogether
+  if (info.tree != nullptr && info.simpleCuts) {
+    if (info.resetSelection == true) {
+      info.selection = framework::expressions::createSelection(table, info.cuts);
+      info.resetSelection = false;
+    }
+    return;
+  }
   if (info.tree != nullptr && info.filter == nullptr) {
     info.filter = framework::expressions::createFilter(table->schema(), framework::expressions::makeCondition(info.tree));
   }
@@ -208,9 +208,15 @@ InjectorFunction o2DataModelAdaptor(OutputSpec const& spec, uint64_t startTime,
     auto* device = ref.get<RawDeviceService>().device();
     for (int i = 0; i < parts.Size() / 2; ++i) {
       auto dh = o2::header::get<DataHeader*>(parts.At(i * 2)->GetData());
-
-      DataProcessingHeader dph{newTimesliceId, 0};
-      o2::header::Stack headerStack{*dh, dph};
+      auto dph = o2::header::get<DataProcessingHeader*>(parts.At(i * 2)->GetData());
+      // If the stack already has a DataProcessingHeader, we only need to
+      // update the timeslice and can send the original messages as they are.
+      if (dph) {
+        const_cast<DataProcessingHeader*>(dph)->startTime = newTimesliceId;
+        sendOnChannel(*device, std::move(parts.At(i * 2)), std::move(parts.At(i * 2 + 1)), spec, channelRetriever);
+        continue;
+      }
+      o2::header::Stack headerStack{*dh, DataProcessingHeader{newTimesliceId, 0}};
       sendOnChannel(*device, std::move(headerStack), std::move(parts.At(i * 2 + 1)), spec, channelRetriever);
     }
     return parts.Size() > 0;
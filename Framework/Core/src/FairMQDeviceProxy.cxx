@@ -15,12 +15,14 @@
 #include "Framework/DataProcessingHeader.h"
 #include "Headers/DataHeader.h"
 #include "Headers/DataHeaderHelpers.h"
+#include "MemoryResources/MemoryResources.h"
 
 #include <fairmq/Channel.h>
 #include <fairmq/Device.h>
 #include <fairmq/Message.h>
 #include <fairmq/TransportFactory.h>
 
+#include <algorithm>
 #include <unordered_set>
 
 namespace o2::framework
@@ -210,7 +212,35 @@ std::unique_ptr<fair::mq::Message> FairMQDeviceProxy::createOutputMessage(RouteI
 
 std::unique_ptr<fair::mq::Message> FairMQDeviceProxy::createOutputMessage(RouteIndex routeIndex, const size_t size) const
 {
-  return getOutputTransport(routeIndex)->CreateMessage(size, fair::mq::Alignment{64});
+  auto* transport = getOutputTransport(routeIndex);
+  if (size != 0 && size <= mArenaMaxMessageSize) {
+    std::lock_guard<std::mutex> lock(mArenaMutex);
+    for (auto& arena : mOutputArenas) {
+      if (arena->getTransportFactory() != transport) {
+        continue;
+      }
+      if (auto message = arena->newMessage(size)) {
+        return message;
+      }
+      break;
+    }
+  }
+  return transport->CreateMessage(size, fair::mq::Alignment{64});
+}
+
+void FairMQDeviceProxy::setOutputArena(size_t blockSize, size_t nBlocks, size_t maxMessageSize)
+{
+  mArenaBlockSize = blockSize;
+  mArenaBlocks = nBlocks;
+  mArenaMaxMessageSize = std::min(maxMessageSize, blockSize);
+}
+
+void FairMQDeviceProxy::newOutputArenaBlock()
+{
+  std::lock_guard<std::mutex> lock(mArenaMutex);
+  for (auto& arena : mOutputArenas) {
+    arena->nextBlock();
+  }
 }
 
 std::unique_ptr<fair::mq::Message> FairMQDeviceProxy::createInputMessage(RouteIndex routeIndex) const
@@ -228,6 +258,9 @@ std::unique_ptr<fair::mq::Message> FairMQDeviceProxy::createForwardMessage(Route
   return getForwardTransport(routeIndex)->CreateMessage(fair::mq::Alignment{64});
 }
 
+FairMQDeviceProxy::FairMQDeviceProxy() = default;
+FairMQDeviceProxy::~FairMQDeviceProxy() = default;
+
 void FairMQDeviceProxy::bind(std::vector<OutputRoute> const& outputs, std::vector<InputRoute> const& inputs,
                              std::vector<ForwardRoute> const& forwards,
                              fair::mq::Device& device)
@@ -368,6 +401,17 @@ void FairMQDeviceProxy::bind(std::vector<OutputRoute> const& outputs, std::vecto
       LOGP(detail, "Forward route {}@{}%{} to index {} and channelIndex {}", DataSpecUtils::describe(route.matcher), route.timeslice, route.maxTimeslices, fi, state.channel.value);
     }
   }
+  if (mArenaMaxMessageSize != 0) {
+    // Arenas are kept across rebinds, since their messages might still be in flight.
+    std::lock_guard<std::mutex> lock(mArenaMutex);
+    for (auto& info : mOutputChannelInfos) {
+      auto* transport = info.channel.Transport();
+      if (std::none_of(mOutputArenas.begin(), mOutputArenas.end(), [transport](auto const& arena) { return arena->getTransportFactory() == transport; })) {
+        LOGP(detail, "Creating output arena of {} x {} bytes for channel {}", mArenaBlocks, mArenaBlockSize, info.name);
+        mOutputArenas.push_back(std::make_unique<o2::pmr::MessageArena>(transport, mArenaBlockSize, mArenaBlocks));
+      }
+    }
+  }
   mStateChangeCallback = [&device]() -> bool { return device.NewStatePending(); };
 }
 } // namespace o2::framework
@@ -185,6 +185,8 @@ HistPtr HistFactory::createHistVariant(const HistogramSpec& histSpec)
 
     CREATE_HIST_CASE(StepTHnF, StepTHn)
     CREATE_HIST_CASE(StepTHnD, StepTHn)
+    CREATE_HIST_CASE(StepTHnSparseF, StepTHn)
+    CREATE_HIST_CASE(StepTHnSparseD, StepTHn)
     default:
       throw runtime_error("Histogram type was not specified.");
   }
@@ -243,7 +245,9 @@ EXPIMPL(TProfile);
 EXPIMPL(TProfile2D);
 EXPIMPL(TProfile3D);
 EXPIMPL(StepTHnF);
-EXPIMPL(StepTHnD)
+EXPIMPL(StepTHnD);
+EXPIMPL(StepTHnSparseF);
+EXPIMPL(StepTHnSparseD)
 #undef EXPIMPL
 
 } // namespace o2::framework
@@ -84,6 +84,13 @@ arrow::Status IndexColumnBuilder::preSlice()
   auto pair = static_cast<arrow::StructArray>(value_counts.array());
   mValuesArrow = std::make_shared<arrow::NumericArray<arrow::Int32Type>>(pair.field(0)->data());
   mCounts = std::make_shared<arrow::NumericArray<arrow::Int64Type>>(pair.field(1)->data());
+  // first row of each group, so that filling a slice does not need to sum the counts of all the preceding groups
+  mFirstEntries.resize(mCounts->length());
+  int64_t firstEntry = 0;
+  for (auto i = 0; i < mCounts->length(); ++i) {
+    mFirstEntries[i] = firstEntry;
+    firstEntry += mCounts->Value(i);
+  }
   return arrow::Status::OK();
 }
 
@@ -99,12 +106,10 @@ arrow::Status IndexColumnBuilder::preFind()
   for (auto i = 0; i < mSource->length(); ++i) {
     auto v = valueAt(i);
     if (v >= 0) {
-      mValues.emplace_back(v);
       mIndices[v].push_back(row);
     }
     ++row;
   }
-  std::sort(mValues.begin(), mValues.end());
 
   return arrow::Status::OK();
 }
@@ -175,7 +180,8 @@ bool IndexColumnBuilder::findSlice(int idx)
 
 bool IndexColumnBuilder::findMulti(int idx)
 {
-  return (std::find(mValues.begin(), mValues.end(), idx) != mValues.end());
+  // the rows are already grouped by value, no need to search
+  return (idx >= 0 && idx < (int)mIndices.size() && !mIndices[idx].empty());
 }
 
 void IndexColumnBuilder::fillSingle(int idx)
@@ -192,10 +198,7 @@ void IndexColumnBuilder::fillSlice(int idx)
 {
   int data[2] = {-1, -1};
   if (mValuePos < mValuesArrow->length() && mValuesArrow->Value(mValuePos) == idx) {
-    for (auto i = 0; i < mValuePos; ++i) {
-      data[0] += mCounts->Value(i);
-    }
-    data[0] += 1;
+    data[0] = mFirstEntries[mValuePos];
     data[1] = data[0] + mCounts->Value(mValuePos) - 1;
   }
   (void)static_cast<arrow::FixedSizeListBuilder*>(mListBuilder.get())->AppendValues(1);
@@ -205,7 +208,7 @@ void IndexColumnBuilder::fillSlice(int idx)
 void IndexColumnBuilder::fillMulti(int idx)
 {
   (void)static_cast<arrow::ListBuilder*>(mListBuilder.get())->Append();
-  if (std::find(mValues.begin(), mValues.end(), idx) != mValues.end()) {
+  if (findMulti(idx)) {
     (void)static_cast<arrow::Int32Builder*>(mValueBuilder)->AppendValues(mIndices[idx].data(), mIndices[idx].size());
   } else {
     (void)static_cast<arrow::Int32Builder*>(mValueBuilder)->AppendValues(nullptr, 0);
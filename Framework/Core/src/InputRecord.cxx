@@ -35,15 +35,20 @@ namespace o2::framework
 
 InputRecord::InputRecord(std::vector<InputRoute> const& inputsSchema,
                          InputSpan& span,
-                         ServiceRegistryRef registry)
+                         ServiceRegistryRef registry,
+                         InputRouteIndex const* index)
   : mRegistry{registry},
     mInputsSchema{inputsSchema},
-    mSpan{span}
+    mSpan{span},
+    mIndex{index}
 {
 }
 
 int InputRecord::getPos(const char* binding) const
 {
+  if (mIndex) {
+    return mIndex->getPos(binding);
+  }
   auto inputIndex = 0;
   for (size_t i = 0; i < mInputsSchema.size(); ++i) {
     auto& route = mInputsSchema[i];
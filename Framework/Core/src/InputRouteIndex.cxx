@@ -0,0 +1,57 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/InputRouteIndex.h"
+#include "Framework/InputRoute.h"
+#include "Framework/DataSpecUtils.h"
+#include "Framework/DataDescriptorMatcher.h"
+
+namespace o2::framework
+{
+
+InputRouteIndex::InputRouteIndex(std::vector<InputRoute> const& routes)
+{
+  size_t pos = 0;
+  for (auto const& route : routes) {
+    if (route.timeslice != 0) {
+      continue;
+    }
+    // Only the first input with a given binding can be found by getPos.
+    mBindings.emplace(route.matcher.binding, pos);
+    std::optional<ConcreteDataMatcher> concrete;
+    if (auto const* matcher = std::get_if<ConcreteDataMatcher>(&route.matcher.matcher)) {
+      concrete = *matcher;
+    } else if (auto const* matcher = std::get_if<data_matcher::DataDescriptorMatcher>(&route.matcher.matcher)) {
+      concrete = DataSpecUtils::optionalConcreteDataMatcherFrom(*matcher);
+    }
+    if (concrete) {
+      mConcrete.emplace(*concrete, pos);
+    } else {
+      mGeneric.push_back(pos);
+    }
+    ++pos;
+  }
+  mSize = pos;
+}
+
+int InputRouteIndex::getPos(std::string_view binding) const
+{
+  auto it = mBindings.find(binding);
+  return it == mBindings.end() ? -1 : it->second;
+}
+
+InputRouteIndex::Candidates InputRouteIndex::candidatesFor(ConcreteDataMatcher const& target) const
+{
+  auto it = mConcrete.find(target);
+  return {it == mConcrete.end() ? INVALID : it->second, mGeneric};
+}
+
+} // namespace o2::framework
@@ -17,7 +17,7 @@ template class std::function<o2::framework::DataRef(size_t, size_t)>;
 namespace o2::framework
 {
 InputSpan::InputSpan(std::function<DataRef(size_t)> getter, size_t size)
-  : mGetter{}, mNofPartsGetter{}, mSize{size}
+  : mGetter{}, mNofPartsGetter{}, mPayloadMessageGetter{}, mSize{size}
 {
   mGetter = [getter](size_t index, size_t) -> DataRef {
     return getter(index);
@@ -25,12 +25,12 @@ InputSpan::InputSpan(std::function<DataRef(size_t)> getter, size_t size)
 }
 
 InputSpan::InputSpan(std::function<DataRef(size_t, size_t)> getter, size_t size)
-  : mGetter{getter}, mNofPartsGetter{}, mSize{size}
+  : mGetter{getter}, mNofPartsGetter{}, mPayloadMessageGetter{}, mSize{size}
 {
 }
 
 InputSpan::InputSpan(std::function<DataRef(size_t, size_t)> getter, std::function<size_t(size_t)> nofPartsGetter, size_t size)
-  : mGetter{getter}, mNofPartsGetter{nofPartsGetter}, mSize{size}
+  : mGetter{getter}, mNofPartsGetter{nofPartsGetter}, mPayloadMessageGetter{}, mSize{size}
 {
 }
 
@@ -12,6 +12,8 @@
 #include "Framework/Logger.h"
 #include <uv.h>
 #include <functional>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 namespace o2::framework
@@ -101,6 +103,41 @@ void PluginManager::load(std::vector<PluginInfo>& libs, const char* dso, std::fu
   onSuccess(pluginInstance);
 }
 
+DPLPluginHandle* PluginManager::resolve(std::string const& library)
+{
+  // The libraries are never closed, so the handles stay valid
+  // for the whole lifetime of the process.
+  static std::mutex mutex;
+  static std::unordered_map<std::string, DPLPluginHandle*> cache;
+  std::scoped_lock<std::mutex> lock(mutex);
+  auto cached = cache.find(library);
+  if (cached != cache.end()) {
+    return cached->second;
+  }
+#ifdef __APPLE__
+  auto libraryName = fmt::format("lib{}.dylib", library);
+#else
+  auto libraryName = fmt::format("lib{}.so", library);
+#endif
+  auto* handle = (uv_lib_t*)malloc(sizeof(uv_lib_t));
+  if (uv_dlopen(libraryName.c_str(), handle) != 0) {
+    LOGP(error, "Could not load library {}", library);
+    LOG(error) << uv_dlerror(handle);
+    free(handle);
+    return nullptr;
+  }
+  DPLPluginHandle* (*dpl_plugin_callback)(DPLPluginHandle*) = nullptr;
+  if (uv_dlsym(handle, "dpl_plugin_callback", (void**)&dpl_plugin_callback) == -1 || dpl_plugin_callback == nullptr) {
+    LOGP(error, "Could not find dpl_plugin_callback in {}", libraryName);
+    LOG(error) << uv_dlerror(handle);
+    return nullptr;
+  }
+  LOGP(debug, "Resolving plugins from {}", libraryName);
+  DPLPluginHandle* pluginInstance = dpl_plugin_callback(nullptr);
+  cache[library] = pluginInstance;
+  return pluginInstance;
+}
+
 auto PluginManager::loadAlgorithmFromPlugin(std::string library, std::string plugin) -> AlgorithmSpec
 {
   std::shared_ptr<AlgorithmSpec> algorithm{nullptr};
@@ -109,30 +146,13 @@ auto PluginManager::loadAlgorithmFromPlugin(std::string library, std::string plu
       return algorithm->onInit(ic);
     }
 
-    uv_lib_t supportLib;
-    std::string libName = "lib" + library;
-#ifdef __APPLE__
-    libName += ".dylib";
-#else
-    libName += ".so";
-#endif
-    int result = uv_dlopen(libName.c_str(), &supportLib);
-    if (result == -1) {
-      LOG(fatal) << uv_dlerror(&supportLib);
-    }
-    DPLPluginHandle* (*dpl_plugin_callback)(DPLPluginHandle*);
-
-    result = uv_dlsym(&supportLib, "dpl_plugin_callback", (void**)&dpl_plugin_callback);
-    if (result == -1) {
-      LOG(fatal) << uv_dlerror(&supportLib);
-    }
-    if (dpl_plugin_callback == nullptr) {
-      LOGP(fatal, "Could not find the {} plugin in {}.", plugin, libName);
+    DPLPluginHandle* pluginInstance = PluginManager::resolve(library);
+    if (pluginInstance == nullptr) {
+      LOGP(fatal, "Could not load the {} plugin from {}.", plugin, library);
     }
-    DPLPluginHandle* pluginInstance = dpl_plugin_callback(nullptr);
     auto* creator = PluginManager::getByName<AlgorithmPlugin>(pluginInstance, plugin.c_str());
     if (!creator) {
-      LOGP(fatal, "Could not find the {} plugin in {}.", plugin, libName);
+      LOGP(fatal, "Could not find the {} plugin in {}.", plugin, library);
     }
     algorithm = std::make_shared<AlgorithmSpec>(creator->create());
     return algorithm->onInit(ic);
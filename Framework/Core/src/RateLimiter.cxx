@@ -16,15 +16,62 @@
 #include "Framework/DataTakingContext.h"
 #include "Framework/DeviceState.h"
 #include "Framework/DeviceContext.h"
+#include "Framework/DataProcessingStats.h"
 #include <fairmq/Device.h>
 #include <uv.h>
 #include <fairmq/shmem/Monitor.h>
 #include <fairmq/shmem/Common.h>
+#include <algorithm>
 #include <chrono>
 #include <thread>
 
 using namespace o2::framework;
 
+void AdmissionController::updateMemory(uint64_t freeMemory, int64_t inFlight)
+{
+  // The largest free memory we have seen is our best guess of what
+  // is available when no timeframe is in flight.
+  mMaxFree = std::max(mMaxFree, freeMemory);
+  if (inFlight <= 0) {
+    return;
+  }
+  double sample = double(mMaxFree - freeMemory) / inFlight;
+  mFootprint = mFootprint == 0 ? sample : (1 - SMOOTHING) * mFootprint + SMOOTHING * sample;
+}
+
+void AdmissionController::updateConsumed(int64_t consumed, double now)
+{
+  if (mLastConsumed < 0 || consumed < mLastConsumed) {
+    mLastConsumed = consumed;
+    mLastConsumedTime = now;
+    return;
+  }
+  if (consumed == mLastConsumed || now <= mLastConsumedTime) {
+    return;
+  }
+  double sample = (consumed - mLastConsumed) / (now - mLastConsumedTime);
+  mRate = mRate == 0 ? sample : (1 - SMOOTHING) * mRate + SMOOTHING * sample;
+  mLastConsumed = consumed;
+  mLastConsumedTime = now;
+}
+
+bool AdmissionController::admit(uint64_t freeMemory, uint64_t minSHM, int64_t inFlight) const
+{
+  if (freeMemory <= minSHM) {
+    return false;
+  }
+  return inFlight <= 0 || freeMemory - minSHM > mFootprint;
+}
+
+double AdmissionController::delay(double sinceLast, int64_t inFlight, int maxInFlight) const
+{
+  // Until the pipeline is half full we send as fast as possible.
+  if (mRate <= 0 || maxInFlight <= 0 || 2 * inFlight < maxInFlight) {
+    return 0;
+  }
+  return std::max(0., 1. / mRate - sinceLast);
+}
+
 int RateLimiter::check(ProcessingContext& ctx, int maxInFlight, size_t minSHM)
 {
   if (!maxInFlight && !minSHM) {
@@ -32,7 +79,21 @@ int RateLimiter::check(ProcessingContext& ctx, int maxInFlight, size_t minSHM)
   }
   auto device = ctx.services().get<RawDeviceService>().device();
   auto& deviceState = ctx.services().get<DeviceState>();
-  if (maxInFlight && device->GetChannels().count("metric-feedback")) {
+  auto& stats = ctx.services().get<DataProcessingStats>();
+  static bool predictive = getenv("DPL_PREDICTIVE_RATE_LIMITING") && atoi(getenv("DPL_PREDICTIVE_RATE_LIMITING"));
+  auto secondsSinceEpoch = []() { return std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::system_clock::now().time_since_epoch()).count(); };
+  bool hasFeedback = maxInFlight && device->GetChannels().count("metric-feedback");
+  if (hasFeedback && predictive) {
+    // Keep track of what was consumed also when we are not waiting,
+    // so that the consumption rate is known before the pipeline is full.
+    auto msg = device->NewMessageFor("metric-feedback", 0, 0);
+    while (device->Receive(msg, "metric-feedback", 0, 0) > 0) {
+      assert(msg->GetSize() == 8);
+      mConsumedTimeframes = *(int64_t*)msg->GetData();
+    }
+    mAdmission.updateConsumed(mConsumedTimeframes, secondsSinceEpoch());
+  }
+  if (hasFeedback) {
     auto& dtc = ctx.services().get<DataTakingContext>();
     const auto& device = ctx.services().get<RawDeviceService>().device();
     const auto& deviceContext = ctx.services().get<DeviceContext>();
@@ -67,6 +128,9 @@ int RateLimiter::check(ProcessingContext& ctx, int maxInFlight, size_t minSHM)
       }
       assert(msg->GetSize() == 8);
       mConsumedTimeframes = *(int64_t*)msg->GetData();
+      if (predictive) {
+        mAdmission.updateConsumed(mConsumedTimeframes, secondsSinceEpoch());
+      }
     }
     if (waitMessage) {
       if (dtc.deploymentMode == DeploymentMode::OnlineDDS || dtc.deploymentMode == DeploymentMode::OnlineECS || dtc.deploymentMode == DeploymentMode::FST) {
@@ -124,6 +188,17 @@ int RateLimiter::check(ProcessingContext& ctx, int maxInFlight, size_t minSHM)
       mLastTime = std::chrono::system_clock::now();
       mTfTimes[mSentTimeframes % maxInFlight] = curTime;
     }
+    if (predictive) {
+      float sinceLast = std::chrono::duration_cast<std::chrono::duration<float>>(std::chrono::system_clock::now() - mLastAdmission).count();
+      double wait = mAdmission.delay(sinceLast, mSentTimeframes - mConsumedTimeframes, maxInFlight);
+      stats.updateStats({(int)ProcessingStatsId::ADMISSION_DELAY_US, DataProcessingStats::Op::Set, (int64_t)(wait * 1.e6)});
+      stats.updateStats({(int)ProcessingStatsId::ADMISSION_CONSUMPTION_RATE_MHZ, DataProcessingStats::Op::Set, (int64_t)(mAdmission.consumptionRate() * 1000)});
+      if (wait > 0) {
+        LOG(debug) << "TF admission: waiting " << wait << " s to match the consumption rate of " << mAdmission.consumptionRate() << " TF/s";
+        uv_run(deviceState.loop, UV_RUN_NOWAIT);
+        std::this_thread::sleep_for(std::chrono::microseconds((size_t)(wait * 1.e6)));
+      }
+    }
   }
   if (minSHM) {
     int waitMessage = 0;
@@ -144,7 +219,16 @@ int RateLimiter::check(ProcessingContext& ctx, int maxInFlight, size_t minSHM)
         throw std::runtime_error("Could not obtain free SHM memory");
       }
       uint64_t freeSHM = freeMemory;
-      if (freeSHM > minSHM) {
+      // Without feedback we do not know how many timeframes are in flight,
+      // so we cannot estimate their footprint.
+      bool admitted = freeSHM > minSHM;
+      if (predictive && hasFeedback) {
+        auto inFlight = mSentTimeframes - mConsumedTimeframes;
+        mAdmission.updateMemory(freeSHM, inFlight);
+        admitted = mAdmission.admit(freeSHM, minSHM, inFlight);
+        stats.updateStats({(int)ProcessingStatsId::ADMISSION_TF_FOOTPRINT, DataProcessingStats::Op::Set, (int64_t)mAdmission.footprint()});
+      }
+      if (admitted) {
         if (waitMessage) {
           LOG(important) << "Sufficient SHM memory free (" << freeSHM << " >= " << minSHM << "), continuing to publish";
         }
@@ -155,12 +239,24 @@ int RateLimiter::check(ProcessingContext& ctx, int maxInFlight, size_t minSHM)
         break;
       }
       if (waitMessage == 0) {
-        LOG(alarm) << "Free SHM memory too low: " << freeSHM << " < " << minSHM << ", waiting";
+        if (freeSHM > minSHM) {
+          LOG(info) << "Free SHM memory " << freeSHM << " would go below " << minSHM << " with a timeframe of about " << mAdmission.footprint() << " bytes, waiting";
+        } else {
+          LOG(alarm) << "Free SHM memory too low: " << freeSHM << " < " << minSHM << ", waiting";
+        }
         waitMessage = 1;
       }
       usleep(30000);
+      if (predictive && hasFeedback) {
+        // Timeframes consumed in the meanwhile need to be accounted for the footprint.
+        auto msg = device->NewMessageFor("metric-feedback", 0, 0);
+        while (device->Receive(msg, "metric-feedback", 0, 0) > 0) {
+          mConsumedTimeframes = *(int64_t*)msg->GetData();
+        }
+      }
     }
   }
+  mLastAdmission = std::chrono::system_clock::now();
   mSentTimeframes++;
   return 0;
 }
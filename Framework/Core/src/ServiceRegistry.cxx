@@ -107,8 +107,16 @@ void ServiceRegistry::declareService(ServiceSpec const& spec, DeviceState& state
 {
   // We save the specs for the late binding
   mSpecs.push_back(spec);
-  // Services which are not stream must have a single instance created upfront.
-  if (spec.kind != ServiceKind::Stream) {
+  // Lazy services get booked now, but they are created only when requested.
+  if (spec.lazy && spec.kind != ServiceKind::Stream) {
+    if (!spec.uniqueId) {
+      throw runtime_error_f("Service %s is lazy, but does not have a uniqueId method.", spec.name.c_str());
+    }
+    mLazyState = &state;
+    mLazyOptions = &options;
+    this->registerService({spec.uniqueId()}, nullptr, spec.kind, salt, spec.name.c_str(), {static_cast<int>(mSpecs.size() - 1)});
+  } else if (spec.kind != ServiceKind::Stream) {
+    // Services which are not stream must have a single instance created upfront.
     ServiceHandle handle = spec.init({*this}, state, options);
     this->registerService({handle.hash}, handle.instance, handle.kind, salt, handle.name.c_str());
     this->bindService(salt, spec, handle.instance);
@@ -203,6 +211,9 @@ void* ServiceRegistry::get(ServiceTypeHash typeHash, Salt salt, ServiceKind kind
     if (ptr) {
       return ptr;
     }
+    if (mServicesMeta[pos].kind != ServiceKind::Stream && mServicesMeta[pos].specIndex.index != -1) {
+      return createLazyService(pos);
+    }
   }
   // We are looking up a service which is not of
   // stream kind and was not looked up by this thread
@@ -229,6 +240,9 @@ void* ServiceRegistry::get(ServiceTypeHash typeHash, Salt salt, ServiceKind kind
     LOGP(detail, "Caching global service {} for stream {}", name ? name : "", salt.streamId);
     mServicesKey[pos].load();
     std::atomic_thread_fence(std::memory_order_acquire);
+    if (mServicesValue[pos] == nullptr && mServicesMeta[pos].kind != ServiceKind::Stream && mServicesMeta[pos].specIndex.index != -1) {
+      createLazyService(pos);
+    }
     registerService(typeHash, mServicesValue[pos], kind, salt, name);
   }
   if (pos != -1) {
@@ -262,6 +276,30 @@ void* ServiceRegistry::get(ServiceTypeHash typeHash, Salt salt, ServiceKind kind
   return nullptr;
 }
 
+void* ServiceRegistry::createLazyService(int pos) const
+{
+  // Recursive, because the creation of a lazy service might
+  // need another lazy service.
+  static std::recursive_mutex lazyMutex;
+  std::scoped_lock<std::recursive_mutex> lock(lazyMutex);
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (mServicesValue[pos]) {
+    return mServicesValue[pos];
+  }
+  auto key = mServicesKey[pos].load();
+  auto& spec = mSpecs[mServicesMeta[pos].specIndex.index];
+  LOGP(detail, "Creating lazy service {} with hash {} in salt {}", spec.name, key.typeHash.hash, valueFromSalt(key.salt));
+  auto& registry = const_cast<ServiceRegistry&>(*this);
+  ServiceHandle handle = spec.init({registry, key.salt}, *mLazyState, *mLazyOptions);
+  if (handle.hash != key.typeHash.hash) {
+    throw runtime_error_f("Lazy service %s was created with a hash different from its uniqueId.", spec.name.c_str());
+  }
+  mServicesValue[pos] = handle.instance;
+  std::atomic_thread_fence(std::memory_order_release);
+  this->bindService(key.salt, spec, handle.instance);
+  return handle.instance;
+}
+
 void ServiceRegistry::postRenderGUICallbacks(ServiceRegistryRef ref)
 {
   for (auto& handle : mPostRenderGUIHandles) {
@@ -28,6 +28,7 @@
 
 ClassImp(StepTHn);
 templateClassImp(StepTHnT);
+templateClassImp(StepTHnSparseT);
 
 StepTHn::StepTHn() : mNBins(0),
                      mNVars(0),
@@ -433,6 +434,11 @@ void StepTHn::Fill(int iStep, int nParams, double positionAndWeight[])
     //     Printf("%lld", bin);
   }
 
+  addToStep(iStep, bin, weight);
+}
+
+void StepTHn::addToStep(Int_t iStep, Long64_t bin, Double_t weight)
+{
   if (!mValues[iStep]) {
     mValues[iStep] = createArray();
     LOGF(info, "Created values container for step %d", iStep);
@@ -453,5 +459,171 @@ void StepTHn::Fill(int iStep, int nParams, double positionAndWeight[])
   }
 }
 
+template <class TemplateArray>
+StepTHnSparseT<TemplateArray>::StepTHnSparseT(const char* name, const char* title, const int nSteps, const int nAxes, const int* nBins, const double* xmin, const double* xmax) : StepTHn(name, title, nSteps, nAxes)
+{
+  // the number of bins is only informative, no memory is allocated for them
+  mNBins = 1;
+  for (Int_t i = 0; i < mNVars; i++) {
+    mNBins *= nBins[i];
+  }
+  mPrototype = new THnSparseT<TemplateArray>(Form("%s_sparse", name), title, nAxes, nBins, xmin, xmax);
+  mSteps.SetOwner(kTRUE);
+}
+
+template <class TemplateArray>
+StepTHnSparseT<TemplateArray>::StepTHnSparseT(const Char_t* name, const Char_t* title, const Int_t nSteps, const Int_t nAxes,
+                                              Int_t* nBins, std::vector<Double_t> binEdges[], const char** axisTitles) : StepTHn(name, title, nSteps, nAxes)
+{
+  mNBins = 1;
+  for (Int_t i = 0; i < mNVars; i++) {
+    mNBins *= nBins[i];
+  }
+  mPrototype = new THnSparseT<TemplateArray>(Form("%s_sparse", name), title, nAxes, nBins);
+
+  for (Int_t i = 0; i < mNVars; i++) {
+    if (nBins[i] + 1 == binEdges[i].size()) { // variable-width binning
+      mPrototype->GetAxis(i)->Set(nBins[i], &(binEdges[i])[0]);
+    } else if (binEdges[i].size() == 2) { // equidistant binning
+      mPrototype->GetAxis(i)->Set(nBins[i], binEdges[i][0], binEdges[i][1]);
+    } else {
+      LOGF(fatal, "Invalid binning information for axis %d with %d bins and %d entries for bin edges", i, nBins[i], binEdges[i].size());
+    }
+    mPrototype->GetAxis(i)->SetTitle(axisTitles[i]);
+  }
+  mSteps.SetOwner(kTRUE);
+}
+
+template <class TemplateArray>
+StepTHnSparseT<TemplateArray>::StepTHnSparseT(const StepTHnSparseT& c) : StepTHn(c)
+{
+  mSteps.SetOwner(kTRUE);
+  c.copySteps(*this);
+}
+
+template <class TemplateArray>
+void StepTHnSparseT<TemplateArray>::Copy(TObject& c) const
+{
+  StepTHn::Copy(c);
+
+  // when called while the base class of a copy is constructed, the steps are copied by the copy constructor
+  auto* target = dynamic_cast<StepTHnSparseT<TemplateArray>*>(&c);
+  if (target) {
+    copySteps(*target);
+  }
+}
+
+template <class TemplateArray>
+void StepTHnSparseT<TemplateArray>::copySteps(StepTHnSparseT& target) const
+{
+  target.mSteps.Delete();
+  for (Int_t i = 0; i < mNSteps; i++) {
+    if (mSteps.At(i)) {
+      target.mSteps.AddAtAndExpand(mSteps.At(i)->Clone(), i);
+    }
+  }
+}
+
+template <class TemplateArray>
+Long64_t StepTHnSparseT<TemplateArray>::Merge(TCollection* list)
+{
+  // Merge a list of StepTHnSparse objects with this.
+  // Returns the number of merged objects (including this).
+
+  if (!list) {
+    return 0;
+  }
+
+  if (list->IsEmpty()) {
+    return 1;
+  }
+
+  TIterator* iter = list->MakeIterator();
+  TObject* obj;
+
+  Int_t count = 0;
+  while ((obj = iter->Next())) {
+
+    auto* entry = dynamic_cast<StepTHnSparseT<TemplateArray>*>(obj);
+    if (entry == nullptr) {
+      continue;
+    }
+
+    // only the populated bins are added
+    for (Int_t i = 0; i < mNSteps; i++) {
+      auto* source = entry->getSparse(i);
+      if (!source) {
+        continue;
+      }
+      if (auto* target = getSparse(i)) {
+        target->Add(source);
+      } else {
+        mSteps.AddAtAndExpand(source->Clone(), i);
+      }
+    }
+
+    count++;
+  }
+
+  return count + 1;
+}
+
+template <class TemplateArray>
+void StepTHnSparseT<TemplateArray>::addToStep(Int_t iStep, Long64_t, Double_t weight)
+{
+  auto* step = getSparse(iStep);
+  if (!step) {
+    step = THnSparse::CreateSparse(Form("%s_%d", GetName(), iStep), Form("%s_%d", GetTitle(), iStep), mPrototype);
+    mSteps.AddAtAndExpand(step, iStep);
+    LOGF(info, "Created sparse container for step %d", iStep);
+  }
+
+  if (weight != 1. && !step->GetCalculateErrors()) {
+    // the errors of the entries filled so far (with weight == 1) are initialised from their content
+    step->Sumw2();
+  }
+
+  // the bins are only allocated when they are filled
+  auto bin = step->GetBin(mLastBins, kTRUE);
+  step->AddBinContent(bin, weight);
+  if (step->GetCalculateErrors()) {
+    step->AddBinError2(bin, weight * weight);
+  }
+  step->SetEntries(step->GetEntries() + 1);
+}
+
+template <class TemplateArray>
+void StepTHnSparseT<TemplateArray>::createTarget(Int_t step, Bool_t sparse)
+{
+  // copies the populated bins of the step into the target histogram
+
+  auto* source = getSparse(step);
+  if (!source) {
+    LOGF(fatal, "Histogram request for step %d which is empty.", step);
+    return;
+  }
+
+  if (!mTarget) {
+    mTarget = new THnBase*[mNSteps];
+    for (Int_t i = 0; i < mNSteps; i++) {
+      mTarget[i] = nullptr;
+    }
+  }
+
+  if (mTarget[step]) {
+    return;
+  }
+
+  if (sparse) {
+    mTarget[step] = THnSparse::CreateSparse(Form("%s_%d", GetName(), step), Form("%s_%d", GetTitle(), step), source);
+  } else {
+    mTarget[step] = THn::CreateHn(Form("%s_%d", GetName(), step), Form("%s_%d", GetTitle(), step), source);
+  }
+
+  LOGF(info, "Step %d: copied %lld filled bins", step, source->GetNbins());
+}
+
 template class StepTHnT<TArrayF>;
 template class StepTHnT<TArrayD>;
+template class StepTHnSparseT<TArrayF>;
+template class StepTHnSparseT<TArrayD>;
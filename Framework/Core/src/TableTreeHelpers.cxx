@@ -552,7 +552,7 @@ void TreeToTable::fill(TTree*)
 {
   std::vector<std::shared_ptr<arrow::ChunkedArray>> columns;
   std::vector<std::shared_ptr<arrow::Field>> fields;
-  static TBufferFile buffer{TBuffer::EMode::kWrite, 4 * 1024 * 1024};
+  thread_local TBufferFile buffer{TBuffer::EMode::kWrite, 4 * 1024 * 1024}; // tables may be read ahead in another thread
   for (auto& reader : mBranchReaders) {
     buffer.Reset();
     auto arrayAndField = reader->read(&buffer);
@@ -566,7 +566,7 @@ void TreeToTable::fill(TTree*)
 
 void TreeToTable::addReader(TBranch* branch, std::string const& name, bool VLA)
 {
-  static TClass* cls;
+  TClass* cls;
   EDataType type;
   branch->GetExpectedType(cls, type);
   auto listSize = -1;
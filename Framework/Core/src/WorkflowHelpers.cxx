@@ -24,11 +24,13 @@
 #include "Framework/PluginManager.h"
 #include "Framework/DataTakingContext.h"
 #include "Framework/DefaultsHelpers.h"
+#include "Framework/VariantHelpers.h"
 
 #include "Headers/DataHeader.h"
 #include <algorithm>
 #include <list>
 #include <set>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 #include <climits>
@@ -45,6 +47,103 @@ std::ostream& operator<<(std::ostream& out, TopoIndexInfo const& info)
   return out;
 }
 
+namespace
+{
+// The AOD reader reads only the columns declared via "column:<label>" metadata
+// by the subscribers of a table. Subscribers which do not declare them, e.g. plain
+// InputSpecs or the spawners and builders, get all of them.
+InputSpec withAllColumns(InputSpec spec)
+{
+  if (std::none_of(spec.metadata.begin(), spec.metadata.end(), [](ConfigParamSpec const& p) { return p.name.rfind("column:", 0) == 0; })) {
+    spec.metadata.emplace_back(ConfigParamSpec{"column:*", VariantType::Bool, true, {"\"\""}});
+  }
+  return spec;
+}
+
+// Key to look up outputs by origin, description and, for the concrete ones, subspec.
+struct DataTypeKey {
+  header::DataOrigin::ItgType origin = 0;
+  header::DataDescription::ItgType description[2] = {0, 0};
+  header::DataHeader::SubSpecificationType subSpec = 0;
+  bool operator==(DataTypeKey const&) const = default;
+};
+
+struct DataTypeKeyHash {
+  size_t operator()(DataTypeKey const& key) const
+  {
+    size_t hash = std::hash<uint64_t>{}(key.description[0]);
+    hash ^= std::hash<uint64_t>{}(key.description[1]) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+    hash ^= std::hash<uint64_t>{}(((uint64_t)key.origin << 32) | key.subSpec) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+    return hash;
+  }
+};
+
+DataTypeKey makeDataTypeKey(header::DataOrigin const& origin, header::DataDescription const& description, header::DataHeader::SubSpecificationType subSpec = 0)
+{
+  return DataTypeKey{origin.itg[0], {description.itg[0], description.itg[1]}, subSpec};
+}
+
+// Index of the outputs of a workflow, so that the graph construction only
+// needs to check an input against the outputs which can possibly match it,
+// rather than against all of them.
+struct OutputsIndex {
+  using Map = std::unordered_map<DataTypeKey, std::vector<size_t>, DataTypeKeyHash>;
+  /// ConcreteDataMatcher outputs, by origin, description and subspec
+  Map concrete;
+  /// ConcreteDataTypeMatcher outputs, by origin and description
+  Map wildcard;
+  /// All the outputs, by origin and description
+  Map dataType;
+
+  explicit OutputsIndex(std::vector<OutputSpec> const& outputs)
+  {
+    for (size_t oi = 0; oi < outputs.size(); ++oi) {
+      std::visit(overloaded{
+                   [&](ConcreteDataMatcher const& matcher) {
+                     concrete[makeDataTypeKey(matcher.origin, matcher.description, matcher.subSpec)].push_back(oi);
+                     dataType[makeDataTypeKey(matcher.origin, matcher.description)].push_back(oi);
+                   },
+                   [&](ConcreteDataTypeMatcher const& matcher) {
+                     wildcard[makeDataTypeKey(matcher.origin, matcher.description)].push_back(oi);
+                     dataType[makeDataTypeKey(matcher.origin, matcher.description)].push_back(oi);
+                   }},
+                 outputs[oi].matcher);
+    }
+  }
+
+  /// Invoke @a callback with the index of every output which can match @a input.
+  /// Candidates still need to be checked with DataSpecUtils::match.
+  /// @return false if the input does not allow for a lookup, e.g. because it
+  ///         has a wildcard origin, and all the outputs need to be checked.
+  template <typename F>
+  bool forEachCandidate(InputSpec const& input, F&& callback) const
+  {
+    auto visitAll = [&callback](Map const& map, DataTypeKey const& key) {
+      if (auto it = map.find(key); it != map.end()) {
+        for (auto oi : it->second) {
+          callback(oi);
+        }
+      }
+    };
+    if (auto const* matcher = std::get_if<ConcreteDataMatcher>(&input.matcher)) {
+      visitAll(concrete, makeDataTypeKey(matcher->origin, matcher->description, matcher->subSpec));
+      visitAll(wildcard, makeDataTypeKey(matcher->origin, matcher->description));
+      return true;
+    }
+    auto const* matcher = std::get_if<data_matcher::DataDescriptorMatcher>(&input.matcher);
+    if (matcher == nullptr) {
+      return false;
+    }
+    auto type = DataSpecUtils::optionalConcreteDataTypeMatcherFrom(*matcher);
+    if (!type) {
+      return false;
+    }
+    visitAll(dataType, makeDataTypeKey(type->origin, type->description));
+    return true;
+  }
+};
+} // namespace
+
 std::vector<TopoIndexInfo>
   WorkflowHelpers::topologicalSort(size_t nodeCount,
                                    int const* edgeIn,
@@ -175,7 +274,7 @@ void WorkflowHelpers::addMissingOutputsToSpawner(std::vector<OutputSpec> const&
         if (j == publisher.inputs.end()) {
           publisher.inputs.push_back(spec);
         }
-        DataSpecUtils::updateInputList(requestedAODs, std::move(spec));
+        DataSpecUtils::updateInputList(requestedAODs, withAllColumns(std::move(spec)));
       }
     }
   }
@@ -197,7 +296,7 @@ void WorkflowHelpers::addMissingOutputsToBuilder(std::vector<InputSpec> const& r
           publisher.inputs.push_back(spec);
         }
         if (DataSpecUtils::partialMatch(spec, AODOrigins)) {
-          DataSpecUtils::updateInputList(requestedAODs, std::move(spec));
+          DataSpecUtils::updateInputList(requestedAODs, withAllColumns(std::move(spec)));
         } else if (DataSpecUtils::partialMatch(spec, header::DataOrigin{"DYN"})) {
           DataSpecUtils::updateInputList(requestedDYNs, std::move(spec));
         }
@@ -256,6 +355,8 @@ void WorkflowHelpers::injectServiceDevices(WorkflowSpec& workflow, ConfigContext
                 {"condition-tf-per-query", VariantType::Int, defaultConditionQueryRate(), {"check condition validity per requested number of TFs, fetch only once if <=0"}},
                 {"condition-tf-per-query-multiplier", VariantType::Int, defaultConditionQueryRateMultiplier(), {"check conditions once per this amount of nominal checks"}},
                 {"condition-time-tolerance", VariantType::Int64, 5000ll, {"prefer creation time if its difference to orbit-derived time exceeds threshold (ms), impose if <0"}},
+                {"condition-prefetch-ms", VariantType::Int64, 0ll, {"download in the background objects for the next validity interval when the current one ends within this time (ms), 0 disables"}},
+                {"condition-prefetch-max-bytes", VariantType::Int64, 1000000000ll, {"maximum size of the objects kept by the prefetcher"}},
                 {"orbit-offset-enumeration", VariantType::Int64, 0ll, {"initial value for the orbit"}},
                 {"orbit-multiplier-enumeration", VariantType::Int64, 0ll, {"multiplier to get the orbit from the counter"}},
                 {"start-value-enumeration", VariantType::Int64, 0ll, {"initial value for the enumeration"}},
@@ -296,6 +397,9 @@ void WorkflowHelpers::injectServiceDevices(WorkflowSpec& workflow, ConfigContext
                 ConfigParamSpec{"aod-reader-json", VariantType::String, {"json configuration file"}},
                 ConfigParamSpec{"aod-parent-access-level", VariantType::String, {"Allow parent file access up to specified level. Default: no (0)"}},
                 ConfigParamSpec{"aod-parent-base-path-replacement", VariantType::String, {R"(Replace base path of parent files. Syntax: FROM;TO. E.g. "alien:///path/in/alien;/local/path". Enclose in "" on the command line.)"}},
+                ConfigParamSpec{"aod-read-ahead", VariantType::Int, 0, {"Number of DFs of the current file to read ahead in the background. Default: no read-ahead (0)"}},
+                ConfigParamSpec{"aod-read-ahead-max-bytes", VariantType::Int64, 1000000000ll, {"Maximum uncompressed size of the DFs read ahead, per input descriptor"}},
+                ConfigParamSpec{"aod-read-ahead-threads", VariantType::Int, 1, {"Number of threads reading ahead different DFs of the current file, per input descriptor"}},
                 ConfigParamSpec{"time-limit", VariantType::Int64, 0ll, {"Maximum run time limit in seconds"}},
                 ConfigParamSpec{"orbit-offset-enumeration", VariantType::Int64, 0ll, {"initial value for the orbit"}},
                 ConfigParamSpec{"orbit-multiplier-enumeration", VariantType::Int64, 0ll, {"multiplier to get the orbit from the counter"}},
@@ -420,7 +524,7 @@ void WorkflowHelpers::injectServiceDevices(WorkflowSpec& workflow, ConfigContext
           break;
       }
       if (DataSpecUtils::partialMatch(input, AODOrigins)) {
-        DataSpecUtils::updateInputList(requestedAODs, InputSpec{input});
+        DataSpecUtils::updateInputList(requestedAODs, withAllColumns(input));
       }
       if (DataSpecUtils::partialMatch(input, header::DataOrigin{"DYN"})) {
         DataSpecUtils::updateInputList(requestedDYNs, InputSpec{input});
@@ -876,12 +980,22 @@ void WorkflowHelpers::constructGraph(const WorkflowSpec& workflow,
   // parallel pipeline and add an edge for each.
   enumerateAvailableOutputs();
 
+  // Forwards reuse the global index of the original output, so the index
+  // does not need to be updated while the graph is constructed.
+  OutputsIndex outputsIndex(constOutputs);
   std::vector<bool> matches(constOutputs.size());
   for (size_t consumer = 0; consumer < workflow.size(); ++consumer) {
     for (size_t input = 0; input < workflow[consumer].inputs.size(); ++input) {
       forwards.clear();
-      for (size_t i = 0; i < constOutputs.size(); i++) {
-        matches[i] = DataSpecUtils::match(workflow[consumer].inputs[input], constOutputs[i]);
+      auto const& inputSpec = workflow[consumer].inputs[input];
+      std::fill(matches.begin(), matches.end(), false);
+      bool indexed = outputsIndex.forEachCandidate(inputSpec, [&](size_t oi) {
+        matches[oi] = DataSpecUtils::match(inputSpec, constOutputs[oi]);
+      });
+      if (!indexed) {
+        for (size_t i = 0; i < constOutputs.size(); i++) {
+          matches[i] = DataSpecUtils::match(inputSpec, constOutputs[i]);
+        }
       }
 
       for (size_t i = 0; i < availableOutputsInfo.size(); i++) {
@@ -1104,6 +1218,9 @@ std::shared_ptr<DataOutputDirector> WorkflowHelpers::getDataOutputDirector(Confi
       ntfmerge = ntfm;
     }
   }
+  if (options.isSet("aod-writer-nthreads")) {
+    dod->setNumberWriterThreads(options.get<int>("aod-writer-nthreads"));
+  }
   // parse the keepString
   if (options.isSet("aod-writer-keep")) {
     auto keepString = options.get<std::string>("aod-writer-keep");
@@ -29,6 +29,7 @@
 #include "Framework/DeviceInfo.h"
 #include "Framework/DeviceMetricsInfo.h"
 #include "Framework/DeviceMetricsHelper.h"
+#include "Framework/DeviceMetricsRingBuffer.h"
 #include "Framework/DeviceConfigInfo.h"
 #include "Framework/DeviceSpec.h"
 #include "Framework/DeviceState.h"
@@ -170,6 +171,11 @@ using DeviceControls = std::vector<DeviceControl>;
 using DataProcessorSpecs = std::vector<DataProcessorSpec>;
 
 std::vector<DeviceMetricsInfo> gDeviceMetricsInfos;
+// Binary metrics channel for each of the devices, nullptr if not available
+// (e.g. for remote devices). Same index as gDeviceMetricsInfos.
+std::vector<std::unique_ptr<DeviceMetricsSharedMemory>> gDeviceMetricsRings;
+// Number of records which can be buffered for each device.
+static constexpr size_t DPL_METRICS_RING_CAPACITY = 16384;
 
 // FIXME: probably find a better place
 // these are the device options added by the framework, but they can be
@@ -416,6 +422,7 @@ void spawnRemoteDevice(uv_loop_t* loop,
                          TimingHelpers::defaultCPUTimeConfigurator(loop));
   // Let's add also metrics information for the given device
   gDeviceMetricsInfos.emplace_back(DeviceMetricsInfo{});
+  gDeviceMetricsRings.emplace_back(nullptr);
 }
 
 struct DeviceLogContext {
@@ -696,6 +703,16 @@ void spawnDevice(uv_loop_t* loop,
       service.preFork(serviceRegistry, DeviceConfig{varmap});
     }
   }
+  // The binary metrics channel needs to exist before the child starts. If it
+  // cannot be created, the device will simply send its metrics as text.
+  std::unique_ptr<DeviceMetricsSharedMemory> metricsRing;
+  if (getenv("DPL_DISABLE_METRICS_SHM") == nullptr) {
+    try {
+      metricsRing = DeviceMetricsSharedMemory::create(fmt::format("/dpl-metrics-{}-{}", getpid(), ref.index), DPL_METRICS_RING_CAPACITY);
+    } catch (...) {
+      LOGP(warning, "Unable to create the metrics shared memory for {}. Metrics will be sent as text.", spec.id);
+    }
+  }
   // If we have a framework id, it means we have already been respawned
   // and that we are in a child. If not, we need to fork and re-exec, adding
   // the framework-id as one of the options.
@@ -747,6 +764,9 @@ void spawnDevice(uv_loop_t* loop,
     for (auto& env : execution.environ) {
       putenv(strdup(DeviceSpecHelpers::reworkTimeslicePlaceholder(env, spec).data()));
     }
+    if (metricsRing) {
+      setenv(DeviceMetricsSharedMemory::ENV_NAME, metricsRing->name().c_str(), 1);
+    }
     execvp(execution.args[0], execution.args.data());
   } else {
     O2_SIGNPOST_ID_GENERATE(sid, driver);
@@ -831,6 +851,43 @@ void spawnDevice(uv_loop_t* loop,
 
   // Let's add also metrics information for the given device
   gDeviceMetricsInfos.emplace_back(DeviceMetricsInfo{});
+  gDeviceMetricsRings.emplace_back(std::move(metricsRing));
+}
+
+/// Bulk read the binary metrics the devices pushed in their
+/// shared memory ring.
+void processChildrenMetrics(DriverServerContext& context)
+{
+  assert(context.metrics);
+  assert(context.infos);
+  bool didProcessMetric = false;
+  for (size_t di = 0; di < gDeviceMetricsRings.size() && di < context.metrics->size(); ++di) {
+    if (!gDeviceMetricsRings[di]) {
+      continue;
+    }
+    DeviceInfo& info = (*context.infos)[di];
+    std::array<Metric2DViewIndex*, 2> model = {&info.inputChannelMetricsViewIndex,
+                                               &info.outputChannelMetricsViewIndex};
+    auto updateMetricsViews = Metric2DViewIndex::getUpdater();
+    auto newMetricCallback = [&](std::string const& name, MetricInfo const& metric, int value, size_t metricIndex) {
+      updateMetricsViews(model, name, metric, value, metricIndex);
+    };
+    auto& metricsInfo = (*context.metrics)[di];
+    didProcessMetric |= gDeviceMetricsRings[di]->ring().consume([&](MetricRecord const& record) {
+      DeviceMetricsHelper::processMetric(record, metricsInfo, newMetricCallback);
+    }) > 0;
+  }
+  if (!didProcessMetric) {
+    return;
+  }
+  // Same post processing as for the metrics received via websocket.
+  size_t timestamp = (uv_hrtime() - context.driver->startTime) / 1000000 + context.driver->startTimeMsFromEpoch;
+  for (auto& callback : *context.metricProcessingCallbacks) {
+    callback(context.registry, ServiceMetricsInfo{*context.metrics, *context.specs, *context.infos, context.driver->metrics, *context.driver}, timestamp);
+  }
+  for (auto& metricsInfo : *context.metrics) {
+    std::fill(metricsInfo.changed.begin(), metricsInfo.changed.end(), false);
+  }
 }
 
 void processChildrenOutput(uv_loop_t* loop,
@@ -1055,6 +1112,7 @@ int doChild(int argc, char** argv, ServiceRegistry& serviceRegistry,
       ("expected-region-callbacks", bpo::value<std::string>()->default_value("0"), "how many region callbacks we are expecting")                                                           //
       ("exit-transition-timeout", bpo::value<std::string>()->default_value(defaultExitTransitionTimeout), "how many second to wait before switching from RUN to READY")                    //
       ("timeframes-rate-limit", bpo::value<std::string>()->default_value("0"), "how many timeframe can be in fly at the same moment (0 disables)")                                         //
+      ("output-arena", bpo::value<std::string>()->default_value(""), "<block size>:<blocks>:<max message size> of the arena for small outputs (empty disables)")                           //
       ("configuration,cfg", bpo::value<std::string>()->default_value("command-line"), "configuration backend")                                                                             //
       ("infologger-mode", bpo::value<std::string>()->default_value(defaultInfologgerMode), "O2_INFOLOGGER_MODE override");
     r.fConfig.AddToCmdLineOptions(optsDesc, true);
@@ -1241,6 +1299,8 @@ std::vector<std::regex> getDumpableMetrics()
   dumpableMetrics.emplace_back("^total-timeframes.*");
   dumpableMetrics.emplace_back("^device_state.*");
   dumpableMetrics.emplace_back("^total_wall_time_ms$");
+  dumpableMetrics.emplace_back("^shm-offer-bytes-consumed$");
+  dumpableMetrics.emplace_back("^available_managed_shm_.*");
   return dumpableMetrics;
 }
 
@@ -1516,6 +1576,14 @@ int runStateMachine(DataProcessorSpecs const& workflow,
 
   uv_timer_t metricDumpTimer;
   metricDumpTimer.data = &serverContext;
+  // Nothing wakes up the loop when a device pushes binary metrics, so
+  // we poll the shared memory rings at a fixed interval.
+  uv_timer_t metricsRingTimer;
+  uv_timer_init(loop, &metricsRingTimer);
+  metricsRingTimer.data = &serverContext;
+  uv_timer_start(&metricsRingTimer, [](uv_timer_t* handle) {
+    processChildrenMetrics(*(DriverServerContext*)handle->data);
+  }, 100, 100);
   bool allChildrenGone = false;
   guiContext.allChildrenGone = &allChildrenGone;
   O2_SIGNPOST_ID_FROM_POINTER(sid, driver, loop);
@@ -1566,6 +1634,7 @@ int runStateMachine(DataProcessorSpecs const& workflow,
       current = DriverState::UNKNOWN;
     }
     driverInfo.states.pop_back();
+    auto stateStart = uv_hrtime();
     switch (current) {
       case DriverState::BIND_GUI_PORT:
         bindGUIPort(driverInfo, serverContext, frameworkId);
@@ -2022,6 +2091,7 @@ int runStateMachine(DataProcessorSpecs const& workflow,
             "--aod-memory-rate-limit",
             "--aod-writer-json",
             "--aod-writer-ntfmerge",
+            "--aod-writer-nthreads",
             "--aod-writer-resdir",
             "--aod-writer-resfile",
             "--aod-writer-resmode",
@@ -2029,6 +2099,9 @@ int runStateMachine(DataProcessorSpecs const& workflow,
             "--aod-writer-keep",
             "--aod-parent-access-level",
             "--aod-parent-base-path-replacement",
+            "--aod-read-ahead",
+            "--aod-read-ahead-max-bytes",
+            "--aod-read-ahead-threads",
             "--driver-client-backend",
             "--fairmq-ipc-prefix",
             "--readers",
@@ -2165,6 +2238,23 @@ int runStateMachine(DataProcessorSpecs const& workflow,
           driverInfo.states.push_back(DriverState::RUNNING);
           driverInfo.states.push_back(DriverState::REDEPLOY_GUI);
         } else {
+          if (driverInfo.startupReported == false) {
+            driverInfo.startupReported = true;
+            // RUNNING is left out, since it mostly waits in the event loop.
+            std::string phases;
+            for (int i = 0; i < (int)DriverState::LAST; ++i) {
+              auto duration = driverInfo.stateDurations[i];
+              if (duration == 0 || i == (int)DriverState::RUNNING) {
+                continue;
+              }
+              phases += fmt::format(" {}: {:.1f} ms,", DriverInfoHelper::stateToString((DriverState)i), duration / 1.e6);
+            }
+            if (!phases.empty()) {
+              phases.pop_back();
+            }
+            LOGP(info, "All {} devices scheduled {:.1f} ms after startup. Time spent per phase:{}",
+                 runningWorkflow.devices.size(), (uv_hrtime() - driverInfo.startTime) / 1.e6, phases);
+          }
           driverInfo.states.push_back(DriverState::RUNNING);
         }
         break;
@@ -2225,6 +2315,9 @@ int runStateMachine(DataProcessorSpecs const& workflow,
         }
       } break;
       case DriverState::EXIT: {
+        // Make sure we get the last binary metrics before dumping them.
+        uv_timer_stop(&metricsRingTimer);
+        processChildrenMetrics(serverContext);
         if (ResourcesMonitoringHelper::isResourcesMonitoringEnabled(driverInfo.resourcesMonitoringInterval)) {
           if (driverInfo.resourcesMonitoringDumpInterval) {
             uv_timer_stop(&metricDumpTimer);
@@ -2277,6 +2370,7 @@ int runStateMachine(DataProcessorSpecs const& workflow,
                    << "). Shutting down.";
         driverInfo.states.push_back(DriverState::QUIT_REQUESTED);
     }
+    driverInfo.stateDurations[(int)current] += uv_hrtime() - stateStart;
   }
   O2_SIGNPOST_END(driver, sid, "driver", "End driver loop");
 }
@@ -3082,7 +3176,7 @@ int doMain(int argc, char** argv, o2::framework::WorkflowSpec const& workflow,
   } else {
     auto printAllSignposts = [](char const* name, void* l, void* context) {
       auto* log = (_o2_log_t*)l;
-      LOGP(detail, "Signpost stream {} disabled. Enable it with o2-log -p {} -a {}", name, pid, (void*)&log->stacktrace);
+      LOGP(detail, "Signpost stream {} disabled. Enable it with o2-log -p {} -a {}, trace it with o2-log -p {} -a {}", name, pid, (void*)&log->stacktrace, pid, (void*)&log->trace);
       return true;
     };
     o2_walk_logs(printAllSignposts, nullptr);
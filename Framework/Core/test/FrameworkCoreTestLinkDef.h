@@ -25,3 +25,7 @@
 #pragma link C++ class StepTHnT < TArrayD> + ;
 #pragma link C++ typedef StepTHnF;
 #pragma link C++ typedef StepTHnD;
+#pragma link C++ class StepTHnSparseT < TArrayF> + ;
+#pragma link C++ class StepTHnSparseT < TArrayD> + ;
+#pragma link C++ typedef StepTHnSparseF;
+#pragma link C++ typedef StepTHnSparseD;
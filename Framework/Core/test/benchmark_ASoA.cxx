@@ -260,6 +260,36 @@ static void BM_ASoASimpleForLoopWithOp(benchmark::State& state)
 
 BENCHMARK(BM_ASoASimpleForLoopWithOp)->Range(8, 8 << maxrange);
 
+static void BM_ASoABatchesWithOp(benchmark::State& state)
+{
+  // Seed with a real random value, if available
+  std::default_random_engine e1(1234567891);
+  std::uniform_real_distribution<float> uniform_dist(0, 1);
+
+  TableBuilder builder;
+  auto rowWriter = builder.persist<float, float, float>({"x", "y", "z"});
+  for (auto i = 0; i < state.range(0); ++i) {
+    rowWriter(0, uniform_dist(e1), uniform_dist(e1), uniform_dist(e1));
+  }
+  auto table = builder.finalize();
+
+  using Test = o2::soa::Table<test::X, test::Y>;
+
+  for (auto _ : state) {
+    Test tests{table};
+    float sum = 0;
+    for (auto [xs, ys] : tests.batches<test::X, test::Y>()) {
+      for (auto i = 0U; i < xs.size(); ++i) {
+        sum += xs[i] + ys[i];
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(float) * 2);
+}
+
+BENCHMARK(BM_ASoABatchesWithOp)->Range(8, 8 << maxrange);
+
 static void BM_ASoADynamicColumnPresent(benchmark::State& state)
 {
   // Seed with a real random value, if available
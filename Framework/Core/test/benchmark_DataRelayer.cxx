@@ -15,9 +15,15 @@
 #include "Framework/CompletionPolicyHelpers.h"
 #include "Framework/DataRelayer.h"
 #include "Framework/DataProcessingHeader.h"
+#include "Framework/DataProcessingStats.h"
+#include "Framework/DataProcessingStates.h"
+#include "Framework/DriverConfig.h"
+#include "Framework/TimingHelpers.h"
 #include <Monitoring/Monitoring.h>
 #include <fairmq/TransportFactory.h>
+#include <uv.h>
 #include <cstring>
+#include <memory>
 #include <vector>
 
 using Monitoring = o2::monitoring::Monitoring;
@@ -354,4 +360,86 @@ static void BM_RelayMultiplePayloads(benchmark::State& state)
 
 BENCHMARK(BM_RelayMultiplePayloads)->Arg(10)->Arg(100)->Arg(1000);
 
+// Services needed by a DataRelayer which is actually relaying from
+// more than one thread, shared by all the threads of a benchmark.
+struct ConcurrentRelayerContext {
+  ConcurrentRelayerContext(size_t nSlots)
+  {
+    ServiceRegistryRef ref{registry};
+    using MetricSpec = DataProcessingStats::MetricSpec;
+    std::vector<MetricSpec> specs{
+      MetricSpec{.name = "malformed_inputs", .metricId = static_cast<short>(ProcessingStatsId::MALFORMED_INPUTS)},
+      MetricSpec{.name = "dropped_computations", .metricId = static_cast<short>(ProcessingStatsId::DROPPED_COMPUTATIONS)},
+      MetricSpec{.name = "dropped_incoming_messages", .metricId = static_cast<short>(ProcessingStatsId::DROPPED_INCOMING_MESSAGES)},
+      MetricSpec{.name = "relayed_messages", .metricId = static_cast<short>(ProcessingStatsId::RELAYED_MESSAGES)}};
+    for (auto& spec : specs) {
+      stats.registerMetric(spec);
+    }
+    ref.registerService(ServiceRegistryHelpers::handleForService<Monitoring>(&monitoring));
+    ref.registerService(ServiceRegistryHelpers::handleForService<DataProcessingStats>(&stats));
+    ref.registerService(ServiceRegistryHelpers::handleForService<DataProcessingStates>(&states));
+    ref.registerService(ServiceRegistryHelpers::handleForService<DriverConfig const>(&driverConfig));
+    ref.registerService(ServiceRegistryHelpers::handleForService<TimesliceIndex>(&index));
+    relayer = std::make_unique<DataRelayer>(CompletionPolicyHelpers::consumeWhenAll(), inputs, index, ref);
+    relayer->setPipelineLength(nSlots);
+  }
+
+  ServiceRegistry registry;
+  Monitoring monitoring;
+  const DriverConfig driverConfig{.batch = false};
+  DataProcessingStates states{TimingHelpers::defaultRealtimeBaseConfigurator(0, uv_default_loop()),
+                              TimingHelpers::defaultCPUTimeConfigurator(uv_default_loop())};
+  DataProcessingStats stats{TimingHelpers::defaultRealtimeBaseConfigurator(0, uv_default_loop()),
+                            TimingHelpers::defaultCPUTimeConfigurator(uv_default_loop())};
+  std::vector<InputRoute> inputs = {InputRoute{InputSpec{"clusters", "TPC", "CLUSTERS"}, 0, "Fake", 0}};
+  std::vector<InputChannelInfo> infos{1};
+  TimesliceIndex index{1, infos};
+  std::unique_ptr<DataRelayer> relayer;
+};
+
+// Every thread (e.g. a different stream) relays state.range(0) parts of
+// its own timeslices and then consumes them, so only the first part of a
+// timeslice requires a new slot while the others go to one already in flight.
+static void BM_RelayConcurrentSlots(benchmark::State& state)
+{
+  static std::unique_ptr<ConcurrentRelayerContext> context;
+  const int nParts = state.range(0);
+  if (state.thread_index() == 0) {
+    context = std::make_unique<ConcurrentRelayerContext>(state.threads());
+  }
+
+  DataHeader dh;
+  dh.dataDescription = "CLUSTERS";
+  dh.dataOrigin = "TPC";
+  dh.subSpecification = 0;
+  dh.payloadSize = 100;
+
+  auto transport = fair::mq::TransportFactory::CreateTransportFactory("zeromq");
+  size_t timeslice = state.thread_index();
+  std::vector<fair::mq::MessagePtr> inflightMessages(2);
+  DataRelayer::InputInfo fakeInfo{0, inflightMessages.size(), DataRelayer::InputType::Data, {ChannelIndex::INVALID}};
+
+  for (auto _ : state) {
+    auto& relayer = *context->relayer;
+    Stack stack{dh, DataProcessingHeader{timeslice, 1}};
+    for (int pi = 0; pi < nParts; ++pi) {
+      inflightMessages[0] = transport->CreateMessage(stack.size());
+      inflightMessages[1] = transport->CreateMessage(dh.payloadSize);
+      memcpy(inflightMessages[0]->GetData(), stack.data(), stack.size());
+      relayer.relay(inflightMessages[0]->GetData(), inflightMessages.data(), fakeInfo, inflightMessages.size());
+    }
+    for (size_t si = 0; si < relayer.getParallelTimeslices(); ++si) {
+      if (relayer.getTimesliceForSlot({si}).value == timeslice) {
+        auto result = relayer.consumeAllInputsForTimeslice({si});
+        assert(result.at(0).size() == (size_t)nParts);
+        break;
+      }
+    }
+    timeslice += state.threads();
+  }
+  state.SetItemsProcessed(state.iterations() * nParts);
+}
+
+BENCHMARK(BM_RelayConcurrentSlots)->Arg(16)->Arg(256)->ThreadRange(1, 8)->UseRealTime();
+
 BENCHMARK_MAIN();
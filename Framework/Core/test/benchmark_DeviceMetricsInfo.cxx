@@ -10,6 +10,7 @@
 // or submit itself to any jurisdiction.
 #include "Framework/DeviceMetricsInfo.h"
 #include "Framework/DeviceMetricsHelper.h"
+#include "Framework/DeviceMetricsRingBuffer.h"
 
 #include <benchmark/benchmark.h>
 #include <regex>
@@ -92,10 +93,38 @@ static void BM_ProcessIntMetric(benchmark::State& state)
     }
   }
   state.SetBytesProcessed(state.iterations() * metrics.size() * metric.size());
+  state.SetItemsProcessed(state.iterations() * metrics.size());
 }
 
 BENCHMARK(BM_ProcessIntMetric);
 
+// Same as above, but going through the binary shared memory ring
+static void BM_ProcessIntMetricRecord(benchmark::State& state)
+{
+  using namespace o2::framework;
+  DeviceMetricsInfo info;
+
+  constexpr size_t capacity = 1000;
+  std::vector<char> memory(DeviceMetricsRingBuffer::sizeForCapacity(capacity));
+  DeviceMetricsRingBuffer ring(memory.data(), capacity, true);
+  MetricRecord record;
+  record.setKey("bkey");
+  record.type = MetricType::Int;
+  record.intValue = 12;
+  record.timestamp = 1789372894;
+  for (auto _ : state) {
+    for (size_t i = 0; i < capacity; ++i) {
+      ring.push(record);
+    }
+    ring.consume([&info](MetricRecord const& r) {
+      DeviceMetricsHelper::processMetric(r, info);
+    });
+  }
+  state.SetItemsProcessed(state.iterations() * capacity);
+}
+
+BENCHMARK(BM_ProcessIntMetricRecord);
+
 static void BM_ParseFloatMetric(benchmark::State& state)
 {
   using namespace o2::framework;
@@ -58,6 +58,12 @@ void customize(std::vector<ConfigParamSpec>& workflowOptions)
   workflowOptions.push_back(
     ConfigParamSpec{
       "runningTime", VariantType::Int, 30, {"time to run the workflow"}});
+  workflowOptions.push_back(
+    ConfigParamSpec{
+      "nCheckers", VariantType::Int, 1, {"number of consumers of the proxied data, to benchmark the fan-out"}});
+  workflowOptions.push_back(
+    ConfigParamSpec{
+      "copy-headers", VariantType::Bool, false, {"copy the header messages in the input proxy rather than rewriting them in place"}});
 }
 
 #include "Framework/runDataProcessing.h"
@@ -90,6 +96,8 @@ std::vector<DataProcessorSpec> defineDataProcessing(ConfigContext const& config)
   using ProxyBypass = benchmark_config::ProxyBypass;
   auto bypassProxies = readConfig<ProxyBypass>(config, "bypass-proxies");
   int nChannels = config.options().get<int>("nChannels");
+  int nCheckers = config.options().get<int>("nCheckers");
+  bool copyHeaders = config.options().get<bool>("copy-headers");
   std::string defaultTransportConfig = config.options().get<std::string>("default-transport");
   if (defaultTransportConfig == "zeromq") {
     // nothing to do for the moment
@@ -421,49 +429,54 @@ std::vector<DataProcessorSpec> defineDataProcessing(ConfigContext const& config)
   // a simple checker process subscribing to the output of the input proxy
   //
   // the compute callback of the checker
-  auto cState = makeBenchmarkState();
-  auto checkerCallback = [cState, loggerCycle](InputRecord& inputs) {
-    ActiveGuard g(*cState);
-    LOG(debug) << "got inputs " << inputs.size();
-    size_t msgCount = 0;
-    size_t msgSize = 0;
-    for (auto const& ref : InputRecordWalker(inputs)) {
-      auto data = inputs.get<gsl::span<char>>(ref);
-      ++msgCount;
-      msgSize += data.size();
-    }
-    loggerCycle(*cState, msgCount, msgSize);
-  };
-  auto checkerBenchInit = [cState, loggerInit]() {
-    loggerInit(*cState);
-  };
-  auto checkerBenchSummary = [cState, loggerSummary](EndOfStreamContext&) {
-    loggerSummary(*cState);
-  };
-  auto checkerInit = [checkerCallback, checkerBenchInit, checkerBenchSummary](CallbackService& callbacks) {
-    callbacks.set<CallbackService::Id::Start>(checkerBenchInit);
-    callbacks.set<CallbackService::Id::EndOfStream>(checkerBenchSummary);
-    return adaptStateless(checkerCallback);
+  auto makeChecker = [&makeBenchmarkState, loggerInit, loggerCycle, loggerSummary]() {
+    auto cState = makeBenchmarkState();
+    auto checkerCallback = [cState, loggerCycle](InputRecord& inputs) {
+      ActiveGuard g(*cState);
+      LOG(debug) << "got inputs " << inputs.size();
+      size_t msgCount = 0;
+      size_t msgSize = 0;
+      for (auto const& ref : InputRecordWalker(inputs)) {
+        auto data = inputs.get<gsl::span<char>>(ref);
+        ++msgCount;
+        msgSize += data.size();
+      }
+      loggerCycle(*cState, msgCount, msgSize);
+    };
+    auto checkerBenchInit = [cState, loggerInit]() {
+      loggerInit(*cState);
+    };
+    auto checkerBenchSummary = [cState, loggerSummary](EndOfStreamContext&) {
+      loggerSummary(*cState);
+    };
+    return [checkerCallback, checkerBenchInit, checkerBenchSummary](CallbackService& callbacks) {
+      callbacks.set<CallbackService::Id::Start>(checkerBenchInit);
+      callbacks.set<CallbackService::Id::EndOfStream>(checkerBenchSummary);
+      return adaptStateless(checkerCallback);
+    };
   };
 
-  // the checker process connects to the proxy
-  Inputs checkerInputs;
-  if (bypassProxies != ProxyBypass::None) {
-    checkerInputs.emplace_back(InputSpec{"datain", ConcreteDataTypeMatcher{"TST", "DATA"}, Lifetime::Timeframe});
-  } else {
-    checkerInputs.emplace_back(InputSpec{"datain", ConcreteDataTypeMatcher{"PRX", "DATA"}, Lifetime::Timeframe});
+  // the checker processes connect to the proxy, with more than one the
+  // data is fanned out to all of them
+  for (int ci = 0; ci < nCheckers; ++ci) {
+    Inputs checkerInputs;
+    if (bypassProxies != ProxyBypass::None) {
+      checkerInputs.emplace_back(InputSpec{"datain", ConcreteDataTypeMatcher{"TST", "DATA"}, Lifetime::Timeframe});
+    } else {
+      checkerInputs.emplace_back(InputSpec{"datain", ConcreteDataTypeMatcher{"PRX", "DATA"}, Lifetime::Timeframe});
+    }
+    workflow.emplace_back(DataProcessorSpec{ci == 0 ? std::string("checker") : fmt::format("checker-{}", ci),
+                                            std::move(checkerInputs),
+                                            {},
+                                            AlgorithmSpec{adaptStateful(makeChecker())}});
   }
-  workflow.emplace_back(DataProcessorSpec{"checker",
-                                          std::move(checkerInputs),
-                                          {},
-                                          AlgorithmSpec{adaptStateful(checkerInit)}});
 
   //////////////////////////////////////////////////////////////////////////////////////////////////////////////
   // the input proxy process
   // reads the messages from the output proxy via the out-of-band channel
 
   // converter callback for the external FairMQ device proxy ProcessorSpec generator
-  InjectorFunction converter = [](TimingInfo&, ServiceRegistryRef const& ref, fair::mq::Parts& inputs, ChannelRetriever channelRetriever, size_t newTimesliceId, bool&) -> bool {
+  InjectorFunction converter = [copyHeaders](TimingInfo&, ServiceRegistryRef const& ref, fair::mq::Parts& inputs, ChannelRetriever channelRetriever, size_t newTimesliceId, bool&) -> bool {
     auto* device = ref.get<RawDeviceService>().device();
     ASSERT_ERROR(inputs.Size() >= 2);
     if (inputs.Size() < 2) {
@@ -493,9 +506,14 @@ std::vector<DataProcessorSpec> defineDataProcessing(ConfigContext const& config)
     if (channelName.empty()) {
       return false;
     }
-    // make a copy of the header message, get the data header and change origin
-    auto outHeaderMessage = device->NewMessageFor(channelName, 0, inputs.At(msgidx)->GetSize());
-    memcpy(outHeaderMessage->GetData(), inputs.At(msgidx)->GetData(), inputs.At(msgidx)->GetSize());
+    // either rewrite the origin in the original header message, or in a copy of it
+    fair::mq::MessagePtr outHeaderMessage;
+    if (copyHeaders) {
+      outHeaderMessage = device->NewMessageFor(channelName, 0, inputs.At(msgidx)->GetSize());
+      memcpy(outHeaderMessage->GetData(), inputs.At(msgidx)->GetData(), inputs.At(msgidx)->GetSize());
+    } else {
+      outHeaderMessage = std::move(inputs.At(msgidx));
+    }
     // this we obviously need to fix in the get API, const'ness of the returned header pointer
     // should depend on const'ness of the buffer
     auto odh = const_cast<o2::header::DataHeader*>(o2::header::get<o2::header::DataHeader*>(outHeaderMessage->GetData()));
@@ -67,7 +67,65 @@ static void BM_GandivaExpression(benchmark::State& state)
   benchmark::DoNotOptimize(tt);
 }
 
+// Filter creation for an expression which was not compiled before in this process: it pays the LLVM compilation
+static void BM_GandivaFilterCold(benchmark::State& state)
+{
+  auto tt = createTable(state.range(0));
+  auto schema = tt.asArrowTable()->schema();
+  float cut = 0.f;
+  for (auto _ : state) {
+    cut += 1e-3f; // a new literal makes a new expression, missing the gandiva cache
+    expressions::Filter f = (test::x > cut) && (test::y < 1.f);
+    auto filter = expressions::createFilter(schema, expressions::createOperations(std::move(f)));
+    benchmark::DoNotOptimize(filter);
+  }
+}
+
+// Filter creation for an identical expression, as for the same filter declared in several tasks of a workflow:
+// served by the gandiva in-process cache
+static void BM_GandivaFilterWarm(benchmark::State& state)
+{
+  auto tt = createTable(state.range(0));
+  auto schema = tt.asArrowTable()->schema();
+  for (auto _ : state) {
+    expressions::Filter f = (test::x > 0.5f) && (test::y < 1.f);
+    auto filter = expressions::createFilter(schema, expressions::createOperations(std::move(f)));
+    benchmark::DoNotOptimize(filter);
+  }
+}
+
+// Selection with a simple range filter, evaluated by the gandiva filter
+static void BM_GandivaRangeSelection(benchmark::State& state)
+{
+  auto tt = createTable(state.range(0));
+  auto table = tt.asArrowTable();
+  expressions::Filter f = (test::x > -1.f) && (test::x < 1.f) && (test::y > 0.f);
+  auto filter = expressions::createFilter(table->schema(), expressions::createOperations(f));
+  for (auto _ : state) {
+    auto selection = expressions::createSelection(table, filter);
+    benchmark::DoNotOptimize(selection);
+  }
+}
+
+// Selection with the same range filter, evaluated natively from the column cuts
+static void BM_NativeRangeSelection(benchmark::State& state)
+{
+  auto tt = createTable(state.range(0));
+  auto table = tt.asArrowTable();
+  expressions::Filter f = (test::x > -1.f) && (test::x < 1.f) && (test::y > 0.f);
+  std::vector<expressions::ColumnCut> cuts;
+  expressions::extractColumnCuts(expressions::createOperations(f), cuts);
+  for (auto _ : state) {
+    auto selection = expressions::createSelection(table, cuts);
+    benchmark::DoNotOptimize(selection);
+  }
+}
+
 BENCHMARK(BM_DirectCalculation)->Arg(maxrows);
 BENCHMARK(BM_GandivaExpression)->Arg(maxrows);
+BENCHMARK(BM_GandivaFilterCold)->Arg(maxrows);
+BENCHMARK(BM_GandivaFilterWarm)->Arg(maxrows);
+BENCHMARK(BM_GandivaRangeSelection)->Arg(maxrows)->Arg(10000)->Arg(1000000);
+BENCHMARK(BM_NativeRangeSelection)->Arg(maxrows)->Arg(10000)->Arg(1000000);
 
 BENCHMARK_MAIN();
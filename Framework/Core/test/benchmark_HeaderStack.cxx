@@ -0,0 +1,79 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include <benchmark/benchmark.h>
+
+#include "Headers/DataHeader.h"
+#include "Headers/NameHeader.h"
+#include "Headers/Stack.h"
+#include "Framework/DataProcessingHeader.h"
+#include "Framework/DataRef.h"
+#include "Framework/DataRefUtils.h"
+
+using namespace o2::framework;
+using DataHeader = o2::header::DataHeader;
+using Stack = o2::header::Stack;
+
+namespace
+{
+Stack createStack()
+{
+  DataHeader dh;
+  dh.dataDescription = "CLUSTERS";
+  dh.dataOrigin = "TPC";
+  dh.subSpecification = 0;
+  dh.payloadSize = 100;
+  DataProcessingHeader dph{0, 1};
+  return Stack{dh, dph};
+}
+} // namespace
+
+// the header stack is built for every message sent, e.g. by the proxies
+static void BM_HeaderStackCreation(benchmark::State& state)
+{
+  for (auto _ : state) {
+    auto stack = createStack();
+    benchmark::DoNotOptimize(stack.data());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_HeaderStackCreation);
+
+// what the relayer and the input record do for every message
+static void BM_HeaderStackLookup(benchmark::State& state)
+{
+  auto stack = createStack();
+  DataRef ref{nullptr, reinterpret_cast<const char*>(stack.data()), nullptr};
+  for (auto _ : state) {
+    auto dh = DataRefUtils::getHeader<DataHeader*>(ref);
+    auto dph = DataRefUtils::getHeader<DataProcessingHeader*>(ref);
+    benchmark::DoNotOptimize(dh);
+    benchmark::DoNotOptimize(dph);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_HeaderStackLookup);
+
+// worst case: a header type which is not in the stack, the full stack is traversed
+static void BM_HeaderStackLookupMissing(benchmark::State& state)
+{
+  auto stack = createStack();
+  for (auto _ : state) {
+    auto nh = o2::header::get<o2::header::NameHeader<0>*>(stack.data());
+    benchmark::DoNotOptimize(nh);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_HeaderStackLookupMissing);
+
+BENCHMARK_MAIN();
@@ -62,7 +62,42 @@ static void BM_StandardNameLookup(benchmark::State& state)
     }
   }
 }
+
+/// Fill a histogram value by value, looking it up for each fill
+static void BM_FillPerValue(benchmark::State& state)
+{
+  HistogramRegistry registry{"registry", {{"histo", "Histo", {HistType::kTH2F, {{100, 0, 1}, {100, 0, 1}}}}}};
+  std::vector<float> xs(state.range(0)), ys(state.range(0));
+  for (auto i = 0; i < state.range(0); ++i) {
+    xs[i] = (float)i / state.range(0);
+    ys[i] = 1.f - xs[i];
+  }
+  for (auto _ : state) {
+    for (auto i = 0; i < state.range(0); ++i) {
+      registry.fill(HIST("histo"), xs[i], ys[i]);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// Fill a histogram with spans of values, looking it up once
+static void BM_FillSpans(benchmark::State& state)
+{
+  HistogramRegistry registry{"registry", {{"histo", "Histo", {HistType::kTH2F, {{100, 0, 1}, {100, 0, 1}}}}}};
+  std::vector<float> xs(state.range(0)), ys(state.range(0));
+  for (auto i = 0; i < state.range(0); ++i) {
+    xs[i] = (float)i / state.range(0);
+    ys[i] = 1.f - xs[i];
+  }
+  for (auto _ : state) {
+    registry.fill(HIST("histo"), gsl::span<float const>{xs}, gsl::span<float const>{ys});
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
 BENCHMARK(BM_HashedNameLookup)->Arg(4)->Arg(8)->Arg(16)->Arg(64)->Arg(128)->Arg(256)->Arg(512);
 BENCHMARK(BM_StandardNameLookup)->Arg(4)->Arg(8)->Arg(16)->Arg(64)->Arg(128)->Arg(256)->Arg(512);
+BENCHMARK(BM_FillPerValue)->Arg(1024)->Arg(16384)->Arg(262144);
+BENCHMARK(BM_FillSpans)->Arg(1024)->Arg(16384)->Arg(262144);
 
 BENCHMARK_MAIN();
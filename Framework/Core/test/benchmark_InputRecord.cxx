@@ -20,6 +20,7 @@
 #include <Monitoring/Monitoring.h>
 #include <fairmq/TransportFactory.h>
 #include <cstring>
+#include <string>
 
 using Monitoring = o2::monitoring::Monitoring;
 using namespace o2::framework;
@@ -103,4 +104,33 @@ static void BM_InputRecordGenericGetters(benchmark::State& state)
 
 BENCHMARK(BM_InputRecordGenericGetters);
 
+// Look up the position of all the inputs by binding, for a device with
+// state.range(0) inputs, with (state.range(1) == 1) or without the index.
+static void BM_InputRecordGetPosManyInputs(benchmark::State& state)
+{
+  std::vector<InputSpec> specs;
+  std::vector<std::string> bindings;
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    bindings.push_back("input-" + std::to_string(i));
+    specs.emplace_back(InputSpec{bindings.back(), "TST", "A", static_cast<o2::header::DataHeader::SubSpecificationType>(i), Lifetime::Timeframe});
+  }
+  std::vector<InputRoute> schema;
+  for (size_t i = 0; i < specs.size(); ++i) {
+    schema.push_back(InputRoute{specs[i], i, "source"});
+  }
+  InputRouteIndex index{schema};
+  InputSpan span{[](size_t) { return DataRef{nullptr, nullptr, nullptr}; }, schema.size()};
+  ServiceRegistry registry;
+  InputRecord record{schema, span, registry, state.range(1) ? &index : nullptr};
+
+  for (auto _ : state) {
+    for (auto& binding : bindings) {
+      benchmark::DoNotOptimize(record.getPos(binding.c_str()));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * bindings.size());
+}
+
+BENCHMARK(BM_InputRecordGetPosManyInputs)->ArgsProduct({{4, 16, 64, 256}, {0, 1}});
+
 BENCHMARK_MAIN();
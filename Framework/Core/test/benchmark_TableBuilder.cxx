@@ -95,6 +95,25 @@ static void BM_TableBuilderScalarBulk(benchmark::State& state)
 
 BENCHMARK(BM_TableBuilderScalarBulk)->Range(256, 1 << 20);
 
+static void BM_TableBuilderColumnsBulk(benchmark::State& state)
+{
+  using namespace o2::framework;
+  auto chunkSize = state.range(0) / 256;
+  std::vector<float> x(chunkSize, 0.);
+  std::vector<float> y(chunkSize, 0.);
+  std::vector<float> z(chunkSize, 0.);
+  for (auto _ : state) {
+    TableBuilder builder;
+    auto bulkWriter = builder.bulkPersistColumns<float, float, float>({"x", "y", "z"}, state.range(0));
+    for (size_t i = 0; i < state.range(0) / chunkSize; ++i) {
+      bulkWriter(chunkSize, x.data(), y.data(), z.data());
+    }
+    auto table = builder.finalize();
+  }
+}
+
+BENCHMARK(BM_TableBuilderColumnsBulk)->Range(256, 1 << 20);
+
 static void BM_TableBuilderSimple(benchmark::State& state)
 {
   using namespace o2::framework;
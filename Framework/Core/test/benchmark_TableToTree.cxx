@@ -16,6 +16,7 @@
 #include <vector>
 
 #include <TFile.h>
+#include <TROOT.h>
 
 using namespace o2::framework;
 using namespace arrow;
@@ -37,6 +38,10 @@ constexpr unsigned int maxrange = 16;
 
 static void BM_TableToTree(benchmark::State& state)
 {
+  // second argument: number of threads for implicit multi-threading, 0 to fill sequentially
+  if (state.range(1) > 0) {
+    ROOT::EnableImplicitMT(state.range(1));
+  }
 
   // initialize a random generator
   std::default_random_engine e1(1234567891);
@@ -70,8 +75,11 @@ static void BM_TableToTree(benchmark::State& state)
   }
 
   state.SetBytesProcessed(state.iterations() * state.range(0) * 24);
+  if (state.range(1) > 0) {
+    ROOT::DisableImplicitMT();
+  }
 }
 
-BENCHMARK(BM_TableToTree)->Range(8, 8 << maxrange);
+BENCHMARK(BM_TableToTree)->Ranges({{8, 8 << maxrange}, {0, 4}});
 
 BENCHMARK_MAIN();
@@ -17,6 +17,10 @@
 #include <vector>
 
 #include <TFile.h>
+#include <arrow/io/file.h>
+#include <arrow/ipc/reader.h>
+#include <arrow/ipc/writer.h>
+#include <arrow/util/compression.h>
 
 using namespace o2::framework;
 using namespace arrow;
@@ -93,4 +97,53 @@ static void BM_TreeToTable(benchmark::State& state)
 
 BENCHMARK(BM_TreeToTable)->Range(8, 8 << maxrange);
 
+// baseline for BM_TreeToTable: the same table read from a memory mapped Arrow IPC file,
+// with the buffers uncompressed (0), LZ4 (1) or ZSTD (2) compressed
+static void BM_ArrowIPCToTable(benchmark::State& state)
+{
+  std::default_random_engine e1(1234567891);
+  std::uniform_real_distribution<double> rd(0, 1);
+  std::normal_distribution<float> rf(5., 2.);
+  std::discrete_distribution<ULong64_t> rl({10, 20, 30, 30, 5, 5});
+  std::discrete_distribution<int> ri({10, 20, 30, 30, 5, 5});
+
+  TableBuilder builder;
+  auto rowWriter =
+    builder.persist<double, float, ULong64_t, int>({"a", "b", "c", "d"});
+  for (auto i = 0; i < state.range(0); ++i) {
+    rowWriter(0, rd(e1), rf(e1), rl(e1), ri(e1));
+  }
+  auto table = builder.finalize();
+
+  auto options = arrow::ipc::IpcWriteOptions::Defaults();
+  if (state.range(1) > 0) {
+    auto codec = arrow::util::Codec::Create(state.range(1) == 1 ? arrow::Compression::LZ4_FRAME : arrow::Compression::ZSTD);
+    if (!codec.ok()) {
+      state.SkipWithError("compression codec not available");
+      return;
+    }
+    options.codec = std::move(codec).ValueOrDie();
+  }
+  auto stream = arrow::io::FileOutputStream::Open("table2ipc.arrow").ValueOrDie();
+  auto writer = arrow::ipc::MakeFileWriter(stream, table->schema(), options).ValueOrDie();
+  (void)writer->WriteTable(*table);
+  (void)writer->Close();
+  (void)stream->Close();
+
+  for (auto _ : state) {
+    auto file = arrow::io::MemoryMappedFile::Open("table2ipc.arrow", arrow::io::FileMode::READ).ValueOrDie();
+    auto reader = arrow::ipc::RecordBatchFileReader::Open(file).ValueOrDie();
+    std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+    for (int i = 0; i < reader->num_record_batches(); i++) {
+      batches.emplace_back(reader->ReadRecordBatch(i).ValueOrDie());
+    }
+    auto ta = arrow::Table::FromRecordBatches(reader->schema(), batches).ValueOrDie();
+    benchmark::DoNotOptimize(ta);
+  }
+
+  state.SetBytesProcessed(state.iterations() * state.range(0) * 24);
+}
+
+BENCHMARK(BM_ArrowIPCToTable)->ArgsProduct({benchmark::CreateRange(8, 8 << maxrange, 8), {0, 1, 2}});
+
 BENCHMARK_MAIN();
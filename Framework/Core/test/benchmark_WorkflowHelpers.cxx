@@ -14,9 +14,16 @@
 #include "Framework/DataSpecUtils.h"
 #include "Framework/OutputSpec.h"
 #include "Framework/SimpleOptionsRetriever.h"
+#include "Framework/ChannelConfigurationPolicy.h"
+#include "Framework/CompletionPolicy.h"
+#include "Framework/CallbacksPolicy.h"
 #include "../src/WorkflowHelpers.h"
+#include "../src/DeviceSpecHelpers.h"
+#include "../src/SimpleResourceManager.h"
+#include "../src/ComputingResourceHelpers.h"
 #include <benchmark/benchmark.h>
 #include <algorithm>
+#include <string>
 
 using namespace o2::framework;
 
@@ -107,4 +114,80 @@ static void BM_CreateGraphReverseOverhead(benchmark::State& state)
 }
 
 BENCHMARK(BM_CreateGraphReverseOverhead)->Range(1, 1 << 10);
+
+o2::header::DataDescription makeDescription(std::string const& name)
+{
+  o2::header::DataDescription description;
+  description.runtimeInit(name.c_str());
+  return description;
+}
+
+// A reconstruction-like topology: a reader followed by nProcessors
+// processors, each consuming the output of the previous one and of the
+// reader, with a final sink which consumes everything.
+WorkflowSpec createLargeTopology(size_t nProcessors)
+{
+  WorkflowSpec workflow;
+  std::vector<OutputSpec> readerOutputs;
+  for (size_t i = 0; i < nProcessors; ++i) {
+    readerOutputs.emplace_back(OutputSpec{{"raw"}, "TST", makeDescription("RAW" + std::to_string(i)), 0});
+  }
+  workflow.push_back(DataProcessorSpec{.name = "reader", .outputs = readerOutputs});
+  std::vector<InputSpec> sinkInputs;
+  for (size_t i = 0; i < nProcessors; ++i) {
+    std::vector<InputSpec> inputs{InputSpec{"raw", "TST", makeDescription("RAW" + std::to_string(i)), 0}};
+    if (i != 0) {
+      inputs.emplace_back(InputSpec{"previous", "TST", makeDescription("RECO" + std::to_string(i - 1)), 0});
+    }
+    workflow.push_back(DataProcessorSpec{.name = "reco-" + std::to_string(i),
+                                         .inputs = inputs,
+                                         .outputs = {OutputSpec{{"reco"}, "TST", makeDescription("RECO" + std::to_string(i)), 0}}});
+    sinkInputs.emplace_back(InputSpec{"reco" + std::to_string(i), "TST", makeDescription("RECO" + std::to_string(i)), 0});
+  }
+  workflow.push_back(DataProcessorSpec{.name = "sink", .inputs = sinkInputs});
+  return workflow;
+}
+
+static void BM_CreateGraphLargeTopology(benchmark::State& state)
+{
+  auto workflow = createLargeTopology(state.range());
+  auto context = makeEmptyConfigContext();
+  WorkflowHelpers::injectServiceDevices(workflow, *context);
+
+  for (auto _ : state) {
+    std::vector<DeviceConnectionEdge> logicalEdges;
+    std::vector<OutputSpec> outputs;
+    std::vector<LogicalForwardInfo> availableForwardsInfo;
+    WorkflowHelpers::constructGraph(workflow, logicalEdges,
+                                    outputs,
+                                    availableForwardsInfo);
+  }
+}
+
+BENCHMARK(BM_CreateGraphLargeTopology)->Range(8, 512);
+
+static void BM_DeviceSpecsLargeTopology(benchmark::State& state)
+{
+  auto workflow = createLargeTopology(state.range());
+  auto context = makeEmptyConfigContext();
+  WorkflowHelpers::injectServiceDevices(workflow, *context);
+  auto channelPolicies = ChannelConfigurationPolicy::createDefaultPolicies(*context);
+  auto completionPolicies = CompletionPolicy::createDefaultPolicies();
+  auto callbacksPolicies = CallbacksPolicy::createDefaultPolicies();
+  std::vector<ComputingResource> resources = {ComputingResourceHelpers::getLocalhostResource()};
+
+  for (auto _ : state) {
+    std::vector<DeviceSpec> devices;
+    SimpleResourceManager rm(resources);
+    DeviceSpecHelpers::dataProcessorSpecs2DeviceSpecs(workflow,
+                                                      channelPolicies,
+                                                      completionPolicies,
+                                                      callbacksPolicies,
+                                                      devices,
+                                                      rm, "workflow-id", *context);
+  }
+}
+
+BENCHMARK(BM_DeviceSpecsLargeTopology)->Range(8, 512);
+
 BENCHMARK_MAIN();
@@ -635,6 +635,58 @@ TEST_CASE("TestFilteredOperators")
   REQUIRE(i == 3);
 }
 
+TEST_CASE("TestFilteredChunkedTable")
+{
+  std::vector<std::shared_ptr<arrow::Table>> chunks;
+  for (auto c = 0; c < 2; ++c) {
+    TableBuilder builder;
+    auto rowWriter = builder.persist<int32_t, int32_t>({"fX", "fY"});
+    for (auto i = 0; i < 4; ++i) {
+      rowWriter(0, c * 4 + i, 8 + c * 4 + i);
+    }
+    chunks.push_back(builder.finalize());
+  }
+  auto table = arrow::ConcatenateTables(chunks).ValueOrDie();
+  REQUIRE(table->num_rows() == 8);
+  REQUIRE(table->column(0)->num_chunks() == 2);
+
+  // the rows selected in each chunk are collected with the chunk offset
+  expressions::Filter f = (o2::aod::test::x > 1) && (o2::aod::test::x < 6);
+  auto s = expressions::createSelection(table, f);
+  REQUIRE(s->GetNumSlots() == 4);
+  for (auto i = 0; i < s->GetNumSlots(); ++i) {
+    REQUIRE(s->GetIndex(i) == (uint64_t)(i + 2));
+  }
+}
+
+TEST_CASE("TestColumnBatches")
+{
+  std::vector<std::shared_ptr<arrow::Table>> chunks;
+  for (auto c = 0; c < 3; ++c) {
+    TableBuilder builder;
+    auto rowWriter = builder.persist<int32_t, int32_t>({"fX", "fY"});
+    for (auto i = 0; i < c + 2; ++i) {
+      rowWriter(0, i, 2 * i);
+    }
+    chunks.push_back(builder.finalize());
+  }
+  using TestA = o2::soa::Table<o2::soa::Index<>, o2::aod::test::X, o2::aod::test::Y>;
+  TestA tests{arrow::ConcatenateTables(chunks).ValueOrDie()};
+
+  auto batches = tests.batches<o2::aod::test::X, o2::aod::test::Y>();
+  REQUIRE(batches.size() == 3);
+  size_t rows = 0;
+  for (auto [xs, ys] : batches) {
+    REQUIRE(xs.size() == ys.size());
+    for (auto i = 0U; i < xs.size(); ++i) {
+      REQUIRE(xs[i] == (int)i);
+      REQUIRE(ys[i] == 2 * (int)i);
+    }
+    rows += xs.size();
+  }
+  REQUIRE(rows == (size_t)tests.size());
+}
+
 TEST_CASE("TestNestedFiltering")
 {
   TableBuilder builderA;
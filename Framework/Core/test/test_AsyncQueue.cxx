@@ -11,6 +11,7 @@
 
 #include <catch_amalgamated.hpp>
 #include "Framework/AsyncQueue.h"
+#include <chrono>
 
 /// Test debouncing functionality. The same task cannot be executed more than once
 /// in a given run.
@@ -143,3 +144,47 @@ TEST_CASE("TestOldestTimeslicePerTimeslice")
   REQUIRE(queue.tasks.size() == 0);
   REQUIRE(count == 30);
 }
+
+// Tasks which can run anywhere are executed by the workers, the others by the caller of run.
+TEST_CASE("TestWorkerAffinity")
+{
+  using namespace o2::framework;
+  AsyncQueue queue;
+  auto streamTask = AsyncQueueHelpers::create(queue, {.name = "stream", .score = 10});
+  auto anyTask = AsyncQueueHelpers::create(queue, {.name = "any", .score = 10, .affinity = AsyncTaskAffinity::Any});
+  std::thread::id streamThread;
+  std::thread::id anyThread;
+  AsyncQueueHelpers::post(
+    queue, streamTask, [&streamThread](size_t) { streamThread = std::this_thread::get_id(); }, TimesliceId{0});
+  AsyncQueueHelpers::post(
+    queue, anyTask, [&anyThread](size_t) { anyThread = std::this_thread::get_id(); }, TimesliceId{0});
+  AsyncQueueHelpers::run(queue, TimesliceId{0});
+  REQUIRE(queue.tasks.size() == 0);
+  REQUIRE(streamThread == std::this_thread::get_id());
+  // reset waits for the workers
+  AsyncQueueHelpers::reset(queue);
+  REQUIRE(anyThread != std::thread::id{});
+  REQUIRE(anyThread != std::this_thread::get_id());
+}
+
+// Tasks with the same id are executed in order, even when handed over to the workers.
+TEST_CASE("TestWorkerOrdering")
+{
+  using namespace o2::framework;
+  AsyncQueue queue;
+  queue.maxWorkers = 4;
+  auto taskId = AsyncQueueHelpers::create(queue, {.name = "ordered", .score = 10, .affinity = AsyncTaskAffinity::Any});
+  std::mutex mutex;
+  std::vector<int> executed;
+  for (int i = 0; i < 10; ++i) {
+    AsyncQueueHelpers::post(
+      queue, taskId, [i, &mutex, &executed](size_t) {
+        // Make the early ones slower, so that they would be overtaken if run concurrently
+        std::this_thread::sleep_for(std::chrono::milliseconds(10 - i));
+        std::scoped_lock<std::mutex> lock(mutex);
+        executed.push_back(i); }, TimesliceId{(size_t)i});
+    AsyncQueueHelpers::run(queue, TimesliceId{(size_t)i});
+  }
+  AsyncQueueHelpers::reset(queue);
+  REQUIRE(executed == std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+}
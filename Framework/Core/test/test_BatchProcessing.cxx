@@ -0,0 +1,58 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "Framework/ConfigParamSpec.h"
+#include "Framework/BatchProcessingContext.h"
+#include "Framework/ControlService.h"
+#include "Framework/Logger.h"
+
+#include <memory>
+#include <set>
+
+#include "Framework/runDataProcessing.h"
+using namespace o2::framework;
+
+// A consumer which gets all the timeslices ready at wakeup in one go.
+// Every value sent by the producer must be seen exactly once.
+WorkflowSpec defineDataProcessing(ConfigContext const& specs)
+{
+  return WorkflowSpec{
+    {"A",
+     Inputs{},
+     {OutputSpec{{"a"}, "TST", "A"}},
+     AlgorithmSpec{adaptStateful([]() { return adaptStateless(
+                                          [](DataAllocator& outputs, ControlService& control) {
+                                            static int count = 0;
+                                            outputs.make<int>(OutputRef{"a"}) = count++;
+                                            if (count == 1000) {
+                                              control.endOfStream();
+                                              control.readyToQuit(QuitRequest::Me);
+                                            }
+                                          }); })}},
+    {"B",
+     {InputSpec{"x", "TST", "A", Lifetime::Timeframe}},
+     {},
+     AlgorithmSpec::batch([](InitContext&) {
+       auto seen = std::make_shared<std::set<int>>();
+       return [seen](BatchProcessingContext& batch) {
+         for (auto& inputs : batch.inputs()) {
+           auto value = inputs.get<int>("x");
+           if (seen->insert(value).second == false) {
+             LOGP(error, "Value {} received twice.", value);
+             batch.services().get<ControlService>().readyToQuit(QuitRequest::All);
+           }
+         }
+         LOGP(info, "Processed a batch of {} timeslices, {} values seen so far.", batch.size(), seen->size());
+         if (seen->size() == 1000) {
+           batch.services().get<ControlService>().readyToQuit(QuitRequest::All);
+         }
+       };
+     })}};
+}
@@ -401,3 +401,76 @@ TEST_CASE("DataProcessingStatsPublishingRepeated")
   REQUIRE(updated.size() == 2);
   REQUIRE(count == 10);
 }
+
+TEST_CASE("DataProcessingStatsLatencyHistogram")
+{
+  // Values below the linear threshold are exact.
+  for (uint64_t v = 0; v < LatencyHistogram::LINEAR_BUCKETS; ++v) {
+    REQUIRE(LatencyHistogram::bucketIndex(v) == v);
+    REQUIRE(LatencyHistogram::bucketUpperBound(v) == v);
+  }
+  // The buckets are contiguous and their width is at most 1/8 of the value.
+  bool consistent = true;
+  for (uint64_t v = LatencyHistogram::LINEAR_BUCKETS; v < (1 << 20); ++v) {
+    auto index = LatencyHistogram::bucketIndex(v);
+    auto upper = LatencyHistogram::bucketUpperBound(index);
+    consistent &= upper >= v && LatencyHistogram::bucketUpperBound(index - 1) < v && upper - v <= v / 8;
+  }
+  REQUIRE(consistent);
+  REQUIRE(LatencyHistogram::bucketIndex(-1ULL) == LatencyHistogram::N_BUCKETS - 1);
+
+  LatencyHistogram histogram;
+  REQUIRE(histogram.summarize(false).count == 0);
+  for (uint64_t i = 1; i <= 1000; ++i) {
+    histogram.record(i);
+  }
+  auto summary = histogram.summarize(false);
+  REQUIRE(summary.count == 1000);
+  REQUIRE(summary.p50 >= 500);
+  REQUIRE(summary.p50 <= 500 + 500 / 8);
+  REQUIRE(summary.p99 >= 990);
+  REQUIRE(summary.p99 <= 990 + 990 / 8);
+  REQUIRE(summary.p999 >= 999);
+  REQUIRE(summary.max >= 1000);
+  REQUIRE(summary.max <= 1000 + 1000 / 8);
+  // Resetting starts a new interval.
+  REQUIRE(histogram.summarize(true).count == 1000);
+  REQUIRE(histogram.summarize(true).count == 0);
+}
+
+TEST_CASE("DataProcessingStatsPublishLatencies")
+{
+  static int64_t now = 0;
+  auto realtimeTime = [](int64_t& base, int64_t& offset) {
+    base = 0;
+    offset = 0;
+  };
+  auto cpuTime = [](int64_t base, int64_t offset) -> int64_t {
+    return base + now - offset;
+  };
+  DataProcessingStats stats(realtimeTime, cpuTime);
+  auto callbackId = (int)ProcessingStatsId::LATENCY_PERCENTILES_BASE + (int)DataProcessingStats::LatencyStage::Callback * DataProcessingStats::LATENCY_METRICS_PER_STAGE;
+  for (int i = 0; i < DataProcessingStats::LATENCY_METRICS_PER_STAGE; ++i) {
+    stats.registerMetric({.name = "callback_" + std::to_string(i), .metricId = (short)(callbackId + i)});
+  }
+  for (int i = 0; i < 100; ++i) {
+    stats.recordLatency(DataProcessingStats::LatencyStage::Callback, 10);
+  }
+  stats.recordLatency(DataProcessingStats::LatencyStage::Callback, 1000);
+
+  // Nothing is published before the interval has passed.
+  now = 500;
+  stats.publishLatencies();
+  stats.processCommandQueue();
+  REQUIRE(stats.metrics[callbackId + 3] == 0);
+
+  now = 1000;
+  stats.publishLatencies();
+  stats.processCommandQueue();
+  REQUIRE(stats.metrics[callbackId + 0] == 10);
+  REQUIRE(stats.metrics[callbackId + 1] == 10);
+  REQUIRE(stats.metrics[callbackId + 2] >= 1000);
+  REQUIRE(stats.metrics[callbackId + 3] >= 1000);
+  // The histogram was reset
+  REQUIRE(stats.latencies[(int)DataProcessingStats::LatencyStage::Callback].summarize(false).count == 0);
+}
@@ -25,6 +25,8 @@
 #include <Monitoring/Monitoring.h>
 #include <fairmq/TransportFactory.h>
 #include <array>
+#include <set>
+#include <thread>
 #include <vector>
 #include <uv.h>
 
@@ -804,4 +806,77 @@ TEST_CASE("DataRelayer")
       }
     }
   }
+
+  // Several threads relaying the inputs of distinct timeslices at the
+  // same time must end up with each timeslice complete in its own slot.
+  SECTION("TestConcurrentRelay")
+  {
+    InputSpec spec1{"clusters", "TPC", "CLUSTERS"};
+    InputSpec spec2{"clusters_its", "ITS", "CLUSTERS"};
+
+    std::vector<InputRoute> inputs = {
+      InputRoute{spec1, 0, "Fake1", 0},
+      InputRoute{spec2, 1, "Fake2", 0}};
+
+    std::vector<InputChannelInfo> infos{1};
+    TimesliceIndex index{1, infos};
+    ref.registerService(ServiceRegistryHelpers::handleForService<TimesliceIndex>(&index));
+
+    constexpr size_t nThreads = 4;
+    constexpr size_t nTimeslicesPerThread = 2;
+    auto policy = CompletionPolicyHelpers::consumeWhenAll();
+    DataRelayer relayer(policy, inputs, index, {registry});
+    relayer.setPipelineLength(nThreads * nTimeslicesPerThread);
+
+    auto transport = fair::mq::TransportFactory::CreateTransportFactory("zeromq");
+    auto channelAlloc = o2::pmr::getTransportAllocator(transport.get());
+
+    DataHeader dh1;
+    dh1.dataDescription = "CLUSTERS";
+    dh1.dataOrigin = "TPC";
+    dh1.subSpecification = 0;
+    DataHeader dh2;
+    dh2.dataDescription = "CLUSTERS";
+    dh2.dataOrigin = "ITS";
+    dh2.subSpecification = 0;
+
+    std::array<std::vector<DataRelayer::RelayChoice::Type>, nThreads> choices;
+    std::vector<std::thread> threads;
+    for (size_t ti = 0; ti < nThreads; ++ti) {
+      threads.emplace_back([&, ti]() {
+        for (size_t time = ti; time < nThreads * nTimeslicesPerThread; time += nThreads) {
+          for (auto* dh : {&dh1, &dh2}) {
+            std::array<fair::mq::MessagePtr, 2> messages;
+            messages[0] = o2::pmr::getMessage(Stack{channelAlloc, *dh, DataProcessingHeader{time, 1}});
+            messages[1] = transport->CreateMessage(1000);
+            DataRelayer::InputInfo fakeInfo{0, messages.size(), DataRelayer::InputType::Data, {ChannelIndex::INVALID}};
+            choices[ti].push_back(relayer.relay(messages[0]->GetData(), messages.data(), fakeInfo, messages.size()).type);
+          }
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    for (auto& threadChoices : choices) {
+      REQUIRE(threadChoices.size() == 2 * nTimeslicesPerThread);
+      for (auto choice : threadChoices) {
+        REQUIRE(choice == DataRelayer::RelayChoice::Type::WillRelay);
+      }
+    }
+
+    std::vector<RecordAction> ready;
+    relayer.getReadyToProcess(ready);
+    REQUIRE(ready.size() == nThreads * nTimeslicesPerThread);
+    std::set<size_t> timeslices;
+    for (auto& action : ready) {
+      REQUIRE(action.op == CompletionPolicy::CompletionOp::Consume);
+      timeslices.insert(relayer.getTimesliceForSlot(action.slot).value);
+      auto result = relayer.consumeAllInputsForTimeslice(action.slot);
+      REQUIRE(result.size() == 2);
+      REQUIRE(result.at(0).size() == 1);
+      REQUIRE(result.at(1).size() == 1);
+    }
+    REQUIRE(timeslices.size() == nThreads * nTimeslicesPerThread);
+  }
 }
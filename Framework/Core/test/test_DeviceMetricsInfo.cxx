@@ -11,6 +11,7 @@
 
 #include "Framework/DeviceMetricsInfo.h"
 #include "Framework/DeviceMetricsHelper.h"
+#include "Framework/DeviceMetricsRingBuffer.h"
 #include <catch_amalgamated.hpp>
 #include <catch_amalgamated.hpp>
 #include <regex>
@@ -515,3 +516,62 @@ TEST_CASE("TestHelpers")
   REQUIRE(metric2 == 0);
   REQUIRE(metric3 == 1);
 }
+
+TEST_CASE("TestMetricsRingBuffer")
+{
+  using namespace o2::framework;
+  constexpr size_t capacity = 4;
+  std::vector<char> memory(DeviceMetricsRingBuffer::sizeForCapacity(capacity) + 64);
+  void* aligned = memory.data() + (64 - ((uintptr_t)memory.data() % 64)) % 64;
+  DeviceMetricsRingBuffer ring(aligned, capacity, true);
+
+  MetricRecord record;
+  REQUIRE(record.setKey(std::string(MetricRecord::MAX_KEY_SIZE + 1, 'a')) == false);
+  REQUIRE(record.setKey("bkey"));
+  record.type = MetricType::Int;
+  for (int i = 0; i < (int)capacity; ++i) {
+    record.intValue = i;
+    record.timestamp = 1789372894 + i;
+    REQUIRE(ring.push(record));
+  }
+  // Ring is full
+  REQUIRE(ring.push(record) == false);
+  REQUIRE(ring.dropped() == 1);
+
+  // Another view on the same memory, like the driver would have.
+  DeviceMetricsRingBuffer reader(aligned, capacity, false);
+  DeviceMetricsInfo info;
+  std::vector<int> values;
+  auto consumed = reader.consume([&](MetricRecord const& r) {
+    values.push_back(r.intValue);
+    REQUIRE(DeviceMetricsHelper::processMetric(r, info));
+  });
+  REQUIRE(consumed == capacity);
+  REQUIRE(values == std::vector<int>{0, 1, 2, 3});
+  REQUIRE(reader.consume([](MetricRecord const&) {}) == 0);
+
+  // The records end up in the same store as the parsed metrics.
+  ParsedMetricMatch match;
+  std::string metricString = "[METRIC] bkey,0 12 1789372898 hostname=test.cern.ch";
+  REQUIRE(DeviceMetricsHelper::parseMetric(metricString, match));
+  REQUIRE(DeviceMetricsHelper::processMetric(match, info));
+  REQUIRE(info.metrics.size() == 1);
+  REQUIRE(info.metrics[0].type == MetricType::Int);
+  REQUIRE(info.metrics[0].filledMetrics == 5);
+  REQUIRE(info.intMetrics[0][3] == 3);
+  REQUIRE(info.intMetrics[0][4] == 12);
+  REQUIRE(info.intTimestamps[0][3] == 1789372897);
+
+  // Wrapping around
+  record.setKey("akey");
+  record.type = MetricType::Float;
+  record.floatValue = 0.5f;
+  REQUIRE(ring.push(record));
+  REQUIRE(reader.consume([&](MetricRecord const& r) {
+            REQUIRE(DeviceMetricsHelper::processMetric(r, info));
+          }) == 1);
+  REQUIRE(info.metrics.size() == 2);
+  auto akey = DeviceMetricsHelper::metricIdxByName("akey", info);
+  REQUIRE(info.metrics[akey].type == MetricType::Float);
+  REQUIRE(info.floatMetrics[info.metrics[akey].storeIdx][0] == 0.5f);
+}
@@ -13,6 +13,7 @@
 #include "Framework/ExpressionHelpers.h"
 #include "Framework/AnalysisDataModel.h"
 #include "Framework/AODReaderHelpers.h"
+#include "Framework/TableBuilder.h"
 #include <catch_amalgamated.hpp>
 #include <arrow/util/config.h>
 
@@ -283,3 +284,38 @@ TEST_CASE("TestConditionalExpressions")
   auto gandiva_filter2 = createFilter(schema2, gandiva_condition2);
   REQUIRE(gandiva_tree2->ToString() == "bool greater_than((float) fSigned1Pt, (const float) 0 raw(0)) && if (bool less_than(float absf((float) fEta), (const float) 1 raw(3f800000)) && if (bool less_than((float) fPt, (const float) 1 raw(3f800000))) { bool greater_than((float) fPhi, (const float) 1.5708 raw(3fc90fdb)) } else { bool less_than((float) fPhi, (const float) 1.5708 raw(3fc90fdb)) }) { bool greater_than(float absf((float) fX), (const float) 1 raw(3f800000)) } else { bool greater_than(float absf((float) fY), (const float) 1 raw(3f800000)) }");
 }
+
+TEST_CASE("TestColumnCuts")
+{
+  // conjunctions of comparisons of float columns with literals are extracted
+  Filter f = (o2::aod::track::pt > 1.f) && (0.8f >= o2::aod::track::eta) && (o2::aod::track::eta > -0.8f);
+  std::vector<ColumnCut> cuts;
+  REQUIRE(extractColumnCuts(createOperations(f), cuts));
+  REQUIRE(cuts.size() == 3);
+  REQUIRE(std::count_if(cuts.begin(), cuts.end(), [](auto const& cut) { return cut.column == "fEta" && cut.op == BasicOp::LessThanOrEqual && cut.value == (double)0.8f; }) == 1);
+
+  // anything else is left to gandiva
+  Filter fo = (o2::aod::track::pt > 1.f) || (o2::aod::track::eta > 0.f);
+  Filter fa = nabs(o2::aod::track::eta) < 1.f;
+  Filter fc = o2::aod::track::pt > o2::aod::track::eta;
+  std::vector<ColumnCut> none;
+  REQUIRE(!extractColumnCuts(createOperations(fo), none));
+  REQUIRE(!extractColumnCuts(createOperations(fa), none));
+  REQUIRE(!extractColumnCuts(createOperations(fc), none));
+  REQUIRE(none.empty());
+
+  // native evaluation gives the same selection as gandiva
+  TableBuilder builder;
+  auto rowWriter = builder.persist<float, float>({"fPt", "fEta"});
+  for (auto i = 0; i < 100; ++i) {
+    rowWriter(0, 0.05f * i, -1.f + 0.02f * i);
+  }
+  auto table = builder.finalize();
+  auto native = createSelection(table, cuts);
+  auto reference = createSelection(table, f);
+  REQUIRE(native->GetNumSlots() == reference->GetNumSlots());
+  REQUIRE(native->GetNumSlots() > 0);
+  for (auto i = 0; i < native->GetNumSlots(); ++i) {
+    REQUIRE(native->GetIndex(i) == reference->GetIndex(i));
+  }
+}
@@ -105,6 +105,28 @@ TEST_CASE("HistogramRegistryExpressionFill")
   REQUIRE(registry.get<TH2>(HIST("xy"))->GetEntries() == 2);
 }
 
+TEST_CASE("HistogramRegistryFillSpans")
+{
+  HistogramRegistry registry{
+    "registry", {
+                  {"x", "test x", {HistType::kTH1F, {{10, 0.0f, 10.0f}}}},                      //
+                  {"xy", "test xy", {HistType::kTH2F, {{10, 0.0f, 10.0f}, {10, 0.0f, 10.0f}}}} //
+                }                                                                             //
+  };
+
+  std::vector<float> xs{0.5f, 1.5f, 2.5f, 2.5f};
+  std::vector<double> ws{1., 2., 3., 4.};
+  /// Fill with weights
+  registry.fill(HIST("x"), gsl::span<float const>{xs}, gsl::span<double const>{ws});
+  auto x = registry.get<TH1>(HIST("x"));
+  REQUIRE(x->GetEntries() == 4);
+  REQUIRE(x->GetBinContent(3) == 7.);
+
+  std::vector<int> ys{1, 1, 2, 3};
+  registry.fill(HIST("xy"), gsl::span<float const>{xs}, gsl::span<int const>{ys});
+  REQUIRE(registry.get<TH2>(HIST("xy"))->GetEntries() == 4);
+}
+
 TEST_CASE("HistogramRegistryStepTHn")
 {
   HistogramRegistry registry{"registry"};
@@ -123,5 +145,22 @@ TEST_CASE("HistogramRegistryStepTHn")
 
   registry.fill(HIST("stepTHnD2"), 1, 0., 4.);
 
+  // sparse storage only allocates the filled bins
+  registry.add("stepTHnSparseF", "c", {kStepTHnSparseF, {{1000, -10.0f, 10.0f}, {1000, -10.0f, 10.0f}, {1000, -10.0f, 10.0f}}, 2});
+  registry.fill(HIST("stepTHnSparseF"), 0, 0.5, 1.5, 2.5);
+  registry.fill(HIST("stepTHnSparseF"), 0, 0.5, 1.5, 2.5);
+  registry.fill(HIST("stepTHnSparseF"), 1, -0.5, 1.5, 2.5, 2.);
+  auto sparse = registry.get<StepTHn>(HIST("stepTHnSparseF"));
+  REQUIRE(sparse->getValues(0) == nullptr);
+  auto step0 = sparse->getTHn(0, kTRUE);
+  REQUIRE(static_cast<THnSparse*>(step0)->GetNbins() == 1);
+  REQUIRE(step0->GetEntries() == 2);
+  double position[] = {0.5, 1.5, 2.5};
+  REQUIRE(step0->GetBinContent(step0->GetBin(position)) == 2.);
+  auto step1 = sparse->getTHn(1, kTRUE);
+  double position1[] = {-0.5, 1.5, 2.5};
+  REQUIRE(step1->GetBinContent(step1->GetBin(position1)) == 2.);
+  REQUIRE(step1->GetBinError(step1->GetBin(position1)) == 2.);
+
   registry.print();
 }
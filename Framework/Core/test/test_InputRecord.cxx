@@ -133,6 +133,14 @@ TEST_CASE("TestInputRecord")
   REQUIRE(record.get<int>("x") == 1);
   REQUIRE(record.get<int>("x") == 1);
 
+  // The same lookups using the precomputed index
+  InputRouteIndex index{schema};
+  InputRecord indexedRecord{schema, span2, registry, &index};
+  REQUIRE(indexedRecord.get<int>("x") == 1);
+  REQUIRE(indexedRecord.get<int>("y") == 2);
+  REQUIRE(indexedRecord.getPos("z") == 2);
+  REQUIRE_THROWS_AS(indexedRecord.get("err"), RuntimeErrorRef);
+
   // test the iterator
   int position = 0;
   for (auto input = record.begin(), end = record.end(); input != end; input++, position++) {
@@ -159,6 +167,37 @@ TEST_CASE("TestInputRecord")
   REQUIRE(record.end().begin() == record.end().end());
 }
 
+TEST_CASE("TestInputRouteIndex")
+{
+  InputSpec concrete1{"x", "TPC", "CLUSTERS", 0, Lifetime::Timeframe};
+  InputSpec wildcard{"y", ConcreteDataTypeMatcher{"TPC", "CLUSTERS"}, Lifetime::Timeframe};
+  InputSpec concrete2{"z", "ITS", "CLUSTERS", 0, Lifetime::Timeframe};
+  InputSpec duplicate{"x", "TPC", "CLUSTERS", 0, Lifetime::Timeframe};
+
+  // The timepipelined route is not counted for the positions.
+  std::vector<InputRoute> schema = {
+    InputRoute{wildcard, 0, "y_source", 0, std::nullopt},
+    InputRoute{concrete1, 1, "x_source", 0, std::nullopt},
+    InputRoute{concrete1, 1, "x_source_t1", 1, std::nullopt},
+    InputRoute{concrete2, 2, "z_source", 0, std::nullopt},
+    InputRoute{duplicate, 3, "x_source2", 0, std::nullopt}};
+
+  InputRouteIndex index{schema};
+  REQUIRE(index.size() == 4);
+  REQUIRE(index.getPos("y") == 0);
+  REQUIRE(index.getPos("x") == 1);
+  REQUIRE(index.getPos("z") == 2);
+  REQUIRE(index.getPos("err") == -1);
+
+  auto tpc = index.candidatesFor(ConcreteDataMatcher{"TPC", "CLUSTERS", 0});
+  REQUIRE(tpc.concrete == 1);
+  REQUIRE(tpc.generic == std::vector<size_t>{0});
+  auto its = index.candidatesFor(ConcreteDataMatcher{"ITS", "CLUSTERS", 0});
+  REQUIRE(its.concrete == 2);
+  auto missing = index.candidatesFor(ConcreteDataMatcher{"ITS", "CLUSTERS", 1});
+  REQUIRE(missing.concrete == InputRouteIndex::INVALID);
+}
+
 // TODO:
 // - test all `get` implementations
 // - create a list of supported types and check that the API compiles
@@ -0,0 +1,60 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/RateLimiter.h"
+#include <catch_amalgamated.hpp>
+
+using namespace o2::framework;
+
+TEST_CASE("AdmissionControllerFootprint")
+{
+  AdmissionController admission;
+  // Nothing in flight: the free memory is the reference.
+  admission.updateMemory(1000, 0);
+  REQUIRE(admission.footprint() == 0);
+  REQUIRE(admission.admit(1000, 100, 0));
+  REQUIRE(!admission.admit(100, 100, 0));
+
+  // Two timeframes in flight using 400 bytes.
+  admission.updateMemory(600, 2);
+  REQUIRE(admission.footprint() == 200);
+  REQUIRE(admission.admit(600, 100, 2));
+  // Another timeframe would leave less than minSHM free.
+  REQUIRE(!admission.admit(250, 100, 2));
+  // With nothing in flight there is nothing to wait for.
+  REQUIRE(admission.admit(250, 100, 0));
+
+  // The estimate moves slowly towards new samples.
+  admission.updateMemory(400, 2);
+  REQUIRE(admission.footprint() == 220);
+}
+
+TEST_CASE("AdmissionControllerDelay")
+{
+  AdmissionController admission;
+  // No rate known yet.
+  REQUIRE(admission.delay(0, 10, 10) == 0);
+  admission.updateConsumed(0, 100.);
+  REQUIRE(admission.consumptionRate() == 0);
+  admission.updateConsumed(10, 101.);
+  REQUIRE(admission.consumptionRate() == Catch::Approx(10.));
+  // Pipeline less than half full, no delay.
+  REQUIRE(admission.delay(0, 4, 10) == 0);
+  // Otherwise follow the consumption rate.
+  REQUIRE(admission.delay(0, 5, 10) == Catch::Approx(0.1));
+  REQUIRE(admission.delay(0.04, 8, 10) == Catch::Approx(0.06));
+  REQUIRE(admission.delay(1., 8, 10) == 0);
+  // A reset of the counter does not produce a bogus rate.
+  admission.updateConsumed(0, 102.);
+  REQUIRE(admission.consumptionRate() == Catch::Approx(10.));
+  admission.updateConsumed(20, 103.);
+  REQUIRE(admission.consumptionRate() == Catch::Approx(12.));
+}
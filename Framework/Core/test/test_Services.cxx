@@ -214,6 +214,44 @@ TEST_CASE("TestStreamServices")
   REQUIRE_THROWS_AS(registry.get({TypeIdHelpers::uniqueId<DummyService>()}, salt_1_1, ServiceKind::Stream), RuntimeErrorRef);
 }
 
+TEST_CASE("TestLazyServices")
+{
+  using namespace o2::framework;
+  ServiceRegistry registry;
+  static int created = 0;
+
+  ServiceSpec spec{.name = "dummy-service",
+                   .uniqueId = CommonServices::simpleServiceId<DummyService>(),
+                   .init = [](ServiceRegistryRef, DeviceState&, fair::mq::ProgOptions&) -> ServiceHandle {
+                     return ServiceHandle{TypeIdHelpers::uniqueId<DummyService>(), new DummyService{++created}};
+                   },
+                   .configure = CommonServices::noConfiguration(),
+                   .lazy = true,
+                   .kind = ServiceKind::Serial};
+
+  DeviceState state;
+  fair::mq::ProgOptions options;
+  registry.declareService(spec, state, options, ServiceRegistry::globalDeviceSalt());
+  // Declaring it does not create it, however it is already known.
+  REQUIRE(created == 0);
+  REQUIRE(registry.active<DummyService>(ServiceRegistry::globalDeviceSalt()) == true);
+
+  auto tt0 = reinterpret_cast<DummyService*>(registry.get({TypeIdHelpers::uniqueId<DummyService>()}, salt_0, ServiceKind::Serial));
+  REQUIRE(created == 1);
+  REQUIRE(tt0->threadId == 1);
+  // Subsequent gets, also from other streams, reuse the same instance.
+  auto tt1 = reinterpret_cast<DummyService*>(registry.get({TypeIdHelpers::uniqueId<DummyService>()}, salt_1, ServiceKind::Serial));
+  auto tt0bis = reinterpret_cast<DummyService*>(registry.get({TypeIdHelpers::uniqueId<DummyService>()}, salt_0, ServiceKind::Serial));
+  REQUIRE(created == 1);
+  REQUIRE(tt1 == tt0);
+  REQUIRE(tt0bis == tt0);
+
+  // A lazy service needs a uniqueId.
+  spec.uniqueId = nullptr;
+  ServiceRegistry registry2;
+  REQUIRE_THROWS_AS(registry2.declareService(spec, state, options, ServiceRegistry::globalDeviceSalt()), RuntimeErrorRef);
+}
+
 TEST_CASE("TestServiceRegistryCtor")
 {
   using namespace o2::framework;
@@ -190,6 +190,66 @@ TEST_CASE("TestTableBuilderBulk")
   }
 }
 
+TEST_CASE("TestTableBuilderBulkColumns")
+{
+  using namespace o2::framework;
+  TableBuilder builder;
+  auto bulkWriter = builder.bulkPersistColumns<int, float, bool, int[2]>({"x", "y", "b", "a"}, 8);
+  int x[] = {0, 1, 2, 3, 4, 5, 6, 7};
+  float y[] = {0.f, 1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f};
+  bool b[] = {true, false, true, false, true, false, true, false};
+  int a[] = {0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7};
+
+  // two batches of four rows
+  bulkWriter(4, x, y, b, a);
+  bulkWriter(4, x + 4, y + 4, b + 4, a + 8);
+
+  auto table = builder.finalize();
+  REQUIRE(table->num_columns() == 4);
+  REQUIRE(table->num_rows() == 8);
+  REQUIRE(table->schema()->field(0)->type()->id() == arrow::int32()->id());
+  REQUIRE(table->schema()->field(1)->type()->id() == arrow::float32()->id());
+  REQUIRE(table->schema()->field(2)->type()->id() == arrow::boolean()->id());
+  REQUIRE(table->schema()->field(3)->type()->id() == arrow::fixed_size_list(arrow::int32(), 2)->id());
+
+  auto px = std::dynamic_pointer_cast<arrow::NumericArray<arrow::Int32Type>>(table->column(0)->chunk(0));
+  auto py = std::dynamic_pointer_cast<arrow::NumericArray<arrow::FloatType>>(table->column(1)->chunk(0));
+  auto pb = std::dynamic_pointer_cast<arrow::BooleanArray>(table->column(2)->chunk(0));
+  auto pa = std::dynamic_pointer_cast<arrow::FixedSizeListArray>(table->column(3)->chunk(0));
+  auto pav = std::dynamic_pointer_cast<arrow::NumericArray<arrow::Int32Type>>(pa->values());
+  for (int i = 0; i < 8; ++i) {
+    REQUIRE(px->Value(i) == i);
+    REQUIRE(py->Value(i) == (float)i);
+    REQUIRE(pb->Value(i) == (i % 2 == 0));
+    REQUIRE(pav->Value(2 * i) == i);
+    REQUIRE(pav->Value(2 * i + 1) == i);
+  }
+}
+
+TEST_CASE("TestTableBuilderBulkCursor")
+{
+  using namespace o2::framework;
+  TableBuilder builder;
+  auto bulkWriter = builder.bulkCursor<TestTable>(8);
+  uint64_t x[] = {0, 10, 20, 30, 40, 50, 60, 70};
+  uint64_t y[] = {0, 1, 2, 3, 4, 5, 6, 7};
+  bulkWriter(8, x, y);
+  auto table = builder.finalize();
+  REQUIRE(table->num_columns() == 2);
+  REQUIRE(table->num_rows() == 8);
+  REQUIRE(table->schema()->field(0)->name() == "x");
+  REQUIRE(table->schema()->field(1)->name() == "y");
+
+  TestTable readBack{table};
+  size_t i = 0;
+  for (auto& row : readBack) {
+    REQUIRE(row.x() == i * 10);
+    REQUIRE(row.y() == i);
+    ++i;
+  }
+  REQUIRE(i == 8);
+}
+
 TEST_CASE("TestTableBuilderMore")
 {
   using namespace o2::framework;
@@ -457,6 +457,25 @@ TEST_CASE("optionalConcreteDataMatcherFrom")
   check(matcher7, true, ConcreteDataMatcher{"ITS", "RAWDATA", 0});
   check(matcher8, false);
 
+  // The data type is available also without a unique subspec, as long as
+  // only 'and' operations are used.
+  auto checkDataType = [](DataDescriptorMatcher const& matcher, bool expectDataType, ConcreteDataTypeMatcher compare = {"", ""}) {
+    auto dataType = DataSpecUtils::optionalConcreteDataTypeMatcherFrom(matcher);
+    CHECK(dataType.has_value() == expectDataType);
+    if (dataType.has_value()) {
+      CHECK(*dataType == compare);
+    }
+  };
+
+  checkDataType(matcher1, true, ConcreteDataTypeMatcher{"TPC", "CLUSTERS"});
+  checkDataType(matcher2, true, ConcreteDataTypeMatcher{"TPC", "CLUSTERS"});
+  checkDataType(matcher3, false);
+  checkDataType(matcher4, false);
+  checkDataType(matcher5, true, ConcreteDataTypeMatcher{"TPC", "CLUSTERS"});
+  checkDataType(matcher6, true, ConcreteDataTypeMatcher{"TPC", "CLUSTERS"});
+  checkDataType(matcher8, true, ConcreteDataTypeMatcher{"ITS", "RAWDATA"});
+  checkDataType(DataSpecUtils::dataDescriptorMatcherFrom(header::DataOrigin{"ITS"}), false);
+
   REQUIRE(DataSpecUtils::asOptionalConcreteDataMatcher(ConcreteDataMatcher{"ITS", "RAWDATA", 0}) == ConcreteDataMatcher{"ITS", "RAWDATA", 0});
   REQUIRE(DataSpecUtils::asOptionalConcreteDataMatcher(ConcreteDataTypeMatcher{"ITS", "RAWDATA"}) == std::nullopt);
 }
@@ -197,6 +197,38 @@ struct _o2_log_t {
 
   // Default stacktrace level for the log, when enabled.
   int defaultStacktrace = 1;
+
+  // Whether the signposts are recorded in the binary trace buffers.
+  // 0 means they are not. Like stacktrace, this can be changed
+  // from outside the process with o2-log.
+  int trace = 0;
+};
+
+// A signpost as recorded in the per thread trace buffers. We keep it
+// to a cache line and copy the name, so that we do not need to worry
+// about its lifetime when dumping the buffers.
+struct _o2_trace_event_t {
+  static constexpr size_t MAX_NAME_SIZE = 39;
+  // Nanoseconds from the steady clock.
+  uint64_t timestamp = 0;
+  int64_t id = 0;
+  _o2_log_t* log = nullptr;
+  // 'b' for the start, 'e' for the end of an interval, 'n' for an event,
+  // like in the Chrome trace format.
+  char phase = 0;
+  char name[MAX_NAME_SIZE] = {};
+};
+static_assert(sizeof(_o2_trace_event_t) == 64, "_o2_trace_event_t should fit in a cache line");
+
+// Circular buffer of the last N trace events of a given thread.
+// Only the owning thread writes into it, the buffers of all
+// the threads are kept in a list so that they can be dumped.
+struct _o2_trace_buffer_t {
+  static constexpr size_t N = 8192;
+  std::atomic<uint64_t> head = 0;
+  int64_t tid = 0;
+  _o2_trace_buffer_t* next = nullptr;
+  std::array<_o2_trace_event_t, N> events = {};
 };
 
 bool _o2_lock_free_stack_push(_o2_lock_free_stack& stack, const int& value, bool spin = false);
@@ -206,6 +238,13 @@ void _o2_signpost_event_emit(_o2_log_t* log, _o2_signpost_id_t id, char const* n
 void _o2_signpost_interval_begin(_o2_log_t* log, _o2_signpost_id_t id, char const* name, char const* const format, ...);
 void _o2_signpost_interval_end(_o2_log_t* log, _o2_signpost_id_t id, char const* name, char const* const format, ...);
 void _o2_log_set_stacktrace(_o2_log_t* log, int stacktrace);
+void _o2_log_set_trace(_o2_log_t* log, int trace);
+// Record a signpost in the trace buffer of the current thread. No formatting happens.
+void _o2_signpost_trace(_o2_log_t* log, _o2_signpost_id_t id, char const* name, char phase);
+// Write the content of all the trace buffers to @a filename in Chrome trace
+// format, which can be loaded in Perfetto or chrome://tracing.
+// @return false if the file could not be written.
+bool o2_signpost_trace_dump(char const* filename);
 
 // This generates a unique id for a signpost. Do not use this directly, use O2_SIGNPOST_ID_GENERATE instead.
 // Notice that this is only valid on a given computer.
@@ -233,7 +272,15 @@ inline _o2_signpost_id_t _o2_signpost_id_make_with_pointer(_o2_log_t* log, void
 #ifdef O2_SIGNPOST_IMPLEMENTATION
 #include <cstdarg>
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
 #include "Framework/RuntimeError.h"
 void _o2_signpost_interval_end_v(_o2_log_t* log, _o2_signpost_id_t id, char const* name, char const* const format, va_list args);
 
@@ -293,6 +340,134 @@ bool _o2_lock_free_stack_pop(_o2_lock_free_stack& stack, int& value, bool spin)
   }
 }
 
+// The first trace buffer of the list. Like for the logs, new ones
+// are added at the front and they are never removed.
+std::atomic<_o2_trace_buffer_t*>& _o2_get_trace_buffers()
+{
+  static std::atomic<_o2_trace_buffer_t*> first = nullptr;
+  return first;
+}
+
+_o2_trace_buffer_t* _o2_trace_buffer_create()
+{
+  auto* buffer = new _o2_trace_buffer_t();
+#ifdef __linux__
+  buffer->tid = syscall(SYS_gettid);
+#else
+  buffer->tid = std::hash<std::thread::id>{}(std::this_thread::get_id());
+#endif
+  buffer->next = _o2_get_trace_buffers().load();
+  while (!_o2_get_trace_buffers().compare_exchange_weak(buffer->next, buffer,
+                                                        std::memory_order_release,
+                                                        std::memory_order_relaxed)) {
+  }
+  return buffer;
+}
+
+void _o2_signpost_trace(_o2_log_t* log, _o2_signpost_id_t id, char const* name, char phase)
+{
+  thread_local _o2_trace_buffer_t* buffer = _o2_trace_buffer_create();
+  auto head = buffer->head.load(std::memory_order_relaxed);
+  auto& event = buffer->events[head % _o2_trace_buffer_t::N];
+  event.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  event.id = id.value;
+  event.log = log;
+  event.phase = phase;
+  strncpy(event.name, name ? name : "", _o2_trace_event_t::MAX_NAME_SIZE - 1);
+  event.name[_o2_trace_event_t::MAX_NAME_SIZE - 1] = '\0';
+  buffer->head.store(head + 1, std::memory_order_release);
+}
+
+// Notice that the buffers are not locked while dumping, so the events
+// which are being overwritten at the same time might be inconsistent.
+bool o2_signpost_trace_dump(char const* filename)
+{
+  FILE* f = fopen(filename, "w");
+  if (f == nullptr) {
+    return false;
+  }
+  int pid = getpid();
+  fprintf(f, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+  bool first = true;
+  for (auto* buffer = _o2_get_trace_buffers().load(); buffer; buffer = buffer->next) {
+    auto head = buffer->head.load(std::memory_order_acquire);
+    auto begin = head > _o2_trace_buffer_t::N ? head - _o2_trace_buffer_t::N : 0;
+    for (auto pos = begin; pos < head; ++pos) {
+      auto& event = buffer->events[pos % _o2_trace_buffer_t::N];
+      // Find the name of the log, which is used as category.
+      o2_log_handle_t* handle = o2_walk_logs([](char const*, void* log, void* context) -> bool {
+        return log != context;
+      },
+                                             event.log);
+      fprintf(f, "%s\n{\"name\":\"", first ? "" : ",");
+      // Names are usually identifiers, but better be safe.
+      for (char const* c = event.name; *c; ++c) {
+        if (*c == '"' || *c == '\\') {
+          fputc('\\', f);
+        }
+        fputc((unsigned char)*c < 0x20 ? ' ' : *c, f);
+      }
+      fprintf(f, "\",\"cat\":\"%s\",\"ph\":\"%c\",\"id\":\"0x%" PRIx64 "\",\"ts\":%.3f,\"pid\":%d,\"tid\":%" PRIi64 "}",
+              handle ? handle->name : "unknown", event.phase, event.id, event.timestamp / 1000., pid, buffer->tid);
+      first = false;
+    }
+  }
+  fprintf(f, "\n]}\n");
+  return fclose(f) == 0;
+}
+
+// If O2_SIGNPOST_TRACE is set, the buffers are dumped at exit to O2_SIGNPOST_TRACE_FILE,
+// where %d is replaced with the pid, or to o2-signposts-<pid>.json.
+void _o2_signpost_trace_dump_at_exit()
+{
+  char const* pattern = getenv("O2_SIGNPOST_TRACE_FILE");
+  char filename[4096];
+  if (pattern && strstr(pattern, "%d")) {
+    snprintf(filename, sizeof(filename), pattern, (int)getpid());
+  } else if (pattern) {
+    snprintf(filename, sizeof(filename), "%s", pattern);
+  } else {
+    snprintf(filename, sizeof(filename), "o2-signposts-%d.json", (int)getpid());
+  }
+  if (o2_signpost_trace_dump(filename) == false) {
+    fprintf(stderr, "Unable to write signposts trace to %s\n", filename);
+  }
+}
+
+// @return true if the log matches the comma separated list of names in O2_SIGNPOST_TRACE
+// (either the full name or without the ch.cern.aliceo2. prefix), or the list is "all".
+bool _o2_log_trace_requested(char const* name)
+{
+  char const* selection = getenv("O2_SIGNPOST_TRACE");
+  if (selection == nullptr || selection[0] == '\0') {
+    return false;
+  }
+  static bool dumpRegistered = false;
+  if (!dumpRegistered) {
+    dumpRegistered = true;
+    atexit(_o2_signpost_trace_dump_at_exit);
+  }
+  if (strcmp(selection, "all") == 0) {
+    return true;
+  }
+  char const* prefix = "ch.cern.aliceo2.";
+  char const* shortName = strncmp(name, prefix, strlen(prefix)) == 0 ? name + strlen(prefix) : name;
+  char const* token = selection;
+  while (*token) {
+    char const* end = strchr(token, ',');
+    size_t size = end ? end - token : strlen(token);
+    if ((strlen(name) == size && strncmp(name, token, size) == 0) ||
+        (strlen(shortName) == size && strncmp(shortName, token, size) == 0)) {
+      return true;
+    }
+    if (end == nullptr) {
+      break;
+    }
+    token = end + 1;
+  }
+  return false;
+}
+
 void* _o2_log_create(char const* name, int defaultStacktrace)
 {
   // iterate over the list of logs and check if we already have
@@ -320,6 +495,7 @@ void* _o2_log_create(char const* name, int defaultStacktrace)
     _o2_lock_free_stack_push(log->slots, signpost_index, true);
   }
   log->defaultStacktrace = defaultStacktrace;
+  log->trace = _o2_log_trace_requested(name) ? 1 : 0;
   auto* newHandle = new o2_log_handle_t();
   newHandle->log = log;
 #ifdef __APPLE__
@@ -451,12 +627,22 @@ void _o2_log_set_stacktrace(_o2_log_t* log, int stacktrace)
 {
   log->stacktrace = stacktrace;
 }
+
+void _o2_log_set_trace(_o2_log_t* log, int trace)
+{
+  log->trace = trace;
+}
 // A C function which can be used to enable the signposts
 extern "C" {
 void o2_debug_log_set_stacktrace(_o2_log_t* log, int stacktrace)
 {
   log->stacktrace = stacktrace;
 }
+// So that the trace can be dumped on demand from a debugger.
+bool o2_debug_signpost_trace_dump(char const* filename)
+{
+  return o2_signpost_trace_dump(filename);
+}
 }
 #endif // O2_SIGNPOST_IMPLEMENTATION
 
@@ -485,12 +671,17 @@ void o2_debug_log_set_stacktrace(_o2_log_t* log, int stacktrace)
 // mac and on linux we use our own implementation, using the logger. We can use the same ids because
 // they are compatible between the two implementations, we also use remove_engineering_type to remove
 // the engineering types from the format string, so that we can use the same format string for both.
+// Independently of that, if the log is traced, the signpost is recorded in the binary trace buffers,
+// without the formatted message.
 #define O2_SIGNPOST_EVENT_EMIT(log, id, name, format, ...) __extension__({                                          \
   if (O2_BUILTIN_UNLIKELY(O2_SIGNPOST_ENABLED_MAC(log))) {                                                          \
     O2_SIGNPOST_EVENT_EMIT_MAC(log, id, name, format, ##__VA_ARGS__);                                               \
   } else if (O2_BUILTIN_UNLIKELY(private_o2_log_##log->stacktrace)) {                                               \
     _o2_signpost_event_emit(private_o2_log_##log, id, name, remove_engineering_type(format).data(), ##__VA_ARGS__); \
   }                                                                                                                 \
+  if (O2_BUILTIN_UNLIKELY(private_o2_log_##log->trace)) {                                                           \
+    _o2_signpost_trace(private_o2_log_##log, id, name, 'n');                                                        \
+  }                                                                                                                 \
 })
 
 // Similar to the above, however it will print a normal info message if the signpost is not enabled.
@@ -502,6 +693,9 @@ void o2_debug_log_set_stacktrace(_o2_log_t* log, int stacktrace)
   } else {                                                                                                          \
     O2_LOG_MACRO_RAW(info, remove_engineering_type(format).data(), ##__VA_ARGS__);                                  \
   }                                                                                                                 \
+  if (O2_BUILTIN_UNLIKELY(private_o2_log_##log->trace)) {                                                           \
+    _o2_signpost_trace(private_o2_log_##log, id, name, 'n');                                                        \
+  }                                                                                                                 \
 })
 
 // Similar to the above, however it will always print a normal error message regardless of the signpost being enabled or not.
@@ -511,6 +705,9 @@ void o2_debug_log_set_stacktrace(_o2_log_t* log, int stacktrace)
   } else if (O2_BUILTIN_UNLIKELY(private_o2_log_##log->stacktrace)) {                                               \
     _o2_signpost_event_emit(private_o2_log_##log, id, name, remove_engineering_type(format).data(), ##__VA_ARGS__); \
   }                                                                                                                 \
+  if (O2_BUILTIN_UNLIKELY(private_o2_log_##log->trace)) {                                                           \
+    _o2_signpost_trace(private_o2_log_##log, id, name, 'n');                                                        \
+  }                                                                                                                 \
   O2_LOG_MACRO_RAW(error, remove_engineering_type(format).data(), ##__VA_ARGS__);                                   \
 })
 
@@ -521,21 +718,32 @@ void o2_debug_log_set_stacktrace(_o2_log_t* log, int stacktrace)
   } else if (O2_BUILTIN_UNLIKELY(private_o2_log_##log->stacktrace)) {                                               \
     _o2_signpost_event_emit(private_o2_log_##log, id, name, remove_engineering_type(format).data(), ##__VA_ARGS__); \
   }                                                                                                                 \
+  if (O2_BUILTIN_UNLIKELY(private_o2_log_##log->trace)) {                                                           \
+    _o2_signpost_trace(private_o2_log_##log, id, name, 'n');                                                        \
+  }                                                                                                                 \
   O2_LOG_MACRO_RAW(warn, remove_engineering_type(format).data(), ##__VA_ARGS__);                                    \
 })
 
-#define O2_SIGNPOST_START(log, id, name, format, ...)                                                                   \
+#define O2_SIGNPOST_START(log, id, name, format, ...) __extension__({                                                   \
   if (O2_BUILTIN_UNLIKELY(O2_SIGNPOST_ENABLED_MAC(log))) {                                                              \
     O2_SIGNPOST_START_MAC(log, id, name, format, ##__VA_ARGS__);                                                        \
   } else if (O2_BUILTIN_UNLIKELY(private_o2_log_##log->stacktrace)) {                                                   \
     _o2_signpost_interval_begin(private_o2_log_##log, id, name, remove_engineering_type(format).data(), ##__VA_ARGS__); \
-  }
-#define O2_SIGNPOST_END(log, id, name, format, ...)                                                                   \
+  }                                                                                                                     \
+  if (O2_BUILTIN_UNLIKELY(private_o2_log_##log->trace)) {                                                               \
+    _o2_signpost_trace(private_o2_log_##log, id, name, 'b');                                                            \
+  }                                                                                                                     \
+})
+#define O2_SIGNPOST_END(log, id, name, format, ...) __extension__({                                                   \
   if (O2_BUILTIN_UNLIKELY(O2_SIGNPOST_ENABLED_MAC(log))) {                                                            \
     O2_SIGNPOST_END_MAC(log, id, name, format, ##__VA_ARGS__);                                                        \
   } else if (O2_BUILTIN_UNLIKELY(private_o2_log_##log->stacktrace)) {                                                 \
     _o2_signpost_interval_end(private_o2_log_##log, id, name, remove_engineering_type(format).data(), ##__VA_ARGS__); \
-  }
+  }                                                                                                                   \
+  if (O2_BUILTIN_UNLIKELY(private_o2_log_##log->trace)) {                                                             \
+    _o2_signpost_trace(private_o2_log_##log, id, name, 'e');                                                          \
+  }                                                                                                                   \
+})
 #else // This is the release implementation, it does nothing.
 #define O2_DECLARE_DYNAMIC_LOG(x)
 #define O2_DECLARE_DYNAMIC_STACKTRACE_LOG(x)
@@ -11,6 +11,9 @@
 
 #include "Framework/Signpost.h"
 #include <iostream>
+#include <fstream>
+#include <string>
+#include <thread>
 
 int main(int argc, char** argv)
 {
@@ -49,4 +52,31 @@ int main(int argc, char** argv)
   O2_SIGNPOST_START(test_SignpostDynamic, id, "Test category", "This is dynamic signpost which you will see, because we turned them on");
   O2_SIGNPOST_END(test_SignpostDynamic, id, "Test category", "This is dynamic signpost which you will see, because we turned them on");
 #endif
+
+  // Record the signposts in the binary trace buffers and dump them.
+  O2_DECLARE_DYNAMIC_LOG(test_SignpostTrace);
+  _o2_log_set_trace(private_o2_log_test_SignpostTrace, 1);
+  O2_SIGNPOST_ID_GENERATE(tid, test_SignpostTrace);
+  O2_SIGNPOST_START(test_SignpostTrace, tid, "traced", "This is not printed, only traced %d", 1);
+  std::thread other([]() {
+    O2_SIGNPOST_ID_GENERATE(tid2, test_SignpostTrace);
+    O2_SIGNPOST_EVENT_EMIT(test_SignpostTrace, tid2, "traced_in_thread", "In another thread");
+  });
+  other.join();
+  O2_SIGNPOST_END(test_SignpostTrace, tid, "traced", "This is not printed, only traced");
+  char const* traceFile = "test_Signpost_trace.json";
+  if (o2_signpost_trace_dump(traceFile) == false) {
+    std::cerr << "Unable to dump the trace" << std::endl;
+    return 1;
+  }
+  std::ifstream trace(traceFile);
+  std::string content((std::istreambuf_iterator<char>(trace)), std::istreambuf_iterator<char>());
+  std::cout << content;
+  if (content.find("\"name\":\"traced\",\"cat\":\"ch.cern.aliceo2.test_SignpostTrace\",\"ph\":\"b\"") == std::string::npos ||
+      content.find("\"ph\":\"e\"") == std::string::npos ||
+      content.find("\"name\":\"traced_in_thread\"") == std::string::npos) {
+    std::cerr << "Unexpected trace content" << std::endl;
+    return 1;
+  }
+  std::remove(traceFile);
 }
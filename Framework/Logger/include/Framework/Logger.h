@@ -12,9 +12,220 @@
 #define O2_FRAMEWORK_LOGGER_H_
 
 #include <fairlogger/Logger.h>
+#include <fmt/format.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <unistd.h>
 
 #define O2DEBUG(...) LOGF(debug, __VA_ARGS__)
 #define O2INFO(...) LOGF(info, __VA_ARGS__)
 #define O2ERROR(...) LOGF(error, __VA_ARGS__)
 
+namespace o2::framework
+{
+
+/// State of a rate limited logging call site: at most one message per period
+/// is accepted, the others are only counted.
+class LogRateLimiter
+{
+ public:
+  /// @returns true if the message is to be logged, @a suppressed being then the number
+  /// of messages dropped since the previous accepted one
+  bool accept(int64_t periodMs, uint64_t& suppressed)
+  {
+    auto now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    auto next = mNext.load(std::memory_order_relaxed);
+    if (now < next || !mNext.compare_exchange_strong(next, now + periodMs, std::memory_order_relaxed)) {
+      mSuppressed.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    suppressed = mSuppressed.exchange(0, std::memory_order_relaxed);
+    return true;
+  }
+
+ private:
+  std::atomic<int64_t> mNext{0};
+  std::atomic<uint64_t> mSuppressed{0};
+};
+
+/// Thread formatting and emitting the messages of the LOGP_ASYNC macros, so that
+/// the calling thread only pays for copying the arguments.
+class AsyncLogger
+{
+ public:
+  /// messages beyond this are dropped and counted, rather than growing the queue
+  static constexpr size_t MaxQueued = 100000;
+
+  static AsyncLogger& instance()
+  {
+    static AsyncLogger logger;
+    return logger;
+  }
+
+  void push(std::function<void(uint64_t)>&& message)
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    // the thread of the parent is not there after a fork
+    if (mPid != getpid()) {
+      mThread.release(); // NOLINT: not running in this process, cannot be joined
+      mQueue.clear();
+      mPid = getpid();
+      mStop = false;
+      mThread = std::make_unique<std::thread>(&AsyncLogger::loop, this);
+    }
+    if (mQueue.size() >= MaxQueued) {
+      mDropped++;
+      return;
+    }
+    mQueue.emplace_back(std::move(message));
+    mCondition.notify_one();
+  }
+
+  /// wait until all the queued messages are emitted
+  void flush()
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    if (mPid == getpid()) {
+      mFlushed.wait(lock, [this] { return mQueue.empty() && !mBusy; });
+    }
+  }
+
+  ~AsyncLogger()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mStop = true;
+      mCondition.notify_one();
+    }
+    if (mPid == getpid()) {
+      mThread->join();
+    } else {
+      mThread.release(); // NOLINT: see push
+    }
+  }
+
+ private:
+  AsyncLogger() = default;
+
+  void loop()
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (true) {
+      mCondition.wait(lock, [this] { return mStop || !mQueue.empty(); });
+      if (mQueue.empty()) {
+        return;
+      }
+      auto message = std::move(mQueue.front());
+      mQueue.pop_front();
+      auto dropped = mDropped;
+      mDropped = 0;
+      mBusy = true;
+      lock.unlock();
+      message(dropped);
+      lock.lock();
+      mBusy = false;
+      if (mQueue.empty()) {
+        mFlushed.notify_all();
+      }
+    }
+  }
+
+  std::mutex mMutex;
+  std::condition_variable mCondition;
+  std::condition_variable mFlushed;
+  std::deque<std::function<void(uint64_t)>> mQueue;
+  std::unique_ptr<std::thread> mThread;
+  pid_t mPid = -1;
+  uint64_t mDropped = 0;
+  bool mBusy = false;
+  bool mStop = false;
+};
+
+namespace detail
+{
+// arguments are kept by value until the message is formatted: strings are copied
+template <typename T>
+auto loggable(T&& arg)
+{
+  using U = std::decay_t<T>;
+  if constexpr (std::is_same_v<U, char*> || std::is_same_v<U, const char*> || std::is_same_v<U, std::string_view>) {
+    return std::string(arg);
+  } else {
+    return U(std::forward<T>(arg));
+  }
+}
+
+template <typename... Args>
+void logAsync(fair::Severity severity, const char* file, const char* line, const char* function, uint64_t suppressed, const char* format, Args&&... args)
+{
+  AsyncLogger::instance().push([=, values = std::make_tuple(loggable(std::forward<Args>(args))...)](uint64_t dropped) {
+    auto text = std::apply([format](auto const&... v) { return fmt::vformat(format, fmt::make_format_args(v...)); }, values);
+    fair::Logger logger(severity, file, line, function);
+    logger << text;
+    if (suppressed) {
+      logger << " (" << suppressed << " similar messages suppressed)";
+    }
+    if (dropped) {
+      logger << " (" << dropped << " messages dropped by the logging queue)";
+    }
+  });
+}
+} // namespace detail
+
+} // namespace o2::framework
+
+#define O2_LOG_STRINGIFY_(x) #x
+#define O2_LOG_STRINGIFY(x) O2_LOG_STRINGIFY_(x)
+
+/// fmt formatted message emitted at most once every @a periodMs milliseconds by the call site,
+/// with the number of the suppressed ones. Nothing is formatted for suppressed messages.
+#define LOGP_RATE_LIMITED(severity, periodMs, ...)                                                                 \
+  do {                                                                                                             \
+    if (fair::Logger::Logging(fair::Severity::severity)) {                                                         \
+      static o2::framework::LogRateLimiter o2LogRateLimiter;                                                       \
+      uint64_t o2LogSuppressed = 0;                                                                                \
+      if (o2LogRateLimiter.accept(periodMs, o2LogSuppressed)) {                                                    \
+        if (o2LogSuppressed) {                                                                                     \
+          LOG(severity) << fmt::format(__VA_ARGS__) << " (" << o2LogSuppressed << " similar messages suppressed)"; \
+        } else {                                                                                                   \
+          LOG(severity) << fmt::format(__VA_ARGS__);                                                               \
+        }                                                                                                          \
+      }                                                                                                            \
+    }                                                                                                              \
+  } while (0)
+
+/// fmt formatted message whose arguments are copied and which is formatted and emitted
+/// by the logging thread
+#define LOGP_ASYNC(severity, ...)                                                                     \
+  do {                                                                                                \
+    if (fair::Logger::Logging(fair::Severity::severity)) {                                            \
+      o2::framework::detail::logAsync(fair::Severity::severity, __FILE__, O2_LOG_STRINGIFY(__LINE__), \
+                                      static_cast<const char*>(__FUNCTION__), 0, __VA_ARGS__);        \
+    }                                                                                                 \
+  } while (0)
+
+/// rate limited as LOGP_RATE_LIMITED and emitted as LOGP_ASYNC, for error messages in hot loops
+#define LOGP_ASYNC_RATE_LIMITED(severity, periodMs, ...)                                                       \
+  do {                                                                                                         \
+    if (fair::Logger::Logging(fair::Severity::severity)) {                                                     \
+      static o2::framework::LogRateLimiter o2LogRateLimiter;                                                   \
+      uint64_t o2LogSuppressed = 0;                                                                            \
+      if (o2LogRateLimiter.accept(periodMs, o2LogSuppressed)) {                                                \
+        o2::framework::detail::logAsync(fair::Severity::severity, __FILE__, O2_LOG_STRINGIFY(__LINE__),        \
+                                        static_cast<const char*>(__FUNCTION__), o2LogSuppressed, __VA_ARGS__); \
+      }                                                                                                        \
+    }                                                                                                          \
+  } while (0)
+
 #endif // O2_FRAMEWORK_LOGGER_H_
@@ -24,3 +24,35 @@ TEST_CASE("TestLogF")
   O2ERROR("{}", "Hello world");
   O2INFO("{}", "Hello world");
 }
+
+TEST_CASE("TestLogRateLimiter")
+{
+  o2::framework::LogRateLimiter limiter;
+  uint64_t suppressed = 1;
+  REQUIRE(limiter.accept(1000000, suppressed));
+  REQUIRE(suppressed == 0);
+  for (int i = 0; i < 10; i++) {
+    REQUIRE(!limiter.accept(1000000, suppressed));
+  }
+  // still within the period of the first message
+  REQUIRE(!limiter.accept(0, suppressed));
+  o2::framework::LogRateLimiter other;
+  REQUIRE(other.accept(0, suppressed));
+  REQUIRE(other.accept(0, suppressed));
+  REQUIRE(suppressed == 0);
+
+  for (int i = 0; i < 1000; i++) {
+    LOGP_RATE_LIMITED(error, 1000000, "Hello world {}", i);
+  }
+}
+
+TEST_CASE("TestLogAsync")
+{
+  for (int i = 0; i < 10; i++) {
+    std::string world = "world";
+    LOGP_ASYNC(info, "Hello {} {}", world.c_str(), i);
+    LOGP_ASYNC_RATE_LIMITED(error, 1000000, "{1} {0} {2:03.2f}", std::string_view{world}, "Hello", 1000.30343f);
+  }
+  LOGP_ASYNC(debug, "{}", "Not formatted");
+  o2::framework::AsyncLogger::instance().flush();
+}
@@ -21,6 +21,7 @@
 #include "Framework/DataRefUtils.h"
 #include "Framework/Logger.h"
 #include "Framework/InputRecordWalker.h"
+#include <algorithm>
 #include <utility> // std::declval
 
 // Framework does not depend on detectors, but this file is header-only.
@@ -63,6 +64,12 @@ class InputRecord;
 ///   };
 ///   DPLRawPageSequencer(inputs)(isSameRdh, insertPages);
 ///
+/// Alternatively, all raw pages can be indexed in one pass and the decoder
+/// can iterate over the index or partition it by link:
+///   std::vector<raw_parser::RawPageInfo> index;
+///   DPLRawPageSequencer(inputs).index(index);
+///   DPLRawPageSequencer::sortByLink(index);
+///
 /// TODO:
 ///   - support configurable page length
 class DPLRawPageSequencer
@@ -167,6 +174,46 @@ class DPLRawPageSequencer
     return retVal;
   }
 
+  /// Append a RawPageInfo entry for every raw page of the inputs to @a pages, in input order
+  template <typename Container>
+  int index(Container& pages)
+  {
+    return index(pages, [](...) { return true; });
+  }
+
+  template <typename Container, typename Precheck>
+  int index(Container& pages, Precheck preCheck)
+  {
+    for (auto const& ref : mInput) {
+      auto size = DataRefUtils::getPayloadSize(ref);
+      const auto dh = DataRefUtils::getHeader<o2::header::DataHeader*>(ref);
+      if (dh == nullptr) {
+        continue;
+      }
+      if (size == 0) {
+        if (dh->subSpecification == 0xDEADBEEF) {
+          raw_parser::RawParserHelper::warnDeadBeef(dh);
+        }
+        continue;
+      }
+      if (!preCheck(ref.payload, dh->subSpecification)) {
+        continue;
+      }
+      rawparser_type(ref.payload, size).index(pages, dh->subSpecification);
+    }
+    return 0;
+  }
+
+  /// Order an index by subspecification and FEE ID, keeping the input order of the
+  /// pages of each link
+  template <typename Container>
+  static void sortByLink(Container& pages)
+  {
+    std::stable_sort(pages.begin(), pages.end(), [](auto const& a, auto const& b) {
+      return a.subSpec != b.subSpec ? a.subSpec < b.subSpec : a.feeId < b.feeId;
+    });
+  }
+
   template <typename Predicate, typename Inserter>
   int forward(Predicate pred, Inserter inserter)
   {
@@ -68,6 +68,8 @@ namespace framework
 ///     --nevents
 ///     --autosave
 ///     --terminate
+///     --async-queue
+///     --imt-threads
 ///
 /// \par
 /// In addition to that, a custom option can be added for every branch to configure the
@@ -94,6 +96,12 @@ namespace framework
 /// to do the processing of an input object or skip it. The two types of evaluators are
 /// checked before or after extraction of an object from the input.
 ///
+/// \par Asynchronous writing:
+/// With a non-zero --async-queue, the branches are filled and compressed in a background
+/// thread of the writer, see RootTreeWriter::setAsync. The processing blocks when the given
+/// number of input sets is queued. --imt-threads enables ROOT's implicit multithreading,
+/// the baskets of the different branches are then compressed in parallel.
+///
 /// \par Usage:
 ///
 ///     WorkflowSpec specs;
@@ -403,6 +411,11 @@ class MakeRootTreeWriterSpec
         }
         filename = outdir + filename;
       }
+      auto imtThreads = ic.options().get<int>("imt-threads");
+      if (imtThreads > 0) {
+        ROOT::EnableImplicitMT(imtThreads);
+      }
+      processAttributes->writer->setAsync(std::max(0, ic.options().get<int>("async-queue")));
       processAttributes->writer->init(filename.c_str(), treename.c_str(), treetitle.c_str());
       // the callback to be set as hook at stop of processing for the framework
       auto finishWriting = [processAttributes]() {
@@ -492,6 +505,8 @@ class MakeRootTreeWriterSpec
       {"nevents", VariantType::Int, mDefaultNofEvents, {"Number of events to execute"}},
       {"autosave", VariantType::Int, mDefaultAutoSave, {"Autosave after number of events"}},
       {"terminate", VariantType::String, mDefaultTerminationPolicy.c_str(), {"Terminate the 'process' or 'workflow'"}},
+      {"async-queue", VariantType::Int, 0, {"Number of input sets queued for writing in a background thread, 0 to write synchronously"}},
+      {"imt-threads", VariantType::Int, 0, {"Number of threads for ROOT implicit multithreading in branch compression, 0 to disable"}},
     };
     for (size_t branchIndex = 0; branchIndex < mBranchNameOptions.size(); branchIndex++) {
       // adding option definitions for those ones defined in the branch definition
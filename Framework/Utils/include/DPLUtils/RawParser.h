@@ -92,6 +92,19 @@ struct RawParserHelper {
   static void warnDeadBeef(const o2::header::DataHeader* dh);
 };
 
+/// @struct RawPageInfo compact description of a raw page, filled by the index
+/// methods of the parsers in a single pass over the buffer, so that the pages
+/// can be iterated or partitioned by link without parsing the RDHs again
+struct RawPageInfo {
+  const char* page = nullptr; // start of the page, i.e. the RDH
+  uint32_t size = 0;          // size of header and payload
+  uint32_t orbit = 0;         // (heartbeat) orbit
+  uint32_t subSpec = 0;       // subspecification of the input, if known
+  uint16_t feeId = 0;         // FEE identifier
+  uint16_t bc = 0;            // (heartbeat) bunch crossing
+};
+static_assert(sizeof(RawPageInfo) == 24);
+
 /// @class ConcreteRawParser
 /// Raw parser implementation for a particular version of RAWDataHeader.
 /// Parses a contiguous sequence of raw pages in a raw buffer.
@@ -219,16 +232,7 @@ class ConcreteRawParser
     if (!reset()) {
       return;
     }
-    if constexpr (BOUNDS_CHECKS) {
-      if (RawParserHelper::sErrorMode && !checkPageInBuffer()) {
-        if (RawParserHelper::sErrorMode >= 2) {
-          throw std::runtime_error("Corrupt RDH - RDH parsing ran out of raw data buffer");
-        }
-        if (RawParserHelper::checkPrintError(mNErrors)) {
-          LOG(error) << "RAWPARSER: Corrupt RDH - RDH parsing ran out of raw data buffer (" << RawParserHelper::sErrors << " total RawParser errors)";
-        }
-      }
-    }
+    checkFirstPage();
     // auto deleter = [](buffer_type*) {};
     do {
       processor(data(), size());
@@ -236,6 +240,33 @@ class ConcreteRawParser
     } while (next());
   }
 
+  /// Index the complete buffer
+  /// A RawPageInfo entry is appended to the container for each page, the header fields
+  /// are read with the fixed header type of this parser
+  template <typename Container>
+  void index(Container& pages, uint32_t subSpec = 0)
+  {
+    if (!reset()) {
+      return;
+    }
+    checkFirstPage();
+    do {
+      header_type const& h = header();
+      auto& info = pages.emplace_back();
+      info.page = reinterpret_cast<const char*>(mPosition);
+      info.size = sizeTotal();
+      info.subSpec = subSpec;
+      info.feeId = h.feeId;
+      if constexpr (std::is_same<header_type, header::RAWDataHeaderV4>::value) {
+        info.orbit = h.heartbeatOrbit;
+        info.bc = h.heartbeatBC;
+      } else {
+        info.orbit = h.orbit;
+        info.bc = h.bunchCrossing;
+      }
+    } while (next());
+  }
+
   /// Move to next page start
   bool next()
   {
@@ -343,6 +374,20 @@ class ConcreteRawParser
   }
 
  private:
+  void checkFirstPage()
+  {
+    if constexpr (BOUNDS_CHECKS) {
+      if (RawParserHelper::sErrorMode && !checkPageInBuffer()) {
+        if (RawParserHelper::sErrorMode >= 2) {
+          throw std::runtime_error("Corrupt RDH - RDH parsing ran out of raw data buffer");
+        }
+        if (RawParserHelper::checkPrintError(mNErrors)) {
+          LOG(error) << "RAWPARSER: Corrupt RDH - RDH parsing ran out of raw data buffer (" << RawParserHelper::sErrors << " total RawParser errors)";
+        }
+      }
+    }
+  }
+
   buffer_type const* mRawBuffer;
   buffer_type const* mPosition = nullptr;
   size_t mSize;
@@ -451,7 +496,11 @@ U const* get_if(T& instances)
 ///     };
 ///     parser.parse(processor);
 ///
-///     // option 2: iterator
+///     // option 2: index of all pages, e.g. to partition by link
+///     std::vector<raw_parser::RawPageInfo> pages;
+///     RawParser(buffer, size).index(pages);
+///
+///     // option 3: iterator
 ///     RawParser parser(buffer, size);
 ///     for (auto it = parser.begin(), end = parser.end(); it != end; ++it, ++count) {
 ///       std::cout << "Iterating block of size " << it.size() << std::endl;
@@ -491,6 +540,14 @@ class RawParser
     // std::visit([&processor](auto& parser) { return parser.parse(processor); }, mParser);
   }
 
+  /// Index complete raw buffer, one RawPageInfo entry is appended to the container for each page.
+  /// The version is dispatched once for the buffer, not per page.
+  template <typename Container>
+  void index(Container& pages, uint32_t subSpec = 0)
+  {
+    std::visit([&pages, subSpec](auto& parser) { parser.index(pages, subSpec); }, mParser);
+  }
+
   /// Reset parser and set position to beginning of buffer
   bool reset()
   {
@@ -24,6 +24,7 @@
 #include <TTree.h>
 #include <TBranch.h>
 #include <TClass.h>
+#include <TROOT.h>
 #include <vector>
 #include <functional>
 #include <string>
@@ -35,6 +36,11 @@
 #include <utility>    // std::forward
 #include <algorithm>  // std::generate
 #include <variant>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
 
 namespace o2
 {
@@ -117,6 +123,14 @@ struct can_assign<
 /// as a \c std::vector<char>, this ensures separation on event basis as well as having binary
 /// data in parallel to ROOT objects in the same file, e.g. a binary data format from the
 /// reconstruction in parallel to MC labels.
+///
+/// \par Asynchronous writing:
+/// With \ref setAsync, the branches are filled and compressed by a background thread.
+/// The processing call only extracts the inputs and queues them, objects which are
+/// only referenced in the input messages are copied because the messages are released
+/// after processing. The call blocks if the queue is full. Spectator callbacks are still
+/// invoked in the processing call, Fill callbacks on the background thread. Definitions
+/// using the FillExt callback need the DataRef when filling and force synchronous writing.
 class RootTreeWriter
 {
  public:
@@ -313,6 +327,33 @@ class RootTreeWriter
     mTree = std::make_unique<TTree>(treename, treetitle != nullptr ? treetitle : treename);
     mTree->SetDirectory(mFile.get());
     mTreeStructure->setup(mBranchSpecs, mTree.get());
+    if (mQueueSize > 0) {
+      for (auto const& spec : mBranchSpecs) {
+        if (spec.needsInputRef) {
+          LOG(warning) << "branch " << spec.names.at(0) << " uses a callback which needs the input reference, falling back to synchronous writing";
+          mQueueSize = 0;
+          return;
+        }
+      }
+      mWorker = std::thread([this]() { runWorker(); });
+    }
+  }
+
+  /// Fill and compress the branches in a background thread
+  /// @param queueSize  number of input sets which can be queued before the
+  ///                   processing call blocks, 0 for synchronous writing
+  ///
+  /// Has to be called before init.
+  void setAsync(size_t queueSize)
+  {
+    if (mFile) {
+      throw std::runtime_error("asynchronous writing has to be configured before init");
+    }
+    mQueueSize = queueSize;
+    if (mQueueSize > 0) {
+      // the processing thread keeps using ROOT for the deserialization of inputs
+      ROOT::EnableThreadSafety();
+    }
   }
 
   /// Set the branch name for a branch definition from the constructor argument list
@@ -345,9 +386,21 @@ class RootTreeWriter
     if (!mTree || !mFile || mFile->IsZombie()) {
       throw std::runtime_error("Writer is invalid state, probably closed previously");
     }
-    // execute tree structure handlers and fill the individual branches
-    mTreeStructure->exec(std::forward<ContextType>(context), mBranchSpecs);
-    // Note: number of entries will be set when closing the writer
+    if (mQueueSize == 0) {
+      // execute tree structure handlers and fill the individual branches
+      mTreeStructure->exec(std::forward<ContextType>(context), mBranchSpecs, nullptr);
+      // Note: number of entries will be set when closing the writer
+      return;
+    }
+    std::vector<Job> entry;
+    mTreeStructure->exec(std::forward<ContextType>(context), mBranchSpecs, &entry);
+    if (entry.size()) {
+      enqueue([entry = std::move(entry)]() {
+        for (auto const& job : entry) {
+          job();
+        }
+      });
+    }
   }
 
   /// write the tree and close the file
@@ -356,6 +409,21 @@ class RootTreeWriter
   {
     if (!mIsClosed) {
       mIsClosed = true;
+      if (mWorker.joinable()) {
+        {
+          std::lock_guard<std::mutex> lock(mQueueMutex);
+          mStopWorker = true;
+        }
+        mQueueCondition.notify_all();
+        mWorker.join();
+        if (mWorkerError) {
+          try {
+            std::rethrow_exception(mWorkerError);
+          } catch (std::exception const& e) {
+            LOG(error) << "Asynchronous writing of " << mTree->GetName() << " failed: " << e.what();
+          }
+        }
+      }
       if (!mFile) {
         return;
       }
@@ -381,9 +449,16 @@ class RootTreeWriter
     if (mIsClosed || !mFile) {
       return;
     }
-    mTree->SetEntries();
-    LOG(info) << "Autosaving " << mTree->GetName() << " at entry " << mTree->GetEntries();
-    mTree->AutoSave("overwrite");
+    auto save = [tree = mTree.get()]() {
+      tree->SetEntries();
+      LOG(info) << "Autosaving " << tree->GetName() << " at entry " << tree->GetEntries();
+      tree->AutoSave("overwrite");
+    };
+    if (mWorker.joinable()) {
+      enqueue(save);
+    } else {
+      save();
+    }
   }
 
   bool isClosed() const
@@ -436,9 +511,15 @@ class RootTreeWriter
     TClass* classinfo = nullptr;
     IndexExtractor getIndex = nullptr;
     BranchNameMapper getName = nullptr;
+    /// the fill callback needs the DataRef, which is only valid during processing
+    bool needsInputRef = false;
   };
 
   using InputContext = InputRecord;
+  /// deferred filling of one branch, or of all branches for one input set
+  using Job = std::function<void()>;
+  /// the jobs to run for the current input set, nullptr when filling synchronously
+  using DeferredJobs = std::vector<Job>*;
 
   /// polymorphic interface for the mixin stack of branch type descriptions
   /// it implements the entry point for processing through exec method
@@ -456,7 +537,9 @@ class RootTreeWriter
     /// enters at the outermost element and recurses to the base elements
     /// Read the configured inputs from the input context, select the output branch
     /// and write the object
-    virtual void exec(InputContext&, std::vector<BranchSpec>&) {}
+    /// If a list of deferred jobs is given, the filling is added to the list
+    /// instead of being executed.
+    virtual void exec(InputContext&, std::vector<BranchSpec>&, DeferredJobs) {}
     /// get the size of the branch structure, i.e. the number of registered branch
     /// definitions
     virtual size_t size() const { return STAGE; }
@@ -464,7 +547,7 @@ class RootTreeWriter
     // a dummy method called in the recursive processing
     void setupInstance(std::vector<BranchSpec>&, TTree*) {}
     // a dummy method called in the recursive processing
-    void process(InputContext&, std::vector<BranchSpec>&) {}
+    void process(InputContext&, std::vector<BranchSpec>&, DeferredJobs) {}
   };
 
   template <typename T = char>
@@ -558,9 +641,9 @@ class RootTreeWriter
 
     // this is the polymorphic entry point for processing of branch specs
     // recursive processing starting from the highest instance
-    void exec(InputContext& context, std::vector<BranchSpec>& specs) override
+    void exec(InputContext& context, std::vector<BranchSpec>& specs, DeferredJobs deferred) override
     {
-      process(context, specs);
+      process(context, specs, deferred);
     }
     size_t size() const override { return STAGE; }
 
@@ -602,6 +685,7 @@ class RootTreeWriter
         return;
       }
       specs[SpecIndex].classinfo = TClass::GetClass(typeid(value_type));
+      specs[SpecIndex].needsInputRef = std::holds_alternative<typename BranchDef<value_type>::FillExt>(mCallback);
       if (std::is_same<value_type, const char*>::value == false && std::is_fundamental<value_type>::value == false &&
           specs[SpecIndex].classinfo == nullptr) {
         // for all non-fundamental types but the special case for binary chunks, a dictionary is required
@@ -624,10 +708,10 @@ class RootTreeWriter
       }
     }
 
-    /// check the alternatives for the callback and run if there are any
-    /// @return true if branch has been filled, false if still to be filled
+    /// run the spectator callbacks if there are any, they are always invoked
+    /// while processing the input
     template <typename DataType>
-    bool runCallback(TBranch* branch, DataType const& data, DataRef const& ref)
+    void runSpectator(DataType const& data, DataRef const& ref)
     {
       if (std::holds_alternative<typename BranchDef<value_type>::Spectator>(mCallback)) {
         std::get<typename BranchDef<value_type>::Spectator>(mCallback)(data);
@@ -635,6 +719,13 @@ class RootTreeWriter
       if (std::holds_alternative<typename BranchDef<value_type>::SpectatorExt>(mCallback)) {
         std::get<typename BranchDef<value_type>::SpectatorExt>(mCallback)(data, ref);
       }
+    }
+
+    /// check the alternatives for the fill callback and run if there are any
+    /// @return true if branch has been filled, false if still to be filled
+    template <typename DataType>
+    bool runFill(TBranch* branch, DataType const& data, DataRef const& ref)
+    {
       if (std::holds_alternative<typename BranchDef<value_type>::Fill>(mCallback)) {
         std::get<typename BranchDef<value_type>::Fill>(mCallback)(*branch, data);
         return true;
@@ -646,50 +737,82 @@ class RootTreeWriter
       return false;
     }
 
+    /// fill the branch now, or add the filling to the deferred jobs
+    template <typename F>
+    void commit(DeferredJobs deferred, F&& fill)
+    {
+      if (deferred) {
+        deferred->emplace_back(std::forward<F>(fill));
+      } else {
+        fill();
+      }
+    }
+
+    /// fill the branch from an object, the pointer keeps the object alive until
+    /// the branch is filled
+    /// store is a pointer to object
+    void commitObject(DeferredJobs deferred, std::shared_ptr<value_type const> object, DataRef const& ref, TBranch* branch, size_t branchIdx)
+    {
+      runSpectator(*object, ref);
+      commit(deferred, [this, object, ref, branch, branchIdx]() {
+        if (!runFill(branch, *object, ref)) {
+          // this is ugly but necessary because of the TTree API does not allow a const
+          // object as input. Have to rely on that ROOT treats the object as const
+          mStore[branchIdx] = const_cast<value_type*>(object.get());
+          branch->Fill();
+        }
+      });
+    }
+
     // specialization for trivial structs or serialized objects without a TClass interface
     // the extracted object is copied to store variable
     template <typename S, typename std::enable_if_t<std::is_same<S, MessageableTypeSpecialization>::value, int> = 0>
-    void fillData(InputContext& context, DataRef const& ref, TBranch* branch, size_t branchIdx)
+    void fillData(InputContext& context, DataRef const& ref, TBranch* branch, size_t branchIdx, DeferredJobs deferred)
     {
       auto data = context.get<value_type>(ref);
-      if (!runCallback(branch, data, ref)) {
-        mStore[branchIdx] = data;
-        branch->Fill();
-      }
+      runSpectator(data, ref);
+      commit(deferred, [this, data, ref, branch, branchIdx]() {
+        if (!runFill(branch, data, ref)) {
+          mStore[branchIdx] = data;
+          branch->Fill();
+        }
+      });
     }
 
     // specialization for non-messageable types with ROOT dictionary
     // for non-trivial structs, the address of the pointer to the objects needs to be used
     // in order to directly use the pointer to extracted object
-    // store is a pointer to object
     template <typename S, typename std::enable_if_t<std::is_same<S, ROOTTypeSpecialization>::value, int> = 0>
-    void fillData(InputContext& context, DataRef const& ref, TBranch* branch, size_t branchIdx)
+    void fillData(InputContext& context, DataRef const& ref, TBranch* branch, size_t branchIdx, DeferredJobs deferred)
     {
-      auto data = context.get<typename std::add_pointer<value_type>::type>(ref);
-      if (!runCallback(branch, *data, ref)) {
-        // this is ugly but necessary because of the TTree API does not allow a const
-        // object as input. Have to rely on that ROOT treats the object as const
-        mStore[branchIdx] = const_cast<value_type*>(data.get());
-        branch->Fill();
-      }
+      commitObject(deferred, context.get<typename std::add_pointer<value_type>::type>(ref), ref, branch, branchIdx);
     }
 
     // specialization for binary buffers using const char*
     // this writes both the data branch and a size branch
     template <typename S, typename std::enable_if_t<std::is_same<S, BinaryBranchSpecialization>::value, int> = 0>
-    void fillData(InputContext& context, DataRef const& ref, TBranch* branch, size_t branchIdx)
+    void fillData(InputContext& context, DataRef const& ref, TBranch* branch, size_t branchIdx, DeferredJobs deferred)
     {
       auto data = context.get<gsl::span<char>>(ref);
-      std::get<2>(mStore.at(branchIdx)) = data.size();
-      std::get<1>(mStore.at(branchIdx))->Fill();
-      std::get<0>(mStore.at(branchIdx)).resize(data.size());
-      memcpy(std::get<0>(mStore.at(branchIdx)).data(), data.data(), data.size());
-      branch->Fill();
+      if (deferred == nullptr) {
+        std::get<2>(mStore.at(branchIdx)) = data.size();
+        std::get<1>(mStore.at(branchIdx))->Fill();
+        std::get<0>(mStore.at(branchIdx)).resize(data.size());
+        memcpy(std::get<0>(mStore.at(branchIdx)).data(), data.data(), data.size());
+        branch->Fill();
+        return;
+      }
+      commit(deferred, [this, branch, branchIdx, buffer = std::vector<char>(data.begin(), data.end())]() mutable {
+        std::get<2>(mStore.at(branchIdx)) = buffer.size();
+        std::get<1>(mStore.at(branchIdx))->Fill();
+        std::get<0>(mStore.at(branchIdx)).swap(buffer);
+        branch->Fill();
+      });
     }
 
     // specialization for vectors of messageable types
     template <typename S, typename std::enable_if_t<std::is_same<S, MessageableVectorSpecialization>::value, int> = 0>
-    void fillData(InputContext& context, DataRef const& ref, TBranch* branch, size_t branchIdx)
+    void fillData(InputContext& context, DataRef const& ref, TBranch* branch, size_t branchIdx, DeferredJobs deferred)
     {
       using ElementType = typename value_type::value_type;
       static_assert(is_messageable<ElementType>::value, "logical error: should be correctly selected by StructureElementTypeTrait");
@@ -723,10 +846,16 @@ class RootTreeWriter
         // try extracting from message with serialization method NONE, throw runtime error
         // if message is serialized
         auto data = context.get<gsl::span<ElementType>>(ref);
+        if (deferred) {
+          // the message is released after processing, the deferred filling needs a copy
+          commitObject(deferred, std::make_shared<value_type>(data.begin(), data.end()), ref, branch, branchIdx);
+          return;
+        }
         // take an ordinary std::vector "view" on the data
         auto* dataview = new value_type;
         adopt(data, *dataview);
-        if (!runCallback(branch, *dataview, ref)) {
+        runSpectator(*dataview, ref);
+        if (!runFill(branch, *dataview, ref)) {
           mStore[branchIdx] = dataview;
           branch->Fill();
         }
@@ -738,11 +867,7 @@ class RootTreeWriter
       } catch (RuntimeErrorRef e) {
         if constexpr (has_root_dictionary<value_type>::value == true) {
           // try extracting from message with serialization method ROOT
-          auto data = context.get<typename std::add_pointer<value_type>::type>(ref);
-          if (!runCallback(branch, *data, ref)) {
-            mStore[branchIdx] = const_cast<value_type*>(data.get());
-            branch->Fill();
-          }
+          commitObject(deferred, context.get<typename std::add_pointer<value_type>::type>(ref), ref, branch, branchIdx);
         } else {
           // the type has no ROOT dictionary, re-throw exception
           throw e;
@@ -751,11 +876,11 @@ class RootTreeWriter
     }
 
     // process previous stage and this stage
-    void process(InputContext& context, std::vector<BranchSpec>& specs)
+    void process(InputContext& context, std::vector<BranchSpec>& specs, DeferredJobs deferred)
     {
       // recursing through the tree structure by simply using method of the previous type,
       // i.e. the base class method.
-      PrevT::process(context, specs);
+      PrevT::process(context, specs, deferred);
       constexpr size_t SpecIndex = STAGE - 1;
       BranchSpec const& spec = specs[SpecIndex];
       if (spec.branches.size() == 0) {
@@ -776,7 +901,7 @@ class RootTreeWriter
               continue;
             }
           }
-          fillData<specialization_id>(context, dataref, spec.branches.at(branchIdx), branchIdx);
+          fillData<specialization_id>(context, dataref, spec.branches.at(branchIdx), branchIdx, deferred);
         }
       }
     }
@@ -893,6 +1018,47 @@ class RootTreeWriter
     return std::make_unique<T>();
   }
 
+  /// queue a job for the background thread, blocks while the queue is full
+  /// an error of a previous job is rethrown here
+  void enqueue(Job&& job)
+  {
+    std::unique_lock<std::mutex> lock(mQueueMutex);
+    mQueueCondition.wait(lock, [this]() { return mQueue.size() < mQueueSize || mWorkerError; });
+    if (mWorkerError) {
+      std::rethrow_exception(mWorkerError);
+    }
+    mQueue.emplace_back(std::move(job));
+    lock.unlock();
+    mQueueCondition.notify_all();
+  }
+
+  /// the background thread, all operations on the tree are done here
+  /// until the writer is closed
+  void runWorker()
+  {
+    while (true) {
+      std::unique_lock<std::mutex> lock(mQueueMutex);
+      mQueueCondition.wait(lock, [this]() { return mQueue.size() || mStopWorker; });
+      if (mQueue.empty()) {
+        return;
+      }
+      auto job = std::move(mQueue.front());
+      mQueue.pop_front();
+      lock.unlock();
+      mQueueCondition.notify_all();
+      try {
+        job();
+      } catch (...) {
+        lock.lock();
+        mWorkerError = std::current_exception();
+        mQueue.clear();
+        lock.unlock();
+        mQueueCondition.notify_all();
+        return;
+      }
+    }
+  }
+
   /// the output file
   std::unique_ptr<TFile> mFile;
   /// the output tree
@@ -905,6 +1071,16 @@ class RootTreeWriter
   bool mIsClosed = false;
   /// custom close handler, optional
   CustomClose mCustomClose;
+  /// maximum number of queued input sets, 0 for synchronous writing
+  size_t mQueueSize = 0;
+  /// the queued input sets and autosave requests
+  std::deque<Job> mQueue;
+  std::mutex mQueueMutex;
+  std::condition_variable mQueueCondition;
+  bool mStopWorker = false;
+  /// the first error in the background thread
+  std::exception_ptr mWorkerError;
+  std::thread mWorker;
 };
 
 } // namespace framework
@@ -97,7 +97,19 @@ static void BM_DPLRawPageSequencerForward(benchmark::State& state)
   }
 }
 
+static void BM_DPLRawPageSequencerIndex(benchmark::State& state)
+{
+  std::vector<raw_parser::RawPageInfo> pages;
+  auto dataset = createData(state.range(0));
+  for (auto _ : state) {
+    pages.clear();
+    DPLRawPageSequencer(dataset.record).index(pages);
+    DPLRawPageSequencer::sortByLink(pages);
+  }
+}
+
 BENCHMARK(BM_DPLRawPageSequencerBinary)->Arg(64)->Arg(512)->Arg(1024);
 BENCHMARK(BM_DPLRawPageSequencerForward)->Arg(64)->Arg(512)->Arg(1024);
+BENCHMARK(BM_DPLRawPageSequencerIndex)->Arg(64)->Arg(512)->Arg(1024);
 
 BENCHMARK_MAIN();
@@ -11,6 +11,7 @@
 #include <benchmark/benchmark.h>
 
 #include "DPLUtils/RawParser.h"
+#include <vector>
 
 using namespace o2::framework;
 
@@ -89,7 +90,25 @@ static void BM_RawParserV4(benchmark::State& state)
   }
 }
 
+static void BM_RawParserIndex(benchmark::State& state)
+{
+  size_t nofPages = state.range(0);
+  if (nofPages > TestPages::MaxNPages) {
+    return;
+  }
+  using Parser = RawParser<TestPages::PageSize>;
+  Parser parser(reinterpret_cast<const char*>(gPages.data()), nofPages * TestPages::PageSize);
+  std::vector<raw_parser::RawPageInfo> pages;
+  pages.reserve(nofPages);
+  for (auto _ : state) {
+    pages.clear();
+    parser.index(pages);
+    benchmark::DoNotOptimize(pages.data());
+  }
+}
+
 BENCHMARK(BM_RawParserV4)->Arg(1)->Arg(8)->Arg(256)->Arg(1024)->Arg(16 * 1024)->Arg(256 * 1024);
 BENCHMARK(BM_RawParserAuto)->Arg(1)->Arg(8)->Arg(256)->Arg(1024)->Arg(16 * 1024)->Arg(256 * 1024);
+BENCHMARK(BM_RawParserIndex)->Arg(1)->Arg(8)->Arg(256)->Arg(1024)->Arg(16 * 1024)->Arg(256 * 1024);
 
 BENCHMARK_MAIN();
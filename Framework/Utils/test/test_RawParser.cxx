@@ -11,6 +11,7 @@
 
 #include <catch_amalgamated.hpp>
 #include "DPLUtils/RawParser.h"
+#include <vector>
 
 namespace o2::framework
 {
@@ -82,4 +83,30 @@ TEMPLATE_TEST_CASE("test_RawParser", "[RDH][template]", V5, V6, V7)
   }
 }
 
+TEMPLATE_TEST_CASE("test_RawParserIndex", "[RDH][template]", V5, V6, V7)
+{
+  constexpr size_t NofPages = 4;
+  std::array<unsigned char, NofPages * PageSize> buffer;
+  fillPages<TestType>(buffer);
+  for (int pageNo = 0; pageNo < NofPages; pageNo++) {
+    auto* rdh = reinterpret_cast<TestType*>(buffer.data() + pageNo * PageSize);
+    rdh->feeId = pageNo % 2;
+    rdh->orbit = 100 + pageNo;
+    rdh->bunchCrossing = 10 * pageNo;
+  }
+
+  std::vector<raw_parser::RawPageInfo> pages;
+  RawParser(buffer.data(), buffer.size()).index(pages, 42);
+  REQUIRE(pages.size() == NofPages);
+  for (int pageNo = 0; pageNo < NofPages; pageNo++) {
+    auto const& info = pages[pageNo];
+    REQUIRE(info.page == reinterpret_cast<const char*>(buffer.data() + pageNo * PageSize));
+    REQUIRE(info.size == PageSize);
+    REQUIRE(info.subSpec == 42);
+    REQUIRE(info.feeId == pageNo % 2);
+    REQUIRE(info.orbit == 100 + pageNo);
+    REQUIRE(info.bc == 10 * pageNo);
+  }
+}
+
 } // namespace o2::framework
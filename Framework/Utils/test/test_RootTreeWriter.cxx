@@ -247,6 +247,63 @@ TEST_CASE("test_RootTreeWriter")
             BranchContent<decltype(trivvec)>{"srlzdvecbranch", trivvec});
 }
 
+TEST_CASE("test_RootTreeWriterAsync")
+{
+  std::string filename = "test_RootTreeWriterAsync.root";
+  const char* treename = "testtree";
+
+  int spectated = 0;
+  auto spectator = [&spectated](std::vector<int> const& data) { spectated += data.size(); };
+  RootTreeWriter writer(nullptr, nullptr,
+                        RootTreeWriter::BranchDef<int>{"input1", "intbranch"},
+                        RootTreeWriter::BranchDef<std::vector<int>>{"input2", "intvecbranch", spectator});
+  writer.setAsync(1);
+  writer.init(filename.c_str(), treename);
+
+  auto transport = fair::mq::TransportFactory::CreateTransportFactory("zeromq");
+  std::vector<fair::mq::MessagePtr> store;
+  auto createMessage = [&transport, &store](DataHeader&& dh, void const* data, size_t size) {
+    dh.payloadSize = size;
+    dh.payloadSerializationMethod = o2::header::gSerializationMethodNone;
+    DataProcessingHeader dph{0, 1};
+    o2::header::Stack stack{dh, dph};
+    fair::mq::MessagePtr header = transport->CreateMessage(stack.size());
+    fair::mq::MessagePtr payload = transport->CreateMessage(size);
+    memcpy(header->GetData(), stack.data(), stack.size());
+    memcpy(payload->GetData(), data, size);
+    store.emplace_back(std::move(header));
+    store.emplace_back(std::move(payload));
+  };
+
+  int a = 23;
+  std::vector<int> intvec{10, 21, 42};
+  createMessage(o2::header::DataHeader{"INT", "TST", 0}, &a, sizeof(a));
+  createMessage(o2::header::DataHeader{"FDMTLVEC", "TST", 0}, intvec.data(), intvec.size() * sizeof(int));
+
+  std::vector<InputRoute> schema = {
+    {InputSpec{"input1", "TST", "INT"}, 0, "input1", 0},
+    {InputSpec{"input2", "TST", "FDMTLVEC"}, 1, "input2", 0},
+  };
+  auto getter = [&store](size_t i) -> DataRef {
+    return DataRef{nullptr, static_cast<char const*>(store[2 * i]->GetData()), static_cast<char const*>(store[2 * i + 1]->GetData())};
+  };
+  InputSpan span{getter, store.size() / 2};
+  ServiceRegistry registry;
+  InputRecord inputs{schema, span, registry};
+
+  writer(inputs);
+  // the spectator is invoked during processing
+  CHECK(spectated == 3);
+  // the messages can be released right after processing
+  memset(store[1]->GetData(), 0, sizeof(a));
+  memset(store[3]->GetData(), 0, intvec.size() * sizeof(int));
+  writer.close();
+
+  checkTree(filename.c_str(), treename,
+            BranchContent<decltype(a)>{"intbranch", a},
+            BranchContent<decltype(intvec)>{"intvecbranch", intvec});
+}
+
 template <typename T>
 using BranchDefinition = MakeRootTreeWriterSpec::BranchDefinition<T>;
 
@@ -363,6 +363,10 @@ int GPUReconstruction::InitPhaseBeforeDevice()
     GPUError("Must use double pipeline mode only with exactly one chain that must support it");
     return 1;
   }
+  if (mProcessingSettings.doublePipeline && mProcessingSettings.doublePipelineDepth < 2) {
+    GPUError("Invalid double pipeline depth %d, must be at least 2", (int)mProcessingSettings.doublePipelineDepth);
+    return 1;
+  }
 
   if (mMaster == nullptr && mProcessingSettings.doublePipeline) {
     mPipelineContext.reset(new GPUReconstructionPipelineContext);
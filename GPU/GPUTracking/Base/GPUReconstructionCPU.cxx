@@ -32,6 +32,8 @@
 #include "GPUConstantMem.h"
 #include "GPUMemorySizeScalers.h"
 #include <atomic>
+#include <algorithm>
+#include <cstdio>
 
 #define GPUCA_LOGGING_PRINTF
 #include "GPULogging.h"
@@ -72,6 +74,13 @@ inline int GPUReconstructionCPUBackend::runKernelBackendInternal(const krnlSetup
     throw std::runtime_error("Cannot run device kernel on host with nThreads != 1");
   }
   unsigned int num = y.num == 0 || y.num == -1 ? 1 : y.num;
+  krnlOmpSetup ompSetup;
+  if (mKernelOmpSetup.size()) {
+    auto it = mKernelOmpSetup.find(GPUReconstructionCPU::GetKernelName<T, I>());
+    if (it != mKernelOmpSetup.end()) {
+      ompSetup = it->second;
+    }
+  }
   for (unsigned int k = 0; k < num; k++) {
     int ompThreads = 0;
     if (mProcessingSettings.ompKernels == 2) {
@@ -83,14 +92,25 @@ inline int GPUReconstructionCPUBackend::runKernelBackendInternal(const krnlSetup
     } else {
       ompThreads = mProcessingSettings.ompKernels ? mProcessingSettings.ompThreads : 1;
     }
+    if (ompSetup.nThreads) {
+      ompThreads = std::min(ompThreads, ompSetup.nThreads);
+    }
     if (ompThreads > 1) {
       if (mProcessingSettings.debugLevel >= 5) {
         printf("Running %d ompThreads\n", ompThreads);
       }
-      GPUCA_OPENMP(parallel for num_threads(ompThreads))
-      for (unsigned int iB = 0; iB < x.nBlocks; iB++) {
-        typename T::GPUSharedMemory smem;
-        T::template Thread<I>(x.nBlocks, 1, iB, 0, smem, T::Processor(*mHostConstantMem)[y.start + k], args...);
+      if (ompSetup.chunk) {
+        GPUCA_OPENMP(parallel for num_threads(ompThreads) schedule(dynamic, ompSetup.chunk))
+        for (unsigned int iB = 0; iB < x.nBlocks; iB++) {
+          typename T::GPUSharedMemory smem;
+          T::template Thread<I>(x.nBlocks, 1, iB, 0, smem, T::Processor(*mHostConstantMem)[y.start + k], args...);
+        }
+      } else {
+        GPUCA_OPENMP(parallel for num_threads(ompThreads))
+        for (unsigned int iB = 0; iB < x.nBlocks; iB++) {
+          typename T::GPUSharedMemory smem;
+          T::template Thread<I>(x.nBlocks, 1, iB, 0, smem, T::Processor(*mHostConstantMem)[y.start + k], args...);
+        }
       }
     } else {
       for (unsigned int iB = 0; iB < x.nBlocks; iB++) {
@@ -191,11 +211,52 @@ int GPUReconstructionCPU::InitDevice()
   if (mProcessingSettings.ompKernels) {
     mBlockCount = getOMPMaxThreads();
   }
+  if (ParseKernelOmpSetup()) {
+    return 1;
+  }
   mThreadId = GetThread();
   mProcShadow.mProcessorsProc = processors();
   return 0;
 }
 
+int GPUReconstructionCPU::ParseKernelOmpSetup()
+{
+  mKernelOmpSetup.clear();
+  if (mProcessingSettings.ompKernelThreads.empty()) {
+    return 0;
+  }
+  static const std::vector<std::string> kernelNames = {
+#define GPUCA_KRNL(x_class, ...) GetKernelName<GPUCA_M_KRNL_TEMPLATE(x_class)>(),
+#include "GPUReconstructionKernelList.h"
+#undef GPUCA_KRNL
+  };
+  const std::string& config = mProcessingSettings.ompKernelThreads;
+  for (size_t pos = 0; pos < config.size();) {
+    size_t end = config.find(',', pos);
+    if (end == std::string::npos) {
+      end = config.size();
+    }
+    std::string entry = config.substr(pos, end - pos);
+    pos = end + 1;
+    size_t sep = entry.find(':');
+    krnlOmpSetup setup;
+    if (sep == std::string::npos || sscanf(entry.c_str() + sep + 1, "%d:%d", &setup.nThreads, &setup.chunk) < 1 || setup.nThreads < 0 || setup.chunk < 0) {
+      GPUError("Invalid OMP kernel setup %s, expected <kernel>:<max threads>[:<chunk size>]", entry.c_str());
+      return 1;
+    }
+    std::string name = entry.substr(0, sep);
+    if (std::find(kernelNames.begin(), kernelNames.end(), name) == kernelNames.end()) {
+      GPUError("Invalid OMP kernel setup %s, unknown kernel %s", entry.c_str(), name.c_str());
+      return 1;
+    }
+    mKernelOmpSetup[name] = setup;
+    if (mProcessingSettings.debugLevel >= 2) {
+      GPUInfo("OMP setup of kernel %s: max threads %d, chunk size %d", name.c_str(), setup.nThreads, setup.chunk);
+    }
+  }
+  return 0;
+}
+
 int GPUReconstructionCPU::ExitDevice()
 {
   if (mProcessingSettings.memoryAllocationStrategy == GPUMemoryResource::ALLOCATION_GLOBAL) {
@@ -20,6 +20,8 @@
 #include "GPUConstantMem.h"
 #include <stdexcept>
 #include "utils/timer.h"
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "GPUGeneralKernels.h"
@@ -47,6 +49,12 @@ class GPUReconstructionCPUBackend : public GPUReconstruction
   unsigned int mNestedLoopOmpFactor = 1;
   static int getOMPThreadNum();
   static int getOMPMaxThreads();
+
+  struct krnlOmpSetup {
+    int nThreads = 0; // Maximum number of OMP threads, 0 = no limit
+    int chunk = 0;    // Chunk size for dynamic scheduling of the blocks, 0 = static scheduling
+  };
+  std::unordered_map<std::string, krnlOmpSetup> mKernelOmpSetup; // From GPUSettingsProcessing::ompKernelThreads, by kernel name
 };
 
 class GPUReconstructionCPU : public GPUReconstructionKernels<GPUReconstructionCPUBackend>
@@ -137,6 +145,7 @@ class GPUReconstructionCPU : public GPUReconstructionKernels<GPUReconstructionCP
   virtual size_t TransferMemoryInternal(GPUMemoryResource* res, int stream, deviceEvent* ev, deviceEvent* evList, int nEvents, bool toGPU, const void* src, void* dst);
 
   int InitDevice() override;
+  int ParseKernelOmpSetup();
   int ExitDevice() override;
   int GetThread();
 
@@ -219,6 +219,8 @@ struct zsEncoder {
   unsigned int pageCounter = 0;
   void ZSfillEmpty(void* ptr, int shift, unsigned int feeId, int orbit, int linkid);
   static void ZSstreamOut(unsigned short* bufIn, unsigned int& lenIn, unsigned char* bufOut, unsigned int& lenOut, unsigned int nBits);
+  template <unsigned int NBITS>
+  static unsigned int ZSstreamOutGroups(const unsigned short* bufIn, unsigned int nGroups, unsigned char* bufOut);
   long int getHbf(long int timestamp) { return (timestamp * LHCBCPERTIMEBIN + bcShiftInFirstHBF) / o2::constants::lhc::LHCMaxBunches; }
 };
 
@@ -236,11 +238,35 @@ inline void zsEncoder::ZSfillEmpty(void* ptr, int shift, unsigned int feeId, int
   o2::raw::RDHUtils::setPageCounter(*rdh, pageCounter++);
 }
 
+template <unsigned int NBITS>
+inline unsigned int zsEncoder::ZSstreamOutGroups(const unsigned short* bufIn, unsigned int nGroups, unsigned char* bufOut)
+{
+  // Groups of 4 samples end on a byte boundary for 10 and 12 bits, and can be packed independently of each other through a 64 bit word
+  constexpr unsigned long mask = (1 << NBITS) - 1;
+  constexpr unsigned int nBytes = 4 * NBITS / 8;
+  for (unsigned int i = 0; i < nGroups; i++) {
+    const unsigned short* in = bufIn + 4 * i;
+    const unsigned long word = (in[0] & mask) | ((in[1] & mask) << NBITS) | ((in[2] & mask) << (2 * NBITS)) | ((in[3] & mask) << (3 * NBITS));
+    for (unsigned int j = 0; j < nBytes; j++) {
+      bufOut[nBytes * i + j] = (unsigned char)(word >> (8 * j));
+    }
+  }
+  return nGroups * nBytes;
+}
+
 inline void zsEncoder::ZSstreamOut(unsigned short* bufIn, unsigned int& lenIn, unsigned char* bufOut, unsigned int& lenOut, unsigned int nBits)
 {
   unsigned int byte = 0, bits = 0;
   unsigned int mask = (1 << nBits) - 1;
-  for (unsigned int i = 0; i < lenIn; i++) {
+  unsigned int i = 0;
+  if (nBits == 10) {
+    lenOut += ZSstreamOutGroups<10>(bufIn, lenIn / 4, bufOut + lenOut);
+    i = lenIn / 4 * 4;
+  } else if (nBits == 12) {
+    lenOut += ZSstreamOutGroups<12>(bufIn, lenIn / 4, bufOut + lenOut);
+    i = lenIn / 4 * 4;
+  }
+  for (; i < lenIn; i++) {
     byte |= (bufIn[i] & mask) << bits;
     bits += nBits;
     while (bits >= 8) {
@@ -284,6 +310,7 @@ struct zsEncoderRow : public zsEncoder {
   unsigned int encodeSequence(std::vector<o2::tpc::Digit>& tmpBuffer, unsigned int k);
 
   bool sort(const o2::tpc::Digit a, const o2::tpc::Digit b);
+  void sortInput(std::vector<o2::tpc::Digit>& tmpBuffer) { std::sort(tmpBuffer.begin(), tmpBuffer.end(), [this](const o2::tpc::Digit a, const o2::tpc::Digit b) { return sort(a, b); }); }
   void decodePage(std::vector<o2::tpc::Digit>& outputBuffer, const zsPage* page, unsigned int endpoint, unsigned int firstOrbit, unsigned int triggerBC = 0);
 };
 
@@ -484,9 +511,15 @@ struct zsEncoderLinkBased : public zsEncoder {
   std::vector<unsigned short> adcValues = {};
   std::bitset<80> bitmask = {};
 
+  struct padLink {
+    unsigned char endpoint, link, channel;
+  };
+  std::vector<padLink> padLinks; // endpoint, FEC in partition and channel of all pads of the sector, by global pad number
+
+  const padLink& getPadLink(const o2::tpc::Digit& a) const { return padLinks[Mapper::instance().globalPadNumber(o2::tpc::PadPos(a.getRow(), a.getPad()))]; }
   void createBitmask(std::vector<o2::tpc::Digit>& tmpBuffer, unsigned int k);
   void init();
-  bool sort(const o2::tpc::Digit a, const o2::tpc::Digit b);
+  void sortInput(std::vector<o2::tpc::Digit>& tmpBuffer);
 };
 
 void zsEncoderLinkBased::init()
@@ -516,65 +549,60 @@ void zsEncoderLinkBased::init()
       }
     }
   }
+  const auto& mapper = Mapper::instance();
+  padLinks.resize(Mapper::getPadsInSector());
+  for (int row = 0; row < GPUCA_ROW_COUNT; row++) {
+    int cruinsector = param->tpcGeometry.GetRegion(row);
+    o2::tpc::CRU cru = cruinsector;
+    const auto& partition = mapper.getPartitionInfo(cru.partition());
+    for (int pad = 0; pad < mapper.getNumberOfPadsInRowSector(row); pad++) {
+      o2::tpc::GlobalPadNumber globalPad = mapper.globalPadNumber(o2::tpc::PadPos(row, pad));
+      o2::tpc::FECInfo fec = mapper.fecInfo(globalPad);
+      int fecInPartition = fec.getIndex() - partition.getSectorFECOffset();
+      auto& lnk = padLinks[globalPad];
+      lnk.endpoint = 2 * cruinsector + (fecInPartition >= (partition.getNumberOfFECs() + 1) / 2);
+      lnk.link = fecInPartition;
+      lnk.channel = inverseChannelMapping[fec.getSampaChip()][fec.getSampaChannel()];
+    }
+  }
 }
 
 void zsEncoderLinkBased::createBitmask(std::vector<o2::tpc::Digit>& tmpBuffer, unsigned int k)
 {
-  const auto& mapper = Mapper::instance();
   nSamples = 0;
   adcValues.clear();
   bitmask.reset();
   unsigned int l;
   for (l = k; l < tmpBuffer.size(); l++) {
     const auto& a = tmpBuffer[l];
-    int cruinsector = param->tpcGeometry.GetRegion(a.getRow());
-    o2::tpc::GlobalPadNumber pad = mapper.globalPadNumber(o2::tpc::PadPos(a.getRow(), a.getPad()));
-    o2::tpc::FECInfo fec = mapper.fecInfo(pad);
-    o2::tpc::CRU cru = cruinsector;
-    int fecInPartition = fec.getIndex() - mapper.getPartitionInfo(cru.partition()).getSectorFECOffset();
-    int tmpEndpoint = 2 * cruinsector + (fecInPartition >= (mapper.getPartitionInfo(cru.partition()).getNumberOfFECs() + 1) / 2);
+    const auto& lnk = getPadLink(a);
     if (l == k) {
-      link = fecInPartition;
-      endpoint = tmpEndpoint;
-    } else if (endpoint != tmpEndpoint || link != fecInPartition || tmpBuffer[l].getTimeStamp() != tmpBuffer[k].getTimeStamp()) {
+      link = lnk.link;
+      endpoint = lnk.endpoint;
+    } else if (endpoint != lnk.endpoint || link != lnk.link || tmpBuffer[l].getTimeStamp() != tmpBuffer[k].getTimeStamp()) {
       break;
     }
-    int channel = inverseChannelMapping[fec.getSampaChip()][fec.getSampaChannel()];
-    bitmask[channel] = 1;
+    bitmask[lnk.channel] = 1;
     adcValues.emplace_back((unsigned short)(a.getChargeFloat() * encodeBitsFactor + 0.5f));
   }
   nSamples = l - k;
 }
 
-bool zsEncoderLinkBased::sort(const o2::tpc::Digit a, const o2::tpc::Digit b)
+void zsEncoderLinkBased::sortInput(std::vector<o2::tpc::Digit>& tmpBuffer)
 {
-  // Fixme: this is blasphemy... one shoult precompute all values and sort an index array
-  int cruinsectora = param->tpcGeometry.GetRegion(a.getRow());
-  int cruinsectorb = param->tpcGeometry.GetRegion(b.getRow());
-  if (cruinsectora != cruinsectorb) {
-    return cruinsectora < cruinsectorb;
-  }
-  const auto& mapper = Mapper::instance();
-  o2::tpc::GlobalPadNumber pada = mapper.globalPadNumber(o2::tpc::PadPos(a.getRow(), a.getPad()));
-  o2::tpc::GlobalPadNumber padb = mapper.globalPadNumber(o2::tpc::PadPos(b.getRow(), b.getPad()));
-  o2::tpc::FECInfo feca = mapper.fecInfo(pada);
-  o2::tpc::FECInfo fecb = mapper.fecInfo(padb);
-  o2::tpc::CRU cru = cruinsectora;
-  int fecInPartitiona = feca.getIndex() - mapper.getPartitionInfo(cru.partition()).getSectorFECOffset();
-  int fecInPartitionb = fecb.getIndex() - mapper.getPartitionInfo(cru.partition()).getSectorFECOffset();
-
-  int endpointa = 2 * cruinsectora + (fecInPartitiona >= (mapper.getPartitionInfo(cru.partition()).getNumberOfFECs() + 1) / 2);
-  int endpointb = 2 * cruinsectorb + (fecInPartitionb >= (mapper.getPartitionInfo(cru.partition()).getNumberOfFECs() + 1) / 2);
-  if (endpointa != endpointb) {
-    return endpointa < endpointb;
-  }
-  if (a.getTimeStamp() != b.getTimeStamp()) {
-    return a.getTimeStamp() < b.getTimeStamp();
-  }
-  if (fecInPartitiona != fecInPartitionb) {
-    return fecInPartitiona < fecInPartitionb;
-  }
-  return inverseChannelMapping[feca.getSampaChip()][feca.getSampaChannel()] < inverseChannelMapping[fecb.getSampaChip()][fecb.getSampaChannel()];
+  // Order by endpoint, time bin, FEC and channel: the sort is done on precomputed keys, the time bin being offset to keep the signed order
+  std::vector<std::pair<unsigned long, unsigned int>> keys(tmpBuffer.size());
+  for (unsigned int i = 0; i < tmpBuffer.size(); i++) {
+    const auto& lnk = getPadLink(tmpBuffer[i]);
+    const unsigned int time = (unsigned int)tmpBuffer[i].getTimeStamp() ^ 0x80000000u;
+    keys[i] = {((unsigned long)lnk.endpoint << 48) | ((unsigned long)time << 16) | ((unsigned long)lnk.link << 8) | lnk.channel, i};
+  }
+  std::sort(keys.begin(), keys.end());
+  std::vector<o2::tpc::Digit> sorted(tmpBuffer.size());
+  for (unsigned int i = 0; i < keys.size(); i++) {
+    sorted[i] = tmpBuffer[keys[i].second];
+  }
+  tmpBuffer.swap(sorted);
 }
 
 // ------------------------------------------------- TPC Improved Link Based ZS -------------------------------------------------
@@ -1097,7 +1125,7 @@ struct zsEncoderRun : public T {
   using T::pagePtr;
   using T::param;
   using T::raw;
-  using T::sort;
+  using T::sortInput;
   using T::writeSubPage;
   using T::ZSfillEmpty;
   using T::zsVersion;
@@ -1119,7 +1147,7 @@ inline unsigned int zsEncoderRun<T>::run(std::vector<zsPage>* buffer, std::vecto
   (void)(rawcru + rawendpoint); // avoid compiler warning
   encodeBitsFactor = (1 << (encodeBits - 10));
 
-  std::sort(tmpBuffer.begin(), tmpBuffer.end(), [this](const o2::tpc::Digit a, const o2::tpc::Digit b) { return sort(a, b); });
+  sortInput(tmpBuffer);
   for (unsigned int k = 0; k <= tmpBuffer.size();) {
     bool mustWritePage = false, mustWriteSubPage = false;
     if (needAnotherPage) {
@@ -1395,8 +1423,18 @@ void GPUReconstructionConvert::RunZSEncoder(const S& in, std::unique_ptr<unsigne
 
   if (outBuffer) {
     outBuffer->reset(new unsigned long long int[totalPages * TPCZSHDR::TPC_ZS_PAGE_SIZE / sizeof(unsigned long long int)]);
-    unsigned long long int offset = 0;
+    unsigned long long int offsets[NSLICES] = {0};
+    for (unsigned int i = 1; i < NSLICES; i++) {
+      offsets[i] = offsets[i - 1];
+      for (unsigned int j = 0; j < GPUTrackingInOutZS::NENDPOINTS; j++) {
+        offsets[i] += buffer[i - 1][j].size() * TPCZSHDR::TPC_ZS_PAGE_SIZE;
+      }
+    }
+    // clang-format off
+    GPUCA_OPENMP(parallel for)
+    // clang-format on
     for (unsigned int i = 0; i < NSLICES; i++) {
+      unsigned long long int offset = offsets[i];
       for (unsigned int j = 0; j < GPUTrackingInOutZS::NENDPOINTS; j++) {
         memcpy((char*)outBuffer->get() + offset, buffer[i][j].data(), buffer[i][j].size() * TPCZSHDR::TPC_ZS_PAGE_SIZE);
         offset += buffer[i][j].size() * TPCZSHDR::TPC_ZS_PAGE_SIZE;
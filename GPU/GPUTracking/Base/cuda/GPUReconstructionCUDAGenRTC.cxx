@@ -66,6 +66,7 @@ int GPUReconstructionCUDA::genRTC(std::string& filename, unsigned int& nCompile)
   nCompile = mProcessingSettings.rtc.compilePerKernel ? kernels.size() : 1;
   bool cacheLoaded = false;
   int fd = 0;
+  std::string cacheFile;
   if (mProcessingSettings.rtc.cacheOutput) {
     if (mProcessingSettings.RTCcacheFolder != ".") {
       std::filesystem::create_directories(mProcessingSettings.RTCcacheFolder);
@@ -73,6 +74,16 @@ int GPUReconstructionCUDA::genRTC(std::string& filename, unsigned int& nCompile)
 #ifndef GPUCA_HAVE_O2HEADERS
     throw std::runtime_error("Cannot use RTC cache without O2 headers");
 #else
+    // With one file per parameter set, devices processing runs with different settings (e.g. field polarities) do not evict each others cache
+    cacheFile = mProcessingSettings.RTCcacheFolder + "/rtc.cuda";
+    if (mProcessingSettings.rtc.cachePerParam) {
+      char shaparamhex[17];
+      for (unsigned int i = 0; i < 8; i++) {
+        snprintf(shaparamhex + 2 * i, 3, "%02x", (unsigned char)shaparam[i]);
+      }
+      cacheFile += std::string(".") + shaparamhex;
+    }
+    cacheFile += ".cache";
     if (mProcessingSettings.rtc.cacheMutex) {
       mode_t mask = S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH;
       fd = open((mProcessingSettings.RTCcacheFolder + "/cache.lock").c_str(), O_RDWR | O_CREAT | O_CLOEXEC, mask);
@@ -85,7 +96,7 @@ int GPUReconstructionCUDA::genRTC(std::string& filename, unsigned int& nCompile)
       }
     }
 
-    FILE* fp = fopen((mProcessingSettings.RTCcacheFolder + "/rtc.cuda.cache").c_str(), "rb");
+    FILE* fp = fopen(cacheFile.c_str(), "rb");
     char sharead[20];
     if (fp) {
       size_t len;
@@ -204,7 +215,9 @@ int GPUReconstructionCUDA::genRTC(std::string& filename, unsigned int& nCompile)
     }
 #ifdef GPUCA_HAVE_O2HEADERS
     if (mProcessingSettings.rtc.cacheOutput) {
-      FILE* fp = fopen((mProcessingSettings.RTCcacheFolder + "/rtc.cuda.cache").c_str(), "w+b");
+      // Written aside and moved in place, so that devices not using the cache mutex never read a partial file
+      std::string cacheFileTmp = cacheFile + ".tmp." + std::to_string(getpid());
+      FILE* fp = fopen(cacheFileTmp.c_str(), "w+b");
       if (fp == nullptr) {
         throw std::runtime_error("Cannot open cache file for writing");
       }
@@ -239,6 +252,9 @@ int GPUReconstructionCUDA::genRTC(std::string& filename, unsigned int& nCompile)
         }
       }
       fclose(fp);
+      if (rename(cacheFileTmp.c_str(), cacheFile.c_str())) {
+        throw std::runtime_error("Error moving cache file in place");
+      }
     }
 #endif
   }
@@ -32,6 +32,7 @@ GPUdii() void GPUTPCCompressionKernels::Thread<GPUTPCCompressionKernels::step0at
   const o2::tpc::ClusterNativeAccess* GPUrestrict() clusters = ioPtrs.clustersNative;
   GPUTPCCompression& GPUrestrict() compressor = processors.tpcCompressor;
   const GPUParam& GPUrestrict() param = processors.param;
+  const TPCFastTransform* GPUrestrict() transform = (param.rec.tpc.compressionTypeMask & GPUSettings::CompressionTrackModelCorrected) ? processors.calibObjects.fastTransform : nullptr;
 
   char lastLeg = 0;
   int myTrack = 0;
@@ -71,6 +72,9 @@ GPUdii() void GPUTPCCompressionKernels::Thread<GPUTPCCompressionKernels::step0at
       float x = param.tpcGeometry.Row2X(hit.row);
       float y = param.tpcGeometry.LinearPad2Y(hit.slice, hit.row, orgCl.getPad());
       float z = param.tpcGeometry.LinearTime2Z(hit.slice, orgCl.getTime());
+      if (transform) {
+        GPUTPCCompressionTrackModel::CorrectYZ(transform, param, hit.slice, hit.row, y, z);
+      }
       if (nClustersStored) {
         if ((hit.slice < GPUCA_NSLICES) ^ (lastSlice < GPUCA_NSLICES)) {
           break;
@@ -115,9 +119,13 @@ GPUdii() void GPUTPCCompressionKernels::Thread<GPUTPCCompressionKernels::step0at
         }
         c.rowDiffA[cidx] = row;
         c.sliceLegDiffA[cidx] = (hit.leg == lastLeg ? 0 : compressor.NSLICES) + slice;
-        float pad = CAMath::Max(0.f, CAMath::Min((float)param.tpcGeometry.NPads(GPUCA_ROW_COUNT - 1), param.tpcGeometry.LinearY2Pad(hit.slice, hit.row, track.Y())));
+        float predY = track.Y(), predZ = track.Z() + zOffset;
+        if (transform) {
+          GPUTPCCompressionTrackModel::UncorrectYZ(transform, param, hit.slice, hit.row, predY, predZ);
+        }
+        float pad = CAMath::Max(0.f, CAMath::Min((float)param.tpcGeometry.NPads(GPUCA_ROW_COUNT - 1), param.tpcGeometry.LinearY2Pad(hit.slice, hit.row, predY)));
         c.padResA[cidx] = orgCl.padPacked - orgCl.packPad(pad);
-        float time = CAMath::Max(0.f, param.tpcGeometry.LinearZ2Time(hit.slice, track.Z() + zOffset));
+        float time = CAMath::Max(0.f, param.tpcGeometry.LinearZ2Time(hit.slice, predZ));
         c.timeResA[cidx] = (orgCl.getTimePacked() - orgCl.packTime(time)) & 0xFFFFFF;
         lastLeg = hit.leg;
       }
@@ -15,6 +15,7 @@
 #include "GPUTPCCompressionTrackModel.h"
 #include "GPUConstantMem.h"
 #include "GPUParam.inc"
+#include "TPCFastTransform.h"
 
 using namespace GPUCA_NAMESPACE::gpu;
 
@@ -933,3 +934,29 @@ GPUd() void GPUTPCCompressionTrackModel::resetCovariance()
 }
 
 #endif
+
+GPUd() void GPUTPCCompressionTrackModel::CorrectYZ(const TPCFastTransform* GPUrestrict() transform, const GPUParam& GPUrestrict() param, int slice, int row, float& y, float& z)
+{
+  // Shift the nominal position by the difference between the corrected and the ideal transformation, the x shift is neglected
+  const float pad = param.tpcGeometry.LinearY2Pad(slice, row, y);
+  const float time = param.tpcGeometry.LinearZ2Time(slice, z);
+  float xc, yc, zc, xi, yi, zi;
+  transform->Transform(slice, row, pad, time, xc, yc, zc);
+  transform->TransformIdeal(slice, row, pad, time, xi, yi, zi, 0.f);
+  y += yc - yi;
+  z += zc - zi;
+}
+
+GPUd() void GPUTPCCompressionTrackModel::UncorrectYZ(const TPCFastTransform* GPUrestrict() transform, const GPUParam& GPUrestrict() param, int slice, int row, float& y, float& z)
+{
+  // Fixed number of fixed-point iterations, encoder and decoder must obtain bit-identical results
+  float yn = y, zn = z;
+  for (int i = 0; i < 2; i++) {
+    float yc = yn, zc = zn;
+    CorrectYZ(transform, param, slice, row, yc, zc);
+    yn += y - yc;
+    zn += z - zc;
+  }
+  y = yn;
+  z = zn;
+}
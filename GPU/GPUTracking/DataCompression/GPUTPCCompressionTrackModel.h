@@ -38,6 +38,7 @@ namespace GPUCA_NAMESPACE::gpu
 // encoded with the old version!!!
 
 struct GPUParam;
+class TPCFastTransform;
 
 constexpr float MaxSinPhi = 0.999f;
 
@@ -49,6 +50,10 @@ class GPUTPCCompressionTrackModel
   GPUd() int Filter(float y, float z, int iRow);
   GPUd() int Mirror();
 
+  // Conversion between nominal (linear pad / time) and distortion-corrected coordinates, for GPUSettings::CompressionTrackModelCorrected
+  GPUd() static void CorrectYZ(const TPCFastTransform* transform, const GPUParam& param, int slice, int row, float& y, float& z);
+  GPUd() static void UncorrectYZ(const TPCFastTransform* transform, const GPUParam& param, int slice, int row, float& y, float& z);
+
 #if defined(GPUCA_COMPRESSION_TRACK_MODEL_MERGER) || defined(GPUCA_COMPRESSION_TRACK_MODEL_SLICETRACKER)
   GPUd() float X() const
   {
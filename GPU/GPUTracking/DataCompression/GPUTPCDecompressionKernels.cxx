@@ -28,14 +28,15 @@ GPUdii() void GPUTPCDecompressionKernels::Thread<GPUTPCDecompressionKernels::ste
   CompressedClusters& GPUrestrict() cmprClusters = decompressor.mInputGPU;
   const GPUParam& GPUrestrict() param = processors.param;
 
+  const TPCFastTransform* GPUrestrict() transform = (cmprClusters.nComppressionModes & GPUSettings::CompressionTrackModelCorrected) ? processors.calibObjects.fastTransform : nullptr;
   const unsigned int maxTime = (param.par.continuousMaxTimeBin + 1) * ClusterNative::scaleTimePacked - 1;
 
   for (unsigned int i = trackStart + get_global_id(0); i < trackEnd; i += get_global_size(0)) {
-    decompressTrack(cmprClusters, param, maxTime, i, decompressor.mAttachedClustersOffsets[i], decompressor);
+    decompressTrack(cmprClusters, param, transform, maxTime, i, decompressor.mAttachedClustersOffsets[i], decompressor);
   }
 }
 
-GPUdii() void GPUTPCDecompressionKernels::decompressTrack(CompressedClusters& cmprClusters, const GPUParam& param, const unsigned int maxTime, const unsigned int trackIndex, unsigned int clusterOffset, GPUTPCDecompression& decompressor)
+GPUdii() void GPUTPCDecompressionKernels::decompressTrack(CompressedClusters& cmprClusters, const GPUParam& param, const TPCFastTransform* transform, const unsigned int maxTime, const unsigned int trackIndex, unsigned int clusterOffset, GPUTPCDecompression& decompressor)
 {
   float zOffset = 0;
   unsigned int slice = cmprClusters.sliceA[trackIndex];
@@ -73,8 +74,12 @@ GPUdii() void GPUTPCDecompressionKernels::decompressTrack(CompressedClusters& cm
       if (timeTmp & 800000) {
         timeTmp |= 0xFF000000;
       }
-      time = timeTmp + ClusterNative::packTime(CAMath::Max(0.f, param.tpcGeometry.LinearZ2Time(slice, track.Z() + zOffset)));
-      float tmpPad = CAMath::Max(0.f, CAMath::Min((float)param.tpcGeometry.NPads(GPUCA_ROW_COUNT - 1), param.tpcGeometry.LinearY2Pad(slice, row, track.Y())));
+      float predY = track.Y(), predZ = track.Z() + zOffset;
+      if (transform) {
+        GPUTPCCompressionTrackModel::UncorrectYZ(transform, param, slice, row, predY, predZ);
+      }
+      time = timeTmp + ClusterNative::packTime(CAMath::Max(0.f, param.tpcGeometry.LinearZ2Time(slice, predZ)));
+      float tmpPad = CAMath::Max(0.f, CAMath::Min((float)param.tpcGeometry.NPads(GPUCA_ROW_COUNT - 1), param.tpcGeometry.LinearY2Pad(slice, row, predY)));
       pad = cmprClusters.padResA[clusterOffset - trackIndex - 1] + ClusterNative::packPad(tmpPad);
       time = time & 0xFFFFFF;
       pad = (unsigned short)pad;
@@ -99,6 +104,9 @@ GPUdii() void GPUTPCDecompressionKernels::decompressTrack(CompressedClusters& cm
     const auto cluster = decompressTrackStore(cmprClusters, clusterOffset, slice, row, pad, time, decompressor);
     float y = param.tpcGeometry.LinearPad2Y(slice, row, cluster.getPad());
     float z = param.tpcGeometry.LinearTime2Z(slice, cluster.getTime());
+    if (transform) {
+      GPUTPCCompressionTrackModel::CorrectYZ(transform, param, slice, row, y, z);
+    }
     if (clusterIndex == 0) {
       zOffset = z;
       track.Init(param.tpcGeometry.Row2X(row), y, z - zOffset, param.SliceParam[slice].Alpha, cmprClusters.qPtA[trackIndex], param);
@@ -17,15 +17,18 @@
 #include "GPUParam.h"
 #include "GPUTPCCompressionTrackModel.h"
 #include "GPULogging.h"
+#include "TPCFastTransform.h"
 #include <algorithm>
 #include <cstring>
 #include <atomic>
+#include <numeric>
+#include <vector>
 #include "TPCClusterDecompressor.inc"
 
 using namespace GPUCA_NAMESPACE::gpu;
 using namespace o2::tpc;
 
-int TPCClusterDecompressor::decompress(const CompressedClustersFlat* clustersCompressed, o2::tpc::ClusterNativeAccess& clustersNative, std::function<o2::tpc::ClusterNative*(size_t)> allocator, const GPUParam& param, bool deterministicRec)
+int TPCClusterDecompressor::decompress(const CompressedClustersFlat* clustersCompressed, o2::tpc::ClusterNativeAccess& clustersNative, std::function<o2::tpc::ClusterNative*(size_t)> allocator, const GPUParam& param, bool deterministicRec, const TPCFastTransform* transform)
 {
   CompressedClusters c;
   const CompressedClusters* p;
@@ -35,10 +38,10 @@ int TPCClusterDecompressor::decompress(const CompressedClustersFlat* clustersCom
     c = *clustersCompressed;
     p = &c;
   }
-  return decompress(p, clustersNative, allocator, param, deterministicRec);
+  return decompress(p, clustersNative, allocator, param, deterministicRec, transform);
 }
 
-int TPCClusterDecompressor::decompress(const CompressedClusters* clustersCompressed, o2::tpc::ClusterNativeAccess& clustersNative, std::function<o2::tpc::ClusterNative*(size_t)> allocator, const GPUParam& param, bool deterministicRec)
+int TPCClusterDecompressor::decompress(const CompressedClusters* clustersCompressed, o2::tpc::ClusterNativeAccess& clustersNative, std::function<o2::tpc::ClusterNative*(size_t)> allocator, const GPUParam& param, bool deterministicRec, const TPCFastTransform* transform)
 {
   if (clustersCompressed->nTracks && clustersCompressed->solenoidBz != -1e6f && clustersCompressed->solenoidBz != param.bzkG) {
     throw std::runtime_error("Configured solenoid Bz does not match value used for track model encoding");
@@ -46,35 +49,53 @@ int TPCClusterDecompressor::decompress(const CompressedClusters* clustersCompres
   if (clustersCompressed->nTracks && clustersCompressed->maxTimeBin != -1e6 && clustersCompressed->maxTimeBin != param.par.continuousMaxTimeBin) {
     throw std::runtime_error("Configured max time bin does not match value used for track model encoding");
   }
-  std::vector<ClusterNative> clusters[NSLICES][GPUCA_ROW_COUNT];
-  std::atomic_flag locks[NSLICES][GPUCA_ROW_COUNT];
-  for (unsigned int i = 0; i < NSLICES * GPUCA_ROW_COUNT; i++) {
-    (&locks[0][0])[i].clear();
+  if (clustersCompressed->nTracks && (clustersCompressed->nComppressionModes & GPUSettings::CompressionTrackModelCorrected) && transform == nullptr) {
+    throw std::runtime_error("TPC transformation required for decoding of distortion-corrected track model");
   }
-  unsigned int offset = 0, lasti = 0;
+  // The attached clusters are decoded per track into the slots given by the track offsets, then counted per chunk of tracks and sector row.
+  // The prefix sum of the counts gives every chunk its output position in each row, so that all steps can run in parallel without locks.
+  const unsigned int nTracks = clustersCompressed->nTracks;
+  const unsigned int nSliceRows = NSLICES * GPUCA_ROW_COUNT;
+  const unsigned int nChunks = std::min<unsigned int>(MAX_TRACK_CHUNKS, (nTracks + MIN_TRACKS_PER_CHUNK - 1) / MIN_TRACKS_PER_CHUNK);
+  const unsigned int tracksPerChunk = nChunks ? (nTracks + nChunks - 1) / nChunks : 0;
+  std::vector<unsigned int> trackOffsets(nTracks);
+  std::exclusive_scan(clustersCompressed->nTrackClusters, clustersCompressed->nTrackClusters + nTracks, trackOffsets.begin(), 0u);
+  std::vector<ClusterNative> attachedClusters(clustersCompressed->nAttachedClusters);
+  std::vector<unsigned short> attachedSliceRows(clustersCompressed->nAttachedClusters, INVALID_SLICE_ROW);
+  std::vector<unsigned int> chunkRowCounts((size_t)nChunks * nSliceRows, 0);
   const unsigned int maxTime = param.par.continuousMaxTimeBin > 0 ? ((param.par.continuousMaxTimeBin + 1) * ClusterNative::scaleTimePacked - 1) : TPC_MAX_TIME_BIN_TRIGGERED;
-  GPUCA_OPENMP(parallel for firstprivate(offset, lasti))
-  for (unsigned int i = 0; i < clustersCompressed->nTracks; i++) {
-    if (i < lasti) {
-      offset = lasti = 0; // dynamic OMP scheduling, need to reinitialize offset
-    }
-    while (lasti < i) {
-      offset += clustersCompressed->nTrackClusters[lasti++];
+  GPUCA_OPENMP(parallel for schedule(dynamic))
+  for (unsigned int iChunk = 0; iChunk < nChunks; iChunk++) {
+    ClusterNative* clusterBuffer = attachedClusters.data();
+    unsigned short* sliceRowBuffer = attachedSliceRows.data();
+    unsigned int* counts = &chunkRowCounts[(size_t)iChunk * nSliceRows];
+    const unsigned int endTrack = std::min(nTracks, (iChunk + 1) * tracksPerChunk);
+    for (unsigned int i = iChunk * tracksPerChunk; i < endTrack; i++) {
+      unsigned int offset = trackOffsets[i];
+      decompressTrack(clustersCompressed, param, transform, maxTime, i, offset, clusterBuffer, sliceRowBuffer);
+      for (unsigned int k = trackOffsets[i]; k < offset; k++) {
+        if (sliceRowBuffer[k] != INVALID_SLICE_ROW) {
+          counts[sliceRowBuffer[k]]++;
+        }
+      }
     }
-    lasti++;
-    decompressTrack(clustersCompressed, param, maxTime, i, offset, clusters, locks);
   }
   size_t nTotalClusters = clustersCompressed->nAttachedClusters + clustersCompressed->nUnattachedClusters;
   ClusterNative* clusterBuffer = allocator(nTotalClusters);
   unsigned int offsets[NSLICES][GPUCA_ROW_COUNT];
-  offset = 0;
+  unsigned int nAttached[NSLICES][GPUCA_ROW_COUNT];
+  unsigned int offset = 0;
   unsigned int decodedAttachedClusters = 0;
   for (unsigned int i = 0; i < NSLICES; i++) {
     for (unsigned int j = 0; j < GPUCA_ROW_COUNT; j++) {
-      clustersNative.nClusters[i][j] = clusters[i][j].size() + ((i * GPUCA_ROW_COUNT + j >= clustersCompressed->nSliceRows) ? 0 : clustersCompressed->nSliceRowClusters[i * GPUCA_ROW_COUNT + j]);
+      nAttached[i][j] = 0;
+      for (unsigned int iChunk = 0; iChunk < nChunks; iChunk++) {
+        nAttached[i][j] += chunkRowCounts[(size_t)iChunk * nSliceRows + i * GPUCA_ROW_COUNT + j];
+      }
+      clustersNative.nClusters[i][j] = nAttached[i][j] + ((i * GPUCA_ROW_COUNT + j >= clustersCompressed->nSliceRows) ? 0 : clustersCompressed->nSliceRowClusters[i * GPUCA_ROW_COUNT + j]);
       offsets[i][j] = offset;
       offset += (i * GPUCA_ROW_COUNT + j >= clustersCompressed->nSliceRows) ? 0 : clustersCompressed->nSliceRowClusters[i * GPUCA_ROW_COUNT + j];
-      decodedAttachedClusters += clusters[i][j].size();
+      decodedAttachedClusters += nAttached[i][j];
     }
   }
   if (decodedAttachedClusters != clustersCompressed->nAttachedClusters) {
@@ -82,32 +103,51 @@ int TPCClusterDecompressor::decompress(const CompressedClusters* clustersCompres
   }
   clustersNative.clustersLinear = clusterBuffer;
   clustersNative.setOffsetPtrs();
+  // exclusive scan over the chunks: the counts become the output positions of the chunks in every row, attached clusters come first
   GPUCA_OPENMP(parallel for)
-  for (unsigned int i = 0; i < NSLICES; i++) {
-    for (unsigned int j = 0; j < GPUCA_ROW_COUNT; j++) {
-      ClusterNative* buffer = &clusterBuffer[clustersNative.clusterOffset[i][j]];
-      if (clusters[i][j].size()) {
-        memcpy((void*)buffer, (const void*)clusters[i][j].data(), clusters[i][j].size() * sizeof(clusterBuffer[0]));
+  for (unsigned int iSliceRow = 0; iSliceRow < nSliceRows; iSliceRow++) {
+    unsigned int pos = clustersNative.clusterOffset[iSliceRow / GPUCA_ROW_COUNT][iSliceRow % GPUCA_ROW_COUNT];
+    for (unsigned int iChunk = 0; iChunk < nChunks; iChunk++) {
+      unsigned int& count = chunkRowCounts[(size_t)iChunk * nSliceRows + iSliceRow];
+      const unsigned int n = count;
+      count = pos;
+      pos += n;
+    }
+  }
+  GPUCA_OPENMP(parallel for schedule(dynamic))
+  for (unsigned int iChunk = 0; iChunk < nChunks; iChunk++) {
+    unsigned int* positions = &chunkRowCounts[(size_t)iChunk * nSliceRows];
+    const unsigned int endTrack = std::min(nTracks, (iChunk + 1) * tracksPerChunk);
+    const unsigned int begin = iChunk * tracksPerChunk < endTrack ? trackOffsets[iChunk * tracksPerChunk] : 0;
+    const unsigned int end = iChunk * tracksPerChunk < endTrack ? trackOffsets[endTrack - 1] + clustersCompressed->nTrackClusters[endTrack - 1] : 0;
+    for (unsigned int k = begin; k < end; k++) {
+      if (attachedSliceRows[k] != INVALID_SLICE_ROW) {
+        clusterBuffer[positions[attachedSliceRows[k]]++] = attachedClusters[k];
       }
-      ClusterNative* clout = buffer + clusters[i][j].size();
-      unsigned int end = offsets[i][j] + ((i * GPUCA_ROW_COUNT + j >= clustersCompressed->nSliceRows) ? 0 : clustersCompressed->nSliceRowClusters[i * GPUCA_ROW_COUNT + j]);
-      decompressHits(clustersCompressed, offsets[i][j], end, clout);
-      if (param.rec.tpc.clustersShiftTimebins != 0.f) {
-        for (unsigned int k = 0; k < clustersNative.nClusters[i][j]; k++) {
-          auto& cl = buffer[k];
-          float t = cl.getTime() + param.rec.tpc.clustersShiftTimebins;
-          if (t < 0) {
-            t = 0;
-          }
-          if (param.par.continuousMaxTimeBin > 0 && t > param.par.continuousMaxTimeBin) {
-            t = param.par.continuousMaxTimeBin;
-          }
-          cl.setTime(t);
+    }
+  }
+  GPUCA_OPENMP(parallel for schedule(dynamic))
+  for (unsigned int iSliceRow = 0; iSliceRow < nSliceRows; iSliceRow++) {
+    const unsigned int i = iSliceRow / GPUCA_ROW_COUNT, j = iSliceRow % GPUCA_ROW_COUNT;
+    ClusterNative* buffer = &clusterBuffer[clustersNative.clusterOffset[i][j]];
+    ClusterNative* clout = buffer + nAttached[i][j];
+    unsigned int end = offsets[i][j] + ((i * GPUCA_ROW_COUNT + j >= clustersCompressed->nSliceRows) ? 0 : clustersCompressed->nSliceRowClusters[i * GPUCA_ROW_COUNT + j]);
+    decompressHits(clustersCompressed, offsets[i][j], end, clout);
+    if (param.rec.tpc.clustersShiftTimebins != 0.f) {
+      for (unsigned int k = 0; k < clustersNative.nClusters[i][j]; k++) {
+        auto& cl = buffer[k];
+        float t = cl.getTime() + param.rec.tpc.clustersShiftTimebins;
+        if (t < 0) {
+          t = 0;
         }
+        if (param.par.continuousMaxTimeBin > 0 && t > param.par.continuousMaxTimeBin) {
+          t = param.par.continuousMaxTimeBin;
+        }
+        cl.setTime(t);
       }
-      if (deterministicRec) {
-        std::sort(buffer, buffer + clustersNative.nClusters[i][j]);
-      }
+    }
+    if (deterministicRec) {
+      std::sort(buffer, buffer + clustersNative.nClusters[i][j]);
     }
   }
   return 0;
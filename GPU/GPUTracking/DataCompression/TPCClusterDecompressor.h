@@ -28,16 +28,20 @@ struct ClusterNative;
 namespace GPUCA_NAMESPACE::gpu
 {
 struct GPUParam;
+class TPCFastTransform;
 
 class TPCClusterDecompressor
 {
  public:
   static constexpr unsigned int NSLICES = GPUCA_NSLICES;
-  static int decompress(const o2::tpc::CompressedClustersFlat* clustersCompressed, o2::tpc::ClusterNativeAccess& clustersNative, std::function<o2::tpc::ClusterNative*(size_t)> allocator, const GPUParam& param, bool deterministicRec);
-  static int decompress(const o2::tpc::CompressedClusters* clustersCompressed, o2::tpc::ClusterNativeAccess& clustersNative, std::function<o2::tpc::ClusterNative*(size_t)> allocator, const GPUParam& param, bool deterministicRec);
+  static constexpr unsigned int MIN_TRACKS_PER_CHUNK = 1024;                  // attached clusters are decoded in chunks of tracks, with one counter per sector row for every chunk
+  static constexpr unsigned int MAX_TRACK_CHUNKS = 256;                       // limits the memory for the counters
+  static constexpr unsigned short INVALID_SLICE_ROW = NSLICES * GPUCA_ROW_COUNT; // marks clusters not decoded due to a track model failure
+  static int decompress(const o2::tpc::CompressedClustersFlat* clustersCompressed, o2::tpc::ClusterNativeAccess& clustersNative, std::function<o2::tpc::ClusterNative*(size_t)> allocator, const GPUParam& param, bool deterministicRec, const TPCFastTransform* transform = nullptr);
+  static int decompress(const o2::tpc::CompressedClusters* clustersCompressed, o2::tpc::ClusterNativeAccess& clustersNative, std::function<o2::tpc::ClusterNative*(size_t)> allocator, const GPUParam& param, bool deterministicRec, const TPCFastTransform* transform = nullptr);
 
   template <typename... Args>
-  static void decompressTrack(const o2::tpc::CompressedClusters* clustersCompressed, const GPUParam& param, const unsigned int maxTime, const unsigned int i, unsigned int& offset, Args&... args);
+  static void decompressTrack(const o2::tpc::CompressedClusters* clustersCompressed, const GPUParam& param, const TPCFastTransform* transform, const unsigned int maxTime, const unsigned int i, unsigned int& offset, Args&... args);
   template <typename... Args>
   static void decompressHits(const o2::tpc::CompressedClusters* clustersCompressed, const unsigned int start, const unsigned int end, Args&... args);
 };
@@ -36,3 +36,38 @@ void GPUMemorySizeScalers::rescaleMaxMem(size_t newAvailableMemory)
   tpcMaxMergedTrackHits = (double)tmp.tpcMaxMergedTrackHits * scaleFactor;
   availableMemory = newAvailableMemory;
 }
+
+void GPUMemorySizeScalers::updateAdaptiveFactors(unsigned int nTFs, double margin)
+{
+  // The factor which would have made the buffer exactly fit is the current one scaled by the used fraction.
+  // Use the largest one of the last nTFs and the margin, never exceeding the static estimate.
+  if (adaptiveHistory.size() != (size_t)nTFs * nAdaptiveScalers) {
+    adaptiveHistory.assign((size_t)nTFs * nAdaptiveScalers, 1.);
+    adaptiveHistoryPos = 0;
+  }
+  double* current = &adaptiveHistory[(size_t)adaptiveHistoryPos * nAdaptiveScalers];
+  for (unsigned int i = 0; i < nAdaptiveScalers; i++) {
+    current[i] = adaptiveUsage[i] > 0. ? adaptiveFactor[i] * adaptiveUsage[i] : adaptiveFactor[i];
+    adaptiveUsage[i] = 0.;
+  }
+  adaptiveHistoryPos = (adaptiveHistoryPos + 1) % nTFs;
+  for (unsigned int i = 0; i < nAdaptiveScalers; i++) {
+    double needed = 0.;
+    for (unsigned int j = 0; j < nTFs; j++) {
+      needed = std::max(needed, adaptiveHistory[(size_t)j * nAdaptiveScalers + i]);
+    }
+    adaptiveFactor[i] = std::min(1., needed * margin);
+  }
+}
+
+bool GPUMemorySizeScalers::resetAdaptiveFactors()
+{
+  bool tightened = false;
+  for (unsigned int i = 0; i < nAdaptiveScalers; i++) {
+    tightened |= adaptiveFactor[i] < 1.;
+    adaptiveFactor[i] = 1.;
+    adaptiveUsage[i] = 0.;
+  }
+  adaptiveHistory.clear();
+  return tightened;
+}
@@ -16,6 +16,7 @@
 #define O2_GPU_GPUMEMORYSIZESCALERS_H
 
 #include "GPUDef.h"
+#include <vector>
 
 namespace GPUCA_NAMESPACE::gpu
 {
@@ -65,22 +66,48 @@ struct GPUMemorySizeScalers {
   size_t availableMemory = 20500000000;
   bool returnMaxVal = false;
 
+  // Online tuning of the estimates from the peak usage of the last TFs, see GPU_proc.memoryScalingAdaptive
+  enum AdaptiveScaler : unsigned int { tpcPeaksScaler,
+                                       tpcSectorClustersScaler,
+                                       tpcStartHitsScaler,
+                                       tpcTrackletsScaler,
+                                       tpcTrackletHitsScaler,
+                                       tpcSectorTracksScaler,
+                                       tpcSectorTrackHitsScaler,
+                                       tpcMergedTracksScaler,
+                                       tpcMergedTrackHitsScaler,
+                                       nAdaptiveScalers };
+  double adaptiveFactor[nAdaptiveScalers] = {1., 1., 1., 1., 1., 1., 1., 1., 1.}; // <= 1, applied on top of the static estimates
+  double adaptiveUsage[nAdaptiveScalers] = {};                                  // peak fraction of the buffers used in the current TF
+  std::vector<double> adaptiveHistory;                                          // factors needed in the last TFs, nAdaptiveScalers per TF
+  unsigned int adaptiveHistoryPos = 0;
+  bool adaptiveFallback = false; // set when tightened estimates were reset after an overflow
+
   void rescaleMaxMem(size_t newAvailableMemory);
-  inline size_t getValue(size_t maxVal, size_t val)
+  inline void addAdaptiveUsage(AdaptiveScaler s, size_t used, size_t bound)
+  {
+    if (bound) {
+      adaptiveUsage[s] = std::max(adaptiveUsage[s], (double)used / bound);
+    }
+  }
+  void updateAdaptiveFactors(unsigned int nTFs, double margin);
+  bool resetAdaptiveFactors();
+
+  inline size_t getValue(size_t maxVal, size_t val, double adaptive = 1.)
   {
-    return returnMaxVal ? maxVal : (std::min<size_t>(maxVal, offset + val) * factor * temporaryFactor);
+    return returnMaxVal ? maxVal : (std::min<size_t>(maxVal, offset + val) * factor * temporaryFactor * adaptive);
   }
 
-  inline size_t NTPCPeaks(size_t tpcDigits, bool perSector = false) { return getValue(perSector ? tpcMaxPeaks : (GPUCA_NSLICES * tpcMaxPeaks), hitOffset + tpcDigits * tpcPeaksPerDigit); }
-  inline size_t NTPCClusters(size_t tpcDigits, bool perSector = false) { return getValue(perSector ? tpcMaxSectorClusters : tpcMaxClusters, (conservative ? 1.0 : tpcClustersPerPeak) * NTPCPeaks(tpcDigits, perSector)); }
-  inline size_t NTPCStartHits(size_t tpcHits) { return getValue(tpcMaxStartHits, tpcHits * tpcStartHitsPerHit); }
-  inline size_t NTPCRowStartHits(size_t tpcHits) { return getValue(tpcMaxRowStartHits, std::max<size_t>(NTPCStartHits(tpcHits) * (tpcHits < 30000000 ? 20 : 12) / GPUCA_ROW_COUNT, tpcMinRowStartHits)); }
-  inline size_t NTPCTracklets(size_t tpcHits) { return getValue(tpcMaxTracklets, NTPCStartHits(tpcHits) * tpcTrackletsPerStartHit); }
-  inline size_t NTPCTrackletHits(size_t tpcHits) { return getValue(tpcMaxTrackletHits, hitOffset + tpcHits * tpcTrackletHitsPerHit); }
-  inline size_t NTPCSectorTracks(size_t tpcHits) { return getValue(tpcMaxSectorTracks, tpcHits * tpcSectorTracksPerHit); }
-  inline size_t NTPCSectorTrackHits(size_t tpcHits, unsigned char withRejection = 0) { return getValue(tpcMaxSectorTrackHits, tpcHits * (withRejection ? tpcSectorTrackHitsPerHitWithRejection : tpcSectorTrackHitsPerHit)); }
-  inline size_t NTPCMergedTracks(size_t tpcSliceTracks) { return getValue(tpcMaxMergedTracks, tpcSliceTracks * (conservative ? 1.0 : tpcMergedTrackPerSliceTrack)); }
-  inline size_t NTPCMergedTrackHits(size_t tpcSliceTrackHitss) { return getValue(tpcMaxMergedTrackHits, tpcSliceTrackHitss * tpcMergedTrackHitPerSliceHit); }
+  inline size_t NTPCPeaks(size_t tpcDigits, bool perSector = false, bool adaptive = true) { return getValue(perSector ? tpcMaxPeaks : (GPUCA_NSLICES * tpcMaxPeaks), hitOffset + tpcDigits * tpcPeaksPerDigit, adaptive ? adaptiveFactor[tpcPeaksScaler] : 1.); }
+  inline size_t NTPCClusters(size_t tpcDigits, bool perSector = false) { return getValue(perSector ? tpcMaxSectorClusters : tpcMaxClusters, (conservative ? 1.0 : tpcClustersPerPeak) * NTPCPeaks(tpcDigits, perSector, false), perSector ? adaptiveFactor[tpcSectorClustersScaler] : 1.); }
+  inline size_t NTPCStartHits(size_t tpcHits, bool adaptive = true) { return getValue(tpcMaxStartHits, tpcHits * tpcStartHitsPerHit, adaptive ? adaptiveFactor[tpcStartHitsScaler] : 1.); }
+  inline size_t NTPCRowStartHits(size_t tpcHits) { return getValue(tpcMaxRowStartHits, std::max<size_t>(NTPCStartHits(tpcHits, false) * (tpcHits < 30000000 ? 20 : 12) / GPUCA_ROW_COUNT, tpcMinRowStartHits)); }
+  inline size_t NTPCTracklets(size_t tpcHits) { return getValue(tpcMaxTracklets, NTPCStartHits(tpcHits, false) * tpcTrackletsPerStartHit, adaptiveFactor[tpcTrackletsScaler]); }
+  inline size_t NTPCTrackletHits(size_t tpcHits) { return getValue(tpcMaxTrackletHits, hitOffset + tpcHits * tpcTrackletHitsPerHit, adaptiveFactor[tpcTrackletHitsScaler]); }
+  inline size_t NTPCSectorTracks(size_t tpcHits) { return getValue(tpcMaxSectorTracks, tpcHits * tpcSectorTracksPerHit, adaptiveFactor[tpcSectorTracksScaler]); }
+  inline size_t NTPCSectorTrackHits(size_t tpcHits, unsigned char withRejection = 0) { return getValue(tpcMaxSectorTrackHits, tpcHits * (withRejection ? tpcSectorTrackHitsPerHitWithRejection : tpcSectorTrackHitsPerHit), adaptiveFactor[tpcSectorTrackHitsScaler]); }
+  inline size_t NTPCMergedTracks(size_t tpcSliceTracks) { return getValue(tpcMaxMergedTracks, tpcSliceTracks * (conservative ? 1.0 : tpcMergedTrackPerSliceTrack), adaptiveFactor[tpcMergedTracksScaler]); }
+  inline size_t NTPCMergedTrackHits(size_t tpcSliceTrackHitss) { return getValue(tpcMaxMergedTrackHits, tpcSliceTrackHitss * tpcMergedTrackHitPerSliceHit, adaptiveFactor[tpcMergedTrackHitsScaler]); }
   inline size_t NTPCUnattachedHitsBase1024(int type) { return (returnMaxVal || conservative) ? 1024 : std::min<size_t>(1024, tpcCompressedUnattachedHitsBase1024[type] * factor * temporaryFactor); }
 };
 
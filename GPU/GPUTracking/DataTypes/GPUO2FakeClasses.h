@@ -139,7 +139,7 @@ class GPUTPCClusterStatistics
 {
  public:
   void Finish() {}
-  void RunStatistics(const o2::tpc::ClusterNativeAccess* clustersNative, const GPUFakeEmpty* clustersCompressed, const GPUParam& param) {}
+  void RunStatistics(const o2::tpc::ClusterNativeAccess* clustersNative, const GPUFakeEmpty* clustersCompressed, const GPUParam& param, const TPCFastTransform* transform) {}
 };
 #endif
 } // namespace gpu
@@ -35,7 +35,8 @@ class GPUSettings
   enum CompressionModes { CompressionTruncate = 1,
                           CompressionDifferences = 2,
                           CompressionTrackModel = 4,
-                          CompressionFull = 7 };
+                          CompressionFull = 7,
+                          CompressionTrackModelCorrected = 8 };
   enum CompressionSort { SortTime = 0,
                          SortPad = 1,
                          SortZTimePad = 2,
@@ -77,6 +77,7 @@
   #define GPUCA_LB_GPUTPCCFChargeMapFiller_fillIndexMap 512
   #define GPUCA_LB_GPUTPCCFChargeMapFiller_fillFromDigits 512
   #define GPUCA_LB_GPUTPCCFChargeMapFiller_findFragmentStart 512
+  #define GPUCA_LB_GPUTPCCFChargeMapFiller_resetMaps 512
   #define GPUCA_LB_GPUTPCCFPeakFinder 512
   #define GPUCA_LB_GPUTPCCFNoiseSuppression 512
   #define GPUCA_LB_GPUTPCCFDeconvolution 512
@@ -143,6 +144,7 @@
   #define GPUCA_LB_GPUTPCCFChargeMapFiller_fillIndexMap 512
   #define GPUCA_LB_GPUTPCCFChargeMapFiller_fillFromDigits 512
   #define GPUCA_LB_GPUTPCCFChargeMapFiller_findFragmentStart 512
+  #define GPUCA_LB_GPUTPCCFChargeMapFiller_resetMaps 512
   #define GPUCA_LB_GPUTPCCFPeakFinder 512
   #define GPUCA_LB_GPUTPCCFNoiseSuppression 512
   #define GPUCA_LB_GPUTPCCFDeconvolution 512
@@ -209,6 +211,7 @@
   #define GPUCA_LB_GPUTPCCFChargeMapFiller_fillIndexMap 448
   #define GPUCA_LB_GPUTPCCFChargeMapFiller_fillFromDigits 448
   #define GPUCA_LB_GPUTPCCFChargeMapFiller_findFragmentStart 448
+  #define GPUCA_LB_GPUTPCCFChargeMapFiller_resetMaps 448
   #define GPUCA_LB_GPUTPCCFPeakFinder 128
   #define GPUCA_LB_GPUTPCCFNoiseSuppression 448
   #define GPUCA_LB_GPUTPCCFDeconvolution 384
@@ -327,6 +330,9 @@
   #ifndef GPUCA_LB_GPUTRDTrackerKernels_o2Version
     #define GPUCA_LB_GPUTRDTrackerKernels_o2Version 512
   #endif
+  #ifndef GPUCA_LB_GPUTRDTrackerLoadTracks
+    #define GPUCA_LB_GPUTRDTrackerLoadTracks 256
+  #endif
   #ifndef GPUCA_LB_GPUTPCConvertKernel
     #define GPUCA_LB_GPUTPCConvertKernel 256
   #endif
@@ -471,6 +477,9 @@
   #ifndef GPUCA_LB_GPUTPCCFChargeMapFiller_findFragmentStart
     #define GPUCA_LB_GPUTPCCFChargeMapFiller_findFragmentStart 512
   #endif
+  #ifndef GPUCA_LB_GPUTPCCFChargeMapFiller_resetMaps
+    #define GPUCA_LB_GPUTPCCFChargeMapFiller_resetMaps 512
+  #endif
   #ifndef GPUCA_LB_GPUTPCCFPeakFinder
     #define GPUCA_LB_GPUTPCCFPeakFinder 512
   #endif
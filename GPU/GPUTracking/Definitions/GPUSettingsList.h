@@ -40,6 +40,8 @@ AddOptionRTC(rejectQPtB5, float, 1.f / GPUCA_MIN_TRACK_PTB5_REJECT_DEFAULT, "",
 AddOptionRTC(hitPickUpFactor, float, 1.f, "", 0, "multiplier for the combined cluster+track error during track following")
 AddOptionRTC(hitSearchArea2, float, 2.f, "", 0, "square of maximum search road of hits during seeding")
 AddOptionRTC(neighboursSearchArea, float, 3.f, "", 0, "area in cm for the search of neighbours, for z only used if searchWindowDZDR = 0")
+AddOptionRTC(sliceDataGridHitsPerBin, float, 1.f, "", 0, "average number of hits per bin of the y-z grid of each row, the bin size follows the occupancy of the row (values < 1 need more grid memory)")
+AddOptionRTC(sliceDataGridMaxBinsPerSearchArea, float, 0.f, "", 0, "if > 0, limit the number of grid bins spanned by the neighbours search area in y, increasing the bin size in high-occupancy rows")
 AddOptionRTC(clusterError2CorrectionY, float, 1.f, "", 0, "correction (multiplicative) for the squared cluster error during tracking")
 AddOptionRTC(clusterError2CorrectionZ, float, 1.f, "", 0, "correction (multiplicative) for the squared cluster error during tracking")
 AddOptionRTC(clusterError2AdditionalY, float, 0.f, "", 0, "correction (additive) for the squared cluster error during track fitting")
@@ -135,7 +137,7 @@ AddOptionRTC(globalTracking, char, 1, "", 0, "Enable Global Tracking (prolong tr
 AddOptionRTC(disableRefitAttachment, unsigned char, 0, "", 0, "Bitmask to disable certain attachment steps during refit (1: attachment, 2: propagation, 4: loop following, 8: mirroring)")
 AddOptionRTC(rejectionStrategy, unsigned char, GPUCA_NAMESPACE::gpu::GPUSettings::RejectionStrategyA, "", 0, "Enable rejection of TPC clusters for compression (0 = no, 1 = strategy A, 2 = strategy B)")
 AddOptionRTC(mergeLoopersAfterburner, unsigned char, 1, "", 0, "Run afterburner for additional looper merging")
-AddOptionRTC(compressionTypeMask, unsigned char, GPUCA_NAMESPACE::gpu::GPUSettings::CompressionFull, "", 0, "TPC Compression mode bits (1=truncate charge/width LSB, 2=differences, 4=track-model)")
+AddOptionRTC(compressionTypeMask, unsigned char, GPUCA_NAMESPACE::gpu::GPUSettings::CompressionFull, "", 0, "TPC Compression mode bits (1=truncate charge/width LSB, 2=differences, 4=track-model, 8=fit track-model in distortion-corrected coordinates, decoding requires the same TPC transformation)")
 AddOptionRTC(compressionSortOrder, unsigned char, GPUCA_NAMESPACE::gpu::GPUSettings::SortTime, "", 0, "Sort order of TPC compression (0 = time, 1 = pad, 2 = Z-time-pad, 3 = Z-pad-time, 4 = no sorting (use incoming order))")
 AddOptionRTC(sigBitsCharge, unsigned char, 4, "", 0, "Number of significant bits for TPC cluster charge in compression mode 1")
 AddOptionRTC(sigBitsWidth, unsigned char, 3, "", 0, "Number of significant bits for TPC cluster width in compression mode 1")
@@ -202,6 +204,7 @@ AddOption(compilePerKernel, bool, true, "", 0, "Run one RTC compilation per kern
 AddOption(enable, bool, false, "", 0, "Use RTC to optimize GPU code")
 AddOption(runTest, int, 0, "", 0, "Do not run the actual benchmark, but just test RTC compilation (1 full test, 2 test only compilation)")
 AddOption(cacheMutex, bool, true, "", 0, "Use a file lock to serialize access to the cache folder")
+AddOption(cachePerParam, bool, true, "", 0, "Keep one cache file per set of parameters compiled in as constants, instead of a single cache file")
 AddOption(ignoreCacheValid, bool, false, "", 0, "If set, allows to use RTC cached code files even if they are not valid for the current source code / parameters")
 AddHelp("help", 'h')
 EndConfig()
@@ -221,6 +224,7 @@ AddOption(globalInitMutex, bool, false, "", 0, "Use global mutex to synchronize
 AddOption(stuckProtection, int, 0, "", 0, "Timeout in us, When AMD GPU is stuck, just continue processing and skip tracking, do not crash or stall the chain")
 AddOption(trdNCandidates, int, 3, "", 0, "Number of branching track candidates for single input track during propagation")
 AddOption(trdTrackModelO2, bool, false, "", 0, "Use O2 track model instead of GPU track model for TRD tracking")
+AddOption(trdLoadTracksOnGPU, bool, false, "", 0, "Select and load the TPC tracks for the GPU TRD tracking from the merger output in GPU memory instead of uploading them (track order not deterministic)")
 AddOption(debugLevel, int, -1, "debug", 'd', "Set debug level (-1 = silent)")
 AddOption(allocDebugLevel, int, 0, "allocDebug", 0, "Some debug output for memory allocations (without messing with normal debug level)")
 AddOption(debugMask, int, 262143, "", 0, "Mask for debug output dumps to file")
@@ -238,12 +242,15 @@ AddOption(forceMemoryPoolSize, unsigned long, 1, "memSize", 0, "Force size of al
 AddOption(forceHostMemoryPoolSize, unsigned long, 0, "hostMemSize", 0, "Force size of allocated host page locked host memory (overriding memSize)", min(0ul))
 AddOption(memoryScalingFactor, float, 1.f, "", 0, "Factor to apply to all memory scalers")
 AddOption(conservativeMemoryEstimate, bool, false, "", 0, "Use some more conservative defaults for larger buffers during TPC processing")
+AddOption(memoryScalingAdaptive, unsigned int, 0, "", 0, "Tighten the memory scalers online to the peak buffer usage of the last n TFs (0 = disabled)")
+AddOption(memoryScalingAdaptiveMargin, float, 1.25f, "", 0, "Safety margin applied on top of the peak buffer usage by the adaptive memory scaling")
 AddOption(tpcInputWithClusterRejection, unsigned char, 0, "", 0, "Indicate whether the TPC input is CTF data with cluster rejection, to tune buffer estimations")
 AddOption(forceMaxMemScalers, unsigned long, 0, "", 0, "Force using the maximum values for all buffers, Set a value n > 1 to rescale all maximums to a memory size of n")
 AddOption(registerStandaloneInputMemory, bool, false, "registerInputMemory", 0, "Automatically register input memory buffers for the GPU")
 AddOption(ompThreads, int, -1, "omp", 't', "Number of OMP threads to run (-1: all)", min(-1), message("Using %s OMP threads"))
 AddOption(ompKernels, unsigned char, 2, "", 0, "Parallelize with OMP inside kernels instead of over slices, 2 for nested parallelization over TPC sectors and inside kernels")
 AddOption(ompAutoNThreads, bool, true, "", 0, "Auto-adjust number of OMP threads, decreasing the number for small input data")
+AddOption(ompKernelThreads, std::string, "", "", 0, "OMP setup of individual CPU kernels, comma-separated list of <kernel>:<max threads>[:<chunk size>], with kernel names as in the timing output and a chunk size > 0 for dynamic scheduling of the blocks")
 AddOption(nDeviceHelperThreads, int, 1, "", 0, "Number of CPU helper threads for CPU processing")
 AddOption(nStreams, char, 8, "", 0, "Number of GPU streams / command queues")
 AddOption(nTPCClustererLanes, char, -1, "", 0, "Number of TPC clusterers that can run in parallel (-1 = autoset)")
@@ -258,8 +265,10 @@ AddOption(alternateBorderSort, char, -1, "", 0, "Alternative implementation for
 AddOption(tpcCompressionGatherMode, char, -1, "", 0, "TPC Compressed Clusters Gather Mode (0: DMA transfer gather gpu to host, 1: serial DMA to host and gather by copy on CPU, 2. gather via GPU kernal DMA access, 3. gather on GPU via kernel, dma afterwards")
 AddOption(tpcCompressionGatherModeKernel, char, -1, "", 0, "TPC Compressed Clusters Gather Mode Kernel (0: unbufferd, 1-3: buffered, 4: multi-block)")
 AddOption(tpccfGatherKernel, bool, true, "", 0, "Use a kernel instead of the DMA engine to gather the clusters")
+AddOption(tpccfSparseMapReset, float, 0.05f, "", 0, "Reset only the written entries of the TPC clusterizer charge and peak maps after a fragment with less digits than this fraction of the map entries, instead of clearing the full maps (0 = disable)")
 AddOption(doublePipeline, bool, false, "", 0, "Double pipeline mode")
 AddOption(doublePipelineClusterizer, bool, true, "", 0, "Include the input data of the clusterizer in the double-pipeline")
+AddOption(doublePipelineDepth, unsigned char, 2, "", 0, "Number of processing contexts, i.e. TFs in flight, in double-pipeline mode")
 AddOption(prefetchTPCpageScan, char, 0, "", 0, "Prefetch Data for TPC page scan in CPU cache")
 AddOption(runMC, bool, false, "", 0, "Process MC labels")
 AddOption(runQA, int, 0, "qa", 'q', "Enable tracking QA (negative number to provide bitmask for QA tasks)", message("Running QA: %s"), def(1))
@@ -281,6 +290,7 @@ AddOption(tpcSingleSector, int, -1, "", 0, "Restrict TPC processing to a single
 AddOption(tpcDownscaledEdx, unsigned char, 0, "", 0, "If != 0, downscale dEdx processing (if enabled) to x %")
 AddOption(tpcMaxAttachedClustersPerSectorRow, unsigned int, 51000, "", 0, "Maximum number of TPC attached clusters which can be decoded per SectorRow")
 AddOption(tpcUseOldCPUDecoding, bool, false, "", 0, "Enable old CPU-based TPC decoding")
+AddOption(tpcDecompressionBenchmarkCPU, bool, false, "", 0, "Run the CPU-based TPC decoding in addition to the kernel-based one, to time it and compare the decoded clusters")
 AddOption(RTCcacheFolder, std::string, "./rtccache/", "", 0, "Folder in which the cache file is stored")
 AddVariable(eventDisplay, GPUCA_NAMESPACE::gpu::GPUDisplayFrontendInterface*, nullptr)
 AddSubConfig(GPUSettingsProcessingRTC, rtc)
@@ -404,6 +414,7 @@ AddOption(qpt, float, 10.f, "", 0, "Set cut for Q/Pt", def(2.f))
 AddOption(maxResX, float, 1e6f, "", 0, "Maxmimum X (~radius) for reconstructed track position to take into accound for resolution QA in cm")
 AddOption(recThreshold, float, 0.9f, "", 0, "Compute the efficiency including impure tracks with fake contamination")
 AddOption(resPrimaries, int, 0, "", 0, "0: Resolution for all tracks, 1: only for primary tracks, 2: only for non-primaries", def(1))
+AddOption(resFraction, float, 1.f, "", 0, "Fraction of the MC tracks (deterministic subset) for which the resolution is computed, for a lightweight QA")
 AddOption(filterCharge, int, 0, "", 0, "Filter for positive (+1) or negative (-1) charge")
 AddOption(filterPID, int, -1, "", 0, "Filter for Particle Type (0 Electron, 1 Muon, 2 Pion, 3 Kaon, 4 Proton)")
 AddOption(nativeFitResolutions, bool, false, "", 0, "Create resolution histograms in the native fit units (sin(phi), tan(lambda), Q/Pt)")
@@ -403,9 +403,15 @@ int GPUChainTracking::Init()
 
 void GPUChainTracking::UpdateGPUCalibObjects(int stream, const GPUCalibObjectsConst* ptrMask)
 {
-  if (processors()->calibObjects.fastTransform && (ptrMask == nullptr || ptrMask->fastTransform)) {
-    memcpy((void*)mFlatObjectsShadow.mCalibObjects.fastTransform, (const void*)processors()->calibObjects.fastTransform, sizeof(*processors()->calibObjects.fastTransform));
-    memcpy((void*)mFlatObjectsShadow.mTpcTransformBuffer, (const void*)processors()->calibObjects.fastTransform->getFlatBufferPtr(), processors()->calibObjects.fastTransform->getFlatBufferSize());
+  // A blended map of the helper replaces the current map, it has the same size since it is created as a copy of the current map and it changes with the scaling
+  const TPCFastTransform* fastTransformBlended = processors()->calibObjects.fastTransformHelper ? processors()->calibObjects.fastTransformHelper->getCorrMapBlended() : nullptr;
+  if (fastTransformBlended && (!processors()->calibObjects.fastTransform || fastTransformBlended->getFlatBufferSize() != processors()->calibObjects.fastTransform->getFlatBufferSize())) {
+    fastTransformBlended = nullptr;
+  }
+  if (processors()->calibObjects.fastTransform && (ptrMask == nullptr || ptrMask->fastTransform || (fastTransformBlended && ptrMask->fastTransformHelper))) {
+    const TPCFastTransform* fastTransform = fastTransformBlended ? fastTransformBlended : processors()->calibObjects.fastTransform;
+    memcpy((void*)mFlatObjectsShadow.mCalibObjects.fastTransform, (const void*)fastTransform, sizeof(*fastTransform));
+    memcpy((void*)mFlatObjectsShadow.mTpcTransformBuffer, (const void*)fastTransform->getFlatBufferPtr(), fastTransform->getFlatBufferSize());
     mFlatObjectsShadow.mCalibObjects.fastTransform->clearInternalBufferPtr();
     mFlatObjectsShadow.mCalibObjects.fastTransform->setActualBufferAddress(mFlatObjectsShadow.mTpcTransformBuffer);
     mFlatObjectsShadow.mCalibObjects.fastTransform->setFutureBufferAddress(mFlatObjectsDevice.mTpcTransformBuffer);
@@ -429,6 +435,7 @@ void GPUChainTracking::UpdateGPUCalibObjects(int stream, const GPUCalibObjectsCo
     mFlatObjectsShadow.mCalibObjects.fastTransformHelper->setCorrMap(mFlatObjectsShadow.mCalibObjects.fastTransform);
     mFlatObjectsShadow.mCalibObjects.fastTransformHelper->setCorrMapRef(mFlatObjectsShadow.mCalibObjects.fastTransformRef);
     mFlatObjectsShadow.mCalibObjects.fastTransformHelper->setCorrMapMShape(mFlatObjectsShadow.mCalibObjects.fastTransformMShape);
+    mFlatObjectsShadow.mCalibObjects.fastTransformHelper->setCorrMapBlended(fastTransformBlended ? mFlatObjectsShadow.mCalibObjects.fastTransform : nullptr);
   }
 #ifdef GPUCA_HAVE_O2HEADERS
   if (processors()->calibObjects.dEdxCalibContainer && (ptrMask == nullptr || ptrMask->dEdxCalibContainer)) {
@@ -791,9 +798,12 @@ int GPUChainTracking::RunChain()
   int retVal = 0;
   if (CheckErrorCodes(false, false, mRec->getErrorCodeOutput())) {
     retVal = 3;
-    if (!GetProcessingSettings().ignoreNonFatalGPUErrors) {
-      return retVal;
-    }
+  }
+  if (GetProcessingSettings().memoryScalingAdaptive) {
+    UpdateAdaptiveMemoryScalers(retVal != 0);
+  }
+  if (retVal && !GetProcessingSettings().ignoreNonFatalGPUErrors) {
+    return retVal;
   }
 
   if (GetProcessingSettings().doublePipeline) {
@@ -808,7 +818,7 @@ int GPUChainTracking::RunChainFinalize()
 #ifdef GPUCA_HAVE_O2HEADERS
   if (mIOPtrs.clustersNative && (GetRecoSteps() & RecoStep::TPCCompression) && GetProcessingSettings().runCompressionStatistics) {
     CompressedClusters c = *mIOPtrs.tpcCompressedClusters;
-    mCompressionStatistics->RunStatistics(mIOPtrs.clustersNative, &c, param());
+    mCompressionStatistics->RunStatistics(mIOPtrs.clustersNative, &c, param(), processors()->calibObjects.fastTransform);
   }
 #endif
 
@@ -168,7 +168,7 @@ class GPUChainTracking : public GPUChain, GPUReconstructionHelpers::helperDelega
   template <int I>
   int RunTRDTracking();
   template <int I, class T = GPUTRDTracker>
-  int DoTRDGPUTracking(T* externalInstance = nullptr);
+  int DoTRDGPUTracking(T* externalInstance = nullptr, bool loadTracksOnGPU = false);
   int RunTPCCompression();
   int RunTPCDecompression();
   int RunRefit();
@@ -239,6 +239,7 @@ class GPUChainTracking : public GPUChain, GPUReconstructionHelpers::helperDelega
   int DoProfile();
   void PrintMemoryRelations();
   void PrintMemoryStatistics() override;
+  void UpdateAdaptiveMemoryScalers(bool error);
   void PrepareDebugOutput();
   void PrintDebugOutput();
   void PrintOutputStat();
@@ -430,6 +430,17 @@ std::pair<unsigned int, unsigned int> GPUChainTracking::RunTPCClusterizer_transf
     GPUTPCClusterFinder& clusterer = processors()->tpcClusterer[iSlice];
     GPUTPCClusterFinder& clustererShadow = doGPU ? processorsShadow()->tpcClusterer[iSlice] : clusterer;
     unsigned int nPagesSector = 0;
+    // The pages are copied directly from the (registered) input buffers. Page ranges which are contiguous in the input,
+    // e.g. the pages of consecutive links in the same shm message, are merged into a single transfer.
+    char* pendingSrc = nullptr;
+    char* pendingDst = nullptr;
+    size_t pendingSize = 0;
+    auto flushZSCopy = [&]() {
+      if (pendingSize) {
+        GPUMemCpy(RecoStep::TPCClusterFinding, pendingDst, pendingSrc, pendingSize, lane, true);
+      }
+      pendingSize = 0;
+    };
     for (unsigned int j = 0; j < GPUTrackingInOutZS::NENDPOINTS; j++) {
       unsigned int nPages = 0;
       mInputsHost->mPzsMeta->slice[iSlice].zsPtr[j] = &mInputsShadow->mPzsPtrs[iSlice * GPUTrackingInOutZS::NENDPOINTS + j];
@@ -441,7 +452,16 @@ std::pair<unsigned int, unsigned int> GPUChainTracking::RunTPCClusterizer_transf
           char* src = (char*)mIOPtrs.tpcZS->slice[iSlice].zsPtr[j][k] + min * TPCZSHDR::TPC_ZS_PAGE_SIZE;
           char* ptrLast = (char*)mIOPtrs.tpcZS->slice[iSlice].zsPtr[j][k] + (max - 1) * TPCZSHDR::TPC_ZS_PAGE_SIZE;
           size_t size = (ptrLast - src) + o2::raw::RDHUtils::getMemorySize(*(const o2::header::RAWDataHeader*)ptrLast);
-          GPUMemCpy(RecoStep::TPCClusterFinding, clustererShadow.mPzs + (nPagesSector + nPages) * TPCZSHDR::TPC_ZS_PAGE_SIZE, src, size, lane, true);
+          char* dst = clustererShadow.mPzs + (nPagesSector + nPages) * TPCZSHDR::TPC_ZS_PAGE_SIZE;
+          const size_t pendingPages = (pendingSize + TPCZSHDR::TPC_ZS_PAGE_SIZE - 1) / TPCZSHDR::TPC_ZS_PAGE_SIZE;
+          if (pendingSize && src == pendingSrc + pendingPages * TPCZSHDR::TPC_ZS_PAGE_SIZE && dst == pendingDst + pendingPages * TPCZSHDR::TPC_ZS_PAGE_SIZE) {
+            pendingSize = (src - pendingSrc) + size;
+          } else {
+            flushZSCopy();
+            pendingSrc = src;
+            pendingDst = dst;
+            pendingSize = size;
+          }
         }
         nPages += max - min;
       }
@@ -450,6 +470,7 @@ std::pair<unsigned int, unsigned int> GPUChainTracking::RunTPCClusterizer_transf
       mInputsHost->mPzsMeta->slice[iSlice].count[j] = 1;
       nPagesSector += nPages;
     }
+    flushZSCopy();
     GPUMemCpy(RecoStep::TPCClusterFinding, clustererShadow.mPzsOffsets, clusterer.mPzsOffsets, clusterer.mNMaxPages * sizeof(*clusterer.mPzsOffsets), lane, true);
   }
   return retVal;
@@ -662,6 +683,7 @@ int GPUChainTracking::RunTPCClusterizer(bool synchronizeOutput)
 
   for (unsigned int iSliceBase = 0; iSliceBase < NSLICES; iSliceBase += GetProcessingSettings().nTPCClustererLanes) {
     std::vector<bool> laneHasData(GetProcessingSettings().nTPCClustererLanes, false);
+    char mapsClean[NSLICES] = {0}; // Charge and peak maps of the lane were reset sparsely after the previous fragment
     static_assert(NSLICES <= GPUCA_MAX_STREAMS, "Stream events must be able to hold all slices");
     const int maxLane = std::min<int>(GetProcessingSettings().nTPCClustererLanes, NSLICES - iSliceBase);
     for (CfFragment fragment = mCFContext->fragmentFirst; !fragment.isEnd(); fragment = fragment.next()) {
@@ -706,8 +728,11 @@ int GPUChainTracking::RunTPCClusterizer(bool synchronizeOutput)
 
         using ChargeMapType = decltype(*clustererShadow.mPchargeMap);
         using PeakMapType = decltype(*clustererShadow.mPpeakMap);
-        runKernel<GPUMemClean16>({GetGridAutoStep(lane, RecoStep::TPCClusterFinding)}, clustererShadow.mPchargeMap, TPCMapMemoryLayout<ChargeMapType>::items(GetProcessingSettings().overrideClusterizerFragmentLen) * sizeof(ChargeMapType));
-        runKernel<GPUMemClean16>({GetGridAutoStep(lane, RecoStep::TPCClusterFinding)}, clustererShadow.mPpeakMap, TPCMapMemoryLayout<PeakMapType>::items(GetProcessingSettings().overrideClusterizerFragmentLen) * sizeof(PeakMapType));
+        if (!mapsClean[lane]) {
+          runKernel<GPUMemClean16>({GetGridAutoStep(lane, RecoStep::TPCClusterFinding)}, clustererShadow.mPchargeMap, TPCMapMemoryLayout<ChargeMapType>::items(GetProcessingSettings().overrideClusterizerFragmentLen) * sizeof(ChargeMapType));
+          runKernel<GPUMemClean16>({GetGridAutoStep(lane, RecoStep::TPCClusterFinding)}, clustererShadow.mPpeakMap, TPCMapMemoryLayout<PeakMapType>::items(GetProcessingSettings().overrideClusterizerFragmentLen) * sizeof(PeakMapType));
+        }
+        mapsClean[lane] = 0;
         if (fragment.index == 0) {
           runKernel<GPUMemClean16>({GetGridAutoStep(lane, RecoStep::TPCClusterFinding)}, clustererShadow.mPpadIsNoisy, TPC_PADS_IN_SECTOR * sizeof(*clustererShadow.mPpadIsNoisy));
         }
@@ -861,7 +886,15 @@ int GPUChainTracking::RunTPCClusterizer(bool synchronizeOutput)
           transferRunning[lane] = 2;
         }
 
+        const size_t nMapItems = TPCMapMemoryLayout<decltype(*clustererShadow.mPchargeMap)>::items(GetProcessingSettings().overrideClusterizerFragmentLen);
+        const bool sparseMapReset = clusterer.mPmemory->counters.nPositions < GetProcessingSettings().tpccfSparseMapReset * nMapItems;
         if (clusterer.mPmemory->counters.nClusters == 0) {
+          if (sparseMapReset) {
+            if (clusterer.mPmemory->counters.nPositions) {
+              runKernel<GPUTPCCFChargeMapFiller, GPUTPCCFChargeMapFiller::resetMaps>({GetGrid(clusterer.mPmemory->counters.nPositions, lane), {iSlice}});
+            }
+            mapsClean[lane] = 1;
+          }
           continue;
         }
 
@@ -876,6 +909,10 @@ int GPUChainTracking::RunTPCClusterizer(bool synchronizeOutput)
           }
           runKernel<GPUTPCCFClusterizer>({GetGrid(clusterer.mPmemory->counters.nClusters, lane, GPUReconstruction::krnlDeviceType::CPU), {iSlice}}, 1);
         }
+        if (sparseMapReset) {
+          runKernel<GPUTPCCFChargeMapFiller, GPUTPCCFChargeMapFiller::resetMaps>({GetGrid(clusterer.mPmemory->counters.nPositions, lane), {iSlice}});
+          mapsClean[lane] = 1;
+        }
         if (GetProcessingSettings().debugLevel >= 3) {
           GPUInfo("Sector %02d Fragment %02d Lane %d: Found clusters: digits %u peaks %u clusters %u", iSlice, fragment.index, lane, (int)clusterer.mPmemory->counters.nPositions, (int)clusterer.mPmemory->counters.nPeaks, (int)clusterer.mPmemory->counters.nClusters);
         }
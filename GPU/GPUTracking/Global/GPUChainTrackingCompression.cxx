@@ -17,6 +17,8 @@
 #include "GPUO2DataTypes.h"
 #include "GPUTrackingInputProvider.h"
 #include <numeric>
+#include <vector>
+#include <cstring>
 
 #ifdef GPUCA_HAVE_O2HEADERS
 #include "GPUTPCCFChainContext.h"
@@ -217,7 +219,7 @@ int GPUChainTracking::RunTPCDecompression()
     };
     auto& gatherTimer = getTimer<TPCClusterDecompressor>("TPCDecompression", 0);
     gatherTimer.Start();
-    if (decomp.decompress(mIOPtrs.tpcCompressedClusters, *mClusterNativeAccess, allocator, param(), GetProcessingSettings().deterministicGPUReconstruction)) {
+    if (decomp.decompress(mIOPtrs.tpcCompressedClusters, *mClusterNativeAccess, allocator, param(), GetProcessingSettings().deterministicGPUReconstruction, processors()->calibObjects.fastTransform)) {
       GPUError("Error decompressing clusters");
       return 1;
     }
@@ -252,7 +254,7 @@ int GPUChainTracking::RunTPCDecompression()
     inputGPU.nTracks = cmprClsHost.nTracks;
     inputGPU.nAttachedClustersReduced = inputGPU.nAttachedClusters - inputGPU.nTracks;
     inputGPU.nSliceRows = NSLICES * GPUCA_ROW_COUNT;
-    inputGPU.nComppressionModes = param().rec.tpc.compressionTypeMask;
+    inputGPU.nComppressionModes = cmprClsHost.nComppressionModes; // decode with the modes used for the encoding, as the CPU decoder
     inputGPU.solenoidBz = param().bzkG;
     inputGPU.maxTimeBin = param().par.continuousMaxTimeBin;
     SetupGPUProcessor(&Decompressor, true);
@@ -378,6 +380,33 @@ int GPUChainTracking::RunTPCDecompression()
         }
       }
     }
+    if (GetProcessingSettings().tpcDecompressionBenchmarkCPU) { // decode the same input with the CPU decoder, to compare timing and output
+      std::vector<ClusterNative> clustersCPU;
+      ClusterNativeAccess accessCPU;
+      auto allocator = [&clustersCPU](size_t size) {
+        clustersCPU.resize(size);
+        return clustersCPU.data();
+      };
+      auto& cpuTimer = getTimer<TPCClusterDecompressor>("TPCDecompressionCPUBenchmark", 0);
+      cpuTimer.Start();
+      if (TPCClusterDecompressor::decompress(mIOPtrs.tpcCompressedClusters, accessCPU, allocator, param(), GetProcessingSettings().deterministicGPUReconstruction, processors()->calibObjects.fastTransform)) {
+        GPUError("Error decompressing clusters on the CPU");
+        return 1;
+      }
+      cpuTimer.Stop();
+      const ClusterNativeAccess* decoded = mIOPtrs.clustersNative;
+      unsigned int nBadRows = 0;
+      for (unsigned int i = 0; i < NSLICES; i++) {
+        for (unsigned int j = 0; j < GPUCA_ROW_COUNT; j++) {
+          if (accessCPU.nClusters[i][j] != decoded->nClusters[i][j]) {
+            nBadRows++;
+          } else if (GetProcessingSettings().deterministicGPUReconstruction && memcmp(accessCPU.clusters[i][j], decoded->clusters[i][j], decoded->nClusters[i][j] * sizeof(ClusterNative))) {
+            nBadRows++; // the order within a row is only defined for the deterministic reconstruction
+          }
+        }
+      }
+      GPUInfo("TPC decompression CPU benchmark: %u clusters decoded in %f s, %u / %u sector rows differ from the %s decoding", (unsigned int)accessCPU.nClustersTotal, cpuTimer.GetElapsedTime(), nBadRows, NSLICES * GPUCA_ROW_COUNT, doGPU ? "GPU" : "kernel-based CPU");
+    }
     mRec->PopNonPersistentMemory(RecoStep::TPCDecompression, qStr2Tag("TPCDCMPR"));
   }
 #endif
@@ -167,6 +167,39 @@ void GPUChainTracking::PrintMemoryStatistics()
   }
 }
 
+void GPUChainTracking::UpdateAdaptiveMemoryScalers(bool error)
+{
+  GPUMemorySizeScalers* scalers = mRec->MemoryScalers();
+  if (error) {
+    if (scalers->resetAdaptiveFactors()) {
+      scalers->adaptiveFallback = true;
+      GPUWarning("Error with tightened memory estimates, reverting to the static ones");
+    }
+    return;
+  }
+  for (int i = 0; i < NSLICES; i++) {
+#ifdef GPUCA_TPC_GEOMETRY_O2
+    if (GetRecoSteps() & RecoStep::TPCClusterFinding) {
+      scalers->addAdaptiveUsage(GPUMemorySizeScalers::tpcPeaksScaler, processors()->tpcClusterer[i].mPmemory->counters.nPeaks, processors()->tpcClusterer[i].mNMaxPeaks);
+      scalers->addAdaptiveUsage(GPUMemorySizeScalers::tpcSectorClustersScaler, processors()->tpcClusterer[i].mPmemory->counters.nClusters, processors()->tpcClusterer[i].mNMaxClusters);
+    }
+#endif
+    scalers->addAdaptiveUsage(GPUMemorySizeScalers::tpcStartHitsScaler, *processors()->tpcTrackers[i].NStartHits(), processors()->tpcTrackers[i].NMaxStartHits());
+    scalers->addAdaptiveUsage(GPUMemorySizeScalers::tpcTrackletsScaler, *processors()->tpcTrackers[i].NTracklets(), processors()->tpcTrackers[i].NMaxTracklets());
+    scalers->addAdaptiveUsage(GPUMemorySizeScalers::tpcTrackletHitsScaler, *processors()->tpcTrackers[i].NRowHits(), processors()->tpcTrackers[i].NMaxRowHits());
+    scalers->addAdaptiveUsage(GPUMemorySizeScalers::tpcSectorTracksScaler, *processors()->tpcTrackers[i].NTracks(), processors()->tpcTrackers[i].NMaxTracks());
+    scalers->addAdaptiveUsage(GPUMemorySizeScalers::tpcSectorTrackHitsScaler, *processors()->tpcTrackers[i].NTrackHits(), processors()->tpcTrackers[i].NMaxTrackHits());
+  }
+  scalers->addAdaptiveUsage(GPUMemorySizeScalers::tpcMergedTracksScaler, processors()->tpcMerger.NOutputTracks(), processors()->tpcMerger.NMaxTracks());
+  scalers->addAdaptiveUsage(GPUMemorySizeScalers::tpcMergedTrackHitsScaler, processors()->tpcMerger.NOutputTrackClusters(), processors()->tpcMerger.NMaxOutputTrackClusters());
+  scalers->updateAdaptiveFactors(GetProcessingSettings().memoryScalingAdaptive, GetProcessingSettings().memoryScalingAdaptiveMargin);
+  if (GetProcessingSettings().debugLevel >= 3) {
+    for (unsigned int i = 0; i < GPUMemorySizeScalers::nAdaptiveScalers; i++) {
+      GPUInfo("Adaptive memory scaling factor %u: %f", i, scalers->adaptiveFactor[i]);
+    }
+  }
+}
+
 void GPUChainTracking::PrintMemoryRelations()
 {
   for (int i = 0; i < NSLICES; i++) {
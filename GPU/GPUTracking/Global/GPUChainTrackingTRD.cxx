@@ -51,35 +51,40 @@ int GPUChainTracking::RunTRDTracking()
   mRec->PushNonPersistentMemory(qStr2Tag("TRDTRACK"));
   SetupGPUProcessor(&Tracker, true);
 
+  bool loadTracksOnGPU = false;
   if constexpr (I == GPUTRDTrackerKernels::gpuVersion) {
-    for (unsigned int i = 0; i < mIOPtrs.nMergedTracks; i++) {
-      const GPUTPCGMMergedTrack& trk = mIOPtrs.mergedTracks[i];
-      if (!Tracker.PreCheckTrackTRDCandidate(trk)) {
-        continue;
-      }
-      const GPUTRDTrackGPU& trktrd = param().rec.tpc.nWaysOuter ? (GPUTRDTrackGPU)trk.OuterParam() : (GPUTRDTrackGPU)trk;
-      if (!Tracker.CheckTrackTRDCandidate(trktrd)) {
-        continue;
-      }
-      GPUTRDTrackerGPU::HelperTrackAttributes trkAttribs, *trkAttribsPtr{nullptr};
-      if (!isTriggeredEvent) {
-        const float tpcTBinMUS = 0.199606f;
-        trkAttribs.mTime = trk.GetParam().GetTZOffset() * tpcTBinMUS;
-        trkAttribs.mTimeAddMax = 50.f; // half of a TPC drift time in us
-        trkAttribs.mTimeSubMax = 50.f; // half of a TPC drift time in us
-        if (!trk.CCE()) {
-          if (trk.CSide()) {
-            // track has only C-side clusters
-            trkAttribs.mSide = 1;
-          } else {
-            // track has only A-side clusters
-            trkAttribs.mSide = -1;
+    // with the TPC merger on the GPU, the TRD tracker can take the merged tracks directly from GPU memory
+    loadTracksOnGPU = GetProcessingSettings().trdLoadTracksOnGPU && (GetRecoStepsGPU() & RecoStep::TRDTracking) && (GetRecoStepsGPU() & RecoStep::TPCMerging);
+    if (!loadTracksOnGPU) {
+      for (unsigned int i = 0; i < mIOPtrs.nMergedTracks; i++) {
+        const GPUTPCGMMergedTrack& trk = mIOPtrs.mergedTracks[i];
+        if (!Tracker.PreCheckTrackTRDCandidate(trk)) {
+          continue;
+        }
+        const GPUTRDTrackGPU& trktrd = param().rec.tpc.nWaysOuter ? (GPUTRDTrackGPU)trk.OuterParam() : (GPUTRDTrackGPU)trk;
+        if (!Tracker.CheckTrackTRDCandidate(trktrd)) {
+          continue;
+        }
+        GPUTRDTrackerGPU::HelperTrackAttributes trkAttribs, *trkAttribsPtr{nullptr};
+        if (!isTriggeredEvent) {
+          const float tpcTBinMUS = 0.199606f;
+          trkAttribs.mTime = trk.GetParam().GetTZOffset() * tpcTBinMUS;
+          trkAttribs.mTimeAddMax = 50.f; // half of a TPC drift time in us
+          trkAttribs.mTimeSubMax = 50.f; // half of a TPC drift time in us
+          if (!trk.CCE()) {
+            if (trk.CSide()) {
+              // track has only C-side clusters
+              trkAttribs.mSide = 1;
+            } else {
+              // track has only A-side clusters
+              trkAttribs.mSide = -1;
+            }
           }
+          trkAttribsPtr = &trkAttribs;
+        }
+        if (Tracker.LoadTrack(trktrd, i, false, trkAttribsPtr)) {
+          return 1;
         }
-        trkAttribsPtr = &trkAttribs;
-      }
-      if (Tracker.LoadTrack(trktrd, i, false, trkAttribsPtr)) {
-        return 1;
       }
     }
   } else {
@@ -115,7 +120,7 @@ int GPUChainTracking::RunTRDTracking()
 #endif
   }
 
-  DoTRDGPUTracking<I>();
+  DoTRDGPUTracking<I>(nullptr, loadTracksOnGPU);
 
   mIOPtrs.nTRDTracks = Tracker.NTracks();
   if constexpr (I == GPUTRDTrackerKernels::gpuVersion) {
@@ -134,7 +139,7 @@ int GPUChainTracking::RunTRDTracking()
 }
 
 template <int I, class T>
-int GPUChainTracking::DoTRDGPUTracking(T* externalInstance)
+int GPUChainTracking::DoTRDGPUTracking(T* externalInstance, bool loadTracksOnGPU)
 {
 #ifdef GPUCA_HAVE_O2HEADERS
   bool doGPU = GetRecoStepsGPU() & RecoStep::TRDTracking;
@@ -185,7 +190,23 @@ int GPUChainTracking::DoTRDGPUTracking(T* externalInstance)
     WriteToConstantMemory(RecoStep::TRDTracking, (char*)&processors()->trdTrackerGPU - (char*)processors(), TrackerShadow, sizeof(*TrackerShadow), useStream);
   }
 
-  TransferMemoryResourcesToGPU(RecoStep::TRDTracking, Tracker, useStream);
+  if (loadTracksOnGPU) {
+    if constexpr (I == GPUTRDTrackerKernels::gpuVersion) {
+      // only the tracklet data is uploaded, the tracks are loaded on the GPU and only their number is transferred back
+      TransferMemoryResourceLinkToGPU(RecoStep::TRDTracking, Tracker->MemoryTracklets(), useStream);
+      *Tracker->TrackCounter() = 0;
+      GPUMemCpy(RecoStep::TRDTracking, TrackerShadow->TrackCounter(), Tracker->TrackCounter(), sizeof(*Tracker->TrackCounter()), useStream, true);
+      runKernel<GPUTRDTrackerLoadTracks>(GetGridAuto(useStream));
+      GPUMemCpy(RecoStep::TRDTracking, Tracker->TrackCounter(), TrackerShadow->TrackCounter(), sizeof(*Tracker->TrackCounter()), useStream, false);
+      SynchronizeStream(useStream);
+      unsigned int nTracks = *Tracker->TrackCounter();
+      Tracker->SetNTracks(nTracks);
+      TrackerShadow->SetNTracks(nTracks);
+      WriteToConstantMemory(RecoStep::TRDTracking, (char*)&processors()->trdTrackerGPU - (char*)processors(), TrackerShadow, sizeof(*TrackerShadow), useStream);
+    }
+  } else {
+    TransferMemoryResourcesToGPU(RecoStep::TRDTracking, Tracker, useStream);
+  }
   runKernel<GPUTRDTrackerKernels, I>(GetGridAuto(useStream), externalInstance ? Tracker : nullptr);
   TransferMemoryResourcesToHost(RecoStep::TRDTracking, Tracker, useStream);
   SynchronizeStream(useStream);
@@ -198,8 +219,8 @@ int GPUChainTracking::DoTRDGPUTracking(T* externalInstance)
 }
 
 template int GPUChainTracking::RunTRDTracking<GPUTRDTrackerKernels::gpuVersion>();
-template int GPUChainTracking::DoTRDGPUTracking<GPUTRDTrackerKernels::gpuVersion>(GPUTRDTrackerGPU*);
-template int GPUChainTracking::DoTRDGPUTracking<GPUTRDTrackerKernels::gpuVersion>(GPUTRDTracker*);
+template int GPUChainTracking::DoTRDGPUTracking<GPUTRDTrackerKernels::gpuVersion>(GPUTRDTrackerGPU*, bool);
+template int GPUChainTracking::DoTRDGPUTracking<GPUTRDTrackerKernels::gpuVersion>(GPUTRDTracker*, bool);
 template int GPUChainTracking::RunTRDTracking<GPUTRDTrackerKernels::o2Version>();
-template int GPUChainTracking::DoTRDGPUTracking<GPUTRDTrackerKernels::o2Version>(GPUTRDTracker*);
-template int GPUChainTracking::DoTRDGPUTracking<GPUTRDTrackerKernels::o2Version>(GPUTRDTrackerGPU*);
+template int GPUChainTracking::DoTRDGPUTracking<GPUTRDTrackerKernels::o2Version>(GPUTRDTracker*, bool);
+template int GPUChainTracking::DoTRDGPUTracking<GPUTRDTrackerKernels::o2Version>(GPUTRDTrackerGPU*, bool);
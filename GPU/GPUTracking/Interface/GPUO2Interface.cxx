@@ -56,7 +56,7 @@ int GPUO2Interface::Initialize(const GPUO2InterfaceConfiguration& config)
     return (1);
   }
   mConfig.reset(new GPUO2InterfaceConfiguration(config));
-  mNContexts = mConfig->configProcessing.doublePipeline ? 2 : 1;
+  mNContexts = mConfig->configProcessing.doublePipeline ? mConfig->configProcessing.doublePipelineDepth : 1;
   mCtx.reset(new GPUO2Interface_processingContext[mNContexts]);
   if (mConfig->configWorkflow.inputs.isSet(GPUDataTypes::InOutType::TPCRaw)) {
     mConfig->configGRP.needsClusterer = 1;
@@ -207,6 +207,21 @@ int GPUO2Interface::RunTracking(GPUTrackingInOutPointers* data, GPUInterfaceOutp
   }
 
   int retVal = mCtx[iThread].mRec->RunChains();
+  if (mCtx[iThread].mRec->MemoryScalers()->adaptiveFallback) {
+    // The TF failed with tightened memory estimates, process it again with the static ones if the outputs can be rewritten
+    mCtx[iThread].mRec->MemoryScalers()->adaptiveFallback = false;
+    bool outputsReusable = !inputUpdateCallback && !mConfig->configProcessing.doublePipeline;
+    for (unsigned int i = 0; outputsReusable && mConfig->configInterface.outputToExternalBuffers && i < mCtx[iThread].mOutputRegions->count(); i++) {
+      outputsReusable = outputs->asArray()[i].allocator == nullptr;
+    }
+    if (retVal == 3 && outputsReusable) {
+      GPUInfo("Reprocessing TF with the static memory estimates");
+      mCtx[iThread].mChain->mIOPtrs = *data;
+      setOutputs(outputs);
+      retVal = mCtx[iThread].mRec->RunChains();
+      mCtx[iThread].mRec->MemoryScalers()->adaptiveFallback = false;
+    }
+  }
   if (retVal == 2) {
     retVal = 0; // 2 signals end of event display, ignore
   }
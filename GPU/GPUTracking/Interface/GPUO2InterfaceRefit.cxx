@@ -21,11 +21,12 @@
 #include "GPUTrackingRefit.h"
 #include "CorrectionMapsHelper.h"
 #include "GPUTPCClusterOccupancyMap.h"
+#include <atomic>
 
 using namespace o2::gpu;
 using namespace o2::tpc;
 
-void GPUO2InterfaceRefit::fillSharedClustersAndOccupancyMap(const ClusterNativeAccess* cl, const gsl::span<const TrackTPC> trks, const TPCClRefElem* trackRef, unsigned char* shmap, unsigned int* ocmap, unsigned int nHbfPerTf, const GPUParam* param)
+void GPUO2InterfaceRefit::fillSharedClustersAndOccupancyMap(const ClusterNativeAccess* cl, const gsl::span<const TrackTPC> trks, const TPCClRefElem* trackRef, unsigned char* shmap, unsigned int* ocmap, unsigned int nHbfPerTf, const GPUParam* param, int nThreads)
 {
   if (!cl || (!shmap && cl->nClustersTotal > 0)) {
     throw std::runtime_error("Must provide clusters access and preallocated buffer for shared map");
@@ -38,11 +39,22 @@ void GPUO2InterfaceRefit::fillSharedClustersAndOccupancyMap(const ClusterNativeA
   if ((param->rec.tpc.occupancyMapTimeBins || param->rec.tpc.sysClusErrorC12Norm) && ocmap && !nHbfPerTf) {
     throw std::runtime_error("Must provide nHbfPerTf for occupancy map");
   }
+  if (nThreads < 1) {
+    nThreads = 1;
+  }
   memset(shmap, 0, sizeof(char) * cl->nClustersTotal);
-  for (unsigned int i = 0; i < trks.size(); i++) {
+  // 1 for the first track attaching the cluster, 2 for the next ones, so that the result does not depend on the order of the tracks
+  const unsigned int nTracks = trks.size();
+  // clang-format off
+  GPUCA_OPENMP(parallel for schedule(dynamic, 256) num_threads(nThreads))
+  // clang-format on
+  for (unsigned int i = 0; i < nTracks; i++) {
     for (int j = 0; j < trks[i].getNClusterReferences(); j++) {
       size_t idx = &trks[i].getCluster(trackRef, j, *cl) - cl->clustersLinear;
-      shmap[idx] = shmap[idx] ? 2 : 1;
+      std::atomic_ref<unsigned char> sh(shmap[idx]);
+      if (sh.exchange(1, std::memory_order_relaxed)) {
+        sh.store(2, std::memory_order_relaxed);
+      }
     }
   }
   std::vector<unsigned int> tmp;
@@ -56,15 +68,22 @@ void GPUO2InterfaceRefit::fillSharedClustersAndOccupancyMap(const ClusterNativeA
     }
   }
 
+  // clang-format off
+  GPUCA_OPENMP(parallel for num_threads(nThreads))
+  // clang-format on
   for (unsigned int i = 0; i < cl->nClustersTotal; i++) {
     shmap[i] = (shmap[i] > 1 ? GPUTPCGMMergedTrackHit::flagShared : 0) | cl->clustersLinear[i].getFlags();
     if (binmap) {
-      binmap[(unsigned int)(cl->clustersLinear[i].getTime() / param->rec.tpc.occupancyMapTimeBins)]++;
+      std::atomic_ref<unsigned int>(binmap[(unsigned int)(cl->clustersLinear[i].getTime() / param->rec.tpc.occupancyMapTimeBins)]).fetch_add(1, std::memory_order_relaxed);
     }
   }
 
   if (ocmap && nHbfPerTf && param->rec.tpc.occupancyMapTimeBinsAverage) {
-    for (unsigned int bin = 0; bin < GPUTPCClusterOccupancyMapBin::getNBins(*param); bin++) {
+    const unsigned int nBins = GPUTPCClusterOccupancyMapBin::getNBins(*param);
+    // clang-format off
+    GPUCA_OPENMP(parallel for num_threads(nThreads))
+    // clang-format on
+    for (unsigned int bin = 0; bin < nBins; bin++) {
       int binmin = CAMath::Max<int>(0, bin - param->rec.tpc.occupancyMapTimeBinsAverage);
       int binmax = CAMath::Min<int>(GPUTPCClusterOccupancyMapBin::getNBins(*param), bin + param->rec.tpc.occupancyMapTimeBinsAverage + 1);
       unsigned int sum = 0;
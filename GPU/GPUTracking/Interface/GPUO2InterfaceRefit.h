@@ -87,7 +87,8 @@ class GPUO2InterfaceRefit
   // If the param object / default object requires an occupancy map, an occupancy map ptr and nHbfPerTf value must be provided.
   // You can use the function fillOccupancyMapGetSize(...) to get the required size of the occupancy map. If 0 is returned, no map is required.
   // Providing only the shmap ptr but no ocmap ptr will create only the shared map, but no occupancy map.
-  static void fillSharedClustersAndOccupancyMap(const o2::tpc::ClusterNativeAccess* cl, const gsl::span<const o2::tpc::TrackTPC> trks, const o2::tpc::TPCClRefElem* trackRef, unsigned char* shmap, unsigned int* ocmap = nullptr, unsigned int nHbfPerTf = 0, const GPUParam* param = nullptr);
+  // The maps are filled with nThreads OpenMP threads, if available, the result does not depend on it.
+  static void fillSharedClustersAndOccupancyMap(const o2::tpc::ClusterNativeAccess* cl, const gsl::span<const o2::tpc::TrackTPC> trks, const o2::tpc::TPCClRefElem* trackRef, unsigned char* shmap, unsigned int* ocmap = nullptr, unsigned int nHbfPerTf = 0, const GPUParam* param = nullptr, int nThreads = 1);
   static size_t fillOccupancyMapGetSize(unsigned int nHbfPerTf, const GPUParam* param = nullptr);
 
  private:
@@ -265,7 +265,7 @@ void* GPUTPCGMMerger::SetPointersMerger(void* mem)
     computePointerWithAlignment(mem, mGlobalClusterIDs, mNMaxOutputTrackClusters);
   }
   if (mRec->GetProcessingSettings().deterministicGPUReconstruction) {
-    computePointerWithAlignment(mem, mTmpSortMemory, std::max(mNTotalSliceTracks, mNMaxTracks * 2));
+    computePointerWithAlignment(mem, mTmpSortMemory, std::max(mNTotalSliceTracks * 2, mNMaxTracks * 2)); // sectorTracks: permutation + inverse track id lookup
   }
 
   void* memBase = mem;
@@ -146,6 +146,7 @@ class GPUTPCGMMerger : public GPUProcessor
   GPUhdi() unsigned int NOutputClusRefsTPCO2() const { return mMemory->nO2ClusRefs; }
   GPUhdi() GPUTPCGMSliceTrack* SliceTrackInfos() { return mSliceTrackInfos; }
   GPUhdi() int NMaxSingleSliceTracks() const { return mNMaxSingleSliceTracks; }
+  GPUhdi() unsigned int NTotalSliceTracks() const { return mNTotalSliceTracks; }
   GPUhdi() int* TrackIDs() { return mTrackIDs; }
   GPUhdi() int* TmpSortMemory() { return mTmpSortMemory; }
 
@@ -49,36 +49,49 @@ GPUdii() void GPUTPCGlobalDebugSortKernels::Thread<GPUTPCGlobalDebugSortKernels:
     for (int j = 0; j < n; j++) {
       tmp[j] = j;
     }
+    // the index breaks ties, making the key unique: the result does not depend on the sort algorithm
     GPUCommonAlgorithm::sort(tmp, tmp + n, [&merger, offset](const int& aa, const int& bb) {
       const auto& a = merger.SliceTrackInfos()[offset + aa];
       const auto& b = merger.SliceTrackInfos()[offset + bb];
       return (a.X() != b.X()) ? (a.X() < b.X()) : (a.Y() != b.Y()) ? (a.Y() < b.Y())
-                                                                   : (a.Z() < b.Z());
+                                                : (a.Z() != b.Z()) ? (a.Z() < b.Z())
+                                                                   : (aa < bb);
     });
+    // inverse of the track ids of this slice, built in a single pass instead of searching the ids for every moved track
+    int* GPUrestrict() trackIDIndex = merger.TmpSortMemory() + merger.NTotalSliceTracks() + offset;
+    if (!parameter) {
+      for (int j = 0; j < n; j++) {
+        trackIDIndex[j] = -1;
+      }
+      const int kEnd = merger.NMaxSingleSliceTracks();
+      for (int k = 0; k < kEnd; k++) {
+        const int id = merger.TrackIDs()[i * merger.NMaxSingleSliceTracks() + k];
+        if (id >= offset && id < offset + n) {
+          trackIDIndex[id - offset] = k;
+        }
+      }
+    }
     for (int j = 0; j < n; j++) {
       if (tmp[j] >= 0 && tmp[j] != j) {
-        auto getTrackIDIndex = [&merger](const int iSlice, const int iTrack) {
-          const int kEnd = merger.NMaxSingleSliceTracks();
-          for (int k = 0; k < kEnd; k++) {
-            if (merger.TrackIDs()[iSlice * merger.NMaxSingleSliceTracks() + k] == iTrack) {
-              return k;
-            }
-          }
+        auto getTrackIDIndex = [trackIDIndex](const int iTrack) {
+          const int k = trackIDIndex[iTrack];
 #ifndef GPUCA_GPUCODE_DEVICE
-          throw std::runtime_error("Internal error, track id missing");
+          if (k < 0) {
+            throw std::runtime_error("Internal error, track id missing");
+          }
 #endif
-          return -1;
+          return k;
         };
         int firstIdx = j;
         auto firstItem = merger.SliceTrackInfos()[offset + firstIdx];
-        int firstTrackIDIndex = parameter ? 0 : getTrackIDIndex(i, offset + firstIdx);
+        int firstTrackIDIndex = parameter ? 0 : getTrackIDIndex(firstIdx);
         int currIdx = firstIdx;
         int sourceIdx = tmp[currIdx];
         do {
           tmp[currIdx] = -1;
           merger.SliceTrackInfos()[offset + currIdx] = merger.SliceTrackInfos()[offset + sourceIdx];
           if (!parameter) {
-            merger.TrackIDs()[i * merger.NMaxSingleSliceTracks() + getTrackIDIndex(i, offset + sourceIdx)] = offset + currIdx;
+            merger.TrackIDs()[i * merger.NMaxSingleSliceTracks() + getTrackIDIndex(sourceIdx)] = offset + currIdx;
           }
           currIdx = sourceIdx;
           sourceIdx = tmp[currIdx];
@@ -107,7 +120,7 @@ GPUdii() void GPUTPCGlobalDebugSortKernels::Thread<GPUTPCGlobalDebugSortKernels:
   GPUCommonAlgorithm::sortDeviceDynamic(tmp, tmp + n, [&merger](const int& aa, const int& bb) {
     const GPUTPCGMMergedTrack& a = merger.OutputTracks()[aa];
     const GPUTPCGMMergedTrack& b = merger.OutputTracks()[bb];
-    return (a.GetAlpha() != b.GetAlpha()) ? (a.GetAlpha() < b.GetAlpha()) : (a.GetParam().GetX() != b.GetParam().GetX()) ? (a.GetParam().GetX() < b.GetParam().GetX()) : (a.GetParam().GetY() != b.GetParam().GetY()) ? (a.GetParam().GetY() < b.GetParam().GetY()) : (a.GetParam().GetZ() < b.GetParam().GetZ());
+    return (a.GetAlpha() != b.GetAlpha()) ? (a.GetAlpha() < b.GetAlpha()) : (a.GetParam().GetX() != b.GetParam().GetX()) ? (a.GetParam().GetX() < b.GetParam().GetX()) : (a.GetParam().GetY() != b.GetParam().GetY()) ? (a.GetParam().GetY() < b.GetParam().GetY()) : (a.GetParam().GetZ() != b.GetParam().GetZ()) ? (a.GetParam().GetZ() < b.GetParam().GetZ()) : (aa < bb);
   });
 }
 
@@ -129,9 +129,15 @@ GPUdi() void GPUTPCSliceData::CreateGrid(GPUconstantref() const MEM_CONSTANT(GPU
     tfFactor = dz / GPUTPCGeometry::TPCLength();
     dz = GPUTPCGeometry::TPCLength();
   }
-  const float norm = CAMath::InvSqrt(row->mNHits / tfFactor);
-  float sy = CAMath::Min(CAMath::Max((yMax - yMin) * norm, GPUCA_MIN_BIN_SIZE), GPUCA_MAX_BIN_SIZE);
-  float sz = CAMath::Min(CAMath::Max(dz * norm, GPUCA_MIN_BIN_SIZE), GPUCA_MAX_BIN_SIZE);
+  // bin size from the occupancy of the row, for the requested average number of hits per bin
+  const float norm = CAMath::InvSqrt(row->mNHits / (tfFactor * mem->param.rec.tpc.sliceDataGridHitsPerBin));
+  float minBinSize = GPUCA_MIN_BIN_SIZE;
+  if (mem->param.rec.tpc.sliceDataGridMaxBinsPerSearchArea > 0.f) {
+    // in high-occupancy rows, avoid that the neighbours finder loops over many (almost) empty bins per search area
+    minBinSize = CAMath::Max(minBinSize, 2.f * mem->param.rec.tpc.neighboursSearchArea / mem->param.rec.tpc.sliceDataGridMaxBinsPerSearchArea);
+  }
+  float sy = CAMath::Min(CAMath::Max((yMax - yMin) * norm, minBinSize), GPUCA_MAX_BIN_SIZE);
+  float sz = CAMath::Min(CAMath::Max(dz * norm, minBinSize), GPUCA_MAX_BIN_SIZE);
   int maxy, maxz;
   GetMaxNBins(mem, row, maxy, maxz);
   int ny = CAMath::Max(1, CAMath::Min<int>(maxy, (yMax - yMin) / sy + 1));
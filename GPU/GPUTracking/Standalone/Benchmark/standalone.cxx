@@ -187,6 +187,10 @@ int ReadConfiguration(int argc, char** argv)
     printf("Cannot run asynchronous processing with double pipeline\n");
     return 1;
   }
+  if (configStandalone.proc.doublePipeline && configStandalone.proc.doublePipelineDepth != 2) {
+    printf("The standalone benchmark supports only a double pipeline depth of 2\n");
+    return 1;
+  }
   if (configStandalone.proc.doublePipeline && (configStandalone.runs < 4 || !configStandalone.outputcontrolmem)) {
     printf("Double pipeline mode needs at least 3 runs per event and external output. To cycle though multiple events, use --preloadEvents and --runs n for n iterations round-robin\n");
     return 1;
@@ -0,0 +1,54 @@
+#!/bin/bash
+# Per-kernel timing and OMP thread scaling of the CPU backend for a reference data dump.
+# Run in the standalone folder: tools/cpuScaling.sh [events] [thread counts] [additional options for ca]
+# e.g. tools/cpuScaling.sh o2-pbpb-50 "1 2 4 8 16 32 64" --runs 5 --PROCompKernelThreads "GPUTPCCFPeakFinder:16"
+
+EVENTS=${1:-pp}
+THREADS=${2:-"1 2 4 8 16 32"}
+shift 2 2> /dev/null
+OPTIONS="$@"
+CA=${CA:-./ca}
+
+OUT=$(mktemp -d)
+trap "rm -rf $OUT" EXIT
+
+for i in $THREADS; do
+  echo "Running with $i OMP threads"
+  $CA -c -e $EVENTS --omp $i --PROCompAutoNThreads 0 --debug 1 --runs 3 $OPTIONS > $OUT/$i.log 2>&1
+  if [ $? != 0 ]; then
+    echo "Error running $CA with $i threads, see output below"
+    tail -n 20 $OUT/$i.log
+    exit 1
+  fi
+  # Average the time of each kernel / step over all processed events, in us
+  sed -n -e 's/^Execution Time: Task (K *[0-9]*x): *\([^ ]*\) *Time: *\([0-9,]*\) us.*/\1 \2/p' \
+         -e 's/^Execution Time: Total *: *\(Total [A-Za-z]*\) *Time: *\([0-9,]*\) us.*/\1 \2/p' $OUT/$i.log |
+    tr -d ',' | sed 's/^Total /Total_/' |
+    awk '{ if (!($1 in n)) order[m++] = $1; t[$1] += $2; n[$1]++ } END { for (i = 0; i < m; i++) print order[i], t[order[i]] / n[order[i]] }' > $OUT/$i.txt
+done
+
+FIRST=$(echo $THREADS | awk '{print $1}')
+echo
+printf "%-60s" "Time per event [us] / OMP threads"
+for i in $THREADS; do
+  printf "%12s" $i
+done
+printf "%12s\n" "Speedup"
+awk -v threads="$THREADS" -v dir="$OUT" -v first="$FIRST" '
+  BEGIN {
+    nt = split(threads, th, " ")
+    for (j = 1; j <= nt; j++) {
+      file = dir "/" th[j] ".txt"
+      while ((getline line < file) > 0) {
+        split(line, f, " ")
+        if (!(f[1] in seen)) { seen[f[1]] = 1; order[m++] = f[1] }
+        t[f[1], j] = f[2]
+      }
+    }
+    for (i = 0; i < m; i++) {
+      k = order[i]
+      printf "%-60s", k
+      for (j = 1; j <= nt; j++) printf "%12.0f", t[k, j]
+      printf "%12.2f\n", (t[k, nt] > 0 ? t[k, 1] / t[k, nt] : 0)
+    }
+  }'
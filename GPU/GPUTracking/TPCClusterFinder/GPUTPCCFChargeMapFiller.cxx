@@ -90,6 +90,24 @@ GPUdii() void GPUTPCCFChargeMapFiller::Thread<GPUTPCCFChargeMapFiller::findFragm
   }
 }
 
+template <>
+GPUdii() void GPUTPCCFChargeMapFiller::Thread<GPUTPCCFChargeMapFiller::resetMaps>(int nBlocks, int nThreads, int iBlock, int iThread, GPUSharedMemory& smem, processorType& clusterer)
+{
+  // Only the entries at the positions of the fragment were written, clearing them leaves both maps empty
+  size_t idx = get_global_id(0);
+  if (idx >= clusterer.mPmemory->counters.nPositions) {
+    return;
+  }
+  ChargePos pos = clusterer.mPpositions[idx];
+  if (!pos.valid()) {
+    return;
+  }
+  Array2D<PackedCharge> chargeMap(reinterpret_cast<PackedCharge*>(clusterer.mPchargeMap));
+  Array2D<uchar> isPeakMap(clusterer.mPpeakMap);
+  chargeMap[pos] = PackedCharge(0);
+  isPeakMap[pos] = 0;
+}
+
 GPUd() size_t GPUTPCCFChargeMapFiller::findTransition(int time, const tpc::Digit* digits, size_t nDigits, size_t lower)
 {
   if (!nDigits) {
@@ -39,6 +39,7 @@ class GPUTPCCFChargeMapFiller : public GPUKernelTemplate
     fillIndexMap,
     fillFromDigits,
     findFragmentStart,
+    resetMaps,
   };
 
 #ifdef GPUCA_HAVE_O2HEADERS
@@ -98,11 +98,12 @@ void* GPUTRDTracker_t<TRDTRK, PROP>::SetPointersTracks(void* base)
   //--------------------------------------------------------------------
   computePointerWithAlignment(base, mTracks, mNMaxTracks);
   computePointerWithAlignment(base, mTrackAttribs, mNMaxTracks);
+  computePointerWithAlignment(base, mTrackCounter, 1);
   return base;
 }
 
 template <class TRDTRK, class PROP>
-GPUTRDTracker_t<TRDTRK, PROP>::GPUTRDTracker_t() : mR(nullptr), mIsInitialized(false), mGenerateSpacePoints(false), mProcessPerTimeFrame(false), mNAngleHistogramBins(25), mAngleHistogramRange(50), mMemoryPermanent(-1), mMemoryTracklets(-1), mMemoryTracks(-1), mNMaxCollisions(0), mNMaxTracks(0), mNMaxSpacePoints(0), mTracks(nullptr), mTrackAttribs(nullptr), mNCandidates(1), mNTracks(0), mNEvents(0), mMaxThreads(100), mTrackletIndexArray(nullptr), mHypothesis(nullptr), mCandidates(nullptr), mSpacePoints(nullptr), mGeo(nullptr), mRPhiA2(0), mRPhiB(0), mRPhiC2(0), mDyA2(0), mDyB(0), mDyC2(0), mAngleToDyA(0), mAngleToDyB(0), mAngleToDyC(0), mDebugOutput(false), mMaxEta(0.84f), mRoadZ(18.f), mZCorrCoefNRC(1.4f), mTPCVdrift(2.58f), mTPCTDriftOffset(0.f), mDebug(new GPUTRDTrackerDebug<TRDTRK>())
+GPUTRDTracker_t<TRDTRK, PROP>::GPUTRDTracker_t() : mR(nullptr), mIsInitialized(false), mGenerateSpacePoints(false), mProcessPerTimeFrame(false), mNAngleHistogramBins(25), mAngleHistogramRange(50), mMemoryPermanent(-1), mMemoryTracklets(-1), mMemoryTracks(-1), mNMaxCollisions(0), mNMaxTracks(0), mNMaxSpacePoints(0), mTracks(nullptr), mTrackAttribs(nullptr), mTrackCounter(nullptr), mNCandidates(1), mNTracks(0), mNEvents(0), mMaxThreads(100), mTrackletIndexArray(nullptr), mHypothesis(nullptr), mCandidates(nullptr), mSpacePoints(nullptr), mGeo(nullptr), mRPhiA2(0), mRPhiB(0), mRPhiC2(0), mDyA2(0), mDyB(0), mDyC2(0), mAngleToDyA(0), mAngleToDyB(0), mAngleToDyC(0), mDebugOutput(false), mMaxEta(0.84f), mRoadZ(18.f), mZCorrCoefNRC(1.4f), mTPCVdrift(2.58f), mTPCTDriftOffset(0.f), mDebug(new GPUTRDTrackerDebug<TRDTRK>())
 {
   //--------------------------------------------------------------------
   // Default constructor
@@ -344,6 +345,30 @@ GPUd() int GPUTRDTracker_t<TRDTRK, PROP>::LoadTrack(const TRDTRK& trk, unsigned
   return (0);
 }
 
+template <class TRDTRK, class PROP>
+GPUd() int GPUTRDTracker_t<TRDTRK, PROP>::LoadTrackAtomic(const TRDTRK& trk, unsigned int tpcTrackId, const HelperTrackAttributes* attribs)
+{
+  //--------------------------------------------------------------------
+  // Load a track concurrently with other threads, the number of loaded
+  // tracks is counted in mTrackCounter and must be set with SetNTracks()
+  // before the tracking
+  //--------------------------------------------------------------------
+  unsigned int iTrk = CAMath::AtomicAdd(mTrackCounter, 1u);
+  if (iTrk >= (unsigned int)mNMaxTracks) {
+    return (1);
+  }
+#ifdef GPUCA_ALIROOT_LIB
+  new (&mTracks[iTrk]) TRDTRK(trk); // We need placement new, since the class is virtual
+#else
+  mTracks[iTrk] = trk;
+#endif
+  mTracks[iTrk].setRefGlobalTrackIdRaw(tpcTrackId);
+  if (attribs) {
+    mTrackAttribs[iTrk] = *attribs;
+  }
+  return (0);
+}
+
 
 template <class TRDTRK, class PROP>
 GPUd() void GPUTRDTracker_t<TRDTRK, PROP>::DumpTracks()
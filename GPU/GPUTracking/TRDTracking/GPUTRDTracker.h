@@ -113,6 +113,7 @@ class GPUTRDTracker_t : public GPUProcessor
   GPUd() bool PreCheckTrackTRDCandidate(const GPUTPCGMMergedTrack& trk) const { return trk.OK() && !trk.Looper(); }
   GPUd() bool CheckTrackTRDCandidate(const TRDTRK& trk) const;
   GPUd() int LoadTrack(const TRDTRK& trk, unsigned int tpcTrackId, bool checkTrack = true, HelperTrackAttributes* attribs = nullptr);
+  GPUd() int LoadTrackAtomic(const TRDTRK& trk, unsigned int tpcTrackId, const HelperTrackAttributes* attribs = nullptr);
 
   GPUd() int GetCollisionIDs(int iTrk, int* collisionIds) const;
   GPUd() void DoTrackingThread(int iTrk, int threadId = 0);
@@ -150,6 +151,8 @@ class GPUTRDTracker_t : public GPUProcessor
 
   // output
   GPUd() int NTracks() const { return mNTracks; }
+  GPUd() void SetNTracks(int n) { mNTracks = n; }
+  GPUd() unsigned int* TrackCounter() const { return mTrackCounter; }
   GPUd() GPUTRDSpacePoint* SpacePoints() const { return mSpacePoints; }
   GPUd() TRDTRK* Tracks() const { return mTracks; }
   GPUd() void DumpTracks();
@@ -172,6 +175,7 @@ class GPUTRDTracker_t : public GPUProcessor
   int mNMaxSpacePoints;                    // max number of space points hold by the tracker (per event)
   TRDTRK* mTracks;                         // array of trd-updated tracks
   HelperTrackAttributes* mTrackAttribs;    // array with additional (transient) track attributes
+  unsigned int* mTrackCounter;             // number of tracks loaded by LoadTrackAtomic
   int mNCandidates;                        // max. track hypothesis per layer
   int mNTracks;                            // number of TPC tracks to be matched
   int mNEvents;                            // number of processed events
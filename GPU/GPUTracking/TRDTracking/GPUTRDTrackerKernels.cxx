@@ -42,6 +42,37 @@ GPUdii() void GPUTRDTrackerKernels::Thread(int nBlocks, int nThreads, int iBlock
   }
 }
 
+template <>
+GPUdii() void GPUTRDTrackerLoadTracks::Thread<0>(int nBlocks, int nThreads, int iBlock, int iThread, GPUsharedref() GPUSharedMemory& smem, processorType& processors)
+{
+  // same selection as for the host-side loading in GPUChainTracking::RunTRDTracking
+  auto& trdTracker = processors.getTRDTracker<GPUTRDTrackerKernels::gpuVersion>();
+  const auto& merger = processors.tpcMerger;
+  const bool isTriggeredEvent = (processors.param.par.continuousMaxTimeBin == 0);
+  for (unsigned int i = get_global_id(0); i < (unsigned int)merger.NOutputTracks(); i += get_global_size(0)) {
+    const GPUTPCGMMergedTrack& trk = merger.OutputTracks()[i];
+    if (!trdTracker.PreCheckTrackTRDCandidate(trk)) {
+      continue;
+    }
+    const GPUTRDTrackGPU& trktrd = processors.param.rec.tpc.nWaysOuter ? (GPUTRDTrackGPU)trk.OuterParam() : (GPUTRDTrackGPU)trk;
+    if (!trdTracker.CheckTrackTRDCandidate(trktrd)) {
+      continue;
+    }
+    GPUTRDTrackerGPU::HelperTrackAttributes trkAttribs, *trkAttribsPtr{nullptr};
+    if (!isTriggeredEvent) {
+      const float tpcTBinMUS = 0.199606f;
+      trkAttribs.mTime = trk.GetParam().GetTZOffset() * tpcTBinMUS;
+      trkAttribs.mTimeAddMax = 50.f; // half of a TPC drift time in us
+      trkAttribs.mTimeSubMax = 50.f; // half of a TPC drift time in us
+      if (!trk.CCE()) {
+        trkAttribs.mSide = trk.CSide() ? 1 : -1;
+      }
+      trkAttribsPtr = &trkAttribs;
+    }
+    trdTracker.LoadTrackAtomic(trktrd, i, trkAttribsPtr);
+  }
+}
+
 template GPUd() void GPUTRDTrackerKernels::Thread<0>(int nBlocks, int nThreads, int iBlock, int iThread, GPUsharedref() GPUSharedMemory& smem, processorType& processors, GPUTRDTrackerGPU* externalInstance);
 #ifdef GPUCA_HAVE_O2HEADERS
 template GPUd() void GPUTRDTrackerKernels::Thread<1>(int nBlocks, int nThreads, int iBlock, int iThread, GPUsharedref() GPUSharedMemory& smem, processorType& processors, GPUTRDTracker* externalInstance);
@@ -32,6 +32,15 @@ class GPUTRDTrackerKernels : public GPUKernelTemplate
   template <int iKernel = defaultKernel, class T>
   GPUd() static void Thread(int nBlocks, int nThreads, int iBlock, int iThread, GPUsharedref() GPUSharedMemory& smem, processorType& processors, T* externalInstance = nullptr);
 };
+
+// Selects the TRD track candidates among the merged TPC tracks in GPU memory and loads them into the GPU TRD tracker
+class GPUTRDTrackerLoadTracks : public GPUKernelTemplate
+{
+ public:
+  GPUhdi() CONSTEXPR static GPUDataTypes::RecoStep GetRecoStep() { return GPUCA_RECO_STEP::TRDTracking; }
+  template <int iKernel = defaultKernel>
+  GPUd() static void Thread(int nBlocks, int nThreads, int iBlock, int iThread, GPUsharedref() GPUSharedMemory& smem, processorType& processors);
+};
 } // namespace gpu
 } // namespace GPUCA_NAMESPACE
 
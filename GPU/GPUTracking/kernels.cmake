@@ -96,6 +96,7 @@ o2_gpu_add_kernel("GPUTPCGMO2Output, output"                          "= TPCMERG
 o2_gpu_add_kernel("GPUTPCGMO2Output, mc"                              "= TPCMERGER"                                           NO      simple)
 o2_gpu_add_kernel("GPUTRDTrackerKernels, gpuVersion"                  "= TRDTRACKER MATLUT TPCMERGER"                         LB      simple GPUTRDTrackerGPU* externalInstance)
 o2_gpu_add_kernel("GPUTRDTrackerKernels, o2Version"                   "= TRDTRACKER MATLUT O2PROPAGATOR"                      LB      simple GPUTRDTracker* externalInstance)
+o2_gpu_add_kernel("GPUTRDTrackerLoadTracks"                           "= TRDTRACKER TPCMERGER"                                LB      simple)
 o2_gpu_add_kernel("GPUITSFitterKernels"                               "= TPCMERGER MATLUT"                                    LB      simple)
 o2_gpu_add_kernel("GPUTPCConvertKernel"                               "="                                                     LB      simple)
 o2_gpu_add_kernel("GPUTPCCompressionKernels, step0attached"           "= TPCCOMPRESSION"                                      LB      simple)
@@ -112,6 +113,7 @@ o2_gpu_add_kernel("GPUTPCCFCheckPadBaseline"                          "= TPCCLUS
 o2_gpu_add_kernel("GPUTPCCFChargeMapFiller, fillIndexMap"             "= TPCCLUSTERFINDER"                                    LB      single)
 o2_gpu_add_kernel("GPUTPCCFChargeMapFiller, fillFromDigits"           "= TPCCLUSTERFINDER"                                    LB      single)
 o2_gpu_add_kernel("GPUTPCCFChargeMapFiller, findFragmentStart"        "= TPCCLUSTERFINDER"                                    LB      single char setPositions)
+o2_gpu_add_kernel("GPUTPCCFChargeMapFiller, resetMaps"                "= TPCCLUSTERFINDER"                                    LB      single)
 o2_gpu_add_kernel("GPUTPCCFPeakFinder"                                "= TPCCLUSTERFINDER"                                    LB      single)
 o2_gpu_add_kernel("GPUTPCCFNoiseSuppression, noiseSuppression"        "= TPCCLUSTERFINDER"                                    LB      single)
 o2_gpu_add_kernel("GPUTPCCFNoiseSuppression, updatePeaks"             "= TPCCLUSTERFINDER"                                    LB      single)
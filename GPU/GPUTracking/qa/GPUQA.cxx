@@ -1241,6 +1241,16 @@ void GPUQA::RunQA(bool matchOnly, const std::vector<o2::tpc::TrackTPC>* tracksEx
       prop.SetMaterialTPC();
       prop.SetPolynomialField(&mParam->polynomialField);
 
+      // The tracks are propagated to the MC reference in parallel, the histograms are filled afterwards in the order of the tracks
+      struct resolutionEntry {
+        float paramval[5], resval[5], pullval[5];
+        float eta, pt;
+        bool ok = false;
+      };
+      std::vector<resolutionEntry> resEntries(mTrackMCLabels.size());
+#if QA_DEBUG == 0
+      GPUCA_OPENMP(parallel for firstprivate(prop))
+#endif
       for (unsigned int i = 0; i < mTrackMCLabels.size(); i++) {
         if (mConfig.writeMCLabels) {
           std::vector<int>& labelBuffer = mcLabelBuffer[mNEvents - 1];
@@ -1292,6 +1302,9 @@ void GPUQA::RunQA(bool matchOnly, const std::vector<o2::tpc::TrackTPC>* tracksEx
         if (GetMCTrackObj(mTrackMCLabelsReverse, mTrackMCLabels[i]) != (int)i) {
           continue;
         }
+        if (mConfig.resFraction < 1.f && ((unsigned int)(mTrackMCLabels[i].getEventID() * 7919 + mTrackMCLabels[i].getTrackID()) * 2654435761u) >= mConfig.resFraction * 4294967296.) {
+          continue; // deterministic subset of the MC tracks, for a lightweight QA
+        }
 
         GPUTPCGMTrackParam param;
         float alpha = 0.f;
@@ -1385,19 +1398,34 @@ void GPUQA::RunQA(bool matchOnly, const std::vector<o2::tpc::TrackTPC>* tracksEx
         float resval[5] = {deltaY, deltaZ, mConfig.nativeFitResolutions ? deltaPhiNative : deltaPhi, mConfig.nativeFitResolutions ? deltaLambdaNative : deltaLambda, mConfig.nativeFitResolutions ? deltaPtNative : deltaPt};
         float pullval[5] = {deltaY / std::sqrt(param.GetErr2Y()), deltaZ / std::sqrt(param.GetErr2Z()), deltaPhiNative / std::sqrt(param.GetErr2SinPhi()), deltaLambdaNative / std::sqrt(param.GetErr2DzDs()), deltaPtNative / std::sqrt(param.GetErr2QPt())};
 
+        resolutionEntry& entry = resEntries[i];
+        for (int j = 0; j < 5; j++) {
+          entry.paramval[j] = paramval[j];
+          entry.resval[j] = resval[j];
+          entry.pullval[j] = pullval[j];
+        }
+        entry.eta = mc2.eta;
+        entry.pt = mc2.pt;
+        entry.ok = true;
+      }
+
+      for (const auto& entry : resEntries) {
+        if (!entry.ok) {
+          continue;
+        }
         for (int j = 0; j < 5; j++) {
           for (int k = 0; k < 5; k++) {
-            if (k != 3 && fabsf(mc2.eta) > ETA_MAX2) {
+            if (k != 3 && fabsf(entry.eta) > ETA_MAX2) {
               continue;
             }
-            if (k < 4 && mc2.pt < 1.f / mConfig.qpt) {
+            if (k < 4 && entry.pt < 1.f / mConfig.qpt) {
               continue;
             }
             if (mQATasks & taskTrackingRes) {
-              mRes2[j][k]->Fill(resval[j], paramval[k]);
+              mRes2[j][k]->Fill(entry.resval[j], entry.paramval[k]);
             }
             if (mQATasks & taskTrackingResPull) {
-              mPull2[j][k]->Fill(pullval[j], paramval[k]);
+              mPull2[j][k]->Fill(entry.pullval[j], entry.paramval[k]);
             }
           }
         }
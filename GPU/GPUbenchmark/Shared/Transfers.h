@@ -0,0 +1,71 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file Transfers.h
+/// \brief Benchmark of the host <-> device transfer patterns of the reconstruction
+
+#ifndef GPU_BENCHMARK_TRANSFERS_H
+#define GPU_BENCHMARK_TRANSFERS_H
+
+#include "Utils.h"
+#include <vector>
+
+namespace o2
+{
+namespace benchmark
+{
+
+// Measures the throughput of the host <-> device copies as done by GPUReconstruction:
+// from pinned or registered (e.g. the shm segment of the framework) host memory,
+// contiguous or as a list of scattered ZS pages, on one or several streams,
+// and concurrently on several devices, possibly with the host memory on the NUMA node of each device.
+class GPUTransferBenchmark final
+{
+ public:
+  GPUTransferBenchmark() = delete; // need for a configuration
+  GPUTransferBenchmark(benchmarkOpts& opts) : mOptions{opts}
+  {
+  }
+
+  void run(); // Execute all the configured transfer tests
+
+ private:
+  struct Copy {
+    size_t hostOffset;
+    size_t deviceOffset;
+    size_t size;
+    bool toDevice;
+  };
+
+  struct DeviceBuffers {
+    int deviceId = 0;
+    HostMemory hostMemory = HostMemory::Pinned;
+    size_t size = 0;
+    char* hostPtr = nullptr;
+    char* devicePtr = nullptr;
+  };
+
+  void allocate(DeviceBuffers& buffers);
+  void release(DeviceBuffers& buffers);
+  void bindToLocalCPUs(int deviceId);
+  std::vector<Copy> getCopies(Transfer transfer, size_t size, int nStreams);
+
+  // @returns time in ms of the nLaunches repetitions of all the copies
+  float runTransfer(DeviceBuffers& buffers, std::vector<Copy> const& copies, int nStreams, int nLaunches);
+
+  void runTest(Transfer transfer, HostMemory hostMemory, Mode mode);
+
+  benchmarkOpts mOptions;
+};
+
+} // namespace benchmark
+} // namespace o2
+#endif
@@ -45,7 +45,6 @@
   printf("\n");                           \
   printf("error: TEST FAILED\n%s", KNRM); \
   exit(EXIT_FAILURE);
-#endif
 
 template <typename T>
 void discardResult(const T&)
@@ -86,6 +85,60 @@ inline std::ostream& operator<<(std::ostream& os, Test test)
   return os;
 }
 
+// Host <-> device transfer patterns of the reconstruction chain
+enum class Transfer {
+  HostToDevice,
+  DeviceToHost,
+  Bidirectional,
+  ScatteredHostToDevice
+};
+
+inline std::ostream& operator<<(std::ostream& os, Transfer transfer)
+{
+  switch (transfer) {
+    case Transfer::HostToDevice:
+      os << "host to device";
+      break;
+    case Transfer::DeviceToHost:
+      os << "device to host";
+      break;
+    case Transfer::Bidirectional:
+      os << "bidirectional";
+      break;
+    case Transfer::ScatteredHostToDevice:
+      os << "scattered pages host to device";
+      break;
+  }
+  return os;
+}
+
+// Kind of host memory the transfers are done from/to
+enum class HostMemory {
+  Pageable,
+  Pinned,
+  Registered,
+  Shm
+};
+
+inline std::ostream& operator<<(std::ostream& os, HostMemory memory)
+{
+  switch (memory) {
+    case HostMemory::Pageable:
+      os << "pageable";
+      break;
+    case HostMemory::Pinned:
+      os << "pinned";
+      break;
+    case HostMemory::Registered:
+      os << "registered";
+      break;
+    case HostMemory::Shm:
+      os << "registered shm";
+      break;
+  }
+  return os;
+}
+
 enum class Mode {
   Sequential,
   Concurrent,
@@ -230,6 +283,12 @@ struct benchmarkOpts {
   int prime = 0;
   std::string outFileName = "benchmark_result";
   bool dumpChunks = false;
+  std::vector<Transfer> transfers;                                                     // host <-> device transfer tests
+  std::vector<HostMemory> hostMemories = {HostMemory::Pinned, HostMemory::Registered}; // host memory used by the transfer tests
+  std::vector<int> transferDevices;                                                    // devices running the transfer tests concurrently, deviceId if empty
+  size_t zsPageSize = 8192;                                                            // size of the pages of the scattered transfers (TPC ZS page)
+  int zsPagesPerCopy = 1;                                                              // number of contiguous pages per copy of the scattered transfers
+  bool localNuma = false;                                                              // use host memory and threads on the NUMA node of each device
 };
 
 template <class chunk_t>
@@ -262,4 +321,6 @@ struct gpuState {
 };
 
 } // namespace benchmark
-} // namespace o2
\ No newline at end of file
+} // namespace o2
+
+#endif
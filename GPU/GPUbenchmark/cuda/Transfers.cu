@@ -0,0 +1,362 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file Transfers.{cu, hip.cxx}
+/// \brief Benchmark of the host <-> device transfer patterns of the reconstruction
+
+#include "../Shared/Transfers.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#define GPUCHECK(error)                                                                        \
+  if (error != cudaSuccess) {                                                                  \
+    printf("%serror: '%s'(%d) at %s:%d%s\n", KRED, cudaGetErrorString(error), error, __FILE__, \
+           __LINE__, KNRM);                                                                    \
+    failed("API returned error code.");                                                        \
+  }
+
+namespace o2
+{
+namespace benchmark
+{
+
+namespace
+{
+// Lets the threads of all the devices start each measurement together
+class Barrier
+{
+ public:
+  Barrier(size_t n) : mCount{n} {}
+  void wait()
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    auto generation = mGeneration;
+    if (++mWaiting == mCount) {
+      mWaiting = 0;
+      mGeneration++;
+      mCondition.notify_all();
+    } else {
+      mCondition.wait(lock, [&] { return generation != mGeneration; });
+    }
+  }
+
+ private:
+  std::mutex mMutex;
+  std::condition_variable mCondition;
+  size_t mCount;
+  size_t mWaiting = 0;
+  size_t mGeneration = 0;
+};
+
+// Parses a sysfs cpu list, e.g. "0-15,64-79"
+std::vector<int> parseCPUList(std::string const& list)
+{
+  std::vector<int> cpus;
+  std::stringstream stream(list);
+  std::string range;
+  while (std::getline(stream, range, ',')) {
+    const size_t sep = range.find('-');
+    try {
+      const int first = std::stoi(range.substr(0, sep));
+      const int last = sep == std::string::npos ? first : std::stoi(range.substr(sep + 1));
+      for (int cpu = first; cpu <= last; ++cpu) {
+        cpus.push_back(cpu);
+      }
+    } catch (const std::exception&) {
+    }
+  }
+  return cpus;
+}
+} // namespace
+
+void GPUTransferBenchmark::bindToLocalCPUs(int deviceId)
+{
+  char busId[32];
+  GPUCHECK(cudaDeviceGetPCIBusId(busId, sizeof(busId), deviceId));
+  std::string path{"/sys/bus/pci/devices/"};
+  for (const char* c = busId; *c; ++c) {
+    path += std::tolower(*c);
+  }
+  std::ifstream file(path + "/local_cpulist");
+  std::string list;
+  if (!std::getline(file, list) || parseCPUList(list).empty()) {
+    std::cerr << "   │   - \033[1;33mWarning: no NUMA information for device " << deviceId << "\e[0m" << std::endl;
+    return;
+  }
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (auto cpu : parseCPUList(list)) {
+    CPU_SET(cpu, &set);
+  }
+  // Pins the calling thread: the host memory first touched afterwards is allocated on the node of the device
+  if (sched_setaffinity(0, sizeof(set), &set)) {
+    std::cerr << "   │   - \033[1;33mWarning: could not bind to the CPUs " << list << " of device " << deviceId << "\e[0m" << std::endl;
+  }
+}
+
+void GPUTransferBenchmark::allocate(DeviceBuffers& buffers)
+{
+  GPUCHECK(cudaSetDevice(buffers.deviceId));
+  GPUCHECK(cudaMalloc(reinterpret_cast<void**>(&buffers.devicePtr), buffers.size));
+  switch (buffers.hostMemory) {
+    case HostMemory::Pageable:
+      buffers.hostPtr = static_cast<char*>(std::malloc(buffers.size));
+      break;
+    case HostMemory::Pinned:
+      GPUCHECK(cudaMallocHost(reinterpret_cast<void**>(&buffers.hostPtr), buffers.size));
+      break;
+    case HostMemory::Registered:
+      buffers.hostPtr = static_cast<char*>(std::aligned_alloc(4096, buffers.size));
+      break;
+    case HostMemory::Shm: {
+      // A shared memory segment registered for the GPU, as the one of the framework by GPUReconstruction
+      const std::string name = "/o2-gpu-benchmark-" + std::to_string(getpid()) + "-" + std::to_string(buffers.deviceId);
+      int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+      if (fd < 0 || ftruncate(fd, buffers.size)) {
+        failed("Could not create the shared memory segment %s", name.c_str());
+      }
+      void* ptr = mmap(nullptr, buffers.size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+      close(fd);
+      shm_unlink(name.c_str()); // the mapping stays valid
+      if (ptr == MAP_FAILED) {
+        failed("Could not map the shared memory segment %s", name.c_str());
+      }
+      buffers.hostPtr = static_cast<char*>(ptr);
+      break;
+    }
+  }
+  if (!buffers.hostPtr) {
+    failed("Could not allocate %zu bytes of host memory", buffers.size);
+  }
+  std::memset(buffers.hostPtr, 0, buffers.size); // first touch
+  if (buffers.hostMemory == HostMemory::Registered || buffers.hostMemory == HostMemory::Shm) {
+    GPUCHECK(cudaHostRegister(buffers.hostPtr, buffers.size, cudaHostRegisterDefault));
+  }
+  GPUCHECK(cudaMemset(buffers.devicePtr, 0, buffers.size));
+}
+
+void GPUTransferBenchmark::release(DeviceBuffers& buffers)
+{
+  GPUCHECK(cudaSetDevice(buffers.deviceId));
+  GPUCHECK(cudaFree(buffers.devicePtr));
+  switch (buffers.hostMemory) {
+    case HostMemory::Pageable:
+      std::free(buffers.hostPtr);
+      break;
+    case HostMemory::Pinned:
+      GPUCHECK(cudaFreeHost(buffers.hostPtr));
+      break;
+    case HostMemory::Registered:
+      GPUCHECK(cudaHostUnregister(buffers.hostPtr));
+      std::free(buffers.hostPtr);
+      break;
+    case HostMemory::Shm:
+      GPUCHECK(cudaHostUnregister(buffers.hostPtr));
+      munmap(buffers.hostPtr, buffers.size);
+      break;
+  }
+  buffers.hostPtr = buffers.devicePtr = nullptr;
+}
+
+std::vector<GPUTransferBenchmark::Copy> GPUTransferBenchmark::getCopies(Transfer transfer, size_t size, int nStreams)
+{
+  std::vector<Copy> copies;
+  if (transfer == Transfer::ScatteredHostToDevice) {
+    // Pages scattered in the host buffer gathered contiguously on the device, one copy per group of pages
+    const size_t copySize = mOptions.zsPageSize * mOptions.zsPagesPerCopy;
+    std::vector<size_t> hostSlots(size / copySize);
+    std::iota(hostSlots.begin(), hostSlots.end(), 0);
+    std::shuffle(hostSlots.begin(), hostSlots.end(), std::mt19937{12345});
+    for (size_t iCopy{0}; iCopy < hostSlots.size(); ++iCopy) {
+      copies.push_back({hostSlots[iCopy] * copySize, iCopy * copySize, copySize, true});
+    }
+    return copies;
+  }
+  // Contiguous slices, one per stream: with both directions the first half of the streams sends, the second half receives
+  const size_t slice = (size / nStreams) & ~size_t(0xFFF);
+  for (int iStream{0}; iStream < nStreams; ++iStream) {
+    const bool toDevice = transfer == Transfer::HostToDevice || (transfer == Transfer::Bidirectional && iStream < nStreams / 2);
+    copies.push_back({iStream * slice, iStream * slice, slice, toDevice});
+  }
+  return copies;
+}
+
+float GPUTransferBenchmark::runTransfer(DeviceBuffers& buffers, std::vector<Copy> const& copies, int nStreams, int nLaunches)
+{
+  GPUCHECK(cudaSetDevice(buffers.deviceId));
+  std::vector<cudaStream_t> streams(nStreams);
+  std::vector<cudaEvent_t> stops(nStreams);
+  cudaEvent_t start, stop;
+  for (auto iStream{0}; iStream < nStreams; ++iStream) {
+    GPUCHECK(cudaStreamCreate(&streams[iStream]));
+    GPUCHECK(cudaEventCreate(&stops[iStream]));
+  }
+  GPUCHECK(cudaEventCreate(&start));
+  GPUCHECK(cudaEventCreate(&stop));
+
+  auto schedule = [&]() {
+    for (size_t iCopy{0}; iCopy < copies.size(); ++iCopy) { // round-robin on stream pool
+      auto& copy = copies[iCopy];
+      auto stream = streams[iCopy % nStreams];
+      if (copy.toDevice) {
+        GPUCHECK(cudaMemcpyAsync(buffers.devicePtr + copy.deviceOffset, buffers.hostPtr + copy.hostOffset, copy.size, cudaMemcpyHostToDevice, stream));
+      } else {
+        GPUCHECK(cudaMemcpyAsync(buffers.hostPtr + copy.hostOffset, buffers.devicePtr + copy.deviceOffset, copy.size, cudaMemcpyDeviceToHost, stream));
+      }
+    }
+  };
+
+  // Warm up
+  schedule();
+  GPUCHECK(cudaDeviceSynchronize());
+
+  // All the streams start after the start event and the stop event is recorded after all of them
+  GPUCHECK(cudaEventRecord(start, streams[0]));
+  for (auto iStream{1}; iStream < nStreams; ++iStream) {
+    GPUCHECK(cudaStreamWaitEvent(streams[iStream], start, 0));
+  }
+  for (auto iLaunch{0}; iLaunch < nLaunches; ++iLaunch) {
+    schedule();
+  }
+  for (auto iStream{1}; iStream < nStreams; ++iStream) {
+    GPUCHECK(cudaEventRecord(stops[iStream], streams[iStream]));
+    GPUCHECK(cudaStreamWaitEvent(streams[0], stops[iStream], 0));
+  }
+  GPUCHECK(cudaEventRecord(stop, streams[0]));
+  GPUCHECK(cudaEventSynchronize(stop));
+
+  float milliseconds{0.f};
+  GPUCHECK(cudaEventElapsedTime(&milliseconds, start, stop));
+  GPUCHECK(cudaEventDestroy(start));
+  GPUCHECK(cudaEventDestroy(stop));
+  for (auto iStream{0}; iStream < nStreams; ++iStream) {
+    GPUCHECK(cudaEventDestroy(stops[iStream]));
+    GPUCHECK(cudaStreamDestroy(streams[iStream]));
+  }
+  return milliseconds;
+}
+
+void GPUTransferBenchmark::runTest(Transfer transfer, HostMemory hostMemory, Mode mode)
+{
+  auto devices = mOptions.transferDevices;
+  if (devices.empty()) {
+    devices.push_back(mOptions.deviceId);
+  }
+  int nStreams = (mode == Mode::Sequential) ? 1 : mOptions.streams;
+  if (transfer == Transfer::Bidirectional) {
+    nStreams = std::max(nStreams, 2);
+  }
+  const size_t size = static_cast<size_t>(GB * mOptions.chunkReservedGB) & 0xFFFFFFFFFFFFF000;
+  auto copies = getCopies(transfer, size, nStreams);
+  if (copies.empty() || !copies[0].size) {
+    std::cerr << "Transfer size " << size << " B too small for the " << transfer << " test." << std::endl;
+    return;
+  }
+  size_t copiedBytes{0};
+  for (auto& copy : copies) {
+    copiedBytes += copy.size;
+  }
+  const float copiedGB = (float)copiedBytes / GB;
+
+  // One thread per device, so that the devices transfer concurrently
+  std::vector<std::vector<float>> results(devices.size(), std::vector<float>(mOptions.nTests));
+  std::vector<float> hostTimes(mOptions.nTests);
+  Barrier barrier(devices.size() + 1);
+  std::vector<std::thread> threads;
+  for (size_t iDevice{0}; iDevice < devices.size(); ++iDevice) {
+    threads.emplace_back([&, iDevice]() {
+      if (mOptions.localNuma) {
+        bindToLocalCPUs(devices[iDevice]);
+      }
+      DeviceBuffers buffers;
+      buffers.deviceId = devices[iDevice];
+      buffers.hostMemory = hostMemory;
+      buffers.size = size;
+      allocate(buffers);
+      for (auto measurement{0}; measurement < mOptions.nTests; ++measurement) {
+        barrier.wait();
+        results[iDevice][measurement] = runTransfer(buffers, copies, nStreams, mOptions.kernelLaunches);
+        barrier.wait();
+      }
+      release(buffers);
+    });
+  }
+  for (auto measurement{0}; measurement < mOptions.nTests; ++measurement) {
+    barrier.wait();
+    auto start = std::chrono::high_resolution_clock::now();
+    barrier.wait();
+    std::chrono::duration<double, std::milli> diff_t{std::chrono::high_resolution_clock::now() - start};
+    hostTimes[measurement] = diff_t.count();
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (auto measurement{0}; measurement < mOptions.nTests; ++measurement) {
+    if (!mOptions.raw) {
+      std::cout << "   ├ " << mode << " " << transfer << " from " << hostMemory << " memory (" << measurement + 1 << "/" << mOptions.nTests << "): \n"
+                << "   │   - streams: " << nStreams << ", copies per launch: " << copies.size() << " of " << copies[0].size << " B\n"
+                << "   │   - per device throughput:\n";
+    }
+    for (size_t iDevice{0}; iDevice < devices.size(); ++iDevice) {
+      auto result = results[iDevice][measurement];
+      auto throughput = computeThroughput(Test::Copy, result, copiedGB, mOptions.kernelLaunches);
+      if (!mOptions.raw) {
+        std::cout << "   │     " << ((devices.size() - iDevice != 1) ? "├ " : "└ ") << "device#" << devices[iDevice]
+                  << ": \e[1m" << throughput << " GB/s \e[0m(" << result * 1e-3 << " s)\n";
+      } else {
+        std::cout << "" << measurement << "\t" << devices[iDevice] << "\t" << throughput << "\t" << copiedGB << "\t" << result << std::endl;
+      }
+    }
+    if (devices.size() > 1 && !mOptions.raw) {
+      std::cout << "   │   - total throughput with host time: \e[1m" << computeThroughput(Test::Copy, hostTimes[measurement], copiedGB * devices.size(), mOptions.kernelLaunches)
+                << " GB/s \e[0m (" << std::setw(2) << hostTimes[measurement] / 1000 << " s)" << std::endl;
+    }
+  }
+}
+
+void GPUTransferBenchmark::run()
+{
+  for (auto& hostMemory : mOptions.hostMemories) {
+    for (auto& transfer : mOptions.transfers) {
+      if (!mOptions.raw) {
+        std::cout << " ◈ \033[1;33m" << transfer << "\033[0m transfer benchmark from " << hostMemory << " memory with \e[1m" << mOptions.nTests
+                  << "\e[0m runs and \e[1m" << mOptions.kernelLaunches << "\e[0m launches of " << mOptions.chunkReservedGB << " GB" << std::endl;
+      }
+      for (auto& mode : mOptions.modes) {
+        if (mode == Mode::Distributed) {
+          continue;
+        }
+        runTest(transfer, hostMemory, mode);
+      }
+      if (!mOptions.raw) {
+        std::cout << "   └\033[1;32m done\033[0m" << std::endl;
+      }
+    }
+  }
+}
+
+} // namespace benchmark
+} // namespace o2
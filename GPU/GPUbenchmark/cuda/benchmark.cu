@@ -14,7 +14,8 @@
 #include <unistd.h>
 
 #include "../Shared/Kernels.h"
-#define VERSION "version 0.3"
+#include "../Shared/Transfers.h"
+#define VERSION "version 0.4"
 
 bool parseArgs(o2::benchmark::benchmarkOpts& conf, int argc, const char* argv[])
 {
@@ -42,7 +43,13 @@ bool parseArgs(o2::benchmark::benchmarkOpts& conf, int argc, const char* argv[])
     "streams,s", bpo::value<int>()->default_value(8), "Size of the pool of streams available for concurrent tests.")(
     "test,t", bpo::value<std::vector<std::string>>()->multitoken()->default_value(std::vector<std::string>{"read", "write", "copy", "rread", "rwrite", "rcopy"}, "read write copy rread rwrite rcopy"), "Tests to be performed.")(
     "version,v", "Print version.")(
-    "extra,x", "Print extra info for each available device.");
+    "extra,x", "Print extra info for each available device.")(
+    "transfer,T", bpo::value<std::vector<std::string>>()->multitoken(), "Host <-> device transfer tests: h2d d2h bidir zs. Chunk size is the transferred size, launches the repetitions.")(
+    "hostMemory,H", bpo::value<std::vector<std::string>>()->multitoken()->default_value(std::vector<std::string>{"pinned", "registered"}, "pinned registered"), "Host memory of the transfer tests: pageable, pinned, registered or shm.")(
+    "transferDevices,D", bpo::value<std::vector<int>>()->multitoken(), "Ids of the devices running the transfer tests concurrently (default: --device).")(
+    "zsPageSize", bpo::value<size_t>()->default_value(8192), "Page size of the scattered (zs) transfer test (B).")(
+    "zsPagesPerCopy", bpo::value<int>()->default_value(1), "Contiguous pages per copy of the scattered (zs) transfer test.")(
+    "localNuma", "Allocate the host memory of the transfer tests on the NUMA node of each device.");
   try {
     bpo::store(parse_command_line(argc, argv, options), vm);
     if (vm.count("help")) {
@@ -168,6 +175,54 @@ bool parseArgs(o2::benchmark::benchmarkOpts& conf, int argc, const char* argv[])
     }
   }
 
+  conf.transfers.clear();
+  if (vm.count("transfer")) {
+    for (auto& transfer : vm["transfer"].as<std::vector<std::string>>()) {
+      if (transfer == "h2d") {
+        conf.transfers.push_back(Transfer::HostToDevice);
+      } else if (transfer == "d2h") {
+        conf.transfers.push_back(Transfer::DeviceToHost);
+      } else if (transfer == "bidir") {
+        conf.transfers.push_back(Transfer::Bidirectional);
+      } else if (transfer == "zs") {
+        conf.transfers.push_back(Transfer::ScatteredHostToDevice);
+      } else {
+        std::cerr << "Unkonwn transfer: " << transfer << std::endl;
+        exit(1);
+      }
+    }
+    if (vm["test"].defaulted()) { // only the transfer tests unless kernel tests are requested
+      conf.tests.clear();
+    }
+  }
+
+  conf.hostMemories.clear();
+  for (auto& memory : vm["hostMemory"].as<std::vector<std::string>>()) {
+    if (memory == "pageable") {
+      conf.hostMemories.push_back(HostMemory::Pageable);
+    } else if (memory == "pinned") {
+      conf.hostMemories.push_back(HostMemory::Pinned);
+    } else if (memory == "registered") {
+      conf.hostMemories.push_back(HostMemory::Registered);
+    } else if (memory == "shm") {
+      conf.hostMemories.push_back(HostMemory::Shm);
+    } else {
+      std::cerr << "Unkonwn host memory: " << memory << std::endl;
+      exit(1);
+    }
+  }
+
+  if (vm.count("transferDevices")) {
+    conf.transferDevices = vm["transferDevices"].as<std::vector<int>>();
+  }
+  conf.zsPageSize = vm["zsPageSize"].as<size_t>();
+  conf.zsPagesPerCopy = vm["zsPagesPerCopy"].as<int>();
+  if (!conf.zsPageSize || conf.zsPagesPerCopy < 1) {
+    std::cerr << "Invalid scattered transfer pages: " << conf.zsPagesPerCopy << " x " << conf.zsPageSize << " B" << std::endl;
+    exit(1);
+  }
+  conf.localNuma = vm.count("localNuma");
+
   conf.dtypes = vm["kind"].as<std::vector<std::string>>();
   conf.outFileName = vm["outfile"].as<std::string>();
 
@@ -183,7 +238,7 @@ int main(int argc, const char* argv[])
     return -1;
   }
 
-  for (auto& dtype : opts.dtypes) {
+  for (auto& dtype : opts.tests.empty() ? std::vector<std::string>{} : opts.dtypes) {
     if (dtype == "char") {
       o2::benchmark::GPUbenchmark<char> bm_char{opts};
       bm_char.run();
@@ -201,5 +256,10 @@ int main(int argc, const char* argv[])
       exit(1);
     }
   }
+
+  if (!opts.transfers.empty()) {
+    o2::benchmark::GPUTransferBenchmark bm_transfer{opts};
+    bm_transfer.run();
+  }
   return 0;
 }
@@ -22,10 +22,15 @@ void CorrectionMapsHelper::clear()
     delete mCorrMapRef;
     delete mCorrMapMShape;
   }
+  if (mOwnerBlended) {
+    delete mCorrMapBlended;
+  }
   mLumiCTPAvailable = false;
   mCorrMap = nullptr;
   mCorrMapRef = nullptr;
   mCorrMapMShape = nullptr;
+  mCorrMapBlended = nullptr;
+  mOwnerBlended = false;
   mUpdatedFlags = 0;
   mInstLumiCTP = 0.f;
   mInstLumi = 0.f;
@@ -68,6 +73,13 @@ void CorrectionMapsHelper::setCorrMapMShape(TPCFastTransform* m)
   mCorrMapMShape = m;
 }
 
+void CorrectionMapsHelper::setCorrMapBlended(TPCFastTransform* m)
+{
+  // the previous pointer is not deleted, since it may belong to the helper from which this one was copied
+  mCorrMapBlended = m;
+  mOwnerBlended = false;
+}
+
 //________________________________________________________
 void CorrectionMapsHelper::setCorrMap(std::unique_ptr<TPCFastTransform>&& m)
 {
@@ -108,11 +120,65 @@ void CorrectionMapsHelper::updateLumiScale(bool report)
     mLumiScale = mMeanLumi ? mInstLumi / mMeanLumi : 0.f;
   }
   setUpdatedLumi();
+  updateBlendedMap();
   if (report) {
     reportScaling();
   }
 }
 
+//________________________________________________________
+void CorrectionMapsHelper::enableMapBlending(bool v)
+{
+  mBlendMaps = v;
+  updateBlendedMap();
+}
+
+//________________________________________________________
+bool CorrectionMapsHelper::updateBlendedMap()
+{
+  // the spline parameters are combined in the same way as the corrections in TPCFastTransform::Transform and the inverse transformations
+  bool blend = mBlendMaps && mCorrMap && mCorrMapRef;
+  if (blend && (mLumiScaleMode != 1) && (mLumiScaleMode != 2) && (mLumiScale < 0.f)) {
+    blend = false; // corrections are switched off
+  }
+  const TPCFastSpaceChargeCorrection* corr = blend ? &mCorrMap->getCorrection() : nullptr;
+  const TPCFastSpaceChargeCorrection* corrRef = blend ? &mCorrMapRef->getCorrection() : nullptr;
+  const TPCFastSpaceChargeCorrection* corrMShape = (blend && !isCorrMapMShapeDummy()) ? &mCorrMapMShape->getCorrection() : nullptr;
+  for (int iSpline = 0; blend && iSpline < (mScaleInverse ? 3 : 1); iSpline++) { // otherwise the inverse correction of the current map is used as it is
+    blend = corr->isCompatible(*corrRef, iSpline) && (!corrMShape || corr->isCompatible(*corrMShape, iSpline));
+    if (!blend) {
+      LOGP(warning, "Correction maps have different splines or grids, they are combined during the transformation");
+    }
+  }
+
+  if (!blend) {
+    if (mOwnerBlended) {
+      delete mCorrMapBlended;
+    }
+    mCorrMapBlended = nullptr;
+    mOwnerBlended = false;
+    return false;
+  }
+
+  if (!mOwnerBlended) {
+    mCorrMapBlended = new TPCFastTransform;
+    mOwnerBlended = true;
+  }
+  mCorrMapBlended->cloneFromObject(*mCorrMap, nullptr);
+  auto& corrBlended = mCorrMapBlended->getCorrection();
+  const bool derivative = (mLumiScaleMode == 1) || (mLumiScaleMode == 2);
+  const float scale = derivative ? 1.f : ((mLumiScale > 0.f) ? mLumiScale : 1.f);
+  const float scaleRef = derivative ? mLumiScale : ((mLumiScale > 0.f) ? 1.f - mLumiScale : 0.f);
+  for (int iSpline = 0; iSpline < (mScaleInverse ? 3 : 1); iSpline++) {
+    corrBlended.setSplineData(*corr, scale, iSpline);
+    corrBlended.addSplineData(*corrRef, scaleRef, iSpline);
+    if (corrMShape) {
+      corrBlended.addSplineData(*corrMShape, 1.f, iSpline);
+    }
+  }
+  return true;
+}
+
 //________________________________________________________
 void CorrectionMapsHelper::reportScaling()
 {
@@ -39,34 +39,62 @@ class CorrectionMapsHelper
 
   GPUd() void Transform(int slice, int row, float pad, float time, float& x, float& y, float& z, float vertexTime = 0) const
   {
-    mCorrMap->Transform(slice, row, pad, time, x, y, z, vertexTime, mCorrMapRef, mCorrMapMShape, mLumiScale, 1, mLumiScaleMode);
+    if (mCorrMapBlended) {
+      mCorrMapBlended->Transform(slice, row, pad, time, x, y, z, vertexTime);
+    } else {
+      mCorrMap->Transform(slice, row, pad, time, x, y, z, vertexTime, mCorrMapRef, mCorrMapMShape, mLumiScale, 1, mLumiScaleMode);
+    }
   }
 
   GPUd() void TransformXYZ(int slice, int row, float& x, float& y, float& z) const
   {
-    mCorrMap->TransformXYZ(slice, row, x, y, z, mCorrMapRef, mCorrMapMShape, mLumiScale, 1, mLumiScaleMode);
+    if (mCorrMapBlended) {
+      mCorrMapBlended->TransformXYZ(slice, row, x, y, z);
+    } else {
+      mCorrMap->TransformXYZ(slice, row, x, y, z, mCorrMapRef, mCorrMapMShape, mLumiScale, 1, mLumiScaleMode);
+    }
   }
 
   GPUd() void InverseTransformYZtoX(int slice, int row, float y, float z, float& x) const
   {
-    mCorrMap->InverseTransformYZtoX(slice, row, y, z, x, mCorrMapRef, mCorrMapMShape, (mScaleInverse ? mLumiScale : 0), (mScaleInverse ? 1 : 0), mLumiScaleMode);
+    if (mCorrMapBlended) {
+      mCorrMapBlended->InverseTransformYZtoX(slice, row, y, z, x);
+    } else {
+      mCorrMap->InverseTransformYZtoX(slice, row, y, z, x, mCorrMapRef, mCorrMapMShape, (mScaleInverse ? mLumiScale : 0), (mScaleInverse ? 1 : 0), mLumiScaleMode);
+    }
   }
 
   GPUd() void InverseTransformYZtoNominalYZ(int slice, int row, float y, float z, float& ny, float& nz) const
   {
-    mCorrMap->InverseTransformYZtoNominalYZ(slice, row, y, z, ny, nz, mCorrMapRef, mCorrMapMShape, (mScaleInverse ? mLumiScale : 0), (mScaleInverse ? 1 : 0), mLumiScaleMode);
+    if (mCorrMapBlended) {
+      mCorrMapBlended->InverseTransformYZtoNominalYZ(slice, row, y, z, ny, nz);
+    } else {
+      mCorrMap->InverseTransformYZtoNominalYZ(slice, row, y, z, ny, nz, mCorrMapRef, mCorrMapMShape, (mScaleInverse ? mLumiScale : 0), (mScaleInverse ? 1 : 0), mLumiScaleMode);
+    }
   }
 
   GPUd() const GPUCA_NAMESPACE::gpu::TPCFastTransform* getCorrMap() const { return mCorrMap; }
   GPUd() const GPUCA_NAMESPACE::gpu::TPCFastTransform* getCorrMapRef() const { return mCorrMapRef; }
   GPUd() const GPUCA_NAMESPACE::gpu::TPCFastTransform* getCorrMapMShape() const { return mCorrMapMShape; }
+  GPUd() const GPUCA_NAMESPACE::gpu::TPCFastTransform* getCorrMapBlended() const { return mCorrMapBlended; }
 
   bool getOwner() const { return mOwner; }
 
   void setCorrMap(GPUCA_NAMESPACE::gpu::TPCFastTransform* m);
   void setCorrMapRef(GPUCA_NAMESPACE::gpu::TPCFastTransform* m);
   void setCorrMapMShape(GPUCA_NAMESPACE::gpu::TPCFastTransform* m);
+  /// set a non-owned blended map, e.g. the copy of the blended map in the GPU memory for a copy of the helper
+  void setCorrMapBlended(GPUCA_NAMESPACE::gpu::TPCFastTransform* m);
   void reportScaling();
+
+  /// enable the blending of the spline parameters of the current, reference and M-shape maps into a single map, which is updated when the scaling changes
+  void enableMapBlending(bool v);
+  bool getMapBlending() const { return mBlendMaps; }
+
+  /// combine the spline parameters of the maps with the current scaling into the blended map, called when the scaling changes and to be called after setting new maps
+  /// the blended map is removed and the maps are combined during the transformation if blending is disabled or not possible
+  /// \return true if the blended map is used
+  bool updateBlendedMap();
   void setInstLumiCTP(float v)
   {
     if (v != mInstLumiCTP) {
@@ -180,11 +208,14 @@ class CorrectionMapsHelper
   float mInstCTPLumiOverride = -1.f;                               // optional value to override inst lumi from CTP
   bool mEnableMShape = false;                                      ///< use v shape correction
   bool mScaleInverse{false};                                       // if set to false the inverse correction is already scaled and will not scaled again
+  bool mBlendMaps{false};                                          // combine the maps into mCorrMapBlended when the scaling changes
+  bool mOwnerBlended{false};                                       //! is mCorrMapBlended owned by the helper
   GPUCA_NAMESPACE::gpu::TPCFastTransform* mCorrMap{nullptr};       // current transform
   GPUCA_NAMESPACE::gpu::TPCFastTransform* mCorrMapRef{nullptr};    // reference transform
   GPUCA_NAMESPACE::gpu::TPCFastTransform* mCorrMapMShape{nullptr}; // correction map for v-shape distortions on A-side
+  GPUCA_NAMESPACE::gpu::TPCFastTransform* mCorrMapBlended{nullptr}; //! current transform with the scaled reference and M-shape maps added to its spline parameters
 #ifndef GPUCA_ALIROOT_LIB
-  ClassDefNV(CorrectionMapsHelper, 6);
+  ClassDefNV(CorrectionMapsHelper, 7);
 #endif
 };
 
@@ -20,6 +20,7 @@
 #if !defined(GPUCA_GPUCODE)
 #include <iostream>
 #include <cmath>
+#include <cstring>
 #include "Spline2DHelper.h"
 #endif
 
@@ -540,3 +541,88 @@ double TPCFastSpaceChargeCorrection::testInverse(bool prn)
 }
 
 #endif // GPUCA_GPUCODE
+
+#if !defined(GPUCA_GPUCODE)
+
+bool TPCFastSpaceChargeCorrection::isCompatible(const TPCFastSpaceChargeCorrection& other, int iSpline) const
+{
+  /// Checks that the spline iSpline of both corrections has the same scenarios, memory layout and grids
+
+  if (!mFlatBufferPtr || !other.mFlatBufferPtr || iSpline < 0 || iSpline > 2) {
+    return false;
+  }
+  if (mGeo.getNumberOfSlices() != other.mGeo.getNumberOfSlices() || mGeo.getNumberOfRows() != other.mGeo.getNumberOfRows() ||
+      mNumberOfScenarios != other.mNumberOfScenarios || mSliceDataSizeBytes[iSpline] != other.mSliceDataSizeBytes[iSpline]) {
+    return false;
+  }
+  for (int i = 0; i < mNumberOfScenarios; i++) {
+    const SplineType& sp1 = mScenarioPtr[i];
+    const SplineType& sp2 = other.mScenarioPtr[i];
+    if (sp1.getGridX1().getUmax() != sp2.getGridX1().getUmax() || sp1.getGridX2().getUmax() != sp2.getGridX2().getUmax() ||
+        sp1.getFlatBufferSize() != sp2.getFlatBufferSize() || std::memcmp(sp1.getFlatBufferPtr(), sp2.getFlatBufferPtr(), sp1.getFlatBufferSize()) != 0) {
+      return false;
+    }
+  }
+  for (int row = 0; row < mGeo.getNumberOfRows(); row++) {
+    const RowInfo& r1 = mRowInfoPtr[row];
+    const RowInfo& r2 = other.mRowInfoPtr[row];
+    if (r1.splineScenarioID != r2.splineScenarioID || r1.dataOffsetBytes[iSpline] != r2.dataOffsetBytes[iSpline]) {
+      return false;
+    }
+  }
+  for (int slice = 0; slice < mGeo.getNumberOfSlices(); slice++) {
+    for (int row = 0; row < mGeo.getNumberOfRows(); row++) {
+      const SliceRowInfo& i1 = getSliceRowInfo(slice, row);
+      const SliceRowInfo& i2 = other.getSliceRowInfo(slice, row);
+      if (iSpline == 0) {
+        // grid of the direct correction
+        if (i1.gridV0 != i2.gridV0) {
+          return false;
+        }
+      } else {
+        // grid of the inverse corrections, which is defined by the corrected coordinates
+        if (i1.gridCorrU0 != i2.gridCorrU0 || i1.gridCorrV0 != i2.gridCorrV0 || i1.scaleCorrUtoGrid != i2.scaleCorrUtoGrid || i1.scaleCorrVtoGrid != i2.scaleCorrVtoGrid ||
+            i1.activeArea.cuMin != i2.activeArea.cuMin || i1.activeArea.cuMax != i2.activeArea.cuMax || i1.activeArea.cvMax != i2.activeArea.cvMax) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+void TPCFastSpaceChargeCorrection::setSplineData(const TPCFastSpaceChargeCorrection& corr, float scale, int iSpline)
+{
+  /// Sets the parameters of the spline iSpline to scale * parameters of a compatible correction
+
+  const int nDim = (iSpline == 0) ? 3 : iSpline;
+  for (int slice = 0; slice < mGeo.getNumberOfSlices(); slice++) {
+    for (int row = 0; row < mGeo.getNumberOfRows(); row++) {
+      const int nPar = getSpline(slice, row).getNumberOfParameters() / 3 * nDim;
+      float* data = getSplineData(slice, row, iSpline);
+      const float* dataCorr = corr.getSplineData(slice, row, iSpline);
+      for (int i = 0; i < nPar; i++) {
+        data[i] = scale * dataCorr[i];
+      }
+    }
+  }
+}
+
+void TPCFastSpaceChargeCorrection::addSplineData(const TPCFastSpaceChargeCorrection& corr, float scale, int iSpline)
+{
+  /// Adds scale * parameters of the spline iSpline of a compatible correction
+
+  const int nDim = (iSpline == 0) ? 3 : iSpline;
+  for (int slice = 0; slice < mGeo.getNumberOfSlices(); slice++) {
+    for (int row = 0; row < mGeo.getNumberOfRows(); row++) {
+      const int nPar = getSpline(slice, row).getNumberOfParameters() / 3 * nDim;
+      float* data = getSplineData(slice, row, iSpline);
+      const float* dataCorr = corr.getSplineData(slice, row, iSpline);
+      for (int i = 0; i < nPar; i++) {
+        data[i] += scale * dataCorr[i];
+      }
+    }
+  }
+}
+
+#endif // GPUCA_GPUCODE
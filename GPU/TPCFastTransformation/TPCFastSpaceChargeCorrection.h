@@ -161,6 +161,9 @@ class TPCFastSpaceChargeCorrection : public FlatObject
   ///
   GPUd() int getCorrection(int slice, int row, float u, float v, float& dx, float& du, float& dv) const;
 
+  /// cluster correction for n clusters of the same TPC slice and row, the row information, the spline and its parameters are looked up only once
+  GPUd() void getCorrection(int slice, int row, int n, const float* u, const float* v, float* dx, float* du, float* dv) const;
+
   /// inverse correction: Corrected U and V -> coorrected X
   GPUd() void getCorrectionInvCorrectedX(int slice, int row, float corrU, float corrV, float& corrX) const;
 
@@ -236,6 +239,17 @@ class TPCFastSpaceChargeCorrection : public FlatObject
   /// Print method
   void print() const;
   GPUh() double testInverse(bool prn = 0);
+
+  /// Checks that the spline iSpline (0: correction, 1: inverse X, 2: inverse UV) of another correction has the same scenarios, memory layout and grids,
+  /// such that the spline parameters of both corrections can be combined linearly
+  bool isCompatible(const TPCFastSpaceChargeCorrection& other, int iSpline) const;
+
+  /// Sets the parameters of the spline iSpline to scale * parameters of a compatible correction
+  void setSplineData(const TPCFastSpaceChargeCorrection& corr, float scale, int iSpline);
+
+  /// Adds scale * parameters of the spline iSpline of a compatible correction
+  /// The splines are linear in their parameters, the combined parameters interpolate therefore the combined corrections
+  void addSplineData(const TPCFastSpaceChargeCorrection& corr, float scale, int iSpline);
 #endif
 
  private:
@@ -420,6 +434,35 @@ GPUdi() int TPCFastSpaceChargeCorrection::getCorrection(int slice, int row, floa
   return 0;
 }
 
+GPUdi() void TPCFastSpaceChargeCorrection::getCorrection(int slice, int row, int n, const float* u, const float* v, float* dx, float* du, float* dv) const
+{
+  const SplineType& spline = getSpline(slice, row);
+  const float* splineData = getSplineData(slice, row);
+  const SliceRowInfo& info = getSliceRowInfo(slice, row);
+
+  // same grid conversion as in convUVtoGrid, with the row constants computed once
+  float su0 = 0.f, sv0 = 0.f;
+  mGeo.convUVtoScaledUV(slice, row, 0.f, info.gridV0, su0, sv0);
+  const float gridV1 = 1.f - sv0;
+  const float scaleU = spline.getGridX1().getUmax();
+  const float scaleV = spline.getGridX2().getUmax();
+
+  for (int i = 0; i < n; i++) {
+    float cu = u[i], cv = v[i];
+    schrinkUV(slice, row, cu, cv);
+    float gridU = 0.f, gridV = 0.f;
+    mGeo.convUVtoScaledUV(slice, row, cu, cv, gridU, gridV);
+    gridV = (gridV - sv0) / gridV1;
+    gridU *= scaleU;
+    gridV *= scaleV;
+    float dxuv[3];
+    spline.interpolateU(splineData, gridU, gridV, dxuv);
+    dx[i] = dxuv[0];
+    du[i] = dxuv[1];
+    dv[i] = dxuv[2];
+  }
+}
+
 GPUdi() int TPCFastSpaceChargeCorrection::getCorrectionOld(int slice, int row, float u, float v, float& dx, float& du, float& dv) const
 {
   const SplineType& spline = getSpline(slice, row);
@@ -21,6 +21,7 @@
 #include <condition_variable>
 #include <queue>
 #include <array>
+#include <vector>
 #include <fairmq/States.h>
 
 namespace o2::gpu
@@ -78,7 +79,7 @@ struct GPURecoWorkflowSpec_PipelineInternals {
     std::mutex inputQueueMutex;
     std::condition_variable inputQueueNotify;
   };
-  std::array<pipelineWorkerStruct, 2> workers;
+  std::vector<pipelineWorkerStruct> workers; // one per processing context of GPUO2Interface
 
   std::queue<std::unique_ptr<GPURecoWorkflow_QueueObject>> pipelineQueue;
   std::mutex queueMutex;
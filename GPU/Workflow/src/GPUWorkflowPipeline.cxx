@@ -72,6 +72,7 @@ void GPURecoWorkflowSpec::initPipeline(o2::framework::InitContext& ic)
       }
       return false;
     };
+    mPipeline->workers = decltype(mPipeline->workers)(mConfig->configProcessing.doublePipelineDepth);
     mPipeline->receiveThread = std::thread([this]() { RunReceiveThread(); });
     for (unsigned int i = 0; i < mPipeline->workers.size(); i++) {
       mPipeline->workers[i].thread = std::thread([this, i]() { RunWorkerThread(i); });
@@ -134,7 +135,7 @@ void GPURecoWorkflowSpec::enqueuePipelinedJob(GPUTrackingInOutPointers* ptrs, GP
     mPipeline->mayInjectCondition.notify_one();
   };
 
-  mNextThreadIndex = (mNextThreadIndex + 1) % 2;
+  mNextThreadIndex = (mNextThreadIndex + 1) % mPipeline->workers.size();
 
   {
     std::lock_guard lk(mPipeline->workers[mNextThreadIndex].inputQueueMutex);
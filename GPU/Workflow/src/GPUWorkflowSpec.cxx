@@ -794,7 +794,7 @@ void GPURecoWorkflowSpec::run(ProcessingContext& pc)
     // unsigned int threadIndex = pc.services().get<ThreadPool>().threadIndex;
     unsigned int threadIndex = mNextThreadIndex;
     if (mConfig->configProcessing.doublePipeline) {
-      mNextThreadIndex = (mNextThreadIndex + 1) % 2;
+      mNextThreadIndex = (mNextThreadIndex + 1) % mConfig->configProcessing.doublePipelineDepth;
     }
 
     retVal = runMain(&pc, &ptrs, &outputRegions, threadIndex);
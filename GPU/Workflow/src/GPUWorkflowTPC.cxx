@@ -377,6 +377,7 @@ bool GPURecoWorkflowSpec::fetchCalibsCCDBTPC<GPUCalibObjectsConst>(ProcessingCon
           mCalibObjects.mFastTransformHelper->setCorrMap(mCalibObjects.mFastTransform.get());
           mCalibObjects.mFastTransformHelper->setCorrMapRef(mCalibObjects.mFastTransformRef.get());
           mCalibObjects.mFastTransformHelper->setCorrMapMShape(mCalibObjects.mFastTransformMShape.get());
+          mCalibObjects.mFastTransformHelper->updateBlendedMap();
           mCalibObjects.mFastTransformHelper->acknowledgeUpdate();
           newCalibObjects.fastTransformHelper = mCalibObjects.mFastTransformHelper.get();
         }
@@ -82,6 +82,12 @@ class PrimaryGenerator : public FairPrimaryGenerator
 
   void setExternalVertexForNextEvent(double x, double y, double z);
 
+  /** sample an interaction vertex according to the vertex mode (uses gRandom);
+      allows to draw the vertices of events generated on other threads in a reproducible order **/
+  o2::math_utils::Point3D<float> sampleInteractionVertex();
+
+  bool isEmbedding() const { return mEmbedTree != nullptr; }
+
   // sets the vertex mode; if mode is kCCDB, a valid MeanVertexObject pointer must be given at the same time
   void setVertexMode(o2::conf::VertexMode const& mode, o2::dataformats::MeanVertexObject const* obj = nullptr);
   // if we apply vertex smearing
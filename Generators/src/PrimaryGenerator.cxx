@@ -297,6 +297,19 @@ void PrimaryGenerator::fixInteractionVertex()
   SmearGausVertexXY(false);
   SmearGausVertexZ(false);
 
+  auto sampledvertex = sampleInteractionVertex();
+
+  if (PrimaryGeneratorParam::Instance().verbose) {
+    LOG(info) << "Sampled interacting vertex " << sampledvertex;
+  }
+  SetBeam(sampledvertex.X(), sampledvertex.Y(), 0., 0.);
+  SetTarget(sampledvertex.Z(), 0.);
+}
+
+/*****************************************************************/
+
+o2::math_utils::Point3D<float> PrimaryGenerator::sampleInteractionVertex()
+{
   // we use the mMeanVertexObject if initialized (initialize first)
   if (!mMeanVertex) {
     if (mVertexMode == o2::conf::VertexMode::kDiamondParam) {
@@ -313,13 +326,7 @@ void PrimaryGenerator::fixInteractionVertex()
       LOG(fatal) << "MeanVertexObject is null ... but mode is kCCDB. Please inject the valid CCDB object via setVertexMode";
     }
   }
-  auto sampledvertex = mMeanVertex->sample();
-
-  if (PrimaryGeneratorParam::Instance().verbose) {
-    LOG(info) << "Sampled interacting vertex " << sampledvertex;
-  }
-  SetBeam(sampledvertex.X(), sampledvertex.Y(), 0., 0.);
-  SetTarget(sampledvertex.Z(), 0.);
+  return mMeanVertex->sample();
 }
 
 /*****************************************************************/
@@ -21,11 +21,13 @@
 #include "DataFormatsITSMFT/Digit.h"
 #include "DataFormatsITSMFT/NoiseMap.h"
 #include "DataFormatsITSMFT/TimeDeadMap.h"
+#include "DataFormatsITSMFT/TopologyDictionary.h"
 #include "SimulationDataFormat/ConstMCTruthContainer.h"
 #include "DetectorsBase/BaseDPLDigitizer.h"
 #include "DetectorsCommonDataFormats/DetID.h"
 #include "DetectorsCommonDataFormats/SimTraits.h"
 #include "DetectorsCommonDataFormats/DetectorNameConf.h"
+#include "SimConfig/DigiParams.h"
 #include "DataFormatsParameters/GRPObject.h"
 #include "DataFormatsITSMFT/ROFRecord.h"
 #include "ITSMFTSimulation/Digitizer.h"
@@ -53,6 +55,7 @@ class ITSMFTDPLDigitizerTask : BaseDPLDigitizer
   void initDigitizerTask(framework::InitContext& ic) override
   {
     mDisableQED = ic.options().get<bool>("disable-qed");
+    mHitCache.setMaxBytes(size_t(std::max(0, o2::conf::DigiParams::Instance().bgHitCacheMB)) << 20);
   }
 
   void run(framework::ProcessingContext& pc)
@@ -66,6 +69,8 @@ class ITSMFTDPLDigitizerTask : BaseDPLDigitizer
     // read collision context from input
     auto context = pc.inputs().get<o2::steer::DigitizationContext*>("collisioncontext");
     context->initSimChains(mID, mSimChains);
+    // only the background events of embedding productions are used for several collisions
+    mHitCache.setCachedSources(context->getSimPrefixes().size() > 1 ? std::vector<int>{0} : std::vector<int>{});
     const bool withQED = context->isQEDProvided() && !mDisableQED;
     auto& timesview = context->getEventRecords(withQED);
     LOG(info) << "GOT " << timesview.size() << " COLLISSION TIMES";
@@ -145,7 +150,7 @@ class ITSMFTDPLDigitizerTask : BaseDPLDigitizer
 
         // get the hits for this event and this source
         mHits.clear();
-        context->retrieveHits(mSimChains, o2::detectors::SimTraits::DETECTORBRANCHNAMES[mID][0].c_str(), part.sourceID, part.entryID, &mHits);
+        context->retrieveHits(mSimChains, o2::detectors::SimTraits::DETECTORBRANCHNAMES[mID][0].c_str(), part.sourceID, part.entryID, &mHits, mHitCache);
 
         if (mHits.size() > 0) {
           LOG(debug) << "For collision " << collID << " eventID " << part.entryID
@@ -175,6 +180,9 @@ class ITSMFTDPLDigitizerTask : BaseDPLDigitizer
 
     timer.Stop();
     LOG(info) << "Digitization took " << timer.CpuTime() << "s";
+    if (mHitCache.getNHits() > 0) {
+      LOG(info) << "Background hits taken " << mHitCache.getNHits() << " times from the cache, read " << mHitCache.getNMisses() << " times";
+    }
 
     // we should be only called once; tell DPL that this process is ready to exit
     pc.services().get<ControlService>().readyToQuit(QuitRequest::Me);
@@ -211,6 +219,11 @@ class ITSMFTDPLDigitizerTask : BaseDPLDigitizer
 
       return;
     }
+    if (matcher == ConcreteDataMatcher(mOrigin, "CLUSDICT", 0)) {
+      LOG(info) << mID.getName() << " cluster dictionary updated";
+      mDigitizer.setTopologyDictionary((const o2::itsmft::TopologyDictionary*)obj);
+      return;
+    }
     if (matcher == ConcreteDataMatcher(mOrigin, "ALPIDEPARAM", 0)) {
       LOG(info) << mID.getName() << " Alpide param updated";
       if (mID == o2::detectors::DetID::ITS) {
@@ -238,6 +251,9 @@ class ITSMFTDPLDigitizerTask : BaseDPLDigitizer
     pc.inputs().get<o2::itsmft::DPLAlpideParam<DETID>*>(detstr + "_alppar");
 
     auto& dopt = o2::itsmft::DPLDigitizerParam<DETID>::Instance();
+    if (dopt.useTopologyFastSim) {
+      pc.inputs().get<o2::itsmft::TopologyDictionary*>(detstr + "_cldict");
+    }
     auto& aopt = o2::itsmft::DPLAlpideParam<DETID>::Instance();
     auto& digipar = mDigitizer.getParams();
     digipar.setContinuous(dopt.continuous);
@@ -296,6 +312,7 @@ class ITSMFTDPLDigitizerTask : BaseDPLDigitizer
   o2::dataformats::MCTruthContainer<o2::MCCompLabel> mLabelsAccum;
   std::vector<o2::itsmft::MC2ROFRecord> mMC2ROFRecordsAccum;
   std::vector<TChain*> mSimChains;
+  o2::steer::HitCache mHitCache; // hits of background events, which are used by several collisions
   o2::itsmft::NoiseMap* mDeadMap = nullptr;
 
   int mFixMC2ROF = 0;                                                             // 1st entry in mc2rofRecordsAccum to be fixed for ROFRecordID
@@ -365,6 +382,9 @@ DataProcessorSpec getITSDigitizerSpec(int channel, bool mctruth)
   inputs.emplace_back("ITS_dead", "ITS", "DEADMAP", 0, Lifetime::Condition, ccdbParamSpec("ITS/Calib/DeadMap"));
   inputs.emplace_back("ITS_time_dead", "ITS", "TimeDeadMap", 0, Lifetime::Condition, ccdbParamSpec("ITS/Calib/TimeDeadMap"));
   inputs.emplace_back("ITS_alppar", "ITS", "ALPIDEPARAM", 0, Lifetime::Condition, ccdbParamSpec("ITS/Config/AlpideParam"));
+  if (o2::itsmft::DPLDigitizerParam<ITSDPLDigitizerTask::DETID>::Instance().useTopologyFastSim) {
+    inputs.emplace_back("ITS_cldict", "ITS", "CLUSDICT", 0, Lifetime::Condition, ccdbParamSpec("ITS/Calib/ClusterDictionary"));
+  }
 
   return DataProcessorSpec{(detStr + "Digitizer").c_str(),
                            inputs, makeOutChannels(detOrig, mctruth),
@@ -384,6 +404,9 @@ DataProcessorSpec getMFTDigitizerSpec(int channel, bool mctruth)
   inputs.emplace_back("MFT_dead", "MFT", "DEADMAP", 0, Lifetime::Condition, ccdbParamSpec("MFT/Calib/DeadMap"));
   inputs.emplace_back("MFT_time_dead", "MFT", "TimeDeadMap", 0, Lifetime::Condition, ccdbParamSpec("MFT/Calib/TimeDeadMap"));
   inputs.emplace_back("MFT_alppar", "MFT", "ALPIDEPARAM", 0, Lifetime::Condition, ccdbParamSpec("MFT/Config/AlpideParam"));
+  if (o2::itsmft::DPLDigitizerParam<MFTDPLDigitizerTask::DETID>::Instance().useTopologyFastSim) {
+    inputs.emplace_back("MFT_cldict", "MFT", "CLUSDICT", 0, Lifetime::Condition, ccdbParamSpec("MFT/Calib/ClusterDictionary"));
+  }
   parHelper << "Params as " << o2::itsmft::DPLDigitizerParam<ITSDPLDigitizerTask::DETID>::getParamName().data() << ".<param>=value;... with"
             << o2::itsmft::DPLDigitizerParam<ITSDPLDigitizerTask::DETID>::Instance()
             << " or " << o2::itsmft::DPLAlpideParam<ITSDPLDigitizerTask::DETID>::getParamName().data() << ".<param>=value;... with"
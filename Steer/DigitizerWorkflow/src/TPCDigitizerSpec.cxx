@@ -29,6 +29,7 @@
 #include "TChain.h"
 #include <SimulationDataFormat/MCCompLabel.h>
 #include <SimulationDataFormat/ConstMCTruthContainer.h>
+#include <SimulationDataFormat/CompactMCTruthContainer.h>
 #include <SimulationDataFormat/IOMCTruthContainerView.h>
 #include "Framework/Task.h"
 #include "DataFormatsParameters/GRPObject.h"
@@ -44,7 +45,10 @@
 #include "CommonDataFormat/RangeReference.h"
 #include "SimConfig/DigiParams.h"
 #include <filesystem>
+#include <atomic>
+#include <thread>
 #include "Framework/CCDBParamSpec.h"
+#include "TROOT.h"
 
 using namespace o2::framework;
 using SubSpecificationType = o2::framework::DataAllocator::SubSpecificationType;
@@ -123,11 +127,21 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
     mUseCalibrationsFromCCDB = ic.options().get<bool>("TPCuseCCDB");
     mMeanLumiDistortions = ic.options().get<float>("meanLumiDistortions");
     mMeanLumiDistortionsDerivative = ic.options().get<float>("meanLumiDistortionsDerivative");
+    mNThreads = std::max(1, ic.options().get<int>("TPCnthreads"));
+    if (mNThreads > 1 && mInternalWriter) {
+      LOG(info) << "TPC: Internal writer requested, digitizing sectors sequentially";
+      mNThreads = 1;
+    }
+    if (mNThreads > 1) {
+      ROOT::EnableThreadSafety();
+      mThreadSimChains.resize(mNThreads);
+    }
 
     LOG(info) << "TPC calibrations from CCDB: " << mUseCalibrationsFromCCDB;
 
     mDigitizer.setContinuousReadout(!triggeredMode);
     mDigitizer.setDistortionScaleType(mDistortionType);
+    mHitCache.setMaxBytes(size_t(std::max(0, o2::conf::DigiParams::Instance().bgHitCacheMB)) << 20);
 
     // we send the GRP data once if the corresponding output channel is available
     // and set the flag to false after
@@ -150,7 +164,7 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
     }
   }
 
-  void writeToROOTFile()
+  void writeToROOTFile(std::vector<o2::tpc::Digit>& digits, o2::dataformats::MCTruthContainer<o2::MCCompLabel>& labels, std::vector<o2::tpc::CommonMode>& commonMode)
   {
     if (!mInternalROOTFlushFile) {
       std::stringstream tmp;
@@ -163,7 +177,7 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
     {
       std::stringstream brname;
       brname << "TPCDigit_" << mSector;
-      auto br = o2::base::getOrMakeBranch(*mInternalROOTFlushTTree, brname.str().c_str(), &mDigits);
+      auto br = o2::base::getOrMakeBranch(*mInternalROOTFlushTTree, brname.str().c_str(), &digits);
       br->Fill();
       br->ResetAddress();
     }
@@ -171,7 +185,7 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
       // labels
       std::stringstream brname;
       brname << "TPCDigitMCTruth_" << mSector;
-      auto br = o2::base::getOrMakeBranch(*mInternalROOTFlushTTree, brname.str().c_str(), &mLabels);
+      auto br = o2::base::getOrMakeBranch(*mInternalROOTFlushTTree, brname.str().c_str(), &labels);
       br->Fill();
       br->ResetAddress();
     }
@@ -179,7 +193,7 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
       // common
       std::stringstream brname;
       brname << "TPCCommonMode_" << mSector;
-      auto br = o2::base::getOrMakeBranch(*mInternalROOTFlushTTree, brname.str().c_str(), &mCommonMode);
+      auto br = o2::base::getOrMakeBranch(*mInternalROOTFlushTTree, brname.str().c_str(), &commonMode);
       br->Fill();
       br->ResetAddress();
     }
@@ -242,38 +256,130 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
       cdb.setGainMapFromFile("GainMap.root");
     }
 
+    std::vector<framework::DataRef> inputrefs;
     for (auto it = pc.inputs().begin(), end = pc.inputs().end(); it != end; ++it) {
       for (auto const& inputref : it) {
         if (inputref.spec->lifetime == o2::framework::Lifetime::Condition) { // process does not need conditions
           continue;
         }
-        process(pc, inputref);
-        if (mInternalWriter) {
-          mInternalROOTFlushTTree->SetEntries(mFlushCounter);
-          mInternalROOTFlushFile->Write("", TObject::kOverwrite);
-          mInternalROOTFlushFile->Close();
-          // delete mInternalROOTFlushTTree; --> automatically done by ->Close()
-          delete mInternalROOTFlushFile;
-          mInternalROOTFlushFile = nullptr;
-        }
-        // TODO: make generic reset method?
-        mFlushCounter = 0;
-        mDigitCounter = 0;
+        inputrefs.push_back(inputref);
+      }
+    }
+
+    if (mNThreads > 1 && inputrefs.size() > 1) {
+      processParallel(pc, inputrefs);
+      reportHitCache();
+      return;
+    }
+
+    for (auto const& inputref : inputrefs) {
+      process(pc, inputref);
+      if (mInternalWriter) {
+        mInternalROOTFlushTTree->SetEntries(mFlushCounter);
+        mInternalROOTFlushFile->Write("", TObject::kOverwrite);
+        mInternalROOTFlushFile->Close();
+        // delete mInternalROOTFlushTTree; --> automatically done by ->Close()
+        delete mInternalROOTFlushFile;
+        mInternalROOTFlushFile = nullptr;
       }
+      // TODO: make generic reset method?
+      mFlushCounter = 0;
+    }
+    reportHitCache();
+  }
+
+  void reportHitCache() const
+  {
+    if (mHitCache.getNHits() > 0) {
+      LOG(info) << "TPC: Background hits taken " << mHitCache.getNHits() << " times from the cache, read " << mHitCache.getNMisses()
+                << " times, cache holds " << mHitCache.getNEntries() << " entries (" << (mHitCache.getBytes() >> 20) << " MB)";
     }
   }
 
+  // the digitization output of one sector
+  struct SectorOutput {
+    int sector = -1;
+    uint64_t activeSectors = 0;
+    SubSpecificationType subSpecification = 0;
+    std::vector<o2::tpc::Digit>* digits = nullptr;                     // DPL owned accumulator for digits (in shared memory)
+    o2::dataformats::CompactMCTruthContainer<o2::MCCompLabel> labels; // timeframe accumulator for labels (digits of the same track share them)
+    std::vector<CommonMode> commonMode;
+    std::vector<DigiGroupRef> events;
+  };
+
   // process one sector
   void process(framework::ProcessingContext& pc, framework::DataRef const& inputref)
   {
     // read collision context from input
     auto context = pc.inputs().get<o2::steer::DigitizationContext*>(inputref);
     context->initSimChains(o2::detectors::DetID::TPC, mSimChains);
-    auto& irecords = context->getEventRecords();
+    SectorOutput output;
+    if (!prepareSector(pc, inputref, *context, output)) {
+      return;
+    }
+    digitizeSector(mDigitizer, mSimChains, *context, output);
+    sendSector(pc, output);
+  }
+
+  // process the sectors of all inputs in parallel, each thread using its own digitizer and hit chains;
+  // the DPL interaction (making and sending the outputs) stays on the calling thread
+  void processParallel(framework::ProcessingContext& pc, std::vector<framework::DataRef> const& inputrefs)
+  {
+    using ContextPtr = decltype(pc.inputs().get<o2::steer::DigitizationContext*>(inputrefs[0]));
+    std::vector<ContextPtr> contexts;
+    std::vector<SectorOutput> outputs(inputrefs.size());
+    std::vector<size_t> tasks; // inputs with a sector to digitize
+    for (size_t i = 0; i < inputrefs.size(); ++i) {
+      contexts.emplace_back(pc.inputs().get<o2::steer::DigitizationContext*>(inputrefs[i]));
+      if (prepareSector(pc, inputrefs[i], *contexts.back(), outputs[i])) {
+        tasks.push_back(i);
+      }
+    }
+    if (tasks.empty()) {
+      return;
+    }
+
+    // load the calibration objects from this thread, they are only read by the digitization threads
+    mDigitizer.init();
+
+    const int nThreads = std::min<int>(mNThreads, tasks.size());
+    LOG(info) << "TPC: Digitizing " << tasks.size() << " sectors with " << nThreads << " threads";
+    std::atomic<size_t> nextTask{0};
+    auto worker = [&](int ithread) {
+      o2::tpc::Digitizer digitizer;
+      digitizer.copySettingsFrom(mDigitizer);
+      auto& simChains = mThreadSimChains[ithread];
+      for (size_t itask = nextTask++; itask < tasks.size(); itask = nextTask++) {
+        auto const& context = *contexts[tasks[itask]];
+        context.initSimChains(o2::detectors::DetID::TPC, simChains);
+        digitizeSector(digitizer, simChains, context, outputs[tasks[itask]]);
+      }
+    };
+    std::vector<std::thread> threads;
+    for (int ithread = 1; ithread < nThreads; ++ithread) {
+      threads.emplace_back(worker, ithread);
+    }
+    worker(0);
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    // send out in the order of the inputs
+    for (auto itask : tasks) {
+      sendSector(pc, outputs[itask]);
+    }
+  }
+
+  // extract the sector of an input and set up its output, returns false if there is nothing to digitize
+  bool prepareSector(framework::ProcessingContext& pc, framework::DataRef const& inputref, o2::steer::DigitizationContext const& context, SectorOutput& output)
+  {
+    auto& irecords = context.getEventRecords();
     LOG(info) << "TPC: Processing " << irecords.size() << " collisions";
     if (irecords.size() == 0) {
-      return;
+      return false;
     }
+    // only the background events of embedding productions are used for several collisions
+    mHitCache.setCachedSources(context.getSimPrefixes().size() > 1 ? std::vector<int>{0} : std::vector<int>{});
     auto const* dh = DataRefUtils::getHeader<o2::header::DataHeader*>(inputref);
 
     bool isContinuous = mDigitizer.isContinuousReadout();
@@ -290,64 +396,23 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
     auto const* sectorHeader = DataRefUtils::getHeader<TPCSectorHeader*>(inputref);
     if (sectorHeader == nullptr) {
       LOG(error) << "TPC: Sector header missing, skipping processing";
-      return;
+      return false;
     }
     auto sector = sectorHeader->sector();
     mSector = sector;
     mListOfSectors.push_back(sector);
     LOG(info) << "TPC: Processing sector " << sector;
     // the active sectors need to be propagated
-    uint64_t activeSectors = 0;
-    activeSectors = sectorHeader->activeSectors;
+    output.sector = sector;
+    output.activeSectors = sectorHeader->activeSectors;
+    output.subSpecification = static_cast<SubSpecificationType>(dh->subSpecification);
 
-    // lambda that creates a DPL owned buffer to accumulate the digits (in shared memory)
-    auto makeDigitBuffer = [this, sector, &pc, activeSectors, &dh]() {
-      o2::tpc::TPCSectorHeader header{sector};
-      header.activeSectors = activeSectors;
-      if (mInternalWriter) {
-        using ContainerType = std::decay_t<decltype(pc.outputs().make<std::vector<o2::tpc::Digit>>(Output{"", "", 0}))>*;
-        return ContainerType(nullptr);
-      } else {
-        // default case
-        return &pc.outputs().make<std::vector<o2::tpc::Digit>>(Output{"TPC", "DIGITS", static_cast<SubSpecificationType>(dh->subSpecification), header});
-      }
-    };
-    // lambda that snapshots the common mode vector to be sent out; prepares and attaches header with sector information
-    auto snapshotCommonMode = [this, sector, &pc, activeSectors, &dh](std::vector<o2::tpc::CommonMode> const& commonMode) {
-      o2::tpc::TPCSectorHeader header{sector};
-      header.activeSectors = activeSectors;
-      if (!mInternalWriter) {
-        // note that snapshoting only works with non-const references (to be fixed?)
-        pc.outputs().snapshot(Output{"TPC", "COMMONMODE", static_cast<SubSpecificationType>(dh->subSpecification), header},
-                              const_cast<std::vector<o2::tpc::CommonMode>&>(commonMode));
-      }
-    };
-    // lambda that snapshots labels to be sent out; prepares and attaches header with sector information
-    auto snapshotLabels = [this, &sector, &pc, activeSectors, &dh](o2::dataformats::MCTruthContainer<o2::MCCompLabel> const& labels) {
-      o2::tpc::TPCSectorHeader header{sector};
-      header.activeSectors = activeSectors;
-      if (mWithMCTruth) {
-        if (!mInternalWriter) {
-          auto& sharedlabels = pc.outputs().make<o2::dataformats::ConstMCTruthContainer<o2::MCCompLabel>>(Output{"TPC", "DIGITSMCTR", static_cast<SubSpecificationType>(dh->subSpecification), header});
-          labels.flatten_to(sharedlabels);
-        }
-      }
-    };
-    // lambda that snapshots digits grouping (triggers) to be sent out; prepares and attaches header with sector information
-    auto snapshotEvents = [this, sector, &pc, activeSectors, &dh](const std::vector<DigiGroupRef>& events) {
+    // create a DPL owned buffer to accumulate the digits (in shared memory)
+    if (!mInternalWriter) {
       o2::tpc::TPCSectorHeader header{sector};
-      header.activeSectors = activeSectors;
-      if (!mInternalWriter) {
-        LOG(info) << "TPC: Send TRIGGERS for sector " << sector << " channel " << dh->subSpecification << " | size " << events.size();
-        pc.outputs().snapshot(Output{"TPC", "DIGTRIGGERS", static_cast<SubSpecificationType>(dh->subSpecification), header},
-                              const_cast<std::vector<DigiGroupRef>&>(events));
-      }
-    };
-
-    auto digitsAccum = makeDigitBuffer();                          // accumulator for digits
-    o2::dataformats::MCTruthContainer<o2::MCCompLabel> labelAccum; // timeframe accumulator for labels
-    std::vector<CommonMode> commonModeAccum;
-    std::vector<DigiGroupRef> eventAccum;
+      header.activeSectors = output.activeSectors;
+      output.digits = &pc.outputs().make<std::vector<o2::tpc::Digit>>(Output{"TPC", "DIGITS", output.subSpecification, header});
+    }
 
     // this should not happen any more, legacy condition when the sector variable was used
     // to transport control information
@@ -361,40 +426,53 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
     if (sector >= TPCSectorHeader::NSectors) {
       throw std::runtime_error("Digitizer can only work on single sectors");
     }
+    return true;
+  }
 
-    mDigitizer.setSector(sector);
-    mDigitizer.init();
+  // digitize all collisions of the context for one sector, does not interact with DPL
+  void digitizeSector(o2::tpc::Digitizer& digitizer, std::vector<TChain*> const& simChains, o2::steer::DigitizationContext const& context, SectorOutput& output)
+  {
+    const auto sector = output.sector;
+    digitizer.setSector(sector);
+    digitizer.init();
+
+    auto& irecords = context.getEventRecords();
+    auto& eventParts = context.getEventParts();
+    const bool isContinuous = digitizer.isContinuousReadout();
 
-    auto& eventParts = context->getEventParts();
+    std::vector<o2::tpc::Digit> digits;
+    o2::dataformats::MCTruthContainer<o2::MCCompLabel> labels;
+    std::vector<o2::tpc::CommonMode> commonMode;
+    size_t digitCounter = 0;
 
-    auto flushDigitsAndLabels = [this, digitsAccum, &labelAccum, &commonModeAccum](bool finalFlush = false) {
-      mFlushCounter++;
+    auto flushDigitsAndLabels = [this, &digitizer, &digits, &labels, &commonMode, &output, &digitCounter](bool finalFlush = false) {
       // flush previous buffer
-      mDigits.clear();
-      mLabels.clear();
-      mCommonMode.clear();
-      mDigitizer.flush(mDigits, mLabels, mCommonMode, finalFlush);
-      LOG(info) << "TPC: Flushed " << mDigits.size() << " digits, " << mLabels.getNElements() << " labels and " << mCommonMode.size() << " common mode entries";
+      digits.clear();
+      labels.clear();
+      commonMode.clear();
+      digitizer.flush(digits, labels, commonMode, finalFlush);
+      LOG(info) << "TPC: Flushed " << digits.size() << " digits, " << labels.getNElements() << " labels and " << commonMode.size() << " common mode entries";
 
       if (mInternalWriter) {
         // the natural place to write out this independent datachunk immediately ...
-        writeToROOTFile();
+        mFlushCounter++;
+        writeToROOTFile(digits, labels, commonMode);
       } else {
         // ... or to accumulate and later forward to next DPL proc
-        std::copy(mDigits.begin(), mDigits.end(), std::back_inserter(*digitsAccum));
+        std::copy(digits.begin(), digits.end(), std::back_inserter(*output.digits));
         if (mWithMCTruth) {
-          labelAccum.mergeAtBack(mLabels);
+          output.labels.mergeAtBack(labels);
         }
-        std::copy(mCommonMode.begin(), mCommonMode.end(), std::back_inserter(commonModeAccum));
+        std::copy(commonMode.begin(), commonMode.end(), std::back_inserter(output.commonMode));
       }
-      mDigitCounter += mDigits.size();
+      digitCounter += digits.size();
     };
 
     if (isContinuous) {
       auto& hbfu = o2::raw::HBFUtils::Instance();
       double time = hbfu.getFirstIRofTF(o2::InteractionRecord(0, hbfu.orbitFirstSampled)).bc2ns() / 1000.;
-      mDigitizer.setOutputDigitTimeOffset(time);
-      mDigitizer.setStartTime(irecords[0].getTimeNS() / 1000.f);
+      digitizer.setOutputDigitTimeOffset(time);
+      digitizer.setStartTime(irecords[0].getTimeNS() / 1000.f);
     }
 
     TStopwatch timer;
@@ -405,11 +483,11 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
     for (int collID = 0; collID < irecords.size(); ++collID) {
       const double eventTime = irecords[collID].getTimeNS() / 1000.f;
       LOG(info) << "TPC: Event time " << eventTime << " us";
-      mDigitizer.setEventTime(eventTime);
+      digitizer.setEventTime(eventTime);
       if (!isContinuous) {
-        mDigitizer.setStartTime(eventTime);
+        digitizer.setStartTime(eventTime);
       }
-      size_t startSize = mDigitCounter; // digitsAccum->size();
+      size_t startSize = digitCounter;
 
       // for each collision, loop over the constituents event and source IDs
       // (background signal merging is basically taking place here)
@@ -420,17 +498,17 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
         // get the hits for this event and this source
         std::vector<o2::tpc::HitGroup> hitsLeft;
         std::vector<o2::tpc::HitGroup> hitsRight;
-        context->retrieveHits(mSimChains, getBranchNameLeft(sector).c_str(), part.sourceID, part.entryID, &hitsLeft);
-        context->retrieveHits(mSimChains, getBranchNameRight(sector).c_str(), part.sourceID, part.entryID, &hitsRight);
+        context.retrieveHits(simChains, getBranchNameLeft(sector).c_str(), part.sourceID, part.entryID, &hitsLeft, mHitCache);
+        context.retrieveHits(simChains, getBranchNameRight(sector).c_str(), part.sourceID, part.entryID, &hitsRight, mHitCache);
         LOG(debug) << "TPC: Found " << hitsLeft.size() << " hit groups left and " << hitsRight.size() << " hit groups right in collision " << collID << " eventID " << part.entryID;
 
-        mDigitizer.process(hitsLeft, eventID, sourceID);
-        mDigitizer.process(hitsRight, eventID, sourceID);
+        digitizer.process(hitsLeft, eventID, sourceID);
+        digitizer.process(hitsRight, eventID, sourceID);
 
         flushDigitsAndLabels();
 
         if (!isContinuous) {
-          eventAccum.emplace_back(startSize, mDigits.size());
+          output.events.emplace_back(startSize, digits.size());
         }
       }
     }
@@ -439,33 +517,43 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
     if (isContinuous) {
       LOG(info) << "TPC: Final flush";
       flushDigitsAndLabels(true);
-      eventAccum.emplace_back(0, mDigitCounter); // all digits are grouped to 1 super-event pseudo-triggered mode
+      output.events.emplace_back(0, digitCounter); // all digits are grouped to 1 super-event pseudo-triggered mode
     }
 
-    if (!mInternalWriter) {
-      // send out to next stage
-      snapshotEvents(eventAccum);
-      // snapshotDigits(digitsAccum); --> done automatically
-      snapshotCommonMode(commonModeAccum);
-      snapshotLabels(labelAccum);
+    timer.Stop();
+    LOG(info) << "TPC: Digitization of sector " << sector << " took " << timer.CpuTime() << "s";
+  }
+
+  // send out the digitization output of one sector to the next stage; prepares and attaches header with sector information
+  void sendSector(framework::ProcessingContext& pc, SectorOutput& output)
+  {
+    if (mInternalWriter) {
+      return;
     }
+    o2::tpc::TPCSectorHeader header{output.sector};
+    header.activeSectors = output.activeSectors;
 
-    timer.Stop();
-    LOG(info) << "TPC: Digitization took " << timer.CpuTime() << "s";
+    LOG(info) << "TPC: Send TRIGGERS for sector " << output.sector << " channel " << output.subSpecification << " | size " << output.events.size();
+    pc.outputs().snapshot(Output{"TPC", "DIGTRIGGERS", output.subSpecification, header}, output.events);
+    // the digits are sent automatically from the DPL owned buffer
+    pc.outputs().snapshot(Output{"TPC", "COMMONMODE", output.subSpecification, header}, output.commonMode);
+    if (mWithMCTruth) {
+      auto& sharedlabels = pc.outputs().make<o2::dataformats::ConstMCTruthContainer<o2::MCCompLabel>>(Output{"TPC", "DIGITSMCTR", output.subSpecification, header});
+      output.labels.flatten_to(sharedlabels);
+    }
   }
 
  private:
   o2::tpc::Digitizer mDigitizer;
   o2::tpc::VDriftHelper mTPCVDriftHelper{};
   std::vector<TChain*> mSimChains;
-  std::vector<o2::tpc::Digit> mDigits;
-  o2::dataformats::MCTruthContainer<o2::MCCompLabel> mLabels;
-  std::vector<o2::tpc::CommonMode> mCommonMode;
+  std::vector<std::vector<TChain*>> mThreadSimChains; // hit chains of the digitization threads
+  o2::steer::HitCache mHitCache;                      // hits of background events, kept across timeframes
   std::vector<int> mListOfSectors; //  a list of sectors treated by this task
   TFile* mInternalROOTFlushFile = nullptr;
   TTree* mInternalROOTFlushTTree = nullptr;
-  size_t mDigitCounter = 0;
   size_t mFlushCounter = 0;
+  int mNThreads = 1; // number of threads digitizing sectors in parallel
   int mLaneId = 0; // the id of the current process within the parallel pipeline
   int mSector = 0;
   bool mWriteGRP = false;
@@ -513,6 +601,7 @@ o2::framework::DataProcessorSpec getTPCDigitizerSpec(int channel, bool writeGRP,
       {"TPCuseCCDB", VariantType::Bool, false, {"true: load calibrations from CCDB; false: use random calibratoins"}},
       {"meanLumiDistortions", VariantType::Float, -1.f, {"override lumi of distortion object if >=0"}},
       {"meanLumiDistortionsDerivative", VariantType::Float, -1.f, {"override lumi of derivative distortion object if >=0"}},
+      {"TPCnthreads", VariantType::Int, 1, {"number of threads digitizing the sectors of this device in parallel"}},
     }};
 }
 
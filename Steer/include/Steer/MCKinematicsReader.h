@@ -82,6 +82,16 @@ class MCKinematicsReader
   /// API to ask releasing tracks (freeing memory) for source + event
   void releaseTracksForSourceAndEvent(int source, int event);
 
+  /// Limit the number of events whose tracks are kept in memory (0 = no limit, the default).
+  /// When the limit is reached, the tracks of the least recently accessed event are released
+  /// before loading a new one. Pointers and references to the tracks of a released event
+  /// obtained before become invalid.
+  void setMaxCachedEvents(size_t maxEvents) { mMaxCachedEvents = maxEvents; }
+  size_t getMaxCachedEvents() const { return mMaxCachedEvents; }
+
+  /// number of events whose tracks are currently kept in memory
+  size_t getNCachedEvents() const { return mNCachedEvents; }
+
   /// variant returning all tracks for an event id (source = 0) at once
   std::vector<MCTrack> const& getTracks(int event) const;
 
@@ -115,6 +125,8 @@ class MCKinematicsReader
  private:
   void initTracksForSource(int source) const;
   void loadTracksForSourceAndEvent(int source, int eventID) const;
+  void releaseTracks(int source, int eventID) const;
+  void releaseLeastRecentlyUsedTracks() const;
   void loadHeadersForSource(int source) const;
   void loadTrackRefsForSource(int source) const;
   void initIndexedTrackRefs(std::vector<o2::TrackReference>& refs, o2::dataformats::MCTruthContainer<o2::TrackReference>& indexedrefs) const;
@@ -126,6 +138,10 @@ class MCKinematicsReader
 
   // a vector of tracks foreach source and each collision
   mutable std::vector<std::vector<std::vector<o2::MCTrack>*>> mTracks;                                       // the in-memory track container
+  mutable std::vector<std::vector<size_t>> mTracksLastUse;                                                   // access stamp of the in-memory tracks of each event
+  mutable size_t mTracksUseCounter = 0;                                                                      // counter giving the access stamps
+  mutable size_t mNCachedEvents = 0;                                                                         // number of events with tracks in memory
+  size_t mMaxCachedEvents = 0;                                                                               // maximal number of events with tracks in memory (0 = no limit)
   mutable std::vector<std::vector<o2::dataformats::MCEventHeader>> mHeaders;                                 // the in-memory header container
   mutable std::vector<std::vector<o2::dataformats::MCTruthContainer<o2::TrackReference>>> mIndexedTrackRefs; // the in-memory track ref container
 
@@ -158,6 +174,9 @@ inline std::vector<MCTrack> const& MCKinematicsReader::getTracks(int source, int
   if (mTracks[source][event] == nullptr) {
     loadTracksForSourceAndEvent(source, event);
   }
+  if (mMaxCachedEvents > 0) {
+    mTracksLastUse[source][event] = ++mTracksUseCounter;
+  }
   return *mTracks[source][event];
 }
 
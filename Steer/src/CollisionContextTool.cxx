@@ -22,6 +22,8 @@
 #include <cmath>
 #include <TRandom.h>
 #include <numeric>
+#include <iterator>
+#include <algorithm>
 #include <fairlogger/Logger.h>
 #include "Steer/MCKinematicsReader.h"
 #include "CommonUtils/ConfigurableParam.h"
@@ -290,16 +292,18 @@ int main(int argc, char* argv[])
         record = sampler.generateCollisionTime();
       } while (options.noEmptyTF && usetimeframelength && record.orbit >= orbitstart + options.orbits);
       int count = 0;
+      // the sampler produces the records in time order: collect them separately and merge them
+      // with the collisions of the previous sources in one pass, instead of inserting every
+      // record in the middle of the (large) collisions vector
+      std::vector<std::pair<o2::InteractionTimeRecord, std::vector<o2::steer::EventPart>>> newcollisions;
+      if (ispecs[id].mcnumberasked > 0) {
+        newcollisions.reserve(ispecs[id].mcnumberasked);
+      }
       do {
         if (usetimeframelength && record.orbit >= orbitstart + options.orbits) {
           break;
         }
-        std::vector<o2::steer::EventPart> parts;
-        parts.emplace_back(id, count);
-
-        std::pair<o2::InteractionTimeRecord, std::vector<o2::steer::EventPart>> insertvalue(record, parts);
-        auto iter = std::lower_bound(collisions.begin(), collisions.end(), insertvalue, [](std::pair<o2::InteractionTimeRecord, std::vector<o2::steer::EventPart>> const& a, std::pair<o2::InteractionTimeRecord, std::vector<o2::steer::EventPart>> const& b) { return a.first < b.first; });
-        collisions.insert(iter, insertvalue);
+        newcollisions.emplace_back(record, std::vector<o2::steer::EventPart>{o2::steer::EventPart(id, count)});
         record = sampler.generateCollisionTime();
         count++;
       } while ((ispecs[id].mcnumberasked > 0 && count < ispecs[id].mcnumberasked));
@@ -326,14 +330,20 @@ int main(int argc, char* argv[])
         }
       }
       // make these transformations final:
-      for (auto& col : collisions) {
+      for (auto& col : newcollisions) {
         for (auto& part : col.second) {
-          if (part.sourceID == id) {
-            part.entryID = eventindices[part.entryID];
-          }
+          part.entryID = eventindices[part.entryID];
         }
       }
 
+      // for equal times the new collision goes first, as the ordered insertion did
+      std::vector<std::pair<o2::InteractionTimeRecord, std::vector<o2::steer::EventPart>>> merged;
+      merged.reserve(collisions.size() + newcollisions.size());
+      std::merge(std::make_move_iterator(newcollisions.begin()), std::make_move_iterator(newcollisions.end()),
+                 std::make_move_iterator(collisions.begin()), std::make_move_iterator(collisions.end()),
+                 std::back_inserter(merged), [](auto const& a, auto const& b) { return a.first < b.first; });
+      collisions = std::move(merged);
+
       // keep bunch filling information produced by these samplers
       bunchFillings.push_back(sampler.getBunchFilling());
 
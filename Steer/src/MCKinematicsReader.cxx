@@ -57,6 +57,7 @@ void MCKinematicsReader::initTracksForSource(int source) const
     // todo: get name from NameConfig
     auto br = chain->GetBranch("MCTrack");
     mTracks[source].resize(br->GetEntries(), nullptr);
+    mTracksLastUse[source].resize(br->GetEntries(), 0);
   }
 }
 
@@ -67,24 +68,52 @@ void MCKinematicsReader::loadTracksForSourceAndEvent(int source, int event) cons
     // todo: get name from NameConfig
     auto br = chain->GetBranch("MCTrack");
     if (br) {
+      if (mMaxCachedEvents > 0 && mNCachedEvents >= mMaxCachedEvents) {
+        releaseLeastRecentlyUsedTracks();
+      }
+      // the vector created by ROOT is taken over directly
       std::vector<MCTrack>* loadtracks = nullptr;
       br->SetAddress(&loadtracks);
       br->GetEntry(event);
-      mTracks[source][event] = new std::vector<o2::MCTrack>;
-      *mTracks[source][event] = *loadtracks;
-      delete loadtracks;
+      br->ResetAddress();
+      mTracks[source][event] = loadtracks ? loadtracks : new std::vector<o2::MCTrack>;
+      ++mNCachedEvents;
     }
   }
 }
 
-void MCKinematicsReader::releaseTracksForSourceAndEvent(int source, int eventID)
+void MCKinematicsReader::releaseTracks(int source, int eventID) const
 {
   if (mTracks.at(source).at(eventID) != nullptr) {
     delete mTracks[source][eventID];
     mTracks[source][eventID] = nullptr;
+    --mNCachedEvents;
   }
 }
 
+void MCKinematicsReader::releaseLeastRecentlyUsedTracks() const
+{
+  int lruSource = -1, lruEvent = -1;
+  size_t lruStamp = 0;
+  for (int source = 0; source < mTracks.size(); ++source) {
+    for (int event = 0; event < mTracks[source].size(); ++event) {
+      if (mTracks[source][event] != nullptr && (lruSource < 0 || mTracksLastUse[source][event] < lruStamp)) {
+        lruSource = source;
+        lruEvent = event;
+        lruStamp = mTracksLastUse[source][event];
+      }
+    }
+  }
+  if (lruSource >= 0) {
+    releaseTracks(lruSource, lruEvent);
+  }
+}
+
+void MCKinematicsReader::releaseTracksForSourceAndEvent(int source, int eventID)
+{
+  releaseTracks(source, eventID);
+}
+
 void MCKinematicsReader::loadHeadersForSource(int source) const
 {
   auto chain = mInputChains[source];
@@ -151,6 +180,7 @@ bool MCKinematicsReader::initFromDigitContext(std::string_view name)
 
   // load the kinematics information
   mTracks.resize(mInputChains.size());
+  mTracksLastUse.resize(mInputChains.size());
   mHeaders.resize(mInputChains.size());
   mIndexedTrackRefs.resize(mInputChains.size());
 
@@ -169,6 +199,7 @@ bool MCKinematicsReader::initFromKinematics(std::string_view name)
   mInputChains.emplace_back(new TChain("o2sim"));
   mInputChains.back()->AddFile(o2::base::NameConf::getMCKinematicsFileName(name.data()).c_str());
   mTracks.resize(1);
+  mTracksLastUse.resize(1);
   mHeaders.resize(1);
   mIndexedTrackRefs.resize(1);
   mInitialized = true;
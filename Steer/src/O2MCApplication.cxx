@@ -20,6 +20,7 @@
 #include <SimConfig/SimConfig.h>
 #include <DetectorsBase/Detector.h>
 #include "DetectorsBase/Aligner.h"
+#include "DetectorsBase/FastSimRegion.h"
 #include "DetectorsBase/MaterialManager.h"
 #include <CommonUtils/ShmManager.h>
 #include <cassert>
@@ -98,6 +99,14 @@ void O2MCApplicationBase::Stepping()
     }
   }
 
+  // particles entering a fast simulation region are handed to the shower model
+  // registered by the detector, which produces the hits directly
+  static auto const& fastSimRegistry = o2::base::FastSimRegistry::instance();
+  if (!fastSimRegistry.empty() && fastSimRegistry.process(fMC)) {
+    fMC->StopTrack();
+    return;
+  }
+
   if (mCutParams.stepTrackRefHook) {
     mTrackRefFcn(fMC);
   }
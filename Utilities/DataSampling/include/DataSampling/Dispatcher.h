@@ -67,7 +67,8 @@ class Dispatcher : public framework::Task
   DataSamplingHeader prepareDataSamplingHeader(const DataSamplingPolicy& policy);
   header::Stack extractAdditionalHeaders(const char* inputHeaderStack) const;
   void reportStats(monitoring::Monitoring& monitoring) const;
-  void send(framework::DataAllocator& dataAllocator, const framework::DataRef& inputData, const framework::Output& output) const;
+  void send(framework::DataAllocator& dataAllocator, const framework::DataRef& inputData, const framework::Output& output,
+            const fair::mq::Message* inputPayload) const;
 
   std::string mName;
   DataSamplingHeader::DeviceIDType mDeviceID = "invalid";
@@ -100,7 +100,8 @@ void Dispatcher::run(ProcessingContext& ctx)
       if (auto route = policy->match(inputMatcher); route != nullptr && policy->decide(firstPart)) {
         auto routeAsConcreteDataType = DataSpecUtils::asConcreteDataTypeMatcher(*route);
         auto dsheader = prepareDataSamplingHeader(*policy);
-        for (const auto& part : inputIt) {
+        for (size_t partIndex = 0; partIndex < inputIt.size(); partIndex++) {
+          const DataRef& part = inputIt.getByPos(partIndex);
           if (part.header != nullptr) {
             // We copy every header which is not DataHeader or DataProcessingHeader,
             // so that custom data-dependent headers are passed forward,
@@ -115,7 +116,7 @@ void Dispatcher::run(ProcessingContext& ctx)
               routeAsConcreteDataType.description,
               partInputHeader->subSpecification,
               std::move(headerStack)};
-            send(ctx.outputs(), part, output);
+            send(ctx.outputs(), part, output, ctx.inputs().span().payloadMessage(inputIt.position(), partIndex));
           }
         }
       }
@@ -170,9 +171,15 @@ header::Stack Dispatcher::extractAdditionalHeaders(const char* inputHeaderStack)
   return headerStack;
 }
 
-void Dispatcher::send(DataAllocator& dataAllocator, const DataRef& inputData, const Output& output) const
+void Dispatcher::send(DataAllocator& dataAllocator, const DataRef& inputData, const Output& output,
+                      const fair::mq::Message* inputPayload) const
 {
   const auto* inputHeader = DataRefUtils::getHeader<header::DataHeader*>(inputData);
+  if (inputPayload != nullptr && inputPayload->GetData() == inputData.payload) {
+    // Only the header stack is new, the sampled payload is shared with the input.
+    dataAllocator.forward(output, *inputPayload, inputHeader->payloadSerializationMethod);
+    return;
+  }
   dataAllocator.snapshot(output, inputData.payload, DataRefUtils::getPayloadSize(inputData), inputHeader->payloadSerializationMethod);
 }
 
@@ -0,0 +1,77 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file HistogramDelta.h
+/// \brief A sparse difference between two versions of a histogram
+
+#ifndef O2_HISTOGRAMDELTA_H
+#define O2_HISTOGRAMDELTA_H
+
+#include <TObject.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+class TH1;
+
+namespace o2::mergers
+{
+
+/// \brief Only the bins of a TH1, TH2 or TH3 which changed since the previous publication.
+///
+/// A producer which sends differences may publish a HistogramDelta instead of a full histogram
+/// when only a few of its bins changed. The first object published in a run has to be the full
+/// histogram, so that the merger knows its binning. Mergers apply the deltas in place with
+/// algorithm::merge, the bins are matched by their global bin number.
+class HistogramDelta : public TObject
+{
+ public:
+  HistogramDelta() = default;
+  ~HistogramDelta() override = default;
+
+  /// Creates the delta which brings \p previous to \p current. Both have to share the binning.
+  static std::unique_ptr<HistogramDelta> make(const TH1& current, const TH1& previous);
+
+  /// Adds the changed bins, their errors and the statistics to \p target.
+  void applyTo(TH1& target) const;
+
+  const char* GetName() const override
+  {
+    return mName.c_str();
+  }
+
+  /// The number of bins which are stored in the delta.
+  size_t size() const
+  {
+    return mBins.size();
+  }
+
+  /// The number of bins (including under- and overflows) of the histogram it was made of.
+  int getNcells() const
+  {
+    return mNcells;
+  }
+
+ private:
+  std::string mName;
+  int mNcells = 0;
+  std::vector<int> mBins;
+  std::vector<double> mContents;
+  std::vector<double> mSumw2; // empty if the histogram does not store the sum of squares of weights
+  std::vector<double> mStats;
+  double mEntries = 0;
+
+  ClassDefOverride(HistogramDelta, 1);
+};
+
+} // namespace o2::mergers
+
+#endif //O2_HISTOGRAMDELTA_H
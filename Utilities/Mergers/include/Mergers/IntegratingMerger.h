@@ -59,6 +59,7 @@ class IntegratingMerger : public framework::Task
   void publishIntegral(framework::DataAllocator& allocator);
   void publishMovingWindow(framework::DataAllocator& allocator);
   static void merge(ObjectStore& mMergedDelta, ObjectStore&& other);
+  void prepareForHistogramDelta(const ObjectStore& other);
   void clear();
 
  private:
@@ -67,6 +68,8 @@ class IntegratingMerger : public framework::Task
   ObjectStore mMergedObjectLastCycle = std::monostate{};
   // data points since the last state reset
   ObjectStore mMergedObjectIntegral = std::monostate{};
+  // an empty copy of the first full histogram in the run, the HistogramDeltas which start a cycle are applied to it
+  TObjectPtr mHistogramTemplate;
   MergerConfig mConfig;
   std::unique_ptr<monitoring::Monitoring> mCollector;
   int mCyclesSinceReset = 0;
@@ -19,6 +19,8 @@
 
 #include "ObjectStore.h"
 
+#include <vector>
+
 class TObject;
 
 namespace o2::mergers::algorithm
@@ -32,6 +34,12 @@ void merge(TObject* const target, TObject* const other);
 /// If such item exists it is merged into the target object. If not than the item is pushed to the end
 /// of targets vector.
 void merge(VectorOfTObjectPtrs& targets, const VectorOfTObjectPtrs& others);
+/// \brief A function which merges many TObjects into the target with a number of threads
+///
+/// The others are split among nThreads threads, each merging its share into a clone of the first object
+/// of the share. The per-thread results are merged into the target at the end. The others are not modified.
+/// ROOT thread safety has to be enabled (ROOT::EnableThreadSafety()) if nThreads > 1.
+void merge(TObject* const target, const std::vector<TObject*>& others, size_t nThreads);
 
 void deleteTCollections(TObject* obj);
 
@@ -96,6 +96,7 @@ struct MergerConfig {
   std::string monitoringUrl = "infologger:///debug?qc";
   std::string detectorName = "TST";
   ConfigEntry<ParallelismType> parallelismType = {ParallelismType::SplitInputs};
+  size_t mergingThreads = 1; // threads merging the latest versions of the objects at each publication (FullHistory input only)
   std::vector<o2::framework::DataProcessorLabel> labels;
 };
 
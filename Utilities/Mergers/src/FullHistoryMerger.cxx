@@ -25,6 +25,7 @@
 #include "Framework/Logger.h"
 #include <Monitoring/MonitoringFactory.h>
 #include <InfoLogger/InfoLogger.hxx>
+#include <TROOT.h>
 
 using namespace o2::header;
 using namespace o2::framework;
@@ -51,6 +52,9 @@ void FullHistoryMerger::init(framework::InitContext& ictx)
   mCyclesSinceReset = 0;
   mCollector = monitoring::MonitoringFactory::Get(mConfig.monitoringUrl);
   mCollector->addGlobalTag(monitoring::tags::Key::Subsystem, monitoring::tags::Value::Mergers);
+  if (mConfig.mergingThreads > 1) {
+    ROOT::EnableThreadSafety();
+  }
 
   // clear the state before starting the run, especially important for START->STOP->START sequence
   ictx.services().get<CallbackService>().set<CallbackService::Id::Start>([this]() { clear(); });
@@ -157,12 +161,14 @@ void FullHistoryMerger::mergeCache()
   // We expect that all the objects use the same kind of interface
   if (std::holds_alternative<TObjectPtr>(mMergedObject)) {
     auto target = std::get<TObjectPtr>(mMergedObject);
+    std::vector<TObject*> others;
+    others.reserve(mCache.size());
     for (auto& [name, entry] : mCache) {
       (void)name;
-      auto other = std::get<TObjectPtr>(entry);
-      algorithm::merge(target.get(), other.get());
-      mObjectsMerged++;
+      others.push_back(std::get<TObjectPtr>(entry).get());
     }
+    algorithm::merge(target.get(), others, mConfig.mergingThreads);
+    mObjectsMerged += others.size();
 
   } else if (std::holds_alternative<MergeInterfacePtr>(mMergedObject)) {
     auto target = std::get<MergeInterfacePtr>(mMergedObject);
@@ -0,0 +1,103 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file HistogramDelta.cxx
+/// \brief Implementation of HistogramDelta
+
+#include "Mergers/HistogramDelta.h"
+
+#include <TH1.h>
+#include <stdexcept>
+
+namespace o2::mergers
+{
+
+std::unique_ptr<HistogramDelta> HistogramDelta::make(const TH1& current, const TH1& previous)
+{
+  if (current.GetNcells() != previous.GetNcells() || current.GetDimension() != previous.GetDimension()) {
+    throw std::runtime_error(std::string("Cannot make a delta of the histogram '") + current.GetName() +
+                             "', the previous version has a different binning");
+  }
+  if (current.TestBit(TH1::kIsAverage)) {
+    throw std::runtime_error(std::string("Cannot make a delta of the histogram '") + current.GetName() + "', it is an average");
+  }
+
+  auto delta = std::make_unique<HistogramDelta>();
+  delta->mName = current.GetName();
+  delta->mNcells = current.GetNcells();
+
+  const bool withSumw2 = current.GetSumw2N() > 0;
+  const TArrayD* currentSumw2 = current.GetSumw2();
+  const TArrayD* previousSumw2 = previous.GetSumw2N() > 0 ? previous.GetSumw2() : nullptr;
+  for (int bin = 0; bin < delta->mNcells; bin++) {
+    double content = current.GetBinContent(bin) - previous.GetBinContent(bin);
+    double sumw2 = 0;
+    if (withSumw2) {
+      // without Sumw2 the previous errors are the bin contents
+      sumw2 = currentSumw2->At(bin) - (previousSumw2 ? previousSumw2->At(bin) : previous.GetBinContent(bin));
+    }
+    if (content != 0 || sumw2 != 0) {
+      delta->mBins.push_back(bin);
+      delta->mContents.push_back(content);
+      if (withSumw2) {
+        delta->mSumw2.push_back(sumw2);
+      }
+    }
+  }
+
+  double currentStats[TH1::kNstat] = {0};
+  double previousStats[TH1::kNstat] = {0};
+  current.GetStats(currentStats);
+  previous.GetStats(previousStats);
+  delta->mStats.resize(TH1::kNstat);
+  for (int i = 0; i < TH1::kNstat; i++) {
+    delta->mStats[i] = currentStats[i] - previousStats[i];
+  }
+  delta->mEntries = current.GetEntries() - previous.GetEntries();
+  return delta;
+}
+
+void HistogramDelta::applyTo(TH1& target) const
+{
+  if (target.GetNcells() != mNcells) {
+    throw std::runtime_error(std::string("Cannot apply the delta of '") + mName + "' to '" + target.GetName() +
+                             "', they have different numbers of bins (" + std::to_string(mNcells) + " and " +
+                             std::to_string(target.GetNcells()) + ")");
+  }
+  if (target.TestBit(TH1::kIsAverage)) {
+    throw std::runtime_error(std::string("Cannot apply the delta of '") + mName + "' to '" + target.GetName() + "', it is an average");
+  }
+
+  // the statistics have to be read before changing the bins, as they might be recomputed from them
+  double stats[TH1::kNstat] = {0};
+  target.GetStats(stats);
+  const double entries = target.GetEntries();
+
+  if (!mSumw2.empty() && target.GetSumw2N() == 0) {
+    target.Sumw2();
+  }
+  TArrayD* targetSumw2 = target.GetSumw2N() > 0 ? target.GetSumw2() : nullptr;
+  for (size_t i = 0; i < mBins.size(); i++) {
+    const int bin = mBins[i];
+    target.AddBinContent(bin, mContents[i]);
+    if (targetSumw2) {
+      (*targetSumw2)[bin] += mSumw2.empty() ? mContents[i] : mSumw2[i];
+    }
+  }
+
+  for (size_t i = 0; i < mStats.size() && i < TH1::kNstat; i++) {
+    stats[i] += mStats[i];
+  }
+  target.PutStats(stats);
+  target.SetEntries(entries + mEntries);
+}
+
+} // namespace o2::mergers
@@ -16,6 +16,7 @@
 
 #include "Mergers/IntegratingMerger.h"
 
+#include "Mergers/HistogramDelta.h"
 #include "Mergers/MergerAlgorithm.h"
 #include "Mergers/MergerBuilder.h"
 
@@ -26,6 +27,8 @@
 #include "Framework/InputRecordWalker.h"
 #include "Framework/Logger.h"
 
+#include <TH1.h>
+
 using namespace o2::framework;
 
 namespace o2::mergers
@@ -44,7 +47,10 @@ void IntegratingMerger::init(framework::InitContext& ictx)
   mCollector->addGlobalTag(monitoring::tags::Key::Subsystem, monitoring::tags::Value::Mergers);
 
   // clear the state before starting the run, especially important for START->STOP->START sequence
-  ictx.services().get<CallbackService>().set<CallbackService::Id::Start>([this]() { clear(); });
+  ictx.services().get<CallbackService>().set<CallbackService::Id::Start>([this]() {
+    clear();
+    mHistogramTemplate.reset();
+  });
 
   // set detector field in infologger
   try {
@@ -63,6 +69,7 @@ void IntegratingMerger::run(framework::ProcessingContext& ctx)
   for (const DataRef& ref : InputRecordWalker(ctx.inputs())) {
     if (ref.header != timerHeader) {
       auto other = object_store_helpers::extractObjectFrom(ref);
+      prepareForHistogramDelta(other);
       merge(mMergedObjectLastCycle, std::move(other));
       mDeltasMerged++;
     }
@@ -125,6 +132,32 @@ void IntegratingMerger::merge(ObjectStore& target, ObjectStore&& other)
   }
 }
 
+void IntegratingMerger::prepareForHistogramDelta(const ObjectStore& other)
+{
+  if (!std::holds_alternative<TObjectPtr>(other)) {
+    return;
+  }
+  const auto& otherAsTObject = std::get<TObjectPtr>(other);
+  auto delta = dynamic_cast<HistogramDelta*>(otherAsTObject.get());
+  if (delta == nullptr) {
+    if (!mHistogramTemplate && otherAsTObject && otherAsTObject->InheritsFrom(TH1::Class())) {
+      auto histogramTemplate = dynamic_cast<TH1*>(otherAsTObject->Clone());
+      histogramTemplate->Reset();
+      mHistogramTemplate = TObjectPtr(histogramTemplate, algorithm::deleteTCollections);
+    }
+    return;
+  }
+  if (!std::holds_alternative<std::monostate>(mMergedObjectLastCycle)) {
+    return;
+  }
+  // A delta cannot become the merged object, it is applied to an empty histogram with the same binning instead.
+  if (!mHistogramTemplate) {
+    throw std::runtime_error(std::string("Received the HistogramDelta '") + delta->GetName() +
+                             "' before any full histogram, the producer has to publish the full object first");
+  }
+  mMergedObjectLastCycle = TObjectPtr(mHistogramTemplate->Clone(), algorithm::deleteTCollections);
+}
+
 void IntegratingMerger::endOfStream(framework::EndOfStreamContext& eosContext)
 {
   finishCycle(eosContext.outputs());
@@ -17,6 +17,7 @@
 #include "Mergers/MergerAlgorithm.h"
 
 #include "Framework/Logger.h"
+#include "Mergers/HistogramDelta.h"
 #include "Mergers/MergeInterface.h"
 #include "Mergers/ObjectStore.h"
 
@@ -30,6 +31,9 @@
 #include <TObjArray.h>
 #include <TTree.h>
 
+#include <algorithm>
+#include <thread>
+
 namespace o2::mergers::algorithm
 {
 
@@ -62,6 +66,15 @@ void merge(TObject* const target, TObject* const other)
 
     custom->merge(dynamic_cast<MergeInterface* const>(other));
 
+  } else if (auto delta = dynamic_cast<HistogramDelta*>(other)) {
+
+    auto targetTH1 = dynamic_cast<TH1*>(target);
+    if (targetTH1 == nullptr) {
+      throw std::runtime_error(std::string("The other object '") + other->GetName() +
+                               "' is a HistogramDelta, while the target object '" + target->GetName() + "' is not a histogram.");
+    }
+    delta->applyTo(*targetTH1);
+
   } else if (auto targetCollection = dynamic_cast<TCollection*>(target)) {
 
     auto otherCollection = dynamic_cast<TCollection*>(other);
@@ -143,6 +156,46 @@ void merge(VectorOfTObjectPtrs& targets, const VectorOfTObjectPtrs& others)
   }
 }
 
+void merge(TObject* const target, const std::vector<TObject*>& others, size_t nThreads)
+{
+  nThreads = std::min(nThreads, others.size() / 2); // a thread clones the first object of its share, so it needs at least two
+  if (nThreads <= 1) {
+    for (auto* other : others) {
+      merge(target, other);
+    }
+    return;
+  }
+
+  std::vector<TObjectPtr> partialResults(nThreads);
+  std::vector<std::exception_ptr> errors(nThreads);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < nThreads; t++) {
+    threads.emplace_back([&, t]() {
+      try {
+        const size_t begin = others.size() * t / nThreads;
+        const size_t end = others.size() * (t + 1) / nThreads;
+        partialResults[t] = TObjectPtr(others[begin]->Clone(), deleteTCollections);
+        for (size_t i = begin + 1; i < end; i++) {
+          merge(partialResults[t].get(), others[i]);
+        }
+      } catch (...) {
+        errors[t] = std::current_exception();
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+  for (auto& partialResult : partialResults) {
+    merge(target, partialResult.get());
+  }
+}
+
 void deleteRecursive(TCollection* Coll)
 {
   // I can iterate a collection
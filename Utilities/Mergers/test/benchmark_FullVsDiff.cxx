@@ -10,6 +10,9 @@
 // or submit itself to any jurisdiction.
 #include <benchmark/benchmark.h>
 
+#include "Mergers/HistogramDelta.h"
+#include "Mergers/MergerAlgorithm.h"
+
 #include <TObjArray.h>
 #include <TH1.h>
 #include <TH2.h>
@@ -21,6 +24,7 @@
 #include <TF3.h>
 #include <TRandom.h>
 #include <TRandomGen.h>
+#include <TMessage.h>
 #include <chrono>
 #include <ctime>
 
@@ -248,10 +252,60 @@ static void BM_MergingTTree(benchmark::State& state)
   delete merged;
 }
 
+// The same differences as BM_MergingTH2I with DIFF_OBJECTS, but sent as HistogramDeltas of the producers' histograms.
+static void BM_MergingTH2IDelta(benchmark::State& state)
+{
+  size_t bins = 250; // 250 bins * 250 bins * 4B makes 250kB
+
+  TF2* uni = new TF2("uni", "1", 0, 1000000, 0, 1000000);
+  std::vector<std::unique_ptr<o2::mergers::HistogramDelta>> deltas;
+  size_t diffBytes = 0;
+  size_t deltaBytes = 0;
+  for (size_t i = 0; i < collectionSize; i++) {
+    TH2I previous(("test" + std::to_string(i)).c_str(), "test", bins, 0, 1000000, bins, 0, 1000000);
+    previous.FillRandom("uni", entriesInFull);
+    TH2I diff(("test" + std::to_string(i)).c_str(), "test", bins, 0, 1000000, bins, 0, 1000000);
+    diff.FillRandom("uni", entriesInDiff);
+    TH2I current(previous);
+    current.Add(&diff);
+    deltas.push_back(o2::mergers::HistogramDelta::make(current, previous));
+
+    TMessage diffMessage(kMESS_OBJECT);
+    diffMessage.WriteObject(&diff);
+    diffBytes += diffMessage.Length();
+    TMessage deltaMessage(kMESS_OBJECT);
+    deltaMessage.WriteObject(deltas.back().get());
+    deltaBytes += deltaMessage.Length();
+  }
+  state.counters["diff_bytes"] = diffBytes / collectionSize;
+  state.counters["delta_bytes"] = deltaBytes / collectionSize;
+
+  TH2I* m = new TH2I("merged", "merged", bins, 0, 1000000, bins, 0, 1000000);
+  // avoid memory overcommitment by doing something with data.
+  for (size_t i = 0; i < bins; i++) {
+    m->SetBinContent(i, 1);
+  }
+
+  for (auto _ : state) {
+    auto start = std::chrono::high_resolution_clock::now();
+    for (const auto& delta : deltas) {
+      o2::mergers::algorithm::merge(m, delta.get());
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    auto elapsed_seconds = std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
+    state.SetIterationTime(elapsed_seconds.count());
+  }
+
+  delete m;
+  delete uni;
+}
+
 BENCHMARK(BM_MergingTH1I)->Arg(DIFF_OBJECTS)->UseManualTime();
 BENCHMARK(BM_MergingTH1I)->Arg(FULL_OBJECTS)->UseManualTime();
 BENCHMARK(BM_MergingTH2I)->Arg(DIFF_OBJECTS)->UseManualTime();
 BENCHMARK(BM_MergingTH2I)->Arg(FULL_OBJECTS)->UseManualTime();
+BENCHMARK(BM_MergingTH2IDelta)->UseManualTime();
 BENCHMARK(BM_MergingTH3I)->Arg(DIFF_OBJECTS)->UseManualTime();
 BENCHMARK(BM_MergingTH3I)->Arg(FULL_OBJECTS)->UseManualTime();
 BENCHMARK(BM_MergingTHnSparse)->Arg(DIFF_OBJECTS)->UseManualTime();
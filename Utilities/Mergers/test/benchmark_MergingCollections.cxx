@@ -10,6 +10,9 @@
 // or submit itself to any jurisdiction.
 #include <benchmark/benchmark.h>
 
+#include "Mergers/MergerAlgorithm.h"
+
+#include <TROOT.h>
 #include <TObjArray.h>
 #include <TH1.h>
 #include <TH2.h>
@@ -449,6 +452,40 @@ static void BM_mergingBoostRegular2DCollections(benchmark::State& state)
   delete uni;
 }
 
+static void BM_mergingTH2IThreads(benchmark::State& state)
+{
+  const size_t nThreads = state.range(0);
+  const size_t nObjects = 256;
+  const size_t bins = 250; // 250 bins * 250 bins * 4B makes 250kB
+  ROOT::EnableThreadSafety();
+
+  TF2* uni = new TF2("uni", "1", 0, 1000000, 0, 1000000);
+  std::vector<std::unique_ptr<TH2I>> objects;
+  for (size_t i = 0; i < nObjects; i++) {
+    auto h = std::make_unique<TH2I>(("test" + std::to_string(i)).c_str(), "test", bins, 0, 1000000, bins, 0, 1000000);
+    h->SetDirectory(nullptr);
+    h->FillRandom("uni", 50000);
+    objects.push_back(std::move(h));
+  }
+  std::vector<TObject*> others;
+  for (const auto& object : objects) {
+    others.push_back(object.get());
+  }
+
+  for (auto _ : state) {
+    auto m = std::make_unique<TH2I>("merged", "merged", bins, 0, 1000000, bins, 0, 1000000);
+    m->SetDirectory(nullptr);
+    auto start = std::chrono::high_resolution_clock::now();
+    o2::mergers::algorithm::merge(m.get(), others, nThreads);
+    auto end = std::chrono::high_resolution_clock::now();
+
+    auto elapsed_seconds = std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
+    state.SetIterationTime(elapsed_seconds.count());
+  }
+
+  delete uni;
+}
+
 // one by one comparison
 BENCHMARK(BM_mergingCollectionsTH1I)->Arg(1)->UseManualTime();
 BENCHMARK(BM_mergingCollectionsTH1I)->Arg(1)->UseManualTime();
@@ -460,6 +497,9 @@ BENCHMARK(BM_mergingBoostRegular1DCollections)->Arg(1)->UseManualTime();
 BENCHMARK(BM_mergingBoostRegular2DCollections)->Arg(1)->UseManualTime();
 BENCHMARK(BM_mergingCollectionsTTree)->Arg(1)->UseManualTime();
 
+// threads merging the same objects
+BENCHMARK(BM_mergingTH2IThreads)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Arg(16)->UseManualTime();
+
 // collections
 
 BENCHMARK(BM_mergingCollectionsTH1I)->BENCHMARK_RANGE_COLLECTIONS->UseManualTime();
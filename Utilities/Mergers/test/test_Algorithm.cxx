@@ -26,6 +26,7 @@
 #include "Mergers/MergerAlgorithm.h"
 #include "Mergers/CustomMergeableTObject.h"
 #include "Mergers/CustomMergeableObject.h"
+#include "Mergers/HistogramDelta.h"
 #include "Mergers/ObjectStore.h"
 
 #include <TObjArray.h>
@@ -39,6 +40,7 @@
 #include <TF1.h>
 #include <TGraph.h>
 #include <TProfile.h>
+#include <TROOT.h>
 
 // using namespace o2::framework;
 using namespace o2::mergers;
@@ -251,6 +253,28 @@ BOOST_AUTO_TEST_CASE(MergerSingularObjects)
   }
 }
 
+BOOST_AUTO_TEST_CASE(MergerManyObjectsThreads)
+{
+  ROOT::EnableThreadSafety();
+  std::vector<std::unique_ptr<TH1I>> objects;
+  std::vector<TObject*> others;
+  for (size_t i = 0; i < 11; i++) {
+    objects.push_back(std::make_unique<TH1I>(("obj" + std::to_string(i)).c_str(), "obj", bins, min, max));
+    objects.back()->Fill(i % bins);
+    others.push_back(objects.back().get());
+  }
+  for (size_t nThreads : {1, 2, 4, 16}) {
+    TH1I target("target", "target", bins, min, max);
+    target.Fill(5);
+    BOOST_CHECK_NO_THROW(algorithm::merge(&target, others, nThreads));
+    BOOST_CHECK_EQUAL(target.GetEntries(), 12);
+    BOOST_CHECK_EQUAL(target.GetBinContent(target.FindBin(0)), 2);
+    BOOST_CHECK_EQUAL(target.GetBinContent(target.FindBin(5)), 2);
+    // the objects to merge are left untouched
+    BOOST_CHECK_EQUAL(objects[0]->GetEntries(), 1);
+  }
+}
+
 BOOST_AUTO_TEST_CASE(MergerCollection)
 {
   // Setting up the target. Histo 1D + Custom stored in TObjArray.
@@ -352,6 +376,35 @@ BOOST_AUTO_TEST_CASE(AverageHisto)
   delete other;
 }
 
+BOOST_AUTO_TEST_CASE(HistogramDeltas)
+{
+  TH2F previous("histo", "histo", bins, min, max, bins, min, max);
+  previous.Fill(1, 1);
+  previous.Fill(5, 5, 2);
+  TH2F current(previous);
+  current.Fill(5, 5);
+  current.Fill(7, 3, 0.5);
+
+  auto delta = HistogramDelta::make(current, previous);
+  BOOST_CHECK_EQUAL(delta->size(), 2);
+  BOOST_CHECK_EQUAL(delta->getNcells(), current.GetNcells());
+
+  TH2F target(previous);
+  BOOST_CHECK_NO_THROW(algorithm::merge(&target, delta.get()));
+  for (int bin = 0; bin < current.GetNcells(); bin++) {
+    BOOST_CHECK_EQUAL(target.GetBinContent(bin), current.GetBinContent(bin));
+  }
+  BOOST_CHECK_EQUAL(target.GetEntries(), current.GetEntries());
+  BOOST_CHECK_CLOSE(target.GetMean(1), current.GetMean(1), 0.001);
+  BOOST_CHECK_CLOSE(target.GetMean(2), current.GetMean(2), 0.001);
+
+  TH1F other("histo", "histo", bins + 1, min, max);
+  BOOST_CHECK_THROW(algorithm::merge(&other, delta.get()), std::runtime_error);
+  TGraph graph;
+  BOOST_CHECK_THROW(algorithm::merge(&graph, delta.get()), std::runtime_error);
+  BOOST_CHECK_THROW(HistogramDelta::make(current, other), std::runtime_error);
+}
+
 BOOST_AUTO_TEST_SUITE(VectorOfHistos)
 
 gsl::span<float> to_span(std::shared_ptr<TH1F>& histo)
@@ -28,6 +28,10 @@
 #include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
+
+#include <unistd.h>
+#include <sys/mman.h>
 
 #if !defined(__MACH__) && !defined(__APPLE__)
 #include <syscall.h>
@@ -56,9 +60,41 @@ void resetContentHandler(int /* signal */)
   gResetContent = 1;
 }
 
+// Fault in the pages of [data, data + size) in nThreads threads, reading one byte per page.
+// The threads are created after the NUMA policy of the calling thread is set, hence they inherit it and the pages are
+// allocated on the requested node. Reading leaves the content untouched, so this is safe for the managed segments.
+void preFault(void* data, size_t size, int nThreads, bool hugePages)
+{
+#if defined(MADV_HUGEPAGE)
+  if (hugePages && madvise(data, size, MADV_HUGEPAGE) != 0) {
+    LOG(warning) << "madvise(MADV_HUGEPAGE) failed, continuing with regular pages";
+  }
+#endif
+  if (nThreads < 1) {
+    return;
+  }
+  const size_t pageSize = sysconf(_SC_PAGESIZE);
+  const size_t nPages = (size + pageSize - 1) / pageSize;
+  const size_t pagesPerThread = (nPages + nThreads - 1) / nThreads;
+  vector<thread> threads;
+  for (int i = 0; i < nThreads; i++) {
+    threads.emplace_back([=]() {
+      const volatile char* mem = static_cast<const volatile char*>(data);
+      char sum = 0;
+      for (size_t page = i * pagesPerThread; page < min(nPages, (i + 1) * pagesPerThread); page++) {
+        sum += mem[page * pageSize];
+      }
+      (void)sum;
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+}
+
 struct ShmManager {
-  ShmManager(uint64_t _shmId, const vector<string>& _segments, const vector<string>& _regions, uint64_t _refcount_segment_size, bool zero = true)
-    : shmId(fair::mq::shmem::makeShmIdStr(_shmId))
+  ShmManager(uint64_t _shmId, const vector<string>& _segments, const vector<string>& _regions, uint64_t _refcount_segment_size, bool zero = true, int _prefaultThreads = 0, bool _hugePages = false)
+    : shmId(fair::mq::shmem::makeShmIdStr(_shmId)), prefaultThreads(_prefaultThreads), hugePages(_hugePages)
   {
     LOG(info) << "Starting ShmManager for shmId: " << shmId;
     LOG(info) << "Performing full reset...";
@@ -105,7 +141,9 @@ struct ShmManager {
 
       auto ret = segments.emplace(id, fair::mq::shmem::Segment(shmId, id, size, fair::mq::shmem::rbTreeBestFit));
       fair::mq::shmem::Segment& segment = ret.first->second;
-      LOG(info) << "Created segment " << id << " of size " << segment.GetSize() << ", starting at " << segment.GetData() << ". Locking...";
+      LOG(info) << "Created segment " << id << " of size " << segment.GetSize() << ", starting at " << segment.GetData() << ". Pre-faulting in " << prefaultThreads << " threads...";
+      preFault(segment.GetData(), segment.GetSize(), prefaultThreads, hugePages);
+      LOG(info) << "Done. Locking...";
       segment.Lock();
       LOG(info) << "Done.";
       if (zero) {
@@ -154,7 +192,9 @@ struct ShmManager {
 
       auto ret = regions.emplace(id, make_unique<fair::mq::shmem::UnmanagedRegion>(shmId, cfg));
       fair::mq::shmem::UnmanagedRegion& region = *(ret.first->second);
-      LOG(info) << "Created unamanged region " << id << " of size " << region.GetSize() << ", starting at " << region.GetData() << ". Locking...";
+      LOG(info) << "Created unamanged region " << id << " of size " << region.GetSize() << ", starting at " << region.GetData() << ". Pre-faulting in " << prefaultThreads << " threads...";
+      preFault(region.GetData(), region.GetSize(), prefaultThreads, hugePages);
+      LOG(info) << "Done. Locking...";
       region.Lock();
       LOG(info) << "Done.";
       if (zero) {
@@ -201,6 +241,8 @@ struct ShmManager {
   }
 
   std::string shmId;
+  int prefaultThreads = 0; // threads faulting in the pages before locking them, 0: pages are faulted by the lock
+  bool hugePages = false;  // request transparent huge pages for the segments and regions
   std::mutex localMtx;
   map<uint16_t, fair::mq::shmem::Segment> segments;
   map<uint16_t, unique_ptr<fair::mq::shmem::UnmanagedRegion>> regions;
@@ -219,6 +261,8 @@ int main(int argc, char** argv)
   try {
     bool nozero = false;
     bool checkPresence = true;
+    bool hugePages = false;
+    int prefaultThreads = 0;
     uint64_t shmId = 0;
     uint64_t refcount_segment_size = 0;
     vector<string> segments;
@@ -231,6 +275,8 @@ int main(int argc, char** argv)
       "regions", value<vector<string>>(&regions)->multitoken()->composing(), "Regions, as <id>,<size> <id>,<size>,<numaid> <id>,<size>,<numaid> ...")(
       "nozero", value<bool>(&nozero)->default_value(false)->implicit_value(true), "Do not zero segments after initialization")(
       "check-presence", value<bool>(&checkPresence)->default_value(true)->implicit_value(true), "Check periodically if configured segments/regions are still present, and cleanup and leave if they are not")(
+      "prefault-threads", value<int>(&prefaultThreads)->default_value(0), "Number of threads faulting in the pages of the segments/regions in parallel before locking them (0 = faulted serially by the lock)")(
+      "huge-pages", value<bool>(&hugePages)->default_value(false)->implicit_value(true), "Request transparent huge pages for the segments/regions (needs shmem_enabled=advise)")(
       "refcount-segment-size", value<uint64_t>(&refcount_segment_size)->default_value(1), "Size in bytes of refCount segment (global setting affecting all unmanaged regions, 1 = use default, 0 = disable rc segment)")(
       "help,h", "Print help");
 
@@ -246,7 +292,7 @@ int main(int argc, char** argv)
 
     notify(vm);
 
-    ShmManager shmManager(shmId, segments, regions, refcount_segment_size, !nozero);
+    ShmManager shmManager(shmId, segments, regions, refcount_segment_size, !nozero, prefaultThreads, hugePages);
 
     std::thread resetContentThread([&shmManager]() {
       while (!gStopping) {
@@ -101,7 +101,7 @@ inline const SourceMessageProxyUniform<uint8_t> sourceMessageUniform8{MessageSiz
 inline const SourceMessageProxyUniform<uint16_t> sourceMessageUniform16{MessageSize};
 inline const SourceMessageProxyUniform<uint32_t> sourceMessageUniform32{MessageSize};
 
-template <class... Args>
+template <CoderTag coderTag_V = defaults::DefaultTag, size_t nStreams_V = defaults::CoderPreset<coderTag_V>::nStreams, class... Args>
 void ransDecodeBenchmark(benchmark::State& st, Args&&... args)
 {
 
@@ -119,7 +119,7 @@ void ransDecodeBenchmark(benchmark::State& st, Args&&... args)
   Metrics<source_type> metrics{histogram};
   const auto renormedHistogram = renorm(histogram, metrics, RenormingPolicy::Auto, 10);
 
-  auto encoder = makeDenseEncoder<>::fromRenormed(renormedHistogram);
+  auto encoder = makeDenseEncoder<coderTag_V, nStreams_V>::fromRenormed(renormedHistogram);
   encodeBuffer.encodeBufferEnd = encoder.process(inputData.data(), inputData.data() + inputData.size(), encodeBuffer.buffer.data());
 
   auto decoder = makeDecoder<>::fromRenormed(renormedHistogram);
@@ -160,4 +160,18 @@ BENCHMARK_CAPTURE(ransDecodeBenchmark, decode_uniform_8, sourceMessageUniform8);
 BENCHMARK_CAPTURE(ransDecodeBenchmark, decode_uniform_16, sourceMessageUniform16);
 BENCHMARK_CAPTURE(ransDecodeBenchmark, decode_uniform_32, sourceMessageUniform32);
 
+// interleaved decoders for different numbers of streams, 64 streams use the generic decoder.
+template <size_t nStreams_V>
+void ransDecodeStreamsBenchmark(benchmark::State& st)
+{
+  ransDecodeBenchmark<CoderTag::Compat, nStreams_V>(st, sourceMessageUniform16);
+};
+
+BENCHMARK_TEMPLATE(ransDecodeStreamsBenchmark, 2);
+BENCHMARK_TEMPLATE(ransDecodeStreamsBenchmark, 4);
+BENCHMARK_TEMPLATE(ransDecodeStreamsBenchmark, 8);
+BENCHMARK_TEMPLATE(ransDecodeStreamsBenchmark, 16);
+BENCHMARK_TEMPLATE(ransDecodeStreamsBenchmark, 32);
+BENCHMARK_TEMPLATE(ransDecodeStreamsBenchmark, 64);
+
 BENCHMARK_MAIN();
\ No newline at end of file
@@ -66,6 +66,7 @@ class SourceMessageUniform
 
 SourceMessageUniform<uint32_t> sourceMessage{0, 0};
 
+template <CoderTag coderTag_V, size_t nStreams_V>
 void ransDecodeBenchmark(benchmark::State& st)
 {
 
@@ -84,7 +85,7 @@ void ransDecodeBenchmark(benchmark::State& st)
   Metrics<source_type> metrics{histogram};
   const auto renormedHistogram = renorm(histogram, metrics, RenormingPolicy::Auto, 10);
 
-  auto encoder = makeDenseEncoder<>::fromRenormed(renormedHistogram);
+  auto encoder = makeDenseEncoder<coderTag_V, nStreams_V>::fromRenormed(renormedHistogram);
   encodeBuffer.encodeBufferEnd = encoder.process(inputData.data(), inputData.data() + inputData.size(), encodeBuffer.buffer.data());
 
   auto decoder = makeDecoder<>::fromRenormed(renormedHistogram);
@@ -117,6 +118,10 @@ void ransDecodeBenchmark(benchmark::State& st)
   st.counters["CompressionWRTEntropy"] = st.counters["CompressedSize"] / st.counters["LowerBound"];
 };
 
-BENCHMARK(ransDecodeBenchmark)->DenseRange(8, 27, 1);
+BENCHMARK_TEMPLATE(ransDecodeBenchmark, defaults::DefaultTag, defaults::CoderPreset<defaults::DefaultTag>::nStreams)->DenseRange(8, 27, 1);
+// scaling of the interleaved decoders with the number of streams, 64 streams use the generic decoder.
+BENCHMARK_TEMPLATE(ransDecodeBenchmark, CoderTag::Compat, 4)->DenseRange(8, 27, 1);
+BENCHMARK_TEMPLATE(ransDecodeBenchmark, CoderTag::Compat, 32)->DenseRange(8, 27, 1);
+BENCHMARK_TEMPLATE(ransDecodeBenchmark, CoderTag::Compat, 64)->DenseRange(8, 27, 1);
 
 BENCHMARK_MAIN();
\ No newline at end of file
@@ -52,74 +52,129 @@ class DecoderConcept
   template <typename stream_IT, typename source_IT, typename literals_IT = std::nullptr_t, std::enable_if_t<utils::isCompatibleIter_v<typename symbolTable_T::source_type, source_IT>, bool> = true>
   void process(stream_IT inputEnd, source_IT outputBegin, size_t messageLength, size_t nStreams, literals_IT literalsEnd = nullptr) const
   {
-    {
+    if (messageLength == 0) {
+      LOG(warning) << "Empty message passed to decoder, skipping decode process";
+      return;
+    }
+
+    if (!(nStreams > 1 && internal::isPow2(nStreams))) {
+      throw DecodingError(fmt::format("Invalid number of decoder streams {}", nStreams));
+    }
+
+    stream_IT inputIter = inputEnd;
+    --inputIter;
+
+    // dispatch the stream count of the encoder to an interleaved decoder with all states in registers,
+    // fall back to the generic implementation for unusual stream counts.
+    switch (nStreams) {
+      case 2:
+        processInterleaved<2>(inputIter, outputBegin, messageLength, literalsEnd);
+        break;
+      case 4:
+        processInterleaved<4>(inputIter, outputBegin, messageLength, literalsEnd);
+        break;
+      case 8:
+        processInterleaved<8>(inputIter, outputBegin, messageLength, literalsEnd);
+        break;
+      case 16:
+        processInterleaved<16>(inputIter, outputBegin, messageLength, literalsEnd);
+        break;
+      case 32:
+        processInterleaved<32>(inputIter, outputBegin, messageLength, literalsEnd);
+        break;
+      default:
+        processGeneric(inputIter, outputBegin, messageLength, nStreams, literalsEnd);
+        break;
+    }
+  }
+
+  template <typename literals_IT = std::nullptr_t>
+  inline void process(gsl::span<const stream_type> inputStream, gsl::span<source_type> outputStream, size_t messageLength, size_t nStreams, literals_IT literalsEnd = nullptr) const
+  {
+    process(inputStream.data() + inputStream.size(), outputStream.data(), nStreams, literalsEnd);
+  };
 
-      if (messageLength == 0) {
-        LOG(warning) << "Empty message passed to decoder, skipping decode process";
-        return;
+ private:
+  template <typename literals_IT>
+  inline value_type lookupSymbol(uint32_t cumulativeFrequency, literals_IT& literalsIter) const
+  {
+    if constexpr (!std::is_null_pointer_v<literals_IT>) {
+      if (this->mSymbolTable.isEscapeSymbol(cumulativeFrequency)) {
+        return value_type{*(--literalsIter), this->mSymbolTable.getEscapeSymbol()};
+      } else {
+        return this->mSymbolTable[cumulativeFrequency];
       }
+    } else {
+      return this->mSymbolTable[cumulativeFrequency];
+    }
+  };
 
-      if (!(nStreams > 1 && internal::isPow2(nStreams))) {
-        throw DecodingError(fmt::format("Invalid number of decoder streams {}", nStreams));
+  template <size_t nStreams_V, typename stream_IT, typename source_IT, typename literals_IT>
+  void processInterleaved(stream_IT inputIter, source_IT outputIter, size_t messageLength, literals_IT literalsIter) const
+  {
+    using interleavedCoder_type = typename coder_type::template interleaved_type<nStreams_V>;
+    typename interleavedCoder_type::template lanes_type<uint32_t> frequencies{};
+    typename interleavedCoder_type::template lanes_type<uint32_t> cumulatives{};
+
+    interleavedCoder_type decoder{this->mSymbolTable.getPrecision()};
+    inputIter = decoder.init(inputIter);
+
+    const size_t nLoops = messageLength / nStreams_V;
+    const size_t nLoopRemainder = messageLength % nStreams_V;
+
+    for (size_t i = 0; i < nLoops; ++i) {
+      for (size_t lane = 0; lane < nStreams_V; ++lane) {
+        const value_type symbol = lookupSymbol(decoder.get(lane), literalsIter);
+        *outputIter++ = symbol.first;
+        frequencies[lane] = symbol.second.getFrequency();
+        cumulatives[lane] = symbol.second.getCumulative();
       }
+      inputIter = decoder.advanceSymbols(inputIter, frequencies, cumulatives);
+    }
 
-      stream_IT inputIter = inputEnd;
-      --inputIter;
-      source_IT outputIter = outputBegin;
-      literals_IT literalsIter = literalsEnd;
-
-      auto lookupSymbol = [&literalsIter, this](uint32_t cumulativeFrequency) -> value_type {
-        if constexpr (!std::is_null_pointer_v<literals_IT>) {
-          if (this->mSymbolTable.isEscapeSymbol(cumulativeFrequency)) {
-            return value_type{*(--literalsIter), this->mSymbolTable.getEscapeSymbol()};
-          } else {
-            return this->mSymbolTable[cumulativeFrequency];
-          }
-        } else {
-          return this->mSymbolTable[cumulativeFrequency];
-        }
-      };
-
-      auto decode = [&, this](coder_type& decoder) {
-        const auto cumul = decoder.get();
-        const value_type symbol = lookupSymbol(cumul);
+    for (size_t lane = 0; lane < nLoopRemainder; ++lane) {
+      const value_type symbol = lookupSymbol(decoder.get(lane), literalsIter);
+      *outputIter++ = symbol.first;
+      inputIter = decoder.advanceSymbol(inputIter, symbol.second, lane);
+    }
+  };
+
+  template <typename stream_IT, typename source_IT, typename literals_IT>
+  void processGeneric(stream_IT inputIter, source_IT outputIter, size_t messageLength, size_t nStreams, literals_IT literalsIter) const
+  {
+    auto decode = [&, this](coder_type& decoder) {
+      const auto cumul = decoder.get();
+      const value_type symbol = lookupSymbol(cumul, literalsIter);
 #ifdef RANS_LOG_PROCESSED_DATA
-        arrayLogger << symbol.first;
+      arrayLogger << symbol.first;
 #endif
-        return std::make_tuple(symbol.first, decoder.advanceSymbol(inputIter, symbol.second));
-      };
+      return std::make_tuple(symbol.first, decoder.advanceSymbol(inputIter, symbol.second));
+    };
 
-      std::vector<coder_type> decoders{nStreams, coder_type{this->mSymbolTable.getPrecision()}};
-      for (auto& decoder : decoders) {
-        inputIter = decoder.init(inputIter);
-      }
+    std::vector<coder_type> decoders{nStreams, coder_type{this->mSymbolTable.getPrecision()}};
+    for (auto& decoder : decoders) {
+      inputIter = decoder.init(inputIter);
+    }
 
-      const size_t nLoops = messageLength / nStreams;
-      const size_t nLoopRemainder = messageLength % nStreams;
+    const size_t nLoops = messageLength / nStreams;
+    const size_t nLoopRemainder = messageLength % nStreams;
 
-      for (size_t i = 0; i < nLoops; ++i) {
+    for (size_t i = 0; i < nLoops; ++i) {
 #if defined(RANS_OPENMP)
 #pragma omp unroll partial(2)
 #endif
-        for (auto& decoder : decoders) {
-          std::tie(*outputIter++, inputIter) = decode(decoder);
-        }
+      for (auto& decoder : decoders) {
+        std::tie(*outputIter++, inputIter) = decode(decoder);
       }
+    }
 
-      for (size_t i = 0; i < nLoopRemainder; ++i) {
-        std::tie(*outputIter++, inputIter) = decode(decoders[i]);
-      }
+    for (size_t i = 0; i < nLoopRemainder; ++i) {
+      std::tie(*outputIter++, inputIter) = decode(decoders[i]);
+    }
 
 #ifdef RANS_LOG_PROCESSED_DATA
-      LOG(info) << "decoderOutput:" << arrayLogger;
+    LOG(info) << "decoderOutput:" << arrayLogger;
 #endif
-    }
-  }
-
-  template <typename literals_IT = std::nullptr_t>
-  inline void process(gsl::span<const stream_type> inputStream, gsl::span<source_type> outputStream, size_t messageLength, size_t nStreams, literals_IT literalsEnd = nullptr) const
-  {
-    process(inputStream.data() + inputStream.size(), outputStream.data(), nStreams, literalsEnd);
   };
 
  protected:
@@ -24,6 +24,7 @@
 
 #include "rANS/internal/containers/Symbol.h"
 #include "rANS/internal/common/utils.h"
+#include "rANS/internal/decode/InterleavedDecoderImpl.h"
 
 namespace o2::rans::internal
 {
@@ -51,6 +52,9 @@ class DecoderImpl
 
   [[nodiscard]] inline static constexpr size_type getNstreams() noexcept { return N_STREAMS; };
 
+  template <size_t nStreams_V>
+  using interleaved_type = InterleavedDecoderImpl<LowerBound_V, nStreams_V>;
+
  private:
   state_type mState{};
   size_type mSymbolTablePrecission{};
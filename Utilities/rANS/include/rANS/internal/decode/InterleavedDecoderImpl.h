@@ -0,0 +1,150 @@
+// Copyright 2019-2023 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   InterleavedDecoderImpl.h
+/// @author Michael Lettrich
+/// @brief  Operations to decode a rANS stream consisting of a compile time known number of interleaved streams.
+///         All states are kept in a fixed size array, which allows the compiler to unroll the decoding loop, keep the states
+///         in (SIMD) registers and issue the symbol table lookups of all streams before the dependent renormalization.
+///         The streams are renormalized in order, the result is bit compatible with the scalar DecoderImpl.
+
+#ifndef RANS_INTERNAL_DECODE_INTERLEAVEDDECODERIMPL_H_
+#define RANS_INTERNAL_DECODE_INTERLEAVEDDECODERIMPL_H_
+
+#include <array>
+#include <cstdint>
+#include <cassert>
+#include <iterator>
+#include <type_traits>
+
+#include "rANS/internal/common/utils.h"
+
+namespace o2::rans::internal
+{
+
+template <size_t LowerBound_V, size_t nStreams_V>
+class InterleavedDecoderImpl
+{
+ public:
+  using cumulative_frequency_type = uint32_t;
+  using stream_type = uint32_t;
+  using state_type = uint64_t;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  template <typename T>
+  using lanes_type = std::array<T, nStreams_V>;
+
+  static_assert(nStreams_V > 1 && isPow2(nStreams_V), "number of interleaved streams has to be a power of 2");
+
+  explicit InterleavedDecoderImpl(size_type symbolTablePrecission) noexcept : mSymbolTablePrecission{symbolTablePrecission} {};
+
+  // reads the initial states of all streams in the same order as nStreams_V consecutive DecoderImpl::init calls.
+  template <typename stream_IT>
+  stream_IT init(stream_IT inputIter);
+
+  // cumulative frequency of a stream: the index into the decoder symbol table.
+  [[nodiscard]] inline cumulative_frequency_type get(size_type lane) const noexcept { return mStates[lane] & ((utils::pow2(mSymbolTablePrecission)) - 1); };
+
+  // advances all streams by one symbol each. Equivalent to calling DecoderImpl::advanceSymbol for stream 0 to nStreams_V-1.
+  template <typename stream_IT>
+  stream_IT advanceSymbols(stream_IT inputIter, const lanes_type<uint32_t>& frequencies, const lanes_type<uint32_t>& cumulativeFrequencies);
+
+  // advances a single stream, used for the tail of a message that does not fill all streams.
+  template <typename stream_IT, typename symbol_T>
+  stream_IT advanceSymbol(stream_IT inputIter, const symbol_T& symbol, size_type lane);
+
+  [[nodiscard]] inline static constexpr size_type getNstreams() noexcept { return N_STREAMS; };
+
+ private:
+  alignas(64) lanes_type<state_type> mStates{};
+  size_type mSymbolTablePrecission{};
+
+  template <typename stream_IT>
+  stream_IT renorm(state_type& state, stream_IT iter);
+
+  inline static constexpr size_type N_STREAMS = nStreams_V;
+
+  inline static constexpr state_type LOWER_BOUND = utils::pow2(LowerBound_V); // lower bound of our normalization interval
+
+  inline static constexpr state_type STREAM_BITS = utils::toBits<stream_type>(); // lower bound of our normalization interval
+};
+
+template <size_t LowerBound_V, size_t nStreams_V>
+template <typename stream_IT>
+stream_IT InterleavedDecoderImpl<LowerBound_V, nStreams_V>::init(stream_IT inputIter)
+{
+  stream_IT streamPosition = inputIter;
+
+  for (auto& state : mStates) {
+    state = static_cast<state_type>(*streamPosition) << 0;
+    --streamPosition;
+    state |= static_cast<state_type>(*streamPosition) << 32;
+    --streamPosition;
+  }
+  assert(std::distance(streamPosition, inputIter) == 2 * N_STREAMS);
+
+  return streamPosition;
+};
+
+template <size_t LowerBound_V, size_t nStreams_V>
+template <typename stream_IT>
+inline stream_IT InterleavedDecoderImpl<LowerBound_V, nStreams_V>::advanceSymbols(stream_IT inputIter, const lanes_type<uint32_t>& frequencies, const lanes_type<uint32_t>& cumulativeFrequencies)
+{
+  static_assert(std::is_same<typename std::iterator_traits<stream_IT>::value_type, stream_type>::value);
+
+  const state_type mask = (utils::pow2(mSymbolTablePrecission)) - 1;
+  const size_type precision = mSymbolTablePrecission;
+
+  stream_IT streamPosition = inputIter;
+  for (size_type i = 0; i < N_STREAMS; ++i) {
+    // s, x = D(x)
+    state_type state = mStates[i];
+    state = static_cast<state_type>(frequencies[i]) * (state >> precision) + (state & mask) - cumulativeFrequencies[i];
+    // renormalize in stream order, streams share a single input buffer
+    streamPosition = renorm(state, streamPosition);
+    mStates[i] = state;
+  }
+  return streamPosition;
+};
+
+template <size_t LowerBound_V, size_t nStreams_V>
+template <typename stream_IT, typename symbol_T>
+inline stream_IT InterleavedDecoderImpl<LowerBound_V, nStreams_V>::advanceSymbol(stream_IT inputIter, const symbol_T& symbol, size_type lane)
+{
+  static_assert(std::is_same<typename std::iterator_traits<stream_IT>::value_type, stream_type>::value);
+
+  const state_type mask = (utils::pow2(mSymbolTablePrecission)) - 1;
+
+  // s, x = D(x)
+  state_type& state = mStates[lane];
+  state = symbol.getFrequency() * (state >> mSymbolTablePrecission) + (state & mask) - symbol.getCumulative();
+
+  return renorm(state, inputIter);
+};
+
+template <size_t LowerBound_V, size_t nStreams_V>
+template <typename stream_IT>
+inline stream_IT InterleavedDecoderImpl<LowerBound_V, nStreams_V>::renorm(state_type& state, stream_IT inputIter)
+{
+  stream_IT streamPosition = inputIter;
+
+  if (state < LOWER_BOUND) {
+    state = (state << STREAM_BITS) | *streamPosition;
+    --streamPosition;
+    assert(state >= LOWER_BOUND);
+  }
+  return streamPosition;
+};
+
+} // namespace o2::rans::internal
+
+#endif /* RANS_INTERNAL_DECODE_INTERLEAVEDDECODERIMPL_H_ */
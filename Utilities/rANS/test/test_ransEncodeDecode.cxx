@@ -144,6 +144,49 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(test_encodeDecode, test_types, testCase_types)
   BOOST_CHECK_EQUAL_COLLECTIONS(decodeBuffer.begin(), decodeBuffer.end(), encodeString.begin(), encodeString.end());
 };
 
+using nStreams_types = boost::mp11::mp_list<std::integral_constant<size_t, 2>,
+                                            std::integral_constant<size_t, 4>,
+                                            std::integral_constant<size_t, 8>,
+                                            std::integral_constant<size_t, 32>,
+                                            std::integral_constant<size_t, 64>>;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(test_decodeInterleaved, nStreams_type, nStreams_types)
+{
+  // covers both the interleaved decoders for power of 2 stream counts and the generic fallback
+  using source_type = int8_t;
+  using stream_type = uint32_t;
+  constexpr size_t nStreams = nStreams_type::value;
+
+  const auto& dictString = Full<source_type>::Data;
+  // drop a few symbols so that the message does not fill all streams evenly
+  gsl::span<const source_type> encodeString{dictString.data(), dictString.size() - 3};
+
+  auto renormed = renorm(makeDenseHistogram::fromSamples(dictString.begin(), dictString.end()), RansRenormingPrecision);
+  auto encoder = makeDenseEncoder<CoderTag::Compat, nStreams>::fromRenormed(renormed);
+  auto decoder = makeDecoder<>::fromRenormed(renormed);
+  BOOST_CHECK_EQUAL(encoder.getNStreams(), nStreams);
+
+  std::vector<stream_type> encodeBuffer(encodeString.size() + 2 * nStreams);
+  auto encodeBufferEnd = encoder.process(encodeString.begin(), encodeString.end(), encodeBuffer.begin());
+
+  std::vector<source_type> decodeBuffer(encodeString.size());
+  decoder.process(encodeBufferEnd, decodeBuffer.begin(), encodeString.size(), encoder.getNStreams());
+  BOOST_CHECK_EQUAL_COLLECTIONS(decodeBuffer.begin(), decodeBuffer.end(), encodeString.begin(), encodeString.end());
+
+  // incompressible symbols are read from the literals in the same order by all decoder implementations
+  auto renormedSparse = renorm(makeDenseHistogram::fromSamples(dictString.begin(), dictString.begin() + 100), RansRenormingPrecision, RenormingPolicy::ForceIncompressible);
+  auto encoderSparse = makeDenseEncoder<CoderTag::Compat, nStreams>::fromRenormed(renormedSparse);
+  auto decoderSparse = makeDecoder<>::fromRenormed(renormedSparse);
+
+  std::vector<source_type> literals(encodeString.size());
+  std::vector<stream_type> encodeBufferSparse(encodeString.size() + 2 * nStreams);
+  auto [encodeBufferSparseEnd, literalsEnd] = encoderSparse.process(encodeString.begin(), encodeString.end(), encodeBufferSparse.begin(), literals.begin());
+
+  std::vector<source_type> decodeBufferSparse(encodeString.size());
+  decoderSparse.process(encodeBufferSparseEnd, decodeBufferSparse.begin(), encodeString.size(), encoderSparse.getNStreams(), literalsEnd);
+  BOOST_CHECK_EQUAL_COLLECTIONS(decodeBufferSparse.begin(), decodeBufferSparse.end(), encodeString.begin(), encodeString.end());
+};
+
 #ifndef RANS_SINGLE_STREAM
 BOOST_AUTO_TEST_CASE(test_NoSingleStream)
 {
@@ -0,0 +1,95 @@
+#!/bin/bash
+
+# Script replaying a fixed set of reference timeframes through the reconstruction
+# (CTF reading -> detector reconstruction -> global tracking -> AOD production)
+# with the DPL resources monitoring enabled, in order to collect per device
+# CPU time, wall time, peak memory and shared memory usage.
+# The per device summary is written as JSON and, if a baseline summary is given,
+# compared to it: the script fails if any device regressed beyond the tolerance.
+#
+# Usage: reco_benchmark.sh <file with list of reference CTFs> [baseline summary JSON]
+#
+# Parameters (environment variables):
+# BENCHMARK_INPUT_TYPE      CTF (default) or TF for raw timeframes
+# BENCHMARK_REPS            number of repetitions, the summary takes the best one (default 1)
+# BENCHMARK_MONITORING      resources monitoring interval in seconds (default 1)
+# BENCHMARK_TOLERANCE       allowed relative increase wrt the baseline (default 0.1)
+# BENCHMARK_OUTPUT          summary JSON to produce (default reco_benchmark.json)
+# all the parameters of full-system-test/dpl-workflow.sh, e.g. WORKFLOW_DETECTORS, SHMSIZE, GPUTYPE, NTIMEFRAMES
+
+if [[ -z $1 ]]; then
+  echo "ERROR: Command line arguments missing. Syntax: reco_benchmark.sh [name of file with list of reference timeframes] [baseline JSON (optional)]"
+  exit 1
+fi
+if [[ ! -f $1 ]]; then
+  echo "ERROR: List file $1 not found"
+  exit 1
+fi
+if [[ -z $O2_ROOT ]]; then
+  echo "ERROR: O2 environment not loaded"
+  exit 1
+fi
+BASELINE=${2:-}
+if [[ ! -z $BASELINE && ! -f $BASELINE ]]; then
+  echo "ERROR: Baseline file $BASELINE not found"
+  exit 1
+fi
+
+: ${BENCHMARK_INPUT_TYPE:=CTF}
+: ${BENCHMARK_REPS:=1}
+: ${BENCHMARK_MONITORING:=1}
+: ${BENCHMARK_TOLERANCE:=0.1}
+: ${BENCHMARK_OUTPUT:=reco_benchmark.json}
+
+export INPUT_FILE_LIST=$(realpath $1)
+if [[ $BENCHMARK_INPUT_TYPE == "CTF" ]]; then
+  export CTFINPUT=1
+  export RAWTFINPUT=0
+elif [[ $BENCHMARK_INPUT_TYPE == "TF" ]]; then
+  export CTFINPUT=0
+  export RAWTFINPUT=1
+else
+  echo "ERROR: Unknown input type $BENCHMARK_INPUT_TYPE"
+  exit 1
+fi
+export EXTINPUT=0
+export DIGITINPUT=0
+export SYNCMODE=0
+export WORKFLOWMODE=run
+export WORKFLOW_PARAMETERS="${WORKFLOW_PARAMETERS:+${WORKFLOW_PARAMETERS},}AOD"
+: ${NTIMEFRAMES:=-1}
+export NTIMEFRAMES
+export TFDELAY=${TFDELAY:-0}
+export GLOBALDPLOPT="${GLOBALDPLOPT:-} --resources-monitoring $BENCHMARK_MONITORING"
+
+HOST=`hostname`
+TAG="input=$(basename $1),host=${HOST}${ALIDISTCOMMIT:+,alidist=$ALIDISTCOMMIT}${O2COMMIT:+,o2=$O2COMMIT}"
+METRICFILE=metrics.dat
+SUMMARIES=
+RETVAL=0
+
+for REP in `seq 1 $BENCHMARK_REPS`; do
+  RUNDIR=reco_benchmark_rep${REP}
+  rm -rf $RUNDIR
+  mkdir $RUNDIR
+  pushd $RUNDIR > /dev/null
+  SECONDS=0
+  $O2_ROOT/prodtests/full-system-test/dpl-workflow.sh > reco.log 2>&1
+  RC=$?
+  WALLTIME=$SECONDS
+  popd > /dev/null
+  echo "walltime_reco_benchmark,${TAG},rep=${REP} value=${WALLTIME},rc=${RC}" >> ${METRICFILE}
+  if [[ $RC != 0 || ! -f $RUNDIR/performanceMetrics.json ]]; then
+    echo "ERROR: reconstruction failed in repetition $REP, see $RUNDIR/reco.log"
+    RETVAL=1
+    continue
+  fi
+  SUMMARIES+=" $RUNDIR/performanceMetrics.json"
+done
+
+[[ -z $SUMMARIES ]] && exit 1
+
+python3 $O2_ROOT/prodtests/reco_benchmark_summary.py --output $BENCHMARK_OUTPUT --metrics-file $METRICFILE --tag "$TAG" \
+  ${BASELINE:+--baseline $BASELINE} --tolerance $BENCHMARK_TOLERANCE $SUMMARIES || RETVAL=1
+
+exit $RETVAL
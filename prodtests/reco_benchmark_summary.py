@@ -0,0 +1,109 @@
+#!/usr/bin/env python3
+
+# Reduces the performanceMetrics.json files dumped by the DPL driver with --resources-monitoring
+# to a per device summary (CPU time, wall time, peak RSS, shared memory) and compares it to a baseline.
+# With several input files (repetitions of the same workflow) the smallest value of each quantity is kept.
+
+import argparse
+import json
+import sys
+
+# relative changes of these quantities are checked against the baseline
+CHECKED = ["cpu_s", "wall_s", "rss_peak_mb", "shm_peak_mb"]
+# changes below these absolute values are ignored as noise
+NOISE = {"cpu_s": 1., "wall_s": 1., "rss_peak_mb": 20., "shm_peak_mb": 20.}
+
+
+def values(node):
+    result = []
+    for entry in node if isinstance(node, list) else node.values():
+        try:
+            result.append((int(entry["timestamp"]), float(entry["value"])))
+        except (KeyError, TypeError, ValueError):
+            pass
+    return result
+
+
+def summarize_device(metrics):
+    summary = {}
+    timestamps = [t for m in metrics.values() for t, _ in values(m)]
+    if timestamps:
+        summary["wall_s"] = (max(timestamps) - min(timestamps)) / 1000.
+    if "cpuTimeConsumedByProcess" in metrics:
+        # cumulative process CPU time in us
+        summary["cpu_s"] = max(v for _, v in values(metrics["cpuTimeConsumedByProcess"])) / 1.e6
+    elif "cpuUsedAbsolute" in metrics:
+        # CPU time in us used in each monitoring interval
+        summary["cpu_s"] = sum(v for _, v in values(metrics["cpuUsedAbsolute"])) / 1.e6
+    if "residentSetSize" in metrics:
+        # in kB
+        summary["rss_peak_mb"] = max(v for _, v in values(metrics["residentSetSize"])) / 1024.
+    if "shm-offer-bytes-consumed" in metrics:
+        summary["shm_peak_mb"] = max(v for _, v in values(metrics["shm-offer-bytes-consumed"])) / (1024. * 1024.)
+    return summary
+
+
+def summarize(files):
+    result = {}
+    for file in files:
+        with open(file) as f:
+            root = json.load(f)
+        for device, metrics in root.items():
+            if not isinstance(metrics, dict) or device == "driver":
+                continue
+            summary = summarize_device(metrics)
+            best = result.setdefault(device, summary)
+            for key, value in summary.items():
+                best[key] = min(best.get(key, value), value)
+    return result
+
+
+def compare(summary, baseline, tolerance):
+    regressions = []
+    for device, reference in sorted(baseline.items()):
+        if device not in summary:
+            print(f"WARNING: device {device} of the baseline is missing")
+            continue
+        for key in CHECKED:
+            if key not in reference or key not in summary[device]:
+                continue
+            old, new = reference[key], summary[device][key]
+            if new - old > NOISE[key] and new > old * (1. + tolerance):
+                regressions.append(f"{device} {key}: {old:.2f} -> {new:.2f} (+{100. * (new - old) / max(old, 1.e-9):.1f}%)")
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Summarize and compare DPL resources monitoring dumps")
+    parser.add_argument("inputs", nargs="+", help="performanceMetrics.json files")
+    parser.add_argument("--output", default="reco_benchmark.json", help="per device summary to write")
+    parser.add_argument("--baseline", help="per device summary to compare with")
+    parser.add_argument("--tolerance", type=float, default=0.1, help="allowed relative increase wrt the baseline")
+    parser.add_argument("--metrics-file", help="append the summary in the InfluxDB line format to this file")
+    parser.add_argument("--tag", default="", help="tags of the InfluxDB lines")
+    args = parser.parse_args()
+
+    summary = summarize(args.inputs)
+    with open(args.output, "w") as f:
+        json.dump(summary, f, indent=2, sort_keys=True)
+
+    if args.metrics_file:
+        with open(args.metrics_file, "a") as f:
+            for device, quantities in sorted(summary.items()):
+                fields = ",".join(f"{k}={v}" for k, v in sorted(quantities.items()))
+                if fields:
+                    f.write(f"reco_benchmark,{args.tag}{',' if args.tag else ''}device={device} {fields}\n")
+
+    if args.baseline:
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+        regressions = compare(summary, baseline, args.tolerance)
+        for r in regressions:
+            print(f"REGRESSION: {r}")
+        if regressions:
+            return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -66,6 +66,9 @@
 #include <mutex>
 #include <filesystem>
 #include <functional>
+#include <atomic>
+#include <thread>
+#include <algorithm>
 
 #include "SimPublishChannelHelper.h"
 
@@ -161,6 +164,14 @@ class O2HitMerger : public fair::mq::Device
       initHitFiles(o2::conf::SimConfig::Instance().getOutPrefix());
     }
 
+    // number of threads merging and flushing kinematics and detector hits in parallel
+    if (auto nthreadsenv = getenv("O2SIM_MERGER_THREADS")) {
+      mNMergerThreads = std::max(1, atoi(nthreadsenv));
+    } else {
+      mNMergerThreads = std::max(1, std::min(4, (int)std::thread::hardware_concurrency()));
+    }
+    LOG(info) << "Merging and flushing with " << mNMergerThreads << " threads";
+
     // init pipe
     auto pipeenv = getenv("ALICE_O2SIMMERGERTODRIVER_PIPE");
     if (pipeenv) {
@@ -628,6 +639,32 @@ class O2HitMerger : public fair::mq::Device
     }
   }
 
+  // Executes independent tasks on up to mNMergerThreads threads and waits for all of them
+  void runTasks(std::vector<std::function<void()>> const& tasks)
+  {
+    const int nthreads = std::min<int>(mNMergerThreads, tasks.size());
+    if (nthreads <= 1) {
+      for (auto& task : tasks) {
+        task();
+      }
+      return;
+    }
+    std::atomic<size_t> next{0};
+    auto worker = [&tasks, &next]() {
+      for (size_t i = next++; i < tasks.size(); i = next++) {
+        tasks[i]();
+      }
+    };
+    std::vector<std::thread> threads;
+    for (int i = 1; i < nthreads; ++i) {
+      threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& t : threads) {
+      t.join();
+    }
+  }
+
   // This method goes over the buffers containing data for a given event; potentially merges
   // them and flushes into the actual output file.
   // The method can be called asynchronously to data collection
@@ -765,27 +802,32 @@ class O2HitMerger : public fair::mq::Device
         eventheader->putInfo("prims_total", prims);
       };
 
-      reorderAndMergeMCTracks(flusheventID, mOutTree, nprimaries, subevOrdered, mcheaderhook, eventheader);
-
-      if (mOutTree) {
-        // adjusting and merging track references
-        remapTrackIdsAndMerge<std::vector<o2::TrackReference>>("TrackRefs", flusheventID, *mOutTree, trackoffsets, nprimaries, subevOrdered, mTrackRefBuffer);
-
-        // write MC event headers
-        {
-          auto headerbr = o2::base::getOrMakeBranch(*mOutTree, "MCEventHeader.", &eventheader);
-          headerbr->SetAddress(&eventheader);
-          headerbr->Fill();
-          headerbr->ResetAddress();
-        }
+      // the kinematics and the hits of each detector go to different trees (and files) and are
+      // merged and flushed by independent tasks
+      std::vector<std::function<void()>> tasks;
+      tasks.emplace_back([&, this]() {
+        reorderAndMergeMCTracks(flusheventID, mOutTree, nprimaries, subevOrdered, mcheaderhook, eventheader);
+
+        if (mOutTree) {
+          // adjusting and merging track references
+          remapTrackIdsAndMerge<std::vector<o2::TrackReference>>("TrackRefs", flusheventID, *mOutTree, trackoffsets, nprimaries, subevOrdered, mTrackRefBuffer);
+
+          // write MC event headers
+          {
+            auto headerbr = o2::base::getOrMakeBranch(*mOutTree, "MCEventHeader.", &eventheader);
+            headerbr->SetAddress(&eventheader);
+            headerbr->Fill();
+            headerbr->ResetAddress();
+          }
 
-        {
-          auto headerbr = o2::base::getOrMakeBranch(*mMCHeaderTree, "MCEventHeader.", &eventheader);
-          headerbr->SetAddress(&eventheader);
-          headerbr->Fill();
-          headerbr->ResetAddress();
+          {
+            auto headerbr = o2::base::getOrMakeBranch(*mMCHeaderTree, "MCEventHeader.", &eventheader);
+            headerbr->SetAddress(&eventheader);
+            headerbr->Fill();
+            headerbr->ResetAddress();
+          }
         }
-      }
+      });
 
       // c) do the merge procedure for all hits ... delegate this to detector specific functions
       // since they know about types; number of branches; etc.
@@ -795,12 +837,15 @@ class O2HitMerger : public fair::mq::Device
         if (det) {
           auto hittree = mDetectorToTTreeMap[id];
           if (hittree) {
-            det->mergeHitEntriesAndFlush(flusheventID, *hittree, trackoffsets, nprimaries, subevOrdered);
-            hittree->SetEntries(hittree->GetEntries() + 1);
-            LOG(info) << "flushing tree to file " << hittree->GetDirectory()->GetFile()->GetName();
+            tasks.emplace_back([&, det = det.get(), hittree]() {
+              det->mergeHitEntriesAndFlush(flusheventID, *hittree, trackoffsets, nprimaries, subevOrdered);
+              hittree->SetEntries(hittree->GetEntries() + 1);
+              LOG(info) << "flushing tree to file " << hittree->GetDirectory()->GetFile()->GetName();
+            });
           }
         }
       }
+      runTasks(tasks);
 
       // increase the entry count in the tree
       if (mOutTree) {
@@ -820,16 +865,18 @@ class O2HitMerger : public fair::mq::Device
     } // end while
     if (mWriteToDisc && mOutFile) {
       LOG(info) << "Writing TTrees";
-      mOutFile->Write("", TObject::kOverwrite);
+      std::vector<std::function<void()>> tasks;
+      tasks.emplace_back([this]() { mOutFile->Write("", TObject::kOverwrite); });
       for (int id = 0; id < mDetectorInstances.size(); ++id) {
         auto& det = mDetectorInstances[id];
         if (det && mDetectorOutFiles[id]) {
-          mDetectorOutFiles[id]->Write("", TObject::kOverwrite);
+          tasks.emplace_back([file = mDetectorOutFiles[id]]() { file->Write("", TObject::kOverwrite); });
         }
       }
       if (mMCHeaderOnlyOutFile) {
-        mMCHeaderOnlyOutFile->Write("", TObject::kOverwrite);
+        tasks.emplace_back([this]() { mMCHeaderOnlyOutFile->Write("", TObject::kOverwrite); });
       }
+      runTasks(tasks);
     }
     return true;
   }
@@ -850,6 +897,7 @@ class O2HitMerger : public fair::mq::Device
 
   // intermediate structures to collect data per event
   std::thread mMergerIOThread; //! a thread used to do hit merging and IO flushing asynchronously
+  int mNMergerThreads = 1;     //! number of threads merging and flushing the trees of an event in parallel
   bool mergingInProgress = false;
 
   Hashtable<int, std::vector<std::vector<o2::MCTrack>*>> mMCTrackBuffer;         //! vector of sub-event track vectors; one per event
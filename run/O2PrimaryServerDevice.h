@@ -28,6 +28,7 @@
 #include <Generators/GeneratorFromFile.h>
 #include <Generators/PrimaryGenerator.h>
 #include <SimConfig/SimConfig.h>
+#include <SimConfig/SimParams.h>
 #include <CommonUtils/ConfigurableParam.h>
 #include <CommonUtils/RngHelper.h>
 #include <DetectorsBase/SimFieldUtils.h>
@@ -40,11 +41,16 @@
 #include <fstream>
 #include <iostream>
 #include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include "PrimaryServerState.h"
 #include "SimPublishChannelHelper.h"
 #include <chrono>
 #include <CCDB/BasicCCDBManager.h>
 #include <TRandom3.h>
+#include <TParticle.h>
+#include <algorithm>
+#include <cmath>
 
 namespace o2
 {
@@ -61,6 +67,12 @@ class O2PrimaryServerDevice final : public fair::mq::Device
     if (mUseFixedChunkSeed) {
       mFixedChunkSeed = atol(getenv("ALICEO2_O2SIM_SUBEVENTSEED"));
     }
+    // number of generator instances producing events in parallel
+    if (auto ngen = getenv("O2SIM_PRIMSERVER_NGENERATORS")) {
+      mNGenerators = std::max(1, atoi(ngen));
+    }
+    // whether events of the generator pool may be dispatched in the order they become ready
+    mOrderedDispatch = !(getenv("O2SIM_PRIMSERVER_UNORDERED") && atoi(getenv("O2SIM_PRIMSERVER_UNORDERED")));
   }
 
   /// Default destructor
@@ -73,11 +85,27 @@ class O2PrimaryServerDevice final : public fair::mq::Device
       if (mControlThread.joinable()) {
         mControlThread.join();
       }
+      stopGeneratorPool();
     } catch (...) {
     }
   }
 
  protected:
+  // a generator instance of the pool, with its own stack and event header
+  struct GeneratorSlot {
+    enum class State { Idle,
+                       Requested,
+                       Generating,
+                       Done };
+    o2::eventgen::PrimaryGenerator* generator = nullptr;
+    o2::data::Stack* stack = nullptr;
+    o2::dataformats::MCEventHeader header;
+    o2::math_utils::Point3D<float> vertex; // vertex of the requested event
+    bool hasVertex = false;
+    int eventID = -1; // event (counting from 1) requested from this generator
+    State state = State::Idle;
+  };
+
   void initGenerator()
   {
     TStopwatch timer;
@@ -111,28 +139,7 @@ class O2PrimaryServerDevice final : public fair::mq::Device
     }
 
     if (mPrimGen == nullptr) {
-      mPrimGen = new o2::eventgen::PrimaryGenerator;
-      o2::eventgen::GeneratorFactory::setPrimaryGenerator(conf, mPrimGen);
-
-      // setup vertexing
-      auto vtxMode = conf.getVertexMode();
-      using o2::conf::VertexMode;
-      if (vtxMode == VertexMode::kNoVertex || vtxMode == VertexMode::kDiamondParam) {
-        mPrimGen->setVertexMode(vtxMode);
-      } else if (vtxMode == VertexMode::kCCDB) {
-        // we need to fetch the CCDB object
-        mPrimGen->setVertexMode(vtxMode, ccdbmgr.getForTimeStamp<o2::dataformats::MeanVertexObject>("GLO/Calib/MeanVertex", conf.getTimestamp()));
-      } else {
-        LOG(fatal) << "Unsupported vertex mode";
-      }
-
-      auto embedinto_filename = conf.getEmbedIntoFileName();
-      if (!embedinto_filename.empty()) {
-        mPrimGen->embedInto(embedinto_filename);
-      }
-
-      mPrimGen->Init();
-
+      mPrimGen = createGenerator();
       mPrimGeneratorCache[conf.getGenerator()] = mPrimGen;
     }
     mPrimGen->SetEvent(&mEventHeader);
@@ -156,40 +163,198 @@ class O2PrimaryServerDevice final : public fair::mq::Device
       }
     }
 
+    if (usePool()) {
+      initGeneratorPool();
+    }
+
     LOG(info) << "Generator initialization took " << timer.CpuTime() << "s";
     if (mMaxEvents > 0) {
       generateEvent(); // generate a first event
     }
   }
 
-  // function generating one event
-  void generateEvent(/*bool changeState = false*/)
+  // creates and initializes a primary generator according to the current configuration
+  o2::eventgen::PrimaryGenerator* createGenerator()
   {
-    bool changeState = true; // false;
-    LOG(info) << "Event generation started ";
-    if (changeState) {
-      stateTransition(O2PrimaryServerState::WaitingEvent, "GENEVENT");
+    const auto& conf = mSimConfig;
+    auto& ccdbmgr = o2::ccdb::BasicCCDBManager::instance();
+    auto primGen = new o2::eventgen::PrimaryGenerator;
+    o2::eventgen::GeneratorFactory::setPrimaryGenerator(conf, primGen);
+
+    // setup vertexing
+    auto vtxMode = conf.getVertexMode();
+    using o2::conf::VertexMode;
+    if (vtxMode == VertexMode::kNoVertex || vtxMode == VertexMode::kDiamondParam) {
+      primGen->setVertexMode(vtxMode);
+    } else if (vtxMode == VertexMode::kCCDB) {
+      // we need to fetch the CCDB object
+      primGen->setVertexMode(vtxMode, ccdbmgr.getForTimeStamp<o2::dataformats::MeanVertexObject>("GLO/Calib/MeanVertex", conf.getTimestamp()));
+    } else {
+      LOG(fatal) << "Unsupported vertex mode";
     }
-    TStopwatch timer;
-    timer.Start();
+
+    auto embedinto_filename = conf.getEmbedIntoFileName();
+    if (!embedinto_filename.empty()) {
+      primGen->embedInto(embedinto_filename);
+    }
+
+    primGen->Init();
+    return primGen;
+  }
+
+  // whether events are produced by a pool of generators running in parallel (never when running as a service);
+  // restricted to Pythia8 based generators, which use their own random number engine for the event generation
+  bool usePool() const
+  {
+    return mNGenerators > 1 && mSimConfig.getGenerator().rfind("pythia8", 0) == 0 && !mPrimGen->isEmbedding();
+  }
+
+  // sets up the additional generator instances and starts the generation of the first events
+  void initGeneratorPool()
+  {
+    LOG(info) << "Generating events with " << mNGenerators << " generator instances, " << (mOrderedDispatch || mCollissionContext ? "ordered" : "unordered") << " dispatch";
+    // the generators seed themselves from gRandom during initialization; give each a
+    // different, reproducible seed and restore the state of gRandom afterwards
+    TRandom3 seeds(mInitialSeed);
+    for (int i = 0; i < mNGenerators; ++i) {
+      auto slot = std::make_unique<GeneratorSlot>();
+      if (i == 0) {
+        slot->generator = mPrimGen;
+      } else {
+        o2::utils::RngHelper::setGRandomSeed(seeds.Integer(std::numeric_limits<int>::max()));
+        slot->generator = createGenerator();
+      }
+      slot->generator->SetEvent(&slot->header);
+      slot->stack = new o2::data::Stack();
+      slot->stack->setExternalMode(true);
+      mGeneratorPool.push_back(std::move(slot));
+    }
+    o2::utils::RngHelper::setGRandomSeed(mInitialSeed);
+
+    mNextEventToIssue = 0;
+    for (auto& slot : mGeneratorPool) {
+      mGeneratorPoolThreads.emplace_back(&O2PrimaryServerDevice::generatorPoolLoop, this, slot.get());
+    }
+    std::lock_guard<std::mutex> lock(mPoolMutex);
+    for (auto& slot : mGeneratorPool) {
+      if (mNextEventToIssue < mMaxEvents) {
+        issueEvent(*slot);
+      }
+    }
+  }
+
+  void stopGeneratorPool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mPoolMutex);
+      mPoolStop = true;
+    }
+    mPoolCondition.notify_all();
+    for (auto& thread : mGeneratorPoolThreads) {
+      if (thread.joinable()) {
+        thread.join();
+      }
+    }
+    mGeneratorPoolThreads.clear();
+    for (auto& slot : mGeneratorPool) {
+      if (slot->generator != mPrimGen) {
+        delete slot->generator;
+      }
+      delete slot->stack;
+    }
+    mGeneratorPool.clear();
+  }
+
+  // assigns the next event to a generator of the pool (to be called with mPoolMutex held);
+  // the vertex is drawn here so that the sequence of vertices does not depend on the thread timing
+  void issueEvent(GeneratorSlot& slot)
+  {
+    slot.eventID = ++mNextEventToIssue;
+    slot.vertex = getContextVertex(slot.eventID - 1, slot.hasVertex);
+    if (!slot.hasVertex) {
+      slot.vertex = slot.generator->sampleInteractionVertex();
+      slot.hasVertex = true;
+    }
+    slot.state = GeneratorSlot::State::Requested;
+    mPoolCondition.notify_all();
+  }
+
+  // the loop of a generator thread of the pool
+  void generatorPoolLoop(GeneratorSlot* slot)
+  {
+    std::unique_lock<std::mutex> lock(mPoolMutex);
+    while (true) {
+      mPoolCondition.wait(lock, [this, slot]() { return mPoolStop || slot->state == GeneratorSlot::State::Requested; });
+      if (mPoolStop) {
+        return;
+      }
+      slot->state = GeneratorSlot::State::Generating;
+      lock.unlock();
+      generateWith(*slot->generator, *slot->stack, &slot->vertex);
+      lock.lock();
+      slot->state = GeneratorSlot::State::Done;
+      mPoolCondition.notify_all();
+    }
+  }
+
+  // takes the next event from the generator pool into mStack and mEventHeader
+  void takeEventFromPool()
+  {
+    std::unique_lock<std::mutex> lock(mPoolMutex);
+    const bool ordered = mOrderedDispatch || mCollissionContext;
+    const int nextEvent = mEventCounter + 1;
+    GeneratorSlot* ready = nullptr;
+    mPoolCondition.wait(lock, [&]() {
+      for (auto& slot : mGeneratorPool) {
+        if (slot->state == GeneratorSlot::State::Done && (!ordered || slot->eventID == nextEvent) && (!ready || slot->eventID < ready->eventID)) {
+          ready = slot.get();
+        }
+      }
+      return ready != nullptr || mPoolStop;
+    });
+    if (!ready) {
+      return;
+    }
+    std::swap(mStack, ready->stack);
+    mEventHeader = ready->header;
+    ready->state = GeneratorSlot::State::Idle;
+    if (mNextEventToIssue < mMaxEvents) {
+      issueEvent(*ready);
+    }
+  }
+
+  // the vertex of an event (counting from 0) given by the collision context, if any
+  o2::math_utils::Point3D<float> getContextVertex(int eventIndex, bool& found) const
+  {
+    found = false;
+    if (mCollissionContext) {
+      const auto& vertices = mCollissionContext->getInteractionVertices();
+      if (vertices.size() > 0) {
+        auto collisionindex = mEventID_to_CollID.at(eventIndex);
+        auto& vertex = vertices.at(collisionindex);
+        LOG(info) << "Setting vertex " << vertex << " for event " << eventIndex << " for prefix " << mSimConfig.getOutPrefix();
+        found = true;
+        return o2::math_utils::Point3D<float>(vertex.X(), vertex.Y(), vertex.Z());
+      }
+    }
+    return o2::math_utils::Point3D<float>();
+  }
+
+  // generates one (non-empty if possible) event with the given generator into the given stack,
+  // using the given vertex if any
+  void generateWith(o2::eventgen::PrimaryGenerator& generator, o2::data::Stack& stack, o2::math_utils::Point3D<float> const* vertex)
+  {
     try {
       bool valid = false;
       int retry_counter = 0;
       const int MAX_RETRY = 100;
       do {
-        mStack->Reset();
-        // see if we the vertex comes from the collision context
-        if (mCollissionContext) {
-          const auto& vertices = mCollissionContext->getInteractionVertices();
-          if (vertices.size() > 0) {
-            auto collisionindex = mEventID_to_CollID.at(mEventCounter);
-            auto& vertex = vertices.at(collisionindex);
-            LOG(info) << "Setting vertex " << vertex << " for event " << mEventCounter << " for prefix " << mSimConfig.getOutPrefix();
-            mPrimGen->setExternalVertexForNextEvent(vertex.X(), vertex.Y(), vertex.Z());
-          }
+        stack.Reset();
+        if (vertex) {
+          generator.setExternalVertexForNextEvent(vertex->X(), vertex->Y(), vertex->Z());
         }
-        mPrimGen->GenerateEvent(mStack);
-        if (mStack->getPrimaries().size() > 0) {
+        generator.GenerateEvent(&stack);
+        if (stack.getPrimaries().size() > 0) {
           valid = true;
         } else {
           retry_counter++;
@@ -203,6 +368,26 @@ class O2PrimaryServerDevice final : public fair::mq::Device
     } catch (std::exception const& e) {
       LOG(error) << " Exception occurred during event gen " << e.what();
     }
+  }
+
+  // function generating one event
+  void generateEvent(/*bool changeState = false*/)
+  {
+    bool changeState = true; // false;
+    LOG(info) << "Event generation started ";
+    if (changeState) {
+      stateTransition(O2PrimaryServerState::WaitingEvent, "GENEVENT");
+    }
+    TStopwatch timer;
+    timer.Start();
+    if (!mGeneratorPool.empty()) {
+      takeEventFromPool();
+    } else {
+      // see if we the vertex comes from the collision context
+      bool hasVertex = false;
+      const auto vertex = getContextVertex(mEventCounter, hasVertex);
+      generateWith(*mPrimGen, *mStack, hasVertex ? &vertex : nullptr);
+    }
     timer.Stop();
     LOG(info) << "Event generation took " << timer.CpuTime() << "s"
               << " and produced " << mStack->getPrimaries().size() << " primaries ";
@@ -300,6 +485,10 @@ class O2PrimaryServerDevice final : public fair::mq::Device
 
     launchInfoThread();
 
+    if (vm["asservice"].as<bool>()) {
+      mNGenerators = 1; // the generator pool is not (yet) reconfigured when running as a service
+    }
+
     // launch initialization of particle generator asynchronously
     // so that we reach the RUNNING state of the server quickly
     // and do not block here
@@ -517,9 +706,11 @@ class O2PrimaryServerDevice final : public fair::mq::Device
       }
 
       auto& prims = mStack->getPrimaries();
-      auto numberofparts = (int)std::ceil(prims.size() / (1. * mChunkGranularity));
-      // number of parts should be at least 1 (even if empty)
-      numberofparts = std::max(1, numberofparts);
+      if (mPartCounter == 0) {
+        // the number of parts is fixed with the first chunk since the hit merger relies on it
+        computeChunkBoundaries(prims);
+      }
+      const int numberofparts = mChunkBoundaries.size() - 1;
 
       LOG(debug) << "Have " << prims.size() << " " << numberofparts;
 
@@ -537,17 +728,11 @@ class O2PrimaryServerDevice final : public fair::mq::Device
       i.mMCEventHeader = mEventHeader;
       m.mSubEventInfo = i;
 
-      int endindex = prims.size() - mPartCounter * mChunkGranularity;
-      int startindex = prims.size() - (mPartCounter + 1) * mChunkGranularity;
+      // chunks are taken from the end of the primaries
+      const int endindex = mChunkBoundaries[numberofparts - mPartCounter];
+      const int startindex = mChunkBoundaries[numberofparts - mPartCounter - 1];
       LOG(debug) << "indices " << startindex << " " << endindex;
 
-      if (startindex < 0) {
-        startindex = 0;
-      }
-      if (endindex < 0) {
-        endindex = 0;
-      }
-
       for (int index = startindex; index < endindex; ++index) {
         m.mParticles.emplace_back(prims[index]);
       }
@@ -646,6 +831,75 @@ class O2PrimaryServerDevice final : public fair::mq::Device
     mWaitingControlInput.store(0);
   }
 
+ private:
+  // estimated transport cost of a primary, see SimChunkingParams
+  static float estimateCost(TParticle const& p, o2::conf::SimChunkingParams const& param)
+  {
+    const int apdg = std::abs(p.GetPdgCode());
+    if (apdg == 12 || apdg == 14 || apdg == 16) {
+      return 0.f;
+    }
+    float cost = 1.f + param.energyWeight * p.Energy();
+    if (p.Pt() > 0. && std::abs(p.Eta()) > param.forwardEta) {
+      cost *= param.forwardWeight;
+    }
+    return cost;
+  }
+
+  // fills mChunkBoundaries with the numberofparts + 1 primary indices delimiting the chunks of the current event
+  void computeChunkBoundaries(std::vector<TParticle> const& prims)
+  {
+    auto& param = o2::conf::SimChunkingParams::Instance();
+    const int nprims = prims.size();
+    // number of parts should be at least 1 (even if empty)
+    int numberofparts = std::max(1, (int)std::ceil(nprims / (1. * mChunkGranularity)));
+    int size = mChunkGranularity;
+    if (param.minParts > numberofparts && nprims > numberofparts) {
+      numberofparts = std::min(param.minParts, nprims);
+      size = std::ceil(nprims / (1. * numberofparts));
+    }
+    mChunkBoundaries.clear();
+    mChunkBoundaries.reserve(numberofparts + 1);
+    if (!param.costBalanced) {
+      // fixed number of primaries, the remainder going to the part sent last
+      mChunkBoundaries.push_back(0);
+      for (int part = numberofparts - 1; part > 0; --part) {
+        mChunkBoundaries.push_back(std::max(0, nprims - part * size));
+      }
+      mChunkBoundaries.push_back(nprims);
+      return;
+    }
+    // cumulative cost, cut where it reaches the target of each part (in the order of sending, i.e. from the end)
+    std::vector<double> cumCost(nprims + 1, 0.);
+    for (int index = nprims - 1; index >= 0; --index) {
+      cumCost[index] = cumCost[index + 1] + estimateCost(prims[index], param);
+    }
+    const float guided = std::clamp(param.guidedFraction, 0.f, 0.99f);
+    std::vector<double> weights(numberofparts);
+    double sumWeights = 0.;
+    for (int part = 0; part < numberofparts; ++part) {
+      weights[part] = numberofparts > 1 ? 1. - guided * part / (numberofparts - 1) : 1.;
+      sumWeights += weights[part];
+    }
+    mChunkBoundaries.resize(numberofparts + 1);
+    mChunkBoundaries[numberofparts] = nprims;
+    double target = 0.;
+    int index = nprims;
+    for (int part = 0; part < numberofparts - 1; ++part) {
+      target += cumCost[0] * weights[part] / sumWeights;
+      // leave at least one primary to each of the remaining parts
+      const int minIndex = numberofparts - 1 - part;
+      int next = index - 1;
+      while (next > minIndex && cumCost[next - 1] <= target) {
+        --next;
+      }
+      index = std::max(next, minIndex);
+      mChunkBoundaries[numberofparts - 1 - part] = index;
+    }
+    mChunkBoundaries[0] = 0;
+    LOG(info) << "Cost balanced chunking of " << nprims << " primaries (estimated cost " << cumCost[0] << ") in " << numberofparts << " parts";
+  }
+
  private:
   o2::conf::SimConfig mSimConfig = o2::conf::SimConfig::Instance(); // local sim config object
   o2::eventgen::PrimaryGenerator* mPrimGen = nullptr;               // the current primary generator
@@ -653,6 +907,7 @@ class O2PrimaryServerDevice final : public fair::mq::Device
   o2::data::Stack* mStack = nullptr; // the stack which is filled (pointer since constructor to be called only init method)
   int mChunkGranularity = 500;       // how many primaries to send to a worker
   int mPartCounter = 0;
+  std::vector<int> mChunkBoundaries; // primary indices delimiting the chunks of the current event
   bool mNeedNewEvent = true;
   int mMaxEvents = 2;
   ULong_t mInitialSeed = 0;
@@ -687,6 +942,15 @@ class O2PrimaryServerDevice final : public fair::mq::Device
   std::unordered_map<int, int> mEventID_to_CollID;              //!
 
   TRandom3 mSeedGenerator; //! specific random generator for seed generation for work chunks
+
+  int mNGenerators = 1;         // number of generator instances producing events in parallel
+  bool mOrderedDispatch = true; // whether the pool events are dispatched in the order they were requested
+  std::vector<std::unique_ptr<GeneratorSlot>> mGeneratorPool; //!
+  std::vector<std::thread> mGeneratorPoolThreads;             //!
+  std::mutex mPoolMutex;                                      //! protecting the states of the pool
+  std::condition_variable mPoolCondition;                     //!
+  bool mPoolStop = false;
+  int mNextEventToIssue = 0; // number of events given to the pool
 };
 
 } // namespace devices
@@ -22,11 +22,14 @@
 #include <fairmq/Parts.h>
 #include <fairmq/TransportFactory.h>
 #include <TStopwatch.h>
+#include <TGeoManager.h>
 #include <sys/wait.h>
 #include <pthread.h> // to set cpu affinity
 #include <cmath>
 #include <csignal>
 #include <unistd.h>
+#include <fstream>
+#include <sstream>
 #include "SimPublishChannelHelper.h"
 
 #include "rapidjson/document.h"
@@ -141,6 +144,42 @@ int initAndRunDevice(int argc, char* argv[])
   }
 }
 
+// prepares the geometry for being shared by the forked workers: the per-thread data of the
+// geometry objects (voxel and pattern finders, assemblies) and the navigation caches are
+// otherwise created lazily by the first navigation, separately in every worker
+void prepareGeometryForFork()
+{
+  if (!gGeoManager) {
+    return;
+  }
+  gGeoManager->CreateThreadData();
+  auto navigator = gGeoManager->GetCurrentNavigator();
+  if (!navigator) {
+    navigator = gGeoManager->AddNavigator();
+  }
+  // a first navigation initializes the remaining lazy state of the navigator
+  navigator->FindNode(0., 0., 0.);
+}
+
+// reports how much of the memory of this process is still shared with the other workers
+void logMemorySharing(int workerID)
+{
+  std::ifstream smaps("/proc/self/smaps_rollup");
+  if (!smaps.is_open()) {
+    return;
+  }
+  std::string key;
+  long value;
+  std::string unit;
+  std::stringstream summary;
+  while (smaps >> key >> value >> unit) {
+    if (key == "Rss:" || key == "Pss:" || key == "Shared_Clean:" || key == "Shared_Dirty:" || key == "Private_Clean:" || key == "Private_Dirty:") {
+      summary << " " << key << " " << value / 1024 << " MB";
+    }
+  }
+  LOG(info) << "Memory of worker " << workerID << ":" << summary.str();
+}
+
 struct KernelSetup {
   o2::devices::O2SimDevice* sim = nullptr;
   fair::mq::Channel* primchannel = nullptr;
@@ -372,6 +411,7 @@ int main(int argc, char* argv[])
       LOG(error) << "Could not initialize simulation";
       return 1;
     }
+    prepareGeometryForFork();
 
     // should be factored out?
     unsigned int nworkers = std::max(1u, std::thread::hardware_concurrency() / 2);
@@ -420,6 +460,7 @@ int main(int argc, char* argv[])
         pinToCPU(i);
 
         auto kernelSetup = initSim("zeromq", serveraddress, serverstatus_address, mergeraddress, i);
+        logMemorySharing(i);
 
         std::stringstream worker;
         worker << "WORKER" << i;
@@ -430,6 +471,7 @@ int main(int argc, char* argv[])
         bool more = true;
         while (more) {
           runSim(kernelSetup);
+          logMemorySharing(i);
 
           if (conf.asService()) {
             LOG(info) << "IN SERVICE MODE WAITING";